@@ -13,7 +13,7 @@
 #include "archival/logger.h"
 #include "storage/disk_log_impl.h"
 #include "storage/fs_utils.h"
-#include "storage/parser.h"
+#include "storage/header_sidecar.h"
 #include "storage/segment.h"
 #include "storage/segment_set.h"
 #include "storage/version.h"
@@ -34,14 +34,15 @@ std::ostream& operator<<(std::ostream& s, const upload_candidate& c) {
       s,
       "{{segment: {}, exposed_name: {}, starting_offset:{}, "
       "file_offset: {}, content_length: {}, final_offset: {}, "
-      "final_file_offset: {}}}",
+      "final_file_offset: {}, coalesced: {}}}",
       *c.source,
       c.exposed_name,
       c.starting_offset,
       c.file_offset,
       c.content_length,
       c.final_offset,
-      c.final_file_offset);
+      c.final_file_offset,
+      c.coalesced.size());
     return s;
 }
 
@@ -49,11 +50,13 @@ archival_policy::archival_policy(
   model::ntp ntp,
   service_probe& svc_probe,
   ntp_level_probe& ntp_probe,
-  std::optional<segment_time_limit> limit)
+  std::optional<segment_time_limit> limit,
+  size_t coalesce_size)
   : _ntp(std::move(ntp))
   , _svc_probe(svc_probe)
   , _ntp_probe(ntp_probe)
-  , _upload_limit(limit) {}
+  , _upload_limit(limit)
+  , _coalesce_size(coalesce_size) {}
 
 bool archival_policy::upload_deadline_reached() {
     if (!_upload_limit.has_value()) {
@@ -162,29 +165,6 @@ archival_policy::lookup_result archival_policy::find_segment(
 }
 
 // Data sink for noop output_stream instance
-// needed to implement scanning
-struct null_data_sink final : ss::data_sink_impl {
-    ss::future<> put(ss::net::packet data) final { return put(data.release()); }
-    ss::future<> put(std::vector<ss::temporary_buffer<char>> all) final {
-        return ss::do_with(
-          std::move(all), [this](std::vector<ss::temporary_buffer<char>>& all) {
-              return ss::do_for_each(
-                all, [this](ss::temporary_buffer<char>& buf) {
-                    return put(std::move(buf));
-                });
-          });
-    }
-    ss::future<> put(ss::temporary_buffer<char>) final { return ss::now(); }
-    ss::future<> flush() final { return ss::now(); }
-    ss::future<> close() final { return ss::now(); }
-};
-
-static ss::output_stream<char> make_null_output_stream() {
-    auto ds = ss::data_sink(std::make_unique<null_data_sink>());
-    ss::output_stream<char> ostr(std::move(ds), 4_KiB);
-    return ostr;
-}
-
 /// This function computes offsets for the upload (inc. file offets)
 /// If the full segment is uploaded the segment is not scanned.
 /// If the upload is partial, the partial scan will be performed if
@@ -215,7 +195,23 @@ static ss::future<> get_file_range(
           fsize);
         co_return;
     }
-    if (begin_inclusive != segment->offsets().base_offset) {
+    auto ix_begin = begin_inclusive != segment->offsets().base_offset
+                      ? segment->index().find_nearest(begin_inclusive)
+                      : std::nullopt;
+    if (ix_begin && ix_begin->offset == begin_inclusive) {
+        // The upload starts at the indexed record batch, the file offset is
+        // known without scanning. The index doesn't store the first timestamp
+        // of the batch, the base timestamp of the segment is kept as a lower
+        // bound.
+        vlog(
+          archival_log.debug,
+          "Starting offset {} found in the index at {}",
+          begin_inclusive,
+          ix_begin->filepos);
+        upl.starting_offset = begin_inclusive;
+        upl.file_offset = ix_begin->filepos;
+        upl.content_length -= ix_begin->filepos;
+    } else if (begin_inclusive != segment->offsets().base_offset) {
         // The upload is not started at the begining of the segment.
         // The segment may or may not be sealed and the final offset
         // may or may not be the last offset of the segment. This code
@@ -231,45 +227,45 @@ static ss::future<> get_file_range(
         size_t scan_from = ix_begin ? ix_begin->filepos : 0;
         model::offset sto = ix_begin ? ix_begin->offset
                                      : segment->offsets().base_offset;
-        auto istr = segment->reader().data_stream(
-          scan_from, ss::default_priority_class());
-        auto ostr = make_null_output_stream();
-
         size_t bytes_to_skip = 0;
         model::timestamp ts = upl.base_timestamp;
-        auto res = co_await storage::transform_stream(
-          std::move(istr),
-          std::move(ostr),
-          [begin_inclusive, &sto, &ts](model::record_batch_header& hdr) {
-              if (hdr.last_offset() < begin_inclusive) {
-                  // The current record batch is accepted and will contribute to
-                  // skipped length. This means that if we will read segment
-                  // file starting from the 'scan_from' + 'res' we will be
-                  // looking at the next record batch. We might not see the
-                  // offset that we're looking for in this segment. This is why
-                  // we need to update 'sto' per batch.
-                  sto = hdr.last_offset() + model::offset(1);
-                  // TODO: update base_timestamp
-                  return storage::batch_consumer::consume_result::accept_batch;
-              }
-              ts = hdr.first_timestamp;
-              return storage::batch_consumer::consume_result::stop_parser;
-          });
-        if (res.has_error()) {
-            vlog(
-              archival_log.error,
-              "Can't read segment file, error: {}",
-              res.error());
-        } else {
-            bytes_to_skip = scan_from + res.value();
+        try {
+            // only the batch headers are needed, they are read from the
+            // header sidecar of the segment when it has one
+            bytes_to_skip = co_await storage::scan_headers(
+              *segment,
+              scan_from,
+              ss::default_priority_class(),
+              [begin_inclusive, &sto, &ts](
+                const model::record_batch_header& hdr) {
+                  if (hdr.last_offset() < begin_inclusive) {
+                      // The current record batch is skipped and will
+                      // contribute to skipped length. This means that if we
+                      // will read segment file starting from the returned
+                      // position we will be looking at the next record batch.
+                      // We might not see the offset that we're looking for in
+                      // this segment. This is why we need to update 'sto' per
+                      // batch.
+                      sto = hdr.last_offset() + model::offset(1);
+                      // TODO: update base_timestamp
+                      return ss::stop_iteration::no;
+                  }
+                  ts = hdr.first_timestamp;
+                  return ss::stop_iteration::yes;
+              });
             vlog(
               archival_log.debug,
               "Scanned {} bytes starting from {}, total {}. Adjusted starting "
               "offset: {}",
-              res.value(),
+              bytes_to_skip - scan_from,
               scan_from,
               bytes_to_skip,
               sto);
+        } catch (...) {
+            vlog(
+              archival_log.error,
+              "Can't read segment file, error: {}",
+              std::current_exception());
         }
         // Adjust content lenght and offsets at the begining of the file
         upl.starting_offset = sto;
@@ -277,7 +273,25 @@ static ss::future<> get_file_range(
         upl.content_length -= bytes_to_skip;
         upl.base_timestamp = ts;
     }
-    if (end_inclusive) {
+    auto ix_next = end_inclusive ? segment->index().find_nearest(
+                     end_inclusive.value() + model::offset(1))
+                                 : std::nullopt;
+    if (
+      ix_next && ix_next->offset == end_inclusive.value() + model::offset(1)
+      && ix_next->filepos <= fsize) {
+        // The record batch that follows the upload is indexed, the upload
+        // ends right before it. The max timestamp of the segment is kept as
+        // an upper bound.
+        vlog(
+          archival_log.debug,
+          "Offset following the final offset {} found in the index at {}",
+          end_inclusive.value(),
+          ix_next->filepos);
+        upl.final_offset = end_inclusive.value();
+        upl.final_file_offset = ix_next->filepos;
+        upl.content_length -= std::min(
+          upl.content_length, fsize - ix_next->filepos);
+    } else if (end_inclusive) {
         // Handle truncated segment upload (if the upload was triggered by time
         // limit). Note that the upload is not necessary started at the begining
         // of the segment.
@@ -307,42 +321,39 @@ static ss::future<> get_file_range(
           scan_from,
           fo);
 
-        auto istr = segment->reader().data_stream(
-          scan_from, ss::default_priority_class());
-        auto ostr = make_null_output_stream();
         model::timestamp ts = upl.max_timestamp;
         size_t stop_at = 0;
-        auto res = co_await storage::transform_stream(
-          std::move(istr),
-          std::move(ostr),
-          [off_end = end_inclusive.value(), &fo, &ts](
-            model::record_batch_header& hdr) {
-              if (hdr.last_offset() <= off_end) {
-                  // If last offset of the record batch is within the range
-                  // we need to add it to the output stream (to calculate the
-                  // total size).
-                  fo = hdr.last_offset();
-                  // TODO: update max_timestamp
-                  return storage::batch_consumer::consume_result::accept_batch;
-              }
-              ts = hdr.max_timestamp;
-              return storage::batch_consumer::consume_result::stop_parser;
-          });
-        if (res.has_error()) {
-            vlog(
-              archival_log.error,
-              "Can't read segment file, error: {}",
-              res.error());
-        } else {
-            stop_at = scan_from + res.value();
+        try {
+            stop_at = co_await storage::scan_headers(
+              *segment,
+              scan_from,
+              ss::default_priority_class(),
+              [off_end = end_inclusive.value(), &fo, &ts](
+                const model::record_batch_header& hdr) {
+                  if (hdr.last_offset() <= off_end) {
+                      // If last offset of the record batch is within the
+                      // range it is part of the upload (to calculate the
+                      // total size).
+                      fo = hdr.last_offset();
+                      // TODO: update max_timestamp
+                      return ss::stop_iteration::no;
+                  }
+                  ts = hdr.max_timestamp;
+                  return ss::stop_iteration::yes;
+              });
             vlog(
               archival_log.debug,
               "Scanned {} bytes starting from {}, total {}. Adjusted final "
               "offset: {}",
-              res.value(),
+              stop_at - scan_from,
               scan_from,
               stop_at,
               fo);
+        } catch (...) {
+            vlog(
+              archival_log.error,
+              "Can't read segment file, error: {}",
+              std::current_exception());
         }
         upl.final_offset = fo;
         upl.final_file_offset = stop_at;
@@ -435,7 +446,59 @@ ss::future<upload_candidate> archival_policy::get_next_candidate(
     if (upload.content_length == 0) {
         co_return upload_candidate{};
     }
+    if (!forced && _coalesce_size != 0) {
+        coalesce_segments(upload, adjusted_lso, lm);
+    }
     co_return upload;
 }
 
+void archival_policy::coalesce_segments(
+  upload_candidate& upload,
+  model::offset adjusted_lso,
+  storage::log_manager& lm) {
+    std::optional<storage::log> log = lm.get(_ntp);
+    if (!log) {
+        return;
+    }
+    auto plog = dynamic_cast<storage::disk_log_impl*>(log->get_impl());
+    if (plog == nullptr || upload.source->is_compacted_segment()) {
+        return;
+    }
+    const auto& set = plog->segments();
+    auto term = upload.source->offsets().term;
+    auto it = set.lower_bound(upload.final_offset);
+    if (it == set.end() || *it != upload.source) {
+        return;
+    }
+    for (++it; it != set.end(); ++it) {
+        const auto& next = *it;
+        auto size = next->reader().file_size();
+        // The segment name contains the term of the first segment, only the
+        // segments of the same term are coalesced
+        if (
+          next->has_appender() || next->is_compacted_segment()
+          || next->offsets().term != term
+          || next->offsets().base_offset
+               != upload.final_offset + model::offset(1)
+          || next->offsets().dirty_offset > adjusted_lso
+          || upload.content_length + size > _coalesce_size) {
+            break;
+        }
+        upload.coalesced.push_back(next);
+        upload.content_length += size;
+        upload.final_offset = next->offsets().dirty_offset;
+        upload.final_file_offset = size;
+        upload.max_timestamp = std::max(
+          upload.max_timestamp, next->index().max_timestamp());
+    }
+    if (!upload.coalesced.empty()) {
+        vlog(
+          archival_log.debug,
+          "Upload policy for {}, coalesced {} segments into {}",
+          _ntp,
+          upload.coalesced.size() + 1,
+          upload);
+    }
+}
+
 } // namespace archival
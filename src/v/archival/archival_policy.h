@@ -21,6 +21,11 @@ namespace archival {
 
 struct upload_candidate {
     ss::lw_shared_ptr<storage::segment> source;
+    /// Segments following the source that are uploaded in the same object,
+    /// in offset order. Only closed segments are coalesced and only as a
+    /// whole, the upload continues from the 'file_offset' of the source to
+    /// the end of the last coalesced segment.
+    std::vector<ss::lw_shared_ptr<storage::segment>> coalesced;
     segment_name exposed_name;
     model::offset starting_offset;
     size_t file_offset;
@@ -44,10 +49,16 @@ public:
       model::ntp ntp,
       service_probe& svc_probe,
       ntp_level_probe& ntp_probe,
-      std::optional<segment_time_limit> limit = std::nullopt);
+      std::optional<segment_time_limit> limit = std::nullopt,
+      size_t coalesce_size = 0);
 
     /// \brief regurn next upload candidate
     ///
+    /// The upload boundaries are found using the segment index, the segment
+    /// is scanned only from the nearest index entry when the boundary doesn't
+    /// match the index. Closed segments smaller than the coalesce size are
+    /// combined into a single upload.
+    ///
     /// \param begin_inclusive is an inclusive begining of the range
     /// \param end_exclusive is an exclusive end of the range
     /// \param lm is a log manager
@@ -76,11 +87,19 @@ private:
       model::offset adjusted_lso,
       storage::log_manager& lm);
 
+    /// Add the closed segments following the upload to it while the total
+    /// size stays within the coalesce size
+    void coalesce_segments(
+      upload_candidate& upload,
+      model::offset adjusted_lso,
+      storage::log_manager& lm);
+
     model::ntp _ntp;
     service_probe& _svc_probe;
     ntp_level_probe& _ntp_probe;
     std::optional<segment_time_limit> _upload_limit;
     std::optional<ss::lowres_clock::time_point> _upload_deadline;
+    size_t _coalesce_size;
 };
 
 } // namespace archival
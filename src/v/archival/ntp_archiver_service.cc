@@ -16,12 +16,14 @@
 #include "cloud_storage/types.h"
 #include "model/metadata.h"
 #include "raft/configuration_manager.h"
+#include "resource_mgmt/io_priority.h"
 #include "s3/client.h"
 #include "s3/error.h"
 #include "storage/disk_log_impl.h"
 #include "storage/fs_utils.h"
 #include "storage/parser.h"
 #include "utils/gate_guard.h"
+#include "utils/stream_utils.h"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/file.hh>
@@ -45,13 +47,19 @@ std::ostream& operator<<(std::ostream& o, const configuration& cfg) {
       o,
       "{{bucket_name: {}, interval: {}, initial_backoff: {}, "
       "segment_upload_timeout: {}, "
-      "manifest_upload_timeout: {}, time_limit: {}}}",
+      "manifest_upload_timeout: {}, time_limit: {}, upload_bandwidth: {}, "
+      "binary_manifest: {}, manifest_max_deltas: {}, "
+      "upload_coalesce_size: {}}}",
       cfg.bucket_name,
       cfg.interval.count(),
       cfg.initial_backoff.count(),
       cfg.segment_upload_timeout.count(),
       cfg.manifest_upload_timeout.count(),
-      cfg.time_limit);
+      cfg.time_limit,
+      cfg.upload_bandwidth,
+      cfg.manifest_format == cloud_storage::manifest_format::binary,
+      cfg.manifest_max_deltas,
+      cfg.upload_coalesce_size);
     return o;
 }
 
@@ -60,20 +68,33 @@ ntp_archiver::ntp_archiver(
   const configuration& conf,
   cloud_storage::remote& remote,
   ss::lw_shared_ptr<cluster::partition> part,
-  service_probe& svc_probe)
+  service_probe& svc_probe,
+  std::optional<std::reference_wrapper<cloud_storage::bandwidth_throttle>>
+    throttle)
   : _svc_probe(svc_probe)
   , _probe(conf.ntp_metrics_disabled, ntp.ntp())
   , _ntp(ntp.ntp())
   , _rev(ntp.get_revision())
   , _remote(remote)
   , _partition(std::move(part))
-  , _policy(_ntp, _svc_probe, std::ref(_probe), conf.time_limit)
+  , _throttle(throttle)
+  , _policy(
+      _ntp,
+      _svc_probe,
+      std::ref(_probe),
+      conf.time_limit,
+      conf.upload_coalesce_size)
   , _bucket(conf.bucket_name)
   , _manifest(_ntp, _rev)
+  , _manifest_delta(_ntp, _rev)
+  , _max_manifest_deltas(conf.manifest_max_deltas)
+  , _next_delta_seq(conf.manifest_max_deltas)
   , _gate()
   , _initial_backoff(conf.initial_backoff)
   , _segment_upload_timeout(conf.segment_upload_timeout)
   , _manifest_upload_timeout(conf.manifest_upload_timeout) {
+    _manifest.set_format(conf.manifest_format);
+    _manifest_delta.set_format(conf.manifest_format);
     vlog(archival_log.trace, "Create ntp_archiver {}", _ntp.path());
 }
 
@@ -94,6 +115,63 @@ const cloud_storage::manifest& ntp_archiver::get_remote_manifest() const {
     return _manifest;
 }
 
+double ntp_archiver::upload_urgency(storage::log_manager& lm) const {
+    auto log = lm.get(_ntp);
+    if (!log) {
+        return 0;
+    }
+    auto plog = dynamic_cast<storage::disk_log_impl*>(log->get_impl());
+    if (plog == nullptr || plog->segment_count() == 0) {
+        return 0;
+    }
+    const auto& set = plog->segments();
+    auto it = set.begin();
+    if (_manifest.size()) {
+        it = set.lower_bound(_manifest.get_last_offset() + model::offset(1));
+    }
+    if (it == set.end()) {
+        return 0;
+    }
+
+    // same defaults and overrides as the log housekeeping
+    std::optional<size_t> retention_bytes = lm.config().retention_bytes;
+    std::optional<std::chrono::milliseconds> retention_time
+      = lm.config().delete_retention;
+    if (plog->config().has_overrides()) {
+        const auto& overrides = plog->config().get_overrides();
+        if (overrides.retention_bytes.is_disabled()) {
+            retention_bytes = std::nullopt;
+        } else if (overrides.retention_bytes.has_value()) {
+            retention_bytes = overrides.retention_bytes.value();
+        }
+        if (overrides.retention_time.is_disabled()) {
+            retention_time = std::nullopt;
+        } else if (overrides.retention_time.has_value()) {
+            retention_time = overrides.retention_time.value();
+        }
+    }
+
+    double urgency = 0;
+    // the oldest segment not uploaded yet is removed once it is older than
+    // the retention time...
+    if (retention_time && retention_time->count() > 0) {
+        auto age = model::timestamp::now().value()
+                   - (*it)->index().max_timestamp().value();
+        urgency = std::max(
+          urgency, static_cast<double>(age) / retention_time->count());
+    }
+    // ...or once the segments following it exceed the retention size
+    if (retention_bytes && *retention_bytes > 0) {
+        size_t pending = 0;
+        for (; it != set.end(); ++it) {
+            pending += (*it)->size_bytes();
+        }
+        urgency = std::max(
+          urgency, static_cast<double>(pending) / *retention_bytes);
+    }
+    return urgency;
+}
+
 ss::future<cloud_storage::download_result>
 ntp_archiver::download_manifest(retry_chain_node& parent) {
     gate_guard guard{_gate};
@@ -103,7 +181,14 @@ ntp_archiver::download_manifest(retry_chain_node& parent) {
     auto path = _manifest.get_manifest_path();
     auto key = cloud_storage::remote_manifest_path(
       std::filesystem::path(std::move(path)));
-    co_return co_await _remote.download_manifest(_bucket, key, _manifest, fib);
+    auto res = co_await _remote.download_manifest(
+      _bucket, key, _manifest, fib);
+    // the deltas written by the previous leader are already applied, the
+    // next upload starts a new generation of the manifest
+    _manifest_delta = cloud_storage::manifest(_ntp, _rev);
+    _manifest_delta.set_format(_manifest.get_format());
+    _next_delta_seq = _max_manifest_deltas;
+    co_return res;
 }
 
 ss::future<cloud_storage::upload_result>
@@ -111,8 +196,117 @@ ntp_archiver::upload_manifest(retry_chain_node& parent) {
     gate_guard guard{_gate};
     retry_chain_node fib(_manifest_upload_timeout, _initial_backoff, &parent);
     retry_chain_logger ctxlog(archival_log, fib, _ntp.path());
+    auto generation = _manifest.get_generation();
+    if (
+      _max_manifest_deltas > 0 && generation
+      && _next_delta_seq < _max_manifest_deltas) {
+        auto key = _manifest.get_manifest_delta_path(
+          *generation, _next_delta_seq);
+        vlog(
+          ctxlog.debug,
+          "Uploading manifest delta {} with {} segments for {}",
+          key,
+          _manifest_delta.size(),
+          _ntp);
+        auto res = co_await _remote.upload_manifest(
+          _bucket, _manifest_delta, key, fib);
+        if (res == cloud_storage::upload_result::success) {
+            // segments of the failed delta are uploaded with the next one
+            _manifest_delta = cloud_storage::manifest(_ntp, _rev);
+            _manifest_delta.set_format(_manifest.get_format());
+            ++_next_delta_seq;
+        }
+        co_return res;
+    }
+
     vlog(ctxlog.debug, "Uploading manifest for {}", _ntp);
-    co_return co_await _remote.upload_manifest(_bucket, _manifest, fib);
+    // the full manifest starts a new generation, the deltas of the previous
+    // one are folded into it
+    _manifest.set_generation(
+      _max_manifest_deltas > 0 ? std::make_optional(generation.value_or(0) + 1)
+                               : std::nullopt);
+    auto res = co_await _remote.upload_manifest(_bucket, _manifest, fib);
+    if (res != cloud_storage::upload_result::success) {
+        _manifest.set_generation(generation);
+        co_return res;
+    }
+    _manifest_delta = cloud_storage::manifest(_ntp, _rev);
+    _manifest_delta.set_format(_manifest.get_format());
+    _next_delta_seq = 0;
+    if (generation) {
+        co_await remove_manifest_deltas(*generation, fib);
+    }
+    co_return res;
+}
+
+ss::future<> ntp_archiver::remove_manifest_deltas(
+  uint64_t generation, retry_chain_node& parent) {
+    retry_chain_logger ctxlog(archival_log, parent, _ntp.path());
+    std::vector<s3::object_key> deltas;
+    auto prefix = _manifest.get_manifest_delta_prefix(generation);
+    auto res = co_await _remote.list_objects(
+      [&deltas](
+        const ss::sstring& key,
+        std::chrono::system_clock::time_point,
+        size_t,
+        const ss::sstring&) {
+          deltas.emplace_back(std::filesystem::path(key));
+          return ss::stop_iteration::no;
+      },
+      _bucket,
+      s3::object_key(prefix()),
+      std::nullopt,
+      parent);
+    if (res != cloud_storage::download_result::success) {
+        vlog(
+          ctxlog.warn,
+          "Failed to list the deltas of manifest generation {}: {}",
+          generation,
+          res);
+        co_return;
+    }
+    for (const auto& key : deltas) {
+        auto del = co_await _remote.delete_object(_bucket, key, parent);
+        if (del != cloud_storage::upload_result::success) {
+            vlog(
+              ctxlog.warn, "Failed to remove manifest delta {}: {}", key, del);
+        }
+    }
+}
+
+/// Stream of the [offset, offset + length) range of the upload, the range can
+/// span the source segment and the segments coalesced with it
+static ss::input_stream<char> make_upload_stream(
+  const upload_candidate& candidate, uint64_t offset, uint64_t length) {
+    // the archival reads yield the disk to the produce and fetch traffic
+    if (candidate.coalesced.empty()) {
+        return candidate.source->reader().data_stream(
+          candidate.file_offset + offset,
+          candidate.file_offset + offset + length,
+          archival_priority());
+    }
+    std::vector<ss::input_stream<char>> parts;
+    // position of the current segment file range within the upload
+    uint64_t pos = 0;
+    auto add_part = [&](
+                      const ss::lw_shared_ptr<storage::segment>& segment,
+                      uint64_t file_offset) {
+        auto size = segment->reader().file_size() - file_offset;
+        auto begin = std::max(offset, pos);
+        auto end = std::min(offset + length, pos + size);
+        if (begin < end) {
+            parts.push_back(segment->reader().data_stream(
+              file_offset + begin - pos,
+              file_offset + end - pos,
+              archival_priority()));
+        }
+        pos += size;
+    };
+    add_part(candidate.source, candidate.file_offset);
+    for (const auto& segment : candidate.coalesced) {
+        add_part(segment, 0);
+    }
+    return input_stream_concat(std::move(parts));
 }
 
 // from offset to offset (by record batch boundary)
@@ -123,11 +317,13 @@ ss::future<cloud_storage::upload_result> ntp_archiver::upload_segment(
     retry_chain_logger ctxlog(archival_log, fib, _ntp.path());
     vlog(ctxlog.debug, "Uploading segment {}", candidate);
 
-    auto reset_func = [candidate] {
-        auto stream = candidate.source->reader().data_stream(
-          candidate.file_offset,
-          candidate.final_file_offset,
-          ss::default_priority_class());
+    // large segments are uploaded in parts, each part reads its own range of
+    // the segment file
+    auto reset_func = [this, candidate](uint64_t offset, uint64_t length) {
+        auto stream = make_upload_stream(candidate, offset, length);
+        if (_throttle) {
+            return _throttle->get().wrap(std::move(stream));
+        }
         return stream;
     };
     co_return co_await _remote.upload_segment(
@@ -347,6 +543,9 @@ ss::future<ntp_archiver::batch_result> ntp_archiver::wait_all_scheduled_uploads(
         const auto& upload = scheduled[ixupload[i]];
         _probe.uploaded(*upload.delta);
         _manifest.add(segment_name(*upload.name), *upload.meta);
+        if (_max_manifest_deltas > 0) {
+            _manifest_delta.add(segment_name(*upload.name), *upload.meta);
+        }
     }
     if (total.num_succeded != 0) {
         vlog(
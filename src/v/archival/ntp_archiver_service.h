@@ -12,6 +12,7 @@
 #include "archival/archival_policy.h"
 #include "archival/probe.h"
 #include "archival/types.h"
+#include "cloud_storage/bandwidth_throttle.h"
 #include "cloud_storage/manifest.h"
 #include "cloud_storage/remote.h"
 #include "cloud_storage/types.h"
@@ -54,6 +55,18 @@ struct configuration {
     /// Upload time limit (if segment is not uploaded this amount of time the
     /// upload is triggered)
     std::optional<segment_time_limit> time_limit;
+    /// Bandwidth of the segment uploads of the shard in bytes per second, 0
+    /// if unlimited
+    size_t upload_bandwidth{0};
+    /// Encoding of the uploaded partition manifests
+    cloud_storage::manifest_format manifest_format{
+      cloud_storage::manifest_format::json};
+    /// Max number of manifest deltas uploaded before the full manifest is
+    /// re-uploaded, the delta layout is not used if 0
+    size_t manifest_max_deltas{0};
+    /// Max size of the upload object that combines small closed segments,
+    /// the segments are uploaded one by one if 0
+    size_t upload_coalesce_size{0};
 };
 
 std::ostream& operator<<(std::ostream& o, const configuration& cfg);
@@ -78,12 +91,16 @@ public:
     /// \param conf is an S3 client configuration
     /// \param remote is an object used to send/recv data
     /// \param svc_probe is a service level probe (optional)
+    /// \param throttle limits the bandwidth of the segment uploads (optional)
     ntp_archiver(
       const storage::ntp_config& ntp,
       const configuration& conf,
       cloud_storage::remote& remote,
       ss::lw_shared_ptr<cluster::partition> part,
-      service_probe& svc_probe);
+      service_probe& svc_probe,
+      std::optional<std::reference_wrapper<cloud_storage::bandwidth_throttle>>
+        throttle
+      = std::nullopt);
 
     /// Stop archiver.
     ///
@@ -107,11 +124,23 @@ public:
     download_manifest(retry_chain_node& parent);
 
     /// Upload manifest to the pre-defined S3 location
+    ///
+    /// When the delta layout is used only the segments added since the
+    /// previous upload are uploaded as a delta object, the full manifest is
+    /// uploaded as a new generation once the max number of deltas is reached
     ss::future<cloud_storage::upload_result>
     upload_manifest(retry_chain_node& parent);
 
     const cloud_storage::manifest& get_remote_manifest() const;
 
+    /// \brief How close the local data that is not uploaded yet is to be
+    /// removed by the local retention
+    ///
+    /// \param lm is a log manager instance
+    /// \return fraction of the retention limit, by time or by size, consumed
+    ///         by the data not uploaded yet, 0 if everything is uploaded
+    double upload_urgency(storage::log_manager& lm) const;
+
     struct batch_result {
         size_t num_succeded;
         size_t num_failed;
@@ -179,17 +208,30 @@ private:
     ss::future<cloud_storage::upload_result>
     upload_segment(upload_candidate candidate, retry_chain_node& fib);
 
+    /// Remove the deltas of the manifest generation, best effort
+    ss::future<>
+    remove_manifest_deltas(uint64_t generation, retry_chain_node& parent);
+
     service_probe& _svc_probe;
     ntp_level_probe _probe;
     model::ntp _ntp;
     model::revision_id _rev;
     cloud_storage::remote& _remote;
     ss::lw_shared_ptr<cluster::partition> _partition;
+    std::optional<std::reference_wrapper<cloud_storage::bandwidth_throttle>>
+      _throttle;
     archival_policy _policy;
     s3::bucket_name _bucket;
     /// Remote manifest contains representation of the data stored in S3 (it
     /// gets uploaded to the remote location)
     cloud_storage::manifest _manifest;
+    /// Segments added to the manifest after the last upload when the delta
+    /// layout is used
+    cloud_storage::manifest _manifest_delta;
+    size_t _max_manifest_deltas;
+    /// Sequence number of the next delta of the manifest generation, the
+    /// full manifest is uploaded when it reaches the max number of deltas
+    size_t _next_delta_seq;
     ss::gate _gate;
     ss::abort_source _as;
     ss::semaphore _mutex{1};
@@ -41,8 +41,6 @@
 #include <seastar/core/smp.hh>
 #include <seastar/core/when_all.hh>
 
-#include <boost/iterator/counting_iterator.hpp>
-
 #include <algorithm>
 #include <exception>
 #include <optional>
@@ -147,7 +145,19 @@ scheduler_service_impl::get_archival_service_config() {
         static_cast<bool>(disable_metrics)),
       .ntp_metrics_disabled = per_ntp_metrics_disabled(
         static_cast<bool>(disable_metrics)),
-      .time_limit = time_limit_opt};
+      .time_limit = time_limit_opt,
+      .upload_bandwidth = config::shard_local_cfg()
+                            .cloud_storage_max_upload_bandwidth.value()
+                            .value_or(0)
+                          / ss::smp::count,
+      .manifest_format
+      = config::shard_local_cfg().cloud_storage_manifest_binary_format()
+          ? cloud_storage::manifest_format::binary
+          : cloud_storage::manifest_format::json,
+      .manifest_max_deltas
+      = config::shard_local_cfg().cloud_storage_manifest_max_deltas(),
+      .upload_coalesce_size
+      = config::shard_local_cfg().cloud_storage_upload_coalesce_size()};
     vlog(archival_log.debug, "Archival configuration generated: {}", cfg);
     co_return cfg;
 }
@@ -169,7 +179,8 @@ scheduler_service_impl::scheduler_service_impl(
   , _probe(conf.svc_metrics_disabled)
   , _remote(remote)
   , _topic_manifest_upload_timeout(conf.manifest_upload_timeout)
-  , _initial_backoff(conf.initial_backoff) {}
+  , _initial_backoff(conf.initial_backoff)
+  , _throttle(conf.upload_bandwidth) {}
 
 scheduler_service_impl::scheduler_service_impl(
   ss::sharded<cloud_storage::remote>& remote,
@@ -204,6 +215,7 @@ ss::future<> scheduler_service_impl::stop() {
     vlog(_rtclog.info, "Scheduler service stop");
     _timer.cancel();
     _as.request_abort(); // interrupt possible sleep
+    _throttle.shutdown();
     std::vector<ss::future<>> outstanding;
     for (auto& it : _queue) {
         auto fut = ss::with_semaphore(
@@ -329,7 +341,12 @@ scheduler_service_impl::create_archivers(std::vector<model::ntp> to_create) {
                           return ss::now();
                       }
                       auto svc = ss::make_lw_shared<ntp_archiver>(
-                        log->config(), _conf, _remote.local(), part, _probe);
+                        log->config(),
+                        _conf,
+                        _remote.local(),
+                        part,
+                        _probe,
+                        std::ref(_throttle));
                       return ss::repeat([this, svc = std::move(svc)] {
                           return add_ntp_archiver(svc);
                       });
@@ -422,37 +439,40 @@ ss::future<> scheduler_service_impl::run_uploads() {
         static constexpr ss::lowres_clock::duration max_backoff = 10s;
         ss::lowres_clock::duration backoff = initial_backoff;
         while (!_gate.is_closed()) {
-            int quota = _queue.size();
-            std::vector<ss::future<ntp_archiver::batch_result>> flist;
-
-            std::transform(
-              boost::make_counting_iterator(0),
-              boost::make_counting_iterator(quota),
-              std::back_inserter(flist),
-              [this](int) {
-                  auto archiver = _queue.get_upload_candidate();
-                  storage::api& api = _storage_api.local();
-                  storage::log_manager& lm = api.log_mgr();
-                  vlog(
-                    _rtclog.debug,
-                    "Checking {} for S3 upload candidates",
-                    archiver->get_ntp());
-                  return archiver->upload_next_candidates(lm, _rtcnode);
+            storage::log_manager& lm = _storage_api.local().log_mgr();
+            // the archivers with the data closest to be removed by the local
+            // retention start first, they get the connections and the upload
+            // bandwidth first
+            std::vector<std::pair<double, ss::lw_shared_ptr<ntp_archiver>>>
+              candidates;
+            candidates.reserve(_queue.size());
+            for (const auto& [ntp, item] : _queue) {
+                candidates.emplace_back(
+                  item.archiver->upload_urgency(lm), item.archiver);
+            }
+            std::stable_sort(
+              candidates.begin(),
+              candidates.end(),
+              [](const auto& lhs, const auto& rhs) {
+                  return lhs.first > rhs.first;
               });
 
-            auto results = co_await ss::when_all_succeed(
-              flist.begin(), flist.end());
-
-            auto total = std::accumulate(
-              results.begin(),
-              results.end(),
-              ntp_archiver::batch_result(),
-              [](
-                const ntp_archiver::batch_result& lhs,
-                const ntp_archiver::batch_result& rhs) {
-                  return ntp_archiver::batch_result{
-                    .num_succeded = lhs.num_succeded + rhs.num_succeded,
-                    .num_failed = lhs.num_failed + rhs.num_failed};
+            ntp_archiver::batch_result total{};
+            co_await ss::max_concurrent_for_each(
+              candidates,
+              std::max<size_t>(1, _remote.local().concurrency()),
+              [this, &lm, &total](const auto& candidate) {
+                  const auto& [urgency, archiver] = candidate;
+                  vlog(
+                    _rtclog.debug,
+                    "Checking {} for S3 upload candidates, urgency {:.2f}",
+                    archiver->get_ntp(),
+                    urgency);
+                  return archiver->upload_next_candidates(lm, _rtcnode)
+                    .then([&total](ntp_archiver::batch_result res) {
+                        total.num_succeded += res.num_succeded;
+                        total.num_failed += res.num_failed;
+                    });
               });
 
             if (total.num_failed != 0) {
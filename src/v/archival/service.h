@@ -10,6 +10,7 @@
 
 #pragma once
 #include "archival/ntp_archiver_service.h"
+#include "cloud_storage/bandwidth_throttle.h"
 #include "cloud_storage/manifest.h"
 #include "cluster/partition_manager.h"
 #include "model/fundamental.h"
@@ -89,8 +90,9 @@ void ntp_upload_queue::copy_if(FwdIt out, const Func& pred) const {
 /// archivers gets removed and new are added. The service runs a simple
 /// workflow on its working set:
 /// - Reconcile working set
-/// - Choose next candidate(s) archiver(s)
-/// - Start configured number of uploads
+/// - Order the archivers by the urgency of their uploads
+/// - Start configured number of uploads, limited by the shard's share of the
+///   node-wide upload bandwidth
 /// - Re-upload manifest(s)
 /// - Reset timer
 class scheduler_service_impl {
@@ -183,6 +185,7 @@ private:
     ss::sharded<cloud_storage::remote>& _remote;
     ss::lowres_clock::duration _topic_manifest_upload_timeout;
     ss::lowres_clock::duration _initial_backoff;
+    cloud_storage::bandwidth_throttle _throttle;
 };
 
 } // namespace internal
@@ -20,6 +20,7 @@
 #include "storage/disk_log_impl.h"
 #include "storage/parser.h"
 #include "test_utils/fixture.h"
+#include "units.h"
 #include "utils/retry_chain_node.h"
 #include "utils/unresolved_address.h"
 
@@ -342,6 +343,61 @@ FIXTURE_TEST(test_archiver_policy, archiver_fixture) {
     BOOST_REQUIRE(upload5.source.get() == nullptr);
 }
 
+// NOLINTNEXTLINE
+FIXTURE_TEST(test_archiver_policy_coalesce, archiver_fixture) {
+    model::offset lso = model::offset::max();
+    std::vector<segment_desc> segments = {
+      {manifest_ntp, model::offset(0), model::term_id(1)},
+      {manifest_ntp, std::nullopt, model::term_id(1)},
+      {manifest_ntp, std::nullopt, model::term_id(1)},
+      {manifest_ntp, std::nullopt, model::term_id(2)},
+    };
+    init_storage_api_local(segments);
+    auto& lm = get_local_storage_api().log_mgr();
+    ntp_level_probe ntp_probe(per_ntp_metrics_disabled::yes, manifest_ntp);
+    service_probe svc_probe(service_metrics_disabled::yes);
+    archival::archival_policy policy(
+      manifest_ntp, svc_probe, ntp_probe, std::nullopt, 1_MiB);
+
+    log_segment_set(lm);
+    // the segments of the first term are combined into one upload
+    auto upload1 = policy.get_next_candidate(model::offset(0), lso, lm).get();
+    log_upload_candidate(upload1);
+    BOOST_REQUIRE(upload1.source.get() != nullptr);
+    BOOST_REQUIRE_EQUAL(upload1.starting_offset, model::offset(0));
+    BOOST_REQUIRE_EQUAL(upload1.coalesced.size(), 2);
+    auto size = upload1.source->reader().file_size();
+    for (const auto& s : upload1.coalesced) {
+        size += s->reader().file_size();
+    }
+    BOOST_REQUIRE_EQUAL(upload1.content_length, size);
+    BOOST_REQUIRE_EQUAL(
+      upload1.final_offset, upload1.coalesced.back()->offsets().dirty_offset);
+
+    auto upload2 = policy
+                     .get_next_candidate(
+                       upload1.final_offset + model::offset(1), lso, lm)
+                     .get();
+    log_upload_candidate(upload2);
+    BOOST_REQUIRE(upload2.source.get() != nullptr);
+    BOOST_REQUIRE_EQUAL(upload2.source->offsets().term, model::term_id(2));
+    BOOST_REQUIRE(upload2.coalesced.empty());
+
+    // the coalesced upload can't exceed the coalesce size
+    archival::archival_policy small_policy(
+      manifest_ntp,
+      svc_probe,
+      ntp_probe,
+      std::nullopt,
+      upload1.source->reader().file_size());
+    auto upload3
+      = small_policy.get_next_candidate(model::offset(0), lso, lm).get();
+    BOOST_REQUIRE(upload3.source.get() != nullptr);
+    BOOST_REQUIRE(upload3.coalesced.empty());
+    BOOST_REQUIRE_EQUAL(
+      upload3.final_offset, upload3.source->offsets().dirty_offset);
+}
+
 // NOLINTNEXTLINE
 FIXTURE_TEST(test_upload_segments_leadership_transfer, archiver_fixture) {
     // This test simulates leadership transfer. In this situation the
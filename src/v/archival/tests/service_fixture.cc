@@ -290,6 +290,7 @@ void archiver_fixture::init_storage_api_local(std::vector<segment_desc>& segm) {
 void archiver_fixture::initialize_shard(
   storage::api& api, const std::vector<segment_desc>& segm) {
     absl::flat_hash_map<model::ntp, size_t> all_ntp;
+    absl::flat_hash_map<model::ntp, model::offset> next_offset;
     for (const auto& d : segm) {
         storage::ntp_config ntpc(d.ntp, data_dir.string());
         storage::directories::initialize(ntpc.work_directory()).get();
@@ -297,7 +298,7 @@ void archiver_fixture::initialize_shard(
         auto seg = api.log_mgr()
                      .make_log_segment(
                        storage::ntp_config(d.ntp, data_dir.string()),
-                       d.base_offset,
+                       d.base_offset.value_or(next_offset[d.ntp]),
                        d.term,
                        ss::default_priority_class())
                      .get0();
@@ -305,6 +306,7 @@ void archiver_fixture::initialize_shard(
         auto layout = write_random_batches(
           seg, d.num_batches ? d.num_batches.value() : 1);
         layouts[d.ntp].push_back(std::move(layout));
+        next_offset[d.ntp] = seg->offsets().dirty_offset + model::offset(1);
         vlog(fixt_log.trace, "segment close");
         seg->close().get();
         all_ntp[d.ntp] += 1;
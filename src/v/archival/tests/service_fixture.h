@@ -89,7 +89,9 @@ private:
 
 struct segment_desc {
     model::ntp ntp;
-    model::offset base_offset;
+    /// The segment starts right after the previous segment of the ntp if not
+    /// set
+    std::optional<model::offset> base_offset;
     model::term_id term;
     std::optional<size_t> num_batches;
 };
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "bytes/details/io_allocation_size.h"
+#include "seastarx.h"
+
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/temporary_buffer.hh>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace details {
+
+/// Shard local cache of the buffers of the iobuf fragments.
+///
+/// The buffers of the io_allocation_size::alloc_table size classes are kept
+/// in per size class free lists when the fragments using them are released,
+/// and reused by the next fragments of the same size class instead of being
+/// allocated again. The cached buffers are bounded by max_cached_bytes, the
+/// buffers released past the bound are freed. The pool is disabled and the
+/// buffers allocated as plain temporary buffers until it is started.
+///
+/// Buffers released on another shard or after the pool was destroyed are
+/// freed, they never move between shards.
+class io_fragment_pool {
+public:
+    static constexpr size_t size_classes
+      = io_allocation_size::alloc_table.size();
+
+    struct stats {
+        // buffers of a size class requested
+        uint64_t allocations{0};
+        // requested buffers that were served from the pool
+        uint64_t hits{0};
+        // buffers released that were freed because the pool was full
+        uint64_t dropped{0};
+        size_t cached_bytes{0};
+    };
+
+    io_fragment_pool(const io_fragment_pool&) = delete;
+    io_fragment_pool& operator=(const io_fragment_pool&) = delete;
+    io_fragment_pool(io_fragment_pool&&) = delete;
+    io_fragment_pool& operator=(io_fragment_pool&&) = delete;
+    ~io_fragment_pool() noexcept;
+
+    void start(size_t max_cached_bytes, bool disable_metrics);
+    /// Frees the cached buffers and disables the pool
+    void stop();
+
+    /// Buffer of the given size, from the pool when the size is one of the
+    /// size classes
+    ss::temporary_buffer<char> allocate(size_t size);
+
+    const stats& get_stats() const { return _stats; }
+
+private:
+    friend io_fragment_pool& fragment_pool();
+    io_fragment_pool() noexcept;
+
+    // intrusive free list node stored in the cached buffer itself
+    struct free_buffer {
+        free_buffer* next;
+    };
+
+    /// Index of the size class of the size, size_classes if it is not one
+    static size_t size_class(size_t size);
+    void release(char*, size_t cls) noexcept;
+    void clear() noexcept;
+    void setup_metrics();
+
+    size_t _max_cached_bytes{0};
+    std::array<free_buffer*, size_classes> _free{};
+    stats _stats;
+    ss::metrics::metric_groups _metrics;
+};
+
+/// Fragment buffer pool of the shard
+io_fragment_pool& fragment_pool();
+
+} // namespace details
@@ -0,0 +1,145 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/details/io_fragment_pool.h"
+
+#include "prometheus/prometheus_sanitize.h"
+
+#include <seastar/core/metrics.hh>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace details {
+
+// the pool of the thread while it is alive. the storage of a trivially
+// destructible thread local outlives the pool, so buffers released by the
+// other thread locals destroyed after it are freed instead of cached
+static thread_local io_fragment_pool* live_pool = nullptr;
+
+io_fragment_pool::io_fragment_pool() noexcept { live_pool = this; }
+
+io_fragment_pool::~io_fragment_pool() noexcept {
+    live_pool = nullptr;
+    clear();
+}
+
+void io_fragment_pool::start(size_t max_cached_bytes, bool disable_metrics) {
+    _max_cached_bytes = max_cached_bytes;
+    if (!disable_metrics) {
+        setup_metrics();
+    }
+}
+
+void io_fragment_pool::stop() {
+    _max_cached_bytes = 0;
+    _metrics.clear();
+    clear();
+}
+
+size_t io_fragment_pool::size_class(size_t size) {
+    const auto& table = io_allocation_size::alloc_table;
+    auto it = std::lower_bound(table.begin(), table.end(), size);
+    if (it == table.end() || *it != size) {
+        return size_classes;
+    }
+    return std::distance(table.begin(), it);
+}
+
+ss::temporary_buffer<char> io_fragment_pool::allocate(size_t size) {
+    auto cls = size_class(size);
+    if (_max_cached_bytes == 0 || cls == size_classes) {
+        return ss::temporary_buffer<char>(size);
+    }
+    ++_stats.allocations;
+    char* p = nullptr;
+    if (auto* f = _free[cls]; f != nullptr) {
+        _free[cls] = f->next;
+        _stats.cached_bytes -= size;
+        ++_stats.hits;
+        p = reinterpret_cast<char*>(f); // NOLINT
+    } else {
+        p = static_cast<char*>(std::malloc(size)); // NOLINT
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+    }
+    try {
+        return ss::temporary_buffer<char>(
+          p, size, ss::make_deleter([this, p, cls] {
+              if (live_pool == this) {
+                  release(p, cls);
+              } else {
+                  std::free(p); // NOLINT
+              }
+          }));
+    } catch (...) {
+        std::free(p); // NOLINT
+        throw;
+    }
+}
+
+void io_fragment_pool::release(char* p, size_t cls) noexcept {
+    auto size = io_allocation_size::alloc_table[cls];
+    if (_stats.cached_bytes + size > _max_cached_bytes) {
+        if (_max_cached_bytes > 0) {
+            ++_stats.dropped;
+        }
+        std::free(p); // NOLINT
+        return;
+    }
+    _free[cls] = new (p) free_buffer{.next = _free[cls]};
+    _stats.cached_bytes += size;
+}
+
+void io_fragment_pool::clear() noexcept {
+    for (auto& head : _free) {
+        while (head != nullptr) {
+            auto* next = head->next;
+            std::free(head); // NOLINT
+            head = next;
+        }
+    }
+    _stats.cached_bytes = 0;
+}
+
+void io_fragment_pool::setup_metrics() {
+    namespace sm = ss::metrics;
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("iobuf"),
+      {
+        sm::make_derive(
+          "fragment_allocations",
+          [this] { return _stats.allocations; },
+          sm::description("Number of fragment buffers of a size class "
+                          "requested by iobufs")),
+        sm::make_derive(
+          "fragment_pool_hits",
+          [this] { return _stats.hits; },
+          sm::description(
+            "Number of fragment buffers reused from the fragment pool")),
+        sm::make_derive(
+          "fragment_pool_dropped",
+          [this] { return _stats.dropped; },
+          sm::description("Number of released fragment buffers freed because "
+                          "the fragment pool was full")),
+        sm::make_gauge(
+          "fragment_pool_cached_bytes",
+          [this] { return _stats.cached_bytes; },
+          sm::description("Bytes of the buffers cached in the fragment pool")),
+      });
+}
+
+io_fragment_pool& fragment_pool() {
+    static thread_local io_fragment_pool pool;
+    return pool;
+}
+
+} // namespace details
@@ -19,8 +19,56 @@
 
 #include <seastar/core/sstring.hh>
 
+#include <array>
 #include <memory>
 
+namespace details {
+
+inline const uint8_t* segment_data(const iobuf::iterator_consumer& in) {
+    return reinterpret_cast<const uint8_t*>(in.segment_data()); // NOLINT
+}
+
+/// Reads a varlong from the consumer, decoded in place when it cannot cross
+/// the fragment end
+inline std::pair<int64_t, uint8_t> read_varlong(iobuf::iterator_consumer& in) {
+    if (likely(in.segment_bytes_left() >= vint::max_length)) {
+        auto [val, length_size] = vint::deserialize(
+          segment_data(in), in.segment_bytes_left());
+        in.skip(length_size);
+        return {val, length_size};
+    }
+    auto [val, length_size] = vint::deserialize(in);
+    in.skip(length_size);
+    return {val, length_size};
+}
+
+/// Reads N consecutive varlongs. When none of them can cross the fragment end
+/// they are decoded in a single pass over the fragment and consumed at once.
+template<size_t N>
+std::array<int64_t, N> read_varlongs(iobuf::iterator_consumer& in) {
+    std::array<int64_t, N> ret;
+    const size_t available = in.segment_bytes_left();
+    if (likely(available >= N * vint::max_length)) {
+        const uint8_t* src = segment_data(in);
+        size_t pos = 0;
+        for (auto& v : ret) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            auto [val, length_size] = vint::deserialize(
+              src + pos, available - pos);
+            v = val;
+            pos += length_size;
+        }
+        in.skip(pos);
+        return ret;
+    }
+    for (auto& v : ret) {
+        v = read_varlong(in).first;
+    }
+    return ret;
+}
+
+} // namespace details
+
 /**
  * iobuf parser interface suitable for an iobuf passed by const-ref. also
  * accepts an iobuf value. in both cases it is safe to move this type, but when
@@ -46,9 +94,13 @@ public:
     size_t bytes_consumed() const { return _in.bytes_consumed(); }
 
     std::pair<int64_t, uint8_t> read_varlong() {
-        auto [val, length_size] = vint::deserialize(_in);
-        _in.skip(length_size);
-        return {val, length_size};
+        return details::read_varlong(_in);
+    }
+
+    /// Reads N consecutive varlongs, see details::read_varlongs
+    template<size_t N>
+    std::array<int64_t, N> read_varlongs() {
+        return details::read_varlongs<N>(_in);
     }
 
     ss::sstring read_string(size_t len) {
@@ -9,6 +9,7 @@
 
 #include "bytes/bytes.h"
 #include "bytes/details/io_allocation_size.h"
+#include "bytes/details/io_fragment_pool.h"
 #include "bytes/iobuf.h"
 #include "bytes/iobuf_istreambuf.h"
 #include "bytes/iobuf_ostreambuf.h"
@@ -17,6 +18,7 @@
 
 #include <seastar/core/temporary_buffer.hh>
 #include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/defer.hh>
 
 #include <boost/range/algorithm/for_each.hpp>
 #include <boost/test/tools/old/interface.hpp>
@@ -645,3 +647,45 @@ SEASTAR_THREAD_TEST_CASE(iobuf_parser_peek) {
     auto dst_b = parser.copy(1000);
     BOOST_REQUIRE(dst_a == dst_b);
 }
+
+SEASTAR_THREAD_TEST_CASE(iobuf_fragment_pool_reuse) {
+    auto& pool = details::fragment_pool();
+    pool.start(1024 * 1024, true);
+    auto stop = ss::defer([&pool] { pool.stop(); });
+    const auto& stats = pool.get_stats();
+    auto hits = stats.hits;
+    {
+        iobuf buf;
+        append_sequence(buf, 1);
+    }
+    BOOST_REQUIRE_GT(stats.cached_bytes, 0);
+    {
+        iobuf buf;
+        append_sequence(buf, 1);
+        BOOST_REQUIRE_EQUAL(stats.hits, hits + 1);
+        BOOST_REQUIRE_EQUAL(stats.cached_bytes, 0);
+        // a shared fragment goes back to the pool once all the shares are
+        // released
+        auto shared = buf.share(0, buf.size_bytes());
+        buf.clear();
+        BOOST_REQUIRE_EQUAL(stats.cached_bytes, 0);
+        BOOST_REQUIRE_EQUAL(shared.size_bytes(), characters_per_append);
+    }
+    BOOST_REQUIRE_GT(stats.cached_bytes, 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(iobuf_fragment_pool_is_bounded) {
+    auto& pool = details::fragment_pool();
+    const size_t max = details::io_allocation_size::max_chunk_size;
+    pool.start(max, true);
+    auto stop = ss::defer([&pool] { pool.stop(); });
+    const auto& stats = pool.get_stats();
+    auto dropped = stats.dropped;
+    {
+        iobuf buf;
+        auto data = random_generators::gen_alphanum_string(4 * max);
+        buf.append(data.data(), data.size());
+    }
+    BOOST_REQUIRE_LE(stats.cached_bytes, max);
+    BOOST_REQUIRE_GT(stats.dropped, dropped);
+}
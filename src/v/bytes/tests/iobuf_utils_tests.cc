@@ -8,9 +8,13 @@
 // by the Apache License, Version 2.0
 
 #include "bytes/tests/utils.h"
+#include "bytes/utils.h"
+#include "hashing/crc32c.h"
 
 #include <seastar/testing/thread_test_case.hh>
 
+#include <numeric>
+
 SEASTAR_THREAD_TEST_CASE(test_reading_zero_bytes_empty_stream) {
     auto buf = iobuf();
     auto is = make_iobuf_input_stream(std::move(buf));
@@ -54,3 +58,28 @@ SEASTAR_THREAD_TEST_CASE(test_bytes_conversion) {
     BOOST_REQUIRE_EQUAL(
       absl::Hash<iobuf>{}(buf), absl::Hash<iobuf>{}(converted_back));
 }
+
+SEASTAR_THREAD_TEST_CASE(test_crc_extend_fragmented_iobuf) {
+    // runs of small fragments, staged or not, between large fragments
+    const std::vector<size_t> sizes = {
+      1, 13, 64, 700, 767, 768, 5000, 9, 4096, 4095, 2, 1, 100000, 3, 511};
+    auto data = random_generators::gen_alphanum_string(
+      std::accumulate(sizes.begin(), sizes.end(), size_t(0)));
+    iobuf buf;
+    size_t pos = 0;
+    for (auto sz : sizes) {
+        iobuf part;
+        part.append(data.data() + pos, sz);
+        buf.append_fragments(std::move(part));
+        pos += sz;
+    }
+    BOOST_REQUIRE_GE(
+      std::distance(buf.begin(), buf.end()),
+      static_cast<std::ptrdiff_t>(sizes.size()));
+
+    crc::crc32c expected;
+    expected.extend(data.data(), data.size());
+    crc::crc32c crc;
+    crc_extend_iobuf(crc, buf);
+    BOOST_REQUIRE_EQUAL(crc.value(), expected.value());
+}
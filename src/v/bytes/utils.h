@@ -13,11 +13,45 @@
 #include "bytes/iobuf.h"
 #include "hashing/crc32c.h"
 
+#include <array>
+#include <cstring>
+
+namespace details {
+// the crc32c library interleaves 3 hardware crc lanes on inputs of at least
+// 3 blocks of 256 bytes, smaller inputs are hashed by a single lane
+inline constexpr size_t crc_min_interleaved_bytes = 768;
+inline constexpr size_t crc_staging_bytes = 4096;
+} // namespace details
+
+/// \brief extends the crc with the contents of the buffer.
+///
+/// Runs of fragments too small for the interleaved lanes of the crc32c
+/// library, e.g. the fragments of a batch received from the network, are
+/// copied to a staging buffer and hashed at once. The other fragments are
+/// hashed in place.
 inline void crc_extend_iobuf(crc::crc32c& crc, const iobuf& buf) {
+    std::array<char, details::crc_staging_bytes> staging; // NOLINT
+    size_t staged = 0;
+    auto flush = [&crc, &staging, &staged] {
+        if (staged > 0) {
+            crc.extend(staging.data(), staged);
+            staged = 0;
+        }
+    };
     auto in = iobuf::iterator_consumer(buf.cbegin(), buf.cend());
-    (void)in.consume(buf.size_bytes(), [&crc](const char* src, size_t sz) {
-        // NOLINTNEXTLINE
-        crc.extend(reinterpret_cast<const uint8_t*>(src), sz);
+    (void)in.consume(buf.size_bytes(), [&](const char* src, size_t sz) {
+        if (sz >= details::crc_min_interleaved_bytes) {
+            flush();
+            crc.extend(src, sz);
+            return ss::stop_iteration::no;
+        }
+        if (staged + sz > staging.size()) {
+            flush();
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(staging.data() + staged, src, sz);
+        staged += sz;
         return ss::stop_iteration::no;
     });
+    flush();
 }
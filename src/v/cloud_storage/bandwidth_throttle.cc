@@ -0,0 +1,97 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "cloud_storage/bandwidth_throttle.h"
+
+#include <seastar/core/coroutine.hh>
+
+#include <algorithm>
+
+namespace cloud_storage {
+
+namespace {
+
+class throttled_data_source final : public ss::data_source_impl {
+public:
+    throttled_data_source(
+      ss::input_stream<char> in, bandwidth_throttle& throttle)
+      : _in(std::move(in))
+      , _throttle(throttle) {}
+
+    ss::future<ss::temporary_buffer<char>> get() final {
+        auto buf = co_await _in.read();
+        if (!buf.empty()) {
+            co_await _throttle.throttle(buf.size());
+        }
+        co_return buf;
+    }
+
+    ss::future<> close() final { return _in.close(); }
+
+private:
+    ss::input_stream<char> _in;
+    bandwidth_throttle& _throttle;
+};
+
+} // namespace
+
+bandwidth_throttle::bandwidth_throttle(size_t rate)
+  : _rate(rate)
+  , _tokens(rate)
+  , _last_refill(clock_type::now())
+  , _refill_timer([this] { refill(); }) {}
+
+ss::future<> bandwidth_throttle::throttle(size_t size) {
+    if (_rate == 0) {
+        return ss::now();
+    }
+    refill();
+    // requests larger than the bucket are charged the whole bucket, they
+    // would never be served otherwise
+    auto f = _tokens.wait(std::min(size, _rate));
+    if (_tokens.waiters() && !_refill_timer.armed()) {
+        _refill_timer.arm(refill_interval);
+    }
+    return f;
+}
+
+ss::input_stream<char> bandwidth_throttle::wrap(ss::input_stream<char> in) {
+    if (_rate == 0) {
+        return in;
+    }
+    return ss::input_stream<char>(ss::data_source(
+      std::make_unique<throttled_data_source>(std::move(in), *this)));
+}
+
+void bandwidth_throttle::shutdown() {
+    _refill_timer.cancel();
+    _tokens.broken();
+}
+
+void bandwidth_throttle::refill() {
+    auto now = clock_type::now();
+    auto elapsed = now - _last_refill;
+    if (elapsed >= refill_interval) {
+        _last_refill = now;
+        auto available = _tokens.available_units();
+        auto capacity = static_cast<ssize_t>(_rate);
+        auto tokens = static_cast<ssize_t>(
+          _rate * elapsed / std::chrono::milliseconds(1000));
+        // the bucket doesn't accumulate more than a second worth of tokens
+        // while the transfers are idle
+        _tokens.signal(std::max<ssize_t>(
+          0, std::min(tokens, capacity - std::max<ssize_t>(available, 0))));
+    }
+    if (_tokens.waiters() && !_refill_timer.armed()) {
+        _refill_timer.arm(refill_interval);
+    }
+}
+
+} // namespace cloud_storage
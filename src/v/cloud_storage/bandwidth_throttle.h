@@ -0,0 +1,59 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#pragma once
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/iostream.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/timer.hh>
+
+#include <chrono>
+
+namespace cloud_storage {
+
+/// Token bucket limiting the bandwidth of the segment transfers of a shard,
+/// used by the archival uploads and by the partition recovery downloads.
+///
+/// The bucket holds at most one second worth of tokens and is refilled while
+/// there are waiters. Waiters are served in FIFO order, the transfers started
+/// first (e.g. the most urgent uploads) get the bandwidth first. The rate of 0
+/// disables throttling.
+class bandwidth_throttle {
+    using clock_type = ss::lowres_clock;
+    static constexpr std::chrono::milliseconds refill_interval{50};
+
+public:
+    /// \param rate is a number of bytes per second
+    explicit bandwidth_throttle(size_t rate);
+
+    /// Wait until `size` bytes can be transferred
+    ss::future<> throttle(size_t size);
+
+    /// Wrap the stream, every buffer read from the stream is throttled
+    ss::input_stream<char> wrap(ss::input_stream<char> in);
+
+    /// Fail all waiters and the subsequent throttle requests
+    void shutdown();
+
+    size_t rate() const { return _rate; }
+
+private:
+    void refill();
+
+    size_t _rate;
+    ss::semaphore _tokens;
+    clock_type::time_point _last_refill;
+    ss::timer<clock_type> _refill_timer;
+};
+
+} // namespace cloud_storage
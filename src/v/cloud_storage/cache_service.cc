@@ -8,7 +8,9 @@
  * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
  */
 
+#include "bytes/iobuf_parser.h"
 #include "cloud_storage/logger.h"
+#include "utils/file_io.h"
 #include "utils/gate_guard.h"
 #include "vassert.h"
 #include "vlog.h"
@@ -22,6 +24,7 @@
 
 #include <cloud_storage/cache_service.h>
 
+#include <charconv>
 #include <exception>
 #include <stdexcept>
 #include <string_view>
@@ -44,21 +47,147 @@ std::ostream& operator<<(std::ostream& o, cache_element_status s) {
 }
 
 static constexpr std::string_view tmp_extension{".part"};
+static constexpr std::string_view index_filename{"cache_index"};
 
 cache::cache(
   std::filesystem::path cache_dir,
   size_t max_cache_size,
-  ss::lowres_clock::duration check_period) noexcept
+  ss::lowres_clock::duration check_period,
+  size_t max_read_ahead_bytes) noexcept
   : _cache_dir(std::move(cache_dir))
   , _max_cache_size(max_cache_size)
   , _check_period(check_period)
   , _cnt(0)
-  , _total_cleaned(0) {}
+  , _total_cleaned(0)
+  , _max_read_ahead_bytes(max_read_ahead_bytes)
+  , _read_ahead_budget(max_read_ahead_bytes) {}
 
 uint64_t cache::get_total_cleaned() { return _total_cleaned; }
 
+std::optional<ss::semaphore_units<>> cache::reserve_read_ahead(size_t size) {
+    auto available = static_cast<size_t>(_read_ahead_budget.available_units());
+    auto in_flight = _max_read_ahead_bytes - available;
+    auto room = _max_cache_size * (long double)_cache_size_low_watermark;
+    if (_current_size + in_flight + size > room) {
+        return std::nullopt;
+    }
+    return ss::try_get_units(_read_ahead_budget, size);
+}
+
+void cache::touch(const std::filesystem::path& key, size_t size) {
+    auto it = _index.find(key.native());
+    if (it == _index.end()) {
+        _lru.emplace_back(key.native());
+        _index.emplace(key.native(), index_entry{size, std::prev(_lru.end())});
+    } else {
+        _current_size -= it->second.size;
+        it->second.size = size;
+        _lru.splice(_lru.end(), _lru, it->second.lru_pos);
+    }
+    _current_size += size;
+}
+
+void cache::forget(const std::filesystem::path& key) {
+    auto it = _index.find(key.native());
+    if (it != _index.end()) {
+        _current_size -= it->second.size;
+        _lru.erase(it->second.lru_pos);
+        _index.erase(it);
+    }
+}
+
+ss::future<bool> cache::load_index() {
+    auto path = _cache_dir / index_filename;
+    if (!co_await ss::file_exists(path.native())) {
+        co_return false;
+    }
+    auto buf = co_await read_fully(path);
+    co_await ss::remove_file(path.native());
+
+    // the first line is the number of entries followed by one
+    // "<size> <key>" line per file, least recently used first
+    iobuf_parser parser(std::move(buf));
+    auto content = parser.read_string(parser.bytes_left());
+    std::string_view rest(content);
+    auto next_line = [&rest]() -> std::optional<std::string_view> {
+        auto eol = rest.find('\n');
+        if (eol == std::string_view::npos) {
+            return std::nullopt;
+        }
+        auto line = rest.substr(0, eol);
+        rest.remove_prefix(eol + 1);
+        return line;
+    };
+    auto parse_number = [](std::string_view s) -> std::optional<size_t> {
+        size_t value = 0;
+        auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+        if (ec != std::errc() || ptr != s.data() + s.size()) {
+            return std::nullopt;
+        }
+        return value;
+    };
+
+    auto header = next_line();
+    auto count = header ? parse_number(*header) : std::nullopt;
+    if (!count) {
+        co_return false;
+    }
+    for (size_t i = 0; i < *count; ++i) {
+        auto line = next_line();
+        auto sep = line ? line->find(' ') : std::string_view::npos;
+        auto size = sep != std::string_view::npos
+                      ? parse_number(line->substr(0, sep))
+                      : std::nullopt;
+        if (!size) {
+            _lru.clear();
+            _index.clear();
+            _current_size = 0;
+            co_return false;
+        }
+        touch(std::filesystem::path(line->substr(sep + 1)), *size);
+    }
+    co_return rest.empty();
+}
+
+ss::future<> cache::save_index() {
+    iobuf buf;
+    auto append = [&buf](std::string_view s) {
+        buf.append(s.data(), s.size());
+    };
+    append(fmt::format("{}\n", _index.size()));
+    for (const auto& key : _lru) {
+        append(fmt::format("{} {}\n", _index.find(key)->second.size, key));
+    }
+    // written to a tmp file first so that a partially written index is never
+    // loaded, the tmp file is removed by the directory walk on the next start
+    auto path = _cache_dir / index_filename;
+    auto tmp_path = (_cache_dir / index_filename).concat(tmp_extension);
+    co_await ss::recursive_touch_directory(_cache_dir.native());
+    co_await write_fully(tmp_path, std::move(buf));
+    co_await ss::rename_file(tmp_path.native(), path.native());
+}
+
 ss::future<> cache::clean_up_at_start() {
     gate_guard guard{_gate};
+    try {
+        if (co_await load_index()) {
+            vlog(
+              cst_log.debug,
+              "Restored cache index of {} files of total size {}.",
+              _index.size(),
+              _current_size);
+            co_return;
+        }
+    } catch (...) {
+        vlog(
+          cst_log.warn,
+          "Couldn't restore cache index, walking cache directory: {}",
+          std::current_exception());
+    }
+    _lru.clear();
+    _index.clear();
+    _current_size = 0;
+
     auto [unused, candidates_for_deletion] = co_await _walker.walk(
       _cache_dir.native());
 
@@ -82,70 +211,86 @@ ss::future<> cache::clean_up_at_start() {
                   filepath_to_remove,
                   e.what());
             }
+        } else {
+            // the files are sorted by access time, oldest first
+            touch(
+              std::filesystem::path(filepath_to_remove)
+                .lexically_relative(_cache_dir),
+              file_item.size);
         }
     }
     vlog(
       cst_log.debug,
-      "Clean up at start deleted files of total size {}.",
-      _total_cleaned);
+      "Clean up at start deleted files of total size {}, {} files of total "
+      "size {} are cached.",
+      _total_cleaned,
+      _index.size(),
+      _current_size);
 }
 
 ss::future<> cache::clean_up_cache() {
     gate_guard guard{_gate};
-    auto [curr_cache_size, candidates_for_deletion] = co_await _walker.walk(
-      _cache_dir.native());
+    if (_current_size < _max_cache_size) {
+        co_return;
+    }
+    auto size_to_delete
+      = _current_size
+        - (_max_cache_size * (long double)_cache_size_low_watermark);
 
-    if (curr_cache_size >= _max_cache_size) {
-        auto size_to_delete
-          = curr_cache_size
-            - (_max_cache_size * (long double)_cache_size_low_watermark);
-
-        uint64_t deleted_size = 0;
-        size_t i_to_delete = 0;
-        while (i_to_delete < candidates_for_deletion.size()
-               && deleted_size < size_to_delete) {
-            auto filename_to_remove = candidates_for_deletion[i_to_delete].path;
-            vassert(
-              std::string_view(filename_to_remove)
-                .starts_with(_cache_dir.native()),
-              "Tried to clean up {}, which is outside of cache_dir {}.",
-              filename_to_remove,
-              _cache_dir.native());
-
-            // skip tmp files since someone may be writing to it
-            if (!std::string_view(filename_to_remove)
-                   .ends_with(tmp_extension)) {
-                try {
-                    co_await ss::remove_file(filename_to_remove);
-                    deleted_size += candidates_for_deletion[i_to_delete].size;
-                } catch (std::exception& e) {
-                    vlog(
-                      cst_log.error,
-                      "Cache eviction couldn't delete {}: {}.",
-                      filename_to_remove,
-                      e.what());
-                }
+    // the files are removed from the index before they are deleted so that
+    // concurrent clean ups don't pick the same files
+    std::vector<std::pair<ss::sstring, size_t>> to_delete;
+    uint64_t deleted_size = 0;
+    while (!_lru.empty() && deleted_size < size_to_delete) {
+        auto key = _lru.front();
+        auto size = _index.find(key)->second.size;
+        forget(std::filesystem::path(key));
+        deleted_size += size;
+        to_delete.emplace_back(std::move(key), size);
+    }
+
+    for (auto& [key, size] : to_delete) {
+        auto filename_to_remove = (_cache_dir / key.c_str()).native();
+        vassert(
+          std::string_view(filename_to_remove).starts_with(_cache_dir.native()),
+          "Tried to clean up {}, which is outside of cache_dir {}.",
+          filename_to_remove,
+          _cache_dir.native());
+        try {
+            co_await ss::remove_file(filename_to_remove);
+        } catch (std::filesystem::filesystem_error& e) {
+            if (e.code() != std::errc::no_such_file_or_directory) {
+                vlog(
+                  cst_log.error,
+                  "Cache eviction couldn't delete {}: {}.",
+                  filename_to_remove,
+                  e.what());
             }
-            i_to_delete++;
+        } catch (std::exception& e) {
+            vlog(
+              cst_log.error,
+              "Cache eviction couldn't delete {}: {}.",
+              filename_to_remove,
+              e.what());
         }
-        _total_cleaned += deleted_size;
-        vlog(
-          cst_log.debug,
-          "Cache eviction deleted {} files of total size {}.",
-          i_to_delete,
-          deleted_size);
     }
+    _total_cleaned += deleted_size;
+    vlog(
+      cst_log.debug,
+      "Cache eviction deleted {} files of total size {}.",
+      to_delete.size(),
+      deleted_size);
 }
 
 ss::future<> cache::start() {
     vlog(cst_log.debug, "Starting archival cache service");
-    // TODO: implement more optimal cache eviction
-    if (ss::this_shard_id() == 0) {
-        co_await clean_up_at_start();
+    co_await clean_up_at_start();
 
-        _timer.set_callback([this] { return clean_up_cache(); });
-        _timer.arm_periodic(_check_period);
-    }
+    _timer.set_callback([this] {
+        (void)clean_up_cache().handle_exception_type(
+          [](const ss::gate_closed_exception&) {});
+    });
+    _timer.arm_periodic(_check_period);
 }
 
 ss::future<> cache::stop() {
@@ -153,6 +298,15 @@ ss::future<> cache::stop() {
     _timer.cancel();
     co_await _walker.stop();
     co_await _gate.close();
+    try {
+        co_await save_index();
+    } catch (...) {
+        vlog(
+          cst_log.warn,
+          "Couldn't save cache index, the cache directory will be walked on "
+          "the next start: {}",
+          std::current_exception());
+    }
 }
 
 ss::future<std::optional<cache_item>>
@@ -161,17 +315,11 @@ cache::get(std::filesystem::path key, size_t file_pos) {
     vlog(cst_log.debug, "Trying to get {} from archival cache.", key.native());
     ss::file cache_file;
     try {
-        /*
-         * TODO: update access time of file. Cache eviction uses file access
-         * timestamp to delete files from oldest to newest. File access time
-         * should be updated every time file is returned by cache, see
-         *
-         *  https://github.com/vectorizedio/redpanda/issues/2459
-         */
         cache_file = co_await ss::open_file_dma(
           (_cache_dir / key).native(), ss::open_flags::ro);
     } catch (std::filesystem::filesystem_error& e) {
         if (e.code() == std::errc::no_such_file_or_directory) {
+            forget(key);
             co_return std::nullopt;
         } else {
             throw;
@@ -179,6 +327,8 @@ cache::get(std::filesystem::path key, size_t file_pos) {
     }
 
     auto data_size = co_await cache_file.size();
+    // eviction deletes the least recently used files first
+    touch(key, data_size);
     auto data_stream = ss::make_file_input_stream(cache_file, file_pos);
     co_return std::optional(cache_item{std::move(data_stream), data_size});
 }
@@ -218,13 +368,28 @@ cache::put(std::filesystem::path key, ss::input_stream<char>& data) {
       (dir_path / tmp_filename).native(), flags);
     auto out = co_await ss::make_file_output_stream(tmp_cache_file);
 
-    co_await ss::copy(data, out)
-      .then([&out]() { return out.flush(); })
-      .finally([&out]() { return out.close(); });
+    size_t size = 0;
+    std::exception_ptr ex;
+    try {
+        co_await ss::copy(data, out)
+          .then([&out]() { return out.flush(); })
+          .finally([&out]() { return out.close(); });
+        size = co_await ss::file_size((dir_path / tmp_filename).native());
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        // don't leave the tmp file behind, it's not in the index and would
+        // never be evicted
+        co_await ss::remove_file((dir_path / tmp_filename).native())
+          .handle_exception([](std::exception_ptr) {});
+        std::rethrow_exception(ex);
+    }
 
     // commit write transaction
     co_await ss::rename_file(
       (dir_path / tmp_filename).native(), (dir_path / filename).native());
+    touch(key, size);
 }
 
 ss::future<cache_element_status>
@@ -249,6 +414,7 @@ ss::future<> cache::invalidate(const std::filesystem::path& key) {
       cst_log.debug,
       "Trying to invalidate {} from archival cache.",
       key.native());
+    forget(key);
     try {
         co_await ss::remove_file((_cache_dir / key).native());
     } catch (std::filesystem::filesystem_error& e) {
@@ -12,12 +12,17 @@
 
 #include "cloud_storage/recursive_directory_walker.h"
 #include "seastarx.h"
+#include "utils/absl_sstring_hash.h"
 
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/iostream.hh>
+#include <seastar/core/semaphore.hh>
+
+#include <absl/container/flat_hash_map.h>
 
 #include <filesystem>
+#include <list>
 #include <set>
 
 namespace cloud_storage {
@@ -30,15 +35,25 @@ struct cache_item {
 enum class cache_element_status { available, not_available, in_progress };
 std::ostream& operator<<(std::ostream& o, cache_element_status);
 
+/// Cache of the objects downloaded from S3 on the local disk.
+///
+/// The cache keeps an in-memory index of the cached files ordered by the time
+/// of the last access. Eviction removes the least recently used files from
+/// the index without walking the cache directory. The index is saved to the
+/// cache directory on stop and restored on start, the directory is walked
+/// only when the index is missing, e.g. after a crash.
 class cache {
 public:
     /// C-tor.
     ///
     /// \param cache_dir is a directory where cached data is stored
+    /// \param max_read_ahead_bytes is the budget of the objects downloaded
+    /// ahead of the readers
     cache(
       std::filesystem::path cache_dir,
       size_t _max_cache_size,
-      ss::lowres_clock::duration _check_period) noexcept;
+      ss::lowres_clock::duration _check_period,
+      size_t max_read_ahead_bytes) noexcept;
 
     ss::future<> start();
     ss::future<> stop();
@@ -64,18 +79,42 @@ public:
     /// Remove element from cache by key
     ss::future<> invalidate(const std::filesystem::path& key);
 
+    /// \brief Reserves room for an object downloaded ahead of a reader
+    ///
+    /// Read-ahead downloads share the budget of the shard and are only
+    /// allowed while the cache has room for them below the eviction low
+    /// watermark, so that prefetched objects don't evict the ones being
+    /// read. nullopt when there is no room, the units are released once the
+    /// object was put in the cache.
+    std::optional<ss::semaphore_units<>> reserve_read_ahead(size_t size);
+
     // Total cleaned is exposed for better testability of eviction
     uint64_t get_total_cleaned();
 
 private:
-    /// Triggers directory walker, creates a list of files to delete and deletes
-    /// them until cache size <= _cache_size_low_watermark * max_cache_size
+    /// Deletes the least recently used files until
+    /// cache size <= _cache_size_low_watermark * max_cache_size
     ss::future<> clean_up_cache();
 
-    /// Triggers directory walker, creates a list of files to delete and deletes
-    /// only tmp files that are left from previous Red Panda run
+    /// Restores the index saved by the previous run. When there is no index,
+    /// triggers directory walker to rebuild it and deletes tmp files that are
+    /// left from previous Red Panda run
     ss::future<> clean_up_at_start();
 
+    /// Rebuilds the index from the saved file, false if it's missing or
+    /// malformed. The file is removed so that it's not trusted after a crash.
+    ss::future<bool> load_index();
+    ss::future<> save_index();
+
+    /// Adds the file to the index or marks it as the most recently used one
+    void touch(const std::filesystem::path& key, size_t size);
+    void forget(const std::filesystem::path& key);
+
+    struct index_entry {
+        size_t size;
+        std::list<ss::sstring>::iterator lru_pos;
+    };
+
     std::filesystem::path _cache_dir;
     size_t _max_cache_size;
     ss::lowres_clock::duration _check_period;
@@ -87,6 +126,13 @@ private:
     cloud_storage::recursive_directory_walker _walker;
     uint64_t _total_cleaned;
     std::set<std::filesystem::path> _files_in_progress;
+    // keys of the cached files, least recently used first
+    std::list<ss::sstring> _lru;
+    absl::flat_hash_map<ss::sstring, index_entry, sstring_hash, sstring_eq>
+      _index;
+    uint64_t _current_size{0};
+    size_t _max_read_ahead_bytes;
+    ss::semaphore _read_ahead_budget;
 };
 
 } // namespace cloud_storage
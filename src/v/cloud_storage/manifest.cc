@@ -13,12 +13,15 @@
 #include "bytes/iobuf.h"
 #include "bytes/iobuf_istreambuf.h"
 #include "bytes/iobuf_ostreambuf.h"
+#include "bytes/iobuf_parser.h"
 #include "cloud_storage/types.h"
 #include "cluster/types.h"
 #include "hashing/xx.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
 #include "model/timestamp.h"
+#include "serde/envelope.h"
+#include "serde/serde.h"
 #include "ssx/sformat.h"
 #include "storage/ntp_config.h"
 
@@ -36,6 +39,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cctype>
 #include <charconv>
 #include <chrono>
 #include <variant>
@@ -276,6 +280,47 @@ remote_manifest_path manifest::get_manifest_path() const {
     return generate_partition_manifest_path(_ntp, _rev);
 }
 
+remote_manifest_path
+manifest::get_manifest_delta_prefix(uint64_t generation) const {
+    // the deltas are stored next to the manifest, e.g.
+    // b0000000/meta/kafka/redpanda-test/4_2/manifest.3.0000000012
+    auto path = get_manifest_path()();
+    path.replace_filename(fmt::format("manifest.{}.", generation));
+    return remote_manifest_path(std::move(path));
+}
+
+remote_manifest_path
+manifest::get_manifest_delta_path(uint64_t generation, uint64_t seq) const {
+    // zero padded to list the deltas in order
+    return remote_manifest_path(fmt::format(
+      "{}{:010}", get_manifest_delta_prefix(generation)().native(), seq));
+}
+
+std::optional<uint64_t> manifest::get_generation() const {
+    return _generation;
+}
+
+void manifest::set_generation(std::optional<uint64_t> generation) {
+    _generation = generation;
+}
+
+void manifest::apply_delta(const manifest& delta) {
+    for (const auto& [key, meta] : delta) {
+        _segments.insert_or_assign(key, meta);
+    }
+    _last_offset = std::max(_last_offset, delta.get_last_offset());
+}
+
+bool manifest::operator==(const manifest& other) const {
+    return _ntp == other._ntp && _rev == other._rev
+           && _segments == other._segments && _last_offset == other._last_offset
+           && _generation == other._generation;
+}
+
+manifest_format manifest::get_format() const { return _format; }
+
+void manifest::set_format(manifest_format format) { _format = format; }
+
 remote_segment_path
 manifest::get_remote_segment_path(const segment_name& name) const {
     auto path = ssx::sformat("{}_{}/{}", _ntp.path(), _rev(), name());
@@ -384,11 +429,28 @@ manifest manifest::difference(const manifest& remote_set) const {
     return result;
 }
 
+/// The binary manifest is a serde envelope, its first byte is the version
+/// of the envelope while the json document starts with '{'
+static bool is_json(const iobuf& buf) {
+    for (const auto& frag : buf) {
+        for (auto c : std::string_view(frag.get(), frag.size())) {
+            if (!std::isspace(static_cast<unsigned char>(c))) {
+                return c == '{';
+            }
+        }
+    }
+    return true;
+}
+
 ss::future<> manifest::update(ss::input_stream<char> is) {
     using namespace rapidjson;
     iobuf result;
     auto os = make_iobuf_ref_output_stream(result);
     co_await ss::copy(is, os);
+    if (!is_json(result)) {
+        update_binary(std::move(result));
+        co_return;
+    }
     iobuf_istreambuf ibuf(result);
     std::istream stream(&ibuf);
     Document m;
@@ -419,6 +481,10 @@ void manifest::update(const rapidjson::Document& m) {
     _rev = model::revision_id(m["revision"].GetInt());
     _ntp = model::ntp(ns, tp, pt);
     _last_offset = model::offset(m["last_offset"].GetInt64());
+    _generation = std::nullopt;
+    if (m.HasMember("generation")) {
+        _generation = m["generation"].GetUint64();
+    }
     segment_map tmp;
     if (m.HasMember("segments")) {
         const auto& s = m["segments"].GetObject();
@@ -457,11 +523,96 @@ void manifest::update(const rapidjson::Document& m) {
     std::swap(tmp, _segments);
 }
 
+namespace {
+
+struct binary_segment_meta
+  : serde::envelope<binary_segment_meta, serde::version<1>> {
+    // segment name or full segment path
+    ss::sstring key;
+    bool is_compacted;
+    uint64_t size_bytes;
+    int64_t base_offset;
+    int64_t committed_offset;
+    int64_t base_timestamp;
+    int64_t max_timestamp;
+    int64_t delta_offset;
+};
+
+struct binary_manifest : serde::envelope<binary_manifest, serde::version<1>> {
+    ss::sstring ns;
+    ss::sstring topic;
+    int32_t partition;
+    int64_t revision;
+    int64_t last_offset;
+    std::optional<uint64_t> generation;
+    std::vector<binary_segment_meta> segments;
+};
+
+} // namespace
+
+void manifest::update_binary(iobuf buf) {
+    iobuf_parser parser(std::move(buf));
+    auto m = serde::read<binary_manifest>(parser);
+    _ntp = model::ntp(
+      model::ns(std::move(m.ns)),
+      model::topic(std::move(m.topic)),
+      model::partition_id(m.partition));
+    _rev = model::revision_id(m.revision);
+    _last_offset = model::offset(m.last_offset);
+    _generation = m.generation;
+    segment_map tmp;
+    for (auto& s : m.segments) {
+        tmp.emplace(
+          string_to_key(s.key.c_str()),
+          segment_meta{
+            .is_compacted = s.is_compacted,
+            .size_bytes = s.size_bytes,
+            .base_offset = model::offset(s.base_offset),
+            .committed_offset = model::offset(s.committed_offset),
+            .base_timestamp = model::timestamp(s.base_timestamp),
+            .max_timestamp = model::timestamp(s.max_timestamp),
+            .delta_offset = model::offset(s.delta_offset),
+          });
+    }
+    std::swap(tmp, _segments);
+}
+
+iobuf manifest::serialize_binary() const {
+    binary_manifest m{
+      .ns = _ntp.ns(),
+      .topic = _ntp.tp.topic(),
+      .partition = _ntp.tp.partition(),
+      .revision = _rev(),
+      .last_offset = _last_offset(),
+      .generation = _generation,
+    };
+    m.segments.reserve(_segments.size());
+    for (const auto& [key, meta] : _segments) {
+        m.segments.push_back(binary_segment_meta{
+          .key = std::holds_alternative<segment_name>(key)
+                   ? std::get<segment_name>(key)()
+                   : ss::sstring(std::get<remote_segment_path>(key)().native()),
+          .is_compacted = meta.is_compacted,
+          .size_bytes = meta.size_bytes,
+          .base_offset = meta.base_offset(),
+          .committed_offset = meta.committed_offset(),
+          .base_timestamp = meta.base_timestamp.value(),
+          .max_timestamp = meta.max_timestamp.value(),
+          .delta_offset = meta.delta_offset(),
+        });
+    }
+    return serde::to_iobuf(std::move(m));
+}
+
 serialized_json_stream manifest::serialize() const {
     iobuf serialized;
-    iobuf_ostreambuf obuf(serialized);
-    std::ostream os(&obuf);
-    serialize(os);
+    if (_format == manifest_format::binary) {
+        serialized = serialize_binary();
+    } else {
+        iobuf_ostreambuf obuf(serialized);
+        std::ostream os(&obuf);
+        serialize(os);
+    }
     size_t size_bytes = serialized.size_bytes();
     return {
       .stream = make_iobuf_input_stream(std::move(serialized)),
@@ -485,6 +636,10 @@ void manifest::serialize(std::ostream& out) const {
     w.Int64(_rev());
     w.Key("last_offset");
     w.Int64(_last_offset());
+    if (_generation) {
+        w.Key("generation");
+        w.Uint64(*_generation);
+    }
     if (!_segments.empty()) {
         w.Key("segments");
         w.StartObject();
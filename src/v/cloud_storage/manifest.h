@@ -84,6 +84,15 @@ enum class manifest_type {
     partition,
 };
 
+/// Encoding of the partition manifest objects. The format of a downloaded
+/// manifest is detected from its content, both formats can always be read.
+enum class manifest_format {
+    /// Human readable, the default
+    json,
+    /// Compact serde encoding for partitions with many segments
+    binary,
+};
+
 /// Selected prefixes used to store manifest files
 static constexpr std::array<std::string_view, 16> manifest_prefixes = {{
   "00000000",
@@ -127,6 +136,13 @@ public:
 };
 
 /// Manifest file stored in S3
+///
+/// The manifest can be stored as a single object, re-uploaded in full after
+/// every change, or using the delta layout. In the delta layout the full
+/// manifest object has a generation number and the segments added after it
+/// was uploaded are stored in small delta objects of the same generation
+/// (see get_manifest_delta_path). The deltas are folded into the next
+/// generation of the full manifest periodically.
 class manifest final : public base_manifest {
 public:
     struct segment_meta {
@@ -156,6 +172,26 @@ public:
     /// Manifest object name in S3
     remote_manifest_path get_manifest_path() const override;
 
+    /// Name of the delta object of the manifest generation in S3
+    ///
+    /// The deltas of a generation share the prefix returned by
+    /// get_manifest_delta_prefix and are ordered by the sequence number when
+    /// listed.
+    remote_manifest_path
+    get_manifest_delta_path(uint64_t generation, uint64_t seq) const;
+    remote_manifest_path get_manifest_delta_prefix(uint64_t generation) const;
+
+    /// Generation of the manifest, set only when the delta layout is used
+    std::optional<uint64_t> get_generation() const;
+    void set_generation(std::optional<uint64_t> generation);
+
+    /// Add the segments of the delta object to the manifest
+    void apply_delta(const manifest& delta);
+
+    /// Format used by serialize()
+    manifest_format get_format() const;
+    void set_format(manifest_format format);
+
     /// Segment file name in S3
     remote_segment_path get_remote_segment_path(const segment_name& name) const;
     remote_segment_path get_remote_segment_path(const key& name) const;
@@ -214,7 +250,8 @@ public:
 
     /// Serialize manifest object
     ///
-    /// \return asynchronous input_stream with the serialized json
+    /// \return asynchronous input_stream with the manifest serialized
+    /// in the format set by set_format
     serialized_json_stream serialize() const override;
 
     /// Serialize manifest object
@@ -222,8 +259,12 @@ public:
     /// \param out output stream that should be used to output the json
     void serialize(std::ostream& out) const;
 
-    /// Compare two manifests for equality
-    bool operator==(const manifest& other) const = default;
+    /// Serialize manifest object using the binary format
+    iobuf serialize_binary() const;
+
+    /// Compare two manifests for equality, the serialization format is not
+    /// compared
+    bool operator==(const manifest& other) const;
 
     /// Remove segment record from manifest
     ///
@@ -240,10 +281,15 @@ private:
     /// from manifest.json file
     void update(const rapidjson::Document& m);
 
+    /// Update manifest content from binary encoded manifest
+    void update_binary(iobuf buf);
+
     model::ntp _ntp;
     model::revision_id _rev;
     segment_map _segments;
     model::offset _last_offset;
+    std::optional<uint64_t> _generation;
+    manifest_format _format{manifest_format::json};
 };
 
 class topic_manifest final : public base_manifest {
@@ -35,6 +35,8 @@
 #include <seastar/core/smp.hh>
 #include <seastar/core/temporary_buffer.hh>
 #include <seastar/core/thread.hh>
+#include <seastar/util/defer.hh>
+#include <seastar/util/file.hh>
 #include <seastar/util/log.hh>
 
 #include <absl/container/btree_map.h>
@@ -68,15 +70,24 @@ private:
 };
 
 partition_recovery_manager::partition_recovery_manager(
-  s3::bucket_name bucket, ss::sharded<remote>& remote)
+  s3::bucket_name bucket,
+  ss::sharded<remote>& remote,
+  recovery_config conf,
+  remote_metrics_disabled disable_metrics)
   : _bucket(std::move(bucket))
-  , _remote(remote) {}
+  , _remote(remote)
+  , _config(conf)
+  , _throttle(conf.bandwidth)
+  , _probe(disable_metrics) {}
 
 partition_recovery_manager::~partition_recovery_manager() {
     vassert(_gate.is_closed(), "S3 downloader is not stopped properly");
 }
 
-ss::future<> partition_recovery_manager::stop() { co_await _gate.close(); }
+ss::future<> partition_recovery_manager::stop() {
+    _throttle.shutdown();
+    co_await _gate.close();
+}
 
 /// Download full log based on manifest data.
 /// The 'ntp_config' should have corresponding override. If override
@@ -99,20 +110,52 @@ partition_recovery_manager::download_log(const storage::ntp_config& ntp_cfg) {
         co_return false;
     }
     partition_downloader downloader(
-      ntp_cfg, &_remote.local(), _bucket, _gate, _root);
+      ntp_cfg,
+      &_remote.local(),
+      _bucket,
+      _gate,
+      _root,
+      _config.concurrency,
+      _throttle,
+      _probe);
+    _probe.partition_started();
+    auto finished = ss::defer([this] { _probe.partition_finished(); });
     co_return co_await downloader.download_log();
 }
 
+ss::future<std::optional<hydrated_log>>
+partition_recovery_manager::hydrate_log(
+  const storage::ntp_config& ntp_cfg, model::revision_id topic_revision) {
+    partition_downloader downloader(
+      ntp_cfg,
+      &_remote.local(),
+      _bucket,
+      _gate,
+      _root,
+      _config.concurrency,
+      _throttle,
+      _probe);
+    _probe.partition_started();
+    auto finished = ss::defer([this] { _probe.partition_finished(); });
+    co_return co_await downloader.hydrate_log(topic_revision);
+}
+
 partition_downloader::partition_downloader(
   const storage::ntp_config& ntpc,
   remote* remote,
   s3::bucket_name bucket,
   ss::gate& gate_root,
-  retry_chain_node& parent)
+  retry_chain_node& parent,
+  size_t concurrency,
+  bandwidth_throttle& throttle,
+  recovery_probe& probe)
   : _ntpc(ntpc)
   , _bucket(std::move(bucket))
   , _remote(remote)
   , _gate(gate_root)
+  , _concurrency(concurrency)
+  , _throttle(throttle)
+  , _probe(probe)
   , _rtcnode(download_timeout, initial_backoff, &parent)
   , _ctxlog(
       cst_log,
@@ -338,6 +381,90 @@ partition_downloader::download_log(const remote_manifest_path& manifest_key) {
     co_return;
 }
 
+ss::future<std::optional<hydrated_log>>
+partition_downloader::hydrate_log(model::revision_id topic_revision) {
+    gate_guard guard(_gate);
+    if (co_await ss::file_exists(_ntpc.work_directory())) {
+        co_return std::nullopt;
+    }
+    auto prefix = std::filesystem::path(_ntpc.work_directory());
+    download_part part{
+      .part_prefix = std::filesystem::path(prefix.string() + "_part"),
+      .dest_prefix = prefix,
+      .num_files = 0,
+      .translate_offsets = false};
+    std::deque<segment> staged;
+    bool failed = false;
+    try {
+        auto mat = co_await find_recovery_material(
+          topic_manifest::get_topic_manifest_path(
+            _ntpc.ntp().ns, _ntpc.ntp().tp.topic));
+        // the manifests of a deleted topic with the same name or of a newer
+        // reassignment of the partition don't belong to this log
+        std::erase_if(
+          mat.paths, [this, topic_revision](const remote_manifest_path& p) {
+              auto c = get_manifest_path_components(p());
+              return !c || c->_rev < topic_revision
+                     || c->_rev > _ntpc.get_revision();
+          });
+        staged = select_hydrated_segments(co_await build_offset_map(mat));
+        if (staged.empty()) {
+            vlog(_ctxlog.info, "No archived segments to hydrate the log");
+            co_return std::nullopt;
+        }
+        const auto& first = staged.front().meta;
+        if (
+          first.base_offset > model::offset(0)
+          && first.delta_offset == model::offset::min()) {
+            vlog(
+              _ctxlog.info,
+              "The manifest has no offset delta of {}, the log can't be "
+              "hydrated",
+              staged.front().path);
+            co_return std::nullopt;
+        }
+        manifest target(_ntpc.ntp(), _ntpc.get_revision());
+        for (const auto& s : staged) {
+            target.add(s.path, s.meta);
+        }
+        vlog(
+          _ctxlog.info,
+          "Hydrating the log from {} archived segments, offsets {}-{}",
+          staged.size(),
+          first.base_offset,
+          staged.back().meta.committed_offset);
+        co_await ss::max_concurrent_for_each(
+          staged,
+          _concurrency,
+          [this, &target, &part, &failed](const segment& s) -> ss::future<> {
+              _probe.segment_scheduled(s.meta.size_bytes);
+              if (co_await download_file(s.path, target, part)) {
+                  ++part.num_files;
+              } else {
+                  failed = true;
+              }
+          });
+    } catch (...) {
+        vlog(
+          _ctxlog.warn,
+          "Error while hydrating the log: {}",
+          std::current_exception());
+        failed = true;
+    }
+    if (failed) {
+        // the leader recovers the whole log, a gap in the downloaded segments
+        // would be replicated otherwise
+        if (co_await ss::file_exists(part.part_prefix.string())) {
+            co_await ss::recursive_remove_directory(part.part_prefix);
+        }
+        co_return std::nullopt;
+    }
+    co_await move_parts(std::move(part));
+    co_return hydrated_log{
+      .start_offset = staged.front().meta.base_offset,
+      .delta_offset = staged.front().meta.delta_offset};
+}
+
 ss::future<partition_downloader::download_part>
 partition_downloader::download_log_with_capped_size(
   const offset_map_t& offset_map,
@@ -374,6 +501,7 @@ partition_downloader::download_log_with_capped_size(
           .size_bytes = meta.size_bytes,
         });
         total_size += meta.size_bytes;
+        _probe.segment_scheduled(meta.size_bytes);
     }
     download_part dlpart{
       .part_prefix = std::filesystem::path(prefix.string() + "_part"),
@@ -382,7 +510,7 @@ partition_downloader::download_log_with_capped_size(
 
     co_await ss::max_concurrent_for_each(
       staged_downloads,
-      max_concurrency,
+      _concurrency,
       [this, &manifest, &dlpart](download& dl) -> ss::future<> {
           retry_chain_node fib(&_rtcnode);
           retry_chain_logger dllog(cst_log, fib);
@@ -438,6 +566,7 @@ partition_downloader::download_log_with_capped_time(
         }
         auto fname = it->second.path;
         staged_downloads.push_front(fname);
+        _probe.segment_scheduled(meta.size_bytes);
     }
     download_part dlpart = {
       .part_prefix = std::filesystem::path(prefix.string() + "_part"),
@@ -446,7 +575,7 @@ partition_downloader::download_log_with_capped_time(
 
     co_await ss::max_concurrent_for_each(
       staged_downloads,
-      max_concurrency,
+      _concurrency,
       [this, &manifest, &dlpart](
         const remote_segment_path& fname) -> ss::future<> {
           retry_chain_node fib(&_rtcnode);
@@ -463,6 +592,54 @@ partition_downloader::download_log_with_capped_time(
     co_return dlpart;
 }
 
+std::deque<partition_downloader::segment>
+partition_downloader::select_hydrated_segments(
+  const offset_map_t& offset_map) const {
+    static constexpr auto one_week = std::chrono::seconds(86400) * 7;
+    auto retention = get_retention_policy(_ntpc.get_overrides());
+    std::optional<size_t> max_size;
+    auto retention_time = std::chrono::milliseconds(one_week);
+    if (std::holds_alternative<size_bound_deletion_parameters>(retention)) {
+        max_size = std::get<size_bound_deletion_parameters>(retention)
+                     .retention_bytes;
+    } else if (std::holds_alternative<time_bound_deletion_parameters>(
+                 retention)) {
+        retention_time = std::get<time_bound_deletion_parameters>(retention)
+                           .retention_duration;
+    }
+    auto time_threshold = model::to_timestamp(
+      model::timestamp_clock::now() - retention_time);
+
+    std::deque<segment> staged;
+    size_t total_size = 0;
+    for (auto it = offset_map.rbegin(); it != offset_map.rend(); ++it) {
+        const auto& meta = it->second.meta;
+        if (max_size) {
+            if (total_size > *max_size) {
+                break;
+            }
+        } else if (
+          meta.max_timestamp == model::timestamp::missing()
+          || meta.max_timestamp < time_threshold) {
+            break;
+        }
+        if (
+          !staged.empty()
+          && meta.committed_offset + model::offset(1)
+               != staged.front().meta.base_offset) {
+            vlog(
+              _ctxlog.info,
+              "Gap between {} and {}, the older segments aren't hydrated",
+              it->second.path,
+              staged.front().path);
+            break;
+        }
+        staged.push_front(it->second);
+        total_size += meta.size_bytes;
+    }
+    return staged;
+}
+
 ss::future<manifest>
 partition_downloader::download_manifest(const remote_manifest_path& key) {
     vlog(_ctxlog.info, "Downloading manifest {}", key);
@@ -527,7 +704,7 @@ open_output_file_stream(const std::filesystem::path& path) {
     co_return std::move(stream);
 }
 
-ss::future<> partition_downloader::download_file(
+ss::future<bool> partition_downloader::download_file(
   const remote_segment_path& remote_location,
   const manifest& manifest,
   const partition_downloader::download_part& part) {
@@ -540,9 +717,12 @@ ss::future<> partition_downloader::download_file(
       remote_location,
       part.part_prefix.string());
 
-    auto adjusted_path = otl.get_adjusted_segment_name(
-      remote_location, _rtcnode)();
-    auto localpath = part.part_prefix / adjusted_path.filename();
+    auto localpath = part.part_prefix / remote_location().filename();
+    if (part.translate_offsets) {
+        auto adjusted_path = otl.get_adjusted_segment_name(
+          remote_location, _rtcnode)();
+        localpath = part.part_prefix / adjusted_path.filename();
+    }
 
     if (co_await ss::file_exists(localpath.string())) {
         // we don't need to re-download file if it's already on disk
@@ -559,7 +739,8 @@ ss::future<> partition_downloader::download_file(
               "The local file {} is already downloaded and its size matches "
               "the manifest",
               localpath);
-            co_return;
+            _probe.segment_downloaded(sz);
+            co_return true;
         }
         vlog(
           _ctxlog.info,
@@ -579,8 +760,19 @@ ss::future<> partition_downloader::download_file(
           localpath.string());
         co_await ss::recursive_touch_directory(part.part_prefix.string());
         auto fs = co_await open_output_file_stream(localpath);
-        auto actual_len = co_await otl.copy_stream(
-          remote_location, std::move(in), std::move(fs), _rtcnode);
+        uint64_t actual_len = len;
+        if (part.translate_offsets) {
+            actual_len = co_await otl.copy_stream(
+              remote_location,
+              _throttle.wrap(std::move(in)),
+              std::move(fs),
+              _rtcnode);
+        } else {
+            auto src = _throttle.wrap(std::move(in));
+            co_await ss::copy(src, fs)
+              .then([&fs] { return fs.flush(); })
+              .finally([&fs] { return fs.close(); });
+        }
         vlog(
           _ctxlog.debug,
           "Log segment downloaded. {} bytes expected, {} bytes after "
@@ -597,9 +789,11 @@ ss::future<> partition_downloader::download_file(
         // The individual segment might be missing for varios reasons but
         // it shouldn't prevent us from restoring the remaining data
         vlog(_ctxlog.error, "Failed segment download for {}", remote_location);
+        _probe.segment_failed();
+        co_return false;
     }
-
-    co_return;
+    _probe.segment_downloaded(manifest.get(remote_location)->size_bytes);
+    co_return true;
 }
 
 ss::future<> partition_downloader::move_parts(download_part dls) {
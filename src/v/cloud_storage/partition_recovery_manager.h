@@ -1,6 +1,8 @@
 #pragma once
 
+#include "cloud_storage/bandwidth_throttle.h"
 #include "cloud_storage/manifest.h"
+#include "cloud_storage/probe.h"
 #include "cloud_storage/remote.h"
 #include "cloud_storage/types.h"
 #include "model/record.h"
@@ -16,17 +18,34 @@
 #include <seastar/core/sharded.hh>
 
 #include <compare>
+#include <deque>
 #include <iterator>
+#include <optional>
 #include <vector>
 
 namespace cloud_storage {
 
+/// Start of a log hydrated from the archived segments of the partition
+struct hydrated_log {
+    /// base offset of the first downloaded segment
+    model::offset start_offset;
+    /// offset delta of the first downloaded segment, as recorded in the
+    /// partition manifest
+    model::offset delta_offset;
+};
+
 /// Data recovery provider is used to download topic segments from S3 (or
 /// compatible storage) during topic re-creation process
+///
+/// The segments of a partition are downloaded concurrently, the downloads of
+/// all partitions recovered by the shard share the bandwidth limit.
 class partition_recovery_manager {
 public:
     partition_recovery_manager(
-      s3::bucket_name bucket, ss::sharded<remote>& remote);
+      s3::bucket_name bucket,
+      ss::sharded<remote>& remote,
+      recovery_config conf = {},
+      remote_metrics_disabled disable_metrics = remote_metrics_disabled::no);
 
     partition_recovery_manager(const partition_recovery_manager&) = delete;
     partition_recovery_manager(partition_recovery_manager&&) = delete;
@@ -48,9 +67,20 @@ public:
     /// \return true if log was actually downloaded, false otherwise
     ss::future<bool> download_log(const storage::ntp_config& ntp_cfg);
 
+    /// Download the archived segments of a new replica of an existing
+    /// partition, as uploaded, so that the leader only has to recover the
+    /// offsets that were not archived yet. Only the manifests uploaded since
+    /// \p topic_revision, the revision the topic was created at, are used.
+    /// \return the start of the log if it was hydrated
+    ss::future<std::optional<hydrated_log>> hydrate_log(
+      const storage::ntp_config& ntp_cfg, model::revision_id topic_revision);
+
 private:
     s3::bucket_name _bucket;
     ss::sharded<remote>& _remote;
+    recovery_config _config;
+    bandwidth_throttle _throttle;
+    recovery_probe _probe;
     ss::gate _gate;
     retry_chain_node _root;
 };
@@ -58,15 +88,18 @@ private:
 /// Topic downloader is used to download topic segments from S3 (or compatible
 /// storage) during topic re-creation
 class partition_downloader {
-    static constexpr size_t max_concurrency = 1;
-
 public:
+    /// \param concurrency is a max number of segments downloaded concurrently
+    /// \param throttle limits the bandwidth of the segment downloads
     partition_downloader(
       const storage::ntp_config& ntpc,
       remote* remote,
       s3::bucket_name bucket,
       ss::gate& gate_root,
-      retry_chain_node& parent);
+      retry_chain_node& parent,
+      size_t concurrency,
+      bandwidth_throttle& throttle,
+      recovery_probe& probe);
 
     partition_downloader(const partition_downloader&) = delete;
     partition_downloader(partition_downloader&&) = delete;
@@ -81,6 +114,13 @@ public:
     /// \return true if log was actually downloaded, false otherwise
     ss::future<bool> download_log();
 
+    /// Download the newest contiguous segments of the partition within its
+    /// retention without translating their offsets. The log isn't hydrated
+    /// if any of them can't be downloaded.
+    /// \return the start of the log if it was hydrated
+    ss::future<std::optional<hydrated_log>>
+    hydrate_log(model::revision_id topic_revision);
+
 private:
     /// Download full log based on manifest data
     ss::future<> download_log(const remote_manifest_path& key);
@@ -110,6 +150,9 @@ private:
         std::filesystem::path part_prefix;
         std::filesystem::path dest_prefix;
         size_t num_files;
+        /// the raft configuration batches are removed and the offsets are
+        /// translated to kafka offsets, otherwise the segment is copied as is
+        bool translate_offsets{true};
     };
 
     /// Download file to the target location
@@ -117,7 +160,8 @@ private:
     /// The downloaded file will have a custom suffix
     /// which has to be changed. The downloaded file path
     /// is returned by the futue.
-    ss::future<> download_file(
+    /// \return false if the segment couldn't be downloaded
+    ss::future<bool> download_file(
       const remote_segment_path& target,
       const manifest& manifest,
       const download_part& part);
@@ -131,6 +175,10 @@ private:
 
     ss::future<offset_map_t> build_offset_map(const recovery_material& mat);
 
+    /// Newest segments of the offset map within the retention of the
+    /// partition, they stop at the first gap between the segments
+    std::deque<segment> select_hydrated_segments(const offset_map_t&) const;
+
     ss::future<download_part> download_log_with_capped_size(
       const offset_map_t& offset_map,
       const manifest& manifest,
@@ -153,6 +201,9 @@ private:
     s3::bucket_name _bucket;
     remote* _remote;
     ss::gate& _gate;
+    size_t _concurrency;
+    bandwidth_throttle& _throttle;
+    recovery_probe& _probe;
     retry_chain_node _rtcnode;
     retry_chain_logger _ctxlog;
 };
@@ -97,4 +97,40 @@ remote_probe::remote_probe(remote_metrics_disabled disabled) {
       });
 }
 
+recovery_probe::recovery_probe(remote_metrics_disabled disabled) {
+    if (disabled) {
+        return;
+    }
+    namespace sm = ss::metrics;
+
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("cloud_storage:recovery"),
+      {
+        sm::make_gauge(
+          "partitions_in_progress",
+          [this] { return _partitions_in_progress; },
+          sm::description("Number of partitions being recovered")),
+        sm::make_counter(
+          "segments_scheduled",
+          [this] { return _cnt_segments_scheduled; },
+          sm::description("Number of log-segments scheduled for download")),
+        sm::make_counter(
+          "segments_downloaded",
+          [this] { return _cnt_segments_downloaded; },
+          sm::description("Number of downloaded log-segments")),
+        sm::make_counter(
+          "segments_failed",
+          [this] { return _cnt_segments_failed; },
+          sm::description("Number of log-segments which failed to download")),
+        sm::make_counter(
+          "bytes_scheduled",
+          [this] { return _cnt_bytes_scheduled; },
+          sm::description("Size of the log-segments scheduled for download")),
+        sm::make_counter(
+          "bytes_downloaded",
+          [this] { return _cnt_bytes_downloaded; },
+          sm::description("Size of the downloaded log-segments")),
+      });
+}
+
 } // namespace cloud_storage
@@ -168,4 +168,47 @@ private:
     ss::metrics::metric_groups _metrics;
 };
 
+/// Progress of the topic recovery downloads of a shard
+class recovery_probe {
+public:
+    explicit recovery_probe(remote_metrics_disabled disabled);
+
+    /// Register partition recovery start
+    void partition_started() { _partitions_in_progress++; }
+
+    /// Register partition recovery completion, successful or not
+    void partition_finished() { _partitions_in_progress--; }
+
+    /// Register segment scheduled for download
+    void segment_scheduled(size_t size) {
+        _cnt_segments_scheduled++;
+        _cnt_bytes_scheduled += size;
+    }
+
+    /// Register downloaded segment
+    void segment_downloaded(size_t size) {
+        _cnt_segments_downloaded++;
+        _cnt_bytes_downloaded += size;
+    }
+
+    /// Register segment which failed to download
+    void segment_failed() { _cnt_segments_failed++; }
+
+private:
+    /// Number of partitions being recovered
+    int64_t _partitions_in_progress{0};
+    /// Number of segments scheduled for download
+    uint64_t _cnt_segments_scheduled{0};
+    /// Number of segments downloaded
+    uint64_t _cnt_segments_downloaded{0};
+    /// Number of segments which failed to download
+    uint64_t _cnt_segments_failed{0};
+    /// Size of the segments scheduled for download
+    uint64_t _cnt_bytes_scheduled{0};
+    /// Size of the segments downloaded
+    uint64_t _cnt_bytes_downloaded{0};
+
+    ss::metrics::metric_groups _metrics;
+};
+
 } // namespace cloud_storage
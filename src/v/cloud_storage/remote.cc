@@ -26,7 +26,9 @@
 
 #include <boost/beast/http/error.hpp>
 #include <boost/beast/http/field.hpp>
+#include <boost/range/irange.hpp>
 
+#include <algorithm>
 #include <exception>
 #include <variant>
 
@@ -133,14 +135,21 @@ static error_outcome categorize_error(
     return result;
 }
 
-remote::remote(s3_connection_limit limit, const s3::configuration& conf)
+remote::remote(
+  s3_connection_limit limit,
+  const s3::configuration& conf,
+  multipart_upload_config multipart)
   : _pool(limit(), conf)
+  , _multipart(multipart)
   , _probe(remote_metrics_disabled(static_cast<bool>(conf.disable_metrics))) {}
 
 remote::remote(ss::sharded<configuration>& conf)
-  : remote(conf.local().connection_limit, conf.local().client_config) {}
+  : remote(
+    conf.local().connection_limit,
+    conf.local().client_config,
+    conf.local().multipart) {}
 
-ss::future<> remote::start() { return ss::now(); }
+ss::future<> remote::start() { return _pool.start(); }
 
 ss::future<> remote::stop() {
     _as.request_abort();
@@ -151,6 +160,75 @@ ss::future<> remote::stop() {
 size_t remote::concurrency() const { return _pool.max_size(); }
 
 ss::future<download_result> remote::download_manifest(
+  const s3::bucket_name& bucket,
+  const remote_manifest_path& key,
+  base_manifest& manifest,
+  retry_chain_node& parent) {
+    auto result = co_await download_manifest_object(
+      bucket, key, manifest, parent);
+    if (
+      result != download_result::success
+      || manifest.get_manifest_type() != manifest_type::partition) {
+        co_return result;
+    }
+    auto& partition_manifest = static_cast<cloud_storage::manifest&>(manifest);
+    if (!partition_manifest.get_generation()) {
+        co_return result;
+    }
+    co_return co_await download_manifest_deltas(
+      bucket, partition_manifest, parent);
+}
+
+ss::future<download_result> remote::download_manifest_deltas(
+  const s3::bucket_name& bucket,
+  manifest& manifest,
+  retry_chain_node& parent) {
+    retry_chain_node fib(&parent);
+    retry_chain_logger ctxlog(cst_log, fib);
+    auto prefix = manifest.get_manifest_delta_prefix(
+      *manifest.get_generation());
+    std::vector<remote_manifest_path> deltas;
+    auto result = co_await list_objects(
+      [&deltas](
+        const ss::sstring& key,
+        std::chrono::system_clock::time_point,
+        size_t,
+        const ss::sstring&) {
+          deltas.emplace_back(std::filesystem::path(key));
+          return ss::stop_iteration::no;
+      },
+      bucket,
+      s3::object_key(prefix()),
+      std::nullopt,
+      fib);
+    if (result != download_result::success) {
+        co_return result;
+    }
+    // the keys are listed in lexicographical order, which is the order of
+    // the sequence numbers of the deltas
+    for (const auto& key : deltas) {
+        cloud_storage::manifest delta;
+        result = co_await download_manifest_object(bucket, key, delta, fib);
+        if (result == download_result::notfound) {
+            // the delta was folded into the next generation of the manifest
+            // after the listing, the manifest has to be downloaded again
+            vlog(ctxlog.debug, "Manifest delta {} was removed", key);
+            co_return download_result::failed;
+        } else if (result != download_result::success) {
+            co_return result;
+        }
+        manifest.apply_delta(delta);
+    }
+    vlog(
+      ctxlog.debug,
+      "Applied {} deltas of generation {} to manifest {}",
+      deltas.size(),
+      *manifest.get_generation(),
+      manifest.get_manifest_path());
+    co_return download_result::success;
+}
+
+ss::future<download_result> remote::download_manifest_object(
   const s3::bucket_name& bucket,
   const remote_manifest_path& key,
   base_manifest& manifest,
@@ -159,7 +237,6 @@ ss::future<download_result> remote::download_manifest(
     retry_chain_node fib(&parent);
     retry_chain_logger ctxlog(cst_log, fib);
     auto path = s3::object_key(key().native());
-    auto [client, deleter] = co_await _pool.acquire();
     auto retry_permit = fib.retry();
     std::optional<download_result> result;
     vlog(ctxlog.debug, "Download manifest {}", key());
@@ -167,7 +244,7 @@ ss::future<download_result> remote::download_manifest(
            && !result.has_value()) {
         std::exception_ptr eptr = nullptr;
         try {
-            auto resp = co_await client->get_object(
+            auto [lease, resp] = co_await _pool.get_object(
               bucket, path, fib.get_timeout());
             vlog(ctxlog.debug, "Receive OK response from {}", path);
             co_await manifest.update(resp->as_input_stream());
@@ -185,16 +262,8 @@ ss::future<download_result> remote::download_manifest(
         }
         auto outcome = categorize_error(eptr, fib, bucket, path);
         switch (outcome) {
+        // the pool closes the connection that received the 'SlowDown'
         case error_outcome::retry_slowdown:
-            // We have to close the connection upon receiving the 'SlowDown'
-            // response from S3. If we won't do this and just sleep the required
-            // number of milliseconds the next request that will use this
-            // connection will trigger a 'short read' error. The error means
-            // that the S3 forcibly closes the connection. This doesn't happen
-            // when we close and then reestablish the connection upon receiving
-            // the 'SlowDown' response (if long enough backoff period is used).
-            co_await client->shutdown();
-            [[fallthrough]];
         case error_outcome::retry:
             vlog(
               ctxlog.debug,
@@ -234,11 +303,19 @@ ss::future<download_result> remote::download_manifest(
 ss::future<upload_result> remote::upload_manifest(
   const s3::bucket_name& bucket,
   const base_manifest& manifest,
+  retry_chain_node& parent) {
+    return upload_manifest(
+      bucket, manifest, manifest.get_manifest_path(), parent);
+}
+
+ss::future<upload_result> remote::upload_manifest(
+  const s3::bucket_name& bucket,
+  const base_manifest& manifest,
+  const remote_manifest_path& key,
   retry_chain_node& parent) {
     gate_guard guard{_gate};
     retry_chain_node fib(&parent);
     retry_chain_logger ctxlog(cst_log, fib);
-    auto key = manifest.get_manifest_path();
     auto path = s3::object_key(key().string());
     std::vector<s3::object_tag> tags = {{"rp-type", "partition-manifest"}};
     auto [client, deleter] = co_await _pool.acquire();
@@ -393,26 +470,230 @@ ss::future<upload_result> remote::upload_segment(
     co_return upload_result::timedout;
 }
 
+ss::future<upload_result> remote::upload_segment(
+  const s3::bucket_name& bucket,
+  const segment_name& exposed_name,
+  uint64_t content_length,
+  const reset_input_stream_range& reset_str,
+  manifest& manifest,
+  retry_chain_node& parent) {
+    if (_multipart.part_size == 0 || content_length <= _multipart.part_size) {
+        co_return co_await upload_segment(
+          bucket,
+          exposed_name,
+          content_length,
+          [&reset_str, content_length] {
+              return reset_str(0, content_length);
+          },
+          manifest,
+          parent);
+    }
+    gate_guard guard{_gate};
+    retry_chain_node fib(&parent);
+    retry_chain_logger ctxlog(cst_log, fib);
+    auto s3path = manifest.get_remote_segment_path(exposed_name);
+    vlog(
+      ctxlog.debug,
+      "Uploading segment for {}, exposed name {}, length {}, in parts of {}",
+      manifest.get_ntp(),
+      exposed_name,
+      content_length,
+      _multipart.part_size);
+    auto result = co_await multipart_upload_segment(
+      bucket,
+      s3::object_key(s3path().string()),
+      content_length,
+      reset_str,
+      fib);
+    if (result == upload_result::success) {
+        _probe.successful_upload();
+        _probe.register_upload_size(content_length);
+    } else {
+        _probe.failed_upload();
+        vlog(
+          ctxlog.warn,
+          "Uploading segment {} to {}, {}, segment not uploaded",
+          s3path,
+          bucket,
+          result);
+    }
+    co_return result;
+}
+
+ss::future<upload_result> remote::multipart_upload_segment(
+  const s3::bucket_name& bucket,
+  const s3::object_key& path,
+  uint64_t content_length,
+  const reset_input_stream_range& reset_str,
+  retry_chain_node& fib) {
+    retry_chain_logger ctxlog(cst_log, fib);
+    std::vector<s3::object_tag> tags = {{"rp-type", "segment"}};
+    ss::sstring upload_id;
+    auto result = co_await retry_upload_request(
+      bucket,
+      path,
+      "create multipart upload",
+      [&](const s3::client_pool::http_client_ptr& client) {
+          return client
+            ->create_multipart_upload(bucket, path, tags, fib.get_timeout())
+            .then([&upload_id](ss::sstring id) { upload_id = std::move(id); });
+      },
+      fib);
+    if (result != upload_result::success) {
+        co_return result;
+    }
+
+    auto num_parts = (content_length + _multipart.part_size - 1)
+                     / _multipart.part_size;
+    std::vector<ss::sstring> etags(num_parts);
+    co_await ss::max_concurrent_for_each(
+      boost::irange<size_t>(0, num_parts),
+      _multipart.parallelism,
+      [&](size_t part) -> ss::future<> {
+          // the upload fails as a whole, the remaining parts are not sent
+          if (result != upload_result::success) {
+              co_return;
+          }
+          retry_chain_node part_fib(&fib);
+          auto offset = part * _multipart.part_size;
+          auto length = std::min<uint64_t>(
+            _multipart.part_size, content_length - offset);
+          auto part_result = co_await retry_upload_request(
+            bucket,
+            path,
+            "upload part",
+            [&](const s3::client_pool::http_client_ptr& client) {
+                return client
+                  ->upload_part(
+                    bucket,
+                    path,
+                    upload_id,
+                    part + 1,
+                    length,
+                    reset_str(offset, length),
+                    part_fib.get_timeout())
+                  .then([&etags, part](ss::sstring etag) {
+                      etags[part] = std::move(etag);
+                  });
+            },
+            part_fib);
+          if (part_result != upload_result::success) {
+              result = part_result;
+          }
+      });
+
+    if (result == upload_result::success) {
+        result = co_await retry_upload_request(
+          bucket,
+          path,
+          "complete multipart upload",
+          [&](const s3::client_pool::http_client_ptr& client) {
+              return client->complete_multipart_upload(
+                bucket, path, upload_id, etags, fib.get_timeout());
+          },
+          fib);
+    }
+    if (result != upload_result::success) {
+        // best effort, S3 lifecycle rules remove the parts otherwise
+        try {
+            auto [client, deleter] = co_await _pool.acquire();
+            co_await client->abort_multipart_upload(
+              bucket, path, upload_id, fib.get_timeout());
+        } catch (...) {
+            vlog(
+              ctxlog.warn,
+              "Failed to abort multipart upload {} of {}: {}",
+              upload_id,
+              path,
+              std::current_exception());
+        }
+    }
+    co_return result;
+}
+
+ss::future<upload_result> remote::delete_object(
+  const s3::bucket_name& bucket,
+  const s3::object_key& key,
+  retry_chain_node& parent) {
+    gate_guard guard{_gate};
+    retry_chain_node fib(&parent);
+    co_return co_await retry_upload_request(
+      bucket,
+      key,
+      "delete object",
+      [&](const s3::client_pool::http_client_ptr& client) {
+          return client->delete_object(bucket, key, fib.get_timeout());
+      },
+      fib);
+}
+
+ss::future<upload_result> remote::retry_upload_request(
+  const s3::bucket_name& bucket,
+  const s3::object_key& path,
+  std::string_view description,
+  const request_t& request,
+  retry_chain_node& fib) {
+    retry_chain_logger ctxlog(cst_log, fib);
+    auto permit = fib.retry();
+    while (!_gate.is_closed() && permit.is_allowed) {
+        auto [client, deleter] = co_await _pool.acquire();
+        std::exception_ptr eptr = nullptr;
+        try {
+            co_await request(client);
+            co_return upload_result::success;
+        } catch (...) {
+            eptr = std::current_exception();
+        }
+        auto outcome = categorize_error(eptr, fib, bucket, path);
+        switch (outcome) {
+        case error_outcome::retry_slowdown:
+            co_await client->shutdown();
+            [[fallthrough]];
+        case error_outcome::retry:
+            vlog(
+              ctxlog.debug,
+              "Request '{}' for {} failed, {}ms backoff required",
+              description,
+              path,
+              permit.delay.count());
+            _probe.upload_backoff();
+            co_await ss::sleep_abortable(permit.delay, _as);
+            permit = fib.retry();
+            break;
+        case error_outcome::notfound:
+            // not expected during upload
+        case error_outcome::fail:
+            co_return upload_result::failed;
+        }
+    }
+    vlog(
+      ctxlog.warn,
+      "Request '{}' for {} failed, backoff quota exceded",
+      description,
+      path);
+    co_return upload_result::timedout;
+}
+
 ss::future<download_result> remote::download_segment(
   const s3::bucket_name& bucket,
   const manifest::key& name,
   const manifest& manifest,
   const try_consume_stream& cons_str,
-  retry_chain_node& parent) {
+  retry_chain_node& parent,
+  std::optional<s3::byte_range> range) {
     gate_guard guard{_gate};
     retry_chain_node fib(&parent);
     retry_chain_logger ctxlog(cst_log, fib);
     auto s3path = manifest.get_remote_segment_path(name);
     auto path = s3::object_key(s3path().string());
-    auto [client, deleter] = co_await _pool.acquire();
     auto permit = fib.retry();
     vlog(ctxlog.debug, "Download segment {}", path);
     std::optional<download_result> result;
     while (!_gate.is_closed() && permit.is_allowed && !result) {
         std::exception_ptr eptr = nullptr;
         try {
-            auto resp = co_await client->get_object(
-              bucket, path, fib.get_timeout());
+            auto [lease, resp] = co_await _pool.get_object(
+              bucket, path, fib.get_timeout(), range);
             vlog(ctxlog.debug, "Receive OK response from {}", path);
             auto length = boost::lexical_cast<uint64_t>(resp->get_headers().at(
               boost::beast::http::field::content_length));
@@ -426,9 +707,8 @@ ss::future<download_result> remote::download_segment(
         }
         auto outcome = categorize_error(eptr, fib, bucket, path);
         switch (outcome) {
+        // the pool closes the connection that received the 'SlowDown'
         case error_outcome::retry_slowdown:
-            co_await client->shutdown();
-            [[fallthrough]];
         case error_outcome::retry:
             vlog(
               ctxlog.debug,
@@ -36,6 +36,12 @@ public:
     /// to re-upload and will return all data that needs to be uploaded
     using reset_input_stream = std::function<ss::input_stream<char>()>;
 
+    /// Functor that returns fresh input_stream object with the data in the
+    /// range [offset, offset + length) of the content to upload. It's used to
+    /// upload and re-upload the parts of the multipart uploads.
+    using reset_input_stream_range
+      = std::function<ss::input_stream<char>(uint64_t offset, uint64_t length)>;
+
     /// Functor that attempts to consume the input stream. If the connection
     /// is broken during the download the functor is responsible for he cleanup.
     /// The functor should be reenterable since it can be called many times.
@@ -54,7 +60,11 @@ public:
     ///
     /// \param limit is a number of simultaneous connections
     /// \param conf is an S3 configuration
-    remote(s3_connection_limit limit, const s3::configuration& conf);
+    /// \param multipart is a multipart upload configuration of the segments
+    remote(
+      s3_connection_limit limit,
+      const s3::configuration& conf,
+      multipart_upload_config multipart = {});
 
     /// \brief Initialize 'remote'
     ///
@@ -77,6 +87,8 @@ public:
     ///
     /// Method downloads the manifest and handles backpressure and
     /// errors. It retries multiple times until timeout excedes.
+    /// The delta objects of the partition manifests that use the delta
+    /// layout are downloaded and applied to the manifest as well.
     /// \param bucket is a bucket name
     /// \param key is an object key of the manifest
     /// \param manifest is a manifest to download
@@ -97,6 +109,28 @@ public:
       const base_manifest& manifest,
       retry_chain_node& parent);
 
+    /// \brief Upload manifest to the S3 location
+    ///
+    /// \param bucket is a bucket name
+    /// \param manifest is a manifest to upload
+    /// \param key is an object key of the manifest, e.g. the delta path
+    /// \return future that returns success code
+    ss::future<upload_result> upload_manifest(
+      const s3::bucket_name& bucket,
+      const base_manifest& manifest,
+      const remote_manifest_path& key,
+      retry_chain_node& parent);
+
+    /// \brief Delete object from S3
+    ///
+    /// \param bucket is a bucket name
+    /// \param key is an object key
+    /// \return future that returns success code
+    ss::future<upload_result> delete_object(
+      const s3::bucket_name& bucket,
+      const s3::object_key& key,
+      retry_chain_node& parent);
+
     /// \brief Upload segment to S3
     ///
     /// The method uploads the segment while tolerating some errors. It can
@@ -113,6 +147,24 @@ public:
       manifest& manifest,
       retry_chain_node& parent);
 
+    /// \brief Upload segment to S3, in parts if the segment is large
+    ///
+    /// Segments larger than the multipart part size are uploaded using the
+    /// multipart upload. The parts are uploaded concurrently using the
+    /// connections of the pool, every part is retried independently. The
+    /// smaller segments are uploaded using a single request.
+    /// \param reset_str is a functor that returns an input_stream that
+    ///                  returns the range of segment's data
+    /// \param exposed_name is a segment's name in S3
+    /// \param manifest is a manifest that should have the segment metadata
+    ss::future<upload_result> upload_segment(
+      const s3::bucket_name& bucket,
+      const segment_name& exposed_name,
+      uint64_t content_length,
+      const reset_input_stream_range& reset_str,
+      manifest& manifest,
+      retry_chain_node& parent);
+
     /// \brief Download segment from S3
     ///
     /// The method downloads the segment while tolerating some errors. It can
@@ -121,12 +173,15 @@ public:
     /// segment's data
     /// \param name is a segment's name in S3
     /// \param manifest is a manifest that should have the segment metadata
+    /// \param range is a range of bytes of the segment to download, the
+    ///        whole segment is downloaded if not set
     ss::future<download_result> download_segment(
       const s3::bucket_name& bucket,
       const manifest::key& name,
       const manifest& manifest,
       const try_consume_stream& cons_str,
-      retry_chain_node& parent);
+      retry_chain_node& parent,
+      std::optional<s3::byte_range> range = std::nullopt);
 
     ss::future<download_result> list_objects(
       const list_objects_consumer& cons,
@@ -136,7 +191,41 @@ public:
       retry_chain_node& parent);
 
 private:
+    /// Download single manifest object
+    ss::future<download_result> download_manifest_object(
+      const s3::bucket_name& bucket,
+      const remote_manifest_path& key,
+      base_manifest& manifest,
+      retry_chain_node& parent);
+
+    /// Download the deltas of the manifest generation and apply them to the
+    /// manifest
+    ss::future<download_result> download_manifest_deltas(
+      const s3::bucket_name& bucket,
+      manifest& manifest,
+      retry_chain_node& parent);
+
+    using request_t
+      = std::function<ss::future<>(const s3::client_pool::http_client_ptr&)>;
+
+    /// Send the request using a client from the pool, the request is retried
+    /// with backoff until the retry quota of the node is exhausted
+    ss::future<upload_result> retry_upload_request(
+      const s3::bucket_name& bucket,
+      const s3::object_key& path,
+      std::string_view description,
+      const request_t& request,
+      retry_chain_node& fib);
+
+    ss::future<upload_result> multipart_upload_segment(
+      const s3::bucket_name& bucket,
+      const s3::object_key& path,
+      uint64_t content_length,
+      const reset_input_stream_range& reset_str,
+      retry_chain_node& fib);
+
     s3::client_pool _pool;
+    multipart_upload_config _multipart;
     ss::gate _gate;
     ss::abort_source _as;
     remote_probe _probe;
@@ -0,0 +1,520 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "cloud_storage/remote_partition.h"
+
+#include "cloud_storage/logger.h"
+#include "cloud_storage/types.h"
+#include "model/record.h"
+#include "storage/parser.h"
+#include "utils/gate_guard.h"
+#include "utils/retry_chain_node.h"
+#include "vassert.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/iostream.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <fmt/ostream.h>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
+namespace cloud_storage {
+
+namespace {
+
+/// Consumes the batches of an archived segment within the range of the reader
+/// config. Raft configuration batches are skipped and the offsets of the
+/// other batches are translated to kafka offsets.
+///
+/// The first batch starting in every chunk is added to the segment index.
+class remote_batch_consumer final : public storage::batch_consumer {
+public:
+    remote_batch_consumer(
+      storage::log_reader_config& cfg,
+      segment_batch_position start,
+      segment_position_index& index,
+      size_t chunk_size,
+      model::record_batch_reader::data_t& batches) noexcept
+      : _config(cfg)
+      , _delta(start.delta)
+      , _base_pos(start.file_pos)
+      , _chunk_size(chunk_size)
+      , _indexed_chunk(start.file_pos / chunk_size)
+      , _index(index)
+      , _batches(batches) {}
+
+    consume_result
+    accept_batch_start(const model::record_batch_header& h) const final {
+        if (h.type == model::record_batch_type::raft_configuration) {
+            return consume_result::skip_batch;
+        }
+        if (h.base_offset - _delta > _config.max_offset) {
+            return consume_result::stop_parser;
+        }
+        if (
+          (_config.strict_max_bytes || _config.bytes_consumed)
+          && (_config.bytes_consumed + h.size_bytes) > _config.max_bytes) {
+            _config.over_budget = true;
+            return consume_result::stop_parser;
+        }
+        if (h.last_offset() - _delta < _config.start_offset) {
+            return consume_result::skip_batch;
+        }
+        if (_config.type_filter && h.type != *_config.type_filter) {
+            return consume_result::skip_batch;
+        }
+        if (
+          _config.first_timestamp
+          && h.max_timestamp < *_config.first_timestamp) {
+            return consume_result::skip_batch;
+        }
+        return consume_result::accept_batch;
+    }
+
+    void consume_batch_start(
+      model::record_batch_header h,
+      size_t physical_base_offset,
+      size_t /*size_on_disk*/) final {
+        maybe_index(h, physical_base_offset);
+        _header = h;
+        _header.base_offset = h.base_offset - _delta;
+    }
+
+    void skip_batch_start(
+      model::record_batch_header h,
+      size_t physical_base_offset,
+      size_t /*size_on_disk*/) final {
+        maybe_index(h, physical_base_offset);
+        // configuration batches do not have kafka offsets
+        if (h.type == model::record_batch_type::raft_configuration) {
+            _delta += model::offset(h.record_count);
+        }
+    }
+
+    void consume_records(iobuf&& records) final {
+        _records = std::move(records);
+    }
+
+    stop_parser consume_batch_end() final {
+        _config.bytes_consumed += _header.size_bytes;
+        _config.start_offset = _header.last_offset() + model::offset(1);
+        _batches.emplace_back(
+          _header, std::move(_records), model::record_batch::tag_ctor_ng{});
+        _header = {};
+        return stop_parser(
+          _config.start_offset > _config.max_offset
+          || _config.bytes_consumed >= _config.max_bytes);
+    }
+
+    void print(std::ostream& o) const final {
+        fmt::print(o, "cloud_storage::remote_batch_consumer");
+    }
+
+private:
+    void
+    maybe_index(const model::record_batch_header& h, size_t physical_offset) {
+        auto pos = _base_pos + physical_offset;
+        auto chunk = pos / _chunk_size;
+        if (chunk == _indexed_chunk) {
+            return;
+        }
+        _indexed_chunk = chunk;
+        _index.emplace(
+          h.base_offset - _delta,
+          segment_batch_position{.file_pos = pos, .delta = _delta});
+    }
+
+    storage::log_reader_config& _config;
+    model::offset _delta;
+    size_t _base_pos;
+    size_t _chunk_size;
+    size_t _indexed_chunk;
+    segment_position_index& _index;
+    model::record_batch_reader::data_t& _batches;
+    model::record_batch_header _header;
+    iobuf _records;
+};
+
+/// Concatenation of the cached chunks of a segment. Chunks are hydrated
+/// lazily so that the chunks past the end of the read are never downloaded.
+class chunked_data_source final : public ss::data_source_impl {
+public:
+    using open_chunk_t = ss::noncopyable_function<
+      ss::future<ss::input_stream<char>>(size_t)>;
+
+    /// \param first is the first chunk to read
+    /// \param last is the last chunk of the segment
+    /// \param skip is the number of bytes to skip in the first chunk
+    chunked_data_source(
+      size_t first, size_t last, size_t skip, open_chunk_t open)
+      : _next(first)
+      , _last(last)
+      , _skip(skip)
+      , _open(std::move(open)) {}
+
+    ss::future<ss::temporary_buffer<char>> get() final {
+        while (true) {
+            if (!_current) {
+                if (_next > _last) {
+                    co_return ss::temporary_buffer<char>();
+                }
+                _current = co_await _open(_next++);
+                if (_skip) {
+                    co_await _current->skip(std::exchange(_skip, 0));
+                }
+            }
+            auto buf = co_await _current->read();
+            if (!buf.empty()) {
+                co_return buf;
+            }
+            co_await _current->close();
+            _current = std::nullopt;
+        }
+    }
+
+    ss::future<> close() final {
+        if (!_current) {
+            return ss::now();
+        }
+        return _current->close();
+    }
+
+private:
+    size_t _next;
+    size_t _last;
+    size_t _skip;
+    open_chunk_t _open;
+    std::optional<ss::input_stream<char>> _current;
+};
+
+std::filesystem::path
+chunk_key(const remote_segment_path& path, size_t chunk) {
+    return std::filesystem::path(fmt::format("{}.{}", path().native(), chunk));
+}
+
+} // namespace
+
+remote_partition::remote_partition(
+  model::ntp ntp,
+  model::revision_id rev,
+  s3::bucket_name bucket,
+  remote& remote,
+  cache& cache,
+  size_t chunk_size,
+  size_t read_ahead_chunks)
+  : _ntp(std::move(ntp))
+  , _bucket(std::move(bucket))
+  , _remote(remote)
+  , _cache(cache)
+  , _chunk_size(chunk_size)
+  , _read_ahead_chunks(read_ahead_chunks)
+  , _rev(rev) {
+    vassert(_chunk_size > 0, "Chunk size of {} must be positive", _ntp);
+}
+
+void remote_partition::start() {
+    (void)ss::with_gate(_gate, [this] {
+        return _manifest_lock.with([this] { return update_manifest(); });
+    }).handle_exception([this](const std::exception_ptr& e) {
+        vlog(cst_log.info, "Unable to download manifest of {}: {}", _ntp, e);
+    });
+}
+
+ss::future<> remote_partition::stop() {
+    _as.request_abort();
+    return _gate.close();
+}
+
+std::optional<model::offset> remote_partition::first_offset() const {
+    if (!_archive || _archive->segments.empty()) {
+        return std::nullopt;
+    }
+    return _archive->segments.begin()->first;
+}
+
+ss::future<> remote_partition::maybe_update_manifest() {
+    return _manifest_lock.with([this] {
+        if (
+          ss::lowres_clock::now()
+          < _manifest_updated_at + manifest_refresh_interval) {
+            return ss::now();
+        }
+        return update_manifest();
+    });
+}
+
+ss::future<> remote_partition::update_manifest() {
+    retry_chain_node fib(_as, download_timeout, initial_backoff);
+    retry_chain_logger ctxlog(cst_log, fib, _ntp.path());
+    manifest m(_ntp, _rev);
+    auto res = co_await _remote.download_manifest(
+      _bucket, m.get_manifest_path(), m, fib);
+    _manifest_updated_at = ss::lowres_clock::now();
+    if (res == download_result::notfound) {
+        // nothing was uploaded yet
+        vlog(ctxlog.debug, "Manifest {} not found", m.get_manifest_path());
+        co_return;
+    }
+    if (res != download_result::success) {
+        throw std::runtime_error(fmt::format(
+          "failed to download manifest {}: {}", m.get_manifest_path(), res));
+    }
+
+    offset_map_t segments;
+    for (const auto& [name, meta] : m) {
+        // segments uploaded without the offset delta can not be translated to
+        // kafka offsets
+        if (meta.delta_offset == model::offset::min()) {
+            continue;
+        }
+        auto base = meta.base_offset - meta.delta_offset;
+        auto index = ss::make_lw_shared<segment_position_index>();
+        // the index of a segment that was not replaced remains valid
+        if (_archive) {
+            auto it = _archive->segments.find(base);
+            if (
+              it != _archive->segments.end() && it->second.name == name
+              && it->second.meta.size_bytes == meta.size_bytes) {
+                index = it->second.index;
+            }
+        }
+        segments.emplace(base, segment{name, meta, std::move(index)});
+    }
+    vlog(
+      ctxlog.debug,
+      "Manifest updated, {} segments readable out of {}",
+      segments.size(),
+      m.size());
+    _archive = ss::make_lw_shared<archive>(archive{
+      .partition_manifest = std::move(m), .segments = std::move(segments)});
+}
+
+ss::future<ss::input_stream<char>> remote_partition::hydrate(
+  const archive& a, const segment& s, size_t chunk) {
+    auto key = chunk_key(
+      a.partition_manifest.get_remote_segment_path(s.name), chunk);
+    // the chunks downloaded ahead are served without waiting for the
+    // download in progress
+    if (auto item = co_await _cache.get(key); item) {
+        co_return std::move(item->body);
+    }
+    {
+        auto units = co_await _hydration_lock.get_units();
+        if (
+          co_await _cache.is_cached(key) != cache_element_status::available) {
+            co_await download_chunk(a, s, chunk, key);
+        }
+    }
+    auto item = co_await _cache.get(key);
+    if (!item) {
+        throw std::runtime_error(
+          fmt::format("{} evicted from the cache", key.native()));
+    }
+    co_return std::move(item->body);
+}
+
+ss::future<> remote_partition::download_chunk(
+  const archive& a,
+  const segment& s,
+  size_t chunk,
+  const std::filesystem::path& key) {
+    auto path = a.partition_manifest.get_remote_segment_path(s.name);
+    retry_chain_node fib(_as, download_timeout, initial_backoff);
+    retry_chain_logger ctxlog(cst_log, fib, _ntp.path());
+    s3::byte_range range{
+      .first = chunk * _chunk_size,
+      .last = std::min((chunk + 1) * _chunk_size, s.meta.size_bytes) - 1};
+    vlog(
+      ctxlog.debug,
+      "Hydrating chunk {} of segment {}, bytes {}-{}",
+      chunk,
+      path,
+      range.first,
+      range.last);
+    auto res = co_await _remote.download_segment(
+      _bucket,
+      s.name,
+      a.partition_manifest,
+      [this, &key](uint64_t len, ss::input_stream<char> in) {
+          return ss::do_with(
+            std::move(in), [this, &key, len](ss::input_stream<char>& in) {
+                return _cache.put(key, in)
+                  .finally([&in] { return in.close(); })
+                  .then([len] { return len; });
+            });
+      },
+      fib,
+      range);
+    if (res != download_result::success) {
+        throw std::runtime_error(fmt::format(
+          "failed to download chunk {} of segment {}: {}", chunk, path, res));
+    }
+}
+
+ss::future<std::optional<size_t>> remote_partition::read_segment(
+  const archive& a,
+  const segment& s,
+  storage::log_reader_config& cfg,
+  model::record_batch_reader::data_t& batches) {
+    if (s.meta.size_bytes == 0) {
+        co_return std::nullopt;
+    }
+    // start from the closest indexed batch at or before the start offset
+    segment_batch_position start{.file_pos = 0, .delta = s.meta.delta_offset};
+    if (auto it = s.index->upper_bound(cfg.start_offset);
+        it != s.index->begin()) {
+        start = std::prev(it)->second;
+    }
+    auto first_chunk = start.file_pos / _chunk_size;
+    auto last_chunk = (s.meta.size_bytes - 1) / _chunk_size;
+    auto read_chunk = first_chunk;
+    ss::input_stream<char> stream(
+      ss::data_source(std::make_unique<chunked_data_source>(
+        first_chunk,
+        last_chunk,
+        start.file_pos - first_chunk * _chunk_size,
+        [this, &a, &s, &read_chunk](size_t chunk) {
+            read_chunk = chunk;
+            return hydrate(a, s, chunk);
+        })));
+    storage::continuous_batch_parser parser(
+      std::make_unique<remote_batch_consumer>(
+        cfg, start, *s.index, _chunk_size, batches),
+      std::move(stream));
+    std::exception_ptr ex;
+    try {
+        auto res = co_await parser.consume();
+        if (!res) {
+            ex = std::make_exception_ptr(std::system_error(res.error()));
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await parser.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return read_chunk;
+}
+
+ss::future<model::record_batch_reader>
+remote_partition::make_reader(storage::log_reader_config cfg) {
+    gate_guard guard{_gate};
+    co_await maybe_update_manifest();
+
+    model::record_batch_reader::data_t batches;
+    // the snapshot keeps the segments alive while they are read
+    auto a = _archive;
+    if (
+      !a || a->segments.empty()
+      || cfg.start_offset < a->segments.begin()->first) {
+        co_return model::make_memory_record_batch_reader(std::move(batches));
+    }
+    const auto start = cfg.start_offset;
+    std::optional<chunk_position> last_read;
+    // the segment containing the start offset is the last one starting at or
+    // before it
+    auto it = std::prev(a->segments.upper_bound(cfg.start_offset));
+    while (it != a->segments.end() && cfg.start_offset <= cfg.max_offset
+           && !cfg.over_budget && cfg.bytes_consumed < cfg.max_bytes) {
+        auto next = std::next(it);
+        auto chunk = co_await read_segment(*a, it->second, cfg, batches);
+        if (chunk) {
+            last_read = chunk_position{.segment = it->first, .chunk = *chunk};
+        }
+        // the remaining batches of the segment were filtered out
+        if (next != a->segments.end() && cfg.start_offset < next->first) {
+            cfg.start_offset = next->first;
+        }
+        it = next;
+    }
+    if (last_read && is_sequential(start, cfg.start_offset)) {
+        maybe_read_ahead(std::move(a), *last_read);
+    }
+    co_return model::make_memory_record_batch_reader(std::move(batches));
+}
+
+bool remote_partition::is_sequential(model::offset start, model::offset next) {
+    auto it = std::find(_read_ends.begin(), _read_ends.end(), start);
+    if (it != _read_ends.end()) {
+        *it = next;
+        return true;
+    }
+    _read_ends.push_back(next);
+    if (_read_ends.size() > max_tracked_readers) {
+        _read_ends.pop_front();
+    }
+    return false;
+}
+
+void remote_partition::maybe_read_ahead(archive_ptr a, chunk_position last) {
+    if (_read_ahead_chunks == 0 || _read_ahead_running) {
+        return;
+    }
+    _read_ahead_running = true;
+    (void)ss::with_gate(
+      _gate,
+      [this, a = std::move(a), last]() mutable {
+          return read_ahead(std::move(a), last);
+      })
+      .handle_exception([this](const std::exception_ptr& e) {
+          vlog(cst_log.debug, "Read-ahead of {} failed: {}", _ntp, e);
+      })
+      .finally([this] { _read_ahead_running = false; });
+}
+
+ss::future<> remote_partition::read_ahead(archive_ptr a, chunk_position last) {
+    auto it = a->segments.find(last.segment);
+    auto chunk = last.chunk;
+    for (size_t i = 0; i < _read_ahead_chunks && !_as.abort_requested(); ++i) {
+        // the chunk following the previous one, in the next non empty
+        // segment past the end of a segment
+        ++chunk;
+        while (it != a->segments.end()
+               && chunk * _chunk_size >= it->second.meta.size_bytes) {
+            ++it;
+            chunk = 0;
+        }
+        if (it == a->segments.end()) {
+            co_return;
+        }
+        const auto& s = it->second;
+        auto key = chunk_key(
+          a->partition_manifest.get_remote_segment_path(s.name), chunk);
+        if (
+          co_await _cache.is_cached(key)
+          != cache_element_status::not_available) {
+            continue;
+        }
+        auto size = std::min((chunk + 1) * _chunk_size, s.meta.size_bytes)
+                    - chunk * _chunk_size;
+        auto budget = _cache.reserve_read_ahead(size);
+        if (!budget) {
+            vlog(
+              cst_log.debug,
+              "No room in the cache to read {} ahead",
+              key.native());
+            co_return;
+        }
+        auto units = co_await _hydration_lock.get_units();
+        // a reader may have needed the chunk in the meantime
+        if (
+          co_await _cache.is_cached(key) == cache_element_status::available) {
+            continue;
+        }
+        co_await download_chunk(*a, s, chunk, key);
+    }
+}
+
+} // namespace cloud_storage
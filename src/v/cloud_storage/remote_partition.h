@@ -0,0 +1,188 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#pragma once
+
+#include "cloud_storage/cache_service.h"
+#include "cloud_storage/manifest.h"
+#include "cloud_storage/remote.h"
+#include "cloud_storage/types.h"
+#include "model/fundamental.h"
+#include "model/record_batch_reader.h"
+#include "s3/client.h"
+#include "storage/types.h"
+#include "utils/mutex.h"
+#include "utils/retry_chain_node.h"
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include <absl/container/btree_map.h>
+
+#include <chrono>
+#include <deque>
+#include <filesystem>
+
+namespace cloud_storage {
+
+using namespace std::chrono_literals;
+
+/// Location of a batch in an archived segment
+struct segment_batch_position {
+    size_t file_pos;
+    // number of configuration batches in the log before the batch
+    model::offset delta;
+};
+/// Sparse index of an archived segment, batch positions indexed by the kafka
+/// offset of the batch
+using segment_position_index
+  = absl::btree_map<model::offset, segment_batch_position>;
+
+/// Read path for the part of a partition log that was uploaded to S3 and
+/// removed from the local disk.
+///
+/// The partition manifest locates the segment containing the requested
+/// offset. Segments are downloaded to the cache in fixed size chunks using
+/// ranged requests, only the chunks covering the requested offsets are
+/// downloaded and the read starts as soon as the first one is cached. Chunks
+/// are served from the cache afterwards.
+///
+/// The position of the first batch of every chunk read is added to a sparse
+/// per-segment index so that subsequent reads start from the chunk containing
+/// the requested offset instead of the beginning of the segment.
+///
+/// Readers starting where a previous read ended are considered sequential.
+/// Once their read is done, the chunks that follow it, possibly in the next
+/// segments, are downloaded in the background so that the next read of the
+/// consumer does not wait for S3 at the chunk and segment boundaries. The
+/// read-ahead stops at the first chunk the cache has no room or read-ahead
+/// budget for.
+///
+/// The remote partition uses kafka offsets. Raft configuration batches are
+/// removed from the segments and the offsets of the other batches are
+/// adjusted using the offset deltas stored in the manifest, the same way
+/// offset_translator does for the recovered segments.
+class remote_partition {
+    static constexpr ss::lowres_clock::duration manifest_refresh_interval
+      = 30s;
+    static constexpr ss::lowres_clock::duration download_timeout = 30s;
+    static constexpr ss::lowres_clock::duration initial_backoff = 100ms;
+    // number of consumers whose reads are checked for the read-ahead
+    static constexpr size_t max_tracked_readers = 8;
+
+public:
+    remote_partition(
+      model::ntp ntp,
+      model::revision_id rev,
+      s3::bucket_name bucket,
+      remote& remote,
+      cache& cache,
+      size_t chunk_size,
+      size_t read_ahead_chunks);
+
+    remote_partition(const remote_partition&) = delete;
+    remote_partition(remote_partition&&) = delete;
+    remote_partition& operator=(const remote_partition&) = delete;
+    remote_partition& operator=(remote_partition&&) = delete;
+    ~remote_partition() = default;
+
+    /// Download the manifest in the background
+    void start();
+    ss::future<> stop();
+
+    /// Kafka offset of the first batch available in S3, nullopt until the
+    /// manifest with at least one segment was downloaded
+    std::optional<model::offset> first_offset() const;
+
+    /// Reader of the archived batches with the kafka offsets in the range
+    /// [start_offset, max_offset] of the config, limited by its max_bytes.
+    /// The manifest is refreshed first when it is older than the refresh
+    /// interval.
+    ss::future<model::record_batch_reader>
+      make_reader(storage::log_reader_config);
+
+private:
+    struct segment {
+        manifest::key name;
+        manifest::segment_meta meta;
+        ss::lw_shared_ptr<segment_position_index> index;
+    };
+    // segments indexed by the kafka offset of their first batch
+    using offset_map_t = absl::btree_map<model::offset, segment>;
+
+    /// Content of the downloaded manifest, replaced on every update so that
+    /// readers keep a consistent view while the manifest is refreshed
+    struct archive {
+        manifest partition_manifest;
+        offset_map_t segments;
+    };
+    using archive_ptr = ss::lw_shared_ptr<const archive>;
+
+    ss::future<> maybe_update_manifest();
+    ss::future<> update_manifest();
+
+    /// Stream of one chunk of the segment data, downloads the chunk to the
+    /// cache when it is not cached yet
+    ss::future<ss::input_stream<char>>
+    hydrate(const archive&, const segment&, size_t chunk);
+
+    /// Downloads the chunk to the cache, the hydration lock must be held
+    ss::future<> download_chunk(
+      const archive&,
+      const segment&,
+      size_t chunk,
+      const std::filesystem::path& key);
+
+    /// Adds the batches of the segment within the range of the config to
+    /// `batches`, the config start offset is moved past the consumed batches.
+    /// Returns the last chunk read, nullopt when the segment is empty
+    ss::future<std::optional<size_t>> read_segment(
+      const archive&,
+      const segment&,
+      storage::log_reader_config&,
+      model::record_batch_reader::data_t& batches);
+
+    /// Chunk of a segment, identified by the kafka offset of the segment
+    struct chunk_position {
+        model::offset segment;
+        size_t chunk;
+    };
+
+    /// True when a read starting at \p start continues a previous read, the
+    /// read is then tracked as ending at \p next
+    bool is_sequential(model::offset start, model::offset next);
+
+    /// Downloads the chunks following \p last in the background, unless a
+    /// read-ahead of the partition is already running
+    void maybe_read_ahead(archive_ptr, chunk_position last);
+    ss::future<> read_ahead(archive_ptr, chunk_position last);
+
+    model::ntp _ntp;
+    s3::bucket_name _bucket;
+    remote& _remote;
+    cache& _cache;
+    size_t _chunk_size;
+    size_t _read_ahead_chunks;
+    model::revision_id _rev;
+    archive_ptr _archive;
+    ss::lowres_clock::time_point _manifest_updated_at;
+    mutex _manifest_lock;
+    // one segment download at a time
+    mutex _hydration_lock;
+    // offsets following the recent reads, oldest first
+    std::deque<model::offset> _read_ends;
+    bool _read_ahead_running{false};
+    ss::gate _gate;
+    ss::abort_source _as;
+};
+
+} // namespace cloud_storage
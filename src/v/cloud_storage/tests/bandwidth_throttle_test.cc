@@ -0,0 +1,66 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "cloud_storage/bandwidth_throttle.h"
+#include "bytes/iobuf.h"
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+using namespace std::chrono_literals;
+
+SEASTAR_THREAD_TEST_CASE(test_bandwidth_throttle_unlimited) {
+    cloud_storage::bandwidth_throttle throttle(0);
+    auto f = throttle.throttle(1024 * 1024 * 1024);
+    BOOST_REQUIRE(f.available());
+    f.get();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_bandwidth_throttle_rate) {
+    cloud_storage::bandwidth_throttle throttle(1000);
+    // the bucket starts full
+    auto f = throttle.throttle(1000);
+    BOOST_REQUIRE(f.available());
+    f.get();
+
+    auto start = ss::lowres_clock::now();
+    throttle.throttle(500).get();
+    BOOST_REQUIRE_GE(ss::lowres_clock::now() - start, 400ms);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_bandwidth_throttle_stream) {
+    cloud_storage::bandwidth_throttle throttle(1000);
+    // two buffers, the second one waits for the bucket to refill
+    iobuf buf;
+    buf.append(ss::temporary_buffer<char>(750));
+    buf.append(ss::temporary_buffer<char>(750));
+    auto start = ss::lowres_clock::now();
+    auto in = throttle.wrap(make_iobuf_input_stream(std::move(buf)));
+    size_t total = 0;
+    while (true) {
+        auto tmp = in.read().get0();
+        if (tmp.empty()) {
+            break;
+        }
+        total += tmp.size();
+    }
+    in.close().get();
+    BOOST_REQUIRE_EQUAL(total, 1500);
+    BOOST_REQUIRE_GE(ss::lowres_clock::now() - start, 400ms);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_bandwidth_throttle_shutdown) {
+    cloud_storage::bandwidth_throttle throttle(1000);
+    throttle.throttle(1000).get();
+    auto f = throttle.throttle(1000);
+    throttle.shutdown();
+    BOOST_REQUIRE_THROW(f.get(), ss::broken_semaphore);
+}
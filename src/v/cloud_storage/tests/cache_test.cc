@@ -16,6 +16,7 @@
 
 #include <seastar/core/seastar.hh>
 #include <seastar/core/sleep.hh>
+#include <seastar/util/defer.hh>
 
 #include <boost/test/tools/old/interface.hpp>
 #include <boost/test/unit_test.hpp>
@@ -148,3 +149,69 @@ FIXTURE_TEST(cannot_put_tmp_file, cache_test_fixture) {
     BOOST_CHECK_THROW(
       put_into_cache(data_string1, TEMP_KEY), std::invalid_argument);
 }
+
+FIXTURE_TEST(least_recently_used_file_deleted, cache_test_fixture) {
+    const std::filesystem::path key3{"abc003/test_topic3/test_cache_file3.txt"};
+    put_into_cache(create_data_string('a', 700_KiB), KEY);
+    put_into_cache(create_data_string('b', 700_KiB), KEY2);
+    // reading the older file makes the other one the least recently used
+    cache_service.get(KEY).get()->body.close().get();
+    put_into_cache(create_data_string('c', 200_KiB), key3);
+
+    ss::sleep(ss::lowres_clock::duration(2s)).get();
+
+    BOOST_CHECK_EQUAL(700_KiB, cache_service.get_total_cleaned());
+    BOOST_REQUIRE(ss::file_exists((CACHE_DIR / KEY).native()).get());
+    BOOST_REQUIRE(!ss::file_exists((CACHE_DIR / KEY2).native()).get());
+    BOOST_REQUIRE(ss::file_exists((CACHE_DIR / key3).native()).get());
+}
+
+FIXTURE_TEST(index_restored_after_restart, cache_test_fixture) {
+    const std::filesystem::path dir{"test_cache_restore_dir"};
+    auto remove_dir = ss::defer(
+      [&dir] { boost::filesystem::remove_all(dir.native()); });
+    {
+        cloud_storage::cache cache(dir, 1_MiB + 500_KiB, 1s, 0);
+        cache.start().get();
+        iobuf buf;
+        buf.append(create_data_string('a', 1_MiB + 1_KiB));
+        auto input = make_iobuf_input_stream(std::move(buf));
+        cache.put(KEY, input).get();
+        cache.stop().get();
+    }
+    BOOST_REQUIRE(ss::file_exists((dir / "cache_index").native()).get());
+
+    // the restored cache is smaller, the file from the index is evicted
+    cloud_storage::cache cache(dir, 1_MiB, 1s, 0);
+    cache.start().get();
+    auto stop = ss::defer([&cache] { cache.stop().get(); });
+    BOOST_REQUIRE(!ss::file_exists((dir / "cache_index").native()).get());
+
+    ss::sleep(ss::lowres_clock::duration(2s)).get();
+
+    BOOST_CHECK_EQUAL(1_MiB + 1_KiB, cache.get_total_cleaned());
+    BOOST_REQUIRE(!ss::file_exists((dir / KEY).native()).get());
+}
+
+FIXTURE_TEST(read_ahead_bounded_by_budget_and_space, cache_test_fixture) {
+    const std::filesystem::path dir{"test_cache_read_ahead_dir"};
+    auto remove_dir = ss::defer(
+      [&dir] { boost::filesystem::remove_all(dir.native()); });
+    cloud_storage::cache cache(dir, 1_MiB, 1s, 256_KiB);
+    cache.start().get();
+    auto stop = ss::defer([&cache] { cache.stop().get(); });
+
+    // the downloads in flight share the budget
+    auto first = cache.reserve_read_ahead(200_KiB);
+    BOOST_REQUIRE(first);
+    BOOST_REQUIRE(!cache.reserve_read_ahead(100_KiB));
+    first = std::nullopt;
+
+    // and must fit below the eviction low watermark with the cached files
+    iobuf buf;
+    buf.append(create_data_string('a', 700_KiB));
+    auto input = make_iobuf_input_stream(std::move(buf));
+    cache.put(KEY, input).get();
+    BOOST_REQUIRE(!cache.reserve_read_ahead(200_KiB));
+    BOOST_REQUIRE(cache.reserve_read_ahead(100_KiB));
+}
@@ -39,7 +39,7 @@ public:
 
     cache_test_fixture()
       : cache_service(
-        CACHE_DIR, 1_MiB + 500_KiB, ss::lowres_clock::duration(1s)) {
+        CACHE_DIR, 1_MiB + 500_KiB, ss::lowres_clock::duration(1s), 0) {
         cache_service.start().get();
     }
 
@@ -314,3 +314,79 @@ SEASTAR_THREAD_TEST_CASE(test_segment_path_parsing_failure_5) {
     auto res = cloud_storage::get_segment_path_components(path);
     BOOST_REQUIRE(!res.has_value());
 }
+
+SEASTAR_THREAD_TEST_CASE(test_manifest_binary_serialization) {
+    manifest m(manifest_ntp, model::revision_id(0));
+    m.add(
+      segment_name("10-1-v1.log"),
+      {
+        .is_compacted = false,
+        .size_bytes = 1024,
+        .base_offset = model::offset(10),
+        .committed_offset = model::offset(19),
+        .max_timestamp = model::timestamp(1234),
+        .delta_offset = model::offset(1),
+      });
+    m.add(
+      remote_segment_path("6fab5988/test-ns/test-topic/42_1/20-1-v1.log"),
+      {
+        .is_compacted = true,
+        .size_bytes = 2048,
+        .base_offset = model::offset(20),
+        .committed_offset = model::offset(29),
+        .max_timestamp = model::timestamp::missing(),
+      });
+    m.set_generation(3);
+    m.set_format(manifest_format::binary);
+    auto [is, size] = m.serialize();
+    iobuf buf;
+    auto os = make_iobuf_ref_output_stream(buf);
+    ss::copy(is, os).get();
+    BOOST_REQUIRE_EQUAL(buf.size_bytes(), size);
+
+    auto rstr = make_iobuf_input_stream(std::move(buf));
+    manifest restored;
+    restored.update(std::move(rstr)).get0();
+
+    BOOST_REQUIRE(m == restored);
+    BOOST_REQUIRE(restored.get_generation() == 3);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_manifest_generation_json) {
+    manifest m(manifest_ntp, model::revision_id(0));
+    m.set_generation(7);
+    auto [is, size] = m.serialize();
+    manifest restored;
+    restored.update(std::move(is)).get0();
+    BOOST_REQUIRE(m == restored);
+    BOOST_REQUIRE(restored.get_generation() == 7);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_manifest_delta) {
+    manifest m(manifest_ntp, model::revision_id(0));
+    m.add(
+      segment_name("10-1-v1.log"),
+      {
+        .size_bytes = 1024,
+        .base_offset = model::offset(10),
+        .committed_offset = model::offset(19),
+      });
+    manifest delta(manifest_ntp, model::revision_id(0));
+    delta.add(
+      segment_name("20-1-v1.log"),
+      {
+        .size_bytes = 2048,
+        .base_offset = model::offset(20),
+        .committed_offset = model::offset(29),
+      });
+    m.apply_delta(delta);
+    BOOST_REQUIRE_EQUAL(m.size(), 2);
+    BOOST_REQUIRE(m.contains(segment_name("20-1-v1.log")));
+    BOOST_REQUIRE_EQUAL(m.get_last_offset(), model::offset(29));
+
+    auto prefix = m.get_manifest_delta_prefix(3)().native();
+    auto path = m.get_manifest_delta_path(3, 12)().native();
+    BOOST_REQUIRE(std::string_view(path).starts_with(prefix));
+    BOOST_REQUIRE(path.ends_with("/manifest.3.0000000012"));
+    BOOST_REQUIRE(!get_manifest_path_components(path));
+}
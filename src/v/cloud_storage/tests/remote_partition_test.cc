@@ -0,0 +1,285 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "bytes/iobuf.h"
+#include "bytes/iobuf_parser.h"
+#include "cloud_storage/cache_service.h"
+#include "cloud_storage/remote.h"
+#include "cloud_storage/remote_partition.h"
+#include "cloud_storage/tests/s3_imposter.h"
+#include "cloud_storage/types.h"
+#include "model/record_batch_reader.h"
+#include "seastarx.h"
+#include "storage/segment_appender_utils.h"
+#include "storage/tests/utils/random_batch.h"
+#include "test_utils/async.h"
+#include "test_utils/fixture.h"
+#include "units.h"
+
+#include <seastar/core/io_priority_class.hh>
+#include <seastar/util/defer.hh>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace std::chrono_literals;
+using namespace cloud_storage;
+
+static ss::sstring make_manifest_payload(size_t segment_size) {
+    return fmt::format(
+      R"json({{
+    "version": 1,
+    "namespace": "kafka",
+    "topic": "test-topic",
+    "partition": 42,
+    "revision": 0,
+    "last_offset": 5,
+    "segments": {{
+        "0-1-v1.log": {{
+            "is_compacted": false,
+            "size_bytes": {},
+            "committed_offset": 5,
+            "base_offset": 0,
+            "delta_offset": 0
+        }}
+    }}
+}})json",
+      segment_size);
+}
+static const auto manifest_ntp = model::ntp( // NOLINT
+  model::ns("kafka"),
+  model::topic("test-topic"),
+  model::partition_id(42));
+static const auto manifest_revision = model::revision_id(0); // NOLINT
+static const std::filesystem::path cache_dir{"test_remote_partition_cache"};
+// smaller than the batches to make them span the chunk boundaries
+static constexpr size_t chunk_size = 64;
+
+/// Segment with data batches at offsets [0, 2] and [4, 5] and a raft
+/// configuration batch at offset 3 in between
+static ss::sstring make_segment() {
+    iobuf segment;
+    auto append = [&segment](model::record_batch b) {
+        segment.append(storage::disk_header_to_iobuf(b.header()));
+        segment.append(b.data().copy());
+    };
+    append(storage::test::make_random_batch(
+      model::offset(0), 3, false, model::record_batch_type::raft_data));
+    append(storage::test::make_random_batch(
+      model::offset(3),
+      1,
+      false,
+      model::record_batch_type::raft_configuration));
+    append(storage::test::make_random_batch(
+      model::offset(4), 2, false, model::record_batch_type::raft_data));
+    iobuf_parser p(std::move(segment));
+    return p.read_string(p.bytes_left());
+}
+
+/// Segment with data batches at kafka offsets [0, 2], [3, 5], [6, 8] and
+/// [9, 11], a raft configuration batch follows the first one
+static ss::sstring make_long_segment() {
+    iobuf segment;
+    auto append = [&segment](model::record_batch b) {
+        segment.append(storage::disk_header_to_iobuf(b.header()));
+        segment.append(b.data().copy());
+    };
+    append(storage::test::make_random_batch(
+      model::offset(0), 3, false, model::record_batch_type::raft_data));
+    append(storage::test::make_random_batch(
+      model::offset(3),
+      1,
+      false,
+      model::record_batch_type::raft_configuration));
+    for (int64_t base = 4; base < 13; base += 3) {
+        append(storage::test::make_random_batch(
+          model::offset(base), 3, false, model::record_batch_type::raft_data));
+    }
+    iobuf_parser p(std::move(segment));
+    return p.read_string(p.bytes_left());
+}
+
+static ss::sstring segment_url() {
+    manifest m(manifest_ntp, manifest_revision);
+    auto path = m.get_remote_segment_path(segment_name("0-1-v1.log"));
+    return "/" + path().string();
+}
+
+static std::vector<s3_imposter_fixture::expectation>
+make_expectations(const ss::sstring& segment) {
+    manifest m(manifest_ntp, manifest_revision);
+    return {
+      s3_imposter_fixture::expectation{
+        .url = "/" + m.get_manifest_path()().string(),
+        .body = make_manifest_payload(segment.size())},
+      s3_imposter_fixture::expectation{.url = segment_url(), .body = segment},
+    };
+}
+
+static storage::log_reader_config
+reader_config(model::offset start, model::offset max) {
+    return storage::log_reader_config(
+      start,
+      max,
+      0,
+      1_MiB,
+      ss::default_priority_class(),
+      model::record_batch_type::raft_data,
+      std::nullopt,
+      std::nullopt);
+}
+
+FIXTURE_TEST(test_read_archived_segment, s3_imposter_fixture) { // NOLINT
+    auto segment = make_segment();
+    set_expectations_and_listen(make_expectations(segment));
+    remote api(s3_connection_limit(10), get_configuration());
+    cloud_storage::cache cache(cache_dir, 1_MiB, 1s, 0);
+    cache.start().get();
+    auto stop = ss::defer([&api, &cache] {
+        cache.stop().get();
+        api.stop().get();
+        boost::filesystem::remove_all(cache_dir.native());
+    });
+
+    remote_partition partition(
+      manifest_ntp,
+      manifest_revision,
+      s3::bucket_name("bucket"),
+      api,
+      cache,
+      chunk_size,
+      0);
+    auto stop_partition = ss::defer([&partition] { partition.stop().get(); });
+
+    // the configuration batch is removed and the offsets following it are
+    // translated to kafka offsets
+    auto batches = model::consume_reader_to_memory(
+                     partition
+                       .make_reader(reader_config(
+                         model::offset(0), model::offset::max()))
+                       .get(),
+                     model::no_timeout)
+                     .get();
+    BOOST_REQUIRE_EQUAL(batches.size(), 2);
+    BOOST_REQUIRE_EQUAL(batches[0].base_offset(), model::offset(0));
+    BOOST_REQUIRE_EQUAL(batches[0].last_offset(), model::offset(2));
+    BOOST_REQUIRE_EQUAL(batches[1].base_offset(), model::offset(3));
+    BOOST_REQUIRE_EQUAL(batches[1].last_offset(), model::offset(4));
+    BOOST_REQUIRE_EQUAL(partition.first_offset(), model::offset(0));
+
+    // every chunk of the segment was downloaded once
+    auto chunks = (segment.size() + chunk_size - 1) / chunk_size;
+    BOOST_REQUIRE_EQUAL(get_targets().count(segment_url()), chunks);
+
+    // the read starts from the indexed chunk and is served from the cache
+    batches = model::consume_reader_to_memory(
+                partition
+                  .make_reader(
+                    reader_config(model::offset(3), model::offset::max()))
+                  .get(),
+                model::no_timeout)
+                .get();
+    BOOST_REQUIRE_EQUAL(batches.size(), 1);
+    BOOST_REQUIRE_EQUAL(batches[0].base_offset(), model::offset(3));
+    BOOST_REQUIRE_EQUAL(get_targets().count(segment_url()), chunks);
+}
+
+FIXTURE_TEST(test_read_first_chunk_only, s3_imposter_fixture) { // NOLINT
+    auto segment = make_segment();
+    set_expectations_and_listen(make_expectations(segment));
+    remote api(s3_connection_limit(10), get_configuration());
+    cloud_storage::cache cache(cache_dir, 1_MiB, 1s, 0);
+    cache.start().get();
+    auto stop = ss::defer([&api, &cache] {
+        cache.stop().get();
+        api.stop().get();
+        boost::filesystem::remove_all(cache_dir.native());
+    });
+
+    remote_partition partition(
+      manifest_ntp,
+      manifest_revision,
+      s3::bucket_name("bucket"),
+      api,
+      cache,
+      segment.size() - 1,
+      0);
+    auto stop_partition = ss::defer([&partition] { partition.stop().get(); });
+
+    // the first batch ends in the first chunk, the last byte of the segment
+    // is not downloaded
+    auto batches = model::consume_reader_to_memory(
+                     partition
+                       .make_reader(
+                         reader_config(model::offset(0), model::offset(2)))
+                       .get(),
+                     model::no_timeout)
+                     .get();
+    BOOST_REQUIRE_EQUAL(batches.size(), 1);
+    BOOST_REQUIRE_EQUAL(batches[0].base_offset(), model::offset(0));
+    BOOST_REQUIRE_EQUAL(get_targets().count(segment_url()), 1);
+}
+
+FIXTURE_TEST(test_read_ahead_of_sequential_reader, s3_imposter_fixture) {
+    auto segment = make_long_segment();
+    set_expectations_and_listen(make_expectations(segment));
+    remote api(s3_connection_limit(10), get_configuration());
+    cloud_storage::cache cache(cache_dir, 1_MiB, 1s, 1_MiB);
+    cache.start().get();
+    auto stop = ss::defer([&api, &cache] {
+        cache.stop().get();
+        api.stop().get();
+        boost::filesystem::remove_all(cache_dir.native());
+    });
+
+    remote_partition partition(
+      manifest_ntp,
+      manifest_revision,
+      s3::bucket_name("bucket"),
+      api,
+      cache,
+      chunk_size,
+      1000);
+    auto stop_partition = ss::defer([&partition] { partition.stop().get(); });
+
+    auto read = [&partition](int64_t start, int64_t max) {
+        return model::consume_reader_to_memory(
+                 partition
+                   .make_reader(reader_config(
+                     model::offset(start), model::offset(max)))
+                   .get(),
+                 model::no_timeout)
+          .get();
+    };
+    auto chunks = (segment.size() + chunk_size - 1) / chunk_size;
+
+    // the first read of the consumer only downloads the chunks it reads
+    BOOST_REQUIRE_EQUAL(read(0, 2).size(), 1);
+    auto downloaded = get_targets().count(segment_url());
+    BOOST_REQUIRE_LT(downloaded, chunks);
+
+    // a read out of order isn't followed by a read-ahead either
+    BOOST_REQUIRE_EQUAL(read(9, 11).size(), 1);
+    BOOST_REQUIRE_LT(get_targets().count(segment_url()), chunks);
+
+    // the read continuing the first one is, the rest of the segment is
+    // downloaded in the background
+    BOOST_REQUIRE_EQUAL(read(3, 5).size(), 1);
+    tests::cooperative_spin_wait_with_timeout(10s, [this, chunks] {
+        return get_targets().count(segment_url()) == chunks;
+    }).get();
+
+    // and the following reads are served from the cache
+    auto batches = read(6, 11);
+    BOOST_REQUIRE_EQUAL(batches.size(), 2);
+    BOOST_REQUIRE_EQUAL(batches[0].base_offset(), model::offset(6));
+    BOOST_REQUIRE_EQUAL(batches[1].last_offset(), model::offset(11));
+    BOOST_REQUIRE_EQUAL(get_targets().count(segment_url()), chunks);
+}
@@ -28,6 +28,8 @@
 #include <boost/test/tools/old/interface.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <cstring>
+
 using namespace std::chrono_literals;
 
 inline ss::logger fixt_log("fixture"); // NOLINT
@@ -112,6 +114,10 @@ void s3_imposter_fixture::set_routes(
                     repl.set_status(reply::status_type::not_found);
                     return error_payload;
                 }
+                auto range = request.get_header("Range");
+                if (!range.empty()) {
+                    return handle_range(*it->second.body, range, repl);
+                }
                 return *it->second.body;
             } else if (request._method == "PUT") {
                 expectations[request._url] = {
@@ -131,6 +137,18 @@ void s3_imposter_fixture::set_routes(
             BOOST_FAIL("Unexpected request");
             return "";
         }
+        /// Reply to a ranged GET, the range has 'bytes={first}-{last}' format
+        static ss::sstring handle_range(
+          const ss::sstring& body, const ss::sstring& range, reply& repl) {
+            auto bounds = range.substr(std::strlen("bytes="));
+            auto sep = bounds.find('-');
+            BOOST_REQUIRE(sep != ss::sstring::npos);
+            auto first = std::stoul(bounds.substr(0, sep));
+            auto last = std::stoul(bounds.substr(sep + 1));
+            BOOST_REQUIRE(first <= last && last < body.size());
+            repl.set_status(reply::status_type::partial_content);
+            return body.substr(first, last - first + 1);
+        }
         std::map<ss::sstring, expectation> expectations;
         s3_imposter_fixture& fixture;
     };
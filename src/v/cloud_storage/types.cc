@@ -2,6 +2,11 @@
 
 #include "cloud_storage/logger.h"
 #include "config/configuration.h"
+#include "units.h"
+
+#include <seastar/core/smp.hh>
+
+#include <algorithm>
 
 namespace cloud_storage {
 
@@ -42,14 +47,22 @@ std::ostream& operator<<(std::ostream& o, const configuration& cfg) {
     fmt::print(
       o,
       "{{connection_limit: {}, client_config: {}, metrics_disabled: {}, "
-      "bucket_name: {}",
+      "bucket_name: {}, multipart_part_size: {}, multipart_parallelism: {}, "
+      "recovery_concurrency: {}, recovery_bandwidth: {}}}",
       cfg.connection_limit,
       cfg.client_config,
       cfg.metrics_disabled,
-      cfg.bucket_name);
+      cfg.bucket_name,
+      cfg.multipart.part_size,
+      cfg.multipart.parallelism,
+      cfg.recovery.concurrency,
+      cfg.recovery.bandwidth);
     return o;
 }
 
+/// S3 rejects the parts smaller than 5MiB, except the last one
+static constexpr size_t min_multipart_part_size = 5_MiB;
+
 static ss::sstring get_value_or_throw(
   const config::property<std::optional<ss::sstring>>& prop, const char* name) {
     auto opt = prop.value();
@@ -88,6 +101,10 @@ ss::future<configuration> configuration::get_config() {
         overrides.endpoint = s3::endpoint_url(*optep);
     }
     overrides.disable_tls = config::shard_local_cfg().cloud_storage_disable_tls;
+    overrides.sign_payload
+      = config::shard_local_cfg().cloud_storage_sign_payload();
+    overrides.hedge_percentile
+      = config::shard_local_cfg().cloud_storage_hedge_percentile();
     if (auto cert = config::shard_local_cfg().cloud_storage_trust_file.value();
         cert.has_value()) {
         overrides.trust_file = s3::ca_trust_file(std::filesystem::path(*cert));
@@ -107,6 +124,25 @@ ss::future<configuration> configuration::get_config() {
         config::shard_local_cfg().cloud_storage_bucket,
         "cloud_storage_bucket")),
     };
+    if (auto part_size
+        = config::shard_local_cfg().cloud_storage_segment_upload_part_size();
+        part_size > 0) {
+        cfg.multipart = multipart_upload_config{
+          .part_size = std::max(part_size, min_multipart_part_size),
+          .parallelism = std::max<size_t>(
+            config::shard_local_cfg()
+              .cloud_storage_segment_upload_parallelism(),
+            1),
+        };
+    }
+    cfg.recovery = recovery_config{
+      .concurrency = std::max<size_t>(
+        config::shard_local_cfg().cloud_storage_recovery_concurrency(), 1),
+      .bandwidth = config::shard_local_cfg()
+                     .cloud_storage_max_recovery_bandwidth()
+                     .value_or(0)
+                   / ss::smp::count,
+    };
     vlog(cst_log.debug, "Cloud storage configuration generated: {}", cfg);
     co_return cfg;
 }
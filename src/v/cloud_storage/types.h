@@ -67,6 +67,24 @@ std::ostream& operator<<(std::ostream& o, const download_result& r);
 
 std::ostream& operator<<(std::ostream& o, const upload_result& r);
 
+/// Multipart upload parameters of the segment uploads
+struct multipart_upload_config {
+    /// Segments larger than the part size are uploaded in parts of this
+    /// size, multipart uploads are disabled if the size is 0
+    size_t part_size{0};
+    /// Max number of parts of a segment uploaded concurrently
+    size_t parallelism{1};
+};
+
+/// Parameters of the segment downloads of the topic recovery
+struct recovery_config {
+    /// Max number of segments of a partition downloaded concurrently
+    size_t concurrency{1};
+    /// Bandwidth of the downloads of the shard in bytes per second, unlimited
+    /// if 0
+    size_t bandwidth{0};
+};
+
 struct configuration {
     /// S3 configuration
     s3::configuration client_config;
@@ -76,6 +94,10 @@ struct configuration {
     remote_metrics_disabled metrics_disabled;
     /// The bucket to use
     s3::bucket_name bucket_name;
+    /// Multipart upload parameters of the segment uploads
+    multipart_upload_config multipart;
+    /// Parameters of the topic recovery downloads
+    recovery_config recovery;
 
     static ss::future<configuration> get_config();
 };
@@ -192,4 +192,38 @@ ss::future<std::error_code> replicate_and_wait(
       });
 }
 
+/// replicates the commands in a single controller append and waits until all
+/// of them are applied, returns the result of every command in order
+template<typename Cmd>
+ss::future<std::vector<std::error_code>> replicate_and_wait_all(
+  ss::sharded<controller_stm>& stm,
+  ss::sharded<ss::abort_source>& as,
+  std::vector<Cmd> cmds,
+  model::timeout_clock::time_point timeout) {
+    return stm.invoke_on(
+      controller_stm_shard,
+      [cmds = std::move(cmds), &as = as, timeout](
+        controller_stm& stm) mutable {
+          return ss::do_with(
+            std::move(cmds),
+            model::record_batch_reader::data_t{},
+            [&stm, &as, timeout](
+              std::vector<Cmd>& cmds,
+              model::record_batch_reader::data_t& batches) {
+                return ss::do_for_each(
+                         cmds,
+                         [&batches](Cmd& cmd) {
+                             return serialize_cmd(std::move(cmd))
+                               .then([&batches](model::record_batch b) {
+                                   batches.push_back(std::move(b));
+                               });
+                         })
+                  .then([&stm, &as, &batches, timeout] {
+                      return stm.replicate_and_wait(
+                        std::move(batches), timeout, as.local());
+                  });
+            });
+      });
+}
+
 } // namespace cluster
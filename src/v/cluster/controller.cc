@@ -97,11 +97,22 @@ ss::future<> controller::start() {
             std::ref(clusterlog),
             _raft0.get(),
             raft::persistent_last_applied::yes,
+            std::ref(_members_manager),
             std::ref(_tp_updates_dispatcher),
             std::ref(_security_manager),
-            std::ref(_members_manager),
             std::ref(_data_policy_manager));
       })
+      .then([this] {
+          auto interval
+            = config::shard_local_cfg().controller_snapshot_max_batches();
+          if (interval > 0) {
+              return _stm.invoke_on(
+                controller_stm_shard, [interval](controller_stm& stm) {
+                    stm.enable_snapshots(interval);
+                });
+          }
+          return ss::now();
+      })
       .then([this] {
           return _members_frontend.start(
             std::ref(_stm),
@@ -207,6 +218,7 @@ ss::future<> controller::start() {
             std::ref(_shard_table),
             std::ref(_partition_manager),
             std::ref(_raft_manager),
+            std::ref(_health_manager),
             std::ref(_as),
             config::shard_local_cfg().leader_balancer_idle_timeout(),
             config::shard_local_cfg().leader_balancer_mute_timeout(),
@@ -223,11 +235,27 @@ ss::future<> controller::start() {
             std::ref(_tp_frontend),
             std::ref(_partition_allocator),
             std::ref(_partition_leaders),
+            std::ref(_members_table),
+            std::ref(_partition_manager),
+            std::ref(_connections),
             std::ref(_as));
       })
       .then([this] {
           return _health_manager.invoke_on(
             health_manager::shard, &health_manager::start);
+      })
+      .then([this] {
+          return _partition_balancer.start_single(
+            std::ref(_tp_state),
+            std::ref(_tp_frontend),
+            std::ref(_partition_allocator),
+            std::ref(_health_manager),
+            _raft0,
+            std::ref(_as));
+      })
+      .then([this] {
+          return _partition_balancer.invoke_on(
+            partition_balancer::shard, &partition_balancer::start);
       });
 }
 
@@ -250,6 +278,7 @@ ss::future<> controller::stop() {
         auto stop_leader_balancer = _leader_balancer ? _leader_balancer->stop()
                                                      : ss::now();
         return stop_leader_balancer
+          .then([this] { return _partition_balancer.stop(); })
           .then([this] { return _health_manager.stop(); })
           .then([this] { return _members_backend.stop(); })
           .then([this] { return _api.stop(); })
@@ -14,6 +14,7 @@
 #include "cluster/controller_stm.h"
 #include "cluster/fwd.h"
 #include "cluster/health_manager.h"
+#include "cluster/partition_balancer.h"
 #include "cluster/scheduling/leader_balancer.h"
 #include "cluster/topic_updates_dispatcher.h"
 #include "raft/group_manager.h"
@@ -71,6 +72,10 @@ public:
         return _members_frontend;
     }
 
+    ss::sharded<health_manager>& get_health_manager() {
+        return _health_manager;
+    }
+
     ss::future<> wire_up();
 
     ss::future<> start();
@@ -106,6 +111,7 @@ private:
     ss::sharded<security::authorizer> _authorizer;
     ss::sharded<raft::group_manager>& _raft_manager;
     ss::sharded<health_manager> _health_manager;
+    ss::sharded<partition_balancer> _partition_balancer; // single instance
     std::unique_ptr<leader_balancer> _leader_balancer;
     consensus_ptr _raft0;
 };
@@ -25,8 +25,10 @@
 #include "model/fundamental.h"
 #include "model/metadata.h"
 #include "outcome.h"
+#include "prometheus/prometheus_sanitize.h"
 #include "raft/group_configuration.h"
 #include "raft/types.h"
+#include "storage/api.h"
 #include "ssx/future-util.h"
 #include "vassert.h"
 
@@ -35,6 +37,8 @@
 #include <seastar/core/future-util.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/metrics.hh>
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/sharded.hh>
 #include <seastar/core/smp.hh>
@@ -187,11 +191,34 @@ ss::future<> controller_backend::stop() {
 }
 
 ss::future<> controller_backend::start() {
-    return bootstrap_controller_backend().then([this] {
-        start_topics_reconciliation_loop();
-        _housekeeping_timer.set_callback([this] { housekeeping(); });
-        _housekeeping_timer.arm(_housekeeping_timer_interval);
+    if (!config::shard_local_cfg().controller_backend_background_bootstrap()) {
+        return bootstrap_controller_backend().then(
+          [this] { start_reconciliation(); });
+    }
+    /*
+     * the partitions that are not bootstrapped yet are missing from the shard
+     * table, the kafka api answers for them with a retriable error. the
+     * reconciliation loop retries the partitions that failed to bootstrap.
+     */
+    (void)ss::with_gate(_gate, [this] {
+        return bootstrap_controller_backend()
+          .handle_exception([](const std::exception_ptr& e) {
+              vlog(clusterlog.error, "Error while bootstrapping - {}", e);
+          })
+          .then([this] {
+              if (!_gate.is_closed()) {
+                  start_reconciliation();
+              }
+          });
     });
+    return ss::now();
+}
+
+void controller_backend::start_reconciliation() {
+    setup_metrics();
+    start_topics_reconciliation_loop();
+    _housekeeping_timer.set_callback([this] { housekeeping(); });
+    _housekeeping_timer.arm(_housekeeping_timer_interval);
 }
 
 ss::future<> controller_backend::bootstrap_controller_backend() {
@@ -206,12 +233,78 @@ ss::future<> controller_backend::bootstrap_controller_backend() {
     });
 }
 
+void controller_backend::setup_metrics() {
+    namespace sm = ss::metrics;
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("cluster:controller_backend"),
+      {sm::make_gauge(
+         "queued_partitions",
+         [this] { return _topic_deltas.size(); },
+         sm::description("Number of partitions with deltas to reconcile")),
+       sm::make_gauge(
+         "queued_deltas",
+         [this] {
+             size_t deltas = 0;
+             for (auto& [_, d] : _topic_deltas) {
+                 deltas += d.size();
+             }
+             return deltas;
+         },
+         sm::description("Number of deltas waiting to be reconciled")),
+       sm::make_histogram(
+         "reconciliation_latency",
+         [this] { return _reconciliation_latency.seastar_histogram_logform(); },
+         sm::description("Time from queueing the first delta of a partition "
+                         "until all its deltas are reconciled"))});
+}
+
+/**
+ * Order in which partitions are bootstrapped, lowest first. Internal topics
+ * gate group coordination and transactions, then partitions of which this
+ * node is the preferred (first) replica: those are the ones it most likely
+ * led before restarting, recovering them first gives leadership back sooner.
+ */
+static int bootstrap_priority(
+  model::node_id self,
+  const model::ntp& ntp,
+  const std::vector<topic_table::delta>& deltas) {
+    if (ntp.ns != model::kafka_namespace) {
+        return 0;
+    }
+    if (deltas.empty()) {
+        return 2;
+    }
+    const auto& replicas = deltas.back().new_assignment.replicas;
+    return !replicas.empty() && replicas.front().node_id == self ? 1 : 2;
+}
+
 ss::future<> controller_backend::do_bootstrap() {
-    return ss::parallel_for_each(
-      _topic_deltas.begin(),
-      _topic_deltas.end(),
-      [this](underlying_t::value_type& ntp_deltas) {
-          return bootstrap_ntp(ntp_deltas.first, ntp_deltas.second);
+    // _topic_deltas is not modified until bootstrap is finished, pointers to
+    // its elements stay valid
+    std::vector<underlying_t::value_type*> ordered;
+    ordered.reserve(_topic_deltas.size());
+    for (auto& ntp_deltas : _topic_deltas) {
+        ordered.push_back(&ntp_deltas);
+    }
+    std::stable_sort(
+      ordered.begin(),
+      ordered.end(),
+      [this](underlying_t::value_type* a, underlying_t::value_type* b) {
+          return bootstrap_priority(_self, a->first, a->second)
+                 < bootstrap_priority(_self, b->first, b->second);
+      });
+    return ss::do_with(
+      std::move(ordered), [this](std::vector<underlying_t::value_type*>& o) {
+          return ss::max_concurrent_for_each(
+            o,
+            config::shard_local_cfg()
+              .controller_backend_max_concurrent_reconciliations(),
+            [this](underlying_t::value_type* ntp_deltas) {
+                return bootstrap_ntp(ntp_deltas->first, ntp_deltas->second);
+            });
       });
 }
 
@@ -325,8 +418,10 @@ ss::future<> controller_backend::fetch_deltas() {
       .then([this](deltas_t deltas) {
           return ss::with_semaphore(
             _topics_sem, 1, [this, deltas = std::move(deltas)]() mutable {
+                auto now = clock_type::now();
                 for (auto& d : deltas) {
                     auto ntp = d.ntp;
+                    _queued_at.try_emplace(ntp, now);
                     _topic_deltas[ntp].push_back(std::move(d));
                 }
             });
@@ -350,6 +445,13 @@ void controller_backend::start_topics_reconciliation_loop() {
     });
 }
 
+void controller_backend::trigger_housekeeping() {
+    // when not armed housekeeping is already running
+    if (_housekeeping_timer.armed()) {
+        _housekeeping_timer.rearm(ss::timer<>::clock::now());
+    }
+}
+
 void controller_backend::housekeeping() {
     (void)ss::with_gate(_gate, [this] {
         auto f = ss::now();
@@ -447,27 +549,36 @@ ss::future<> controller_backend::reconcile_topics() {
         if (_topic_deltas.empty()) {
             return ss::now();
         }
-        // reconcile NTPs in parallel
-        return ss::parallel_for_each(
-                 _topic_deltas.begin(),
-                 _topic_deltas.end(),
+        // reconcile NTPs in parallel, with bounded concurrency
+        return ss::max_concurrent_for_each(
+                 _topic_deltas,
+                 config::shard_local_cfg()
+                   .controller_backend_max_concurrent_reconciliations(),
                  [this](underlying_t::value_type& ntp_deltas) {
                      return reconcile_ntp(ntp_deltas.second);
                  })
-          .then([this] {
-              // cleanup empty NTP keys
-              for (auto it = _topic_deltas.cbegin();
-                   it != _topic_deltas.cend();) {
-                  if (it->second.empty()) {
-                      _topic_deltas.erase(it++);
-                  } else {
-                      ++it;
-                  }
-              }
-          });
+          .then([this] { erase_reconciled_ntps(); });
     });
 }
 
+void controller_backend::erase_reconciled_ntps() {
+    auto now = clock_type::now();
+    for (auto it = _topic_deltas.cbegin(); it != _topic_deltas.cend();) {
+        if (!it->second.empty()) {
+            ++it;
+            continue;
+        }
+        if (auto q_it = _queued_at.find(it->first); q_it != _queued_at.end()) {
+            _reconciliation_latency.record(
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                now - q_it->second)
+                .count());
+            _queued_at.erase(q_it);
+        }
+        _topic_deltas.erase(it++);
+    }
+}
+
 std::vector<model::broker> create_brokers_set(
   const std::vector<model::broker_shard>& replicas,
   cluster::members_table& members) {
@@ -648,9 +759,15 @@ ss::future<std::error_code> controller_backend::process_partition_update(
          * node, in this situation we have to
          * 1) shutdown partition instance
          * 2) create instance on target remote core
+         *
+         * the log directory does not depend on the shard, the target core
+         * reopens the segments left in place together with the raft and
+         * storage state moved from the KV store of this core.
          */
         if (contains_node(_self, requested.replicas)) {
-            co_return co_await shutdown_on_current_shard(std::move(ntp), rev);
+            auto target_shard = get_target_shard(_self, requested.replicas);
+            co_return co_await shutdown_on_current_shard(
+              std::move(ntp), rev, *target_shard);
         }
 
         /**
@@ -748,6 +865,8 @@ ss::future<std::error_code> controller_backend::process_partition_update(
               previous_shard);
             co_await raft::details::move_persistent_state(
               requested.group, *previous_shard, ss::this_shard_id(), _storage);
+            co_await storage::move_persistent_state(
+              ntp, *previous_shard, ss::this_shard_id(), _storage);
             auto ec = co_await create_partition(
               ntp,
               requested.group,
@@ -766,9 +885,17 @@ ss::future<std::error_code> controller_backend::process_partition_update(
     /**
      * We expect partition replica to exists on current broker/shard. Create
      * partiton. we relay on raft recovery to populate partion
-     * configuration.
+     * configuration. The archived part of the log may be hydrated from the
+     * cloud storage instead of being recovered from the leader.
      */
-    auto ec = co_await create_partition(ntp, requested.group, rev, {});
+    std::optional<model::revision_id> hydrate_since;
+    const auto& topics = _topics.local().topics_map();
+    if (auto it = topics.find(model::topic_namespace_view(ntp));
+        it != topics.end() && it->second.is_topic_replicable()) {
+        hydrate_since = it->second.get_revision();
+    }
+    auto ec = co_await create_partition(
+      ntp, requested.group, rev, {}, hydrate_since);
     // wait for recovery, we will mark partition as updated in next
     // controller backend reconciliation loop pass
     if (!ec) {
@@ -902,11 +1029,41 @@ ss::future<> controller_backend::add_to_shard_table(
     // update shard_table: broadcast
     vlog(
       clusterlog.trace, "adding {} to shard table at {}", revision, ntp, shard);
-    return _shard_table.invoke_on_all(
-      [ntp = std::move(ntp), raft_group, shard, revision](
-        shard_table& s) mutable {
-          s.update(ntp, raft_group, shard, revision);
-      });
+    if (_gate.is_closed()) {
+        return _shard_table.invoke_on_all(
+          [ntp = std::move(ntp), raft_group, shard, revision](
+            shard_table& s) mutable {
+              s.update(ntp, raft_group, shard, revision);
+          });
+    }
+    _shard_table_updates.push_back(
+      shard_table_update{std::move(ntp), raft_group, shard, revision});
+    if (!_shard_table_updated) {
+        // first update queued, the partitions created concurrently until the
+        // reactor gets back to us are broadcast together
+        _shard_table_updated = ss::make_lw_shared<ss::shared_promise<>>();
+        (void)ss::with_gate(_gate, [this] {
+            return ss::later().then(
+              [this] { return flush_shard_table_updates(); });
+        });
+    }
+    return _shard_table_updated->get_shared_future();
+}
+
+ss::future<> controller_backend::flush_shard_table_updates() {
+    auto updates = std::exchange(_shard_table_updates, {});
+    auto updated = std::exchange(_shard_table_updated, nullptr);
+    vlog(clusterlog.trace, "updating {} shard table entries", updates.size());
+    try {
+        co_await _shard_table.invoke_on_all([&updates](shard_table& s) {
+            for (auto& u : updates) {
+                s.update(u.ntp, u.group, u.shard, u.revision);
+            }
+        });
+        updated->set_value();
+    } catch (...) {
+        updated->set_exception(std::current_exception());
+    }
 }
 
 ss::future<> controller_backend::add_to_shard_table(
@@ -951,7 +1108,8 @@ ss::future<std::error_code> controller_backend::create_partition(
   model::ntp ntp,
   raft::group_id group_id,
   model::revision_id rev,
-  std::vector<model::broker> members) {
+  std::vector<model::broker> members,
+  std::optional<model::revision_id> hydrate_since) {
     auto cfg = _topics.local().get_topic_cfg(model::topic_namespace_view(ntp));
 
     if (!cfg) {
@@ -970,7 +1128,8 @@ ss::future<std::error_code> controller_backend::create_partition(
               .manage(
                 cfg->make_ntp_config(_data_directory, ntp.tp.partition, rev),
                 group_id,
-                std::move(members))
+                std::move(members),
+                hydrate_since)
               .discard_result();
     } else {
         // old partition still exists, wait for it to be removed
@@ -994,7 +1153,7 @@ controller_backend::cross_shard_move_request::cross_shard_move_request(
   , initial_configuration(std::move(cfg)) {}
 
 ss::future<std::error_code> controller_backend::shutdown_on_current_shard(
-  model::ntp ntp, model::revision_id rev) {
+  model::ntp ntp, model::revision_id rev, ss::shard_id target_shard) {
     vlog(clusterlog.trace, "cross core move, shutting down partition: {}", ntp);
     auto partition = _partition_manager.local().get(ntp);
     // partition doesn't exists it was deleted
@@ -1021,7 +1180,6 @@ ss::future<std::error_code> controller_backend::shutdown_on_current_shard(
           it->second,
           ntp,
           rev);
-        co_return errc::success;
     } catch (...) {
         /**
          * If partition shutdown failed we should crash, this error is
@@ -1035,6 +1193,12 @@ ss::future<std::error_code> controller_backend::shutdown_on_current_shard(
           rev,
           std::current_exception());
     }
+    // do not leave the partition unavailable until the next housekeeping tick
+    // of the target core
+    co_await container().invoke_on(
+      target_shard,
+      [](controller_backend& remote) { remote.trigger_housekeeping(); });
+    co_return errc::success;
 }
 
 ss::future<>
@@ -1051,20 +1215,64 @@ controller_backend::delete_partition(model::ntp ntp, model::revision_id rev) {
 
     auto group_id = part->group();
 
-    return _shard_table
-      .invoke_on_all([ntp, group_id, rev](shard_table& st) mutable {
-          st.erase(ntp, group_id, rev);
-      })
-      .then([this, ntp] {
-          return _partition_leaders_table.invoke_on_all(
-            [ntp](partition_leaders_table& leaders) {
-                leaders.remove_leader(ntp);
-            });
-      })
-      .then([this, ntp = std::move(ntp)] {
-          // remove partition
-          return _partition_manager.local().remove(ntp);
-      });
+    if (_gate.is_closed()) {
+        return _shard_table
+          .invoke_on_all([ntp, group_id, rev](shard_table& st) mutable {
+              st.erase(ntp, group_id, rev);
+          })
+          .then([this, ntp] {
+              return _partition_leaders_table.invoke_on_all(
+                [ntp](partition_leaders_table& leaders) {
+                    leaders.remove_leader(ntp);
+                });
+          })
+          .then([this, ntp = std::move(ntp)] {
+              // remove partition
+              return _partition_manager.local().remove(ntp);
+          });
+    }
+    _partition_deletions.push_back(
+      partition_deletion{std::move(ntp), group_id, rev});
+    if (!_partitions_deleted) {
+        // first deletion queued, the partitions deleted concurrently (e.g.
+        // all partitions of a deleted topic) until the reactor gets back to us
+        // are removed together
+        _partitions_deleted = ss::make_lw_shared<ss::shared_promise<>>();
+        (void)ss::with_gate(_gate, [this] {
+            return ss::later().then(
+              [this] { return flush_partition_deletions(); });
+        });
+    }
+    return _partitions_deleted->get_shared_future();
+}
+
+ss::future<> controller_backend::flush_partition_deletions() {
+    auto deletions = std::exchange(_partition_deletions, {});
+    auto deleted = std::exchange(_partitions_deleted, nullptr);
+    vlog(clusterlog.trace, "deleting {} partitions", deletions.size());
+    try {
+        co_await _shard_table.invoke_on_all([&deletions](shard_table& st) {
+            for (auto& d : deletions) {
+                st.erase(d.ntp, d.group, d.revision);
+            }
+        });
+        co_await _partition_leaders_table.invoke_on_all(
+          [&deletions](partition_leaders_table& leaders) {
+              for (auto& d : deletions) {
+                  leaders.remove_leader(d.ntp);
+              }
+          });
+        std::vector<model::ntp> ntps;
+        ntps.reserve(deletions.size());
+        for (auto& d : deletions) {
+            ntps.push_back(std::move(d.ntp));
+        }
+        // the log files are removed in the background by the log manager
+        co_await _partition_manager.local().remove(std::move(ntps));
+        deleted->set_value();
+    } catch (...) {
+        deleted->set_exception(std::current_exception());
+    }
 }
 
 std::vector<topic_table::delta>
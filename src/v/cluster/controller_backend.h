@@ -19,9 +19,13 @@
 #include "outcome.h"
 #include "raft/group_configuration.h"
 #include "storage/api.h"
+#include "utils/hdr_hist.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/sharded.hh>
 
 #include <absl/container/node_hash_map.h>
@@ -31,6 +35,11 @@
 namespace cluster {
 
 /// on every core, sharded
+///
+/// Deltas of different partitions are reconciled concurrently, up to
+/// controller_backend_max_concurrent_reconciliations at a time, the deltas of
+/// a partition are applied in order. Shard table updates of the partitions
+/// created concurrently are broadcast to all the shards together.
 
 class controller_backend
   : public ss::peering_sharded_service<controller_backend> {
@@ -71,15 +80,31 @@ private:
 
     using deltas_t = std::vector<topic_table::delta>;
     using underlying_t = absl::flat_hash_map<model::ntp, deltas_t>;
+    using clock_type = ss::lowres_clock;
+
+    struct shard_table_update {
+        model::ntp ntp;
+        raft::group_id group;
+        ss::shard_id shard;
+        model::revision_id revision;
+    };
+
+    struct partition_deletion {
+        model::ntp ntp;
+        raft::group_id group;
+        model::revision_id revision;
+    };
 
     // Topics
     ss::future<> bootstrap_controller_backend();
+    void start_reconciliation();
     void start_topics_reconciliation_loop();
 
     ss::future<> fetch_deltas();
 
     ss::future<> reconcile_topics();
     ss::future<> reconcile_ntp(deltas_t&);
+    void erase_reconciled_ntps();
 
     ss::future<std::error_code>
     execute_partitition_op(const topic_table::delta&);
@@ -99,16 +124,19 @@ private:
       model::ntp,
       raft::group_id,
       model::revision_id,
-      std::vector<model::broker>);
+      std::vector<model::broker>,
+      std::optional<model::revision_id> hydrate_since = std::nullopt);
     ss::future<std::error_code>
       create_non_replicable_partition(model::ntp, model::revision_id);
     ss::future<>
       add_to_shard_table(model::ntp, ss::shard_id, model::revision_id);
     ss::future<> add_to_shard_table(
       model::ntp, raft::group_id, ss::shard_id, model::revision_id);
+    ss::future<> flush_shard_table_updates();
     ss::future<>
       remove_from_shard_table(model::ntp, raft::group_id, model::revision_id);
     ss::future<> delete_partition(model::ntp, model::revision_id);
+    ss::future<> flush_partition_deletions();
     ss::future<std::error_code> update_partition_replica_set(
       const model::ntp&,
       const std::vector<model::broker_shard>&,
@@ -120,12 +148,14 @@ private:
     ss::future<> bootstrap_ntp(const model::ntp&, deltas_t&);
 
     ss::future<std::error_code>
-      shutdown_on_current_shard(model::ntp, model::revision_id);
+      shutdown_on_current_shard(model::ntp, model::revision_id, ss::shard_id);
 
     ss::future<std::optional<cross_shard_move_request>>
       ask_remote_shard_for_initail_rev(model::ntp, ss::shard_id);
 
     void housekeeping();
+    void trigger_housekeeping();
+    void setup_metrics();
 
     ss::sharded<topic_table>& _topics;
     ss::sharded<shard_table>& _shard_table;
@@ -157,6 +187,21 @@ private:
      * first created on current node before cross core move series
      */
     absl::node_hash_map<model::ntp, model::revision_id> _bootstrap_revisions;
+
+    /// shard table updates waiting to be broadcast, set when the first one is
+    /// queued
+    std::vector<shard_table_update> _shard_table_updates;
+    ss::lw_shared_ptr<ss::shared_promise<>> _shard_table_updated;
+
+    /// partitions waiting to be deleted together, set when the first one is
+    /// queued
+    std::vector<partition_deletion> _partition_deletions;
+    ss::lw_shared_ptr<ss::shared_promise<>> _partitions_deleted;
+
+    /// when the oldest pending delta of a partition was queued
+    absl::flat_hash_map<model::ntp, clock_type::time_point> _queued_at;
+    hdr_hist _reconciliation_latency;
+    ss::metrics::metric_groups _metrics;
 };
 
 std::vector<topic_table::delta> calculate_bootstrap_deltas(
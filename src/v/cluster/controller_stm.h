@@ -19,11 +19,12 @@
 
 namespace cluster {
 
-// single instance
+// single instance, states are restored from snapshots in the order they are
+// listed, cluster members have to be known before partitions are allocated
 using controller_stm = raft::mux_state_machine<
+  members_manager,
   topic_updates_dispatcher,
   security_manager,
-  members_manager,
   data_policy_manager>;
 
 static constexpr ss::shard_id controller_stm_shard = 0;
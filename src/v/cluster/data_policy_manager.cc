@@ -13,12 +13,17 @@
 
 #include "cluster/cluster_utils.h"
 #include "cluster/errc.h"
+#include "cluster/logger.h"
+#include "reflection/adl.h"
+#include "vlog.h"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
 
 #include <optional>
 #include <system_error>
+#include <utility>
+#include <vector>
 
 namespace cluster {
 
@@ -73,4 +78,43 @@ data_policy_manager::apply_update(model::record_batch batch) {
     });
 }
 
+ss::future<iobuf> data_policy_manager::take_snapshot(model::offset) {
+    auto& table = _dps.local();
+    iobuf out;
+    reflection::serialize(out, static_cast<uint32_t>(table.size()));
+    for (auto& [tn, dp] : table) {
+        reflection::serialize(
+          out, model::topic_namespace(tn), v8_engine::data_policy(dp));
+    }
+    co_return out;
+}
+
+ss::future<>
+data_policy_manager::apply_snapshot(model::offset offset, iobuf data) {
+    using policies_t
+      = std::vector<std::pair<model::topic_namespace, v8_engine::data_policy>>;
+    iobuf_parser parser(std::move(data));
+    auto count = reflection::adl<uint32_t>{}.from(parser);
+    policies_t policies;
+    policies.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto tn = reflection::adl<model::topic_namespace>{}.from(parser);
+        policies.emplace_back(
+          std::move(tn),
+          reflection::adl<v8_engine::data_policy>{}.from(parser));
+    }
+    vlog(
+      clusterlog.info,
+      "restoring {} data policies from snapshot at offset {}",
+      policies.size(),
+      offset);
+    co_await _dps.invoke_on_all(
+      [&policies](v8_engine::data_policy_table& table) {
+          table.clear();
+          for (auto& [tn, dp] : policies) {
+              table.insert(tn, dp);
+          }
+      });
+}
+
 } // namespace cluster
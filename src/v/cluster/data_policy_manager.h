@@ -30,6 +30,9 @@ public:
 
     ss::future<std::error_code> apply_update(model::record_batch);
 
+    ss::future<iobuf> take_snapshot(model::offset);
+    ss::future<> apply_snapshot(model::offset, iobuf);
+
     bool is_batch_applicable(const model::record_batch& batch) const {
         return batch.header().type
                == model::record_batch_type::data_policy_management_cmd;
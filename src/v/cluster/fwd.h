@@ -38,5 +38,7 @@ class data_policy_frontend;
 class tx_gateway;
 class rm_group_proxy;
 class non_replicable_topics_frontend;
+class health_manager;
+class partition_balancer;
 
 } // namespace cluster
@@ -10,19 +10,31 @@
  */
 #include "cluster/health_manager.h"
 
+#include "cluster/controller_service.h"
 #include "cluster/logger.h"
+#include "cluster/members_table.h"
 #include "cluster/partition_leaders_table.h"
+#include "cluster/partition_manager.h"
 #include "cluster/scheduling/partition_allocator.h"
 #include "cluster/topic_table.h"
 #include "cluster/topics_frontend.h"
+#include "config/configuration.h"
 #include "model/namespace.h"
+#include "rpc/connection_cache.h"
 #include "seastarx.h"
 #include "vlog.h"
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/reactor.hh>
 #include <seastar/core/sleep.hh>
 #include <seastar/core/timer.hh>
 
+#include <absl/container/flat_hash_map.h>
+
+#include <algorithm>
+#include <iterator>
+
 namespace cluster {
 
 health_manager::health_manager(
@@ -33,6 +45,9 @@ health_manager::health_manager(
   ss::sharded<topics_frontend>& topics_frontend,
   ss::sharded<partition_allocator>& allocator,
   ss::sharded<partition_leaders_table>& leaders,
+  ss::sharded<members_table>& members,
+  ss::sharded<partition_manager>& partition_manager,
+  ss::sharded<rpc::connection_cache>& connections,
   ss::sharded<ss::abort_source>& as)
   : _self(self)
   , _target_replication_factor(target_replication_factor)
@@ -41,6 +56,9 @@ health_manager::health_manager(
   , _topics_frontend(topics_frontend)
   , _allocator(allocator)
   , _leaders(leaders)
+  , _members(members)
+  , _partition_manager(partition_manager)
+  , _connections(connections)
   , _as(as)
   , _timer([this] { tick(); }) {}
 
@@ -167,20 +185,302 @@ health_manager::ensure_topic_replication(model::topic_namespace_view topic) {
     co_return true;
 }
 
+namespace {
+struct partition_sample {
+    model::ntp ntp;
+    uint64_t bytes_written;
+    uint64_t disk_bytes;
+    bool is_leader{false};
+    // followers of a partition led by this node that are not in sync
+    uint16_t under_replicated_replicas{0};
+    uint64_t max_follower_lag{0};
+};
+
+partition_sample sample_partition(const model::ntp& ntp, partition& p) {
+    partition_sample s{
+      .ntp = ntp,
+      .bytes_written = p.bytes_written(),
+      .disk_bytes = p.size_bytes(),
+      .is_leader = p.is_leader()};
+    if (!s.is_leader) {
+        return s;
+    }
+    auto dirty_offset = p.dirty_offset();
+    for (const auto& f : p.raft()->get_follower_metrics()) {
+        if (f.under_replicated) {
+            ++s.under_replicated_replicas;
+        }
+        if (f.match_index < dirty_offset) {
+            s.max_follower_lag = std::max<uint64_t>(
+              s.max_follower_lag, dirty_offset - f.match_index);
+        }
+    }
+    return s;
+}
+
+/// moves the partitions with the highest throughput and the largest ones to
+/// the report, the partition balancer picks the partitions it moves from them
+void add_heaviest(
+  std::vector<partition_load>& report,
+  std::vector<partition_load> partitions,
+  size_t n) {
+    auto take = [&report, &partitions, n](auto cmp) {
+        auto last = partitions.begin()
+                    + std::min<size_t>(n, partitions.size());
+        std::partial_sort(partitions.begin(), last, partitions.end(), cmp);
+        std::move(partitions.begin(), last, std::back_inserter(report));
+        partitions.erase(partitions.begin(), last);
+    };
+    take([](const partition_load& a, const partition_load& b) {
+        return a.bytes_per_sec > b.bytes_per_sec;
+    });
+    take([](const partition_load& a, const partition_load& b) {
+        return a.disk_bytes > b.disk_bytes;
+    });
+}
+} // namespace
+
+ss::future<> health_manager::sample_local_load() {
+    auto samples = co_await _partition_manager.map([](partition_manager& pm) {
+        std::vector<partition_sample> ret;
+        ret.reserve(pm.partitions().size());
+        for (const auto& [ntp, p] : pm.partitions()) {
+            ret.push_back(sample_partition(ntp, *p));
+        }
+        return ret;
+    });
+    auto fs = co_await ss::engine().statvfs(
+      config::shard_local_cfg().data_directory().as_sstring());
+    auto now = clock_type::now();
+    auto elapsed
+      = std::chrono::duration_cast<std::chrono::seconds>(now - _last_sample)
+          .count();
+    // the first sample has nothing to compare with
+    const bool measured = _last_sample != clock_type::time_point{}
+                          && elapsed > 0;
+
+    node_load_reply load;
+    load.cores.resize(samples.size());
+    load.disk = disk_space{
+      .total_bytes = fs.f_blocks * fs.f_frsize,
+      .free_bytes = fs.f_bavail * fs.f_frsize};
+    absl::flat_hash_map<model::ntp, uint64_t> bytes_written;
+    for (size_t shard = 0; shard < samples.size(); ++shard) {
+        std::vector<partition_load> partitions;
+        partitions.reserve(samples[shard].size());
+        for (auto& s : samples[shard]) {
+            // partitions created or moved to this node since the last sample
+            // wrote all of their bytes in the meantime
+            auto it = _bytes_written.find(s.ntp);
+            auto prev = it == _bytes_written.end() ? 0 : it->second;
+            auto written = s.bytes_written - std::min(s.bytes_written, prev);
+            auto& p = partitions.emplace_back(partition_load{
+              .ntp = s.ntp,
+              .bytes_per_sec = measured ? written / elapsed : 0,
+              .disk_bytes = s.disk_bytes});
+            load.cores[shard].bytes_per_sec += p.bytes_per_sec;
+            load.cores[shard].disk_bytes += p.disk_bytes;
+            if (s.is_leader) {
+                ++load.leaders;
+            }
+            if (s.under_replicated_replicas > 0) {
+                ++load.under_replicated_count;
+                if (
+                  load.under_replicated.size()
+                  < reported_under_replicated_partitions) {
+                    load.under_replicated.push_back(partition_health{
+                      .ntp = s.ntp,
+                      .under_replicated_replicas = s.under_replicated_replicas,
+                      .max_follower_lag = s.max_follower_lag});
+                }
+            }
+            bytes_written.emplace(std::move(s.ntp), s.bytes_written);
+        }
+        add_heaviest(
+          load.partitions, std::move(partitions), reported_partitions_per_core);
+    }
+    _bytes_written = std::move(bytes_written);
+    _last_sample = now;
+    if (measured) {
+        _local_load = std::move(load);
+    }
+}
+
+ss::future<node_load_reply> health_manager::get_node_load(model::node_id id) {
+    if (id == _self) {
+        co_return _local_load;
+    }
+    auto res = co_await _connections.local()
+                 .with_node_client<controller_client_protocol>(
+                   _self,
+                   ss::this_shard_id(),
+                   id,
+                   node_load_timeout,
+                   [](controller_client_protocol cp) mutable {
+                       return cp.get_node_load(
+                         node_load_request{},
+                         rpc::client_opts(
+                           model::timeout_clock::now() + node_load_timeout));
+                   });
+    if (res.has_error()) {
+        throw std::system_error(res.error());
+    }
+    co_return std::move(res.value().data);
+}
+
+ss::future<> health_manager::update_cluster_load() {
+    auto ids = _members.local().all_broker_ids();
+    absl::node_hash_map<model::node_id, node_load_reply> load;
+    absl::flat_hash_set<model::node_id> down;
+    co_await ss::parallel_for_each(
+      ids, [this, &load, &down](model::node_id id) {
+          return get_node_load(id).then_wrapped(
+            [this, id, &load, &down](ss::future<node_load_reply> f) {
+                if (f.failed()) {
+                    down.insert(id);
+                    // the last load reported by the node is kept
+                    vlog(
+                      clusterlog.debug,
+                      "Health manager: unable to get load of node {}: {}",
+                      id,
+                      f.get_exception());
+                    if (auto it = _cluster_load.find(id);
+                        it != _cluster_load.end()) {
+                        load.emplace(id, std::move(it->second));
+                    }
+                    return;
+                }
+                auto r = f.get0();
+                _allocator.local().update_node_load(id, r.cores);
+                load.emplace(id, std::move(r));
+            });
+      });
+    _cluster_load = std::move(load);
+    _nodes_down = std::move(down);
+    _cluster_load_collected_at = clock_type::now();
+}
+
+bool health_manager::is_cluster_healthy() const {
+    return _nodes_down.empty()
+           && std::all_of(
+             _cluster_load.cbegin(), _cluster_load.cend(), [](const auto& e) {
+                 return e.second.under_replicated_count == 0;
+             });
+}
+
+ss::future<cluster_health_overview_reply>
+health_manager::get_cluster_health_overview(
+  model::timeout_clock::time_point timeout) {
+    auto leader = _leaders.local().get_leader(model::controller_ntp);
+    if (!leader) {
+        co_return cluster_health_overview_reply{
+          .error = errc::no_leader_controller};
+    }
+    if (leader == _self) {
+        co_return co_await local_health_overview();
+    }
+    // the overview is served by the controller leader from its cached reports
+    auto res = co_await _connections.local()
+                 .with_node_client<controller_client_protocol>(
+                   _self,
+                   ss::this_shard_id(),
+                   *leader,
+                   timeout,
+                   [timeout](controller_client_protocol cp) mutable {
+                       return cp.get_cluster_health_overview(
+                         cluster_health_overview_request{},
+                         rpc::client_opts(timeout));
+                   });
+    if (res.has_error()) {
+        vlog(
+          clusterlog.info,
+          "Health manager: unable to get health overview from {}: {}",
+          *leader,
+          res.error().message());
+        co_return cluster_health_overview_reply{.error = errc::timeout};
+    }
+    co_return std::move(res.value().data);
+}
+
+ss::future<cluster_health_overview_reply>
+health_manager::local_health_overview() {
+    if (_leaders.local().get_leader(model::controller_ntp) != _self) {
+        co_return cluster_health_overview_reply{
+          .error = errc::not_leader_controller};
+    }
+    // a node that just became the controller leader has nothing cached yet
+    if (_cluster_load_collected_at == clock_type::time_point{}) {
+        co_await ss::with_gate(_gate, [this] { return update_cluster_load(); });
+    }
+
+    cluster_health_overview_reply ret{.controller_id = _self};
+    ret.age_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                   clock_type::now() - _cluster_load_collected_at)
+                   .count();
+    for (auto id : _members.local().all_broker_ids()) {
+        auto& n = ret.nodes.emplace_back(node_health_overview{
+          .id = id, .is_alive = !_nodes_down.contains(id)});
+        if (auto it = _cluster_load.find(id); it != _cluster_load.end()) {
+            n.leaders = it->second.leaders;
+            n.disk = it->second.disk;
+            // nodes that are not reachable keep their last report
+            if (n.is_alive) {
+                ret.under_replicated_count
+                  += it->second.under_replicated_count;
+                for (const auto& p : it->second.under_replicated) {
+                    if (
+                      ret.under_replicated_partitions.size()
+                      < overview_partitions) {
+                        ret.under_replicated_partitions.push_back(p.ntp);
+                    }
+                }
+            }
+        } else {
+            n.is_alive = false;
+        }
+    }
+
+    for (const auto& [tp_ns, md] : _topics.local().topics_map()) {
+        if (!md.is_topic_replicable()) {
+            continue;
+        }
+        for (const auto& p_as : md.get_configuration().assignments) {
+            if (_leaders.local().get_leader(tp_ns, p_as.id)) {
+                continue;
+            }
+            ++ret.leaderless_count;
+            if (ret.leaderless_partitions.size() < overview_partitions) {
+                ret.leaderless_partitions.emplace_back(
+                  tp_ns.ns, tp_ns.tp, p_as.id);
+            }
+        }
+    }
+    co_return ret;
+}
+
 void health_manager::tick() {
     (void)ss::try_with_gate(
       _gate,
       [this]() -> ss::future<> {
           /*
-           * only active on the controller leader
+           * every node measures its load, the controller leader collects it
+           * to place new partitions on the least loaded cores
+           */
+          co_await sample_local_load();
+
+          /*
+           * replication is only fixed by the controller leader
            */
           auto cluster_leader = _leaders.local().get_leader(
             model::controller_ntp);
           if (cluster_leader != _self) {
               vlog(clusterlog.trace, "Health: skipping tick as non-leader");
+              _timer.arm(_tick_interval);
               co_return;
           }
 
+          co_await update_cluster_load();
+
           /*
            * we try to be conservative here. if something goes wrong we'll back
            * off and wait before trying to fix replication for any other
@@ -11,6 +11,7 @@
 #pragma once
 #include "cluster/types.h"
 #include "model/metadata.h"
+#include "rpc/fwd.h"
 #include "seastarx.h"
 
 #include <seastar/core/abort_source.hh>
@@ -18,6 +19,10 @@
 #include <seastar/core/sharded.hh>
 #include <seastar/core/timer.hh>
 
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <absl/container/node_hash_map.h>
+
 #include <chrono>
 
 using namespace std::chrono_literals;
@@ -25,13 +30,22 @@ using namespace std::chrono_literals;
 namespace cluster {
 
 class health_manager {
-    using clock_type = ss::lowres_clock;
     static constexpr std::chrono::seconds set_replicas_timeout = 15s;
     // after changing replica set introduce a short cooling off delay
     static constexpr std::chrono::seconds stabilize_delay = 10s;
+    static constexpr std::chrono::seconds node_load_timeout = 5s;
+    // partitions with the highest throughput and largest partitions reported
+    // for every core
+    static constexpr size_t reported_partitions_per_core = 8;
+    // under replicated partitions reported by every node and listed in the
+    // cluster health overview
+    static constexpr size_t reported_under_replicated_partitions = 128;
+    static constexpr size_t overview_partitions = 128;
 
 public:
+    using clock_type = ss::lowres_clock;
     static constexpr ss::shard_id shard = 0;
+    using cluster_load_t = absl::node_hash_map<model::node_id, node_load_reply>;
 
     health_manager(
       model::node_id,
@@ -41,14 +55,44 @@ public:
       ss::sharded<topics_frontend>&,
       ss::sharded<partition_allocator>&,
       ss::sharded<partition_leaders_table>&,
+      ss::sharded<members_table>&,
+      ss::sharded<partition_manager>&,
+      ss::sharded<rpc::connection_cache>&,
       ss::sharded<ss::abort_source>&);
 
     ss::future<> start();
     ss::future<> stop();
 
+    /// Load of this node measured during the last tick, empty until two ticks
+    /// elapsed
+    const node_load_reply& local_load() const { return _local_load; }
+
+    /// Load of the cluster nodes, only collected by the controller leader
+    const cluster_load_t& cluster_load() const { return _cluster_load; }
+    clock_type::time_point cluster_load_collected_at() const {
+        return _cluster_load_collected_at;
+    }
+
+    /// False when a node did not report its health during the last
+    /// collection or reported under replicated partitions
+    bool is_cluster_healthy() const;
+
+    /// Summary of the cluster health built by the controller leader from the
+    /// reports it collected, other nodes ask the controller leader for it
+    ss::future<cluster_health_overview_reply>
+      get_cluster_health_overview(model::timeout_clock::time_point);
+
+    /// Summary of the cluster health built from the reports collected by this
+    /// node, fails with not_leader_controller unless this node is the
+    /// controller leader
+    ss::future<cluster_health_overview_reply> local_health_overview();
+
 private:
     ss::future<bool> ensure_topic_replication(model::topic_namespace_view);
     ss::future<bool> ensure_partition_replication(model::ntp);
+    ss::future<> sample_local_load();
+    ss::future<> update_cluster_load();
+    ss::future<node_load_reply> get_node_load(model::node_id);
     void tick();
 
     model::node_id _self;
@@ -58,9 +102,20 @@ private:
     ss::sharded<topics_frontend>& _topics_frontend;
     ss::sharded<partition_allocator>& _allocator;
     ss::sharded<partition_leaders_table>& _leaders;
+    ss::sharded<members_table>& _members;
+    ss::sharded<partition_manager>& _partition_manager;
+    ss::sharded<rpc::connection_cache>& _connections;
     ss::sharded<ss::abort_source>& _as;
     ss::gate _gate;
     ss::timer<clock_type> _timer;
+    // bytes written to the logs of local partitions at the last sample
+    absl::flat_hash_map<model::ntp, uint64_t> _bytes_written;
+    clock_type::time_point _last_sample;
+    node_load_reply _local_load;
+    cluster_load_t _cluster_load;
+    clock_type::time_point _cluster_load_collected_at;
+    // nodes that did not report during the last collection
+    absl::flat_hash_set<model::node_id> _nodes_down;
 };
 
 } // namespace cluster
@@ -27,6 +27,9 @@ public:
     virtual ss::future<allocate_id_reply>
     allocate_id(allocate_id_request&&, rpc::streaming_context&) final;
 
+    virtual ss::future<allocate_id_range_reply> allocate_id_range(
+      allocate_id_range_request&&, rpc::streaming_context&) final;
+
 private:
     ss::sharded<cluster::id_allocator_frontend>& _id_allocator_frontend;
 };
@@ -22,6 +22,7 @@
 #include "config/configuration.h"
 #include "model/namespace.h"
 #include "model/record_batch_reader.h"
+#include "rpc/errc.h"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/do_with.hh>
@@ -55,6 +56,44 @@ id_allocator_frontend::id_allocator_frontend(
 
 ss::future<allocate_id_reply>
 id_allocator_frontend::allocate_id(model::timeout_clock::duration timeout) {
+    if (_lease_next < _lease_end) {
+        co_return allocate_id_reply{_lease_next++, errc::success};
+    }
+
+    const int64_t lease_size
+      = config::shard_local_cfg().id_allocator_lease_size();
+    if (lease_size <= 1) {
+        auto r = co_await allocate_id_range(1, timeout);
+        co_return allocate_id_reply{r.id, r.ec};
+    }
+
+    // concurrent requests wait for a single lease instead of each of them
+    // going to the id allocator
+    co_return co_await _lease_lock
+      .with(
+        timeout,
+        [this, lease_size, timeout]() -> ss::future<allocate_id_reply> {
+            if (_lease_next < _lease_end) {
+                return ss::make_ready_future<allocate_id_reply>(
+                  allocate_id_reply{_lease_next++, errc::success});
+            }
+            return allocate_id_range(lease_size, timeout)
+              .then([this](allocate_id_range_reply r) {
+                  if (r.ec != errc::success) {
+                      return allocate_id_reply{r.id, r.ec};
+                  }
+                  _lease_next = r.id + 1;
+                  _lease_end = r.id + r.count;
+                  return allocate_id_reply{r.id, errc::success};
+              });
+        })
+      .handle_exception_type([](const ss::semaphore_timed_out&) {
+          return allocate_id_reply{0, errc::timeout};
+      });
+}
+
+ss::future<allocate_id_range_reply> id_allocator_frontend::allocate_id_range(
+  int64_t count, model::timeout_clock::duration timeout) {
     auto nt = model::topic_namespace(
       model::kafka_internal_namespace, model::id_allocator_topic);
 
@@ -66,12 +105,12 @@ id_allocator_frontend::allocate_id(model::timeout_clock::duration timeout) {
 
     if (!has_topic) {
         vlog(clusterlog.warn, "can't find {} in the metadata cache", nt);
-        co_return allocate_id_reply{0, errc::topic_not_exists};
+        co_return allocate_id_range_reply{0, 0, errc::topic_not_exists};
     }
 
     auto _self = _controller->self();
 
-    auto r = allocate_id_reply{0, errc::no_leader_controller};
+    auto r = allocate_id_range_reply{0, 0, errc::no_leader_controller};
 
     auto retries = _metadata_dissemination_retries;
     auto delay_ms = _metadata_dissemination_retry_delay_ms;
@@ -93,14 +132,16 @@ id_allocator_frontend::allocate_id(model::timeout_clock::duration timeout) {
         auto leader = leader_opt.value();
 
         if (leader == _self) {
-            r = co_await do_allocate_id(timeout);
+            r = co_await do_allocate_id_range(count, timeout);
         } else {
             vlog(
               clusterlog.trace,
-              "dispatching id allocation from {} to {} ",
+              "dispatching allocation of {} ids from {} to {} ",
+              count,
               _self,
               leader);
-            r = co_await dispatch_allocate_id_to_leader(leader, timeout);
+            r = co_await dispatch_allocate_id_range_to_leader(
+              leader, count, timeout);
         }
 
         if (likely(r.ec == errc::success)) {
@@ -126,28 +167,50 @@ id_allocator_frontend::allocate_id(model::timeout_clock::duration timeout) {
     co_return r;
 }
 
-ss::future<allocate_id_reply>
-id_allocator_frontend::dispatch_allocate_id_to_leader(
-  model::node_id leader, model::timeout_clock::duration timeout) {
+ss::future<allocate_id_range_reply>
+id_allocator_frontend::dispatch_allocate_id_range_to_leader(
+  model::node_id leader,
+  int64_t count,
+  model::timeout_clock::duration timeout) {
+    using ret_t = result<allocate_id_range_reply>;
     return _connection_cache.local()
       .with_node_client<cluster::id_allocator_client_protocol>(
         _controller->self(),
         ss::this_shard_id(),
         leader,
         timeout,
-        [timeout](id_allocator_client_protocol cp) {
-            return cp.allocate_id(
-              allocate_id_request{timeout},
-              rpc::client_opts(model::timeout_clock::now() + timeout));
+        [count, timeout](id_allocator_client_protocol cp) mutable {
+            auto opts = rpc::client_opts(model::timeout_clock::now() + timeout);
+            return cp
+              .allocate_id_range(
+                allocate_id_range_request{timeout, count}, std::move(opts))
+              .then(&rpc::get_ctx_data<allocate_id_range_reply>)
+              .then([cp, timeout](ret_t r) mutable {
+                  if (r || r.error() != rpc::errc::method_not_found) {
+                      return ss::make_ready_future<ret_t>(std::move(r));
+                  }
+                  // node predating id ranges, allocate a single id
+                  return cp
+                    .allocate_id(
+                      allocate_id_request{timeout},
+                      rpc::client_opts(model::timeout_clock::now() + timeout))
+                    .then(&rpc::get_ctx_data<allocate_id_reply>)
+                    .then([](result<allocate_id_reply> r) -> ret_t {
+                        if (!r) {
+                            return r.error();
+                        }
+                        return allocate_id_range_reply{
+                          r.value().id, 1, r.value().ec};
+                    });
+              });
         })
-      .then(&rpc::get_ctx_data<allocate_id_reply>)
-      .then([](result<allocate_id_reply> r) {
+      .then([](ret_t r) {
           if (r.has_error()) {
               vlog(
                 clusterlog.warn,
-                "got error {} on remote allocate_id",
+                "got error {} on remote allocate_id_range",
                 r.error());
-              return allocate_id_reply{0, errc::timeout};
+              return allocate_id_range_reply{0, 0, errc::timeout};
           }
           return r.value();
       });
@@ -155,6 +218,15 @@ id_allocator_frontend::dispatch_allocate_id_to_leader(
 
 ss::future<allocate_id_reply>
 id_allocator_frontend::do_allocate_id(model::timeout_clock::duration timeout) {
+    return do_allocate_id_range(1, timeout)
+      .then([](allocate_id_range_reply r) {
+          return allocate_id_reply{r.id, r.ec};
+      });
+}
+
+ss::future<allocate_id_range_reply> id_allocator_frontend::do_allocate_id_range(
+  int64_t count, model::timeout_clock::duration timeout) {
+    count = std::max<int64_t>(count, 1);
     auto shard = _shard_table.local().shard_for(model::id_allocator_ntp);
 
     if (unlikely(!shard)) {
@@ -171,24 +243,25 @@ id_allocator_frontend::do_allocate_id(model::timeout_clock::duration timeout) {
               clusterlog.warn,
               "can't find {} in the shard table",
               model::id_allocator_ntp);
-            co_return allocate_id_reply{0, errc::no_leader_controller};
+            co_return allocate_id_range_reply{
+              0, 0, errc::no_leader_controller};
         }
     }
-    co_return co_await do_allocate_id(*shard, timeout);
+    co_return co_await do_allocate_id_range(*shard, count, timeout);
 }
 
-ss::future<allocate_id_reply> id_allocator_frontend::do_allocate_id(
-  ss::shard_id shard, model::timeout_clock::duration timeout) {
+ss::future<allocate_id_range_reply> id_allocator_frontend::do_allocate_id_range(
+  ss::shard_id shard, int64_t count, model::timeout_clock::duration timeout) {
     return _partition_manager.invoke_on(
-      shard, _ssg, [timeout](cluster::partition_manager& mgr) mutable {
+      shard, _ssg, [count, timeout](cluster::partition_manager& mgr) mutable {
           auto partition = mgr.get(model::id_allocator_ntp);
           if (!partition) {
               vlog(
                 clusterlog.warn,
                 "can't get partition by {} ntp",
                 model::id_allocator_ntp);
-              return ss::make_ready_future<allocate_id_reply>(
-                allocate_id_reply{0, errc::topic_not_exists});
+              return ss::make_ready_future<allocate_id_range_reply>(
+                allocate_id_range_reply{0, 0, errc::topic_not_exists});
           }
           auto& stm = partition->id_allocator_stm();
           if (!stm) {
@@ -196,20 +269,21 @@ ss::future<allocate_id_reply> id_allocator_frontend::do_allocate_id(
                 clusterlog.warn,
                 "can't get id allocator stm of the {}' partition",
                 model::id_allocator_ntp);
-              return ss::make_ready_future<allocate_id_reply>(
-                allocate_id_reply{0, errc::topic_not_exists});
+              return ss::make_ready_future<allocate_id_range_reply>(
+                allocate_id_range_reply{0, 0, errc::topic_not_exists});
           }
-          return stm->allocate_id(timeout).then(
-            [](id_allocator_stm::stm_allocation_result r) {
+          return stm->allocate_id_range(count, timeout)
+            .then([count](id_allocator_stm::stm_allocation_result r) {
                 if (r.raft_status != raft::errc::success) {
                     vlog(
                       clusterlog.warn,
                       "allocate id stm call failed with {}",
                       r.raft_status);
-                    return allocate_id_reply{r.id, errc::replication_error};
+                    return allocate_id_range_reply{
+                      r.id, 0, errc::replication_error};
                 }
 
-                return allocate_id_reply{r.id, errc::success};
+                return allocate_id_range_reply{r.id, count, errc::success};
             });
       });
 }
@@ -12,6 +12,7 @@
 #pragma once
 #include "cluster/types.h"
 #include "rpc/connection_cache.h"
+#include "utils/mutex.h"
 
 #include <seastar/core/sharded.hh>
 
@@ -34,6 +35,10 @@ class id_allocator;
 //
 // when the service recieves a call it triggers id_allocator_frontend
 // which in its own turn pass the request to the id_allocator_stm
+//
+// each shard leases a range of `id_allocator_lease_size` ids at once and
+// serves allocate_id from it until the range is exhausted, so only one in
+// that many calls reaches the id_allocator_stm.
 class id_allocator_frontend {
 public:
     id_allocator_frontend(
@@ -59,14 +64,25 @@ private:
     int16_t _metadata_dissemination_retries{1};
     std::chrono::milliseconds _metadata_dissemination_retry_delay_ms;
 
-    ss::future<allocate_id_reply> dispatch_allocate_id_to_leader(
-      model::node_id, model::timeout_clock::duration);
+    // ids of the current lease left to serve, [_lease_next, _lease_end)
+    int64_t _lease_next{0};
+    int64_t _lease_end{0};
+    mutex _lease_lock;
+
+    ss::future<allocate_id_range_reply>
+      allocate_id_range(int64_t, model::timeout_clock::duration);
+
+    ss::future<allocate_id_range_reply> dispatch_allocate_id_range_to_leader(
+      model::node_id, int64_t, model::timeout_clock::duration);
 
     ss::future<allocate_id_reply>
       do_allocate_id(model::timeout_clock::duration);
 
-    ss::future<allocate_id_reply>
-      do_allocate_id(ss::shard_id, model::timeout_clock::duration);
+    ss::future<allocate_id_range_reply>
+      do_allocate_id_range(int64_t, model::timeout_clock::duration);
+
+    ss::future<allocate_id_range_reply> do_allocate_id_range(
+      ss::shard_id, int64_t, model::timeout_clock::duration);
 
     ss::future<bool> try_create_id_allocator_topic();
 
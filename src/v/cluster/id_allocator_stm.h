@@ -46,6 +46,10 @@ public:
     ss::future<stm_allocation_result>
     allocate_id(model::timeout_clock::duration timeout);
 
+    // allocates \p count consecutive ids, the result holds the first of them
+    ss::future<stm_allocation_result>
+    allocate_id_range(int64_t count, model::timeout_clock::duration timeout);
+
 private:
     // legacy structs left for backward compatibility with the "old"
     // on-disk log format
@@ -92,7 +96,7 @@ private:
     };
 
     ss::future<stm_allocation_result>
-      do_allocate_id(model::timeout_clock::duration);
+      do_allocate_id_range(int64_t, model::timeout_clock::duration);
     ss::future<bool> set_state(int64_t, model::timeout_clock::duration);
 
     ss::future<> apply(model::record_batch) override;
@@ -111,7 +115,9 @@ private:
     // left in the range. Each time `allocate_id` is called the state machine
     // increments `_curr_id` (it is initialy equal to `_state`) and decrements
     // `_curr_batch`. When the latter reaches zero the state machine allocates
-    // a new batch.
+    // a new batch. A range of IDs is served the same way, when the batch has
+    // fewer IDs left than requested they are skipped and a new batch of at
+    // least the range size is allocated.
     //
     // Unlike the data partitions id_allocator_stm doesn't rely on the eviction
     // stm and manages log truncations on its own. STM counts the number of
@@ -33,6 +33,7 @@
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/smp.hh>
 
+#include <algorithm>
 #include <chrono>
 #include <system_error>
 namespace cluster {
@@ -226,6 +227,50 @@ members_manager::apply_update(model::record_batch b) {
             .then([] { return make_error_code(errc::success); });
       });
 }
+ss::future<iobuf> members_manager::take_snapshot(model::offset) {
+    std::vector<model::broker> brokers;
+    for (auto& b : _members_table.local().all_brokers()) {
+        brokers.push_back(*b);
+    }
+    iobuf out;
+    reflection::serialize(
+      out, std::move(brokers), _members_table.local().get_decommissioned());
+    co_return out;
+}
+
+ss::future<>
+members_manager::apply_snapshot(model::offset offset, iobuf data) {
+    iobuf_parser parser(std::move(data));
+    auto brokers = reflection::adl<std::vector<model::broker>>{}.from(parser);
+    auto draining = reflection::adl<std::vector<model::node_id>>{}.from(parser);
+    vlog(
+      clusterlog.info,
+      "restoring {} members from snapshot at offset {}, draining: {}",
+      brokers.size(),
+      offset,
+      draining);
+
+    co_await handle_raft0_cfg_update(
+      raft::group_configuration(std::move(brokers), model::revision_id(0)),
+      offset);
+
+    // membership state changes are applied as the commands that caused them
+    for (auto& b : _members_table.local().all_brokers()) {
+        auto id = b->id();
+        bool is_draining = std::find(draining.begin(), draining.end(), id)
+                           != draining.end();
+        auto state = b->get_membership_state();
+        if (is_draining && state == model::membership_state::active) {
+            co_await apply_update(
+              co_await serialize_cmd(decommission_node_cmd(id, 0)));
+        } else if (
+          !is_draining && state == model::membership_state::draining) {
+            co_await apply_update(
+              co_await serialize_cmd(recommission_node_cmd(id, 0)));
+        }
+    }
+}
+
 ss::future<std::error_code>
 members_manager::apply_raft_configuration_batch(model::record_batch b) {
     vassert(
@@ -69,6 +69,10 @@ public:
     ss::future<result<join_reply>> handle_join_request(model::broker);
     ss::future<std::error_code> apply_update(model::record_batch);
 
+    /// cluster members and their membership state
+    ss::future<iobuf> take_snapshot(model::offset);
+    ss::future<> apply_snapshot(model::offset, iobuf);
+
     ss::future<result<configuration_update_reply>>
       handle_configuration_update_request(configuration_update_request);
 
@@ -79,11 +79,27 @@ metadata_cache::get_topic_timestamp_type(model::topic_namespace_view tp) const {
 }
 
 std::vector<model::topic_metadata> metadata_cache::all_topics_metadata() const {
+    return topics_metadata_snapshot()->topics;
+}
+
+metadata_cache::topics_snapshot_ptr
+metadata_cache::topics_metadata_snapshot() const {
+    auto version = topics_metadata_version();
+    if (_topics_snapshot && _topics_snapshot->version == version) {
+        return _topics_snapshot;
+    }
     auto all_md = _topics_state.local().all_topics_metadata();
     for (auto& md : all_md) {
         fill_partition_leaders(_leaders.local(), md);
     }
-    return all_md;
+    _topics_snapshot = ss::make_lw_shared<topics_snapshot>(
+      topics_snapshot{.version = version, .topics = std::move(all_md)});
+    return _topics_snapshot;
+}
+
+uint64_t metadata_cache::topics_metadata_version() const {
+    // both versions only ever grow, so does their sum
+    return _topics_state.local().version() + _leaders.local().version();
 }
 
 std::optional<broker_ptr> metadata_cache::get_broker(model::node_id nid) const {
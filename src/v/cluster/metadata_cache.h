@@ -18,6 +18,7 @@
 #include "utils/expiring_promise.h"
 
 #include <seastar/core/future.hh>
+#include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sharded.hh>
 
 #include <absl/container/flat_hash_map.h>
@@ -47,8 +48,21 @@ namespace cluster {
 /// +----v----+   +----v-----+    +-----v------+
 /// | Members |   |  Topics  |    |  Leaders   |
 /// +---------+   +----------+    +------------+
+///```
+///
+/// The metadata of all topics, with the partition leaders filled in, is kept
+/// in an immutable snapshot shared by all the readers. The snapshot is rebuilt,
+/// once, by the first reader following a change of topics or leaders; readers
+/// still holding the previous snapshot keep it alive.
 class metadata_cache {
 public:
+    /// Metadata of all the topics at a given topics metadata version
+    struct topics_snapshot {
+        uint64_t version;
+        std::vector<model::topic_metadata> topics;
+    };
+    using topics_snapshot_ptr = ss::lw_shared_ptr<const topics_snapshot>;
+
     metadata_cache(
       ss::sharded<topic_table>&,
       ss::sharded<members_table>&,
@@ -84,6 +98,14 @@ public:
     /// Returns metadata of all topics.
     std::vector<model::topic_metadata> all_topics_metadata() const;
 
+    /// Returns metadata of all topics without copying it, the snapshot is
+    /// never modified and may be held across scheduling points
+    topics_snapshot_ptr topics_metadata_snapshot() const;
+
+    /// Returns a version of the topics metadata, it changes whenever the
+    /// result of all_topics_metadata() may have changed
+    uint64_t topics_metadata_version() const;
+
     /// Returns all brokers, returns copy as the content of broker can change
     std::vector<broker_ptr> all_brokers() const;
 
@@ -133,5 +155,6 @@ private:
     ss::sharded<topic_table>& _topics_state;
     ss::sharded<members_table>& _members_table;
     ss::sharded<partition_leaders_table>& _leaders;
+    mutable topics_snapshot_ptr _topics_snapshot;
 };
 } // namespace cluster
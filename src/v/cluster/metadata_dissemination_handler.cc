@@ -12,6 +12,7 @@
 #include "cluster/cluster_utils.h"
 #include "cluster/logger.h"
 #include "cluster/metadata_cache.h"
+#include "cluster/metadata_dissemination_service.h"
 #include "cluster/metadata_dissemination_types.h"
 #include "cluster/partition_leaders_table.h"
 #include "likely.h"
@@ -68,6 +69,44 @@ make_get_leadership_reply(const partition_leaders_table& leaders) {
     return get_leadership_reply{std::move(ret)};
 }
 
+static get_leadership_delta_reply make_get_leadership_delta_reply(
+  const partition_leaders_table& leaders,
+  const get_leadership_delta_request& req) {
+    get_leadership_delta_reply reply{
+      .epoch = leaders.epoch(), .version = leaders.version()};
+    auto append = [&reply](
+                    model::topic_namespace_view tp_ns,
+                    model::partition_id pid,
+                    std::optional<model::node_id> leader,
+                    model::term_id term) {
+        reply.leaders.emplace_back(ntp_leader{
+          .ntp = model::ntp(tp_ns.ns, tp_ns.tp, pid),
+          .term = term,
+          .leader_id = leader});
+    };
+    if (
+      req.epoch == leaders.epoch()
+      && leaders.for_each_leader_since(req.version, append)) {
+        return reply;
+    }
+    reply.full = true;
+    leaders.for_each_leader(append);
+    return reply;
+}
+
+ss::future<get_leadership_delta_reply>
+metadata_dissemination_handler::get_leadership_delta(
+  get_leadership_delta_request&& req, rpc::streaming_context&) {
+    return ss::with_scheduling_group(get_scheduling_group(), [this, req] {
+        // the updates log is only retained on shard 0
+        return _leaders.invoke_on(
+          metadata_dissemination_service::shard,
+          [req](const partition_leaders_table& leaders) {
+              return make_get_leadership_delta_reply(leaders, req);
+          });
+    });
+}
+
 ss::future<get_leadership_reply> metadata_dissemination_handler::get_leadership(
   get_leadership_request&& req, rpc::streaming_context&) {
     return ss::with_scheduling_group(
@@ -45,6 +45,9 @@ public:
     ss::future<get_leadership_reply>
     get_leadership(get_leadership_request&&, rpc::streaming_context&) final;
 
+    ss::future<get_leadership_delta_reply> get_leadership_delta(
+      get_leadership_delta_request&&, rpc::streaming_context&) final;
+
 private:
     ss::future<update_leadership_reply>
     do_update_leadership(update_leadership_request&&);
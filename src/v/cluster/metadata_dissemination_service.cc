@@ -26,6 +26,7 @@
 #include "model/namespace.h"
 #include "model/timeout_clock.h"
 #include "rpc/connection_cache.h"
+#include "rpc/errc.h"
 #include "rpc/types.h"
 #include "utils/retry.h"
 #include "utils/unresolved_address.h"
@@ -33,6 +34,7 @@
 #include "vlog.h"
 
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/future-util.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/sleep.hh>
@@ -60,12 +62,27 @@ metadata_dissemination_service::metadata_dissemination_service(
   , _self(make_self_broker(config::shard_local_cfg()))
   , _dissemination_interval(
       config::shard_local_cfg().metadata_dissemination_interval_ms)
-  , _rpc_tls_config(config::shard_local_cfg().rpc_server_tls()) {
+  , _rpc_tls_config(config::shard_local_cfg().rpc_server_tls())
+  , _delta_interval(
+      config::shard_local_cfg().metadata_dissemination_delta_interval_ms()) {
     _dispatch_timer.set_callback([this] {
         (void)ss::with_gate(
           _bg, [this] { return dispatch_disseminate_leadership(); });
     });
     _dispatch_timer.arm(_dissemination_interval);
+    _delta_timer.set_callback([this] {
+        (void)ss::with_gate(_bg, [this] {
+            return request_leadership_delta()
+              .handle_exception([](const std::exception_ptr& e) {
+                  vlog(clusterlog.debug, "Leadership updates error: {}", e);
+              })
+              .finally([this] {
+                  if (!_as.abort_requested()) {
+                      _delta_timer.arm(_delta_interval);
+                  }
+              });
+        });
+    });
 
     for (auto& seed : config::shard_local_cfg().seed_servers()) {
         _seed_servers.push_back(seed.addr);
@@ -101,9 +118,18 @@ ss::future<> metadata_dissemination_service::start() {
               std::move(ntp), term, std::move(leader_id));
         });
 
-    if (ss::this_shard_id() != 0) {
+    if (ss::this_shard_id() != shard) {
         return ss::make_ready_future<>();
     }
+    _leaders.local().enable_updates_log(
+      config::shard_local_cfg().metadata_dissemination_delta_log_size());
+    // the first request, made right away, asks for all the leaders
+    _delta_timer.arm(std::chrono::milliseconds(0));
+    return ss::make_ready_future<>();
+}
+
+std::vector<unresolved_address>
+metadata_dissemination_service::metadata_sources() const {
     // poll either seed servers or configuration
     auto all_brokers = _members_table.local().all_brokers();
     // use hash set to deduplicate ids
@@ -120,23 +146,51 @@ ss::future<> metadata_dissemination_service::start() {
     // We do not want to send requst to self
     all_broker_addresses.erase(_self.rpc_address());
 
-    // Do nothing, single node cluster
-    if (all_broker_addresses.empty()) {
-        return ss::make_ready_future<>();
-    }
     std::vector<unresolved_address> addresses;
     addresses.reserve(all_broker_addresses.size());
     addresses.insert(
       addresses.begin(),
       all_broker_addresses.begin(),
       all_broker_addresses.end());
+    return addresses;
+}
 
-    (void)ss::with_gate(
-      _bg, [this, addresses = std::move(addresses)]() mutable {
-          return update_metadata_with_retries(std::move(addresses));
-      });
-
-    return ss::make_ready_future<>();
+ss::future<> metadata_dissemination_service::request_leadership_delta() {
+    auto addresses = metadata_sources();
+    // Do nothing, single node cluster
+    if (addresses.empty()) {
+        co_return;
+    }
+    if (_delta_source) {
+        if (_delta_source->epoch == 0) {
+            // source does not retain leadership updates, rely on the updates
+            // pushed by the leaders
+            co_return;
+        }
+        auto source = *_delta_source;
+        try {
+            auto r = co_await dispatch_get_metadata_update(
+              source.address, source.epoch, source.version);
+            if (r) {
+                co_await apply_leadership_delta(
+                  source.address, std::move(r.value()));
+                co_return;
+            }
+            vlog(
+              clusterlog.debug,
+              "Unable to request leadership updates from {} - {}",
+              source.address,
+              r.error().message());
+        } catch (...) {
+            vlog(
+              clusterlog.debug,
+              "Unable to request leadership updates from {} - {}",
+              source.address,
+              std::current_exception());
+        }
+    }
+    // fallback requesting all the leaders
+    co_await update_metadata_with_retries(std::move(addresses));
 }
 
 void metadata_dissemination_service::handle_leadership_notification(
@@ -198,8 +252,8 @@ ss::future<> metadata_dissemination_service::update_metadata_with_retries(
 
 ss::future<> metadata_dissemination_service::do_request_metadata_update(
   request_retry_meta& meta) {
-    return dispatch_get_metadata_update(*meta.next)
-      .then([this, &meta](result<get_leadership_reply> r) {
+    return dispatch_get_metadata_update(*meta.next, 0, 0)
+      .then([this, &meta](result<get_leadership_delta_reply> r) {
           return process_get_update_reply(std::move(r), meta);
       })
       .handle_exception([](const std::exception_ptr& e) {
@@ -223,7 +277,7 @@ ss::future<> metadata_dissemination_service::do_request_metadata_update(
 }
 
 ss::future<> metadata_dissemination_service::process_get_update_reply(
-  result<get_leadership_reply> reply_result, request_retry_meta& meta) {
+  result<get_leadership_delta_reply> reply_result, request_retry_meta& meta) {
     if (!reply_result) {
         vlog(
           clusterlog.debug,
@@ -231,32 +285,77 @@ ss::future<> metadata_dissemination_service::process_get_update_reply(
           *meta.next);
         return ss::make_ready_future<>();
     }
-    // Update all NTP leaders
+    return apply_leadership_delta(*meta.next, std::move(reply_result.value()))
+      .then([&meta] { meta.success = true; });
+}
+
+ss::future<> metadata_dissemination_service::apply_leadership_delta(
+  unresolved_address address, get_leadership_delta_reply reply) {
+    vlog(
+      clusterlog.trace,
+      "Applying {} leaders from {}, full: {}, version: {}",
+      reply.leaders.size(),
+      address,
+      reply.full,
+      reply.version);
+    auto source = delta_source{
+      .address = std::move(address),
+      .epoch = reply.epoch,
+      .version = reply.version};
+    // Update NTP leaders
     return _leaders
-      .invoke_on_all([reply = std::move(reply_result.value())](
-                       partition_leaders_table& leaders) mutable {
-          for (auto& l : reply.leaders) {
-              leaders.update_partition_leader(l.ntp, l.term, l.leader_id);
+      .invoke_on_all([leaders = std::move(reply.leaders)](
+                       partition_leaders_table& table) mutable {
+          for (auto& l : leaders) {
+              table.update_partition_leader(l.ntp, l.term, l.leader_id);
           }
       })
-      .then([&meta] { meta.success = true; });
+      .then([this, source = std::move(source)]() mutable {
+          _delta_source = std::move(source);
+      });
 }
 
-ss::future<result<get_leadership_reply>>
+ss::future<result<get_leadership_delta_reply>>
 metadata_dissemination_service::dispatch_get_metadata_update(
-  unresolved_address address) {
-    vlog(clusterlog.debug, "Requesting metadata update from node {}", address);
+  unresolved_address address, uint64_t epoch, uint64_t version) {
+    vlog(
+      clusterlog.debug,
+      "Requesting metadata update from node {}, epoch: {}, version: {}",
+      address,
+      epoch,
+      version);
+    using ret_t = result<get_leadership_delta_reply>;
     return do_with_client_one_shot<metadata_dissemination_rpc_client_protocol>(
       address,
       _rpc_tls_config,
       _dissemination_interval,
-      [this](metadata_dissemination_rpc_client_protocol c) {
+      [this, epoch, version](metadata_dissemination_rpc_client_protocol c) {
+          auto timeout = rpc::clock_type::now() + _dissemination_interval;
           return c
-            .get_leadership(
-              get_leadership_request{},
-              rpc::client_opts(
-                rpc::clock_type::now() + _dissemination_interval))
-            .then(&rpc::get_ctx_data<get_leadership_reply>);
+            .get_leadership_delta(
+              get_leadership_delta_request{.epoch = epoch, .version = version},
+              rpc::client_opts(timeout))
+            .then(&rpc::get_ctx_data<get_leadership_delta_reply>)
+            .then([c, timeout](ret_t r) mutable {
+                if (r || r.error() != rpc::errc::method_not_found) {
+                    return ss::make_ready_future<ret_t>(std::move(r));
+                }
+                // node predating leadership updates, request all the leaders
+                return c
+                  .get_leadership(
+                    get_leadership_request{}, rpc::client_opts(timeout))
+                  .then(&rpc::get_ctx_data<get_leadership_reply>)
+                  .then([](result<get_leadership_reply> r) -> ret_t {
+                      if (!r) {
+                          return r.error();
+                      }
+                      return get_leadership_delta_reply{
+                        .full = true,
+                        .epoch = 0,
+                        .version = 0,
+                        .leaders = std::move(r.value().leaders)};
+                  });
+            });
       });
 }
 
@@ -362,6 +461,7 @@ ss::future<> metadata_dissemination_service::stop() {
       _notification_handle);
     _as.request_abort();
     _dispatch_timer.cancel();
+    _delta_timer.cancel();
     return _bg.close();
 }
 
@@ -67,10 +67,19 @@ namespace cluster {
 /// | +-----+ |   | +-----+ |  | +-----+ |  |         |  |         |
 /// +---------+   +---------+  +---------+  +---------+  +---------+
 ///                New leader
+///
+/// Leadership updates a node missed, e.g. while it was unreachable, are
+/// requested periodically from the node that provided the initial metadata.
+/// Every node retains the last leadership updates it applied, versioned by a
+/// monotonic sequence, so that only the updates following the last version
+/// seen by the requester are sent back. All the leaders are requested only
+/// when the updates are not retained anymore or the node restarted.
 
 class metadata_dissemination_service final
   : public ss::peering_sharded_service<metadata_dissemination_service> {
 public:
+    static constexpr ss::shard_id shard = 0;
+
     metadata_dissemination_service(
       ss::sharded<raft::group_manager>&,
       ss::sharded<cluster::partition_manager>&,
@@ -105,6 +114,14 @@ private:
         const_iterator next;
         exp_backoff_policy backoff_policy;
     };
+    // Node the leadership updates are requested from, with the last version
+    // of its leaders table applied locally. Epoch 0 if the node is not able
+    // to serve leadership updates.
+    struct delta_source {
+        unresolved_address address;
+        uint64_t epoch;
+        uint64_t version;
+    };
 
     using broker_updates_t
       = absl::flat_hash_map<model::node_id, update_retry_meta>;
@@ -118,13 +135,17 @@ private:
     void cleanup_finished_updates();
     ss::future<> dispatch_disseminate_leadership();
     ss::future<> dispatch_one_update(model::node_id, update_retry_meta&);
-    ss::future<result<get_leadership_reply>>
-      dispatch_get_metadata_update(unresolved_address);
+    ss::future<result<get_leadership_delta_reply>>
+      dispatch_get_metadata_update(unresolved_address, uint64_t, uint64_t);
     ss::future<> do_request_metadata_update(request_retry_meta&);
+    ss::future<> process_get_update_reply(
+      result<get_leadership_delta_reply>, request_retry_meta&);
     ss::future<>
-    process_get_update_reply(result<get_leadership_reply>, request_retry_meta&);
+      apply_leadership_delta(unresolved_address, get_leadership_delta_reply);
 
     ss::future<> update_metadata_with_retries(std::vector<unresolved_address>);
+    std::vector<unresolved_address> metadata_sources() const;
+    ss::future<> request_leadership_delta();
 
     ss::sharded<raft::group_manager>& _raft_manager;
     ss::sharded<cluster::partition_manager>& _partition_manager;
@@ -140,6 +161,9 @@ private:
     broker_updates_t _pending_updates;
     mutex _lock;
     ss::timer<> _dispatch_timer;
+    std::chrono::milliseconds _delta_interval;
+    std::optional<delta_source> _delta_source;
+    ss::timer<> _delta_timer;
     ss::abort_source _as;
     ss::gate _bg;
     cluster::notification_id_type _notification_handle;
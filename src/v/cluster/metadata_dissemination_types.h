@@ -37,6 +37,24 @@ struct get_leadership_reply {
     ntp_leaders leaders;
 };
 
+/// Requests the leadership updates the receiver applied after `version` of
+/// its leaders table instance `epoch`. All the leaders are returned if the
+/// epoch does not match or the updates are not retained anymore, epoch 0
+/// requests all the leaders.
+struct get_leadership_delta_request {
+    uint64_t epoch{0};
+    uint64_t version{0};
+};
+
+struct get_leadership_delta_reply {
+    // set if the reply holds all the leaders, not only the updated ones
+    bool full{false};
+    uint64_t epoch{0};
+    // version of the leaders table the reply is up to date with
+    uint64_t version{0};
+    ntp_leaders leaders;
+};
+
 inline std::ostream& operator<<(std::ostream& o, const ntp_leader& l) {
     o << "{ " << l.ntp << ", term: " << l.term
       << ", leader_id: " << (l.leader_id ? l.leader_id.value()() : -1) << " }";
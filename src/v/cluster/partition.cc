@@ -28,8 +28,10 @@ static bool is_tx_manager_topic(const model::ntp& ntp) {
 
 partition::partition(
   consensus_ptr r,
-  ss::sharded<cluster::tx_gateway_frontend>& tx_gateway_frontend)
+  ss::sharded<cluster::tx_gateway_frontend>& tx_gateway_frontend,
+  ss::lw_shared_ptr<cloud_storage::remote_partition> cloud_storage_partition)
   : _raft(r)
+  , _cloud_storage_partition(std::move(cloud_storage_partition))
   , _probe(std::make_unique<replicated_partition_probe>(*this))
   , _tx_gateway_frontend(tx_gateway_frontend)
   , _is_tx_enabled(config::shard_local_cfg().enable_transactions.value())
@@ -287,6 +289,10 @@ ss::future<> partition::start() {
         f = f.then([this] { return _tm_stm->start(); });
     }
 
+    if (_cloud_storage_partition) {
+        _cloud_storage_partition->start();
+    }
+
     return f;
 }
 
@@ -311,6 +317,10 @@ ss::future<> partition::stop() {
         f = f.then([this] { return _tm_stm->stop(); });
     }
 
+    if (_cloud_storage_partition) {
+        f = f.then([this] { return _cloud_storage_partition->stop(); });
+    }
+
     // no state machine
     return f;
 }
@@ -321,6 +331,13 @@ partition::timequery(model::timestamp t, ss::io_priority_class p) {
     return _raft->timequery(cfg);
 }
 
+ss::future<std::optional<storage::key_query_result>>
+partition::key_query(bytes key, ss::io_priority_class p) {
+    storage::key_query_config cfg(
+      std::move(key), _raft->last_visible_index(), p);
+    return _raft->log().key_query(std::move(cfg));
+}
+
 ss::future<> partition::update_configuration(topic_properties properties) {
     return _raft->log().update_configuration(
       properties.get_ntp_cfg_overrides());
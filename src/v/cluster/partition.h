@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "cloud_storage/remote_partition.h"
 #include "cluster/id_allocator_stm.h"
 #include "cluster/partition_probe.h"
 #include "cluster/rm_stm.h"
@@ -33,7 +34,10 @@ class partition_manager;
 /// all raft logic is proxied transparently
 class partition {
 public:
-    partition(consensus_ptr r, ss::sharded<cluster::tx_gateway_frontend>&);
+    partition(
+      consensus_ptr r,
+      ss::sharded<cluster::tx_gateway_frontend>&,
+      ss::lw_shared_ptr<cloud_storage::remote_partition> = nullptr);
 
     raft::group_id group() const { return _raft->group(); }
     ss::future<> start();
@@ -125,6 +129,11 @@ public:
     ss::future<std::optional<storage::timequery_result>>
       timequery(model::timestamp, ss::io_priority_class);
 
+    /// latest record with the key visible to consumers, the partition must
+    /// be compacted
+    ss::future<std::optional<storage::key_query_result>>
+      key_query(bytes, ss::io_priority_class);
+
     bool is_leader() const { return _raft->is_leader(); }
 
     ss::future<std::error_code>
@@ -163,6 +172,7 @@ public:
     ss::shared_ptr<cluster::rm_stm> rm_stm();
 
     size_t size_bytes() const { return _raft->log().size_bytes(); }
+    uint64_t bytes_written() const { return _raft->log().bytes_written(); }
     ss::future<> update_configuration(topic_properties);
 
     const storage::ntp_config& get_ntp_config() const {
@@ -180,18 +190,26 @@ public:
         return _rm_stm->aborted_transactions(from, to);
     }
 
+    /// Part of the log archived in the cloud storage that can be read after
+    /// it was removed from the local disk, null when remote reads are
+    /// disabled
+    const ss::lw_shared_ptr<cloud_storage::remote_partition>&
+    cloud_storage_partition() const {
+        return _cloud_storage_partition;
+    }
+
+    consensus_ptr raft() const { return _raft; }
+
 private:
     friend partition_manager;
     friend replicated_partition_probe;
 
-    consensus_ptr raft() { return _raft; }
-
-private:
     consensus_ptr _raft;
     ss::lw_shared_ptr<raft::log_eviction_stm> _nop_stm;
     ss::lw_shared_ptr<cluster::id_allocator_stm> _id_allocator_stm;
     ss::shared_ptr<cluster::rm_stm> _rm_stm;
     ss::shared_ptr<cluster::tm_stm> _tm_stm;
+    ss::lw_shared_ptr<cloud_storage::remote_partition> _cloud_storage_partition;
     ss::abort_source _as;
     partition_probe _probe;
     ss::sharded<cluster::tx_gateway_frontend>& _tx_gateway_frontend;
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#include "cluster/partition_balancer.h"
+
+#include "cluster/logger.h"
+#include "cluster/partition_balancer_planner.h"
+#include "cluster/scheduling/partition_allocator.h"
+#include "cluster/topic_table.h"
+#include "cluster/topics_frontend.h"
+#include "config/configuration.h"
+#include "model/timeout_clock.h"
+#include "raft/consensus.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+
+namespace cluster {
+
+partition_balancer::partition_balancer(
+  ss::sharded<topic_table>& topics,
+  ss::sharded<topics_frontend>& topics_frontend,
+  ss::sharded<partition_allocator>& allocator,
+  ss::sharded<health_manager>& health_manager,
+  consensus_ptr raft0,
+  ss::sharded<ss::abort_source>& as)
+  : _topics(topics)
+  , _topics_frontend(topics_frontend)
+  , _allocator(allocator)
+  , _health_manager(health_manager)
+  , _raft0(std::move(raft0))
+  , _as(as)
+  , _tick_interval(
+      config::shard_local_cfg().partition_balancer_tick_interval_ms())
+  , _timer([this] { tick(); }) {}
+
+ss::future<> partition_balancer::start() {
+    _timer.arm(_tick_interval);
+    co_return;
+}
+
+ss::future<> partition_balancer::stop() {
+    _timer.cancel();
+    return _gate.close();
+}
+
+void partition_balancer::tick() {
+    (void)ss::try_with_gate(_gate, [this] {
+        return do_tick()
+          .handle_exception([](const std::exception_ptr& e) {
+              vlog(clusterlog.info, "Partition balancer caught error {}", e);
+          })
+          .finally([this] {
+              if (!_as.local().abort_requested()) {
+                  _timer.arm(_tick_interval);
+              }
+          });
+    }).handle_exception_type([](const ss::gate_closed_exception&) {});
+}
+
+ss::future<> partition_balancer::do_tick() {
+    const auto& cfg = config::shard_local_cfg();
+    if (!cfg.enable_partition_balancer() || !_raft0->is_leader()) {
+        co_return;
+    }
+    // wait for all moves, including the ones of decommissioned and added
+    // nodes, to finish
+    if (_topics.local().has_updates_in_progress()) {
+        vlog(clusterlog.trace, "Partition balancer: moves in progress");
+        co_return;
+    }
+    if (_moves_requested) {
+        _moves_requested = false;
+        _moves_finished_at = clock_type::now();
+    }
+    // nodes measure their throughput over a health manager tick, the load used
+    // has to be measured after the previous moves finished
+    const auto& hm = _health_manager.local();
+    if (
+      hm.cluster_load_collected_at()
+      < _moves_finished_at + 2 * cfg.health_manager_tick_interval()) {
+        vlog(clusterlog.trace, "Partition balancer: waiting for cluster load");
+        co_return;
+    }
+    // moving replicas adds recovery traffic, the cluster has to recover from
+    // failures first
+    if (!hm.is_cluster_healthy()) {
+        vlog(clusterlog.debug, "Partition balancer: cluster is not healthy");
+        co_return;
+    }
+
+    partition_balancer_planner planner(
+      partition_balancer_planner::config{
+        .max_moves = cfg.partition_balancer_max_concurrent_moves(),
+        .min_skew_percent = cfg.partition_balancer_min_skew_percent()},
+      _topics.local(),
+      _allocator.local().state());
+    auto moves = planner.plan(hm.cluster_load());
+
+    for (auto& m : moves) {
+        vlog(clusterlog.info, "Partition balancer: moving {}", m);
+        auto ec = co_await _topics_frontend.local().move_partition_replicas(
+          m.ntp,
+          std::move(m.replicas),
+          model::timeout_clock::now() + move_timeout);
+        if (ec) {
+            vlog(
+              clusterlog.info,
+              "Partition balancer: error moving {}: {}",
+              m.ntp,
+              ec.message());
+            continue;
+        }
+        _moves_requested = true;
+    }
+}
+
+} // namespace cluster
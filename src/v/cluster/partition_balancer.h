@@ -0,0 +1,73 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#pragma once
+
+#include "cluster/fwd.h"
+#include "cluster/health_manager.h"
+#include "cluster/types.h"
+#include "seastarx.h"
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/timer.hh>
+
+#include <chrono>
+
+namespace cluster {
+
+/**
+ * Continuously moves partition replicas across nodes and cores to even out
+ * the throughput and disk usage measured by the health manager.
+ *
+ * Only active on the controller leader. Every round requests at most
+ * `partition_balancer_max_concurrent_moves` moves and the next round is only
+ * planned once all partition moves in the cluster finished and the load was
+ * measured again, so the recovery traffic generated stays bounded. Moves of a
+ * replica between cores of the same node are carried out by the controller
+ * backend as cross shard moves.
+ */
+class partition_balancer {
+    using clock_type = health_manager::clock_type;
+    static constexpr std::chrono::seconds move_timeout = 10s;
+
+public:
+    static constexpr ss::shard_id shard = 0;
+
+    partition_balancer(
+      ss::sharded<topic_table>&,
+      ss::sharded<topics_frontend>&,
+      ss::sharded<partition_allocator>&,
+      ss::sharded<health_manager>&,
+      consensus_ptr,
+      ss::sharded<ss::abort_source>&);
+
+    ss::future<> start();
+    ss::future<> stop();
+
+private:
+    void tick();
+    ss::future<> do_tick();
+
+    ss::sharded<topic_table>& _topics;
+    ss::sharded<topics_frontend>& _topics_frontend;
+    ss::sharded<partition_allocator>& _allocator;
+    ss::sharded<health_manager>& _health_manager;
+    consensus_ptr _raft0;
+    ss::sharded<ss::abort_source>& _as;
+    std::chrono::milliseconds _tick_interval;
+    ss::gate _gate;
+    ss::timer<clock_type> _timer;
+    bool _moves_requested{false};
+    clock_type::time_point _moves_finished_at;
+};
+
+} // namespace cluster
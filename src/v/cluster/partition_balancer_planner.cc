@@ -0,0 +1,267 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#include "cluster/partition_balancer_planner.h"
+
+#include "cluster/scheduling/allocation_node.h"
+#include "cluster/topic_table.h"
+#include "model/namespace.h"
+
+#include <fmt/ostream.h>
+
+#include <algorithm>
+
+namespace cluster {
+
+namespace {
+void add_load(core_load& dst, const core_load& l) {
+    dst.bytes_per_sec += l.bytes_per_sec;
+    dst.disk_bytes += l.disk_bytes;
+}
+
+void remove_load(core_load& dst, const core_load& l) {
+    dst.bytes_per_sec -= std::min(dst.bytes_per_sec, l.bytes_per_sec);
+    dst.disk_bytes -= std::min(dst.disk_bytes, l.disk_bytes);
+}
+
+bool contains_node(
+  const std::vector<model::broker_shard>& replicas, model::node_id id) {
+    return std::any_of(
+      replicas.begin(), replicas.end(), [id](const model::broker_shard& bs) {
+          return bs.node_id == id;
+      });
+}
+} // namespace
+
+partition_balancer_planner::partition_balancer_planner(
+  config cfg, const topic_table& topics, const allocation_state& state)
+  : _config(cfg)
+  , _topics(topics)
+  , _state(state) {}
+
+double partition_balancer_planner::node::per_core(dimension d) const {
+    uint64_t total = 0;
+    for (const auto& c : cores) {
+        total += c.*d;
+    }
+    return static_cast<double>(total) / cores.size();
+}
+
+void partition_balancer_planner::build_model(const cluster_load_t& load) {
+    _nodes.clear();
+    _moved.clear();
+    for (const auto& [id, report] : load) {
+        auto it = _state.allocation_nodes().find(id);
+        if (
+          it == _state.allocation_nodes().end() || !it->second->is_active()
+          || report.cores.empty()) {
+            continue;
+        }
+        node n{.id = id, .allocation = it->second.get(), .cores = report.cores};
+        for (const auto& p : report.partitions) {
+            // internal partitions are never moved
+            if (
+              p.ntp.ns == model::kafka_internal_namespace
+              || p.ntp.ns == model::redpanda_ns
+              || _topics.is_update_in_progress(p.ntp)) {
+                continue;
+            }
+            auto assignment = _topics.get_partition_assignment(p.ntp);
+            if (!assignment) {
+                continue;
+            }
+            auto r_it = std::find_if(
+              assignment->replicas.begin(),
+              assignment->replicas.end(),
+              [id = id](const model::broker_shard& bs) {
+                  return bs.node_id == id;
+              });
+            if (
+              r_it == assignment->replicas.end()
+              || r_it->shard >= n.cores.size()) {
+                continue;
+            }
+            n.replicas.push_back(replica{
+              .ntp = p.ntp,
+              .shard = r_it->shard,
+              .load = core_load{
+                .bytes_per_sec = p.bytes_per_sec, .disk_bytes = p.disk_bytes},
+              .replicas = std::move(assignment->replicas)});
+        }
+        _nodes.push_back(std::move(n));
+    }
+}
+
+bool partition_balancer_planner::is_skewed(
+  double max, double min, double mean) const {
+    return mean > 0 && (max - min) * 100 > mean * _config.min_skew_percent;
+}
+
+std::vector<partition_balancer_planner::move>
+partition_balancer_planner::plan(const cluster_load_t& load) {
+    build_model(load);
+    std::vector<move> moves;
+    while (moves.size() < _config.max_moves) {
+        auto m = plan_node_move(&core_load::bytes_per_sec);
+        if (!m) {
+            m = plan_node_move(&core_load::disk_bytes);
+        }
+        if (!m) {
+            m = plan_core_move();
+        }
+        if (!m) {
+            break;
+        }
+        _moved.insert(m->ntp);
+        moves.push_back(std::move(*m));
+    }
+    return moves;
+}
+
+std::optional<partition_balancer_planner::move>
+partition_balancer_planner::plan_node_move(dimension d) {
+    if (_nodes.size() < 2) {
+        return std::nullopt;
+    }
+    double mean = 0;
+    for (const auto& n : _nodes) {
+        mean += n.per_core(d);
+    }
+    mean /= _nodes.size();
+
+    auto by_load = [d](const node& a, const node& b) {
+        return a.per_core(d) < b.per_core(d);
+    };
+    auto [cold, hot] = std::minmax_element(
+      _nodes.begin(), _nodes.end(), by_load);
+    const auto hot_load = hot->per_core(d);
+    const auto cold_load = cold->per_core(d);
+    if (!is_skewed(hot_load, cold_load, mean) || cold->allocation->is_full()) {
+        return std::nullopt;
+    }
+
+    // moving more than this makes the destination more loaded than the source
+    const double hot_cores = hot->cores.size();
+    const double cold_cores = cold->cores.size();
+    const double limit = (hot_load - cold_load) * hot_cores * cold_cores
+                         / (hot_cores + cold_cores);
+
+    // the largest replica that does not overshoot
+    auto best = hot->replicas.end();
+    for (auto it = hot->replicas.begin(); it != hot->replicas.end(); ++it) {
+        auto l = it->load.*d;
+        if (
+          l == 0 || l > limit || _moved.contains(it->ntp)
+          || contains_node(it->replicas, cold->id)) {
+            continue;
+        }
+        if (best == hot->replicas.end() || l > best->load.*d) {
+            best = it;
+        }
+    }
+    if (best == hot->replicas.end()) {
+        return std::nullopt;
+    }
+
+    auto dst_core = std::min_element(
+      cold->cores.begin(),
+      cold->cores.end(),
+      [](const core_load& a, const core_load& b) {
+          return a.bytes_per_sec < b.bytes_per_sec;
+      });
+    move m{.ntp = best->ntp, .replicas = best->replicas};
+    for (auto& bs : m.replicas) {
+        if (bs.node_id == hot->id) {
+            bs = model::broker_shard{
+              .node_id = cold->id,
+              .shard = static_cast<uint32_t>(
+                std::distance(cold->cores.begin(), dst_core))};
+        }
+    }
+    remove_load(hot->cores[best->shard], best->load);
+    add_load(*dst_core, best->load);
+    return m;
+}
+
+std::optional<partition_balancer_planner::move>
+partition_balancer_planner::plan_core_move() {
+    auto by_load = [](const core_load& a, const core_load& b) {
+        return a.bytes_per_sec < b.bytes_per_sec;
+    };
+
+    // the move is planned on the node with the most skewed cores
+    std::optional<move> ret;
+    double max_skew = 0;
+    std::vector<core_load>* cores = nullptr;
+    ss::shard_id from = 0;
+    ss::shard_id to = 0;
+    core_load moved;
+    for (auto& n : _nodes) {
+        if (n.cores.size() < 2) {
+            continue;
+        }
+        auto [cold, hot] = std::minmax_element(
+          n.cores.begin(), n.cores.end(), by_load);
+        const double hot_load = hot->bytes_per_sec;
+        const double cold_load = cold->bytes_per_sec;
+        const double skew = hot_load - cold_load;
+        if (
+          !is_skewed(hot_load, cold_load, n.per_core(&core_load::bytes_per_sec))
+          || skew <= max_skew) {
+            continue;
+        }
+        const ss::shard_id hot_shard = std::distance(n.cores.begin(), hot);
+        const ss::shard_id cold_shard = std::distance(n.cores.begin(), cold);
+        // moving more than half of the difference swaps the hot and cold cores
+        const double limit = skew / 2;
+
+        auto best = n.replicas.end();
+        for (auto it = n.replicas.begin(); it != n.replicas.end(); ++it) {
+            auto l = it->load.bytes_per_sec;
+            if (
+              it->shard != hot_shard || l == 0 || l > limit
+              || _moved.contains(it->ntp)) {
+                continue;
+            }
+            if (best == n.replicas.end() || l > best->load.bytes_per_sec) {
+                best = it;
+            }
+        }
+        if (best == n.replicas.end()) {
+            continue;
+        }
+
+        move m{.ntp = best->ntp, .replicas = best->replicas};
+        for (auto& bs : m.replicas) {
+            if (bs.node_id == n.id) {
+                bs.shard = cold_shard;
+            }
+        }
+        max_skew = skew;
+        ret = std::move(m);
+        cores = &n.cores;
+        from = hot_shard;
+        to = cold_shard;
+        moved = best->load;
+    }
+    if (ret) {
+        remove_load((*cores)[from], moved);
+        add_load((*cores)[to], moved);
+    }
+    return ret;
+}
+
+std::ostream&
+operator<<(std::ostream& o, const partition_balancer_planner::move& m) {
+    fmt::print(o, "{{ntp: {}, replicas: {}}}", m.ntp, m.replicas);
+    return o;
+}
+
+} // namespace cluster
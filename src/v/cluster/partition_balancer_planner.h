@@ -0,0 +1,92 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#pragma once
+
+#include "cluster/fwd.h"
+#include "cluster/scheduling/allocation_state.h"
+#include "cluster/types.h"
+#include "model/fundamental.h"
+#include "model/metadata.h"
+
+#include <absl/container/flat_hash_set.h>
+#include <absl/container/node_hash_map.h>
+
+#include <optional>
+#include <vector>
+
+namespace cluster {
+
+/**
+ * Plans partition replica moves evening out the load measured on the cluster
+ * nodes and on the cores of every node.
+ *
+ * Replicas move from the node with the highest throughput per core to the one
+ * with the lowest, then from the node with the highest disk usage per core to
+ * the one with the lowest, then from the hottest core of a node to its
+ * coldest core. A replica is only moved if it reduces the difference between
+ * the source and the destination, the moves planned are applied to the load
+ * model before planning the next one.
+ */
+class partition_balancer_planner {
+public:
+    using cluster_load_t = absl::node_hash_map<model::node_id, node_load_reply>;
+
+    struct config {
+        size_t max_moves;
+        // difference between the most and least loaded nodes or cores above
+        // which replicas are moved, in percent of their average load
+        uint32_t min_skew_percent;
+    };
+
+    struct move {
+        model::ntp ntp;
+        std::vector<model::broker_shard> replicas;
+
+        friend std::ostream& operator<<(std::ostream&, const move&);
+    };
+
+    partition_balancer_planner(
+      config, const topic_table&, const allocation_state&);
+
+    std::vector<move> plan(const cluster_load_t&);
+
+private:
+    using dimension = uint64_t core_load::*;
+
+    struct replica {
+        model::ntp ntp;
+        ss::shard_id shard;
+        core_load load;
+        std::vector<model::broker_shard> replicas;
+    };
+
+    struct node {
+        model::node_id id;
+        const allocation_node* allocation;
+        std::vector<core_load> cores;
+        std::vector<replica> replicas;
+
+        double per_core(dimension) const;
+    };
+
+    void build_model(const cluster_load_t&);
+    std::optional<move> plan_node_move(dimension);
+    std::optional<move> plan_core_move();
+    bool is_skewed(double max, double min, double mean) const;
+
+    config _config;
+    const topic_table& _topics;
+    const allocation_state& _state;
+    std::vector<node> _nodes;
+    absl::flat_hash_set<model::ntp> _moved;
+};
+
+} // namespace cluster
@@ -13,17 +13,27 @@
 #include "cluster/topic_table.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
+#include "random/generators.h"
 #include "utils/expiring_promise.h"
 
 #include <seastar/core/future-util.hh>
 
+#include <limits>
 #include <optional>
 
 namespace cluster {
 
 partition_leaders_table::partition_leaders_table(
   ss::sharded<topic_table>& topic_table)
-  : _topic_table(topic_table) {}
+  : _topic_table(topic_table)
+  , _epoch(random_generators::get_int<uint64_t>(
+      1, std::numeric_limits<uint64_t>::max())) {}
+
+void partition_leaders_table::enable_updates_log(size_t capacity) {
+    _updates_capacity = capacity;
+    _updates_start = _version;
+    _updates.clear();
+}
 
 ss::future<> partition_leaders_table::stop() {
     while (!_leader_promises.empty()) {
@@ -85,6 +95,14 @@ void partition_leaders_table::update_partition_leader(
     // existing partition
     it->second.id = leader_id;
     it->second.update_term = term;
+    ++_version;
+    if (_updates_capacity > 0) {
+        _updates.push_back(logged_update{_version, it->first});
+        if (_updates.size() > _updates_capacity) {
+            _updates_start = _updates.front().version;
+            _updates.pop_front();
+        }
+    }
 
     // notify waiters if update is setting the leader
     if (!leader_id) {
@@ -20,8 +20,12 @@
 #include <seastar/core/sharded.hh>
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 #include <absl/container/node_hash_map.h>
 
+#include <algorithm>
+#include <deque>
+
 namespace cluster {
 
 /// Partition leaders contains information about currently elected partition
@@ -65,11 +69,54 @@ public:
     void remove_leader(const model::ntp& ntp) {
         _leaders.erase(
           leader_key_view{model::topic_namespace_view(ntp), ntp.tp.partition});
+        ++_version;
     }
 
     void update_partition_leader(
       const model::ntp&, model::term_id, std::optional<model::node_id>);
 
+    /// Version of the table content, incremented on every leadership change
+    uint64_t version() const { return _version; }
+
+    /// Identifies this instance of the table, versions of different
+    /// instances, e.g. before and after restart, can not be compared
+    uint64_t epoch() const { return _epoch; }
+
+    /// Retains the partitions of the last `capacity` leadership updates,
+    /// for_each_leader_since can only be served if enabled
+    void enable_updates_log(size_t capacity);
+
+    /// Calls `f` with the current leader of every partition which leader was
+    /// updated after `version`. Returns false, without calling `f`, if these
+    /// updates are not retained anymore.
+    template<typename Func>
+    bool for_each_leader_since(uint64_t version, Func&& f) const {
+        if (
+          _updates_capacity == 0 || version < _updates_start
+          || version > _version) {
+            return false;
+        }
+        auto it = std::upper_bound(
+          _updates.begin(),
+          _updates.end(),
+          version,
+          [](uint64_t v, const logged_update& u) { return v < u.version; });
+        absl::flat_hash_set<leader_key_view, leader_key_hash, leader_key_eq>
+          visited;
+        for (; it != _updates.end(); ++it) {
+            auto key = leader_key_view{it->key.tp_ns, it->key.pid};
+            if (!visited.insert(key).second) {
+                continue;
+            }
+            // removed partitions are not reported
+            if (auto l_it = _leaders.find(key); l_it != _leaders.end()) {
+                auto& meta = l_it->second;
+                f(key.tp_ns, key.pid, meta.id, meta.update_term);
+            }
+        }
+        return true;
+    }
+
 private:
     // optimized to reduce number of ntp copies
     struct leader_key {
@@ -132,6 +179,11 @@ private:
         model::term_id update_term;
     };
 
+    struct logged_update {
+        uint64_t version;
+        leader_key key;
+    };
+
     absl::flat_hash_map<leader_key, leader_meta, leader_key_hash, leader_key_eq>
       _leaders;
 
@@ -146,6 +198,13 @@ private:
     promises_t _leader_promises;
 
     ss::sharded<topic_table>& _topic_table;
+    uint64_t _version{0};
+    const uint64_t _epoch;
+    // partitions of the last leadership updates, all the updates made after
+    // _updates_start are retained
+    std::deque<logged_update> _updates;
+    size_t _updates_capacity{0};
+    uint64_t _updates_start{0};
 };
 
 } // namespace cluster
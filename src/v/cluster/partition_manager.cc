@@ -13,6 +13,7 @@
 #include "cluster/logger.h"
 #include "config/configuration.h"
 #include "model/metadata.h"
+#include "model/namespace.h"
 #include "raft/consensus.h"
 #include "raft/log_eviction_stm.h"
 #include "raft/rpc_client_protocol.h"
@@ -35,11 +36,15 @@ partition_manager::partition_manager(
   ss::sharded<storage::api>& storage,
   ss::sharded<raft::group_manager>& raft,
   ss::sharded<cluster::tx_gateway_frontend>& tx_gateway_frontend,
-  ss::sharded<cloud_storage::partition_recovery_manager>& recovery_mgr)
+  ss::sharded<cloud_storage::partition_recovery_manager>& recovery_mgr,
+  ss::sharded<cloud_storage::remote>& cloud_storage_api,
+  ss::sharded<cloud_storage::cache>& cloud_storage_cache)
   : _storage(storage.local())
   , _raft_manager(raft)
   , _tx_gateway_frontend(tx_gateway_frontend)
-  , _partition_recovery_mgr(recovery_mgr) {}
+  , _partition_recovery_mgr(recovery_mgr)
+  , _cloud_storage_api(cloud_storage_api)
+  , _cloud_storage_cache(cloud_storage_cache) {}
 
 partition_manager::ntp_table_container
 partition_manager::get_topic_partition_table(
@@ -56,8 +61,13 @@ partition_manager::get_topic_partition_table(
 ss::future<consensus_ptr> partition_manager::manage(
   storage::ntp_config ntp_cfg,
   raft::group_id group,
-  std::vector<model::broker> initial_nodes) {
+  std::vector<model::broker> initial_nodes,
+  std::optional<model::revision_id> hydrate_since) {
     gate_guard guard(_gate);
+    std::optional<cloud_storage::hydrated_log> hydrated;
+    if (hydrate_since) {
+        hydrated = co_await maybe_hydrate_log(ntp_cfg, *hydrate_since);
+    }
     bool logs_recovered = co_await maybe_download_log(ntp_cfg);
     if (logs_recovered) {
         vlog(
@@ -79,8 +89,12 @@ ss::future<consensus_ptr> partition_manager::manage(
     ss::lw_shared_ptr<raft::consensus> c
       = co_await _raft_manager.local().create_group(
         group, std::move(initial_nodes), log);
+    if (hydrated && hydrated->start_offset > model::offset(0)) {
+        co_await c->set_initial_offset_delta(hydrated->delta_offset);
+    }
 
-    auto p = ss::make_lw_shared<partition>(c, _tx_gateway_frontend);
+    auto p = ss::make_lw_shared<partition>(
+      c, _tx_gateway_frontend, make_cloud_storage_partition(log.config()));
 
     _ntp_table.emplace(log.config().ntp(), p);
     _raft_table.emplace(group, p);
@@ -103,6 +117,50 @@ partition_manager::maybe_download_log(storage::ntp_config& ntp_cfg) {
     co_return false;
 }
 
+ss::future<std::optional<cloud_storage::hydrated_log>>
+partition_manager::maybe_hydrate_log(
+  const storage::ntp_config& ntp_cfg, model::revision_id topic_revision) {
+    // only kafka topics are archived
+    if (
+      !config::shard_local_cfg().cloud_storage_hydrate_replicas()
+      || !_partition_recovery_mgr.local_is_initialized()
+      || ntp_cfg.ntp().ns != model::kafka_namespace) {
+        co_return std::nullopt;
+    }
+    auto hydrated = co_await _partition_recovery_mgr.local().hydrate_log(
+      ntp_cfg, topic_revision);
+    if (hydrated) {
+        vlog(
+          clusterlog.info,
+          "Log of {} hydrated from the cloud storage, start offset: {}",
+          ntp_cfg.ntp(),
+          hydrated->start_offset);
+    }
+    co_return hydrated;
+}
+
+ss::lw_shared_ptr<cloud_storage::remote_partition>
+partition_manager::make_cloud_storage_partition(
+  const storage::ntp_config& ntp_cfg) {
+    const auto& cfg = config::shard_local_cfg();
+    // only kafka topics are archived
+    if (
+      !cfg.cloud_storage_enable_remote_read()
+      || !_cloud_storage_api.local_is_initialized()
+      || !_cloud_storage_cache.local_is_initialized()
+      || ntp_cfg.ntp().ns != model::kafka_namespace) {
+        return nullptr;
+    }
+    return ss::make_lw_shared<cloud_storage::remote_partition>(
+      ntp_cfg.ntp(),
+      ntp_cfg.get_revision(),
+      s3::bucket_name(cfg.cloud_storage_bucket().value_or("")),
+      _cloud_storage_api.local(),
+      _cloud_storage_cache.local(),
+      cfg.cloud_storage_cache_chunk_size(),
+      cfg.cloud_storage_read_ahead_chunks());
+}
+
 ss::future<> partition_manager::stop_partitions() {
     co_await _gate.close();
     // prevent partitions from being accessed
@@ -154,6 +212,40 @@ ss::future<> partition_manager::remove(const model::ntp& ntp) {
       .finally([partition] {}); // in the end remove partition
 }
 
+ss::future<> partition_manager::remove(std::vector<model::ntp> ntps) {
+    std::vector<ss::lw_shared_ptr<partition>> partitions;
+    partitions.reserve(ntps.size());
+    for (const auto& ntp : ntps) {
+        auto partition = get(ntp);
+        if (!partition) {
+            throw std::invalid_argument(fmt::format(
+              "Can not remove partition. NTP {} is not present in partition "
+              "manager",
+              ntp));
+        }
+        partitions.push_back(std::move(partition));
+    }
+
+    // remove partitions from ntp & raft tables
+    std::vector<consensus_ptr> groups;
+    groups.reserve(partitions.size());
+    for (const auto& p : partitions) {
+        _ntp_table.erase(p->ntp());
+        _raft_table.erase(p->group());
+        groups.push_back(p->raft());
+    }
+
+    co_await _raft_manager.local().remove(std::move(groups));
+    for (const auto& p : partitions) {
+        _unmanage_watchers.notify(p->ntp(), p->ntp().tp.partition);
+    }
+    co_await ss::parallel_for_each(
+      partitions, [this](const ss::lw_shared_ptr<partition>& p) {
+          return p->stop().then(
+            [this, p] { return _storage.log_mgr().remove(p->ntp()); });
+      });
+}
+
 ss::future<> partition_manager::shutdown(const model::ntp& ntp) {
     auto partition = get(ntp);
 
@@ -11,7 +11,10 @@
 
 #pragma once
 
+#include "cloud_storage/cache_service.h"
 #include "cloud_storage/partition_recovery_manager.h"
+#include "cloud_storage/remote.h"
+#include "cloud_storage/remote_partition.h"
 #include "cluster/ntp_callbacks.h"
 #include "cluster/partition.h"
 #include "model/metadata.h"
@@ -33,7 +36,9 @@ public:
       ss::sharded<storage::api>&,
       ss::sharded<raft::group_manager>&,
       ss::sharded<cluster::tx_gateway_frontend>&,
-      ss::sharded<cloud_storage::partition_recovery_manager>&);
+      ss::sharded<cloud_storage::partition_recovery_manager>&,
+      ss::sharded<cloud_storage::remote>&,
+      ss::sharded<cloud_storage::cache>&);
 
     using manage_cb_t
       = ss::noncopyable_function<void(ss::lw_shared_ptr<partition>)>;
@@ -68,11 +73,20 @@ public:
 
     ss::future<> start() { return ss::now(); }
     ss::future<> stop_partitions();
-    ss::future<consensus_ptr>
-      manage(storage::ntp_config, raft::group_id, std::vector<model::broker>);
+    /// \param hydrate_since is set for the replicas added to an existing
+    /// partition, their log may be hydrated from the manifests uploaded since
+    /// that revision of the topic
+    ss::future<consensus_ptr> manage(
+      storage::ntp_config,
+      raft::group_id,
+      std::vector<model::broker>,
+      std::optional<model::revision_id> hydrate_since = std::nullopt);
 
     ss::future<> shutdown(const model::ntp& ntp);
     ss::future<> remove(const model::ntp& ntp);
+    /// removes the partitions together, their raft groups are deregistered
+    /// in one batch
+    ss::future<> remove(std::vector<model::ntp>);
 
     std::optional<storage::log> log(const model::ntp& ntp) {
         return _storage.log_mgr().get(ntp);
@@ -146,6 +160,17 @@ private:
     /// \return true if the recovery was invoked, false otherwise
     ss::future<bool> maybe_download_log(storage::ntp_config& ntp_cfg);
 
+    /// Hydrate the log of a new replica from the cloud storage when enabled
+    /// and the partition is archived
+    /// \return the start of the log if it was hydrated
+    ss::future<std::optional<cloud_storage::hydrated_log>>
+    maybe_hydrate_log(const storage::ntp_config&, model::revision_id);
+
+    /// Remote read path of the partition, created when remote reads from the
+    /// cloud storage are enabled
+    ss::lw_shared_ptr<cloud_storage::remote_partition>
+    make_cloud_storage_partition(const storage::ntp_config&);
+
     ss::future<> do_shutdown(ss::lw_shared_ptr<partition>);
 
     storage::api& _storage;
@@ -161,6 +186,8 @@ private:
     ss::sharded<cluster::tx_gateway_frontend>& _tx_gateway_frontend;
     ss::sharded<cloud_storage::partition_recovery_manager>&
       _partition_recovery_mgr;
+    ss::sharded<cloud_storage::remote>& _cloud_storage_api;
+    ss::sharded<cloud_storage::cache>& _cloud_storage_cache;
     ss::gate _gate;
 
     friend std::ostream& operator<<(std::ostream&, const partition_manager&);
@@ -12,6 +12,7 @@
 #include "cluster/partition.h"
 #include "config/configuration.h"
 #include "model/metadata.h"
+#include "prometheus/partition_metrics.h"
 #include "prometheus/prometheus_sanitize.h"
 
 #include <seastar/core/metrics.hh>
@@ -29,25 +30,46 @@ void replicated_partition_probe::setup_metrics(const model::ntp& ntp) {
         return;
     }
 
-    auto ns_label = sm::label("namespace");
-    auto topic_label = sm::label("topic");
-    auto partition_label = sm::label("partition");
-
-    const std::vector<sm::label_instance> labels = {
-      ns_label(ntp.ns()),
-      topic_label(ntp.tp.topic()),
-      partition_label(ntp.tp.partition()),
-    };
+    using partition_metrics::metric_kind;
+    partition_metrics::setup(
+      "cluster:partition",
+      ntp,
+      {
+        {"leader",
+         "Flag indicating if this partition instance is a leader",
+         metric_kind::gauge,
+         [this] { return _partition.is_leader() ? 1 : 0; }},
+        {"under_replicated_replicas",
+         "Number of under replicated replicas",
+         metric_kind::gauge,
+         [this] {
+             auto metrics = _partition._raft->get_follower_metrics();
+             return std::count_if(
+               metrics.cbegin(),
+               metrics.cend(),
+               [](const raft::follower_metrics& fm) {
+                   return fm.under_replicated;
+               });
+         }},
+        {"records_produced",
+         "Total number of records produced",
+         metric_kind::counter,
+         [this] { return _records_produced; }},
+        {"records_fetched",
+         "Total number of records fetched",
+         metric_kind::counter,
+         [this] { return _records_fetched; }},
+      },
+      _metrics,
+      _aggregated_metrics);
 
+    if (!partition_metrics::per_partition(ntp)) {
+        return;
+    }
+    const auto labels = partition_metrics::labels(ntp);
     _metrics.add_group(
       prometheus_sanitize::metrics_name("cluster:partition"),
       {
-        sm::make_gauge(
-          "leader",
-          [this] { return _partition.is_leader() ? 1 : 0; },
-          sm::description(
-            "Flag indicating if this partition instance is a leader"),
-          labels),
         sm::make_gauge(
           "last_stable_offset",
           [this] { return _partition.last_stable_offset(); },
@@ -79,29 +101,31 @@ void replicated_partition_probe::setup_metrics(const model::ntp& ntp) {
           },
           sm::description("Id of current partition leader"),
           labels),
-        sm::make_gauge(
-          "under_replicated_replicas",
+      });
+
+    if (!config::shard_local_cfg().partition_latency_breakdown()) {
+        return;
+    }
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("cluster:partition"),
+      {
+        sm::make_histogram(
+          "replicate_enqueue_latency_us",
+          sm::description("Time in microseconds for produced batches to be "
+                          "enqueued for replication"),
+          labels,
           [this] {
-              auto metrics = _partition._raft->get_follower_metrics();
-              return std::count_if(
-                metrics.cbegin(),
-                metrics.cend(),
-                [](const raft::follower_metrics& fm) {
-                    return fm.under_replicated;
-                });
-          },
-          sm::description("Number of under replicated replicas"),
-          labels),
-        sm::make_derive(
-          "records_produced",
-          [this] { return _records_produced; },
-          sm::description("Total number of records produced"),
-          labels),
-        sm::make_derive(
-          "records_fetched",
-          [this] { return _records_fetched; },
-          sm::description("Total number of records fetched"),
-          labels),
+              return _replicate_enqueue_latency.seastar_histogram_logform();
+          }),
+        sm::make_histogram(
+          "replicate_ack_latency_us",
+          sm::description("Time in microseconds for produced batches to be "
+                          "acknowledged at the requested consistency level, "
+                          "including the enqueue"),
+          labels,
+          [this] {
+              return _replicate_ack_latency.seastar_histogram_logform();
+          }),
       });
 }
 partition_probe make_materialized_partition_probe() {
@@ -110,6 +134,8 @@ partition_probe make_materialized_partition_probe() {
         void setup_metrics(const model::ntp&) final {}
         void add_records_fetched(uint64_t) final {}
         void add_records_produced(uint64_t) final {}
+        void add_replicate_enqueue_latency(std::chrono::microseconds) final {}
+        void add_replicate_ack_latency(std::chrono::microseconds) final {}
     };
     return partition_probe(std::make_unique<impl>());
 }
@@ -11,10 +11,13 @@
 
 #pragma once
 #include "model/fundamental.h"
+#include "prometheus/partition_metrics.h"
+#include "utils/log_hist.h"
 
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/shared_ptr.hh>
 
+#include <chrono>
 #include <cstdint>
 
 namespace cluster {
@@ -26,6 +29,9 @@ public:
     struct impl {
         virtual void add_records_produced(uint64_t) = 0;
         virtual void add_records_fetched(uint64_t) = 0;
+        virtual void add_replicate_enqueue_latency(std::chrono::microseconds)
+          = 0;
+        virtual void add_replicate_ack_latency(std::chrono::microseconds) = 0;
         virtual void setup_metrics(const model::ntp&) = 0;
         virtual ~impl() noexcept = default;
     };
@@ -45,6 +51,16 @@ public:
         return _impl->add_records_fetched(num_records);
     }
 
+    /// time for a produce to be enqueued for replication
+    void add_replicate_enqueue_latency(std::chrono::microseconds d) {
+        return _impl->add_replicate_enqueue_latency(d);
+    }
+
+    /// time for a produce to be acknowledged, including the enqueue
+    void add_replicate_ack_latency(std::chrono::microseconds d) {
+        return _impl->add_replicate_ack_latency(d);
+    }
+
 private:
     std::unique_ptr<impl> _impl;
 };
@@ -56,12 +72,21 @@ public:
 
     void add_records_fetched(uint64_t cnt) final { _records_fetched += cnt; }
     void add_records_produced(uint64_t cnt) final { _records_produced += cnt; }
+    void add_replicate_enqueue_latency(std::chrono::microseconds d) final {
+        _replicate_enqueue_latency.record(d);
+    }
+    void add_replicate_ack_latency(std::chrono::microseconds d) final {
+        _replicate_ack_latency.record(d);
+    }
 
 private:
     const partition& _partition;
     uint64_t _records_produced{0};
     uint64_t _records_fetched{0};
+    log_hist<std::chrono::microseconds> _replicate_enqueue_latency;
+    log_hist<std::chrono::microseconds> _replicate_ack_latency;
     ss::metrics::metric_groups _metrics;
+    partition_metrics::registry::member _aggregated_metrics;
 };
 
 partition_probe make_materialized_partition_probe();
@@ -81,7 +81,8 @@ ss::future<> persisted_stm::wait_for_snapshot_hydrated() {
     return f;
 }
 
-ss::future<> persisted_stm::persist_snapshot(stm_snapshot&& snapshot) {
+ss::future<>
+persisted_stm::persist_snapshot(stm_streaming_snapshot&& snapshot) {
     iobuf data_size_buf;
 
     int8_t version = snapshot_version;
@@ -91,32 +92,34 @@ ss::future<> persisted_stm::persist_snapshot(stm_snapshot&& snapshot) {
     reflection::serialize(
       data_size_buf, version, offset, data_version, data_size);
 
-    return _snapshot_mgr.start_snapshot().then(
-      [this,
-       snapshot = std::move(snapshot),
-       data_size_buf = std::move(data_size_buf)](
-        storage::snapshot_writer writer) mutable {
-          return ss::do_with(
-            std::move(writer),
-            [this,
-             snapshot = std::move(snapshot),
-             data_size_buf = std::move(data_size_buf)](
-              storage::snapshot_writer& writer) mutable {
-                return writer.write_metadata(std::move(data_size_buf))
-                  .then([&writer, snapshot = std::move(snapshot)]() mutable {
-                      return write_iobuf_to_output_stream(
-                        std::move(snapshot.data), writer.output());
-                  })
-                  .finally([&writer] { return writer.close(); })
-                  .then([this, &writer] {
-                      return _snapshot_mgr.finish_snapshot(writer);
-                  });
-            });
-      });
+    auto writer = co_await _snapshot_mgr.start_snapshot();
+    std::exception_ptr ex;
+    try {
+        co_await writer.write_metadata(std::move(data_size_buf));
+        co_await snapshot.write(writer.output());
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await writer.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_await _snapshot_mgr.finish_snapshot(writer);
 }
 
-ss::future<> persisted_stm::do_make_snapshot() {
+ss::future<stm_streaming_snapshot> persisted_stm::take_streaming_snapshot() {
     auto snapshot = co_await take_snapshot();
+    co_return stm_streaming_snapshot{
+      .header = snapshot.header,
+      .write =
+        [data = std::move(snapshot.data)](
+          ss::output_stream<char>& out) mutable {
+            return write_iobuf_to_output_stream(std::move(data), out);
+        }};
+}
+
+ss::future<> persisted_stm::do_make_snapshot() {
+    auto snapshot = co_await take_streaming_snapshot();
     auto offset = snapshot.header.offset;
 
     co_await persist_snapshot(std::move(snapshot));
@@ -24,6 +24,8 @@
 #include "utils/expiring_promise.h"
 #include "utils/mutex.h"
 
+#include <seastar/util/noncopyable_function.hh>
+
 #include <absl/container/flat_hash_map.h>
 
 namespace cluster {
@@ -39,6 +41,14 @@ struct stm_snapshot {
     iobuf data;
 };
 
+/// \brief snapshot serialized while it's written, the data of
+/// header.snapshot_size bytes is written to the snapshot file by `write`
+/// piece by piece instead of being built in memory first
+struct stm_streaming_snapshot {
+    stm_snapshot_header header;
+    ss::noncopyable_function<ss::future<>(ss::output_stream<char>&)> write;
+};
+
 /**
  * persisted_stm is a base class for building ingestion time (*) state
  * machines. Ingestion time means a state machine doesn't need to
@@ -112,9 +122,12 @@ private:
 protected:
     virtual ss::future<> apply_snapshot(stm_snapshot_header, iobuf&&) = 0;
     virtual ss::future<stm_snapshot> take_snapshot() = 0;
+    /// a state machine with a large state overrides it to stream its
+    /// snapshot, by default it's the one taken by take_snapshot
+    virtual ss::future<stm_streaming_snapshot> take_streaming_snapshot();
     ss::future<std::optional<stm_snapshot>> load_snapshot();
     ss::future<> wait_for_snapshot_hydrated();
-    ss::future<> persist_snapshot(stm_snapshot&&);
+    ss::future<> persist_snapshot(stm_streaming_snapshot&&);
     ss::future<> do_make_snapshot();
 
     /*
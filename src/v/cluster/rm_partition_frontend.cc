@@ -25,10 +25,54 @@
 #include <seastar/core/coroutine.hh>
 
 #include <algorithm>
+#include <string_view>
+#include <type_traits>
 
 namespace cluster {
 using namespace std::chrono_literals;
 
+namespace {
+
+struct prepare_tx_traits {
+    using request_t = prepare_tx_request;
+    using reply_t = prepare_tx_reply;
+    using batch_request_t = prepare_tx_batch_request;
+    using batch_reply_t = prepare_tx_batch_reply;
+    static constexpr std::string_view name = "prepare tx";
+
+    static ss::future<result<rpc::client_context<reply_t>>> send(
+      tx_gateway_client_protocol& cp, request_t&& r, rpc::client_opts opts) {
+        return cp.prepare_tx(std::move(r), std::move(opts));
+    }
+    static ss::future<result<rpc::client_context<batch_reply_t>>> send_batch(
+      tx_gateway_client_protocol& cp,
+      batch_request_t&& r,
+      rpc::client_opts opts) {
+        return cp.prepare_tx_batch(std::move(r), std::move(opts));
+    }
+};
+
+struct commit_tx_traits {
+    using request_t = commit_tx_request;
+    using reply_t = commit_tx_reply;
+    using batch_request_t = commit_tx_batch_request;
+    using batch_reply_t = commit_tx_batch_reply;
+    static constexpr std::string_view name = "commit tx";
+
+    static ss::future<result<rpc::client_context<reply_t>>> send(
+      tx_gateway_client_protocol& cp, request_t&& r, rpc::client_opts opts) {
+        return cp.commit_tx(std::move(r), std::move(opts));
+    }
+    static ss::future<result<rpc::client_context<batch_reply_t>>> send_batch(
+      tx_gateway_client_protocol& cp,
+      batch_request_t&& r,
+      rpc::client_opts opts) {
+        return cp.commit_tx_batch(std::move(r), std::move(opts));
+    }
+};
+
+} // namespace
+
 rm_partition_frontend::rm_partition_frontend(
   ss::smp_service_group ssg,
   ss::sharded<cluster::partition_manager>& partition_manager,
@@ -50,6 +94,179 @@ rm_partition_frontend::rm_partition_frontend(
       config::shard_local_cfg().metadata_dissemination_retry_delay_ms.value()) {
 }
 
+ss::future<> rm_partition_frontend::stop() { return _gate.close(); }
+
+template<typename Traits>
+auto& rm_partition_frontend::queue_for() {
+    if constexpr (std::is_same_v<Traits, prepare_tx_traits>) {
+        return _prepare_queue;
+    } else {
+        return _commit_queue;
+    }
+}
+
+template<typename Traits>
+ss::future<typename Traits::reply_t> rm_partition_frontend::dispatch(
+  model::node_id leader, typename Traits::request_t request) {
+    auto& q = queue_for<Traits>();
+    if (q.batching_unsupported.contains(leader) || _gate.is_closed()) {
+        return send<Traits>(leader, std::move(request));
+    }
+
+    auto& pending = q.pending[leader];
+    pending.push_back({std::move(request), {}});
+    auto f = pending.back().reply.get_future();
+    if (pending.size() == 1) {
+        // the requests issued by other transactions until the reactor gets
+        // back to us are sent together
+        (void)ss::with_gate(_gate, [this, leader] {
+            return ss::later().then(
+              [this, leader] { return flush<Traits>(leader); });
+        }).handle_exception([leader](const std::exception_ptr& e) {
+            vlog(
+              clusterlog.warn,
+              "Error sending batched {} requests to {}: {}",
+              Traits::name,
+              leader,
+              e);
+        });
+    }
+    return f;
+}
+
+template<typename Traits>
+ss::future<> rm_partition_frontend::flush(model::node_id leader) {
+    using reply_t = typename Traits::reply_t;
+    using batch_reply_t = typename Traits::batch_reply_t;
+    auto& q = queue_for<Traits>();
+    auto it = q.pending.find(leader);
+    if (it == q.pending.end()) {
+        return ss::now();
+    }
+    auto pending = std::move(it->second);
+    q.pending.erase(it);
+
+    if (pending.size() == 1) {
+        auto& p = pending.front();
+        send<Traits>(leader, std::move(p.request)).forward_to(std::move(p.reply));
+        return ss::now();
+    }
+
+    // requests are kept to be sent one by one if the node doesn't support
+    // the batched rpc
+    typename Traits::batch_request_t batch;
+    batch.requests.reserve(pending.size());
+    auto timeout = model::timeout_clock::duration::min();
+    for (auto& p : pending) {
+        timeout = std::max(timeout, p.request.timeout);
+        batch.requests.push_back(p.request);
+    }
+
+    return _connection_cache.local()
+      .with_node_client<cluster::tx_gateway_client_protocol>(
+        _controller->self(),
+        ss::this_shard_id(),
+        leader,
+        timeout,
+        [batch = std::move(batch),
+         timeout](tx_gateway_client_protocol cp) mutable {
+            return Traits::send_batch(
+              cp,
+              std::move(batch),
+              rpc::client_opts(model::timeout_clock::now() + timeout));
+        })
+      .then(&rpc::get_ctx_data<batch_reply_t>)
+      .then_wrapped([this, leader, pending = std::move(pending)](
+                      ss::future<result<batch_reply_t>> f) mutable {
+          auto fail_all = [&pending] {
+              for (auto& p : pending) {
+                  p.reply.set_value(reply_t{.ec = tx_errc::timeout});
+              }
+          };
+          if (f.failed()) {
+              vlog(
+                clusterlog.warn,
+                "got error {} on remote batched {}",
+                f.get_exception(),
+                Traits::name);
+              fail_all();
+              return;
+          }
+          auto r = f.get0();
+          if (r.has_error()) {
+              if (r.error() == rpc::errc::method_not_found) {
+                  vlog(
+                    clusterlog.info,
+                    "node {} does not support batched {} requests, sending "
+                    "them one by one",
+                    leader,
+                    Traits::name);
+                  queue_for<Traits>().batching_unsupported.insert(leader);
+                  for (auto& p : pending) {
+                      send<Traits>(leader, std::move(p.request))
+                        .forward_to(std::move(p.reply));
+                  }
+                  return;
+              }
+              vlog(
+                clusterlog.warn,
+                "got error {} on remote batched {}",
+                r.error(),
+                Traits::name);
+              fail_all();
+              return;
+          }
+          auto& replies = r.value().replies;
+          if (replies.size() != pending.size()) {
+              vlog(
+                clusterlog.warn,
+                "received {} batched {} replies from {}, expected {}",
+                replies.size(),
+                Traits::name,
+                leader,
+                pending.size());
+              fail_all();
+              return;
+          }
+          for (size_t i = 0; i < pending.size(); ++i) {
+              pending[i].reply.set_value(replies[i]);
+          }
+      });
+}
+
+template<typename Traits>
+ss::future<typename Traits::reply_t> rm_partition_frontend::send(
+  model::node_id leader, typename Traits::request_t request) {
+    using reply_t = typename Traits::reply_t;
+    auto timeout = request.timeout;
+    return _connection_cache.local()
+      .with_node_client<cluster::tx_gateway_client_protocol>(
+        _controller->self(),
+        ss::this_shard_id(),
+        leader,
+        timeout,
+        [request = std::move(request),
+         timeout](tx_gateway_client_protocol cp) mutable {
+            return Traits::send(
+              cp,
+              std::move(request),
+              rpc::client_opts(model::timeout_clock::now() + timeout));
+        })
+      .then(&rpc::get_ctx_data<reply_t>)
+      .then([](result<reply_t> r) {
+          if (r.has_error()) {
+              vlog(
+                clusterlog.warn,
+                "got error {} on remote {}",
+                r.error(),
+                Traits::name);
+              return reply_t{.ec = tx_errc::timeout};
+          }
+
+          return r.value();
+      });
+}
+
 bool rm_partition_frontend::is_leader_of(const model::ntp& ntp) const {
     auto leader = _leaders.local().get_leader(ntp);
     if (!leader) {
@@ -324,47 +541,15 @@ ss::future<prepare_tx_reply> rm_partition_frontend::prepare_tx(
     vlog(
       clusterlog.trace, "dispatching prepare tx to {} from {}", leader, _self);
 
-    return dispatch_prepare_tx(
-      leader.value(), ntp, etag, tm, pid, tx_seq, timeout);
-}
-
-ss::future<prepare_tx_reply> rm_partition_frontend::dispatch_prepare_tx(
-  model::node_id leader,
-  model::ntp ntp,
-  model::term_id etag,
-  model::partition_id tm,
-  model::producer_identity pid,
-  model::tx_seq tx_seq,
-  model::timeout_clock::duration timeout) {
-    return _connection_cache.local()
-      .with_node_client<cluster::tx_gateway_client_protocol>(
-        _controller->self(),
-        ss::this_shard_id(),
-        leader,
-        timeout,
-        [ntp, etag, tm, pid, tx_seq, timeout](tx_gateway_client_protocol cp) {
-            return cp.prepare_tx(
-              prepare_tx_request{
-                .ntp = ntp,
-                .etag = etag,
-                .tm = tm,
-                .pid = pid,
-                .tx_seq = tx_seq,
-                .timeout = timeout},
-              rpc::client_opts(model::timeout_clock::now() + timeout));
-        })
-      .then(&rpc::get_ctx_data<prepare_tx_reply>)
-      .then([](result<prepare_tx_reply> r) {
-          if (r.has_error()) {
-              vlog(
-                clusterlog.warn,
-                "got error {} on remote prepare tx",
-                r.error());
-              return prepare_tx_reply{.ec = tx_errc::timeout};
-          }
-
-          return r.value();
-      });
+    return dispatch<prepare_tx_traits>(
+      leader.value(),
+      prepare_tx_request{
+        .ntp = std::move(ntp),
+        .etag = etag,
+        .tm = tm,
+        .pid = pid,
+        .tx_seq = tx_seq,
+        .timeout = timeout});
 }
 
 ss::future<prepare_tx_reply> rm_partition_frontend::do_prepare_tx(
@@ -424,6 +609,18 @@ ss::future<prepare_tx_reply> rm_partition_frontend::do_prepare_tx(
       });
 }
 
+ss::future<prepare_tx_batch_reply>
+rm_partition_frontend::do_prepare_tx_batch(prepare_tx_batch_request batch) {
+    std::vector<ss::future<prepare_tx_reply>> fs;
+    fs.reserve(batch.requests.size());
+    for (auto& r : batch.requests) {
+        fs.push_back(do_prepare_tx(
+          std::move(r.ntp), r.etag, r.tm, r.pid, r.tx_seq, r.timeout));
+    }
+    auto replies = co_await ss::when_all_succeed(fs.begin(), fs.end());
+    co_return prepare_tx_batch_reply{.replies = std::move(replies)};
+}
+
 ss::future<commit_tx_reply> rm_partition_frontend::commit_tx(
   model::ntp ntp,
   model::producer_identity pid,
@@ -452,37 +649,13 @@ ss::future<commit_tx_reply> rm_partition_frontend::commit_tx(
     vlog(
       clusterlog.trace, "dispatching commit tx to {} from {}", leader, _self);
 
-    return dispatch_commit_tx(leader.value(), ntp, pid, tx_seq, timeout);
-}
-
-ss::future<commit_tx_reply> rm_partition_frontend::dispatch_commit_tx(
-  model::node_id leader,
-  model::ntp ntp,
-  model::producer_identity pid,
-  model::tx_seq tx_seq,
-  model::timeout_clock::duration timeout) {
-    return _connection_cache.local()
-      .with_node_client<cluster::tx_gateway_client_protocol>(
-        _controller->self(),
-        ss::this_shard_id(),
-        leader,
-        timeout,
-        [ntp, pid, tx_seq, timeout](tx_gateway_client_protocol cp) {
-            return cp.commit_tx(
-              commit_tx_request{
-                .ntp = ntp, .pid = pid, .tx_seq = tx_seq, .timeout = timeout},
-              rpc::client_opts(model::timeout_clock::now() + timeout));
-        })
-      .then(&rpc::get_ctx_data<commit_tx_reply>)
-      .then([](result<commit_tx_reply> r) {
-          if (r.has_error()) {
-              vlog(
-                clusterlog.warn, "got error {} on remote commit tx", r.error());
-              return commit_tx_reply{.ec = tx_errc::timeout};
-          }
-
-          return r.value();
-      });
+    return dispatch<commit_tx_traits>(
+      leader.value(),
+      commit_tx_request{
+        .ntp = std::move(ntp),
+        .pid = pid,
+        .tx_seq = tx_seq,
+        .timeout = timeout});
 }
 
 ss::future<commit_tx_reply> rm_partition_frontend::do_commit_tx(
@@ -537,6 +710,18 @@ ss::future<commit_tx_reply> rm_partition_frontend::do_commit_tx(
       });
 }
 
+ss::future<commit_tx_batch_reply>
+rm_partition_frontend::do_commit_tx_batch(commit_tx_batch_request batch) {
+    std::vector<ss::future<commit_tx_reply>> fs;
+    fs.reserve(batch.requests.size());
+    for (auto& r : batch.requests) {
+        fs.push_back(
+          do_commit_tx(std::move(r.ntp), r.pid, r.tx_seq, r.timeout));
+    }
+    auto replies = co_await ss::when_all_succeed(fs.begin(), fs.end());
+    co_return commit_tx_batch_reply{.replies = std::move(replies)};
+}
+
 ss::future<abort_tx_reply> rm_partition_frontend::abort_tx(
   model::ntp ntp,
   model::producer_identity pid,
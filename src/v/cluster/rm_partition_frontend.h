@@ -17,8 +17,23 @@
 #include "rpc/fwd.h"
 #include "seastarx.h"
 
+#include <seastar/core/gate.hh>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+
+#include <vector>
+
 namespace cluster {
 
+/**
+ * Prepare and commit requests for partitions led by other nodes are queued
+ * per node until the tasks already scheduled on the reactor ran, then sent
+ * together in a single prepare_tx_batch or commit_tx_batch RPC, so a
+ * coordinator running many short transactions issues one RPC per node
+ * instead of one per transaction and partition. Nodes that do not support
+ * the batched RPCs are remembered and served with plain requests.
+ */
 class rm_partition_frontend {
 public:
     rm_partition_frontend(
@@ -54,7 +69,24 @@ public:
       model::tx_seq,
       model::timeout_clock::duration);
 
+    ss::future<> stop();
+
 private:
+    template<typename Request, typename Reply>
+    struct pending_tx_request {
+        Request request;
+        ss::promise<Reply> reply;
+    };
+    template<typename Request, typename Reply>
+    using pending_t = std::vector<pending_tx_request<Request, Reply>>;
+
+    /// remote requests of a single kind queued per node
+    template<typename Request, typename Reply>
+    struct tx_request_queue {
+        absl::flat_hash_map<model::node_id, pending_t<Request, Reply>> pending;
+        absl::flat_hash_set<model::node_id> batching_unsupported;
+    };
+
     ss::smp_service_group _ssg;
     ss::sharded<cluster::partition_manager>& _partition_manager;
     ss::sharded<cluster::shard_table>& _shard_table;
@@ -64,6 +96,9 @@ private:
     cluster::controller* _controller;
     int16_t _metadata_dissemination_retries;
     std::chrono::milliseconds _metadata_dissemination_retry_delay_ms;
+    tx_request_queue<prepare_tx_request, prepare_tx_reply> _prepare_queue;
+    tx_request_queue<commit_tx_request, commit_tx_reply> _commit_queue;
+    ss::gate _gate;
 
     bool is_leader_of(const model::ntp&) const;
 
@@ -79,14 +114,6 @@ private:
       model::producer_identity,
       model::tx_seq,
       std::chrono::milliseconds);
-    ss::future<prepare_tx_reply> dispatch_prepare_tx(
-      model::node_id,
-      model::ntp,
-      model::term_id,
-      model::partition_id,
-      model::producer_identity,
-      model::tx_seq,
-      model::timeout_clock::duration);
     ss::future<prepare_tx_reply> do_prepare_tx(
       model::ntp,
       model::term_id,
@@ -94,17 +121,27 @@ private:
       model::producer_identity,
       model::tx_seq,
       model::timeout_clock::duration);
-    ss::future<commit_tx_reply> dispatch_commit_tx(
-      model::node_id,
-      model::ntp,
-      model::producer_identity,
-      model::tx_seq,
-      model::timeout_clock::duration);
     ss::future<commit_tx_reply> do_commit_tx(
       model::ntp,
       model::producer_identity,
       model::tx_seq,
       model::timeout_clock::duration);
+    ss::future<prepare_tx_batch_reply>
+      do_prepare_tx_batch(prepare_tx_batch_request);
+    ss::future<commit_tx_batch_reply>
+      do_commit_tx_batch(commit_tx_batch_request);
+
+    template<typename Traits>
+    ss::future<typename Traits::reply_t>
+      dispatch(model::node_id, typename Traits::request_t);
+    template<typename Traits>
+    ss::future<> flush(model::node_id);
+    template<typename Traits>
+    ss::future<typename Traits::reply_t>
+      send(model::node_id, typename Traits::request_t);
+    template<typename Traits>
+    auto& queue_for();
+
     ss::future<abort_tx_reply> dispatch_abort_tx(
       model::node_id,
       model::ntp,
@@ -19,10 +19,13 @@
 #include "raft/types.h"
 #include "storage/parser_utils.h"
 #include "storage/record_batch_builder.h"
+#include "units.h"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/preempt.hh>
 
+#include <algorithm>
 #include <filesystem>
 #include <optional>
 
@@ -34,6 +37,8 @@ static const model::violation_recovery_policy crash{
 static const model::violation_recovery_policy best_effort{
   model::violation_recovery_policy::best_effort};
 
+static constexpr size_t tx_snapshot_chunk_size = 128_KiB;
+
 static bool is_sequence(int32_t last_seq, int32_t next_seq) {
     return (last_seq + 1 == next_seq)
            || (next_seq == 0 && last_seq == std::numeric_limits<int32_t>::max());
@@ -169,17 +174,20 @@ rm_stm::rm_stm(
   raft::consensus* c,
   ss::sharded<cluster::tx_gateway_frontend>& tx_gateway_frontend)
   : persisted_stm("tx.snapshot", logger, c)
-  , _oldest_session(model::timestamp::now())
   , _sync_timeout(config::shard_local_cfg().rm_sync_timeout_ms.value())
   , _tx_timeout_delay(config::shard_local_cfg().tx_timeout_delay_ms.value())
   , _abort_interval_ms(config::shard_local_cfg()
                          .abort_timed_out_transactions_interval_ms.value())
   , _abort_index_segment_size(
       config::shard_local_cfg().abort_index_segment_size.value())
+  , _abort_index_cache_size(
+      config::shard_local_cfg().abort_index_cache_size.value())
   , _recovery_policy(
       config::shard_local_cfg().rm_violation_recovery_policy.value())
   , _transactional_id_expiration(
       config::shard_local_cfg().transactional_id_expiration_ms.value())
+  , _max_concurrent_producer_ids(
+      config::shard_local_cfg().max_concurrent_producer_ids.value())
   , _is_tx_enabled(config::shard_local_cfg().enable_transactions.value())
   , _tx_gateway_frontend(tx_gateway_frontend)
   , _abort_snapshot_mgr(
@@ -655,28 +663,17 @@ ss::future<> rm_stm::stop() {
 
 bool rm_stm::check_seq(model::batch_identity bid) {
     auto pid_seq = _log_state.seq_table.find(bid.pid);
-    auto last_write_timestamp = model::timestamp::now().value();
-    if (pid_seq == _log_state.seq_table.end()) {
+    if (pid_seq == nullptr) {
         if (bid.first_seq != 0) {
             return false;
         }
-        seq_entry entry{
-          .pid = bid.pid,
-          .seq = bid.last_seq,
-          .last_write_timestamp = last_write_timestamp};
-        _oldest_session = std::min(
-          _oldest_session, model::timestamp(entry.last_write_timestamp));
-        _log_state.seq_table.emplace(entry.pid, entry);
-    } else {
-        if (!is_sequence(pid_seq->second.seq, bid.first_seq)) {
-            return false;
-        }
-        pid_seq->second.seq = bid.last_seq;
-        pid_seq->second.last_write_timestamp = last_write_timestamp;
-        _oldest_session = std::min(
-          _oldest_session,
-          model::timestamp(pid_seq->second.last_write_timestamp));
+    } else if (!is_sequence(pid_seq->seq, bid.first_seq)) {
+        return false;
     }
+    _log_state.seq_table.write(seq_entry{
+      .pid = bid.pid,
+      .seq = bid.last_seq,
+      .last_write_timestamp = model::timestamp::now().value()});
     return true;
 }
 
@@ -825,21 +822,17 @@ rm_stm::aborted_transactions(model::offset from, model::offset to) {
     if (!_is_tx_enabled) {
         co_return result;
     }
-    for (auto& idx : _log_state.abort_indexes) {
-        if (idx.last < from) {
-            continue;
-        }
-        if (idx.first > to) {
+    // the segments are copied, new ones may be added while we are loading
+    auto indexes = _log_state.abort_indexes.intersecting(from, to);
+    for (auto& idx : indexes) {
+        if (auto cached = cached_abort_snapshot(idx)) {
+            filter_intersecting(result, cached->aborted, from, to);
             continue;
         }
-        std::optional<abort_snapshot> opt;
-        if (_log_state.last_abort_snapshot.match(idx)) {
-            opt = _log_state.last_abort_snapshot;
-        } else {
-            opt = co_await load_abort_snapshot(idx);
-        }
+        auto opt = co_await load_abort_snapshot(idx);
         if (opt) {
             filter_intersecting(result, opt->aborted, from, to);
+            cache_abort_snapshot(std::move(*opt));
         }
     }
 
@@ -851,22 +844,28 @@ rm_stm::aborted_transactions(model::offset from, model::offset to) {
 void rm_stm::compact_snapshot() {
     auto cutoff_timestamp = model::timestamp::now().value()
                             - _transactional_id_expiration.count();
-    if (cutoff_timestamp <= _oldest_session.value()) {
-        return;
-    }
-    auto next_oldest_session = model::timestamp::now();
-    for (auto it = _log_state.seq_table.cbegin();
-         it != _log_state.seq_table.cend();) {
-        if (it->second.last_write_timestamp < cutoff_timestamp) {
-            _log_state.seq_table.erase(it++);
-        } else {
-            next_oldest_session = std::min(
-              next_oldest_session,
-              model::timestamp(it->second.last_write_timestamp));
-            ++it;
-        }
+    _log_state.seq_table.evict(cutoff_timestamp, _max_concurrent_producer_ids);
+}
+
+void rm_stm::producer_seq_table::write(const seq_entry& entry) {
+    auto [it, _] = _entries.try_emplace(entry.pid);
+    auto& n = it->second;
+    n.entry = entry;
+    n.hook.unlink();
+    _lru.push_back(n);
+}
+
+void rm_stm::producer_seq_table::evict(
+  model::timestamp::type cutoff, size_t capacity) {
+    // writes usually come in timestamp order, a producer written out of order
+    // only delays the expiration of the ones written after it
+    while (!_lru.empty()
+           && (_entries.size() > capacity
+               || _lru.front().entry.last_write_timestamp < cutoff)) {
+        auto pid = _lru.front().entry.pid;
+        _lru.pop_front();
+        _entries.erase(pid);
     }
-    _oldest_session = next_oldest_session;
 }
 
 ss::future<bool> rm_stm::sync(model::timeout_clock::duration timeout) {
@@ -1157,18 +1156,11 @@ ss::future<> rm_stm::apply_control(
 void rm_stm::apply_data(model::batch_identity bid, model::offset last_offset) {
     if (bid.has_idempotent()) {
         auto pid_seq = _log_state.seq_table.find(bid.pid);
-        if (pid_seq == _log_state.seq_table.end()) {
-            seq_entry entry{
+        if (pid_seq == nullptr || pid_seq->seq < bid.last_seq) {
+            _log_state.seq_table.write(seq_entry{
               .pid = bid.pid,
               .seq = bid.last_seq,
-              .last_write_timestamp = bid.max_timestamp.value()};
-            _log_state.seq_table.emplace(bid.pid, entry);
-            _oldest_session = std::min(
-              _oldest_session, model::timestamp(entry.last_write_timestamp));
-        } else if (pid_seq->second.seq < bid.last_seq) {
-            pid_seq->second.seq = bid.last_seq;
-            pid_seq->second.last_write_timestamp = bid.max_timestamp.value();
-            _oldest_session = std::min(_oldest_session, bid.max_timestamp);
+              .last_write_timestamp = bid.max_timestamp.value()});
         }
     }
 
@@ -1230,19 +1222,19 @@ rm_stm::apply_snapshot(stm_snapshot_header hdr, iobuf&& tx_ss_buf) {
       _log_state.aborted.end(),
       std::make_move_iterator(data.aborted.begin()),
       std::make_move_iterator(data.aborted.end()));
-    _log_state.abort_indexes.insert(
-      _log_state.abort_indexes.end(),
-      std::make_move_iterator(data.abort_indexes.begin()),
-      std::make_move_iterator(data.abort_indexes.end()));
+    for (auto& entry : data.abort_indexes) {
+        _log_state.abort_indexes.add(entry);
+    }
+    // the snapshot lists the producers from the least recently written one
     for (auto& entry : data.seqs) {
-        auto [seq_it, _] = _log_state.seq_table.try_emplace(entry.pid, entry);
-        if (seq_it->second.seq < entry.seq) {
-            seq_it->second = entry;
+        auto pid_seq = _log_state.seq_table.find(entry.pid);
+        if (pid_seq == nullptr || pid_seq->seq < entry.seq) {
+            _log_state.seq_table.write(entry);
         }
     }
 
     abort_index last{.last = model::offset(-1)};
-    for (auto& entry : _log_state.abort_indexes) {
+    for (auto& entry : _log_state.abort_indexes.segments()) {
         if (entry.last > last.last) {
             last = entry;
         }
@@ -1250,7 +1242,7 @@ rm_stm::apply_snapshot(stm_snapshot_header hdr, iobuf&& tx_ss_buf) {
     if (last.last > model::offset(0)) {
         auto snapshot_opt = co_await load_abort_snapshot(last);
         if (snapshot_opt) {
-            _log_state.last_abort_snapshot = snapshot_opt.value();
+            cache_abort_snapshot(std::move(*snapshot_opt));
         }
     }
 
@@ -1258,7 +1250,78 @@ rm_stm::apply_snapshot(stm_snapshot_header hdr, iobuf&& tx_ss_buf) {
     _insync_offset = data.offset;
 }
 
-ss::future<stm_snapshot> rm_stm::take_snapshot() {
+/// serialized size of the entries of the tx snapshot, they're fixed size
+template<typename T>
+static size_t adl_size() {
+    static const size_t size = [] {
+        iobuf buf;
+        reflection::adl<T>{}.to(buf, T{});
+        return buf.size_bytes();
+    }();
+    return size;
+}
+
+template<typename T>
+static size_t adl_size(const std::vector<T>& v) {
+    return sizeof(int32_t) + v.size() * adl_size<T>();
+}
+
+static ss::future<> maybe_yield() {
+    return ss::need_preempt() ? ss::later() : ss::now();
+}
+
+/// writes the vector as adl does, in chunks of about
+/// tx_snapshot_chunk_size bytes with a preemption point in between
+template<typename T>
+static ss::future<size_t>
+write_vector(const std::vector<T>& v, ss::output_stream<char>& out) {
+    size_t written = 0;
+    iobuf buf;
+    reflection::adl<int32_t>{}.to(buf, int32_t(v.size()));
+    for (const auto& entry : v) {
+        reflection::adl<T>{}.to(buf, entry);
+        if (buf.size_bytes() >= tx_snapshot_chunk_size) {
+            written += buf.size_bytes();
+            co_await write_iobuf_to_output_stream(std::exchange(buf, {}), out);
+            co_await maybe_yield();
+        }
+    }
+    written += buf.size_bytes();
+    co_await write_iobuf_to_output_stream(std::move(buf), out);
+    co_return written;
+}
+
+size_t rm_stm::serialized_size(const tx_snapshot& tx_ss) {
+    return adl_size(tx_ss.fenced) + adl_size(tx_ss.ongoing)
+           + adl_size(tx_ss.prepared) + adl_size(tx_ss.aborted)
+           + adl_size(tx_ss.abort_indexes) + adl_size<model::offset>()
+           + adl_size(tx_ss.seqs);
+}
+
+ss::future<> rm_stm::write_tx_snapshot(
+  tx_snapshot tx_ss, size_t size, ss::output_stream<char>& out) {
+    size_t written = 0;
+    written += co_await write_vector(tx_ss.fenced, out);
+    written += co_await write_vector(tx_ss.ongoing, out);
+    written += co_await write_vector(tx_ss.prepared, out);
+    written += co_await write_vector(tx_ss.aborted, out);
+    written += co_await write_vector(tx_ss.abort_indexes, out);
+    iobuf offset_buf;
+    reflection::adl<model::offset>{}.to(offset_buf, tx_ss.offset);
+    written += offset_buf.size_bytes();
+    co_await write_iobuf_to_output_stream(std::move(offset_buf), out);
+    written += co_await write_vector(tx_ss.seqs, out);
+    if (written != size) {
+        // the snapshot is left unfinished
+        throw std::runtime_error(fmt::format(
+          "tx snapshot at offset {} has {} bytes, expected {}",
+          tx_ss.offset,
+          written,
+          size));
+    }
+}
+
+ss::future<stm_streaming_snapshot> rm_stm::take_streaming_snapshot() {
     if (_log_state.aborted.size() > _abort_index_segment_size) {
         std::sort(
           std::begin(_log_state.aborted),
@@ -1274,8 +1337,9 @@ ss::future<stm_snapshot> rm_stm::take_snapshot() {
             if (snapshot.aborted.size() == _abort_index_segment_size) {
                 auto idx = abort_index{
                   .first = snapshot.first, .last = snapshot.last};
-                _log_state.abort_indexes.push_back(idx);
+                _log_state.abort_indexes.add(idx);
                 co_await save_abort_snapshot(snapshot);
+                cache_abort_snapshot(std::move(snapshot));
                 snapshot = abort_snapshot{
                   .first = model::offset::max(), .last = model::offset::min()};
             }
@@ -1298,25 +1362,35 @@ ss::future<stm_snapshot> rm_stm::take_snapshot() {
     for (auto& entry : _log_state.aborted) {
         tx_ss.aborted.push_back(entry);
     }
-    for (auto& entry : _log_state.abort_indexes) {
+    for (auto& entry : _log_state.abort_indexes.segments()) {
         tx_ss.abort_indexes.push_back(entry);
     }
-    for (auto& entry : _log_state.seq_table) {
-        tx_ss.seqs.push_back(entry.second);
-    }
+    tx_ss.seqs.reserve(_log_state.seq_table.size());
+    _log_state.seq_table.for_each(
+      [&tx_ss](const seq_entry& entry) { tx_ss.seqs.push_back(entry); });
     tx_ss.offset = _insync_offset;
 
-    iobuf tx_ss_buf;
-    reflection::adl<tx_snapshot>{}.to(tx_ss_buf, tx_ss);
-
     stm_snapshot_header header;
     header.version = tx_snapshot_version;
-    header.snapshot_size = tx_ss_buf.size_bytes();
+    header.snapshot_size = serialized_size(tx_ss);
     header.offset = _insync_offset;
 
+    co_return stm_streaming_snapshot{
+      .header = header,
+      .write =
+        [tx_ss = std::move(tx_ss), size = header.snapshot_size](
+          ss::output_stream<char>& out) mutable {
+            return write_tx_snapshot(std::move(tx_ss), size, out);
+        }};
+}
+
+ss::future<stm_snapshot> rm_stm::take_snapshot() {
+    auto snapshot = co_await take_streaming_snapshot();
     stm_snapshot stx_ss;
-    stx_ss.header = header;
-    stx_ss.data = std::move(tx_ss_buf);
+    stx_ss.header = snapshot.header;
+    auto out = make_iobuf_ref_output_stream(stx_ss.data);
+    co_await snapshot.write(out);
+    co_await out.close();
     co_return stx_ss;
 }
 
@@ -1338,6 +1412,77 @@ ss::future<> rm_stm::save_abort_snapshot(abort_snapshot snapshot) {
     co_await _abort_snapshot_mgr.finish_snapshot(writer);
 }
 
+void rm_stm::abort_index_tree::add(abort_index idx) {
+    auto it = std::upper_bound(
+      _segments.begin(),
+      _segments.end(),
+      idx,
+      [](const abort_index& a, const abort_index& b) {
+          return a.first < b.first;
+      });
+    auto pos = std::distance(_segments.begin(), it);
+    _segments.insert(it, idx);
+    // segments are usually added in order, only the tail has to be updated
+    _max_last.resize(_segments.size());
+    for (auto i = static_cast<size_t>(pos); i < _segments.size(); ++i) {
+        auto prev = i == 0 ? model::offset::min() : _max_last[i - 1];
+        _max_last[i] = std::max(prev, _segments[i].last);
+    }
+}
+
+std::vector<rm_stm::abort_index> rm_stm::abort_index_tree::intersecting(
+  model::offset from, model::offset to) const {
+    std::vector<abort_index> result;
+    // segments before the first one with max_last >= from end before `from`
+    auto it = std::lower_bound(_max_last.begin(), _max_last.end(), from);
+    for (auto i = std::distance(_max_last.begin(), it);
+         i < static_cast<int64_t>(_segments.size());
+         ++i) {
+        const auto& idx = _segments[i];
+        if (idx.first > to) {
+            break;
+        }
+        if (idx.last >= from) {
+            result.push_back(idx);
+        }
+    }
+    return result;
+}
+
+// the cache holds a handful of segments, a linear scan is cheaper than
+// maintaining an index
+const rm_stm::abort_snapshot* rm_stm::cached_abort_snapshot(abort_index idx) {
+    auto it = std::find_if(
+      _abort_snapshot_cache.begin(),
+      _abort_snapshot_cache.end(),
+      [idx](const abort_snapshot& s) { return s.match(idx); });
+    if (it == _abort_snapshot_cache.end()) {
+        return nullptr;
+    }
+    _abort_snapshot_cache.splice(
+      _abort_snapshot_cache.begin(), _abort_snapshot_cache, it);
+    return &_abort_snapshot_cache.front();
+}
+
+void rm_stm::cache_abort_snapshot(abort_snapshot snapshot) {
+    if (_abort_index_cache_size == 0) {
+        return;
+    }
+    auto it = std::find_if(
+      _abort_snapshot_cache.begin(),
+      _abort_snapshot_cache.end(),
+      [&snapshot](const abort_snapshot& s) {
+          return s.first == snapshot.first && s.last == snapshot.last;
+      });
+    if (it != _abort_snapshot_cache.end()) {
+        _abort_snapshot_cache.erase(it);
+    }
+    _abort_snapshot_cache.push_front(std::move(snapshot));
+    while (_abort_snapshot_cache.size() > _abort_index_cache_size) {
+        _abort_snapshot_cache.pop_back();
+    }
+}
+
 ss::future<std::optional<rm_stm::abort_snapshot>>
 rm_stm::load_abort_snapshot(abort_index index) {
     auto filename = fmt::format("abort.idx.{}.{}", index.first, index.last);
@@ -1380,6 +1525,7 @@ ss::future<> rm_stm::handle_eviction() {
       [this]([[maybe_unused]] ss::basic_rwlock<>::holder unit) {
           _log_state = {};
           _mem_state = {};
+          _abort_snapshot_cache.clear();
           set_next(_c->start_offset());
           return ss::now();
       });
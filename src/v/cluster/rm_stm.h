@@ -24,10 +24,14 @@
 #include "raft/types.h"
 #include "storage/snapshot.h"
 #include "utils/expiring_promise.h"
+#include "utils/intrusive_list_helpers.h"
 #include "utils/mutex.h"
 
 #include <absl/container/btree_set.h>
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/node_hash_map.h>
+
+#include <list>
 
 namespace cluster {
 
@@ -76,6 +80,48 @@ public:
         model::timestamp::type last_write_timestamp;
     };
 
+    /**
+     * Sequence numbers of the idempotent producers of the partition, kept in
+     * the order of their last write. Short lived producers are expired from
+     * the least recently written end, in time proportional to the number of
+     * expired producers, and the table is capped so its memory stays flat
+     * under producer churn.
+     */
+    class producer_seq_table {
+    public:
+        const seq_entry* find(model::producer_identity pid) const {
+            auto it = _entries.find(pid);
+            return it == _entries.end() ? nullptr : &it->second.entry;
+        }
+
+        /// records a write of the producer, it becomes the most recent one
+        void write(const seq_entry&);
+
+        /// removes the producers not written since the cutoff and the least
+        /// recently written ones above the capacity
+        void evict(model::timestamp::type cutoff, size_t capacity);
+
+        size_t size() const { return _entries.size(); }
+
+        /// visits the producers from the least recently written one
+        template<typename Func>
+        void for_each(Func&& f) const {
+            for (const auto& n : _lru) {
+                f(n.entry);
+            }
+        }
+
+    private:
+        struct node {
+            seq_entry entry;
+            intrusive_list_hook hook;
+        };
+
+        // nodes are linked in the lru, their addresses must be stable
+        absl::node_hash_map<model::producer_identity, node> _entries;
+        intrusive_list<node, &node::hook> _lru;
+    };
+
     struct tx_snapshot {
         std::vector<model::producer_identity> fenced;
         std::vector<tx_range> ongoing;
@@ -91,11 +137,37 @@ public:
         model::offset last;
         std::vector<tx_range> aborted;
 
-        bool match(abort_index idx) {
+        bool match(abort_index idx) const {
             return idx.first == first && idx.last == last;
         }
     };
 
+    /**
+     * Abort index segments sorted by their first offset. Next to every
+     * segment we keep the highest last offset of the segments up to it, which
+     * is monotonic, so the first segment that may intersect a range is found
+     * with a binary search like in an augmented interval tree.
+     */
+    class abort_index_tree {
+    public:
+        void add(abort_index);
+        /// segments intersecting [from, to]
+        std::vector<abort_index>
+          intersecting(model::offset from, model::offset to) const;
+        const std::vector<abort_index>& segments() const { return _segments; }
+
+    private:
+        std::vector<abort_index> _segments;
+        std::vector<model::offset> _max_last;
+    };
+
+    /// size of the adl serialization of the snapshot
+    static size_t serialized_size(const tx_snapshot&);
+    /// writes the snapshot of \p size bytes as adl serializes it, in chunks
+    /// with preemption points in between
+    static ss::future<>
+    write_tx_snapshot(tx_snapshot, size_t size, ss::output_stream<char>&);
+
     static constexpr int8_t prepare_control_record_version{0};
     static constexpr int8_t fence_control_record_version{0};
 
@@ -150,8 +222,12 @@ private:
       model::producer_identity, model::tx_seq, model::timeout_clock::duration);
     ss::future<> apply_snapshot(stm_snapshot_header, iobuf&&) override;
     ss::future<stm_snapshot> take_snapshot() override;
+    /// the state is copied at once and serialized while it's written
+    ss::future<stm_streaming_snapshot> take_streaming_snapshot() override;
     ss::future<std::optional<abort_snapshot>> load_abort_snapshot(abort_index);
     ss::future<> save_abort_snapshot(abort_snapshot);
+    const abort_snapshot* cached_abort_snapshot(abort_index);
+    void cache_abort_snapshot(abort_snapshot);
 
     bool check_seq(model::batch_identity);
 
@@ -219,14 +295,13 @@ private:
         absl::btree_set<model::offset> ongoing_set;
         absl::flat_hash_map<model::producer_identity, prepare_marker> prepared;
         std::vector<tx_range> aborted;
-        std::vector<abort_index> abort_indexes;
-        abort_snapshot last_abort_snapshot{.last = model::offset(-1)};
+        abort_index_tree abort_indexes;
         // the only piece of data which we update on replay and before
         // replicating the command. we use the highest seq number to resolve
         // conflicts. if the replication fails we reject a command but clients
         // by spec should be ready for thier commands being rejected so it's
         // ok by design to have false rejects
-        absl::flat_hash_map<model::producer_identity, seq_entry> seq_table;
+        producer_seq_table seq_table;
     };
 
     struct expiration_info {
@@ -288,13 +363,16 @@ private:
     log_state _log_state;
     mem_state _mem_state;
     ss::timer<clock_type> auto_abort_timer;
-    model::timestamp _oldest_session;
     std::chrono::milliseconds _sync_timeout;
     std::chrono::milliseconds _tx_timeout_delay;
     std::chrono::milliseconds _abort_interval_ms;
     uint32_t _abort_index_segment_size;
+    // recently used abort index segments, most recent first
+    std::list<abort_snapshot> _abort_snapshot_cache;
+    uint32_t _abort_index_cache_size;
     model::violation_recovery_policy _recovery_policy;
     std::chrono::milliseconds _transactional_id_expiration;
+    size_t _max_concurrent_producer_ids;
     bool _is_autoabort_enabled{true};
     bool _is_autoabort_active{false};
     bool _is_tx_enabled{false};
@@ -25,10 +25,42 @@ allocation_node::allocation_node(
 }
 
 ss::shard_id allocation_node::allocate() {
-    auto it = std::min_element(_weights.begin(), _weights.end());
-    (*it)++; // increment the weights
+    ss::shard_id core = 0;
+    if (_load.size() != _weights.size()) {
+        auto it = std::min_element(_weights.begin(), _weights.end());
+        core = std::distance(_weights.begin(), it);
+    } else {
+        // the number of partitions of a core is scaled by its throughput
+        // relative to the node average, hot cores get fewer new partitions.
+        // Weights still grow with every allocation as the reported load is
+        // only updated periodically.
+        const auto avg = average_load().bytes_per_sec + 1;
+        auto cost = [this, avg](ss::shard_id c) {
+            return uint64_t(_weights[c]) * (avg + _load[c].bytes_per_sec);
+        };
+        for (ss::shard_id c = 1; c < _weights.size(); ++c) {
+            if (cost(c) < cost(core)) {
+                core = c;
+            }
+        }
+    }
+    _weights[core]++;
     _allocated_partitions++;
-    return std::distance(_weights.begin(), it);
+    return core;
+}
+
+core_load allocation_node::average_load() const {
+    if (_load.empty()) {
+        return core_load{};
+    }
+    core_load total;
+    for (const auto& l : _load) {
+        total.bytes_per_sec += l.bytes_per_sec;
+        total.disk_bytes += l.disk_bytes;
+    }
+    return core_load{
+      .bytes_per_sec = total.bytes_per_sec / _load.size(),
+      .disk_bytes = total.disk_bytes / _load.size()};
 }
 
 void allocation_node::deallocate(ss::shard_id core) {
@@ -96,7 +128,7 @@ std::ostream& operator<<(std::ostream& o, const allocation_node& n) {
     for (auto w : n._weights) {
         o << "(" << w << ")";
     }
-    return o << "]}";
+    return o << "], load: " << n.average_load() << "}";
 }
 
 } // namespace cluster
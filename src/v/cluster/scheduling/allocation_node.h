@@ -87,6 +87,11 @@ public:
     allocation_capacity max_capacity() const { return _max_capacity; }
     ss::shard_id allocate();
 
+    /// updates the load measured by the node, one entry per core
+    void update_load(std::vector<core_load> load) { _load = std::move(load); }
+    /// average load of the node cores, zero until the node reported its load
+    core_load average_load() const;
+
 private:
     friend allocation_state;
 
@@ -99,6 +104,8 @@ private:
     std::vector<uint32_t> _weights;
     allocation_capacity _max_capacity;
     allocation_capacity _allocated_partitions{0};
+    /// load of every core as last reported by the node
+    std::vector<core_load> _load;
     /// generated by `rpk` usually in /etc/redpanda/machine_labels.json
     absl::node_hash_map<ss::sstring, ss::sstring> _machine_labels;
     state _state = state::active;
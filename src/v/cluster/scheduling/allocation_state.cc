@@ -126,6 +126,27 @@ void allocation_state::decommission_node(model::node_id id) {
     it->second->decommission();
 }
 
+void allocation_state::update_node_load(
+  model::node_id id, std::vector<core_load> load) {
+    // load of nodes removed in the meantime is ignored
+    if (auto it = _nodes.find(id); it != _nodes.end()) {
+        it->second->update_load(std::move(load));
+    }
+}
+
+core_load allocation_state::max_core_load() const {
+    core_load max;
+    for (const auto& [_, n] : _nodes) {
+        if (!n->is_active()) {
+            continue;
+        }
+        auto l = n->average_load();
+        max.bytes_per_sec = std::max(max.bytes_per_sec, l.bytes_per_sec);
+        max.disk_bytes = std::max(max.disk_bytes, l.disk_bytes);
+    }
+    return max;
+}
+
 void allocation_state::recommission_node(model::node_id id) {
     auto it = _nodes.find(id);
     if (it == _nodes.end()) {
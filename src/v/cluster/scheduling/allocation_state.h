@@ -14,6 +14,8 @@
 #include "cluster/scheduling/allocation_node.h"
 #include "model/metadata.h"
 
+#include <algorithm>
+
 namespace cluster {
 /**
  * Partition allocator state
@@ -34,6 +36,9 @@ public:
     bool contains_node(model::node_id n) const { return _nodes.contains(n); }
     const underlying_t& allocation_nodes() const { return _nodes; }
     int16_t available_nodes() const;
+    void update_node_load(model::node_id, std::vector<core_load>);
+    /// highest average core load among the active nodes
+    core_load max_core_load() const;
 
     // Operations on state
     void deallocate(const model::broker_shard&);
@@ -48,6 +53,10 @@ public:
     // Raft group id
     raft::group_id next_group_id();
     raft::group_id last_group_id() const { return _highest_group; }
+    /// makes sure group ids up to `id` are never allocated
+    void update_highest_group_id(raft::group_id id) {
+        _highest_group = std::max(_highest_group, id);
+    }
 
 private:
     raft::group_id _highest_group{0};
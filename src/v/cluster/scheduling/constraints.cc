@@ -113,4 +113,42 @@ soft_constraint_evaluator least_allocated() {
     return soft_constraint_evaluator(std::make_unique<impl>());
 }
 
+soft_constraint_evaluator least_loaded(core_load max_core_load) {
+    class impl : public soft_constraint_evaluator::impl {
+    public:
+        explicit impl(core_load max)
+          : _max(max) {}
+
+        uint64_t score(const allocation_node& node) const final {
+            // throughput and disk usage contribute equally, nodes that did not
+            // report their load yet are considered idle
+            auto load = node.average_load();
+            return (free_share(load.bytes_per_sec, _max.bytes_per_sec)
+                    + free_share(load.disk_bytes, _max.disk_bytes))
+                   / 2;
+        }
+
+        void print(std::ostream& o) const final {
+            fmt::print(o, "least loaded node, max core load: {}", _max);
+        }
+
+    private:
+        static uint64_t free_share(uint64_t load, uint64_t max) {
+            if (max == 0) {
+                return soft_constraint_evaluator::max_score;
+            }
+            if (load >= max) {
+                return 0;
+            }
+            return static_cast<uint64_t>(
+              soft_constraint_evaluator::max_score
+              * (1.0 - static_cast<double>(load) / max));
+        }
+
+        core_load _max;
+    };
+
+    return soft_constraint_evaluator(std::make_unique<impl>(max_core_load));
+}
+
 } // namespace cluster
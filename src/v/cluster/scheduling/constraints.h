@@ -25,4 +25,8 @@ distinct_from(const std::vector<model::broker_shard>&);
 
 soft_constraint_evaluator least_allocated();
 
+/// prefers nodes with the lowest average core throughput and disk usage,
+/// relative to the most loaded node
+soft_constraint_evaluator least_loaded(core_load max_core_load);
+
 } // namespace cluster
@@ -10,11 +10,14 @@
  */
 #include "cluster/scheduling/leader_balancer.h"
 
+#include "cluster/health_manager.h"
 #include "cluster/logger.h"
 #include "cluster/partition_leaders_table.h"
 #include "cluster/scheduling/leader_balancer_greedy.h"
+#include "cluster/scheduling/leader_balancer_throughput.h"
 #include "cluster/shard_table.h"
 #include "cluster/topic_table.h"
+#include "config/configuration.h"
 #include "model/namespace.h"
 #include "random/generators.h"
 #include "rpc/types.h"
@@ -42,6 +45,7 @@ leader_balancer::leader_balancer(
   ss::sharded<shard_table>& shard_table,
   ss::sharded<partition_manager>& partition_manager,
   ss::sharded<raft::group_manager>& group_manager,
+  ss::sharded<health_manager>& health_manager,
   ss::sharded<ss::abort_source>& as,
   std::chrono::milliseconds idle_timeout,
   std::chrono::milliseconds mute_timeout,
@@ -56,6 +60,7 @@ leader_balancer::leader_balancer(
   , _shard_table(shard_table)
   , _partition_manager(partition_manager)
   , _group_manager(group_manager)
+  , _health_manager(health_manager)
   , _as(as)
   , _raft0(std::move(raft0))
   , _timer([this] { trigger_balance(); }) {
@@ -210,10 +215,10 @@ ss::future<ss::stop_iteration> leader_balancer::balance() {
      * (e.g. on average little should change between ticks) and bounding the
      * search for leader moves.
      */
-    greedy_balanced_shards strategy(build_index(), muted_nodes());
+    auto strategy = make_strategy();
 
     if (clusterlog.is_enabled(ss::log_level::trace)) {
-        auto cores = strategy.stats();
+        auto cores = strategy->stats();
         for (const auto& core : cores) {
             vlog(
               clusterlog.trace,
@@ -223,8 +228,8 @@ ss::future<ss::stop_iteration> leader_balancer::balance() {
         }
     }
 
-    auto error = strategy.error();
-    auto transfer = strategy.find_movement(muted_groups());
+    auto error = strategy->error();
+    auto transfer = strategy->find_movement(muted_groups());
     if (!transfer) {
         vlog(
           clusterlog.info,
@@ -239,6 +244,18 @@ ss::future<ss::stop_iteration> leader_balancer::balance() {
         co_return ss::stop_iteration::yes;
     }
 
+    if (transfers_exhausted()) {
+        vlog(
+          clusterlog.debug,
+          "Leadership balancer tick: transfer limit of {} per minute reached",
+          config::shard_local_cfg().leader_balancer_max_transfers_per_minute());
+        if (!_timer.armed()) {
+            _timer.arm(_transfers_window_start + transfers_window);
+        }
+        co_return ss::stop_iteration::yes;
+    }
+    ++_transfers_in_window;
+
     auto success = co_await do_transfer(*transfer);
     if (!success) {
         vlog(
@@ -353,6 +370,73 @@ ss::future<ss::stop_iteration> leader_balancer::balance() {
     co_return ss::stop_iteration::no;
 }
 
+std::unique_ptr<leader_balancer_strategy> leader_balancer::make_strategy() {
+    const auto& cfg = config::shard_local_cfg();
+    if (!cfg.leader_balancer_throughput_aware()) {
+        return std::make_unique<greedy_balanced_shards>(
+          build_index(), muted_nodes());
+    }
+    update_throughput();
+    return std::make_unique<throughput_balanced_shards>(
+      build_index(),
+      muted_nodes(),
+      _throughput,
+      cfg.leader_balancer_min_improvement_percent() / 100.0);
+}
+
+/*
+ * folds the partition throughput collected by the health manager since the
+ * last update into the moving average of every group. nodes only report their
+ * busiest partitions, the groups that are not reported decay towards idle.
+ */
+void leader_balancer::update_throughput() {
+    if (!_health_manager.local_is_initialized()) {
+        return;
+    }
+    const auto& hm = _health_manager.local();
+    if (hm.cluster_load_collected_at() <= _throughput_updated_at) {
+        return;
+    }
+    _throughput_updated_at = hm.cluster_load_collected_at();
+
+    // every replica writes the same bytes, take the highest measurement
+    absl::flat_hash_map<raft::group_id, double> current;
+    for (const auto& [id, report] : hm.cluster_load()) {
+        for (const auto& p : report.partitions) {
+            auto assignment = _topics.get_partition_assignment(p.ntp);
+            if (!assignment) {
+                continue;
+            }
+            auto& tput = current[assignment->group];
+            tput = std::max(tput, static_cast<double>(p.bytes_per_sec));
+        }
+    }
+
+    const auto alpha
+      = config::shard_local_cfg().leader_balancer_throughput_ema_alpha();
+    for (auto& [group, tput] : _throughput) {
+        tput *= 1 - alpha;
+    }
+    for (const auto& [group, tput] : current) {
+        auto [it, inserted] = _throughput.try_emplace(group, tput);
+        if (!inserted) {
+            it->second += alpha * tput;
+        }
+    }
+    absl::erase_if(_throughput, [](const auto& e) { return e.second < 1; });
+}
+
+bool leader_balancer::transfers_exhausted() {
+    const auto now = clock_type::now();
+    if (now >= _transfers_window_start + transfers_window) {
+        _transfers_window_start = now;
+        _transfers_in_window = 0;
+    }
+    return _transfers_in_window
+           >= config::shard_local_cfg()
+                .leader_balancer_max_transfers_per_minute();
+}
+
 absl::flat_hash_set<model::node_id> leader_balancer::muted_nodes() const {
     absl::flat_hash_set<model::node_id> nodes;
     const auto now = raft::clock_type::now();
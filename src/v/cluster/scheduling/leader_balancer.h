@@ -9,6 +9,7 @@
  * by the Apache License, Version 2.0
  */
 #pragma once
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "cluster/partition_manager.h"
 #include "cluster/scheduling/leader_balancer_probe.h"
@@ -21,6 +22,8 @@
 #include <seastar/core/gate.hh>
 #include <seastar/core/timer.hh>
 
+#include <memory>
+
 using namespace std::chrono_literals;
 
 namespace cluster {
@@ -62,6 +65,12 @@ class leader_balancer {
      */
     static constexpr clock_type::duration leader_transfer_rpc_timeout = 30s;
 
+    /*
+     * window over which `leader_balancer_max_transfers_per_minute` is
+     * enforced.
+     */
+    static constexpr clock_type::duration transfers_window = 1min;
+
 public:
     leader_balancer(
       topic_table&,
@@ -70,6 +79,7 @@ public:
       ss::sharded<shard_table>&,
       ss::sharded<partition_manager>&,
       ss::sharded<raft::group_manager>&,
+      ss::sharded<health_manager>&,
       ss::sharded<ss::abort_source>&,
       std::chrono::milliseconds,
       std::chrono::milliseconds,
@@ -84,6 +94,9 @@ private:
     using reassignment = leader_balancer_strategy::reassignment;
 
     index_type build_index();
+    std::unique_ptr<leader_balancer_strategy> make_strategy();
+    void update_throughput();
+    bool transfers_exhausted();
     std::optional<model::broker_shard> find_leader_shard(const model::ntp&);
     absl::flat_hash_set<raft::group_id> muted_groups() const;
     absl::flat_hash_set<model::node_id> muted_nodes() const;
@@ -136,6 +149,16 @@ private:
     };
     absl::btree_map<raft::group_id, last_known_leader> _last_leader;
 
+    /*
+     * exponential moving average of the throughput of every group reported by
+     * the health manager, used by the throughput aware strategy.
+     */
+    absl::flat_hash_map<raft::group_id, double> _throughput;
+    clock_type::time_point _throughput_updated_at;
+
+    clock_type::time_point _transfers_window_start;
+    size_t _transfers_in_window{0};
+
     leader_balancer_probe _probe;
     bool _need_controller_refresh{true};
     absl::btree_map<raft::group_id, clock_type::time_point> _muted;
@@ -146,6 +169,7 @@ private:
     ss::sharded<shard_table>& _shard_table;
     ss::sharded<partition_manager>& _partition_manager;
     ss::sharded<raft::group_manager>& _group_manager;
+    ss::sharded<health_manager>& _health_manager;
     ss::sharded<ss::abort_source>& _as;
     consensus_ptr _raft0;
     ss::gate _gate;
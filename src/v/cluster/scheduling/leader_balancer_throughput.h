@@ -0,0 +1,201 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#pragma once
+
+#include "cluster/scheduling/leader_balancer_strategy.h"
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+/*
+ * Throughput balancer strategy moves leaders so that the load of the groups
+ * led by every core is even. Leaders serve the produce and fetch requests of
+ * their groups, so a core leading a few hot groups is more loaded than a core
+ * leading many idle ones.
+ *
+ * The load of a group is a fixed cost of leading the group plus its smoothed
+ * throughput. The fixed cost is the average group throughput (or one byte per
+ * second in an idle cluster) so that without throughput measurements the
+ * strategy balances the number of leaders like the greedy strategy does.
+ */
+namespace cluster {
+
+class throughput_balanced_shards final : public leader_balancer_strategy {
+public:
+    /*
+     * Smoothed throughput of the groups in bytes per second, groups missing
+     * from the map are idle.
+     */
+    using group_throughput = absl::flat_hash_map<raft::group_id, double>;
+
+    /*
+     * A leader is only moved between two cores when it reduces the difference
+     * between their loads by at least `min_improvement` times the average core
+     * load. This creates a dead band around the balanced state in which small
+     * throughput variations do not move leaders back and forth.
+     */
+    throughput_balanced_shards(
+      index_type cores,
+      absl::flat_hash_set<model::node_id> muted_nodes,
+      const group_throughput& throughput,
+      double min_improvement)
+      : _cores(std::move(cores))
+      , _muted_nodes(std::move(muted_nodes))
+      , _min_improvement(min_improvement) {
+        build_load(throughput);
+    }
+
+    double error() const final {
+        return std::accumulate(
+          _load.cbegin(),
+          _load.cend(),
+          double{0},
+          [this](auto acc, const auto& e) {
+              if (_muted_nodes.contains(e.first.node_id)) {
+                  return acc;
+              }
+              return acc + pow(e.second - _target_load, 2);
+          });
+    }
+
+    /*
+     * Find a group reassignment that moves load from the most loaded core to
+     * a less loaded core. For the most loaded core with a valid move the
+     * reassignment reducing the load difference the most is chosen, a group
+     * heavier than the difference is never moved as it would only swap the
+     * roles of the two cores.
+     *
+     * Muted nodes are treated as in the greedy strategy: no leadership is
+     * moved to or from them.
+     */
+    std::optional<reassignment>
+    find_movement(const absl::flat_hash_set<raft::group_id>& skip) const final {
+        std::vector<std::pair<model::broker_shard, double>> cores;
+        cores.reserve(_load.size());
+        for (const auto& e : _load) {
+            if (!_muted_nodes.contains(e.first.node_id)) {
+                cores.emplace_back(e);
+            }
+        }
+        std::sort(cores.begin(), cores.end(), [](const auto& a, const auto& b) {
+            return a.second < b.second;
+        });
+
+        const auto min_delta = _min_improvement * _target_load;
+        for (auto from = cores.crbegin(); from != cores.crend(); ++from) {
+            std::optional<reassignment> best;
+            double best_gain = 0;
+            for (const auto& to : cores) {
+                const auto delta = from->second - to.second;
+                /*
+                 * cores are sorted by load, a move can not reduce the
+                 * difference by more than the difference itself.
+                 */
+                if (delta <= min_delta) {
+                    break;
+                }
+                for (const auto& group : _cores.at(from->first)) {
+                    if (skip.contains(group.first)) {
+                        continue;
+                    }
+                    const auto it = std::find(
+                      group.second.cbegin(), group.second.cend(), to.first);
+                    if (it == group.second.cend()) {
+                        continue;
+                    }
+                    const auto gain = delta
+                                      - std::abs(
+                                        delta - 2 * group_load(group.first));
+                    if (gain > best_gain && gain >= min_delta) {
+                        best_gain = gain;
+                        best = reassignment{
+                          group.first, from->first, to.first};
+                    }
+                }
+            }
+            if (best) {
+                return best;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    std::vector<shard_load> stats() const final {
+        std::vector<shard_load> ret;
+        ret.reserve(_cores.size());
+        std::transform(
+          _cores.cbegin(),
+          _cores.cend(),
+          std::back_inserter(ret),
+          [](const auto& e) {
+              return shard_load{e.first, static_cast<size_t>(e.second.size())};
+          });
+        return ret;
+    }
+
+private:
+    double group_load(raft::group_id group) const {
+        auto it = _throughput.find(group);
+        return _group_cost + (it == _throughput.end() ? 0 : it->second);
+    }
+
+    void build_load(const group_throughput& throughput) {
+        size_t num_groups = 0;
+        double total_throughput = 0;
+        for (const auto& core : _cores) {
+            for (const auto& group : core.second) {
+                ++num_groups;
+                if (auto it = throughput.find(group.first);
+                    it != throughput.end()) {
+                    _throughput.emplace(*it);
+                    total_throughput += it->second;
+                }
+            }
+        }
+        _group_cost = num_groups == 0
+                        ? 1
+                        : std::max(1.0, total_throughput / num_groups);
+
+        /*
+         * as in the greedy strategy only leaders on non-muted nodes are
+         * accounted for when calculating the target load.
+         */
+        size_t num_cores = 0;
+        double total_load = 0;
+        for (const auto& core : _cores) {
+            double load = 0;
+            for (const auto& group : core.second) {
+                load += group_load(group.first);
+            }
+            _load.emplace(core.first, load);
+            if (!_muted_nodes.contains(core.first.node_id)) {
+                ++num_cores;
+                total_load += load;
+            }
+        }
+        _target_load = num_cores == 0 ? 0 : total_load / num_cores;
+    }
+
+    index_type _cores;
+    absl::flat_hash_set<model::node_id> _muted_nodes;
+    double _min_improvement;
+    group_throughput _throughput;
+    double _group_cost{1};
+    absl::flat_hash_map<model::broker_shard, double> _load;
+    double _target_load{0};
+};
+
+} // namespace cluster
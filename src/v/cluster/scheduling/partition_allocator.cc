@@ -28,7 +28,7 @@ partition_allocator::partition_allocator()
   : _state(std::make_unique<allocation_state>())
   , _allocation_strategy(simple_allocation_strategy()) {}
 
-allocation_constraints default_constraints() {
+allocation_constraints default_constraints(const allocation_state& state) {
     allocation_constraints req;
     req.hard_constraints.push_back(
       ss::make_lw_shared<hard_constraint_evaluator>(not_fully_allocated()));
@@ -36,6 +36,9 @@ allocation_constraints default_constraints() {
       ss::make_lw_shared<hard_constraint_evaluator>(is_active()));
     req.soft_constraints.push_back(
       ss::make_lw_shared<soft_constraint_evaluator>(least_allocated()));
+    req.soft_constraints.push_back(
+      ss::make_lw_shared<soft_constraint_evaluator>(
+        least_loaded(state.max_core_load())));
     return req;
 }
 
@@ -55,7 +58,7 @@ partition_allocator::allocate_partition(partition_constraints p_constraints) {
       *_state, p_constraints.replication_factor);
 
     for (auto r = 0; r < p_constraints.replication_factor; ++r) {
-        auto effective_constraits = default_constraints();
+        auto effective_constraits = default_constraints(*_state);
         effective_constraits.hard_constraints.push_back(
           ss::make_lw_shared<hard_constraint_evaluator>(
             distinct_from(replicas.get())));
@@ -98,6 +101,16 @@ partition_allocator::allocate(allocation_request request) {
     return allocation_units(std::move(assignments).finish(), _state.get());
 }
 
+std::vector<result<allocation_units>>
+partition_allocator::allocate(std::vector<allocation_request> requests) {
+    std::vector<result<allocation_units>> ret;
+    ret.reserve(requests.size());
+    for (auto& r : requests) {
+        ret.push_back(allocate(std::move(r)));
+    }
+    return ret;
+}
+
 result<std::vector<model::broker_shard>>
 partition_allocator::do_reallocate_partition(
   partition_constraints p_constraints,
@@ -160,7 +173,7 @@ result<allocation_units> partition_allocator::reassign_decommissioned_replicas(
                || it->second->is_decommissioned();
     });
 
-    auto req = default_constraints();
+    auto req = default_constraints(*_state);
     req.hard_constraints.push_back(
       ss::make_lw_shared<hard_constraint_evaluator>(
         distinct_from(current_replicas)));
@@ -34,6 +34,11 @@ public:
     }
     void decommission_node(model::node_id id) { _state->decommission_node(id); }
     void recommission_node(model::node_id id) { _state->recommission_node(id); }
+    /// updates the load measured by the node, used to place new replicas on
+    /// the least loaded nodes and cores
+    void update_node_load(model::node_id id, std::vector<core_load> load) {
+        _state->update_node_load(id, std::move(load));
+    }
 
     bool is_empty(model::node_id id) const { return _state->is_empty(id); }
     bool contains_node(model::node_id n) const {
@@ -42,6 +47,12 @@ public:
 
     result<allocation_units> allocate(allocation_request);
 
+    /// Allocates the requests one after the other, every allocation accounts
+    /// for the replicas placed by the previous ones. Used to create many
+    /// topics at once without a round trip to the allocator shard for each.
+    std::vector<result<allocation_units>>
+      allocate(std::vector<allocation_request>);
+
     /// Realocates partition replicas, moving them away from decommissioned
     /// nodes. Replicas on nodes that were left untouched are not changed.
     ///
@@ -11,8 +11,11 @@
 #include "cluster/security_manager.h"
 
 #include "cluster/commands.h"
+#include "cluster/logger.h"
 #include "model/metadata.h"
 #include "raft/types.h"
+#include "reflection/adl.h"
+#include "vlog.h"
 
 #include <seastar/core/coroutine.hh>
 
@@ -51,6 +54,60 @@ security_manager::apply_update(model::record_batch batch) {
     });
 }
 
+ss::future<iobuf> security_manager::take_snapshot(model::offset) {
+    auto& store = _credentials.local();
+    iobuf out;
+    reflection::serialize(out, static_cast<uint32_t>(store.size()));
+    for (auto& [user, credential] : store) {
+        reflection::serialize(
+          out,
+          security::credential_user(user),
+          security::scram_credential(
+            std::get<security::scram_credential>(credential)));
+    }
+    reflection::serialize(
+      out,
+      create_acls_cmd_data{
+        .bindings = _authorizer.local().acls(
+          security::acl_binding_filter::any())});
+    co_return out;
+}
+
+ss::future<>
+security_manager::apply_snapshot(model::offset offset, iobuf data) {
+    using credentials_t = std::vector<
+      std::pair<security::credential_user, security::scram_credential>>;
+    iobuf_parser parser(std::move(data));
+    auto users = reflection::adl<uint32_t>{}.from(parser);
+    credentials_t credentials;
+    credentials.reserve(users);
+    for (uint32_t i = 0; i < users; ++i) {
+        auto user = reflection::adl<security::credential_user>{}.from(parser);
+        credentials.emplace_back(
+          std::move(user),
+          reflection::adl<security::scram_credential>{}.from(parser));
+    }
+    auto acls = reflection::adl<create_acls_cmd_data>{}.from(parser);
+    vlog(
+      clusterlog.info,
+      "restoring {} users and {} acls from snapshot at offset {}",
+      credentials.size(),
+      acls.bindings.size(),
+      offset);
+
+    co_await _credentials.invoke_on_all(
+      [&credentials](security::credential_store& store) {
+          store.clear();
+          for (auto& [user, credential] : credentials) {
+              store.put(user, credential);
+          }
+      });
+    co_await _authorizer.invoke_on_all([&acls](security::authorizer& auth) {
+        auth.remove_bindings({security::acl_binding_filter::any()});
+        auth.add_bindings(acls.bindings);
+    });
+}
+
 /*
  * handle: delete acls command
  */
@@ -34,6 +34,11 @@ public:
 
     ss::future<std::error_code> apply_update(model::record_batch);
 
+    /// users and acls of the cluster
+    ss::future<iobuf> take_snapshot(model::offset);
+    /// replaces users and acls of all the shards with the snapshot content
+    ss::future<> apply_snapshot(model::offset, iobuf);
+
     bool is_batch_applicable(const model::record_batch& batch) const {
         return batch.header().type
                  == model::record_batch_type::user_management_cmd
@@ -12,6 +12,7 @@
 #include "cluster/controller_api.h"
 #include "cluster/errc.h"
 #include "cluster/fwd.h"
+#include "cluster/health_manager.h"
 #include "cluster/members_frontend.h"
 #include "cluster/members_manager.h"
 #include "cluster/metadata_cache.h"
@@ -34,14 +35,16 @@ service::service(
   ss::sharded<metadata_cache>& cache,
   ss::sharded<security_frontend>& sf,
   ss::sharded<controller_api>& api,
-  ss::sharded<members_frontend>& members_frontend)
+  ss::sharded<members_frontend>& members_frontend,
+  ss::sharded<health_manager>& health_manager)
   : controller_service(sg, ssg)
   , _topics_frontend(tf)
   , _members_manager(mm)
   , _md_cache(cache)
   , _security_frontend(sf)
   , _api(api)
-  , _members_frontend(members_frontend) {}
+  , _members_frontend(members_frontend)
+  , _health_manager(health_manager) {}
 
 ss::future<join_reply>
 service::join(join_request&& req, rpc::streaming_context&) {
@@ -259,4 +262,30 @@ service::do_finish_reallocation(finish_reallocation_request req) {
 
     co_return finish_reallocation_reply{.error = errc::success};
 }
+
+ss::future<node_load_reply>
+service::get_node_load(node_load_request&&, rpc::streaming_context&) {
+    return ss::smp::submit_to(
+      health_manager::shard, get_smp_service_group(), [this] {
+          // the health manager is started together with the controller
+          if (!_health_manager.local_is_initialized()) {
+              return node_load_reply{};
+          }
+          return _health_manager.local().local_load();
+      });
+}
+
+ss::future<cluster_health_overview_reply>
+service::get_cluster_health_overview(
+  cluster_health_overview_request&&, rpc::streaming_context&) {
+    return ss::smp::submit_to(
+      health_manager::shard, get_smp_service_group(), [this] {
+          if (!_health_manager.local_is_initialized()) {
+              return ss::make_ready_future<cluster_health_overview_reply>(
+                cluster_health_overview_reply{
+                  .error = errc::not_leader_controller});
+          }
+          return _health_manager.local().local_health_overview();
+      });
+}
 } // namespace cluster
@@ -30,7 +30,8 @@ public:
       ss::sharded<metadata_cache>&,
       ss::sharded<security_frontend>&,
       ss::sharded<controller_api>&,
-      ss::sharded<members_frontend>&);
+      ss::sharded<members_frontend>&,
+      ss::sharded<health_manager>&);
 
     virtual ss::future<join_reply>
     join(join_request&&, rpc::streaming_context&) override;
@@ -64,6 +65,12 @@ public:
     ss::future<finish_reallocation_reply> finish_reallocation(
       finish_reallocation_request&&, rpc::streaming_context&) final;
 
+    ss::future<node_load_reply>
+    get_node_load(node_load_request&&, rpc::streaming_context&) final;
+
+    ss::future<cluster_health_overview_reply> get_cluster_health_overview(
+      cluster_health_overview_request&&, rpc::streaming_context&) final;
+
 private:
     std::
       pair<std::vector<model::topic_metadata>, std::vector<topic_configuration>>
@@ -87,5 +94,6 @@ private:
     ss::sharded<security_frontend>& _security_frontend;
     ss::sharded<controller_api>& _api;
     ss::sharded<members_frontend>& _members_frontend;
+    ss::sharded<health_manager>& _health_manager;
 };
 } // namespace cluster
@@ -17,7 +17,7 @@
 
 #include <seastar/core/reactor.hh> // shard_id
 
-#include <absl/container/node_hash_map.h>
+#include <absl/container/flat_hash_map.h>
 
 namespace cluster {
 /// \brief this is populated by consensus::controller
@@ -26,9 +26,19 @@ class shard_table final {
     struct shard_revision {
         ss::shard_id shard;
         model::revision_id revision;
+        // not assigned for the non replicable ntps
+        raft::group_id group{-1};
     };
 
 public:
+    /// the shard hosting an ntp together with its raft group. The group ids
+    /// are dense integers assigned by the controller, the shard resolves the
+    /// partition by group id instead of hashing the ntp again.
+    struct placement {
+        ss::shard_id shard;
+        raft::group_id group;
+    };
+
     bool contains(const raft::group_id& group) {
         return _group_idx.find(group) != _group_idx.end();
     }
@@ -46,6 +56,13 @@ public:
         return std::nullopt;
     }
 
+    std::optional<placement> placement_for(const model::ntp& ntp) {
+        if (auto it = _ntp_idx.find(ntp); it != _ntp_idx.end()) {
+            return placement{it->second.shard, it->second.group};
+        }
+        return std::nullopt;
+    }
+
     bool insert(model::ntp ntp, ss::shard_id i, model::revision_id rev) {
         auto [_, success] = _ntp_idx.insert(
           {std::move(ntp), shard_revision{i, rev}});
@@ -84,8 +101,8 @@ public:
             }
         }
 
-        _ntp_idx.insert_or_assign(ntp, shard_revision{shard, rev});
-        _group_idx.insert_or_assign(g, shard_revision{shard, rev});
+        _ntp_idx.insert_or_assign(ntp, shard_revision{shard, rev, g});
+        _group_idx.insert_or_assign(g, shard_revision{shard, rev, g});
     }
 
     void
@@ -122,8 +139,8 @@ private:
      */
 
     // kafka index
-    absl::node_hash_map<model::ntp, shard_revision> _ntp_idx;
+    absl::flat_hash_map<model::ntp, shard_revision> _ntp_idx;
     // raft index
-    absl::node_hash_map<raft::group_id, shard_revision> _group_idx;
+    absl::flat_hash_map<raft::group_id, shard_revision> _group_idx;
 };
 } // namespace cluster
@@ -99,3 +99,33 @@ FIXTURE_TEST(stm_restart_test, mux_state_machine_fixture) {
     }
     stm2.stop().get0();
 }
+
+FIXTURE_TEST(stm_range_allocation_test, mux_state_machine_fixture) {
+    start_raft();
+
+    config::configuration cfg;
+    cfg.id_allocator_batch_size.set_value(int16_t(10));
+    cfg.id_allocator_log_capacity.set_value(int16_t(2));
+
+    cluster::id_allocator_stm stm(idstmlog, _raft.get(), cfg);
+
+    stm.start().get0();
+    auto stop = ss::defer([&stm] { stm.stop().get0(); });
+
+    wait_for_leader();
+
+    // ranges smaller and larger than the batch never overlap
+    int64_t next_free = -1;
+    for (int64_t count : {3, 4, 25, 1, 9}) {
+        auto result = stm.allocate_id_range(count, 1s).get0();
+
+        BOOST_REQUIRE_EQUAL(raft::errc::success, result.raft_status);
+        BOOST_REQUIRE_LE(next_free, result.id);
+
+        next_free = result.id + count;
+    }
+
+    auto result = stm.allocate_id(1s).get0();
+    BOOST_REQUIRE_EQUAL(raft::errc::success, result.raft_status);
+    BOOST_REQUIRE_LE(next_free, result.id);
+}
@@ -11,6 +11,7 @@
 #define BOOST_TEST_MODULE leader_balancer
 
 #include "cluster/scheduling/leader_balancer_greedy.h"
+#include "cluster/scheduling/leader_balancer_throughput.h"
 
 #include <boost/test/unit_test.hpp>
 
@@ -62,3 +63,77 @@ BOOST_AUTO_TEST_CASE(greedy) {
     BOOST_REQUIRE(movement);
     BOOST_REQUIRE_EQUAL(movement->from, shards[5]);
 }
+
+namespace {
+/*
+ * two single core nodes, every group is replicated on both of them and led
+ * by the first one in its replica set.
+ */
+std::vector<model::broker_shard> two_shards() {
+    return {
+      model::broker_shard{model::node_id(0), 0},
+      model::broker_shard{model::node_id(1), 0}};
+}
+
+void add_groups(
+  cluster::leader_balancer_strategy::index_type& index,
+  size_t leader,
+  int first,
+  int count) {
+    auto shards = two_shards();
+    for (int g = first; g < first + count; ++g) {
+        index[shards[leader]][raft::group_id(g)] = {
+          shards[leader], shards[1 - leader]};
+    }
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(throughput) {
+    cluster::leader_balancer_strategy::index_type index;
+    // shard 0 leads 3 hot groups, shard 1 leads 4 idle groups
+    add_groups(index, 0, 0, 3);
+    add_groups(index, 1, 3, 4);
+    cluster::throughput_balanced_shards::group_throughput tput{
+      {raft::group_id(0), 100},
+      {raft::group_id(1), 100},
+      {raft::group_id(2), 100}};
+
+    // the greedy strategy balances the number of leaders
+    auto greed = cluster::greedy_balanced_shards(index, {});
+    auto movement = greed.find_movement({});
+    BOOST_REQUIRE(movement);
+    BOOST_REQUIRE_EQUAL(movement->from, two_shards()[1]);
+
+    // while the hot groups make shard 0 the most loaded one
+    auto strategy = cluster::throughput_balanced_shards(index, {}, tput, 0.1);
+    BOOST_REQUIRE_GT(strategy.error(), 0);
+    movement = strategy.find_movement({});
+    BOOST_REQUIRE(movement);
+    BOOST_REQUIRE_EQUAL(movement->from, two_shards()[0]);
+    BOOST_REQUIRE_EQUAL(movement->to, two_shards()[1]);
+
+    // skipped groups are not moved
+    movement = strategy.find_movement(
+      {raft::group_id(0), raft::group_id(1), raft::group_id(2)});
+    BOOST_REQUIRE(!movement);
+}
+
+BOOST_AUTO_TEST_CASE(throughput_dead_band) {
+    cluster::leader_balancer_strategy::index_type index;
+    // a hot group and a few idle groups on each shard, shard 0 leads two more
+    // idle groups
+    add_groups(index, 0, 0, 6);
+    add_groups(index, 1, 6, 4);
+    cluster::throughput_balanced_shards::group_throughput tput{
+      {raft::group_id(0), 100}, {raft::group_id(6), 100}};
+
+    // moving an idle group reduces the skew by 20% of the average load...
+    auto strategy = cluster::throughput_balanced_shards(index, {}, tput, 0.1);
+    auto movement = strategy.find_movement({});
+    BOOST_REQUIRE(movement);
+    BOOST_REQUIRE_EQUAL(movement->from, two_shards()[0]);
+
+    // ...which is below the required improvement
+    strategy = cluster::throughput_balanced_shards(index, {}, tput, 0.25);
+    BOOST_REQUIRE(!strategy.find_movement({}));
+}
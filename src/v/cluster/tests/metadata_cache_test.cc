@@ -0,0 +1,75 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/members_table.h"
+#include "cluster/metadata_cache.h"
+#include "cluster/partition_leaders_table.h"
+#include "cluster/tests/topic_table_fixture.h"
+#include "model/fundamental.h"
+#include "model/metadata.h"
+
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/defer.hh>
+
+#include <algorithm>
+
+static std::optional<model::node_id> snapshot_leader(
+  const cluster::metadata_cache::topics_snapshot& snapshot,
+  const model::topic_namespace& tp_ns,
+  model::partition_id p) {
+    auto it = std::find_if(
+      snapshot.topics.begin(),
+      snapshot.topics.end(),
+      [&tp_ns](const model::topic_metadata& md) { return md.tp_ns == tp_ns; });
+    BOOST_REQUIRE(it != snapshot.topics.end());
+    auto p_it = std::find_if(
+      it->partitions.begin(),
+      it->partitions.end(),
+      [p](const model::partition_metadata& pm) { return pm.id == p; });
+    BOOST_REQUIRE(p_it != it->partitions.end());
+    return p_it->leader_node;
+}
+
+FIXTURE_TEST(test_topics_snapshot_rebuilt_on_change, topic_table_fixture) {
+    ss::sharded<cluster::members_table> members;
+    ss::sharded<cluster::partition_leaders_table> leaders;
+    members.start().get();
+    leaders.start(std::ref(table)).get();
+    auto stop = ss::defer([&members, &leaders] {
+        leaders.stop().get();
+        members.stop().get();
+    });
+    cluster::metadata_cache cache(table, members, leaders);
+
+    create_topics();
+    auto tp_ns = make_tp_ns("test_tp_2");
+    auto first = cache.topics_metadata_snapshot();
+    BOOST_REQUIRE_EQUAL(first->topics.size(), 3);
+    BOOST_REQUIRE_EQUAL(first->version, cache.topics_metadata_version());
+    BOOST_REQUIRE(!snapshot_leader(*first, tp_ns, model::partition_id(0)));
+
+    // readers share the snapshot until something changes
+    BOOST_REQUIRE(cache.topics_metadata_snapshot() == first);
+
+    leaders.local().update_partition_leader(
+      model::ntp(tp_ns.ns, tp_ns.tp, model::partition_id(0)),
+      model::term_id(1),
+      model::node_id(1));
+    auto second = cache.topics_metadata_snapshot();
+    BOOST_REQUIRE(second != first);
+    BOOST_REQUIRE_EQUAL(second->version, cache.topics_metadata_version());
+    BOOST_REQUIRE(
+      snapshot_leader(*second, tp_ns, model::partition_id(0))
+      == model::node_id(1));
+    // the previous snapshot is left untouched
+    BOOST_REQUIRE(!snapshot_leader(*first, tp_ns, model::partition_id(0)));
+
+    BOOST_REQUIRE_EQUAL(
+      cache.all_topics_metadata().size(), second->topics.size());
+}
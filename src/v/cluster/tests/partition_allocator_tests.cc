@@ -14,6 +14,7 @@
 #include "random/fast_prng.h"
 #include "random/generators.h"
 #include "test_utils/fixture.h"
+#include "units.h"
 
 #include <seastar/core/sharded.hh>
 
@@ -510,3 +511,44 @@ FIXTURE_TEST(change_replication_factor, partition_allocator_fixture) {
     BOOST_CHECK_EQUAL(expected_success.has_value(), true);
     validate_replica_set_diversity(expected_success.value().get_assignments());
 }
+
+FIXTURE_TEST(load_aware_node_selection, partition_allocator_fixture) {
+    register_node(0, 2);
+    register_node(1, 2);
+    register_node(2, 2);
+    // node 0 is hot, node 1 stores a lot of data
+    allocator.update_node_load(
+      model::node_id(0),
+      {cluster::core_load{.bytes_per_sec = 100_MiB, .disk_bytes = 1_GiB},
+       cluster::core_load{.bytes_per_sec = 100_MiB, .disk_bytes = 1_GiB}});
+    allocator.update_node_load(
+      model::node_id(1),
+      {cluster::core_load{.bytes_per_sec = 0, .disk_bytes = 100_GiB},
+       cluster::core_load{.bytes_per_sec = 0, .disk_bytes = 100_GiB}});
+
+    auto res = allocator.allocate(make_allocation_request(30, 1));
+    BOOST_REQUIRE(res.has_value());
+    for (const auto& as : res.value().get_assignments()) {
+        BOOST_REQUIRE_EQUAL(as.replicas.front().node_id, model::node_id(2));
+    }
+}
+
+FIXTURE_TEST(load_aware_core_selection, partition_allocator_fixture) {
+    register_node(0, 4);
+    allocator.update_node_load(
+      model::node_id(0),
+      {cluster::core_load{},
+       cluster::core_load{.bytes_per_sec = 100_MiB},
+       cluster::core_load{},
+       cluster::core_load{}});
+
+    auto res = allocator.allocate(make_allocation_request(20, 1));
+    BOOST_REQUIRE(res.has_value());
+    std::vector<int> per_core(4, 0);
+    for (const auto& as : res.value().get_assignments()) {
+        per_core[as.replicas.front().shard]++;
+    }
+    // the hot core gets fewer partitions than the idle ones
+    BOOST_REQUIRE_LT(per_core[1], per_core[2]);
+    BOOST_REQUIRE_LT(per_core[1], per_core[3]);
+}
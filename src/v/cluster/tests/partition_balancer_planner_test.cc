@@ -0,0 +1,120 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/partition_balancer_planner.h"
+#include "cluster/tests/topic_table_fixture.h"
+#include "model/fundamental.h"
+#include "model/metadata.h"
+#include "units.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+namespace {
+model::broker_shard replica_on(int node, uint32_t shard) {
+    return model::broker_shard{.node_id = model::node_id(node), .shard = shard};
+}
+
+cluster::partition_load
+partition_tput(const model::ntp& ntp, uint64_t bytes_per_sec) {
+    return cluster::partition_load{
+      .ntp = ntp, .bytes_per_sec = bytes_per_sec, .disk_bytes = 0};
+}
+
+cluster::node_load_reply cores_load(size_t cores, uint64_t core0_tput) {
+    cluster::node_load_reply r;
+    r.cores.resize(cores);
+    r.cores[0].bytes_per_sec = core0_tput;
+    return r;
+}
+} // namespace
+
+struct planner_fixture : topic_table_fixture {
+    // p0 and p1 on node 1, p2 on node 2, p3 on node 3, all on core 0
+    planner_fixture() {
+        std::vector<cluster::partition_assignment> assignments;
+        std::vector<model::broker_shard> replicas{
+          replica_on(1, 0),
+          replica_on(1, 0),
+          replica_on(2, 0),
+          replica_on(3, 0)};
+        for (int p = 0; p < 4; ++p) {
+            assignments.push_back(cluster::partition_assignment{
+              .group = raft::group_id(100 + p),
+              .id = model::partition_id(p),
+              .replicas = {replicas[p]}});
+        }
+        cluster::topic_configuration cfg(test_ns, model::topic("hot"), 4, 1);
+        auto res = table.local()
+                     .apply(
+                       cluster::create_topic_cmd(
+                         make_tp_ns("hot"),
+                         cluster::topic_configuration_assignment(
+                           cfg, std::move(assignments))),
+                       model::offset(0))
+                     .get0();
+        BOOST_REQUIRE_EQUAL(res, cluster::errc::success);
+    }
+
+    model::ntp ntp(int p) {
+        return model::ntp(test_ns, model::topic("hot"), model::partition_id(p));
+    }
+
+    std::vector<cluster::partition_balancer_planner::move>
+    plan(const cluster::partition_balancer_planner::cluster_load_t& load) {
+        cluster::partition_balancer_planner planner(
+          cluster::partition_balancer_planner::config{
+            .max_moves = 1, .min_skew_percent = 20},
+          table.local(),
+          allocator.local().state());
+        return planner.plan(load);
+    }
+};
+
+FIXTURE_TEST(test_balanced_cluster_is_left_untouched, planner_fixture) {
+    cluster::partition_balancer_planner::cluster_load_t load;
+    load.emplace(model::node_id(1), cores_load(8, 0));
+    load.emplace(model::node_id(2), cores_load(12, 0));
+    load.emplace(model::node_id(3), cores_load(4, 0));
+    BOOST_REQUIRE(plan(load).empty());
+}
+
+FIXTURE_TEST(test_replica_moved_to_least_loaded_node, planner_fixture) {
+    cluster::partition_balancer_planner::cluster_load_t load;
+    auto n1 = cores_load(8, 80_MiB);
+    n1.partitions = {
+      partition_tput(ntp(0), 50_MiB), partition_tput(ntp(1), 30_MiB)};
+    auto n2 = cores_load(12, 10_MiB);
+    n2.partitions = {partition_tput(ntp(2), 10_MiB)};
+    auto n3 = cores_load(4, 10_MiB);
+    n3.partitions = {partition_tput(ntp(3), 10_MiB)};
+    load.emplace(model::node_id(1), std::move(n1));
+    load.emplace(model::node_id(2), std::move(n2));
+    load.emplace(model::node_id(3), std::move(n3));
+
+    auto moves = plan(load);
+    BOOST_REQUIRE_EQUAL(moves.size(), 1);
+    // p0 would make node 2 the most loaded node, p1 lands on its idle core
+    BOOST_REQUIRE_EQUAL(moves[0].ntp, ntp(1));
+    BOOST_REQUIRE_EQUAL(moves[0].replicas.size(), 1);
+    BOOST_REQUIRE_EQUAL(moves[0].replicas[0], replica_on(2, 1));
+}
+
+FIXTURE_TEST(test_replica_moved_to_least_loaded_core, planner_fixture) {
+    // a single node, nothing to balance across nodes
+    cluster::partition_balancer_planner::cluster_load_t load;
+    auto n1 = cores_load(8, 80_MiB);
+    n1.partitions = {
+      partition_tput(ntp(0), 50_MiB), partition_tput(ntp(1), 30_MiB)};
+    load.emplace(model::node_id(1), std::move(n1));
+
+    auto moves = plan(load);
+    BOOST_REQUIRE_EQUAL(moves.size(), 1);
+    BOOST_REQUIRE_EQUAL(moves[0].ntp, ntp(1));
+    BOOST_REQUIRE_EQUAL(moves[0].replicas[0], replica_on(1, 1));
+}
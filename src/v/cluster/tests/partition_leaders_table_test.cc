@@ -0,0 +1,82 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "cluster/partition_leaders_table.h"
+#include "cluster/topic_table.h"
+#include "model/fundamental.h"
+#include "model/metadata.h"
+
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/defer.hh>
+
+#include <vector>
+
+static model::ntp leaders_test_ntp(int p) {
+    return model::ntp(
+      model::ns("test"), model::topic("tp"), model::partition_id(p));
+}
+
+static std::optional<std::vector<model::partition_id>>
+updates_since(const cluster::partition_leaders_table& leaders, uint64_t v) {
+    std::vector<model::partition_id> ret;
+    bool retained = leaders.for_each_leader_since(
+      v,
+      [&ret](
+        model::topic_namespace_view,
+        model::partition_id pid,
+        std::optional<model::node_id>,
+        model::term_id) { ret.push_back(pid); });
+    if (!retained) {
+        return std::nullopt;
+    }
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+SEASTAR_THREAD_TEST_CASE(test_leadership_updates_since_version) {
+    ss::sharded<cluster::topic_table> topics;
+    topics.start().get();
+    auto stop = ss::defer([&topics] { topics.stop().get(); });
+    cluster::partition_leaders_table leaders(topics);
+
+    // updates are not retained unless enabled
+    leaders.update_partition_leader(
+      leaders_test_ntp(0), model::term_id(1), model::node_id(1));
+    BOOST_REQUIRE(!updates_since(leaders, 0));
+
+    leaders.enable_updates_log(3);
+    auto start = leaders.version();
+    // updates preceding the log are not retained
+    BOOST_REQUIRE(!updates_since(leaders, start - 1));
+    BOOST_REQUIRE(updates_since(leaders, start)->empty());
+
+    leaders.update_partition_leader(
+      leaders_test_ntp(1), model::term_id(1), model::node_id(1));
+    leaders.update_partition_leader(
+      leaders_test_ntp(2), model::term_id(1), model::node_id(2));
+    // multiple updates of a partition are reported once
+    leaders.update_partition_leader(
+      leaders_test_ntp(1), model::term_id(2), model::node_id(3));
+    BOOST_REQUIRE_EQUAL(leaders.version(), start + 3);
+    auto updated = updates_since(leaders, start);
+    BOOST_REQUIRE(updated);
+    BOOST_REQUIRE_EQUAL(updated->size(), 2);
+    BOOST_REQUIRE_EQUAL(updated->at(0), model::partition_id(1));
+    BOOST_REQUIRE_EQUAL(updated->at(1), model::partition_id(2));
+    BOOST_REQUIRE_EQUAL(updates_since(leaders, start + 2)->size(), 1);
+    BOOST_REQUIRE(leaders.get_leader(leaders_test_ntp(1)) == model::node_id(3));
+
+    // the oldest update is evicted
+    leaders.update_partition_leader(
+      leaders_test_ntp(3), model::term_id(1), model::node_id(1));
+    BOOST_REQUIRE(!updates_since(leaders, start));
+    BOOST_REQUIRE_EQUAL(updates_since(leaders, start + 1)->size(), 3);
+    // versions the table never reached
+    BOOST_REQUIRE(!updates_since(leaders, leaders.version() + 1));
+}
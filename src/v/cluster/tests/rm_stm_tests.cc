@@ -439,3 +439,93 @@ FIXTURE_TEST(test_tx_post_aborted_produce, mux_state_machine_fixture) {
                  .get0();
     BOOST_REQUIRE(offset_r == invalid_producer_epoch);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_abort_index_tree_intersecting) {
+    using abort_index = cluster::rm_stm::abort_index;
+    cluster::rm_stm::abort_index_tree tree;
+    std::vector<abort_index> all;
+    for (int i = 0; i < 200; ++i) {
+        auto first = random_generators::get_int(10000);
+        auto last = first + random_generators::get_int(500);
+        abort_index idx{
+          .first = model::offset(first), .last = model::offset(last)};
+        tree.add(idx);
+        all.push_back(idx);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        auto from = model::offset(random_generators::get_int(11000));
+        auto to = from + model::offset(random_generators::get_int(1000));
+        size_t expected = std::count_if(
+          all.begin(), all.end(), [from, to](const abort_index& idx) {
+              return idx.last >= from && idx.first <= to;
+          });
+        auto found = tree.intersecting(from, to);
+        BOOST_REQUIRE_EQUAL(found.size(), expected);
+        for (auto& idx : found) {
+            BOOST_REQUIRE(idx.last >= from && idx.first <= to);
+        }
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(test_producer_seq_table_eviction) {
+    using seq_entry = cluster::rm_stm::seq_entry;
+    cluster::rm_stm::producer_seq_table table;
+    auto pid = [](int64_t id) {
+        return model::producer_identity{.id = id, .epoch = 0};
+    };
+    for (int64_t i = 0; i < 10; ++i) {
+        table.write(
+          seq_entry{.pid = pid(i), .seq = 0, .last_write_timestamp = i});
+    }
+    // producer 0 writes again, it becomes the most recent one
+    table.write(seq_entry{.pid = pid(0), .seq = 1, .last_write_timestamp = 10});
+    BOOST_REQUIRE_EQUAL(table.size(), 10);
+    BOOST_REQUIRE_EQUAL(table.find(pid(0))->seq, 1);
+
+    // expire the producers not written since 3
+    table.evict(3, 100);
+    BOOST_REQUIRE_EQUAL(table.size(), 8);
+    BOOST_REQUIRE(table.find(pid(1)) == nullptr);
+    BOOST_REQUIRE(table.find(pid(2)) == nullptr);
+
+    // cap to 2 producers, the most recently written ones are kept
+    table.evict(0, 2);
+    BOOST_REQUIRE_EQUAL(table.size(), 2);
+    BOOST_REQUIRE(table.find(pid(9)) != nullptr);
+    BOOST_REQUIRE(table.find(pid(0)) != nullptr);
+
+    std::vector<int64_t> order;
+    table.for_each(
+      [&order](const seq_entry& e) { order.push_back(e.pid.id); });
+    BOOST_REQUIRE(order == std::vector<int64_t>({9, 0}));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_streamed_tx_snapshot) {
+    using tx_snapshot = cluster::rm_stm::tx_snapshot;
+    tx_snapshot tx_ss;
+    for (int64_t i = 0; i < 3; ++i) {
+        auto pid = model::producer_identity{.id = i, .epoch = 1};
+        tx_ss.fenced.push_back(pid);
+        tx_ss.aborted.push_back(
+          {.pid = pid, .first = model::offset(i), .last = model::offset(i)});
+    }
+    tx_ss.offset = model::offset(42);
+    // spans a few chunks
+    for (int64_t i = 0; i < 20'000; ++i) {
+        tx_ss.seqs.push_back(
+          {.pid = model::producer_identity{.id = i, .epoch = 0},
+           .seq = int32_t(i),
+           .last_write_timestamp = i});
+    }
+
+    iobuf expected;
+    reflection::adl<tx_snapshot>{}.to(expected, tx_ss);
+    auto size = cluster::rm_stm::serialized_size(tx_ss);
+    BOOST_REQUIRE_EQUAL(size, expected.size_bytes());
+
+    iobuf streamed;
+    auto out = make_iobuf_ref_output_stream(streamed);
+    cluster::rm_stm::write_tx_snapshot(std::move(tx_ss), size, out).get();
+    out.close().get();
+    BOOST_REQUIRE(streamed == expected);
+}
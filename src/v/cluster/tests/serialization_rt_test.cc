@@ -191,3 +191,32 @@ SEASTAR_THREAD_TEST_CASE(config_update_req_resp_test) {
     auto reply_res = serialize_roundtrip_rpc(std::move(reply));
     BOOST_REQUIRE_EQUAL(reply_res.success, true);
 }
+
+SEASTAR_THREAD_TEST_CASE(cluster_health_overview_rt_test) {
+    const model::ntp ntp(model::ns("test"), model::topic("tp"), 2);
+    cluster::cluster_health_overview_reply reply{
+      .controller_id = model::node_id(1),
+      .nodes = {{.id = model::node_id(1),
+                 .is_alive = true,
+                 .leaders = 10,
+                 .disk = {.total_bytes = 100_GiB, .free_bytes = 40_GiB}},
+                {.id = model::node_id(2)}},
+      .leaderless_count = 3,
+      .leaderless_partitions = {ntp},
+      .age_ms = 1500};
+
+    auto d = serialize_roundtrip_rpc(std::move(reply));
+
+    BOOST_REQUIRE_EQUAL(d.error, cluster::errc::success);
+    BOOST_REQUIRE_EQUAL(d.controller_id, model::node_id(1));
+    BOOST_REQUIRE_EQUAL(d.nodes.size(), 2);
+    BOOST_REQUIRE(d.nodes[0].is_alive);
+    BOOST_REQUIRE_EQUAL(d.nodes[0].leaders, 10);
+    BOOST_REQUIRE_EQUAL(d.nodes[0].disk.free_bytes, 40_GiB);
+    BOOST_REQUIRE(!d.nodes[1].is_alive);
+    BOOST_REQUIRE_EQUAL(d.leaderless_count, 3);
+    BOOST_REQUIRE_EQUAL(d.leaderless_partitions.size(), 1);
+    BOOST_REQUIRE_EQUAL(d.leaderless_partitions[0], ntp);
+    BOOST_REQUIRE_EQUAL(d.age_ms, 1500);
+    BOOST_REQUIRE(!d.is_healthy());
+}
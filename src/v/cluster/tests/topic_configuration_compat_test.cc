@@ -201,6 +201,8 @@ void topic_config_roundtrip() {
         cfg.properties.recovery = true;
         cfg.properties.shadow_indexing
           = model::shadow_indexing_mode::archival_storage;
+        cfg.properties.in_memory = true;
+        cfg.properties.write_caching = true;
     }
 
     auto d = serialize_upgrade_rpc<CfgIn, CfgOut>(std::move(cfg));
@@ -226,9 +228,13 @@ void topic_config_roundtrip() {
         BOOST_REQUIRE(
           d.properties.shadow_indexing
           == model::shadow_indexing_mode::archival_storage);
+        BOOST_REQUIRE(d.properties.in_memory == true);
+        BOOST_REQUIRE(d.properties.write_caching == true);
     } else {
         BOOST_REQUIRE_EQUAL(false, d.properties.recovery.has_value());
         BOOST_REQUIRE_EQUAL(false, d.properties.shadow_indexing.has_value());
+        BOOST_REQUIRE_EQUAL(false, d.properties.in_memory.has_value());
+        BOOST_REQUIRE_EQUAL(false, d.properties.write_caching.has_value());
     }
 }
 
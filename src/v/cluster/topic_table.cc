@@ -343,6 +343,7 @@ topic_table::apply(create_non_replicable_topic_cmd cmd, model::offset o) {
 }
 
 void topic_table::notify_waiters() {
+    ++_version;
     if (_waiters.empty()) {
         return;
     }
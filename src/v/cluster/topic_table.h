@@ -148,6 +148,13 @@ public:
     const underlying_t& topics_map() const { return _topics; }
 
     bool is_update_in_progress(const model::ntp&) const;
+    bool has_updates_in_progress() const {
+        return !_update_in_progress.empty();
+    }
+
+    /// Version of the table content, incremented on every change. Allows
+    /// callers to tell if state derived from the table is still up to date.
+    uint64_t version() const { return _version; }
 
 private:
     struct waiter {
@@ -175,5 +182,6 @@ private:
     std::vector<std::pair<cluster::notification_id_type, delta_cb_t>>
       _notifications;
     uint64_t _waiter_id{0};
+    uint64_t _version{0};
 };
 } // namespace cluster
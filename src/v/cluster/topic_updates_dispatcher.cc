@@ -10,9 +10,18 @@
 #include "cluster/topic_updates_dispatcher.h"
 
 #include "cluster/commands.h"
+#include "cluster/logger.h"
+#include "config/configuration.h"
 #include "model/metadata.h"
 #include "raft/types.h"
+#include "reflection/adl.h"
+#include "vlog.h"
 
+#include <seastar/core/coroutine.hh>
+
+#include <absl/container/flat_hash_set.h>
+
+#include <algorithm>
 #include <iterator>
 #include <system_error>
 #include <vector>
@@ -22,10 +31,152 @@ namespace cluster {
 topic_updates_dispatcher::topic_updates_dispatcher(
   ss::sharded<partition_allocator>& pal, ss::sharded<topic_table>& table)
   : _partition_allocator(pal)
-  , _topic_table(table) {}
+  , _topic_table(table)
+  , _retain_history(
+      config::shard_local_cfg().controller_snapshot_max_batches() > 0) {}
+
+static model::topic_namespace command_topic(const model::topic_namespace& key) {
+    return key;
+}
+
+static model::topic_namespace command_topic(const model::ntp& key) {
+    return model::topic_namespace(key.ns, key.tp.topic);
+}
+
+static model::topic_namespace command_topic(const non_replicable_topic& key) {
+    return key.name;
+}
 
 ss::future<std::error_code>
 topic_updates_dispatcher::apply_update(model::record_batch b) {
+    auto base_offset = b.base_offset();
+    if (!_retain_history) {
+        _last_applied = base_offset;
+        co_return co_await do_apply_update(std::move(b));
+    }
+
+    auto copy = b.copy();
+    auto ec = co_await do_apply_update(std::move(b));
+    _last_applied = base_offset;
+    if (ec) {
+        co_return ec;
+    }
+    auto cmd = co_await deserialize(copy.copy(), commands);
+    auto tn = ss::visit(
+      cmd, [](const auto& c) { return command_topic(c.key); });
+    if (std::holds_alternative<delete_topic_cmd>(cmd)) {
+        // nothing left to restore once the topic is deleted
+        _history.erase(tn);
+    } else {
+        _history[tn].push_back(std::move(copy));
+    }
+    co_return ec;
+}
+
+ss::future<iobuf> topic_updates_dispatcher::take_snapshot(model::offset) {
+    vassert(
+      _retain_history,
+      "controller snapshots are enabled but topic commands are not retained");
+    iobuf out;
+    reflection::serialize(
+      out,
+      _partition_allocator.local().state().last_group_id(),
+      static_cast<uint32_t>(_history.size()));
+    for (auto& [tn, batches] : _history) {
+        std::vector<model::record_batch> copies;
+        copies.reserve(batches.size());
+        for (auto& b : batches) {
+            copies.push_back(b.copy());
+        }
+        reflection::serialize(out, tn, std::move(copies));
+    }
+    co_return out;
+}
+
+ss::future<>
+topic_updates_dispatcher::apply_snapshot(model::offset offset, iobuf data) {
+    iobuf_parser parser(std::move(data));
+    auto last_group_id = reflection::adl<raft::group_id>{}.from(parser);
+    auto topics = reflection::adl<uint32_t>{}.from(parser);
+    history_t snapshot;
+    snapshot.reserve(topics);
+    for (uint32_t i = 0; i < topics; ++i) {
+        auto tn = reflection::adl<model::topic_namespace>{}.from(parser);
+        snapshot.emplace(
+          std::move(tn),
+          reflection::adl<std::vector<model::record_batch>>{}.from(parser));
+    }
+
+    // topics deleted after the last applied command, or deleted and created
+    // again, are removed from the current state
+    for (auto& tn : _topic_table.local().all_topics()) {
+        auto it = snapshot.find(tn);
+        if (
+          it == snapshot.end() || it->second.empty()
+          || it->second.front().base_offset() > _last_applied) {
+            co_await delete_topic(tn, offset);
+        }
+    }
+
+    // the commands already reflected in the current state are retained, the
+    // others are applied in the order they were replicated
+    history_t retained;
+    std::vector<model::record_batch> to_apply;
+    for (auto& [tn, batches] : snapshot) {
+        auto& topic_history = retained[tn];
+        for (auto& b : batches) {
+            if (b.base_offset() <= _last_applied) {
+                topic_history.push_back(std::move(b));
+            } else {
+                to_apply.push_back(std::move(b));
+            }
+        }
+        if (topic_history.empty()) {
+            retained.erase(tn);
+        }
+    }
+    _history = std::move(retained);
+    std::sort(
+      to_apply.begin(),
+      to_apply.end(),
+      [](const model::record_batch& l, const model::record_batch& r) {
+          return l.base_offset() < r.base_offset();
+      });
+    vlog(
+      clusterlog.info,
+      "restoring {} topics from snapshot at offset {}, applying {} commands",
+      snapshot.size(),
+      offset,
+      to_apply.size());
+    for (auto& b : to_apply) {
+        co_await apply_update(std::move(b));
+    }
+
+    // group ids of deleted topics are never reused
+    _partition_allocator.local().state().update_highest_group_id(
+      last_group_id);
+    _last_applied = std::max(_last_applied, offset);
+}
+
+ss::future<> topic_updates_dispatcher::delete_topic(
+  model::topic_namespace tn, model::offset offset) {
+    auto tp_md = _topic_table.local().get_topic_metadata(tn);
+    auto ec = co_await dispatch_updates_to_cores(
+      delete_topic_cmd(tn, tn), offset);
+    if (ec) {
+        vlog(
+          clusterlog.warn,
+          "unable to delete topic {} missing from controller snapshot - {}",
+          tn,
+          ec.message());
+        co_return;
+    }
+    deallocate_topic(*tp_md);
+    _history.erase(tn);
+}
+
+ss::future<std::error_code>
+topic_updates_dispatcher::do_apply_update(model::record_batch b) {
     auto base_offset = b.base_offset();
     return deserialize(std::move(b), commands)
       .then([this, base_offset](auto cmd) {
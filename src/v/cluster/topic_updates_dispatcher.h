@@ -17,6 +17,10 @@
 
 #include <seastar/core/sharded.hh>
 
+#include <absl/container/node_hash_map.h>
+
+#include <vector>
+
 namespace cluster {
 
 // The topic updates dispatcher is resposible for receiving update_apply upcalls
@@ -46,6 +50,11 @@ namespace cluster {
 //                              +-->| Table@core #n  |---+
 //                                  +----------------+
 //
+// When controller snapshots are enabled the dispatcher retains the commands
+// successfully applied to the existing topics. The snapshot of the topics is
+// made of these commands, with their original offsets, so that the topic table
+// restored from a snapshot holds the same revisions as the one built by
+// replaying the whole controller log.
 class topic_updates_dispatcher {
 public:
     topic_updates_dispatcher(
@@ -53,6 +62,9 @@ public:
 
     ss::future<std::error_code> apply_update(model::record_batch);
 
+    ss::future<iobuf> take_snapshot(model::offset);
+    ss::future<> apply_snapshot(model::offset, iobuf);
+
     static constexpr auto commands = make_commands_list<
       create_topic_cmd,
       delete_topic_cmd,
@@ -68,9 +80,15 @@ public:
     }
 
 private:
+    using history_t = absl::
+      node_hash_map<model::topic_namespace, std::vector<model::record_batch>>;
+
     template<typename Cmd>
     ss::future<std::error_code> dispatch_updates_to_cores(Cmd, model::offset);
 
+    ss::future<std::error_code> do_apply_update(model::record_batch);
+    ss::future<> delete_topic(model::topic_namespace, model::offset);
+
     void update_allocations(const create_topic_cmd&);
     void update_allocations(const create_partition_cmd&);
     void deallocate_topic(const model::topic_metadata&);
@@ -80,6 +98,10 @@ private:
 
     ss::sharded<partition_allocator>& _partition_allocator;
     ss::sharded<topic_table>& _topic_table;
+    const bool _retain_history;
+    // commands successfully applied to the existing topics
+    history_t _history;
+    model::offset _last_applied{model::offset::min()};
 };
 
 } // namespace cluster
@@ -82,18 +82,7 @@ ss::future<std::vector<topic_result>> topics_frontend::create_topics(
               return ss::make_ready_future<std::vector<topic_result>>(
                 create_topic_results(topics, errc::not_leader_controller));
           }
-          std::vector<ss::future<topic_result>> futures;
-          futures.reserve(topics.size());
-
-          std::transform(
-            std::begin(topics),
-            std::end(topics),
-            std::back_inserter(futures),
-            [this, timeout](topic_configuration& t_cfg) {
-                return do_create_topic(std::move(t_cfg), timeout);
-            });
-
-          return ss::when_all_succeed(futures.begin(), futures.end());
+          return do_create_topics(std::move(topics), timeout);
       })
       .then([this, timeout](std::vector<topic_result> results) {
           if (needs_linearizable_barrier(results)) {
@@ -315,80 +304,110 @@ allocation_request make_allocation_request(const topic_configuration& cfg) {
     return req;
 }
 
-ss::future<topic_result> topics_frontend::do_create_topic(
-  topic_configuration t_cfg, model::timeout_clock::time_point timeout) {
-    if (!validate_topic_name(t_cfg.tp_ns)) {
-        return ss::make_ready_future<topic_result>(
-          topic_result(t_cfg.tp_ns, errc::invalid_topic_name));
+ss::future<std::vector<topic_result>> topics_frontend::do_create_topics(
+  std::vector<topic_configuration> topics,
+  model::timeout_clock::time_point timeout) {
+    auto results = create_topic_results(topics, errc::success);
+    std::vector<size_t> valid;
+    std::vector<allocation_request> requests;
+    valid.reserve(topics.size());
+    requests.reserve(topics.size());
+    for (size_t i = 0; i < topics.size(); ++i) {
+        if (!validate_topic_name(topics[i].tp_ns)) {
+            results[i].ec = errc::invalid_topic_name;
+            continue;
+        }
+        valid.push_back(i);
+        requests.push_back(make_allocation_request(topics[i]));
     }
-    return _allocator
-      .invoke_on(
-        partition_allocator::shard,
-        [t_cfg](partition_allocator& al) {
-            return al.allocate(make_allocation_request(t_cfg));
-        })
-      .then([this, t_cfg = std::move(t_cfg), timeout](
-              result<allocation_units> units) mutable {
-          // no assignments, error
-          if (!units) {
-              return ss::make_ready_future<topic_result>(
-                make_error_result(t_cfg.tp_ns, units.error()));
-          }
 
-          return replicate_create_topic(
-            std::move(t_cfg), std::move(units.value()), timeout);
+    // all topics are allocated in a single round trip to the allocator
+    auto allocated = co_await _allocator.invoke_on(
+      partition_allocator::shard,
+      [requests = std::move(requests)](partition_allocator& al) mutable {
+          return al.allocate(std::move(requests));
       });
-}
 
-ss::future<topic_result> topics_frontend::replicate_create_topic(
-  topic_configuration cfg,
-  allocation_units units,
-  model::timeout_clock::time_point timeout) {
-    auto tp_ns = cfg.tp_ns;
-    create_topic_cmd cmd(
-      tp_ns,
-      topic_configuration_assignment(std::move(cfg), units.get_assignments()));
-
-    std::vector<ntp_leader> leaders;
-    leaders.reserve(cmd.value.assignments.size());
-    for (auto& p_as : cmd.value.assignments) {
-        std::shuffle(
-          p_as.replicas.begin(),
-          p_as.replicas.end(),
-          random_generators::internal::gen);
-        // guesstimate leaders
-        leaders.emplace_back(
-          model::ntp(tp_ns.ns, tp_ns.tp, p_as.id),
-          p_as.replicas.begin()->node_id);
+    std::vector<create_topic_cmd> cmds;
+    // index in results of the topic of every command
+    std::vector<size_t> cmd_results;
+    std::vector<std::vector<ntp_leader>> cmd_leaders;
+    // the allocation units are held until the commands are applied
+    std::vector<allocation_units> units;
+    cmds.reserve(valid.size());
+    cmd_results.reserve(valid.size());
+    cmd_leaders.reserve(valid.size());
+    units.reserve(valid.size());
+    for (size_t v = 0; v < valid.size(); ++v) {
+        auto i = valid[v];
+        // no assignments, error
+        if (!allocated[v]) {
+            results[i] = make_error_result(
+              topics[i].tp_ns, allocated[v].error());
+            continue;
+        }
+        auto tp_ns = topics[i].tp_ns;
+        create_topic_cmd cmd(
+          tp_ns,
+          topic_configuration_assignment(
+            std::move(topics[i]), allocated[v].value().get_assignments()));
+
+        std::vector<ntp_leader> leaders;
+        leaders.reserve(cmd.value.assignments.size());
+        for (auto& p_as : cmd.value.assignments) {
+            std::shuffle(
+              p_as.replicas.begin(),
+              p_as.replicas.end(),
+              random_generators::internal::gen);
+            // guesstimate leaders
+            leaders.emplace_back(
+              model::ntp(tp_ns.ns, tp_ns.tp, p_as.id),
+              p_as.replicas.begin()->node_id);
+        }
+        cmds.push_back(std::move(cmd));
+        cmd_results.push_back(i);
+        cmd_leaders.push_back(std::move(leaders));
+        units.push_back(std::move(allocated[v].value()));
     }
 
-    return replicate_and_wait(_stm, _as, std::move(cmd), timeout)
-      .then_wrapped(
-        [this,
-         tp_ns = std::move(tp_ns),
-         units = std::move(units),
-         leaders = std::move(leaders)](ss::future<std::error_code> f) mutable {
-            try {
-                auto error_code = f.get0();
-                auto ret_f = ss::now();
-                if (!error_code) {
-                    ret_f = update_leaders_with_estimates(std::move(leaders));
-                }
-
-                return ret_f.then([tp_ns = std::move(tp_ns),
-                                   error_code]() mutable {
-                    return topic_result(std::move(tp_ns), map_errc(error_code));
-                });
+    /*
+     * the commands are replicated in a single controller append, creating
+     * many topics costs one replication round trip instead of one per topic.
+     * appends are bounded to keep the controller batches reasonably sized.
+     */
+    for (size_t first = 0; first < cmds.size();
+         first += max_topics_per_append) {
+        auto last = std::min(cmds.size(), first + max_topics_per_append);
+        std::vector<create_topic_cmd> append(
+          std::make_move_iterator(cmds.begin() + first),
+          std::make_move_iterator(cmds.begin() + last));
+        std::vector<std::error_code> errors;
+        try {
+            errors = co_await replicate_and_wait_all(
+              _stm, _as, std::move(append), timeout);
+        } catch (...) {
+            vlog(
+              clusterlog.warn,
+              "Unable to create topics - {}",
+              std::current_exception());
+            errors.assign(last - first, errc::replication_error);
+        }
 
-            } catch (...) {
-                vlog(
-                  clusterlog.warn,
-                  "Unable to create topic - {}",
-                  std::current_exception());
-                return ss::make_ready_future<topic_result>(
-                  topic_result(std::move(tp_ns), errc::replication_error));
+        std::vector<ntp_leader> leaders;
+        for (size_t c = first; c < last; ++c) {
+            auto ec = errors[c - first];
+            results[cmd_results[c]].ec = map_errc(ec);
+            if (!ec) {
+                std::move(
+                  cmd_leaders[c].begin(),
+                  cmd_leaders[c].end(),
+                  std::back_inserter(leaders));
             }
-        });
+        }
+        co_await update_leaders_with_estimates(std::move(leaders));
+    }
+
+    co_return results;
 }
 
 ss::future<> topics_frontend::update_leaders_with_estimates(
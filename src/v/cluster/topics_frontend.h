@@ -76,11 +76,12 @@ public:
 private:
     using ntp_leader = std::pair<model::ntp, model::node_id>;
 
-    ss::future<topic_result>
-      do_create_topic(topic_configuration, model::timeout_clock::time_point);
+    // maximum number of create topic commands replicated in one controller
+    // append
+    static constexpr size_t max_topics_per_append = 128;
 
-    ss::future<topic_result> replicate_create_topic(
-      topic_configuration, allocation_units, model::timeout_clock::time_point);
+    ss::future<std::vector<topic_result>> do_create_topics(
+      std::vector<topic_configuration>, model::timeout_clock::time_point);
 
     ss::future<topic_result>
       do_delete_topic(model::topic_namespace, model::timeout_clock::time_point);
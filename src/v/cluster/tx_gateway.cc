@@ -67,6 +67,18 @@ tx_gateway::commit_tx(commit_tx_request&& request, rpc::streaming_context&) {
       request.ntp, request.pid, request.tx_seq, request.timeout);
 }
 
+ss::future<prepare_tx_batch_reply> tx_gateway::prepare_tx_batch(
+  prepare_tx_batch_request&& request, rpc::streaming_context&) {
+    return _rm_partition_frontend.local().do_prepare_tx_batch(
+      std::move(request));
+}
+
+ss::future<commit_tx_batch_reply> tx_gateway::commit_tx_batch(
+  commit_tx_batch_request&& request, rpc::streaming_context&) {
+    return _rm_partition_frontend.local().do_commit_tx_batch(
+      std::move(request));
+}
+
 ss::future<abort_tx_reply>
 tx_gateway::abort_tx(abort_tx_request&& request, rpc::streaming_context&) {
     return _rm_partition_frontend.local().do_abort_tx(
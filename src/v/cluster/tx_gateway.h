@@ -51,6 +51,12 @@ public:
     ss::future<commit_tx_reply>
     commit_tx(commit_tx_request&&, rpc::streaming_context&) override;
 
+    ss::future<prepare_tx_batch_reply> prepare_tx_batch(
+      prepare_tx_batch_request&&, rpc::streaming_context&) override;
+
+    ss::future<commit_tx_batch_reply>
+    commit_tx_batch(commit_tx_batch_request&&, rpc::streaming_context&) override;
+
     ss::future<abort_tx_reply>
     abort_tx(abort_tx_request&&, rpc::streaming_context&) override;
 
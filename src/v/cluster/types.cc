@@ -21,6 +21,7 @@
 
 #include <fmt/ostream.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -42,7 +43,9 @@ bool topic_properties::has_overrides() const {
     return cleanup_policy_bitflags || compaction_strategy || segment_size
            || retention_bytes.has_value() || retention_bytes.is_disabled()
            || retention_duration.has_value() || retention_duration.is_disabled()
-           || recovery.has_value() || shadow_indexing.has_value();
+           || recovery.has_value() || shadow_indexing.has_value()
+           || compression.has_value() || in_memory.has_value()
+           || write_caching.has_value();
 }
 
 storage::ntp_config::default_overrides
@@ -53,6 +56,10 @@ topic_properties::get_ntp_cfg_overrides() const {
     ret.retention_bytes = retention_bytes;
     ret.retention_time = retention_duration;
     ret.segment_size = segment_size;
+    ret.compression = compression;
+    ret.in_memory = storage::in_memory_log(in_memory.value_or(false));
+    ret.write_caching = storage::with_write_caching(
+      write_caching.value_or(false));
     return ret;
 }
 
@@ -81,7 +88,12 @@ storage::ntp_config topic_configuration::make_ntp_config(
             // during bootstrap.
             .cache_enabled = storage::with_cache(!is_internal()),
             .recovery_enabled = storage::topic_recovery_enabled(
-              properties.recovery ? *properties.recovery : false)});
+              properties.recovery ? *properties.recovery : false),
+            .compression = properties.compression,
+            .in_memory = storage::in_memory_log(
+              properties.in_memory.value_or(false)),
+            .write_caching = storage::with_write_caching(
+              properties.write_caching.value_or(false))});
     }
     return storage::ntp_config(
       model::ntp(tp_ns.ns, tp_ns.tp, p_id),
@@ -170,7 +182,8 @@ std::ostream& operator<<(std::ostream& o, const topic_properties& properties) {
       "compaction_strategy: "
       "{}, retention_bytes: {}, retention_duration_ms: {}, segment_size: "
       "{}, "
-      "timestamp_type: {}, recovery_enabled: {}, shadow_indexing: {} }}",
+      "timestamp_type: {}, recovery_enabled: {}, shadow_indexing: {}, "
+      "in_memory: {}, write_caching: {} }}",
       properties.compression,
       properties.cleanup_policy_bitflags,
       properties.compaction_strategy,
@@ -179,7 +192,9 @@ std::ostream& operator<<(std::ostream& o, const topic_properties& properties) {
       properties.segment_size,
       properties.timestamp_type,
       properties.recovery,
-      properties.shadow_indexing);
+      properties.shadow_indexing,
+      properties.in_memory,
+      properties.write_caching);
 
     return o;
 }
@@ -270,6 +285,23 @@ std::ostream& operator<<(std::ostream& o, const reconciliation_status& s) {
     __builtin_unreachable();
 }
 
+bool cluster_health_overview_reply::is_healthy() const {
+    return error == errc::success && leaderless_count == 0
+           && under_replicated_count == 0
+           && std::all_of(nodes.cbegin(), nodes.cend(), [](const auto& n) {
+                  return n.is_alive;
+              });
+}
+
+std::ostream& operator<<(std::ostream& o, const core_load& l) {
+    fmt::print(
+      o,
+      "{{bytes_per_sec: {}, disk_bytes: {}}}",
+      l.bytes_per_sec,
+      l.disk_bytes);
+    return o;
+}
+
 std::ostream&
 operator<<(std::ostream& o, const ntp_reconciliation_state& state) {
     fmt::print(
@@ -306,7 +338,7 @@ namespace reflection {
 
 void adl<cluster::topic_configuration>::to(
   iobuf& out, cluster::topic_configuration&& t) {
-    int32_t version = -1;
+    int32_t version = -3;
     reflection::serialize(
       out,
       version,
@@ -321,7 +353,9 @@ void adl<cluster::topic_configuration>::to(
       t.properties.retention_bytes,
       t.properties.retention_duration,
       t.properties.recovery,
-      t.properties.shadow_indexing);
+      t.properties.shadow_indexing,
+      t.properties.in_memory,
+      t.properties.write_caching);
 }
 
 cluster::topic_configuration
@@ -338,7 +372,7 @@ adl<cluster::topic_configuration>::from(iobuf_parser& in) {
         // Consume version from stream
         in.skip(4);
         vassert(
-          -1 == version,
+          version >= -3,
           "topic_configuration version {} is not supported",
           version);
     } else {
@@ -369,6 +403,12 @@ adl<cluster::topic_configuration>::from(iobuf_parser& in) {
         cfg.properties.shadow_indexing
           = adl<std::optional<model::shadow_indexing_mode>>{}.from(in);
     }
+    if (version < -1) {
+        cfg.properties.in_memory = adl<std::optional<bool>>{}.from(in);
+    }
+    if (version < -2) {
+        cfg.properties.write_caching = adl<std::optional<bool>>{}.from(in);
+    }
     return cfg;
 }
 
@@ -41,6 +41,18 @@ struct allocate_id_reply {
     errc ec;
 };
 
+struct allocate_id_range_request {
+    model::timeout_clock::duration timeout;
+    int64_t count;
+};
+
+// the ids of the range are [id, id + count)
+struct allocate_id_range_reply {
+    int64_t id;
+    int64_t count;
+    errc ec;
+};
+
 enum class tx_errc {
     none = 0,
     leader_not_found,
@@ -212,6 +224,20 @@ struct commit_tx_request {
 struct commit_tx_reply {
     tx_errc ec;
 };
+// prepare and commit requests of a coordinator sent to the same node in
+// quick succession are batched together
+struct prepare_tx_batch_request {
+    std::vector<prepare_tx_request> requests;
+};
+struct prepare_tx_batch_reply {
+    std::vector<prepare_tx_reply> replies;
+};
+struct commit_tx_batch_request {
+    std::vector<commit_tx_request> requests;
+};
+struct commit_tx_batch_reply {
+    std::vector<commit_tx_reply> replies;
+};
 struct abort_tx_request {
     model::ntp ntp;
     model::producer_identity pid;
@@ -317,6 +343,8 @@ struct topic_properties {
     tristate<std::chrono::milliseconds> retention_duration{std::nullopt};
     std::optional<bool> recovery;
     std::optional<model::shadow_indexing_mode> shadow_indexing;
+    std::optional<bool> in_memory;
+    std::optional<bool> write_caching;
 
     bool is_compacted() const;
     bool has_overrides() const;
@@ -676,6 +704,81 @@ struct finish_reallocation_reply {
     errc error;
 };
 
+/// Load of the partition replicas hosted by a core
+struct core_load {
+    // bytes appended to the partition logs per second
+    uint64_t bytes_per_sec{0};
+    // size of the partition logs
+    uint64_t disk_bytes{0};
+
+    friend std::ostream& operator<<(std::ostream&, const core_load&);
+};
+
+struct node_load_request {};
+
+/// Load of a partition replica
+struct partition_load {
+    model::ntp ntp;
+    uint64_t bytes_per_sec{0};
+    uint64_t disk_bytes{0};
+};
+
+/// Health of a partition led by the reporting node
+struct partition_health {
+    model::ntp ntp;
+    // followers that are down or are not caught up with the leader
+    uint16_t under_replicated_replicas{0};
+    // offsets the slowest follower is behind the leader log
+    uint64_t max_follower_lag{0};
+};
+
+/// Space of the file system hosting the data directory
+struct disk_space {
+    uint64_t total_bytes{0};
+    uint64_t free_bytes{0};
+};
+
+struct node_load_reply {
+    // load of every core, empty until the node measured its load
+    std::vector<core_load> cores;
+    // heaviest partition replicas of every core
+    std::vector<partition_load> partitions;
+    disk_space disk;
+    // number of partitions led by the node
+    uint32_t leaders{0};
+    // number of partitions led by the node with followers that are not in
+    // sync, only a bounded number of them is reported
+    uint32_t under_replicated_count{0};
+    std::vector<partition_health> under_replicated;
+};
+
+struct cluster_health_overview_request {};
+
+/// Health of a node as seen by the controller leader
+struct node_health_overview {
+    model::node_id id;
+    // the node reported its health during the last collection
+    bool is_alive{false};
+    uint32_t leaders{0};
+    disk_space disk;
+};
+
+/// Summary of the health reports cached by the controller leader. The lists
+/// of partitions are bounded, the counts are not.
+struct cluster_health_overview_reply {
+    errc error{errc::success};
+    model::node_id controller_id;
+    std::vector<node_health_overview> nodes;
+    uint32_t leaderless_count{0};
+    std::vector<model::ntp> leaderless_partitions;
+    uint32_t under_replicated_count{0};
+    std::vector<model::ntp> under_replicated_partitions;
+    // milliseconds elapsed since the reports were collected
+    int64_t age_ms{0};
+
+    bool is_healthy() const;
+};
+
 } // namespace cluster
 namespace std {
 template<>
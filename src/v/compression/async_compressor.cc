@@ -0,0 +1,162 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "compression/async_compressor.h"
+
+#include "compression/compression.h"
+#include "prometheus/prometheus_sanitize.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/future-util.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/preempt.hh>
+#include <seastar/core/with_scheduling_group.hh>
+
+#include <algorithm>
+
+namespace compression {
+
+/// Measures the codec work between the preemption points. The stall time
+/// avoided is the work that ran after the longest uninterrupted part, all of
+/// it would have run as a single task without the preemption points.
+class async_compressor::preemption_tracker {
+    using clock_type = std::chrono::steady_clock;
+
+public:
+    explicit preemption_tracker(probe& p) noexcept
+      : _probe(p)
+      , _span_start(clock_type::now()) {}
+
+    ss::future<> maybe_yield() {
+        if (!ss::need_preempt()) {
+            return ss::now();
+        }
+        end_span();
+        ++_probe.yields;
+        return ss::later().then([this] { _span_start = clock_type::now(); });
+    }
+
+    void finish() {
+        end_span();
+        _probe.stall_time_avoided += _total - _longest;
+    }
+
+private:
+    void end_span() {
+        const auto span = clock_type::now() - _span_start;
+        _total += span;
+        _longest = std::max(_longest, span);
+    }
+
+    probe& _probe;
+    clock_type::time_point _span_start;
+    clock_type::duration _total{0};
+    clock_type::duration _longest{0};
+};
+
+void async_compressor::start(
+  ss::scheduling_group sg, bool disable_metrics, size_t min_async_bytes) {
+    _sg = sg;
+    _min_async_bytes = min_async_bytes;
+    if (!disable_metrics) {
+        setup_metrics();
+    }
+}
+
+void async_compressor::stop() { _metrics.clear(); }
+
+ss::future<iobuf>
+async_compressor::compress(const iobuf& io, model::compression t) {
+    if (io.size_bytes() < _min_async_bytes) {
+        return ss::futurize_invoke(
+          [&io, t] { return compressor::compress(io, t); });
+    }
+    return ss::with_scheduling_group(
+      _sg, [this, &io, t] { return do_compress(io, t); });
+}
+
+ss::future<iobuf>
+async_compressor::uncompress(const iobuf& io, model::compression t) {
+    // the uncompressed size is unknown, small inputs are uncompressed in
+    // parts too but without switching the scheduling group
+    if (io.size_bytes() < _min_async_bytes) {
+        return do_uncompress(io, t);
+    }
+    return ss::with_scheduling_group(
+      _sg, [this, &io, t] { return do_uncompress(io, t); });
+}
+
+ss::future<iobuf>
+async_compressor::do_compress(const iobuf& io, model::compression t) {
+    ++_probe.async_calls;
+    _probe.async_bytes += io.size_bytes();
+    auto c = compressor::make_stream_compressor(io.size_bytes(), t);
+    preemption_tracker tracker(_probe);
+    for (const auto& frag : io) {
+        for (size_t pos = 0; pos < frag.size(); pos += step_bytes) {
+            c->write(
+              // NOLINTNEXTLINE
+              frag.get() + pos,
+              std::min(step_bytes, frag.size() - pos));
+            co_await tracker.maybe_yield();
+        }
+    }
+    tracker.finish();
+    co_return c->finish();
+}
+
+ss::future<iobuf>
+async_compressor::do_uncompress(const iobuf& io, model::compression t) {
+    auto d = compressor::make_stream_decompressor(io, t);
+    ++_probe.async_calls;
+    _probe.async_bytes += io.size_bytes();
+    preemption_tracker tracker(_probe);
+    iobuf ret;
+    for (auto part = d->next(step_bytes); !part.empty();
+         part = d->next(step_bytes)) {
+        ret.append(std::move(part));
+        co_await tracker.maybe_yield();
+    }
+    tracker.finish();
+    co_return ret;
+}
+
+void async_compressor::setup_metrics() {
+    namespace sm = ss::metrics;
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("compression"),
+      {
+        sm::make_derive(
+          "async_calls",
+          [this] { return _probe.async_calls; },
+          sm::description(
+            "Number of codec calls split into parts with preemption points")),
+        sm::make_total_bytes(
+          "async_bytes",
+          [this] { return _probe.async_bytes; },
+          sm::description(
+            "Input bytes of the codec calls split into parts")),
+        sm::make_derive(
+          "yields",
+          [this] { return _probe.yields; },
+          sm::description(
+            "Number of times the codec work yielded to the reactor")),
+        sm::make_derive(
+          "stall_time_avoided_us",
+          [this] {
+              return std::chrono::duration_cast<std::chrono::microseconds>(
+                       _probe.stall_time_avoided)
+                .count();
+          },
+          sm::description("Codec work in microseconds that ran after a "
+                          "preemption point instead of stalling the reactor")),
+      });
+}
+
+} // namespace compression
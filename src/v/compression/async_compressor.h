@@ -0,0 +1,81 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "bytes/iobuf.h"
+#include "model/compression.h"
+#include "seastarx.h"
+#include "units.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/scheduling.hh>
+
+#include <chrono>
+
+namespace compression {
+
+/// Shard local runner of the codec calls that can outlast the task quota of
+/// the reactor, e.g. the recompression done by compaction and coproc.
+///
+/// The codec work is split into parts of step_bytes with preemption points
+/// in between, and the work on large payloads runs in a dedicated low
+/// priority scheduling group once started. Smaller payloads are compressed
+/// inline. The inputs must stay alive until the returned futures resolve.
+class async_compressor {
+public:
+    /// Payloads of at least this size are compressed in the scheduling group
+    static constexpr size_t default_min_async_bytes = 128_KiB;
+    /// Size of the parts between the preemption points
+    static constexpr size_t step_bytes = 64_KiB;
+
+    async_compressor() noexcept = default;
+    async_compressor(const async_compressor&) = delete;
+    async_compressor& operator=(const async_compressor&) = delete;
+    async_compressor(async_compressor&&) = delete;
+    async_compressor& operator=(async_compressor&&) = delete;
+    ~async_compressor() noexcept = default;
+
+    void start(
+      ss::scheduling_group,
+      bool disable_metrics,
+      size_t min_async_bytes = default_min_async_bytes);
+    void stop();
+
+    ss::future<iobuf> compress(const iobuf&, model::compression);
+    ss::future<iobuf> uncompress(const iobuf&, model::compression);
+
+private:
+    class preemption_tracker;
+
+    struct probe {
+        uint64_t async_calls{0};
+        uint64_t async_bytes{0};
+        uint64_t yields{0};
+        std::chrono::steady_clock::duration stall_time_avoided{0};
+    };
+
+    ss::future<iobuf> do_compress(const iobuf&, model::compression);
+    ss::future<iobuf> do_uncompress(const iobuf&, model::compression);
+    void setup_metrics();
+
+    ss::scheduling_group _sg;
+    size_t _min_async_bytes{default_min_async_bytes};
+    probe _probe;
+    ss::metrics::metric_groups _metrics;
+};
+
+inline async_compressor& local_async_compressor() {
+    static thread_local async_compressor compressor;
+    return compressor;
+}
+
+} // namespace compression
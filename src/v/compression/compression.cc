@@ -52,5 +52,46 @@ iobuf compressor::uncompress(const iobuf& io, type t) {
         vassert(false, "Cannot uncompress type {}", t);
     }
 }
+std::unique_ptr<stream_compressor>
+compressor::make_stream_compressor(size_t input_size, type t) {
+    switch (t) {
+    case type::none:
+        throw std::runtime_error("compressor: nothing to compress for 'none'");
+    case type::gzip:
+        return internal::gzip_compressor::make_stream_compressor(input_size);
+    case type::snappy:
+        return internal::snappy_java_compressor::make_stream_compressor(
+          input_size);
+    case type::lz4:
+        return internal::lz4_frame_compressor::make_stream_compressor(
+          input_size);
+    case type::zstd:
+        return internal::zstd_compressor::make_stream_compressor(input_size);
+    default:
+        vassert(false, "Cannot compress type {}", t);
+    }
+}
+std::unique_ptr<stream_decompressor>
+compressor::make_stream_decompressor(const iobuf& io, type t) {
+    if (io.empty()) {
+        throw std::runtime_error(
+          fmt::format("Asked to decomrpess:{} an empty buffer:{}", (int)t, io));
+    }
+    switch (t) {
+    case type::none:
+        throw std::runtime_error(
+          "compressor: nothing to uncompress for 'none'");
+    case type::gzip:
+        return internal::gzip_compressor::make_stream_decompressor(io);
+    case type::snappy:
+        return internal::snappy_java_compressor::make_stream_decompressor(io);
+    case type::lz4:
+        return internal::lz4_frame_compressor::make_stream_decompressor(io);
+    case type::zstd:
+        return internal::zstd_compressor::make_stream_decompressor(io);
+    default:
+        vassert(false, "Cannot uncompress type {}", t);
+    }
+}
 
 } // namespace compression
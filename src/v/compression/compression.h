@@ -11,7 +11,12 @@
 
 #pragma once
 #include "bytes/iobuf.h"
+#include "compression/stream_compressor.h"
+#include "compression/stream_decompressor.h"
 #include "model/compression.h"
+
+#include <memory>
+
 namespace compression {
 
 using type = model::compression;
@@ -21,6 +26,14 @@ using type = model::compression;
 struct compressor {
     static iobuf compress(const iobuf&, type);
     static iobuf uncompress(const iobuf&, type);
+    /// Incremental alternative to compress(), the size of the whole input
+    /// is stored in the frame header by the codecs that support it
+    static std::unique_ptr<stream_compressor>
+    make_stream_compressor(size_t input_size, type);
+    /// Incremental alternative to uncompress(), the input must outlive the
+    /// returned decompressor
+    static std::unique_ptr<stream_decompressor>
+    make_stream_decompressor(const iobuf&, type);
 };
 
 } // namespace compression
@@ -0,0 +1,21 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "compression/internal/context_pool.h"
+
+namespace compression::internal {
+
+// enough for the synchronous calls and a few streaming decompressors
+static thread_local size_t max_pooled_contexts = 4;
+
+size_t context_pool_size() { return max_pooled_contexts; }
+
+void set_context_pool_size(size_t n) { max_pooled_contexts = n; }
+
+} // namespace compression::internal
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace compression::internal {
+
+/// Max number of idle contexts kept per codec on the shard, a new context is
+/// created for every call if 0
+size_t context_pool_size();
+void set_context_pool_size(size_t);
+
+/// Shard local pool of codec contexts. Creating a context allocates the codec
+/// state, which costs about as much as compressing a small batch, so the
+/// contexts are reused across calls. The codec resets the context after
+/// acquiring it.
+template<typename Ctx>
+class context_pool {
+public:
+    using factory_fn = Ctx (*)();
+
+    /// Returns the context to the pool when destroyed
+    class handle {
+    public:
+        handle(context_pool& pool, Ctx ctx) noexcept
+          : _pool(&pool)
+          , _ctx(std::move(ctx)) {}
+        handle(handle&& o) noexcept
+          : _pool(std::exchange(o._pool, nullptr))
+          , _ctx(std::move(o._ctx)) {}
+        handle(const handle&) = delete;
+        handle& operator=(const handle&) = delete;
+        handle& operator=(handle&&) = delete;
+        ~handle() {
+            if (_pool) {
+                _pool->release(std::move(_ctx));
+            }
+        }
+
+        Ctx& get() { return _ctx; }
+
+    private:
+        context_pool* _pool;
+        Ctx _ctx;
+    };
+
+    explicit context_pool(factory_fn f) noexcept
+      : _factory(f) {}
+
+    handle acquire() {
+        // release() never allocates
+        _free.reserve(context_pool_size());
+        if (_free.empty()) {
+            return handle(*this, _factory());
+        }
+        auto ctx = std::move(_free.back());
+        _free.pop_back();
+        return handle(*this, std::move(ctx));
+    }
+
+private:
+    void release(Ctx ctx) noexcept {
+        if (
+          _free.size() < context_pool_size()
+          && _free.size() < _free.capacity()) {
+            _free.push_back(std::move(ctx));
+        }
+    }
+
+    factory_fn _factory;
+    std::vector<Ctx> _free;
+};
+
+} // namespace compression::internal
@@ -10,6 +10,8 @@
 #include "compression/internal/gzip_compressor.h"
 
 #include "bytes/bytes.h"
+#include "compression/internal/context_pool.h"
+#include "units.h"
 #include "vassert.h"
 
 #include <seastar/core/temporary_buffer.hh>
@@ -49,7 +51,11 @@ public:
     operator=(gzip_compression_codec&&) noexcept = delete;
 
     void reset() {
-        vassert(!_init, "Double initialized gzip decompression codec");
+        if (_init) {
+            throw_if_zstream_error(
+              "gzip compress deflateReset error: {}", deflateReset(&_stream));
+            return;
+        }
         _stream = default_zstream();
         throw_if_zstream_error(
           "gzip compress deflateInit2 error: {}",
@@ -76,9 +82,7 @@ private:
 };
 class gzip_decompression_codec {
 public:
-    gzip_decompression_codec(const char* src, size_t src_size) noexcept
-      : _input(src)
-      , _input_size(src_size) {}
+    gzip_decompression_codec() noexcept = default;
     gzip_decompression_codec(const gzip_decompression_codec&) = delete;
     gzip_decompression_codec& operator=(const gzip_decompression_codec&)
       = delete;
@@ -86,17 +90,24 @@ public:
     gzip_decompression_codec&
     operator=(gzip_decompression_codec&&) noexcept = delete;
 
-    void reset() {
-        vassert(!_init, "Double initialized gzip decompression codec");
-        _stream = default_zstream();
+    void reset(const char* src, size_t src_size) {
+        if (!_init) {
+            _stream = default_zstream();
+        }
         // zlib is not const-correct
         // NOLINTNEXTLINE
-        _stream.next_in = (unsigned char*)_input;
-        _stream.avail_in = _input_size;
-        throw_if_zstream_error(
-          "gzip error with inflateInit2:{}", inflateInit2(&_stream, 15 + 32));
-        // marking init must happen before gzip header
-        _init = true;
+        _stream.next_in = (unsigned char*)src;
+        _stream.avail_in = src_size;
+        if (_init) {
+            throw_if_zstream_error(
+              "gzip error with inflateReset:{}", inflateReset(&_stream));
+        } else {
+            throw_if_zstream_error(
+              "gzip error with inflateInit2:{}",
+              inflateInit2(&_stream, 15 + 32));
+            // marking init must happen before gzip header
+            _init = true;
+        }
 
         // last
         throw_if_zstream_error(
@@ -117,16 +128,24 @@ public:
 
 private:
     bool _init{false};
-    const char* _input;
-    size_t _input_size;
     gz_header _hdr; // needed for gzip
     z_stream _stream;
 };
 
+using gzip_compression_ctx = std::unique_ptr<gzip_compression_codec>;
+using gzip_decompression_ctx = std::unique_ptr<gzip_decompression_codec>;
+
+// the codecs are reset instead of being initialized on every call
+static thread_local context_pool<gzip_compression_ctx> deflate_pool(
+  [] { return std::make_unique<gzip_compression_codec>(); });
+static thread_local context_pool<gzip_decompression_ctx> inflate_pool(
+  [] { return std::make_unique<gzip_decompression_codec>(); });
+
 iobuf gzip_compressor::compress(const iobuf& b) {
     ss::temporary_buffer<char> obuf;
     {
-        gzip_compression_codec def;
+        auto ctx = deflate_pool.acquire();
+        gzip_compression_codec& def = *ctx.get();
         def.reset();
         z_stream& strm = def.stream();
         /* Calculate maximum compressed size and
@@ -153,7 +172,7 @@ iobuf gzip_compressor::compress(const iobuf& b) {
             throw_if_zstream_error("gzip error finishing compression: {}", ret);
         }
         obuf.trim(def.stream().total_out);
-        // trigger deflateEnd
+        // return the codec to the pool
     }
     iobuf ret;
     ret.append(std::move(obuf));
@@ -183,10 +202,9 @@ void gzip_decompression_codec::inflate_to(char* output, size_t out_size) {
     } while (_stream.avail_out == 0 && code != Z_STREAM_END);
 }
 
-static ss::temporary_buffer<char>
-buffer_for_input(const char* src, size_t src_size) {
-    auto codec = gzip_decompression_codec(src, src_size);
-    codec.reset();
+static ss::temporary_buffer<char> buffer_for_input(
+  gzip_decompression_codec& codec, const char* src, size_t src_size) {
+    codec.reset(src, src_size);
     std::array<char, 512> dummy_buf{};
     // find gzip header
     codec.inflate_to(dummy_buf.data(), dummy_buf.size());
@@ -196,10 +214,11 @@ buffer_for_input(const char* src, size_t src_size) {
 static iobuf do_uncompress(const char* src, size_t src_size) {
     ss::temporary_buffer<char> buf;
     {
-        auto codec = gzip_decompression_codec(src, src_size);
-        codec.reset();
-        buf = buffer_for_input(src, src_size);
+        auto ctx = inflate_pool.acquire();
+        gzip_decompression_codec& codec = *ctx.get();
+        buf = buffer_for_input(codec, src, src_size);
         // main data decompression
+        codec.reset(src, src_size);
         codec.inflate_to(buf.get_write(), buf.size());
     }
     iobuf ret;
@@ -219,4 +238,130 @@ iobuf gzip_compressor::uncompress(const iobuf& b) {
       reinterpret_cast<const char*>(linearized.data()),
       linearized.size());
 }
+
+namespace {
+class gzip_stream_compressor final : public stream_compressor {
+    static constexpr size_t output_step = 32_KiB;
+
+public:
+    gzip_stream_compressor()
+      : _codec(deflate_pool.acquire())
+      , _stream(_codec.get()->stream()) {
+        _codec.get()->reset();
+        reset_output();
+    }
+
+    void write(const char* src, size_t size) final {
+        // zlib is not const correct
+        // NOLINTNEXTLINE
+        _stream.next_in = (unsigned char*)src;
+        _stream.avail_in = size;
+        while (_stream.avail_in != 0) {
+            throw_if_zstream_error(
+              "gzip error compressing chunk: {}",
+              deflate(&_stream, Z_NO_FLUSH));
+            maybe_flush_output();
+        }
+    }
+
+    iobuf finish() final {
+        int code = Z_OK;
+        do {
+            code = deflate(&_stream, Z_FINISH);
+            if (code != Z_STREAM_END) {
+                throw_if_zstream_error(
+                  "gzip error finishing compression: {}", code);
+            }
+            maybe_flush_output();
+        } while (code != Z_STREAM_END);
+        _obuf.trim(_obuf.size() - _stream.avail_out);
+        _ret.append(std::move(_obuf));
+        return std::move(_ret);
+    }
+
+private:
+    void reset_output() {
+        _obuf = ss::temporary_buffer<char>(output_step);
+        // NOLINTNEXTLINE
+        _stream.next_out = reinterpret_cast<unsigned char*>(_obuf.get_write());
+        _stream.avail_out = _obuf.size();
+    }
+    void maybe_flush_output() {
+        if (_stream.avail_out == 0) {
+            _ret.append(std::move(_obuf));
+            reset_output();
+        }
+    }
+
+    context_pool<gzip_compression_ctx>::handle _codec;
+    z_stream& _stream;
+    ss::temporary_buffer<char> _obuf;
+    iobuf _ret;
+};
+
+class gzip_stream_decompressor final : public stream_decompressor {
+public:
+    explicit gzip_stream_decompressor(const iobuf& input)
+      : stream_decompressor(input)
+      , _codec(inflate_pool.acquire())
+      , _stream(_codec.get()->stream()) {
+        // the input is set fragment by fragment
+        _codec.get()->reset(nullptr, 0);
+    }
+
+    iobuf next(size_t max_bytes) final {
+        iobuf ret;
+        if (is_eof()) {
+            return ret;
+        }
+        ss::temporary_buffer<char> obuf(max_bytes);
+        // NOLINTNEXTLINE
+        _stream.next_out = reinterpret_cast<unsigned char*>(obuf.get_write());
+        _stream.avail_out = obuf.size();
+        while (_stream.avail_out != 0) {
+            auto src = input();
+            // zlib is not const correct
+            // NOLINTNEXTLINE
+            _stream.next_in = (unsigned char*)src.data();
+            _stream.avail_in = src.size();
+            const auto avail_out = _stream.avail_out;
+            int code = inflate(&_stream, Z_NO_FLUSH);
+            consume(src.size() - _stream.avail_in);
+            switch (code) {
+            case Z_STREAM_ERROR:
+            case Z_NEED_DICT:
+            case Z_DATA_ERROR:
+            case Z_MEM_ERROR:
+                throw_zstream_error("gzip uncmpress error:{}", code);
+            default: /*do nothing*/;
+            }
+            if (code == Z_STREAM_END) {
+                set_eof();
+                break;
+            }
+            if (src.empty() && _stream.avail_out == avail_out) {
+                throw std::runtime_error(
+                  "gzip error. input ended before the end of the stream");
+            }
+        }
+        obuf.trim(obuf.size() - _stream.avail_out);
+        ret.append(std::move(obuf));
+        return ret;
+    }
+
+private:
+    context_pool<gzip_decompression_ctx>::handle _codec;
+    z_stream& _stream;
+};
+} // namespace
+
+std::unique_ptr<stream_compressor>
+gzip_compressor::make_stream_compressor(size_t) {
+    return std::make_unique<gzip_stream_compressor>();
+}
+
+std::unique_ptr<stream_decompressor>
+gzip_compressor::make_stream_decompressor(const iobuf& b) {
+    return std::make_unique<gzip_stream_decompressor>(b);
+}
 } // namespace compression::internal
@@ -10,6 +10,7 @@
 #include "compression/internal/lz4_frame_compressor.h"
 
 #include "bytes/bytes.h"
+#include "compression/internal/context_pool.h"
 #include "compression/logger.h"
 #include "static_deleter_fn.h"
 #include "units.h"
@@ -66,15 +67,33 @@ static lz4_decompression_ctx make_decompression_context() {
     return lz4_decompression_ctx(c);
 }
 
-iobuf lz4_frame_compressor::compress(const iobuf& b) {
-    auto ctx_ptr = make_compression_context();
-    LZ4F_compressionContext_t ctx = ctx_ptr.get();
+// LZ4F_compressBegin resets the compression context
+static thread_local context_pool<lz4_compression_ctx>
+  cctx_pool(make_compression_context);
+static thread_local context_pool<lz4_decompression_ctx>
+  dctx_pool(make_decompression_context);
+
+static context_pool<lz4_decompression_ctx>::handle acquire_dctx() {
+    auto ctx = dctx_pool.acquire();
+    // might have been released in the middle of a frame
+    LZ4F_resetDecompressionContext(ctx.get().get());
+    return ctx;
+}
+
+static LZ4F_preferences_t make_preferences(size_t input_size) {
     /* Required by Kafka */
     LZ4F_preferences_t prefs;
     std::memset(&prefs, 0, sizeof(prefs));
     prefs.compressionLevel = 1; // default
     prefs.frameInfo = {
-      .blockMode = LZ4F_blockIndependent, .contentSize = b.size_bytes()};
+      .blockMode = LZ4F_blockIndependent, .contentSize = input_size};
+    return prefs;
+}
+
+iobuf lz4_frame_compressor::compress(const iobuf& b) {
+    auto ctx_ptr = cctx_pool.acquire();
+    LZ4F_compressionContext_t ctx = ctx_ptr.get().get();
+    const LZ4F_preferences_t prefs = make_preferences(b.size_bytes());
     const size_t output_buffer_size = LZ4F_compressBound(b.size_bytes(), &prefs)
                                       + lz4f_footer_size + lz4f_header_size;
     check_lz4_error("lz4_compressbound erorr:{}", output_buffer_size);
@@ -121,8 +140,8 @@ compute_frame_uncompressed_size(size_t frame_size, size_t original) {
 }
 
 static iobuf do_uncompressed(const char* src, const size_t src_size) {
-    auto ctx_ptr = make_decompression_context();
-    LZ4F_decompressionContext_t ctx = ctx_ptr.get();
+    auto ctx_ptr = acquire_dctx();
+    LZ4F_decompressionContext_t ctx = ctx_ptr.get().get();
     LZ4F_frameInfo_t fi;
     size_t in_sz = src_size;
     LZ4F_errorCode_t code = LZ4F_getFrameInfo(ctx, &fi, src, &in_sz);
@@ -212,4 +231,108 @@ iobuf lz4_frame_compressor::uncompress(const iobuf& b) {
       linearized.size());
 }
 
+namespace {
+class lz4_frame_stream_compressor final : public stream_compressor {
+public:
+    explicit lz4_frame_stream_compressor(size_t input_size)
+      : _ctx(cctx_pool.acquire())
+      , _prefs(make_preferences(input_size)) {
+        ss::temporary_buffer<char> obuf(lz4f_header_size);
+        LZ4F_errorCode_t code = LZ4F_compressBegin(
+          _ctx.get().get(), obuf.get_write(), obuf.size(), &_prefs);
+        check_lz4_error("lz4f_compressbegin error:{}", code);
+        obuf.trim(code);
+        _ret.append(std::move(obuf));
+    }
+
+    void write(const char* src, size_t size) final {
+        ss::temporary_buffer<char> obuf(LZ4F_compressBound(size, &_prefs));
+        LZ4F_errorCode_t code = LZ4F_compressUpdate(
+          _ctx.get().get(), obuf.get_write(), obuf.size(), src, size, nullptr);
+        check_lz4_error("lz4f_compressupdate error:{}", code);
+        obuf.trim(code);
+        _ret.append(std::move(obuf));
+    }
+
+    iobuf finish() final {
+        // flushes the buffered input
+        ss::temporary_buffer<char> obuf(
+          LZ4F_compressBound(0, &_prefs) + lz4f_footer_size);
+        LZ4F_errorCode_t code = LZ4F_compressEnd(
+          _ctx.get().get(), obuf.get_write(), obuf.size(), nullptr);
+        check_lz4_error("lz4f_compressend:{}", code);
+        obuf.trim(code);
+        _ret.append(std::move(obuf));
+        return std::move(_ret);
+    }
+
+private:
+    context_pool<lz4_compression_ctx>::handle _ctx;
+    LZ4F_preferences_t _prefs;
+    iobuf _ret;
+};
+
+class lz4_frame_stream_decompressor final : public stream_decompressor {
+public:
+    explicit lz4_frame_stream_decompressor(const iobuf& input)
+      : stream_decompressor(input)
+      , _ctx(acquire_dctx()) {}
+
+    iobuf next(size_t max_bytes) final {
+        iobuf ret;
+        if (is_eof()) {
+            return ret;
+        }
+        ss::temporary_buffer<char> obuf(max_bytes);
+        size_t consumed_bytes = 0;
+        while (consumed_bytes != obuf.size()) {
+            auto src = input();
+            size_t step_output_bytes = obuf.size() - consumed_bytes;
+            size_t step_input_bytes = src.size();
+            LZ4F_errorCode_t code = LZ4F_decompress(
+              _ctx.get().get(),
+              // NOLINTNEXTLINE
+              obuf.get_write() + consumed_bytes,
+              &step_output_bytes,
+              src.data(),
+              &step_input_bytes,
+              nullptr);
+            check_lz4_error("lz4f_decompress error: {}", code);
+            consume(step_input_bytes);
+            consumed_bytes += step_output_bytes;
+            if (code == 0) {
+                // end of the frame
+                if (unlikely(!is_input_consumed())) {
+                    throw std::runtime_error(
+                      "lz4 error. could not consume all input bytes in "
+                      "decompression");
+                }
+                set_eof();
+                break;
+            }
+            if (src.empty() && step_output_bytes == 0) {
+                throw std::runtime_error(
+                  "lz4 error. input ended before the end of the frame");
+            }
+        }
+        obuf.trim(consumed_bytes);
+        ret.append(std::move(obuf));
+        return ret;
+    }
+
+private:
+    context_pool<lz4_decompression_ctx>::handle _ctx;
+};
+} // namespace
+
+std::unique_ptr<stream_compressor>
+lz4_frame_compressor::make_stream_compressor(size_t input_size) {
+    return std::make_unique<lz4_frame_stream_compressor>(input_size);
+}
+
+std::unique_ptr<stream_decompressor>
+lz4_frame_compressor::make_stream_decompressor(const iobuf& b) {
+    return std::make_unique<lz4_frame_stream_decompressor>(b);
+}
+
 } // namespace compression::internal
@@ -55,12 +55,16 @@ void append_le(iobuf& o, T t) {
     // NOLINTNEXTLINE
     o.append((const char*)&x, sizeof(x));
 }
-iobuf snappy_java_compressor::compress(const iobuf& x) {
-    iobuf ret;
+static void append_java_header(iobuf& ret) {
     ret.append(
       snappy_magic::java_magic.data(), snappy_magic::java_magic.size());
     append_le(ret, snappy_magic::default_version);
     append_le(ret, snappy_magic::min_compatible_version);
+}
+
+iobuf snappy_java_compressor::compress(const iobuf& x) {
+    iobuf ret;
+    append_java_header(ret);
     // staging buffer
     ss::temporary_buffer<char> obuf(find_max_size_in_frags(x));
     for (const auto& f : x) {
@@ -73,15 +77,17 @@ iobuf snappy_java_compressor::compress(const iobuf& x) {
     }
     return ret;
 }
-iobuf snappy_java_compressor::uncompress(const iobuf& x) {
-    auto iter = details::io_iterator_consumer(x.cbegin(), x.cend());
+/// Consumes the snappy-java header, returns false if the input is in the
+/// standard snappy format
+static bool
+consume_java_header(details::io_iterator_consumer& iter, const iobuf& x) {
     if (unlikely(x.size_bytes() < snappy_magic::header_len)) {
-        return snappy_standard_compressor::uncompress(x);
+        return false;
     }
     std::array<uint8_t, snappy_magic::java_magic.size()> magic_compare{};
     iter.consume_to(magic_compare.size(), magic_compare.data());
     if (unlikely(snappy_magic::java_magic != magic_compare)) {
-        return snappy_standard_compressor::uncompress(x);
+        return false;
     }
     // NOTE: version and min_version are LITTLE_ENDIAN!
     const auto version = iter.consume_type<int32_t>();
@@ -94,38 +100,120 @@ iobuf snappy_java_compressor::uncompress(const iobuf& x) {
           version,
           min_version));
     }
+    return true;
+}
+
+/// Decompresses the next snappy-java frame and appends it to `ret`
+static void uncompress_frame(
+  details::io_iterator_consumer& iter, const iobuf& x, iobuf& ret) {
+    auto compressed_length = iter.consume_be_type<int32_t>();
+    auto chunk = ss::uninitialized_string<bytes>(compressed_length);
+    iter.consume_to(chunk.size(), chunk.data());
+    size_t output_size = 0;
+    if (unlikely(!::snappy::GetUncompressedLength(
+          // NOLINTNEXTLINE
+          reinterpret_cast<const char*>(chunk.data()),
+          chunk.size(),
+          &output_size))) {
+        throw std::runtime_error(fmt::format(
+          "Could not find uncompressed size from input buffer of size: {}",
+          chunk.size()));
+    }
+    auto ph = ret.reserve(output_size);
+    char* output = ph.mutable_index();
+    if (!::snappy::RawUncompress(
+          // NOLINTNEXTLINE
+          reinterpret_cast<const char*>(chunk.data()),
+          chunk.size(),
+          output)) {
+        throw std::runtime_error(fmt_with_ctx(
+          fmt::format,
+          "snappy: Could not decompress frame: {}, from:{}",
+          chunk.size(),
+          x));
+    }
+}
+
+iobuf snappy_java_compressor::uncompress(const iobuf& x) {
+    auto iter = details::io_iterator_consumer(x.cbegin(), x.cend());
+    if (!consume_java_header(iter, x)) {
+        return snappy_standard_compressor::uncompress(x);
+    }
     // stream decoder next
     iobuf ret;
     const size_t input_bytes = x.size_bytes();
     while (iter.bytes_consumed() != input_bytes) {
-        auto compressed_length = iter.consume_be_type<int32_t>();
-        auto chunk = ss::uninitialized_string<bytes>(compressed_length);
-        iter.consume_to(chunk.size(), chunk.data());
-        size_t output_size = 0;
-        if (unlikely(!::snappy::GetUncompressedLength(
-              // NOLINTNEXTLINE
-              reinterpret_cast<const char*>(chunk.data()),
-              chunk.size(),
-              &output_size))) {
-            throw std::runtime_error(fmt::format(
-              "Could not find uncompressed size from input buffer of size: {}",
-              chunk.size()));
+        uncompress_frame(iter, x, ret);
+    }
+    return ret;
+}
+
+namespace {
+/// Every written part is compressed into its own snappy-java frame
+class snappy_java_stream_compressor final : public stream_compressor {
+public:
+    snappy_java_stream_compressor() { append_java_header(_ret); }
+
+    void write(const char* src, size_t size) final {
+        ss::temporary_buffer<char> obuf(snappy::MaxCompressedLength(size));
+        size_t omax = obuf.size();
+        snappy::RawCompress(src, size, obuf.get_write(), &omax);
+        // must be int32 to be compatible && in big endian
+        append_be(_ret, int32_t(omax));
+        obuf.trim(omax);
+        _ret.append(std::move(obuf));
+    }
+
+    iobuf finish() final { return std::move(_ret); }
+
+private:
+    iobuf _ret;
+};
+
+/// snappy-java frames are decompressed one at a time, the memory used is
+/// bounded by the frame size (32KiB for the java client). The standard
+/// snappy format has no framing and is decompressed at once.
+class snappy_java_stream_decompressor final : public stream_decompressor {
+public:
+    explicit snappy_java_stream_decompressor(const iobuf& input)
+      : stream_decompressor(input)
+      , _input(input)
+      , _iter(input.cbegin(), input.cend()) {
+        if (!consume_java_header(_iter, _input)) {
+            _frame = snappy_standard_compressor::uncompress(_input);
+            _iter.skip(_input.size_bytes() - _iter.bytes_consumed());
         }
-        auto ph = ret.reserve(output_size);
-        char* output = ph.mutable_index();
-        if (!::snappy::RawUncompress(
-              // NOLINTNEXTLINE
-              reinterpret_cast<const char*>(chunk.data()),
-              chunk.size(),
-              output)) {
-            throw std::runtime_error(fmt_with_ctx(
-              fmt::format,
-              "snappy: Could not decompress frame: {}, from:{}",
-              chunk.size(),
-              x));
+    }
+
+    iobuf next(size_t max_bytes) final {
+        if (_frame.empty() && _iter.bytes_consumed() != _input.size_bytes()) {
+            uncompress_frame(_iter, _input, _frame);
         }
+        auto n = std::min(max_bytes, _frame.size_bytes());
+        auto ret = _frame.share(0, n);
+        _frame.trim_front(n);
+        if (_frame.empty() && _iter.bytes_consumed() == _input.size_bytes()) {
+            set_eof();
+        }
+        return ret;
     }
-    return ret;
+
+private:
+    const iobuf& _input;
+    details::io_iterator_consumer _iter;
+    // uncompressed frame not returned yet
+    iobuf _frame;
+};
+} // namespace
+
+std::unique_ptr<stream_compressor>
+snappy_java_compressor::make_stream_compressor(size_t) {
+    return std::make_unique<snappy_java_stream_compressor>();
+}
+
+std::unique_ptr<stream_decompressor>
+snappy_java_compressor::make_stream_decompressor(const iobuf& x) {
+    return std::make_unique<snappy_java_stream_decompressor>(x);
 }
 
 } // namespace compression::internal
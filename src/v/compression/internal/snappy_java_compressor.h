@@ -12,11 +12,19 @@
 #pragma once
 
 #include "bytes/iobuf.h"
+#include "compression/stream_compressor.h"
+#include "compression/stream_decompressor.h"
+
+#include <memory>
 
 namespace compression::internal {
 struct snappy_java_compressor {
     static iobuf compress(const iobuf&);
     static iobuf uncompress(const iobuf&);
+    static std::unique_ptr<stream_compressor>
+    make_stream_compressor(size_t input_size);
+    static std::unique_ptr<stream_decompressor>
+    make_stream_decompressor(const iobuf&);
 };
 
 } // namespace compression::internal
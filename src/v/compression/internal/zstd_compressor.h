@@ -23,6 +23,14 @@ struct zstd_compressor {
         stream_zstd fn;
         return fn.uncompress(b);
     }
+    static std::unique_ptr<stream_compressor>
+    make_stream_compressor(size_t input_size) {
+        return stream_zstd::make_stream_compressor(input_size);
+    }
+    static std::unique_ptr<stream_decompressor>
+    make_stream_decompressor(const iobuf& b) {
+        return stream_zstd::make_stream_decompressor(b);
+    }
 };
 
 } // namespace compression::internal
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "bytes/iobuf.h"
+
+namespace compression {
+
+/// Push based compression, the input is compressed part by part into a
+/// single frame in the same format as the output of compressor::compress()
+class stream_compressor {
+public:
+    stream_compressor() noexcept = default;
+    stream_compressor(const stream_compressor&) = delete;
+    stream_compressor& operator=(const stream_compressor&) = delete;
+    stream_compressor(stream_compressor&&) = delete;
+    stream_compressor& operator=(stream_compressor&&) = delete;
+    virtual ~stream_compressor() = default;
+
+    /// Compresses the next part of the input
+    virtual void write(const char* src, size_t size) = 0;
+
+    /// Completes the frame and returns the compressed data, the compressor
+    /// can't be used afterwards
+    virtual iobuf finish() = 0;
+};
+
+} // namespace compression
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "bytes/iobuf.h"
+
+#include <string_view>
+
+namespace compression {
+
+/// Pull based decompression of a compressed buffer. The uncompressed data is
+/// returned in parts of bounded size so that the whole uncompressed payload
+/// never has to be allocated at once.
+///
+/// The compressed input is not copied, it must outlive the decompressor.
+class stream_decompressor {
+public:
+    explicit stream_decompressor(const iobuf& input) noexcept
+      : _frag(input.cbegin())
+      , _end(input.cend()) {}
+    stream_decompressor(const stream_decompressor&) = delete;
+    stream_decompressor& operator=(const stream_decompressor&) = delete;
+    stream_decompressor(stream_decompressor&&) = delete;
+    stream_decompressor& operator=(stream_decompressor&&) = delete;
+    virtual ~stream_decompressor() = default;
+
+    /// Next part of the uncompressed data, at most max_bytes long and
+    /// empty only once all of the data was returned
+    virtual iobuf next(size_t max_bytes) = 0;
+
+    /// True once all of the uncompressed data was returned
+    bool is_eof() const { return _eof; }
+
+protected:
+    /// Contiguous part of the input not consumed yet, empty at the end of
+    /// the input
+    std::string_view input() {
+        while (_frag != _end && _frag_pos == _frag->size()) {
+            ++_frag;
+            _frag_pos = 0;
+        }
+        if (_frag == _end) {
+            return {};
+        }
+        // NOLINTNEXTLINE
+        return {_frag->get() + _frag_pos, _frag->size() - _frag_pos};
+    }
+    /// Marks n bytes of the view returned by input() as consumed
+    void consume(size_t n) { _frag_pos += n; }
+    bool is_input_consumed() { return input().empty(); }
+    void set_eof() { _eof = true; }
+
+private:
+    iobuf::const_iterator _frag;
+    iobuf::const_iterator _end;
+    size_t _frag_pos{0};
+    bool _eof{false};
+};
+
+} // namespace compression
@@ -11,6 +11,7 @@
 
 #include "bytes/bytes.h"
 #include "bytes/details/io_allocation_size.h"
+#include "compression/internal/context_pool.h"
 #include "compression/logger.h"
 #include "likely.h"
 #include "units.h"
@@ -53,19 +54,32 @@ void stream_zstd::init_workspace(size_t size) {
     }
 }
 
-void stream_zstd::reset_compressor() {
-    _compress.reset(ZSTD_createCCtx());
-    if (!_compress) {
+using zstd_decompress_ctx = std::unique_ptr<
+  ZSTD_DCtx,
+  // wrap ZSTD C API
+  static_sized_deleter_fn<ZSTD_DCtx, &ZSTD_freeDCtx>>;
+
+static stream_zstd::zstd_compress_ctx make_compress_ctx() {
+    stream_zstd::zstd_compress_ctx ctx(ZSTD_createCCtx());
+    if (!ctx) {
         throw std::bad_alloc{};
     }
+    return ctx;
 }
-stream_zstd::zstd_compress_ctx& stream_zstd::compressor() {
-    if (!_compress) {
-        reset_compressor();
+static zstd_decompress_ctx make_decompress_ctx() {
+    zstd_decompress_ctx ctx(ZSTD_createDCtx());
+    if (!ctx) {
+        throw std::bad_alloc{};
     }
-    return _compress;
+    return ctx;
 }
 
+// the contexts keep their internal buffers between the calls
+static thread_local internal::context_pool<stream_zstd::zstd_compress_ctx>
+  cctx_pool(make_compress_ctx);
+static thread_local internal::context_pool<zstd_decompress_ctx>
+  dctx_pool(make_decompress_ctx);
+
 ZSTD_DCtx* stream_zstd::decompressor() {
     if (unlikely(!dctx_workspace)) {
         /*
@@ -82,8 +96,9 @@ ZSTD_DCtx* stream_zstd::decompressor() {
 }
 
 iobuf stream_zstd::do_compress(const iobuf& x) {
-    reset_compressor();
-    ZSTD_CCtx* ctx = compressor().get();
+    auto cctx = cctx_pool.acquire();
+    ZSTD_CCtx* ctx = cctx.get().get();
+    throw_if_error(ZSTD_CCtx_reset(ctx, ZSTD_reset_session_and_parameters));
     // NOTE: always enable content size. **decompression** depends on this
     throw_if_error(ZSTD_CCtx_setPledgedSrcSize(ctx, x.size_bytes()));
     // zstd requires linearized memory
@@ -176,4 +191,118 @@ iobuf stream_zstd::do_uncompress(const iobuf& x) {
     return ret;
 }
 
+namespace {
+class zstd_stream_compressor final : public stream_compressor {
+public:
+    explicit zstd_stream_compressor(size_t input_size)
+      : _ctx(cctx_pool.acquire()) {
+        ZSTD_CCtx* ctx = _ctx.get().get();
+        throw_if_error(
+          ZSTD_CCtx_reset(ctx, ZSTD_reset_session_and_parameters));
+        // NOTE: always enable content size. **decompression** depends on this
+        throw_if_error(ZSTD_CCtx_setPledgedSrcSize(ctx, input_size));
+        reset_output();
+    }
+
+    void write(const char* src, size_t size) final {
+        ZSTD_inBuffer in = {.src = src, .size = size, .pos = 0};
+        while (in.pos != in.size) {
+            throw_if_error(ZSTD_compressStream2(
+              _ctx.get().get(), &_out, &in, ZSTD_e_continue));
+            maybe_flush_output();
+        }
+    }
+
+    iobuf finish() final {
+        ZSTD_inBuffer in = {.src = nullptr, .size = 0, .pos = 0};
+        size_t remaining = 0;
+        do {
+            remaining = ZSTD_compressStream2(
+              _ctx.get().get(), &_out, &in, ZSTD_e_end);
+            throw_if_error(remaining);
+            maybe_flush_output();
+        } while (remaining != 0);
+        _obuf.trim(_out.pos);
+        _ret.append(std::move(_obuf));
+        return std::move(_ret);
+    }
+
+private:
+    void reset_output() {
+        _obuf = ss::temporary_buffer<char>(ZSTD_CStreamOutSize());
+        _out = {.dst = _obuf.get_write(), .size = _obuf.size(), .pos = 0};
+    }
+    void maybe_flush_output() {
+        if (_out.pos == _out.size) {
+            _ret.append(std::move(_obuf));
+            reset_output();
+        }
+    }
+
+    internal::context_pool<stream_zstd::zstd_compress_ctx>::handle _ctx;
+    ss::temporary_buffer<char> _obuf;
+    ZSTD_outBuffer _out{};
+    iobuf _ret;
+};
+
+class zstd_stream_decompressor final : public stream_decompressor {
+public:
+    explicit zstd_stream_decompressor(const iobuf& input)
+      : stream_decompressor(input)
+      , _ctx(dctx_pool.acquire()) {
+        throw_if_error(
+          ZSTD_DCtx_reset(_ctx.get().get(), ZSTD_reset_session_only));
+    }
+
+    iobuf next(size_t max_bytes) final {
+        iobuf ret;
+        if (is_eof()) {
+            return ret;
+        }
+        ss::temporary_buffer<char> obuf(max_bytes);
+        ZSTD_outBuffer out = {
+          .dst = obuf.get_write(), .size = obuf.size(), .pos = 0};
+        while (out.pos != out.size) {
+            auto src = input();
+            ZSTD_inBuffer in = {
+              .src = src.data(), .size = src.size(), .pos = 0};
+            const size_t out_pos = out.pos;
+            const size_t rc = ZSTD_decompressStream(
+              _ctx.get().get(), &out, &in);
+            throw_if_error(rc);
+            consume(in.pos);
+            if (rc == 0 && is_input_consumed()) {
+                // frame fully decoded and flushed
+                set_eof();
+                break;
+            }
+            if (src.empty() && out.pos == out_pos) {
+                throw std::runtime_error(
+                  "ZSTD error: input ended before the end of the frame");
+            }
+        }
+        obuf.trim(out.pos);
+        ret.append(std::move(obuf));
+        return ret;
+    }
+
+private:
+    internal::context_pool<zstd_decompress_ctx>::handle _ctx;
+};
+} // namespace
+
+std::unique_ptr<stream_compressor>
+stream_zstd::make_stream_compressor(size_t input_size) {
+    return std::make_unique<zstd_stream_compressor>(input_size);
+}
+
+std::unique_ptr<stream_decompressor>
+stream_zstd::make_stream_decompressor(const iobuf& x) {
+    if (unlikely(x.empty())) {
+        throw std::runtime_error(
+          "Asked to stream_zstd::uncompress empty buffer");
+    }
+    return std::make_unique<zstd_stream_decompressor>(x);
+}
+
 } // namespace compression
@@ -11,6 +11,8 @@
 
 #pragma once
 #include "bytes/iobuf.h"
+#include "compression/stream_compressor.h"
+#include "compression/stream_decompressor.h"
 #include "static_deleter_fn.h"
 
 #include <memory>
@@ -31,15 +33,19 @@ public:
 
     static void init_workspace(size_t);
 
+    static std::unique_ptr<stream_compressor>
+    make_stream_compressor(size_t input_size);
+
+    /// The decompressor holds a pooled context, unlike uncompress() it
+    /// doesn't use the shared workspace since it outlives the call
+    static std::unique_ptr<stream_decompressor>
+    make_stream_decompressor(const iobuf&);
+
 private:
     iobuf do_compress(const iobuf&);
     iobuf do_uncompress(const iobuf&);
 
-    void reset_compressor();
-    zstd_compress_ctx& compressor();
     ZSTD_DCtx* decompressor();
-
-    zstd_compress_ctx _compress{nullptr};
 };
 
 } // namespace compression
@@ -0,0 +1,160 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "compression/compression.h"
+#include "compression/internal/context_pool.h"
+#include "random/generators.h"
+#include "units.h"
+
+#include <seastar/testing/perf_tests.hh>
+#include <seastar/util/defer.hh>
+
+static inline iobuf gen(const size_t data_size) {
+    const auto data = random_generators::gen_alphanum_string(512);
+    iobuf ret;
+    size_t i = data_size;
+    while (i > 0) {
+        const auto step = std::min<size_t>(i, data.size());
+        ret.append(data.data(), step);
+        i -= step;
+    }
+    return ret;
+}
+
+enum class pooling { pooled, per_call };
+enum class op { compress, uncompress };
+
+// per_call disables the shard local pools of the codec contexts so that a
+// context is created for every call
+static void run(compression::type t, size_t data_size, pooling p, op o) {
+    using compression::compressor;
+    namespace ci = compression::internal;
+    const auto pool_size = ci::context_pool_size();
+    ci::set_context_pool_size(p == pooling::pooled ? pool_size : 0);
+    auto restore = ss::defer(
+      [pool_size] { ci::set_context_pool_size(pool_size); });
+    auto data = gen(data_size);
+    auto compressed = compressor::compress(data, t);
+    perf_tests::start_measuring_time();
+    if (o == op::compress) {
+        perf_tests::do_not_optimize(compressor::compress(data, t));
+    } else {
+        perf_tests::do_not_optimize(compressor::uncompress(compressed, t));
+    }
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(gzip_1kib, compress_pooled) {
+    run(compression::type::gzip, 1_KiB, pooling::pooled, op::compress);
+}
+PERF_TEST(gzip_1kib, compress_per_call) {
+    run(compression::type::gzip, 1_KiB, pooling::per_call, op::compress);
+}
+PERF_TEST(gzip_1kib, uncompress_pooled) {
+    run(compression::type::gzip, 1_KiB, pooling::pooled, op::uncompress);
+}
+PERF_TEST(gzip_1kib, uncompress_per_call) {
+    run(compression::type::gzip, 1_KiB, pooling::per_call, op::uncompress);
+}
+PERF_TEST(gzip_64kib, compress_pooled) {
+    run(compression::type::gzip, 64_KiB, pooling::pooled, op::compress);
+}
+PERF_TEST(gzip_64kib, compress_per_call) {
+    run(compression::type::gzip, 64_KiB, pooling::per_call, op::compress);
+}
+PERF_TEST(gzip_64kib, uncompress_pooled) {
+    run(compression::type::gzip, 64_KiB, pooling::pooled, op::uncompress);
+}
+PERF_TEST(gzip_64kib, uncompress_per_call) {
+    run(compression::type::gzip, 64_KiB, pooling::per_call, op::uncompress);
+}
+PERF_TEST(gzip_1mib, compress_pooled) {
+    run(compression::type::gzip, 1_MiB, pooling::pooled, op::compress);
+}
+PERF_TEST(gzip_1mib, compress_per_call) {
+    run(compression::type::gzip, 1_MiB, pooling::per_call, op::compress);
+}
+PERF_TEST(gzip_1mib, uncompress_pooled) {
+    run(compression::type::gzip, 1_MiB, pooling::pooled, op::uncompress);
+}
+PERF_TEST(gzip_1mib, uncompress_per_call) {
+    run(compression::type::gzip, 1_MiB, pooling::per_call, op::uncompress);
+}
+PERF_TEST(lz4_1kib, compress_pooled) {
+    run(compression::type::lz4, 1_KiB, pooling::pooled, op::compress);
+}
+PERF_TEST(lz4_1kib, compress_per_call) {
+    run(compression::type::lz4, 1_KiB, pooling::per_call, op::compress);
+}
+PERF_TEST(lz4_1kib, uncompress_pooled) {
+    run(compression::type::lz4, 1_KiB, pooling::pooled, op::uncompress);
+}
+PERF_TEST(lz4_1kib, uncompress_per_call) {
+    run(compression::type::lz4, 1_KiB, pooling::per_call, op::uncompress);
+}
+PERF_TEST(lz4_64kib, compress_pooled) {
+    run(compression::type::lz4, 64_KiB, pooling::pooled, op::compress);
+}
+PERF_TEST(lz4_64kib, compress_per_call) {
+    run(compression::type::lz4, 64_KiB, pooling::per_call, op::compress);
+}
+PERF_TEST(lz4_64kib, uncompress_pooled) {
+    run(compression::type::lz4, 64_KiB, pooling::pooled, op::uncompress);
+}
+PERF_TEST(lz4_64kib, uncompress_per_call) {
+    run(compression::type::lz4, 64_KiB, pooling::per_call, op::uncompress);
+}
+PERF_TEST(lz4_1mib, compress_pooled) {
+    run(compression::type::lz4, 1_MiB, pooling::pooled, op::compress);
+}
+PERF_TEST(lz4_1mib, compress_per_call) {
+    run(compression::type::lz4, 1_MiB, pooling::per_call, op::compress);
+}
+PERF_TEST(lz4_1mib, uncompress_pooled) {
+    run(compression::type::lz4, 1_MiB, pooling::pooled, op::uncompress);
+}
+PERF_TEST(lz4_1mib, uncompress_per_call) {
+    run(compression::type::lz4, 1_MiB, pooling::per_call, op::uncompress);
+}
+PERF_TEST(zstd_1kib, compress_pooled) {
+    run(compression::type::zstd, 1_KiB, pooling::pooled, op::compress);
+}
+PERF_TEST(zstd_1kib, compress_per_call) {
+    run(compression::type::zstd, 1_KiB, pooling::per_call, op::compress);
+}
+PERF_TEST(zstd_1kib, uncompress_pooled) {
+    run(compression::type::zstd, 1_KiB, pooling::pooled, op::uncompress);
+}
+PERF_TEST(zstd_1kib, uncompress_per_call) {
+    run(compression::type::zstd, 1_KiB, pooling::per_call, op::uncompress);
+}
+PERF_TEST(zstd_64kib, compress_pooled) {
+    run(compression::type::zstd, 64_KiB, pooling::pooled, op::compress);
+}
+PERF_TEST(zstd_64kib, compress_per_call) {
+    run(compression::type::zstd, 64_KiB, pooling::per_call, op::compress);
+}
+PERF_TEST(zstd_64kib, uncompress_pooled) {
+    run(compression::type::zstd, 64_KiB, pooling::pooled, op::uncompress);
+}
+PERF_TEST(zstd_64kib, uncompress_per_call) {
+    run(compression::type::zstd, 64_KiB, pooling::per_call, op::uncompress);
+}
+PERF_TEST(zstd_1mib, compress_pooled) {
+    run(compression::type::zstd, 1_MiB, pooling::pooled, op::compress);
+}
+PERF_TEST(zstd_1mib, compress_per_call) {
+    run(compression::type::zstd, 1_MiB, pooling::per_call, op::compress);
+}
+PERF_TEST(zstd_1mib, uncompress_pooled) {
+    run(compression::type::zstd, 1_MiB, pooling::pooled, op::uncompress);
+}
+PERF_TEST(zstd_1mib, uncompress_per_call) {
+    run(compression::type::zstd, 1_MiB, pooling::per_call, op::uncompress);
+}
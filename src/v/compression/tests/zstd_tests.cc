@@ -7,6 +7,8 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "compression/async_compressor.h"
+#include "compression/compression.h"
 #include "compression/internal/gzip_compressor.h"
 #include "compression/internal/lz4_frame_compressor.h"
 #include "compression/internal/snappy_java_compressor.h"
@@ -18,6 +20,7 @@
 #include "vassert.h"
 
 #include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/defer.hh>
 
 static inline constexpr std::array<size_t, 12> sizes{{
   0,
@@ -85,3 +88,112 @@ SEASTAR_THREAD_TEST_CASE(gzip_test) {
     using fn = compression::internal::gzip_compressor;
     roundtrip_compression(fn::compress, fn::uncompress);
 }
+
+// small fragments so that the decompressors read across fragment boundaries
+static inline iobuf fragmented(const iobuf& x, size_t frag_size) {
+    iobuf ret;
+    auto in = x.copy();
+    while (!in.empty()) {
+        auto n = std::min(frag_size, in.size_bytes());
+        ret.append_fragments(in.share(0, n));
+        in.trim_front(n);
+    }
+    return ret;
+}
+
+SEASTAR_THREAD_TEST_CASE(stream_decompressor_test) {
+    using compression::compressor;
+    constexpr size_t step = 100;
+    for (auto t :
+         {compression::type::gzip,
+          compression::type::snappy,
+          compression::type::lz4,
+          compression::type::zstd}) {
+        for (size_t i : sizes) {
+            iobuf buf = gen(i);
+            auto cbuf = fragmented(compressor::compress(buf, t), 7);
+            auto decompressor = compressor::make_stream_decompressor(cbuf, t);
+            iobuf dbuf;
+            while (true) {
+                auto part = decompressor->next(step);
+                if (part.empty()) {
+                    break;
+                }
+                BOOST_REQUIRE_LE(part.size_bytes(), step);
+                dbuf.append(std::move(part));
+            }
+            BOOST_REQUIRE(decompressor->is_eof());
+            BOOST_CHECK_EQUAL(dbuf, buf);
+        }
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(pooled_context_reuse_test) {
+    using compression::compressor;
+    auto drain = [](compression::stream_decompressor& d) {
+        iobuf ret;
+        for (auto part = d.next(1_KiB); !part.empty(); part = d.next(1_KiB)) {
+            ret.append(std::move(part));
+        }
+        return ret;
+    };
+    for (auto t :
+         {compression::type::gzip,
+          compression::type::lz4,
+          compression::type::zstd}) {
+        iobuf buf = gen(10_KiB);
+        auto cbuf = compressor::compress(buf, t);
+        auto truncated = cbuf.share(0, cbuf.size_bytes() / 2);
+        // the context goes back to the pool in the middle of the frame
+        BOOST_CHECK_THROW(
+          drain(*compressor::make_stream_decompressor(truncated, t)),
+          std::runtime_error);
+        BOOST_CHECK_EQUAL(
+          drain(*compressor::make_stream_decompressor(cbuf, t)), buf);
+        BOOST_CHECK_EQUAL(compressor::uncompress(cbuf, t), buf);
+        BOOST_CHECK_EQUAL(
+          compressor::uncompress(compressor::compress(buf, t), t), buf);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(stream_compressor_test) {
+    using compression::compressor;
+    for (auto t :
+         {compression::type::gzip,
+          compression::type::snappy,
+          compression::type::lz4,
+          compression::type::zstd}) {
+        for (size_t i : sizes) {
+            iobuf buf = gen(i);
+            auto c = compressor::make_stream_compressor(buf.size_bytes(), t);
+            // parts smaller than the fragments
+            auto input = fragmented(buf, 100);
+            for (const auto& frag : input) {
+                c->write(frag.get(), frag.size());
+            }
+            BOOST_CHECK_EQUAL(compressor::uncompress(c->finish(), t), buf);
+        }
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(async_compressor_test) {
+    using compression::compressor;
+    auto& ac = compression::local_async_compressor();
+    // every call is split into parts
+    ac.start(ss::default_scheduling_group(), true, 0);
+    auto stop = ss::defer([&ac] { ac.stop(); });
+    for (auto t :
+         {compression::type::gzip,
+          compression::type::snappy,
+          compression::type::lz4,
+          compression::type::zstd}) {
+        for (size_t i : {size_t(1), 10_KiB, 1_MiB + 1}) {
+            iobuf buf = gen(i);
+            auto cbuf = ac.compress(buf, t).get0();
+            BOOST_CHECK_EQUAL(compressor::uncompress(cbuf, t), buf);
+            BOOST_CHECK_EQUAL(ac.uncompress(cbuf, t).get0(), buf);
+            auto sync_cbuf = compressor::compress(buf, t);
+            BOOST_CHECK_EQUAL(ac.uncompress(sync_cbuf, t).get0(), buf);
+        }
+    }
+}
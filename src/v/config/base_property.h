@@ -50,6 +50,9 @@ public:
     virtual void set_value(YAML::Node) = 0;
     virtual void set_value(std::any) = 0;
     virtual std::optional<validation_error> validate() const = 0;
+    /// validates a value before it is set, throws if it can not be decoded
+    virtual std::optional<validation_error>
+    validate(const YAML::Node&) const = 0;
     virtual base_property& operator=(const base_property&) = 0;
     virtual ~base_property() noexcept = default;
 
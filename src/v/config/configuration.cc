@@ -11,7 +11,10 @@
 
 #include "config/base_property.h"
 #include "model/metadata.h"
+#include "prometheus/partition_metrics.h"
+#include "resource_mgmt/cpu_scheduling.h"
 #include "storage/chunk_cache.h"
+#include "storage/segment_appender.h"
 #include "units.h"
 
 #include <cstdint>
@@ -74,6 +77,56 @@ configuration::configuration()
       "Duration after which inactive readers will be evicted from cache",
       required::no,
       30s)
+  , segment_reader_max_readahead_size(
+      *this,
+      "segment_reader_max_readahead_size",
+      "Largest disk read issued by a log reader that is consuming a "
+      "partition sequentially",
+      required::no,
+      1_MiB)
+  , segment_flush_coalesce_window_ms(
+      *this,
+      "segment_flush_coalesce_window_ms",
+      "Latency budget for coalescing segment flushes across partitions on a "
+      "shard. Zero issues every flush immediately",
+      required::no,
+      0ms)
+  , storage_shared_wal(
+      *this,
+      "storage_shared_wal",
+      "Make the appends of small partitions durable in a write-ahead log "
+      "shared by the partitions of a shard instead of an fsync of their "
+      "segments. Requires restart",
+      required::no,
+      false)
+  , storage_shared_wal_partition_bytes(
+      *this,
+      "storage_shared_wal_partition_bytes",
+      "Appends go through the shared write-ahead log while the partition "
+      "holds at most this many bytes not yet flushed to its segments",
+      required::no,
+      1_MiB)
+  , storage_shared_wal_drain_interval_ms(
+      *this,
+      "storage_shared_wal_drain_interval_ms",
+      "Interval at which the partitions in the shared write-ahead log are "
+      "flushed to their segments and the write-ahead log is trimmed",
+      required::no,
+      10s)
+  , segment_header_sidecar(
+      *this,
+      "segment_header_sidecar",
+      "Write the batch headers of the segments of non-compacted partitions to "
+      "a sidecar file, read by the scans looking only at batch headers",
+      required::no,
+      false)
+  , storage_read_coalescing(
+      *this,
+      "storage_read_coalescing",
+      "Concurrent reads of the same range of a segment share a single disk "
+      "read. Applies to the segments opened after the change",
+      required::no,
+      false)
   , rpc_server(
       *this,
       "rpc_server",
@@ -115,6 +168,13 @@ configuration::configuration()
       "IpAddress and port for supervisor service",
       required::no,
       unresolved_address("127.0.0.1", 43189))
+  , coproc_supervisor_connections(
+      *this,
+      "coproc_supervisor_connections",
+      "Number of connections of every shard to the supervisor service, the "
+      "requests of the scripts are spread over them",
+      required::no,
+      2)
   , coproc_max_inflight_bytes(
       *this,
       "coproc_max_inflight_bytes",
@@ -133,6 +193,27 @@ configuration::configuration()
       "Maximum amount of bytes to read from one topic read",
       required::no,
       32_KiB)
+  , coproc_max_inflight_requests(
+      *this,
+      "coproc_max_inflight_requests",
+      "Maximum number of requests to the wasm engine in flight per script, "
+      "their replies are applied in order",
+      required::no,
+      4)
+  , coproc_write_coalesce_bytes(
+      *this,
+      "coproc_write_coalesce_bytes",
+      "Amount of bytes of script outputs queued for a materialized partition "
+      "before they are appended at once",
+      required::no,
+      128_KiB)
+  , coproc_write_coalesce_ms(
+      *this,
+      "coproc_write_coalesce_ms",
+      "Max time the script outputs for a materialized partition are queued "
+      "before they are appended, 0 appends each output on its own",
+      required::no,
+      5ms)
   , coproc_offset_flush_interval_ms(
       *this,
       "coproc_offset_flush_interval_ms",
@@ -194,6 +275,15 @@ configuration::configuration()
       required::no,
       {},
       endpoint_tls_config::validate_many)
+  , kafka_api_shard_listeners_base_port(
+      *this,
+      "kafka_api_shard_listeners_base_port",
+      "When set, every Kafka API listener is also bound on one port per core, "
+      "starting at this port, accepting connections on that core only. "
+      "Clients looking up the core of a partition replica in the admin API "
+      "connect to the port of that core and skip the cross core hop",
+      required::no,
+      std::nullopt)
   , use_scheduling_groups(
       *this,
       "use_scheduling_groups",
@@ -239,12 +329,46 @@ configuration::configuration()
       "Quota manager GC frequency in milliseconds",
       required::no,
       std::chrono::milliseconds(30000))
+  , quota_manager_reconciliation_ms(
+      *this,
+      "quota_manager_reconciliation_ms",
+      "Period of the reconciliation of client throughput across shards",
+      required::no,
+      std::chrono::milliseconds(1000))
   , target_quota_byte_rate(
       *this,
       "target_quota_byte_rate",
       "Target quota byte rate (bytes per second) - 2GB default",
       required::no,
       2_GiB)
+  , target_partition_produce_byte_rate(
+      *this,
+      "target_partition_produce_byte_rate",
+      "Produce byte rate limit of a partition (bytes per second), unlimited "
+      "if not set",
+      required::no,
+      std::nullopt)
+  , target_partition_fetch_byte_rate(
+      *this,
+      "target_partition_fetch_byte_rate",
+      "Fetch byte rate limit of a partition (bytes per second), unlimited if "
+      "not set",
+      required::no,
+      std::nullopt)
+  , target_topic_produce_byte_rate(
+      *this,
+      "target_topic_produce_byte_rate",
+      "Produce byte rate limit of the partitions of a topic managed by a "
+      "shard (bytes per second), unlimited if not set",
+      required::no,
+      std::nullopt)
+  , target_topic_fetch_byte_rate(
+      *this,
+      "target_topic_fetch_byte_rate",
+      "Fetch byte rate limit of the partitions of a topic managed by a shard "
+      "(bytes per second), unlimited if not set",
+      required::no,
+      std::nullopt)
   , cluster_id(
       *this, "cluster_id", "Cluster identifier", required::no, std::nullopt)
   , rack(*this, "rack", "Rack identifier", required::no, std::nullopt)
@@ -309,6 +433,19 @@ configuration::configuration()
       "failing a request",
       required::no,
       30)
+  , metadata_dissemination_delta_interval_ms(
+      *this,
+      "metadata_dissemination_delta_interval_ms",
+      "Interval between requests of the leadership updates a node missed",
+      required::no,
+      30'000ms)
+  , metadata_dissemination_delta_log_size(
+      *this,
+      "metadata_dissemination_delta_log_size",
+      "Number of leadership updates retained to be served to nodes that fell "
+      "behind, nodes missing older updates request all the leaders",
+      required::no,
+      100'000)
   , tm_sync_timeout_ms(
       *this,
       "tm_sync_timeout_ms",
@@ -345,9 +482,26 @@ configuration::configuration()
       *this,
       "fetch_reads_debounce_timeout",
       "Time to wait for next read in fetch request when requested min bytes "
-      "wasn't reached",
+      "wasn't reached and the fetched partitions high watermark can not be "
+      "watched",
       required::no,
       1ms)
+  , enable_follower_fetching(
+      *this,
+      "enable_follower_fetching",
+      "Serve fetches of consumers supporting preferred read replicas (fetch "
+      "v11+) from followers, the leader points consumers that set their rack "
+      "to an in-sync follower from the same rack",
+      required::no,
+      false)
+  , enable_balanced_fetch_planning(
+      *this,
+      "enable_balanced_fetch_planning",
+      "Split the fetch response budget evenly among the partitions with data "
+      "to read instead of assigning it in the request order, and read the "
+      "partitions closest to their high watermark first",
+      required::no,
+      false)
   , alter_topic_cfg_timeout_ms(
       *this,
       "alter_topic_cfg_timeout_ms",
@@ -386,6 +540,13 @@ configuration::configuration()
       "write with the given producer id.",
       required::no,
       10080min)
+  , max_concurrent_producer_ids(
+      *this,
+      "max_concurrent_producer_ids",
+      "Max number of idempotent producers tracked per partition, the least "
+      "recently written producer ids are expired first",
+      required::no,
+      100000)
   , enable_idempotence(
       *this,
       "enable_idempotence",
@@ -400,6 +561,13 @@ configuration::configuration()
       "Capacity (in number of txns) of an abort index segment",
       required::no,
       50000)
+  , abort_index_cache_size(
+      *this,
+      "abort_index_cache_size",
+      "Number of abort index segments per partition kept in memory to serve "
+      "read committed fetches",
+      required::no,
+      4)
   , delete_retention_ms(
       *this,
       "delete_retention_ms",
@@ -521,6 +689,14 @@ configuration::configuration()
       "Max size of requests cached for replication",
       required::no,
       1_MiB)
+  , raft_replicate_batch_max_linger_us(
+      *this,
+      "raft_replicate_batch_max_linger_us",
+      "Maximum time in microseconds the replicate batcher waits for more "
+      "requests before flushing when requests arrive faster than that. "
+      "0 disables lingering",
+      required::no,
+      250)
   , raft_learner_recovery_rate(
       *this,
       "raft_learner_recovery_rate",
@@ -541,6 +717,106 @@ configuration::configuration()
       "one follower",
       required::no,
       16)
+  , rpc_client_connections_per_peer(
+      *this,
+      "rpc_client_connections_per_peer",
+      "Number of internal RPC connections a node opens to each of its peers, "
+      "shards of nodes with more cores share a connection",
+      required::no,
+      8)
+  , rpc_client_connection_warm_up(
+      *this,
+      "rpc_client_connection_warm_up",
+      "Reconnect to unreachable peers in the background as soon as the "
+      "reconnect backoff expires, so that the first request sent once a peer "
+      "recovers does not wait for the connection to be established",
+      required::no,
+      false)
+  , rpc_crc32c_payload_checksum(
+      *this,
+      "rpc_crc32c_payload_checksum",
+      "Checksum internal RPC requests with hardware accelerated crc32c "
+      "instead of xxhash64, requires all the nodes to support it",
+      required::no,
+      false)
+  , rpc_skip_tls_payload_checksum(
+      *this,
+      "rpc_skip_tls_payload_checksum",
+      "Do not checksum internal RPC requests sent over TLS, which already "
+      "protects their integrity, requires all the nodes to support it",
+      required::no,
+      false)
+  , rpc_slow_request_log_threshold_ms(
+      *this,
+      "rpc_slow_request_log_threshold_ms",
+      "Internal RPC requests taking longer are logged, by the client and the "
+      "server, with their correlation id and the time spent in each phase",
+      required::no,
+      1s)
+  , raft_enable_append_entries_batching(
+      *this,
+      "raft_enable_append_entries_batching",
+      "Send the append entries requests of all raft groups of a shard that "
+      "replicate to the same node at the same time in a single RPC",
+      required::no,
+      true)
+  , raft_enable_vote_batching(
+      *this,
+      "raft_enable_vote_batching",
+      "Send the vote and prevote requests of all raft groups of a shard that "
+      "are issued to the same node at the same time in a single RPC",
+      required::no,
+      true)
+  , raft_append_entries_storage_encoding(
+      *this,
+      "raft_append_entries_storage_encoding",
+      "Send the record batches of append entries requests as they are "
+      "stored, followers append them without re-encoding their records. "
+      "Requires all the nodes to support it",
+      required::no,
+      false)
+  , raft_enable_lightweight_heartbeats(
+      *this,
+      "raft_enable_lightweight_heartbeats",
+      "Do not send the metadata of raft groups whose state did not change to "
+      "followers that already acknowledged it, heartbeats only refresh the "
+      "follower election timers of such groups",
+      required::no,
+      true)
+  , raft_enable_leader_lease(
+      *this,
+      "raft_enable_leader_lease",
+      "Let a leader that recently heard from a majority of its followers "
+      "serve linearizable barriers without a confirmation round trip. Relies "
+      "on clocks of the nodes not drifting by more than half of the election "
+      "timeout",
+      required::no,
+      true)
+  , raft_recovery_max_read_size(
+      *this,
+      "raft_recovery_max_read_size",
+      "Upper bound of the amount of data read and sent to a recovering "
+      "follower in a single request. Recovery starts with 32KiB requests and "
+      "doubles their size, up to this limit, as long as the follower keeps "
+      "accepting them",
+      required::no,
+      512_KiB)
+  , raft_write_caching_max_unflushed_bytes(
+      *this,
+      "raft_write_caching_max_unflushed_bytes",
+      "Partitions of topics created with x-redpanda-write-caching acknowledge "
+      "acks=all writes once a majority appended them, without waiting for a "
+      "flush. The log is flushed in the background once this many bytes are "
+      "unflushed",
+      required::no,
+      4_MiB)
+  , raft_write_caching_flush_interval_ms(
+      *this,
+      "raft_write_caching_flush_interval_ms",
+      "Upper bound of the time the writes of a write caching partition stay "
+      "unflushed",
+      required::no,
+      100ms)
   , reclaim_min_size(
       *this,
       "reclaim_min_size",
@@ -565,6 +841,20 @@ configuration::configuration()
       "Length of time above which growth is reset",
       required::no,
       10'000ms)
+  , batch_cache_compressed_tier_max_size(
+      *this,
+      "batch_cache_compressed_tier_max_size",
+      "Maximum bytes per shard kept in the compressed batch cache tier. "
+      "Zero disables the tier",
+      required::no,
+      0)
+  , enable_adaptive_cache_sizing(
+      *this,
+      "enable_adaptive_cache_sizing",
+      "Move memory between the chunk cache and the batch cache based on "
+      "append waits and batch cache hit ratio",
+      required::no,
+      false)
   , auto_create_topics_enabled(
       *this,
       "auto_create_topics_enabled",
@@ -643,6 +933,14 @@ configuration::configuration()
       required::no,
       16_KiB,
       storage::internal::chunk_cache::validate_chunk_size)
+  , segment_fallocation_step(
+      *this,
+      "segment_fallocation_step",
+      "Size of the extents preallocated ahead of the write head of a segment. "
+      "Zero disables preallocation",
+      required::no,
+      32_MiB,
+      storage::segment_appender::validate_fallocation_step)
   , max_compacted_log_segment_size(
       *this,
       "max_compacted_log_segment_size",
@@ -664,6 +962,14 @@ configuration::configuration()
       "touching the log until the batch is exhausted.",
       required::no,
       1000)
+  , id_allocator_lease_size(
+      *this,
+      "id_allocator_lease_size",
+      "Number of ids each shard leases from the id allocator at once and "
+      "then serves locally until the lease is exhausted. Leases of 1 id "
+      "allocate every id through the id allocator.",
+      required::no,
+      100)
   , enable_sasl(
       *this,
       "enable_sasl",
@@ -676,6 +982,29 @@ configuration::configuration()
       "Interval between iterations of controller backend housekeeping loop",
       required::no,
       1s)
+  , controller_backend_max_concurrent_reconciliations(
+      *this,
+      "controller_backend_max_concurrent_reconciliations",
+      "Maximum number of partitions reconciled concurrently by the controller "
+      "backend of every shard",
+      required::no,
+      64)
+  , controller_backend_background_bootstrap(
+      *this,
+      "controller_backend_background_bootstrap",
+      "Recover the partitions of a restarting node in the background, so that "
+      "the kafka api is served while they recover. Partitions that have not "
+      "recovered yet answer with a retriable not leader error",
+      required::no,
+      false)
+  , controller_snapshot_max_batches(
+      *this,
+      "controller_snapshot_max_batches",
+      "Number of controller log batches applied between snapshots of the "
+      "controller state, the log is truncated up to the latest snapshot. "
+      "Snapshots are disabled if set to 0",
+      required::no,
+      0)
   , node_management_operation_timeout_ms(
       *this,
       "node_management_operation_timeout_ms",
@@ -723,6 +1052,144 @@ configuration::configuration()
       "target compaction backlog would be equal to ",
       required::no,
       std::nullopt)
+  , background_io_ctrl_latency_target_ms(
+      *this,
+      "background_io_ctrl_latency_target_ms",
+      "Target of the p99 produce latency of a shard. When set, the IO shares "
+      "of compaction, learner recovery, scrubbing and archival are scaled "
+      "down while the target is missed and back up while it is met",
+      required::no,
+      std::nullopt)
+  , background_io_ctrl_update_interval_ms(
+      *this,
+      "background_io_ctrl_update_interval_ms",
+      "Interval at which the background IO controller samples produce latency",
+      required::no,
+      1s)
+  , background_io_ctrl_min_scale(
+      *this,
+      "background_io_ctrl_min_scale",
+      "Lowest scale, in (0, 1], applied to the shares of background IO",
+      required::no,
+      0.1)
+  , compaction_key_map_enabled(
+      *this,
+      "compaction_key_map_enabled",
+      "Drop records of self compacted segments whose keys were rewritten in "
+      "newer segments of the same log, using a log wide key map",
+      required::no,
+      false)
+  , compaction_key_map_memory(
+      *this,
+      "compaction_key_map_memory",
+      "Memory bound of the log wide compaction key map; keys seen once it is "
+      "full are kept in older segments",
+      required::no,
+      16_MiB)
+  , compaction_index_fingerprint_keys(
+      *this,
+      "compaction_index_fingerprint_keys",
+      "Store 128-bit fingerprints instead of keys longer than 16 bytes in "
+      "segment compaction indices, so compaction covers more distinct keys "
+      "with the same memory",
+      required::no,
+      false)
+  , compaction_index_key_filter(
+      *this,
+      "compaction_index_key_filter",
+      "Store a bloom filter of the keys in segment compaction indices so log "
+      "wide compaction can skip segments sharing no keys with newer ones",
+      required::no,
+      false)
+  , compaction_sorted_run_memory(
+      *this,
+      "compaction_sorted_run_memory",
+      "Hard memory cap of segment self compaction. When set keys are "
+      "deduplicated exactly by spilling sorted runs to disk; when unset a "
+      "bounded in memory map is used and evicted keys are kept",
+      required::no,
+      std::nullopt)
+  , storage_recovery_concurrency(
+      *this,
+      "storage_recovery_concurrency",
+      "Maximum number of logs recovered concurrently on each shard at startup",
+      required::no,
+      32)
+  , storage_recovery_segment_concurrency(
+      *this,
+      "storage_recovery_segment_concurrency",
+      "Maximum number of segments of a log opened or index checked "
+      "concurrently during recovery",
+      required::no,
+      8)
+  , storage_removal_concurrency(
+      *this,
+      "storage_removal_concurrency",
+      "Maximum number of removed logs whose files are deleted concurrently "
+      "in the background on each shard",
+      required::no,
+      2)
+  , readers_cache_max_prefetches(
+      *this,
+      "readers_cache_max_prefetches",
+      "Maximum number of cached readers reading ahead into the batch cache "
+      "at once on each shard",
+      required::no,
+      16)
+  , readers_cache_prefetch_bytes(
+      *this,
+      "readers_cache_prefetch_bytes",
+      "Bytes a sequentially reused cached reader reads ahead into the batch "
+      "cache; 0 disables read-ahead",
+      required::no,
+      1_MiB)
+  , storage_scrub_interval_ms(
+      *this,
+      "storage_scrub_interval_ms",
+      "Interval between background scrubs verifying the batch checksums of "
+      "closed segments; reads of verified segments skip the header checksum. "
+      "Disabled when unset",
+      required::no,
+      std::nullopt)
+  , storage_housekeeping_max_concurrency(
+      *this,
+      "storage_housekeeping_max_concurrency",
+      "Maximum number of logs per shard whose retention and compaction run "
+      "concurrently, reached when the compaction controller runs at its "
+      "maximum shares",
+      required::no,
+      4)
+  , storage_recompression_min_age_ms(
+      *this,
+      "storage_recompression_min_age_ms",
+      "Closed segments of kafka partitions whose newest batch is older than "
+      "this are rewritten by housekeeping with storage_recompression_type. "
+      "Disabled when unset",
+      required::no,
+      std::nullopt)
+  , storage_recompression_type(
+      *this,
+      "storage_recompression_type",
+      "Compression of the data batches of the segments rewritten by "
+      "storage_recompression_min_age_ms",
+      required::no,
+      model::compression::zstd,
+      [](const model::compression& c) -> std::optional<ss::sstring> {
+          if (
+            c == model::compression::none
+            || c == model::compression::producer) {
+              return "Recompression requires a compression codec";
+          }
+          return std::nullopt;
+      })
+  , in_memory_log_max_bytes(
+      *this,
+      "in_memory_log_max_bytes",
+      "Upper bound of the memory held by a partition of a topic created with "
+      "x-redpanda-in-memory. The oldest batches are evicted past it, as with "
+      "a lower retention.bytes",
+      required::no,
+      64_MiB)
   , members_backend_retry_ms(
       *this,
       "members_backend_retry_ms",
@@ -777,12 +1244,92 @@ configuration::configuration()
       "Max number of simultaneous uploads to S3",
       required::no,
       20)
+  , cloud_storage_segment_upload_part_size(
+      *this,
+      "cloud_storage_segment_upload_part_size",
+      "Segments larger than this size are uploaded to S3 in parts of this "
+      "size using multipart uploads, 0 disables multipart uploads. Values "
+      "below the 5MiB S3 limit are rounded up",
+      required::no,
+      64_MiB)
+  , cloud_storage_segment_upload_parallelism(
+      *this,
+      "cloud_storage_segment_upload_parallelism",
+      "Max number of parts of a segment uploaded to S3 concurrently",
+      required::no,
+      4)
+  , cloud_storage_max_upload_bandwidth(
+      *this,
+      "cloud_storage_max_upload_bandwidth",
+      "Max bandwidth of the segment uploads to S3 of the node in bytes per "
+      "second, shared evenly by the shards. Unlimited if not set",
+      required::no,
+      std::nullopt)
+  , cloud_storage_recovery_concurrency(
+      *this,
+      "cloud_storage_recovery_concurrency",
+      "Max number of segments of a partition downloaded concurrently during "
+      "the topic recovery",
+      required::no,
+      4)
+  , cloud_storage_max_recovery_bandwidth(
+      *this,
+      "cloud_storage_max_recovery_bandwidth",
+      "Max bandwidth of the topic recovery segment downloads of the node in "
+      "bytes per second, shared evenly by the shards. Unlimited if not set",
+      required::no,
+      std::nullopt)
+  , cloud_storage_hydrate_replicas(
+      *this,
+      "cloud_storage_hydrate_replicas",
+      "Download the archived segments of the replicas added by a partition "
+      "reassignment from the cloud storage, the leader only recovers the "
+      "offsets that were not uploaded yet",
+      required::no,
+      false)
+  , cloud_storage_manifest_binary_format(
+      *this,
+      "cloud_storage_manifest_binary_format",
+      "Upload the partition manifests using the compact binary encoding "
+      "instead of json",
+      required::no,
+      false)
+  , cloud_storage_manifest_max_deltas(
+      *this,
+      "cloud_storage_manifest_max_deltas",
+      "Max number of delta objects, holding only the newly uploaded segments, "
+      "written after the full partition manifest before it's re-uploaded. "
+      "The full manifest is re-uploaded after every change if 0",
+      required::no,
+      0)
+  , cloud_storage_upload_coalesce_size(
+      *this,
+      "cloud_storage_upload_coalesce_size",
+      "Max size of the object that combines consecutive small closed "
+      "segments into a single upload, segments are uploaded one by one if 0",
+      required::no,
+      0)
   , cloud_storage_disable_tls(
       *this,
       "cloud_storage_disable_tls",
       "Disable TLS for all S3 connections",
       required::no,
       false)
+  , cloud_storage_sign_payload(
+      *this,
+      "cloud_storage_sign_payload",
+      "Sign the payload of the uploads chunk by chunk using the streaming "
+      "SigV4 signature, the payload is sent unsigned otherwise",
+      required::no,
+      false)
+  , cloud_storage_hedge_percentile(
+      *this,
+      "cloud_storage_hedge_percentile",
+      "Percentile of the latencies of the GET requests to the cloud storage "
+      "after which a duplicate request is sent, the first response received "
+      "is used. The requests are not hedged if not set",
+      required::no,
+      std::nullopt)
   , cloud_storage_api_endpoint_port(
       *this,
       "cloud_storage_api_endpoint_port",
@@ -846,6 +1393,34 @@ configuration::configuration()
       "Timeout to check if cache eviction should be triggered",
       required::no,
       30s)
+  , cloud_storage_enable_remote_read(
+      *this,
+      "cloud_storage_enable_remote_read",
+      "Serve fetches of offsets removed from the local disk from the segments "
+      "uploaded to the cloud storage",
+      required::no,
+      false)
+  , cloud_storage_cache_chunk_size(
+      *this,
+      "cloud_storage_cache_chunk_size",
+      "Size of the chunks in which segments are downloaded to the archival "
+      "cache for remote reads",
+      required::no,
+      16_MiB)
+  , cloud_storage_read_ahead_chunks(
+      *this,
+      "cloud_storage_read_ahead_chunks",
+      "Number of chunks downloaded ahead of the consumers reading the archived "
+      "segments in order, 0 disables the read-ahead",
+      required::no,
+      2)
+  , cloud_storage_read_ahead_budget(
+      *this,
+      "cloud_storage_read_ahead_budget",
+      "Max size of the chunks being downloaded ahead of the consumers, split "
+      "evenly between the shards",
+      required::no,
+      256_MiB)
   , superusers(
       *this, "superusers", "List of superuser usernames", required::no, {})
   , kafka_qdc_latency_alpha(
@@ -908,12 +1483,132 @@ configuration::configuration()
       "Update frequency for kafka queue depth control.",
       required::no,
       7s)
+  , kafka_concurrency_limit_enable(
+      *this,
+      "kafka_concurrency_limit_enable",
+      "Limit the produce and fetch requests processed concurrently by a core "
+      "based on their latency. Requests beyond the limit wait for a slot and "
+      "their wait is reported to the client as throttle time",
+      required::no,
+      false)
+  , kafka_concurrency_limit_target_ms(
+      *this,
+      "kafka_concurrency_limit_target_ms",
+      "Latency of produce and fetch requests above which the concurrency "
+      "limit of a core is lowered",
+      required::no,
+      100ms)
+  , kafka_concurrency_limit_min(
+      *this,
+      "kafka_concurrency_limit_min",
+      "Lowest concurrency limit of produce and fetch requests of a core",
+      required::no,
+      4)
+  , kafka_concurrency_limit_max(
+      *this,
+      "kafka_concurrency_limit_max",
+      "Highest concurrency limit of produce and fetch requests of a core",
+      required::no,
+      1000)
+  , kafka_max_inflight_requests_per_connection(
+      *this,
+      "kafka_max_inflight_requests_per_connection",
+      "Maximum number of requests of a single connection that are processed "
+      "concurrently, responses are still sent in the request order. Reading "
+      "requests from the connection pauses while the limit is reached",
+      required::no,
+      128)
+  , kafka_tenant_scheduling_groups(
+      *this,
+      "kafka_tenant_scheduling_groups",
+      "Scheduling groups of kafka tenants as <client_id_prefix>:<shares>. "
+      "Requests of a client run in the group of the longest prefix of its "
+      "client id, with the given cpu shares (1 to 1000, the kafka group has "
+      "1000). Clients that match no prefix are not isolated",
+      required::no,
+      {},
+      scheduling_groups::validate_tenant_groups)
+  , kafka_latency_breakdown(
+      *this,
+      "kafka_latency_breakdown",
+      "Export histograms of the time produce and fetch requests spend in "
+      "each stage of their processing, per client id",
+      required::no,
+      false)
+  , kafka_latency_breakdown_max_clients(
+      *this,
+      "kafka_latency_breakdown_max_clients",
+      "Number of client ids with their own latency breakdown on each shard, "
+      "requests of further clients are accounted under the 'other' client",
+      required::no,
+      16)
+  , partition_latency_breakdown(
+      *this,
+      "partition_latency_breakdown",
+      "Export per partition histograms of the time produce requests spend "
+      "being enqueued for replication and waiting for their acknowledgement, "
+      "and of the time of log flushes. Applies to partitions created after "
+      "it is set",
+      required::no,
+      false)
+  , partition_metrics_aggregation(
+      *this,
+      "partition_metrics_aggregation",
+      "Series of the per partition metrics: 'partition' registers series per "
+      "partition, 'topic' and 'shard' sum the partitions of a topic or of a "
+      "shard in one series and drop the metrics that can not be summed. "
+      "Applies to partitions created after it is set",
+      required::no,
+      "partition",
+      partition_metrics::validate_aggregation)
+  , partition_metrics_topics(
+      *this,
+      "partition_metrics_topics",
+      "Topics whose partitions keep their own series when partition metrics "
+      "are aggregated",
+      required::no,
+      {})
+  , startup_self_test(
+      *this,
+      "startup_self_test",
+      "Benchmark the disk of the data directory and the memory of every shard "
+      "at startup. The results are logged and served by the admin API",
+      required::no,
+      false)
+  , startup_self_test_disk_bytes(
+      *this,
+      "startup_self_test_disk_bytes",
+      "Bytes written then read back by the startup disk benchmark",
+      required::no,
+      256_MiB)
+  , startup_self_test_memory_bytes(
+      *this,
+      "startup_self_test_memory_bytes",
+      "Size of the buffer copied by the startup memory benchmark of each "
+      "shard",
+      required::no,
+      16_MiB)
+  , startup_self_test_tune(
+      *this,
+      "startup_self_test_tune",
+      "Tune the defaults of the properties that are not set from the startup "
+      "self test: segment_flush_coalesce_window_ms is raised on disks with "
+      "slow fsyncs",
+      required::no,
+      true)
   , zstd_decompress_workspace_bytes(
       *this,
       "zstd_decompress_workspace_bytes",
       "Size of the zstd decompression workspace",
       required::no,
       8_MiB)
+  , iobuf_fragment_pool_max_bytes(
+      *this,
+      "iobuf_fragment_pool_max_bytes",
+      "Max bytes of released iobuf fragment buffers cached per core for "
+      "reuse, the fragments are allocated directly if 0",
+      required::no,
+      4_MiB)
   , full_raft_configuration_recovery_pattern(
       *this,
       "full_raft_configuration_recovery_pattern",
@@ -950,6 +1645,35 @@ configuration::configuration()
       "Leadership rebalancing node mute timeout",
       required::no,
       20s)
+  , leader_balancer_throughput_aware(
+      *this,
+      "leader_balancer_throughput_aware",
+      "Balance the partition throughput led by every core instead of the "
+      "number of leaders",
+      required::no,
+      false)
+  , leader_balancer_throughput_ema_alpha(
+      *this,
+      "leader_balancer_throughput_ema_alpha",
+      "Smoothing factor of the partition throughput used by the throughput "
+      "aware leadership rebalancing",
+      required::no,
+      0.3)
+  , leader_balancer_min_improvement_percent(
+      *this,
+      "leader_balancer_min_improvement_percent",
+      "Minimum reduction of the load difference between two cores, in "
+      "percent of the average core load, for the throughput aware "
+      "leadership rebalancing to transfer a leader between them",
+      required::no,
+      10)
+  , leader_balancer_max_transfers_per_minute(
+      *this,
+      "leader_balancer_max_transfers_per_minute",
+      "Maximum number of leadership transfers requested by the leadership "
+      "rebalancing every minute",
+      required::no,
+      120)
   , internal_topic_replication_factor(
       *this,
       "internal_topic_replication_factor",
@@ -962,6 +1686,87 @@ configuration::configuration()
       "How often the health manager runs",
       required::no,
       3min)
+  , enable_partition_balancer(
+      *this,
+      "enable_partition_balancer",
+      "Continuously move partition replicas across nodes and cores to even "
+      "out their measured throughput and disk usage",
+      required::no,
+      false)
+  , partition_balancer_tick_interval_ms(
+      *this,
+      "partition_balancer_tick_interval_ms",
+      "How often the partition balancer checks the cluster load",
+      required::no,
+      1min)
+  , partition_balancer_max_concurrent_moves(
+      *this,
+      "partition_balancer_max_concurrent_moves",
+      "Maximum number of replica moves requested at once by the partition "
+      "balancer, bounds the recovery traffic it generates",
+      required::no,
+      2)
+  , partition_balancer_min_skew_percent(
+      *this,
+      "partition_balancer_min_skew_percent",
+      "Difference between the most and the least loaded nodes or cores, in "
+      "percent of the average load, above which partitions are moved",
+      required::no,
+      20)
+  , kafka_recompression_cpu_budget_percent(
+      *this,
+      "kafka_recompression_cpu_budget_percent",
+      "Max share of the time of a core, in percent, spent recompressing the "
+      "produced batches of the topics with a compression type, batches are "
+      "appended as produced once it is used up",
+      required::no,
+      25)
+  , memory_kafka_fraction(
+      *this,
+      "memory_kafka_fraction",
+      "Share of the memory of a core for the requests of the kafka api",
+      required::no,
+      0.30)
+  , memory_rpc_fraction(
+      *this,
+      "memory_rpc_fraction",
+      "Share of the memory of a core for the internal rpc requests",
+      required::no,
+      0.30)
+  , memory_chunk_cache_min_fraction(
+      *this,
+      "memory_chunk_cache_min_fraction",
+      "Share of the memory of a core the write buffer chunk cache starts with "
+      "as its target",
+      required::no,
+      0.10)
+  , memory_chunk_cache_max_fraction(
+      *this,
+      "memory_chunk_cache_max_fraction",
+      "Share of the memory of a core the write buffer chunk cache starts with "
+      "as its limit on outstanding chunks",
+      required::no,
+      0.30)
+  , memory_chunk_cache_floor_fraction(
+      *this,
+      "memory_chunk_cache_floor_fraction",
+      "Lowest share of the memory of a core the chunk cache is shrunk to, in "
+      "favor of the batch cache",
+      required::no,
+      0.05)
+  , memory_chunk_cache_ceiling_fraction(
+      *this,
+      "memory_chunk_cache_ceiling_fraction",
+      "Highest share of the memory of a core the chunk cache is grown to, "
+      "taking it from the batch cache",
+      required::no,
+      0.40)
+  , memory_segment_index_fraction(
+      *this,
+      "memory_segment_index_fraction",
+      "Share of the memory of a core for the indices of closed segments",
+      required::no,
+      0.05)
   , _advertised_kafka_api(
       *this,
       "advertised_kafka_api",
@@ -46,6 +46,13 @@ struct configuration final : public config_store {
     property<uint64_t> log_segment_size;
     property<uint64_t> compacted_log_segment_size;
     property<std::chrono::milliseconds> readers_cache_eviction_timeout_ms;
+    property<size_t> segment_reader_max_readahead_size;
+    property<std::chrono::milliseconds> segment_flush_coalesce_window_ms;
+    property<bool> storage_shared_wal;
+    property<size_t> storage_shared_wal_partition_bytes;
+    property<std::chrono::milliseconds> storage_shared_wal_drain_interval_ms;
+    property<bool> segment_header_sidecar;
+    property<bool> storage_read_coalescing;
     // Network
     property<unresolved_address> rpc_server;
     property<tls_config> rpc_server_tls;
@@ -55,9 +62,13 @@ struct configuration final : public config_store {
     // Coproc
     property<bool> enable_coproc;
     property<unresolved_address> coproc_supervisor_server;
+    property<std::size_t> coproc_supervisor_connections;
     property<std::size_t> coproc_max_inflight_bytes;
     property<std::size_t> coproc_max_ingest_bytes;
     property<std::size_t> coproc_max_batch_size;
+    property<std::size_t> coproc_max_inflight_requests;
+    property<std::size_t> coproc_write_coalesce_bytes;
+    property<std::chrono::milliseconds> coproc_write_coalesce_ms;
     property<std::chrono::milliseconds> coproc_offset_flush_interval_ms;
 
     // Raft
@@ -72,6 +83,7 @@ struct configuration final : public config_store {
     // Kafka
     one_or_many_property<model::broker_endpoint> kafka_api;
     one_or_many_property<endpoint_tls_config> kafka_api_tls;
+    property<std::optional<uint16_t>> kafka_api_shard_listeners_base_port;
     property<bool> use_scheduling_groups;
     one_or_many_property<model::broker_endpoint> admin;
     one_or_many_property<endpoint_tls_config> admin_api_tls;
@@ -80,7 +92,12 @@ struct configuration final : public config_store {
     property<int16_t> default_num_windows;
     property<std::chrono::milliseconds> default_window_sec;
     property<std::chrono::milliseconds> quota_manager_gc_sec;
+    property<std::chrono::milliseconds> quota_manager_reconciliation_ms;
     property<uint32_t> target_quota_byte_rate;
+    property<std::optional<size_t>> target_partition_produce_byte_rate;
+    property<std::optional<size_t>> target_partition_fetch_byte_rate;
+    property<std::optional<size_t>> target_topic_produce_byte_rate;
+    property<std::optional<size_t>> target_topic_fetch_byte_rate;
     property<std::optional<ss::sstring>> cluster_id;
     property<std::optional<ss::sstring>> rack;
     property<std::optional<ss::sstring>> dashboard_dir;
@@ -92,12 +109,17 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds> metadata_dissemination_interval_ms;
     property<std::chrono::milliseconds> metadata_dissemination_retry_delay_ms;
     property<int16_t> metadata_dissemination_retries;
+    property<std::chrono::milliseconds>
+      metadata_dissemination_delta_interval_ms;
+    property<size_t> metadata_dissemination_delta_log_size;
     property<std::chrono::milliseconds> tm_sync_timeout_ms;
     property<model::violation_recovery_policy> tm_violation_recovery_policy;
     property<std::chrono::milliseconds> rm_sync_timeout_ms;
     property<std::chrono::milliseconds> tx_timeout_delay_ms;
     property<model::violation_recovery_policy> rm_violation_recovery_policy;
     property<std::chrono::milliseconds> fetch_reads_debounce_timeout;
+    property<bool> enable_follower_fetching;
+    property<bool> enable_balanced_fetch_planning;
     property<std::chrono::milliseconds> alter_topic_cfg_timeout_ms;
     property<model::cleanup_policy_bitflags> log_cleanup_policy;
     property<model::timestamp_type> log_message_timestamp_type;
@@ -105,9 +127,11 @@ struct configuration final : public config_store {
     property<size_t> fetch_max_bytes;
     // same as transactional.id.expiration.ms in kafka
     property<std::chrono::milliseconds> transactional_id_expiration_ms;
+    property<size_t> max_concurrent_producer_ids;
     property<bool> enable_idempotence;
     property<bool> enable_transactions;
     property<uint32_t> abort_index_segment_size;
+    property<uint32_t> abort_index_cache_size;
     // same as log.retention.ms in kafka
     property<std::chrono::milliseconds> delete_retention_ms;
     property<std::chrono::milliseconds> log_compaction_interval_ms;
@@ -133,14 +157,30 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds> replicate_append_timeout_ms;
     property<std::chrono::milliseconds> recovery_append_timeout_ms;
     property<size_t> raft_replicate_batch_window_size;
+    property<uint32_t> raft_replicate_batch_max_linger_us;
     property<size_t> raft_learner_recovery_rate;
     property<uint32_t> raft_smp_max_non_local_requests;
     property<uint32_t> raft_max_concurrent_append_requests_per_follower;
+    property<uint32_t> rpc_client_connections_per_peer;
+    property<bool> rpc_client_connection_warm_up;
+    property<bool> rpc_crc32c_payload_checksum;
+    property<bool> rpc_skip_tls_payload_checksum;
+    property<std::chrono::milliseconds> rpc_slow_request_log_threshold_ms;
+    property<bool> raft_enable_append_entries_batching;
+    property<bool> raft_enable_vote_batching;
+    property<bool> raft_append_entries_storage_encoding;
+    property<bool> raft_enable_lightweight_heartbeats;
+    property<bool> raft_enable_leader_lease;
+    property<size_t> raft_recovery_max_read_size;
+    property<size_t> raft_write_caching_max_unflushed_bytes;
+    property<std::chrono::milliseconds> raft_write_caching_flush_interval_ms;
 
     property<size_t> reclaim_min_size;
     property<size_t> reclaim_max_size;
     property<std::chrono::milliseconds> reclaim_growth_window;
     property<std::chrono::milliseconds> reclaim_stable_window;
+    property<size_t> batch_cache_compressed_tier_max_size;
+    property<bool> enable_adaptive_cache_sizing;
     property<bool> auto_create_topics_enabled;
     property<bool> enable_pid_file;
     property<std::chrono::milliseconds> kvstore_flush_interval;
@@ -155,12 +195,17 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds> segment_appender_flush_timeout_ms;
     property<std::chrono::milliseconds> fetch_session_eviction_timeout_ms;
     property<size_t> append_chunk_size;
+    property<size_t> segment_fallocation_step;
     property<size_t> max_compacted_log_segment_size;
     property<int16_t> id_allocator_log_capacity;
     property<int16_t> id_allocator_batch_size;
+    property<int16_t> id_allocator_lease_size;
     property<bool> enable_sasl;
     property<std::chrono::milliseconds>
       controller_backend_housekeeping_interval_ms;
+    property<size_t> controller_backend_max_concurrent_reconciliations;
+    property<bool> controller_backend_background_bootstrap;
+    property<size_t> controller_snapshot_max_batches;
     property<std::chrono::milliseconds> node_management_operation_timeout_ms;
     // Compaction controller
     property<std::chrono::milliseconds> compaction_ctrl_update_interval_ms;
@@ -170,6 +215,26 @@ struct configuration final : public config_store {
     property<int16_t> compaction_ctrl_min_shares;
     property<int16_t> compaction_ctrl_max_shares;
     property<std::optional<size_t>> compaction_ctrl_backlog_size;
+    property<std::optional<std::chrono::milliseconds>>
+      background_io_ctrl_latency_target_ms;
+    property<std::chrono::milliseconds> background_io_ctrl_update_interval_ms;
+    property<double> background_io_ctrl_min_scale;
+    property<bool> compaction_key_map_enabled;
+    property<size_t> compaction_key_map_memory;
+    property<bool> compaction_index_fingerprint_keys;
+    property<bool> compaction_index_key_filter;
+    property<std::optional<size_t>> compaction_sorted_run_memory;
+    property<size_t> storage_recovery_concurrency;
+    property<size_t> storage_recovery_segment_concurrency;
+    property<size_t> storage_removal_concurrency;
+    property<size_t> readers_cache_max_prefetches;
+    property<size_t> readers_cache_prefetch_bytes;
+    property<std::optional<std::chrono::milliseconds>> storage_scrub_interval_ms;
+    property<size_t> storage_housekeeping_max_concurrency;
+    property<std::optional<std::chrono::milliseconds>>
+      storage_recompression_min_age_ms;
+    property<model::compression> storage_recompression_type;
+    property<size_t> in_memory_log_max_bytes;
     property<std::chrono::milliseconds> members_backend_retry_ms;
 
     // Archival storage
@@ -181,7 +246,18 @@ struct configuration final : public config_store {
     property<std::optional<ss::sstring>> cloud_storage_api_endpoint;
     property<std::chrono::milliseconds> cloud_storage_reconciliation_ms;
     property<int16_t> cloud_storage_max_connections;
+    property<size_t> cloud_storage_segment_upload_part_size;
+    property<size_t> cloud_storage_segment_upload_parallelism;
+    property<std::optional<size_t>> cloud_storage_max_upload_bandwidth;
+    property<size_t> cloud_storage_recovery_concurrency;
+    property<std::optional<size_t>> cloud_storage_max_recovery_bandwidth;
+    property<bool> cloud_storage_hydrate_replicas;
+    property<bool> cloud_storage_manifest_binary_format;
+    property<size_t> cloud_storage_manifest_max_deltas;
+    property<size_t> cloud_storage_upload_coalesce_size;
     property<bool> cloud_storage_disable_tls;
+    property<bool> cloud_storage_sign_payload;
+    property<std::optional<double>> cloud_storage_hedge_percentile;
     property<int16_t> cloud_storage_api_endpoint_port;
     property<std::optional<ss::sstring>> cloud_storage_trust_file;
     property<std::chrono::milliseconds> cloud_storage_initial_backoff_ms;
@@ -197,6 +273,10 @@ struct configuration final : public config_store {
     property<std::optional<ss::sstring>> cloud_storage_cache_directory;
     property<size_t> cloud_storage_cache_size;
     property<std::chrono::milliseconds> cloud_storage_cache_check_interval_ms;
+    property<bool> cloud_storage_enable_remote_read;
+    property<size_t> cloud_storage_cache_chunk_size;
+    property<size_t> cloud_storage_read_ahead_chunks;
+    property<size_t> cloud_storage_read_ahead_budget;
 
     one_or_many_property<ss::sstring> superusers;
 
@@ -213,7 +293,23 @@ struct configuration final : public config_store {
     property<size_t> kafka_qdc_min_depth;
     property<size_t> kafka_qdc_max_depth;
     property<std::chrono::milliseconds> kafka_qdc_depth_update_ms;
+    property<bool> kafka_concurrency_limit_enable;
+    property<std::chrono::milliseconds> kafka_concurrency_limit_target_ms;
+    property<size_t> kafka_concurrency_limit_min;
+    property<size_t> kafka_concurrency_limit_max;
+    property<size_t> kafka_max_inflight_requests_per_connection;
+    property<std::vector<ss::sstring>> kafka_tenant_scheduling_groups;
+    property<bool> kafka_latency_breakdown;
+    property<size_t> kafka_latency_breakdown_max_clients;
+    property<bool> partition_latency_breakdown;
+    property<ss::sstring> partition_metrics_aggregation;
+    property<std::vector<ss::sstring>> partition_metrics_topics;
+    property<bool> startup_self_test;
+    property<size_t> startup_self_test_disk_bytes;
+    property<size_t> startup_self_test_memory_bytes;
+    property<bool> startup_self_test_tune;
     property<size_t> zstd_decompress_workspace_bytes;
+    property<size_t> iobuf_fragment_pool_max_bytes;
     one_or_many_property<ss::sstring> full_raft_configuration_recovery_pattern;
     property<bool> enable_auto_rebalance_on_node_add;
 
@@ -221,8 +317,24 @@ struct configuration final : public config_store {
     property<std::chrono::milliseconds> leader_balancer_idle_timeout;
     property<std::chrono::milliseconds> leader_balancer_mute_timeout;
     property<std::chrono::milliseconds> leader_balancer_node_mute_timeout;
+    property<bool> leader_balancer_throughput_aware;
+    property<double> leader_balancer_throughput_ema_alpha;
+    property<uint32_t> leader_balancer_min_improvement_percent;
+    property<size_t> leader_balancer_max_transfers_per_minute;
     property<int> internal_topic_replication_factor;
     property<std::chrono::milliseconds> health_manager_tick_interval;
+    property<bool> enable_partition_balancer;
+    property<std::chrono::milliseconds> partition_balancer_tick_interval_ms;
+    property<size_t> partition_balancer_max_concurrent_moves;
+    property<uint32_t> partition_balancer_min_skew_percent;
+    property<uint32_t> kafka_recompression_cpu_budget_percent;
+    property<double> memory_kafka_fraction;
+    property<double> memory_rpc_fraction;
+    property<double> memory_chunk_cache_min_fraction;
+    property<double> memory_chunk_cache_max_fraction;
+    property<double> memory_chunk_cache_floor_fraction;
+    property<double> memory_chunk_cache_ceiling_fraction;
+    property<double> memory_segment_index_fraction;
 
     configuration();
 
@@ -480,6 +592,10 @@ struct convert<config::tls_config> {
             node["truststore_file"] = *rhs.get_truststore_file();
         }
 
+        if (rhs.get_priority_string()) {
+            node["priority_string"] = *rhs.get_priority_string();
+        }
+
         return node;
     }
 
@@ -513,7 +629,8 @@ struct convert<config::tls_config> {
               key_cert,
               to_absolute(read_optional(node, "truststore_file")),
               node["require_client_auth"]
-                && node["require_client_auth"].as<bool>());
+                && node["require_client_auth"].as<bool>(),
+              read_optional(node, "priority_string"));
         }
         return true;
     }
@@ -12,6 +12,7 @@
 #pragma once
 #include "config/base_property.h"
 #include "config/rjson_serialization.h"
+#include "utils/intrusive_list_helpers.h"
 #include "utils/to_string.h"
 
 #include <seastar/util/noncopyable_function.hh>
@@ -19,8 +20,14 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <concepts>
+#include <functional>
+
 namespace config {
 
+template<class T>
+class binding;
+
 template<class T>
 class property : public base_property {
 public:
@@ -70,32 +77,157 @@ public:
     }
 
     void set_value(std::any v) override {
-        _value = std::any_cast<T>(std::move(v));
+        update_value(std::any_cast<T>(std::move(v)));
+    }
+
+    std::optional<validation_error>
+    validate(const YAML::Node& n) const override {
+        if (auto err = _validator(decode(n)); err) {
+            return std::make_optional<validation_error>(name().data(), *err);
+        }
+        return std::nullopt;
     }
 
-    void set_value(YAML::Node n) override { _value = std::move(n.as<T>()); }
+    void set_value(YAML::Node n) override { update_value(decode(n)); }
 
     property<T>& operator()(T v) {
-        _value = std::move(v);
+        update_value(std::move(v));
         return *this;
     }
 
     base_property& operator=(const base_property& pr) override {
-        _value = dynamic_cast<const property<T>&>(pr)._value;
+        update_value(dynamic_cast<const property<T>&>(pr)._value);
         return *this;
     }
 
+    /// a copy of the value that is updated when the property changes, to
+    /// be held by components reading the property on their hot paths
+    binding<T> bind() const;
+
 protected:
+    /// sets the value and updates the bindings if it changed
+    void update_value(T v) {
+        if constexpr (std::equality_comparable<T>) {
+            if (v == _value) {
+                return;
+            }
+        }
+        _value = std::move(v);
+        notify_bindings();
+    }
+
+    void notify_bindings();
+
+    virtual T decode(const YAML::Node& n) const { return n.as<T>(); }
+
     T _value;
     const T _default;
 
 private:
+    friend class binding<T>;
     validator _validator;
+    // bindings are registered by const accessors of the property
+    mutable intrusive_list<binding<T>, &binding<T>::_hook> _bindings;
     constexpr static auto noop_validator = [](const auto&) {
         return std::nullopt;
     };
 };
 
+/**
+ * A shard local copy of the value of a property, kept up to date by the
+ * property when its value changes, e.g. with
+ *
+ *   _chunk_size = config::shard_local_cfg().append_chunk_size.bind();
+ *   ...
+ *   auto size = _chunk_size();
+ *
+ * Reading a binding is a plain member access. Components that need to react
+ * to a change register a callback with watch(), it runs after the value was
+ * updated. The property must outlive its bindings.
+ */
+template<class T>
+class binding {
+public:
+    explicit binding(const property<T>& p)
+      : _property(&p)
+      , _value(p.value()) {
+        p._bindings.push_back(*this);
+    }
+
+    /// a binding that is never updated, e.g. for tests
+    explicit binding(T v)
+      : _value(std::move(v)) {}
+
+    binding(const binding& o)
+      : _property(o._property)
+      , _value(o._value) {
+        if (_property) {
+            _property->_bindings.push_back(*this);
+        }
+    }
+    binding& operator=(const binding& o) {
+        if (this != &o) {
+            _hook.unlink();
+            _property = o._property;
+            _value = o._value;
+            _on_change = nullptr;
+            if (_property) {
+                _property->_bindings.push_back(*this);
+            }
+        }
+        return *this;
+    }
+    binding(binding&& o) noexcept
+      : _property(o._property)
+      , _value(std::move(o._value))
+      , _on_change(std::move(o._on_change)) {
+        _hook.swap_nodes(o._hook);
+    }
+    binding& operator=(binding&& o) noexcept {
+        if (this != &o) {
+            _hook.unlink();
+            _property = o._property;
+            _value = std::move(o._value);
+            _on_change = std::move(o._on_change);
+            _hook.swap_nodes(o._hook);
+        }
+        return *this;
+    }
+    ~binding() = default;
+
+    const T& operator()() const { return _value; }
+
+    /// \brief runs \p f after each change of the value
+    void watch(std::function<void()> f) { _on_change = std::move(f); }
+
+private:
+    friend class property<T>;
+
+    void update(const T& v) {
+        _value = v;
+        if (_on_change) {
+            _on_change();
+        }
+    }
+
+    const property<T>* _property{nullptr};
+    T _value;
+    std::function<void()> _on_change;
+    intrusive_list_hook _hook;
+};
+
+template<class T>
+binding<T> property<T>::bind() const {
+    return binding<T>(*this);
+}
+
+template<class T>
+void property<T>::notify_bindings() {
+    for (auto& b : _bindings) {
+        b.update(_value);
+    }
+}
+
 /*
  * Same as property<std::vector<T>> but will also decode a single T. This can be
  * useful for dealing with backwards compatibility or creating easier yaml
@@ -106,7 +238,8 @@ class one_or_many_property : public property<std::vector<T>> {
 public:
     using property<std::vector<T>>::property;
 
-    void set_value(YAML::Node n) override {
+protected:
+    std::vector<T> decode(const YAML::Node& n) const override {
         std::vector<T> value;
         if (n.IsSequence()) {
             for (auto elem : n) {
@@ -115,7 +248,7 @@ public:
         } else {
             value.push_back(std::move(n.as<T>()));
         }
-        this->_value = std::move(value);
+        return value;
     }
 };
 
@@ -139,7 +272,8 @@ public:
       , _min(min)
       , _max(max) {}
 
-    void set_value(YAML::Node n) override {
+protected:
+    T decode(const YAML::Node& n) const override {
         auto val = std::move(n.as<T>());
 
         if (val.has_value()) {
@@ -150,7 +284,7 @@ public:
                 val = std::min(val, _max.value());
             }
         }
-        this->_value = std::move(val);
+        return val;
     };
 
 private:
@@ -0,0 +1,90 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "config/config_store.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <optional>
+#include <utility>
+
+namespace {
+
+struct test_config : public config::config_store {
+    config::property<int> an_int;
+    config::property<std::optional<size_t>> a_limit;
+
+    test_config()
+      : an_int(*this, "an_int", "An int value", config::required::no, 10)
+      , a_limit(
+          *this,
+          "a_limit",
+          "An optional limit",
+          config::required::no,
+          std::nullopt,
+          [](const std::optional<size_t>& v) -> std::optional<ss::sstring> {
+              if (v && *v == 0) {
+                  return "must be positive";
+              }
+              return std::nullopt;
+          }) {}
+};
+
+} // namespace
+
+SEASTAR_THREAD_TEST_CASE(binding_follows_property) {
+    test_config cfg;
+    auto b = cfg.an_int.bind();
+    BOOST_REQUIRE_EQUAL(b(), 10);
+    cfg.an_int.set_value(YAML::Load("20"));
+    BOOST_REQUIRE_EQUAL(b(), 20);
+    cfg.an_int(30);
+    BOOST_REQUIRE_EQUAL(b(), 30);
+    cfg.read_yaml(YAML::Load("an_int: 40\n"));
+    BOOST_REQUIRE_EQUAL(b(), 40);
+}
+
+SEASTAR_THREAD_TEST_CASE(binding_watch) {
+    test_config cfg;
+    auto b = cfg.an_int.bind();
+    int changes = 0;
+    int seen = 0;
+    b.watch([&] {
+        ++changes;
+        seen = b();
+    });
+    cfg.an_int(11);
+    BOOST_REQUIRE_EQUAL(changes, 1);
+    BOOST_REQUIRE_EQUAL(seen, 11);
+    // setting the same value is not a change
+    cfg.an_int(11);
+    BOOST_REQUIRE_EQUAL(changes, 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(moved_and_copied_bindings) {
+    test_config cfg;
+    auto a = cfg.an_int.bind();
+    auto moved = std::move(a);
+    auto copied = moved;
+    std::optional<config::binding<int>> destroyed(cfg.an_int.bind());
+    destroyed.reset();
+    cfg.an_int(12);
+    BOOST_REQUIRE_EQUAL(moved(), 12);
+    BOOST_REQUIRE_EQUAL(copied(), 12);
+}
+
+SEASTAR_THREAD_TEST_CASE(validate_before_set) {
+    test_config cfg;
+    auto b = cfg.a_limit.bind();
+    BOOST_REQUIRE(cfg.a_limit.validate(YAML::Load("0")).has_value());
+    BOOST_REQUIRE(!cfg.a_limit.validate(YAML::Load("100")).has_value());
+    BOOST_REQUIRE(b() == std::nullopt);
+    cfg.a_limit.set_value(YAML::Load("100"));
+    BOOST_REQUIRE(b() == std::optional<size_t>(100));
+}
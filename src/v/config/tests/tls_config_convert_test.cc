@@ -90,3 +90,15 @@ SEASTAR_THREAD_TEST_CASE(test_decode_enabled_but_contains_empty_path) {
     BOOST_TEST(*full_cfg.get_truststore_file() == "");
     BOOST_TEST(!full_cfg.get_require_client_auth());
 }
+
+SEASTAR_THREAD_TEST_CASE(test_decode_priority_string) {
+    auto with_values = "tls_config:\n"
+                       "  enabled: true\n"
+                       "  priority_string: \"NORMAL:-VERS-ALL:+VERS-TLS1.3\"\n";
+    auto cfg = read_from_yaml(with_values);
+    BOOST_TEST(cfg.is_enabled());
+    BOOST_TEST(*cfg.get_priority_string() == "NORMAL:-VERS-ALL:+VERS-TLS1.3");
+
+    auto without = read_from_yaml("tls_config:\n  enabled: true\n");
+    BOOST_TEST(!without.get_priority_string());
+}
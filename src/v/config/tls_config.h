@@ -41,11 +41,13 @@ public:
       bool enabled,
       std::optional<key_cert> key_cert,
       std::optional<ss::sstring> truststore,
-      bool require_client_auth)
+      bool require_client_auth,
+      std::optional<ss::sstring> priority_string = std::nullopt)
       : _enabled(enabled)
       , _key_cert(std::move(key_cert))
       , _truststore_file(std::move(truststore))
-      , _require_client_auth(require_client_auth) {}
+      , _require_client_auth(require_client_auth)
+      , _priority_string(std::move(priority_string)) {}
 
     bool is_enabled() const { return _enabled; }
 
@@ -59,6 +61,14 @@ public:
 
     bool get_require_client_auth() const { return _require_client_auth; }
 
+    /// GnuTLS priority string selecting the protocol versions and cipher
+    /// suites offered. Records are encrypted in user space, putting ciphers
+    /// with hardware support first (e.g. AES-GCM on AES-NI cpus) is the main
+    /// lever on the cpu cost of encrypted connections.
+    const std::optional<ss::sstring>& get_priority_string() const {
+        return _priority_string;
+    }
+
     ss::future<std::optional<ss::tls::credentials_builder>>
     get_credentials_builder() const& {
         if (_enabled) {
@@ -69,6 +79,9 @@ public:
                   if (_require_client_auth) {
                       builder.set_client_auth(ss::tls::client_auth::REQUIRE);
                   }
+                  if (_priority_string) {
+                      builder.set_priority_string(*_priority_string);
+                  }
 
                   auto f = _truststore_file ? builder.set_x509_trust_file(
                              *_truststore_file, ss::tls::x509_crt_format::PEM)
@@ -112,6 +125,7 @@ private:
     std::optional<key_cert> _key_cert;
     std::optional<ss::sstring> _truststore_file;
     bool _require_client_auth{false};
+    std::optional<ss::sstring> _priority_string;
 };
 
 } // namespace config
@@ -127,7 +141,8 @@ static inline ostream& operator<<(ostream& o, const config::tls_config& c) {
       << "enabled: " << c.is_enabled() << " "
       << "key/cert files: " << c.get_key_cert_files() << " "
       << "ca file: " << c.get_truststore_file() << " "
-      << "client_auth_required: " << c.get_require_client_auth() << " }";
+      << "client_auth_required: " << c.get_require_client_auth() << " "
+      << "priority_string: " << c.get_priority_string() << " }";
     return o;
 }
 } // namespace std
@@ -11,6 +11,7 @@
 #include "coproc/event_handler.h"
 
 #include "coproc/ntp_context.h"
+#include "hashing/xx.h"
 #include "utils/gate_guard.h"
 #include "vlog.h"
 
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "coproc/materialized_write_batcher.h"
+
+#include "config/configuration.h"
+#include "prometheus/prometheus_sanitize.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
+
+namespace coproc {
+
+static ss::future<>
+append_batches(storage::log log, model::record_batch_reader::data_t batches) {
+    const storage::log_append_config write_cfg{
+      .should_fsync = storage::log_append_config::fsync::no,
+      .io_priority = ss::default_priority_class(),
+      .timeout = model::no_timeout};
+    /// One appender for all of the writes of the group
+    co_await model::make_memory_record_batch_reader(std::move(batches))
+      .for_each_ref(log.make_appender(write_cfg), model::no_timeout)
+      .discard_result();
+}
+
+materialized_write_batcher::materialized_write_batcher()
+  : _max_bytes(config::shard_local_cfg().coproc_write_coalesce_bytes())
+  , _linger(config::shard_local_cfg().coproc_write_coalesce_ms()) {
+    setup_metrics();
+}
+
+ss::future<> materialized_write_batcher::write(
+  storage::log log, model::record_batch_reader::data_t batches) {
+    if (_gate.is_closed()) {
+        return ss::make_exception_future<>(ss::gate_closed_exception());
+    }
+    ++_stats.writes;
+    model::ntp ntp = log.config().ntp();
+    auto [it, inserted] = _writes.try_emplace(ntp);
+    auto& w = it->second;
+    if (inserted) {
+        w.linger.set_callback([this, ntp] {
+            if (auto found = _writes.find(ntp); found != _writes.end()) {
+                dispatch(ntp, found->second);
+            }
+        });
+    }
+    if (!w.log) {
+        w.log = std::move(log);
+    }
+    for (auto& b : batches) {
+        w.bytes += b.size_bytes();
+        w.batches.push_back(std::move(b));
+    }
+    auto appended = w.appended->get_shared_future();
+    if (w.bytes >= _max_bytes || _linger == std::chrono::milliseconds(0)) {
+        dispatch(ntp, w);
+    } else if (!w.linger.armed()) {
+        w.linger.arm(_linger);
+    }
+    return appended;
+}
+
+void materialized_write_batcher::dispatch(
+  const model::ntp& ntp, ntp_writes& w) {
+    w.linger.cancel();
+    if (w.batches.empty()) {
+        return;
+    }
+    auto batches = std::exchange(w.batches, {});
+    auto appended = std::exchange(
+      w.appended, ss::make_lw_shared<ss::shared_promise<>>());
+    auto log = std::move(*w.log);
+    w.log.reset();
+    ++_stats.appends;
+    _stats.batches += batches.size();
+    _stats.bytes += std::exchange(w.bytes, 0);
+    ++w.appends_in_flight;
+    /// The entry is stable in the node_hash_map and is only removed once no
+    /// append of the ntp is in flight
+    (void)ss::with_gate(
+      _gate,
+      [this,
+       ntp,
+       &w,
+       log = std::move(log),
+       batches = std::move(batches),
+       appended = std::move(appended)]() mutable {
+          return w.append_lock
+            .with(
+              [log = std::move(log), batches = std::move(batches)]() mutable {
+                  return append_batches(std::move(log), std::move(batches));
+              })
+            .then_wrapped([this, ntp, appended](ss::future<> f) {
+                if (f.failed()) {
+                    appended->set_exception(f.get_exception());
+                } else {
+                    appended->set_value();
+                }
+                auto found = _writes.find(ntp);
+                if (
+                  --found->second.appends_in_flight == 0
+                  && found->second.batches.empty()) {
+                    _writes.erase(found);
+                }
+            });
+      });
+}
+
+ss::future<> materialized_write_batcher::stop() {
+    /// Appends may complete inline and remove their entry
+    std::vector<model::ntp> pending;
+    pending.reserve(_writes.size());
+    for (const auto& [ntp, w] : _writes) {
+        pending.push_back(ntp);
+    }
+    for (const auto& ntp : pending) {
+        if (auto found = _writes.find(ntp); found != _writes.end()) {
+            dispatch(ntp, found->second);
+        }
+    }
+    co_await _gate.close();
+}
+
+void materialized_write_batcher::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    namespace sm = ss::metrics;
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("coproc:materialized_writes"),
+      {
+        sm::make_derive(
+          "writes",
+          [this] { return _stats.writes; },
+          sm::description("Number of writes of script replies to materialized "
+                          "logs")),
+        sm::make_derive(
+          "appends",
+          [this] { return _stats.appends; },
+          sm::description("Number of appends to materialized logs, each "
+                          "coalesces one or more writes")),
+        sm::make_derive(
+          "batches_written",
+          [this] { return _stats.batches; },
+          sm::description("Number of batches appended to materialized logs")),
+        sm::make_total_bytes(
+          "written_bytes",
+          [this] { return _stats.bytes; },
+          sm::description("Number of bytes appended to materialized logs")),
+      });
+}
+
+} // namespace coproc
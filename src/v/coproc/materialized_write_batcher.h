@@ -0,0 +1,98 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "model/record_batch_reader.h"
+#include "seastarx.h"
+#include "storage/log.h"
+#include "utils/mutex.h"
+
+#include <seastar/core/gate.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/timer.hh>
+
+#include <absl/container/node_hash_map.h>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace coproc {
+
+/**
+ * Shard wide coalescing of the writes to materialized logs.
+ *
+ * Every reply of the wasm engine used to be written with its own append to
+ * the materialized log. Writes to the same materialized ntp, from any script
+ * and any reply, are instead queued and appended together once
+ * 'coproc_write_coalesce_bytes' are queued or 'coproc_write_coalesce_ms'
+ * after the first write of the group was queued, whichever comes first.
+ *
+ * The batches of a write are never split and the groups of an ntp are
+ * appended in the order they were queued. A write resolves once its group
+ * was appended, so that the input offsets are only acked for written data.
+ */
+class materialized_write_batcher {
+public:
+    materialized_write_batcher();
+    materialized_write_batcher(materialized_write_batcher&&) = delete;
+    materialized_write_batcher& operator=(materialized_write_batcher&&)
+      = delete;
+    materialized_write_batcher(const materialized_write_batcher&) = delete;
+    materialized_write_batcher& operator=(const materialized_write_batcher&)
+      = delete;
+    ~materialized_write_batcher() noexcept = default;
+
+    /// Queues the batches to be appended to the log, the future resolves
+    /// once they were appended
+    ss::future<> write(storage::log, model::record_batch_reader::data_t);
+
+    /// Appends the queued writes and waits for the appends in flight
+    ss::future<> stop();
+
+private:
+    struct ntp_writes {
+        std::optional<storage::log> log;
+        /// Batches of the group being filled
+        model::record_batch_reader::data_t batches;
+        size_t bytes{0};
+        ss::lw_shared_ptr<ss::shared_promise<>> appended{
+          ss::make_lw_shared<ss::shared_promise<>>()};
+        ss::timer<> linger;
+        /// Keeps the appends of the groups in order
+        mutex append_lock;
+        /// Groups dispatched and not appended yet, the entry is removed once
+        /// it is idle
+        size_t appends_in_flight{0};
+    };
+
+    void dispatch(const model::ntp&, ntp_writes&);
+    void setup_metrics();
+
+    struct stats {
+        uint64_t writes{0};
+        uint64_t appends{0};
+        uint64_t batches{0};
+        uint64_t bytes{0};
+    };
+
+    size_t _max_bytes;
+    std::chrono::milliseconds _linger;
+    absl::node_hash_map<model::ntp, ntp_writes> _writes;
+    stats _stats;
+    ss::gate _gate;
+    ss::metrics::metric_groups _metrics;
+};
+
+} // namespace coproc
@@ -14,16 +14,18 @@
 #include "cluster/partition.h"
 #include "cluster/partition_manager.h"
 #include "config/configuration.h"
+#include "coproc/materialized_write_batcher.h"
+#include "coproc/supervisor_transports.h"
 #include "coproc/sys_refs.h"
 #include "coproc/types.h"
 #include "random/simple_time_jitter.h"
-#include "rpc/reconnect_transport.h"
 #include "utils/mutex.h"
 
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/shared_ptr.hh>
 
 #include <absl/container/btree_map.h>
+#include <absl/container/btree_set.h>
 #include <absl/container/node_hash_map.h>
 
 #include <chrono>
@@ -40,6 +42,21 @@ struct ntp_context {
     struct offset_pair {
         model::offset last_read{};
         model::offset last_acked{};
+
+        /// First offset of the input that was not acked yet
+        model::offset first_unacked() const {
+            return last_acked == model::offset{}
+                     ? model::offset(0)
+                     : last_acked + model::offset(1);
+        }
+    };
+
+    /// Reads of the ntp for a script which are in requests not processed yet
+    struct read_claim {
+        /// Script whose fiber sent the requests, it applies their replies
+        script_id owner;
+        /// Number of requests in flight containing a read for the script
+        size_t requests{0};
     };
 
     using offset_tracker = absl::btree_map<script_id, offset_pair>;
@@ -54,6 +71,14 @@ struct ntp_context {
 
     /// Interested scripts write their last read offset of the input ntp
     offset_tracker offsets;
+
+    /// Scripts registered on 'this' shard to receive updates for the ntp.
+    /// Scripts that would read the same range share a single read
+    absl::btree_set<script_id> subscribers;
+
+    /// Scripts with reads of the ntp being processed, either by their own
+    /// fiber or by the fiber of a script which shares its reads with them
+    absl::btree_map<script_id, read_claim> in_flight;
 };
 
 using ntp_context_cache
@@ -71,8 +96,8 @@ struct shared_script_resources {
     ss::semaphore read_sem{
       config::shard_local_cfg().coproc_max_ingest_bytes.value()};
 
-    /// Underlying transport connection to the wasm engine
-    rpc::reconnect_transport transport;
+    /// Underlying transport connections to the wasm engine
+    supervisor_transports transports;
 
     /// A mutex per materialized log is required as concurrency is not
     /// guaranteed across script contexts. Two scripts writing to the same
@@ -82,11 +107,14 @@ struct shared_script_resources {
     /// to elements within the collection are used
     absl::node_hash_map<model::ntp, mutex> log_mtx;
 
+    /// Coalesces the writes of all scripts to the materialized logs
+    materialized_write_batcher write_batcher;
+
     /// References to other redpanda components
     sys_refs& rs;
 
-    shared_script_resources(rpc::reconnect_transport t, sys_refs& rs)
-      : transport(std::move(t))
+    shared_script_resources(unresolved_address addr, sys_refs& rs)
+      : transports(std::move(addr))
       , rs(rs) {}
 };
 
@@ -88,7 +88,13 @@ ss::future<> save_offsets(
       ntp_cache.end(),
       std::inserter(irm_map, irm_map.end()),
       [](const ntp_context_cache::value_type& p) {
-          return std::make_pair<>(p.first, p.second->offsets);
+          /// Ranges of requests still in flight are read again after a
+          /// restart, only the acked offsets are stored
+          ntp_context::offset_tracker offsets = p.second->offsets;
+          for (auto& [_, o] : offsets) {
+              o.last_read = o.last_acked;
+          }
+          return std::make_pair<>(p.first, std::move(offsets));
       });
     iobuf data;
     co_await reflection::async_adl<iresults_map>{}.to(data, std::move(irm_map));
@@ -34,27 +34,8 @@
 
 namespace coproc {
 
-rpc::transport_configuration
-wasm_transport_cfg(const unresolved_address& addr) {
-    return rpc::transport_configuration{
-      .server_addr = addr,
-      .max_queued_bytes = static_cast<uint32_t>(
-        config::shard_local_cfg().coproc_max_inflight_bytes.value()),
-      .credentials = nullptr,
-      .disable_metrics = rpc::metrics_disabled(
-        config::shard_local_cfg().disable_metrics())};
-}
-
-rpc::backoff_policy wasm_transport_backoff() {
-    using namespace std::chrono_literals;
-    return rpc::make_exponential_backoff_policy<rpc::clock_type>(1s, 10s);
-}
-
 pacemaker::pacemaker(unresolved_address addr, sys_refs& rs)
-  : _shared_res(
-    rpc::reconnect_transport(
-      wasm_transport_cfg(addr), wasm_transport_backoff()),
-    rs) {
+  : _shared_res(std::move(addr), rs) {
     _offs.timer.set_callback([this] {
         (void)ss::with_gate(_gate, [this] {
             return save_offsets(_offs.snap, _ntps).then([this] {
@@ -107,9 +88,11 @@ ss::future<> pacemaker::stop() {
     if (n_removed != n_active_scripts) {
         vlog(coproclog.error, "Failed to gracefully shutdown all copro fibers");
     }
-    /// Finally close the connection to the wasm engine
-    vlog(coproclog.info, "Closing connection to coproc wasm engine");
-    co_await _shared_res.transport.stop();
+    /// Append the outputs still queued by the removed scripts
+    co_await _shared_res.write_batcher.stop();
+    /// Finally close the connections to the wasm engine
+    vlog(coproclog.info, "Closing connections to coproc wasm engine");
+    co_await _shared_res.transports.stop();
     co_await std::move(gate_closed);
 }
 
@@ -18,6 +18,7 @@
 #include "coproc/types.h"
 #include "model/record_batch_reader.h"
 #include "model/timeout_clock.h"
+#include "raft/offset_monitor.h"
 #include "storage/api.h"
 #include "storage/parser_utils.h"
 #include "storage/types.h"
@@ -25,6 +26,7 @@
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/sleep.hh>
+#include <seastar/core/when_all.hh>
 
 #include <chrono>
 #include <exception>
@@ -42,6 +44,9 @@ script_context::script_context(
       !_ntp_ctxs.empty(),
       "Unallowed to create an instance of script_context without having a "
       "valid subscription list");
+    for (auto& [_, ntp_ctx] : _ntp_ctxs) {
+        ntp_ctx->subscribers.emplace(_id);
+    }
 }
 
 ss::future<> script_context::start() {
@@ -53,7 +58,10 @@ ss::future<> script_context::start() {
               /// do_execute is by design expected to throw one type of
               /// exception, \ref script_failed_exception for which there is a
               /// handler setup by the invoker of this start() method
-              return do_execute().then([this] {
+              return do_execute().then([this](loop_exit exit) {
+                  if (exit == loop_exit::caught_up) {
+                      return park();
+                  }
                   return ss::sleep_abortable(
                            _resources.jitter.next_jitter_duration(),
                            _abort_source)
@@ -63,75 +71,165 @@ ss::future<> script_context::start() {
     });
 }
 
-ss::future<> script_context::do_execute() {
+ss::future<script_context::loop_exit> script_context::do_execute() {
     /// This loop executes while there is data to read from the input logs and
     /// while there is a current successful connection to the wasm engine.
-    /// If both of those conditions aren't met, the loop breaks, hitting the
-    /// sleep_abortable() call in the fiber started by 'start()'
-    return ss::repeat([this] {
-        if (_abort_source.abort_requested()) {
-            return ss::make_ready_future<ss::stop_iteration>(
-              ss::stop_iteration::yes);
+    /// If both of those conditions aren't met, the loop breaks, parking the
+    /// fiber started by 'start()' or sleeping before it tries again
+    std::exception_ptr eptr;
+    loop_exit exit = loop_exit::retry;
+    try {
+        while (!_abort_source.abort_requested()) {
+            const bool connected = co_await fill_window();
+            if (_window.empty()) {
+                /// No data to read from all inputs or no connection to the
+                /// wasm engine, no need to incessently loop, exit to yield
+                if (connected) {
+                    exit = loop_exit::caught_up;
+                }
+                break;
+            }
+            if (!co_await apply_oldest()) {
+                break;
+            }
         }
-        return _resources.transport.get_connected(model::no_timeout)
-          .then([this](result<rpc::transport*> transport) {
-              if (!transport) {
-                  /// Failed to connected to the wasm engine for whatever
-                  /// reason, exit to yield
-                  return ss::make_ready_future<ss::stop_iteration>(
-                    ss::stop_iteration::yes);
-              }
-              supervisor_client_protocol client(*transport.value());
-              input_read_args args{
-                .id = _id,
-                .read_sem = _resources.read_sem,
-                .abort_src = _abort_source,
-                .inputs = _ntp_ctxs};
-              return read_from_inputs(args).then(
-                [this, client = std::move(client)](
-                  std::vector<process_batch_request::data> requests) mutable {
-                    if (requests.empty()) {
-                        /// No data to read from all inputs, no need to
-                        /// incessently loop, can exit to yield
-                        return ss::make_ready_future<ss::stop_iteration>(
-                          ss::stop_iteration::yes);
-                    }
-                    /// Send request to wasm engine
-                    process_batch_request req{.reqs = std::move(requests)};
-                    return send_request(std::move(client), std::move(req))
-                      .then([] { return ss::stop_iteration::no; });
-                });
-          });
-    });
+    } catch (...) {
+        eptr = std::current_exception();
+    }
+    /// Replies following a failure are not applied, their ranges are read
+    /// again once the fiber resumes
+    co_await drain_window();
+    if (eptr) {
+        std::rethrow_exception(eptr);
+    }
+    co_return exit;
 }
 
-ss::future<> script_context::shutdown() {
-    _abort_source.request_abort();
-    return _gate.close().then([this] { _ntp_ctxs.clear(); });
+ss::future<> script_context::park() {
+    /// The first input with data past its snapshot wakes the fiber up and
+    /// cancels the waits on the other inputs
+    ss::abort_source wakeup;
+    auto wake = [&wakeup]() noexcept {
+        if (!wakeup.abort_requested()) {
+            wakeup.request_abort();
+        }
+    };
+    auto sub = _abort_source.subscribe(wake);
+    if (!sub) {
+        co_return;
+    }
+    const auto deadline = model::timeout_clock::now() + max_park_duration;
+    std::vector<ss::future<>> waits;
+    waits.reserve(_watermarks.size());
+    for (const auto& [ntp, ctx] : _ntp_ctxs) {
+        auto found = _watermarks.find(ntp);
+        if (found == _watermarks.end()) {
+            continue;
+        }
+        waits.push_back(
+          ctx->partition->raft()
+            ->visible_offset_monitor()
+            .wait(found->second, deadline, wakeup)
+            .then(wake)
+            .handle_exception_type(
+              [](const raft::offset_monitor::wait_aborted&) {}));
+    }
+    co_await ss::when_all(waits.begin(), waits.end());
 }
 
-ss::future<> script_context::send_request(
-  supervisor_client_protocol client, process_batch_request r) {
-    using reply_t = result<rpc::client_context<process_batch_reply>>;
-    return client
-      .process_batch(
-        std::move(r), rpc::client_opts(rpc::clock_type::now() + 5s))
-      .then([this](reply_t reply) {
-          if (reply) {
-              output_write_args args{
-                .id = _id,
-                .rs = _resources.rs,
-                .inputs = _ntp_ctxs,
-                .locks = _resources.log_mtx};
-              return write_materialized(
-                std::move(reply.value().data.resps), args);
-          }
-          vlog(
-            coproclog.warn,
-            "Error upon attempting to perform RPC to wasm engine, code: {}",
-            reply.error());
-          return ss::now();
-      });
+ss::future<bool> script_context::fill_window() {
+    const size_t max_requests = std::max<size_t>(
+      config::shard_local_cfg().coproc_max_inflight_requests(), 1);
+    while (_window.size() < max_requests
+           && !_abort_source.abort_requested()) {
+        auto transport = co_await _resources.transports.next().get_connected(
+          model::no_timeout);
+        if (!transport) {
+            /// Failed to connected to the wasm engine for whatever reason
+            co_return false;
+        }
+        supervisor_client_protocol client(*transport.value());
+        input_read_args args{
+          .id = _id,
+          .read_sem = _resources.read_sem,
+          .abort_src = _abort_source,
+          .inputs = _ntp_ctxs,
+          .budgets = _read_budgets};
+        snapshot_watermarks();
+        input_read_results results = co_await read_from_inputs(args);
+        if (results.requests.empty()) {
+            co_return true;
+        }
+        /// Send request to wasm engine without waiting for the reply
+        process_batch_request req{.reqs = std::move(results.requests)};
+        _window.push_back(in_flight_request{
+          .claims = std::move(results.claims),
+          .reply = client.process_batch(
+            std::move(req), rpc::client_opts(rpc::clock_type::now() + 5s))});
+    }
+    co_return true;
+}
+
+void script_context::snapshot_watermarks() {
+    /// Data visible after the snapshot was taken may not have been read, the
+    /// fiber parks until data past it is visible
+    _watermarks.clear();
+    for (const auto& [ntp, ctx] : _ntp_ctxs) {
+        _watermarks.emplace(ntp, ctx->partition->high_watermark());
+    }
+}
+
+ss::future<bool> script_context::apply_oldest() {
+    in_flight_request req = std::move(_window.front());
+    _window.pop_front();
+    bool applied = false;
+    try {
+        reply_t reply = co_await std::move(req.reply);
+        if (reply) {
+            output_write_args args{
+              .id = _id,
+              .rs = _resources.rs,
+              .inputs = _ntp_ctxs,
+              .locks = _resources.log_mtx,
+              .batcher = _resources.write_batcher,
+              .claims = req.claims};
+            co_await write_materialized(
+              std::move(reply.value().data.resps), args);
+            applied = true;
+        } else {
+            vlog(
+              coproclog.warn,
+              "Error upon attempting to perform RPC to wasm engine, code: {}",
+              reply.error());
+        }
+    } catch (...) {
+        release_inputs(req.claims, _ntp_ctxs);
+        throw;
+    }
+    release_inputs(req.claims, _ntp_ctxs);
+    co_return applied;
+}
+
+ss::future<> script_context::drain_window() {
+    while (!_window.empty()) {
+        in_flight_request req = std::move(_window.front());
+        _window.pop_front();
+        co_await std::move(req.reply).discard_result().handle_exception(
+          [](const std::exception_ptr&) {});
+        release_inputs(req.claims, _ntp_ctxs);
+    }
+}
+
+ss::future<> script_context::shutdown() {
+    _abort_source.request_abort();
+    return _gate.close().then([this] {
+        /// Reads in flight in the fibers of other scripts stop sharing their
+        /// data with 'this' script
+        for (auto& [_, ntp_ctx] : _ntp_ctxs) {
+            ntp_ctx->subscribers.erase(_id);
+        }
+        _ntp_ctxs.clear();
+    });
 }
 
 } // namespace coproc
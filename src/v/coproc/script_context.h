@@ -12,6 +12,7 @@
 #pragma once
 
 #include "coproc/ntp_context.h"
+#include "coproc/script_context_frontend.h"
 #include "coproc/supervisor.h"
 #include "coproc/types.h"
 #include "random/simple_time_jitter.h"
@@ -21,6 +22,11 @@
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/shared_ptr.hh>
 
+#include <absl/container/flat_hash_map.h>
+
+#include <chrono>
+#include <deque>
+
 namespace coproc {
 
 /**
@@ -31,7 +37,14 @@ namespace coproc {
  * Important to note is the level of concurrency provided. Within a
  * script_context there is one fiber for which scheduled asynchronous work is
  * performed in sync, meaning that for each read -> send -> write that occurs
- * within the run loop, those actions will occur in order.
+ * within the run loop, those actions will occur in order. Up to
+ * 'coproc_max_inflight_requests' requests may be sent before the reply of
+ * the first one is received, the writes of their replies keep the order of
+ * the reads.
+ *
+ * Once all of its inputs are read the fiber parks on the visible offset
+ * notifications of the input partitions rather than polling them, and the
+ * inputs that lag get larger read budgets, see 'read_from_inputs'.
  *
  * Since each script_context has one of these fibers of its own, no one context
  * will wait for work to be finished by another in order to continue making
@@ -69,12 +82,47 @@ public:
     ss::future<> shutdown();
 
 private:
-    ss::future<> do_execute();
+    using reply_t = result<rpc::client_context<process_batch_reply>>;
+
+    /// Why the run loop of the fiber stopped
+    enum class loop_exit {
+        /// All of the inputs were read and their replies applied
+        caught_up,
+        /// No connection to the wasm engine or a request failed
+        retry
+    };
+
+    /// Upper bound of a park, so that reads that could not be served by the
+    /// offset notifications, e.g. ranges rewound after a failed shared read,
+    /// are retried eventually
+    static constexpr auto max_park_duration = std::chrono::seconds(10);
+
+    /// A request sent to the wasm engine whose reply was not applied yet
+    struct in_flight_request {
+        input_claims claims;
+        ss::future<reply_t> reply;
+    };
+
+    ss::future<loop_exit> do_execute();
 
-    ss::future<>
-      send_request(supervisor_client_protocol, process_batch_request);
+    /// Waits until one of the inputs has data past its last snapshot, instead
+    /// of polling inputs that are caught up
+    ss::future<> park();
 
-    ss::future<> process_reply(process_batch_reply);
+    /// Reads and sends requests until the window of requests in flight is
+    /// full or there is no more data to read. Returns false if there is no
+    /// connection to the wasm engine
+    ss::future<bool> fill_window();
+
+    /// Records the high watermarks of the inputs before they are read
+    void snapshot_watermarks();
+
+    /// Waits for the reply of the oldest request in flight and applies it.
+    /// Returns false if the request failed
+    ss::future<bool> apply_oldest();
+
+    /// Waits for the requests in flight, their replies are not applied
+    ss::future<> drain_window();
 
 private:
     /// Killswitch for in-process reads
@@ -91,6 +139,16 @@ private:
     /// receiving updates for
     ntp_context_cache _ntp_ctxs;
 
+    /// Requests sent to the wasm engine, in the order they were sent, their
+    /// replies are applied in that order
+    std::deque<in_flight_request> _window;
+
+    /// High watermarks of the inputs before the last read, see 'park()'
+    absl::flat_hash_map<model::ntp, model::offset> _watermarks;
+
+    /// Read budgets of the inputs that are lagging
+    read_budgets _read_budgets;
+
     /// Uniquely identifying script id. Generated by coproc engine
     script_id _id;
 };
@@ -20,6 +20,9 @@
 #include "vlog.h"
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/when_all.hh>
+
+#include <algorithm>
 
 namespace coproc {
 class crc_failed_exception final : public exception {
@@ -52,8 +55,11 @@ private:
     model::record_batch_reader::data_t _batches;
 };
 
-static ss::future<> do_write_materialized_partition(
-  storage::log log, model::record_batch_reader reader) {
+/// Checks and compresses the batches of a reply, they are written by the
+/// shard wide batcher
+static ss::future<model::record_batch_reader::data_t>
+prepare_materialized_batches(
+  const model::ntp& ntp, model::record_batch_reader reader) {
     /// Re-write all batch term_ids to 1, otherwise they will carry the
     /// term ids of records coming from parent batches
     auto [success, batch_w_correct_terms]
@@ -64,8 +70,7 @@ static ss::future<> do_write_materialized_partition(
     if (!success) {
         /// In the case crc checks failed, do NOT write records to storage
         throw crc_failed_exception(fmt::format(
-          "Batch failed crc checks, check wasm engine impl: {}",
-          log.config().ntp()));
+          "Batch failed crc checks, check wasm engine impl: {}", ntp));
     }
     /// Compress the data before writing...
     auto compressed = co_await std::move(batch_w_correct_terms)
@@ -73,14 +78,8 @@ static ss::future<> do_write_materialized_partition(
                           storage::internal::compress_batch_consumer(
                             model::compression::zstd, 512),
                           model::no_timeout);
-    const storage::log_append_config write_cfg{
-      .should_fsync = storage::log_append_config::fsync::no,
-      .io_priority = ss::default_priority_class(),
-      .timeout = model::no_timeout};
-    /// Finally, write the batch
-    co_await std::move(compressed)
-      .for_each_ref(log.make_appender(write_cfg), model::no_timeout)
-      .discard_result();
+    co_return co_await model::consume_reader_to_memory(
+      std::move(compressed), model::no_timeout);
 }
 
 static ss::future<storage::log>
@@ -157,27 +156,44 @@ static ss::future<> write_materialized_partition(
     if (found == args.locks.end()) {
         found = args.locks.emplace(ntp, mutex()).first;
     }
-    return found->second.with(
-      [args, ntp, ctx, reader = std::move(reader)]() mutable {
-          model::topic_namespace source(ctx->ntp().ns, ctx->ntp().tp.topic);
-          model::topic_namespace new_materialized(ntp.ns, ntp.tp.topic);
-          return maybe_make_materialized_log(
-                   source, new_materialized, ctx->partition->is_leader(), args)
-            .then([args, ntp] {
-                return get_log(args.rs.storage.local().log_mgr(), ntp);
-            })
-            .then([ntp, reader = std::move(reader)](storage::log log) mutable {
-                return do_write_materialized_partition(log, std::move(reader));
-            });
-      });
+    /// The batches are queued under the mutex to keep their order, the append
+    /// is awaited after releasing it so that later writes join the group
+    ss::future<> written = ss::make_ready_future<>();
+    {
+        auto units = co_await found->second.get_units();
+        model::topic_namespace source(ctx->ntp().ns, ctx->ntp().tp.topic);
+        model::topic_namespace new_materialized(ntp.ns, ntp.tp.topic);
+        co_await maybe_make_materialized_log(
+          source, new_materialized, ctx->partition->is_leader(), args);
+        auto log = co_await get_log(args.rs.storage.local().log_mgr(), ntp);
+        auto batches = co_await prepare_materialized_batches(
+          ntp, std::move(reader));
+        written = args.batcher.write(std::move(log), std::move(batches));
+    }
+    co_await std::move(written);
 }
 
-/// TODO: If we group replies by destination topic, we can increase write
-/// throughput, be attentive to maintain relative ordering though..
 static ss::future<>
 process_one_reply(process_batch_reply::data e, output_write_args args) {
-    /// Ensure this 'script_context' instance is handling the correct reply
-    if (e.id != args.id()) {
+    /// Use the source topic portion of the materialized topic to perform a
+    /// lookup for the relevent 'ntp_context'
+    auto found = args.inputs.find(e.source);
+    if (found == args.inputs.end()) {
+        vlog(
+          coproclog.warn,
+          "script {} unknown source ntp: {}",
+          args.id,
+          e.source);
+        co_return;
+    }
+    /// Ensure the reply is for 'this' script_context instance or for a script
+    /// that shared the read of 'this' script
+    auto claim = std::find_if(
+      args.claims.begin(), args.claims.end(), [&e](const input_claim& c) {
+          return c.ntp == e.source
+                 && std::find(c.ids.begin(), c.ids.end(), e.id) != c.ids.end();
+      });
+    if (claim == args.claims.end()) {
         /// TODO: Maybe in the future errors of these type should mean redpanda
         /// kill -9's the wasm engine.
         vlog(
@@ -188,7 +204,21 @@ process_one_reply(process_batch_reply::data e, output_write_args args) {
           e.id);
         co_return;
     }
+    if (!found->second->subscribers.contains(e.id)) {
+        /// The script sharing the read was deregistered in the meantime
+        co_return;
+    }
     if (!e.reader) {
+        if (e.id != args.id()) {
+            /// The script replays the read in its own fiber, which handles
+            /// the error
+            vlog(
+              coproclog.debug,
+              "script {} failed processing a read shared by script {}",
+              e.id,
+              args.id);
+            co_return;
+        }
         throw script_failed_exception(
           e.id,
           fmt::format(
@@ -196,17 +226,6 @@ process_one_reply(process_batch_reply::data e, output_write_args args) {
             "error",
             e.id));
     }
-    /// Use the source topic portion of the materialized topic to perform a
-    /// lookup for the relevent 'ntp_context'
-    auto found = args.inputs.find(e.source);
-    if (found == args.inputs.end()) {
-        vlog(
-          coproclog.warn,
-          "script {} unknown source ntp: {}",
-          args.id,
-          e.source);
-        co_return;
-    }
     auto ntp_ctx = found->second;
     try {
         co_await write_materialized_partition(
@@ -233,14 +252,17 @@ process_one_reply(process_batch_reply::data e, output_write_args args) {
         vlog(coproclog.trace, "Waiting for underlying log: {}", ex.what());
         co_return;
     }
-    auto ofound = ntp_ctx->offsets.find(args.id);
+    auto ofound = ntp_ctx->offsets.find(e.id);
     vassert(
       ofound != ntp_ctx->offsets.end(),
       "Offset not found for script id {} for ntp owning context: {}",
-      args.id,
+      e.id,
       ntp_ctx->ntp());
-    /// Reset the acked offset so that progress can be made
-    ofound->second.last_acked = ofound->second.last_read;
+    /// Reset the acked offset so that progress can be made, unless an earlier
+    /// range of a request still in flight was not acked
+    if (ofound->second.first_unacked() == claim->first) {
+        ofound->second.last_acked = claim->last;
+    }
 }
 
 ss::future<>
@@ -249,9 +271,15 @@ write_materialized(output_write_inputs replies, output_write_args args) {
         vlog(
           coproclog.error, "Wasm engine interpreted the request as erraneous");
     } else {
+        /// Every reply queues its write before suspending on the mutex of its
+        /// materialized log, so that the writes of all replies to the same
+        /// log can be appended together while keeping their order
+        std::vector<ss::future<>> writes;
+        writes.reserve(replies.size());
         for (auto& e : replies) {
-            co_await process_one_reply(std::move(e), args);
+            writes.push_back(process_one_reply(std::move(e), args));
         }
+        co_await ss::when_all_succeed(writes.begin(), writes.end());
     }
 }
 
@@ -11,7 +11,9 @@
 
 #pragma once
 
+#include "coproc/materialized_write_batcher.h"
 #include "coproc/ntp_context.h"
+#include "coproc/script_context_frontend.h"
 #include "coproc/sys_refs.h"
 #include "coproc/types.h"
 #include "utils/mutex.h"
@@ -30,6 +32,9 @@ struct output_write_args {
     sys_refs& rs;
     ntp_context_cache& inputs;
     absl::node_hash_map<model::ntp, mutex>& locks;
+    materialized_write_batcher& batcher;
+    /// Ranges of the inputs read for the request of the replies
+    const input_claims& claims;
 };
 
 /**
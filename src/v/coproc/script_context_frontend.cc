@@ -20,12 +20,50 @@
 #include "vlog.h"
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/util/defer.hh>
+
+#include <algorithm>
 
 namespace coproc {
 static std::size_t max_batch_size() {
     return config::shard_local_cfg().coproc_max_batch_size.value();
 }
 
+static std::size_t max_read_budget() {
+    return std::max(
+      max_batch_size(),
+      config::shard_local_cfg().coproc_max_ingest_bytes.value() / 4);
+}
+
+static std::size_t
+read_budget(const read_budgets& budgets, const model::ntp& ntp) {
+    auto found = budgets.find(ntp);
+    /// Bounded by the current limit in case the configuration changed
+    return found == budgets.end()
+             ? max_batch_size()
+             : std::clamp(found->second, max_batch_size(), max_read_budget());
+}
+
+/// Lagging reads double their budget unless other reads of the shard are
+/// waiting for ingest memory, reads that are caught up, or that compete for
+/// memory, halve it. Only budgets above the default are kept
+static void update_read_budget(
+  input_read_args& args,
+  const model::ntp& ntp,
+  std::size_t budget,
+  bool lagging) {
+    if (lagging && args.read_sem.waiters() == 0) {
+        budget = std::min(budget * 2, max_read_budget());
+    } else {
+        budget = budget / 2;
+    }
+    if (budget <= max_batch_size()) {
+        args.budgets.erase(ntp);
+    } else {
+        args.budgets[ntp] = budget;
+    }
+}
+
 class high_offset_tracker {
 public:
     struct batch_info {
@@ -44,21 +82,92 @@ private:
     batch_info _info;
 };
 
-storage::log_reader_config get_reader(
+/// Reads for a script continue after its last read while earlier requests
+/// with reads of the ntp are in flight, from its last acked offset otherwise
+static model::offset next_read_offset(
+  const ntp_context& ntp_ctx,
   script_id id,
+  const ntp_context::offset_pair& offsets) {
+    if (ntp_ctx.in_flight.contains(id)) {
+        return std::max(
+          offsets.last_read + model::offset(1), offsets.first_unacked());
+    }
+    return offsets.first_unacked();
+}
+
+storage::log_reader_config get_reader(
   ss::abort_source& abort_src,
-  const ss::lw_shared_ptr<ntp_context>& ntp_ctx) {
-    auto found = ntp_ctx->offsets.find(id);
+  const ss::lw_shared_ptr<ntp_context>& ntp_ctx,
+  model::offset next_read,
+  std::size_t budget) {
+    return storage::log_reader_config(
+      next_read,
+      ntp_ctx->partition->last_stable_offset(),
+      1,
+      budget,
+      ss::default_priority_class(),
+      model::record_batch_type::raft_data,
+      std::nullopt,
+      abort_src);
+}
+
+static void claim(ntp_context& ntp_ctx, script_id id, script_id owner) {
+    auto& c = ntp_ctx.in_flight[id];
+    c.owner = owner;
+    ++c.requests;
+}
+
+/// Claims the read of the ntp from 'next_read' for the script and for the
+/// other subscribed scripts that would read the ntp from the same offset and
+/// have no reads in flight, or only reads sent by 'this' script. They share
+/// the read and receive the same batches in a single request
+static std::vector<script_id> claim_readers(
+  script_id id, model::offset next_read, ntp_context& ntp_ctx) {
+    std::vector<script_id> ids{id};
+    for (const auto& [peer, offsets] : ntp_ctx.offsets) {
+        if (peer == id || !ntp_ctx.subscribers.contains(peer)) {
+            continue;
+        }
+        auto found = ntp_ctx.in_flight.find(peer);
+        if (found != ntp_ctx.in_flight.end() && found->second.owner != id) {
+            continue;
+        }
+        if (next_read_offset(ntp_ctx, peer, offsets) == next_read) {
+            ids.push_back(peer);
+        }
+    }
+    for (const auto& claimed : ids) {
+        claim(ntp_ctx, claimed, id);
+    }
+    return ids;
+}
+
+static void release_reader(ntp_context& ntp_ctx, script_id id) {
+    auto found = ntp_ctx.in_flight.find(id);
+    if (found != ntp_ctx.in_flight.end() && --found->second.requests == 0) {
+        ntp_ctx.in_flight.erase(found);
+    }
+}
+
+ss::future<> read_ntp(
+  input_read_args args,
+  ss::lw_shared_ptr<ntp_context> ntp_ctx,
+  std::size_t budget,
+  input_read_results& results) {
+    if (auto found = ntp_ctx->in_flight.find(args.id);
+        found != ntp_ctx->in_flight.end() && found->second.owner != args.id) {
+        /// The reads of the ntp were claimed by another script sharing them
+        co_return;
+    }
+    auto found = ntp_ctx->offsets.find(args.id);
     vassert(
       found != ntp_ctx->offsets.end(),
       "script_id must exist: {} for ntp: {}",
-      id,
+      args.id,
       ntp_ctx->ntp());
     const ntp_context::offset_pair& cp_offsets = found->second;
-    const model::offset next_read
-      = (unlikely(cp_offsets.last_acked == model::offset{}))
-          ? model::offset(0)
-          : cp_offsets.last_acked + model::offset(1);
+    const model::offset next_read = next_read_offset(
+      *ntp_ctx, args.id, cp_offsets);
     if (next_read <= cp_offsets.last_acked) {
         vlog(
           coproclog.info,
@@ -66,54 +175,82 @@ storage::log_reader_config get_reader(
           ntp_ctx->ntp(),
           cp_offsets.last_read);
     }
-    return storage::log_reader_config(
-      next_read,
-      ntp_ctx->partition->last_stable_offset(),
-      1,
-      max_batch_size(),
-      ss::default_priority_class(),
-      model::record_batch_type::raft_data,
-      std::nullopt,
-      abort_src);
-}
-
-ss::future<std::optional<process_batch_request::data>>
-read_ntp(input_read_args args, ss::lw_shared_ptr<ntp_context> ntp_ctx) {
+    auto ids = claim_readers(args.id, next_read, *ntp_ctx);
+    auto release = ss::defer([&ids, ntp_ctx] {
+        for (const auto& id : ids) {
+            release_reader(*ntp_ctx, id);
+        }
+    });
     storage::log_reader_config cfg = get_reader(
-      args.id, args.abort_src, ntp_ctx);
+      args.abort_src, ntp_ctx, next_read, budget);
     auto rbr = co_await ntp_ctx->partition->make_reader(cfg);
     auto read_result = co_await std::move(rbr).for_each_ref(
       coproc::reference_window_consumer(
         high_offset_tracker(), storage::internal::decompress_batch_consumer()),
       model::no_timeout);
     auto& [info, nrbr] = read_result;
+    update_read_budget(
+      args,
+      ntp_ctx->ntp(),
+      budget,
+      info.size > 0
+        && info.last + model::offset(1)
+             < ntp_ctx->partition->last_stable_offset());
     if (info.size == 0) {
-        co_return std::nullopt;
+        co_return;
+    }
+    for (const auto& id : ids) {
+        if (auto it = ntp_ctx->offsets.find(id); it != ntp_ctx->offsets.end()) {
+            it->second.last_read = info.last;
+        }
     }
-    ntp_ctx->offsets[args.id].last_read = info.last;
-    co_return process_batch_request::data{
-      .ids = std::vector<script_id>{args.id},
+    /// The claims are released by 'release_inputs' once the reply for the
+    /// request was processed
+    release.cancel();
+    results.claims.push_back(input_claim{
       .ntp = ntp_ctx->ntp(),
-      .reader = std::move(nrbr)};
+      .ids = ids,
+      .first = next_read,
+      .last = info.last});
+    results.requests.push_back(process_batch_request::data{
+      .ids = std::move(ids), .ntp = ntp_ctx->ntp(), .reader = std::move(nrbr)});
 }
 
-ss::future<std::vector<process_batch_request::data>>
-read_from_inputs(input_read_args args) {
-    std::vector<process_batch_request::data> requests;
-    requests.reserve(args.inputs.size());
-    auto read_all = [args, &requests](const ntp_context_cache::value_type& p) {
+ss::future<input_read_results> read_from_inputs(input_read_args args) {
+    input_read_results results;
+    results.requests.reserve(args.inputs.size());
+    results.claims.reserve(args.inputs.size());
+    auto read_all = [args, &results](const ntp_context_cache::value_type& p) {
+        const std::size_t budget = read_budget(args.budgets, p.first);
         return ss::with_semaphore(
-                 args.read_sem,
-                 max_batch_size(),
-                 [args, ctx = p.second]() { return read_ntp(args, ctx); })
-          .then([&requests](auto request) {
-              if (request) {
-                  requests.push_back(std::move(*request));
-              }
+          args.read_sem, budget, [args, ctx = p.second, budget, &results]() {
+              return read_ntp(args, ctx, budget, results);
           });
     };
     co_await ss::parallel_for_each(args.inputs, std::move(read_all));
-    co_return requests;
+    co_return results;
+}
+
+void release_inputs(const input_claims& claims, ntp_context_cache& inputs) {
+    for (const auto& c : claims) {
+        auto found = inputs.find(c.ntp);
+        if (found == inputs.end()) {
+            continue;
+        }
+        auto& ntp_ctx = *found->second;
+        for (const auto& id : c.ids) {
+            release_reader(ntp_ctx, id);
+            auto offsets = ntp_ctx.offsets.find(id);
+            if (offsets == ntp_ctx.offsets.end()) {
+                continue;
+            }
+            /// The range was next to be acked but was not, read it again.
+            /// Later ranges in flight are not acked since they follow it
+            if (offsets->second.first_unacked() == c.first) {
+                offsets->second.last_read = offsets->second.last_acked;
+            }
+        }
+    }
 }
 
 } // namespace coproc
@@ -21,9 +21,29 @@
 #include <absl/container/flat_hash_map.h>
 
 namespace coproc {
-/// Type of result to expect from 'read_from_inputs', to be immeadiately
-/// dispatched to a wasm engine
-using input_read_results = std::vector<process_batch_request::data>;
+/// Range of an input ntp read for a request, on behalf of the scripts which
+/// share the read
+struct input_claim {
+    model::ntp ntp;
+    std::vector<script_id> ids;
+    /// First and last offsets of the read
+    model::offset first;
+    model::offset last;
+};
+
+/// Claims of all of the input ntps read for one request
+using input_claims = std::vector<input_claim>;
+
+/// Type of result to expect from 'read_from_inputs', the requests are to be
+/// immeadiately dispatched to a wasm engine
+struct input_read_results {
+    std::vector<process_batch_request::data> requests;
+    input_claims claims;
+};
+
+/// Read budgets of the input ntps of a script that are grown above
+/// 'coproc_max_batch_size' as they are lagging
+using read_budgets = absl::flat_hash_map<model::ntp, size_t>;
 
 /// Arugments to pass to 'read_from_inputs', trivially copyable
 struct input_read_args {
@@ -31,6 +51,7 @@ struct input_read_args {
     ss::semaphore& read_sem;
     ss::abort_source& abort_src;
     ntp_context_cache& inputs;
+    read_budgets& budgets;
 };
 
 /**
@@ -38,9 +59,31 @@ struct input_read_args {
  *
  * Abortable mechanism, reads from all input topics within the bounds of a
  * semaphaore. Contains a single side effect that will update the last read
- * offset from each corresponding input ntp.
+ * offset from each corresponding input ntp, for each script sharing the read.
+ *
+ * A read for an input ntp may be shared by all subscribed scripts that would
+ * read the ntp from the same offset, one supervisor request then carries the
+ * batches for all of them. Reads continue after the last read offset while
+ * earlier requests are in flight, so that a script may have several requests
+ * outstanding. Until the claims of a request are released with
+ * 'release_inputs' the scripts sharing its reads are read only by the fiber
+ * that sent it.
+ *
+ * The amount of data read from an ntp starts at 'coproc_max_batch_size' and
+ * doubles every time a read leaves data below the last stable offset, up to
+ * a quarter of 'coproc_max_ingest_bytes'. Budgets only grow while no other
+ * reads of the shard wait for ingest memory, and fall back as the script
+ * catches up or the shard is backlogged.
  * @params args
  * @return list of process_batch_requests to be sent to the wasm engine
  */
 ss::future<input_read_results> read_from_inputs(input_read_args);
+
+/**
+ * Releases the claims of a request once its reply was processed,
+ * successfully or not. The reads of the scripts whose range was not acked
+ * restart from their last acked offset, later replies of requests still in
+ * flight are not acked for them as they would skip the range.
+ */
+void release_inputs(const input_claims&, ntp_context_cache&);
 } // namespace coproc
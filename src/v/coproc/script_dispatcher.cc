@@ -152,7 +152,7 @@ script_dispatcher::script_dispatcher(
   ss::sharded<pacemaker>& p, ss::abort_source& as)
   : _pacemaker(p)
   , _abort_source(as)
-  , _transport(_pacemaker.local().resources().transport) {}
+  , _transport(_pacemaker.local().resources().transports.control()) {}
 
 ss::future<std::vector<std::vector<coproc::errc>>>
 script_dispatcher::add_sources(
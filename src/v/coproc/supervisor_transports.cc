@@ -0,0 +1,63 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "coproc/supervisor_transports.h"
+
+#include "config/configuration.h"
+#include "rpc/types.h"
+
+#include <seastar/core/coroutine.hh>
+
+#include <algorithm>
+
+namespace coproc {
+
+static rpc::transport_configuration
+wasm_transport_cfg(const unresolved_address& addr, size_t connections) {
+    const size_t max_inflight
+      = config::shard_local_cfg().coproc_max_inflight_bytes.value();
+    return rpc::transport_configuration{
+      .server_addr = addr,
+      .max_queued_bytes = static_cast<uint32_t>(
+        std::max<size_t>(max_inflight / connections, 1)),
+      .credentials = nullptr,
+      .disable_metrics = rpc::metrics_disabled(
+        config::shard_local_cfg().disable_metrics())};
+}
+
+static rpc::backoff_policy wasm_transport_backoff() {
+    using namespace std::chrono_literals;
+    return rpc::make_exponential_backoff_policy<rpc::clock_type>(1s, 10s);
+}
+
+supervisor_transports::supervisor_transports(unresolved_address addr) {
+    const size_t connections = std::max<size_t>(
+      config::shard_local_cfg().coproc_supervisor_connections(), 1);
+    _transports.reserve(connections);
+    for (size_t i = 0; i < connections; ++i) {
+        _transports.push_back(std::make_unique<rpc::reconnect_transport>(
+          wasm_transport_cfg(addr, connections), wasm_transport_backoff()));
+    }
+}
+
+rpc::reconnect_transport& supervisor_transports::next() {
+    auto& t = *_transports[_next];
+    _next = (_next + 1) % _transports.size();
+    return t;
+}
+
+ss::future<> supervisor_transports::stop() {
+    for (auto& t : _transports) {
+        co_await t->stop();
+    }
+}
+
+} // namespace coproc
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "rpc/reconnect_transport.h"
+#include "seastarx.h"
+#include "utils/unresolved_address.h"
+
+#include <seastar/core/future.hh>
+
+#include <memory>
+#include <vector>
+
+namespace coproc {
+
+/**
+ * Connections of a shard to the wasm engine.
+ *
+ * A single connection serializes the requests of all of the scripts of the
+ * shard over one socket, which caps the throughput of coproc once requests
+ * carry large batches. The requests of the scripts are instead spread over
+ * 'coproc_supervisor_connections' connections in round robin, while the
+ * control messages of the script_dispatcher are sent on the first one.
+ *
+ * 'coproc_max_inflight_bytes' is split among the connections, so that the
+ * memory held by queued requests of the shard stays bounded by it.
+ */
+class supervisor_transports {
+public:
+    explicit supervisor_transports(unresolved_address);
+    supervisor_transports(supervisor_transports&&) = delete;
+    supervisor_transports& operator=(supervisor_transports&&) = delete;
+    supervisor_transports(const supervisor_transports&) = delete;
+    supervisor_transports& operator=(const supervisor_transports&) = delete;
+    ~supervisor_transports() noexcept = default;
+
+    /// Connection for deploying and removing scripts and for heartbeats
+    rpc::reconnect_transport& control() { return *_transports.front(); }
+
+    /// Connection for the next request to process batches
+    rpc::reconnect_transport& next();
+
+    size_t size() const { return _transports.size(); }
+
+    ss::future<> stop();
+
+private:
+    std::vector<std::unique_ptr<rpc::reconnect_transport>> _transports;
+    size_t _next{0};
+};
+
+} // namespace coproc
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "coproc/tests/fixtures/coproc_test_fixture.h"
+#include "coproc/tests/utils/coprocessor.h"
+#include "model/fundamental.h"
+#include "model/record_batch_reader.h"
+#include "storage/tests/utils/random_batch.h"
+#include "utils/hdr_hist.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <fmt/format.h>
+
+using namespace std::chrono_literals;
+
+// every iteration produces this many batches to each input partition, with
+// alternately 1 and 2 records so that the filter keeps half of the batches
+static constexpr size_t batches_per_iteration = 16;
+static constexpr size_t records_per_iteration = batches_per_iteration / 2 * 3;
+
+enum class transform { identity, filter };
+
+/// Measures the end-to-end throughput of the coproc pipeline, from the
+/// produce to the input topic until the outputs of all of the scripts are
+/// readable from their materialized topics, with the c++ stub of the wasm
+/// engine. Every script reads all of the `partitions` partitions of the
+/// input topic and writes to a materialized topic of its own.
+///
+/// Records per second are the input records processed by all of the
+/// scripts. The partitions are spread over the shards of the fixture, run
+/// with different values of -c to see how throughput scales with the shard
+/// count. The latency of an iteration includes the 20ms polling interval of
+/// the drains of the outputs.
+template<size_t scripts, size_t partitions, transform t>
+struct coproc_throughput_bench : coproc_test_fixture {
+    using copro_typeid = coproc::registry::type_identifier;
+
+    coproc_throughput_bench() {
+        setup({{input_topic, partitions}}).get();
+        std::vector<deploy> deploys;
+        for (uint64_t id = 0; id < scripts; ++id) {
+            deploys.push_back(
+              {.id = id,
+               .data{
+                 .tid = t == transform::identity
+                          ? copro_typeid::unique_identity_coprocessor
+                          : copro_typeid::unique_filter_coprocessor,
+                 .topics = {std::make_pair<>(input_topic, tp_stored)}}});
+            const auto output = to_materialized_topic(
+              input_topic,
+              model::topic(ssx::sformat(
+                "{}_{}",
+                t == transform::identity ? "identity_topic" : "filter_topic",
+                id)));
+            for (size_t p = 0; p < partitions; ++p) {
+                _outputs.emplace(
+                  model::ntp(
+                    model::kafka_namespace, output, model::partition_id(p)),
+                  model::offset(0));
+            }
+        }
+        enable_coprocessors(std::move(deploys)).get();
+        for (size_t p = 0; p < partitions; ++p) {
+            _inputs.emplace_back(
+              model::kafka_namespace, input_topic, model::partition_id(p));
+        }
+    }
+
+    ~coproc_throughput_bench() {
+        fmt::print(
+          "{} scripts, {} partitions, {} transform, {} shards: iteration "
+          "p50: {}us p99: {}us p999: {}us\n",
+          scripts,
+          partitions,
+          t == transform::identity ? "identity" : "filter",
+          ss::smp::count,
+          _hist.get_value_at(50),
+          _hist.get_value_at(99),
+          _hist.get_value_at(99.9));
+    }
+
+    static model::record_batch_reader make_batches() {
+        model::record_batch_reader::data_t batches;
+        for (size_t i = 0; i < batches_per_iteration; ++i) {
+            batches.push_back(storage::test::make_random_batch(
+              model::offset(0), static_cast<int>(i % 2 + 1), false));
+        }
+        return model::make_memory_record_batch_reader(std::move(batches));
+    }
+
+    ss::future<> drain_output(const model::ntp& ntp, model::offset& next) {
+        const size_t expected = t == transform::identity
+                                  ? batches_per_iteration
+                                  : batches_per_iteration / 2;
+        size_t drained = 0;
+        while (drained < expected) {
+            auto batches = co_await drain(
+              ntp,
+              expected - drained,
+              next,
+              model::timeout_clock::now() + 30s);
+            if (!batches || batches->empty()) {
+                throw std::runtime_error(
+                  fmt::format("Timed out draining output ntp: {}", ntp));
+            }
+            drained += batches->size();
+            next = batches->back().last_offset() + model::offset(1);
+        }
+    }
+
+    ss::future<size_t> run() {
+        perf_tests::start_measuring_time();
+        auto m = _hist.auto_measure();
+        co_await ss::parallel_for_each(_inputs, [this](const model::ntp& ntp) {
+            return push(ntp, make_batches()).discard_result();
+        });
+        co_await ss::parallel_for_each(_outputs, [this](auto& output) {
+            return drain_output(output.first, output.second);
+        });
+        perf_tests::stop_measuring_time();
+        co_return scripts * partitions * records_per_iteration;
+    }
+
+    model::topic input_topic{"coproc_bench"};
+    std::vector<model::ntp> _inputs;
+    /// Next offset to drain of every output
+    absl::flat_hash_map<model::ntp, model::offset> _outputs;
+    hdr_hist _hist;
+};
+
+using identity_1x1 = coproc_throughput_bench<1, 1, transform::identity>;
+using identity_1x16 = coproc_throughput_bench<1, 16, transform::identity>;
+using identity_8x1 = coproc_throughput_bench<8, 1, transform::identity>;
+using identity_8x16 = coproc_throughput_bench<8, 16, transform::identity>;
+using filter_1x1 = coproc_throughput_bench<1, 1, transform::filter>;
+using filter_1x16 = coproc_throughput_bench<1, 16, transform::filter>;
+using filter_8x1 = coproc_throughput_bench<8, 1, transform::filter>;
+using filter_8x16 = coproc_throughput_bench<8, 16, transform::filter>;
+
+PERF_TEST_F(identity_1x1, transform) { return run(); }
+PERF_TEST_F(identity_1x16, transform) { return run(); }
+PERF_TEST_F(identity_8x1, transform) { return run(); }
+PERF_TEST_F(identity_8x16, transform) { return run(); }
+PERF_TEST_F(filter_1x1, transform) { return run(); }
+PERF_TEST_F(filter_1x16, transform) { return run(); }
+PERF_TEST_F(filter_8x1, transform) { return run(); }
+PERF_TEST_F(filter_8x16, transform) { return run(); }
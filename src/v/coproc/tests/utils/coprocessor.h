@@ -128,6 +128,31 @@ private:
     model::topic _identity_topic;
 };
 
+/// Keeps the batches with an even number of records, on 1 output topic unique
+/// to the script like 'unique_identity_coprocessor'
+struct unique_filter_coprocessor : public coprocessor {
+    unique_filter_coprocessor(coproc::script_id sid, input_set input)
+      : coprocessor(sid, std::move(input))
+      , _filter_topic(model::topic(ssx::sformat("filter_topic_{}", sid()))) {}
+
+    ss::future<coprocessor::result> apply(
+      const model::topic&,
+      ss::circular_buffer<model::record_batch>&& batches) override {
+        ss::circular_buffer<model::record_batch> kept;
+        for (auto& b : batches) {
+            if (b.record_count() % 2 == 0) {
+                kept.push_back(std::move(b));
+            }
+        }
+        coprocessor::result r;
+        r.emplace(_filter_topic, std::move(kept));
+        return ss::make_ready_future<coprocessor::result>(std::move(r));
+    }
+
+private:
+    model::topic _filter_topic;
+};
+
 struct throwing_coprocessor : public coprocessor {
     throwing_coprocessor(coproc::script_id sid, input_set input)
       : coprocessor(sid, std::move(input)) {}
@@ -211,7 +236,8 @@ enum class type_identifier {
     identity_coprocessor,
     unique_identity_coprocessor,
     throwing_coprocessor,
-    two_way_split_copro
+    two_way_split_copro,
+    unique_filter_coprocessor
 };
 
 inline std::unique_ptr<coprocessor> make_coprocessor(
@@ -230,6 +256,9 @@ inline std::unique_ptr<coprocessor> make_coprocessor(
         return std::make_unique<throwing_coprocessor>(id, std::move(topics));
     case type_identifier::two_way_split_copro:
         return std::make_unique<two_way_split_copro>(id, std::move(topics));
+    case type_identifier::unique_filter_coprocessor:
+        return std::make_unique<unique_filter_coprocessor>(
+          id, std::move(topics));
     default:
         return nullptr;
     };
@@ -7,11 +7,14 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "bytes/iobuf.h"
+#include "bytes/utils.h"
 #include "hashing/crc32c.h"
 #include "hashing/fnv.h"
 #include "hashing/twang.h"
 #include "hashing/xx.h"
 #include "random/generators.h"
+#include "units.h"
 
 #include <seastar/core/reactor.hh>
 #include <seastar/testing/perf_tests.hh>
@@ -72,3 +75,53 @@ PERF_TEST(xx64_twang_fn, header_hash) {
     perf_tests::do_not_optimize(o);
     perf_tests::stop_measuring_time();
 }
+
+static constexpr size_t iobuf_bytes = 1_MiB;
+
+static iobuf make_fragmented_iobuf(size_t fragment_size) {
+    auto data = random_generators::gen_alphanum_string(fragment_size);
+    iobuf buf;
+    for (size_t i = 0; i < iobuf_bytes / fragment_size; ++i) {
+        iobuf part;
+        part.append(data.data(), data.size());
+        buf.append_fragments(std::move(part));
+    }
+    return buf;
+}
+
+static void crc_per_fragment(const iobuf& buf) {
+    crc::crc32c crc;
+    perf_tests::start_measuring_time();
+    for (const auto& frag : buf) {
+        crc.extend(frag.get(), frag.size());
+    }
+    perf_tests::do_not_optimize(crc.value());
+    perf_tests::stop_measuring_time();
+}
+
+static void crc_iobuf(const iobuf& buf) {
+    crc::crc32c crc;
+    perf_tests::start_measuring_time();
+    crc_extend_iobuf(crc, buf);
+    perf_tests::do_not_optimize(crc.value());
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(crc32_iobuf, per_fragment_64) {
+    crc_per_fragment(make_fragmented_iobuf(64));
+}
+PERF_TEST(crc32_iobuf, staged_64) {
+    crc_iobuf(make_fragmented_iobuf(64));
+}
+PERF_TEST(crc32_iobuf, per_fragment_512) {
+    crc_per_fragment(make_fragmented_iobuf(512));
+}
+PERF_TEST(crc32_iobuf, staged_512) {
+    crc_iobuf(make_fragmented_iobuf(512));
+}
+PERF_TEST(crc32_iobuf, per_fragment_128k) {
+    crc_per_fragment(make_fragmented_iobuf(128_KiB));
+}
+PERF_TEST(crc32_iobuf, staged_128k) {
+    crc_iobuf(make_fragmented_iobuf(128_KiB));
+}
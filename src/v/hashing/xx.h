@@ -33,6 +33,13 @@ inline uint32_t xxhash_32(const char* data, const size_t& length) {
     return XXH32(data, length, 0);
 }
 
+inline XXH128_hash_t xxhash_128(const unsigned char* data, size_t length) {
+    return XXH3_128bits(data, length);
+}
+inline XXH128_hash_t xxhash_128(const char* data, const size_t& length) {
+    return XXH3_128bits(data, length);
+}
+
 class incremental_xxhash64 {
 public:
     explicit incremental_xxhash64(uint64_t seed = 0) {
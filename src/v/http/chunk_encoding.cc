@@ -11,6 +11,8 @@
 
 #include "bytes/iobuf.h"
 
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/iostream.hh>
 #include <seastar/core/temporary_buffer.hh>
 
 #include <boost/asio/buffer.hpp>
@@ -20,6 +22,9 @@
 #include <boost/beast/http.hpp>
 #include <boost/beast/http/chunk_encode.hpp>
 #include <boost/beast/http/field.hpp>
+#include <fmt/format.h>
+
+#include <deque>
 
 namespace http {
 
@@ -83,4 +88,83 @@ iobuf chunked_encoder::encode_eof() const {
     return seq;
 }
 
+namespace {
+
+constexpr std::string_view crlf = "\r\n";
+
+class extended_chunked_source final : public ss::data_source_impl {
+public:
+    extended_chunked_source(
+      ss::input_stream<char> src, size_t chunk_size, chunk_extension_fn fn)
+      : _src(std::move(src))
+      , _chunk_size(chunk_size)
+      , _fn(std::move(fn)) {}
+
+    ss::future<ss::temporary_buffer<char>> get() final {
+        if (_pending.empty() && !_eof) {
+            auto chunk = co_await _src.read_exactly(_chunk_size);
+            // short read means that the source is exhausted
+            _eof = chunk.size() < _chunk_size;
+            if (!chunk.empty()) {
+                encode(std::move(chunk));
+            }
+            if (_eof) {
+                encode(ss::temporary_buffer<char>());
+            }
+        }
+        if (_pending.empty()) {
+            co_return ss::temporary_buffer<char>();
+        }
+        auto buf = std::move(_pending.front());
+        _pending.pop_front();
+        co_return buf;
+    }
+
+    ss::future<> close() final { return _src.close(); }
+
+private:
+    void encode(ss::temporary_buffer<char> payload) {
+        auto ext = _fn(std::string_view(payload.get(), payload.size()));
+        auto header = fmt::format("{:x};{}{}", payload.size(), ext, crlf);
+        _pending.emplace_back(header.data(), header.size());
+        if (!payload.empty()) {
+            _pending.push_back(std::move(payload));
+        }
+        _pending.emplace_back(crlf.data(), crlf.size());
+    }
+
+    ss::input_stream<char> _src;
+    size_t _chunk_size;
+    chunk_extension_fn _fn;
+    std::deque<ss::temporary_buffer<char>> _pending;
+    bool _eof{false};
+};
+
+size_t encoded_chunk_size(size_t payload_size, size_t extension_size) {
+    auto header_size = fmt::formatted_size("{:x}", payload_size) + 1
+                       + extension_size + crlf.size();
+    return header_size + payload_size + crlf.size();
+}
+
+} // namespace
+
+ss::input_stream<char> make_extended_chunked_stream(
+  ss::input_stream<char> src, size_t chunk_size, chunk_extension_fn fn) {
+    return ss::input_stream<char>(
+      ss::data_source(std::make_unique<extended_chunked_source>(
+        std::move(src), chunk_size, std::move(fn))));
+}
+
+size_t extended_chunked_stream_size(
+  size_t payload_size, size_t chunk_size, size_t extension_size) {
+    size_t full_chunks = payload_size / chunk_size;
+    size_t tail = payload_size % chunk_size;
+    size_t size = full_chunks * encoded_chunk_size(chunk_size, extension_size);
+    if (tail != 0) {
+        size += encoded_chunk_size(tail, extension_size);
+    }
+    // the last chunk is empty
+    return size + encoded_chunk_size(0, extension_size);
+}
+
 } // namespace http
@@ -14,7 +14,11 @@
 #include "seastarx.h"
 #include "units.h"
 
+#include <seastar/core/iostream.hh>
 #include <seastar/core/temporary_buffer.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <string_view>
 
 namespace http {
 
@@ -60,4 +64,31 @@ private:
     const bool _bypass;
 };
 
+/// Computes the chunk extension (e.g. 'chunk-signature=...') from the chunk
+/// payload, the last chunk of the stream has an empty payload
+using chunk_extension_fn
+  = ss::noncopyable_function<ss::sstring(std::string_view)>;
+
+/// Chunked encoding of the stream with a chunk extension in every chunk
+/// header, e.g. the aws-chunked encoding of signed streaming payloads.
+///
+/// The payload is read from 'src' and encoded in chunks of exactly
+/// 'chunk_size' bytes except for the last one. Every chunk consists of
+///     - hex(size) + ';' + extension
+///     - crlf
+///     - chunk payload
+///     - crlf
+/// followed by the zero size chunk. The payload isn't copied, only the
+/// chunk being read is kept in memory. The returned stream closes 'src'.
+ss::input_stream<char> make_extended_chunked_stream(
+  ss::input_stream<char> src, size_t chunk_size, chunk_extension_fn fn);
+
+/// Size of the stream returned by 'make_extended_chunked_stream'
+///
+/// \param payload_size is a size of the encoded payload
+/// \param chunk_size is a max size of the chunk payload
+/// \param extension_size is a size of the extension of every chunk
+size_t extended_chunked_stream_size(
+  size_t payload_size, size_t chunk_size, size_t extension_size);
+
 } // namespace http
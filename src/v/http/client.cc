@@ -85,11 +85,15 @@ ss::future<client::request_response_t> client::make_request(
                  ? ss::lowres_clock::duration::max()
                  : now - _last_response;
     if (is_valid()) {
-        if (age < _max_idle_time) {
+        if (!_keep_alive) {
+            // The previous response wasn't fully consumed (the remaining
+            // bytes would be parsed as the next response) or the server
+            // sent 'Connection: close'.
+            vlog(http_log.debug, "shutdown connection, can't be reused");
+            shutdown();
+        } else if (age < _max_idle_time) {
             // Reuse connection
             vlog(http_log.debug, "reusing connection, age {}", age.count());
-            return ss::make_ready_future<request_response_t>(
-              std::make_tuple(req, res));
         } else {
             vlog(http_log.debug, "shutdown connection, age {}", age.count());
             // Connection is too old and likeley already received
@@ -98,6 +102,13 @@ ss::future<client::request_response_t> client::make_request(
             shutdown();
         }
     }
+    // The connection can be reused only after the response to this request
+    // is received
+    _keep_alive = false;
+    if (is_valid()) {
+        return ss::make_ready_future<request_response_t>(
+          std::make_tuple(req, res));
+    }
     return get_connected(timeout)
       .then([req, res, target](reconnect_result_t r) {
           if (r == reconnect_result_t::timed_out) {
@@ -330,6 +341,9 @@ ss::future<iobuf> client::response_stream::recv_some() {
           }
           auto out = _parser.get().body().consume();
           _buffer.trim_front(noctets);
+          if (_parser.is_done()) {
+              _client->_keep_alive = _parser.keep_alive();
+          }
           if (!_buffer.empty()) {
               vlog(
                 http_log.trace,
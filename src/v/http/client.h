@@ -91,6 +91,7 @@ public:
       ss::lowres_clock::duration max_idle_time = {});
 
     ss::future<> stop();
+    using rpc::base_transport::is_valid;
     using rpc::base_transport::shutdown;
 
     /// Return immediately if connected or make connection attempts
@@ -243,6 +244,9 @@ private:
     ss::lowres_clock::time_point _last_response{
       ss::lowres_clock::time_point::min()};
     ss::lowres_clock::duration _max_idle_time;
+    // Set when the last response was fully received and the server didn't
+    // ask to close the connection, only such connections can be reused
+    bool _keep_alive{false};
 };
 
 template<class BufferSeq>
@@ -13,7 +13,9 @@
 #include "bytes/iobuf_parser.h"
 #include "http/chunk_encoding.h"
 #include "seastarx.h"
+#include "ssx/sformat.h"
 
+#include <seastar/core/iostream.hh>
 #include <seastar/core/temporary_buffer.hh>
 #include <seastar/testing/thread_test_case.hh>
 
@@ -152,4 +154,47 @@ SEASTAR_THREAD_TEST_CASE(test_chunked_bypass) {
     actual.append(encoder.encode(std::move(inp)));
     actual.append(encoder.encode_eof());
     BOOST_REQUIRE(expected == actual);
-}
\ No newline at end of file
+}
+static ss::sstring read_extended_chunked(ss::sstring payload, size_t chunk) {
+    iobuf inp;
+    inp.append(payload.data(), payload.size());
+    auto stream = http::make_extended_chunked_stream(
+      make_iobuf_input_stream(std::move(inp)),
+      chunk,
+      [](std::string_view data) {
+          return ssx::sformat("n={:03}", data.size());
+      });
+    iobuf out;
+    auto out_stream = make_iobuf_ref_output_stream(out);
+    ss::copy(stream, out_stream).get();
+    stream.close().get();
+    iobuf_parser p(std::move(out));
+    return p.read_string(p.bytes_left());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_extended_chunked_stream) {
+    ss::sstring payload(0x250, 'x');
+    auto actual = read_extended_chunked(payload, 0x100);
+    auto expected = ssx::sformat(
+      "100;n=256\r\n{0}\r\n100;n=256\r\n{0}\r\n50;n=080\r\n{1}\r\n"
+      "0;n=000\r\n\r\n",
+      ss::sstring(0x100, 'x'),
+      ss::sstring(0x50, 'x'));
+    BOOST_REQUIRE_EQUAL(actual, expected);
+    BOOST_REQUIRE_EQUAL(
+      actual.size(), http::extended_chunked_stream_size(0x250, 0x100, 5));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_extended_chunked_stream_aligned) {
+    ss::sstring payload(0x200, 'x');
+    auto actual = read_extended_chunked(payload, 0x100);
+    BOOST_REQUIRE(
+      std::string_view(actual).ends_with("\r\n0;n=000\r\n\r\n"));
+    BOOST_REQUIRE_EQUAL(
+      actual.size(), http::extended_chunked_stream_size(0x200, 0x100, 5));
+
+    actual = read_extended_chunked("", 0x100);
+    BOOST_REQUIRE_EQUAL(actual, "0;n=000\r\n\r\n");
+    BOOST_REQUIRE_EQUAL(
+      actual.size(), http::extended_chunked_stream_size(0, 0x100, 5));
+}
@@ -19,6 +19,15 @@
 #include <fmt/core.h>
 
 #define RAPIDJSON_HAS_STDSTRING 1
+// Vectorized scans of the strings written without escapes and of the
+// whitespace skipped while parsing, chosen at compile time from the target
+#if defined(__SSE4_2__)
+#define RAPIDJSON_SSE42 1
+#elif defined(__SSE2__)
+#define RAPIDJSON_SSE2 1
+#elif defined(__ARM_NEON)
+#define RAPIDJSON_NEON 1
+#endif
 #define RAPIDJSON_ASSERT(x)                                                    \
     do {                                                                       \
         if (unlikely(!(x))) {                                                  \
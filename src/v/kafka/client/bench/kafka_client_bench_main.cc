@@ -0,0 +1,371 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/iobuf.h"
+#include "config/config_store.h"
+#include "kafka/client/client.h"
+#include "kafka/client/configuration.h"
+#include "kafka/protocol/create_topics.h"
+#include "kafka/protocol/errors.h"
+#include "model/compression.h"
+#include "model/fundamental.h"
+#include "random/generators.h"
+#include "seastarx.h"
+#include "storage/record_batch_builder.h"
+#include "syschecks/syschecks.h"
+#include "utils/hdr_hist.h"
+#include "utils/unresolved_address.h"
+#include "vlog.h"
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/util/defer.hh>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/range/irange.hpp>
+#include <fmt/format.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/*
+ * Load generator for a kafka api broker or cluster, e.g. a local multi node
+ * cluster. Producers send batches of random records to the partitions of a
+ * topic in round robin, while the consumers of a group read them back. The
+ * throughput and the latency percentiles of the produce and fetch requests
+ * are printed once all the records were produced and consumed.
+ *
+ *   kafka_client_bench --brokers 127.0.0.1:9092 --partitions 16 \
+ *     --records 1000000 --record-size 1024 --acks -1 --consumers 4
+ */
+
+static ss::logger bench_log{"kafka_client_bench"};
+
+using namespace std::chrono_literals;
+using clock_type = std::chrono::steady_clock;
+
+static void
+cli_opts(boost::program_options::options_description_easy_init opt) {
+    namespace po = boost::program_options;
+
+    opt(
+      "brokers",
+      po::value<std::vector<std::string>>()->multitoken()->default_value(
+        {"127.0.0.1:9092"}, "127.0.0.1:9092"),
+      "host:port of the seed brokers");
+    opt(
+      "topic",
+      po::value<std::string>()->default_value("kafka_client_bench"),
+      "topic produced to, created unless it exists");
+    opt(
+      "partitions",
+      po::value<int32_t>()->default_value(16),
+      "partitions of the topic when it is created");
+    opt(
+      "replication-factor",
+      po::value<int16_t>()->default_value(1),
+      "replication factor of the topic when it is created");
+    opt(
+      "records",
+      po::value<int64_t>()->default_value(1000000),
+      "records produced in total");
+    opt(
+      "record-size",
+      po::value<size_t>()->default_value(1024),
+      "bytes of the value of every record");
+    opt(
+      "batch-records",
+      po::value<int32_t>()->default_value(100),
+      "records of every produced batch");
+    opt(
+      "in-flight",
+      po::value<size_t>()->default_value(16),
+      "produce requests in flight");
+    opt(
+      "acks",
+      po::value<int16_t>()->default_value(-1),
+      "produce acks, -1 for all the replicas or 1 for the leader");
+    opt(
+      "compression",
+      po::value<std::string>()->default_value("none"),
+      "compression of the produced batches: none, gzip, snappy, lz4, zstd");
+    opt(
+      "consumers",
+      po::value<size_t>()->default_value(1),
+      "members of the consumer group reading the topic, 0 to only produce");
+    opt(
+      "group",
+      po::value<std::string>()->default_value("kafka_client_bench"),
+      "consumer group id");
+    opt(
+      "consume-timeout-ms",
+      po::value<int64_t>()->default_value(30000),
+      "consumers give up after fetching nothing for this long");
+}
+
+struct bench_conf {
+    std::vector<unresolved_address> brokers;
+    model::topic topic;
+    int32_t partitions;
+    int16_t replication_factor;
+    int64_t records;
+    size_t record_size;
+    int32_t batch_records;
+    size_t in_flight;
+    int16_t acks;
+    model::compression compression;
+    size_t consumers;
+    kafka::group_id group;
+    std::chrono::milliseconds consume_timeout;
+};
+
+static unresolved_address parse_address(const std::string& s) {
+    auto sep = s.rfind(':');
+    if (sep == std::string::npos) {
+        throw std::invalid_argument(fmt::format("expected host:port: {}", s));
+    }
+    return unresolved_address(
+      ss::sstring(s.substr(0, sep)),
+      boost::lexical_cast<uint16_t>(s.substr(sep + 1)));
+}
+
+static bench_conf cfg_from(const boost::program_options::variables_map& m) {
+    bench_conf cfg{
+      .topic = model::topic(m["topic"].as<std::string>()),
+      .partitions = m["partitions"].as<int32_t>(),
+      .replication_factor = m["replication-factor"].as<int16_t>(),
+      .records = m["records"].as<int64_t>(),
+      .record_size = m["record-size"].as<size_t>(),
+      .batch_records = std::max(m["batch-records"].as<int32_t>(), 1),
+      .in_flight = std::max<size_t>(m["in-flight"].as<size_t>(), 1),
+      .acks = m["acks"].as<int16_t>(),
+      .compression = boost::lexical_cast<model::compression>(
+        m["compression"].as<std::string>()),
+      .consumers = m["consumers"].as<size_t>(),
+      .group = kafka::group_id(m["group"].as<std::string>()),
+      .consume_timeout = std::chrono::milliseconds(
+        m["consume-timeout-ms"].as<int64_t>()),
+    };
+    for (const auto& b : m["brokers"].as<std::vector<std::string>>()) {
+        std::vector<std::string> addrs;
+        boost::split(addrs, b, boost::is_any_of(","));
+        for (const auto& a : addrs) {
+            if (!a.empty()) {
+                cfg.brokers.push_back(parse_address(a));
+            }
+        }
+    }
+    return cfg;
+}
+
+static YAML::Node client_config(const bench_conf& cfg) {
+    kafka::client::configuration c;
+    c.brokers.set_value(cfg.brokers);
+    c.produce_acks.set_value(cfg.acks);
+    c.produce_compression_type.set_value(cfg.compression);
+    // every produce call sends its batch right away, the load generator
+    // controls the batching
+    c.produce_batch_record_count.set_value(1);
+    c.produce_batch_delay.set_value(0ms);
+    return config::to_yaml(c);
+}
+
+/// throughput and latency of the requests of a workload
+struct workload_stats {
+    hdr_hist latency;
+    int64_t records{0};
+    size_t bytes{0};
+    int64_t errors{0};
+    clock_type::time_point start{clock_type::now()};
+    clock_type::time_point end{clock_type::now()};
+
+    void print(std::string_view name) const {
+        const auto secs = std::chrono::duration<double>(end - start).count();
+        fmt::print(
+          "{}: {} records, {:.2f} MiB, {} errors in {:.2f}s: "
+          "{:.0f} records/s, {:.2f} MiB/s, "
+          "latency p50: {}us p99: {}us p999: {}us\n",
+          name,
+          records,
+          static_cast<double>(bytes) / (1024 * 1024),
+          errors,
+          secs,
+          secs > 0 ? static_cast<double>(records) / secs : 0,
+          secs > 0 ? static_cast<double>(bytes) / (1024 * 1024) / secs : 0,
+          latency.get_value_at(50),
+          latency.get_value_at(99),
+          latency.get_value_at(99.9));
+    }
+};
+
+static void
+create_topic(kafka::client::client& client, const bench_conf& cfg) {
+    auto res = client
+                 .create_topic(kafka::creatable_topic{
+                   .name = cfg.topic,
+                   .num_partitions = cfg.partitions,
+                   .replication_factor = cfg.replication_factor,
+                 })
+                 .get0();
+    const auto ec = res.data.topics.empty()
+                      ? kafka::error_code::unknown_server_error
+                      : res.data.topics[0].error_code;
+    if (
+      ec != kafka::error_code::none
+      && ec != kafka::error_code::topic_already_exists) {
+        throw std::runtime_error(
+          fmt::format("unable to create {}: {}", cfg.topic, ec));
+    }
+    vlog(bench_log.info, "topic {}: {}", cfg.topic, ec);
+}
+
+static model::record_batch make_batch(const bench_conf& cfg, iobuf& value) {
+    storage::record_batch_builder builder(
+      model::record_batch_type::raft_data, model::offset(0));
+    for (int32_t i = 0; i < cfg.batch_records; ++i) {
+        builder.add_raw_kv(iobuf{}, value.share(0, value.size_bytes()));
+    }
+    return std::move(builder).build();
+}
+
+static ss::future<> produce(
+  kafka::client::client& client, const bench_conf& cfg, workload_stats& s) {
+    // alphanumeric values leave the compression codecs some work to do
+    const auto payload = random_generators::gen_alphanum_string(
+      cfg.record_size);
+    iobuf value;
+    value.append(payload.data(), payload.size());
+    const int64_t batches = (cfg.records + cfg.batch_records - 1)
+                            / cfg.batch_records;
+    ss::semaphore in_flight(cfg.in_flight);
+    s.start = clock_type::now();
+    co_await ss::parallel_for_each(
+      boost::irange<int64_t>(0, batches),
+      [&client, &cfg, &s, &value, &in_flight](int64_t i) {
+          return ss::with_semaphore(
+            in_flight, 1, [&client, &cfg, &s, &value, i] {
+                model::topic_partition tp(
+                  cfg.topic, model::partition_id(i % cfg.partitions));
+                auto m = s.latency.auto_measure();
+                return client
+                  .produce_record_batch(tp, make_batch(cfg, value))
+                  .then([&s, &cfg, m = std::move(m)](
+                          kafka::produce_response::partition p) {
+                      if (p.error_code != kafka::error_code::none) {
+                          ++s.errors;
+                          return;
+                      }
+                      s.records += cfg.batch_records;
+                      s.bytes += cfg.batch_records * cfg.record_size;
+                  })
+                  .handle_exception([&s](std::exception_ptr e) {
+                      vlog(bench_log.debug, "produce failed: {}", e);
+                      ++s.errors;
+                  });
+            });
+      });
+    s.end = clock_type::now();
+}
+
+static ss::future<> consume(
+  kafka::client::client& client,
+  const bench_conf& cfg,
+  const kafka::member_id& member,
+  const bool& producing,
+  workload_stats& s) {
+    auto last_progress = clock_type::now();
+    while (s.records < cfg.records) {
+        const auto idle = clock_type::now() - last_progress;
+        if (!producing && idle > cfg.consume_timeout) {
+            vlog(bench_log.warn, "{} gave up waiting for records", member);
+            break;
+        }
+        auto m = s.latency.auto_measure();
+        auto res = co_await client.consumer_fetch(
+          cfg.group, member, 1000ms, std::nullopt);
+        if (res.data.error_code != kafka::error_code::none) {
+            ++s.errors;
+            continue;
+        }
+        for (auto& topic : res.data.topics) {
+            for (auto& p : topic.partitions) {
+                if (p.error_code != kafka::error_code::none) {
+                    ++s.errors;
+                    continue;
+                }
+                if (!p.records) {
+                    continue;
+                }
+                s.bytes += p.records->size_bytes();
+                while (!p.records->empty()) {
+                    auto adapter = p.records->consume_batch();
+                    if (adapter.batch) {
+                        s.records += adapter.batch->record_count();
+                        last_progress = clock_type::now();
+                    }
+                }
+            }
+        }
+    }
+    s.end = clock_type::now();
+}
+
+int main(int args, char** argv, char** env) {
+    syschecks::initialize_intrinsics();
+    std::setvbuf(stdout, nullptr, _IOLBF, 1024);
+    ss::app_template app;
+    cli_opts(app.add_options());
+    return app.run(args, argv, [&] {
+        return ss::async([&] {
+            const auto cfg = cfg_from(app.configuration());
+            kafka::client::client client(client_config(cfg));
+            client.connect().get();
+            auto stop = ss::defer([&client] { client.stop().get(); });
+            create_topic(client, cfg);
+
+            std::vector<kafka::member_id> members;
+            auto remove = ss::defer([&client, &cfg, &members] {
+                for (const auto& m : members) {
+                    client.remove_consumer(cfg.group, m)
+                      .handle_exception([](std::exception_ptr) {})
+                      .get();
+                }
+            });
+            for (size_t i = 0; i < cfg.consumers; ++i) {
+                members.push_back(client.create_consumer(cfg.group).get0());
+                client
+                  .subscribe_consumer(cfg.group, members.back(), {cfg.topic})
+                  .get();
+            }
+
+            workload_stats produced;
+            // the records read by all the consumers of the group
+            workload_stats consumed;
+            bool producing = true;
+            std::vector<ss::future<>> consumers;
+            consumers.reserve(members.size());
+            for (const auto& m : members) {
+                consumers.push_back(
+                  consume(client, cfg, m, producing, consumed));
+            }
+            produce(client, cfg, produced).get();
+            producing = false;
+            ss::when_all_succeed(consumers.begin(), consumers.end()).get();
+
+            produced.print("produce");
+            if (!members.empty()) {
+                consumed.print("consume");
+            }
+        });
+    });
+}
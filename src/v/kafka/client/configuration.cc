@@ -67,6 +67,39 @@ configuration::configuration()
       "Delay (in milliseconds) to wait before sending batch",
       config::required::no,
       100ms)
+  , produce_compression_type(
+      *this,
+      "produce_compression_type",
+      "Compression of the batches sent to the broker",
+      config::required::no,
+      model::compression::none)
+  , produce_enable_idempotence(
+      *this,
+      "produce_enable_idempotence",
+      "Produce with a producer id and sequence numbers, so that the broker "
+      "drops retried duplicates. Requires enable_idempotence on the broker",
+      config::required::no,
+      false)
+  , produce_max_in_flight(
+      *this,
+      "produce_max_in_flight",
+      "Max produce requests in flight per partition, only used with "
+      "produce_enable_idempotence as retries could reorder the batches",
+      config::required::no,
+      5)
+  , produce_acks(
+      *this,
+      "produce_acks",
+      "Acknowledgements required from the broker: -1 for all the replicas, 1 "
+      "for the leader only",
+      config::required::no,
+      -1,
+      [](const int16_t& acks) -> std::optional<ss::sstring> {
+          if (acks != -1 && acks != 1) {
+              return "produce_acks must be -1 or 1";
+          }
+          return std::nullopt;
+      })
   , consumer_request_timeout(
       *this,
       "consumer_request_timeout_ms",
@@ -79,6 +112,13 @@ configuration::configuration()
       "Max bytes to fetch per request",
       config::required::no,
       1_MiB)
+  , consumer_prefetch_max_bytes(
+      *this,
+      "consumer_prefetch_max_bytes",
+      "Max bytes of the fetch issued in the background once a consumer fetch "
+      "returns, to be returned by the next one. 0 disables the prefetch",
+      config::required::no,
+      1_MiB)
   , consumer_session_timeout(
       *this,
       "consumer_session_timeout_ms",
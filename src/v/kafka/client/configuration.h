@@ -12,6 +12,7 @@
 #pragma once
 #include "config/config_store.h"
 #include "config/tls_config.h"
+#include "model/compression.h"
 
 #include <seastar/net/inet_address.hh>
 #include <seastar/net/ip.hh>
@@ -33,8 +34,13 @@ struct configuration final : public config::config_store {
     config::property<int32_t> produce_batch_record_count;
     config::property<int32_t> produce_batch_size_bytes;
     config::property<std::chrono::milliseconds> produce_batch_delay;
+    config::property<model::compression> produce_compression_type;
+    config::property<bool> produce_enable_idempotence;
+    config::property<int32_t> produce_max_in_flight;
+    config::property<int16_t> produce_acks;
     config::property<std::chrono::milliseconds> consumer_request_timeout;
     config::property<int32_t> consumer_request_max_bytes;
+    config::property<int32_t> consumer_prefetch_max_bytes;
     config::property<std::chrono::milliseconds> consumer_session_timeout;
     config::property<std::chrono::milliseconds> consumer_rebalance_timeout;
     config::property<std::chrono::milliseconds> consumer_heartbeat_interval;
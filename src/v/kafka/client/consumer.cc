@@ -103,6 +103,7 @@ void consumer::start() {
 ss::future<> consumer::stop() {
     { auto t = std::move(_timer); }
     _as.request_abort();
+    drop_prefetch();
     return _coordinator->stop()
       .then([this]() { return _gate.close(); })
       .finally([me{shared_from_this()}] {});
@@ -269,6 +270,9 @@ ss::future<> consumer::sync() {
                     return join();
                 case error_code::none:
                     _assignment = _plan->decode(res.data.assignment);
+                    // Records prefetched for the previous assignment are
+                    // dropped, the sessions restart with the new partitions
+                    drop_prefetch();
                     return ss::now();
                 default:
                     return ss::make_exception_future<>(consumer_error(
@@ -356,23 +360,29 @@ consumer::offset_commit(std::vector<offset_commit_request_topic> topics) {
     co_return co_await req_res(std::move(req_builder));
 }
 
-ss::future<fetch_response>
+ss::future<consumer::broker_res_t>
 consumer::dispatch_fetch(broker_reqs_t::value_type br) {
     auto& [broker, req] = br;
     kclog.trace("Consumer: {}, fetch_req: {}", *this, req);
-    auto res = co_await broker->dispatch(std::move(req));
+    fetch_response res;
+    try {
+        res = co_await broker->dispatch(std::move(req));
+    } catch (...) {
+        // The broker may not have seen the offsets of the request
+        _fetch_sessions[broker].reset_session();
+        throw;
+    }
     kclog.trace("Consumer: {}, fetch_res: {}", *this, res);
 
     if (res.data.error_code != error_code::none) {
+        _fetch_sessions[broker].reset_session();
         throw broker_error(broker->id(), res.data.error_code);
     }
-
-    _fetch_sessions[broker].apply(res);
-    co_return res;
+    co_return broker_res_t{broker, std::move(res)};
 }
 
-ss::future<fetch_response> consumer::fetch(
-  std::chrono::milliseconds timeout, std::optional<int32_t> max_bytes) {
+ss::future<std::vector<consumer::broker_res_t>> consumer::dispatch_fetches(
+  std::chrono::milliseconds timeout, int32_t max_bytes) {
     // Split requests by broker
     broker_reqs_t broker_reqs;
     for (auto const& [t, ps] : _assignment) {
@@ -390,8 +400,7 @@ ss::future<fetch_response> consumer::fetch(
                               .replica_id = consumer_replica_id,
                               .max_wait_ms = timeout,
                               .min_bytes = 1,
-                              .max_bytes = max_bytes.value_or(
-                                _config.consumer_request_max_bytes),
+                              .max_bytes = max_bytes,
                               .isolation_level = model::isolation_level::
                                 read_uncommitted, // READ_UNCOMMITTED
                               .session_id = session.id(),
@@ -399,6 +408,14 @@ ss::future<fetch_response> consumer::fetch(
                             }})
                           .first->second;
 
+            // An incremental request only carries the partitions whose
+            // offset changed, the broker keeps fetching the others
+            if (!session.must_send(tp)) {
+                continue;
+            }
+            const auto offset = session.offset(tp);
+            session.sent(tp, offset);
+
             if (req.data.topics.empty() || req.data.topics.back().name != t) {
                 req.data.topics.push_back(fetch_request::topic{.name{t}});
             }
@@ -406,9 +423,8 @@ ss::future<fetch_response> consumer::fetch(
             req.data.topics.back().fetch_partitions.push_back(
               fetch_request::partition{
                 .partition_index = p,
-                .fetch_offset = session.offset(tp),
-                .max_bytes = max_bytes.value_or(
-                  _config.consumer_request_max_bytes)});
+                .fetch_offset = offset,
+                .max_bytes = max_bytes});
         }
     }
 
@@ -418,10 +434,65 @@ ss::future<fetch_response> consumer::fetch(
       [this](broker_reqs_t::value_type br) {
           return dispatch_fetch(std::move(br));
       },
-      fetch_response{
-        .data
-        = {.throttle_time_ms{}, .error_code = error_code::none, .session_id = kafka::invalid_fetch_session_id}},
-      detail::reduce_fetch_response);
+      std::vector<broker_res_t>{},
+      [](std::vector<broker_res_t> acc, broker_res_t res) {
+          acc.push_back(std::move(res));
+          return acc;
+      });
+}
+
+void consumer::prefetch(std::chrono::milliseconds timeout, int32_t max_bytes) {
+    _prefetch.emplace(ss::try_with_gate(_gate, [this, timeout, max_bytes]() {
+        return dispatch_fetches(timeout, max_bytes);
+    }));
+}
+
+void consumer::drop_prefetch() {
+    if (!_prefetch) {
+        return;
+    }
+    auto prefetched = std::move(*_prefetch);
+    _prefetch.reset();
+    (void)std::move(prefetched)
+      .discard_result()
+      .handle_exception([](const std::exception_ptr& e) {
+          kclog.trace("Consumer: dropped prefetch failed: {}", e);
+      });
+    // The broker advanced the sessions for the dropped requests
+    for (auto& [broker, session] : _fetch_sessions) {
+        session.reset_session();
+    }
+}
+
+ss::future<fetch_response> consumer::fetch(
+  std::chrono::milliseconds timeout, std::optional<int32_t> max_bytes) {
+    auto units = co_await ss::get_units(_fetch_sem, 1);
+    const int32_t request_max_bytes = max_bytes.value_or(
+      _config.consumer_request_max_bytes());
+
+    std::vector<broker_res_t> responses;
+    if (_prefetch) {
+        auto prefetched = std::move(*_prefetch);
+        _prefetch.reset();
+        responses = co_await std::move(prefetched);
+    } else {
+        responses = co_await dispatch_fetches(timeout, request_max_bytes);
+    }
+
+    fetch_response result{
+      .data
+      = {.throttle_time_ms{}, .error_code = error_code::none, .session_id = kafka::invalid_fetch_session_id}};
+    for (auto& [broker, res] : responses) {
+        _fetch_sessions[broker].apply(res);
+        result = detail::reduce_fetch_response(
+          std::move(result), std::move(res));
+    }
+
+    const int32_t prefetch_max_bytes = _config.consumer_prefetch_max_bytes();
+    if (prefetch_max_bytes > 0 && !_gate.is_closed()) {
+        prefetch(timeout, std::min(request_max_bytes, prefetch_max_bytes));
+    }
+    co_return result;
 }
 
 ss::future<shared_consumer_t> make_consumer(
@@ -23,6 +23,7 @@
 #include "kafka/protocol/offset_fetch.h"
 #include "kafka/types.h"
 
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/shared_ptr.hh>
 
 #include <absl/container/node_hash_map.h>
@@ -30,13 +31,22 @@
 
 #include <chrono>
 #include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
 
 namespace kafka::client {
 
 // consumer manages the lifetime of a consumer within a group.
+//
+// Once a fetch returns, the next one is issued in the background, bounded by
+// consumer_prefetch_max_bytes, so that the round trip to the brokers overlaps
+// with the processing of the records by the caller. The responses are applied
+// to the fetch sessions, and the offsets to commit, only once returned.
 class consumer final : public ss::enable_lw_shared_from_this<consumer> {
     using assignment_t = assignment;
     using broker_reqs_t = absl::node_hash_map<shared_broker_t, fetch_request>;
+    using broker_res_t = std::pair<shared_broker_t, fetch_response>;
 
 public:
     consumer(
@@ -91,7 +101,11 @@ private:
 
     ss::future<describe_groups_response> describe_group();
 
-    ss::future<fetch_response> dispatch_fetch(broker_reqs_t::value_type br);
+    ss::future<std::vector<broker_res_t>>
+    dispatch_fetches(std::chrono::milliseconds timeout, int32_t max_bytes);
+    ss::future<broker_res_t> dispatch_fetch(broker_reqs_t::value_type br);
+    void prefetch(std::chrono::milliseconds timeout, int32_t max_bytes);
+    void drop_prefetch();
 
     template<typename RequestFactory>
     ss::future<
@@ -130,6 +144,9 @@ private:
     std::unique_ptr<assignment_plan> _plan{};
     assignment_t _assignment{};
     absl::node_hash_map<shared_broker_t, fetch_session> _fetch_sessions;
+    /// Serializes the fetches, the requests of a session are sequential
+    ss::semaphore _fetch_sem{1};
+    std::optional<ss::future<std::vector<broker_res_t>>> _prefetch;
 
     friend std::ostream& operator<<(std::ostream& os, const consumer& c) {
         fmt::print(
@@ -30,13 +30,36 @@ model::offset fetch_session::offset(model::topic_partition_view tpv) const {
     return part_it->second;
 }
 
+bool fetch_session::must_send(model::topic_partition_view tpv) const {
+    if (
+      _id == invalid_fetch_session_id
+      || _epoch == initial_fetch_session_epoch) {
+        return true;
+    }
+    auto it = _sent.find(model::topic_partition(tpv.topic, tpv.partition));
+    return it == _sent.end() || it->second != offset(tpv);
+}
+
+void fetch_session::sent(model::topic_partition_view tpv, model::offset o) {
+    _sent.insert_or_assign(model::topic_partition(tpv.topic, tpv.partition), o);
+}
+
+void fetch_session::reset_session() {
+    // The id is kept, the next full request closes the session on the broker
+    _epoch = initial_fetch_session_epoch;
+    _sent.clear();
+}
+
 bool fetch_session::apply(fetch_response& res) {
-    if (_id == invalid_fetch_session_id) {
+    if (_epoch == initial_fetch_session_epoch) {
         _id = fetch_session_id{res.data.session_id};
     }
     vassert(res.data.session_id == _id, "session mismatch: {}", *this);
 
-    ++_epoch;
+    // Without a session every request is a full one
+    if (_id != invalid_fetch_session_id) {
+        ++_epoch;
+    }
     for (auto& part : res) {
         if (part.partition_response->error_code != error_code::none) {
             continue;
@@ -15,6 +15,7 @@
 #include "kafka/types.h"
 #include "model/fundamental.h"
 
+#include <absl/container/flat_hash_map.h>
 #include <absl/container/node_hash_map.h>
 
 #include <iosfwd>
@@ -26,6 +27,10 @@ struct fetch_response;
 namespace kafka::client {
 
 /// \brief Maintain state for consumer group fetch session.
+///
+/// Once the broker has established the session, requests are incremental:
+/// the broker keeps the fetch offsets it was sent, so that a request only
+/// carries the partitions whose offset changed since it was last sent.
 class fetch_session {
 public:
     fetch_session() = default;
@@ -40,6 +45,13 @@ public:
     void id(kafka::fetch_session_id id) { _id = id; }
     kafka::fetch_session_epoch epoch() const { return _epoch; }
     model::offset offset(model::topic_partition_view tpv) const;
+    /// True if the next request must carry the partition
+    bool must_send(model::topic_partition_view tpv) const;
+    /// Record the offset of the partition sent by a request
+    void sent(model::topic_partition_view tpv, model::offset o);
+    /// Start a new session with the next request, keeping the offsets, e.g.
+    /// once a request failed or the assignment changed
+    void reset_session();
     bool apply(fetch_response& res);
     std::vector<kafka::offset_commit_request_topic>
     make_offset_commit_request() const;
@@ -53,6 +65,8 @@ private:
       model::topic,
       absl::node_hash_map<model::partition_id, model::offset>>
       _offsets;
+    /// Offsets known by the broker for the session
+    absl::flat_hash_map<model::topic_partition, model::offset> _sent;
 };
 
 } // namespace kafka::client
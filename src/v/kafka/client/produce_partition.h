@@ -15,60 +15,144 @@
 #include "kafka/client/exceptions.h"
 #include "kafka/client/produce_batcher.h"
 #include "model/fundamental.h"
+#include "model/record.h"
+#include "storage/parser_utils.h"
 
+#include <seastar/core/future.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/timer.hh>
 #include <seastar/util/noncopyable_function.hh>
 
 #include <absl/container/flat_hash_map.h>
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <utility>
+
 namespace kafka::client {
 
 /// \brief Batch multiple client requests, flush them based on size or time.
+///
+/// The linger starts with the first record of a batch and is adapted to the
+/// traffic of the partition: a batch that lingered without reaching a quarter
+/// of the thresholds saved few requests by waiting, so the next linger is
+/// halved, while a batch that reached a threshold doubles it back up to
+/// produce_batch_delay_ms.
+///
+/// Once the producer identity is known, the batches are given its id and
+/// their sequence numbers, and up to produce_max_in_flight of them are
+/// dispatched concurrently. Otherwise a single batch is in flight, as the
+/// retry of a batch could land after the next one.
 class produce_partition {
 public:
     using response = produce_batcher::partition_response;
     using consumer = ss::noncopyable_function<void(model::record_batch&&)>;
 
-    produce_partition(const configuration& config, consumer&& c)
+    /// \param pid The producer identity, which must outlive the partition
+    produce_partition(
+      const configuration& config,
+      consumer&& c,
+      const std::optional<model::producer_identity>* pid = nullptr)
       : _config{config}
       , _batcher{}
-      , _timer{[this]() { try_consume(true); }}
-      , _consumer{std::move(c)} {}
+      , _timer{[this]() {
+          _lingered = true;
+          try_consume();
+      }}
+      , _consumer{std::move(c)}
+      , _pid{pid}
+      , _linger{_config.produce_batch_delay()} {}
 
     ss::future<response> produce(model::record_batch&& batch) {
         _record_count += batch.record_count();
         _size_bytes += batch.size_bytes();
         auto fut = _batcher.produce(std::move(batch));
-        try_consume(false);
+        try_consume();
         return fut;
     }
 
+    /// \brief Handle the response of the oldest batch in flight
     void handle_response(response&& res) {
-        vassert(_in_flight, "handle_response requires a batch in flight");
+        vassert(_in_flight > 0, "handle_response requires a batch in flight");
         _batcher.handle_response(std::move(res));
-        _in_flight = false;
-        try_consume(false);
+        --_in_flight;
+        try_consume();
+    }
+
+    /// \brief Handle the response of a batch once the responses of the
+    /// batches consumed before it were handled
+    ///
+    /// Must be called in the order the batches are consumed.
+    void handle_response(ss::future<response> res) {
+        _responses = _responses.then(
+          [this, res{std::move(res)}]() mutable {
+              return std::move(res).then(
+                [this](response r) { handle_response(std::move(r)); });
+          });
     }
 
     ss::future<> stop() {
-        try_consume(true);
+        _lingered = true;
+        try_consume();
         _timer.cancel();
-        return ss::now();
+        return std::exchange(_responses, ss::now());
     }
 
 private:
+    bool has_pid() const { return _pid && *_pid; }
+
+    int32_t max_in_flight() const {
+        return has_pid() ? std::max(_config.produce_max_in_flight(), 1) : 1;
+    }
+
     model::record_batch do_consume() {
-        vassert(!_in_flight, "do_consume should not run concurrently");
+        vassert(
+          _in_flight < max_in_flight(),
+          "do_consume exceeds the batches in flight");
 
-        _in_flight = true;
+        ++_in_flight;
         _record_count = 0;
         _size_bytes = 0;
-        return _batcher.consume();
+        _lingered = false;
+        _timer.cancel();
+        auto batch = _batcher.consume();
+        if (has_pid()) {
+            const auto& pid = **_pid;
+            if (pid != _sequence_pid) {
+                _sequence_pid = pid;
+                _sequence = 0;
+            }
+            auto& hdr = batch.header();
+            hdr.producer_id = pid.id;
+            hdr.producer_epoch = pid.epoch;
+            hdr.base_sequence = _sequence;
+            storage::internal::reset_size_checksum_metadata(hdr, batch.data());
+            // Sequence numbers wrap around to 0
+            _sequence = static_cast<int32_t>(
+              (int64_t(_sequence) + batch.record_count())
+              % (int64_t(std::numeric_limits<int32_t>::max()) + 1));
+        }
+        return batch;
+    }
+
+    void adapt_linger(bool threshold_met) {
+        const auto max_linger = _config.produce_batch_delay();
+        if (threshold_met) {
+            _linger = std::min(_linger * 2, max_linger);
+            return;
+        }
+        const auto record_count = _config.produce_batch_record_count();
+        const auto size_bytes = _config.produce_batch_size_bytes();
+        if (_record_count * 4 < record_count && _size_bytes * 4 < size_bytes) {
+            _linger = std::max(
+              _linger / 2, std::min(std::chrono::milliseconds{1}, max_linger));
+        }
     }
 
-    bool try_consume(bool timed_out) {
-        if (_in_flight || _record_count == 0) {
+    bool try_consume() {
+        if (_in_flight >= max_in_flight() || _record_count == 0) {
             return false;
         }
 
@@ -78,12 +162,14 @@ private:
         auto threshold_met = _record_count >= batch_record_count
                              || _size_bytes >= batch_size_bytes;
 
-        if (!timed_out && !threshold_met) {
-            _timer.cancel();
-            _timer.arm(_config.produce_batch_delay());
+        if (!_lingered && !threshold_met) {
+            if (!_timer.armed()) {
+                _timer.arm(_linger);
+            }
             return false;
         }
 
+        adapt_linger(threshold_met);
         _consumer(do_consume());
         return true;
     }
@@ -92,9 +178,17 @@ private:
     produce_batcher _batcher{};
     ss::timer<> _timer{};
     consumer _consumer;
+    const std::optional<model::producer_identity>* _pid;
+    std::chrono::milliseconds _linger;
+    /// Next sequence number of the producer identity
+    model::producer_identity _sequence_pid;
+    int32_t _sequence{0};
     int32_t _record_count{};
     int32_t _size_bytes{};
-    bool _in_flight{};
+    int32_t _in_flight{};
+    /// The batch being filled lingered for long enough
+    bool _lingered{};
+    ss::future<> _responses{ss::now()};
 };
 
 } // namespace kafka::client
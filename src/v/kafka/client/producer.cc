@@ -15,8 +15,11 @@
 #include "kafka/client/logger.h"
 #include "kafka/client/retry_with_mitigation.h"
 #include "kafka/protocol/errors.h"
+#include "kafka/protocol/init_producer_id.h"
 #include "kafka/protocol/produce.h"
+#include "model/compression.h"
 #include "model/fundamental.h"
+#include "storage/parser_utils.h"
 
 #include <seastar/core/gate.hh>
 
@@ -24,8 +27,8 @@
 
 namespace kafka::client {
 
-produce_request
-make_produce_request(model::topic_partition tp, model::record_batch&& batch) {
+produce_request make_produce_request(
+  model::topic_partition tp, model::record_batch&& batch, int16_t acks) {
     std::vector<produce_request::partition> partitions;
     partitions.emplace_back(produce_request::partition{
       .partition_index{tp.partition},
@@ -35,7 +38,6 @@ make_produce_request(model::topic_partition tp, model::record_batch&& batch) {
     topics.emplace_back(produce_request::topic{
       .name{std::move(tp.topic)}, .partitions{std::move(partitions)}});
     std::optional<ss::sstring> t_id;
-    int16_t acks = -1;
     return produce_request(t_id, acks, std::move(topics));
 }
 
@@ -68,17 +70,60 @@ make_produce_response(model::partition_id p_id, std::exception_ptr ex) {
 
 ss::future<produce_response::partition>
 producer::produce(model::topic_partition tp, model::record_batch&& batch) {
+    maybe_init_producer_id();
     return get_context(std::move(tp))->produce(std::move(batch));
 }
 
+void producer::maybe_init_producer_id() {
+    if (
+      !_config.produce_enable_idempotence() || _pid || _init_pid_pending
+      || _init_pid_failed) {
+        return;
+    }
+    _init_pid_pending = true;
+    (void)ss::try_with_gate(_gate, [this]() {
+        return init_producer_id().handle_exception(
+          [this](std::exception_ptr ex) {
+              // Retried by the next produce
+              vlog(kclog.debug, "failed to init producer id: {}", ex);
+              _init_pid_pending = false;
+          });
+    }).handle_exception_type([](const ss::gate_closed_exception&) {});
+}
+
+ss::future<> producer::init_producer_id() {
+    return _brokers.any()
+      .then([](shared_broker_t broker) {
+          init_producer_id_request req;
+          req.data.transaction_timeout_ms = std::chrono::milliseconds{0};
+          return broker->dispatch(std::move(req));
+      })
+      .then([this](init_producer_id_response res) {
+          _init_pid_pending = false;
+          if (res.data.error_code != error_code::none) {
+              vlog(
+                kclog.warn,
+                "producing without idempotence, failed to init producer id: "
+                "{}",
+                res.data.error_code);
+              _init_pid_failed = true;
+              return;
+          }
+          _pid = model::producer_identity{
+            .id = res.data.producer_id(), .epoch = res.data.producer_epoch};
+          vlog(kclog.debug, "initialized producer id: {}", *_pid);
+      });
+}
+
 ss::future<produce_response::partition>
 producer::do_send(model::topic_partition tp, model::record_batch&& batch) {
     return _topic_cache.leader(tp)
       .then([this](model::node_id leader) { return _brokers.find(leader); })
       .then([tp{std::move(tp)},
-             batch{std::move(batch)}](shared_broker_t broker) mutable {
+             batch{std::move(batch)},
+             acks = _config.produce_acks()](shared_broker_t broker) mutable {
           return broker->dispatch(
-            make_produce_request(std::move(tp), std::move(batch)));
+            make_produce_request(std::move(tp), std::move(batch), acks));
       })
       .then([](produce_response res) mutable {
           auto topic = std::move(res.data.responses[0]);
@@ -94,7 +139,7 @@ producer::do_send(model::topic_partition tp, model::record_batch&& batch) {
       });
 }
 
-ss::future<>
+ss::future<produce_response::partition>
 producer::send(model::topic_partition tp, model::record_batch&& batch) {
     auto record_count = batch.record_count();
     vlog(
@@ -103,35 +148,43 @@ producer::send(model::topic_partition tp, model::record_batch&& batch) {
       tp,
       record_count);
     auto p_id = tp.partition;
-    return ss::do_with(
-             std::move(batch),
-             [this, tp](model::record_batch& batch) mutable {
-                 return retry_with_mitigation(
-                   _config.retries(),
-                   _config.retry_base_backoff(),
-                   [this, tp{std::move(tp)}, &batch]() {
-                       return do_send(tp, batch.share());
-                   },
-                   [this](std::exception_ptr ex) {
-                       return _error_handler(std::move(ex))
-                         .handle_exception([](std::exception_ptr ex) {
-                             vlog(
-                               kclog.trace, "Error during mitigation: {}", ex);
-                             // ignore failed mitigation
-                         });
-                   });
-             })
+    auto compression = _config.produce_compression_type();
+    auto compressed
+      = compression == model::compression::none
+            || compression == model::compression::producer
+          ? ss::make_ready_future<model::record_batch>(std::move(batch))
+          : storage::internal::compress_batch(compression, std::move(batch));
+    return std::move(compressed)
+      .then([this, tp](model::record_batch batch) mutable {
+          return ss::do_with(
+            std::move(batch), [this, tp](model::record_batch& batch) mutable {
+                return retry_with_mitigation(
+                  _config.retries(),
+                  _config.retry_base_backoff(),
+                  [this, tp{std::move(tp)}, &batch]() {
+                      return do_send(tp, batch.share());
+                  },
+                  [this](std::exception_ptr ex) {
+                      return _error_handler(std::move(ex))
+                        .handle_exception([](std::exception_ptr ex) {
+                            vlog(
+                              kclog.trace, "Error during mitigation: {}", ex);
+                            // ignore failed mitigation
+                        });
+                  });
+            });
+      })
       .handle_exception([p_id](std::exception_ptr ex) {
           return make_produce_response(p_id, std::move(ex));
       })
-      .then([this, tp, record_count](produce_response::partition res) mutable {
+      .then([tp, record_count](produce_response::partition res) mutable {
           vlog(
             kclog.debug,
             "sent record_batch: {}, {{record_count: {}}}, {}",
             tp,
             record_count,
             res.error_code);
-          get_context(std::move(tp))->handle_response(std::move(res));
+          return res;
       });
 }
 
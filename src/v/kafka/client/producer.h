@@ -15,10 +15,15 @@
 #include "kafka/client/produce_partition.h"
 #include "kafka/client/topic_cache.h"
 #include "model/fundamental.h"
+#include "model/record.h"
 #include "ssx/future-util.h"
 
+#include <seastar/core/gate.hh>
+
 #include <absl/container/flat_hash_map.h>
 
+#include <optional>
+
 namespace kafka::client {
 
 class brokers;
@@ -46,20 +51,30 @@ public:
     produce(model::topic_partition tp, model::record_batch&& batch);
 
     ss::future<> stop() {
-        return ssx::parallel_transform(
-          std::move(_partitions),
-          [](partitions_t::value_type p) { return p.second->stop(); });
+        return _gate.close().then([this]() {
+            return ssx::parallel_transform(
+              std::move(_partitions),
+              [](partitions_t::value_type p) { return p.second->stop(); });
+        });
     }
 
 private:
-    ss::future<> send(model::topic_partition tp, model::record_batch&& batch);
+    ss::future<produce_response::partition>
+    send(model::topic_partition tp, model::record_batch&& batch);
 
     ss::future<produce_response::partition>
     do_send(model::topic_partition tp, model::record_batch&& batch);
 
+    /// \brief Request a producer id in the background, if enabled.
+    ///
+    /// The batches consumed until it is known are sent without one.
+    void maybe_init_producer_id();
+    ss::future<> init_producer_id();
+
     auto make_consumer(model::topic_partition tp) {
         return [this, tp](model::record_batch&& batch) {
-            (void)send(tp, std::move(batch));
+            // Called in the order of the batches of the partition
+            get_context(tp)->handle_response(send(tp, std::move(batch)));
         };
     }
 
@@ -70,7 +85,8 @@ private:
         return _partitions
           .emplace(
             tp,
-            ss::make_lw_shared<produce_partition>(_config, make_consumer(tp)))
+            ss::make_lw_shared<produce_partition>(
+              _config, make_consumer(tp), &_pid))
           .first->second;
     }
 
@@ -80,6 +96,11 @@ private:
     error_handler _error_handler;
     topic_cache& _topic_cache;
     brokers& _brokers;
+    std::optional<model::producer_identity> _pid;
+    bool _init_pid_pending{false};
+    /// The broker does not hand out producer ids
+    bool _init_pid_failed{false};
+    ss::gate _gate;
 };
 
 } // namespace kafka::client
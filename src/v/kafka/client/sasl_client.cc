@@ -12,6 +12,9 @@
 
 #include "kafka/client/logger.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace kafka::client {
 
 ss::future<>
@@ -112,6 +115,45 @@ static ss::future<security::server_final_message> send_scram_client_final(
       std::move(client_last_resp.data.auth_bytes));
 }
 
+/*
+ * The salted password is the expensive part of the client side of SCRAM. It
+ * only depends on the password and on the salt and iterations of the stored
+ * credential, so it is cached for the reconnects of the clients of the shard.
+ * The clients of a shard authenticate with few distinct credentials.
+ */
+template<typename ScramAlgo>
+static ss::future<bytes> get_salted_password(
+  const ss::sstring& password, const bytes& salt, int iterations) {
+    struct entry {
+        ss::sstring password;
+        bytes salt;
+        int iterations;
+        bytes salted_password;
+    };
+    static constexpr size_t max_entries = 8;
+    static thread_local std::vector<entry> cache;
+
+    auto it = std::find_if(cache.begin(), cache.end(), [&](const entry& e) {
+        return e.iterations == iterations && e.salt == salt
+               && e.password == password;
+    });
+    if (it != cache.end()) {
+        co_return it->salted_password;
+    }
+
+    auto result = co_await ScramAlgo::hi_async(
+      bytes(password.cbegin(), password.cend()), salt, iterations);
+    if (cache.size() >= max_entries) {
+        cache.erase(cache.begin());
+    }
+    cache.push_back(entry{
+      .password = password,
+      .salt = salt,
+      .iterations = iterations,
+      .salted_password = result});
+    co_return result;
+}
+
 template<typename ScramAlgo>
 static ss::future<> do_authenticate_scram(
   shared_broker_t broker, ss::sstring username, ss::sstring password) {
@@ -152,10 +194,8 @@ static ss::future<> do_authenticate_scram(
     security::client_final_message client_final(
       bytes("n,,"), server_first.nonce());
 
-    auto salted_password = ScramAlgo::hi(
-      bytes(password.cbegin(), password.cend()),
-      server_first.salt(),
-      server_first.iterations());
+    const auto salted_password = co_await get_salted_password<ScramAlgo>(
+      password, server_first.salt(), server_first.iterations());
 
     client_final.set_proof(ScramAlgo::client_proof(
       salted_password, client_first, server_first, client_final));
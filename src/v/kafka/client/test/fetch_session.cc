@@ -157,3 +157,51 @@ SEASTAR_THREAD_TEST_CASE(test_fetch_session_make_offset_commit_request_all) {
       partition.committed_leader_epoch, kafka::invalid_leader_epoch);
     BOOST_REQUIRE_EQUAL(partition.committed_offset, ctx.expected_offset - 1);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_fetch_session_incremental) {
+    context ctx;
+    kc::fetch_session s;
+
+    // Full requests carry every partition
+    BOOST_REQUIRE(s.must_send(ctx.tp));
+    s.sent(ctx.tp, s.offset(ctx.tp));
+    BOOST_REQUIRE(s.must_send(ctx.tp));
+
+    // Incremental requests only carry changed offsets
+    BOOST_REQUIRE(ctx.apply_fetch_response(s, 8));
+    BOOST_REQUIRE(s.must_send(ctx.tp));
+    s.sent(ctx.tp, s.offset(ctx.tp));
+    BOOST_REQUIRE(!s.must_send(ctx.tp));
+    BOOST_REQUIRE(ctx.apply_fetch_response(s, std::nullopt));
+    BOOST_REQUIRE(!s.must_send(ctx.tp));
+    BOOST_REQUIRE(ctx.apply_fetch_response(s, 8));
+    BOOST_REQUIRE(s.must_send(ctx.tp));
+    s.sent(ctx.tp, s.offset(ctx.tp));
+
+    // A reset session starts over with a full request, keeping the offsets
+    s.reset_session();
+    BOOST_REQUIRE_EQUAL(s.epoch(), kafka::initial_fetch_session_epoch);
+    BOOST_REQUIRE_EQUAL(s.offset(ctx.tp), ctx.expected_offset);
+    BOOST_REQUIRE(s.must_send(ctx.tp));
+    ctx.expected_epoch = kafka::initial_fetch_session_epoch;
+    BOOST_REQUIRE(ctx.apply_fetch_response(s, std::nullopt));
+    BOOST_REQUIRE_EQUAL(s.id(), ctx.fetch_session_id);
+    BOOST_REQUIRE_EQUAL(s.epoch(), ctx.expected_epoch);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_fetch_session_sessionless) {
+    context ctx;
+    kc::fetch_session s;
+
+    // Without a session from the broker every request is a full one
+    auto res = make_fetch_response(
+      kafka::invalid_fetch_session_id,
+      ctx.tp,
+      make_record_set(ctx.expected_offset, 8));
+    BOOST_REQUIRE(s.apply(res));
+    BOOST_REQUIRE_EQUAL(s.id(), kafka::invalid_fetch_session_id);
+    BOOST_REQUIRE_EQUAL(s.epoch(), kafka::initial_fetch_session_epoch);
+    BOOST_REQUIRE_EQUAL(s.offset(ctx.tp), model::offset{8});
+    s.sent(ctx.tp, s.offset(ctx.tp));
+    BOOST_REQUIRE(s.must_send(ctx.tp));
+}
@@ -17,12 +17,16 @@
 #include "model/fundamental.h"
 #include "model/record.h"
 
+#include <seastar/core/future-util.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/testing/thread_test_case.hh>
 
 #include <boost/test/tools/old/interface.hpp>
 
 #include <exception>
+#include <optional>
 #include <system_error>
+#include <vector>
 
 namespace kc = kafka::client;
 
@@ -65,3 +69,103 @@ SEASTAR_THREAD_TEST_CASE(test_produce_partition_record_count) {
     auto c_res2 = c_res2_fut.get0();
     BOOST_REQUIRE_EQUAL(c_res2.base_offset, model::offset{3});
 }
+
+SEASTAR_THREAD_TEST_CASE(test_produce_partition_idempotent_in_flight) {
+    std::vector<model::record_batch> consumed_batches;
+    auto consumer = [&consumed_batches](model::record_batch&& batch) {
+        consumed_batches.push_back(std::move(batch));
+    };
+
+    auto cfg = kc::configuration{};
+    cfg.produce_batch_size_bytes.set_value(1024);
+    cfg.produce_batch_record_count.set_value(3);
+    cfg.produce_max_in_flight.set_value(2);
+
+    std::optional<model::producer_identity> pid;
+    kc::produce_partition producer(cfg, consumer, &pid);
+    auto response = [](int64_t base_offset) {
+        return kafka::produce_response::partition{
+          .partition_index{model::partition_id{42}},
+          .error_code = kafka::error_code::none,
+          .base_offset{model::offset{base_offset}}};
+    };
+
+    // Without a producer id a single batch is in flight
+    auto c_res0_fut = producer.produce(make_batch(model::offset(0), 3));
+    auto c_res1_fut = producer.produce(make_batch(model::offset(3), 3));
+    BOOST_REQUIRE_EQUAL(consumed_batches.size(), 1);
+    BOOST_REQUIRE_EQUAL(consumed_batches[0].header().producer_id, -1);
+    producer.handle_response(response(0));
+    BOOST_REQUIRE_EQUAL(consumed_batches.size(), 2);
+    producer.handle_response(response(3));
+    BOOST_REQUIRE_EQUAL(c_res0_fut.get0().base_offset, model::offset{0});
+    BOOST_REQUIRE_EQUAL(c_res1_fut.get0().base_offset, model::offset{3});
+
+    pid = model::producer_identity{.id = 7, .epoch = 1};
+    auto c_res2_fut = producer.produce(make_batch(model::offset(6), 3));
+    auto c_res3_fut = producer.produce(make_batch(model::offset(9), 3));
+    auto c_res4_fut = producer.produce(make_batch(model::offset(12), 3));
+    BOOST_REQUIRE_EQUAL(consumed_batches.size(), 4);
+    for (size_t i = 2; i < consumed_batches.size(); ++i) {
+        const auto& hdr = consumed_batches[i].header();
+        BOOST_REQUIRE_EQUAL(hdr.producer_id, 7);
+        BOOST_REQUIRE_EQUAL(hdr.producer_epoch, 1);
+        BOOST_REQUIRE_EQUAL(hdr.base_sequence, static_cast<int32_t>(i - 2) * 3);
+        BOOST_REQUIRE_EQUAL(
+          hdr.header_crc, model::internal_header_only_crc(hdr));
+    }
+
+    // The responses are handled in the order of the batches
+    ss::promise<kafka::produce_response::partition> res2;
+    ss::promise<kafka::produce_response::partition> res3;
+    producer.handle_response(res2.get_future());
+    producer.handle_response(res3.get_future());
+    res3.set_value(response(9));
+    ss::later().get();
+    BOOST_REQUIRE(!c_res2_fut.available());
+    BOOST_REQUIRE_EQUAL(consumed_batches.size(), 4);
+    res2.set_value(response(6));
+    BOOST_REQUIRE_EQUAL(c_res2_fut.get0().base_offset, model::offset{6});
+    BOOST_REQUIRE_EQUAL(c_res3_fut.get0().base_offset, model::offset{9});
+    BOOST_REQUIRE_EQUAL(consumed_batches.size(), 5);
+    BOOST_REQUIRE_EQUAL(consumed_batches[4].header().base_sequence, 6);
+
+    producer.handle_response(response(12));
+    BOOST_REQUIRE_EQUAL(c_res4_fut.get0().base_offset, model::offset{12});
+    producer.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_produce_partition_linger) {
+    std::vector<model::record_batch> consumed_batches;
+    auto consumer = [&consumed_batches](model::record_batch&& batch) {
+        consumed_batches.push_back(std::move(batch));
+    };
+
+    auto cfg = kc::configuration{};
+    cfg.produce_batch_size_bytes.set_value(1024);
+    cfg.produce_batch_record_count.set_value(100);
+    cfg.produce_batch_delay.set_value(std::chrono::milliseconds{10});
+
+    kc::produce_partition producer(cfg, consumer);
+
+    // The linger starts with the first record, later records don't delay it
+    std::vector<ss::future<kafka::produce_response::partition>> c_res_futs;
+    for (int i = 0; i < 20 && consumed_batches.empty(); ++i) {
+        c_res_futs.push_back(
+          producer.produce(make_batch(model::offset(i), 1)));
+        ss::sleep(std::chrono::milliseconds{2}).get();
+    }
+    BOOST_REQUIRE_EQUAL(consumed_batches.size(), 1);
+    BOOST_REQUIRE_EQUAL(
+      consumed_batches[0].record_count(),
+      static_cast<int32_t>(c_res_futs.size()));
+    producer.handle_response(kafka::produce_response::partition{
+      .partition_index{model::partition_id{42}},
+      .error_code = kafka::error_code::none,
+      .base_offset{model::offset{0}}});
+    for (size_t i = 0; i < c_res_futs.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(
+          c_res_futs[i].get0().base_offset, model::offset(i));
+    }
+    producer.stop().get();
+}
@@ -145,6 +145,8 @@ public:
             return dispatch(std::move(r), api_version(1));
         } else if constexpr (std::is_same_v<type, sasl_authenticate_request>) {
             return dispatch(std::move(r), api_version(1));
+        } else if constexpr (std::is_same_v<type, init_producer_id_request>) {
+            return dispatch(std::move(r), api_version(1));
         }
     }
 
@@ -13,13 +13,15 @@
 
 #include "config/configuration.h"
 #include "prometheus/prometheus_sanitize.h"
-#include "utils/hdr_hist.h"
+#include "utils/log_hist.h"
 
 #include <seastar/core/metrics.hh>
 
 namespace kafka {
 class latency_probe {
 public:
+    using hist_t = log_hist<std::chrono::microseconds>;
+
     void setup_metrics() {
         namespace sm = ss::metrics;
 
@@ -42,16 +44,16 @@ public:
              [this] { return _produce_latency.seastar_histogram_logform(); })});
     }
 
-    std::unique_ptr<hdr_hist::measurement> auto_produce_measurement() {
+    hist_t::measurement auto_produce_measurement() {
         return _produce_latency.auto_measure();
     }
-    std::unique_ptr<hdr_hist::measurement> auto_fetch_measurement() {
+    hist_t::measurement auto_fetch_measurement() {
         return _fetch_latency.auto_measure();
     }
 
 private:
-    hdr_hist _produce_latency;
-    hdr_hist _fetch_latency;
+    hist_t _produce_latency;
+    hist_t _fetch_latency;
     ss::metrics::metric_groups _metrics;
 };
 
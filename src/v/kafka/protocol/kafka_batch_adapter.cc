@@ -17,6 +17,7 @@
 #include "kafka/server/request_context.h"
 #include "likely.h"
 #include "model/record.h"
+#include "model/record_utils.h"
 #include "raft/types.h"
 #include "storage/parser_utils.h"
 #include "vassert.h"
@@ -123,6 +124,18 @@ void kafka_batch_adapter::verify_crc(int32_t expected_crc, iobuf_parser in) {
     }
 }
 
+void kafka_batch_adapter::verify_records(const model::record_batch& b) {
+    iobuf_const_parser parser(b.data());
+    for (int32_t i = 0; i < b.record_count(); ++i) {
+        model::verify_one_record_from_buffer(parser);
+    }
+    if (unlikely(parser.bytes_left())) {
+        throw std::out_of_range(fmt::format(
+          "Record iteration stopped with {} bytes remaining",
+          parser.bytes_left()));
+    }
+}
+
 iobuf kafka_batch_adapter::adapt(iobuf&& kbatch) {
     // The batch size given in the kafka header does not include the offset
     // preceeding the length field nor the size of the length field itself.
@@ -171,12 +184,13 @@ iobuf kafka_batch_adapter::adapt(iobuf&& kbatch) {
 
     /**
      * Perform some type of validation on the uncompressed input. In this case
-     * we make sure that the records can be materialized but we avoid
-     * re-encoding them using the lazy-record optimization.
+     * we make sure that the records are well formed, walking over their
+     * fields without materializing them, the batch keeps the original
+     * fragments of the request as its records.
      */
     if (!new_batch.compressed()) {
         try {
-            new_batch.for_each_record([](model::record r) { (void)r; });
+            verify_records(new_batch);
         } catch (const std::exception& e) {
             vlog(klog.error, "Parsing uncompressed records: {}", e.what());
             return remainder;
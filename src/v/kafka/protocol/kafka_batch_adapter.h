@@ -71,6 +71,7 @@ public:
 
 private:
     void verify_crc(int32_t, iobuf_parser);
+    static void verify_records(const model::record_batch&);
     model::record_batch_header read_header(iobuf_parser&);
     void convert_message_set(storage::record_batch_builder&, iobuf, bool);
 };
@@ -35,6 +35,9 @@ struct leave_group_request final {
 
     leave_group_request_data data;
 
+    // extra context from request header set in decode
+    api_version version;
+
     // set during request processing after mapping group to ntp
     model::ntp ntp;
 
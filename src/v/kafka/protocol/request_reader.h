@@ -25,6 +25,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <optional>
 #include <type_traits>
 
@@ -122,7 +123,9 @@ private:
     // clang-format on
     std::vector<T> do_read_array(int32_t len, ElementParser&& parser) {
         std::vector<T> res;
-        res.reserve(std::max(0, len));
+        // every element takes at least a byte on the wire, a bogus length
+        // must not make us allocate more than the request could hold
+        res.reserve(std::min<size_t>(std::max(0, len), bytes_left()));
         while (len-- > 0) {
             res.push_back(parser(*this));
         }
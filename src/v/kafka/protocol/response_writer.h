@@ -125,14 +125,23 @@ public:
         if (!rdr) {
             return write(std::optional<iobuf>());
         }
-        return write(std::move(*rdr).release());
+        return write_records(std::move(*rdr).release());
     }
 
     uint32_t write(std::optional<batch_reader>& rdr) {
         if (!rdr) {
             return write(std::optional<iobuf>());
         }
-        return write(std::move(*rdr).release());
+        return write_records(std::move(*rdr).release());
+    }
+
+    // records are chained to the output by reference, append() would copy
+    // the fragments fitting into the space left in the output
+    uint32_t write_records(iobuf&& records) {
+        auto size = serialize_int<int32_t>(records.size_bytes())
+                    + records.size_bytes();
+        _out->append_fragments(std::move(records));
+        return size;
     }
 
     // write bytes directly to output without a length prefix
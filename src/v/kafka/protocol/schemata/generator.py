@@ -81,6 +81,7 @@ path_type_map = {
             },
         },
         "MemberId": ("kafka::member_id", "string"),
+        "GroupInstanceId": ("kafka::group_instance_id", "string"),
     },
     "AddPartitionsToTxnRequestData": {
         "Topics": {
@@ -399,6 +400,19 @@ SCALAR_TYPES = list(basic_type_map.keys())
 ENTITY_TYPES = list(entity_type_map.keys())
 
 
+# messages of the hot apis get a codec specialized for each of their valid
+# versions. the fields of a version are encoded and decoded one after the
+# other, without checking the version of every field at runtime.
+specialized_messages = [
+    "ProduceRequest",
+    "ProduceResponse",
+    "FetchRequest",
+    "FetchResponse",
+    "MetadataRequest",
+    "MetadataResponse",
+]
+
+
 def apply_struct_renames(path, type_name):
     rename = struct_renames.get(path, None)
     if rename is None:
@@ -447,6 +461,13 @@ class VersionRange:
             cond = " && ".join(cond)
         return cond
 
+    def contains(self, version):
+        """
+        True if the range includes the version.
+        """
+        return self.min <= version and (self.max is None
+                                        or version <= self.max)
+
     def __repr__(self):
         max = "+inf)" if self.max is None else f"{self.max}]"
         return f"[{self.min}, {max}"
@@ -782,7 +803,11 @@ SOURCE_TEMPLATE = """
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
-{% macro version_guard(field) %}
+{#- the version is none in generic codecs, checked at runtime. specialized
+    codecs are rendered for a known version, without the fields that are not
+    part of it #}
+{% macro version_guard(field, version) %}
+{%- if version is none %}
 {%- set cond = field.versions().guard() %}
 {%- if cond %}
 if ({{ cond }}) {
@@ -791,9 +816,20 @@ if ({{ cond }}) {
 {%- else %}
 {{- caller() }}
 {%- endif %}
+{%- elif field.versions().contains(version) %}
+{{- caller() }}
+{%- endif %}
+{%- endmacro %}
+
+{% macro version_capture(version) %}
+{%- if version is none %}[version]{% else %}[]{% endif %}
+{%- endmacro %}
+
+{% macro version_value(version) %}
+{%- if version is none %}version{% else %}api_version({{ version }}){% endif %}
 {%- endmacro %}
 
-{% macro field_encoder(field, obj) %}
+{% macro field_encoder(field, obj, version) %}
 {%- if obj %}
 {%- set fname = obj + "." + field.name %}
 {%- else %}
@@ -801,12 +837,12 @@ if ({{ cond }}) {
 {%- endif %}
 {%- if field.is_array %}
 {%- if field.nullable() %}
-writer.write_nullable_array({{ fname }}, [version]({{ field.value_type }}& v, response_writer& writer) {
+writer.write_nullable_array({{ fname }}, {{ version_capture(version) }}({{ field.value_type }}& v, response_writer& writer) {
 {%- else %}
-writer.write_array({{ fname }}, [version]({{ field.value_type }}& v, response_writer& writer) {
+writer.write_array({{ fname }}, {{ version_capture(version) }}({{ field.value_type }}& v, response_writer& writer) {
 {%- endif %}
 {%- if field.type().value_type().is_struct %}
-{{- struct_serde(field.type().value_type(), field_encoder, "v") | indent }}
+{{- struct_serde(field.type().value_type(), field_encoder, "v", version) | indent }}
 {%- else %}
     writer.write(v);
 {%- endif %}
@@ -816,7 +852,7 @@ writer.write({{ fname }});
 {%- endif %}
 {%- endmacro %}
 
-{% macro field_decoder(field, obj) %}
+{% macro field_decoder(field, obj, version) %}
 {%- if obj %}
 {%- set fname = obj + "." + field.name %}
 {%- else %}
@@ -824,13 +860,13 @@ writer.write({{ fname }});
 {%- endif %}
 {%- if field.is_array %}
 {%- if field.nullable() %}
-{{ fname }} = reader.read_nullable_array([version](request_reader& reader) {
+{{ fname }} = reader.read_nullable_array({{ version_capture(version) }}(request_reader& reader) {
 {%- else %}
-{{ fname }} = reader.read_array([version](request_reader& reader) {
+{{ fname }} = reader.read_array({{ version_capture(version) }}(request_reader& reader) {
 {%- endif %}
 {%- if field.type().value_type().is_struct %}
     {{ field.type().value_type().name }} v;
-{{- struct_serde(field.type().value_type(), field_decoder, "v") | indent }}
+{{- struct_serde(field.type().value_type(), field_decoder, "v", version) | indent }}
     return v;
 {%- else %}
 {%- set decoder, named_type = field.decoder %}
@@ -858,7 +894,7 @@ writer.write({{ fname }});
     auto tmp = reader.{{ decoder }};
     if (tmp) {
 {%- if named_type == "kafka::produce_request_record_data" %}
-        {{ fname }} = {{ named_type }}(std::move(*tmp), version);
+        {{ fname }} = {{ named_type }}(std::move(*tmp), {{ version_value(version) }});
 {%- else %}
         {{ fname }} = {{ named_type }}(std::move(*tmp));
 {%- endif %}
@@ -870,28 +906,61 @@ writer.write({{ fname }});
 {%- endif %}
 {%- endmacro %}
 
-{% macro struct_serde(struct, field_serde, obj = "") %}
+{% macro struct_serde(struct, field_serde, obj = "", version = none) %}
 {%- for field in struct.fields %}
-{%- call version_guard(field) %}
-{{- field_serde(field, obj) }}
+{%- call version_guard(field, version) %}
+{{- field_serde(field, obj, version) }}
 {%- endcall %}
 {%- endfor %}
 {%- endmacro %}
 
+{#- dispatches the versions with a specialized codec to it, the other ones
+    to the generic codec #}
+{% macro version_dispatch(versions, fn, args) %}
+switch (version()) {
+{%- for v in versions %}
+case {{ v }}:
+    {{ fn }}_v{{ v }}(*this, {{ args }});
+    return;
+{%- endfor %}
+default:
+    break;
+}
+{%- endmacro %}
+
 namespace kafka {
 
 {%- if struct.fields %}
+{%- for v in versions %}
+static void encode_v{{ v }}({{ struct.name }}& self, response_writer& writer) {
+{{- struct_serde(struct, field_encoder, "self", v) | indent }}
+}
+
+static void decode_v{{ v }}({{ struct.name }}& self, request_reader& reader) {
+{{- struct_serde(struct, field_decoder, "self", v) | indent }}
+}
+{% endfor %}
+
 void {{ struct.name }}::encode(response_writer& writer, [[maybe_unused]] api_version version) {
+{%- if versions %}
+{{- version_dispatch(versions, "encode", "writer") | indent }}
+{%- endif %}
 {{- struct_serde(struct, field_encoder) | indent }}
 }
 
 {%- if op_type == "request" %}
 void {{ struct.name }}::decode(request_reader& reader, [[maybe_unused]] api_version version) {
+{%- if versions %}
+{{- version_dispatch(versions, "decode", "reader") | indent }}
+{%- endif %}
 {{- struct_serde(struct, field_decoder) | indent }}
 }
 {%- else %}
 void {{ struct.name }}::decode(iobuf buf, [[maybe_unused]] api_version version) {
     request_reader reader(std::move(buf));
+{%- if versions %}
+{{- version_dispatch(versions, "decode", "reader") | indent }}
+{%- endif %}
 
 {{- struct_serde(struct, field_decoder) | indent }}
 }
@@ -1090,6 +1159,12 @@ if __name__ == "__main__":
     # request or response
     op_type = msg["type"]
 
+    versions = []
+    if msg["name"] in specialized_messages:
+        valid = VersionRange(msg["validVersions"])
+        assert valid.max is not None
+        versions = list(range(valid.min, valid.max + 1))
+
     with open(hdr, 'w') as f:
         f.write(
             jinja2.Template(HEADER_TEMPLATE).render(
@@ -1101,4 +1176,5 @@ if __name__ == "__main__":
         f.write(
             jinja2.Template(SOURCE_TEMPLATE).render(struct=struct,
                                                     header=hdr.name,
-                                                    op_type=op_type))
+                                                    op_type=op_type,
+                                                    versions=versions))
@@ -0,0 +1,280 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/iobuf.h"
+#include "kafka/protocol/batch_reader.h"
+#include "kafka/protocol/fetch.h"
+#include "kafka/protocol/metadata.h"
+#include "kafka/protocol/produce.h"
+#include "kafka/protocol/request_reader.h"
+#include "kafka/protocol/response_writer.h"
+#include "model/record.h"
+#include "storage/record_batch_builder.h"
+#include "units.h"
+
+#include <seastar/core/memory.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <fmt/format.h>
+
+/*
+ * Encoding and decoding of the messages of the hot apis, at the lowest and
+ * the highest versions handled by redpanda. perf_tests reports the time per
+ * operation, the allocations per operation are printed once a test is done.
+ */
+
+static constexpr int records_per_batch = 10;
+static constexpr size_t record_size = 100;
+
+static model::record_batch make_batch() {
+    static const ss::sstring payload(record_size, 'x');
+    storage::record_batch_builder builder(
+      model::record_batch_type::raft_data, model::offset(0));
+    for (int i = 0; i < records_per_batch; ++i) {
+        iobuf v;
+        v.append(payload.data(), payload.size());
+        builder.add_raw_kv(iobuf{}, std::move(v));
+    }
+    return std::move(builder).build();
+}
+
+/// a batch in the kafka on-wire format
+static iobuf make_kafka_batch() {
+    iobuf buf;
+    kafka::response_writer writer(buf);
+    kafka::writer_serialize_batch(writer, make_batch());
+    return buf;
+}
+
+template<int batches>
+struct produce_request_factory {
+    static ss::sstring name() {
+        return fmt::format("produce_request {} batches", batches);
+    }
+    static kafka::produce_request make() {
+        kafka::produce_request::topic tp;
+        tp.name = model::topic("topic");
+        for (int i = 0; i < batches; ++i) {
+            kafka::produce_request::partition p;
+            p.partition_index = model::partition_id(i);
+            p.records.emplace(make_batch());
+            tp.partitions.push_back(std::move(p));
+        }
+        std::vector<kafka::produce_request::topic> topics;
+        topics.push_back(std::move(tp));
+        return kafka::produce_request(std::nullopt, -1, std::move(topics));
+    }
+};
+
+template<int topics, int partitions>
+struct fetch_request_factory {
+    static ss::sstring name() {
+        return fmt::format("fetch_request {} partitions", topics * partitions);
+    }
+    static kafka::fetch_request make() {
+        kafka::fetch_request r;
+        r.data.max_wait_ms = std::chrono::milliseconds(500);
+        r.data.min_bytes = 1;
+        r.data.max_bytes = 50_MiB;
+        for (int t = 0; t < topics; ++t) {
+            kafka::fetch_request::topic topic;
+            topic.name = model::topic(fmt::format("topic-{}", t));
+            for (int p = 0; p < partitions; ++p) {
+                topic.fetch_partitions.push_back(
+                  kafka::fetch_request::partition{
+                    .partition_index = model::partition_id(p),
+                    .fetch_offset = model::offset(p * 1000),
+                    .max_bytes = 1_MiB,
+                  });
+            }
+            r.data.topics.push_back(std::move(topic));
+        }
+        return r;
+    }
+};
+
+template<int topics, int partitions>
+struct fetch_response_factory {
+    static ss::sstring name() {
+        return fmt::format(
+          "fetch_response {} partitions", topics * partitions);
+    }
+    static kafka::fetch_response make() {
+        static const iobuf batch = make_kafka_batch();
+        kafka::fetch_response r;
+        for (int t = 0; t < topics; ++t) {
+            kafka::fetch_response::partition topic;
+            topic.name = model::topic(fmt::format("topic-{}", t));
+            for (int p = 0; p < partitions; ++p) {
+                topic.partitions.push_back(
+                  kafka::fetch_response::partition_response{
+                    .partition_index = model::partition_id(p),
+                    .error_code = kafka::error_code::none,
+                    .high_watermark = model::offset(records_per_batch),
+                    .last_stable_offset = model::offset(records_per_batch),
+                    .records = kafka::batch_reader(batch.copy()),
+                  });
+            }
+            r.data.topics.push_back(std::move(topic));
+        }
+        return r;
+    }
+};
+
+template<int topics, int partitions>
+struct metadata_response_factory {
+    static ss::sstring name() {
+        return fmt::format("metadata_response {} topics", topics);
+    }
+    static kafka::metadata_response make() {
+        kafka::metadata_response r;
+        for (int t = 0; t < topics; ++t) {
+            kafka::metadata_response::topic topic;
+            topic.error_code = kafka::error_code::none;
+            topic.name = model::topic(fmt::format("topic-{}", t));
+            for (int p = 0; p < partitions; ++p) {
+                kafka::metadata_response::partition partition;
+                partition.error_code = kafka::error_code::none;
+                partition.partition_index = model::partition_id(p);
+                partition.leader_id = model::node_id(p % 3);
+                partition.replica_nodes = {
+                  model::node_id(0), model::node_id(1), model::node_id(2)};
+                partition.isr_nodes = partition.replica_nodes;
+                topic.partitions.push_back(std::move(partition));
+            }
+            r.data.topics.push_back(std::move(topic));
+        }
+        return r;
+    }
+};
+
+/// allocations of the measured sections of a test
+class allocation_counter {
+public:
+    explicit allocation_counter(ss::sstring name)
+      : _name(std::move(name)) {}
+    allocation_counter(const allocation_counter&) = delete;
+    allocation_counter& operator=(const allocation_counter&) = delete;
+    ~allocation_counter() {
+        if (_ops > 0) {
+            fmt::print("{}: {} allocations/op\n", _name, _mallocs / _ops);
+        }
+    }
+
+    void start() {
+        _start = ss::memory::stats().mallocs();
+        perf_tests::start_measuring_time();
+    }
+    void stop() {
+        perf_tests::stop_measuring_time();
+        _mallocs += ss::memory::stats().mallocs() - _start;
+        ++_ops;
+    }
+
+private:
+    ss::sstring _name;
+    uint64_t _start{0};
+    uint64_t _mallocs{0};
+    uint64_t _ops{0};
+};
+
+template<typename Factory, int16_t version>
+class codec_bench {
+public:
+    codec_bench()
+      : _encoded(encode_message(Factory::make()))
+      , _encode_allocs(fmt::format("{} v{} encode", Factory::name(), version))
+      , _decode_allocs(
+          fmt::format("{} v{} decode", Factory::name(), version)) {}
+
+    void encode() {
+        // encoding moves the records out of the message
+        auto msg = Factory::make();
+        _encode_allocs.start();
+        auto buf = encode_message(msg);
+        _encode_allocs.stop();
+        perf_tests::do_not_optimize(buf);
+    }
+
+    void decode() {
+        auto buf = _encoded.copy();
+        decltype(Factory::make()) msg;
+        _decode_allocs.start();
+        if constexpr (requires(kafka::request_reader& r) {
+                          msg.decode(r, message_version);
+                      }) {
+            kafka::request_reader reader(std::move(buf));
+            msg.decode(reader, message_version);
+        } else {
+            msg.decode(std::move(buf), message_version);
+        }
+        _decode_allocs.stop();
+        perf_tests::do_not_optimize(msg);
+    }
+
+private:
+    static constexpr kafka::api_version message_version{version};
+
+    template<typename Msg>
+    static iobuf encode_message(Msg&& msg) {
+        iobuf buf;
+        kafka::response_writer writer(buf);
+        msg.encode(writer, message_version);
+        return buf;
+    }
+
+    iobuf _encoded;
+    allocation_counter _encode_allocs;
+    allocation_counter _decode_allocs;
+};
+
+using produce_v3_1_batch = codec_bench<produce_request_factory<1>, 3>;
+using produce_v7_1_batch = codec_bench<produce_request_factory<1>, 7>;
+using produce_v3_100_batches = codec_bench<produce_request_factory<100>, 3>;
+using produce_v7_100_batches = codec_bench<produce_request_factory<100>, 7>;
+
+PERF_TEST_F(produce_v3_1_batch, encode) { encode(); }
+PERF_TEST_F(produce_v3_1_batch, decode) { decode(); }
+PERF_TEST_F(produce_v7_1_batch, encode) { encode(); }
+PERF_TEST_F(produce_v7_1_batch, decode) { decode(); }
+PERF_TEST_F(produce_v3_100_batches, encode) { encode(); }
+PERF_TEST_F(produce_v3_100_batches, decode) { decode(); }
+PERF_TEST_F(produce_v7_100_batches, encode) { encode(); }
+PERF_TEST_F(produce_v7_100_batches, decode) { decode(); }
+
+using fetch_request_v4_1K = codec_bench<fetch_request_factory<10, 100>, 4>;
+using fetch_request_v11_1K = codec_bench<fetch_request_factory<10, 100>, 11>;
+
+PERF_TEST_F(fetch_request_v4_1K, encode) { encode(); }
+PERF_TEST_F(fetch_request_v4_1K, decode) { decode(); }
+PERF_TEST_F(fetch_request_v11_1K, encode) { encode(); }
+PERF_TEST_F(fetch_request_v11_1K, decode) { decode(); }
+
+using fetch_response_v4_1K = codec_bench<fetch_response_factory<10, 100>, 4>;
+using fetch_response_v11_1K = codec_bench<fetch_response_factory<10, 100>, 11>;
+using fetch_response_v4_10K = codec_bench<fetch_response_factory<100, 100>, 4>;
+using fetch_response_v11_10K
+  = codec_bench<fetch_response_factory<100, 100>, 11>;
+
+PERF_TEST_F(fetch_response_v4_1K, encode) { encode(); }
+PERF_TEST_F(fetch_response_v4_1K, decode) { decode(); }
+PERF_TEST_F(fetch_response_v11_1K, encode) { encode(); }
+PERF_TEST_F(fetch_response_v11_1K, decode) { decode(); }
+PERF_TEST_F(fetch_response_v4_10K, encode) { encode(); }
+PERF_TEST_F(fetch_response_v4_10K, decode) { decode(); }
+PERF_TEST_F(fetch_response_v11_10K, encode) { encode(); }
+PERF_TEST_F(fetch_response_v11_10K, decode) { decode(); }
+
+using metadata_v1_10K = codec_bench<metadata_response_factory<10000, 3>, 1>;
+using metadata_v7_10K = codec_bench<metadata_response_factory<10000, 3>, 7>;
+
+PERF_TEST_F(metadata_v1_10K, encode) { encode(); }
+PERF_TEST_F(metadata_v1_10K, decode) { decode(); }
+PERF_TEST_F(metadata_v7_10K, encode) { encode(); }
+PERF_TEST_F(metadata_v7_10K, decode) { decode(); }
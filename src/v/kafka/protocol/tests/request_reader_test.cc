@@ -0,0 +1,33 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/iobuf.h"
+#include "kafka/protocol/request_reader.h"
+
+#include <seastar/core/byteorder.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <limits>
+#include <stdexcept>
+
+SEASTAR_THREAD_TEST_CASE(read_array_with_bogus_length) {
+    iobuf buf;
+    auto len = ss::cpu_to_be(std::numeric_limits<int32_t>::max());
+    buf.append(reinterpret_cast<const char*>(&len), sizeof(len));
+    for (int8_t i = 0; i < 3; ++i) {
+        buf.append(reinterpret_cast<const char*>(&i), sizeof(i));
+    }
+
+    // the declared length is bigger than the request, reading fails once the
+    // buffer is exhausted instead of reserving space for the declared length
+    kafka::request_reader reader(std::move(buf));
+    BOOST_REQUIRE_THROW(
+      reader.read_array([](kafka::request_reader& r) { return r.read_int8(); }),
+      std::out_of_range);
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "kafka/server/batch_recompressor.h"
+
+#include "config/configuration.h"
+#include "kafka/server/logger.h"
+#include "storage/parser_utils.h"
+#include "vlog.h"
+
+namespace kafka {
+
+namespace {
+class recompress_consumer {
+public:
+    recompress_consumer(
+      batch_recompressor& recompressor, model::compression target) noexcept
+      : _recompressor(recompressor)
+      , _target(target) {}
+
+    ss::future<ss::stop_iteration> operator()(model::record_batch& b) {
+        return _recompressor.recompress(b, _target)
+          .then([this](model::record_batch r) {
+              _batches.push_back(std::move(r));
+              return ss::stop_iteration::no;
+          });
+    }
+
+    model::record_batch_reader::data_t end_of_stream() {
+        return std::move(_batches);
+    }
+
+private:
+    batch_recompressor& _recompressor;
+    model::compression _target;
+    model::record_batch_reader::data_t _batches;
+};
+
+/// The batch using the target codec, the batch must outlive the future
+ss::future<model::record_batch>
+transcode(const model::record_batch& b, model::compression target) {
+    if (!b.compressed()) {
+        return storage::internal::compress_batch(target, b);
+    }
+    if (target == model::compression::none) {
+        return storage::internal::decompress_batch(b);
+    }
+    return storage::internal::decompress_batch(b).then(
+      [target](model::record_batch uncompressed) {
+          return storage::internal::compress_batch(
+            target, std::move(uncompressed));
+      });
+}
+} // namespace
+
+bool batch_recompressor::needs_recompression(
+  const model::record_batch& b, model::compression target) {
+    return !b.header().attrs.is_control()
+           && b.header().attrs.compression() != target;
+}
+
+bool batch_recompressor::has_budget() {
+    auto now = clock_type::now();
+    if (now - _window_start >= budget_window) {
+        _window_start = now;
+        _spent = clock_type::duration(0);
+    }
+    auto percent
+      = config::shard_local_cfg().kafka_recompression_cpu_budget_percent();
+    return _spent * 100 < budget_window * percent;
+}
+
+ss::future<model::record_batch_reader> batch_recompressor::recompress(
+  model::record_batch_reader reader, model::compression target) {
+    return std::move(reader)
+      .for_each_ref(recompress_consumer(*this, target), model::no_timeout)
+      .then([](model::record_batch_reader::data_t batches) {
+          return model::make_memory_record_batch_reader(std::move(batches));
+      });
+}
+
+ss::future<model::record_batch> batch_recompressor::recompress(
+  const model::record_batch& b, model::compression target) {
+    if (!needs_recompression(b, target)) {
+        return ss::make_ready_future<model::record_batch>(b.copy());
+    }
+    if (!has_budget()) {
+        vlog(
+          klog.trace,
+          "Recompression budget used up, appending batch as produced: {}",
+          b.header());
+        return ss::make_ready_future<model::record_batch>(b.copy());
+    }
+    auto start = clock_type::now();
+    return transcode(b, target)
+      .then([this, &b, target, start](model::record_batch r) {
+          _spent += clock_type::now() - start;
+          // keep the producer's codec if the target one does not do better
+          if (
+            target != model::compression::none
+            && r.size_bytes() >= b.size_bytes()) {
+              return b.copy();
+          }
+          return r;
+      });
+}
+
+batch_recompressor& local_batch_recompressor() {
+    static thread_local batch_recompressor recompressor;
+    return recompressor;
+}
+
+} // namespace kafka
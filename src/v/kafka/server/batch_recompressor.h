@@ -0,0 +1,67 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "model/compression.h"
+#include "model/record.h"
+#include "model/record_batch_reader.h"
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+
+#include <chrono>
+
+namespace kafka {
+
+/// Recompresses the produced batches of the topics with a compression type
+/// to the codec of the topic before they are appended, so that the batches
+/// are stored, replicated and fetched with the codec of the topic whatever
+/// the producers use.
+///
+/// The time spent recompressing on a shard is limited to a share of every
+/// budget window (kafka_recompression_cpu_budget_percent). The time is
+/// measured including the preemptions of the codec calls, so the budget
+/// shrinks when the core is busy. Once it is used up the batches are
+/// appended as produced until the next window.
+class batch_recompressor {
+public:
+    using clock_type = std::chrono::steady_clock;
+    static constexpr std::chrono::milliseconds budget_window{1000};
+
+    /// The batches of the reader recompressed to the target codec. Batches
+    /// already using the codec, control batches, batches that would not get
+    /// smaller and batches read once the budget is used up are kept as
+    /// produced. The reader may be a foreign reader, the returned one holds
+    /// batches allocated on this shard.
+    ss::future<model::record_batch_reader>
+    recompress(model::record_batch_reader, model::compression target);
+
+    /// The batch recompressed to the target codec, see above. The batch must
+    /// outlive the returned future
+    ss::future<model::record_batch>
+    recompress(const model::record_batch&, model::compression target);
+
+    /// True if the batch is recompressed when the target codec is set
+    static bool
+    needs_recompression(const model::record_batch&, model::compression target);
+
+private:
+    /// True if the budget of the current window is not used up
+    bool has_budget();
+
+    clock_type::time_point _window_start;
+    clock_type::duration _spent{0};
+};
+
+/// Recompressor of the shard
+batch_recompressor& local_batch_recompressor();
+
+} // namespace kafka
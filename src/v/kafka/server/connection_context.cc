@@ -22,9 +22,11 @@
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/scattered_message.hh>
 #include <seastar/core/sleep.hh>
+#include <seastar/core/with_scheduling_group.hh>
 
 #include <chrono>
 #include <memory>
+#include <vector>
 using namespace std::chrono_literals;
 
 namespace kafka {
@@ -56,6 +58,8 @@ ss::future<> connection_context::process_one_request() {
             .then(
               [this, s = sz.value()](std::optional<request_header> h) mutable {
                   _rs.probe().add_bytes_received(s);
+                  _cost.bytes += s;
+                  ++_cost.requests;
                   if (!h) {
                       vlog(
                         klog.debug,
@@ -64,6 +68,14 @@ ss::future<> connection_context::process_one_request() {
                       _rs.probe().header_corrupted();
                       return ss::make_ready_future<>();
                   }
+                  if (auto sg = _proto.tenant_sg(h->client_id); sg) {
+                      // continuations of the request, its second stage
+                      // included, inherit the scheduling group of the tenant
+                      return ss::with_scheduling_group(
+                        *sg, [this, h = std::move(*h), s]() mutable {
+                            return dispatch_method_once(std::move(h), s);
+                        });
+                  }
                   return dispatch_method_once(std::move(h.value()), s);
               });
       });
@@ -162,34 +174,87 @@ connection_context::throttle_request(
     auto delay = _proto.quota_mgr().record_tp_and_throttle(
       hdr.client_id, request_size);
     auto tracker = std::make_unique<request_tracker>(_rs.probe());
+    auto sleep = delay.first_violation ? ss::lowres_clock::duration(0)
+                                       : delay.duration;
+    // partition and topic throughput limits delay the requests following a
+    // throttled response
+    if (auto now = ss::lowres_clock::now(); _delayed_until > now) {
+        sleep = std::max(sleep, _delayed_until - now);
+    }
     auto fut = ss::now();
-    if (!delay.first_violation) {
-        fut = ss::sleep_abortable(delay.duration, _rs.abort_source());
+    if (sleep > ss::lowres_clock::duration(0)) {
+        fut = ss::sleep_abortable(sleep, _rs.abort_source());
     }
     auto track = track_latency(hdr.key);
-    return fut
-      .then(
-        [this, request_size] { return reserve_request_units(request_size); })
-      .then([this, delay, track, tracker = std::move(tracker)](
-              ss::semaphore_units<> units) mutable {
+    auto breakdown = _proto.breakdown_probe().get(hdr.key, hdr.client_id);
+    const auto queued = breakdown ? clock_type::now()
+                                  : clock_type::time_point{};
+    // wait for a slot in the connection window before taking any of the
+    // shared resources, requests queued behind it must not hold them
+    return fut.then([this] { return ss::get_units(_inflight_requests, 1); })
+      .then([this, request_size](ss::semaphore_units<> inflight_units) {
+          return reserve_request_units(request_size)
+            .then([inflight_units = std::move(inflight_units)](
+                    ss::semaphore_units<> mem_units) mutable {
+                return std::make_pair(
+                  std::move(inflight_units), std::move(mem_units));
+            });
+      })
+      .then([this,
+             delay,
+             track,
+             breakdown,
+             queued,
+             tracker = std::move(tracker)](
+              std::pair<ss::semaphore_units<>, ss::semaphore_units<>>
+                units) mutable {
           return server().get_request_unit().then(
             [this,
              delay,
-             mem_units = std::move(units),
+             units = std::move(units),
              track,
+             breakdown,
+             queued,
              tracker = std::move(tracker)](
               ss::semaphore_units<> qd_units) mutable {
                 session_resources r{
                   .backpressure_delay = delay.duration,
-                  .memlocks = std::move(mem_units),
+                  .memlocks = std::move(units.second),
                   .queue_units = std::move(qd_units),
+                  .inflight_units = std::move(units.first),
                   .tracker = std::move(tracker),
+                  .breakdown = breakdown,
                 };
+                if (breakdown) {
+                    breakdown->record(
+                      request_stage::queue, clock_type::now() - queued);
+                }
                 if (track) {
                     r.method_latency = _rs.hist().auto_measure();
                 }
                 return r;
             });
+      })
+      .then([this, track](session_resources r) {
+          auto* limit = _proto.concurrency_limit();
+          if (!track || !limit) {
+              return ss::make_ready_future<session_resources>(std::move(r));
+          }
+          // produce and fetch beyond the concurrency limit of the shard wait
+          // for a slot. the wait is added to the throttle time of the
+          // response, so that well behaved clients back off instead of piling
+          // up more requests
+          const bool saturated = limit->saturated();
+          const auto start = ss::lowres_clock::now();
+          return limit->get_permit().then(
+            [r = std::move(r), saturated, start](
+              adaptive_concurrency_limit::permit p) mutable {
+                if (saturated) {
+                    r.backpressure_delay += ss::lowres_clock::now() - start;
+                }
+                r.concurrency_permit.emplace(std::move(p));
+                return std::move(r);
+            });
       });
 }
 
@@ -254,6 +319,9 @@ connection_context::dispatch_method_once(request_header hdr, size_t size) {
               const auto correlation = rctx.header().correlation;
               const sequence_id seq = _seq_idx;
               _seq_idx = _seq_idx + sequence_id(1);
+              auto breakdown = sres.breakdown;
+              const auto dispatched = breakdown ? clock_type::now()
+                                                : clock_type::time_point{};
               auto res = kafka::process_request(
                 std::move(rctx), _proto.smp_group());
               /**
@@ -264,6 +332,8 @@ connection_context::dispatch_method_once(request_header hdr, size_t size) {
                                f = std::move(res.response),
                                seq,
                                correlation,
+                               breakdown,
+                               dispatched,
                                self,
                                s = std::move(sres)](ss::future<> d) mutable {
                     /*
@@ -293,13 +363,31 @@ connection_context::dispatch_method_once(request_header hdr, size_t size) {
                      */
                     (void)ss::try_with_gate(
                       _rs.conn_gate(),
-                      [this, f = std::move(f), seq, correlation]() mutable {
-                          return f.then(
-                            [this, seq, correlation](response_ptr r) mutable {
-                                r->set_correlation(correlation);
-                                _responses.insert({seq, std::move(r)});
-                                return process_next_response();
-                            });
+                      [this,
+                       f = std::move(f),
+                       seq,
+                       correlation,
+                       breakdown,
+                       dispatched]() mutable {
+                          return f.then([this,
+                                         seq,
+                                         correlation,
+                                         breakdown,
+                                         dispatched](response_ptr r) mutable {
+                              r->set_correlation(correlation);
+                              pending_response pending{
+                                .response = std::move(r),
+                                .breakdown = breakdown,
+                              };
+                              if (breakdown) {
+                                  pending.ready = clock_type::now();
+                                  breakdown->record(
+                                    request_stage::handler,
+                                    pending.ready - dispatched);
+                              }
+                              _responses.insert({seq, std::move(pending)});
+                              return process_next_response();
+                          });
                       })
                       .handle_exception([self](std::exception_ptr e) {
                           vlog(
@@ -321,31 +409,57 @@ connection_context::dispatch_method_once(request_header hdr, size_t size) {
     });
 }
 
+// responses ready in sequence are written together up to this many bytes.
+// a single syscall, and when tls is enabled fewer and larger records, for a
+// pipelined burst of small responses
+static constexpr size_t max_coalesced_response_bytes = 128_KiB;
+
 ss::future<> connection_context::process_next_response() {
     return ss::repeat([this]() mutable {
-        auto it = _responses.find(_next_response);
-        if (it == _responses.end()) {
-            return ss::make_ready_future<ss::stop_iteration>(
-              ss::stop_iteration::yes);
-        }
-        // found one; increment counter
-        _next_response = _next_response + sequence_id(1);
+        std::vector<response_ptr> responses;
+        std::vector<pending_response> written;
+        size_t bytes = 0;
+        while (bytes < max_coalesced_response_bytes) {
+            auto it = _responses.find(_next_response);
+            if (it == _responses.end()) {
+                break;
+            }
+            // found one; increment counter
+            _next_response = _next_response + sequence_id(1);
 
-        auto r = std::move(it->second);
-        _responses.erase(it);
+            auto pending = std::move(it->second);
+            _responses.erase(it);
 
-        if (r->is_noop()) {
+            if (pending.response->is_noop()) {
+                continue;
+            }
+            bytes += pending.response->buf().size_bytes();
+            responses.push_back(std::move(pending.response));
+            written.push_back(std::move(pending));
+        }
+        if (responses.empty()) {
             return ss::make_ready_future<ss::stop_iteration>(
-              ss::stop_iteration::no);
+              ss::stop_iteration::yes);
         }
 
-        auto msg = response_as_scattered(std::move(r));
+        auto msg = responses.size() == 1
+                     ? response_as_scattered(std::move(responses.front()))
+                     : responses_as_scattered(std::move(responses));
         _rs.probe().add_bytes_sent(msg.size());
+        _cost.bytes += msg.size();
         try {
-            return _rs.conn->write(std::move(msg)).then([] {
-                return ss::make_ready_future<ss::stop_iteration>(
-                  ss::stop_iteration::no);
-            });
+            return _rs.conn->write(std::move(msg))
+              .then([written = std::move(written)] {
+                  const auto now = clock_type::now();
+                  for (const auto& w : written) {
+                      if (w.breakdown) {
+                          w.breakdown->record(
+                            request_stage::response_write, now - w.ready);
+                      }
+                  }
+                  return ss::make_ready_future<ss::stop_iteration>(
+                    ss::stop_iteration::no);
+              });
         } catch (...) {
             vlog(
               klog.debug,
@@ -9,6 +9,7 @@
  * by the Apache License, Version 2.0
  */
 #pragma once
+#include "config/configuration.h"
 #include "kafka/server/protocol.h"
 #include "kafka/server/response.h"
 #include "rpc/server.h"
@@ -26,6 +27,7 @@
 #include <absl/container/flat_hash_map.h>
 
 #include <memory>
+#include <optional>
 
 namespace kafka {
 
@@ -44,11 +46,15 @@ public:
       , _rs(std::move(r))
       , _sasl(std::move(sasl))
       // tests may build a context without a live connection
+      , _inflight_requests(
+          config::shard_local_cfg().kafka_max_inflight_requests_per_connection())
       , _client_addr(_rs.conn ? _rs.conn->addr.addr() : ss::net::inet_address{})
       , _enable_authorizer(enable_authorizer)
-      , _authlog(_client_addr, client_port()) {}
+      , _authlog(_client_addr, client_port()) {
+        _proto.connection_load().add(&_cost);
+    }
 
-    ~connection_context() noexcept = default;
+    ~connection_context() noexcept { _proto.connection_load().remove(&_cost); }
     connection_context(const connection_context&) = delete;
     connection_context(connection_context&&) = delete;
     connection_context& operator=(const connection_context&) = delete;
@@ -88,6 +94,12 @@ public:
 
     ss::future<> process_one_request();
     bool is_finished_parsing() const;
+
+    /// delays the requests read from the connection during the next `d`,
+    /// throttled responses are sent right away
+    void delay_requests(ss::lowres_clock::duration d) {
+        _delayed_until = std::max(_delayed_until, ss::lowres_clock::now() + d);
+    }
     ss::net::inet_address client_host() const { return _client_addr; }
     uint16_t client_port() const {
         return _rs.conn ? _rs.conn->addr.port() : 0;
@@ -116,8 +128,11 @@ private:
         ss::lowres_clock::duration backpressure_delay;
         ss::semaphore_units<> memlocks;
         ss::semaphore_units<> queue_units;
+        ss::semaphore_units<> inflight_units;
         std::unique_ptr<hdr_hist::measurement> method_latency;
         std::unique_ptr<request_tracker> tracker;
+        latency_breakdown_probe::stages* breakdown{nullptr};
+        std::optional<adaptive_concurrency_limit::permit> concurrency_permit;
     };
 
     /// called by throttle_request
@@ -135,7 +150,14 @@ private:
 
 private:
     using sequence_id = named_type<uint64_t, struct kafka_protocol_sequence>;
-    using map_t = absl::flat_hash_map<sequence_id, response_ptr>;
+    using clock_type = latency_breakdown_probe::clock_type;
+
+    struct pending_response {
+        response_ptr response;
+        latency_breakdown_probe::stages* breakdown{nullptr};
+        clock_type::time_point ready;
+    };
+    using map_t = absl::flat_hash_map<sequence_id, pending_response>;
 
     class ctx_log {
     public:
@@ -192,10 +214,15 @@ private:
     sequence_id _next_response;
     sequence_id _seq_idx;
     map_t _responses;
+    // bounds the requests of the connection that are processed concurrently
+    ss::semaphore _inflight_requests;
+    ss::lowres_clock::time_point _delayed_until;
     security::sasl_server _sasl;
     const ss::net::inet_address _client_addr;
     const bool _enable_authorizer;
     ctx_log _authlog;
+    // registered in the connection load probe of the shard
+    connection_cost _cost;
 };
 
 } // namespace kafka
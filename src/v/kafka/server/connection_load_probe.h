@@ -0,0 +1,102 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "config/configuration.h"
+#include "prometheus/prometheus_sanitize.h"
+
+#include <seastar/core/metrics.hh>
+
+#include <absl/container/flat_hash_set.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace kafka {
+
+/// bytes read and written by a connection, its cost for the shard serving it
+struct connection_cost {
+    uint64_t bytes{0};
+    uint64_t requests{0};
+};
+
+/// \brief cost of the kafka connections served by the shard.
+///
+/// Connections are placed on shards by the number of connections of each
+/// shard when they are accepted, a few heavy clients can saturate a core
+/// while the others idle. The probe exposes the cost of the live connections
+/// of the shard, and of the heaviest of them, to spot that imbalance.
+class connection_load_probe {
+public:
+    void setup_metrics() {
+        namespace sm = ss::metrics;
+
+        if (config::shard_local_cfg().disable_metrics()) {
+            return;
+        }
+        _metrics.add_group(
+          prometheus_sanitize::metrics_name("kafka:connections"),
+          {sm::make_gauge(
+             "active",
+             [this] { return _connections.size(); },
+             sm::description("Number of live kafka connections of the shard")),
+           sm::make_derive(
+             "bytes",
+             [this] { return _closed_bytes + live_bytes(); },
+             sm::description(
+               "Bytes read and written by the kafka connections of the "
+               "shard")),
+           sm::make_gauge(
+             "heaviest_bytes",
+             [this] { return heaviest().bytes; },
+             sm::description(
+               "Bytes read and written by the heaviest live kafka "
+               "connection of the shard")),
+           sm::make_gauge(
+             "heaviest_requests",
+             [this] { return heaviest().requests; },
+             sm::description(
+               "Requests of the heaviest live kafka connection of the "
+               "shard"))});
+    }
+
+    void add(const connection_cost* c) { _connections.insert(c); }
+    void remove(const connection_cost* c) {
+        _closed_bytes += c->bytes;
+        _connections.erase(c);
+    }
+
+    uint64_t live_bytes() const {
+        uint64_t ret = 0;
+        for (auto c : _connections) {
+            ret += c->bytes;
+        }
+        return ret;
+    }
+
+    connection_cost heaviest() const {
+        connection_cost ret;
+        for (auto c : _connections) {
+            if (c->bytes > ret.bytes) {
+                ret = *c;
+            }
+        }
+        return ret;
+    }
+
+private:
+    absl::flat_hash_set<const connection_cost*> _connections;
+    uint64_t _closed_bytes{0};
+    ss::metrics::metric_groups _metrics;
+};
+
+} // namespace kafka
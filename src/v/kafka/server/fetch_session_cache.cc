@@ -9,6 +9,7 @@
 #include "prometheus/prometheus_sanitize.h"
 
 #include <chrono>
+#include <tuple>
 
 namespace kafka {
 
@@ -50,11 +51,12 @@ void update_fetch_session(fetch_session& session, const fetch_request& req) {
 }
 
 fetch_session_cache::fetch_session_cache(
-  std::chrono::milliseconds eviction_timeout)
+  std::chrono::milliseconds eviction_timeout, size_t max_mem_usage)
   : _min_session_id(max_sessions_per_core() * seastar::this_shard_id())
   , _max_session_id(max_sessions_per_core() + _min_session_id - 1)
   , _last_session_id(_min_session_id)
-  , _session_eviction_duration(eviction_timeout) {
+  , _session_eviction_duration(eviction_timeout)
+  , _max_mem_usage(max_mem_usage) {
     register_metrics();
     _session_eviction_timer.set_callback([this] {
         gc_sessions();
@@ -76,8 +78,7 @@ fetch_session_cache::maybe_get_session(const fetch_request& req) {
         if (session_id != invalid_fetch_session_id) {
             if (auto it = _sessions.find(session_id); it != _sessions.end()) {
                 vlog(klog.info, "removing fetch session {}", session_id);
-                _sessions_mem_usage -= it->second->mem_usage();
-                _sessions.erase(it);
+                erase(it);
             }
         }
         if (epoch == final_fetch_session_epoch) {
@@ -86,7 +87,11 @@ fetch_session_cache::maybe_get_session(const fetch_request& req) {
             return fetch_session_ctx{};
         }
         // create new session
-        auto new_id = new_session_id();
+        size_t partitions = 0;
+        for (const auto& t : req.data.topics) {
+            partitions += t.fetch_partitions.size();
+        }
+        auto new_id = new_session_id(partitions);
         if (!new_id) {
             // if we weren't able to create a session return sessionless
             // context
@@ -143,11 +148,14 @@ fetch_session_cache::maybe_get_session(const fetch_request& req) {
 }
 
 // we split whole range from 1 to max int32_t betewen all shards
-std::optional<fetch_session_id> fetch_session_cache::new_session_id() {
+std::optional<fetch_session_id>
+fetch_session_cache::new_session_id(size_t partitions) {
     if (unlikely(
-          mem_usage() > max_mem_usage
+          mem_usage() > _max_mem_usage
           || _sessions.size() > max_sessions_per_core())) {
-        return std::nullopt;
+        if (!try_evict_for(partitions)) {
+            return std::nullopt;
+        }
     }
 
     if (_last_session_id >= _max_session_id) {
@@ -160,6 +168,56 @@ std::optional<fetch_session_id> fetch_session_cache::new_session_id() {
     return _last_session_id;
 }
 
+bool fetch_session_cache::try_evict_for(size_t partitions) {
+    auto now = model::timeout_clock::now();
+    auto is_expired = [this, now](const fetch_session& s) {
+        return now - s._last_used >= _session_eviction_duration;
+    };
+    // expired sessions first, then the ones with the fewest partitions, the
+    // least recently used of them
+    auto eviction_order = [&is_expired](
+                            const fetch_session& l, const fetch_session& r) {
+        return std::make_tuple(
+                 !is_expired(l), l.partitions().size(), l._last_used)
+               < std::make_tuple(
+                 !is_expired(r), r.partitions().size(), r._last_used);
+    };
+
+    auto candidate = _sessions.end();
+    for (auto it = _sessions.begin(); it != _sessions.end(); ++it) {
+        if (it->second->is_locked()) {
+            continue;
+        }
+        if (
+          candidate == _sessions.end()
+          || eviction_order(*it->second, *candidate->second)) {
+            candidate = it;
+        }
+    }
+    if (candidate == _sessions.end()) {
+        return false;
+    }
+    auto& session = *candidate->second;
+    if (!is_expired(session) && session.partitions().size() >= partitions) {
+        return false;
+    }
+    vlog(
+      klog.debug,
+      "evicting session {} with {} partitions to make room for a session "
+      "with {} partitions",
+      session.id(),
+      session.partitions().size(),
+      partitions);
+    ++_evictions;
+    erase(candidate);
+    return true;
+}
+
+void fetch_session_cache::erase(underlying_t::iterator it) {
+    _sessions_mem_usage -= it->second->mem_usage();
+    _sessions.erase(it);
+}
+
 void fetch_session_cache::gc_sessions() {
     auto now = model::timeout_clock::now();
     for (auto it = _sessions.cbegin(); it != _sessions.cend();) {
@@ -192,7 +250,12 @@ void fetch_session_cache::register_metrics() {
        sm::make_gauge(
          "sessions_count",
          [this] { return _sessions.size(); },
-         sm::description("Total number of fetch sessions"))});
+         sm::description("Total number of fetch sessions")),
+       sm::make_derive(
+         "evictions",
+         [this] { return _evictions; },
+         sm::description(
+           "Number of fetch sessions evicted to make room for new ones"))});
 }
 
 } // namespace kafka
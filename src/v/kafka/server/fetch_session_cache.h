@@ -29,12 +29,18 @@ struct fetch_request;
  * for the node (non overlapping ranges of ids are assigned to each core).
  *
  * The cache evicts not used sessions after configurable period of inactivity.
- * Fetch session cache will stop adding new sessions after its max memory usage
- * is reached.
+ * When its max memory usage is reached a new session replaces the least
+ * valuable session that is not in use (KIP-227): a session inactive for the
+ * eviction period or, failing that, a session with fewer partitions than the
+ * new one. Big and active sessions are kept, when there is no session to
+ * replace the new fetch is served without a session.
  **/
 class fetch_session_cache {
 public:
-    explicit fetch_session_cache(std::chrono::milliseconds);
+    static constexpr size_t default_max_mem_usage = 10_MiB;
+
+    explicit fetch_session_cache(
+      std::chrono::milliseconds, size_t max_mem_usage = default_max_mem_usage);
     fetch_session_ctx maybe_get_session(const fetch_request& req);
     size_t size() const { return _sessions.size(); }
 
@@ -42,8 +48,6 @@ private:
     using underlying_t
       = absl::flat_hash_map<fetch_session_id, fetch_session_ptr>;
 
-    static constexpr size_t max_mem_usage = 10_MiB;
-
     // used to split range of possible session ids to limit memory size we use
     // max_mem_used, this is theoretical limit, the actual number of session
     // held in a cache on single core is limitted by the memory usage.
@@ -53,7 +57,11 @@ private:
         return v;
     }
 
-    std::optional<fetch_session_id> new_session_id();
+    std::optional<fetch_session_id> new_session_id(size_t partitions);
+    /// evicts a session to make room for a new one with given number of
+    /// partitions, returns false if there is no session to evict
+    bool try_evict_for(size_t partitions);
+    void erase(underlying_t::iterator);
     void gc_sessions();
 
     size_t mem_usage() const {
@@ -73,7 +81,9 @@ private:
     // going to be evicted
     std::chrono::milliseconds _session_eviction_duration;
 
+    size_t _max_mem_usage;
     size_t _sessions_mem_usage = 0;
+    uint64_t _evictions = 0;
 
     ss::metrics::metric_groups _metrics;
 };
@@ -200,6 +200,10 @@ void group::add_member_no_join(member_ptr member) {
           fmt::format("group already contains member {}", member));
     }
 
+    if (member->group_instance_id()) {
+        _static_members[*member->group_instance_id()] = member->id();
+    }
+
     for (auto& p : member->protocols()) {
         _supported_protocols[p.name]++;
     }
@@ -495,6 +499,17 @@ group::join_group_unknown_member(join_group_request&& r) {
 
     auto new_member_id = group::generate_member_id(r);
 
+    if (r.data.group_instance_id) {
+        if (auto old_member_id = get_static_member_id(
+              *r.data.group_instance_id);
+            old_member_id) {
+            return update_static_member_and_rebalance(
+              std::move(*old_member_id),
+              std::move(new_member_id),
+              std::move(r));
+        }
+    }
+
     // <kafka>Only return MEMBER_ID_REQUIRED error if joinGroupRequest version
     // is >= 4 and groupInstanceId is configured to unknown.</kafka>
     if (r.version >= api_version(4) && !r.data.group_instance_id) {
@@ -528,6 +543,16 @@ group::join_group_known_member(join_group_request&& r) {
         return make_join_error(
           r.data.member_id, error_code::inconsistent_group_protocol);
 
+    } else if (is_static_member_fenced(
+                 r.data.member_id, r.data.group_instance_id)) {
+        vlog(
+          _ctxlog.trace,
+          "Join rejected for fenced static member {} instance {}",
+          r.data.member_id,
+          r.data.group_instance_id);
+        return make_join_error(
+          r.data.member_id, error_code::fenced_instance_id);
+
     } else if (contains_pending_member(r.data.member_id)) {
         kafka::member_id new_member_id = std::move(r.data.member_id);
         return add_member_and_rebalance(std::move(new_member_id), std::move(r));
@@ -697,6 +722,120 @@ group::update_member_and_rebalance(member_ptr member, join_group_request&& r) {
     return response;
 }
 
+ss::future<join_group_response> group::update_static_member_and_rebalance(
+  kafka::member_id old_member_id,
+  kafka::member_id new_member_id,
+  join_group_request&& r) {
+    // <kafka>We want to avoid current leader performing trivial assignment
+    // while the group is in stable stage, because the new assignment in
+    // leader's next sync call won't be broadcast by a stable group. This could
+    // be guaranteed by always returning the old leader id so that the current
+    // leader won't assume itself as a leader based on the returned message,
+    // since the new member.id won't match returned leader id, therefore no
+    // assignment will be performed.</kafka>
+    auto current_leader = leader().value_or(member_id(""));
+    auto member = replace_static_member(
+      *r.data.group_instance_id, old_member_id, new_member_id);
+    schedule_next_heartbeat_expiration(member);
+
+    vlog(
+      _ctxlog.trace,
+      "Static member {} rejoined with new member id {} replacing {}",
+      r.data.group_instance_id,
+      new_member_id,
+      old_member_id);
+
+    switch (state()) {
+    case group_state::stable:
+        if (r.data.protocols == member->protocols()) {
+            break;
+        }
+        [[fallthrough]];
+    case group_state::preparing_rebalance:
+        [[fallthrough]];
+    case group_state::completing_rebalance:
+        return update_member_and_rebalance(member, std::move(r));
+
+    case group_state::empty:
+        [[fallthrough]];
+    case group_state::dead:
+        return make_join_error(no_member, error_code::unknown_member_id);
+    }
+
+    /*
+     * the metadata of the member did not change. persist the group so the new
+     * member id is recovered on failover and return the current generation,
+     * the member keeps its assignment and rejoins through sync group.
+     */
+    assignments_type assignments;
+    for (const auto& [id, m] : _members) {
+        assignments.emplace(id, m->assignment());
+    }
+    auto batch = checkpoint(assignments);
+    auto reader = model::make_memory_record_batch_reader(std::move(batch));
+
+    return _partition
+      ->replicate(
+        std::move(reader),
+        raft::replicate_options(raft::consistency_level::quorum_ack))
+      .then([this,
+             new_member_id = std::move(new_member_id),
+             current_leader = std::move(current_leader)](
+              result<raft::replicate_result> r) mutable {
+          if (!r) {
+              vlog(
+                _ctxlog.trace,
+                "An error occurred persisting static member {}: {}",
+                new_member_id,
+                r.error());
+              return _make_join_error(
+                std::move(new_member_id), error_code::not_coordinator);
+          }
+          return join_group_response(
+            error_code::none,
+            generation(),
+            protocol().value_or(protocol_name("")),
+            std::move(current_leader),
+            std::move(new_member_id));
+      });
+}
+
+member_ptr group::replace_static_member(
+  const kafka::group_instance_id& instance_id,
+  const kafka::member_id& old_member_id,
+  const kafka::member_id& new_member_id) {
+    auto it = _members.find(old_member_id);
+    vassert(
+      it != _members.end(),
+      "static member {} of instance {} is not a member of {}",
+      old_member_id,
+      instance_id,
+      *this);
+    auto old_member = it->second;
+    _members.erase(it);
+
+    // <kafka>Fence potential duplicate member immediately if someone awaits
+    // join/sync callback.</kafka>
+    try_finish_joining_member(
+      old_member,
+      _make_join_error(old_member_id, error_code::fenced_instance_id));
+    if (old_member->is_syncing()) {
+        old_member->set_sync_response(
+          sync_group_response(error_code::fenced_instance_id));
+    }
+    old_member->expire_timer().cancel();
+
+    auto state = old_member->state().copy();
+    state.id = new_member_id;
+    auto member = ss::make_lw_shared<group_member>(std::move(state), id());
+    _members.emplace(new_member_id, member);
+    _static_members[instance_id] = new_member_id;
+    if (is_leader(old_member_id)) {
+        _leader = new_member_id;
+    }
+    return member;
+}
+
 void group::try_prepare_rebalance() {
     if (!valid_previous_state(group_state::preparing_rebalance)) {
         vlog(_ctxlog.trace, "Cannot prepare rebalance in state {}", _state);
@@ -977,6 +1116,13 @@ void group::remove_member(member_ptr member) {
     try_finish_joining_member(
       member, _make_join_error(no_member, error_code::unknown_member_id));
 
+    if (member->group_instance_id()) {
+        auto it = _static_members.find(*member->group_instance_id());
+        if (it != _static_members.end() && it->second == member->id()) {
+            _static_members.erase(it);
+        }
+    }
+
     // TODO: (not blocker) avoid the double look-up. we could do the removal
     // from the index in the caller and then pass in the shared_ptr.
     auto it = _members.find(member->id());
@@ -1046,6 +1192,14 @@ group::handle_sync_group(sync_group_request&& r) {
         vlog(_ctxlog.trace, "Sync rejected for group state {}", _state);
         return make_sync_error(error_code::coordinator_not_available);
 
+    } else if (is_static_member_fenced(
+                 r.data.member_id, r.data.group_instance_id)) {
+        vlog(
+          _ctxlog.trace,
+          "Sync rejected for fenced static member {}",
+          r.data.member_id);
+        return make_sync_error(error_code::fenced_instance_id);
+
     } else if (!contains_member(r.data.member_id)) {
         vlog(
           _ctxlog.trace,
@@ -1229,6 +1383,14 @@ ss::future<heartbeat_response> group::handle_heartbeat(heartbeat_request&& r) {
         vlog(_ctxlog.trace, "Heartbeat rejected for group state {}", _state);
         return make_heartbeat_error(error_code::coordinator_not_available);
 
+    } else if (is_static_member_fenced(
+                 r.data.member_id, r.data.group_instance_id)) {
+        vlog(
+          _ctxlog.trace,
+          "Heartbeat rejected for fenced static member {}",
+          r.data.member_id);
+        return make_heartbeat_error(error_code::fenced_instance_id);
+
     } else if (!contains_member(r.data.member_id)) {
         vlog(
           _ctxlog.trace,
@@ -1282,25 +1444,66 @@ group::handle_leave_group(leave_group_request&& r) {
         vlog(_ctxlog.trace, "Leave rejected for group state {}", _state);
         return make_leave_error(error_code::coordinator_not_available);
 
-    } else if (contains_pending_member(r.data.member_id)) {
+    } else if (r.version >= api_version(3)) {
+        // members leave in a batch, errors are reported per member
+        leave_group_response response(error_code::none);
+        response.data.members.reserve(r.data.members.size());
+        for (auto& m : r.data.members) {
+            auto error = leave_member(m.member_id, m.group_instance_id);
+            response.data.members.push_back(member_response{
+              .member_id = std::move(m.member_id),
+              .group_instance_id = std::move(m.group_instance_id),
+              .error_code = error,
+            });
+        }
+        return ss::make_ready_future<leave_group_response>(
+          std::move(response));
+
+    } else {
+        return make_leave_error(leave_member(r.data.member_id, std::nullopt));
+    }
+}
+
+error_code group::leave_member(
+  kafka::member_id member_id,
+  const std::optional<kafka::group_instance_id>& instance_id) {
+    if (instance_id) {
+        // static members may leave by their instance id only
+        auto static_member_id = get_static_member_id(*instance_id);
+        if (!static_member_id) {
+            vlog(
+              _ctxlog.trace,
+              "Leave rejected for unregistered instance {}",
+              instance_id);
+            return error_code::unknown_member_id;
+        }
+        if (member_id != unknown_member_id && member_id != *static_member_id) {
+            vlog(
+              _ctxlog.trace,
+              "Leave rejected for fenced static member {}",
+              member_id);
+            return error_code::fenced_instance_id;
+        }
+        member_id = std::move(*static_member_id);
+    }
+
+    if (contains_pending_member(member_id)) {
         // <kafka>if a pending member is leaving, it needs to be removed
         // from the pending list, heartbeat cancelled and if necessary,
         // prompt a JoinGroup completion.</kafka>
-        remove_pending_member(r.data.member_id);
-        return make_leave_error(error_code::none);
+        remove_pending_member(member_id);
+        return error_code::none;
 
-    } else if (!contains_member(r.data.member_id)) {
+    } else if (!contains_member(member_id)) {
         vlog(
-          _ctxlog.trace,
-          "Leave rejected for unregistered member {}",
-          r.data.member_id);
-        return make_leave_error(error_code::unknown_member_id);
+          _ctxlog.trace, "Leave rejected for unregistered member {}", member_id);
+        return error_code::unknown_member_id;
 
     } else {
-        auto member = get_member(r.data.member_id);
+        auto member = get_member(member_id);
         member->expire_timer().cancel();
         remove_member(member);
-        return make_leave_error(error_code::none);
+        return error_code::none;
     }
 }
 
@@ -1311,9 +1514,9 @@ void group::complete_offset_commit(
     if (p_it != _pending_offset_commits.end()) {
         // save the tp commit if it hasn't yet been seen, or we are completing
         // for an instance that is newer based on log offset
-        auto o_it = _offsets.find(tp);
-        if (o_it == _offsets.end() || o_it->second.log_offset < md.log_offset) {
-            _offsets[tp] = md;
+        auto current = _offsets.find(tp);
+        if (!current || current->log_offset < md.log_offset) {
+            _offsets.insert_or_assign(tp, md);
         }
 
         // clear pending for this tp
@@ -1418,9 +1621,9 @@ group::commit_tx(cluster::commit_group_tx_request r) {
     }
 
     for (const auto& [tp, md] : prepare_it->second.offsets) {
-        auto o_it = _offsets.find(tp);
-        if (o_it == _offsets.end() || o_it->second.log_offset < md.log_offset) {
-            _offsets[tp] = md;
+        auto current = _offsets.find(tp);
+        if (!current || current->log_offset < md.log_offset) {
+            _offsets.insert_or_assign(tp, md);
         }
     }
 
@@ -1921,6 +2124,11 @@ group::handle_offset_commit(offset_commit_request&& r) {
         // <kafka>The group is only using Kafka to store offsets.</kafka>
         return store_offsets(std::move(r));
 
+    } else if (is_static_member_fenced(
+                 r.data.member_id, r.data.group_instance_id)) {
+        return offset_commit_stages(
+          offset_commit_response(r, error_code::fenced_instance_id));
+
     } else if (!contains_member(r.data.member_id)) {
         return offset_commit_stages(
           offset_commit_response(r, error_code::unknown_member_id));
@@ -1960,24 +2168,21 @@ group::handle_offset_fetch(offset_fetch_request&& r) {
 
     // retrieve all topics available
     if (!r.data.topics) {
-        absl::flat_hash_map<
-          model::topic,
-          std::vector<offset_fetch_response_partition>>
-          tmp;
-        for (const auto& e : _offsets) {
-            offset_fetch_response_partition p = {
-              .partition_index = e.first.partition,
-              .committed_offset = e.second.offset,
-              .metadata = e.second.metadata,
-              .error_code = error_code::none,
-            };
-            // BUG: support leader_epoch (KIP-320)
-            // https://github.com/vectorizedio/redpanda/issues/1181
-            tmp[e.first.topic].push_back(std::move(p));
-        }
-        for (auto& e : tmp) {
-            resp.data.topics.push_back(
-              {.name = e.first, .partitions = std::move(e.second)});
+        resp.data.topics.reserve(_offsets.topics().size());
+        for (const auto& [topic, partitions] : _offsets.topics()) {
+            auto& t = resp.data.topics.emplace_back();
+            t.name = topic;
+            t.partitions.reserve(partitions.size());
+            for (const auto& [id, md] : partitions) {
+                // BUG: support leader_epoch (KIP-320)
+                // https://github.com/vectorizedio/redpanda/issues/1181
+                t.partitions.push_back(offset_fetch_response_partition{
+                  .partition_index = id,
+                  .committed_offset = md.offset,
+                  .metadata = md.metadata,
+                  .error_code = error_code::none,
+                });
+            }
         }
 
         return ss::make_ready_future<offset_fetch_response>(std::move(resp));
@@ -2064,17 +2269,20 @@ ss::future<error_code> group::remove() {
     storage::record_batch_builder builder(
       model::record_batch_type::raft_data, model::offset(0));
 
-    for (auto& offset : _offsets) {
-        group_log_record_key key{
-          .record_type = group_log_record_key::type::offset_commit,
-          .key = reflection::to_iobuf(group_log_offset_key{
-            _id,
-            offset.first.topic,
-            offset.first.partition,
-          }),
-        };
+    for (const auto& [topic, partitions] : _offsets.topics()) {
+        for (const auto& [id, _] : partitions) {
+            group_log_record_key key{
+              .record_type = group_log_record_key::type::offset_commit,
+              .key = reflection::to_iobuf(group_log_offset_key{
+                _id,
+                topic,
+                id,
+              }),
+            };
 
-        builder.add_raw_kv(reflection::to_iobuf(std::move(key)), std::nullopt);
+            builder.add_raw_kv(
+              reflection::to_iobuf(std::move(key)), std::nullopt);
+        }
     }
 
     // build group tombstone
@@ -2124,8 +2332,7 @@ group::remove_topic_partitions(const std::vector<model::topic_partition>& tps) {
     for (const auto& tp : tps) {
         _pending_offset_commits.erase(tp);
         if (auto offset = _offsets.extract(tp); offset) {
-            removed.emplace_back(
-              std::move(offset.key()), std::move(offset.mapped()));
+            removed.emplace_back(tp, std::move(*offset));
         }
     }
 
@@ -2146,7 +2353,7 @@ group::remove_topic_partitions(const std::vector<model::topic_partition>& tps) {
         co_return;
     }
 
-    _offsets.rehash(0);
+    _offsets.shrink_to_fit();
     _pending_offset_commits.rehash(0);
 
     // build offset tombstones
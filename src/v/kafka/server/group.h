@@ -15,6 +15,7 @@
 #include "cluster/tx_utils.h"
 #include "kafka/protocol/fwd.h"
 #include "kafka/protocol/offset_commit.h"
+#include "kafka/server/group_offsets.h"
 #include "kafka/server/logger.h"
 #include "kafka/server/member.h"
 #include "kafka/types.h"
@@ -190,6 +191,33 @@ public:
         return _members.find(member_id) != _members.end();
     }
 
+    /// Get the member id registered for a static group instance id.
+    std::optional<kafka::member_id>
+    get_static_member_id(const kafka::group_instance_id& instance_id) const {
+        auto it = _static_members.find(instance_id);
+        if (it == _static_members.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * \brief Check if a static member request uses an outdated member id.
+     *
+     * A static member rejoining with an unknown member id takes over the
+     * membership of its group instance id under a new member id. Requests
+     * still using the previous member id are fenced.
+     */
+    bool is_static_member_fenced(
+      const kafka::member_id& member_id,
+      const std::optional<kafka::group_instance_id>& instance_id) const {
+        if (!instance_id) {
+            return false;
+        }
+        auto registered = get_static_member_id(*instance_id);
+        return registered && *registered != member_id;
+    }
+
     /// Check if the group has members.
     bool has_members() const { return !_members.empty(); }
 
@@ -378,6 +406,25 @@ public:
     ss::future<join_group_response> update_member_and_rebalance(
       member_ptr member, join_group_request&& request);
 
+    /**
+     * \brief Handle the join of a static member with an unknown member id.
+     *
+     * The member takes over the membership of its group instance id under a
+     * new member id. A stable group is not rebalanced unless the member's
+     * protocols changed, so restarting a static member keeps the assignments
+     * of the group.
+     */
+    ss::future<join_group_response> update_static_member_and_rebalance(
+      kafka::member_id old_member_id,
+      kafka::member_id new_member_id,
+      join_group_request&& request);
+
+    /// Move a static member to a new member id, fencing the old member id.
+    member_ptr replace_static_member(
+      const kafka::group_instance_id& instance_id,
+      const kafka::member_id& old_member_id,
+      const kafka::member_id& new_member_id);
+
     /// Transition to preparing rebalance if possible.
     void try_prepare_rebalance();
 
@@ -415,10 +462,20 @@ public:
     ss::future<leave_group_response>
     handle_leave_group(leave_group_request&& r);
 
+    /**
+     * \brief Remove a leaving member.
+     *
+     * A static member is identified by its instance id, the member id may be
+     * unknown in that case.
+     */
+    error_code leave_member(
+      kafka::member_id member_id,
+      const std::optional<kafka::group_instance_id>& instance_id);
+
     std::optional<offset_metadata>
     offset(const model::topic_partition& tp) const {
-        if (auto it = _offsets.find(tp); it != _offsets.end()) {
-            return it->second;
+        if (auto md = _offsets.find(tp); md) {
+            return *md;
         }
         return std::nullopt;
     }
@@ -469,13 +526,13 @@ public:
     handle_offset_fetch(offset_fetch_request&& r);
 
     void insert_offset(model::topic_partition tp, offset_metadata md) {
-        _offsets[std::move(tp)] = std::move(md);
+        _offsets.insert_or_assign(tp, std::move(md));
     }
 
     bool try_upsert_offset(model::topic_partition tp, offset_metadata md) {
-        auto [o_it, inserted] = _offsets.try_emplace(tp, std::move(md));
-        if (!inserted && o_it->second.log_offset < md.log_offset) {
-            o_it->second = std::move(md);
+        auto [current, inserted] = _offsets.try_emplace(tp, md);
+        if (!inserted && current->log_offset < md.log_offset) {
+            *current = std::move(md);
             inserted = true;
         }
         return inserted;
@@ -560,6 +617,8 @@ private:
     kafka::generation_id _generation;
     protocol_support _supported_protocols;
     member_map _members;
+    absl::node_hash_map<kafka::group_instance_id, kafka::member_id>
+      _static_members;
     int _num_members_joining;
     absl::node_hash_set<kafka::member_id> _pending_members;
     std::optional<kafka::protocol_type> _protocol_type;
@@ -569,7 +628,7 @@ private:
     bool _new_member_added;
     config::configuration& _conf;
     ss::lw_shared_ptr<cluster::partition> _partition;
-    absl::node_hash_map<model::topic_partition, offset_metadata> _offsets;
+    group_offsets<offset_metadata> _offsets;
     model::violation_recovery_policy _recovery_policy;
     ctx_log _ctxlog;
 
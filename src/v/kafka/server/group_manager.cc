@@ -22,9 +22,11 @@
 #include "model/fundamental.h"
 #include "model/namespace.h"
 #include "model/record.h"
+#include "prometheus/prometheus_sanitize.h"
 #include "resource_mgmt/io_priority.h"
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
 
 namespace kafka {
 
@@ -37,7 +39,48 @@ group_manager::group_manager(
   , _pm(pm)
   , _topic_table(topic_table)
   , _conf(conf)
-  , _self(cluster::make_self_broker(config::shard_local_cfg())) {}
+  , _self(cluster::make_self_broker(config::shard_local_cfg())) {
+    register_metrics();
+}
+
+void group_manager::register_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+
+    namespace sm = ss::metrics;
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("kafka:group_commits"),
+      {sm::make_derive(
+         "requests",
+         [this] { return _commit_stats.requests; },
+         sm::description("Number of offset commit requests handled")),
+       sm::make_derive(
+         "offsets",
+         [this] { return _commit_stats.offsets; },
+         sm::description("Number of partition offsets committed")),
+       sm::make_derive(
+         "failed_offsets",
+         [this] { return _commit_stats.failed_offsets; },
+         sm::description("Number of partition offsets that failed to commit")),
+       sm::make_gauge(
+         "in_flight",
+         [this] { return _commit_stats.in_flight; },
+         sm::description(
+           "Number of offset commit requests waiting for replication"))});
+}
+
+void group_manager::record_offset_commit(const offset_commit_response& resp) {
+    for (const auto& t : resp.data.topics) {
+        for (const auto& p : t.partitions) {
+            if (p.error_code == error_code::none) {
+                ++_commit_stats.offsets;
+            } else {
+                ++_commit_stats.failed_offsets;
+            }
+        }
+    }
+}
 
 ss::future<> group_manager::start() {
     /*
@@ -101,7 +144,11 @@ ss::future<> group_manager::stop() {
         e.second->as.request_abort();
     }
 
-    return _gate.close();
+    return _gate.close().then([this] {
+        return ss::parallel_for_each(_partitions, [](auto& e) {
+            return e.second->recovery_stm->stop();
+        });
+    });
 }
 
 void group_manager::detach_partition(const model::ntp& ntp) {
@@ -126,6 +173,11 @@ void group_manager::detach_partition(const model::ntp& ntp) {
         _groups.erase(it);
         _groups.rehash(0);
     }
+    if (auto it = _partitions.find(ntp); it != _partitions.end()) {
+        (void)ss::with_gate(_gate, [stm = it->second->recovery_stm] {
+            return stm->stop().finally([stm] {});
+        });
+    }
     _partitions.erase(ntp);
     _partitions.rehash(0);
 }
@@ -140,6 +192,15 @@ void group_manager::attach_partition(ss::lw_shared_ptr<cluster::partition> p) {
     vassert(
       res.second, "double registration of ntp in group manager {}", p->ntp());
     _partitions.rehash(0);
+    (void)ss::with_gate(_gate, [attached] {
+        return attached->recovery_stm->start();
+    }).handle_exception([ntp = p->ntp()](std::exception_ptr e) {
+        vlog(
+          klog.warn,
+          "failed to start group recovery state machine of {}: {}",
+          ntp,
+          e);
+    });
 }
 
 ss::future<> group_manager::cleanup_removed_topic_partitions(
@@ -298,44 +359,70 @@ ss::future<> group_manager::handle_partition_leader_change(
     return p->catchup_lock.hold_write_lock().then(
       [this, term, timeout, p](ss::basic_rwlock<>::holder unit) {
           return inject_noop(p->partition, timeout)
-            .then([this, term, timeout, p] {
+            .then([term, timeout, p] {
                 /*
-                 * the full log is read and deduplicated. the dedupe
-                 * processing is based on the record keys, so this code
-                 * should be ready to transparently take advantage of
-                 * key-based compaction in the future.
+                 * the recovery state machine applied the log up to the
+                 * barrier written above once it catches up with the commit
+                 * index, only the tail of the log not applied yet is read.
                  */
-                storage::log_reader_config reader_config(
-                  p->partition->start_offset(),
-                  model::model_limits<model::offset>::max(),
-                  0,
-                  std::numeric_limits<size_t>::max(),
-                  kafka_read_priority(),
-                  std::nullopt,
-                  std::nullopt,
-                  std::nullopt);
-
-                return p->partition->make_reader(reader_config)
-                  .then([this, term, p, timeout](
-                          model::record_batch_reader reader) {
-                      return std::move(reader)
-                        .consume(recovery_batch_consumer(p->as), timeout)
-                        .then([this, term, p](
-                                recovery_batch_consumer_state state) {
-                            // avoid trying to recover if we stopped the
-                            // reader because an abort was requested
-                            if (p->as.abort_requested()) {
-                                return ss::make_ready_future<>();
-                            }
-                            return recover_partition(term, p, std::move(state))
-                              .then([p] { p->loading = false; });
-                        });
-                  });
+                return p->recovery_stm->wait(
+                  p->partition->committed_offset(), timeout);
+            })
+            .then_wrapped([this, term, timeout, p](ss::future<> f) {
+                if (f.failed()) {
+                    vlog(
+                      klog.warn,
+                      "group recovery state machine of {} did not catch up, "
+                      "reading the log: {}",
+                      p->partition->ntp(),
+                      f.get_exception());
+                    return recover_partition_from_log(term, p, timeout);
+                }
+                if (p->as.abort_requested()) {
+                    return ss::make_ready_future<>();
+                }
+                return recover_partition(term, p, p->recovery_stm->state())
+                  .then([p] { p->loading = false; });
             })
             .finally([unit = std::move(unit)] {});
       });
 }
 
+ss::future<> group_manager::recover_partition_from_log(
+  model::term_id term,
+  ss::lw_shared_ptr<attached_partition> p,
+  ss::lowres_clock::time_point timeout) {
+    /*
+     * the full log is read and deduplicated. the dedupe processing is based
+     * on the record keys, so this code should be ready to transparently take
+     * advantage of key-based compaction in the future.
+     */
+    storage::log_reader_config reader_config(
+      p->partition->start_offset(),
+      model::model_limits<model::offset>::max(),
+      0,
+      std::numeric_limits<size_t>::max(),
+      kafka_read_priority(),
+      std::nullopt,
+      std::nullopt,
+      std::nullopt);
+
+    return p->partition->make_reader(reader_config)
+      .then([this, term, p, timeout](model::record_batch_reader reader) {
+          return std::move(reader)
+            .consume(recovery_batch_consumer(p->as), timeout)
+            .then([this, term, p](recovery_batch_consumer_state state) {
+                // avoid trying to recover if we stopped the reader because an
+                // abort was requested
+                if (p->as.abort_requested()) {
+                    return ss::make_ready_future<>();
+                }
+                return recover_partition(term, p, std::move(state))
+                  .then([p] { p->loading = false; });
+            });
+      });
+}
+
 /*
  * TODO: this routine can be improved from a copy vs move perspective, but is
  * rather complicated at the moment to start having to also analyze all the data
@@ -458,6 +545,32 @@ parse_tx_batch(const model::record_batch& batch, int8_t version) {
     return group_tx_cmd<T>{.pid = bid.pid, .cmd = std::move(cmd)};
 }
 
+group_recovery_stm::group_recovery_stm(raft::consensus* c)
+  : raft::state_machine(c, klog, kafka_read_priority())
+  , _c(c)
+  , _consumer(_consumer_as) {}
+
+ss::future<> group_recovery_stm::apply(model::record_batch b) {
+    auto offset = b.last_offset();
+    return _consumer(std::move(b))
+      .discard_result()
+      .handle_exception([this, offset](std::exception_ptr e) {
+          vlog(
+            klog.error,
+            "skipping group metadata batch ending at {} of {}: {}",
+            offset,
+            _c->ntp(),
+            e);
+      });
+}
+
+ss::future<> group_recovery_stm::handle_eviction() {
+    // the log is replayed from its new start offset
+    _consumer.st = {};
+    set_next(_c->start_offset());
+    return ss::now();
+}
+
 ss::future<ss::stop_iteration>
 recovery_batch_consumer::operator()(model::record_batch batch) {
     if (as.abort_requested()) {
@@ -667,11 +780,6 @@ group_manager::join_group(join_group_request&& r) {
 
 ss::future<sync_group_response>
 group_manager::sync_group(sync_group_request&& r) {
-    if (r.data.group_instance_id) {
-        vlog(klog.trace, "Static group membership is not supported");
-        return make_sync_error(error_code::unsupported_version);
-    }
-
     auto error = validate_group_status(
       r.ntp, r.data.group_id, sync_group_api::key);
     if (error != error_code::none) {
@@ -701,11 +809,6 @@ group_manager::sync_group(sync_group_request&& r) {
 }
 
 ss::future<heartbeat_response> group_manager::heartbeat(heartbeat_request&& r) {
-    if (r.data.group_instance_id) {
-        vlog(klog.trace, "Static group membership is not supported");
-        return make_heartbeat_error(error_code::unsupported_version);
-    }
-
     auto error = validate_group_status(
       r.ntp, r.data.group_id, heartbeat_api::key);
     if (error != error_code::none) {
@@ -937,6 +1040,7 @@ group_manager::abort_tx(cluster::abort_group_tx_request&& r) {
 
 group::offset_commit_stages
 group_manager::offset_commit(offset_commit_request&& r) {
+    ++_commit_stats.requests;
     auto error = validate_group_status(
       r.ntp, r.data.group_id, offset_commit_api::key);
     if (error != error_code::none) {
@@ -963,7 +1067,13 @@ group_manager::offset_commit(offset_commit_request&& r) {
     }
 
     auto stages = group->handle_offset_commit(std::move(r));
-    stages.committed = stages.committed.finally([group] {});
+    ++_commit_stats.in_flight;
+    stages.committed = stages.committed
+                         .then([this](offset_commit_response resp) {
+                             record_offset_commit(resp);
+                             return resp;
+                         })
+                         .finally([this, group] { --_commit_stats.in_flight; });
     return stages;
 }
 
@@ -27,11 +27,13 @@
 #include "kafka/server/member.h"
 #include "model/namespace.h"
 #include "raft/group_manager.h"
+#include "raft/state_machine.h"
 #include "seastarx.h"
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/metrics_registration.hh>
 #include <seastar/core/sharded.hh>
 
 #include <absl/container/node_hash_map.h>
@@ -39,7 +41,58 @@
 
 namespace kafka {
 
-struct recovery_batch_consumer_state;
+/*
+ * This batch consumer is used during partition recovery to read, index, and
+ * deduplicate both group and commit metadata snapshots.
+ */
+struct recovery_batch_consumer_state {
+    absl::node_hash_map<kafka::group_id, group_stm> groups;
+};
+
+struct recovery_batch_consumer {
+    explicit recovery_batch_consumer(ss::abort_source& as)
+      : as(as) {}
+
+    ss::future<ss::stop_iteration> operator()(model::record_batch batch);
+
+    ss::future<> handle_record(model::record);
+    ss::future<> handle_group_metadata(iobuf, std::optional<iobuf>);
+    ss::future<> handle_offset_metadata(iobuf, std::optional<iobuf>);
+
+    recovery_batch_consumer_state end_of_stream() { return std::move(st); }
+
+    recovery_batch_consumer_state st;
+    model::offset batch_base_offset;
+
+    ss::abort_source& as;
+};
+
+/**
+ * Follows the committed log of a group metadata partition on every replica,
+ * building the same state as reading the log during partition recovery does.
+ *
+ * When the local replica becomes the leader the partition is recovered from
+ * this state once the tail of the log, up to the barrier written by the new
+ * leader, was applied. Failover does not have to replay the whole log.
+ */
+class group_recovery_stm final : public raft::state_machine {
+public:
+    explicit group_recovery_stm(raft::consensus*);
+
+    ss::future<> apply(model::record_batch) final;
+
+    const recovery_batch_consumer_state& state() const {
+        return _consumer.st;
+    }
+
+private:
+    ss::future<> handle_eviction() final;
+
+    raft::consensus* _c;
+    // the consumer is never aborted, stopping the state machine stops it
+    ss::abort_source _consumer_as;
+    recovery_batch_consumer _consumer;
+};
 
 /*
  * \brief Manages the Kafka group lifecycle.
@@ -92,11 +145,15 @@ struct recovery_batch_consumer_state;
  * - Both recovery and partition unload are serialized per-partition
  * - Recovery occurs when the local node is leader, else unload (below)
  *
- * The recovery process reads the entire log and deduplicates entries into the
- * `recovery_batch_consumer` object.
+ * Every replica of an attached partition runs a `group_recovery_stm` which
+ * applies the committed log to a `recovery_batch_consumer`, deduplicating
+ * entries as they are committed. The recovery process waits for the state
+ * machine to apply the log up to the commit index, so only the tail of the
+ * log that was not applied yet is read. If the state machine does not catch up
+ * in time the entire log is read into a new `recovery_batch_consumer`.
  *
- * After the log is read the deduplicated state is used to re-populate the
- * in-memory cache of groups/commits through.
+ * The deduplicated state is then used to re-populate the in-memory cache of
+ * groups/commits.
  *
  * Unload (background)
  * ===================
@@ -193,10 +250,14 @@ private:
         ss::lw_shared_ptr<cluster::partition> partition;
         ss::basic_rwlock<> catchup_lock;
         model::term_id term{-1};
+        ss::lw_shared_ptr<group_recovery_stm> recovery_stm;
 
         explicit attached_partition(ss::lw_shared_ptr<cluster::partition> p)
           : loading(true)
-          , partition(std::move(p)) {}
+          , partition(std::move(p))
+          , recovery_stm(
+              ss::make_lw_shared<group_recovery_stm>(partition->raft().get())) {
+        }
     };
 
     cluster::notification_id_type _leader_notify_handle;
@@ -222,6 +283,11 @@ private:
       ss::lw_shared_ptr<attached_partition>,
       recovery_batch_consumer_state);
 
+    ss::future<> recover_partition_from_log(
+      model::term_id,
+      ss::lw_shared_ptr<attached_partition>,
+      ss::lowres_clock::time_point);
+
     ss::future<> gc_partition_state(ss::lw_shared_ptr<attached_partition>);
 
     ss::future<> inject_noop(
@@ -237,6 +303,11 @@ private:
         return it->second;
     }
 
+    void register_metrics();
+
+    /// \brief counts the committed offsets and failures of a commit
+    void record_offset_commit(const offset_commit_response&);
+
     ss::sharded<raft::group_manager>& _gm;
     ss::sharded<cluster::partition_manager>& _pm;
     ss::sharded<cluster::topic_table>& _topic_table;
@@ -247,6 +318,18 @@ private:
     //
 
     model::broker _self;
+
+    // offset commits are replicated with quorum acks, concurrent commits of
+    // the groups coordinated by the same partition are coalesced by the raft
+    // replicate batcher into a single append
+    struct offset_commit_stats {
+        uint64_t requests{0};
+        uint64_t offsets{0};
+        uint64_t failed_offsets{0};
+        size_t in_flight{0};
+    };
+    offset_commit_stats _commit_stats;
+    ss::metrics::metric_groups _metrics;
 };
 
 template<typename T>
@@ -272,32 +355,6 @@ struct group_log_record_key {
     iobuf key;
 };
 
-/*
- * This batch consumer is used during partition recovery to read, index, and
- * deduplicate both group and commit metadata snapshots.
- */
-struct recovery_batch_consumer_state {
-    absl::node_hash_map<kafka::group_id, group_stm> groups;
-};
-
-struct recovery_batch_consumer {
-    explicit recovery_batch_consumer(ss::abort_source& as)
-      : as(as) {}
-
-    ss::future<ss::stop_iteration> operator()(model::record_batch batch);
-
-    ss::future<> handle_record(model::record);
-    ss::future<> handle_group_metadata(iobuf, std::optional<iobuf>);
-    ss::future<> handle_offset_metadata(iobuf, std::optional<iobuf>);
-
-    recovery_batch_consumer_state end_of_stream() { return std::move(st); }
-
-    recovery_batch_consumer_state st;
-    model::offset batch_base_offset;
-
-    ss::abort_source& as;
-};
-
 } // namespace kafka
 
 namespace reflection {
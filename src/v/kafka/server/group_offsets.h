@@ -0,0 +1,124 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace kafka {
+
+/**
+ * Committed offsets of a group, keyed by topic partition.
+ *
+ * Consumer groups commit offsets for all the partitions of the topics they
+ * are subscribed to. Instead of a map node holding a copy of the topic name
+ * for every partition, the topic name is stored once and the partitions of a
+ * topic are kept in a vector sorted by partition id. Lookups are a binary
+ * search, retrieving all the offsets of a group is a linear scan.
+ */
+template<typename T>
+class group_offsets {
+public:
+    using partitions_t = std::vector<std::pair<model::partition_id, T>>;
+    using topics_t = absl::flat_hash_map<model::topic, partitions_t>;
+
+    const T* find(const model::topic_partition& tp) const {
+        auto t_it = _topics.find(tp.topic);
+        if (t_it == _topics.end()) {
+            return nullptr;
+        }
+        auto it = lower_bound(t_it->second, tp.partition);
+        if (it == t_it->second.end() || it->first != tp.partition) {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    /// inserts the value of a partition, returns the value in the table and
+    /// false if the partition was already present
+    std::pair<T*, bool> try_emplace(const model::topic_partition& tp, T v) {
+        auto& partitions = _topics[tp.topic];
+        // partitions are usually committed and recovered in order
+        if (partitions.empty() || partitions.back().first < tp.partition) {
+            partitions.emplace_back(tp.partition, std::move(v));
+            ++_size;
+            return {&partitions.back().second, true};
+        }
+        auto it = lower_bound(partitions, tp.partition);
+        if (it != partitions.end() && it->first == tp.partition) {
+            return {&it->second, false};
+        }
+        it = partitions.emplace(it, tp.partition, std::move(v));
+        ++_size;
+        return {&it->second, true};
+    }
+
+    void insert_or_assign(const model::topic_partition& tp, T v) {
+        auto [current, inserted] = try_emplace(tp, v);
+        if (!inserted) {
+            *current = std::move(v);
+        }
+    }
+
+    std::optional<T> extract(const model::topic_partition& tp) {
+        auto t_it = _topics.find(tp.topic);
+        if (t_it == _topics.end()) {
+            return std::nullopt;
+        }
+        auto& partitions = t_it->second;
+        auto it = lower_bound(partitions, tp.partition);
+        if (it == partitions.end() || it->first != tp.partition) {
+            return std::nullopt;
+        }
+        std::optional<T> ret(std::move(it->second));
+        partitions.erase(it);
+        --_size;
+        if (partitions.empty()) {
+            _topics.erase(t_it);
+        }
+        return ret;
+    }
+
+    /// partitions of every topic, sorted by partition id
+    const topics_t& topics() const { return _topics; }
+
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+
+    void shrink_to_fit() {
+        for (auto& [_, partitions] : _topics) {
+            partitions.shrink_to_fit();
+        }
+        _topics.rehash(0);
+    }
+
+private:
+    template<typename Partitions>
+    static auto lower_bound(Partitions& partitions, model::partition_id id) {
+        return std::lower_bound(
+          partitions.begin(),
+          partitions.end(),
+          id,
+          [](const auto& p, model::partition_id id) { return p.first < id; });
+    }
+
+    topics_t _topics;
+    size_t _size{0};
+};
+
+} // namespace kafka
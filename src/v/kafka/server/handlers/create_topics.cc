@@ -32,7 +32,7 @@
 
 namespace kafka {
 
-static constexpr std::array<std::string_view, 8> supported_configs{
+static constexpr std::array<std::string_view, 10> supported_configs{
   {"compression.type",
    "cleanup.policy",
    "message.timestamp.type",
@@ -40,7 +40,9 @@ static constexpr std::array<std::string_view, 8> supported_configs{
    "compaction.strategy",
    "retention.bytes",
    "retention.ms",
-   "x-redpanda-recovery"}};
+   "x-redpanda-recovery",
+   "x-redpanda-in-memory",
+   "x-redpanda-write-caching"}};
 
 bool is_supported(std::string_view name) {
     return std::any_of(
@@ -23,6 +23,9 @@
 
 #include <fmt/ostream.h>
 
+#include <algorithm>
+#include <iterator>
+
 namespace kafka {
 
 using partition_dir_set
@@ -82,11 +85,13 @@ static ss::future<partition_dir_set> collect(
           return collect_mapper(pm, filter);
       },
       partition_dir_set{},
-      [](partition_dir_set acc, const partition_dir_set& update) {
+      [](partition_dir_set acc, partition_dir_set update) {
           for (auto& topic : update) {
-              for (auto partition : topic.second) {
-                  acc[topic.first].push_back(partition);
-              }
+              auto& partitions = acc[topic.first];
+              std::move(
+                topic.second.begin(),
+                topic.second.end(),
+                std::back_inserter(partitions));
           }
           return acc;
       });
@@ -21,6 +21,7 @@
 #include "kafka/server/handlers/fetch/fetch_planner.h"
 #include "kafka/server/materialized_partition.h"
 #include "kafka/server/partition_proxy.h"
+#include "kafka/server/quota_manager.h"
 #include "kafka/server/replicated_partition.h"
 #include "likely.h"
 #include "model/fundamental.h"
@@ -32,7 +33,9 @@
 #include "storage/parser_utils.h"
 #include "utils/to_string.h"
 
+#include <seastar/core/abort_source.hh>
 #include <seastar/core/do_with.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/core/sleep.hh>
 #include <seastar/core/thread.hh>
 #include <seastar/util/log.hh>
@@ -40,7 +43,9 @@
 #include <boost/range/irange.hpp>
 #include <fmt/ostream.h>
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <string_view>
 
 namespace kafka {
@@ -133,8 +138,12 @@ static ss::future<read_result> read_from_partition(
     auto hw = part.high_watermark();
     auto lso = part.last_stable_offset();
     auto start_o = part.start_offset();
-    // if we have no data read, return fast
-    if (hw < config.start_offset || config.skip_read) {
+    // if we have no data read, return fast. It is the common case of idle
+    // partitions of incremental fetch sessions, consumers caught up with the
+    // high watermark do not need a reader to learn that nothing is new.
+    if (
+      hw <= config.start_offset || config.start_offset > config.max_offset
+      || config.skip_read) {
         co_return read_result(start_o, hw, lso);
     }
 
@@ -172,6 +181,42 @@ static ss::future<read_result> read_from_partition(
       std::move(data), start_o, hw, lso, std::move(aborted_transactions));
 }
 
+/**
+ * Rack aware replica selection (KIP-392). A consumer that is not located in
+ * the leader rack is pointed to an in-sync follower from its own rack, if
+ * there is any.
+ */
+static std::optional<model::node_id> select_preferred_replica(
+  cluster::partition& partition,
+  const cluster::metadata_cache& md_cache,
+  const ss::sstring& consumer_rack) {
+    auto in_consumer_rack = [&md_cache, &consumer_rack](model::node_id id) {
+        auto broker = md_cache.get_broker(id);
+        return broker && (*broker)->rack() == consumer_rack;
+    };
+    if (in_consumer_rack(config::shard_local_cfg().node_id())) {
+        return std::nullopt;
+    }
+
+    auto followers = partition.raft()->get_follower_metrics();
+    // prefer the same follower for all the fetches of the consumer
+    std::sort(
+      followers.begin(),
+      followers.end(),
+      [](const raft::follower_metrics& lhs, const raft::follower_metrics& rhs) {
+          return lhs.id < rhs.id;
+      });
+    for (const auto& f : followers) {
+        if (f.is_learner || !f.is_live || f.under_replicated) {
+            continue;
+        }
+        if (in_consumer_rack(f.id)) {
+            return f.id;
+        }
+    }
+    return std::nullopt;
+}
+
 /**
  * Entry point for reading from an ntp. This is executed on NTP home core and
  * build error responses if anything goes wrong.
@@ -192,8 +237,25 @@ static ss::future<read_result> do_read_from_ntp(
           error_code::unknown_topic_or_partition);
     }
     if (unlikely(!kafka_partition->is_leader())) {
-        return ss::make_ready_future<read_result>(
-          error_code::not_leader_for_partition);
+        // followers serve the consumers up to the high watermark propagated
+        // by the leader with heartbeats
+        if (!ntp_config.cfg.read_from_follower) {
+            return ss::make_ready_future<read_result>(
+              error_code::not_leader_for_partition);
+        }
+    } else if (ntp_config.cfg.consumer_rack) {
+        auto partition = mgr.get(ntp_config.ntp());
+        auto preferred = partition ? select_preferred_replica(
+                           *partition, md_cache, *ntp_config.cfg.consumer_rack)
+                                   : std::nullopt;
+        if (preferred) {
+            read_result res(
+              kafka_partition->start_offset(),
+              kafka_partition->high_watermark(),
+              kafka_partition->last_stable_offset());
+            res.preferred_replica = preferred;
+            return ss::make_ready_future<read_result>(std::move(res));
+        }
     }
 
     if (config::shard_local_cfg().enable_transactions.value()) {
@@ -240,18 +302,19 @@ static void fill_fetch_responses(
   op_context& octx,
   std::vector<read_result> results,
   std::vector<op_context::response_iterator> responses,
-  std::vector<std::unique_ptr<hdr_hist::measurement>> metrics) {
+  std::vector<latency_probe::hist_t::measurement> metrics) {
     auto range = boost::irange<size_t>(0, results.size());
     for (auto idx : range) {
         auto& res = results[idx];
         auto& resp_it = responses[idx];
         auto& metric = metrics[idx];
+        octx.throttle = std::max(octx.throttle, res.throttle);
 
         // error case
         if (unlikely(res.error != error_code::none)) {
             resp_it.set(
               make_partition_response_error(res.partition, res.error));
-            metric->set_trace(false);
+            metric.set_trace(false);
             continue;
         }
 
@@ -277,6 +340,9 @@ static void fill_fetch_responses(
         resp.log_start_offset = res.start_offset;
         resp.high_watermark = res.high_watermark;
         resp.last_stable_offset = res.last_stable_offset;
+        if (res.preferred_replica) {
+            resp.preferred_read_replica = (*res.preferred_replica)();
+        }
 
         /**
          * According to KIP-74 we have to return first batch even if it would
@@ -316,18 +382,24 @@ static void fill_fetch_responses(
 static ss::future<std::vector<read_result>> fetch_ntps_in_parallel(
   cluster::partition_manager& mgr,
   cluster::metadata_cache& md_cache,
+  quota_manager& quota_mgr,
   std::vector<ntp_fetch_config> ntp_fetch_configs,
   bool foreign_read,
   std::optional<model::timeout_clock::time_point> deadline) {
     return ssx::parallel_transform(
       std::move(ntp_fetch_configs),
-      [&mgr, &md_cache, deadline, foreign_read](
+      [&mgr, &md_cache, &quota_mgr, deadline, foreign_read](
         const ntp_fetch_config& ntp_cfg) {
-          auto p_id = ntp_cfg.ntp().tp.partition;
           return do_read_from_ntp(
                    mgr, md_cache, ntp_cfg, foreign_read, deadline)
-            .then([p_id](read_result res) {
-                res.partition = p_id;
+            .then([&quota_mgr, ntp = ntp_cfg.ntp()](read_result res) {
+                res.partition = ntp.tp.partition;
+                if (res.has_data()) {
+                    res.throttle = quota_mgr.record_partition_tp_and_throttle(
+                      quota_manager::throughput_type::fetch,
+                      ntp,
+                      res.data_size_bytes());
+                }
                 return res;
             });
       });
@@ -353,19 +425,19 @@ handle_shard_fetch(ss::shard_id shard, op_context& octx, shard_fetch fetch) {
 
     bool foreign_read = shard != ss::this_shard_id();
 
-    // dispatch to remote core
-    return octx.rctx.partition_manager()
-      .invoke_on(
+    // dispatch to remote core, together with the fetches of the other
+    // requests of this core
+    return octx.rctx.smp_batcher()
+      .submit_to(
         shard,
-        octx.ssg,
         [foreign_read,
          &octx,
          deadline = octx.deadline,
-         configs = std::move(fetch.requests)](
-          cluster::partition_manager& mgr) mutable {
+         configs = std::move(fetch.requests)]() mutable {
             return fetch_ntps_in_parallel(
-              mgr,
+              octx.rctx.partition_manager().local(),
               octx.rctx.metadata_cache(),
+              octx.rctx.quota_mgr(),
               std::move(configs),
               foreign_read,
               deadline);
@@ -398,65 +470,102 @@ class parallel_fetch_plan_executor final : public fetch_plan_executor::impl {
     }
 };
 
+/**
+ * Consumers supporting preferred read replicas (fetch v11+) may be served by
+ * followers. Records of open transactions are only tracked by leaders, read
+ * committed consumers are always served by the leader.
+ */
+static bool can_read_from_follower(op_context& octx) {
+    return config::shard_local_cfg().enable_follower_fetching()
+           && octx.rctx.header().version >= api_version(11)
+           && octx.request.data.replica_id < 0
+           && (!config::shard_local_cfg().enable_transactions()
+               || octx.request.data.isolation_level
+                    == model::isolation_level::read_uncommitted);
+}
+
+/**
+ * Checks if the partition should be included into a fetch plan. When it
+ * should not the partition response is set and the iterator advanced.
+ * Returns the shard of the partition otherwise.
+ */
+static std::optional<ss::shard_id> plan_partition_shard(
+  op_context& octx,
+  op_context::response_iterator& resp_it,
+  const fetch_session_partition& fp,
+  const model::ntp& ntp) {
+    // if this is not an initial fetch we are allowed to skip
+    // partions that aleready have an error or we have enough data
+    if (!octx.initial_fetch) {
+        bool has_enough_data = !resp_it->partition_response->records->empty()
+                               && octx.over_min_bytes();
+
+        if (
+          resp_it->partition_response->error_code != error_code::none
+          || has_enough_data) {
+            ++resp_it;
+            return std::nullopt;
+        }
+    }
+    /**
+     * if not authorized do not include into a plan
+     */
+    if (!octx.rctx.authorized(security::acl_operation::read, fp.topic)) {
+        (resp_it).set(make_partition_response_error(
+          fp.partition, error_code::topic_authorization_failed));
+        ++resp_it;
+        return std::nullopt;
+    }
+
+    // there is given partition in topic metadata, return
+    // unknown_topic_or_partition error
+    if (unlikely(!octx.rctx.metadata_cache().contains(ntp))) {
+        (resp_it).set(make_partition_response_error(
+          fp.partition, error_code::unknown_topic_or_partition));
+        ++resp_it;
+        return std::nullopt;
+    }
+
+    auto shard = octx.rctx.shards().shard_for(ntp);
+    if (!shard) {
+        /**
+         * no shard is found on current node, but topic exists in
+         * cluster metadata, this mean that the partition was moved
+         * but consumer has not updated its metadata yet. we return
+         * not_leader_for_partition error to force metadata update.
+         */
+        (resp_it).set(make_partition_response_error(
+          fp.partition, error_code::not_leader_for_partition));
+        ++resp_it;
+        return std::nullopt;
+    }
+    return shard;
+}
+
 class simple_fetch_planner final : public fetch_planner::impl {
     fetch_plan create_plan(op_context& octx) final {
         fetch_plan plan(ss::smp::count);
         auto resp_it = octx.response_begin();
         auto bytes_left_in_plan = octx.bytes_left;
+        const bool read_from_follower = can_read_from_follower(octx);
+        std::optional<ss::sstring> consumer_rack;
+        if (read_from_follower && !octx.request.data.rack_id.empty()) {
+            consumer_rack = octx.request.data.rack_id;
+        }
         /**
          * group fetch requests by shard
          */
         octx.for_each_fetch_partition(
-          [&resp_it, &octx, &plan, &bytes_left_in_plan](
-            const fetch_session_partition& fp) {
-              // if this is not an initial fetch we are allowed to skip
-              // partions that aleready have an error or we have enough data
-              if (!octx.initial_fetch) {
-                  bool has_enough_data
-                    = !resp_it->partition_response->records->empty()
-                      && octx.over_min_bytes();
-
-                  if (
-                    resp_it->partition_response->error_code != error_code::none
-                    || has_enough_data) {
-                      ++resp_it;
-                      return;
-                  }
-              }
-              /**
-               * if not authorized do not include into a plan
-               */
-              if (!octx.rctx.authorized(
-                    security::acl_operation::read, fp.topic)) {
-                  (resp_it).set(make_partition_response_error(
-                    fp.partition, error_code::topic_authorization_failed));
-                  ++resp_it;
-                  return;
-              }
-
+          [&resp_it,
+           &octx,
+           &plan,
+           &bytes_left_in_plan,
+           read_from_follower,
+           &consumer_rack](const fetch_session_partition& fp) {
               auto ntp = model::ntp(
                 model::kafka_namespace, fp.topic, fp.partition);
-
-              // there is given partition in topic metadata, return
-              // unknown_topic_or_partition error
-              if (unlikely(!octx.rctx.metadata_cache().contains(ntp))) {
-                  (resp_it).set(make_partition_response_error(
-                    fp.partition, error_code::unknown_topic_or_partition));
-                  ++resp_it;
-                  return;
-              }
-
-              auto shard = octx.rctx.shards().shard_for(ntp);
+              auto shard = plan_partition_shard(octx, resp_it, fp, ntp);
               if (!shard) {
-                  /**
-                   * no shard is found on current node, but topic exists in
-                   * cluster metadata, this mean that the partition was moved
-                   * but consumer has not updated its metadata yet. we return
-                   * not_leader_for_partition error to force metadata update.
-                   */
-                  (resp_it).set(make_partition_response_error(
-                    fp.partition, error_code::not_leader_for_partition));
-                  ++resp_it;
                   return;
               }
 
@@ -478,6 +587,8 @@ class simple_fetch_planner final : public fetch_planner::impl {
                 .timeout = octx.deadline.value_or(model::no_timeout),
                 .strict_max_bytes = octx.response_size > 0,
                 .skip_read = bytes_left_in_plan == 0 && max_bytes == 0,
+                .read_from_follower = read_from_follower,
+                .consumer_rack = consumer_rack,
               };
 
               plan.fetches_per_shard[*shard].push_back(
@@ -490,6 +601,142 @@ class simple_fetch_planner final : public fetch_planner::impl {
     }
 };
 
+/**
+ * Fetch planner balancing the response budget across the partitions, and with
+ * them the shards, of a fetch.
+ *
+ * The simple planner assigns the budget in the request order, the first
+ * partitions with data to read may take all of it while the remaining ones
+ * are not read at all, so that a single shard decides the fetch latency.
+ * Here the budget is split evenly among the partitions expected to have data,
+ * according to the fetch metadata cache, the share a partition does not need
+ * because of its own max_bytes goes to the others.
+ *
+ * Partitions read close to their high watermark, whose batches most likely
+ * still are in the batch cache, are placed first in their shard fetch, their
+ * responses are filled first and are the last to be dropped when a fetch goes
+ * over the budget.
+ */
+class balanced_fetch_planner final : public fetch_planner::impl {
+    struct candidate {
+        candidate(
+          model::ntp ntp,
+          ss::shard_id shard,
+          const fetch_session_partition& fp,
+          op_context::response_iterator it,
+          std::optional<int64_t> backlog)
+          : ntp(std::move(ntp))
+          , shard(shard)
+          , fetch_offset(fp.fetch_offset)
+          , max_bytes(fp.max_bytes)
+          , it(it)
+          , backlog(backlog) {}
+
+        model::ntp ntp;
+        ss::shard_id shard;
+        model::offset fetch_offset;
+        size_t max_bytes;
+        op_context::response_iterator it;
+        // offsets between the fetch offset and the high watermark, not known
+        // until the partition was fetched in the session
+        std::optional<int64_t> backlog;
+        size_t budget{0};
+
+        bool has_data() const { return backlog && *backlog > 0; }
+    };
+
+    fetch_plan create_plan(op_context& octx) final {
+        fetch_plan plan(ss::smp::count);
+        const bool read_from_follower = can_read_from_follower(octx);
+        std::optional<ss::sstring> consumer_rack;
+        if (read_from_follower && !octx.request.data.rack_id.empty()) {
+            consumer_rack = octx.request.data.rack_id;
+        }
+
+        std::vector<candidate> candidates;
+        auto resp_it = octx.response_begin();
+        octx.for_each_fetch_partition(
+          [&resp_it, &octx, &candidates](const fetch_session_partition& fp) {
+              auto ntp = model::ntp(
+                model::kafka_namespace, fp.topic, fp.partition);
+              auto shard = plan_partition_shard(octx, resp_it, fp, ntp);
+              if (!shard) {
+                  return;
+              }
+              std::optional<int64_t> backlog;
+              if (auto md = octx.rctx.get_fetch_metadata_cache().get(ntp)) {
+                  backlog = md->high_watermark() - fp.fetch_offset();
+              }
+              candidates.emplace_back(
+                std::move(ntp), *shard, fp, resp_it++, backlog);
+          });
+
+        assign_budgets(candidates, octx.bytes_left);
+
+        // partitions close to their high watermark first, the ones that
+        // were not fetched yet in the session last
+        std::stable_sort(
+          candidates.begin(),
+          candidates.end(),
+          [](const candidate& l, const candidate& r) {
+              return l.backlog.value_or(std::numeric_limits<int64_t>::max())
+                     < r.backlog.value_or(std::numeric_limits<int64_t>::max());
+          });
+
+        for (auto& c : candidates) {
+            fetch_config config{
+              .start_offset = c.fetch_offset,
+              .max_offset = model::model_limits<model::offset>::max(),
+              .isolation_level = octx.request.data.isolation_level,
+              .max_bytes = c.budget,
+              .timeout = octx.deadline.value_or(model::no_timeout),
+              .strict_max_bytes = octx.response_size > 0,
+              .skip_read = c.budget == 0,
+              .read_from_follower = read_from_follower,
+              .consumer_rack = consumer_rack,
+            };
+            plan.fetches_per_shard[c.shard].push_back(
+              make_ntp_fetch_config(c.ntp, config),
+              c.it,
+              octx.rctx.probe().auto_fetch_measurement());
+        }
+        return plan;
+    }
+
+    /**
+     * Water filling the budget among the partitions expected to have data,
+     * partitions with unknown state may read up to the whole budget as they
+     * do with the simple planner
+     */
+    static void
+    assign_budgets(std::vector<candidate>& candidates, size_t bytes) {
+        std::vector<candidate*> with_data;
+        for (auto& c : candidates) {
+            if (c.has_data()) {
+                with_data.push_back(&c);
+            } else {
+                c.budget = std::min(bytes, c.max_bytes);
+            }
+        }
+        std::sort(
+          with_data.begin(),
+          with_data.end(),
+          [](const candidate* l, const candidate* r) {
+              return l->max_bytes < r->max_bytes;
+          });
+
+        auto left = bytes;
+        auto remaining = with_data.size();
+        for (auto c : with_data) {
+            // at least one byte so that a batch is read (KIP-74)
+            auto share = std::min(left, std::max<size_t>(1, left / remaining));
+            c->budget = std::min(share, c->max_bytes);
+            left -= c->budget;
+            --remaining;
+        }
+    }
+};
+
 /**
  * Process partition fetch requests.
  *
@@ -514,8 +761,172 @@ class simple_fetch_planner final : public fetch_planner::impl {
  * order as the partitions in the request.
  */
 
+/**
+ * Partition a fetch waiting for more data is parked on, with the high
+ * watermark the fetch has seen.
+ */
+struct watched_partition {
+    model::ntp ntp;
+    model::offset high_watermark;
+};
+
+/**
+ * Runs on the partitions home shard. Resolves with true once the high
+ * watermark of any of the partitions has moved past the one seen by the
+ * fetch, or with false when the wait timed out or was aborted. Partitions
+ * whose high watermark can not be watched, i.e. materialized ones, are polled
+ * every fetch_reads_debounce_timeout.
+ */
+static ss::future<bool> wait_for_shard_partitions(
+  cluster::partition_manager& mgr,
+  cluster::metadata_cache& md_cache,
+  std::vector<watched_partition> partitions,
+  model::timeout_clock::time_point deadline,
+  ss::abort_source& as) {
+    std::vector<ss::lw_shared_ptr<cluster::partition>> watched;
+    watched.reserve(partitions.size());
+    bool poll = false;
+    for (auto& p : partitions) {
+        auto proxy = make_partition_proxy(p.ntp, md_cache, mgr);
+        auto partition = mgr.get(p.ntp);
+        if (!proxy || !partition) {
+            poll = true;
+            continue;
+        }
+        if (proxy->high_watermark() > p.high_watermark) {
+            // committed while the fetch was being processed
+            co_return true;
+        }
+        watched.push_back(std::move(partition));
+    }
+
+    std::vector<ss::future<>> waits;
+    waits.reserve(watched.size() + 1);
+    for (auto& partition : watched) {
+        // visible offset monitor is notified with the last visible offset,
+        // the one preceding the high watermark
+        waits.push_back(partition->raft()->visible_offset_monitor().wait(
+          partition->high_watermark(), deadline, as));
+    }
+    if (poll) {
+        waits.push_back(ss::sleep_abortable<model::timeout_clock>(
+          std::min<model::timeout_clock::duration>(
+            config::shard_local_cfg().fetch_reads_debounce_timeout(),
+            deadline - model::timeout_clock::now()),
+          as));
+    }
+
+    bool woken = false;
+    for (auto& w : waits) {
+        w = std::move(w)
+              .then([&as, &woken] {
+                  woken = true;
+                  // the first partition with new data ends the wait
+                  if (!as.abort_requested()) {
+                      as.request_abort();
+                  }
+              })
+              .handle_exception([](const std::exception_ptr&) {
+                  // timed out or aborted
+              });
+    }
+    co_await ss::when_all_succeed(waits.begin(), waits.end());
+    co_return woken;
+}
+
+/**
+ * Fetch purgatory. Parks a fetch that has not collected min_bytes yet until
+ * new data is committed into any of its partitions or the fetch deadline is
+ * reached. Partition shards are woken up by the raft visible offset monitors
+ * instead of re-reading all the partitions in a loop.
+ */
+static ss::future<> wait_for_new_data(op_context& octx) {
+    std::vector<std::vector<watched_partition>> partitions(ss::smp::count);
+    for (auto it = octx.response_begin(); it != octx.response_end(); ++it) {
+        auto& resp = *it->partition_response;
+        if (resp.error_code != error_code::none) {
+            continue;
+        }
+        auto ntp = model::ntp(
+          model::kafka_namespace, it->partition->name, resp.partition_index);
+        auto shard = octx.rctx.shards().shard_for(ntp);
+        if (!shard) {
+            continue;
+        }
+        partitions[*shard].push_back(
+          watched_partition{std::move(ntp), resp.high_watermark});
+    }
+
+    using abort_source_ptr = ss::foreign_ptr<std::unique_ptr<ss::abort_source>>;
+    std::vector<ss::shard_id> shards;
+    std::vector<ss::future<abort_source_ptr>> abort_sources;
+    for (ss::shard_id shard = 0; shard < partitions.size(); ++shard) {
+        if (!partitions[shard].empty()) {
+            shards.push_back(shard);
+            abort_sources.push_back(ss::smp::submit_to(shard, [] {
+                return ss::make_foreign(std::make_unique<ss::abort_source>());
+            }));
+        }
+    }
+    if (shards.empty()) {
+        co_return;
+    }
+    auto aborts = co_await ss::when_all_succeed(
+      abort_sources.begin(), abort_sources.end());
+
+    ss::promise<> woken;
+    bool is_woken = false;
+    auto wake = [&woken, &is_woken] {
+        if (!is_woken) {
+            is_woken = true;
+            woken.set_value();
+        }
+    };
+    std::vector<ss::future<>> waits;
+    waits.reserve(shards.size());
+    for (size_t i = 0; i < shards.size(); ++i) {
+        waits.push_back(
+          octx.rctx.partition_manager()
+            .invoke_on(
+              shards[i],
+              octx.ssg,
+              [&md_cache = octx.rctx.metadata_cache(),
+               partitions = std::move(partitions[shards[i]]),
+               deadline = *octx.deadline,
+               as = aborts[i].get()](cluster::partition_manager& mgr) mutable {
+                  return wait_for_shard_partitions(
+                    mgr, md_cache, std::move(partitions), deadline, *as);
+              })
+            .then([&wake](bool has_data) {
+                if (has_data) {
+                    wake();
+                }
+            })
+            .handle_exception([&wake](const std::exception_ptr& e) {
+                vlog(klog.debug, "error waiting for fetch data - {}", e);
+                wake();
+            }));
+    }
+    auto all_done = ss::when_all_succeed(waits.begin(), waits.end())
+                      .then([&wake] { wake(); });
+
+    co_await woken.get_future();
+    // stop waiting on the other shards
+    co_await ss::parallel_for_each(
+      boost::irange<size_t>(0, shards.size()), [&shards, &aborts](size_t i) {
+          return ss::smp::submit_to(shards[i], [as = aborts[i].get()] {
+              if (!as->abort_requested()) {
+                  as->request_abort();
+              }
+          });
+      });
+    co_await std::move(all_done);
+}
+
 static ss::future<> fetch_topic_partitions(op_context& octx) {
-    auto planner = make_fetch_planner<simple_fetch_planner>();
+    auto planner = config::shard_local_cfg().enable_balanced_fetch_planning()
+                     ? make_fetch_planner<balanced_fetch_planner>()
+                     : make_fetch_planner<simple_fetch_planner>();
 
     auto fetch_plan = planner.create_plan(octx);
 
@@ -528,10 +939,7 @@ static ss::future<> fetch_topic_partitions(op_context& octx) {
     }
 
     octx.reset_context();
-    // debounce next read retry
-    co_await ss::sleep(std::min(
-      config::shard_local_cfg().fetch_reads_debounce_timeout(),
-      octx.request.data.max_wait_ms));
+    co_await wait_for_new_data(octx);
 }
 
 template<>
@@ -669,6 +1077,13 @@ bool update_fetch_partition(
 }
 
 ss::future<response_ptr> op_context::send_response() && {
+    if (throttle > ss::lowres_clock::duration(0)) {
+        rctx.connection()->delay_requests(throttle);
+    }
+    response.data.throttle_time_ms = std::max(
+      std::chrono::duration_cast<std::chrono::milliseconds>(throttle),
+      std::chrono::milliseconds(rctx.throttle_delay_ms()));
+
     // Sessionless fetch
     if (session_ctx.is_sessionless()) {
         response.data.session_id = invalid_fetch_session_id;
@@ -722,7 +1137,11 @@ void op_context::response_iterator::set(
       _it->partition_response->partition_index,
       response.partition_index);
 
-    if (response.error_code != error_code::none) {
+    // do not wait for more data when the consumer has to fetch from other
+    // replica
+    if (
+      response.error_code != error_code::none
+      || response.preferred_read_replica >= 0) {
         _ctx->response_error = true;
     }
     auto& current_resp_data = _it->partition_response->records;
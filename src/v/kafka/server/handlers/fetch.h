@@ -133,6 +133,8 @@ struct op_context {
     size_t response_size;
     // does the response contain an error
     bool response_error;
+    // partition and topic throughput throttling
+    ss::lowres_clock::duration throttle{0};
 
     bool initial_fetch = true;
     fetch_session_ctx session_ctx;
@@ -146,16 +148,23 @@ struct fetch_config {
     model::timeout_clock::time_point timeout;
     bool strict_max_bytes{false};
     bool skip_read{false};
+    // the consumer may be served by a follower (KIP-392)
+    bool read_from_follower{false};
+    // rack of the consumer, the leader points the consumer to an in-sync
+    // follower from this rack
+    std::optional<ss::sstring> consumer_rack;
 
     friend std::ostream& operator<<(std::ostream& o, const fetch_config& cfg) {
         fmt::print(
           o,
-          R"({{"start_offset": {}, "max_offset": {}, "isolation_lvl": {}, "max_bytes": {}, "strict_max_bytes": {}}})",
+          R"({{"start_offset": {}, "max_offset": {}, "isolation_lvl": {}, "max_bytes": {}, "strict_max_bytes": {}, "read_from_follower": {}, "consumer_rack": {}}})",
           cfg.start_offset,
           cfg.max_offset,
           cfg.isolation_level,
           cfg.max_bytes,
-          cfg.strict_max_bytes);
+          cfg.strict_max_bytes,
+          cfg.read_from_follower,
+          cfg.consumer_rack.value_or(ss::sstring{}));
         return o;
     }
 };
@@ -234,8 +243,24 @@ struct read_result {
           data,
           [](data_t& d) { return std::move(*d); },
           [](foreign_data_t& d) {
-              auto ret = d->copy();
-              d.reset();
+              /**
+               * The fragments of data read on another shard are shared by
+               * reference rather than copied. The foreign buffer is released
+               * on its owner shard once the last of them, owned by the
+               * response sent on this shard, is gone.
+               */
+              auto owner = ss::make_lw_shared<foreign_data_t>(std::move(d));
+              iobuf ret;
+              for (const auto& f : **owner) {
+                  ss::temporary_buffer<char> buf(
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+                    const_cast<char*>(f.get()),
+                    f.size(),
+                    ss::make_deleter([owner] {}));
+                  // intrusive list manages the lifetime
+                  ret.append_take_ownership(new iobuf::fragment(
+                    std::move(buf), iobuf::fragment::full{}));
+              }
               return ret;
           });
     }
@@ -247,6 +272,10 @@ struct read_result {
     error_code error;
     model::partition_id partition;
     std::vector<cluster::rm_stm::tx_range> aborted_transactions;
+    // replica the consumer should fetch from instead of the leader
+    std::optional<model::node_id> preferred_replica;
+    // delay keeping the partition within its fetch throughput limits
+    ss::lowres_clock::duration throttle{0};
 };
 // struct aggregating fetch requests and corresponding response iterators for
 // the same shard
@@ -254,7 +283,7 @@ struct shard_fetch {
     void push_back(
       ntp_fetch_config config,
       op_context::response_iterator it,
-      std::unique_ptr<hdr_hist::measurement> m) {
+      latency_probe::hist_t::measurement m) {
         requests.push_back(std::move(config));
         responses.push_back(it);
         metrics.push_back(std::move(m));
@@ -273,7 +302,7 @@ struct shard_fetch {
     ss::shard_id shard;
     std::vector<ntp_fetch_config> requests;
     std::vector<op_context::response_iterator> responses;
-    std::vector<std::unique_ptr<hdr_hist::measurement>> metrics;
+    std::vector<latency_probe::hist_t::measurement> metrics;
 
     friend std::ostream& operator<<(std::ostream& o, const shard_fetch& sf) {
         fmt::print(o, "{}", sf.requests);
@@ -40,11 +40,6 @@ ss::future<response_ptr> join_group_handler::handle(
     join_group_request request;
     decode_request(ctx, request);
 
-    if (request.data.group_instance_id) {
-        co_return co_await ctx.respond(
-          join_group_response(error_code::unsupported_version));
-    }
-
     if (!ctx.authorized(security::acl_operation::read, request.data.group_id)) {
         co_return co_await ctx.respond(
           join_group_response(error_code::group_authorization_failed));
@@ -14,6 +14,6 @@
 
 namespace kafka {
 
-using join_group_handler = handler<join_group_api, 0, 4>;
+using join_group_handler = handler<join_group_api, 0, 5>;
 
 }
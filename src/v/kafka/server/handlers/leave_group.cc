@@ -26,6 +26,7 @@ ss::future<response_ptr> leave_group_handler::handle(
   request_context ctx, [[maybe_unused]] ss::smp_service_group g) {
     leave_group_request request;
     request.decode(ctx.reader(), ctx.header().version);
+    request.version = ctx.header().version;
 
     if (!ctx.authorized(security::acl_operation::read, request.data.group_id)) {
         co_return co_await ctx.respond(
@@ -130,32 +130,51 @@ static metadata_response::topic make_topic_response(
     return res;
 }
 
+/**
+ * Responses of all the kafka namespace topics, rebuilt only if the topics
+ * metadata changed since they were cached.
+ */
+static const std::vector<metadata_response::topic>&
+all_topics_responses(request_context& ctx) {
+    auto& cache = ctx.get_metadata_response_cache();
+    auto version = ctx.metadata_cache().topics_metadata_version();
+    if (auto cached = cache.get(version); cached) {
+        return *cached;
+    }
+
+    // the snapshot is shared with other readers, only the topics served are
+    // copied out of it
+    auto snapshot = ctx.metadata_cache().topics_metadata_snapshot();
+    std::vector<metadata_response::topic> res;
+    res.reserve(snapshot->topics.size());
+    for (const auto& t_md : snapshot->topics) {
+        // only serve topics from the kafka namespace
+        if (t_md.tp_ns.ns != model::kafka_namespace) {
+            continue;
+        }
+        res.push_back(
+          make_topic_response_from_topic_metadata(model::topic_metadata(t_md)));
+    }
+    return cache.put(snapshot->version, std::move(res));
+}
+
 static ss::future<std::vector<metadata_response::topic>>
 get_topic_metadata(request_context& ctx, metadata_request& request) {
     std::vector<metadata_response::topic> res;
 
     // request can be served from whatever happens to be in the cache
     if (request.list_all_topics) {
-        auto topics = ctx.metadata_cache().all_topics_metadata();
-        // only serve topics from the kafka namespace
-        std::erase_if(topics, [](model::topic_metadata& t_md) {
-            return t_md.tp_ns.ns != model::kafka_namespace;
-        });
-
-        auto unauthorized_it = std::partition(
-          topics.begin(),
-          topics.end(),
-          [&ctx](const model::topic_metadata& t_md) {
-              return ctx.authorized(
-                security::acl_operation::describe, t_md.tp_ns.tp);
-          });
-        std::transform(
-          topics.begin(),
-          unauthorized_it,
-          std::back_inserter(res),
-          [&ctx, &request](model::topic_metadata& t_md) {
-              return make_topic_response(ctx, request, std::move(t_md));
-          });
+        const auto& topics = all_topics_responses(ctx);
+        for (const auto& t : topics) {
+            if (!ctx.authorized(security::acl_operation::describe, t.name)) {
+                continue;
+            }
+            auto& tp = res.emplace_back(t);
+            if (request.data.include_topic_authorized_operations) {
+                tp.topic_authorized_operations = details::to_bit_field(
+                  details::authorized_operations(ctx, t.name));
+            }
+        }
         return ss::make_ready_future<std::vector<metadata_response::topic>>(
           std::move(res));
     }
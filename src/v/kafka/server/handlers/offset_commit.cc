@@ -59,11 +59,6 @@ offset_commit_handler::handle(request_context ctx, ss::smp_service_group ssg) {
     request.decode(ctx.reader(), ctx.header().version);
     vlog(klog.trace, "Handling request {}", request);
 
-    if (request.data.group_instance_id) {
-        return process_result_stages::single_stage(ctx.respond(
-          offset_commit_response(request, error_code::unsupported_version)));
-    }
-
     // check authorization for this group
     const auto group_authorized = ctx.authorized(
       security::acl_operation::read, request.data.group_id);
@@ -16,6 +16,9 @@
 #include "config/configuration.h"
 #include "kafka/protocol/errors.h"
 #include "kafka/protocol/kafka_batch_adapter.h"
+#include "kafka/server/batch_recompressor.h"
+#include "kafka/server/produce_memory_budget.h"
+#include "kafka/server/quota_manager.h"
 #include "kafka/server/replicated_partition.h"
 #include "likely.h"
 #include "model/fundamental.h"
@@ -68,6 +71,8 @@ struct produce_ctx {
     produce_request request;
     produce_response response;
     ss::smp_service_group ssg;
+    // partition and topic throughput throttling
+    ss::lowres_clock::duration throttle{0};
 
     produce_ctx(
       request_context&& rctx,
@@ -83,17 +88,40 @@ struct partition_produce_stages {
     ss::future<produce_response::partition> produced;
 };
 
-struct topic_produce_stages {
+struct produce_stages {
     ss::future<> dispatched;
-    ss::future<produce_response::topic> produced;
+    std::vector<ss::future<produce_response::topic>> produced;
 };
 
-partition_produce_stages make_ready_stage(produce_response::partition p) {
-    return partition_produce_stages{
-      .dispatched = ss::now(),
-      .produced = ss::make_ready_future<produce_response::partition>(
-        std::move(p)),
+/**
+ * Partition requests owned by a single shard. They are sent to the shard in
+ * a single cross shard call once all the topics of the produce request were
+ * processed, and the shard reports that all of them were enqueued with a
+ * single notification.
+ */
+struct shard_produce {
+    struct partition_request {
+        model::ntp ntp;
+        raft::group_id group;
+        model::batch_identity bid;
+        model::record_batch_reader reader;
+        int32_t num_records;
+        size_t size_bytes;
+    };
+
+    struct result {
+        std::vector<produce_response::partition> partitions;
+        ss::lowres_clock::duration throttle;
     };
+
+    std::vector<partition_request> requests;
+    // resolved on the shard handling the produce request
+    std::vector<ss::promise<produce_response::partition>> responses;
+};
+
+static ss::future<produce_response::partition>
+make_ready_partition(produce_response::partition p) {
+    return ss::make_ready_future<produce_response::partition>(std::move(p));
 }
 
 static raft::replicate_options acks_to_replicate_options(int16_t acks) {
@@ -121,7 +149,7 @@ reader_from_lcore_batch(model::record_batch&& batch) {
     return model::make_foreign_memory_record_batch_reader(std::move(batch));
 }
 
-static error_code map_produce_error_code(std::error_code ec) {
+error_code map_produce_error_code(std::error_code ec) {
     if (ec.category() == raft::error_category()) {
         switch (static_cast<raft::errc>(ec.value())) {
         case raft::errc::not_leader:
@@ -162,17 +190,26 @@ static partition_produce_stages partition_append(
   model::record_batch_reader reader,
   int16_t acks,
   int32_t num_records) {
+    using clock_type = std::chrono::steady_clock;
+    const auto begin = clock_type::now();
+    auto elapsed = [begin] {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+          clock_type::now() - begin);
+    };
     auto stages = partition->replicate(
       bid, std::move(reader), acks_to_replicate_options(acks));
     return partition_produce_stages{
-      .dispatched = std::move(stages.request_enqueued),
+      .dispatched = stages.request_enqueued.then([partition, elapsed] {
+          partition->probe().add_replicate_enqueue_latency(elapsed());
+      }),
       .produced = stages.replicate_finished.then_wrapped(
-        [partition, id, num_records = num_records](
+        [partition, id, num_records = num_records, elapsed](
           ss::future<result<raft::replicate_result>> f) {
             produce_response::partition p{.partition_index = id};
             try {
                 auto r = f.get0();
                 if (r.has_value()) {
+                    partition->probe().add_replicate_ack_latency(elapsed());
                     // have to subtract num_of_records - 1 as base_offset
                     // is inclusive
                     p.base_offset = model::offset(
@@ -190,13 +227,66 @@ static partition_produce_stages partition_append(
     };
 }
 
+/*
+ * Appends the batches after recompressing them to the codec of the topic, as
+ * produced if the topic has none. The dispatched stage resolves once the
+ * recompressed batches were enqueued so that the next requests of the
+ * connection are enqueued after them.
+ */
+static partition_produce_stages recompress_and_append(
+  model::partition_id id,
+  ss::lw_shared_ptr<replicated_partition> partition,
+  model::batch_identity bid,
+  model::record_batch_reader reader,
+  int16_t acks,
+  int32_t num_records,
+  std::optional<model::compression> target) {
+    if (!target) {
+        return partition_append(
+          id, std::move(partition), bid, std::move(reader), acks, num_records);
+    }
+    ss::promise<> dispatched;
+    auto dispatched_f = dispatched.get_future();
+    auto produced
+      = local_batch_recompressor()
+          .recompress(std::move(reader), *target)
+          .then_wrapped(
+            [id, partition, bid, acks, num_records, d = std::move(dispatched)](
+              ss::future<model::record_batch_reader> f) mutable {
+                if (f.failed()) {
+                    auto e = f.get_exception();
+                    vlog(
+                      klog.warn,
+                      "Unable to recompress batch produced to {}: {}",
+                      partition->ntp(),
+                      e);
+                    d.set_value();
+                    return make_ready_partition(produce_response::partition{
+                      .partition_index = id,
+                      .error_code = error_code::corrupt_message});
+                }
+                auto stages = partition_append(
+                  id, partition, bid, f.get0(), acks, num_records);
+                stages.dispatched.forward_to(std::move(d));
+                return std::move(stages.produced);
+            });
+    return partition_produce_stages{
+      .dispatched = std::move(dispatched_f),
+      .produced = std::move(produced),
+    };
+}
+
 /**
  * \brief handle writing to a single topic partition.
+ *
+ * The partition request is queued to be dispatched with the other requests
+ * of its shard.
  */
-static partition_produce_stages produce_topic_partition(
+static ss::future<produce_response::partition> produce_topic_partition(
   produce_ctx& octx,
   produce_request::topic& topic,
-  produce_request::partition& part) {
+  produce_request::partition& part,
+  std::vector<shard_produce>& shards) {
     auto ntp = model::ntp(
       model::kafka_namespace, topic.name, part.partition_index);
 
@@ -204,12 +294,17 @@ static partition_produce_stages produce_topic_partition(
      * A single produce request may contain record batches for many
      * different partitions that are managed different cores.
      */
-    auto shard = octx.rctx.shards().shard_for(ntp);
-
-    if (!shard) {
-        return make_ready_stage(produce_response::partition{
+    auto placement = octx.rctx.shards().placement_for(ntp);
+
+    if (!placement) {
+        /*
+         * the partition exists in the cluster metadata, but it is not hosted
+         * on this node: it was moved, or it is still recovering after a
+         * restart. make the client refresh its metadata and retry.
+         */
+        return make_ready_partition(produce_response::partition{
           .partition_index = ntp.tp.partition,
-          .error_code = error_code::unknown_topic_or_partition});
+          .error_code = error_code::not_leader_for_partition});
     }
 
     // steal the batch from the adapter
@@ -235,111 +330,202 @@ static partition_produce_stages produce_topic_partition(
     auto bid = model::batch_identity::from(hdr);
 
     auto num_records = batch.record_count();
+    auto size_bytes = batch.size_bytes();
     auto reader = reader_from_lcore_batch(std::move(batch));
     auto start = std::chrono::steady_clock::now();
 
-    auto dispatch = std::make_unique<ss::promise<>>();
-    auto dispatch_f = dispatch->get_future();
     auto m = octx.rctx.probe().auto_produce_measurement();
-    auto f
-      = octx.rctx.partition_manager()
-          .invoke_on(
-            *shard,
-            octx.ssg,
-            [reader = std::move(reader),
-             ntp = std::move(ntp),
-             dispatch = std::move(dispatch),
-             num_records,
-             bid,
-             acks = octx.request.data.acks,
-             source_shard = ss::this_shard_id()](
-              cluster::partition_manager& mgr) mutable {
-                auto partition = mgr.get(ntp);
-                if (!partition) {
-                    // submit back to promise source shard
-                    (void)ss::smp::submit_to(
-                      source_shard, [dispatch = std::move(dispatch)]() mutable {
-                          dispatch->set_value();
-                          dispatch.reset();
-                      });
-                    return ss::make_ready_future<produce_response::partition>(
-                      produce_response::partition{
-                        .partition_index = ntp.tp.partition,
-                        .error_code = error_code::unknown_topic_or_partition});
+    auto& shard_requests = shards[placement->shard];
+    shard_requests.requests.push_back(shard_produce::partition_request{
+      .ntp = std::move(ntp),
+      .group = placement->group,
+      .bid = bid,
+      .reader = std::move(reader),
+      .num_records = num_records,
+      .size_bytes = static_cast<size_t>(size_bytes),
+    });
+    return shard_requests.responses.emplace_back().get_future().then(
+      [&octx, start, m = std::move(m)](produce_response::partition p) {
+          if (p.error_code == error_code::none) {
+              auto dur = std::chrono::steady_clock::now() - start;
+              octx.rctx.connection()->server().update_produce_latency(dur);
+          } else {
+              m->set_trace(false);
+          }
+          return p;
+      });
+}
+
+static ss::future<shard_produce::result> do_produce_on_shard(
+  cluster::partition_manager& mgr,
+  quota_manager& quota_mgr,
+  std::vector<shard_produce::partition_request> requests,
+  int16_t acks,
+  ss::shard_id source_shard,
+  std::unique_ptr<ss::promise<>> dispatch,
+  ss::semaphore_units<> budget) {
+    std::vector<ss::future<>> dispatched;
+    std::vector<ss::future<produce_response::partition>> produced;
+    ss::lowres_clock::duration throttle(0);
+    dispatched.reserve(requests.size());
+    produced.reserve(requests.size());
+    for (auto& r : requests) {
+        // the raft group index is keyed by integers, cheaper than the ntp
+        auto partition = r.group() >= 0 ? mgr.partition_for(r.group)
+                                        : mgr.get(r.ntp);
+        if (!partition || partition->ntp() != r.ntp) {
+            produced.push_back(make_ready_partition(produce_response::partition{
+              .partition_index = r.ntp.tp.partition,
+              .error_code = error_code::unknown_topic_or_partition}));
+            continue;
+        }
+        if (unlikely(!partition->is_leader())) {
+            produced.push_back(make_ready_partition(produce_response::partition{
+              .partition_index = r.ntp.tp.partition,
+              .error_code = error_code::not_leader_for_partition}));
+            continue;
+        }
+        throttle = std::max(
+          throttle,
+          quota_mgr.record_partition_tp_and_throttle(
+            quota_manager::throughput_type::produce, r.ntp, r.size_bytes));
+        auto target = partition->get_ntp_config().recompression_type();
+        auto stages = recompress_and_append(
+          r.ntp.tp.partition,
+          ss::make_lw_shared<replicated_partition>(std::move(partition)),
+          r.bid,
+          std::move(r.reader),
+          acks,
+          r.num_records,
+          target);
+        dispatched.push_back(std::move(stages.dispatched));
+        produced.push_back(std::move(stages.produced));
+    }
+
+    (void)ss::when_all_succeed(dispatched.begin(), dispatched.end())
+      .then_wrapped([source_shard,
+                     dispatch = std::move(dispatch),
+                     budget = std::move(budget)](ss::future<> f) mutable {
+          // the batches are held by raft from now on
+          budget.return_all();
+          std::exception_ptr e;
+          if (f.failed()) {
+              e = f.get_exception();
+          }
+          // submit back to promise source shard
+          return ss::smp::submit_to(
+            source_shard, [dispatch = std::move(dispatch), e]() mutable {
+                if (e) {
+                    dispatch->set_exception(e);
+                } else {
+                    dispatch->set_value();
                 }
-                if (unlikely(!partition->is_leader())) {
-                    // submit back to promise source shard
-                    (void)ss::smp::submit_to(
-                      source_shard, [dispatch = std::move(dispatch)]() mutable {
-                          dispatch->set_value();
-                          dispatch.reset();
-                      });
-                    return ss::make_ready_future<produce_response::partition>(
-                      produce_response::partition{
-                        .partition_index = ntp.tp.partition,
-                        .error_code = error_code::not_leader_for_partition});
+                dispatch.reset();
+            });
+      });
+    return ss::when_all_succeed(produced.begin(), produced.end())
+      .then([throttle](std::vector<produce_response::partition> partitions) {
+          return shard_produce::result{
+            .partitions = std::move(partitions), .throttle = throttle};
+      });
+}
+
+/**
+ * \brief appends the partition requests of a shard. Runs on the shard.
+ *
+ * The requests wait for their bytes in the produce memory budget of the
+ * shard. The source shard is notified once all of the requests were
+ * enqueued, the returned future resolves when all of them were replicated.
+ */
+static ss::future<shard_produce::result> produce_on_shard(
+  cluster::partition_manager& mgr,
+  quota_manager& quota_mgr,
+  std::vector<shard_produce::partition_request> requests,
+  int16_t acks,
+  ss::shard_id source_shard,
+  std::unique_ptr<ss::promise<>> dispatch) {
+    size_t bytes = 0;
+    for (const auto& r : requests) {
+        bytes += r.size_bytes;
+    }
+    return local_produce_memory_budget().reserve(bytes).then(
+      [&mgr,
+       &quota_mgr,
+       requests = std::move(requests),
+       acks,
+       source_shard,
+       dispatch = std::move(dispatch)](ss::semaphore_units<> budget) mutable {
+          return do_produce_on_shard(
+            mgr,
+            quota_mgr,
+            std::move(requests),
+            acks,
+            source_shard,
+            std::move(dispatch),
+            std::move(budget));
+      });
+}
+
+/**
+ * \brief sends the partition requests of a shard to the shard, the returned
+ * future resolves once all of them were enqueued.
+ */
+static ss::future<>
+dispatch_shard_produce(produce_ctx& octx, ss::shard_id shard, shard_produce sp) {
+    if (sp.requests.empty()) {
+        return ss::now();
+    }
+    auto dispatch = std::make_unique<ss::promise<>>();
+    auto dispatch_f = dispatch->get_future();
+    // sent together with the partition requests of the other produce
+    // requests of this core
+    (void)octx.rctx.smp_batcher()
+      .submit_to(
+        shard,
+        [&rctx = octx.rctx,
+         requests = std::move(sp.requests),
+         dispatch = std::move(dispatch),
+         acks = octx.request.data.acks,
+         source_shard = ss::this_shard_id()]() mutable {
+            return produce_on_shard(
+              rctx.partition_manager().local(),
+              rctx.quota_mgr(),
+              std::move(requests),
+              acks,
+              source_shard,
+              std::move(dispatch));
+        })
+      .then_wrapped(
+        [&octx, responses = std::move(sp.responses)](
+          ss::future<shard_produce::result> f) mutable {
+            if (f.failed()) {
+                auto e = f.get_exception();
+                for (auto& r : responses) {
+                    r.set_exception(e);
                 }
-                auto stages = partition_append(
-                  ntp.tp.partition,
-                  ss::make_lw_shared<replicated_partition>(
-                    std::move(partition)),
-                  bid,
-                  std::move(reader),
-                  acks,
-                  num_records);
-                return stages.dispatched
-                  .then_wrapped([source_shard, dispatch = std::move(dispatch)](
-                                  ss::future<> f) mutable {
-                      if (f.failed()) {
-                          (void)ss::smp::submit_to(
-                            source_shard,
-                            [dispatch = std::move(dispatch),
-                             e = f.get_exception()]() mutable {
-                                dispatch->set_exception(e);
-                                dispatch.reset();
-                            });
-                          return;
-                      }
-                      (void)ss::smp::submit_to(
-                        source_shard,
-                        [dispatch = std::move(dispatch)]() mutable {
-                            dispatch->set_value();
-                            dispatch.reset();
-                        });
-                  })
-                  .then([f = std::move(stages.produced)]() mutable {
-                      return std::move(f);
-                  });
-            })
-          .then([&octx, start, m = std::move(m)](
-                  produce_response::partition p) {
-              if (p.error_code == error_code::none) {
-                  auto dur = std::chrono::steady_clock::now() - start;
-                  octx.rctx.connection()->server().update_produce_latency(dur);
-              } else {
-                  m->set_trace(false);
-              }
-              return p;
-          });
-    return partition_produce_stages{
-      .dispatched = std::move(dispatch_f),
-      .produced = std::move(f),
-    };
+                return;
+            }
+            auto result = f.get0();
+            octx.throttle = std::max(octx.throttle, result.throttle);
+            for (size_t i = 0; i < responses.size(); ++i) {
+                responses[i].set_value(std::move(result.partitions[i]));
+            }
+        });
+    return dispatch_f;
 }
 
 /**
  * \brief Dispatch and collect topic partition produce responses
  */
-static topic_produce_stages
-produce_topic(produce_ctx& octx, produce_request::topic& topic) {
+static ss::future<produce_response::topic> produce_topic(
+  produce_ctx& octx,
+  produce_request::topic& topic,
+  std::vector<shard_produce>& shards) {
     std::vector<ss::future<produce_response::partition>> partitions_produced;
-    std::vector<ss::future<>> partitions_dispatched;
     partitions_produced.reserve(topic.partitions.size());
-    partitions_dispatched.reserve(topic.partitions.size());
 
     for (auto& part : topic.partitions) {
         if (!octx.rctx.authorized(security::acl_operation::write, topic.name)) {
-            partitions_dispatched.push_back(ss::now());
             partitions_produced.push_back(
               ss::make_ready_future<produce_response::partition>(
                 produce_response::partition{
@@ -351,7 +537,6 @@ produce_topic(produce_ctx& octx, produce_request::topic& topic) {
         if (!octx.rctx.metadata_cache().contains(
               model::topic_namespace_view(model::kafka_namespace, topic.name),
               part.partition_index)) {
-            partitions_dispatched.push_back(ss::now());
             partitions_produced.push_back(
               ss::make_ready_future<produce_response::partition>(
                 produce_response::partition{
@@ -362,7 +547,6 @@ produce_topic(produce_ctx& octx, produce_request::topic& topic) {
 
         // the record data on the wire was null value
         if (unlikely(!part.records)) {
-            partitions_dispatched.push_back(ss::now());
             partitions_produced.push_back(
               ss::make_ready_future<produce_response::partition>(
                 produce_response::partition{
@@ -373,7 +557,6 @@ produce_topic(produce_ctx& octx, produce_request::topic& topic) {
 
         // an error occured handling legacy messages (magic 0 or 1)
         if (unlikely(part.records->adapter.legacy_error)) {
-            partitions_dispatched.push_back(ss::now());
             partitions_produced.push_back(
               ss::make_ready_future<produce_response::partition>(
                 produce_response::partition{
@@ -383,7 +566,6 @@ produce_topic(produce_ctx& octx, produce_request::topic& topic) {
         }
 
         if (unlikely(!part.records->adapter.valid_crc)) {
-            partitions_dispatched.push_back(ss::now());
             partitions_produced.push_back(
               ss::make_ready_future<produce_response::partition>(
                 produce_response::partition{
@@ -402,7 +584,6 @@ produce_topic(produce_ctx& octx, produce_request::topic& topic) {
         if (unlikely(
               !part.records->adapter.v2_format
               || !part.records->adapter.batch)) {
-            partitions_dispatched.push_back(ss::now());
             partitions_produced.push_back(
               ss::make_ready_future<produce_response::partition>(
                 produce_response::partition{
@@ -411,40 +592,47 @@ produce_topic(produce_ctx& octx, produce_request::topic& topic) {
             continue;
         }
 
-        auto pr = produce_topic_partition(octx, topic, part);
-        partitions_produced.push_back(std::move(pr.produced));
-        partitions_dispatched.push_back(std::move(pr.dispatched));
+        partitions_produced.push_back(
+          produce_topic_partition(octx, topic, part, shards));
     }
 
     // collect partition responses and build the topic response
-    return topic_produce_stages{
-      .dispatched = ss::when_all_succeed(
-        partitions_dispatched.begin(), partitions_dispatched.end()),
-      .produced
-      = ss::when_all_succeed(
-          partitions_produced.begin(), partitions_produced.end())
-          .then([name = std::move(topic.name)](
-                  std::vector<produce_response::partition> parts) mutable {
-              return produce_response::topic{
-                .name = std::move(name),
-                .partitions = std::move(parts),
-              };
-          }),
-    };
+    return ss::when_all_succeed(
+             partitions_produced.begin(), partitions_produced.end())
+      .then([name = std::move(topic.name)](
+              std::vector<produce_response::partition> parts) mutable {
+          return produce_response::topic{
+            .name = std::move(name),
+            .partitions = std::move(parts),
+          };
+      });
 }
 
 /**
  * \brief Dispatch and collect topic produce responses
+ *
+ * Partition requests are grouped by shard so that every shard receives all
+ * of its partitions in a single cross shard call and reports back once when
+ * they were all enqueued.
  */
-static std::vector<topic_produce_stages> produce_topics(produce_ctx& octx) {
-    std::vector<topic_produce_stages> topics;
-    topics.reserve(octx.request.data.topics.size());
+static produce_stages produce_topics(produce_ctx& octx) {
+    std::vector<shard_produce> shards(ss::smp::count);
+    produce_stages stages;
+    stages.produced.reserve(octx.request.data.topics.size());
 
     for (auto& topic : octx.request.data.topics) {
-        topics.push_back(produce_topic(octx, topic));
+        stages.produced.push_back(produce_topic(octx, topic, shards));
     }
 
-    return topics;
+    std::vector<ss::future<>> dispatched;
+    dispatched.reserve(shards.size());
+    for (ss::shard_id shard = 0; shard < shards.size(); ++shard) {
+        dispatched.push_back(
+          dispatch_shard_produce(octx, shard, std::move(shards[shard])));
+    }
+    stages.dispatched = ss::when_all_succeed(
+      dispatched.begin(), dispatched.end());
+    return stages;
 }
 
 process_result_stages
@@ -532,19 +720,10 @@ produce_handler::handle(request_context ctx, ss::smp_service_group ssg) {
 
           // dispatch produce requests for each topic
           auto stages = produce_topics(octx);
-          std::vector<ss::future<>> dispatched;
-          std::vector<ss::future<produce_response::topic>> produced;
-          dispatched.reserve(stages.size());
-          produced.reserve(stages.size());
-
-          for (auto& s : stages) {
-              dispatched.push_back(std::move(s.dispatched));
-              produced.push_back(std::move(s.produced));
-          }
-          return seastar::when_all_succeed(dispatched.begin(), dispatched.end())
+          return std::move(stages.dispatched)
             .then_wrapped([&octx,
                            dispatched_promise = std::move(dispatched_promise),
-                           produced = std::move(produced)](
+                           produced = std::move(stages.produced)](
                             ss::future<> f) mutable {
                 try {
                     f.get();
@@ -554,6 +733,17 @@ produce_handler::handle(request_context ctx, ss::smp_service_group ssg) {
                       .then(
                         [&octx](std::vector<produce_response::topic> topics) {
                             octx.response.data.responses = std::move(topics);
+                            if (
+                              octx.throttle
+                              > ss::lowres_clock::duration(0)) {
+                                octx.rctx.connection()->delay_requests(
+                                  octx.throttle);
+                            }
+                            octx.response.data.throttle_time_ms = std::max(
+                              std::chrono::duration_cast<
+                                std::chrono::milliseconds>(octx.throttle),
+                              std::chrono::milliseconds(
+                                octx.rctx.throttle_delay_ms()));
                         })
                       .then([&octx] {
                           // send response immediately
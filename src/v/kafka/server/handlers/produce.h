@@ -21,4 +21,7 @@ struct produce_handler {
     static process_result_stages handle(request_context, ss::smp_service_group);
 };
 
+/// Error code of a partition produce response for a failed replication
+error_code map_produce_error_code(std::error_code);
+
 } // namespace kafka
@@ -111,6 +111,10 @@ cluster::topic_configuration to_cluster_type(const creatable_topic& t) {
         config_entries, topic_property_retention_duration);
     cfg.properties.recovery = get_bool_value(
       config_entries, topic_property_recovery);
+    cfg.properties.in_memory = get_bool_value(
+      config_entries, topic_property_in_memory);
+    cfg.properties.write_caching = get_bool_value(
+      config_entries, topic_property_write_caching);
 
     return cfg;
 }
@@ -47,6 +47,10 @@ static constexpr std::string_view topic_property_retention_duration
   = "retention.ms";
 static constexpr std::string_view topic_property_recovery
   = "x-redpanda-recovery";
+static constexpr std::string_view topic_property_in_memory
+  = "x-redpanda-in-memory";
+static constexpr std::string_view topic_property_write_caching
+  = "x-redpanda-write-caching";
 
 // Data-policy property
 static constexpr std::string_view topic_property_data_policy_function_name
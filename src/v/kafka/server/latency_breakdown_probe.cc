@@ -0,0 +1,92 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/server/latency_breakdown_probe.h"
+
+#include "config/configuration.h"
+#include "kafka/protocol/fetch.h"
+#include "kafka/protocol/produce.h"
+#include "prometheus/prometheus_sanitize.h"
+
+#include <seastar/core/metrics.hh>
+
+namespace kafka {
+
+latency_breakdown_probe::latency_breakdown_probe()
+  : _enabled(
+    config::shard_local_cfg().kafka_latency_breakdown()
+    && !config::shard_local_cfg().disable_metrics())
+  , _max_clients(
+      config::shard_local_cfg().kafka_latency_breakdown_max_clients()) {}
+
+latency_breakdown_probe::stages* latency_breakdown_probe::get(
+  api_key key, std::optional<std::string_view> client_id) {
+    if (!_enabled) {
+        return nullptr;
+    }
+    if (key == produce_api::key) {
+        return &get_client(client_id).produce;
+    }
+    if (key == fetch_api::key) {
+        return &get_client(client_id).fetch;
+    }
+    return nullptr;
+}
+
+latency_breakdown_probe::client&
+latency_breakdown_probe::get_client(std::optional<std::string_view> client_id) {
+    static const ss::sstring other = "other";
+    ss::sstring name(client_id.value_or(std::string_view{}));
+    if (auto it = _clients.find(name); it != _clients.end()) {
+        return it->second;
+    }
+    if (_clients.size() >= _max_clients) {
+        name = other;
+        if (auto it = _clients.find(name); it != _clients.end()) {
+            return it->second;
+        }
+    }
+    auto [it, _] = _clients.try_emplace(name);
+    setup_metrics(it->first, it->second);
+    return it->second;
+}
+
+void latency_breakdown_probe::setup_metrics(
+  const ss::sstring& name, client& c) {
+    namespace sm = ss::metrics;
+
+    auto client_label = sm::label("client_id");
+    auto request_label = sm::label("request");
+    auto stage_label = sm::label("stage");
+
+    auto hist = [&](const char* request, stages& s, request_stage stage) {
+        static constexpr std::array<const char*, request_stage_count> names = {
+          "queue", "handler", "response_write"};
+        return sm::make_histogram(
+          "stage_latency_us",
+          sm::description("Time spent by requests in a processing stage"),
+          {client_label(name),
+           request_label(request),
+           stage_label(names[static_cast<size_t>(stage)])},
+          [&s, stage] { return s.get(stage).seastar_histogram_logform(); });
+    };
+
+    c.metrics.add_group(
+      prometheus_sanitize::metrics_name("kafka:latency_breakdown"),
+      {
+        hist(produce_api::name, c.produce, request_stage::queue),
+        hist(produce_api::name, c.produce, request_stage::handler),
+        hist(produce_api::name, c.produce, request_stage::response_write),
+        hist(fetch_api::name, c.fetch, request_stage::queue),
+        hist(fetch_api::name, c.fetch, request_stage::handler),
+        hist(fetch_api::name, c.fetch, request_stage::response_write),
+      });
+}
+
+} // namespace kafka
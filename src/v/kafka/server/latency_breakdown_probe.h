@@ -0,0 +1,98 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "kafka/types.h"
+#include "seastarx.h"
+#include "utils/log_hist.h"
+
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/sstring.hh>
+
+#include <absl/container/node_hash_map.h>
+
+#include <array>
+#include <chrono>
+#include <optional>
+#include <string_view>
+
+namespace kafka {
+
+/// Stages of the processing of a request by the connection.
+enum class request_stage : uint8_t {
+    /// from the header being read to the request being dispatched: quota
+    /// throttling, connection window, memory and queue depth units
+    queue,
+    /// from dispatch to the response being ready
+    handler,
+    /// from the response being ready to it being written, including the
+    /// wait for the responses of the earlier requests of the connection
+    response_write,
+};
+
+inline constexpr size_t request_stage_count = 3;
+
+/// \brief opt-in histograms of the time produce and fetch requests spend in
+/// each request_stage, per client id.
+///
+/// The first kafka_latency_breakdown_max_clients client ids seen by the
+/// shard get their own series, the requests of further clients are
+/// accounted under the "other" client to bound the cardinality.
+class latency_breakdown_probe {
+public:
+    using hist_t = log_hist<std::chrono::microseconds>;
+    using clock_type = hist_t::clock_type;
+
+    /// histograms of a client and request type, stable for the lifetime
+    /// of the probe
+    class stages {
+    public:
+        void record(request_stage s, clock_type::duration d) noexcept {
+            _hists[static_cast<size_t>(s)].record(
+              std::chrono::duration_cast<std::chrono::microseconds>(d));
+        }
+        const hist_t& get(request_stage s) const {
+            return _hists[static_cast<size_t>(s)];
+        }
+
+    private:
+        std::array<hist_t, request_stage_count> _hists;
+    };
+
+    latency_breakdown_probe();
+    latency_breakdown_probe(const latency_breakdown_probe&) = delete;
+    latency_breakdown_probe& operator=(const latency_breakdown_probe&)
+      = delete;
+    latency_breakdown_probe(latency_breakdown_probe&&) = delete;
+    latency_breakdown_probe& operator=(latency_breakdown_probe&&) = delete;
+    ~latency_breakdown_probe() = default;
+
+    /// the histograms of the request, nullptr when the breakdown is
+    /// disabled or the request is neither a produce nor a fetch
+    stages* get(api_key, std::optional<std::string_view> client_id);
+
+private:
+    struct client {
+        stages produce;
+        stages fetch;
+        ss::metrics::metric_groups metrics;
+    };
+
+    client& get_client(std::optional<std::string_view> client_id);
+    void setup_metrics(const ss::sstring& name, client&);
+
+    bool _enabled;
+    size_t _max_clients;
+    absl::node_hash_map<ss::sstring, client> _clients;
+};
+
+} // namespace kafka
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#pragma once
+
+#include "kafka/protocol/metadata.h"
+
+#include <optional>
+#include <vector>
+
+namespace kafka {
+
+/**
+ * Topic responses of all the topics in the kafka namespace, as returned for
+ * metadata requests listing all topics. Building them requires copying the
+ * metadata of every topic and looking up the leader of every partition, with
+ * many topics and clients polling metadata frequently it dominates the
+ * request handling. The responses are rebuilt only when the version of the
+ * cluster topics metadata changed.
+ *
+ * Cached responses do not carry authorized operations, those depend on the
+ * requesting principal.
+ */
+class metadata_response_cache {
+public:
+    using topics_t = std::vector<metadata_response::topic>;
+
+    /// returns the cached responses if they were built at given version
+    const topics_t* get(uint64_t version) const {
+        if (!_topics || _version != version) {
+            return nullptr;
+        }
+        return &*_topics;
+    }
+
+    const topics_t& put(uint64_t version, topics_t topics) {
+        _version = version;
+        _topics = std::move(topics);
+        return *_topics;
+    }
+
+private:
+    uint64_t _version{0};
+    std::optional<topics_t> _topics;
+};
+
+} // namespace kafka
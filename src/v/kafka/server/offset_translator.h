@@ -7,6 +7,15 @@ namespace kafka {
 /**
  * Offset translator performs conversion between kafka offsets, which doesn't
  * include raft configuration batches and log offsets which includes
+ *
+ * Configuration batches split the log into ranges of offsets sharing the same
+ * delta. The range of the last lookup in each direction is cached, consumers
+ * and producers mostly translate consecutive offsets near the tail of the log
+ * which are then served without searching the configuration manager. Cached
+ * ranges are dropped whenever the configuration manager changes. Since the
+ * configurations, with their indices, are persisted by the configuration
+ * manager in the kvstore, the translator does not keep any state that would
+ * have to be rebuilt from the log on startup.
  */
 class offset_translator {
 public:
@@ -23,13 +32,18 @@ public:
         if (kafka_offset == model::offset::max()) {
             return kafka_offset;
         }
+        if (_kafka_range.contains(_cfg_mgr.version(), kafka_offset)) {
+            return kafka_offset + _kafka_range.delta;
+        }
 
         auto next_cfg_it = _cfg_mgr.lower_bound(std::max(hint, kafka_offset));
         // fast exit, current offset is larger than last config batch
         // offset, just add delta
         if (next_cfg_it == _cfg_mgr.end()) {
             --next_cfg_it;
-            return kafka_offset + next_cfg_it->second.idx();
+            auto delta = next_cfg_it->second.idx();
+            cache_kafka_range(next_cfg_it, model::offset::max(), delta);
+            return kafka_offset + delta;
         }
 
         auto delta = model::offset(next_cfg_it->second.idx() - 1);
@@ -43,17 +57,78 @@ public:
             // delta
             ++delta;
             if (next_cfg_it == _cfg_mgr.end()) {
+                max_cfg_ko = model::offset::max();
                 break;
             }
             max_cfg_ko = next_cfg_it->first - delta;
         }
+        if (next_cfg_it != _cfg_mgr.begin()) {
+            cache_kafka_range(std::prev(next_cfg_it), max_cfg_ko, delta());
+        }
         return kafka_offset + delta;
     }
 
 private:
-    int64_t delta(model::offset o) const { return _cfg_mgr.offset_delta(o); }
+    /**
+     * Range of either log or kafka offsets, bounds included, translated with
+     * the same delta. Valid for a single version of the configuration manager.
+     */
+    struct cached_range {
+        uint64_t version{0};
+        model::offset first = model::offset::max();
+        model::offset last = model::offset::min();
+        int64_t delta{0};
+
+        bool contains(uint64_t v, model::offset o) const {
+            return version == v && first <= o && o <= last;
+        }
+    };
+
+    int64_t delta(model::offset o) const {
+        if (_log_range.contains(_cfg_mgr.version(), o)) {
+            return _log_range.delta;
+        }
+        // mirrors configuration_manager::offset_delta, the offsets between
+        // the previous configuration (exclusive) and the next one (inclusive)
+        // share the delta
+        auto it = _cfg_mgr.lower_bound(o);
+        if (it == _cfg_mgr.begin()) {
+            return _cfg_mgr.offset_delta(o);
+        }
+        auto prev = std::prev(it);
+        _log_range = cached_range{
+          .version = _cfg_mgr.version(),
+          .first = prev->first + model::offset(1),
+          .last = it == _cfg_mgr.end() ? model::offset::max() : it->first,
+          .delta = prev->second.idx(),
+        };
+        return _log_range.delta;
+    }
+
+    /// caches the kafka offsets of data batches following the configuration
+    /// at `cfg_it` and translated with `delta`, up to `end` exclusive
+    void cache_kafka_range(
+      raft::configuration_manager::const_iterator cfg_it,
+      model::offset end,
+      int64_t delta) const {
+        if (cfg_it->second.idx() != delta) {
+            return;
+        }
+        // the initial configuration is not a batch in the log
+        auto first = cfg_it->first == model::offset::min()
+                       ? model::offset::min()
+                       : cfg_it->first + model::offset(1) - model::offset(delta);
+        _kafka_range = cached_range{
+          .version = _cfg_mgr.version(),
+          .first = first,
+          .last = end == model::offset::max() ? end : end - model::offset(1),
+          .delta = delta,
+        };
+    }
 
     const raft::configuration_manager& _cfg_mgr;
+    mutable cached_range _log_range;
+    mutable cached_range _kafka_range;
 };
 
 } // namespace kafka
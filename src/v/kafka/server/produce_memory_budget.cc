@@ -0,0 +1,38 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "kafka/server/produce_memory_budget.h"
+
+#include "resource_mgmt/memory_groups.h"
+
+#include <algorithm>
+
+namespace kafka {
+
+produce_memory_budget::produce_memory_budget()
+  : _capacity(memory_groups::kafka_total_memory())
+  , _sem(_capacity) {}
+
+ss::future<ss::semaphore_units<>>
+produce_memory_budget::reserve(size_t bytes) {
+    return ss::get_units(_sem, std::min(bytes, _capacity));
+}
+
+size_t produce_memory_budget::available() const {
+    return static_cast<size_t>(std::max<ssize_t>(0, _sem.available_units()));
+}
+
+produce_memory_budget& local_produce_memory_budget() {
+    static thread_local produce_memory_budget budget;
+    return budget;
+}
+
+} // namespace kafka
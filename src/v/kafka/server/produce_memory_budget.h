@@ -0,0 +1,50 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/semaphore.hh>
+
+namespace kafka {
+
+/// Bytes of produced batches in flight on the shard of their partitions.
+///
+/// The memory of a request is reserved on the shard of its connection, from
+/// the socket read until the response is sent. The partitions of a request
+/// are appended on their own shards though, a shard leading the busy
+/// partitions receives the batches read by the connections of all the shards
+/// until raft takes them in its replicate batcher.
+///
+/// The batches dispatched to a shard hold units of its budget until they
+/// were enqueued. A shard without budget left delays the dispatch, which
+/// delays the next reads of the connections producing to it.
+class produce_memory_budget {
+public:
+    produce_memory_budget();
+
+    /// Units for the bytes of the batches, at most the whole budget so that
+    /// a batch larger than the budget waits for all the others
+    ss::future<ss::semaphore_units<>> reserve(size_t bytes);
+
+    size_t capacity() const { return _capacity; }
+    size_t available() const;
+
+private:
+    size_t _capacity;
+    ss::semaphore _sem;
+};
+
+/// Budget of the shard
+produce_memory_budget& local_produce_memory_budget();
+
+} // namespace kafka
@@ -51,7 +51,9 @@ protocol::protocol(
   ss::sharded<cluster::controller_api>& controller_api,
   ss::sharded<cluster::tx_gateway_frontend>& tx_gateway_frontend,
   ss::sharded<v8_engine::data_policy_table>& data_policy_table,
-  std::optional<qdc_monitor::config> qdc_config) noexcept
+  ss::sharded<ssx::smp_batcher>& smp_batcher,
+  std::optional<qdc_monitor::config> qdc_config,
+  std::vector<tenant_scheduling_group> tenants) noexcept
   : _smp_group(smp)
   , _topics_frontend(tf)
   , _metadata_cache(meta)
@@ -71,11 +73,22 @@ protocol::protocol(
   , _security_frontend(sec_fe)
   , _controller_api(controller_api)
   , _tx_gateway_frontend(tx_gateway_frontend)
-  , _data_policy_table(data_policy_table) {
+  , _data_policy_table(data_policy_table)
+  , _smp_batcher(smp_batcher)
+  , _tenants(std::move(tenants)) {
     if (qdc_config) {
         _qdc_mon.emplace(*qdc_config);
     }
+    if (config::shard_local_cfg().kafka_concurrency_limit_enable()) {
+        _concurrency_limit.emplace(adaptive_concurrency_limit::config{
+          .target_latency
+          = config::shard_local_cfg().kafka_concurrency_limit_target_ms(),
+          .min_limit = config::shard_local_cfg().kafka_concurrency_limit_min(),
+          .max_limit = config::shard_local_cfg().kafka_concurrency_limit_max(),
+        });
+    }
     _probe.setup_metrics();
+    _connection_load.setup_metrics();
 }
 
 ss::future<> protocol::apply(rpc::server::resources rs) {
@@ -14,12 +14,19 @@
 #include "cluster/fwd.h"
 #include "config/configuration.h"
 #include "kafka/latency_probe.h"
+#include "kafka/server/connection_load_probe.h"
+#include "kafka/server/latency_breakdown_probe.h"
 #include "kafka/server/fetch_metadata_cache.hh"
 #include "kafka/server/fwd.h"
+#include "kafka/server/metadata_response_cache.h"
 #include "kafka/server/queue_depth_monitor.h"
+#include "resource_mgmt/cpu_scheduling.h"
+#include "resource_mgmt/foreground_latency.h"
 #include "rpc/server.h"
 #include "security/authorizer.h"
 #include "security/credential_store.h"
+#include "ssx/smp_batcher.h"
+#include "utils/adaptive_concurrency_limit.h"
 #include "utils/ema.h"
 #include "v8_engine/data_policy_table.h"
 
@@ -27,6 +34,10 @@
 #include <seastar/core/sharded.hh>
 #include <seastar/core/smp.hh>
 
+#include <optional>
+#include <string_view>
+#include <vector>
+
 namespace kafka {
 
 class protocol final : public rpc::server::protocol {
@@ -48,7 +59,9 @@ public:
       ss::sharded<cluster::controller_api>&,
       ss::sharded<cluster::tx_gateway_frontend>&,
       ss::sharded<v8_engine::data_policy_table>&,
-      std::optional<qdc_monitor::config>) noexcept;
+      ss::sharded<ssx::smp_batcher>&,
+      std::optional<qdc_monitor::config>,
+      std::vector<tenant_scheduling_group> = {}) noexcept;
 
     ~protocol() noexcept override = default;
     protocol(const protocol&) = delete;
@@ -101,12 +114,21 @@ public:
         return _data_policy_table.local();
     }
 
+    ssx::smp_batcher& smp_batcher() { return _smp_batcher.local(); }
+
     void update_produce_latency(std::chrono::steady_clock::duration x) {
+        foreground_latency::local().record(
+          std::chrono::duration_cast<std::chrono::microseconds>(x));
         if (_qdc_mon) {
             _qdc_mon->ema.update(x);
         }
     }
 
+    /// null unless kafka_concurrency_limit_enable is set
+    adaptive_concurrency_limit* concurrency_limit() {
+        return _concurrency_limit ? &*_concurrency_limit : nullptr;
+    }
+
     ss::future<ss::semaphore_units<>> get_request_unit() {
         if (_qdc_mon) {
             return _qdc_mon->qdc.get_unit();
@@ -123,7 +145,36 @@ public:
         return _fetch_metadata_cache;
     }
 
+    kafka::metadata_response_cache& get_metadata_response_cache() {
+        return _metadata_response_cache;
+    }
+
     latency_probe& probe() { return _probe; }
+    latency_breakdown_probe& breakdown_probe() { return _breakdown_probe; }
+    connection_load_probe& connection_load() { return _connection_load; }
+
+    /// The group of the tenant with the longest prefix of the client id,
+    /// std::nullopt if the client is not isolated.
+    std::optional<ss::scheduling_group>
+    tenant_sg(std::optional<std::string_view> client_id) const {
+        if (!client_id) {
+            return std::nullopt;
+        }
+        const tenant_scheduling_group* match = nullptr;
+        for (const auto& t : _tenants) {
+            if (
+              client_id->starts_with(t.client_id_prefix)
+              && (!match
+                  || t.client_id_prefix.size()
+                       > match->client_id_prefix.size())) {
+                match = &t;
+            }
+        }
+        if (!match) {
+            return std::nullopt;
+        }
+        return match->sg;
+    }
 
 private:
     ss::smp_service_group _smp_group;
@@ -144,10 +195,16 @@ private:
     ss::sharded<cluster::controller_api>& _controller_api;
     ss::sharded<cluster::tx_gateway_frontend>& _tx_gateway_frontend;
     ss::sharded<v8_engine::data_policy_table>& _data_policy_table;
+    ss::sharded<ssx::smp_batcher>& _smp_batcher;
     std::optional<qdc_monitor> _qdc_mon;
+    std::optional<adaptive_concurrency_limit> _concurrency_limit;
     kafka::fetch_metadata_cache _fetch_metadata_cache;
+    kafka::metadata_response_cache _metadata_response_cache;
+    std::vector<tenant_scheduling_group> _tenants;
 
     latency_probe _probe;
+    latency_breakdown_probe _breakdown_probe;
+    connection_load_probe _connection_load;
 };
 
 } // namespace kafka
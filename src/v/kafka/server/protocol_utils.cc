@@ -89,20 +89,21 @@ ss::future<std::optional<size_t>> parse_size(ss::input_stream<char>& src) {
       });
 }
 
-ss::scattered_message<char> response_as_scattered(response_ptr response) {
-    auto correlation = response->correlation();
+/// appends the framed \p response to \p msg, \p chunk_no counts the
+/// fragments of the message
+static void append_framed(
+  ss::scattered_message<char>& msg, response& response, int32_t& chunk_no) {
+    auto correlation = response.correlation();
     auto header = ss::temporary_buffer<char>(sizeof(raw_response_header));
     // NOLINTNEXTLINE
     auto* raw_header = reinterpret_cast<raw_response_header*>(
       header.get_write());
-    auto size = int32_t(sizeof(correlation) + response->buf().size_bytes());
+    auto size = int32_t(sizeof(correlation) + response.buf().size_bytes());
     raw_header->size = ss::cpu_to_be(size);
     raw_header->correlation = ss::cpu_to_be(correlation());
-    auto& buf = response->buf();
+    auto& buf = response.buf();
     buf.prepend(std::move(header));
-    ss::scattered_message<char> msg;
     auto in = iobuf::iterator_consumer(buf.cbegin(), buf.cend());
-    int32_t chunk_no = 0;
     in.consume(
       buf.size_bytes(), [&msg, &chunk_no, &buf](const char* src, size_t sz) {
           ++chunk_no;
@@ -115,9 +116,26 @@ ss::scattered_message<char> response_as_scattered(response_ptr response) {
           msg.append_static(src, sz);
           return ss::stop_iteration::no;
       });
+}
+
+ss::scattered_message<char> response_as_scattered(response_ptr response) {
+    ss::scattered_message<char> msg;
+    int32_t chunk_no = 0;
+    append_framed(msg, *response, chunk_no);
     // MUST be the foreign ptr not the iobuf
     msg.on_delete([response = std::move(response)] {});
     return msg;
 }
 
+ss::scattered_message<char>
+responses_as_scattered(std::vector<response_ptr> responses) {
+    ss::scattered_message<char> msg;
+    int32_t chunk_no = 0;
+    for (auto& r : responses) {
+        append_framed(msg, *r, chunk_no);
+    }
+    msg.on_delete([responses = std::move(responses)] {});
+    return msg;
+}
+
 } // namespace kafka
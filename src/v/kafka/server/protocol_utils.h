@@ -20,6 +20,7 @@
 #include <seastar/core/temporary_buffer.hh>
 
 #include <optional>
+#include <vector>
 
 namespace kafka {
 
@@ -31,4 +32,9 @@ ss::future<std::optional<size_t>> parse_size(ss::input_stream<char>&);
 
 ss::scattered_message<char> response_as_scattered(response_ptr response);
 
+/// frames the responses one after the other in a single message, so that
+/// they are handed to the socket in one write
+ss::scattered_message<char>
+responses_as_scattered(std::vector<response_ptr> responses);
+
 } // namespace kafka
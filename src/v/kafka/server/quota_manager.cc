@@ -13,19 +13,52 @@
 #include "kafka/server/logger.h"
 #include "vlog.h"
 
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/smp.hh>
+
+#include <algorithm>
+
 namespace kafka {
 using clock = quota_manager::clock;
 using throttle_delay = quota_manager::throttle_delay;
 
-quota_manager::~quota_manager() { _gc_timer.cancel(); }
+// delay bringing the rate back to the target rate over a window
+static uint64_t throttle_delay_ms(
+  double rate, double target_rate, clock::duration window_size) {
+    if (rate <= target_rate) {
+        return 0;
+    }
+    auto diff = rate - target_rate;
+    double delay
+      = (diff / target_rate)
+        * (double)std::chrono::duration_cast<std::chrono::milliseconds>(
+            window_size)
+            .count();
+    return static_cast<uint64_t>(delay);
+}
+
+quota_manager::~quota_manager() {
+    _gc_timer.cancel();
+    _reconciliation_timer.cancel();
+}
 
 ss::future<> quota_manager::stop() {
     _gc_timer.cancel();
-    return ss::make_ready_future<>();
+    _reconciliation_timer.cancel();
+    return _gate.close();
 }
 
 ss::future<> quota_manager::start() {
     _gc_timer.arm_periodic(_gc_freq);
+    if (ss::this_shard_id() == 0 && ss::smp::count > 1) {
+        _reconciliation_timer.set_callback([this] {
+            (void)ss::with_gate(_gate, [this] { return reconcile(); })
+              .handle_exception([](const std::exception_ptr& e) {
+                  vlog(klog.debug, "Quota reconciliation failed: {}", e);
+              });
+        });
+        _reconciliation_timer.arm_periodic(_reconciliation_freq);
+    }
     return ss::make_ready_future<>();
 }
 
@@ -57,19 +90,12 @@ throttle_delay quota_manager::record_tp_and_throttle(
         it->second.last_seen = now;
     }
 
-    auto rate = it->second.tp_rate.record_and_measure(bytes, now);
-
-    uint64_t delay_ms = 0;
-    if (rate > _target_tp_rate) {
-        auto diff = rate - _target_tp_rate;
-        double delay
-          = (diff / _target_tp_rate)
-            * (double)std::chrono::duration_cast<std::chrono::milliseconds>(
-                it->second.tp_rate.window_size())
-                .count();
-        delay_ms = static_cast<uint64_t>(delay);
-    }
-    if (delay_ms > (uint64_t)_max_delay.count()) {
+    auto rate = it->second.tp_rate.record_and_measure(bytes, now)
+                + it->second.remote_rate;
+
+    uint64_t delay_ms = throttle_delay_ms(
+      rate, _target_tp_rate(), it->second.tp_rate.window_size());
+    if (delay_ms > (uint64_t)_max_delay().count()) {
         vlog(
           klog.info,
           "Found data rate for window of: {} bytes. Client:{}, Estimated "
@@ -77,8 +103,8 @@ throttle_delay quota_manager::record_tp_and_throttle(
           rate,
           cid,
           delay_ms,
-          _max_delay.count());
-        delay_ms = _max_delay.count();
+          _max_delay().count());
+        delay_ms = _max_delay().count();
     }
 
     auto prev = it->second.delay;
@@ -89,6 +115,88 @@ throttle_delay quota_manager::record_tp_and_throttle(
     res.duration = it->second.delay;
     return res;
 }
+clock::duration quota_manager::record_partition_tp_and_throttle(
+  throughput_type type,
+  const model::ntp& ntp,
+  uint64_t bytes,
+  clock::time_point now) {
+    const auto& partition_rate = type == throughput_type::produce
+                                   ? _partition_produce_rate()
+                                   : _partition_fetch_rate();
+    const auto& topic_rate = type == throughput_type::produce
+                               ? _topic_produce_rate()
+                               : _topic_fetch_rate();
+    clock::duration delay(0);
+    if (partition_rate) {
+        auto [it, _] = _partition_quotas.try_emplace(
+          ntp, _default_num_windows, _default_window_width);
+        delay = record_and_throttle(
+          it->second, type, partition_rate, bytes, now);
+    }
+    if (topic_rate) {
+        auto [it, _] = _topic_quotas.try_emplace(
+          ntp.tp.topic, _default_num_windows, _default_window_width);
+        delay = std::max(
+          delay, record_and_throttle(it->second, type, topic_rate, bytes, now));
+    }
+    return std::min<clock::duration>(delay, _max_delay());
+}
+
+clock::duration quota_manager::record_and_throttle(
+  partition_quota& q,
+  throughput_type type,
+  std::optional<size_t> target_rate,
+  uint64_t bytes,
+  clock::time_point now) {
+    q.last_seen = now;
+    auto& tracker = q.rate(type);
+    auto rate = tracker.record_and_measure(bytes, now);
+    return std::chrono::milliseconds(
+      throttle_delay_ms(rate, *target_rate, tracker.window_size()));
+}
+
+ss::future<> quota_manager::reconcile() {
+    auto node_rates = co_await container().map_reduce0(
+      [](quota_manager& qm) { return qm.report_rates(); },
+      rates_t{},
+      [](rates_t acc, const rates_t& rates) {
+          for (const auto& [cid, rate] : rates) {
+              acc[cid] += rate;
+          }
+          return acc;
+      });
+    co_await container().invoke_on_all([&node_rates](quota_manager& qm) {
+        if (!qm._gate.is_closed()) {
+            qm.update_remote_rates(node_rates);
+        }
+    });
+}
+
+quota_manager::rates_t quota_manager::report_rates() {
+    rates_t rates;
+    if (_gate.is_closed()) {
+        return rates;
+    }
+    auto now = clock::now();
+    rates.reserve(_quotas.size());
+    for (auto& [cid, q] : _quotas) {
+        q.reported_rate = q.tp_rate.measure(now);
+        rates.emplace(cid, q.reported_rate);
+    }
+    return rates;
+}
+
+void quota_manager::update_remote_rates(const rates_t& node_rates) {
+    for (auto& [cid, q] : _quotas) {
+        auto it = node_rates.find(cid);
+        if (it == node_rates.end()) {
+            // the client appeared after the rates were reported
+            continue;
+        }
+        q.remote_rate = std::max(0., it->second - q.reported_rate);
+    }
+}
+
 // erase inactive tracked quotas. windows are considered inactive if they
 // have not received any updates in ten window's worth of time.
 void quota_manager::gc(clock::duration full_window) {
@@ -99,6 +207,11 @@ void quota_manager::gc(clock::duration full_window) {
       _quotas, [now, expire_age](const std::pair<ss::sstring, quota>& q) {
           return (now - q.second.last_seen) > expire_age;
       });
+    auto is_expired = [now, expire_age](const auto& q) {
+        return (now - q.second.last_seen) > expire_age;
+    };
+    absl::erase_if(_partition_quotas, is_expired);
+    absl::erase_if(_topic_quotas, is_expired);
 }
 
 } // namespace kafka
@@ -11,11 +11,14 @@
 
 #pragma once
 #include "config/configuration.h"
+#include "model/fundamental.h"
 #include "resource_mgmt/rate.h"
 #include "seastarx.h"
 
 #include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
 #include <seastar/core/lowres_clock.hh>
+#include <seastar/core/sharded.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/core/timer.hh>
 
@@ -40,11 +43,20 @@ namespace kafka {
 //      - splitting out rates separately for produce and fetch
 //      - accounting per user vs per client (these are separate in kafka)
 //
-//   - it may eventually be beneficial to periodically reduce stats across
-//   shards or track stats globally to produce a more accurate per-node
-//   representation of a statistic (e.g. bandwidth).
+// throughput is recorded on the shard handling the request. the connections of
+// a client may be spread over several shards, so every
+// quota_manager_reconciliation_ms the rates of all clients are reduced across
+// shards on shard 0 and each shard learns the rate of its clients on the other
+// shards. throttling is based on the node wide rate of the client without any
+// cross shard communication on the request path.
 //
-class quota_manager {
+// the throughput of partitions and of the partitions of a topic managed by a
+// shard may be limited separately for produce and fetch. it is recorded on the
+// shard managing the partition, every byte of a partition goes through it.
+// requests exceeding the limits are not rejected, the response carries the
+// throttle time and the connection delays its next requests.
+//
+class quota_manager : public ss::peering_sharded_service<quota_manager> {
 public:
     using clock = ss::lowres_clock;
 
@@ -53,12 +65,25 @@ public:
         clock::duration duration;
     };
 
+    enum class throughput_type { produce, fetch };
+
     quota_manager()
       : _default_num_windows(config::shard_local_cfg().default_num_windows())
       , _default_window_width(config::shard_local_cfg().default_window_sec())
-      , _target_tp_rate(config::shard_local_cfg().target_quota_byte_rate())
+      , _target_tp_rate(config::shard_local_cfg().target_quota_byte_rate.bind())
       , _gc_freq(config::shard_local_cfg().quota_manager_gc_sec())
-      , _max_delay(config::shard_local_cfg().max_kafka_throttle_delay_ms()) {
+      , _max_delay(
+          config::shard_local_cfg().max_kafka_throttle_delay_ms.bind())
+      , _reconciliation_freq(
+          config::shard_local_cfg().quota_manager_reconciliation_ms())
+      , _partition_produce_rate(
+          config::shard_local_cfg().target_partition_produce_byte_rate.bind())
+      , _partition_fetch_rate(
+          config::shard_local_cfg().target_partition_fetch_byte_rate.bind())
+      , _topic_produce_rate(
+          config::shard_local_cfg().target_topic_produce_byte_rate.bind())
+      , _topic_fetch_rate(
+          config::shard_local_cfg().target_topic_fetch_byte_rate.bind()) {
         auto full_window = _default_num_windows * _default_window_width;
         _gc_timer.set_callback([this, full_window] { gc(full_window); });
     }
@@ -80,30 +105,86 @@ public:
       uint64_t bytes,
       clock::time_point now = clock::now());
 
+    // record bytes produced to or fetched from a partition managed by this
+    // shard and return the delay keeping the partition and its topic within
+    // their limits
+    clock::duration record_partition_tp_and_throttle(
+      throughput_type type,
+      const model::ntp& ntp,
+      uint64_t bytes,
+      clock::time_point now = clock::now());
+
 private:
+    using rates_t = absl::flat_hash_map<ss::sstring, double>;
+
     // erase inactive tracked quotas. windows are considered inactive if they
     // have not received any updates in ten window's worth of time.
     void gc(clock::duration full_window);
 
+    // reduce the throughput of clients across shards, runs on shard 0
+    ss::future<> reconcile();
+    // throughput of the clients on this shard, remembered as reported
+    rates_t report_rates();
+    // update the throughput of clients on the other shards
+    void update_remote_rates(const rates_t& node_rates);
+
 private:
     // last_seen: used for gc keepalive
     // delay: last calculated delay
     // tp_rate: throughput tracking
+    // reported_rate: local rate reported in the last reconciliation
+    // remote_rate: rate on the other shards in the last reconciliation
     struct quota {
         clock::time_point last_seen;
         clock::duration delay;
         rate_tracker tp_rate;
+        double reported_rate{0.};
+        double remote_rate{0.};
     };
 
+    // produce and fetch throughput tracking of a partition or a topic
+    struct partition_quota {
+        partition_quota(size_t num_windows, clock::duration window_width)
+          : produce_rate(num_windows, window_width)
+          , fetch_rate(num_windows, window_width) {}
+
+        clock::time_point last_seen;
+        rate_tracker produce_rate;
+        rate_tracker fetch_rate;
+
+        rate_tracker& rate(throughput_type type) {
+            return type == throughput_type::produce ? produce_rate
+                                                    : fetch_rate;
+        }
+    };
+
+    clock::duration record_and_throttle(
+      partition_quota&,
+      throughput_type,
+      std::optional<size_t> target_rate,
+      uint64_t bytes,
+      clock::time_point now);
+
     const std::size_t _default_num_windows;
     const clock::duration _default_window_width;
 
-    const uint32_t _target_tp_rate;
+    config::binding<uint32_t> _target_tp_rate;
     absl::flat_hash_map<ss::sstring, quota> _quotas;
 
     ss::timer<> _gc_timer;
     const clock::duration _gc_freq;
-    const clock::duration _max_delay;
+    config::binding<std::chrono::milliseconds> _max_delay;
+
+    ss::timer<> _reconciliation_timer;
+    const clock::duration _reconciliation_freq;
+    ss::gate _gate;
+
+    config::binding<std::optional<size_t>> _partition_produce_rate;
+    config::binding<std::optional<size_t>> _partition_fetch_rate;
+    config::binding<std::optional<size_t>> _topic_produce_rate;
+    config::binding<std::optional<size_t>> _topic_fetch_rate;
+    absl::flat_hash_map<model::ntp, partition_quota> _partition_quotas;
+    absl::flat_hash_map<model::topic, partition_quota> _topic_quotas;
 };
 
 } // namespace kafka
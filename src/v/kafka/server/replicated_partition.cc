@@ -17,6 +17,7 @@
 
 #include <seastar/core/coroutine.hh>
 
+#include <algorithm>
 #include <optional>
 
 namespace kafka {
@@ -27,10 +28,33 @@ replicated_partition::replicated_partition(
       ss::make_lw_shared<offset_translator>(_partition->get_cfg_manager())){
 
     };
+model::offset replicated_partition::start_offset() const {
+    auto start = local_start_offset();
+    // offsets removed from the local disk may still be read from the cloud
+    if (const auto& remote = _partition->cloud_storage_partition(); remote) {
+        if (auto first = remote->first_offset(); first && *first < start) {
+            return *first;
+        }
+    }
+    return start;
+}
+
 // TODO: use previous translation speed up lookup
 ss::future<model::record_batch_reader> replicated_partition::make_reader(
   storage::log_reader_config cfg,
   std::optional<model::timeout_clock::time_point> deadline) {
+    if (const auto& remote = _partition->cloud_storage_partition(); remote) {
+        auto local_start = local_start_offset();
+        if (cfg.start_offset < local_start) {
+            // the archived segments use kafka offsets, the part of the range
+            // that is still on the local disk is read by the following fetch
+            cfg.max_offset = std::min(
+              cfg.max_offset, local_start - model::offset(1));
+            cfg.type_filter = {model::record_batch_type::raft_data};
+            co_return co_await remote->make_reader(cfg);
+        }
+    }
+
     cfg.start_offset = _translator->from_kafka_offset(cfg.start_offset);
     cfg.max_offset = _translator->from_kafka_offset(cfg.max_offset);
     cfg.type_filter = {model::record_batch_type::raft_data};
@@ -31,9 +31,7 @@ public:
 
     const model::ntp& ntp() const final { return _partition->ntp(); }
 
-    model::offset start_offset() const final {
-        return _translator->to_kafka_offset(_partition->start_offset());
-    }
+    model::offset start_offset() const final;
 
     model::offset high_watermark() const final {
         return _translator->to_kafka_offset(_partition->high_watermark());
@@ -81,6 +79,10 @@ public:
     cluster::partition_probe& probe() final { return _partition->probe(); }
 
 private:
+    model::offset local_start_offset() const {
+        return _translator->to_kafka_offset(_partition->start_offset());
+    }
+
     ss::lw_shared_ptr<cluster::partition> _partition;
     ss::lw_shared_ptr<offset_translator> _translator;
 };
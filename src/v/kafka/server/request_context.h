@@ -112,6 +112,8 @@ public:
         return _conn->server().tx_gateway_frontend();
     }
 
+    quota_manager& quota_mgr() { return _conn->server().quota_mgr(); }
+
     int32_t throttle_delay_ms() const {
         return std::chrono::duration_cast<std::chrono::milliseconds>(
                  _throttle_delay)
@@ -126,6 +128,8 @@ public:
         return _conn->server().partition_manager();
     }
 
+    ssx::smp_batcher& smp_batcher() { return _conn->server().smp_batcher(); }
+
     fetch_session_cache& fetch_sessions() {
         return _conn->server().fetch_sessions_cache();
     }
@@ -134,6 +138,10 @@ public:
         return _conn->server().get_fetch_metadata_cache();
     }
 
+    metadata_response_cache& get_metadata_response_cache() {
+        return _conn->server().get_metadata_response_cache();
+    }
+
     // clang-format off
     template<typename ResponseType>
     CONCEPT(requires requires (
@@ -0,0 +1,112 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/iobuf.h"
+#include "config/configuration.h"
+#include "kafka/server/batch_recompressor.h"
+#include "model/record_batch_reader.h"
+#include "storage/parser_utils.h"
+#include "storage/record_batch_builder.h"
+
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/defer.hh>
+
+static iobuf repeated(char c, size_t n) {
+    iobuf b;
+    ss::sstring s(n, c);
+    b.append(s.data(), s.size());
+    return b;
+}
+
+static model::record_batch make_batch(model::compression c) {
+    storage::record_batch_builder builder(
+      model::record_batch_type::raft_data, model::offset(0));
+    for (int i = 0; i < 10; ++i) {
+        builder.add_raw_kv(repeated('k', 16), repeated('v', 1024));
+    }
+    auto batch = std::move(builder).build();
+    if (c == model::compression::none) {
+        return batch;
+    }
+    return storage::internal::compress_batch(c, std::move(batch)).get0();
+}
+
+static void check_records(const model::record_batch& b, int32_t count) {
+    BOOST_REQUIRE_EQUAL(b.record_count(), count);
+    auto u = b.compressed()
+               ? storage::internal::decompress_batch(b).get0()
+               : b.copy();
+    u.for_each_record([](model::record r) {
+        BOOST_REQUIRE_EQUAL(r.value(), repeated('v', 1024));
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(recompress_to_topic_codec) {
+    kafka::batch_recompressor recompressor;
+    using c = model::compression;
+    for (auto [from, to] : std::vector<std::pair<c, c>>{
+           {c::none, c::gzip},
+           {c::none, c::lz4},
+           {c::none, c::zstd},
+           {c::gzip, c::none},
+           {c::gzip, c::zstd}}) {
+        auto batch = make_batch(from);
+        auto r = recompressor.recompress(batch, to).get0();
+        BOOST_REQUIRE_EQUAL(r.header().attrs.compression(), to);
+        BOOST_REQUIRE_EQUAL(r.header().producer_id, batch.header().producer_id);
+        BOOST_REQUIRE_EQUAL(
+          r.header().base_sequence, batch.header().base_sequence);
+        check_records(r, batch.record_count());
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(kept_if_not_smaller) {
+    kafka::batch_recompressor recompressor;
+    // a tiny batch does not get smaller with a zstd frame
+    storage::record_batch_builder builder(
+      model::record_batch_type::raft_data, model::offset(0));
+    builder.add_raw_kv(std::nullopt, repeated('v', 1));
+    auto batch = std::move(builder).build();
+    auto r = recompressor.recompress(batch, model::compression::zstd).get0();
+    BOOST_REQUIRE_EQUAL(r.header(), batch.header());
+}
+
+SEASTAR_THREAD_TEST_CASE(recompress_reader) {
+    kafka::batch_recompressor recompressor;
+    model::record_batch_reader::data_t batches;
+    batches.push_back(make_batch(model::compression::none));
+    batches.push_back(make_batch(model::compression::gzip));
+    auto reader = recompressor
+                    .recompress(
+                      model::make_foreign_memory_record_batch_reader(
+                        std::move(batches)),
+                      model::compression::zstd)
+                    .get0();
+    auto recompressed = model::consume_reader_to_memory(
+                          std::move(reader), model::no_timeout)
+                          .get0();
+    BOOST_REQUIRE_EQUAL(recompressed.size(), 2);
+    for (auto& b : recompressed) {
+        BOOST_REQUIRE_EQUAL(
+          b.header().attrs.compression(), model::compression::zstd);
+        check_records(b, 10);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(kept_as_produced_without_budget) {
+    auto& budget
+      = config::shard_local_cfg().kafka_recompression_cpu_budget_percent;
+    auto percent = budget();
+    budget.set_value(uint32_t(0));
+    auto reset = ss::defer([&budget, percent] { budget.set_value(percent); });
+    kafka::batch_recompressor recompressor;
+    auto batch = make_batch(model::compression::gzip);
+    auto r = recompressor.recompress(batch, model::compression::zstd).get0();
+    BOOST_REQUIRE_EQUAL(r.header(), batch.header());
+}
@@ -221,3 +221,44 @@ FIXTURE_TEST(test_session_operations, fixture) {
         BOOST_REQUIRE(cache.size() == 0);
     }
 }
+
+FIXTURE_TEST(test_session_eviction, fixture) {
+    // any session fills the cache
+    kafka::fetch_session_cache cache(120s, 1);
+    auto make_request = [](int partitions) {
+        kafka::fetch_request req;
+        req.data.session_epoch = kafka::initial_fetch_session_epoch;
+        req.data.session_id = kafka::invalid_fetch_session_id;
+        req.data.topics = {
+          make_fetch_request_topic(model::topic("test"), partitions)};
+        return req;
+    };
+
+    kafka::fetch_session_id first_id;
+    {
+        auto ctx = cache.maybe_get_session(make_request(3));
+        BOOST_REQUIRE_EQUAL(ctx.is_sessionless(), false);
+        first_id = ctx.session()->id();
+    }
+
+    BOOST_TEST_MESSAGE("smaller session does not replace an active one");
+    {
+        auto ctx = cache.maybe_get_session(make_request(2));
+        BOOST_REQUIRE_EQUAL(ctx.has_error(), false);
+        BOOST_REQUIRE_EQUAL(ctx.is_sessionless(), true);
+        BOOST_REQUIRE_EQUAL(cache.size(), 1);
+    }
+
+    BOOST_TEST_MESSAGE("bigger session replaces a smaller one");
+    {
+        auto ctx = cache.maybe_get_session(make_request(5));
+        BOOST_REQUIRE_EQUAL(ctx.is_sessionless(), false);
+        BOOST_REQUIRE_NE(ctx.session()->id(), first_id);
+        BOOST_REQUIRE_EQUAL(cache.size(), 1);
+
+        BOOST_TEST_MESSAGE("session in use is never evicted");
+        auto other = cache.maybe_get_session(make_request(10));
+        BOOST_REQUIRE_EQUAL(other.is_sessionless(), true);
+        BOOST_REQUIRE_EQUAL(cache.size(), 1);
+    }
+}
@@ -14,7 +14,9 @@
 #include "redpanda/tests/fixture.h"
 #include "resource_mgmt/io_priority.h"
 #include "test_utils/async.h"
+#include "units.h"
 
+#include <seastar/core/sleep.hh>
 #include <seastar/core/smp.hh>
 
 #include <chrono>
@@ -153,6 +155,42 @@ SEASTAR_THREAD_TEST_CASE(partition_iterator) {
 // TODO: when we have a more precise log builder tool we can make these finer
 // grained tests. for now the test is coarse grained based on the random batch
 // builder.
+SEASTAR_THREAD_TEST_CASE(release_foreign_read_result) {
+    struct foreign_read {
+        kafka::read_result result;
+        ss::foreign_ptr<std::unique_ptr<iobuf>> expected;
+        size_t fragments;
+    };
+    auto other = (ss::this_shard_id() + 1) % ss::smp::count;
+    auto read = ss::smp::submit_to(other, [] {
+                    auto data = std::make_unique<iobuf>();
+                    for (int i = 0; i < 10; ++i) {
+                        ss::temporary_buffer<char> buf(16_KiB);
+                        std::fill_n(buf.get_write(), buf.size(), i);
+                        data->append(std::move(buf));
+                    }
+                    auto expected = std::make_unique<iobuf>(data->copy());
+                    auto fragments = std::distance(data->begin(), data->end());
+                    return foreign_read{
+                      .result = kafka::read_result(
+                        ss::make_foreign(std::move(data)),
+                        model::offset(0),
+                        model::offset(10),
+                        model::offset(10),
+                        {}),
+                      .expected = ss::make_foreign(std::move(expected)),
+                      .fragments = static_cast<size_t>(fragments)};
+                }).get0();
+
+    auto data = std::move(read.result).release_data();
+    BOOST_REQUIRE_EQUAL(data.size_bytes(), 10 * 16_KiB);
+    BOOST_REQUIRE(data == *read.expected);
+    // fragments are shared with the foreign buffer, not copied
+    BOOST_REQUIRE_EQUAL(
+      static_cast<size_t>(std::distance(data.begin(), data.end())),
+      read.fragments);
+}
+
 FIXTURE_TEST(read_from_ntp_max_bytes, redpanda_thread_fixture) {
     auto do_read = [this](model::ntp ntp, size_t max_bytes) {
         kafka::fetch_config config{
@@ -204,6 +242,102 @@ FIXTURE_TEST(read_from_ntp_max_bytes, redpanda_thread_fixture) {
     BOOST_TEST(one <= maxlimit); // read more
 }
 
+FIXTURE_TEST(read_from_ntp_at_high_watermark, redpanda_thread_fixture) {
+    wait_for_controller_leadership().get0();
+    auto ntp = make_data(model::revision_id(2));
+
+    auto shard = app.shard_table.local().shard_for(ntp);
+    tests::cooperative_spin_wait_with_timeout(10s, [this, shard, ntp = ntp] {
+        return app.partition_manager.invoke_on(
+          *shard, [ntp](cluster::partition_manager& mgr) {
+              auto partition = mgr.get(ntp);
+              return partition
+                     && partition->committed_offset() >= model::offset(1);
+          });
+    }).get();
+
+    auto rctx = make_request_context();
+    auto octx = kafka::op_context(
+      std::move(rctx), ss::default_smp_service_group());
+    auto do_read = [&octx, shard, ntp](model::offset start) {
+        kafka::fetch_config config{
+          .start_offset = start,
+          .max_offset = model::model_limits<model::offset>::max(),
+          .isolation_level = model::isolation_level::read_uncommitted,
+          .max_bytes = std::numeric_limits<size_t>::max(),
+          .timeout = model::no_timeout,
+        };
+        return octx.rctx.partition_manager()
+          .invoke_on(
+            *shard,
+            [&octx, ntp, config](cluster::partition_manager& pm) {
+                return kafka::read_from_ntp(
+                  pm,
+                  octx.rctx.metadata_cache(),
+                  ntp,
+                  config,
+                  true,
+                  model::no_timeout);
+            })
+          .get0();
+    };
+
+    auto all = do_read(model::offset(0));
+    BOOST_REQUIRE_EQUAL(all.error, kafka::error_code::none);
+    BOOST_REQUIRE(all.has_data());
+
+    // a consumer caught up with the partition reads nothing
+    auto caught_up = do_read(all.high_watermark);
+    BOOST_REQUIRE_EQUAL(caught_up.error, kafka::error_code::none);
+    BOOST_REQUIRE_EQUAL(caught_up.high_watermark, all.high_watermark);
+    BOOST_REQUIRE(!caught_up.has_data());
+}
+
+FIXTURE_TEST(read_from_ntp_with_consumer_rack, redpanda_thread_fixture) {
+    wait_for_controller_leadership().get0();
+    auto ntp = make_data(model::revision_id(2));
+
+    auto shard = app.shard_table.local().shard_for(ntp);
+    tests::cooperative_spin_wait_with_timeout(10s, [this, shard, ntp = ntp] {
+        return app.partition_manager.invoke_on(
+          *shard, [ntp](cluster::partition_manager& mgr) {
+              auto partition = mgr.get(ntp);
+              return partition
+                     && partition->committed_offset() >= model::offset(1);
+          });
+    }).get();
+
+    kafka::fetch_config config{
+      .start_offset = model::offset(0),
+      .max_offset = model::model_limits<model::offset>::max(),
+      .isolation_level = model::isolation_level::read_uncommitted,
+      .max_bytes = std::numeric_limits<size_t>::max(),
+      .timeout = model::no_timeout,
+      .read_from_follower = true,
+      .consumer_rack = "rack-1",
+    };
+    auto rctx = make_request_context();
+    auto octx = kafka::op_context(
+      std::move(rctx), ss::default_smp_service_group());
+    auto res = octx.rctx.partition_manager()
+                 .invoke_on(
+                   *shard,
+                   [&octx, ntp, config](cluster::partition_manager& pm) {
+                       return kafka::read_from_ntp(
+                         pm,
+                         octx.rctx.metadata_cache(),
+                         ntp,
+                         config,
+                         true,
+                         model::no_timeout);
+                   })
+                 .get0();
+    // there are no followers the consumer could be pointed to, the leader
+    // serves the fetch
+    BOOST_REQUIRE(!res.preferred_replica);
+    BOOST_REQUIRE(res.has_data());
+}
+
 FIXTURE_TEST(fetch_one, redpanda_thread_fixture) {
     // create a topic partition with some data
     model::topic topic("foo");
@@ -505,6 +639,76 @@ FIXTURE_TEST(fetch_one_debounce, redpanda_thread_fixture) {
     BOOST_REQUIRE(resp.data.topics[0].partitions[0].records->size_bytes() > 0);
 }
 
+FIXTURE_TEST(fetch_parked_until_new_data, redpanda_thread_fixture) {
+    model::topic topic("foo");
+    model::partition_id pid(0);
+    auto ntp = make_default_ntp(topic, pid);
+
+    wait_for_controller_leadership().get0();
+
+    add_topic(model::topic_namespace_view(ntp)).get();
+    wait_for_partition_offset(ntp, model::offset(0)).get0();
+
+    // polling is effectively disabled, the fetch must be woken up by the
+    // partition high watermark
+    ss::smp::invoke_on_all([] {
+        config::shard_local_cfg().fetch_reads_debounce_timeout.set_value(
+          std::chrono::milliseconds(60000));
+    }).get();
+
+    kafka::fetch_request req;
+    req.data.max_bytes = std::numeric_limits<int32_t>::max();
+    req.data.min_bytes = 1;
+    req.data.max_wait_ms = std::chrono::milliseconds(30000);
+    req.data.session_id = kafka::invalid_fetch_session_id;
+    req.data.topics = {{
+      .name = topic,
+      .fetch_partitions = {{
+        .partition_index = pid,
+        .fetch_offset = model::offset(0),
+      }},
+    }};
+
+    auto client = make_kafka_client().get0();
+    client.connect().get();
+    auto start = model::timeout_clock::now();
+    auto fresp = client.dispatch(req, kafka::api_version(4));
+    ss::sleep(200ms).get();
+    auto shard = app.shard_table.local().shard_for(ntp);
+    app.partition_manager
+      .invoke_on(
+        *shard,
+        [ntp](cluster::partition_manager& mgr) {
+            auto batches = storage::test::make_random_batches(
+              model::offset(0), 5);
+            auto rdr = model::make_memory_record_batch_reader(
+              std::move(batches));
+            return mgr.get(ntp)
+              ->replicate(
+                std::move(rdr),
+                raft::replicate_options(raft::consistency_level::quorum_ack))
+              .discard_result();
+        })
+      .get();
+
+    auto resp = fresp.get0();
+    auto elapsed = model::timeout_clock::now() - start;
+    client.stop().then([&client] { client.shutdown(); }).get();
+    ss::smp::invoke_on_all([] {
+        config::shard_local_cfg().fetch_reads_debounce_timeout.set_value(
+          std::chrono::milliseconds(1));
+    }).get();
+
+    BOOST_REQUIRE(elapsed < 10s);
+    BOOST_REQUIRE_EQUAL(resp.data.topics.size(), 1);
+    BOOST_REQUIRE_EQUAL(resp.data.topics[0].partitions.size(), 1);
+    BOOST_REQUIRE_EQUAL(
+      resp.data.topics[0].partitions[0].error_code, kafka::error_code::none);
+    BOOST_REQUIRE(resp.data.topics[0].partitions[0].records);
+    BOOST_REQUIRE_GT(
+      resp.data.topics[0].partitions[0].records->size_bytes(), 0);
+}
+
 FIXTURE_TEST(fetch_multi_topics, redpanda_thread_fixture) {
     // create a topic partition with some data
     model::topic topic_1("foo");
@@ -596,6 +800,92 @@ FIXTURE_TEST(fetch_multi_topics, redpanda_thread_fixture) {
     BOOST_REQUIRE_GT(total_size, 0);
 }
 
+FIXTURE_TEST(fetch_balanced_planning, redpanda_thread_fixture) {
+    ss::smp::invoke_on_all([] {
+        config::shard_local_cfg().enable_balanced_fetch_planning.set_value(
+          true);
+    }).get();
+    model::topic topic("foo");
+    constexpr int partitions = 4;
+    wait_for_controller_leadership().get0();
+
+    add_topic(model::topic_namespace(model::ns("kafka"), topic), partitions)
+      .get();
+
+    size_t total_size = 0;
+    for (int i = 0; i < partitions; ++i) {
+        auto ntp = make_default_ntp(topic, model::partition_id(i));
+        wait_for_partition_offset(ntp, model::offset(0)).get0();
+        auto shard = app.shard_table.local().shard_for(ntp);
+        total_size += app.partition_manager
+                        .invoke_on(
+                          *shard,
+                          [ntp](cluster::partition_manager& mgr) {
+                              auto batches = storage::test::make_random_batches(
+                                model::offset(0), 10, false);
+                              size_t size = 0;
+                              for (auto& b : batches) {
+                                  size += b.size_bytes();
+                              }
+                              auto rdr = model::make_memory_record_batch_reader(
+                                std::move(batches));
+                              return mgr.get(ntp)
+                                ->replicate(
+                                  std::move(rdr),
+                                  raft::replicate_options(
+                                    raft::consistency_level::quorum_ack))
+                                .then([size](auto) { return size; });
+                          })
+                        .get0();
+    }
+
+    auto make_request = [&topic](int32_t max_bytes) {
+        kafka::fetch_request req;
+        req.data.max_bytes = max_bytes;
+        req.data.min_bytes = 1;
+        req.data.max_wait_ms = std::chrono::milliseconds(0);
+        req.data.session_id = kafka::invalid_fetch_session_id;
+        req.data.topics = {{.name = topic, .fetch_partitions = {}}};
+        for (int i = 0; i < partitions; ++i) {
+            kafka::fetch_request::partition p;
+            p.partition_index = model::partition_id(i);
+            p.fetch_offset = model::offset(0);
+            p.max_bytes = std::numeric_limits<int32_t>::max();
+            req.data.topics[0].fetch_partitions.push_back(p);
+        }
+        return req;
+    };
+
+    auto client = make_kafka_client().get0();
+    client.connect().get();
+    // the first fetch fills the fetch metadata cache of the connection
+    client
+      .dispatch(
+        make_request(std::numeric_limits<int32_t>::max()),
+        kafka::api_version(4))
+      .get0();
+    // budget of about two partitions is split among all of them
+    auto resp = client
+                  .dispatch(make_request(total_size / 2), kafka::api_version(4))
+                  .get0();
+    client.stop().then([&client] { client.shutdown(); }).get();
+    ss::smp::invoke_on_all([] {
+        config::shard_local_cfg().enable_balanced_fetch_planning.set_value(
+          false);
+    }).get();
+
+    BOOST_REQUIRE_EQUAL(resp.data.topics.size(), 1);
+    BOOST_REQUIRE_EQUAL(resp.data.topics[0].partitions.size(), partitions);
+    int with_data = 0;
+    for (auto& p : resp.data.topics[0].partitions) {
+        BOOST_REQUIRE_EQUAL(p.error_code, kafka::error_code::none);
+        if (p.records && p.records->size_bytes() > 0) {
+            ++with_data;
+        }
+    }
+    BOOST_REQUIRE_GT(with_data, 1);
+}
+
 FIXTURE_TEST(fetch_request_max_bytes, redpanda_thread_fixture) {
     model::topic topic("foo");
     model::partition_id pid(0);
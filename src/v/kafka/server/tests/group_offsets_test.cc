@@ -0,0 +1,51 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/server/group_offsets.h"
+#include "model/fundamental.h"
+
+#include <boost/test/unit_test.hpp>
+
+static model::topic_partition tp(const char* topic, int32_t partition) {
+    return model::topic_partition(
+      model::topic(topic), model::partition_id(partition));
+}
+
+BOOST_AUTO_TEST_CASE(group_offsets_insert_find_extract) {
+    kafka::group_offsets<int> offsets;
+    BOOST_REQUIRE(offsets.empty());
+
+    // out of order inserts keep partitions sorted
+    for (int p : {3, 0, 2, 1}) {
+        auto [v, inserted] = offsets.try_emplace(tp("a", p), p * 10);
+        BOOST_REQUIRE(inserted);
+        BOOST_REQUIRE_EQUAL(*v, p * 10);
+    }
+    offsets.insert_or_assign(tp("b", 0), 100);
+    BOOST_REQUIRE_EQUAL(offsets.size(), 5);
+    BOOST_REQUIRE_EQUAL(offsets.topics().size(), 2);
+
+    auto [v, inserted] = offsets.try_emplace(tp("a", 2), 0);
+    BOOST_REQUIRE(!inserted);
+    BOOST_REQUIRE_EQUAL(*v, 20);
+    offsets.insert_or_assign(tp("a", 2), 21);
+    BOOST_REQUIRE_EQUAL(*offsets.find(tp("a", 2)), 21);
+    BOOST_REQUIRE(offsets.find(tp("a", 4)) == nullptr);
+    BOOST_REQUIRE(offsets.find(tp("c", 0)) == nullptr);
+
+    const auto& a = offsets.topics().at(model::topic("a"));
+    for (size_t i = 0; i < a.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(a[i].first, model::partition_id(i));
+    }
+
+    BOOST_REQUIRE_EQUAL(offsets.extract(tp("b", 0)).value(), 100);
+    BOOST_REQUIRE(!offsets.extract(tp("b", 0)));
+    BOOST_REQUIRE_EQUAL(offsets.topics().size(), 1);
+    BOOST_REQUIRE_EQUAL(offsets.size(), 4);
+}
@@ -456,6 +456,49 @@ SEASTAR_THREAD_TEST_CASE(generate_member_id) {
     BOOST_TEST(is_uuid(uuid));
 }
 
+SEASTAR_THREAD_TEST_CASE(static_members) {
+    auto g = get();
+    BOOST_TEST(!g.get_static_member_id(kafka::group_instance_id("i")));
+
+    auto m = get_group_member();
+    (void)g.add_member(m);
+    BOOST_TEST(
+      g.get_static_member_id(kafka::group_instance_id("i"))
+      == kafka::member_id("m"));
+    BOOST_TEST(!g.is_static_member_fenced(
+      kafka::member_id("m"), kafka::group_instance_id("i")));
+    BOOST_TEST(!g.is_static_member_fenced(kafka::member_id("n"), std::nullopt));
+    BOOST_TEST(g.is_static_member_fenced(
+      kafka::member_id("n"), kafka::group_instance_id("i")));
+
+    g.remove_member(m);
+    BOOST_TEST(!g.get_static_member_id(kafka::group_instance_id("i")));
+}
+
+SEASTAR_THREAD_TEST_CASE(replace_static_member) {
+    auto g = get();
+    auto m = get_group_member();
+    auto f = g.add_member(m);
+    m->set_assignment(bytes("a"));
+
+    auto n = g.replace_static_member(
+      kafka::group_instance_id("i"),
+      kafka::member_id("m"),
+      kafka::member_id("n"));
+
+    // the old member is fenced
+    BOOST_TEST(f.get0().data.error_code == error_code::fenced_instance_id);
+    BOOST_TEST(!g.contains_member(kafka::member_id("m")));
+    BOOST_TEST(g.is_static_member_fenced(
+      kafka::member_id("m"), kafka::group_instance_id("i")));
+
+    // the new member takes over the membership
+    BOOST_TEST(g.get_member(kafka::member_id("n")) == n);
+    BOOST_TEST(n->assignment() == bytes("a"));
+    BOOST_TEST(g.is_leader(kafka::member_id("n")));
+    BOOST_TEST(!n->is_joining());
+}
+
 SEASTAR_THREAD_TEST_CASE(group_output) {
     auto g = get();
     auto s = fmt::format("{}", g);
@@ -0,0 +1,80 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "config/configuration.h"
+#include "kafka/protocol/fetch.h"
+#include "kafka/protocol/metadata.h"
+#include "kafka/protocol/produce.h"
+#include "kafka/server/latency_breakdown_probe.h"
+
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/defer.hh>
+
+using namespace std::chrono_literals;
+
+static auto enable_breakdown(size_t max_clients) {
+    auto& enabled = config::shard_local_cfg().kafka_latency_breakdown;
+    auto& clients
+      = config::shard_local_cfg().kafka_latency_breakdown_max_clients;
+    auto prev = std::make_pair(enabled(), clients());
+    enabled.set_value(true);
+    clients.set_value(max_clients);
+    return ss::defer([&enabled, &clients, prev] {
+        enabled.set_value(prev.first);
+        clients.set_value(prev.second);
+    });
+}
+
+SEASTAR_THREAD_TEST_CASE(disabled_by_default) {
+    kafka::latency_breakdown_probe probe;
+    BOOST_REQUIRE(probe.get(kafka::produce_api::key, "client") == nullptr);
+}
+
+SEASTAR_THREAD_TEST_CASE(only_produce_and_fetch) {
+    auto reset = enable_breakdown(16);
+    kafka::latency_breakdown_probe probe;
+    auto produce = probe.get(kafka::produce_api::key, "client");
+    auto fetch = probe.get(kafka::fetch_api::key, "client");
+    BOOST_REQUIRE(produce != nullptr);
+    BOOST_REQUIRE(fetch != nullptr);
+    BOOST_REQUIRE(produce != fetch);
+    BOOST_REQUIRE(probe.get(kafka::metadata_api::key, "client") == nullptr);
+}
+
+SEASTAR_THREAD_TEST_CASE(records_per_stage) {
+    auto reset = enable_breakdown(16);
+    kafka::latency_breakdown_probe probe;
+    auto stages = probe.get(kafka::produce_api::key, std::nullopt);
+    stages->record(kafka::request_stage::queue, 10us);
+    stages->record(kafka::request_stage::handler, 20us);
+    stages->record(kafka::request_stage::handler, 30us);
+    BOOST_REQUIRE_EQUAL(
+      stages->get(kafka::request_stage::queue).sample_count(), 1);
+    BOOST_REQUIRE_EQUAL(
+      stages->get(kafka::request_stage::handler).sample_count(), 2);
+    BOOST_REQUIRE_EQUAL(
+      stages->get(kafka::request_stage::handler).sample_sum(), 50);
+    BOOST_REQUIRE_EQUAL(
+      stages->get(kafka::request_stage::response_write).sample_count(), 0);
+    BOOST_REQUIRE_EQUAL(
+      probe.get(kafka::produce_api::key, std::nullopt), stages);
+}
+
+SEASTAR_THREAD_TEST_CASE(clients_beyond_the_cap_are_other) {
+    auto reset = enable_breakdown(2);
+    kafka::latency_breakdown_probe probe;
+    auto a = probe.get(kafka::produce_api::key, "a");
+    auto b = probe.get(kafka::produce_api::key, "b");
+    BOOST_REQUIRE(a != b);
+    auto c = probe.get(kafka::produce_api::key, "c");
+    auto d = probe.get(kafka::produce_api::key, "d");
+    BOOST_REQUIRE(c != a && c != b);
+    BOOST_REQUIRE_EQUAL(c, d);
+    BOOST_REQUIRE_EQUAL(probe.get(kafka::produce_api::key, "a"), a);
+}
@@ -161,3 +161,31 @@ FIXTURE_TEST(test_topic_namespaces, redpanda_thread_fixture) {
     BOOST_REQUIRE_EQUAL(resp.data.topics[0].name, test_topic.tp);
     client.stop().then([&client] { client.shutdown(); }).get();
 };
+
+FIXTURE_TEST(test_all_topics_follow_metadata_changes, redpanda_thread_fixture) {
+    wait_for_controller_leadership().get();
+    auto client = make_kafka_client().get();
+    client.connect().get();
+
+    // cached empty set of topics
+    auto resp = client.dispatch(all_topics()).get();
+    BOOST_REQUIRE(resp.data.topics.empty());
+
+    model::topic_namespace tp_ns(model::kafka_namespace, model::topic("tp"));
+    add_topic(tp_ns).get();
+    tests::cooperative_spin_wait_with_timeout(2s, [&client] {
+        return client.dispatch(all_topics())
+          .then([](kafka::metadata_response resp) {
+              return resp.data.topics.size() == 1
+                     && resp.data.topics[0].partitions.size() == 1
+                     && resp.data.topics[0].partitions[0].leader_id
+                          != model::node_id(-1);
+          });
+    }).get();
+
+    // served again from the cache
+    resp = client.dispatch(all_topics()).get();
+    BOOST_REQUIRE_EQUAL(resp.data.topics.size(), 1);
+    BOOST_REQUIRE_EQUAL(resp.data.topics[0].name, tp_ns.tp);
+    client.stop().then([&client] { client.shutdown(); }).get();
+}
@@ -0,0 +1,111 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "kafka/client/transport.h"
+#include "kafka/protocol/produce.h"
+#include "model/fundamental.h"
+#include "redpanda/tests/fixture.h"
+#include "storage/record_batch_builder.h"
+#include "test_utils/async.h"
+#include "utils/hdr_hist.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <fmt/format.h>
+
+using namespace std::chrono_literals;
+
+// every iteration sends this many produce requests, one after the other
+static constexpr int requests_per_iteration = 64;
+
+/// Measures the latency of produce requests carrying a small batch for each
+/// of the `partitions` partitions of a single topic, acknowledged by the
+/// leader, as all of the partitions are dispatched by a single request.
+template<int partitions>
+struct produce_bench : redpanda_thread_fixture {
+    produce_bench() {
+        model::topic_namespace tp_ns(model::ns("kafka"), test_topic);
+        add_topic(tp_ns, partitions).get();
+        for (int i = 0; i < partitions; ++i) {
+            model::ntp ntp(tp_ns.ns, tp_ns.tp, model::partition_id(i));
+            tests::cooperative_spin_wait_with_timeout(10s, [ntp, this] {
+                auto shard = app.shard_table.local().shard_for(ntp);
+                if (!shard) {
+                    return ss::make_ready_future<bool>(false);
+                }
+                return app.partition_manager.invoke_on(
+                  *shard, [ntp](cluster::partition_manager& pm) {
+                      auto p = pm.get(ntp);
+                      return p && p->is_leader();
+                  });
+            }).get();
+        }
+        _client = std::make_unique<kafka::client::transport>(
+          make_kafka_client().get0());
+        _client->connect().get();
+    }
+
+    ~produce_bench() {
+        _client->stop().then([this] { _client->shutdown(); }).get();
+        fmt::print(
+          "{} partitions per request: produce p50: {}us p99: {}us p999: "
+          "{}us\n",
+          partitions,
+          _hist.get_value_at(50),
+          _hist.get_value_at(99),
+          _hist.get_value_at(99.9));
+    }
+
+    kafka::produce_request make_request() {
+        kafka::produce_request::topic tp;
+        tp.name = test_topic;
+        for (int i = 0; i < partitions; ++i) {
+            storage::record_batch_builder builder(
+              model::record_batch_type::raft_data, model::offset(0));
+            iobuf v;
+            v.append("v", 1);
+            builder.add_raw_kv(iobuf{}, std::move(v));
+            kafka::produce_request::partition p;
+            p.partition_index = model::partition_id(i);
+            p.records.emplace(std::move(builder).build());
+            tp.partitions.push_back(std::move(p));
+        }
+        std::vector<kafka::produce_request::topic> topics;
+        topics.push_back(std::move(tp));
+        kafka::produce_request req(std::nullopt, 1, std::move(topics));
+        req.data.timeout_ms = std::chrono::seconds(2);
+        req.has_idempotent = false;
+        req.has_transactional = false;
+        return req;
+    }
+
+    ss::future<size_t> run() {
+        for (int i = 0; i < requests_per_iteration; ++i) {
+            auto req = make_request();
+            perf_tests::start_measuring_time();
+            auto m = _hist.auto_measure();
+            co_await _client->dispatch(std::move(req)).discard_result();
+            perf_tests::stop_measuring_time();
+        }
+        co_return requests_per_iteration;
+    }
+
+    model::topic test_topic{"produce_bench"};
+    std::unique_ptr<kafka::client::transport> _client;
+    hdr_hist _hist;
+};
+
+using partitions_1 = produce_bench<1>;
+using partitions_16 = produce_bench<16>;
+using partitions_128 = produce_bench<128>;
+
+PERF_TEST_F(partitions_1, produce) { return run(); }
+PERF_TEST_F(partitions_16, produce) { return run(); }
+PERF_TEST_F(partitions_128, produce) { return run(); }
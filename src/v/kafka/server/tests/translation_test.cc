@@ -247,3 +247,32 @@ FIXTURE_TEST(immutabitlity_test, offset_translator_fixture) {
 
     validate_offsets_immutable(truncate_at + 1);
 }
+
+FIXTURE_TEST(cached_ranges_invalidation_test, offset_translator_fixture) {
+    std::vector<raft::offset_configuration> cfgs;
+    for (auto o : {5, 10, 20}) {
+        cfgs.emplace_back(
+          model::offset(o),
+          raft::group_configuration({}, model::revision_id(0)));
+    }
+    config_manager.add(std::move(cfgs)).get();
+    // fill the cached ranges at the tail
+    validate_offset_translation(model::offset(30), model::offset(27));
+    validate_offset_translation(model::offset(31), model::offset(28));
+
+    // new configuration batch in the middle of the cached range
+    config_manager
+      .add(
+        model::offset(32),
+        raft::group_configuration({}, model::revision_id(0)))
+      .get();
+    validate_offset_translation(model::offset(31), model::offset(28));
+    validate_offset_translation(model::offset(33), model::offset(29));
+
+    // truncation removes it again
+    config_manager.truncate(model::offset(32)).get();
+    validate_offset_translation(model::offset(33), model::offset(30));
+    validate_offset_translation(model::offset(15), model::offset(13));
+    validate_offset_translation(model::offset(7), model::offset(6));
+    validate_offset_translation(model::offset(3), model::offset(3));
+}
@@ -238,12 +238,28 @@ void adl<model::record_batch>::to(iobuf& out, model::record_batch&& batch) {
       [&out](model::record r) { reflection::serialize(out, std::move(r)); });
 }
 
+void adl<model::record_batch>::to_storage_encoding(
+  iobuf& out, model::record_batch&& batch) {
+    if (batch.compressed()) {
+        to(out, std::move(batch));
+        return;
+    }
+    batch_header hdr{.bhdr = batch.header(), .is_compressed = 2};
+    reflection::serialize(out, hdr, std::move(batch).release_data());
+}
+
 model::record_batch adl<model::record_batch>::from(iobuf_parser& in) {
     auto hdr = reflection::adl<batch_header>{}.from(in);
     if (hdr.is_compressed == 1) {
         auto io = reflection::adl<iobuf>{}.from(in);
         return model::record_batch(hdr.bhdr, std::move(io));
     }
+    if (hdr.is_compressed == 2) {
+        // shares the records with the input buffer
+        auto io = reflection::adl<iobuf>{}.from(in);
+        return model::record_batch(
+          hdr.bhdr, std::move(io), model::record_batch::tag_ctor_ng{});
+    }
     auto recs = std::vector<model::record>{};
     recs.reserve(hdr.bhdr.record_count);
     for (int i = 0; i < hdr.bhdr.record_count; ++i) {
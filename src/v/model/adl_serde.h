@@ -100,6 +100,8 @@ struct adl<model::record_batch_header> {
 
 struct batch_header {
     model::record_batch_header bhdr;
+    /// 0: records follow one by one, 1: compressed records, 2: records in
+    /// their storage encoding
     int8_t is_compressed;
 };
 
@@ -112,6 +114,10 @@ struct adl<batch_header> {
 template<>
 struct adl<model::record_batch> {
     void to(iobuf& out, model::record_batch&& batch);
+    /// Serializes the records of the batch as they are stored, receivers
+    /// share them out of the input buffer instead of re-encoding every
+    /// record. Not understood by nodes predating the encoding.
+    void to_storage_encoding(iobuf& out, model::record_batch&& batch);
     model::record_batch from(iobuf_parser& in);
 };
 
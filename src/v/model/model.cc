@@ -329,6 +329,8 @@ std::ostream& operator<<(std::ostream& o, record_batch_type bt) {
         return o << "batch_type::node_management_cmd";
     case record_batch_type::data_policy_management_cmd:
         return o << "batch_type::data_policy_management_cmd";
+    case record_batch_type::shard_wal:
+        return o << "batch_type::shard_wal";
     }
 
     return o << "batch_type::unknown{" << static_cast<int>(bt) << "}";
@@ -31,6 +31,15 @@ inline model::ntp kvstore_ntp(ss::shard_id shard) {
     return model::ntp(redpanda_ns, kvstore_topic, model::partition_id(shard));
 }
 
+/*
+ * The write-ahead log shared by the small partitions of a core, see
+ * storage::shard_wal, likewise has a partition per core.
+ */
+inline const model::topic shard_wal_topic("shard_wal");
+inline model::ntp shard_wal_ntp(ss::shard_id shard) {
+    return model::ntp(redpanda_ns, shard_wal_topic, model::partition_id(shard));
+}
+
 inline const model::ns kafka_namespace("kafka");
 
 inline const model::ns kafka_internal_namespace("kafka_internal");
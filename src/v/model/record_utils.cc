@@ -10,23 +10,42 @@
 #include "model/record_utils.h"
 
 #include "bytes/utils.h"
+#include "likely.h"
 #include "model/record.h"
 #include "reflection/adl.h"
 #include "utils/vint.h"
 
+#include <fmt/format.h>
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
 #include <type_traits>
 
 namespace model {
 
-template<typename T, typename = std::enable_if_t<std::is_integral_v<T>, T>>
-void crc_extend_cpu_to_le(crc::crc32c& crc, T i) {
-    auto j = ss::cpu_to_le(i);
-    crc.extend(j);
+/// \brief packs the fields in a stack buffer, converted by `convert`, so
+/// that they are hashed by a single crc call instead of one per field
+template<typename Convert, typename... T>
+void crc_extend_all_packed(crc::crc32c& crc, Convert convert, T... t) {
+    static_assert((std::is_integral_v<T> && ...));
+    std::array<uint8_t, (sizeof(T) + ...)> packed; // NOLINT
+    size_t pos = 0;
+    (
+      [&packed, &pos, &convert](auto i) {
+          auto j = convert(i);
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+          std::memcpy(packed.data() + pos, &j, sizeof(j));
+          pos += sizeof(j);
+      }(t),
+      ...);
+    crc.extend(packed.data(), packed.size());
 }
 
 template<typename... T>
 void crc_extend_all_cpu_to_le(crc::crc32c& crc, T... t) {
-    ((crc_extend_cpu_to_le(crc, t)), ...);
+    crc_extend_all_packed(
+      crc, [](auto i) { return ss::cpu_to_le(i); }, t...);
 }
 
 /// \brief uint32_t because that's what crc32c uses
@@ -54,15 +73,10 @@ uint32_t internal_header_only_crc(const record_batch_header& header) {
     return c.value();
 }
 
-template<typename T, typename = std::enable_if_t<std::is_integral_v<T>, T>>
-void crc_extend_cpu_to_be(crc::crc32c& crc, T i) {
-    auto j = ss::cpu_to_be(i);
-    crc.extend(j);
-}
-
 template<typename... T>
 void crc_extend_all_cpu_to_be(crc::crc32c& crc, T... t) {
-    ((crc_extend_cpu_to_be(crc, t)), ...);
+    crc_extend_all_packed(
+      crc, [](auto i) { return ss::cpu_to_be(i); }, t...);
 }
 
 void crc_record_batch_header(
@@ -119,9 +133,8 @@ static model::record do_parse_one_record_from_buffer(
   int32_t record_size,
   model::record_attributes::type attr,
   ParserData parser_data) {
-    auto [timestamp_delta, tv] = parser.read_varlong();
-    auto [offset_delta, ov] = parser.read_varlong();
-    auto [key_length, kv] = parser.read_varlong();
+    auto [timestamp_delta, offset_delta, key_length]
+      = parser.template read_varlongs<3>();
     iobuf key;
     if (key_length > 0) {
         key = parser_data(parser, key_length);
@@ -175,6 +188,42 @@ model::record parse_one_record_copy_from_buffer(iobuf_const_parser& parser) {
       });
 }
 
+static void skip_nullable_blob(iobuf_parser_base& parser) {
+    auto [length, _] = parser.read_varlong();
+    if (unlikely(length < -1)) {
+        throw std::out_of_range(
+          fmt::format("Invalid record field length {}", length));
+    }
+    if (length > 0) {
+        parser.skip(length);
+    }
+}
+
+void verify_one_record_from_buffer(iobuf_parser_base& parser) {
+    auto [record_size, attr] = parse_record_meta_from_buffer(parser);
+    // the record size covers all the fields following it
+    const auto start = parser.bytes_consumed() - sizeof(attr);
+    parser.read_varlongs<2>(); // timestamp and offset deltas
+    skip_nullable_blob(parser); // key
+    skip_nullable_blob(parser); // value
+    auto [header_count, _] = parser.read_varlong();
+    if (unlikely(header_count < 0)) {
+        throw std::out_of_range(
+          fmt::format("Invalid record header count {}", header_count));
+    }
+    for (int64_t i = 0; i < header_count; ++i) {
+        skip_nullable_blob(parser);
+        skip_nullable_blob(parser);
+    }
+    const auto consumed = parser.bytes_consumed() - start;
+    if (unlikely(consumed != static_cast<size_t>(record_size))) {
+        throw std::out_of_range(fmt::format(
+          "Record size {} does not match its {} bytes of fields",
+          record_size,
+          consumed));
+    }
+}
+
 static inline void append_vint_to_iobuf(iobuf& b, int64_t v) {
     auto vb = vint::to_bytes(v);
     b.append(vb.data(), vb.size());
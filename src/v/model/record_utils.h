@@ -32,6 +32,9 @@ uint32_t internal_header_only_crc(const record_batch_header&);
 
 model::record parse_one_record_from_buffer(iobuf_parser& parser);
 model::record parse_one_record_copy_from_buffer(iobuf_const_parser& parser);
+/// \brief checks that a record is well formed without materializing it,
+/// skips over the record, throws std::out_of_range if it is malformed
+void verify_one_record_from_buffer(iobuf_parser_base& parser);
 void append_record_to_buffer(iobuf& a, const model::record& r);
 
 } // namespace model
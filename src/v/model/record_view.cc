@@ -0,0 +1,161 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "model/record_view.h"
+
+#include "bytes/iobuf_parser.h"
+#include "vassert.h"
+
+#include <fmt/format.h>
+
+namespace model {
+
+static iobuf copy_field(iobuf::iterator_consumer in, int32_t size) {
+    iobuf ret;
+    if (size <= 0) {
+        return ret;
+    }
+    in.consume(size, [&ret](const char* src, size_t n) {
+        ret.append(src, n);
+        return ss::stop_iteration::no;
+    });
+    return ret;
+}
+
+static void skip_field(iobuf::iterator_consumer& in, int64_t size) {
+    if (unlikely(size < -1)) {
+        throw std::out_of_range(
+          fmt::format("Invalid record field length {}", size));
+    }
+    if (size > 0) {
+        in.skip(size);
+    }
+}
+
+const record_view::decoded& record_view::fields() const {
+    if (_fields) {
+        return *_fields;
+    }
+    auto in = _start;
+    in.skip(_size_length);
+    auto attr = in.consume_type<record_attributes::type>();
+    auto [timestamp_delta, offset_delta, key_size]
+      = details::read_varlongs<3>(in);
+    auto key = in;
+    skip_field(in, key_size);
+    auto [value_size, vv] = details::read_varlong(in);
+    auto value = in;
+    skip_field(in, value_size);
+    auto [headers_count, hv] = details::read_varlong(in);
+    if (unlikely(headers_count < 0)) {
+        throw std::out_of_range(
+          fmt::format("Invalid record header count {}", headers_count));
+    }
+    _fields = decoded{
+      .attributes = record_attributes(attr),
+      .timestamp_delta = timestamp_delta,
+      .offset_delta = static_cast<int32_t>(offset_delta),
+      .key_size = static_cast<int32_t>(key_size),
+      .key = key,
+      .value_size = static_cast<int32_t>(value_size),
+      .value = value,
+      .headers_count = static_cast<int32_t>(headers_count),
+      .headers = in,
+    };
+    return *_fields;
+}
+
+iobuf record_view::copy_key() const {
+    return copy_field(fields().key, key_size());
+}
+
+bytes record_view::key_bytes() const {
+    const auto& f = fields();
+    if (f.key_size <= 0) {
+        return {};
+    }
+    auto ret = ss::uninitialized_string<bytes>(f.key_size);
+    auto in = f.key;
+    in.consume_to(f.key_size, ret.begin());
+    return ret;
+}
+
+iobuf record_view::copy_value() const {
+    return copy_field(fields().value, value_size());
+}
+
+std::vector<record_header> record_view::copy_headers() const {
+    const auto& f = fields();
+    std::vector<record_header> ret;
+    ret.reserve(f.headers_count);
+    auto in = f.headers;
+    for (int32_t i = 0; i < f.headers_count; ++i) {
+        auto [key_size, kv] = details::read_varlong(in);
+        auto key = copy_field(in, key_size);
+        skip_field(in, key_size);
+        auto [value_size, vv] = details::read_varlong(in);
+        auto value = copy_field(in, value_size);
+        skip_field(in, value_size);
+        ret.emplace_back(
+          key_size, std::move(key), value_size, std::move(value));
+    }
+    return ret;
+}
+
+record record_view::copy() const {
+    return record(
+      _size_bytes,
+      attributes(),
+      timestamp_delta(),
+      offset_delta(),
+      key_size(),
+      copy_key(),
+      value_size(),
+      copy_value(),
+      copy_headers());
+}
+
+void record_view::append_to(iobuf& out) const {
+    auto in = _start;
+    in.consume(_size_length + _size_bytes, [&out](const char* src, size_t n) {
+        out.append(src, n);
+        return ss::stop_iteration::no;
+    });
+}
+
+record_view_iterator::record_view_iterator(const record_batch& b)
+  : _in(b.data().cbegin(), b.data().cend())
+  , _size(b.data().size_bytes())
+  , _record_count(b.record_count()) {
+    vassert(
+      !b.compressed(),
+      "Record iteration is not supported for compressed batches.");
+}
+
+std::optional<record_view> record_view_iterator::next() {
+    if (_records_read == _record_count) {
+        if (unlikely(_in.bytes_consumed() != _size)) {
+            throw std::out_of_range(fmt::format(
+              "Record iteration stopped with {} bytes remaining",
+              _size - _in.bytes_consumed()));
+        }
+        return std::nullopt;
+    }
+    auto start = _in;
+    auto [size_bytes, size_length] = details::read_varlong(_in);
+    if (unlikely(size_bytes < 0)) {
+        throw std::out_of_range(
+          fmt::format("Invalid record size {}", size_bytes));
+    }
+    _in.skip(size_bytes);
+    ++_records_read;
+    return record_view(start, size_length, static_cast<int32_t>(size_bytes));
+}
+
+} // namespace model
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "bytes/bytes.h"
+#include "bytes/iobuf.h"
+#include "model/record.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/loop.hh>
+
+#include <optional>
+#include <vector>
+
+namespace model {
+
+/// \brief non-owning view of a record of an uncompressed batch.
+///
+/// Only the size of the record is decoded when iterating over the views of
+/// a batch, the other fields are decoded the first time one of them is
+/// accessed. The key, value and headers stay in the batch and are copied
+/// only when requested. Scanning the records through views allocates
+/// nothing, unlike `record_batch::for_each_record` which materializes every
+/// record with its headers.
+///
+/// The batch must outlive its views.
+class record_view {
+public:
+    /// Size in bytes of everything except the size_bytes field
+    int32_t size_bytes() const { return _size_bytes; }
+    record_attributes attributes() const { return fields().attributes; }
+    int64_t timestamp_delta() const { return fields().timestamp_delta; }
+    int32_t offset_delta() const { return fields().offset_delta; }
+    /// Key size, -1 for a null key
+    int32_t key_size() const { return fields().key_size; }
+    /// Value size, -1 for a null value
+    int32_t value_size() const { return fields().value_size; }
+    int32_t headers_count() const { return fields().headers_count; }
+
+    iobuf copy_key() const;
+    /// Copy of the key in a contiguous buffer
+    bytes key_bytes() const;
+    iobuf copy_value() const;
+    std::vector<record_header> copy_headers() const;
+
+    /// The record with copies of its key, value and headers
+    record copy() const;
+    /// Appends the record as encoded in the batch, size field included
+    void append_to(iobuf&) const;
+
+private:
+    friend class record_view_iterator;
+    using consumer = iobuf::iterator_consumer;
+
+    struct decoded {
+        record_attributes attributes;
+        int64_t timestamp_delta;
+        int32_t offset_delta;
+        int32_t key_size;
+        consumer key;
+        int32_t value_size;
+        consumer value;
+        int32_t headers_count;
+        consumer headers;
+    };
+
+    record_view(consumer start, uint8_t size_length, int32_t size_bytes)
+      : _start(start)
+      , _size_length(size_length)
+      , _size_bytes(size_bytes) {}
+
+    const decoded& fields() const;
+
+    // positioned at the size field of the record
+    consumer _start;
+    uint8_t _size_length;
+    int32_t _size_bytes;
+    mutable std::optional<decoded> _fields;
+};
+
+/// \brief forward iteration over the record views of an uncompressed batch,
+/// see record_view. The batch must outlive the iterator and the views.
+class record_view_iterator {
+public:
+    explicit record_view_iterator(const record_batch&);
+
+    /// View of the next record, nullopt after the last one. Throws
+    /// std::out_of_range if the records do not match the batch.
+    std::optional<record_view> next();
+
+private:
+    iobuf::iterator_consumer _in;
+    size_t _size;
+    int32_t _record_count;
+    int32_t _records_read{0};
+};
+
+/// \brief calls f with the view of every record of an uncompressed batch,
+/// f returns a future. Use record_view_iterator for synchronous iteration.
+template<typename Func>
+inline ss::future<>
+for_each_record_view(const record_batch& batch, Func&& f) {
+    return ss::do_with(
+      record_view_iterator(batch),
+      [f = std::forward<Func>(f)](record_view_iterator& it) mutable {
+          return ss::repeat([&it, &f] {
+              auto view = it.next();
+              if (!view) {
+                  return ss::make_ready_future<ss::stop_iteration>(
+                    ss::stop_iteration::yes);
+              }
+              return ss::do_with(
+                       std::move(*view), [&f](record_view& v) { return f(v); })
+                .then([] { return ss::stop_iteration::no; });
+          });
+      });
+}
+
+} // namespace model
@@ -9,6 +9,7 @@
 
 #include "model/record.h"
 #include "model/record_utils.h"
+#include "model/record_view.h"
 #include "model/timestamp.h"
 #include "storage/tests/utils/random_batch.h"
 
@@ -78,3 +79,98 @@ SEASTAR_THREAD_TEST_CASE(set_max_timestamp) {
     BOOST_TEST(crc == batch.header().crc);
     BOOST_TEST(hdr_crc == batch.header().header_crc);
 }
+
+SEASTAR_THREAD_TEST_CASE(verify_records_without_materializing) {
+    auto batch = storage::test::make_random_batch(model::offset(0), 10, false);
+
+    iobuf_const_parser parser(batch.data());
+    for (int32_t i = 0; i < batch.record_count(); ++i) {
+        model::verify_one_record_from_buffer(parser);
+    }
+    BOOST_REQUIRE_EQUAL(parser.bytes_left(), 0);
+
+    // a truncated record is rejected
+    auto truncated = batch.data().copy();
+    truncated.trim_back(1);
+    iobuf_const_parser truncated_parser(truncated);
+    BOOST_REQUIRE_THROW(
+      [&] {
+          for (int32_t i = 0; i < batch.record_count(); ++i) {
+              model::verify_one_record_from_buffer(truncated_parser);
+          }
+      }(),
+      std::out_of_range);
+}
+
+static void check_record_views(const model::record_batch& batch) {
+    auto records = batch.copy_records();
+    model::record_view_iterator it(batch);
+    iobuf encoded;
+    for (auto& r : records) {
+        auto view = it.next();
+        BOOST_REQUIRE(view);
+        BOOST_REQUIRE_EQUAL(view->size_bytes(), r.size_bytes());
+        BOOST_REQUIRE_EQUAL(view->offset_delta(), r.offset_delta());
+        BOOST_REQUIRE_EQUAL(view->timestamp_delta(), r.timestamp_delta());
+        BOOST_REQUIRE_EQUAL(view->key_size(), r.key_size());
+        BOOST_REQUIRE_EQUAL(view->copy_key(), r.key());
+        BOOST_REQUIRE_EQUAL(view->key_bytes(), iobuf_to_bytes(r.key()));
+        BOOST_REQUIRE_EQUAL(view->value_size(), r.value_size());
+        BOOST_REQUIRE_EQUAL(view->copy_value(), r.value());
+        BOOST_REQUIRE_EQUAL(
+          static_cast<size_t>(view->headers_count()), r.headers().size());
+        BOOST_REQUIRE(view->copy_headers() == r.headers());
+        BOOST_REQUIRE(view->copy() == r);
+        view->append_to(encoded);
+    }
+    BOOST_REQUIRE(!it.next());
+    BOOST_REQUIRE_EQUAL(encoded, batch.data());
+}
+
+SEASTAR_THREAD_TEST_CASE(record_views_match_records) {
+    auto batch = storage::test::make_random_batch(model::offset(0), 20, false);
+    check_record_views(batch);
+
+    // fields crossing the fragment ends
+    for (size_t frag_size : {1, 7, 64}) {
+        iobuf fragmented;
+        auto in = batch.data().copy();
+        while (!in.empty()) {
+            auto n = std::min(frag_size, in.size_bytes());
+            fragmented.append_fragments(in.share(0, n));
+            in.trim_front(n);
+        }
+        check_record_views(model::record_batch(
+          batch.header(),
+          std::move(fragmented),
+          model::record_batch::tag_ctor_ng{}));
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(record_views_of_truncated_batch) {
+    auto batch = storage::test::make_random_batch(model::offset(0), 10, false);
+    auto truncated = batch.data().copy();
+    truncated.trim_back(1);
+    model::record_batch b(
+      batch.header(), std::move(truncated), model::record_batch::tag_ctor_ng{});
+    model::record_view_iterator it(b);
+    BOOST_REQUIRE_THROW(
+      [&it] {
+          while (it.next()) {
+          }
+      }(),
+      std::out_of_range);
+}
+
+SEASTAR_THREAD_TEST_CASE(futurized_record_views) {
+    auto batch = storage::test::make_random_batch(model::offset(0), 10, false);
+    std::vector<int32_t> deltas;
+    model::for_each_record_view(batch, [&deltas](const model::record_view& r) {
+        deltas.push_back(r.offset_delta());
+        return ss::now();
+    }).get();
+    BOOST_REQUIRE_EQUAL(deltas.size(), size_t(10));
+    for (int32_t i = 0; i < 10; ++i) {
+        BOOST_REQUIRE_EQUAL(deltas[i], i);
+    }
+}
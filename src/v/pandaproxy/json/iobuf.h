@@ -45,8 +45,7 @@ public:
     inline std::pair<bool, std::optional<iobuf>>
     decode_base64(std::string_view v) {
         try {
-            auto decoded = base64_to_bytes(v);
-            return {true, bytes_to_iobuf(decoded)};
+            return {true, base64_to_iobuf(v)};
         } catch (const base64_decoder_exception&) {
             return {false, std::nullopt};
         }
@@ -82,8 +81,15 @@ public:
         if (buf.empty()) {
             return w.Null();
         }
-        // TODO Ben: Implement custom OutputStream to prevent this linearization
-        return w.String(iobuf_to_base64(buf));
+        // The base64 alphabet needs no escaping, the quoted encoding is
+        // written as is rather than scanned char by char by w.String
+        ss::sstring quoted(
+          ss::sstring::initialized_later{},
+          base64_encoded_capacity(buf.size_bytes()) + 2);
+        quoted[0] = '"';
+        const size_t len = iobuf_to_base64(buf, quoted.data() + 1);
+        quoted[len + 1] = '"';
+        return w.RawValue(quoted.data(), len + 2, rapidjson::kStringType);
     };
 
     bool encode_json(rapidjson::Writer<rapidjson::StringBuffer>& w, iobuf buf) {
@@ -25,7 +25,10 @@
 #include "pandaproxy/json/rjson_util.h"
 #include "pandaproxy/json/types.h"
 #include "seastarx.h"
+#include "units.h"
 
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/iostream.hh>
 #include <seastar/core/sstring.hh>
 
 #include <rapidjson/reader.h>
@@ -77,38 +80,79 @@ public:
       rapidjson::Writer<rapidjson::StringBuffer>& w,
       kafka::fetch_response&& res) {
         // Eager check for errors
+        check_errors(res);
+
+        w.StartArray();
+        for (auto& v : res) {
+            auto r = std::move(*v.partition_response);
+            model::topic_partition_view tpv(
+              v.partition->name, r.partition_index);
+            while (r.records && !r.records->empty()) {
+                serialize_batch(_fmt, w, tpv, *r.records);
+            }
+        }
+        w.EndArray();
+    }
+
+    /// Throws the error of the first partition that failed
+    static void check_errors(kafka::fetch_response& res) {
         for (auto& v : res) {
             if (v.partition_response->error_code != kafka::error_code::none) {
                 throw serialize_error(v.partition_response->error_code);
             }
         }
+    }
 
+    /// Writes the records to the stream as the batches are decoded, in chunks
+    /// of about flush_bytes, so that neither the whole JSON nor all of the
+    /// decoded records are ever held in memory. Errors must be checked with
+    /// check_errors before anything is written.
+    static ss::future<> stream(
+      ss::output_stream<char>& os,
+      serialization_format fmt,
+      kafka::fetch_response res,
+      size_t flush_bytes = 64_KiB) {
+        rapidjson::StringBuffer str_buf;
+        rapidjson::Writer<rapidjson::StringBuffer> w(str_buf);
         w.StartArray();
         for (auto& v : res) {
             auto r = std::move(*v.partition_response);
             model::topic_partition_view tpv(
               v.partition->name, r.partition_index);
             while (r.records && !r.records->empty()) {
-                auto adapter = r.records->consume_batch();
-                if (
-                  !adapter.batch
-                  || adapter.batch->header().attrs.is_control()) {
-                    continue;
+                serialize_batch(fmt, w, tpv, *r.records);
+                if (str_buf.GetSize() >= flush_bytes) {
+                    // The writer only appends to the buffer, which can be
+                    // emptied between values
+                    co_await os.write(str_buf.GetString(), str_buf.GetSize());
+                    str_buf.Clear();
                 }
-
-                auto rjs = rjson_serialize_impl<model::record>(
-                  _fmt, tpv, adapter.batch->base_offset());
-
-                adapter.batch->for_each_record(
-                  [&rjs, &w](model::record record) {
-                      rjs(w, std::move(record));
-                  });
             }
         }
         w.EndArray();
+        co_await os.write(str_buf.GetString(), str_buf.GetSize());
+        co_await os.flush();
     }
 
 private:
+    static void serialize_batch(
+      serialization_format fmt,
+      rapidjson::Writer<rapidjson::StringBuffer>& w,
+      model::topic_partition_view tpv,
+      kafka::batch_reader& records) {
+        auto adapter = records.consume_batch();
+        if (!adapter.batch || adapter.batch->header().attrs.is_control()) {
+            return;
+        }
+
+        auto rjs = rjson_serialize_impl<model::record>(
+          fmt, tpv, adapter.batch->base_offset());
+
+        adapter.batch->for_each_record([&rjs, &w](model::record record) {
+            rjs(w, std::move(record));
+        });
+    }
+
     serialization_format _fmt;
 };
 
@@ -98,3 +98,28 @@ SEASTAR_THREAD_TEST_CASE(test_produce_fetch_one) {
 
     BOOST_REQUIRE_EQUAL(str_buf.GetString(), expected);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_produce_fetch_stream) {
+    using serializer = ppj::rjson_serialize_impl<kafka::fetch_response>;
+    std::vector<model::topic_partition> tps = {
+      {model::topic{"topic1"}, model::partition_id{1}},
+      {model::topic{"topic2"}, model::partition_id{2}},
+    };
+    auto fmt = ppj::serialization_format::binary_v2;
+
+    rapidjson::StringBuffer str_buf;
+    rapidjson::Writer<rapidjson::StringBuffer> w(str_buf);
+    ppj::rjson_serialize_fmt(fmt)(
+      w, make_fetch_response(tps, model::offset{42}, 3));
+
+    // flushed after every batch
+    iobuf streamed;
+    auto os = make_iobuf_ref_output_stream(streamed);
+    serializer::stream(
+      os, fmt, make_fetch_response(tps, model::offset{42}, 3), 1)
+      .get();
+    os.close().get();
+
+    iobuf_parser p(std::move(streamed));
+    BOOST_REQUIRE_EQUAL(p.read_string(p.bytes_left()), str_buf.GetString());
+}
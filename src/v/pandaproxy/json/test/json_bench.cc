@@ -0,0 +1,88 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/bytes.h"
+#include "bytes/iobuf.h"
+#include "json/json.h"
+#include "pandaproxy/json/iobuf.h"
+#include "pandaproxy/json/rjson_util.h"
+#include "random/generators.h"
+#include "units.h"
+#include "utils/base64.h"
+
+#include <seastar/testing/perf_tests.hh>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+namespace ppj = pandaproxy::json;
+
+static constexpr size_t payload_bytes = 1_KiB;
+static constexpr size_t payloads = 64;
+
+static iobuf make_payload() {
+    return bytes_to_iobuf(random_generators::get_bytes(payload_bytes));
+}
+
+PERF_TEST(base64, encode_payloads) {
+    auto payload = make_payload();
+    rapidjson::StringBuffer str_buf;
+    rapidjson::Writer<rapidjson::StringBuffer> w(str_buf);
+    perf_tests::start_measuring_time();
+    w.StartArray();
+    for (size_t i = 0; i < payloads; ++i) {
+        ppj::rjson_serialize_fmt(ppj::serialization_format::binary_v2)(
+          w, payload.share(0, payload.size_bytes()));
+    }
+    w.EndArray();
+    perf_tests::do_not_optimize(str_buf.GetSize());
+    perf_tests::stop_measuring_time();
+    return payloads * payload_bytes;
+}
+
+PERF_TEST(base64, decode_payloads) {
+    auto encoded = iobuf_to_base64(make_payload());
+    auto parse = ppj::rjson_parse_impl<iobuf>(
+      ppj::serialization_format::binary_v2);
+    perf_tests::start_measuring_time();
+    for (size_t i = 0; i < payloads; ++i) {
+        auto decoded = parse(encoded);
+        perf_tests::do_not_optimize(decoded);
+    }
+    perf_tests::stop_measuring_time();
+    return payloads * payload_bytes;
+}
+
+static size_t write_strings(const ss::sstring& s) {
+    rapidjson::StringBuffer str_buf;
+    rapidjson::Writer<rapidjson::StringBuffer> w(str_buf);
+    perf_tests::start_measuring_time();
+    w.StartArray();
+    for (size_t i = 0; i < payloads; ++i) {
+        w.String(s.data(), s.size());
+    }
+    w.EndArray();
+    perf_tests::do_not_optimize(str_buf.GetSize());
+    perf_tests::stop_measuring_time();
+    return payloads * s.size();
+}
+
+PERF_TEST(json_string, unescaped) {
+    return write_strings(
+      random_generators::gen_alphanum_string(payload_bytes));
+}
+
+PERF_TEST(json_string, escaped) {
+    // one char out of 16 needs an escape
+    auto s = random_generators::gen_alphanum_string(payload_bytes);
+    for (size_t i = 0; i < s.size(); i += 16) {
+        s[i] = '"';
+    }
+    return write_strings(s);
+}
@@ -47,6 +47,14 @@ configuration::configuration()
       "api_doc_dir",
       "API doc directory",
       config::required::no,
-      "/usr/share/redpanda/proxy-api-doc") {}
+      "/usr/share/redpanda/proxy-api-doc")
+  , in_process_broker(
+      *this,
+      "in_process_broker",
+      "Serve produce and fetch requests for the partitions led by the broker "
+      "running the proxy without going through the kafka client. Not used "
+      "when SASL is enabled, so that requests are authorized as the client",
+      config::required::no,
+      true) {}
 
 } // namespace pandaproxy::rest
@@ -9,6 +9,8 @@
 
 #include "handlers.h"
 
+#include "hashing/jump_consistent_hash.h"
+#include "hashing/xx.h"
 #include "kafka/client/exceptions.h"
 #include "kafka/protocol/errors.h"
 #include "kafka/protocol/fetch.h"
@@ -156,19 +158,33 @@ get_topics_records(server::request_t rq, server::reply_t rp) {
     int32_t max_bytes{parse::query_param<int32_t>(*rq.req, "max_bytes")};
 
     rq.req.reset();
-    return rq.service()
-      .client()
-      .local()
-      .fetch_partition(std::move(tp), offset, max_bytes, timeout)
-      .then([res_fmt, rp = std::move(rp)](kafka::fetch_response res) mutable {
-          rapidjson::StringBuffer str_buf;
-          rapidjson::Writer<rapidjson::StringBuffer> w(str_buf);
-
-          ppj::rjson_serialize_fmt(res_fmt)(w, std::move(res));
-
-          // TODO Ben: Prevent this linearization
-          ss::sstring json_rslt = str_buf.GetString();
-          rp.rep->write_body("json", json_rslt);
+    auto* local = rq.service().local_broker();
+    auto fetched = local && local->is_local(tp)
+                     ? local->fetch_partition(
+                       std::move(tp), offset, max_bytes, timeout)
+                     : rq.service().client().local().fetch_partition(
+                       std::move(tp), offset, max_bytes, timeout);
+    return std::move(fetched).then(
+      [res_fmt, rp = std::move(rp)](kafka::fetch_response res) mutable {
+          using serializer = ppj::rjson_serialize_impl<kafka::fetch_response>;
+          // Fail the request before the status is sent
+          serializer::check_errors(res);
+
+          // The records are encoded as the body is sent, with chunked
+          // transfer encoding
+          rp.rep->write_body(
+            "json",
+            [res_fmt, res = std::move(res)](
+              ss::output_stream<char>&& out) mutable {
+                return ss::do_with(
+                  std::move(out),
+                  std::move(res),
+                  [res_fmt](
+                    ss::output_stream<char>& out, kafka::fetch_response& res) {
+                      return serializer::stream(out, res_fmt, std::move(res))
+                        .finally([&out] { return out.close(); });
+                  });
+            });
           rp.mime_type = res_fmt;
           return std::move(rp);
       });
@@ -189,8 +205,11 @@ post_topics_name(server::request_t rq, server::reply_t rp) {
     auto records = ppj::rjson_parse(
       rq.req->content.data(), ppj::produce_request_handler(req_fmt));
 
-    auto res = co_await rq.service().client().local().produce_records(
-      topic, std::move(records));
+    auto* local = rq.service().local_broker();
+    auto res = local && local->is_local(topic, records)
+                 ? co_await local->produce_records(topic, std::move(records))
+                 : co_await rq.service().client().local().produce_records(
+                   topic, std::move(records));
 
     auto json_rslt = ppj::rjson_serialize(res.data.responses[0]);
     rp.rep->write_body("json", json_rslt);
@@ -0,0 +1,263 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "pandaproxy/rest/local_broker.h"
+
+#include "cluster/metadata_cache.h"
+#include "cluster/partition_manager.h"
+#include "cluster/shard_table.h"
+#include "config/configuration.h"
+#include "kafka/server/handlers/fetch.h"
+#include "kafka/server/handlers/produce.h"
+#include "kafka/server/replicated_partition.h"
+#include "model/limits.h"
+#include "model/namespace.h"
+#include "model/record_batch_reader.h"
+#include "pandaproxy/logger.h"
+#include "raft/types.h"
+#include "storage/record_batch_builder.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/when_all.hh>
+
+#include <absl/container/node_hash_map.h>
+
+namespace pandaproxy::rest {
+
+local_broker::local_broker(
+  ss::sharded<cluster::partition_manager>& pm,
+  ss::sharded<cluster::shard_table>& st,
+  ss::sharded<cluster::metadata_cache>& md,
+  ss::smp_service_group smp_sg,
+  const kafka::client::configuration& client_config)
+  : _partition_manager(pm)
+  , _shard_table(st)
+  , _metadata_cache(md)
+  , _smp_sg(smp_sg)
+  , _client_config(client_config) {}
+
+ss::future<> local_broker::stop() {
+    for (auto& [tp, p] : _partitions) {
+        co_await p->stop();
+    }
+    co_await _gate.close();
+}
+
+std::optional<ss::shard_id>
+local_broker::local_shard(const model::ntp& ntp) const {
+    auto leader = _metadata_cache.local().get_leader_id(ntp);
+    if (!leader || *leader != config::shard_local_cfg().node_id()) {
+        return std::nullopt;
+    }
+    return _shard_table.local().shard_for(ntp);
+}
+
+bool local_broker::is_local(const model::topic_partition& tp) const {
+    return local_shard(
+             model::ntp(model::kafka_namespace, tp.topic, tp.partition))
+      .has_value();
+}
+
+bool local_broker::is_local(
+  const model::topic& topic,
+  const std::vector<kafka::client::record_essence>& records) const {
+    return std::all_of(
+      records.begin(), records.end(), [this, &topic](const auto& r) {
+          return r.partition_id
+                 && is_local(model::topic_partition(topic, *r.partition_id));
+      });
+}
+
+ss::future<kafka::produce_response> local_broker::produce_records(
+  model::topic topic, std::vector<kafka::client::record_essence> records) {
+    absl::node_hash_map<model::partition_id, storage::record_batch_builder>
+      partition_builders;
+    for (auto& record : records) {
+        auto it = partition_builders.find(*record.partition_id);
+        if (it == partition_builders.end()) {
+            it = partition_builders
+                   .emplace(
+                     *record.partition_id,
+                     storage::record_batch_builder(
+                       model::record_batch_type::raft_data, model::offset(0)))
+                   .first;
+        }
+        it->second.add_raw_kw(
+          std::move(record.key).value_or(iobuf{}),
+          std::move(record.value),
+          std::move(record.headers));
+    }
+
+    std::vector<ss::future<kafka::produce_response::partition>> produced;
+    produced.reserve(partition_builders.size());
+    for (auto& [id, builder] : partition_builders) {
+        produced.push_back(
+          get_context(model::topic_partition(topic, id))
+            ->produce(std::move(builder).build()));
+    }
+    auto responses = co_await ss::when_all_succeed(
+      produced.begin(), produced.end());
+
+    co_return kafka::produce_response{
+      .data = kafka::produce_response_data{
+        .responses{
+          {.name{std::move(topic)}, .partitions{std::move(responses)}}},
+        .throttle_time_ms{{std::chrono::milliseconds{0}}}}};
+}
+
+/// Runs on the shard owning the partition
+static ss::future<kafka::produce_response::partition> produce_on_shard(
+  cluster::partition_manager& mgr,
+  model::ntp ntp,
+  model::record_batch_reader reader,
+  int32_t num_records) {
+    const auto id = ntp.tp.partition;
+    auto partition = mgr.get(ntp);
+    if (!partition) {
+        co_return kafka::produce_response::partition{
+          .partition_index = id,
+          .error_code = kafka::error_code::unknown_topic_or_partition};
+    }
+    if (!partition->is_leader()) {
+        co_return kafka::produce_response::partition{
+          .partition_index = id,
+          .error_code = kafka::error_code::not_leader_for_partition};
+    }
+    kafka::replicated_partition rp(partition);
+    auto r = co_await rp.replicate(
+      std::move(reader),
+      raft::replicate_options(raft::consistency_level::quorum_ack));
+    if (!r) {
+        co_return kafka::produce_response::partition{
+          .partition_index = id,
+          .error_code = kafka::map_produce_error_code(r.error())};
+    }
+    rp.probe().add_records_produced(num_records);
+    // have to subtract num_of_records - 1 as base_offset is inclusive
+    co_return kafka::produce_response::partition{
+      .partition_index = id,
+      .error_code = kafka::error_code::none,
+      .base_offset = r.value() - model::offset(num_records - 1)};
+}
+
+local_broker::shared_produce_partition
+local_broker::get_context(const model::topic_partition& tp) {
+    if (auto it = _partitions.find(tp); it != _partitions.end()) {
+        return it->second;
+    }
+    return _partitions
+      .emplace(
+        tp,
+        ss::make_lw_shared<kafka::client::produce_partition>(
+          _client_config,
+          [this, tp](model::record_batch&& batch) {
+              send(tp, std::move(batch));
+          }))
+      .first->second;
+}
+
+void local_broker::send(
+  model::topic_partition tp, model::record_batch&& batch) {
+    model::ntp ntp(model::kafka_namespace, tp.topic, tp.partition);
+    (void)ss::try_with_gate(
+      _gate,
+      [this, ntp = std::move(ntp), batch = std::move(batch)]() mutable {
+          return replicate_batch(std::move(ntp), std::move(batch));
+      })
+      .handle_exception([id = tp.partition](const std::exception_ptr& e) {
+          vlog(plog.debug, "Local produce to partition {} failed: {}", id, e);
+          return kafka::produce_response::partition{
+            .partition_index = id,
+            .error_code = kafka::error_code::unknown_server_error};
+      })
+      .then([this, tp](kafka::produce_response::partition res) {
+          get_context(tp)->handle_response(std::move(res));
+      });
+}
+
+ss::future<kafka::produce_response::partition>
+local_broker::replicate_batch(model::ntp ntp, model::record_batch batch) {
+    auto shard = local_shard(ntp);
+    if (!shard) {
+        return ss::make_ready_future<kafka::produce_response::partition>(
+          kafka::produce_response::partition{
+            .partition_index = ntp.tp.partition,
+            .error_code = kafka::error_code::not_leader_for_partition});
+    }
+    const auto num_records = batch.record_count();
+    /// The owning shard has exclusive access to the batch of the reader
+    auto reader = model::make_foreign_memory_record_batch_reader(
+      std::move(batch));
+    return _partition_manager.invoke_on(
+      *shard,
+      _smp_sg,
+      [ntp = std::move(ntp), reader = std::move(reader), num_records](
+        cluster::partition_manager& mgr) mutable {
+          return produce_on_shard(
+            mgr, std::move(ntp), std::move(reader), num_records);
+      });
+}
+
+ss::future<kafka::fetch_response> local_broker::fetch_partition(
+  model::topic_partition tp,
+  model::offset offset,
+  int32_t max_bytes,
+  std::chrono::milliseconds timeout) {
+    model::ntp ntp(model::kafka_namespace, tp.topic, tp.partition);
+    kafka::fetch_response::partition_response pr{
+      .partition_index{tp.partition},
+      .error_code = kafka::error_code::not_leader_for_partition,
+      .high_watermark{model::offset{-1}},
+      .last_stable_offset{model::offset{-1}},
+      .log_start_offset{model::offset{-1}},
+      .aborted{},
+      .records{kafka::batch_reader()}};
+
+    if (auto shard = local_shard(ntp); shard) {
+        /// Like the fetch handler serving a fetch with min_bytes=0, there is
+        /// no wait for new data
+        kafka::fetch_config cfg{
+          .start_offset = offset,
+          .max_offset = model::model_limits<model::offset>::max(),
+          .isolation_level = model::isolation_level::read_uncommitted,
+          .max_bytes = static_cast<size_t>(std::max(max_bytes, 0)),
+          .timeout = model::timeout_clock::now() + timeout};
+        auto res = co_await _partition_manager.invoke_on(
+          *shard,
+          _smp_sg,
+          [ntp, cfg, &md = _metadata_cache](cluster::partition_manager& pm) {
+              return kafka::read_from_ntp(
+                pm, md.local(), ntp, cfg, true, cfg.timeout);
+          });
+        pr.error_code = res.error;
+        if (res.error == kafka::error_code::none) {
+            pr.high_watermark = res.high_watermark;
+            pr.last_stable_offset = res.last_stable_offset;
+            pr.log_start_offset = res.start_offset;
+            if (res.has_data()) {
+                pr.records = kafka::batch_reader(std::move(res).release_data());
+            }
+        }
+    }
+
+    std::vector<kafka::fetch_response::partition_response> responses;
+    responses.push_back(std::move(pr));
+    auto response = kafka::fetch_response::partition{.name = tp.topic};
+    response.partitions = std::move(responses);
+    std::vector<kafka::fetch_response::partition> parts;
+    parts.push_back(std::move(response));
+    co_return kafka::fetch_response{
+      .data = {
+        .error_code = kafka::error_code::none,
+        .topics = std::move(parts),
+      }};
+}
+
+} // namespace pandaproxy::rest
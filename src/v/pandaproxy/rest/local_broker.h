@@ -0,0 +1,110 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "cluster/fwd.h"
+#include "kafka/client/configuration.h"
+#include "kafka/client/produce_partition.h"
+#include "kafka/client/types.h"
+#include "kafka/protocol/fetch.h"
+#include "kafka/protocol/produce.h"
+#include "model/fundamental.h"
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/core/sharded.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+
+namespace pandaproxy::rest {
+
+/// In-process produce and fetch for a proxy running in the broker.
+///
+/// Requests sent with the kafka client are encoded, sent to the broker over a
+/// loopback connection and decoded, as are their responses. For the
+/// partitions led by this broker, requests are instead served on the shard
+/// owning the partition by the replication and read paths of the kafka
+/// handlers, and the responses are built in memory.
+///
+/// Requests for partitions led by other brokers, or whose topic is not known
+/// yet, still go through the kafka client, which follows the leadership
+/// changes and retries.
+///
+/// Like the producer of the kafka client, the records produced to a
+/// partition by concurrent requests of the shard are batched together by a
+/// kafka::client::produce_partition, with the produce_batch_* settings of the
+/// client, and every request gets the offsets of its own records.
+class local_broker {
+public:
+    local_broker(
+      ss::sharded<cluster::partition_manager>&,
+      ss::sharded<cluster::shard_table>&,
+      ss::sharded<cluster::metadata_cache>&,
+      ss::smp_service_group,
+      const kafka::client::configuration&);
+
+    /// Sends the batched records and waits for the batches in flight
+    ss::future<> stop();
+
+    /// True if this broker leads the partition
+    bool is_local(const model::topic_partition&) const;
+
+    /// True if all of the records name their partition and this broker leads
+    /// all of them
+    bool is_local(
+      const model::topic&,
+      const std::vector<kafka::client::record_essence>&) const;
+
+    /// Produces the records, with acks=all like the kafka client. A
+    /// partition whose leadership moved in the meantime fails with
+    /// not_leader_for_partition.
+    ss::future<kafka::produce_response> produce_records(
+      model::topic, std::vector<kafka::client::record_essence>);
+
+    ss::future<kafka::fetch_response> fetch_partition(
+      model::topic_partition,
+      model::offset,
+      int32_t max_bytes,
+      std::chrono::milliseconds timeout);
+
+private:
+    std::optional<ss::shard_id> local_shard(const model::ntp&) const;
+
+    using shared_produce_partition
+      = ss::lw_shared_ptr<kafka::client::produce_partition>;
+
+    shared_produce_partition get_context(const model::topic_partition&);
+
+    /// Replicates a batch of the records of one or more requests, the
+    /// response is handed to the produce_partition of the batch
+    void send(model::topic_partition, model::record_batch&&);
+
+    ss::future<kafka::produce_response::partition>
+      replicate_batch(model::ntp, model::record_batch);
+
+    ss::sharded<cluster::partition_manager>& _partition_manager;
+    ss::sharded<cluster::shard_table>& _shard_table;
+    ss::sharded<cluster::metadata_cache>& _metadata_cache;
+    ss::smp_service_group _smp_sg;
+    const kafka::client::configuration& _client_config;
+    absl::flat_hash_map<model::topic_partition, shared_produce_partition>
+      _partitions;
+    ss::gate _gate;
+};
+
+} // namespace pandaproxy::rest
@@ -67,6 +67,7 @@ proxy::proxy(
   : _config(config)
   , _mem_sem(max_memory)
   , _client(client)
+  , _smp_sg(smp_sg)
   , _ctx{{{}, _mem_sem, {}, smp_sg}, *this}
   , _server(
       "pandaproxy",
@@ -83,7 +84,18 @@ ss::future<> proxy::start() {
       _config.advertised_pandaproxy_api());
 }
 
-ss::future<> proxy::stop() { return _server.stop(); }
+ss::future<> proxy::stop() {
+    return _server.stop().then([this] {
+        return _local_broker ? _local_broker->stop() : ss::now();
+    });
+}
+
+void proxy::enable_local_broker(
+  ss::sharded<cluster::partition_manager>& pm,
+  ss::sharded<cluster::shard_table>& st,
+  ss::sharded<cluster::metadata_cache>& md) {
+    _local_broker.emplace(pm, st, md, _smp_sg, client_config());
+}
 
 configuration& proxy::config() { return _config; }
 
@@ -13,6 +13,7 @@
 
 #include "kafka/client/client.h"
 #include "pandaproxy/rest/configuration.h"
+#include "pandaproxy/rest/local_broker.h"
 #include "pandaproxy/server.h"
 #include "seastarx.h"
 
@@ -21,6 +22,7 @@
 #include <seastar/core/smp.hh>
 #include <seastar/net/socket_defs.hh>
 
+#include <optional>
 #include <vector>
 
 namespace pandaproxy::rest {
@@ -40,10 +42,25 @@ public:
     kafka::client::configuration& client_config();
     ss::sharded<kafka::client::client>& client() { return _client; }
 
+    /// Serves produce and fetch requests for the partitions led by this
+    /// broker in process, see local_broker
+    void enable_local_broker(
+      ss::sharded<cluster::partition_manager>&,
+      ss::sharded<cluster::shard_table>&,
+      ss::sharded<cluster::metadata_cache>&);
+
+    /// Null unless the proxy runs in the broker and in_process_broker is
+    /// enabled
+    rest::local_broker* local_broker() {
+        return _local_broker ? &*_local_broker : nullptr;
+    }
+
 private:
     configuration _config;
     ss::semaphore _mem_sem;
     ss::sharded<kafka::client::client>& _client;
+    ss::smp_service_group _smp_sg;
+    std::optional<rest::local_broker> _local_broker;
     ctx_server<proxy>::context_t _ctx;
     ctx_server<proxy> _server;
 };
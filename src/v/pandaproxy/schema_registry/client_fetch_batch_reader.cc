@@ -18,8 +18,13 @@
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/std-coroutine.hh>
 
+#include <optional>
+#include <utility>
+
 namespace pandaproxy::schema_registry {
 
+/// Once a fetch returns, the fetch of the following records is issued so
+/// that it overlaps with the consumption of the records of the reader.
 class client_fetcher final : public model::record_batch_reader::impl {
     using storage_t = model::record_batch_reader::storage_t;
 
@@ -34,6 +39,11 @@ public:
       , _next_offset{first}
       , _last_offset{last}
       , _batch_reader{} {}
+    client_fetcher(const client_fetcher&) = delete;
+    client_fetcher& operator=(const client_fetcher&) = delete;
+    client_fetcher(client_fetcher&&) = delete;
+    client_fetcher& operator=(client_fetcher&&) = delete;
+    ~client_fetcher() override { drop_prefetch(); }
 
     // Implements model::record_batch_reader::impl
     bool is_end_of_stream() const final { return _next_offset >= _last_offset; }
@@ -42,14 +52,26 @@ public:
     ss::future<storage_t>
     do_load_slice(model::timeout_clock::time_point t) final {
         if (!_batch_reader || _batch_reader->is_end_of_stream()) {
-            vlog(plog.debug, "Schema registry: fetch offset: {}", _next_offset);
-            auto res = co_await _client.fetch_partition(
-              _tp, _next_offset, 1_MiB, t - model::timeout_clock::now());
+            kafka::fetch_response res;
+            if (_prefetch && _prefetch->first == _next_offset) {
+                auto prefetched = std::move(_prefetch->second);
+                _prefetch.reset();
+                res = co_await std::move(prefetched);
+            } else {
+                drop_prefetch();
+                res = co_await fetch(_next_offset, t);
+            }
             vlog(plog.debug, "Schema registry: fetch result: {}", res);
             vassert(
               res.begin() != res.end() && ++res.begin() == res.end(),
               "Expected exactly one response from client::fetch_partition");
             _batch_reader = std::move(res.begin()->partition_response->records);
+            if (_batch_reader && !_batch_reader->empty()) {
+                auto next = _batch_reader->last_offset() + model::offset{1};
+                if (next < _last_offset) {
+                    _prefetch.emplace(next, fetch(next, t));
+                }
+            }
         }
         auto ret = co_await _batch_reader->do_load_slice(t);
         using data_t = model::record_batch_reader::data_t;
@@ -73,11 +95,31 @@ public:
     }
 
 private:
+    ss::future<kafka::fetch_response>
+    fetch(model::offset offset, model::timeout_clock::time_point t) {
+        vlog(plog.debug, "Schema registry: fetch offset: {}", offset);
+        return _client.fetch_partition(
+          _tp, offset, 1_MiB, t - model::timeout_clock::now());
+    }
+
+    void drop_prefetch() {
+        if (!_prefetch) {
+            return;
+        }
+        auto prefetched = std::move(_prefetch->second);
+        _prefetch.reset();
+        (void)std::move(prefetched).discard_result().handle_exception(
+          [](const std::exception_ptr&) {});
+    }
+
     kafka::client::client& _client;
     model::topic_partition _tp;
     model::offset _next_offset;
     model::offset _last_offset;
     std::optional<kafka::batch_reader> _batch_reader;
+    /// Fetch in flight of the records from the offset
+    std::optional<std::pair<model::offset, ss::future<kafka::fetch_response>>>
+      _prefetch;
 };
 
 model::record_batch_reader make_client_fetch_batch_reader(
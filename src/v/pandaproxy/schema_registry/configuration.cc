@@ -37,6 +37,13 @@ configuration::configuration()
       "`default_topic_replication`",
       config::required::no,
       std::nullopt)
+  , schema_registry_store_snapshot(
+      *this,
+      "schema_registry_store_snapshot",
+      "Keep a local snapshot of the schemas in the data directory, so that "
+      "startup only reads the records of _schemas written since the snapshot",
+      config::required::no,
+      true)
   , api_doc_dir(
       *this,
       "api_doc_dir",
@@ -27,6 +27,7 @@ struct configuration final : public config::config_store {
     config::one_or_many_property<config::endpoint_tls_config>
       schema_registry_api_tls;
     config::property<std::optional<int16_t>> schema_registry_replication_factor;
+    config::property<bool> schema_registry_store_snapshot;
     config::property<ss::sstring> api_doc_dir;
 };
 
@@ -107,6 +107,62 @@ ss::future<bool> seq_writer::produce_and_check(
     }
 };
 
+ss::future<> seq_writer::restore_snapshot(
+  std::filesystem::path path, model::offset max_offset) {
+    return container().invoke_on(
+      0, _smp_opts, [path, max_offset](seq_writer& seq) {
+          return ss::with_semaphore(
+            seq._wait_for_sem, 1, [&seq, path, max_offset]() {
+                return seq.restore_snapshot_inner(path, max_offset);
+            });
+      });
+}
+
+ss::future<> seq_writer::restore_snapshot_inner(
+  std::filesystem::path path, model::offset max_offset) {
+    if (_loaded_offset >= model::offset{0}) {
+        co_return;
+    }
+    try {
+        auto offset = co_await _store.restore_snapshot(path, max_offset);
+        if (offset) {
+            vlog(
+              plog.info,
+              "Schema registry: restored store snapshot at offset {}",
+              *offset);
+            advance_offset_inner(*offset);
+            _snapshot_offset = *offset;
+        }
+    } catch (...) {
+        // Reads replay the whole topic, the records of the snapshot that
+        // were restored are applied again
+        vlog(
+          plog.warn,
+          "Schema registry: failed to restore store snapshot {}: {}",
+          path.string(),
+          std::current_exception());
+    }
+}
+
+ss::future<> seq_writer::write_snapshot(std::filesystem::path path) {
+    return container().invoke_on(0, _smp_opts, [path](seq_writer& seq) {
+        return ss::with_semaphore(seq._wait_for_sem, 1, [&seq, path]() {
+            return seq.write_snapshot_inner(path);
+        });
+    });
+}
+
+ss::future<> seq_writer::write_snapshot_inner(std::filesystem::path path) {
+    if (_loaded_offset <= _snapshot_offset) {
+        co_return;
+    }
+    auto offset = _loaded_offset;
+    co_await _store.write_snapshot(path, offset);
+    _snapshot_offset = offset;
+    vlog(
+      plog.debug, "Schema registry: wrote store snapshot at offset {}", offset);
+}
+
 ss::future<> seq_writer::advance_offset(model::offset offset) {
     auto remote = [offset](seq_writer& s) { s.advance_offset_inner(offset); };
 
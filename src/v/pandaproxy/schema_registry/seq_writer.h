@@ -18,6 +18,8 @@
 #include "random/simple_time_jitter.h"
 #include "utils/retry.h"
 
+#include <filesystem>
+
 namespace pandaproxy::schema_registry {
 
 using namespace std::chrono_literals;
@@ -38,6 +40,18 @@ public:
 
     ss::future<> read_sync();
 
+    /// Block until this offset is available, fetching if necessary
+    ss::future<> wait_for(model::offset offset);
+
+    /// Restore the store from a local snapshot, unless reads already loaded
+    /// some of the topic, see sharded_store::restore_snapshot
+    ss::future<>
+    restore_snapshot(std::filesystem::path path, model::offset max_offset);
+
+    /// Write a snapshot of the store as loaded so far, unless the last
+    /// snapshot restored or written is as recent
+    ss::future<> write_snapshot(std::filesystem::path path);
+
     // API for readers: notify us when they have read and applied an offset
     ss::future<> advance_offset(model::offset offset);
 
@@ -128,8 +142,9 @@ private:
     ss::future<bool>
     produce_and_check(model::offset write_at, model::record_batch batch);
 
-    /// Block until this offset is available, fetching if necessary
-    ss::future<> wait_for(model::offset offset);
+    ss::future<> restore_snapshot_inner(
+      std::filesystem::path path, model::offset max_offset);
+    ss::future<> write_snapshot_inner(std::filesystem::path path);
 
     // Global (Shard 0) State
     // ======================
@@ -141,6 +156,9 @@ private:
     /// Shard 0 only: Reads have progressed as far as this offset
     model::offset _loaded_offset{-1};
 
+    /// Shard 0 only: Offset of the last snapshot restored or written
+    model::offset _snapshot_offset{-1};
+
     /// Shard 0 only: Serialize write operations.
     ss::semaphore _write_sem{1};
 
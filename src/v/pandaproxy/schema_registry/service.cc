@@ -17,7 +17,6 @@
 #include "pandaproxy/api/api-doc/schema_registry.json.h"
 #include "pandaproxy/error.h"
 #include "pandaproxy/logger.h"
-#include "pandaproxy/schema_registry/client_fetch_batch_reader.h"
 #include "pandaproxy/schema_registry/configuration.h"
 #include "pandaproxy/schema_registry/handlers.h"
 #include "pandaproxy/schema_registry/storage.h"
@@ -195,12 +194,32 @@ ss::future<> service::fetch_internal_topic() {
     auto max_offset = partition.offset;
     vlog(plog.debug, "Schema registry: _schemas max_offset: {}", max_offset);
 
-    co_await make_client_fetch_batch_reader(
-      _client.local(),
-      model::schema_registry_internal_tp,
-      model::offset{0},
-      max_offset)
-      .consume(consume_to_store{_store, writer()}, model::no_timeout);
+    // Only the records written since the snapshot are read, the reads of
+    // the other shards find the offset loaded already
+    if (_config.schema_registry_store_snapshot()) {
+        co_await writer().restore_snapshot(snapshot_path(), max_offset);
+    }
+    co_await writer().wait_for(max_offset - model::offset{1});
+    co_await write_snapshot();
+}
+
+ss::future<> service::write_snapshot() {
+    if (!_config.schema_registry_store_snapshot()) {
+        co_return;
+    }
+    try {
+        co_await writer().write_snapshot(snapshot_path());
+    } catch (...) {
+        vlog(
+          plog.warn,
+          "Schema registry: failed to write store snapshot: {}",
+          std::current_exception());
+    }
+}
+
+std::filesystem::path service::snapshot_path() {
+    return config::shard_local_cfg().data_directory().path
+           / "schema_registry_store.snapshot";
 }
 
 service::service(
@@ -236,6 +255,9 @@ ss::future<> service::start() {
 ss::future<> service::stop() {
     co_await _gate.close();
     co_await _server.stop();
+    if (ss::this_shard_id() == 0) {
+        co_await write_snapshot();
+    }
 }
 
 configuration& service::config() { return _config; }
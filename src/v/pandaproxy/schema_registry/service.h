@@ -24,6 +24,7 @@
 #include <seastar/core/smp.hh>
 #include <seastar/net/socket_defs.hh>
 
+#include <filesystem>
 #include <vector>
 
 namespace pandaproxy::schema_registry {
@@ -51,6 +52,9 @@ private:
     ss::future<> do_start();
     ss::future<> create_internal_topic();
     ss::future<> fetch_internal_topic();
+    /// Snapshot of the store, restored before reading _schemas at startup
+    static std::filesystem::path snapshot_path();
+    ss::future<> write_snapshot();
     configuration _config;
     ss::semaphore _mem_sem;
     ss::gate _gate;
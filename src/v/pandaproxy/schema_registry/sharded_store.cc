@@ -20,11 +20,14 @@
 #include "pandaproxy/schema_registry/exceptions.h"
 #include "pandaproxy/schema_registry/schema_util.h"
 #include "pandaproxy/schema_registry/store.h"
+#include "pandaproxy/schema_registry/store_snapshot.h"
 #include "pandaproxy/schema_registry/types.h"
+#include "utils/file_io.h"
 #include "vlog.h"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/seastar.hh>
 #include <seastar/core/smp.hh>
 #include <seastar/core/std-coroutine.hh>
 
@@ -36,10 +39,6 @@ ss::shard_id shard_for(const subject& sub) {
     auto hash = xxhash_64(sub().data(), sub().length());
     return jump_consistent_hash(hash, ss::smp::count);
 }
-
-ss::shard_id shard_for(schema_id id) {
-    return jump_consistent_hash(id(), ss::smp::count);
-}
 } // namespace
 
 ss::future<> sharded_store::start(ss::smp_service_group sg) {
@@ -76,12 +75,7 @@ sharded_store::project_ids(const canonical_schema& schema) {
     }
 
     // Figure out if the definition already exists
-    auto map = [&schema](store& s) { return s.get_schema_id(schema.def()); };
-    auto reduce = [](
-                    std::optional<schema_id> acc,
-                    std::optional<schema_id> s_id) { return acc ? acc : s_id; };
-    auto s_id = co_await _store.map_reduce0(
-      map, std::optional<schema_id>{}, reduce);
+    auto s_id = _store.local().get_schema_id(schema.def());
 
     if (!s_id) {
         // New schema, project an ID for it.
@@ -152,9 +146,7 @@ sharded_store::has_schema(const canonical_schema& schema) {
 
 ss::future<canonical_schema_definition>
 sharded_store::get_schema_definition(const schema_id& id) {
-    auto schema = co_await _store.invoke_on(
-      shard_for(id), _smp_opts, &store::get_schema_definition, id);
-    co_return std::move(schema).value();
+    co_return _store.local().get_schema_definition(id).value();
 }
 
 ss::future<std::vector<subject_version>>
@@ -171,14 +163,20 @@ sharded_store::get_schema_subject_versions(schema_id id) {
 
 ss::future<subject_schema> sharded_store::get_subject_schema(
   const subject& sub, schema_version version, include_deleted inc_del) {
-    auto res = co_await _store.invoke_on(
+    auto v_id = co_await _store.invoke_on(
       shard_for(sub),
       _smp_opts,
-      &store::get_subject_schema,
+      &store::get_subject_version_id,
       sub,
       version,
       inc_del);
-    co_return res.value();
+    auto entry = std::move(v_id).value();
+    auto def = _store.local().get_schema_definition(entry.id).value();
+    co_return subject_schema{
+      .schema = {sub, std::move(def), std::move(entry.refs)},
+      .version = entry.version,
+      .id = entry.id,
+      .deleted = entry.deleted};
 }
 
 ss::future<std::vector<subject>>
@@ -305,8 +303,10 @@ ss::future<bool> sharded_store::clear_compatibility(const subject& sub) {
 ss::future<bool>
 sharded_store::upsert_schema(schema_id id, canonical_schema_definition def) {
     co_await maybe_update_max_schema_id(id);
-    co_return co_await _store.invoke_on(
-      shard_for(id), _smp_opts, &store::upsert_schema, id, std::move(def));
+    // Schema definitions are immutable, every shard keeps a replica so that
+    // lookups by id never cross shards
+    auto map = [id, &def](store& s) { return s.upsert_schema(id, def); };
+    co_return co_await _store.map_reduce0(map, false, std::logical_or<>{});
 }
 
 ss::future<sharded_store::insert_subject_result> sharded_store::insert_subject(
@@ -426,9 +426,9 @@ ss::future<bool> sharded_store::is_compatible(
             continue;
         }
 
-        auto old_schema = co_await get_schema_definition(ver_it->id);
+        // Compiled once per shard and kept by the store
         auto old_avro
-          = make_avro_schema_definition(std::move(old_schema).raw()()).value();
+          = _store.local().get_avro_schema_definition(ver_it->id).value();
 
         if (
           compat == compatibility_level::backward
@@ -446,4 +446,72 @@ ss::future<bool> sharded_store::is_compatible(
     co_return is_compat;
 }
 
+ss::future<> sharded_store::write_snapshot(
+  std::filesystem::path path, model::offset offset) {
+    store_snapshot snap{
+      .offset = offset,
+      .compatibility = _store.local().get_compatibility().value(),
+      .schemas = _store.local().get_schemas()};
+    using subjects_t = decltype(snap.subjects);
+    snap.subjects = co_await _store.map_reduce0(
+      [](const store& s) { return s.get_subject_entries(); },
+      subjects_t{},
+      [](subjects_t acc, subjects_t subs) {
+          acc.insert(
+            acc.end(),
+            std::make_move_iterator(subs.begin()),
+            std::make_move_iterator(subs.end()));
+          return acc;
+      });
+    auto buf = co_await encode_store_snapshot(std::move(snap));
+
+    // Replace the previous snapshot only once the new one is complete
+    auto tmp = path;
+    tmp += ".tmp";
+    co_await write_fully(tmp, std::move(buf));
+    co_await ss::rename_file(tmp.native(), path.native());
+    co_await ss::sync_directory(path.parent_path().native());
+}
+
+ss::future<std::optional<model::offset>> sharded_store::restore_snapshot(
+  std::filesystem::path path, model::offset max_offset) {
+    if (!co_await ss::file_exists(path.native())) {
+        co_return std::nullopt;
+    }
+    auto buf = co_await read_fully(path);
+    auto offset = check_store_snapshot(buf);
+    if (!offset) {
+        vlog(plog.warn, "Ignoring invalid store snapshot {}", path.string());
+        co_return std::nullopt;
+    }
+    if (*offset >= max_offset) {
+        // The topic was recreated or truncated since the snapshot
+        vlog(
+          plog.warn,
+          "Ignoring store snapshot {} at offset {}, _schemas ends at {}",
+          path.string(),
+          *offset,
+          max_offset);
+        co_return std::nullopt;
+    }
+
+    // Every shard reads the snapshot itself rather than sharing the buffer
+    // of this shard
+    auto max_id = co_await _store.map_reduce0(
+      [path](store& s) {
+          return read_fully(path).then([&s](iobuf buf) {
+              return restore_store_snapshot(
+                s, std::move(buf), [](const subject& sub) {
+                    return shard_for(sub) == ss::this_shard_id();
+                });
+          });
+      },
+      invalid_schema_id,
+      [](schema_id acc, schema_id id) { return std::max(acc, id); });
+    if (max_id != invalid_schema_id) {
+        co_await maybe_update_max_schema_id(max_id);
+    }
+    co_return offset;
+}
+
 } // namespace pandaproxy::schema_registry
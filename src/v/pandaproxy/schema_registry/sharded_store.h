@@ -11,16 +11,25 @@
 
 #pragma once
 
+#include "model/fundamental.h"
 #include "pandaproxy/schema_registry/types.h"
 
 #include <seastar/core/sharded.hh>
 
+#include <filesystem>
+#include <optional>
+
 namespace pandaproxy::schema_registry {
 
 class store;
 
 ///\brief Dispatch requests to shards based on a a hash of the
-/// subject or schema_id
+/// subject.
+///
+/// Schema definitions are immutable once they have an id, so every shard
+/// keeps a replica of them: lookups by id are served by the local shard, and
+/// the avro schemas compiled for compatibility checks are kept by the local
+/// store.
 class sharded_store {
 public:
     ss::future<> start(ss::smp_service_group sg);
@@ -108,6 +117,19 @@ public:
     ss::future<bool>
     is_compatible(schema_version version, const canonical_schema& new_schema);
 
+    ///\brief Write the state of all shards to a local snapshot, tied to the
+    /// offset of _schemas up to which it was loaded.
+    ss::future<> write_snapshot(std::filesystem::path path, model::offset);
+
+    ///\brief Restore the state of all shards from a local snapshot.
+    ///
+    /// The snapshot is only used if it is tied to an offset before
+    /// max_offset, the next offset of _schemas. Every shard decodes the
+    /// snapshot in parallel, keeping all of the schemas and the subjects it
+    /// owns. Returns the offset the restored snapshot is tied to.
+    ss::future<std::optional<model::offset>>
+    restore_snapshot(std::filesystem::path path, model::offset max_offset);
+
 private:
     ss::future<bool>
     upsert_schema(schema_id id, canonical_schema_definition def);
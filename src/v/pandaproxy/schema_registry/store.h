@@ -12,6 +12,7 @@
 #pragma once
 
 #include "pandaproxy/logger.h"
+#include "pandaproxy/schema_registry/avro.h"
 #include "pandaproxy/schema_registry/errors.h"
 #include "pandaproxy/schema_registry/types.h"
 
@@ -88,6 +89,24 @@ public:
         return {it->second.definition};
     }
 
+    ///\brief Return the compiled avro schema of the id.
+    ///
+    /// The schema is compiled on the first call and kept with the entry, so
+    /// that compatibility checks do not parse the definitions again.
+    result<avro_schema_definition>
+    get_avro_schema_definition(const schema_id& id) {
+        auto it = _schemas.find(id);
+        if (it == _schemas.end()) {
+            return not_found(id);
+        }
+        auto& entry = it->second;
+        if (!entry.avro) {
+            entry.avro.emplace(BOOST_OUTCOME_TRYX(
+              make_avro_schema_definition(entry.definition.raw()())));
+        }
+        return *entry.avro;
+    }
+
     ///\brief Return the id of the schema, if it already exists.
     std::optional<schema_id>
     get_schema_id(const canonical_schema_definition& def) const {
@@ -487,21 +506,50 @@ public:
         return !found;
     }
 
+    struct subject_entry {
+        std::optional<compatibility_level> compatibility;
+        std::vector<subject_version_entry> versions;
+        is_deleted deleted{false};
+
+        std::vector<seq_marker> written_at;
+    };
+
+    ///\brief Return every schema, for a snapshot of the store.
+    std::vector<std::pair<schema_id, canonical_schema_definition>>
+    get_schemas() const {
+        std::vector<std::pair<schema_id, canonical_schema_definition>> res;
+        res.reserve(_schemas.size());
+        for (const auto& [id, entry] : _schemas) {
+            res.emplace_back(id, entry.definition);
+        }
+        return res;
+    }
+
+    ///\brief Return every subject, for a snapshot of the store.
+    std::vector<std::pair<subject, subject_entry>> get_subject_entries() const {
+        std::vector<std::pair<subject, subject_entry>> res;
+        res.reserve(_subjects.size());
+        for (const auto& [sub, entry] : _subjects) {
+            res.emplace_back(sub, entry);
+        }
+        return res;
+    }
+
+    ///\brief Restore a subject from a snapshot of the store.
+    void restore_subject(subject sub, subject_entry entry) {
+        _subjects.insert_or_assign(std::move(sub), std::move(entry));
+    }
+
 private:
     struct schema_entry {
         explicit schema_entry(canonical_schema_definition definition)
           : definition{std::move(definition)} {}
 
         canonical_schema_definition definition;
+        /// Compiled on demand by get_avro_schema_definition
+        std::optional<avro_schema_definition> avro;
     };
 
-    struct subject_entry {
-        std::optional<compatibility_level> compatibility;
-        std::vector<subject_version_entry> versions;
-        is_deleted deleted{false};
-
-        std::vector<seq_marker> written_at;
-    };
     using schema_map = absl::btree_map<schema_id, schema_entry>;
     using subject_map = absl::node_hash_map<subject, subject_entry>;
 
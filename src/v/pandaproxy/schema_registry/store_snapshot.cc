@@ -0,0 +1,198 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "pandaproxy/schema_registry/store_snapshot.h"
+
+#include "bytes/iobuf_parser.h"
+#include "bytes/utils.h"
+#include "hashing/crc32c.h"
+#include "reflection/adl.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/future-util.hh>
+#include <seastar/core/preempt.hh>
+
+namespace pandaproxy::schema_registry {
+
+namespace {
+
+constexpr uint32_t snapshot_magic = 0x53525353; // "SRSS"
+constexpr int8_t snapshot_version = 0;
+/// magic, version, offset, payload size and payload crc
+constexpr size_t snapshot_header_size = sizeof(uint32_t) + sizeof(int8_t)
+                                        + sizeof(int64_t) + sizeof(uint64_t)
+                                        + sizeof(uint32_t);
+
+template<typename T>
+void write(iobuf& out, T t) {
+    reflection::adl<T>{}.to(out, std::move(t));
+}
+
+template<typename T>
+T read(iobuf_parser& in) {
+    return reflection::adl<T>{}.from(in);
+}
+
+ss::future<> maybe_yield() {
+    return ss::need_preempt() ? ss::later() : ss::now();
+}
+
+void write_subject_entry(iobuf& out, store::subject_entry entry) {
+    write(out, entry.compatibility);
+    write(out, entry.deleted);
+    write(out, static_cast<uint32_t>(entry.versions.size()));
+    for (auto& v : entry.versions) {
+        write(out, v.version);
+        write(out, v.id);
+        write(out, static_cast<uint32_t>(v.refs.size()));
+        for (auto& ref : v.refs) {
+            write(out, std::move(ref.name));
+            write(out, std::move(ref.sub));
+            write(out, ref.version);
+        }
+        write(out, v.deleted);
+    }
+    write(out, static_cast<uint32_t>(entry.written_at.size()));
+    for (const auto& m : entry.written_at) {
+        write(out, m.seq);
+        write(out, m.node);
+        write(out, m.version);
+        write(out, m.key_type);
+    }
+}
+
+store::subject_entry read_subject_entry(iobuf_parser& in) {
+    store::subject_entry entry;
+    entry.compatibility = read<std::optional<compatibility_level>>(in);
+    entry.deleted = read<is_deleted>(in);
+    const auto versions = read<uint32_t>(in);
+    entry.versions.reserve(versions);
+    for (uint32_t i = 0; i < versions; ++i) {
+        auto version = read<schema_version>(in);
+        auto id = read<schema_id>(in);
+        const auto num_refs = read<uint32_t>(in);
+        canonical_schema::references refs;
+        refs.reserve(num_refs);
+        for (uint32_t r = 0; r < num_refs; ++r) {
+            refs.push_back(schema_reference{
+              .name = read<ss::sstring>(in),
+              .sub = read<subject>(in),
+              .version = read<schema_version>(in)});
+        }
+        auto deleted = read<is_deleted>(in);
+        entry.versions.emplace_back(version, id, std::move(refs), deleted);
+    }
+    const auto markers = read<uint32_t>(in);
+    entry.written_at.reserve(markers);
+    for (uint32_t i = 0; i < markers; ++i) {
+        entry.written_at.push_back(seq_marker{
+          .seq = read<std::optional<model::offset>>(in),
+          .node = read<std::optional<model::node_id>>(in),
+          .version = read<schema_version>(in),
+          .key_type = read<seq_marker_key_type>(in)});
+    }
+    return entry;
+}
+
+} // namespace
+
+ss::future<iobuf> encode_store_snapshot(store_snapshot snap) {
+    iobuf payload;
+    write(payload, snap.compatibility);
+    write(payload, static_cast<uint32_t>(snap.schemas.size()));
+    for (auto& [id, def] : snap.schemas) {
+        write(payload, id);
+        write(payload, def.type());
+        auto raw = std::move(def).raw();
+        write(payload, std::move(raw()));
+        co_await maybe_yield();
+    }
+    write(payload, static_cast<uint32_t>(snap.subjects.size()));
+    for (auto& [sub, entry] : snap.subjects) {
+        iobuf body;
+        write_subject_entry(body, std::move(entry));
+        write(payload, std::move(sub));
+        write(payload, static_cast<uint32_t>(body.size_bytes()));
+        payload.append(std::move(body));
+        co_await maybe_yield();
+    }
+
+    crc::crc32c crc;
+    crc_extend_iobuf(crc, payload);
+    iobuf out;
+    write(out, snapshot_magic);
+    write(out, snapshot_version);
+    write(out, snap.offset);
+    write(out, static_cast<uint64_t>(payload.size_bytes()));
+    write(out, crc.value());
+    out.append(std::move(payload));
+    co_return out;
+}
+
+std::optional<model::offset> check_store_snapshot(iobuf& buf) {
+    if (buf.size_bytes() < snapshot_header_size) {
+        return std::nullopt;
+    }
+    iobuf_parser in(buf.share(0, buf.size_bytes()));
+    if (
+      read<uint32_t>(in) != snapshot_magic
+      || read<int8_t>(in) != snapshot_version) {
+        return std::nullopt;
+    }
+    auto offset = read<model::offset>(in);
+    const auto size = read<uint64_t>(in);
+    const auto expected_crc = read<uint32_t>(in);
+    if (size != in.bytes_left()) {
+        return std::nullopt;
+    }
+    crc::crc32c crc;
+    crc_extend_iobuf(crc, in.share(size));
+    if (crc.value() != expected_crc) {
+        return std::nullopt;
+    }
+    return offset;
+}
+
+ss::future<schema_id> restore_store_snapshot(
+  store& s,
+  iobuf buf,
+  ss::noncopyable_function<bool(const subject&)> owned) {
+    iobuf_parser in(std::move(buf));
+    in.skip(snapshot_header_size);
+
+    s.set_compatibility(read<compatibility_level>(in)).value();
+
+    auto max_id = invalid_schema_id;
+    const auto schemas = read<uint32_t>(in);
+    for (uint32_t i = 0; i < schemas; ++i) {
+        auto id = read<schema_id>(in);
+        auto type = read<schema_type>(in);
+        s.upsert_schema(
+          id, canonical_schema_definition{read<ss::sstring>(in), type});
+        max_id = std::max(max_id, id);
+        co_await maybe_yield();
+    }
+
+    const auto subjects = read<uint32_t>(in);
+    for (uint32_t i = 0; i < subjects; ++i) {
+        auto sub = read<subject>(in);
+        const auto size = read<uint32_t>(in);
+        if (!owned(sub)) {
+            in.skip(size);
+            continue;
+        }
+        s.restore_subject(std::move(sub), read_subject_entry(in));
+        co_await maybe_yield();
+    }
+    co_return max_id;
+}
+
+} // namespace pandaproxy::schema_registry
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "model/fundamental.h"
+#include "pandaproxy/schema_registry/store.h"
+#include "pandaproxy/schema_registry/types.h"
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace pandaproxy::schema_registry {
+
+///\brief State of the store, tied to the offset of _schemas up to which it
+/// was loaded.
+///
+/// The encoded snapshot starts with a header holding the offset and a crc of
+/// the payload. The payload holds the global compatibility, every schema,
+/// then every subject framed by its size, so that a reader skips the subjects
+/// it does not own without decoding them.
+struct store_snapshot {
+    model::offset offset;
+    compatibility_level compatibility{compatibility_level::backward};
+    std::vector<std::pair<schema_id, canonical_schema_definition>> schemas;
+    std::vector<std::pair<subject, store::subject_entry>> subjects;
+};
+
+ss::future<iobuf> encode_store_snapshot(store_snapshot);
+
+///\brief Return the offset of the snapshot, or std::nullopt if the buffer is
+/// not a complete snapshot of a known version.
+std::optional<model::offset> check_store_snapshot(iobuf&);
+
+///\brief Restore the schemas and the global compatibility of a snapshot that
+/// passed check_store_snapshot, and the subjects that are owned.
+///
+/// Returns the highest schema id of the snapshot.
+ss::future<schema_id> restore_store_snapshot(
+  store&, iobuf, ss::noncopyable_function<bool(const subject&)> owned);
+
+} // namespace pandaproxy::schema_registry
@@ -678,3 +678,23 @@ BOOST_AUTO_TEST_CASE(test_store_delete_subject_after_delete_version) {
       expected_vers.cbegin(),
       expected_vers.cend());
 }
+
+BOOST_AUTO_TEST_CASE(test_store_get_avro_schema_definition) {
+    pps::store s;
+
+    auto missing = s.get_avro_schema_definition(pps::schema_id{1});
+    BOOST_REQUIRE(missing.has_error());
+    BOOST_REQUIRE_EQUAL(
+      missing.error().code(), pps::error_code::schema_id_not_found);
+
+    auto id = s.insert({subject0, string_def0}).id;
+    auto first = s.get_avro_schema_definition(id);
+    BOOST_REQUIRE(first.has_value());
+
+    // The compiled schema is kept with the entry
+    auto second = s.get_avro_schema_definition(id);
+    BOOST_REQUIRE(second.has_value());
+    BOOST_REQUIRE(
+      first.value()().root().get() == second.value()().root().get());
+    BOOST_REQUIRE(pps::check_compatible(first.value(), second.value()));
+}
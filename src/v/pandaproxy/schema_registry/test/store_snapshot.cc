@@ -0,0 +1,116 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "pandaproxy/schema_registry/sharded_store.h"
+#include "pandaproxy/schema_registry/test/compatibility_avro.h"
+#include "pandaproxy/schema_registry/types.h"
+#include "random/generators.h"
+#include "utils/file_io.h"
+
+#include <seastar/core/seastar.hh>
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/defer.hh>
+
+#include <boost/test/unit_test.hpp>
+
+namespace pp = pandaproxy;
+namespace pps = pp::schema_registry;
+
+SEASTAR_THREAD_TEST_CASE(test_store_snapshot_roundtrip) {
+    const std::filesystem::path path{
+      "./test_store_snapshot." + random_generators::gen_alphanum_string(8)};
+    auto remove_snapshot = ss::defer(
+      [&path]() { ss::remove_file(path.native()).get(); });
+
+    const pps::subject sub0{"sub0"};
+    const pps::subject sub1{"sub1"};
+    pps::seq_marker dummy_marker;
+    const pps::seq_marker marker{
+      .seq = model::offset{2},
+      .node = model::node_id{1},
+      .version = pps::schema_version{2},
+      .key_type = pps::seq_marker_key_type::schema};
+    {
+        pps::sharded_store s;
+        s.start(ss::default_smp_service_group()).get();
+        auto stop_store = ss::defer([&s]() { s.stop().get(); });
+
+        s.set_compatibility(pps::compatibility_level::forward).get();
+        s.upsert(
+           dummy_marker,
+           {sub0, pps::canonical_schema_definition{schema1}},
+           pps::schema_id{1},
+           pps::schema_version{1},
+           pps::is_deleted::no)
+          .get();
+        s.upsert(
+           marker,
+           {sub0, pps::canonical_schema_definition{schema2}},
+           pps::schema_id{2},
+           pps::schema_version{2},
+           pps::is_deleted::yes)
+          .get();
+        s.upsert(
+           dummy_marker,
+           {sub1, pps::canonical_schema_definition{schema2}},
+           pps::schema_id{2},
+           pps::schema_version{1},
+           pps::is_deleted::no)
+          .get();
+        s.set_compatibility(
+           dummy_marker, sub1, pps::compatibility_level::none)
+          .get();
+        s.write_snapshot(path, model::offset{4}).get();
+    }
+
+    pps::sharded_store s;
+    s.start(ss::default_smp_service_group()).get();
+    auto stop_store = ss::defer([&s]() { s.stop().get(); });
+
+    // Not usable with a topic that ends before the snapshot
+    BOOST_REQUIRE(!s.restore_snapshot(path, model::offset{4}).get());
+    BOOST_REQUIRE(s.get_subjects(pps::include_deleted::yes).get().empty());
+
+    auto offset = s.restore_snapshot(path, model::offset{5}).get();
+    BOOST_REQUIRE(offset.has_value());
+    BOOST_REQUIRE_EQUAL(*offset, model::offset{4});
+
+    BOOST_REQUIRE(
+      s.get_compatibility().get() == pps::compatibility_level::forward);
+    BOOST_REQUIRE(
+      s.get_compatibility(sub1, pps::default_to_global::no).get()
+      == pps::compatibility_level::none);
+    BOOST_REQUIRE(
+      s.get_schema_definition(pps::schema_id{2}).get()
+      == pps::canonical_schema_definition{schema2});
+
+    auto versions = s.get_versions(sub0, pps::include_deleted::yes).get();
+    BOOST_REQUIRE_EQUAL(versions.size(), 2);
+    BOOST_REQUIRE(
+      s.is_subject_version_deleted(sub0, pps::schema_version{2}).get()
+      == pps::is_deleted::yes);
+    auto schema = s.get_subject_schema(
+                     sub1, pps::schema_version{1}, pps::include_deleted::no)
+                    .get();
+    BOOST_REQUIRE_EQUAL(schema.id, pps::schema_id{2});
+    auto written_at
+      = s.get_subject_version_written_at(sub0, pps::schema_version{2}).get();
+    BOOST_REQUIRE_EQUAL(written_at.size(), 1);
+    BOOST_REQUIRE(written_at.front().seq == marker.seq);
+    BOOST_REQUIRE(written_at.front().node == marker.node);
+
+    // A truncated snapshot is ignored
+    auto buf = read_fully(path).get();
+    buf.trim_back(1);
+    write_fully(path, std::move(buf)).get();
+    pps::sharded_store other;
+    other.start(ss::default_smp_service_group()).get();
+    auto stop_other = ss::defer([&other]() { other.stop().get(); });
+    BOOST_REQUIRE(!other.restore_snapshot(path, model::offset{5}).get());
+}
@@ -0,0 +1,321 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "config/configuration.h"
+#include "model/fundamental.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "seastarx.h"
+
+#include <seastar/core/metrics.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/sstring.hh>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/node_hash_map.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/// \brief per partition metrics that can be aggregated per topic or per
+/// shard to bound the number of series of nodes with many partitions.
+///
+/// Probes describe their summable metrics with a list of metric and call
+/// setup(): depending on the partition_metrics_aggregation property the
+/// metrics either get their own series, labelled by namespace, topic and
+/// partition, or are added to the series of their topic or shard, whose
+/// value is the sum of the values of its partitions. Partitions of the
+/// topics in partition_metrics_topics keep their own series.
+///
+/// Metrics that are not summable, e.g. offsets or histograms, should only
+/// be registered when per_partition() is true.
+namespace partition_metrics {
+
+enum class aggregation { partition, topic, shard };
+
+inline std::optional<aggregation> parse_aggregation(std::string_view s) {
+    if (s == "partition") {
+        return aggregation::partition;
+    }
+    if (s == "topic") {
+        return aggregation::topic;
+    }
+    if (s == "shard") {
+        return aggregation::shard;
+    }
+    return std::nullopt;
+}
+
+/// validator of the partition_metrics_aggregation property
+inline std::optional<ss::sstring> validate_aggregation(const ss::sstring& s) {
+    if (!parse_aggregation(s)) {
+        return ss::sstring(
+          "must be one of 'partition', 'topic' or 'shard'");
+    }
+    return std::nullopt;
+}
+
+enum class metric_kind { gauge, counter, total_bytes };
+
+struct metric {
+    const char* name;
+    const char* description;
+    metric_kind kind;
+    std::function<double()> value;
+};
+
+/// \brief series shared by the partitions of a topic or shard
+class registry {
+    struct series {
+        std::vector<metric_kind> kinds;
+        /// values of the counters of the partitions that left the series,
+        /// so that they do not go backwards
+        std::vector<double> retired;
+        absl::flat_hash_map<uint64_t, std::vector<std::function<double()>>>
+          members;
+        ss::metrics::metric_groups metrics;
+
+        double sum(size_t i) const {
+            double v = retired[i];
+            for (const auto& [_, values] : members) {
+                v += values[i]();
+            }
+            return v;
+        }
+    };
+
+public:
+    /// \brief the metrics of a partition in aggregated series, removed from
+    /// them on destruction. The values of the metrics must outlive it.
+    class member {
+    public:
+        member() = default;
+        member(const member&) = delete;
+        member& operator=(const member&) = delete;
+        member(member&& o) noexcept
+          : _registry(std::exchange(o._registry, nullptr))
+          , _key(o._key)
+          , _id(o._id) {}
+        member& operator=(member&& o) noexcept {
+            if (this != &o) {
+                reset();
+                _registry = std::exchange(o._registry, nullptr);
+                _key = o._key;
+                _id = o._id;
+            }
+            return *this;
+        }
+        ~member() noexcept { reset(); }
+
+    private:
+        friend class registry;
+        member(registry& r, const ss::sstring& key, uint64_t id)
+          : _registry(&r)
+          , _key(&key)
+          , _id(id) {}
+
+        void reset() noexcept {
+            if (_registry) {
+                std::exchange(_registry, nullptr)->remove(*_key, _id);
+            }
+        }
+
+        registry* _registry{nullptr};
+        /// key of the series in the registry, stable until they are removed
+        const ss::sstring* _key{nullptr};
+        uint64_t _id{0};
+    };
+
+    /// adds the metrics to the series of the group with the given labels,
+    /// creating them on first use
+    member add(
+      const ss::sstring& group,
+      const std::vector<ss::metrics::label_instance>& labels,
+      std::vector<metric> metrics) {
+        auto key = group;
+        for (const auto& l : labels) {
+            key += fmt::format(",{}={}", l.key(), l.value());
+        }
+        // probes may share a group, their series are told apart by names
+        for (const auto& m : metrics) {
+            key += fmt::format(",{}", m.name);
+        }
+        auto [it, inserted] = _series.try_emplace(key);
+        auto& s = it->second;
+        if (inserted) {
+            register_series(s, group, labels, metrics);
+        }
+        std::vector<std::function<double()>> values;
+        values.reserve(metrics.size());
+        for (auto& m : metrics) {
+            values.push_back(std::move(m.value));
+        }
+        const auto id = _next_id++;
+        s.members.emplace(id, std::move(values));
+        return member(*this, it->first, id);
+    }
+
+    /// number of aggregated series groups
+    size_t size() const { return _series.size(); }
+
+    static registry& local() {
+        static thread_local registry r;
+        return r;
+    }
+
+private:
+    static void register_series(
+      series& s,
+      const ss::sstring& group,
+      const std::vector<ss::metrics::label_instance>& labels,
+      const std::vector<metric>& metrics) {
+        namespace sm = ss::metrics;
+        s.retired.resize(metrics.size(), 0);
+        std::vector<sm::metric_definition> defs;
+        defs.reserve(metrics.size());
+        for (size_t i = 0; i < metrics.size(); ++i) {
+            const auto& m = metrics[i];
+            auto value = [&s, i] { return s.sum(i); };
+            switch (m.kind) {
+            case metric_kind::gauge:
+                defs.push_back(sm::make_gauge(
+                  m.name, value, sm::description(m.description), labels));
+                break;
+            case metric_kind::counter:
+                defs.push_back(sm::make_derive(
+                  m.name,
+                  [value] { return static_cast<int64_t>(value()); },
+                  sm::description(m.description),
+                  labels));
+                break;
+            case metric_kind::total_bytes:
+                defs.push_back(sm::make_total_bytes(
+                  m.name,
+                  [value] { return static_cast<int64_t>(value()); },
+                  sm::description(m.description),
+                  labels));
+                break;
+            }
+            s.kinds.push_back(m.kind);
+        }
+        s.metrics.add_group(group, defs);
+    }
+
+    void remove(const ss::sstring& key, uint64_t id) noexcept {
+        auto it = _series.find(key);
+        if (it == _series.end()) {
+            return;
+        }
+        auto& s = it->second;
+        if (auto m = s.members.find(id); m != s.members.end()) {
+            for (size_t i = 0; i < s.kinds.size(); ++i) {
+                if (s.kinds[i] != metric_kind::gauge) {
+                    s.retired[i] += m->second[i]();
+                }
+            }
+            s.members.erase(m);
+        }
+        if (s.members.empty()) {
+            _series.erase(it);
+        }
+    }
+
+    absl::node_hash_map<ss::sstring, series> _series;
+    uint64_t _next_id{0};
+};
+
+/// whether the metrics of the partition get their own series
+inline bool per_partition(const model::ntp& ntp) {
+    const auto& cfg = config::shard_local_cfg();
+    if (
+      parse_aggregation(cfg.partition_metrics_aggregation())
+      == aggregation::partition) {
+        return true;
+    }
+    const auto& topics = cfg.partition_metrics_topics();
+    return std::find(topics.begin(), topics.end(), ntp.tp.topic())
+           != topics.end();
+}
+
+/// labels of the series of the metrics of the partition
+inline std::vector<ss::metrics::label_instance>
+labels(const model::ntp& ntp) {
+    namespace sm = ss::metrics;
+    auto ns_label = sm::label("namespace");
+    auto topic_label = sm::label("topic");
+    auto partition_label = sm::label("partition");
+    if (per_partition(ntp)) {
+        return {
+          ns_label(ntp.ns()),
+          topic_label(ntp.tp.topic()),
+          partition_label(ntp.tp.partition()),
+        };
+    }
+    if (
+      parse_aggregation(
+        config::shard_local_cfg().partition_metrics_aggregation())
+      == aggregation::topic) {
+        return {ns_label(ntp.ns()), topic_label(ntp.tp.topic())};
+    }
+    return {};
+}
+
+/// \brief registers the summable metrics of the partition, with their own
+/// series in \p own or in the aggregated series held by \p aggregated
+inline void setup(
+  const ss::sstring& group,
+  const model::ntp& ntp,
+  std::vector<metric> metrics,
+  ss::metrics::metric_groups& own,
+  registry::member& aggregated) {
+    namespace sm = ss::metrics;
+    const auto name = prometheus_sanitize::metrics_name(group);
+    if (!per_partition(ntp)) {
+        aggregated = registry::local().add(
+          name, labels(ntp), std::move(metrics));
+        return;
+    }
+    const auto l = labels(ntp);
+    std::vector<sm::metric_definition> defs;
+    defs.reserve(metrics.size());
+    for (auto& m : metrics) {
+        switch (m.kind) {
+        case metric_kind::gauge:
+            defs.push_back(sm::make_gauge(
+              m.name, std::move(m.value), sm::description(m.description), l));
+            break;
+        case metric_kind::counter:
+            defs.push_back(sm::make_derive(
+              m.name,
+              [v = std::move(m.value)] { return static_cast<int64_t>(v()); },
+              sm::description(m.description),
+              l));
+            break;
+        case metric_kind::total_bytes:
+            defs.push_back(sm::make_total_bytes(
+              m.name,
+              [v = std::move(m.value)] { return static_cast<int64_t>(v()); },
+              sm::description(m.description),
+              l));
+            break;
+        }
+    }
+    own.add_group(name, defs);
+}
+
+} // namespace partition_metrics
@@ -0,0 +1,215 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "raft/append_entries_batcher.h"
+
+#include "config/configuration.h"
+#include "likely.h"
+#include "raft/errc.h"
+#include "raft/logger.h"
+#include "rpc/errc.h"
+#include "vlog.h"
+
+#include <seastar/core/future-util.hh>
+
+#include <algorithm>
+#include <type_traits>
+
+namespace raft {
+
+append_entries_batcher::append_entries_batcher(consensus_client_protocol next)
+  : _next(std::move(next)) {}
+
+ss::future<result<append_entries_reply>> append_entries_batcher::append_entries(
+  model::node_id n, append_entries_request&& r, rpc::client_opts opts) {
+    return enqueue<append_entries_traits>(
+      n,
+      std::move(r),
+      std::move(opts),
+      config::shard_local_cfg().raft_enable_append_entries_batching());
+}
+
+ss::future<result<vote_reply>> append_entries_batcher::vote(
+  model::node_id n, vote_request&& r, rpc::client_opts opts) {
+    return enqueue<vote_traits>(
+      n,
+      std::move(r),
+      std::move(opts),
+      config::shard_local_cfg().raft_enable_vote_batching());
+}
+
+template<typename Traits>
+append_entries_batcher::queue<Traits>& append_entries_batcher::queue_for() {
+    if constexpr (std::is_same_v<Traits, vote_traits>) {
+        return _votes;
+    } else {
+        return _append_entries;
+    }
+}
+
+template<typename Traits>
+ss::future<result<typename Traits::reply_t>> append_entries_batcher::enqueue(
+  model::node_id n,
+  typename Traits::request_t&& r,
+  rpc::client_opts opts,
+  bool batching_enabled) {
+    auto& q = queue_for<Traits>();
+    if (
+      !batching_enabled || q.batching_unsupported.contains(n)
+      || _gate.is_closed()) {
+        return Traits::send(_next, n, std::move(r), std::move(opts));
+    }
+
+    auto& pending = q.pending[n];
+    pending.push_back(
+      pending_request<Traits>{std::move(r), std::move(opts), {}});
+    auto f = pending.back().reply.get_future();
+    if (pending.size() == 1) {
+        // first request queued for the node, the requests issued by other
+        // groups until the reactor gets back to us are sent together
+        (void)ss::with_gate(_gate, [this, n] {
+            return ss::later().then([this, n] { return flush<Traits>(n); });
+        }).handle_exception([n](const std::exception_ptr& e) {
+            vlog(
+              raftlog.warn, "Error sending batched requests to {}: {}", n, e);
+        });
+    }
+    return f;
+}
+
+template<typename Traits>
+ss::future<> append_entries_batcher::flush(model::node_id n) {
+    auto& q = queue_for<Traits>();
+    auto it = q.pending.find(n);
+    if (it == q.pending.end()) {
+        return ss::now();
+    }
+    auto requests = std::move(it->second);
+    q.pending.erase(it);
+
+    if (requests.size() == 1) {
+        auto& p = requests.front();
+        ss::futurize_invoke([this, n, &p] {
+            return Traits::send(
+              _next, n, std::move(p.request), std::move(p.opts));
+        }).forward_to(std::move(p.reply));
+        return ss::now();
+    }
+    return send_batch<Traits>(n, std::move(requests));
+}
+
+template<typename Traits>
+ss::future<> append_entries_batcher::send_batch(
+  model::node_id n, pending_t<Traits> requests) {
+    using reply_t = typename Traits::reply_t;
+    typename Traits::batch_request_t batch;
+    batch.requests.reserve(requests.size());
+    // the batch must not time out before any of its requests would
+    auto timeout = rpc::clock_type::time_point::min();
+    for (auto& p : requests) {
+        timeout = std::max(timeout, p.opts.timeout);
+        batch.requests.push_back(std::move(p.request));
+    }
+
+    auto f = ss::futurize_invoke(
+      [this, n, batch = std::move(batch), timeout]() mutable {
+          return Traits::send_batch(
+            _next, n, std::move(batch), rpc::client_opts(timeout));
+      });
+    // per request options, holding the callers resource units, are kept
+    // until the batch is answered
+    return f.then_wrapped(
+      [this, n, requests = std::move(requests)](
+        ss::future<result<typename Traits::batch_reply_t>> f) mutable {
+          if (f.failed()) {
+              auto e = f.get_exception();
+              for (auto& p : requests) {
+                  p.reply.set_exception(e);
+              }
+              return;
+          }
+          auto r = f.get0();
+          if (!r) {
+              if (r.error() == rpc::errc::method_not_found) {
+                  vlog(
+                    raftlog.info,
+                    "node {} does not support batched requests, sending them "
+                    "one by one",
+                    n);
+                  queue_for<Traits>().batching_unsupported.insert(n);
+              }
+              for (auto& p : requests) {
+                  p.reply.set_value(result<reply_t>(r.error()));
+              }
+              return;
+          }
+          auto& replies = r.value().replies;
+          if (unlikely(replies.size() != requests.size())) {
+              vlog(
+                raftlog.warn,
+                "received {} batched replies from {}, expected {}",
+                replies.size(),
+                n,
+                requests.size());
+              for (auto& p : requests) {
+                  p.reply.set_value(result<reply_t>(Traits::dispatch_error));
+              }
+              return;
+          }
+          for (size_t i = 0; i < requests.size(); ++i) {
+              requests[i].reply.set_value(
+                result<reply_t>(std::move(replies[i])));
+          }
+      });
+}
+
+ss::future<> append_entries_batcher::stop() { return _gate.close(); }
+
+ss::future<result<append_entries_batch_reply>>
+append_entries_batcher::append_entries_batch(
+  model::node_id n, append_entries_batch_request&& r, rpc::client_opts opts) {
+    return _next.append_entries_batch(n, std::move(r), std::move(opts));
+}
+
+ss::future<result<vote_batch_reply>> append_entries_batcher::vote_batch(
+  model::node_id n, vote_batch_request&& r, rpc::client_opts opts) {
+    return _next.vote_batch(n, std::move(r), std::move(opts));
+}
+
+ss::future<result<heartbeat_reply>> append_entries_batcher::heartbeat(
+  model::node_id n, heartbeat_request&& r, rpc::client_opts opts) {
+    return _next.heartbeat(n, std::move(r), std::move(opts));
+}
+
+ss::future<result<install_snapshot_reply>>
+append_entries_batcher::install_snapshot(
+  model::node_id n, install_snapshot_request&& r, rpc::client_opts opts) {
+    return _next.install_snapshot(n, std::move(r), std::move(opts));
+}
+
+ss::future<result<timeout_now_reply>> append_entries_batcher::timeout_now(
+  model::node_id n, timeout_now_request&& r, rpc::client_opts opts) {
+    return _next.timeout_now(n, std::move(r), std::move(opts));
+}
+
+ss::future<bool> append_entries_batcher::ensure_disconnect(model::node_id n) {
+    return _next.ensure_disconnect(n);
+}
+
+ss::future<result<transfer_leadership_reply>>
+append_entries_batcher::transfer_leadership(
+  model::node_id n, transfer_leadership_request&& r, rpc::client_opts opts) {
+    return _next.transfer_leadership(n, std::move(r), std::move(opts));
+}
+
+ss::future<> append_entries_batcher::reset_backoff(model::node_id n) {
+    return _next.reset_backoff(n);
+}
+
+} // namespace raft
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/metadata.h"
+#include "outcome.h"
+#include "raft/consensus_client_protocol.h"
+#include "raft/errc.h"
+#include "raft/types.h"
+#include "rpc/types.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+
+#include <vector>
+
+namespace raft {
+
+/**
+ * Shard level client protocol multiplexing the append entries requests of
+ * all raft groups replicating to the same node, similarly to what
+ * heartbeat_manager does for heartbeats.
+ *
+ * Requests issued for a node are queued until the tasks already scheduled on
+ * the reactor ran, then sent together in a single append_entries_batch RPC.
+ * A single queued request is sent as a plain append_entries RPC. Nodes that
+ * do not support the batched RPC are remembered and served with plain
+ * append_entries RPCs.
+ *
+ * Vote requests, which are issued by many groups at nearly the same time when
+ * a node restarts or looses the leadership of its groups, are batched in the
+ * same way with the vote_batch RPC.
+ *
+ * All the other requests are forwarded as is.
+ */
+class append_entries_batcher final : public consensus_client_protocol::impl {
+public:
+    explicit append_entries_batcher(consensus_client_protocol);
+
+    ss::future<result<vote_reply>>
+    vote(model::node_id, vote_request&&, rpc::client_opts) final;
+
+    ss::future<result<vote_batch_reply>>
+    vote_batch(model::node_id, vote_batch_request&&, rpc::client_opts) final;
+
+    ss::future<result<append_entries_reply>> append_entries(
+      model::node_id, append_entries_request&&, rpc::client_opts) final;
+
+    ss::future<result<append_entries_batch_reply>> append_entries_batch(
+      model::node_id, append_entries_batch_request&&, rpc::client_opts) final;
+
+    ss::future<result<heartbeat_reply>>
+    heartbeat(model::node_id, heartbeat_request&&, rpc::client_opts) final;
+
+    ss::future<result<install_snapshot_reply>> install_snapshot(
+      model::node_id, install_snapshot_request&&, rpc::client_opts) final;
+
+    ss::future<result<timeout_now_reply>>
+    timeout_now(model::node_id, timeout_now_request&&, rpc::client_opts) final;
+
+    ss::future<bool> ensure_disconnect(model::node_id) final;
+
+    ss::future<result<transfer_leadership_reply>> transfer_leadership(
+      model::node_id, transfer_leadership_request&&, rpc::client_opts) final;
+
+    ss::future<> reset_backoff(model::node_id) final;
+
+    ss::future<> stop();
+
+private:
+    struct append_entries_traits {
+        using request_t = append_entries_request;
+        using reply_t = append_entries_reply;
+        using batch_request_t = append_entries_batch_request;
+        using batch_reply_t = append_entries_batch_reply;
+        static constexpr errc dispatch_error
+          = errc::append_entries_dispatch_error;
+
+        static ss::future<result<reply_t>> send(
+          consensus_client_protocol& p,
+          model::node_id n,
+          request_t&& r,
+          rpc::client_opts opts) {
+            return p.append_entries(n, std::move(r), std::move(opts));
+        }
+        static ss::future<result<batch_reply_t>> send_batch(
+          consensus_client_protocol& p,
+          model::node_id n,
+          batch_request_t&& r,
+          rpc::client_opts opts) {
+            return p.append_entries_batch(n, std::move(r), std::move(opts));
+        }
+    };
+
+    struct vote_traits {
+        using request_t = vote_request;
+        using reply_t = vote_reply;
+        using batch_request_t = vote_batch_request;
+        using batch_reply_t = vote_batch_reply;
+        static constexpr errc dispatch_error = errc::vote_dispatch_error;
+
+        static ss::future<result<reply_t>> send(
+          consensus_client_protocol& p,
+          model::node_id n,
+          request_t&& r,
+          rpc::client_opts opts) {
+            return p.vote(n, std::move(r), std::move(opts));
+        }
+        static ss::future<result<batch_reply_t>> send_batch(
+          consensus_client_protocol& p,
+          model::node_id n,
+          batch_request_t&& r,
+          rpc::client_opts opts) {
+            return p.vote_batch(n, std::move(r), std::move(opts));
+        }
+    };
+
+    template<typename Traits>
+    struct pending_request {
+        typename Traits::request_t request;
+        rpc::client_opts opts;
+        ss::promise<result<typename Traits::reply_t>> reply;
+    };
+    template<typename Traits>
+    using pending_t = std::vector<pending_request<Traits>>;
+
+    /// requests of a single kind queued per node
+    template<typename Traits>
+    struct queue {
+        absl::flat_hash_map<model::node_id, pending_t<Traits>> pending;
+        absl::flat_hash_set<model::node_id> batching_unsupported;
+    };
+
+    template<typename Traits>
+    ss::future<result<typename Traits::reply_t>> enqueue(
+      model::node_id,
+      typename Traits::request_t&&,
+      rpc::client_opts,
+      bool batching_enabled);
+    template<typename Traits>
+    ss::future<> flush(model::node_id);
+    template<typename Traits>
+    ss::future<> send_batch(model::node_id, pending_t<Traits>);
+    template<typename Traits>
+    queue<Traits>& queue_for();
+
+    consensus_client_protocol _next;
+    queue<append_entries_traits> _append_entries;
+    queue<vote_traits> _votes;
+    ss::gate _gate;
+};
+
+} // namespace raft
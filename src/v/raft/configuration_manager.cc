@@ -56,6 +56,7 @@ ss::future<> configuration_manager::truncate(model::offset offset) {
             _next_index = it->second.idx;
         }
         _configurations.erase(it, _configurations.end());
+        ++_version;
 
         _highest_known_offset = std::min(offset, _highest_known_offset);
         return store_highest_known_offset().then(
@@ -117,6 +118,7 @@ ss::future<> configuration_manager::prefix_truncate(model::offset offset) {
         _configurations.erase(_configurations.begin(), it);
         const auto [_, success] = _configurations.emplace(
           offset, std::move(config));
+        ++_version;
         vassert(
           success,
           "Inserting configuration after prefix truncate must succeed, "
@@ -158,6 +160,7 @@ void configuration_manager::add_configuration(
           "already exists",
           offset));
     }
+    ++_version;
 }
 
 ss::future<>
@@ -337,6 +340,7 @@ configuration_manager::start(bool reset, model::revision_id initial_revision) {
             f = deserialize_configurations(_next_index, std::move(*map_buf))
                   .then([this](underlying_t cfgs) {
                       _configurations = std::move(cfgs);
+                      ++_version;
                       if (!_configurations.empty()) {
                           _highest_known_offset
                             = _configurations.rbegin()->first;
@@ -463,6 +467,7 @@ ss::future<> configuration_manager::adjust_configuration_idx(
               cfg.idx = idx++;
           }
           _next_index = idx;
+          ++_version;
       });
 }
 
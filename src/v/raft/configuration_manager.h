@@ -163,6 +163,12 @@ public:
 
     int64_t offset_delta(model::offset) const;
 
+    /**
+     * Changes every time the set of configurations or their indices change,
+     * allows users to cache results derived from the configurations.
+     */
+    uint64_t version() const { return _version; }
+
     ss::future<> adjust_configuration_idx(configuration_idx);
 
     friend std::ostream&
@@ -208,5 +214,6 @@ private:
     model::revision_id _initial_revision{};
     ctx_log& _ctxlog;
     configuration_idx _next_index{0};
+    uint64_t _version{0};
 };
 } // namespace raft
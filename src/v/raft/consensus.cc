@@ -12,7 +12,7 @@
 #include "config/configuration.h"
 #include "likely.h"
 #include "model/metadata.h"
-#include "prometheus/prometheus_sanitize.h"
+#include "prometheus/partition_metrics.h"
 #include "raft/consensus_client_protocol.h"
 #include "raft/consensus_utils.h"
 #include "raft/errc.h"
@@ -87,6 +87,8 @@ consensus::consensus(
         maybe_step_down();
         dispatch_vote(false);
     });
+    _write_caching_flush_timer.set_callback(
+      [this] { dispatch_background_flush(); });
 }
 
 void consensus::setup_metrics() {
@@ -95,16 +97,46 @@ void consensus::setup_metrics() {
     }
 
     _probe.setup_metrics(_log.config().ntp());
-    auto labels = probe::create_metric_labels(_log.config().ntp());
-    namespace sm = ss::metrics;
-
-    _metrics.add_group(
-      prometheus_sanitize::metrics_name("raft"),
-      {sm::make_gauge(
-        "leader_for",
-        [this] { return is_leader(); },
-        sm::description("Number of groups for which node is a leader"),
-        labels)});
+    using partition_metrics::metric_kind;
+    partition_metrics::setup(
+      "raft",
+      _log.config().ntp(),
+      {
+        {"leader_for",
+         "Number of groups for which node is a leader",
+         metric_kind::gauge,
+         [this] { return is_leader(); }},
+        {"recovering_followers",
+         "Number of followers the leader is recovering",
+         metric_kind::gauge,
+         [this] {
+             return std::count_if(
+               _fstats.begin(), _fstats.end(), [](const auto& f) {
+                   return f.second.is_recovering;
+               });
+         }},
+        {"recovery_pending_offsets",
+         "Number of offsets the recovering followers are behind the leader "
+         "log end",
+         metric_kind::gauge,
+         [this] { return recovery_pending_offsets(); }},
+      },
+      _metrics,
+      _aggregated_metrics);
+}
+
+int64_t consensus::recovery_pending_offsets() const {
+    if (!is_leader()) {
+        return 0;
+    }
+    const auto dirty_offset = _log.offsets().dirty_offset;
+    int64_t pending = 0;
+    for (const auto& [_, f] : _fstats) {
+        if (f.is_recovering && f.match_index < dirty_offset) {
+            pending += dirty_offset() - f.match_index();
+        }
+    }
+    return pending;
 }
 
 void consensus::do_step_down() {
@@ -129,6 +161,31 @@ void consensus::maybe_step_down() {
     });
 }
 
+bool consensus::has_leader_lease() const {
+    if (
+      !config::shard_local_cfg().raft_enable_leader_lease() || !is_leader()
+      || _transferring_leadership
+      || clock_type::now() < _leader_lease_revoked_until) {
+        return false;
+    }
+    auto acked = config().quorum_match([this](vnode rni) {
+        if (rni == _self) {
+            return clock_type::now();
+        }
+        if (auto it = _fstats.find(rni); it != _fstats.end()) {
+            return it->second.lease_acked_at;
+        }
+        return clock_type::time_point::min();
+    });
+    if (acked == clock_type::time_point::min()) {
+        return false;
+    }
+    // followers do not grant votes for an election timeout after hearing
+    // from the leader, half of it is left as a margin for clock drift and
+    // scheduling delays
+    return acked + _jit.base_duration() / 2 > clock_type::now();
+}
+
 clock_type::time_point consensus::majority_heartbeat() const {
     return config().quorum_match([this](vnode rni) {
         if (rni == _self) {
@@ -148,6 +205,7 @@ clock_type::time_point consensus::majority_heartbeat() const {
 void consensus::shutdown_input() {
     if (likely(!_as.abort_requested())) {
         _vote_timeout.cancel();
+        _write_caching_flush_timer.cancel();
         _as.request_abort();
         _commit_index_updated.broken();
         _disk_append.broken();
@@ -217,6 +275,7 @@ consensus::success_reply consensus::update_follower_index(
     if (unlikely(reply.result == append_entries_reply::status::timeout)) {
         // ignore this response, timed out on the receiver node
         vlog(_ctxlog.trace, "Append entries request timedout at node {}", node);
+        append_entries_failed(idx, seq);
         return success_reply::no;
     }
     if (unlikely(
@@ -268,6 +327,10 @@ consensus::success_reply consensus::update_follower_index(
      * accepting request with seq 98, which should be rejected
      */
     idx.last_received_seq = std::max(seq, idx.last_received_seq);
+    if (idx.last_failed_seq && seq > *idx.last_failed_seq) {
+        // follower state is known again, resume pipelining
+        idx.last_failed_seq.reset();
+    }
 
     // check preconditions for processing the reply
     if (!is_leader()) {
@@ -283,6 +346,15 @@ consensus::success_reply consensus::update_follower_index(
         return success_reply::no;
     }
 
+    if (
+      reply.result == append_entries_reply::status::success
+      && reply.term == _term && idx.lease_probe
+      && seq >= idx.lease_probe->first) {
+        idx.lease_acked_at = std::max(
+          idx.lease_acked_at, idx.lease_probe->second);
+        idx.lease_probe.reset();
+    }
+
     // If recovery is in progress the recovery STM will handle follower index
     // updates
     if (!idx.is_recovering) {
@@ -330,6 +402,22 @@ consensus::success_reply consensus::update_follower_index(
     // learners to nodes and perform data movement to added replicas
 }
 
+void consensus::append_entries_failed(
+  follower_index_metadata& idx, follower_req_seq seq) {
+    if (seq < idx.last_received_seq) {
+        // a newer reply was already processed
+        return;
+    }
+    if (!idx.last_failed_seq || seq < *idx.last_failed_seq) {
+        vlog(
+          _ctxlog.trace,
+          "append entries request {} to {} failed, pausing pipelining",
+          seq,
+          idx.node_id);
+        idx.last_failed_seq = seq;
+    }
+}
+
 void consensus::maybe_promote_to_voter(vnode id) {
     (void)ss::with_gate(_bg, [this, id] {
         const auto& latest_cfg = _configuration_manager.get_latest();
@@ -339,8 +427,8 @@ void consensus::maybe_promote_to_voter(vnode id) {
             return ss::now();
         }
 
-        // is voter already
-        if (latest_cfg.is_voter(id)) {
+        // is voter already, or stays a learner
+        if (latest_cfg.is_voter(id) || latest_cfg.is_pinned_learner(id)) {
             return ss::now();
         }
         auto it = _fstats.find(id);
@@ -450,6 +538,12 @@ ss::future<result<model::offset>> consensus::linearizable_barrier() {
     if (_vstate != vote_state::leader) {
         co_return result<model::offset>(make_error_code(errc::not_leader));
     }
+    if (has_leader_lease() && get_term(_commit_index) == _term) {
+        // no other leader could have been elected, the commit index is up to
+        // date as soon as the leader committed an entry in its own term
+        _probe.linearizable_barrier_lease_hit();
+        co_return ret_t(_commit_index);
+    }
     // store current commit index
     auto cfg = config();
     auto dirty_offset = _log.offsets().dirty_offset;
@@ -683,20 +777,40 @@ ss::future<result<replicate_result>> consensus::do_append_replicate_relaxed(
       .finally([this, u = std::move(u)] { _probe.replicate_done(); });
 }
 
-void consensus::dispatch_flush_with_lock() {
-    if (!_has_pending_flushes) {
+void consensus::dispatch_background_flush() {
+    if (!_has_pending_flushes || _bg.is_closed()) {
         return;
     }
     (void)ss::with_gate(_bg, [this] {
-        return _op_lock.with([this] {
-            if (!_has_pending_flushes) {
-                return ss::make_ready_future<>();
+        return flush_log().then([this] {
+            // the flushed offset may complete the majority
+            if (is_leader()) {
+                maybe_update_leader_commit_idx();
             }
-            return flush_log();
         });
+    }).handle_exception([this](const std::exception_ptr& e) {
+        vlog(_ctxlog.warn, "Error flushing cached writes: {}", e);
     });
 }
 
+void consensus::maybe_flush_cached_writes(size_t appended_bytes) {
+    if (!write_caching()) {
+        return;
+    }
+    _unflushed_bytes += appended_bytes;
+    if (
+      _unflushed_bytes
+      >= config::shard_local_cfg().raft_write_caching_max_unflushed_bytes()) {
+        _write_caching_flush_timer.cancel();
+        dispatch_background_flush();
+        return;
+    }
+    if (!_write_caching_flush_timer.armed()) {
+        _write_caching_flush_timer.arm(
+          config::shard_local_cfg().raft_write_caching_flush_interval_ms());
+    }
+}
+
 ss::future<model::record_batch_reader>
 consensus::do_make_reader(storage::log_reader_config config) {
     // limit to last visible index
@@ -914,6 +1028,28 @@ ss::future<std::error_code> consensus::add_group_members(
     });
 }
 
+ss::future<std::error_code> consensus::add_learners(
+  std::vector<model::broker> nodes, model::revision_id new_revision) {
+    vlog(_ctxlog.trace, "Adding learners: {}", nodes);
+    return change_configuration([nodes = std::move(nodes), new_revision](
+                                  group_configuration current) mutable {
+        auto contains_already = std::any_of(
+          std::cbegin(nodes),
+          std::cend(nodes),
+          [&current](const model::broker& broker) {
+              return current.contains_broker(broker.id());
+          });
+
+        if (contains_already) {
+            return result<group_configuration>(errc::node_already_exists);
+        }
+        current.set_revision(new_revision);
+        current.add_learners(std::move(nodes), new_revision);
+
+        return result<group_configuration>(std::move(current));
+    });
+}
+
 ss::future<std::error_code> consensus::remove_members(
   std::vector<model::node_id> ids, model::revision_id new_revision) {
     vlog(_ctxlog.trace, "Removing members: {}", ids);
@@ -952,6 +1088,12 @@ ss::future<> consensus::start() {
     return ss::try_with_gate(_bg, [this] { return do_start(); });
 }
 
+ss::future<> consensus::set_initial_offset_delta(model::offset delta) {
+    vlog(_ctxlog.info, "Setting initial offset delta to {}", delta);
+    return _configuration_manager.adjust_configuration_idx(
+      configuration_manager::configuration_idx(delta()));
+}
+
 ss::future<> consensus::do_start() {
     vlog(_ctxlog.info, "Starting");
     return _op_lock.with([this] {
@@ -1829,6 +1971,31 @@ ss::future<> consensus::write_snapshot(write_snapshot_cfg cfg) {
     });
 }
 
+ss::future<std::optional<snapshot_data>> consensus::read_snapshot() {
+    auto units = co_await _op_lock.get_units();
+    auto reader = co_await _snapshot_mgr.open_snapshot();
+    if (!reader) {
+        co_return std::nullopt;
+    }
+    std::optional<snapshot_data> ret;
+    std::exception_ptr err;
+    try {
+        auto metadata = reflection::from_iobuf<snapshot_metadata>(
+          co_await reader->read_metadata());
+        auto size = co_await reader->get_snapshot_size();
+        ret = snapshot_data{
+          .last_included_index = metadata.last_included_index,
+          .data = co_await read_iobuf_exactly(reader->input(), size)};
+    } catch (...) {
+        err = std::current_exception();
+    }
+    co_await reader->close();
+    if (err) {
+        std::rethrow_exception(err);
+    }
+    co_return ret;
+}
+
 ss::future<>
 consensus::do_write_snapshot(model::offset last_included_index, iobuf&& data) {
     vlog(
@@ -1947,7 +2114,12 @@ append_entries_reply consensus::make_append_entries_reply(
 
 ss::future<> consensus::flush_log() {
     _probe.log_flushed();
-    return _log.flush().then([this] { _has_pending_flushes = false; });
+    // writes appended while flushing arm the timer again
+    _unflushed_bytes = 0;
+    _write_caching_flush_timer.cancel();
+    return _log.flush().then([this, m = _probe.auto_log_flush_measurement()] {
+        _has_pending_flushes = false;
+    });
 }
 
 ss::future<storage::append_result> consensus::disk_append(
@@ -1979,6 +2151,7 @@ ss::future<storage::append_result> consensus::disk_append(
           }
           _disk_append.broadcast();
           _has_pending_flushes = true;
+          maybe_flush_cached_writes(ret.byte_size);
           // TODO
           // if we rolled a log segment. write current configuration
           // for speedy recovery in the background
@@ -2034,6 +2207,10 @@ void consensus::update_node_hbeat_timestamp(vnode id) {
 
 follower_req_seq consensus::next_follower_sequence(vnode id) {
     if (auto it = _fstats.find(id); it != _fstats.end()) {
+        if (!it->second.lease_probe) {
+            it->second.lease_probe.emplace(
+              it->second.last_sent_seq, clock_type::now());
+        }
         return it->second.last_sent_seq++;
     }
 
@@ -2098,7 +2275,7 @@ ss::future<> consensus::maybe_commit_configuration(ss::semaphore_units<> u) {
     // as a leader replicate new simple configuration
     if (
       latest_cfg.type() == configuration_type::joint
-      && latest_cfg.current_config().learners.empty()) {
+      && !latest_cfg.has_learners_to_promote()) {
         latest_cfg.discard_old_config();
         vlog(
           _ctxlog.trace,
@@ -2511,7 +2688,12 @@ consensus::do_transfer_leadership(std::optional<model::node_id> target) {
         });
     });
 
-    return f.finally([this] { _transferring_leadership = false; });
+    return f.finally([this] {
+        _transferring_leadership = false;
+        // the transfer target may still be collecting votes, the followers
+        // grant them even though they recently heard from this leader
+        _leader_lease_revoked_until = clock_type::now() + _jit.base_duration();
+    });
 }
 
 ss::future<> consensus::remove_persistent_state() {
@@ -2548,8 +2730,16 @@ void consensus::maybe_update_majority_replicated_index() {
         return model::offset{};
     });
 
+    const bool advanced = majority_match > _majority_replicated_index;
     _majority_replicated_index = std::max(
       _majority_replicated_index, majority_match);
+    if (write_caching() && advanced) {
+        // quorum writes are acknowledged, and visible, once a majority
+        // appended them
+        _visibility_upper_bound_index = std::max(
+          _visibility_upper_bound_index, majority_match);
+        _commit_index_updated.broadcast();
+    }
     _consumable_offset_monitor.notify(last_visible_index());
 }
 
@@ -2586,6 +2776,43 @@ void consensus::update_heartbeat_status(vnode id, bool success) {
     }
 }
 
+bool consensus::is_heartbeat_quiescent(vnode id) const {
+    if (auto it = _fstats.find(id); it != _fstats.end()) {
+        return it->second.quiescent_meta == meta();
+    }
+    return false;
+}
+
+void consensus::update_heartbeat_quiescent_meta(
+  vnode id, std::optional<protocol_metadata> m) {
+    if (auto it = _fstats.find(id); it != _fstats.end()) {
+        it->second.quiescent_meta = m;
+    }
+}
+
+void consensus::update_quiescent_heartbeat_status(
+  vnode id, bool accepted, clock_type::time_point sent_at) {
+    if (auto it = _fstats.find(id); it != _fstats.end()) {
+        if (accepted) {
+            it->second.heartbeats_failed = 0;
+            it->second.last_hbeat_timestamp = clock_type::now();
+            // the follower refreshed its election timer
+            it->second.lease_acked_at = std::max(
+              it->second.lease_acked_at, sent_at);
+        } else {
+            it->second.quiescent_meta.reset();
+        }
+    }
+}
+
+bool consensus::refresh_leader_heartbeat(model::node_id leader) {
+    if (is_leader() || !_leader_id || _leader_id->id() != leader) {
+        return false;
+    }
+    _hbeat = clock_type::now();
+    return true;
+}
+
 bool consensus::should_reconnect_follower(vnode id) {
     if (_heartbeat_disconnect_failures == 0) {
         // Force disconnection is disabled
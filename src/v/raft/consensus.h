@@ -96,6 +96,13 @@ public:
     /// Initial call. Allow for internal state recovery
     ss::future<> start();
 
+    /// Logs hydrated from the cloud storage don't start with the initial
+    /// configuration of the group, the configurations they contain are
+    /// indexed after the \p delta configurations preceding the log so that
+    /// offsets are translated as on the other replicas. Must be called
+    /// before start()
+    ss::future<> set_initial_offset_delta(model::offset delta);
+
     /// Stop all communications.
     ss::future<> stop();
 
@@ -113,6 +120,10 @@ public:
     /// configuration update
     ss::future<std::error_code>
       add_group_members(std::vector<model::broker>, model::revision_id);
+    /// Adds long lived learners to the group. They are replicated to but do
+    /// not count towards the majority, and are never promoted to voters
+    ss::future<std::error_code>
+      add_learners(std::vector<model::broker>, model::revision_id);
     /// Updates given member configuration
     ss::future<std::error_code> update_group_member(model::broker);
     // Removes members from group
@@ -135,6 +146,13 @@ public:
      * details see paragraph 6.4 of Raft protocol dissertation.
      */
     ss::future<result<model::offset>> linearizable_barrier();
+    /**
+     * True when a majority of voters acknowledged requests sent by this
+     * leader recently enough that none of them grants its vote to another
+     * candidate before the lease expires. While holding the lease the leader
+     * can trust its state without a confirmation round trip.
+     */
+    bool has_leader_lease() const;
 
     vnode self() const { return _self; }
     protocol_metadata meta() const {
@@ -162,6 +180,14 @@ public:
      * consensus operations lock.
      */
     ss::future<> write_snapshot(write_snapshot_cfg);
+    /**
+     * \brief Reads the latest snapshot, if any
+     *
+     * Used by state machines to restore the state they persisted with
+     * write_snapshot when the entries they were about to apply were truncated
+     * by a snapshot, either taken locally or installed by the leader.
+     */
+    ss::future<std::optional<snapshot_data>> read_snapshot();
 
     /// Increment and returns next append_entries order tracking sequence for
     /// follower with given node id
@@ -312,6 +338,27 @@ public:
 
     void update_heartbeat_status(vnode, bool);
 
+    /**
+     * Lightweight heartbeats. A follower that acknowledged the current leader
+     * metadata and has the same log as the leader does not need to receive
+     * it again, the leader only keeps the follower election timer from
+     * firing. Any change of the leader metadata (appended entries, commit or
+     * visible index advancing, new term) makes the heartbeats carry the full
+     * metadata again.
+     */
+    bool is_heartbeat_quiescent(vnode) const;
+    void
+    update_heartbeat_quiescent_meta(vnode, std::optional<protocol_metadata>);
+    /// Processes the outcome of a lightweight heartbeat sent to the follower
+    /// at \p sent_at, the follower that did not accept it receives full
+    /// metadata next time
+    void update_quiescent_heartbeat_status(
+      vnode, bool accepted, clock_type::time_point sent_at);
+    /// Called on the follower when it receives a lightweight heartbeat,
+    /// refreshes the election timer if \p leader is the known group leader.
+    /// Returns false otherwise, the leader then sends full metadata.
+    bool refresh_leader_heartbeat(model::node_id leader);
+
     bool should_reconnect_follower(vnode);
 
     std::vector<follower_metrics> get_follower_metrics() const;
@@ -391,6 +438,10 @@ private:
     void successfull_append_entries_reply(
       follower_index_metadata&, append_entries_reply);
 
+    /// marks pipelined append entries request with given sequence as failed,
+    /// see follower_index_metadata::last_failed_seq
+    void append_entries_failed(follower_index_metadata&, follower_req_seq);
+
     bool needs_recovery(const follower_index_metadata&, model::offset);
     void dispatch_recovery(follower_index_metadata&);
     void maybe_update_leader_commit_idx();
@@ -423,15 +474,24 @@ private:
 
     /// \brief _does not_ hold the lock.
     ss::future<> flush_log();
-    /// \brief called by the vote timer, to dispatch a write under
-    /// the ops semaphore
-    void dispatch_flush_with_lock();
+    /// \brief called by the write caching flush timer, flushes the log in
+    /// the background. As the flush of follower appends, it does not hold the
+    /// ops semaphore while flushing
+    void dispatch_background_flush();
+    /// quorum writes of write caching logs are acknowledged before they are
+    /// flushed, the log is flushed in the background once
+    /// raft_write_caching_max_unflushed_bytes are appended or after
+    /// raft_write_caching_flush_interval_ms
+    bool write_caching() const { return _log.config().write_caching(); }
+    void maybe_flush_cached_writes(size_t appended_bytes);
 
     void maybe_step_down();
 
     absl::flat_hash_map<vnode, follower_req_seq> next_followers_request_seq();
 
     void setup_metrics();
+    /// sum of the offsets the recovering followers are missing
+    int64_t recovery_pending_offsets() const;
 
     bytes voted_for_key() const {
         return raft::details::serialize_group_key(
@@ -540,6 +600,8 @@ private:
     vnode _voted_for;
     std::optional<vnode> _leader_id;
     bool _transferring_leadership{false};
+    clock_type::time_point _leader_lease_revoked_until
+      = clock_type::time_point::min();
 
     /// useful for when we are not the leader
     clock_type::time_point _hbeat = clock_type::now();
@@ -554,6 +616,8 @@ private:
 
     replicate_batcher _batcher;
     bool _has_pending_flushes{false};
+    size_t _unflushed_bytes{0};
+    timer_type _write_caching_flush_timer;
 
     /// used to wait for background ops before shutting down
     ss::gate _bg;
@@ -571,6 +635,7 @@ private:
     std::chrono::milliseconds _recovery_append_timeout;
     size_t _heartbeat_disconnect_failures;
     ss::metrics::metric_groups _metrics;
+    partition_metrics::registry::member _aggregated_metrics;
     ss::abort_source _as;
     storage::api& _storage;
     std::optional<std::reference_wrapper<recovery_throttle>> _recovery_throttle;
@@ -30,10 +30,19 @@ public:
         virtual ss::future<result<vote_reply>>
         vote(model::node_id, vote_request&&, rpc::client_opts) = 0;
 
+        virtual ss::future<result<vote_batch_reply>>
+        vote_batch(model::node_id, vote_batch_request&&, rpc::client_opts)
+          = 0;
+
         virtual ss::future<result<append_entries_reply>> append_entries(
           model::node_id, append_entries_request&&, rpc::client_opts)
           = 0;
 
+        virtual ss::future<result<append_entries_batch_reply>>
+        append_entries_batch(
+          model::node_id, append_entries_batch_request&&, rpc::client_opts)
+          = 0;
+
         virtual ss::future<result<heartbeat_reply>>
         heartbeat(model::node_id, heartbeat_request&&, rpc::client_opts) = 0;
 
@@ -65,6 +74,13 @@ public:
         return _impl->vote(target_node, std::move(r), std::move(opts));
     }
 
+    ss::future<result<vote_batch_reply>> vote_batch(
+      model::node_id target_node,
+      vote_batch_request&& r,
+      rpc::client_opts opts) {
+        return _impl->vote_batch(target_node, std::move(r), std::move(opts));
+    }
+
     ss::future<result<append_entries_reply>> append_entries(
       model::node_id target_node,
       append_entries_request&& r,
@@ -73,6 +89,14 @@ public:
           target_node, std::move(r), std::move(opts));
     }
 
+    ss::future<result<append_entries_batch_reply>> append_entries_batch(
+      model::node_id target_node,
+      append_entries_batch_request&& r,
+      rpc::client_opts opts) {
+        return _impl->append_entries_batch(
+          target_node, std::move(r), std::move(opts));
+    }
+
     ss::future<result<heartbeat_reply>> heartbeat(
       model::node_id target_node,
       heartbeat_request&& r,
@@ -71,11 +71,13 @@ group_configuration::group_configuration(
   std::vector<model::broker> brokers,
   group_nodes current,
   model::revision_id revision,
-  std::optional<group_nodes> old)
+  std::optional<group_nodes> old,
+  std::vector<model::node_id> pinned_learners)
   : _brokers(std::move(brokers))
   , _current(std::move(current))
   , _old(std::move(old))
-  , _revision(revision) {}
+  , _revision(revision)
+  , _pinned_learners(std::move(pinned_learners)) {}
 
 std::optional<model::broker>
 group_configuration::find_broker(model::node_id id) const {
@@ -220,6 +222,7 @@ void group_configuration::remove(const std::vector<model::node_id>& ids) {
     for (auto& id : ids) {
         erase_id(new_cfg.learners, id);
         erase_id(new_cfg.voters, id);
+        std::erase(_pinned_learners, id);
     }
 
     _old = std::move(_current);
@@ -284,13 +287,49 @@ void group_configuration::replace(
             _brokers.push_back(std::move(b));
         }
     }
+    // learners which are not part of the new configuration are removed
+    std::erase_if(_pinned_learners, [this](model::node_id id) {
+        return !_current.find(id);
+    });
+}
+
+void group_configuration::add_learners(
+  std::vector<model::broker> brokers, model::revision_id rev) {
+    vassert(!_old, "can not add learners to joint configuration - {}", *this);
+    for (auto& b : brokers) {
+        if (unlikely(contains_broker(b.id()))) {
+            throw std::invalid_argument(fmt::format(
+              "broker {} already present in current configuration {}",
+              b.id(),
+              *this));
+        }
+    }
+    _revision = rev;
+    for (auto& b : brokers) {
+        _current.learners.emplace_back(b.id(), rev);
+        _pinned_learners.push_back(b.id());
+        _brokers.push_back(std::move(b));
+    }
+}
+
+bool group_configuration::is_pinned_learner(vnode id) const {
+    return std::find(
+             _pinned_learners.cbegin(), _pinned_learners.cend(), id.id())
+           != _pinned_learners.cend();
+}
+
+bool group_configuration::has_learners_to_promote() const {
+    return std::any_of(
+      _current.learners.cbegin(),
+      _current.learners.cend(),
+      [this](const vnode& id) { return !is_pinned_learner(id); });
 }
 
 void group_configuration::promote_to_voter(vnode id) {
     auto it = std::find(
       std::cbegin(_current.learners), std::cend(_current.learners), id);
     // do nothing
-    if (it == _current.learners.end()) {
+    if (it == _current.learners.end() || is_pinned_learner(id)) {
         return;
     }
     // add to voters
@@ -386,11 +425,13 @@ void group_configuration::maybe_set_initial_revision(
 std::ostream& operator<<(std::ostream& o, const group_configuration& c) {
     fmt::print(
       o,
-      "{{current: {}, old:{}, revision: {}, brokers: {}}}",
+      "{{current: {}, old:{}, revision: {}, brokers: {}, pinned_learners: "
+      "{}}}",
       c._current,
       c._old,
       c._revision,
-      c._brokers);
+      c._brokers,
+      c._pinned_learners);
     return o;
 }
 
@@ -410,7 +451,7 @@ bool operator==(const group_nodes& a, const group_nodes& b) {
 
 bool operator==(const group_configuration& a, const group_configuration& b) {
     return a._brokers == b._brokers && a._current == b._current
-           && a._old == b._old;
+           && a._old == b._old && a._pinned_learners == b._pinned_learners;
 }
 } // namespace raft
 
@@ -418,13 +459,26 @@ namespace reflection {
 
 void adl<raft::group_configuration>::to(
   iobuf& buf, raft::group_configuration cfg) {
+    // configurations without pinned learners keep the previous version, they
+    // can still be read by nodes which do not know about them
+    if (cfg.pinned_learners().empty()) {
+        serialize(
+          buf,
+          uint8_t(3),
+          cfg.brokers(),
+          cfg.current_config(),
+          cfg.old_config(),
+          cfg.revision_id());
+        return;
+    }
     serialize(
       buf,
       cfg.version(),
       cfg.brokers(),
       cfg.current_config(),
       cfg.old_config(),
-      cfg.revision_id());
+      cfg.revision_id(),
+      cfg.pinned_learners());
 }
 
 std::vector<raft::vnode> make_vnodes(const std::vector<model::node_id> ids) {
@@ -466,6 +520,7 @@ adl<raft::group_configuration>::from(iobuf_parser& p) {
      * version 1 - introduced revision id
      * version 2 - introduced raft::vnode
      * version 3 - model::broker with multiple endpoints
+     * version 4 - introduced pinned learners
      */
 
     std::vector<model::broker> brokers;
@@ -504,8 +559,16 @@ adl<raft::group_configuration>::from(iobuf_parser& p) {
     if (version > 0) {
         revision = adl<model::revision_id>{}.from(p);
     }
+    std::vector<model::node_id> pinned_learners;
+    if (version >= 4) {
+        pinned_learners = adl<std::vector<model::node_id>>{}.from(p);
+    }
     return raft::group_configuration(
-      std::move(brokers), std::move(current), revision, std::move(old));
+      std::move(brokers),
+      std::move(current),
+      revision,
+      std::move(old),
+      std::move(pinned_learners));
 }
 
 void adl<raft::vnode>::to(iobuf& buf, raft::vnode id) {
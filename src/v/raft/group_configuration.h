@@ -64,7 +64,7 @@ struct group_nodes {
 
 class group_configuration final {
 public:
-    static constexpr int8_t current_version = 3;
+    static constexpr int8_t current_version = 4;
     /**
      * creates a configuration where all provided brokers are current
      * configuration voters
@@ -79,7 +79,8 @@ public:
       std::vector<model::broker>,
       group_nodes,
       model::revision_id,
-      std::optional<group_nodes> = std::nullopt);
+      std::optional<group_nodes> = std::nullopt,
+      std::vector<model::node_id> pinned_learners = {});
 
     group_configuration(const group_configuration&) = default;
     group_configuration(group_configuration&&) = default;
@@ -108,6 +109,20 @@ public:
     void remove(const std::vector<model::node_id>&);
     void replace(std::vector<model::broker>, model::revision_id);
 
+    /**
+     * Adds long lived learners, e.g. replicas serving reads in a remote
+     * region. They receive the appends as any other member but are never
+     * promoted to voters. As the majority does not change the configuration
+     * stays simple.
+     */
+    void add_learners(std::vector<model::broker>, model::revision_id);
+
+    /// true for learners added with add_learners
+    bool is_pinned_learner(vnode) const;
+
+    /// true if some learners are still to be promoted to voters
+    bool has_learners_to_promote() const;
+
     /**
      * Updating broker configuration. This operation does not require entering
      * joint consensus as it never change majority
@@ -123,6 +138,9 @@ public:
     const group_nodes& current_config() const { return _current; }
     const std::optional<group_nodes>& old_config() const { return _old; }
     const std::vector<model::broker>& brokers() const { return _brokers; }
+    const std::vector<model::node_id>& pinned_learners() const {
+        return _pinned_learners;
+    }
 
     configuration_type type() const;
 
@@ -204,6 +222,7 @@ private:
     group_nodes _current;
     std::optional<group_nodes> _old;
     model::revision_id _revision;
+    std::vector<model::node_id> _pinned_learners;
 };
 
 namespace details {
@@ -16,6 +16,9 @@
 
 #include <seastar/core/scheduling.hh>
 
+#include <absl/container/flat_hash_set.h>
+
+#include <algorithm>
 #include <optional>
 
 namespace raft {
@@ -32,7 +35,9 @@ group_manager::group_manager(
   : _self(self)
   , _disk_timeout(disk_timeout)
   , _raft_sg(raft_sg)
-  , _client(make_rpc_client_protocol(self, clients))
+  , _append_entries_batcher(ss::make_shared<append_entries_batcher>(
+      make_rpc_client_protocol(self, clients)))
+  , _client(_append_entries_batcher)
   , _heartbeats(heartbeat_interval, _client, _self, heartbeat_timeout)
   , _storage(storage.local())
   , _recovery_throttle(recovery_throttle.local()) {
@@ -48,7 +53,8 @@ ss::future<> group_manager::stop() {
           return ss::parallel_for_each(
             _groups,
             [](ss::lw_shared_ptr<consensus> raft) { return raft->stop(); });
-      });
+      })
+      .then([this] { return _append_entries_batcher->stop(); });
 }
 
 ss::future<ss::lw_shared_ptr<raft::consensus>> group_manager::create_group(
@@ -58,8 +64,7 @@ ss::future<ss::lw_shared_ptr<raft::consensus>> group_manager::create_group(
       _self,
       id,
       raft::group_configuration(std::move(nodes), revision),
-      raft::timeout_jitter(
-        config::shard_local_cfg().raft_election_timeout_ms()),
+      make_election_jitter(),
       log,
       scheduling_config(_raft_sg, raft_priority()),
       _disk_timeout,
@@ -78,6 +83,23 @@ ss::future<ss::lw_shared_ptr<raft::consensus>> group_manager::create_group(
     });
 }
 
+raft::timeout_jitter group_manager::make_election_jitter() const {
+    /**
+     * Groups that lost their leader at the same time, e.g. after a node
+     * restart, start their elections within the jitter window. Widen the
+     * window with the number of groups on the shard, up to the election timeout
+     * itself, to spread these elections instead of starting all of them at
+     * nearly the same time.
+     */
+    const auto base = std::chrono::duration_cast<duration_type>(
+      config::shard_local_cfg().raft_election_timeout_ms());
+    const auto jitter = std::clamp<duration_type>(
+      election_stagger_per_group * static_cast<int64_t>(_groups.size() + 1),
+      base / 2,
+      base);
+    return raft::timeout_jitter(base, jitter);
+}
+
 ss::future<> group_manager::remove(ss::lw_shared_ptr<raft::consensus> c) {
     return c->stop()
       .then([c] { return c->remove_persistent_state(); })
@@ -89,6 +111,43 @@ ss::future<> group_manager::remove(ss::lw_shared_ptr<raft::consensus> c) {
       });
 }
 
+ss::future<>
+group_manager::remove(std::vector<ss::lw_shared_ptr<raft::consensus>> groups) {
+    return ss::do_with(
+      std::move(groups),
+      [this](std::vector<ss::lw_shared_ptr<raft::consensus>>& groups) {
+          return ss::parallel_for_each(
+                   groups,
+                   [](const ss::lw_shared_ptr<raft::consensus>& c) {
+                       return c->stop().then(
+                         [c] { return c->remove_persistent_state(); });
+                   })
+            .then([this, &groups] {
+                std::vector<raft::group_id> ids;
+                ids.reserve(groups.size());
+                for (const auto& c : groups) {
+                    ids.push_back(c->group());
+                }
+                return _heartbeats.deregister_groups(std::move(ids));
+            })
+            .finally([this, &groups] {
+                absl::flat_hash_set<raft::consensus*> removed;
+                removed.reserve(groups.size());
+                for (const auto& c : groups) {
+                    removed.insert(c.get());
+                }
+                _groups.erase(
+                  std::remove_if(
+                    _groups.begin(),
+                    _groups.end(),
+                    [&removed](const ss::lw_shared_ptr<raft::consensus>& c) {
+                        return removed.contains(c.get());
+                    }),
+                  _groups.end());
+            });
+      });
+}
+
 ss::future<> group_manager::shutdown(ss::lw_shared_ptr<raft::consensus> c) {
     return c->stop()
       .then(
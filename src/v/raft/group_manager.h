@@ -12,9 +12,11 @@
 #pragma once
 #include "cluster/types.h"
 #include "model/metadata.h"
+#include "raft/append_entries_batcher.h"
 #include "raft/consensus_client_protocol.h"
 #include "raft/heartbeat_manager.h"
 #include "raft/rpc_client_protocol.h"
+#include "raft/timeout_jitter.h"
 #include "raft/types.h"
 #include "storage/fwd.h"
 
@@ -55,6 +57,10 @@ public:
 
     ss::future<> remove(ss::lw_shared_ptr<raft::consensus>);
 
+    /// removes many groups at once, the heartbeat manager and the group list
+    /// are only updated once for all of them
+    ss::future<> remove(std::vector<ss::lw_shared_ptr<raft::consensus>>);
+
     cluster::notification_id_type
     register_leadership_notification(leader_cb_t cb) {
         auto id = _notification_id++;
@@ -83,10 +89,15 @@ public:
 private:
     void trigger_leadership_notification(raft::leadership_status);
     void setup_metrics();
+    raft::timeout_jitter make_election_jitter() const;
+
+    // election timeout jitter window added for every group of the shard
+    static constexpr std::chrono::milliseconds election_stagger_per_group{1};
 
     model::node_id _self;
     model::timeout_clock::duration _disk_timeout;
     ss::scheduling_group _raft_sg;
+    ss::shared_ptr<append_entries_batcher> _append_entries_batcher;
     raft::consensus_client_protocol _client;
     raft::heartbeat_manager _heartbeats;
     ss::gate _gate;
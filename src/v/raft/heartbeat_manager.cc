@@ -46,15 +46,38 @@ struct heartbeat_requests {
     absl::flat_hash_set<model::node_id> reconnect_nodes;
 };
 
+static heartbeat_request make_heartbeat_request(
+  std::vector<heartbeat_metadata> heartbeats,
+  const heartbeat_manager::quiescent_groups_t& quiescent,
+  model::node_id self,
+  model::node_id target) {
+    heartbeat_request req{
+      .heartbeats = std::move(heartbeats),
+      .node_id = self,
+      .target_node_id = target};
+    req.quiescent_groups.reserve(quiescent.size());
+    for (const auto& [group, _] : quiescent) {
+        req.quiescent_groups.push_back(group);
+    }
+    return req;
+}
+
 static heartbeat_requests requests_for_range(
-  const consensus_set& c, clock_type::duration heartbeat_interval) {
+  const consensus_set& c,
+  clock_type::duration heartbeat_interval,
+  model::node_id self,
+  const absl::flat_hash_set<model::node_id>& quiescent_supported) {
     absl::flat_hash_map<
       model::node_id,
       std::vector<std::pair<heartbeat_metadata, follower_req_seq>>>
       pending_beats;
+    absl::flat_hash_map<model::node_id, heartbeat_manager::quiescent_groups_t>
+      quiescent_beats;
     if (c.empty()) {
         return {};
     }
+    const bool lightweight
+      = config::shard_local_cfg().raft_enable_lightweight_heartbeats();
 
     // Set of follower nodes whose heartbeat_failed status indicates
     // that we should tear down their TCP connection before next heartbeat
@@ -68,7 +91,10 @@ static heartbeat_requests requests_for_range(
 
         auto maybe_create_follower_request = [ptr,
                                               last_heartbeat,
+                                              lightweight,
+                                              &quiescent_supported,
                                               &pending_beats,
+                                              &quiescent_beats,
                                               &reconnect_nodes](
                                                const vnode& rni) mutable {
             // special case self beat
@@ -98,6 +124,18 @@ static heartbeat_requests requests_for_range(
                 return;
             }
 
+            if (
+              lightweight && quiescent_supported.contains(rni.id())
+              && ptr->is_heartbeat_quiescent(rni)) {
+                // nothing changed since the follower acknowledged the last
+                // heartbeat, only keep its election timer from firing
+                quiescent_beats[rni.id()].emplace(ptr->group(), rni);
+                if (ptr->should_reconnect_follower(rni)) {
+                    reconnect_nodes.insert(rni.id());
+                }
+                return;
+            }
+
             auto seq_id = ptr->next_follower_sequence(rni);
             ptr->update_suppress_heartbeats(
               rni, seq_id, heartbeats_suppressed::yes);
@@ -128,11 +166,31 @@ static heartbeat_requests requests_for_range(
             meta_map.emplace(
               hb.meta.group,
               heartbeat_manager::follower_request_meta{
-                seq, hb.meta.prev_log_index, hb.target_node_id});
+                seq, hb.meta.prev_log_index, hb.target_node_id, hb.meta});
             requests.push_back(std::move(hb));
         }
+        heartbeat_manager::quiescent_groups_t quiescent;
+        if (auto it = quiescent_beats.find(p.first);
+            it != quiescent_beats.end()) {
+            quiescent = std::move(it->second);
+            quiescent_beats.erase(it);
+        }
         reqs.emplace_back(
-          p.first, heartbeat_request{std::move(requests)}, std::move(meta_map));
+          p.first,
+          make_heartbeat_request(
+            std::move(requests), quiescent, self, p.first),
+          std::move(meta_map),
+          std::move(quiescent));
+    }
+    // nodes following quiescent groups only
+    for (auto& [node, quiescent] : quiescent_beats) {
+        reqs.emplace_back(
+          node,
+          make_heartbeat_request({}, quiescent, self, node),
+          absl::flat_hash_map<
+            raft::group_id,
+            heartbeat_manager::follower_request_meta>{},
+          std::move(quiescent));
     }
 
     return heartbeat_requests{
@@ -171,7 +229,11 @@ heartbeat_manager::send_heartbeats(std::vector<node_heartbeat> reqs) {
 }
 
 ss::future<> heartbeat_manager::do_dispatch_heartbeats() {
-    auto reqs = requests_for_range(_consensus_groups, _heartbeat_interval);
+    auto reqs = requests_for_range(
+      _consensus_groups,
+      _heartbeat_interval,
+      _self,
+      _quiescent_groups_supported);
 
     for (const auto& node_id : reqs.reconnect_nodes) {
         if (co_await _client_protocol.ensure_disconnect(node_id)) {
@@ -197,7 +259,12 @@ ss::future<> heartbeat_manager::do_self_heartbeat(node_heartbeat&& r) {
             .group = hb.meta.group,
             .result = append_entries_reply::status::success};
       });
-    process_reply(r.target, std::move(r.meta_map), std::move(reply));
+    process_reply(
+      r.target,
+      std::move(r.meta_map),
+      std::move(r.quiescent),
+      r.created_at,
+      std::move(reply));
     return ss::now();
 }
 
@@ -213,11 +280,18 @@ ss::future<> heartbeat_manager::do_heartbeat(node_heartbeat&& r) {
                    512))
                .then([node = r.target,
                       groups = std::move(r.meta_map),
+                      quiescent = std::move(r.quiescent),
+                      sent_at = r.created_at,
                       gate = std::move(gate),
                       this](result<heartbeat_reply> ret) mutable {
                    // this will happen after RPC client will return and resume
                    // sending heartbeats to follower
-                   process_reply(node, std::move(groups), std::move(ret));
+                   process_reply(
+                     node,
+                     std::move(groups),
+                     std::move(quiescent),
+                     sent_at,
+                     std::move(ret));
                });
     // fail fast to make sure that not lagging nodes will be able to receive
     // hearteats
@@ -229,10 +303,58 @@ ss::future<> heartbeat_manager::do_heartbeat(node_heartbeat&& r) {
       .handle_exception_type([](const ss::gate_closed_exception&) {});
 }
 
+void heartbeat_manager::process_quiescent_reply(
+  model::node_id n,
+  quiescent_groups_t quiescent,
+  clock_type::time_point sent_at,
+  const result<heartbeat_reply>& r) {
+    if (r) {
+        // a node running an older version ignores quiescent groups
+        if (!r.value().supports_quiescent_groups) {
+            _quiescent_groups_supported.erase(n);
+        } else {
+            _quiescent_groups_supported.insert(n);
+        }
+    }
+    if (quiescent.empty()) {
+        return;
+    }
+    const bool accepted_all = r && r.value().supports_quiescent_groups;
+    if (accepted_all) {
+        for (auto g : r.value().rejected_quiescent_groups) {
+            auto it = quiescent.find(g);
+            if (it == quiescent.end()) {
+                continue;
+            }
+            if (auto c = _consensus_groups.find(g);
+                c != _consensus_groups.end()) {
+                (*c)->update_quiescent_heartbeat_status(
+                  it->second, false, sent_at);
+            }
+            quiescent.erase(it);
+        }
+    }
+    for (auto& [g, follower] : quiescent) {
+        auto it = _consensus_groups.find(g);
+        if (it == _consensus_groups.end()) {
+            continue;
+        }
+        if (!r) {
+            (*it)->update_heartbeat_status(follower, false);
+            (*it)->get_probe().heartbeat_request_error();
+        }
+        (*it)->update_quiescent_heartbeat_status(
+          follower, accepted_all, sent_at);
+    }
+}
+
 void heartbeat_manager::process_reply(
   model::node_id n,
   absl::flat_hash_map<raft::group_id, follower_request_meta> groups,
+  quiescent_groups_t quiescent,
+  clock_type::time_point sent_at,
   result<heartbeat_reply> r) {
+    process_quiescent_reply(n, std::move(quiescent), sent_at, r);
     if (!r) {
         vlog(
           hbeatlog.trace,
@@ -272,6 +394,17 @@ void heartbeat_manager::process_reply(
         (*it)->update_heartbeat_status(meta.follower_vnode, true);
         (*it)->update_suppress_heartbeats(
           meta.follower_vnode, meta.seq, heartbeats_suppressed::no);
+        // follower acknowledged the metadata and flushed the whole leader
+        // log, there is nothing left to learn from its replies hence the
+        // following heartbeats can be lightweight until the metadata changes
+        const bool in_sync = m.result == append_entries_reply::status::success
+                             && m.last_dirty_log_index
+                                  == meta.meta.prev_log_index
+                             && m.last_committed_log_index
+                                  == meta.meta.prev_log_index;
+        (*it)->update_heartbeat_quiescent_meta(
+          meta.follower_vnode,
+          in_sync ? std::make_optional(meta.meta) : std::nullopt);
         (*it)->process_append_entries_reply(
           n,
           result<append_entries_reply>(std::move(m)),
@@ -304,6 +437,17 @@ ss::future<> heartbeat_manager::deregister_group(group_id g) {
     });
 }
 
+ss::future<>
+heartbeat_manager::deregister_groups(std::vector<group_id> groups) {
+    return _lock.with([this, groups = std::move(groups)] {
+        for (auto g : groups) {
+            auto it = _consensus_groups.find(g);
+            vassert(it != _consensus_groups.end(), "group not found: {}", g);
+            _consensus_groups.erase(it);
+        }
+    });
+}
+
 ss::future<>
 heartbeat_manager::register_group(ss::lw_shared_ptr<consensus> ptr) {
     return _lock.with([this, ptr = std::move(ptr)] {
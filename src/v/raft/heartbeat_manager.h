@@ -25,6 +25,7 @@
 #include <seastar/util/log.hh>
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 #include <boost/container/flat_set.hpp>
 
 namespace raft::details {
@@ -82,6 +83,14 @@ extern ss::logger hbeatlog;
  *
  *    heartbeat({L0, L1}) -> {F0, F1}(node-b)
  *    heartbeat({L0, L1}) -> {F0, F1}(node-c)
+ *
+ * Most of the groups are usually idle, their leader metadata does not change
+ * between heartbeats. Once a follower acknowledged the current metadata of
+ * such a quiescent group only the group id is sent, the follower refreshes its
+ * election timer if the sender is the leader it knows about and reports the
+ * group back otherwise so that the next heartbeat carries full metadata. This
+ * is only done for the nodes that replied with a heartbeat reply understanding
+ * quiescent groups.
  */
 class heartbeat_manager {
 public:
@@ -93,22 +102,31 @@ public:
         follower_req_seq seq;
         model::offset dirty_offset;
         vnode follower_vnode;
+        // leader metadata sent with the heartbeat
+        protocol_metadata meta;
     };
+    using quiescent_groups_t = absl::flat_hash_map<raft::group_id, vnode>;
     // Heartbeats from all groups for single node
     struct node_heartbeat {
         node_heartbeat(
           model::node_id t,
           heartbeat_request req,
-          absl::flat_hash_map<raft::group_id, follower_request_meta> seqs)
+          absl::flat_hash_map<raft::group_id, follower_request_meta> seqs,
+          quiescent_groups_t quiescent)
           : target(t)
           , request(std::move(req))
-          , meta_map(std::move(seqs)) {}
+          , meta_map(std::move(seqs))
+          , quiescent(std::move(quiescent)) {}
 
         model::node_id target;
         heartbeat_request request;
         // each raft group has its own follower metadata hence we need map to
         // track a sequence per group
         absl::flat_hash_map<raft::group_id, follower_request_meta> meta_map;
+        // followers of the groups sent as quiescent
+        quiescent_groups_t quiescent;
+        // lower bound of the time at which the request is sent
+        clock_type::time_point created_at = clock_type::now();
     };
 
     heartbeat_manager(
@@ -119,6 +137,7 @@ public:
 
     ss::future<> register_group(ss::lw_shared_ptr<consensus>);
     ss::future<> deregister_group(raft::group_id);
+    ss::future<> deregister_groups(std::vector<raft::group_id>);
 
     ss::future<> start();
     ss::future<> stop();
@@ -145,8 +164,16 @@ private:
     void process_reply(
       model::node_id n,
       absl::flat_hash_map<raft::group_id, follower_request_meta> groups,
+      quiescent_groups_t quiescent,
+      clock_type::time_point sent_at,
       result<heartbeat_reply> result);
 
+    void process_quiescent_reply(
+      model::node_id n,
+      quiescent_groups_t quiescent,
+      clock_type::time_point sent_at,
+      const result<heartbeat_reply>& result);
+
     // private members
 
     mutex _lock;
@@ -161,5 +188,8 @@ private:
     consensus_set _consensus_groups;
     consensus_client_protocol _client_protocol;
     model::node_id _self;
+    /// nodes that replied with heartbeat replies understanding quiescent
+    /// groups
+    absl::flat_hash_set<model::node_id> _quiescent_groups_supported;
 };
 } // namespace raft
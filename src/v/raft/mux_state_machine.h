@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include "bytes/iobuf.h"
+#include "bytes/iobuf_parser.h"
 #include "model/fundamental.h"
 #include "model/record.h"
 #include "model/record_batch_reader.h"
@@ -19,6 +21,7 @@
 #include "raft/consensus.h"
 #include "raft/errc.h"
 #include "raft/state_machine.h"
+#include "reflection/adl.h"
 #include "utils/expiring_promise.h"
 #include "utils/mutex.h"
 #include "vassert.h"
@@ -31,9 +34,12 @@
 
 #include <absl/container/node_hash_map.h>
 
+#include <algorithm>
 #include <optional>
 #include <system_error>
+#include <type_traits>
 #include <variant>
+#include <vector>
 
 namespace raft {
 
@@ -52,6 +58,21 @@ CONCEPT(
 using persistent_last_applied
   = ss::bool_class<struct persistent_last_applied_tag>;
 
+namespace details {
+// states whose content can be captured in and restored from a snapshot
+template<typename T, typename = void>
+struct is_snapshotable : std::false_type {};
+
+template<typename T>
+struct is_snapshotable<
+  T,
+  std::void_t<
+    decltype(std::declval<T&>().take_snapshot(std::declval<model::offset>())),
+    decltype(std::declval<T&>().apply_snapshot(
+      std::declval<model::offset>(), std::declval<iobuf>()))>>
+  : std::true_type {};
+} // namespace details
+
 // The multiplexing STM allows building multiple state machines on top of
 // single consensus instance. The mux_stm dispatches state
 // applications to correct state implementations using
@@ -93,6 +114,17 @@ using persistent_last_applied
 //      |         std::error_code |               |          |
 //      |<------------------------|               |          |
 //      |                         |               |          |
+//
+// Snapshots
+//
+// When all the states provide the `take_snapshot` and `apply_snapshot`
+// methods and snapshots are enabled, the mux_stm snapshots the content of all
+// the states every given number of applied batches and prefix truncates the
+// log. When the next entry to apply was truncated, either by a snapshot taken
+// locally before restart or by one installed by the leader, the states are
+// restored from the latest snapshot and the entries following it are applied
+// as usual. The states are snapshotted and restored one after the other in
+// the order they are passed to the mux_stm.
 template<typename... T>
 CONCEPT(requires(State<T>, ...))
 class mux_state_machine : public state_machine {
@@ -124,7 +156,27 @@ public:
       model::timeout_clock::time_point timeout,
       ss::abort_source& as);
 
+    /// Replicates record batches in a single append and waits until all of
+    /// them are applied to the state machine, returns the result of applying
+    /// every batch in order
+    ss::future<std::vector<std::error_code>> replicate_and_wait(
+      model::record_batch_reader::data_t batches,
+      model::timeout_clock::time_point timeout,
+      ss::abort_source& as);
+
+    static constexpr bool snapshots_supported
+      = (details::is_snapshotable<T>::value && ...);
+
+    /// Takes a snapshot of the states every `interval` applied batches
+    void enable_snapshots(size_t interval) {
+        static_assert(
+          snapshots_supported, "all the states must support snapshots");
+        _snapshot_interval = interval;
+    }
+
 private:
+    static constexpr int8_t snapshot_version = 0;
+
     using promise_t = expiring_promise<std::error_code>;
     // promises used to wait for result of state applies, keyed by offser
     // returned in replication result (i.e. last batch end offset)
@@ -132,6 +184,15 @@ private:
       = absl::node_hash_map<model::offset, expiring_promise<std::error_code>>;
 
     ss::future<> apply(model::record_batch b) final;
+    ss::future<> handle_eviction() final;
+
+    ss::future<std::vector<std::error_code>> do_replicate_and_wait(
+      model::record_batch_reader::data_t,
+      model::timeout_clock::time_point,
+      ss::abort_source&);
+
+    ss::future<> maybe_take_snapshot(model::offset);
+    ss::future<> take_snapshot(model::offset);
 
     container_t _promises;
 
@@ -172,8 +233,12 @@ private:
      *
      */
     mutex _mutex;
+    ss::logger& _log;
     consensus* _c;
     const persistent_last_applied _persist_last_applied;
+    // number of applied batches between snapshots, disabled if 0
+    size_t _snapshot_interval{0};
+    size_t _applied_since_snapshot{0};
     // we keep states in a tuple to automatically dispatch updates to correct
     // state
     std::tuple<T&...> _state;
@@ -187,6 +252,7 @@ mux_state_machine<T...>::mux_state_machine(
   persistent_last_applied persist,
   T&... state)
   : raft::state_machine(c, logger, ss::default_priority_class())
+  , _log(logger)
   , _c(c)
   , _persist_last_applied(persist)
   , _state(state...) {}
@@ -235,6 +301,64 @@ ss::future<std::error_code> mux_state_machine<T...>::replicate_and_wait(
       });
 }
 
+template<typename... T>
+CONCEPT(requires(State<T>, ...))
+ss::future<std::vector<std::error_code>>
+mux_state_machine<T...>::replicate_and_wait(
+  model::record_batch_reader::data_t batches,
+  model::timeout_clock::time_point timeout,
+  ss::abort_source& as) {
+    return ss::with_gate(
+      _gate, [this, batches = std::move(batches), timeout, &as]() mutable {
+          return do_replicate_and_wait(std::move(batches), timeout, as);
+      });
+}
+
+template<typename... T>
+CONCEPT(requires(State<T>, ...))
+ss::future<std::vector<std::error_code>>
+mux_state_machine<T...>::do_replicate_and_wait(
+  model::record_batch_reader::data_t batches,
+  model::timeout_clock::time_point timeout,
+  ss::abort_source& as) {
+    using ret_t = std::error_code;
+    // the batches are appended back to back, the promise of every batch is
+    // keyed by its last offset: the last offset of the append minus the
+    // records of the batches following it
+    std::vector<int64_t> records_after;
+    records_after.reserve(batches.size());
+    int64_t records = 0;
+    for (auto it = batches.rbegin(); it != batches.rend(); ++it) {
+        records_after.push_back(records);
+        records += it->record_count();
+    }
+    std::reverse(records_after.begin(), records_after.end());
+
+    std::vector<ss::future<ret_t>> results;
+    results.reserve(records_after.size());
+    {
+        auto u = co_await _mutex.get_units();
+        auto r = co_await _c->replicate(
+          model::make_memory_record_batch_reader(std::move(batches)),
+          raft::replicate_options{raft::consistency_level::quorum_ack});
+        if (!r) {
+            co_return std::vector<ret_t>(records_after.size(), r.error());
+        }
+        for (auto after : records_after) {
+            auto last_offset = r.value().last_offset - model::offset(after);
+            auto [it, insterted] = _promises.emplace(
+              last_offset, expiring_promise<ret_t>{});
+            vassert(
+              insterted,
+              "Prosmise for offset {} already registered",
+              last_offset);
+            results.push_back(it->second.get_future_with_timeout(
+              timeout, [] { return errc::timeout; }, as));
+        }
+    }
+    co_return co_await ss::when_all_succeed(results.begin(), results.end());
+}
+
 // return value only if state accepts given batch type
 template<typename State>
 static std::optional<State*>
@@ -278,23 +402,143 @@ ss::future<> mux_state_machine<T...>::apply(model::record_batch b) {
           },
           *state);
 
-        return result_f.then([this, last_offset](std::error_code ec) {
-            return _mutex.with([this, last_offset, ec] {
-                if (auto it = _promises.find(last_offset);
-                    it != _promises.end()) {
-                    it->second.set_value(ec);
-                    _promises.erase(it);
-                }
-                if (
-                  _persist_last_applied
-                  && last_offset > _c->read_last_applied()) {
-                    (void)ss::with_gate(_gate, [this, last_offset] {
-                        return _c->write_last_applied(last_offset);
-                    });
-                }
-            });
-        });
+        return result_f
+          .then([this, last_offset](std::error_code ec) {
+              return _mutex.with([this, last_offset, ec] {
+                  if (auto it = _promises.find(last_offset);
+                      it != _promises.end()) {
+                      it->second.set_value(ec);
+                      _promises.erase(it);
+                  }
+                  if (
+                    _persist_last_applied
+                    && last_offset > _c->read_last_applied()) {
+                      (void)ss::with_gate(_gate, [this, last_offset] {
+                          return _c->write_last_applied(last_offset);
+                      });
+                  }
+              });
+          })
+          .then([this, last_offset] {
+              return maybe_take_snapshot(last_offset);
+          });
     });
 }
 
+template<typename... T>
+CONCEPT(requires(State<T>, ...))
+ss::future<> mux_state_machine<T...>::maybe_take_snapshot(
+  model::offset last_applied) {
+    if constexpr (snapshots_supported) {
+        if (
+          _snapshot_interval == 0
+          || ++_applied_since_snapshot < _snapshot_interval) {
+            co_return;
+        }
+        _applied_since_snapshot = 0;
+        try {
+            co_await take_snapshot(last_applied);
+        } catch (...) {
+            // the batch is already applied, failing here would apply it again,
+            // the snapshot is retried after the next interval
+            vlog(
+              _log.warn,
+              "unable to take snapshot of {} at offset {} - {}",
+              _c->ntp(),
+              last_applied,
+              std::current_exception());
+        }
+    } else {
+        co_return;
+    }
+}
+
+template<typename... T>
+CONCEPT(requires(State<T>, ...))
+ss::future<> mux_state_machine<T...>::take_snapshot(model::offset offset) {
+    std::vector<iobuf> parts;
+    parts.reserve(sizeof...(T));
+    auto f = ss::now();
+    std::apply(
+      [&f, &parts, offset](T&... st) {
+          ((f = std::move(f).then([&st, &parts, offset] {
+                return st.take_snapshot(offset).then(
+                  [&parts](iobuf part) { parts.push_back(std::move(part)); });
+            })),
+           ...);
+      },
+      _state);
+    co_await std::move(f);
+
+    iobuf data;
+    reflection::serialize(data, snapshot_version, std::move(parts));
+    vlog(
+      _log.info,
+      "writing snapshot of {} at offset {}, {} bytes",
+      _c->ntp(),
+      offset,
+      data.size_bytes());
+    co_await _c->write_snapshot(write_snapshot_cfg(offset, std::move(data)));
+}
+
+template<typename... T>
+CONCEPT(requires(State<T>, ...))
+ss::future<> mux_state_machine<T...>::handle_eviction() {
+    auto start_offset = _c->start_offset();
+    std::optional<snapshot_data> snapshot;
+    if constexpr (snapshots_supported) {
+        snapshot = co_await _c->read_snapshot();
+    }
+    if (!snapshot || snapshot->data.empty()) {
+        // the log was truncated without a snapshot of the states, there is
+        // no way to restore them
+        vlog(
+          _log.error,
+          "{} entries before {} were evicted without a snapshot of the state, "
+          "skipping them",
+          _c->ntp(),
+          start_offset);
+        set_next(start_offset);
+        co_return;
+    }
+
+    auto offset = snapshot->last_included_index;
+    iobuf_parser parser(std::move(snapshot->data));
+    auto version = reflection::adl<int8_t>{}.from(parser);
+    vassert(
+      version <= snapshot_version,
+      "unsupported snapshot version {} of {}",
+      version,
+      _c->ntp());
+    auto parts = reflection::adl<std::vector<iobuf>>{}.from(parser);
+    vassert(
+      parts.size() == sizeof...(T),
+      "snapshot of {} holds {} states, expected {}",
+      _c->ntp(),
+      parts.size(),
+      sizeof...(T));
+
+    vlog(
+      _log.info,
+      "restoring state of {} from snapshot at offset {}",
+      _c->ntp(),
+      offset);
+    if constexpr (snapshots_supported) {
+        auto f = ss::now();
+        size_t i = 0;
+        std::apply(
+          [&f, &parts, &i, offset](T&... st) {
+              ((f = std::move(f).then([&st, &part = parts[i++], offset] {
+                    return st.apply_snapshot(offset, std::move(part));
+                })),
+               ...);
+          },
+          _state);
+        co_await std::move(f);
+    }
+    _applied_since_snapshot = 0;
+    set_next(offset + model::offset(1));
+    notify_applied(offset);
+}
+
 } // namespace raft
@@ -11,6 +11,7 @@
 
 #include "config/configuration.h"
 #include "model/fundamental.h"
+#include "prometheus/partition_metrics.h"
 #include "prometheus/prometheus_sanitize.h"
 
 #include <seastar/core/metrics.hh>
@@ -32,78 +33,105 @@ probe::create_metric_labels(const model::ntp& ntp) {
 
 void probe::setup_metrics(const model::ntp& ntp) {
     namespace sm = ss::metrics;
-    auto labels = create_metric_labels(ntp);
+    using partition_metrics::metric_kind;
+    partition_metrics::setup(
+      "raft",
+      ntp,
+      {
+        {"received_vote_requests",
+         "Number of vote requests received",
+         metric_kind::counter,
+         [this] { return _vote_requests; }},
+        {"received_append_requests",
+         "Number of append requests received",
+         metric_kind::counter,
+         [this] { return _append_requests; }},
+        {"sent_vote_requests",
+         "Number of vote requests sent",
+         metric_kind::counter,
+         [this] { return _vote_requests_sent; }},
+        {"replicate_ack_all_requests",
+         "Number of replicate requests with quorum ack consistency",
+         metric_kind::counter,
+         [this] { return _replicate_requests_ack_all; }},
+        {"replicate_ack_leader_requests",
+         "Number of replicate requests with leader ack consistency",
+         metric_kind::counter,
+         [this] { return _replicate_requests_ack_leader; }},
+        {"replicate_ack_none_requests",
+         "Number of replicate requests with no ack consistency",
+         metric_kind::counter,
+         [this] { return _replicate_requests_ack_none; }},
+        {"done_replicate_requests",
+         "Number of finished replicate requests",
+         metric_kind::counter,
+         [this] { return _replicate_requests_done; }},
+        {"log_flushes",
+         "Number of log flushes",
+         metric_kind::counter,
+         [this] { return _log_flushes; }},
+        {"log_truncations",
+         "Number of log truncations",
+         metric_kind::counter,
+         [this] { return _log_truncations; }},
+        {"leadership_changes",
+         "Number of leadership changes",
+         metric_kind::counter,
+         [this] { return _leadership_changes; }},
+        {"replicate_request_errors",
+         "Number of failed replicate requests",
+         metric_kind::counter,
+         [this] { return _replicate_request_error; }},
+        {"heartbeat_requests_errors",
+         "Number of failed heartbeat requests",
+         metric_kind::counter,
+         [this] { return _heartbeat_request_error; }},
+        {"linearizable_barrier_lease_hits",
+         "Number of linearizable barriers served with the leader lease",
+         metric_kind::counter,
+         [this] { return _linearizable_barrier_lease_hits; }},
+        {"recovery_bytes_sent",
+         "Number of bytes sent to recovering followers",
+         metric_kind::counter,
+         [this] { return _recovery_bytes_sent; }},
+        {"recovery_requests_errors",
+         "Number of failed recovery requests",
+         metric_kind::counter,
+         [this] { return _recovery_request_error; }},
+      },
+      _metrics,
+      _aggregated_metrics);
 
+    if (!partition_metrics::per_partition(ntp)) {
+        return;
+    }
+    auto labels = create_metric_labels(ntp);
     _metrics.add_group(
       prometheus_sanitize::metrics_name("raft"),
-      {sm::make_derive(
-         "received_vote_requests",
-         [this] { return _vote_requests; },
-         sm::description("Number of vote requests received"),
-         labels),
-       sm::make_derive(
-         "received_append_requests",
-         [this] { return _append_requests; },
-         sm::description("Number of append requests received"),
-         labels),
-       sm::make_derive(
-         "sent_vote_requests",
-         [this] { return _vote_requests_sent; },
-         sm::description("Number of vote requests sent"),
-         labels),
-       sm::make_derive(
-         "replicate_ack_all_requests",
-         [this] { return _replicate_requests_ack_all; },
-         sm::description(
-           "Number of replicate requests with quorum ack consistency"),
-         labels),
-       sm::make_derive(
-         "replicate_ack_leader_requests",
-         [this] { return _replicate_requests_ack_leader; },
-         sm::description(
-           "Number of replicate requests with leader ack consistency"),
-         labels),
-       sm::make_derive(
-         "replicate_ack_none_requests",
-         [this] { return _replicate_requests_ack_none; },
-         sm::description(
-           "Number of replicate requests with no ack consistency"),
+      {sm::make_histogram(
+         "replicate_batch_size",
+         [this] { return _replicate_batch_size.seastar_histogram_logform(); },
+         sm::description("Size in bytes of batches flushed by the replicate "
+                         "batcher"),
          labels),
-       sm::make_derive(
-         "done_replicate_requests",
-         [this] { return _replicate_requests_done; },
-         sm::description("Number of finished replicate requests"),
-         labels),
-       sm::make_derive(
-         "log_flushes",
-         [this] { return _log_flushes; },
-         sm::description("Number of log flushes"),
-         labels),
-       sm::make_derive(
-         "log_truncations",
-         [this] { return _log_truncations; },
-         sm::description("Number of log truncations"),
-         labels),
-       sm::make_derive(
-         "leadership_changes",
-         [this] { return _leadership_changes; },
-         sm::description("Number of leadership changes"),
-         labels),
-       sm::make_derive(
-         "replicate_request_errors",
-         [this] { return _replicate_request_error; },
-         sm::description("Number of failed replicate requests"),
-         labels),
-       sm::make_derive(
-         "heartbeat_requests_errors",
-         [this] { return _heartbeat_request_error; },
-         sm::description("Number of failed heartbeat requests"),
-         labels),
-       sm::make_derive(
-         "recovery_requests_errors",
-         [this] { return _recovery_request_error; },
-         sm::description("Number of failed recovery requests"),
+       sm::make_histogram(
+         "replicate_batch_linger",
+         [this] {
+             return _replicate_batch_linger.seastar_histogram_logform();
+         },
+         sm::description("Time in microseconds the replicate batcher waited "
+                         "for more requests before flushing"),
          labels)});
+
+    if (config::shard_local_cfg().partition_latency_breakdown()) {
+        _metrics.add_group(
+          prometheus_sanitize::metrics_name("raft"),
+          {sm::make_histogram(
+            "log_flush_latency_us",
+            [this] { return _log_flush_latency.seastar_histogram_logform(); },
+            sm::description("Time in microseconds taken by log flushes"),
+            labels)});
+    }
 }
 
 } // namespace raft
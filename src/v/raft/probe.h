@@ -11,10 +11,14 @@
 
 #pragma once
 #include "model/fundamental.h"
+#include "prometheus/partition_metrics.h"
+#include "utils/hdr_hist.h"
+#include "utils/log_hist.h"
 
 #include <seastar/core/metrics.hh>
 #include <seastar/core/metrics_registration.hh>
 
+#include <chrono>
 #include <cstdint>
 namespace raft {
 class probe {
@@ -31,9 +35,20 @@ public:
 
     void log_truncated() { ++_log_truncations; }
     void log_flushed() { ++_log_flushes; }
+    log_hist<std::chrono::microseconds>::measurement
+    auto_log_flush_measurement() {
+        return _log_flush_latency.auto_measure();
+    }
 
-    void replicate_batch_flushed() { ++_replicate_batch_flushed; }
+    void replicate_batch_flushed(size_t bytes) {
+        ++_replicate_batch_flushed;
+        _replicate_batch_size.record(bytes);
+    }
+    void replicate_batch_lingered(std::chrono::microseconds d) {
+        _replicate_batch_linger.record(d.count());
+    }
     void recovery_append_request() { ++_recovery_requests; }
+    void recovery_bytes_sent(size_t bytes) { _recovery_bytes_sent += bytes; }
     void configuration_update() { ++_configuration_updates; }
 
     void leadership_changed() { ++_leadership_changes; }
@@ -46,6 +61,9 @@ public:
     void heartbeat_request_error() { ++_heartbeat_request_error; };
     void replicate_request_error() { ++_replicate_request_error; };
     void recovery_request_error() { ++_recovery_request_error; };
+    void linearizable_barrier_lease_hit() {
+        ++_linearizable_barrier_lease_hits;
+    }
 
 private:
     uint64_t _vote_requests = 0;
@@ -60,11 +78,17 @@ private:
     uint32_t _log_truncations = 0;
     uint32_t _configuration_updates = 0;
     uint64_t _recovery_requests = 0;
+    uint64_t _recovery_bytes_sent = 0;
     uint64_t _leadership_changes = 0;
     uint64_t _heartbeat_request_error = 0;
     uint64_t _replicate_request_error = 0;
     uint64_t _recovery_request_error = 0;
+    uint64_t _linearizable_barrier_lease_hits = 0;
+    hdr_hist _replicate_batch_size;
+    hdr_hist _replicate_batch_linger;
+    log_hist<std::chrono::microseconds> _log_flush_latency;
 
     ss::metrics::metric_groups _metrics;
+    partition_metrics::registry::member _aggregated_metrics;
 };
 } // namespace raft
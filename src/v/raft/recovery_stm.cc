@@ -9,6 +9,7 @@
 
 #include "raft/recovery_stm.h"
 
+#include "config/configuration.h"
 #include "model/fundamental.h"
 #include "model/record_batch_reader.h"
 #include "outcome_future_utils.h"
@@ -194,19 +195,21 @@ ss::future<> recovery_stm::read_range_for_recovery(
       start_offset,
       end_offset,
       1,
-      // 32KB is a modest estimate. It has good batching and it also prevents an
-      // OOM situation where we have a lot of raft groups recovering at the same
-      // time and all drawing from memory. If this setting proves difficult,
-      // we'll need to throttle with a core-local semaphore
-      32 * 1024,
+      // starts with a modest 32KB read that has good batching and prevents an
+      // OOM situation where we have a lot of raft groups recovering at the
+      // same time and all drawing from memory. The read size grows while the
+      // follower keeps accepting the requests, so that followers far behind,
+      // e.g. new replicas, are not bound by the request round trip time
+      _read_size,
       iopc,
       std::nullopt,
       std::nullopt,
       _ptr->_as);
 
-    if (is_learner) {
+    if (is_learner || _read_size > min_read_size) {
         // skip cache insertion on miss for learners which are throttled and
-        // often catching up from the beginning of the log (e.g. new nodes)
+        // often catching up from the beginning of the log (e.g. new nodes) and
+        // for followers reading far behind the tip of the log
         cfg.skip_batch_cache = true;
     }
 
@@ -223,8 +226,11 @@ ss::future<> recovery_stm::read_range_for_recovery(
           return model::consume_reader_to_memory(
             std::move(reader), model::no_timeout);
       })
-      .then([this, start_offset, follower_committed_match_index, is_learner](
-              ss::circular_buffer<model::record_batch> batches) {
+      .then([this,
+             start_offset,
+             end_offset,
+             follower_committed_match_index,
+             is_learner](ss::circular_buffer<model::record_batch> batches) {
           vlog(
             _ctxlog.trace,
             "Read {} batches for {} node recovery",
@@ -239,18 +245,23 @@ ss::future<> recovery_stm::read_range_for_recovery(
           _base_batch_offset = gap_filled_batches.begin()->base_offset();
           _last_batch_offset = gap_filled_batches.back().last_offset();
 
+          const auto size = std::accumulate(
+            gap_filled_batches.cbegin(),
+            gap_filled_batches.cend(),
+            size_t{0},
+            [](size_t acc, const auto& batch) {
+                return acc + batch.size_bytes();
+            });
+          _ptr->get_probe().recovery_bytes_sent(size);
+
           auto throttle_f = ss::now();
           if (is_learner && _ptr->_recovery_throttle) {
-              const auto size = std::accumulate(
-                gap_filled_batches.cbegin(),
-                gap_filled_batches.cend(),
-                size_t{0},
-                [](size_t acc, const auto& batch) {
-                    return acc + batch.size_bytes();
-                });
+              // followers closest to the end of the log are served first
+              const auto lag = std::max<int64_t>(
+                0, end_offset() - start_offset());
               throttle_f
                 = _ptr->_recovery_throttle->get()
-                    .throttle(size)
+                    .throttle(size, lag)
                     .handle_exception_type([this](const ss::broken_semaphore&) {
                         vlog(_ctxlog.info, "Recovery throttling has stopped");
                     });
@@ -283,8 +294,8 @@ ss::future<> recovery_stm::open_snapshot_reader() {
 }
 
 ss::future<> recovery_stm::send_install_snapshot_request() {
-    // send 32KB at a time
-    return read_iobuf_exactly(_snapshot_reader->input(), 32_KiB)
+    // snapshot chunks are sized as log reads, starting with 32KB
+    return read_iobuf_exactly(_snapshot_reader->input(), _read_size)
       .then([this](iobuf chunk) mutable {
           auto chunk_size = chunk.size_bytes();
           install_snapshot_request req{
@@ -327,6 +338,7 @@ ss::future<> recovery_stm::handle_install_snapshot_reply(
   result<install_snapshot_reply> reply) {
     // snapshot delivery failed
     if (reply.has_error() || !reply.value().success) {
+        reset_read_size();
         return close_snapshot_reader();
     }
     if (reply.value().term > _ptr->_term) {
@@ -334,6 +346,7 @@ ss::future<> recovery_stm::handle_install_snapshot_reply(
           [this, term = reply.value().term] { return _ptr->step_down(term); });
     }
     _sent_snapshot_bytes = reply.value().bytes_stored;
+    grow_read_size();
 
     // we will send next chunk as a part of recovery loop
     if (_sent_snapshot_bytes != _snapshot_size) {
@@ -427,6 +440,7 @@ ss::future<> recovery_stm::replicate(
                 r.error().message());
               _stop_requested = true;
               _ptr->get_probe().recovery_request_error();
+              reset_read_size();
           }
           _ptr->process_append_entries_reply(
             _node_id.id(), r.value(), seq, dirty_offset);
@@ -449,6 +463,12 @@ ss::future<> recovery_stm::replicate(
           // If AppendEntries fails because of log inconsistency: decrement
           // nextIndex and retry(§5.3)
 
+          if (r.value().result != append_entries_reply::status::success) {
+              reset_read_size();
+          } else {
+              grow_read_size();
+          }
+
           if (r.value().result == append_entries_reply::status::failure) {
               auto meta = get_follower_meta();
               if (!meta) {
@@ -466,6 +486,16 @@ ss::future<> recovery_stm::replicate(
       });
 }
 
+void recovery_stm::grow_read_size() {
+    _read_size = std::max(
+      min_read_size,
+      std::min(
+        _read_size * 2,
+        config::shard_local_cfg().raft_recovery_max_read_size()));
+}
+
+void recovery_stm::reset_read_size() { _read_size = min_read_size; }
+
 clock_type::time_point recovery_stm::append_entries_timeout() {
     return raft::clock_type::now() + _ptr->_recovery_append_timeout;
 }
@@ -15,6 +15,7 @@
 #include "outcome.h"
 #include "raft/logger.h"
 #include "storage/snapshot.h"
+#include "units.h"
 
 namespace raft {
 
@@ -44,6 +45,11 @@ private:
     bool is_recovery_finished();
     append_entries_request::flush_after_append
       should_flush(model::offset) const;
+    void grow_read_size();
+    void reset_read_size();
+
+    static constexpr size_t min_read_size = 32_KiB;
+
     consensus* _ptr;
     vnode _node_id;
     model::offset _base_batch_offset;
@@ -56,6 +62,8 @@ private:
     std::unique_ptr<storage::snapshot_reader> _snapshot_reader;
     size_t _sent_snapshot_bytes = 0;
     size_t _snapshot_size = 0;
+    // size of the log reads and snapshot chunks sent to the follower
+    size_t _read_size = min_read_size;
     // needed to early exit. (node down)
     bool _stop_requested = false;
 };
@@ -11,16 +11,29 @@
 #pragma once
 #include "seastarx.h"
 
+#include <seastar/core/future.hh>
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/smp.hh>
 #include <seastar/core/timer.hh>
 #include <seastar/util/later.hh>
 
+#include <algorithm>
+#include <vector>
+
 namespace raft {
 
 /*
  * Token bucket-based raft recovery throttling.
  *
+ * When the bucket runs dry the waiting requests are served in a weighted fair
+ * order: each request is tagged with a virtual finish time equal to the
+ * virtual time of the throttle plus its size divided by a weight, and the
+ * request with the lowest tag is served first. The weight is the highest for
+ * followers that are only a few offsets behind the leader so that they rejoin
+ * the group quickly instead of waiting behind long catch-ups, while the
+ * virtual time advancing with every served request guarantees the followers
+ * far behind keep making progress.
+ *
  * Improvements
  *
  *  - cross-core bandwidth sharing
@@ -33,26 +46,45 @@ class recovery_throttle {
     using clock_type = ss::lowres_clock;
     static constexpr std::chrono::milliseconds refresh_error{5};
     static constexpr std::chrono::milliseconds refresh_interval{50};
+    // weight of the followers that are less than `lag_unit` offsets behind,
+    // the weight is halved with every `lag_unit` offsets of lag
+    static constexpr size_t max_weight = 64;
+    static constexpr size_t lag_unit = 1024;
 
 public:
     explicit recovery_throttle(size_t rate)
       : _rate(rate)
-      , _sem{_rate}
+      , _available(_rate)
       , _last_refresh(clock_type::now())
       , _refresh_timer([this] { handle_refresh(); }) {}
 
-    ss::future<> throttle(size_t size) {
+    /// waits until `size` bytes may be sent to a follower which is `lag`
+    /// offsets behind the leader
+    ss::future<> throttle(size_t size, size_t lag = 0) {
+        if (_stopped) {
+            return ss::make_exception_future<>(ss::broken_semaphore());
+        }
         _refresh_timer.cancel();
         refresh();
 
         /*
-         * when try_wait succeeds it implies that there are no waiters so there
-         * is no risk in returning without arming the refresh timer.
+         * when there are no waiters there is no risk in returning without
+         * arming the refresh timer.
          */
-        if (_sem.try_wait(size)) {
+        if (_waiters.empty() && _available >= size) {
+            _available -= size;
             return ss::now();
         }
 
+        const auto cost = std::max<size_t>(1, size / weight(lag));
+        waiter w{
+          .finish_time = _virtual_time + cost,
+          .seq = _next_seq++,
+          .size = size};
+        auto f = w.done.get_future();
+        _waiters.push_back(std::move(w));
+        std::push_heap(_waiters.begin(), _waiters.end(), waiter_order{});
+
         auto elapsed = clock_type::now() - _last_refresh;
         if (elapsed >= refresh_interval) {
             _refresh_timer.arm(refresh_interval);
@@ -60,15 +92,44 @@ public:
             _refresh_timer.arm(refresh_interval - elapsed);
         }
 
-        return _sem.wait(size);
+        return f;
     }
 
     void shutdown() {
+        _stopped = true;
         _refresh_timer.cancel();
-        _sem.broken();
+        for (auto& w : _waiters) {
+            w.done.set_exception(ss::broken_semaphore());
+        }
+        _waiters.clear();
     }
 
+    size_t waiters() const { return _waiters.size(); }
+
 private:
+    struct waiter {
+        uint64_t finish_time;
+        uint64_t seq;
+        size_t size;
+        ss::promise<> done;
+    };
+
+    // max-heap comparator placing the lowest finish time, and then the oldest
+    // request, on top
+    struct waiter_order {
+        bool operator()(const waiter& l, const waiter& r) const {
+            if (l.finish_time != r.finish_time) {
+                return l.finish_time > r.finish_time;
+            }
+            return l.seq > r.seq;
+        }
+    };
+
+    static size_t weight(size_t lag) {
+        auto halvings = std::min<size_t>(lag / lag_unit, 6);
+        return max_weight >> halvings;
+    }
+
     void refresh() {
         auto now = clock_type::now();
         auto elapsed = now - _last_refresh;
@@ -84,15 +145,29 @@ private:
         auto refresh = _rate * (elapsed - refresh_error)
                        / std::chrono::milliseconds(1000);
 
-        _sem.signal(refresh);
+        _available += refresh;
+        serve_waiters();
 
         /*
          * throttling is based on an estimate. if rate is low and a waiter
          * underestimated we may need to allow the available tokens to exceed
          * the rate to let a waiter through.
          */
-        if (_sem.current() > _rate && !_sem.waiters()) {
-            _sem.consume(_sem.current() - _rate);
+        if (_available > _rate && _waiters.empty()) {
+            _available = _rate;
+        }
+    }
+
+    void serve_waiters() {
+        // the request on top is served first even if a smaller one could fit
+        // in the available tokens, otherwise it could be starved
+        while (!_waiters.empty() && _waiters.front().size <= _available) {
+            std::pop_heap(_waiters.begin(), _waiters.end(), waiter_order{});
+            auto w = std::move(_waiters.back());
+            _waiters.pop_back();
+            _available -= w.size;
+            _virtual_time = std::max(_virtual_time, w.finish_time);
+            w.done.set_value();
         }
     }
 
@@ -102,15 +177,19 @@ private:
          * if a waiter exists continue refreshing since it is not guaranteed
          * that throttle will be invoked (e.g. excactly one recovering group).
          */
-        if (_sem.waiters()) {
+        if (!_waiters.empty()) {
             _refresh_timer.arm(refresh_interval);
         }
     }
 
     size_t _rate;
-    ss::semaphore _sem;
+    size_t _available;
     clock_type::time_point _last_refresh;
     ss::timer<> _refresh_timer;
+    std::vector<waiter> _waiters;
+    uint64_t _virtual_time = 0;
+    uint64_t _next_seq = 0;
+    bool _stopped = false;
 };
 
 } // namespace raft
@@ -9,6 +9,7 @@
 
 #include "raft/replicate_batcher.h"
 
+#include "config/configuration.h"
 #include "model/fundamental.h"
 #include "model/record.h"
 #include "model/record_batch_reader.h"
@@ -32,10 +33,20 @@
 
 namespace raft {
 using namespace std::chrono_literals; // NOLINT
+// weight of the older windows, number of windows (flushes) averaged
+static constexpr double arrival_smoothing_factor = 0.5;
+static constexpr size_t arrival_windows = 4;
+// requests arriving further apart than that are not considered to be related
+static constexpr auto max_arrival_interval = std::chrono::seconds(1);
+// when lingering, wait for about that many more requests to arrive
+static constexpr int linger_arrivals = 4;
+
 replicate_batcher::replicate_batcher(consensus* ptr, size_t cache_size)
   : _ptr(ptr)
   , _max_batch_size_sem(cache_size)
-  , _max_batch_size(cache_size) {}
+  , _max_batch_size(cache_size)
+  , _arrival_interval(
+      arrival_smoothing_factor, max_arrival_interval, arrival_windows) {}
 
 replicate_stages replicate_batcher::replicate(
   std::optional<model::term_id> expected_term, model::record_batch_reader&& r) {
@@ -59,7 +70,10 @@ replicate_stages replicate_batcher::replicate(
                     auto item = f.get();
                     return _lock.get_units()
                       .then([this](ss::semaphore_units<> u) {
-                          return flush(std::move(u));
+                          return maybe_linger().then(
+                            [this, u = std::move(u)]() mutable {
+                                return flush(std::move(u));
+                            });
                       })
                       .then_wrapped(
                         [this, item, guard = std::move(guard)](ss::future<> f) {
@@ -151,10 +165,45 @@ replicate_batcher::do_cache_with_backpressure(
           i->record_count = record_count;
           i->units = std::move(u);
           _item_cache.emplace_back(i);
+          record_arrival();
           return i;
       });
 }
 
+void replicate_batcher::record_arrival() {
+    auto now = clock_type::now();
+    auto interval = std::min<clock_type::duration>(
+      now - _last_arrival, max_arrival_interval);
+    _last_arrival = now;
+    _arrival_interval.update(
+      std::chrono::duration_cast<std::chrono::microseconds>(interval));
+}
+
+ss::future<> replicate_batcher::maybe_linger() {
+    if (_item_cache.empty()) {
+        // requests were already flushed by the previous lock holder
+        return ss::now();
+    }
+    // sample() returns milliseconds
+    auto expected_interval = std::chrono::microseconds(
+      static_cast<int64_t>(_arrival_interval.sample() * 1000));
+    _arrival_interval.tick();
+
+    const auto max_linger = std::chrono::microseconds(
+      config::shard_local_cfg().raft_replicate_batch_max_linger_us());
+    // pass through when requests are not likely to arrive soon or when the
+    // cached requests already fill half of the batch
+    if (
+      expected_interval >= max_linger
+      || _max_batch_size_sem.available_units()
+           < static_cast<ssize_t>(_max_batch_size / 2)) {
+        return ss::now();
+    }
+    auto linger = std::min(max_linger, expected_interval * linger_arrivals);
+    _ptr->_probe.replicate_batch_lingered(linger);
+    return ss::sleep(linger);
+}
+
 ss::future<> replicate_batcher::flush(ss::semaphore_units<> u) {
     return ss::try_with_gate(
       _bg, [this, batcher_units = std::move(u)]() mutable {
@@ -195,6 +244,7 @@ ss::future<> replicate_batcher::flush(ss::semaphore_units<> u) {
                 auto meta = _ptr->meta();
                 auto const term = model::term_id(meta.term);
                 ss::circular_buffer<model::record_batch> data;
+                size_t data_bytes = 0;
                 std::vector<item_ptr> notifications;
                 ss::semaphore_units<> item_memory_units(_max_batch_size_sem, 0);
                 for (auto& n : item_cache) {
@@ -204,6 +254,7 @@ ss::future<> replicate_batcher::flush(ss::semaphore_units<> u) {
                       || n->expected_term.value() == term) {
                         for (auto& b : n->data) {
                             b.set_term(term);
+                            data_bytes += b.size_bytes();
                             data.push_back(std::move(b));
                         }
                         notifications.push_back(std::move(n));
@@ -217,16 +268,20 @@ ss::future<> replicate_batcher::flush(ss::semaphore_units<> u) {
                 }
 
                 auto seqs = _ptr->next_followers_request_seq();
+                // followers of write caching logs flush in the background
                 append_entries_request req(
                   _ptr->_self,
                   std::move(meta),
-                  model::make_memory_record_batch_reader(std::move(data)));
+                  model::make_memory_record_batch_reader(std::move(data)),
+                  append_entries_request::flush_after_append(
+                    !_ptr->write_caching()));
                 std::vector<ss::semaphore_units<>> units;
                 units.reserve(2);
                 units.push_back(std::move(u));
                 // we will release memory semaphore as soon as append entry
                 // requests will be dispatched
                 units.push_back(std::move(item_memory_units));
+                _ptr->_probe.replicate_batch_flushed(data_bytes);
                 return do_flush(
                   std::move(notifications),
                   std::move(req),
@@ -269,7 +324,6 @@ ss::future<> replicate_batcher::do_flush(
   append_entries_request req,
   std::vector<ss::semaphore_units<>> u,
   absl::flat_hash_map<vnode, follower_req_seq> seqs) {
-    _ptr->_probe.replicate_batch_flushed();
     try {
         auto result = co_await _ptr->dispatch_replicate(
           std::move(req), std::move(u), std::move(seqs));
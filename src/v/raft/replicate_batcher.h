@@ -15,12 +15,15 @@
 #include "outcome.h"
 #include "raft/types.h"
 #include "units.h"
+#include "utils/ema.h"
 #include "utils/mutex.h"
 
 #include <seastar/core/gate.hh>
 #include <seastar/core/semaphore.hh>
 
 #include <absl/container/flat_hash_map.h>
+
+#include <chrono>
 namespace raft {
 class consensus;
 
@@ -52,6 +55,10 @@ public:
     ss::future<> stop();
 
 private:
+    using clock_type = std::chrono::steady_clock;
+
+    void record_arrival();
+    ss::future<> maybe_linger();
     ss::future<> flush(ss::semaphore_units<> u);
     ss::future<> do_flush(
       std::vector<item_ptr>,
@@ -70,6 +77,14 @@ private:
     ss::semaphore _max_batch_size_sem;
     size_t _max_batch_size;
     std::vector<item_ptr> _item_cache;
+    /**
+     * Smoothed interval between replicate requests, one window per flush.
+     * When requests arrive faster than the maximum linger time the batcher
+     * waits for a few more of them before flushing, so that they are appended
+     * and flushed to disk together.
+     */
+    exponential_moving_average<std::chrono::microseconds> _arrival_interval;
+    clock_type::time_point _last_arrival;
     mutex _lock;
     ss::gate _bg;
 };
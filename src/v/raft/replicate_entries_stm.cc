@@ -38,13 +38,30 @@ ss::future<append_entries_request> replicate_entries_stm::share_request() {
               _req->batches = std::move(readers.back());
               readers.pop_back();
               return append_entries_request{
-                _req->node_id, _req->meta, std::move(readers.back())};
+                _req->node_id,
+                _req->meta,
+                std::move(readers.back()),
+                _req->flush};
           });
     });
 }
 
 ss::future<result<append_entries_reply>> replicate_entries_stm::flush_log() {
     using ret_t = result<append_entries_reply>;
+    if (_ptr->write_caching()) {
+        // the append is acknowledged once a majority appended it, the log is
+        // flushed in the background
+        append_entries_reply reply;
+        reply.node_id = _ptr->_self;
+        reply.target_node_id = _ptr->_self;
+        reply.group = _ptr->group();
+        reply.term = _ptr->term();
+        reply.last_dirty_log_index = _dirty_offset;
+        reply.last_committed_log_index = _ptr->_log.offsets().committed_offset;
+        reply.result = append_entries_reply::status::success;
+        _dispatch_sem.signal();
+        return ss::make_ready_future<ret_t>(reply);
+    }
     auto f = _ptr->flush_log()
                .then([this]() {
                    /**
@@ -150,6 +167,10 @@ ss::future<> replicate_entries_stm::dispatch_one(vnode id) {
 
                        if (!reply) {
                            _ptr->get_probe().replicate_request_error();
+                           if (auto it = _ptr->_fstats.find(id);
+                               it != _ptr->_fstats.end()) {
+                               _ptr->append_entries_failed(it->second, seq);
+                           }
                        }
                        _ptr->process_append_entries_reply(
                          id.id(), reply, seq, _dirty_offset);
@@ -202,6 +223,10 @@ replicate_entries_stm::append_to_self() {
  *     pressure. Follower will still receive heartbeats, as we skip sending
  *     append entries request, after recovery follower will start receiving
  *     requests.
+ *   - one of the requests pipelined to the follower failed - the requests
+ *     following it can not be appended by the follower, we stop dispatching
+ *     new ones until a newer follower reply is received (see
+ *     follower_index_metadata::last_failed_seq)
  */
 inline bool replicate_entries_stm::should_skip_follower_request(vnode id) {
     if (auto it = _ptr->_fstats.find(id); it != _ptr->_fstats.end()) {
@@ -209,7 +234,8 @@ inline bool replicate_entries_stm::should_skip_follower_request(vnode id) {
                              - _ptr->_replicate_append_timeout;
 
         return it->second.last_hbeat_timestamp < timeout
-               || it->second.is_recovering;
+               || it->second.is_recovering
+               || it->second.last_failed_seq.has_value();
     }
 
     return false;
@@ -275,8 +301,11 @@ ss::future<result<replicate_result>> replicate_entries_stm::apply(units_t u) {
            * have been either commited or truncated
            */
           auto stop_cond = [this, appended_offset, appended_term] {
-              return _ptr->committed_offset() >= appended_offset
-                     || _ptr->term() > appended_term;
+              // write caching logs do not wait for the append to be flushed
+              const auto acked = _ptr->write_caching()
+                                   ? _ptr->_majority_replicated_index
+                                   : _ptr->committed_offset();
+              return acked >= appended_offset || _ptr->term() > appended_term;
           };
           return _ptr->_commit_index_updated.wait(stop_cond)
             .then([this, appended_offset, appended_term] {
@@ -34,6 +34,20 @@ ss::future<result<vote_reply>> rpc_client_protocol::vote(
       });
 }
 
+ss::future<result<vote_batch_reply>> rpc_client_protocol::vote_batch(
+  model::node_id n, vote_batch_request&& r, rpc::client_opts opts) {
+    return _connection_cache.local().with_node_client<raftgen_client_protocol>(
+      _self,
+      ss::this_shard_id(),
+      n,
+      opts.timeout,
+      [r = std::move(r),
+       opts = std::move(opts)](raftgen_client_protocol client) mutable {
+          return client.vote_batch(std::move(r), std::move(opts))
+            .then(&rpc::get_ctx_data<vote_batch_reply>);
+      });
+}
+
 ss::future<result<append_entries_reply>> rpc_client_protocol::append_entries(
   model::node_id n, append_entries_request&& r, rpc::client_opts opts) {
     return _connection_cache.local().with_node_client<raftgen_client_protocol>(
@@ -48,6 +62,21 @@ ss::future<result<append_entries_reply>> rpc_client_protocol::append_entries(
       });
 }
 
+ss::future<result<append_entries_batch_reply>>
+rpc_client_protocol::append_entries_batch(
+  model::node_id n, append_entries_batch_request&& r, rpc::client_opts opts) {
+    return _connection_cache.local().with_node_client<raftgen_client_protocol>(
+      _self,
+      ss::this_shard_id(),
+      n,
+      opts.timeout,
+      [r = std::move(r),
+       opts = std::move(opts)](raftgen_client_protocol client) mutable {
+          return client.append_entries_batch(std::move(r), std::move(opts))
+            .then(&rpc::get_ctx_data<append_entries_batch_reply>);
+      });
+}
+
 ss::future<result<heartbeat_reply>> rpc_client_protocol::heartbeat(
   model::node_id n, heartbeat_request&& r, rpc::client_opts opts) {
     return _connection_cache.local().with_node_client<raftgen_client_protocol>(
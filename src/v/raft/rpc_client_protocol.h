@@ -34,9 +34,15 @@ public:
     ss::future<result<vote_reply>>
     vote(model::node_id, vote_request&&, rpc::client_opts) final;
 
+    ss::future<result<vote_batch_reply>>
+    vote_batch(model::node_id, vote_batch_request&&, rpc::client_opts) final;
+
     ss::future<result<append_entries_reply>> append_entries(
       model::node_id, append_entries_request&&, rpc::client_opts) final;
 
+    ss::future<result<append_entries_batch_reply>> append_entries_batch(
+      model::node_id, append_entries_batch_request&&, rpc::client_opts) final;
+
     ss::future<result<heartbeat_reply>>
     heartbeat(model::node_id, heartbeat_request&&, rpc::client_opts) final;
 
@@ -116,6 +116,18 @@ public:
               std::move(
                 missing.begin(), missing.end(), std::back_inserter(ret));
               return heartbeat_reply{std::move(ret)};
+          })
+          .then([this,
+                 leader = r.node_id,
+                 quiescent = std::move(r.quiescent_groups)](
+                  heartbeat_reply reply) mutable {
+              return refresh_quiescent_groups(leader, std::move(quiescent))
+                .then([reply = std::move(reply)](
+                        std::vector<group_id> rejected) mutable {
+                    reply.rejected_quiescent_groups = std::move(rejected);
+                    reply.supports_quiescent_groups = true;
+                    return std::move(reply);
+                });
           });
     }
 
@@ -131,6 +143,37 @@ public:
         });
     }
 
+    [[gnu::always_inline]] ss::future<vote_batch_reply>
+    vote_batch(vote_batch_request&& r, rpc::streaming_context&) final {
+        return _probe.vote_batch().then([this, r = std::move(r)]() mutable {
+            std::vector<ss::future<vote_reply>> futures;
+            futures.reserve(r.requests.size());
+            for (auto& req : r.requests) {
+                auto source = req.node_id;
+                futures.push_back(
+                  dispatch_request(
+                    std::move(req),
+                    &service::make_failed_vote_reply,
+                    [](vote_request&& r, consensus_ptr c) {
+                        return c->vote(std::move(r));
+                    })
+                    .handle_exception([source](const std::exception_ptr&) {
+                        // not granted, the candidate retries in the next
+                        // election round
+                        return vote_reply{
+                          .target_node_id = source,
+                          .term = model::term_id{},
+                          .granted = false,
+                          .log_ok = false};
+                    }));
+            }
+            return ss::when_all_succeed(futures.begin(), futures.end())
+              .then([](std::vector<vote_reply> replies) {
+                  return vote_batch_reply{std::move(replies)};
+              });
+        });
+    }
+
     [[gnu::always_inline]] ss::future<append_entries_reply>
     append_entries(append_entries_request&& r, rpc::streaming_context&) final {
         return _probe.append_entries().then([this, r = std::move(r)]() mutable {
@@ -144,6 +187,44 @@ public:
         });
     }
 
+    [[gnu::always_inline]] ss::future<append_entries_batch_reply>
+    append_entries_batch(
+      append_entries_batch_request&& r, rpc::streaming_context&) final {
+        return _probe.append_entries_batch().then([this,
+                                                   r = std::move(r)]() mutable {
+            std::vector<ss::future<append_entries_reply>> futures;
+            futures.reserve(r.requests.size());
+            // requests are dispatched in order, the requests of a single group
+            // are processed in the same order as if they were sent one by one
+            for (auto& req : r.requests) {
+                auto gr = req.target_group();
+                auto source = req.node_id;
+                auto target = req.target_node();
+                futures.push_back(
+                  dispatch_request(
+                    append_entries_request::make_foreign(std::move(req)),
+                    [gr]() { return make_missing_group_reply(gr); },
+                    [](append_entries_request&& r, consensus_ptr c) {
+                        return c->append_entries(std::move(r));
+                    })
+                    .handle_exception(
+                      [gr, source, target](const std::exception_ptr&) {
+                          // the request was not processed, the leader will
+                          // treat it as a failed one
+                          return append_entries_reply{
+                            .target_node_id = source,
+                            .node_id = target,
+                            .group = gr,
+                            .result = append_entries_reply::status::timeout};
+                      }));
+            }
+            return ss::when_all_succeed(futures.begin(), futures.end())
+              .then([](std::vector<append_entries_reply> replies) {
+                  return append_entries_batch_reply{std::move(replies)};
+              });
+        });
+    }
+
     [[gnu::always_inline]] ss::future<install_snapshot_reply> install_snapshot(
       install_snapshot_request&& r, rpc::streaming_context&) final {
         return _probe.install_snapshot().then([this,
@@ -188,6 +269,8 @@ private:
     using consensus_ptr = seastar::lw_shared_ptr<consensus>;
     using hbeats_t = std::vector<append_entries_request>;
     using hbeats_ptr = ss::foreign_ptr<std::unique_ptr<hbeats_t>>;
+    using groups_ptr
+      = ss::foreign_ptr<std::unique_ptr<std::vector<group_id>>>;
     struct shard_groupped_hbeat_requests {
         absl::flat_hash_map<ss::shard_id, hbeats_ptr> shard_requests;
         std::vector<append_entries_request> group_missing_requests;
@@ -290,6 +373,67 @@ private:
         return ss::when_all_succeed(futures.begin(), futures.end());
     }
 
+    /// refreshes election timers of the groups sent as quiescent by \p leader,
+    /// returns the groups that are not followers of \p leader on this node
+    ss::future<std::vector<group_id>> refresh_quiescent_groups(
+      model::node_id leader, std::vector<group_id> groups) {
+        std::vector<group_id> rejected;
+        if (groups.empty()) {
+            return ss::make_ready_future<std::vector<group_id>>(
+              std::move(rejected));
+        }
+        absl::flat_hash_map<ss::shard_id, groups_ptr> shard_groups;
+        for (auto g : groups) {
+            if (unlikely(!_shard_table.contains(g))) {
+                rejected.push_back(g);
+                continue;
+            }
+            auto& ptr = shard_groups[_shard_table.shard_for(g)];
+            if (!ptr) {
+                ptr = ss::make_foreign(
+                  std::make_unique<std::vector<group_id>>());
+            }
+            ptr->push_back(g);
+        }
+
+        std::vector<ss::future<std::vector<group_id>>> futures;
+        futures.reserve(shard_groups.size());
+        for (auto& [shard, g] : shard_groups) {
+            futures.push_back(
+              refresh_quiescent_groups_on_core(shard, leader, std::move(g)));
+        }
+        return ss::when_all_succeed(futures.begin(), futures.end())
+          .then([rejected = std::move(rejected)](
+                  std::vector<std::vector<group_id>> parts) mutable {
+              for (auto& part : parts) {
+                  std::move(
+                    part.begin(), part.end(), std::back_inserter(rejected));
+              }
+              return std::move(rejected);
+          });
+    }
+
+    ss::future<std::vector<group_id>> refresh_quiescent_groups_on_core(
+      ss::shard_id shard, model::node_id leader, groups_ptr groups) {
+        return with_scheduling_group(
+          get_scheduling_group(),
+          [this, shard, leader, g = std::move(groups)]() mutable {
+              return _group_manager.invoke_on(
+                shard,
+                get_smp_service_group(),
+                [leader, g = std::move(g)](ConsensusManager& m) {
+                    std::vector<group_id> rejected;
+                    for (auto group : *g) {
+                        auto c = m.consensus_for(group);
+                        if (!c || !c->refresh_leader_heartbeat(leader)) {
+                            rejected.push_back(group);
+                        }
+                    }
+                    return rejected;
+                });
+          });
+    }
+
     shard_groupped_hbeat_requests group_hbeats_by_shard(hbeats_t reqs) {
         shard_groupped_hbeat_requests ret;
 
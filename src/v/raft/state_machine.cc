@@ -36,6 +36,10 @@ ss::future<> state_machine::start() {
 
 void state_machine::set_next(model::offset offset) { _next = offset; }
 
+void state_machine::notify_applied(model::offset offset) {
+    _waiters.notify(offset);
+}
+
 ss::future<> state_machine::handle_eviction() {
     vlog(
       _log.warn,
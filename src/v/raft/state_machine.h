@@ -101,6 +101,9 @@ public:
 
 protected:
     void set_next(model::offset offset);
+    /// wakes up the waiters of offsets up to and including `offset`, used
+    /// when batches are not applied one by one, e.g. restored from a snapshot
+    void notify_applied(model::offset offset);
     virtual ss::future<> handle_eviction();
     ss::gate _gate;
 
@@ -8,6 +8,7 @@
 // by the Apache License, Version 2.0
 
 #include "bytes/bytes.h"
+#include "config/configuration.h"
 #include "finjector/hbadger.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
@@ -133,6 +134,21 @@ FIXTURE_TEST(test_replicate_with_expected_term_quorum, raft_test_fixture) {
     }
 };
 
+FIXTURE_TEST(test_write_caching_does_not_wait_for_flush, raft_test_fixture) {
+    raft_group gr = raft_group(raft::group_id(0), 3);
+    // flushes take longer than the replicate timeout
+    gr.set_simulation(node_simulation{
+      .flush_delay = 3s, .write_caching = storage::with_write_caching::yes});
+    gr.enable_all();
+    wait_for_group_leader(gr);
+
+    bool success = replicate_random_batches(
+                     gr, 5, raft::consistency_level::quorum_ack, 1s)
+                     .get0();
+    BOOST_REQUIRE(success);
+    validate_logs_replication(gr);
+};
+
 FIXTURE_TEST(test_replicate_violating_expected_term_leader, raft_test_fixture) {
     raft_group gr = raft_group(raft::group_id(0), 3);
     gr.enable_all();
@@ -224,6 +240,39 @@ FIXTURE_TEST(test_empty_node_recovery, raft_test_fixture) {
       "After recovery state is consistent");
 };
 
+FIXTURE_TEST(test_empty_node_recovery_with_growing_reads, raft_test_fixture) {
+    auto& max_read_size = config::shard_local_cfg().raft_recovery_max_read_size;
+    auto default_max_read_size = max_read_size();
+    max_read_size.set_value(size_t(1_MiB));
+
+    raft_group gr = raft_group(raft::group_id(0), 3);
+    gr.enable_all();
+    bool success = replicate_random_batches(gr, 50).get0();
+    BOOST_REQUIRE(success);
+
+    validate_logs_replication(gr);
+    model::node_id disabled_id;
+    for (auto& [id, m] : gr.get_members()) {
+        if (gr.get_leader_id() != id) {
+            disabled_id = id;
+            auto path = m.log->config().work_directory();
+            gr.disable_node(id);
+            std::filesystem::remove_all(std::filesystem::path(path));
+            break;
+        }
+    }
+
+    gr.enable_node(disabled_id);
+
+    validate_logs_replication(gr);
+
+    wait_for(
+      10s,
+      [this, &gr] { return are_all_commit_indexes_the_same(gr); },
+      "After recovery state is consistent");
+    max_read_size.set_value(default_max_read_size);
+};
+
 FIXTURE_TEST(test_empty_node_recovery_relaxed_consistency, raft_test_fixture) {
     raft_group gr = raft_group(raft::group_id(0), 3);
     gr.enable_all();
@@ -764,6 +813,32 @@ FIXTURE_TEST(test_linarizable_barrier_single_node, raft_test_fixture) {
     }
 };
 
+FIXTURE_TEST(test_leader_lease, raft_test_fixture) {
+    raft_group gr = raft_group(raft::group_id(0), 3);
+    gr.enable_all();
+    auto leader_id = wait_for_group_leader(gr);
+
+    bool success = replicate_random_batches(gr, 5).get0();
+    BOOST_REQUIRE(success);
+
+    leader_id = wait_for_group_leader(gr);
+    auto leader_raft = gr.get_member(leader_id).consensus;
+    // followers acknowledge replicated entries and heartbeats
+    wait_for(
+      10s,
+      [leader_raft] { return leader_raft->has_leader_lease(); },
+      "Leader holds the lease");
+
+    for (auto& [id, m] : gr.get_members()) {
+        if (id != leader_id) {
+            BOOST_REQUIRE(!m.consensus->has_leader_lease());
+        }
+    }
+    auto r = leader_raft->linearizable_barrier().get();
+    BOOST_REQUIRE(r);
+    BOOST_REQUIRE_EQUAL(r.value(), leader_raft->committed_offset());
+};
+
 FIXTURE_TEST(test_big_batches_replication, raft_test_fixture) {
     raft_group gr = raft_group(raft::group_id(0), 1);
     gr.enable_all();
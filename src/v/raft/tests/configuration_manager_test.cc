@@ -281,3 +281,18 @@ FIXTURE_TEST(test_assigning_initial_revision, config_manager_fixture) {
     BOOST_REQUIRE(
       mgr.get_latest().contains(raft::vnode(model::node_id(1), new_revision)));
 }
+
+FIXTURE_TEST(test_indexing_of_hydrated_log, config_manager_fixture) {
+    // a log hydrated from the cloud storage, 3 configurations precede it
+    _cfg_mgr
+      .adjust_configuration_idx(
+        raft::configuration_manager::configuration_idx(3))
+      .get();
+    _cfg_mgr.start(false, model::revision_id(0)).get();
+    BOOST_REQUIRE_EQUAL(_cfg_mgr.offset_delta(model::offset(100)), 3);
+
+    add_random_cfg(model::offset(120));
+    BOOST_REQUIRE_EQUAL(_cfg_mgr.get_latest_index()(), 4);
+    BOOST_REQUIRE_EQUAL(_cfg_mgr.offset_delta(model::offset(110)), 3);
+    BOOST_REQUIRE_EQUAL(_cfg_mgr.offset_delta(model::offset(130)), 4);
+}
@@ -77,6 +77,28 @@ SEASTAR_THREAD_TEST_CASE(roundtrip_raft_configuration_entry) {
     BOOST_REQUIRE_EQUAL(new_cfg, cfg);
 }
 
+SEASTAR_THREAD_TEST_CASE(roundtrip_raft_configuration_with_pinned_learners) {
+    auto brokers = random_brokers();
+    raft::group_nodes current;
+    std::vector<model::node_id> pinned;
+    for (auto& b : brokers) {
+        current.learners.emplace_back(b.id(), model::revision_id(0));
+        pinned.push_back(b.id());
+    }
+    auto cfg = raft::group_configuration(
+      std::move(brokers),
+      std::move(current),
+      model::revision_id(0),
+      std::nullopt,
+      std::move(pinned));
+
+    auto new_cfg = reflection::from_iobuf<raft::group_configuration>(
+      reflection::to_iobuf(cfg));
+
+    BOOST_REQUIRE_EQUAL(new_cfg, cfg);
+    BOOST_REQUIRE(!new_cfg.pinned_learners().empty());
+}
+
 struct test_consumer {
     explicit test_consumer(model::offset base_offset)
       : _next_offset(base_offset + model::offset(1)) {}
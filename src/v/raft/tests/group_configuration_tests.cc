@@ -46,3 +46,32 @@ BOOST_AUTO_TEST_CASE(should_return_false_as_it_does_not_contain_machine) {
     auto contains = test_grp.contains_broker(model::node_id(1));
     BOOST_REQUIRE_EQUAL(contains, false);
 }
+
+BOOST_AUTO_TEST_CASE(pinned_learners_are_not_promoted) {
+    raft::group_configuration cfg = raft::group_configuration(
+      {create_broker(1), create_broker(2), create_broker(3)},
+      model::revision_id(0));
+    cfg.add_learners({create_broker(4)}, model::revision_id(1));
+
+    // the majority does not change
+    BOOST_REQUIRE(cfg.type() == raft::configuration_type::simple);
+    const auto learner = raft::vnode(model::node_id(4), model::revision_id(1));
+    BOOST_REQUIRE(cfg.contains(learner));
+    BOOST_REQUIRE(!cfg.is_voter(learner));
+    BOOST_REQUIRE(cfg.is_pinned_learner(learner));
+    BOOST_REQUIRE(!cfg.has_learners_to_promote());
+    BOOST_REQUIRE_EQUAL(cfg.unique_voter_count(), 3);
+
+    cfg.promote_to_voter(learner);
+    BOOST_REQUIRE(!cfg.is_voter(learner));
+
+    // learners added as members are still promoted
+    cfg.add({create_broker(5)}, model::revision_id(2));
+    BOOST_REQUIRE(cfg.has_learners_to_promote());
+    cfg.promote_to_voter(raft::vnode(model::node_id(5), model::revision_id(2)));
+    BOOST_REQUIRE(!cfg.has_learners_to_promote());
+
+    cfg.discard_old_config();
+    cfg.remove({model::node_id(4)});
+    BOOST_REQUIRE(!cfg.is_pinned_learner(learner));
+}
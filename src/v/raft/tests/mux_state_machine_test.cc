@@ -165,6 +165,30 @@ struct simple_kv {
     }
 };
 
+template<int8_t bt>
+struct snapshotable_kv : simple_kv<bt> {
+    ss::future<iobuf> take_snapshot(model::offset) {
+        iobuf out;
+        reflection::serialize(out, static_cast<uint32_t>(this->kv_map.size()));
+        for (auto& [k, v] : this->kv_map) {
+            reflection::serialize(out, ss::sstring(k), int(v));
+        }
+        return ss::make_ready_future<iobuf>(std::move(out));
+    }
+
+    ss::future<> apply_snapshot(model::offset, iobuf data) {
+        iobuf_parser parser(std::move(data));
+        this->kv_map.clear();
+        auto size = reflection::adl<uint32_t>{}.from(parser);
+        for (uint32_t i = 0; i < size; ++i) {
+            auto k = reflection::adl<ss::sstring>{}.from(parser);
+            auto v = reflection::adl<int>{}.from(parser);
+            this->kv_map.emplace(std::move(k), v);
+        }
+        return ss::now();
+    }
+};
+
 ss::logger kvlog{"kv-test"};
 
 template<typename T>
@@ -292,6 +316,37 @@ FIXTURE_TEST(test_concurrent_sets, mux_state_machine_fixture) {
     BOOST_REQUIRE_EQUAL(success_count, 1);
 }
 
+FIXTURE_TEST(test_replicate_and_wait_many_batches, mux_state_machine_fixture) {
+    start_raft();
+    simple_kv<batch_type_1> state;
+    raft::mux_state_machine stm(
+      kvlog, _raft.get(), raft::persistent_last_applied::yes, state);
+    stm.start().get0();
+    auto stop = ss::defer([&stm] { stm.stop().get0(); });
+    wait_for_leader();
+    ss::abort_source as;
+
+    model::record_batch_reader::data_t batches;
+    batches.push_back(serialize_cmd(set_cmd{"a", 1}, batch_type_1));
+    batches.push_back(serialize_cmd(set_cmd{"b", 2}, batch_type_1));
+    batches.push_back(serialize_cmd(set_cmd{"a", 3}, batch_type_1));
+    batches.push_back(serialize_cmd(cas_cmd{"b", 2, 4}, batch_type_1));
+
+    auto res = stm
+                 .replicate_and_wait(
+                   std::move(batches), model::timeout_clock::now() + 2s, as)
+                 .get0();
+
+    // every batch gets the result of its own apply
+    BOOST_REQUIRE_EQUAL(res.size(), 4);
+    BOOST_REQUIRE_EQUAL(res[0], errc::success);
+    BOOST_REQUIRE_EQUAL(res[1], errc::success);
+    BOOST_REQUIRE_EQUAL(res[2], errc::key_already_exists);
+    BOOST_REQUIRE_EQUAL(res[3], errc::success);
+    BOOST_CHECK(state.kv_map.find("a")->second == 1);
+    BOOST_CHECK(state.kv_map.find("b")->second == 4);
+}
+
 FIXTURE_TEST(test_stm_recovery, mux_state_machine_fixture) {
     {
         auto cfg = storage::log_builder_config();
@@ -355,6 +410,42 @@ FIXTURE_TEST(test_stm_recovery, mux_state_machine_fixture) {
     BOOST_REQUIRE_EQUAL(state.kv_map.contains("test-2"), 1);
 }
 
+FIXTURE_TEST(test_stm_restore_from_snapshot, mux_state_machine_fixture) {
+    start_raft();
+    snapshotable_kv<batch_type_1> state;
+    raft::mux_state_machine stm(
+      kvlog, _raft.get(), raft::persistent_last_applied::yes, state);
+    stm.enable_snapshots(3);
+    stm.start().get0();
+    wait_for_leader();
+    ss::abort_source as;
+    for (int i = 0; i < 5; ++i) {
+        auto res = stm
+                     .replicate_and_wait(
+                       serialize_cmd(
+                         set_cmd{fmt::format("key-{}", i), i}, batch_type_1),
+                       model::timeout_clock::now() + 2s,
+                       as)
+                     .get0();
+        BOOST_REQUIRE_EQUAL(res, errc::success);
+    }
+    stm.stop().get0();
+    // log was truncated up to the snapshot
+    BOOST_REQUIRE_GT(_raft->start_offset(), model::offset(0));
+
+    // the state is restored from the snapshot and the entries following it
+    snapshotable_kv<batch_type_1> restored;
+    raft::mux_state_machine restored_stm(
+      kvlog, _raft.get(), raft::persistent_last_applied::no, restored);
+    restored_stm.start().get0();
+    auto stop = ss::defer([&restored_stm] { restored_stm.stop().get0(); });
+    restored_stm
+      .wait(_raft->committed_offset(), model::timeout_clock::now() + 1s)
+      .get0();
+    BOOST_REQUIRE_EQUAL(restored.kv_map.size(), 5);
+    BOOST_REQUIRE(restored.kv_map == state.kv_map);
+}
+
 FIXTURE_TEST(test_mulitple_states, mux_state_machine_fixture) {
     start_raft();
     simple_kv<batch_type_1> state_1;
@@ -41,6 +41,7 @@
 #include <seastar/net/socket_defs.hh>
 #include <seastar/util/noncopyable_function.hh>
 
+#include <absl/container/flat_hash_map.h>
 #include <boost/range/iterator_range_core.hpp>
 #include <fmt/core.h>
 
@@ -74,6 +75,236 @@ struct consume_to_vector {
     std::vector<model::record_batch> batches;
 };
 
+/// Simulated network and disk characteristics of a raft node
+struct node_simulation {
+    /// latency added to the append entries requests sent by the node
+    std::chrono::milliseconds append_entries_delay{0};
+    /// bandwidth, in bytes per second, of the links to every other node, the
+    /// requests sent to a node are transmitted one after the other. Unlimited
+    /// when 0
+    size_t link_bandwidth{0};
+    /// latency added to every flush of the node log
+    std::chrono::milliseconds flush_delay{0};
+    /// quorum writes are acknowledged before the node logs are flushed
+    storage::with_write_caching write_caching{storage::with_write_caching::no};
+
+    bool simulates_network() const {
+        return append_entries_delay > 0ms || link_bandwidth > 0;
+    }
+};
+
+/// Delays append entries requests before passing them to the wrapped
+/// protocol, used to simulate high RTT and limited bandwidth links
+struct delayed_client_protocol final
+  : raft::consensus_client_protocol::impl {
+    delayed_client_protocol(
+      raft::consensus_client_protocol next,
+      std::chrono::milliseconds delay,
+      size_t bandwidth = 0)
+      : _next(std::move(next))
+      , _delay(delay)
+      , _bandwidth(bandwidth) {}
+
+    ss::future<result<raft::vote_reply>> vote(
+      model::node_id n, raft::vote_request&& r, rpc::client_opts o) final {
+        return _next.vote(n, std::move(r), std::move(o));
+    }
+
+    ss::future<result<raft::vote_batch_reply>> vote_batch(
+      model::node_id n,
+      raft::vote_batch_request&& r,
+      rpc::client_opts o) final {
+        return _next.vote_batch(n, std::move(r), std::move(o));
+    }
+
+    ss::future<result<raft::append_entries_reply>> append_entries(
+      model::node_id n,
+      raft::append_entries_request&& r,
+      rpc::client_opts o) final {
+        return ss::do_with(
+          std::move(r),
+          [this, n, o = std::move(o)](raft::append_entries_request& r) mutable {
+              return transmit(n, r)
+                .then([this] { return ss::sleep(_delay); })
+                .then([this, n, &r, o = std::move(o)]() mutable {
+                    return _next.append_entries(n, std::move(r), std::move(o));
+                });
+          });
+    }
+
+    ss::future<result<raft::append_entries_batch_reply>> append_entries_batch(
+      model::node_id n,
+      raft::append_entries_batch_request&& r,
+      rpc::client_opts o) final {
+        return ss::do_with(
+          std::move(r),
+          [this, n, o = std::move(o)](
+            raft::append_entries_batch_request& r) mutable {
+              return ss::do_for_each(
+                       r.requests,
+                       [this, n](raft::append_entries_request& req) {
+                           return transmit(n, req);
+                       })
+                .then([this] { return ss::sleep(_delay); })
+                .then([this, n, &r, o = std::move(o)]() mutable {
+                    return _next.append_entries_batch(
+                      n, std::move(r), std::move(o));
+                });
+          });
+    }
+
+    ss::future<result<raft::heartbeat_reply>> heartbeat(
+      model::node_id n, raft::heartbeat_request&& r, rpc::client_opts o) final {
+        return _next.heartbeat(n, std::move(r), std::move(o));
+    }
+
+    ss::future<result<raft::install_snapshot_reply>> install_snapshot(
+      model::node_id n,
+      raft::install_snapshot_request&& r,
+      rpc::client_opts o) final {
+        return _next.install_snapshot(n, std::move(r), std::move(o));
+    }
+
+    ss::future<result<raft::timeout_now_reply>> timeout_now(
+      model::node_id n,
+      raft::timeout_now_request&& r,
+      rpc::client_opts o) final {
+        return _next.timeout_now(n, std::move(r), std::move(o));
+    }
+
+    ss::future<bool> ensure_disconnect(model::node_id n) final {
+        return _next.ensure_disconnect(n);
+    }
+
+    ss::future<result<raft::transfer_leadership_reply>> transfer_leadership(
+      model::node_id n,
+      raft::transfer_leadership_request&& r,
+      rpc::client_opts o) final {
+        return _next.transfer_leadership(n, std::move(r), std::move(o));
+    }
+
+    ss::future<> reset_backoff(model::node_id n) final {
+        return _next.reset_backoff(n);
+    }
+
+private:
+    using link_clock = ss::steady_clock_type;
+
+    /// waits until the request batches would be transmitted over the link
+    /// to the node
+    ss::future<> transmit(model::node_id n, raft::append_entries_request& r) {
+        if (_bandwidth == 0) {
+            return ss::now();
+        }
+        return model::consume_reader_to_memory(
+                 std::move(r.batches), model::no_timeout)
+          .then([this, n, &r](
+                  ss::circular_buffer<model::record_batch> batches) {
+              size_t bytes = 0;
+              for (const auto& b : batches) {
+                  bytes += b.size_bytes();
+              }
+              r.batches = model::make_memory_record_batch_reader(
+                std::move(batches));
+
+              auto now = link_clock::now();
+              auto& free_at = _link_free_at[n];
+              free_at = std::max(free_at, now)
+                        + std::chrono::microseconds(
+                          bytes * 1'000'000 / _bandwidth);
+              return ss::sleep(free_at - now);
+          });
+    }
+
+    raft::consensus_client_protocol _next;
+    std::chrono::milliseconds _delay;
+    size_t _bandwidth;
+    absl::flat_hash_map<model::node_id, link_clock::time_point> _link_free_at;
+};
+
+/// Adds a fixed latency to every flush of the wrapped log, used to simulate
+/// slow disks
+class delayed_flush_log final : public storage::log::impl {
+public:
+    delayed_flush_log(storage::log log, std::chrono::milliseconds delay)
+      : storage::log::impl(copy_config(log.config()))
+      , _log(std::move(log))
+      , _delay(delay) {
+        _stm_manager = _log.stm_manager();
+    }
+
+    ss::future<> flush() final {
+        return ss::sleep(_delay).then([this] { return _log.flush(); });
+    }
+
+    ss::future<> compact(storage::compaction_config cfg) final {
+        return _log.compact(cfg);
+    }
+    ss::future<> truncate(storage::truncate_config cfg) final {
+        return _log.truncate(cfg);
+    }
+    ss::future<> truncate_prefix(storage::truncate_prefix_config cfg) final {
+        return _log.truncate_prefix(cfg);
+    }
+    ss::future<model::record_batch_reader>
+    make_reader(storage::log_reader_config cfg) final {
+        return _log.make_reader(cfg);
+    }
+    storage::log_appender make_appender(storage::log_append_config cfg) final {
+        return _log.make_appender(cfg);
+    }
+    ss::future<> close() final { return _log.close(); }
+    ss::future<> remove() final { return _log.remove(); }
+    ss::future<std::optional<storage::timequery_result>>
+    timequery(storage::timequery_config cfg) final {
+        return _log.timequery(cfg);
+    }
+    ss::future<std::optional<storage::key_query_result>>
+    key_query(storage::key_query_config cfg) final {
+        return _log.key_query(std::move(cfg));
+    }
+    size_t segment_count() const final { return _log.segment_count(); }
+    storage::offset_stats offsets() const final { return _log.offsets(); }
+    std::ostream& print(std::ostream& o) const final { return _log.print(o); }
+    std::optional<model::term_id> get_term(model::offset o) const final {
+        return _log.get_term(o);
+    }
+    ss::future<model::offset> monitor_eviction(ss::abort_source& as) final {
+        return _log.monitor_eviction(as);
+    }
+    void set_collectible_offset(model::offset o) final {
+        _log.set_collectible_offset(o);
+    }
+    size_t size_bytes() const final { return _log.size_bytes(); }
+    uint64_t bytes_written() const final { return _log.bytes_written(); }
+    ss::future<> update_configuration(
+      storage::ntp_config::default_overrides o) final {
+        return _log.update_configuration(o);
+    }
+    int64_t compaction_backlog() const final {
+        return _log.compaction_backlog();
+    }
+    ss::future<>
+    scrub(ss::io_priority_class iopc, ss::abort_source& as) final {
+        return _log.scrub(iopc, as);
+    }
+
+private:
+    static storage::ntp_config copy_config(const storage::ntp_config& cfg) {
+        return storage::ntp_config(
+          cfg.ntp(),
+          cfg.base_directory(),
+          cfg.has_overrides()
+            ? std::make_unique<storage::ntp_config::default_overrides>(
+              cfg.get_overrides())
+            : nullptr,
+          cfg.get_revision());
+    }
+
+    storage::log _log;
+    std::chrono::milliseconds _delay;
+};
+
 struct raft_node {
     using log_t = std::vector<model::record_batch>;
     using leader_clb_t
@@ -89,7 +320,8 @@ struct raft_node {
       storage::log_config::storage_type storage_type,
       leader_clb_t l_clb,
       model::cleanup_policy_bitflags cleanup_policy,
-      size_t segment_size)
+      size_t segment_size,
+      node_simulation simulation = {})
       : broker(std::move(broker))
       , leader_callback(std::move(l_clb)) {
         cache.start().get();
@@ -110,6 +342,7 @@ struct raft_node {
 
         overrides.cleanup_policy_bitflags = cleanup_policy;
         overrides.compaction_strategy = model::compaction_strategy::offset;
+        overrides.write_caching = simulation.write_caching;
 
         storage::ntp_config ntp_cfg = storage::ntp_config(
           std::move(ntp),
@@ -119,6 +352,11 @@ struct raft_node {
 
         log = std::make_unique<storage::log>(
           storage.local().log_mgr().manage(std::move(ntp_cfg)).get0());
+        if (simulation.flush_delay > 0ms) {
+            log = std::make_unique<storage::log>(
+              ss::make_shared<delayed_flush_log>(
+                std::move(*log), simulation.flush_delay));
+        }
 
         recovery_throttle
           .start(config::shard_local_cfg().raft_learner_recovery_rate())
@@ -126,6 +364,14 @@ struct raft_node {
 
         // setup consensus
         auto self_id = broker.id();
+        auto client_protocol = raft::make_rpc_client_protocol(self_id, cache);
+        if (simulation.simulates_network()) {
+            client_protocol
+              = raft::make_consensus_client_protocol<delayed_client_protocol>(
+                std::move(client_protocol),
+                simulation.append_entries_delay,
+                simulation.link_bandwidth);
+        }
         consensus = ss::make_lw_shared<raft::consensus>(
           self_id,
           gr_id,
@@ -136,7 +382,7 @@ struct raft_node {
             seastar::default_scheduling_group(),
             seastar::default_priority_class()),
           std::chrono::seconds(10),
-          raft::make_rpc_client_protocol(self_id, cache),
+          std::move(client_protocol),
           [this](raft::leadership_status st) { leader_callback(st); },
           storage.local(),
           recovery_throttle.local());
@@ -368,7 +614,8 @@ struct raft_group {
               election_callback(node_id, st);
           },
           _cleanup_policy,
-          _segment_size);
+          _segment_size,
+          _simulation);
         it->second.start();
     }
 
@@ -412,6 +659,23 @@ struct raft_group {
         }
     }
 
+    /// delays append entries requests sent by nodes enabled afterwards
+    void set_append_entries_delay(std::chrono::milliseconds d) {
+        _simulation.append_entries_delay = d;
+    }
+
+    /// simulates the network and disks of nodes enabled afterwards
+    void set_simulation(node_simulation s) { _simulation = s; }
+
+    /// rpc port of the first node, groups running at the same time must use
+    /// distinct port ranges. Must be set before enabling the nodes
+    void set_base_port(uint16_t port) {
+        base_port = port;
+        for (auto& br : _initial_brokers) {
+            br = make_broker(br.id());
+        }
+    }
+
     std::optional<model::node_id> get_leader_id() { return _leader_id; }
 
     ss::future<model::node_id> wait_for_leader() {
@@ -490,6 +754,7 @@ private:
     ss::sstring _storage_dir;
     model::cleanup_policy_bitflags _cleanup_policy;
     size_t _segment_size;
+    node_simulation _simulation;
 };
 
 static model::record_batch_reader random_batches_reader(int max_batches) {
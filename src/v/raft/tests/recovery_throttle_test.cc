@@ -0,0 +1,77 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "raft/recovery_throttle.h"
+#include "seastarx.h"
+
+#include <seastar/core/sleep.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <vector>
+
+using namespace std::chrono_literals;
+
+SEASTAR_THREAD_TEST_CASE(throttle_within_rate) {
+    raft::recovery_throttle throttle(1000);
+    auto f = throttle.throttle(600);
+    BOOST_REQUIRE(f.available());
+    f.get();
+    auto f2 = throttle.throttle(600);
+    BOOST_REQUIRE(!f2.available());
+    f2.get();
+    throttle.shutdown();
+}
+
+SEASTAR_THREAD_TEST_CASE(throttle_prefers_followers_close_to_log_end) {
+    raft::recovery_throttle throttle(1000);
+    // drain the bucket
+    throttle.throttle(1000).get();
+
+    std::vector<int> order;
+    auto far_behind = throttle.throttle(500, 1'000'000).then(
+      [&order] { order.push_back(0); });
+    auto close = throttle.throttle(500, 10).then(
+      [&order] { order.push_back(1); });
+    BOOST_REQUIRE_EQUAL(throttle.waiters(), 2);
+
+    close.get();
+    far_behind.get();
+    BOOST_REQUIRE_EQUAL(order.size(), 2);
+    BOOST_REQUIRE_EQUAL(order[0], 1);
+    BOOST_REQUIRE_EQUAL(order[1], 0);
+    throttle.shutdown();
+}
+
+SEASTAR_THREAD_TEST_CASE(throttle_does_not_starve_followers_far_behind) {
+    raft::recovery_throttle throttle(1000);
+    throttle.throttle(1000).get();
+
+    auto far_behind = throttle.throttle(100, 2048);
+    // the request waiting for the longest time eventually wins over new
+    // requests of followers close to the log end
+    std::vector<ss::future<>> close;
+    while (!far_behind.available()) {
+        close.push_back(throttle.throttle(100, 0));
+        ss::sleep(10ms).get();
+    }
+    far_behind.get();
+    throttle.shutdown();
+    for (auto& f : close) {
+        f.handle_exception([](const std::exception_ptr&) {}).get();
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(throttle_shutdown_breaks_waiters) {
+    raft::recovery_throttle throttle(1000);
+    throttle.throttle(1000).get();
+    auto f = throttle.throttle(1000);
+    throttle.shutdown();
+    BOOST_REQUIRE_THROW(f.get(), ss::broken_semaphore);
+    BOOST_REQUIRE_THROW(throttle.throttle(1).get(), ss::broken_semaphore);
+}
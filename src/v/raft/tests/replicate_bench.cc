@@ -0,0 +1,118 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "config/configuration.h"
+#include "raft/tests/raft_group_fixture.h"
+#include "units.h"
+#include "utils/hdr_hist.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <boost/range/irange.hpp>
+#include <fmt/format.h>
+
+// every iteration replicates this many single batch requests, spread evenly
+// over the groups, concurrently, with quorum acks
+static constexpr int requests_per_iteration = 256;
+
+/// Measures replication throughput and latency of `groups` raft groups of
+/// `nodes` members each. Append entries requests sent to followers are delayed
+/// by `delay_ms` and transmitted over links of `bandwidth` bytes per second
+/// (unlimited if 0), every log flush takes at least `flush_delay_ms`, with up
+/// to `window` outstanding requests per follower.
+template<
+  int groups,
+  int nodes,
+  int delay_ms,
+  size_t bandwidth,
+  int flush_delay_ms,
+  uint32_t window>
+struct replicate_bench {
+    replicate_bench() {
+        config::shard_local_cfg()
+          .raft_max_concurrent_append_requests_per_follower.set_value(window);
+        for (int i = 0; i < groups; ++i) {
+            auto& group = _groups.emplace_back(
+              std::make_unique<raft_group>(raft::group_id(i), nodes));
+            group->set_base_port(35000 + i * nodes);
+            group->set_simulation(node_simulation{
+              .append_entries_delay = std::chrono::milliseconds(delay_ms),
+              .link_bandwidth = bandwidth,
+              .flush_delay = std::chrono::milliseconds(flush_delay_ms)});
+            group->enable_all();
+        }
+    }
+
+    ~replicate_bench() {
+        fmt::print(
+          "{} groups x {} nodes, delay {}ms, bandwidth {}B/s, flush delay "
+          "{}ms, window {}: replicate p50: {}us p99: {}us p999: {}us\n",
+          groups,
+          nodes,
+          delay_ms,
+          bandwidth,
+          flush_delay_ms,
+          window,
+          _hist.get_value_at(50),
+          _hist.get_value_at(99),
+          _hist.get_value_at(99.9));
+    }
+
+    ss::future<size_t> run() {
+        std::vector<consensus_ptr> leaders;
+        leaders.reserve(_groups.size());
+        for (auto& group : _groups) {
+            auto leader_id = co_await group->wait_for_leader();
+            leaders.push_back(group->get_member(leader_id).consensus);
+        }
+
+        perf_tests::start_measuring_time();
+        co_await ss::parallel_for_each(
+          boost::irange(0, requests_per_iteration), [this, &leaders](int i) {
+              auto m = _hist.auto_measure();
+              return leaders[i % leaders.size()]
+                ->replicate(
+                  random_batch_reader(storage::test::record_batch_spec{
+                    .offset = model::offset(0),
+                    .allow_compression = false,
+                    .count = 1}),
+                  default_replicate_opts)
+                .discard_result()
+                .finally([m = std::move(m)] {});
+          });
+        perf_tests::stop_measuring_time();
+        co_return requests_per_iteration;
+    }
+
+    std::vector<std::unique_ptr<raft_group>> _groups;
+    hdr_hist _hist;
+};
+
+using no_delay_window_1 = replicate_bench<1, 3, 0, 0, 0, 1>;
+using no_delay_window_16 = replicate_bench<1, 3, 0, 0, 0, 16>;
+using delay_10ms_window_1 = replicate_bench<1, 3, 10, 0, 0, 1>;
+using delay_10ms_window_4 = replicate_bench<1, 3, 10, 0, 0, 4>;
+using delay_10ms_window_16 = replicate_bench<1, 3, 10, 0, 0, 16>;
+// many groups sharing the nodes
+using groups_16_delay_1ms = replicate_bench<16, 3, 1, 0, 0, 16>;
+// five replicas on slow disks
+using nodes_5_flush_delay_5ms = replicate_bench<1, 5, 1, 0, 5, 16>;
+// bandwidth limited links
+using groups_4_bandwidth_10MiB = replicate_bench<4, 3, 1, 10_MiB, 1, 16>;
+
+PERF_TEST_F(no_delay_window_1, replicate) { return run(); }
+PERF_TEST_F(no_delay_window_16, replicate) { return run(); }
+PERF_TEST_F(delay_10ms_window_1, replicate) { return run(); }
+PERF_TEST_F(delay_10ms_window_4, replicate) { return run(); }
+PERF_TEST_F(delay_10ms_window_16, replicate) { return run(); }
+PERF_TEST_F(groups_16_delay_1ms, replicate) { return run(); }
+PERF_TEST_F(nodes_5_flush_delay_5ms, replicate) { return run(); }
+PERF_TEST_F(groups_4_bandwidth_10MiB, replicate) { return run(); }
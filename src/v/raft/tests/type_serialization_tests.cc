@@ -8,6 +8,7 @@
 // by the Apache License, Version 2.0
 
 #include "compression/stream_zstd.h"
+#include "config/configuration.h"
 #include "model/metadata.h"
 #include "model/record.h"
 #include "model/record_batch_reader.h"
@@ -101,6 +102,188 @@ SEASTAR_THREAD_TEST_CASE(append_entries_requests) {
       .get0();
 }
 
+SEASTAR_THREAD_TEST_CASE(append_entries_requests_storage_encoding) {
+    config::shard_local_cfg().raft_append_entries_storage_encoding.set_value(
+      true);
+    auto batches = storage::test::make_random_batches(
+      model::offset(1), 10, true);
+
+    auto rdr = model::make_memory_record_batch_reader(std::move(batches));
+    auto readers = raft::details::share_n(std::move(rdr), 2).get0();
+    raft::append_entries_request req(
+      raft::vnode(model::node_id(1), model::revision_id(10)),
+      raft::vnode(model::node_id(10), model::revision_id(101)),
+      raft::protocol_metadata{.group = raft::group_id(1)},
+      std::move(readers.back()));
+    readers.pop_back();
+    auto d = async_serialize_roundtrip_rpc(std::move(req)).get0();
+    config::shard_local_cfg().raft_append_entries_storage_encoding.set_value(
+      false);
+
+    auto expected = model::consume_reader_to_memory(
+                      std::move(readers.back()), model::no_timeout)
+                      .get0();
+    auto result = model::consume_reader_to_memory(
+                    std::move(d.batches), model::no_timeout)
+                    .get0();
+    BOOST_REQUIRE_EQUAL(expected.size(), result.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(expected[i].header(), result[i].header());
+        BOOST_REQUIRE_EQUAL(expected[i].compressed(), result[i].compressed());
+        BOOST_REQUIRE(expected[i].data() == result[i].data());
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(append_entries_batch_request_roundtrip) {
+    std::vector<ss::circular_buffer<model::record_batch>> expected;
+    raft::append_entries_batch_request batch;
+    for (int i = 0; i < 3; ++i) {
+        auto batches = storage::test::make_random_batches(
+          model::offset(i * 10), 3, false);
+        auto rdr = model::make_memory_record_batch_reader(std::move(batches));
+        auto readers = raft::details::share_n(std::move(rdr), 2).get0();
+        expected.push_back(model::consume_reader_to_memory(
+                             std::move(readers.back()), model::no_timeout)
+                             .get0());
+        readers.pop_back();
+        batch.requests.emplace_back(
+          raft::vnode(model::node_id(1), model::revision_id(i)),
+          raft::vnode(model::node_id(2), model::revision_id(i)),
+          raft::protocol_metadata{
+            .group = raft::group_id(i),
+            .commit_index = model::offset(i),
+            .term = model::term_id(1),
+            .prev_log_index = model::offset(i * 10 - 1),
+            .prev_log_term = model::term_id(1),
+            .last_visible_index = model::offset(i)},
+          std::move(readers.back()));
+    }
+
+    auto d = async_serialize_roundtrip_rpc(std::move(batch)).get0();
+
+    BOOST_REQUIRE_EQUAL(d.requests.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        auto& req = d.requests[i];
+        BOOST_REQUIRE_EQUAL(req.meta.group, raft::group_id(i));
+        BOOST_REQUIRE_EQUAL(
+          req.target_node_id,
+          raft::vnode(model::node_id(2), model::revision_id(i)));
+        req.batches
+          .consume(checking_consumer(std::move(expected[i])), model::no_timeout)
+          .get0();
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(vote_batch_request_roundtrip) {
+    raft::vote_batch_request batch;
+    for (int i = 0; i < 3; ++i) {
+        batch.requests.push_back(raft::vote_request{
+          .node_id = raft::vnode(model::node_id(1), model::revision_id(i)),
+          .target_node_id = raft::vnode(
+            model::node_id(2), model::revision_id(i)),
+          .group = raft::group_id(i),
+          .term = model::term_id(i + 1),
+          .prev_log_index = model::offset(i * 10),
+          .prev_log_term = model::term_id(i),
+          .leadership_transfer = i % 2 == 0});
+    }
+
+    auto d = serialize_roundtrip_rpc(std::move(batch));
+
+    BOOST_REQUIRE_EQUAL(d.requests.size(), 3);
+    for (int i = 0; i < 3; ++i) {
+        auto& req = d.requests[i];
+        BOOST_REQUIRE_EQUAL(req.group, raft::group_id(i));
+        BOOST_REQUIRE_EQUAL(
+          req.target_node_id,
+          raft::vnode(model::node_id(2), model::revision_id(i)));
+        BOOST_REQUIRE_EQUAL(req.term, model::term_id(i + 1));
+        BOOST_REQUIRE_EQUAL(req.prev_log_index, model::offset(i * 10));
+        BOOST_REQUIRE_EQUAL(req.leadership_transfer, i % 2 == 0);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(fixed_block_messages_encoding) {
+    // fixed blocks must not change the encoding of the messages
+    raft::vote_request req{
+      .node_id = raft::vnode(model::node_id(1), model::revision_id(2)),
+      .target_node_id = raft::vnode(model::node_id(3), model::revision_id(4)),
+      .group = raft::group_id(5),
+      .term = model::term_id(6),
+      .prev_log_index = model::offset(7),
+      .prev_log_term = model::term_id(8),
+      .leadership_transfer = true};
+    iobuf expected;
+    reflection::serialize(
+      expected,
+      req.node_id.id(),
+      req.node_id.revision(),
+      req.target_node_id.id(),
+      req.target_node_id.revision(),
+      req.group,
+      req.term,
+      req.prev_log_index,
+      req.prev_log_term,
+      req.leadership_transfer);
+    BOOST_REQUIRE(reflection::to_iobuf(req) == expected);
+
+    raft::vote_reply vote_reply{
+      .target_node_id = raft::vnode(model::node_id(3), model::revision_id(4)),
+      .term = model::term_id(6),
+      .granted = true,
+      .log_ok = false};
+    expected.clear();
+    reflection::serialize(
+      expected,
+      vote_reply.target_node_id.id(),
+      vote_reply.target_node_id.revision(),
+      vote_reply.term,
+      vote_reply.granted,
+      vote_reply.log_ok);
+    BOOST_REQUIRE(reflection::to_iobuf(vote_reply) == expected);
+    auto vote_reply_d = serialize_roundtrip_rpc(raft::vote_reply(vote_reply));
+    BOOST_REQUIRE_EQUAL(vote_reply_d.target_node_id, vote_reply.target_node_id);
+    BOOST_REQUIRE_EQUAL(vote_reply_d.term, vote_reply.term);
+    BOOST_REQUIRE_EQUAL(vote_reply_d.granted, vote_reply.granted);
+    BOOST_REQUIRE_EQUAL(vote_reply_d.log_ok, vote_reply.log_ok);
+
+    raft::append_entries_reply reply{
+      .target_node_id = raft::vnode(model::node_id(1), model::revision_id(2)),
+      .node_id = raft::vnode(model::node_id(3), model::revision_id(4)),
+      .group = raft::group_id(5),
+      .term = model::term_id(6),
+      .last_committed_log_index = model::offset(7),
+      .last_dirty_log_index = model::offset(8),
+      .last_term_base_offset = model::offset(9),
+      .result = raft::append_entries_reply::status::group_unavailable};
+    expected.clear();
+    reflection::serialize(
+      expected,
+      reply.target_node_id.id(),
+      reply.target_node_id.revision(),
+      reply.node_id.id(),
+      reply.node_id.revision(),
+      reply.group,
+      reply.term,
+      reply.last_committed_log_index,
+      reply.last_dirty_log_index,
+      reply.last_term_base_offset,
+      reply.result);
+    BOOST_REQUIRE(reflection::to_iobuf(reply) == expected);
+    auto reply_d = serialize_roundtrip_rpc(raft::append_entries_reply(reply));
+    BOOST_REQUIRE_EQUAL(reply_d.target_node_id, reply.target_node_id);
+    BOOST_REQUIRE_EQUAL(reply_d.node_id, reply.node_id);
+    BOOST_REQUIRE_EQUAL(reply_d.group, reply.group);
+    BOOST_REQUIRE_EQUAL(reply_d.term, reply.term);
+    BOOST_REQUIRE_EQUAL(
+      reply_d.last_committed_log_index, reply.last_committed_log_index);
+    BOOST_REQUIRE_EQUAL(
+      reply_d.last_dirty_log_index, reply.last_dirty_log_index);
+    BOOST_REQUIRE_EQUAL(
+      reply_d.last_term_base_offset, reply.last_term_base_offset);
+    BOOST_REQUIRE(reply_d.result == reply.result);
+}
+
 model::broker create_test_broker() {
     return model::broker(
       model::node_id(random_generators::get_int(1000)), // id
@@ -257,6 +440,52 @@ SEASTAR_THREAD_TEST_CASE(heartbeat_response_roundtrip) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(heartbeat_quiescent_groups_roundtrip) {
+    // request carrying quiescent groups only
+    raft::heartbeat_request req{
+      .quiescent_groups
+      = {raft::group_id(7), raft::group_id(3), raft::group_id(12)},
+      .node_id = model::node_id(1),
+      .target_node_id = model::node_id(2)};
+    iobuf buf;
+    reflection::async_adl<raft::heartbeat_request>{}
+      .to(buf, std::move(req))
+      .get();
+    auto req_parser = iobuf_parser(std::move(buf));
+    auto res = reflection::async_adl<raft::heartbeat_request>{}
+                 .from(req_parser)
+                 .get0();
+    BOOST_REQUIRE(res.heartbeats.empty());
+    BOOST_REQUIRE_EQUAL(res.node_id, model::node_id(1));
+    BOOST_REQUIRE_EQUAL(res.target_node_id, model::node_id(2));
+    BOOST_REQUIRE(
+      res.quiescent_groups
+      == std::vector<raft::group_id>(
+        {raft::group_id(3), raft::group_id(7), raft::group_id(12)}));
+
+    raft::heartbeat_reply reply;
+    reply.rejected_quiescent_groups = {raft::group_id(12)};
+    reflection::async_adl<raft::heartbeat_reply>{}
+      .to(buf, std::move(reply))
+      .get();
+    auto reply_parser = iobuf_parser(std::move(buf));
+    auto reply_res = reflection::async_adl<raft::heartbeat_reply>{}
+                       .from(reply_parser)
+                       .get0();
+    BOOST_REQUIRE(reply_res.supports_quiescent_groups);
+    BOOST_REQUIRE(
+      reply_res.rejected_quiescent_groups
+      == std::vector<raft::group_id>({raft::group_id(12)}));
+
+    // reply sent by a node that does not know about quiescent groups
+    reflection::adl<uint32_t>{}.to(buf, 0);
+    auto old_parser = iobuf_parser(std::move(buf));
+    auto old_res = reflection::async_adl<raft::heartbeat_reply>{}
+                     .from(old_parser)
+                     .get0();
+    BOOST_REQUIRE(!old_res.supports_quiescent_groups);
+}
+
 SEASTAR_THREAD_TEST_CASE(snapshot_metadata_roundtrip) {
     auto n1 = tests::random_broker(0, 100);
     auto n2 = tests::random_broker(0, 100);
@@ -9,16 +9,20 @@
 
 #include "raft/types.h"
 
+#include "config/configuration.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
 #include "raft/consensus_utils.h"
 #include "raft/errc.h"
 #include "raft/group_configuration.h"
 #include "reflection/adl.h"
+#include "serde/fixed_block.h"
 #include "utils/to_string.h"
 #include "vassert.h"
 #include "vlog.h"
 
+#include <seastar/core/loop.hh>
+
 #include <fmt/ostream.h>
 
 #include <type_traits>
@@ -73,14 +77,15 @@ std::ostream& operator<<(std::ostream& o, const heartbeat_request& r) {
           << "node_id: " << m.node_id << ","
           << "target_node_id: " << m.target_node_id << ",";
     }
-    return o << "]}";
+    return o << "], quiescent_groups: " << r.quiescent_groups.size() << "}";
 }
 std::ostream& operator<<(std::ostream& o, const heartbeat_reply& r) {
     o << "{meta:[";
     for (auto& m : r.meta) {
         o << m << ",";
     }
-    return o << "]}";
+    return o << "], rejected_quiescent_groups: "
+             << r.rejected_quiescent_groups.size() << "}";
 }
 
 std::ostream& operator<<(std::ostream& o, const consistency_level& l) {
@@ -186,8 +191,15 @@ ss::future<> async_adl<raft::append_entries_request>::to(
       .then([&out, request = std::move(request)](
               ss::circular_buffer<model::record_batch> batches) {
           reflection::adl<uint32_t>{}.to(out, batches.size());
+          const bool storage_encoding
+            = config::shard_local_cfg().raft_append_entries_storage_encoding();
           for (auto& batch : batches) {
-              reflection::serialize(out, std::move(batch));
+              if (storage_encoding) {
+                  adl<model::record_batch>{}.to_storage_encoding(
+                    out, std::move(batch));
+              } else {
+                  reflection::serialize(out, std::move(batch));
+              }
           }
           reflection::serialize(
             out,
@@ -330,8 +342,64 @@ T read_one_varint_delta(iobuf_parser& in, const T& prev) {
     auto dst = varlong_reader<T>(in);
     return prev + dst;
 }
+
+/// Sorted group ids encoded as their count followed by varint deltas. Used for
+/// the parts of heartbeat messages appended after the fields known to older
+/// versions, which stop parsing before reaching them.
+void encode_group_list(iobuf& out, std::vector<raft::group_id> groups) {
+    std::sort(groups.begin(), groups.end());
+    adl<uint32_t>{}.to(out, groups.size());
+    encode_one_delta_array<raft::group_id>(out, groups);
+}
+
+std::vector<raft::group_id> decode_group_list(iobuf_parser& in) {
+    std::vector<raft::group_id> groups(adl<uint32_t>{}.from(in));
+    if (groups.empty()) {
+        return groups;
+    }
+    groups[0] = varlong_reader<raft::group_id>(in);
+    for (size_t i = 1; i < groups.size(); ++i) {
+        groups[i] = read_one_varint_delta<raft::group_id>(in, groups[i - 1]);
+    }
+    return groups;
+}
 } // namespace internal
 
+ss::future<> async_adl<raft::append_entries_batch_request>::to(
+  iobuf& out, raft::append_entries_batch_request&& request) {
+    adl<uint32_t>{}.to(out, request.requests.size());
+    return ss::do_with(
+      std::move(request.requests),
+      [&out](std::vector<raft::append_entries_request>& requests) {
+          return ss::do_for_each(
+            requests, [&out](raft::append_entries_request& r) {
+                return async_adl<raft::append_entries_request>{}.to(
+                  out, std::move(r));
+            });
+      });
+}
+
+ss::future<raft::append_entries_batch_request>
+async_adl<raft::append_entries_batch_request>::from(iobuf_parser& in) {
+    auto count = adl<uint32_t>{}.from(in);
+    raft::append_entries_batch_request batch;
+    batch.requests.reserve(count);
+    return ss::do_with(
+      std::move(batch),
+      [&in, count](raft::append_entries_batch_request& batch) {
+          return ss::do_until(
+                   [&batch, count] { return batch.requests.size() == count; },
+                   [&in, &batch] {
+                       return async_adl<raft::append_entries_request>{}
+                         .from(in)
+                         .then([&batch](raft::append_entries_request r) {
+                             batch.requests.push_back(std::move(r));
+                         });
+                   })
+            .then([&batch] { return std::move(batch); });
+      });
+}
+
 ss::future<> async_adl<raft::heartbeat_request>::to(
   iobuf& out, raft::heartbeat_request&& request) {
     struct sorter_fn {
@@ -343,6 +411,7 @@ ss::future<> async_adl<raft::heartbeat_request>::to(
     };
     std::sort(
       request.heartbeats.begin(), request.heartbeats.end(), sorter_fn{});
+    auto quiescent_groups = std::move(request.quiescent_groups);
     return ss::make_ready_future<>()
       .then([&out, request = std::move(request)] {
           internal::hbeat_soa encodee(request.heartbeats.size());
@@ -376,15 +445,21 @@ ss::future<> async_adl<raft::heartbeat_request>::to(
           // request.meta = {}; // release memory
 
           // physical node ids are the same for all requests
-          adl<model::node_id>{}.to(
-            out, request.heartbeats.front().node_id.id());
-          adl<model::node_id>{}.to(
-            out, request.heartbeats.front().target_node_id.id());
+          if (request.heartbeats.empty()) {
+              adl<model::node_id>{}.to(out, request.node_id);
+              adl<model::node_id>{}.to(out, request.target_node_id);
+          } else {
+              adl<model::node_id>{}.to(
+                out, request.heartbeats.front().node_id.id());
+              adl<model::node_id>{}.to(
+                out, request.heartbeats.front().target_node_id.id());
+          }
           adl<uint32_t>{}.to(out, size);
 
           return encodee;
       })
-      .then([&out](internal::hbeat_soa encodee) {
+      .then([&out, quiescent_groups = std::move(quiescent_groups)](
+              internal::hbeat_soa encodee) mutable {
           internal::encode_one_delta_array<raft::group_id>(out, encodee.groups);
           internal::encode_one_delta_array<model::offset>(
             out, encodee.commit_indices);
@@ -399,6 +474,7 @@ ss::future<> async_adl<raft::heartbeat_request>::to(
             out, encodee.revisions);
           internal::encode_one_delta_array<model::revision_id>(
             out, encodee.target_revisions);
+          internal::encode_group_list(out, std::move(quiescent_groups));
       });
 }
 
@@ -412,9 +488,14 @@ async_adl<raft::heartbeat_request>::from(iobuf_parser& in) {
     raft::heartbeat_request req;
     auto node_id = adl<model::node_id>{}.from(in);
     auto target_node = adl<model::node_id>{}.from(in);
+    req.node_id = node_id;
+    req.target_node_id = target_node;
     req.heartbeats = std::vector<raft::heartbeat_metadata>(
       adl<uint32_t>{}.from(in));
     if (req.heartbeats.empty()) {
+        if (in.bytes_left() > 0) {
+            req.quiescent_groups = internal::decode_group_list(in);
+        }
         return ss::make_ready_future<raft::heartbeat_request>(std::move(req));
     }
     const size_t max = req.heartbeats.size();
@@ -484,6 +565,10 @@ async_adl<raft::heartbeat_request>::from(iobuf_parser& in) {
         hb.target_node_id = raft::vnode(
           hb.target_node_id.id(), decode_signed(hb.target_node_id.revision()));
     }
+    // sent by versions supporting quiescent groups only
+    if (in.bytes_left() > 0) {
+        req.quiescent_groups = internal::decode_group_list(in);
+    }
     return ss::make_ready_future<raft::heartbeat_request>(std::move(req));
 }
 
@@ -499,6 +584,8 @@ ss::future<> async_adl<raft::heartbeat_reply>::to(
     adl<uint32_t>{}.to(out, reply.meta.size());
     // no requests
     if (reply.meta.empty()) {
+        internal::encode_group_list(
+          out, std::move(reply.rejected_quiescent_groups));
         return ss::make_ready_future<>();
     }
 
@@ -540,6 +627,8 @@ ss::future<> async_adl<raft::heartbeat_reply>::to(
     for (auto& m : reply.meta) {
         adl<raft::append_entries_reply::status>{}.to(out, m.result);
     }
+    internal::encode_group_list(
+      out, std::move(reply.rejected_quiescent_groups));
     return ss::make_ready_future<>();
 }
 
@@ -551,6 +640,10 @@ async_adl<raft::heartbeat_reply>::from(iobuf_parser& in) {
 
     // empty reply
     if (reply.meta.empty()) {
+        if (in.bytes_left() > 0) {
+            reply.rejected_quiescent_groups = internal::decode_group_list(in);
+            reply.supports_quiescent_groups = true;
+        }
         return ss::make_ready_future<raft::heartbeat_reply>(std::move(reply));
     }
 
@@ -622,6 +715,11 @@ async_adl<raft::heartbeat_reply>::from(iobuf_parser& in) {
         m.target_node_id = raft::vnode(
           m.target_node_id.id(), decode_signed(m.target_node_id.revision()));
     }
+    // sent by versions supporting quiescent groups only
+    if (in.bytes_left() > 0) {
+        reply.rejected_quiescent_groups = internal::decode_group_list(in);
+        reply.supports_quiescent_groups = true;
+    }
 
     return ss::make_ready_future<raft::heartbeat_reply>(std::move(reply));
 }
@@ -639,6 +737,102 @@ raft::snapshot_metadata adl<raft::snapshot_metadata>::from(iobuf_parser& in) {
       .cluster_time = cluster_time};
 }
 
+void adl<raft::vote_request>::to(iobuf& out, raft::vote_request r) {
+    serde::write_fixed_block(
+      out,
+      r.node_id.id(),
+      r.node_id.revision(),
+      r.target_node_id.id(),
+      r.target_node_id.revision(),
+      r.group,
+      r.term,
+      r.prev_log_index,
+      r.prev_log_term,
+      r.leadership_transfer);
+}
+
+raft::vote_request adl<raft::vote_request>::from(iobuf_parser& in) {
+    model::node_id node;
+    model::revision_id revision;
+    model::node_id target_node;
+    model::revision_id target_revision;
+    raft::vote_request r;
+    serde::read_fixed_block(
+      in,
+      node,
+      revision,
+      target_node,
+      target_revision,
+      r.group,
+      r.term,
+      r.prev_log_index,
+      r.prev_log_term,
+      r.leadership_transfer);
+    r.node_id = raft::vnode(node, revision);
+    r.target_node_id = raft::vnode(target_node, target_revision);
+    return r;
+}
+
+void adl<raft::vote_reply>::to(iobuf& out, raft::vote_reply r) {
+    serde::write_fixed_block(
+      out,
+      r.target_node_id.id(),
+      r.target_node_id.revision(),
+      r.term,
+      r.granted,
+      r.log_ok);
+}
+
+raft::vote_reply adl<raft::vote_reply>::from(iobuf_parser& in) {
+    model::node_id target_node;
+    model::revision_id target_revision;
+    raft::vote_reply r;
+    serde::read_fixed_block(
+      in, target_node, target_revision, r.term, r.granted, r.log_ok);
+    r.target_node_id = raft::vnode(target_node, target_revision);
+    return r;
+}
+
+void adl<raft::append_entries_reply>::to(
+  iobuf& out, raft::append_entries_reply r) {
+    serde::write_fixed_block(
+      out,
+      r.target_node_id.id(),
+      r.target_node_id.revision(),
+      r.node_id.id(),
+      r.node_id.revision(),
+      r.group,
+      r.term,
+      r.last_committed_log_index,
+      r.last_dirty_log_index,
+      r.last_term_base_offset,
+      r.result);
+}
+
+raft::append_entries_reply
+adl<raft::append_entries_reply>::from(iobuf_parser& in) {
+    model::node_id target_node;
+    model::revision_id target_revision;
+    model::node_id node;
+    model::revision_id revision;
+    raft::append_entries_reply r;
+    serde::read_fixed_block(
+      in,
+      target_node,
+      target_revision,
+      node,
+      revision,
+      r.group,
+      r.term,
+      r.last_committed_log_index,
+      r.last_dirty_log_index,
+      r.last_term_base_offset,
+      r.result);
+    r.target_node_id = raft::vnode(target_node, target_revision);
+    r.node_id = raft::vnode(node, revision);
+    return r;
+}
+
 void adl<raft::snapshot_metadata>::to(
   iobuf& out, raft::snapshot_metadata&& request) {
     reflection::serialize(
@@ -35,6 +35,7 @@
 
 #include <cstdint>
 #include <exception>
+#include <optional>
 
 namespace raft {
 using clock_type = ss::lowres_clock;
@@ -51,6 +52,8 @@ struct protocol_metadata {
     model::offset prev_log_index;
     model::term_id prev_log_term;
     model::offset last_visible_index;
+
+    bool operator==(const protocol_metadata&) const = default;
 };
 
 // The sequence used to track the order of follower append entries request
@@ -130,6 +133,34 @@ struct follower_index_metadata {
 
     follower_req_seq last_sent_seq{0};
     follower_req_seq last_received_seq{0};
+    /**
+     * Sequence of the oldest pipelined append entries request that failed
+     * (was not delivered or timed out on the follower) and for which no newer
+     * reply has been received yet. The requests dispatched after it are
+     * already in flight and will most likely be rejected by the follower as
+     * they do not match its log, the leader stops dispatching more requests
+     * to the follower until a newer reply (i.e. heartbeat) tells it what the
+     * follower state is.
+     */
+    std::optional<follower_req_seq> last_failed_seq;
+    /**
+     * Leader protocol metadata carried by the last heartbeat the follower
+     * acknowledged while being in sync with the leader log. As long as the
+     * leader metadata stays the same there is nothing new to tell the
+     * follower and the group is covered by a lightweight heartbeat that only
+     * refreshes the follower election timer.
+     */
+    std::optional<protocol_metadata> quiescent_meta;
+    /**
+     * Leader lease bookkeeping. The oldest request dispatched after the last
+     * acknowledged one is remembered with its send time. A successful reply
+     * to that request or to any later one proves that the follower heard from
+     * the leader after that time and will not grant its vote to other
+     * candidates for an election timeout.
+     */
+    std::optional<std::pair<follower_req_seq, clock_type::time_point>>
+      lease_probe;
+    clock_type::time_point lease_acked_at = clock_type::time_point::min();
     bool is_learner = true;
     bool is_recovering = false;
 
@@ -261,9 +292,33 @@ struct heartbeat_metadata {
 /// log at some offset
 struct heartbeat_request {
     std::vector<heartbeat_metadata> heartbeats;
+    /// groups led by the source node whose state did not change since the
+    /// target node acknowledged their last heartbeat, only the follower
+    /// election timers are refreshed for them
+    std::vector<group_id> quiescent_groups;
+    /// physical source and target nodes, required when the request carries
+    /// quiescent groups only
+    model::node_id node_id;
+    model::node_id target_node_id;
 };
 struct heartbeat_reply {
     std::vector<append_entries_reply> meta;
+    /// quiescent groups for which the source node of the request is not the
+    /// known leader, their next heartbeat must carry full metadata
+    std::vector<group_id> rejected_quiescent_groups;
+    /// set when the replying node understands quiescent groups, nodes running
+    /// older versions do not send this part of the reply
+    bool supports_quiescent_groups = false;
+};
+
+/// \brief append entries requests of many raft groups sent to the same node in
+/// a single RPC, the receiving side dispatches them to their groups and
+/// responds with one reply per request, in the request order
+struct append_entries_batch_request {
+    std::vector<append_entries_request> requests;
+};
+struct append_entries_batch_reply {
+    std::vector<append_entries_reply> replies;
 };
 
 struct vote_request {
@@ -298,6 +353,16 @@ struct vote_reply {
     bool log_ok = false;
 };
 
+/// \brief vote requests of many raft groups sent to the same node in a single
+/// RPC, the receiving side responds with one reply per request, in the request
+/// order
+struct vote_batch_request {
+    std::vector<vote_request> requests;
+};
+struct vote_batch_reply {
+    std::vector<vote_reply> replies;
+};
+
 /// This structure is used by consensus to notify other systems about group
 /// leadership changes.
 struct leadership_status {
@@ -441,6 +506,15 @@ struct write_snapshot_cfg {
     should_prefix_truncate should_truncate;
 };
 
+/// content of the latest snapshot of a raft group, read back by the state
+/// machine built on top of the group to restore its state
+struct snapshot_data {
+    // last offset included in the snapshot
+    model::offset last_included_index;
+    // snapshot content, as passed to write_snapshot
+    iobuf data;
+};
+
 struct timeout_now_request {
     // node id to validate on receiver
     vnode target_node_id;
@@ -542,6 +616,11 @@ struct adl<raft::protocol_metadata> {
     raft::protocol_metadata from(iobuf_parser& in);
 };
 template<>
+struct async_adl<raft::append_entries_batch_request> {
+    ss::future<> to(iobuf& out, raft::append_entries_batch_request&& request);
+    ss::future<raft::append_entries_batch_request> from(iobuf_parser& in);
+};
+template<>
 struct async_adl<raft::heartbeat_request> {
     ss::future<> to(iobuf& out, raft::heartbeat_request&& request);
     ss::future<raft::heartbeat_request> from(iobuf_parser& in);
@@ -553,6 +632,27 @@ struct async_adl<raft::heartbeat_reply> {
     ss::future<raft::heartbeat_reply> from(iobuf_parser& in);
 };
 
+/// The fixed size messages exchanged by every raft group are written as a
+/// single block laid out at compile time, their encoding is the one of the
+/// generic aggregate serialization.
+template<>
+struct adl<raft::vote_request> {
+    void to(iobuf& out, raft::vote_request r);
+    raft::vote_request from(iobuf_parser& in);
+};
+
+template<>
+struct adl<raft::vote_reply> {
+    void to(iobuf& out, raft::vote_reply r);
+    raft::vote_reply from(iobuf_parser& in);
+};
+
+template<>
+struct adl<raft::append_entries_reply> {
+    void to(iobuf& out, raft::append_entries_reply r);
+    raft::append_entries_reply from(iobuf_parser& in);
+};
+
 template<>
 struct adl<raft::snapshot_metadata> {
     void to(iobuf& out, raft::snapshot_metadata&& request);
@@ -15,6 +15,7 @@
 #include "cluster/controller.h"
 #include "cluster/controller_api.h"
 #include "cluster/errc.h"
+#include "cluster/health_manager.h"
 #include "cluster/fwd.h"
 #include "cluster/members_frontend.h"
 #include "cluster/metadata_cache.h"
@@ -26,24 +27,34 @@
 #include "config/configuration.h"
 #include "config/endpoint_tls_config.h"
 #include "finjector/hbadger.h"
+#include "kafka/server/offset_translator.h"
 #include "model/metadata.h"
 #include "model/namespace.h"
 #include "raft/types.h"
 #include "redpanda/admin/api-doc/broker.json.h"
+#include "redpanda/admin/api-doc/cluster.json.h"
 #include "redpanda/admin/api-doc/config.json.h"
+#include "redpanda/admin/api-doc/debug.json.h"
 #include "redpanda/admin/api-doc/hbadger.json.h"
 #include "redpanda/admin/api-doc/partition.json.h"
 #include "redpanda/admin/api-doc/raft.json.h"
 #include "redpanda/admin/api-doc/security.json.h"
 #include "redpanda/admin/api-doc/status.json.h"
+#include "resource_mgmt/io_priority.h"
 #include "rpc/dns.h"
 #include "security/scram_algorithm.h"
 #include "security/scram_authenticator.h"
+#include "ssx/future-util.h"
+#include "syschecks/self_test.h"
+#include "utils/base64.h"
 #include "vlog.h"
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics_api.hh>
 #include <seastar/core/prometheus.hh>
+#include <seastar/core/reactor.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/core/with_scheduling_group.hh>
 #include <seastar/http/api_docs.hh>
@@ -61,6 +72,8 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <map>
+#include <numeric>
 #include <stdexcept>
 #include <system_error>
 #include <unordered_map>
@@ -122,6 +135,10 @@ void admin_server::configure_admin_routes() {
     rb->register_api_file(_server._routes, "hbadger");
     rb->register_function(_server._routes, insert_comma);
     rb->register_api_file(_server._routes, "broker");
+    rb->register_function(_server._routes, insert_comma);
+    rb->register_api_file(_server._routes, "cluster");
+    rb->register_function(_server._routes, insert_comma);
+    rb->register_api_file(_server._routes, "debug");
 
     register_config_routes();
     register_raft_routes();
@@ -131,6 +148,8 @@ void admin_server::configure_admin_routes() {
     register_broker_routes();
     register_partition_routes();
     register_hbadger_routes();
+    register_cluster_routes();
+    register_debug_routes();
 }
 
 void admin_server::configure_dashboard() {
@@ -239,6 +258,9 @@ void throw_on_error(
               id));
         case cluster::errc::update_in_progress:
         case cluster::errc::waiting_for_recovery:
+        case cluster::errc::no_leader_controller:
+        case cluster::errc::not_leader_controller:
+        case cluster::errc::timeout:
             throw ss::httpd::base_exception(
               fmt::format("Not ready ({})", ec.message()),
               ss::httpd::reply::status_type::service_unavailable);
@@ -346,6 +368,39 @@ void admin_server::register_config_routes() {
 
           return ss::json::json_return_type(ss::json::json_void());
       });
+
+    ss::httpd::config_json::set_config_property.set(
+      _server._routes,
+      [](std::unique_ptr<ss::httpd::request> req)
+        -> ss::future<ss::json::json_return_type> {
+          auto name = req->param["name"];
+          auto value = req->get_query_param("value");
+          config::base_property* property = nullptr;
+          try {
+              property = &config::shard_local_cfg().get(name);
+          } catch (const std::out_of_range&) {
+              throw ss::httpd::bad_param_exception(
+                fmt::format("Unknown property {{{}}}", name));
+          }
+          // validated once before being set so that a bad value is not set
+          // on any shard
+          try {
+              if (auto err = property->validate(YAML::Load(value)); err) {
+                  throw ss::httpd::bad_param_exception(fmt::format(
+                    "Invalid value for {{{}}}: {}",
+                    name,
+                    err->error_message()));
+              }
+          } catch (const YAML::Exception& e) {
+              throw ss::httpd::bad_param_exception(fmt::format(
+                "Invalid value for {{{}}}: {}", name, e.what()));
+          }
+          vlog(logger.info, "Setting property {{{}}} to {}", name, value);
+          co_await ss::smp::invoke_on_all([name, value] {
+              config::shard_local_cfg().get(name).set_value(YAML::Load(value));
+          });
+          co_return ss::json::json_return_type(ss::json::json_void());
+      });
 }
 
 void admin_server::register_raft_routes() {
@@ -408,7 +463,7 @@ void admin_server::register_raft_routes() {
 }
 
 // TODO: factor out generic serialization from seastar http exceptions
-static security::scram_credential
+static ss::future<security::scram_credential>
 parse_scram_credential(const rapidjson::Document& doc) {
     if (!doc.IsObject()) {
         throw ss::httpd::bad_request_exception(fmt::format("Not an object"));
@@ -425,24 +480,21 @@ parse_scram_credential(const rapidjson::Document& doc) {
         throw ss::httpd::bad_request_exception(
           fmt::format("String password smissing"));
     }
-    const auto password = doc["password"].GetString();
-
-    security::scram_credential credential;
+    ss::sstring password(
+      doc["password"].GetString(), doc["password"].GetStringLength());
 
     if (algorithm == security::scram_sha256_authenticator::name) {
-        credential = security::scram_sha256::make_credentials(
-          password, security::scram_sha256::min_iterations);
+        return security::scram_sha256::make_credentials_async(
+          std::move(password), security::scram_sha256::min_iterations);
 
     } else if (algorithm == security::scram_sha512_authenticator::name) {
-        credential = security::scram_sha512::make_credentials(
-          password, security::scram_sha512::min_iterations);
+        return security::scram_sha512::make_credentials_async(
+          std::move(password), security::scram_sha512::min_iterations);
 
     } else {
         throw ss::httpd::bad_request_exception(
           fmt::format("Unknown scram algorithm: {}", algorithm));
     }
-
-    return credential;
 }
 
 void admin_server::register_security_routes() {
@@ -451,19 +503,22 @@ void admin_server::register_security_routes() {
           rapidjson::Document doc;
           doc.Parse(req->content.data());
 
-          auto credential = parse_scram_credential(doc);
-
-          if (!doc.HasMember("username") || !doc["username"].IsString()) {
+          if (
+            doc.IsObject()
+            && (!doc.HasMember("username") || !doc["username"].IsString())) {
               throw ss::httpd::bad_request_exception(
                 fmt::format("String username missing"));
           }
 
+          auto make_credential = parse_scram_credential(doc);
           auto username = security::credential_user(
             doc["username"].GetString());
 
-          return _controller->get_security_frontend()
-            .local()
-            .create_user(username, credential, model::timeout_clock::now() + 5s)
+          return std::move(make_credential)
+            .then([this, username](security::scram_credential credential) {
+                return _controller->get_security_frontend().local().create_user(
+                  username, credential, model::timeout_clock::now() + 5s);
+            })
             .then([](std::error_code err) {
                 vlog(logger.debug, "Creating user {}:{}", err, err.message());
                 if (err) {
@@ -500,11 +555,11 @@ void admin_server::register_security_routes() {
           rapidjson::Document doc;
           doc.Parse(req->content.data());
 
-          auto credential = parse_scram_credential(doc);
-
-          return _controller->get_security_frontend()
-            .local()
-            .update_user(user, credential, model::timeout_clock::now() + 5s)
+          return parse_scram_credential(doc)
+            .then([this, user](security::scram_credential credential) {
+                return _controller->get_security_frontend().local().update_user(
+                  user, credential, model::timeout_clock::now() + 5s);
+            })
             .then([](std::error_code err) {
                 vlog(logger.debug, "Updating user {}:{}", err, err.message());
                 if (err) {
@@ -969,6 +1024,102 @@ void admin_server::register_partition_routes() {
 
           co_return ss::json::json_void();
       });
+
+    /*
+     * Latest record of a key of a compacted partition, read on the leader
+     * or a follower up to the offset visible to consumers. The key, like the
+     * value of the response, is base64 encoded.
+     */
+    ss::httpd::partition_json::get_partition_key.set(
+      _server._routes,
+      [this](std::unique_ptr<ss::httpd::request> req)
+        -> ss::future<ss::json::json_return_type> {
+          auto ns = model::ns(req->param["namespace"]);
+          auto topic = model::topic(req->param["topic"]);
+
+          model::partition_id partition;
+          try {
+              partition = model::partition_id(
+                std::stoi(req->param["partition"]));
+          } catch (...) {
+              throw ss::httpd::bad_param_exception(fmt::format(
+                "Partition id must be an integer: {}",
+                req->param["partition"]));
+          }
+
+          if (partition() < 0) {
+              throw ss::httpd::bad_param_exception(
+                fmt::format("Invalid partition id {}", partition));
+          }
+
+          bytes key;
+          try {
+              key = base64_to_bytes(req->get_query_param("key"));
+          } catch (const base64_decoder_exception&) {
+              throw ss::httpd::bad_param_exception(
+                "Key must be base64 encoded");
+          }
+          if (key.empty()) {
+              throw ss::httpd::bad_param_exception("Missing key");
+          }
+
+          model::ntp ntp(std::move(ns), std::move(topic), partition);
+          auto shard = _shard_table.local().shard_for(ntp);
+          if (!shard) {
+              throw ss::httpd::not_found_exception(
+                fmt::format("Could not find ntp: {}", ntp));
+          }
+
+          struct record {
+              model::offset offset;
+              model::timestamp timestamp;
+              std::optional<ss::sstring> value;
+          };
+          auto r = co_await _partition_manager.invoke_on(
+            *shard,
+            [ntp = std::move(ntp), key = std::move(key)](
+              cluster::partition_manager& pm) mutable
+            -> ss::future<std::optional<record>> {
+                auto partition = pm.get(ntp);
+                if (!partition) {
+                    throw ss::httpd::not_found_exception(
+                      fmt::format("Could not find ntp: {}", ntp));
+                }
+                if (!partition->get_ntp_config().is_compacted()) {
+                    throw ss::httpd::bad_request_exception(
+                      fmt::format("Partition {} is not compacted", ntp));
+                }
+                return partition
+                  ->key_query(std::move(key), kafka_read_priority())
+                  .then(
+                    [partition](std::optional<storage::key_query_result> res)
+                      -> std::optional<record> {
+                        if (!res) {
+                            return std::nullopt;
+                        }
+                        kafka::offset_translator translator(
+                          partition->get_cfg_manager());
+                        record rec{
+                          .offset = translator.to_kafka_offset(res->offset),
+                          .timestamp = res->time};
+                        if (res->value) {
+                            rec.value = iobuf_to_base64(*res->value);
+                        }
+                        return rec;
+                    });
+            });
+
+          if (!r) {
+              throw ss::httpd::not_found_exception("Key not found");
+          }
+          ss::httpd::partition_json::key_value kv;
+          kv.offset = r->offset();
+          kv.timestamp = r->timestamp();
+          if (r->value) {
+              kv.value = std::move(*r->value);
+          }
+          co_return kv;
+      });
 }
 
 void admin_server::register_hbadger_routes() {
@@ -1067,3 +1218,247 @@ void admin_server::register_hbadger_routes() {
               [] { return ss::json::json_return_type(ss::json::json_void()); });
       });
 }
+
+ss::httpd::cluster_json::partition_ref
+make_partition_ref(const model::ntp& ntp) {
+    ss::httpd::cluster_json::partition_ref p;
+    p.ns = ntp.ns;
+    p.topic = ntp.tp.topic;
+    p.partition_id = ntp.tp.partition;
+    return p;
+}
+
+void admin_server::register_cluster_routes() {
+    ss::httpd::cluster_json::get_cluster_health_overview.set(
+      _server._routes, [this](std::unique_ptr<ss::httpd::request>) {
+          return _controller->get_health_manager()
+            .invoke_on(
+              cluster::health_manager::shard,
+              [](cluster::health_manager& hm) {
+                  return hm.get_cluster_health_overview(
+                    model::timeout_clock::now() + 5s);
+              })
+            .then([](cluster::cluster_health_overview_reply overview) {
+                throw_on_error(make_error_code(overview.error));
+
+                ss::httpd::cluster_json::cluster_health_overview ret;
+                ret.is_healthy = overview.is_healthy();
+                ret.controller_id = overview.controller_id;
+                ret.age_ms = overview.age_ms;
+                for (const auto& n : overview.nodes) {
+                    ss::httpd::cluster_json::node_health h;
+                    h.node_id = n.id;
+                    h.is_alive = n.is_alive;
+                    h.leaders = n.leaders;
+                    h.disk_total_bytes = n.disk.total_bytes;
+                    h.disk_free_bytes = n.disk.free_bytes;
+                    ret.nodes.push(h);
+                }
+                ret.leaderless_count = overview.leaderless_count;
+                for (const auto& ntp : overview.leaderless_partitions) {
+                    ret.leaderless_partitions.push(make_partition_ref(ntp));
+                }
+                ret.under_replicated_count = overview.under_replicated_count;
+                for (const auto& ntp : overview.under_replicated_partitions) {
+                    ret.under_replicated_partitions.push(
+                      make_partition_ref(ntp));
+                }
+                return ss::make_ready_future<ss::json::json_return_type>(
+                  std::move(ret));
+            });
+      });
+}
+
+namespace {
+
+struct scheduling_group_stats {
+    double shares{0};
+    double runtime_ms{0};
+    double tasks_processed{0};
+    double queue_length{0};
+};
+
+using scheduler_stats = std::map<ss::sstring, scheduling_group_stats>;
+
+/// Stats of the scheduling groups of the current shard, from the metrics that
+/// seastar registers for each of them.
+scheduler_stats local_scheduler_stats() {
+    scheduler_stats stats;
+    const auto& values = ss::metrics::impl::get_value_map();
+    auto read = [&values, &stats](
+                  const char* metric, double scheduling_group_stats::*field) {
+        auto it = values.find(metric);
+        if (it == values.end()) {
+            return;
+        }
+        for (const auto& [labels, m] : it->second) {
+            auto group = labels.find("group");
+            if (group == labels.end() || !m) {
+                continue;
+            }
+            stats[group->second].*field = m->get_function()().d();
+        }
+    };
+    read("scheduler_shares", &scheduling_group_stats::shares);
+    read("scheduler_runtime_ms", &scheduling_group_stats::runtime_ms);
+    read("scheduler_tasks_processed", &scheduling_group_stats::tasks_processed);
+    read("scheduler_queue_length", &scheduling_group_stats::queue_length);
+    return stats;
+}
+
+ss::httpd::debug_json::shard_scheduler_stats
+to_json(ss::shard_id shard, const scheduler_stats& stats) {
+    ss::httpd::debug_json::shard_scheduler_stats ret;
+    ret.shard = shard;
+    for (const auto& [name, s] : stats) {
+        ss::httpd::debug_json::scheduling_group_stats g;
+        g.name = name;
+        g.shares = s.shares;
+        g.runtime_ms = s.runtime_ms;
+        g.tasks_processed = s.tasks_processed;
+        g.queue_length = s.queue_length;
+        ret.groups.push(g);
+    }
+    return ret;
+}
+
+/// Runtime and tasks over the window, shares and queue length at its end.
+scheduler_stats
+stats_delta(const scheduler_stats& begin, scheduler_stats end) {
+    for (auto& [name, s] : end) {
+        if (auto it = begin.find(name); it != begin.end()) {
+            s.runtime_ms -= it->second.runtime_ms;
+            s.tasks_processed -= it->second.tasks_processed;
+        }
+    }
+    return end;
+}
+
+/// shards selected by the optional "shard" query parameter
+std::vector<ss::shard_id> parse_shards(const ss::httpd::request& req) {
+    auto param = req.get_query_param("shard");
+    if (param.empty()) {
+        std::vector<ss::shard_id> shards(ss::smp::count);
+        std::iota(shards.begin(), shards.end(), 0);
+        return shards;
+    }
+    try {
+        auto shard = boost::lexical_cast<ss::shard_id>(param);
+        if (shard < ss::smp::count) {
+            return {shard};
+        }
+    } catch (const boost::bad_lexical_cast&) {
+    }
+    throw ss::httpd::bad_param_exception(fmt::format(
+      "shard: {}, must be an integer below {}", param, ss::smp::count));
+}
+
+std::chrono::milliseconds
+parse_ms(const ss::httpd::request& req, const char* name) {
+    auto param = req.get_query_param(name);
+    try {
+        return std::chrono::milliseconds(
+          boost::lexical_cast<uint32_t>(param));
+    } catch (const boost::bad_lexical_cast&) {
+        throw ss::httpd::bad_param_exception(
+          fmt::format("{}: {}, must be a positive integer", name, param));
+    }
+}
+
+/// Whether a sample is running on this shard, samples do not overlap so that
+/// the stall threshold they lower is restored.
+thread_local bool sampling_scheduler{false};
+
+constexpr auto max_sample_duration = 60s;
+
+ss::future<scheduler_stats> sample_local_scheduler(
+  std::chrono::milliseconds duration,
+  std::optional<std::chrono::milliseconds> stall_threshold) {
+    if (sampling_scheduler) {
+        throw ss::httpd::bad_request_exception(fmt::format(
+          "A scheduler sample is already running on shard {}",
+          ss::this_shard_id()));
+    }
+    sampling_scheduler = true;
+    const auto prev_threshold = ss::engine().get_blocked_reactor_notify_ms();
+    if (stall_threshold) {
+        ss::engine().update_blocked_reactor_notify_ms(*stall_threshold);
+    }
+    auto begin = local_scheduler_stats();
+    co_await ss::sleep(duration);
+    auto end = local_scheduler_stats();
+    if (stall_threshold) {
+        ss::engine().update_blocked_reactor_notify_ms(prev_threshold);
+    }
+    sampling_scheduler = false;
+    co_return stats_delta(begin, std::move(end));
+}
+
+} // namespace
+
+void admin_server::register_debug_routes() {
+    ss::httpd::debug_json::get_scheduler_stats.set(
+      _server._routes,
+      [](std::unique_ptr<ss::httpd::request> req)
+        -> ss::future<ss::json::json_return_type> {
+          std::vector<ss::httpd::debug_json::shard_scheduler_stats> res;
+          for (auto shard : parse_shards(*req)) {
+              auto stats = co_await ss::smp::submit_to(
+                shard, [] { return local_scheduler_stats(); });
+              res.push_back(to_json(shard, stats));
+          }
+          co_return ss::json::json_return_type(std::move(res));
+      });
+
+    ss::httpd::debug_json::sample_scheduler_stats.set(
+      _server._routes,
+      [](std::unique_ptr<ss::httpd::request> req)
+        -> ss::future<ss::json::json_return_type> {
+          const auto shards = parse_shards(*req);
+          const auto duration = parse_ms(*req, "duration_ms");
+          if (duration > max_sample_duration) {
+              throw ss::httpd::bad_param_exception(fmt::format(
+                "duration_ms: {}, must be at most {}",
+                duration.count(),
+                max_sample_duration.count() * 1000));
+          }
+          std::optional<std::chrono::milliseconds> stall_threshold;
+          if (!req->get_query_param("stall_threshold_ms").empty()) {
+              stall_threshold = parse_ms(*req, "stall_threshold_ms");
+              if (*stall_threshold == 0ms) {
+                  throw ss::httpd::bad_param_exception(
+                    "stall_threshold_ms: must be positive");
+              }
+          }
+          // all the shards are sampled over the same window
+          auto samples = co_await ssx::parallel_transform(
+            shards, [duration, stall_threshold](ss::shard_id shard) {
+                return ss::smp::submit_to(shard, [duration, stall_threshold] {
+                    return sample_local_scheduler(duration, stall_threshold);
+                });
+            });
+          std::vector<ss::httpd::debug_json::shard_scheduler_stats> res;
+          for (size_t i = 0; i < shards.size(); ++i) {
+              res.push_back(to_json(shards[i], samples[i]));
+          }
+          co_return ss::json::json_return_type(std::move(res));
+      });
+
+    ss::httpd::debug_json::get_self_test_results.set(
+      _server._routes, [](ss::const_req) {
+          const auto& results = syschecks::local_self_test_results();
+          if (!results) {
+              throw ss::httpd::not_found_exception(
+                "The startup self test did not run, see startup_self_test");
+          }
+          ss::httpd::debug_json::self_test_results res;
+          res.write_fsync_p50_us = results->write_fsync_p50.count();
+          res.write_fsync_p99_us = results->write_fsync_p99.count();
+          res.write_bytes_per_sec = results->write_bytes_per_sec;
+          res.read_bytes_per_sec = results->read_bytes_per_sec;
+          for (auto bw : results->memory_bytes_per_sec) {
+              res.memory_bytes_per_sec.push(bw);
+          }
+          return ss::json::json_return_type(res);
+      });
+}
@@ -11,6 +11,7 @@
 
 #include "archival/ntp_archiver_service.h"
 #include "archival/service.h"
+#include "bytes/details/io_fragment_pool.h"
 #include "cluster/cluster_utils.h"
 #include "cluster/controller.h"
 #include "cluster/fwd.h"
@@ -25,6 +26,7 @@
 #include "cluster/topics_frontend.h"
 #include "cluster/tx_gateway.h"
 #include "cluster/tx_gateway_frontend.h"
+#include "compression/async_compressor.h"
 #include "config/configuration.h"
 #include "config/endpoint_tls_config.h"
 #include "config/seed_server.h"
@@ -46,12 +48,16 @@
 #include "raft/recovery_throttle.h"
 #include "raft/service.h"
 #include "redpanda/admin_server.h"
+#include "resource_mgmt/foreground_latency.h"
 #include "resource_mgmt/io_priority.h"
+#include "resource_mgmt/memory_groups.h"
 #include "rpc/server.h"
 #include "rpc/simple_protocol.h"
 #include "storage/chunk_cache.h"
+#include "storage/background_io_controller.h"
 #include "storage/compaction_controller.h"
 #include "storage/directories.h"
+#include "syschecks/self_test.h"
 #include "syschecks/syschecks.h"
 #include "test_utils/logs.h"
 #include "utils/file_io.h"
@@ -64,6 +70,7 @@
 #include <seastar/core/prometheus.hh>
 #include <seastar/core/smp.hh>
 #include <seastar/core/thread.hh>
+#include <seastar/core/when_all.hh>
 #include <seastar/json/json_elements.hh>
 #include <seastar/net/tls.hh>
 #include <seastar/util/conversions.hh>
@@ -183,10 +190,14 @@ int application::run(int ac, char** av) {
                     }
                 });
                 // must initialize configuration before services
+                _startup_profile.phase("configuration");
                 hydrate_config(cfg);
+                _startup_profile.phase("initialize");
                 initialize();
+                _startup_profile.phase("check_environment");
                 check_environment();
                 setup_metrics();
+                _startup_profile.phase("wire_up_services");
                 wire_up_services();
                 configure_admin_server();
                 start();
@@ -237,6 +248,10 @@ void application::initialize(
     }
 
     _scheduling_groups.create_groups().get();
+    _scheduling_groups
+      .create_tenant_groups(
+        config::shard_local_cfg().kafka_tenant_scheduling_groups())
+      .get();
     _deferred.emplace_back(
       [this] { _scheduling_groups.destroy_groups().get(); });
 
@@ -334,6 +349,7 @@ void application::hydrate_config(const po::variables_map& cfg) {
             config::shard_local_cfg().read_yaml(config);
         }).get0();
         config::shard_local_cfg().for_each(config_printer("redpanda"));
+        memory_groups::validate();
     }
     if (config["pandaproxy"]) {
         _proxy_config.emplace(config["pandaproxy"]);
@@ -360,6 +376,29 @@ void application::hydrate_config(const po::variables_map& cfg) {
     }
 }
 
+/// Raises the default flush coalescing window on disks whose fsyncs take
+/// more than a millisecond, by up to half of the fsync latency: waiting that
+/// long to share a flush costs less than issuing one more.
+static void tune_from_self_test(const syschecks::self_test_results& r) {
+    using namespace std::chrono_literals;
+    auto& window = config::shard_local_cfg().segment_flush_coalesce_window_ms;
+    if (window.is_overriden() || r.write_fsync_p50 <= 1ms) {
+        return;
+    }
+    auto tuned = std::min<std::chrono::milliseconds>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+        r.write_fsync_p50 / 2),
+      5ms);
+    vlog(
+      syschecks::checklog.info,
+      "Tuned segment_flush_coalesce_window_ms to {}ms for fsyncs of {}us",
+      tuned.count(),
+      r.write_fsync_p50.count());
+    ss::smp::invoke_on_all([tuned] {
+        config::shard_local_cfg().segment_flush_coalesce_window_ms(tuned);
+    }).get();
+}
+
 void application::check_environment() {
     syschecks::systemd_message("checking environment (CPU, Mem)").get();
     syschecks::cpu();
@@ -369,6 +408,24 @@ void application::check_environment() {
           config::shard_local_cfg().data_directory().as_sstring())
           .get();
     }
+    const auto& cfg = config::shard_local_cfg();
+    if (_redpanda_enabled && cfg.startup_self_test()) {
+        syschecks::systemd_message("running the startup self test").get();
+        auto results = syschecks::self_test(
+                         cfg.data_directory().as_sstring(),
+                         syschecks::self_test_config{
+                           .disk_bytes = cfg.startup_self_test_disk_bytes(),
+                           .memory_bytes
+                           = cfg.startup_self_test_memory_bytes(),
+                         })
+                         .get0();
+        ss::smp::invoke_on_all([results] {
+            syschecks::local_self_test_results() = results;
+        }).get();
+        if (cfg.startup_self_test_tune()) {
+            tune_from_self_test(results);
+        }
+    }
 }
 
 static admin_server_cfg
@@ -436,6 +493,8 @@ manager_config_from_global_config(scheduling_groups& sgs) {
         .stable_window = config::shard_local_cfg().reclaim_stable_window(),
         .min_size = config::shard_local_cfg().reclaim_min_size(),
         .max_size = config::shard_local_cfg().reclaim_max_size(),
+        .compressed_tier_max_size
+        = config::shard_local_cfg().batch_cache_compressed_tier_max_size(),
       },
       config::shard_local_cfg().readers_cache_eviction_timeout_ms(),
       sgs.compaction_sg());
@@ -503,6 +562,17 @@ void application::wire_up_services() {
           memory_groups::kafka_total_memory(),
           std::reference_wrapper(_proxy_client))
           .get();
+        // requests served in process are not authorized as the client
+        if (
+          _redpanda_enabled && _proxy_config->in_process_broker()
+          && !config::shard_local_cfg().enable_sasl()) {
+            _proxy
+              .invoke_on_all([this](pandaproxy::rest::proxy& p) {
+                  p.enable_local_broker(
+                    partition_manager, shard_table, metadata_cache);
+              })
+              .get();
+        }
     }
     if (_schema_reg_config) {
         construct_single_service(
@@ -521,6 +591,24 @@ void application::wire_up_redpanda_services() {
     ss::smp::invoke_on_all([] {
         return storage::internal::chunks().start();
     }).get();
+    ss::smp::invoke_on_all([] {
+        details::fragment_pool().start(
+          config::shard_local_cfg().iobuf_fragment_pool_max_bytes(),
+          config::shard_local_cfg().disable_metrics());
+    }).get();
+    _deferred.emplace_back([] {
+        ss::smp::invoke_on_all([] { details::fragment_pool().stop(); }).get();
+    });
+    ss::smp::invoke_on_all([this] {
+        compression::local_async_compressor().start(
+          _scheduling_groups.compression_sg(),
+          config::shard_local_cfg().disable_metrics());
+    }).get();
+    _deferred.emplace_back([] {
+        ss::smp::invoke_on_all(
+          [] { compression::local_async_compressor().stop(); })
+          .get();
+    });
 
     // cluster
     syschecks::systemd_message("Adding raft client cache").get();
@@ -577,14 +665,38 @@ void application::wire_up_redpanda_services() {
           })
           .get();
         construct_service(cloud_storage_api, std::ref(cloud_configs)).get();
+        cloud_storage_api.invoke_on_all(&cloud_storage::remote::start).get();
 
         construct_service(
           partition_recovery_manager,
           cloud_configs.local().bucket_name,
-          std::ref(cloud_storage_api))
+          std::ref(cloud_storage_api),
+          cloud_configs.local().recovery,
+          cloud_configs.local().metrics_disabled)
           .get();
 
         cloud_configs.stop().get();
+
+        if (config::shard_local_cfg().cloud_storage_enable_remote_read()) {
+            syschecks::systemd_message("Starting cloud storage cache").get();
+            const auto& cfg = config::shard_local_cfg();
+            std::filesystem::path cache_dir(
+              cfg.cloud_storage_cache_directory().value_or(
+                (cfg.data_directory().path / "archival_cache").native()));
+            // every shard caches the segments of the partitions it hosts in
+            // its own directory, evicting them independently
+            construct_service(
+              cloud_storage_cache,
+              ss::sharded_parameter([cache_dir] {
+                  return cache_dir / fmt::format("{}", ss::this_shard_id());
+              }),
+              cfg.cloud_storage_cache_size() / ss::smp::count,
+              cfg.cloud_storage_cache_check_interval_ms(),
+              cfg.cloud_storage_read_ahead_budget() / ss::smp::count)
+              .get();
+            cloud_storage_cache.invoke_on_all(&cloud_storage::cache::start)
+              .get();
+        }
     }
 
     syschecks::systemd_message("Adding partition manager").get();
@@ -593,7 +705,9 @@ void application::wire_up_redpanda_services() {
       std::ref(storage),
       std::ref(raft_group_manager),
       std::ref(tx_gateway_frontend),
-      std::ref(partition_recovery_manager))
+      std::ref(partition_recovery_manager),
+      std::ref(cloud_storage_api),
+      std::ref(cloud_storage_cache))
       .get();
     vlog(_log.info, "Partition manager started");
 
@@ -867,8 +981,20 @@ void application::wire_up_redpanda_services() {
                             : nullptr;
                   }
 
-                  c.addrs.emplace_back(
-                    ep.name, rpc::resolve_dns(ep.address).get0(), credentails);
+                  auto addr = rpc::resolve_dns(ep.address).get0();
+                  c.addrs.emplace_back(ep.name, addr, credentails);
+                  if (auto base = config::shard_local_cfg()
+                                    .kafka_api_shard_listeners_base_port();
+                      base) {
+                      for (ss::shard_id s = 0; s < ss::smp::count; ++s) {
+                          c.addrs.emplace_back(
+                            ep.name,
+                            ss::socket_address(
+                              addr.addr(), static_cast<uint16_t>(*base + s)),
+                            credentails,
+                            s);
+                      }
+                  }
               }
 
               c.disable_metrics = rpc::metrics_disabled(
@@ -884,6 +1010,8 @@ void application::wire_up_redpanda_services() {
       fetch_session_cache,
       config::shard_local_cfg().fetch_session_eviction_timeout_ms())
       .get();
+    construct_service(kafka_smp_batcher, smp_service_groups.kafka_smp_sg())
+      .get();
     construct_service(
       _compaction_controller,
       std::ref(storage),
@@ -891,6 +1019,30 @@ void application::wire_up_redpanda_services() {
         _scheduling_groups.compaction_sg(),
         priority_manager::local().compaction_priority()))
       .get();
+    const auto& cfg = config::shard_local_cfg();
+    if (cfg.background_io_ctrl_latency_target_ms()) {
+        construct_service(
+          _background_io_controller,
+          storage::background_io_controller_config{
+            .latency_target = *cfg.background_io_ctrl_latency_target_ms(),
+            .sampling_interval = cfg.background_io_ctrl_update_interval_ms(),
+            .min_scale = cfg.background_io_ctrl_min_scale(),
+          },
+          ss::sharded_parameter(
+            [] { return priority_manager::local().background_classes(); }),
+          ss::sharded_parameter([] {
+              return storage::background_io_controller::latency_sampler([] {
+                  return foreground_latency::local().sample_quantile(0.99);
+              });
+          }),
+          ss::sharded_parameter([this] {
+              return storage::background_io_controller::scale_listener(
+                [this](double scale) {
+                    _compaction_controller.local().set_shares_scale(scale);
+                });
+          }))
+          .get();
+    }
 }
 
 ss::future<> application::set_proxy_config(ss::sstring name, std::any val) {
@@ -918,16 +1070,26 @@ void application::start() {
         start_redpanda();
     }
 
+    // the proxy and the schema registry are independent, start them together
+    _startup_profile.phase("http_services");
+    auto proxy_started = ss::now();
+    if (_proxy_config) {
+        proxy_started = _proxy.invoke_on_all(&pandaproxy::rest::proxy::start);
+    }
+    auto schema_registry_started = ss::now();
+    if (_schema_reg_config) {
+        schema_registry_started = _schema_registry->start();
+    }
+    ss::when_all_succeed(
+      std::move(proxy_started), std::move(schema_registry_started))
+      .get();
     if (_proxy_config) {
-        _proxy.invoke_on_all(&pandaproxy::rest::proxy::start).get();
         vlog(
           _log.info,
           "Started Pandaproxy listening at {}",
           _proxy_config->pandaproxy_api());
     }
-
     if (_schema_reg_config) {
-        _schema_registry->start().get();
         vlog(
           _log.info,
           "Started Schema Registry listening at {}",
@@ -936,23 +1098,31 @@ void application::start() {
 
     _admin.invoke_on_all([](admin_server& admin) { admin.set_ready(); }).get();
 
-    vlog(_log.info, "Successfully started Redpanda!");
+    _startup_profile.finish();
+    vlog(_log.info, "Successfully started Redpanda! ({})", _startup_profile);
     syschecks::systemd_notify_ready().get();
 }
 
 void application::start_redpanda() {
+    _startup_profile.phase("storage");
     syschecks::systemd_message("Staring storage services").get();
     storage.invoke_on_all(&storage::api::start).get();
+    storage
+      .invoke_on_all([](storage::api& s) { s.log_mgr().setup_metrics(); })
+      .get();
 
+    _startup_profile.phase("partition_manager");
     syschecks::systemd_message("Starting the partition manager").get();
     partition_manager.invoke_on_all(&cluster::partition_manager::start).get();
 
+    _startup_profile.phase("raft");
     syschecks::systemd_message("Starting Raft group manager").get();
     raft_group_manager.invoke_on_all(&raft::group_manager::start).get();
 
     syschecks::systemd_message("Starting Kafka group manager").get();
     _group_manager.invoke_on_all(&kafka::group_manager::start).get();
 
+    _startup_profile.phase("controller");
     syschecks::systemd_message("Starting controller").get();
     controller->start().get0();
     /**
@@ -972,6 +1142,7 @@ void application::start_redpanda() {
       .invoke_on_all(&cluster::metadata_dissemination_service::start)
       .get();
 
+    _startup_profile.phase("rpc");
     syschecks::systemd_message("Starting RPC").get();
     _rpc
       .invoke_on_all([this](rpc::server& s) {
@@ -1003,7 +1174,8 @@ void application::start_redpanda() {
             std::ref(metadata_cache),
             std::ref(controller->get_security_frontend()),
             std::ref(controller->get_api()),
-            std::ref(controller->get_members_frontend()));
+            std::ref(controller->get_members_frontend()),
+            std::ref(controller->get_health_manager()));
           proto->register_service<cluster::metadata_dissemination_handler>(
             _scheduling_groups.cluster_sg(),
             smp_service_groups.cluster_smp_sg(),
@@ -1021,14 +1193,7 @@ void application::start_redpanda() {
       [this] { _rpc.invoke_on_all(&rpc::server::shutdown_input).get(); });
     vlog(_log.info, "Started RPC server listening at {}", conf.rpc_server());
 
-    if (archival_storage_enabled()) {
-        syschecks::systemd_message("Starting archival storage").get();
-        archival_scheduler
-          .invoke_on_all(
-            [](archival::scheduler_service& svc) { return svc.start(); })
-          .get();
-    }
-
+    _startup_profile.phase("kafka");
     quota_mgr.invoke_on_all(&kafka::quota_manager::start).get();
 
     std::optional<kafka::qdc_monitor::config> qdc_config;
@@ -1067,7 +1232,9 @@ void application::start_redpanda() {
             controller->get_api(),
             tx_gateway_frontend,
             data_policies,
-            qdc_config);
+            kafka_smp_batcher,
+            qdc_config,
+            _scheduling_groups.tenant_groups());
           s.set_protocol(std::move(proto));
       })
       .get();
@@ -1079,10 +1246,54 @@ void application::start_redpanda() {
     vlog(
       _log.info, "Started Kafka API server listening at {}", conf.kafka_api());
 
+    ss::smp::invoke_on_all([this] {
+        auto& groups = local_memory_groups();
+        groups.set_usage(memory_group::kafka, [this] {
+            const auto& s = _kafka_server.local();
+            return memory_group_accounting::usage{
+              .used = s.memory_in_use(),
+              .hard_limit = s.cfg.max_service_memory_per_core};
+        });
+        groups.set_usage(memory_group::rpc, [this] {
+            const auto& s = _rpc.local();
+            return memory_group_accounting::usage{
+              .used = s.memory_in_use(),
+              .hard_limit = s.cfg.max_service_memory_per_core};
+        });
+        if (!config::shard_local_cfg().disable_metrics()) {
+            groups.setup_metrics();
+        }
+    }).get();
+    _deferred.emplace_back([] {
+        ss::smp::invoke_on_all([] { local_memory_groups().stop(); }).get();
+    });
+
+    _startup_profile.phase("admin");
     if (config::shard_local_cfg().enable_admin_api()) {
         _admin.invoke_on_all(&admin_server::start).get0();
     }
 
+    /*
+     * Background services start once the kafka api is served, so that they
+     * do not delay it after a restart.
+     */
+    _startup_profile.phase("background_services");
+    if (archival_storage_enabled()) {
+        syschecks::systemd_message("Starting archival storage").get();
+        archival_scheduler
+          .invoke_on_all(
+            [](archival::scheduler_service& svc) { return svc.start(); })
+          .get();
+    }
+
     _compaction_controller.invoke_on_all(&storage::compaction_controller::start)
       .get();
+    if (_background_io_controller.local_is_initialized()) {
+        _background_io_controller
+          .invoke_on_all([](storage::background_io_controller& c) {
+              c.setup_metrics();
+              return c.start();
+          })
+          .get();
+    }
 }
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "archival/fwd.h"
+#include "cloud_storage/cache_service.h"
 #include "cloud_storage/partition_recovery_manager.h"
 #include "cluster/fwd.h"
 #include "coproc/fwd.h"
@@ -24,11 +25,13 @@
 #include "pandaproxy/schema_registry/fwd.h"
 #include "raft/fwd.h"
 #include "redpanda/admin_server.h"
+#include "redpanda/startup_profile.h"
 #include "resource_mgmt/cpu_scheduling.h"
 #include "resource_mgmt/memory_groups.h"
 #include "resource_mgmt/smp_groups.h"
 #include "rpc/fwd.h"
 #include "seastarx.h"
+#include "ssx/smp_batcher.h"
 #include "storage/fwd.h"
 #include "v8_engine/fwd.h"
 
@@ -87,11 +90,13 @@ public:
     ss::sharded<cloud_storage::remote> cloud_storage_api;
     ss::sharded<cloud_storage::partition_recovery_manager>
       partition_recovery_manager;
+    ss::sharded<cloud_storage::cache> cloud_storage_cache;
     ss::sharded<archival::scheduler_service> archival_scheduler;
     ss::sharded<kafka::rm_group_frontend> rm_group_frontend;
     ss::sharded<cluster::rm_partition_frontend> rm_partition_frontend;
     ss::sharded<cluster::tx_gateway_frontend> tx_gateway_frontend;
     ss::sharded<v8_engine::data_policy_table> data_policies;
+    ss::sharded<ssx::smp_batcher> kafka_smp_batcher;
 
 private:
     using deferred_actions
@@ -132,6 +137,7 @@ private:
     std::optional<kafka::client::configuration> _schema_reg_client_config;
     scheduling_groups _scheduling_groups;
     ss::logger _log;
+    startup_profile _startup_profile;
 
     ss::sharded<rpc::connection_cache> _raft_connection_cache;
     ss::sharded<kafka::group_manager> _group_manager;
@@ -142,6 +148,7 @@ private:
     ss::sharded<pandaproxy::rest::proxy> _proxy;
     std::unique_ptr<pandaproxy::schema_registry::api> _schema_registry;
     ss::sharded<storage::compaction_controller> _compaction_controller;
+    ss::sharded<storage::background_io_controller> _background_io_controller;
 
     ss::metrics::metric_groups _metrics;
     std::unique_ptr<kafka::rm_group_proxy_impl> _rm_group_proxy;
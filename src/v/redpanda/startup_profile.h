@@ -0,0 +1,78 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/sstring.hh>
+
+#include <fmt/ostream.h>
+
+#include <chrono>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/// Wall time spent in each phase of the startup of a node, in order.
+class startup_profile {
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    struct phase_time {
+        ss::sstring name;
+        clock_type::duration elapsed;
+    };
+
+    startup_profile()
+      : _begin(clock_type::now()) {}
+
+    /// ends the current phase, if any, and starts the next one
+    void phase(std::string_view name) {
+        finish();
+        _current = std::make_pair(ss::sstring(name), clock_type::now());
+    }
+
+    /// ends the current phase
+    void finish() {
+        if (_current) {
+            _phases.push_back(phase_time{
+              .name = std::move(_current->first),
+              .elapsed = clock_type::now() - _current->second});
+            _current.reset();
+        }
+    }
+
+    const std::vector<phase_time>& phases() const { return _phases; }
+    clock_type::duration elapsed() const { return clock_type::now() - _begin; }
+
+    friend std::ostream& operator<<(std::ostream& o, const startup_profile& p) {
+        using std::chrono::duration_cast;
+        using std::chrono::milliseconds;
+        fmt::print(
+          o, "total: {}ms", duration_cast<milliseconds>(p.elapsed()).count());
+        for (const auto& ph : p._phases) {
+            fmt::print(
+              o,
+              ", {}: {}ms",
+              ph.name,
+              duration_cast<milliseconds>(ph.elapsed).count());
+        }
+        return o;
+    }
+
+private:
+    clock_type::time_point _begin;
+    std::optional<std::pair<ss::sstring, clock_type::time_point>> _current;
+    std::vector<phase_time> _phases;
+};
@@ -98,6 +98,7 @@ public:
           app.controller->get_api(),
           app.tx_gateway_frontend,
           app.data_policies,
+          app.kafka_smp_batcher,
           std::nullopt);
     }
 
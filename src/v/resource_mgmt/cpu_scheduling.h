@@ -12,10 +12,25 @@
 #pragma once
 
 #include "seastarx.h"
+#include "ssx/sformat.h"
 
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/scheduling.hh>
+#include <seastar/core/sstring.hh>
+
+#include <charconv>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/// Kafka requests of the clients whose client id starts with client_id_prefix
+/// run in sg instead of the scheduling group of the kafka server.
+struct tenant_scheduling_group {
+    ss::sstring client_id_prefix;
+    ss::scheduling_group sg;
+};
 
 // manage cpu scheduling groups. scheduling groups are global, so one instance
 // of this class can be created at the top level and passed down into any server
@@ -34,6 +49,8 @@ public:
           "log_compaction", 100);
         _raft_learner_recovery = co_await ss::create_scheduling_group(
           "raft_learner_recovery", 50);
+        _compression = co_await ss::create_scheduling_group(
+          "compression", 100);
     }
 
     ss::future<> destroy_groups() {
@@ -45,9 +62,68 @@ public:
         co_await destroy_scheduling_group(_cache_background_reclaim);
         co_await destroy_scheduling_group(_compaction);
         co_await destroy_scheduling_group(_raft_learner_recovery);
+        co_await destroy_scheduling_group(_compression);
+        for (auto& t : _tenants) {
+            co_await destroy_scheduling_group(t.sg);
+        }
+        _tenants.clear();
         co_return;
     }
 
+    /**
+     * Seastar caps the number of scheduling groups of a process, the fixed
+     * groups above leave room for this many tenant groups.
+     */
+    static constexpr size_t max_tenant_groups = 4;
+
+    /// \brief parse a "<client_id_prefix>:<shares>" tenant group
+    static std::optional<std::pair<ss::sstring, float>>
+    parse_tenant_group(std::string_view spec) {
+        const auto sep = spec.rfind(':');
+        if (sep == std::string_view::npos || sep == 0) {
+            return std::nullopt;
+        }
+        const auto digits = spec.substr(sep + 1);
+        uint32_t shares = 0;
+        const auto [end, ec] = std::from_chars(
+          digits.data(), digits.data() + digits.size(), shares);
+        if (
+          ec != std::errc() || end != digits.data() + digits.size()
+          || shares == 0 || shares > 1000) {
+            return std::nullopt;
+        }
+        return std::make_pair(
+          ss::sstring(spec.substr(0, sep)), static_cast<float>(shares));
+    }
+
+    static std::optional<ss::sstring>
+    validate_tenant_groups(const std::vector<ss::sstring>& specs) {
+        if (specs.size() > max_tenant_groups) {
+            return ssx::sformat(
+              "At most {} tenant scheduling groups are supported",
+              max_tenant_groups);
+        }
+        for (const auto& spec : specs) {
+            if (!parse_tenant_group(spec)) {
+                return ssx::sformat(
+                  "Invalid tenant scheduling group '{}', expected "
+                  "<client_id_prefix>:<shares> with shares in [1, 1000]",
+                  spec);
+            }
+        }
+        return std::nullopt;
+    }
+
+    /// \brief create a group per validated "<client_id_prefix>:<shares>"
+    ss::future<> create_tenant_groups(std::vector<ss::sstring> specs) {
+        for (const auto& spec : specs) {
+            auto [prefix, shares] = *parse_tenant_group(spec);
+            auto sg = co_await ss::create_scheduling_group(
+              ssx::sformat("kafka_tenant_{}", prefix), shares);
+            _tenants.push_back({std::move(prefix), sg});
+        }
+    }
+
     ss::scheduling_group admin_sg() { return _admin; }
     ss::scheduling_group raft_sg() { return _raft; }
     ss::scheduling_group kafka_sg() { return _kafka; }
@@ -60,6 +136,10 @@ public:
     ss::scheduling_group raft_learner_recovery_sg() {
         return _raft_learner_recovery;
     }
+    ss::scheduling_group compression_sg() { return _compression; }
+    const std::vector<tenant_scheduling_group>& tenant_groups() const {
+        return _tenants;
+    }
 
 private:
     ss::scheduling_group _admin;
@@ -70,4 +150,6 @@ private:
     ss::scheduling_group _cache_background_reclaim;
     ss::scheduling_group _compaction;
     ss::scheduling_group _raft_learner_recovery;
+    ss::scheduling_group _compression;
+    std::vector<tenant_scheduling_group> _tenants;
 };
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+
+/**
+ * Shard local distribution of the latency of the foreground requests, the
+ * produce requests, recorded since it was last sampled. Background IO is
+ * throttled against a quantile of it, see storage::background_io_controller.
+ *
+ * Latencies are counted in power of two buckets of microseconds, a quantile
+ * is the upper bound of its bucket.
+ */
+class foreground_latency {
+public:
+    static constexpr size_t buckets = 32;
+
+    void record(std::chrono::microseconds d) noexcept {
+        ++_counts[bucket(d)];
+        ++_total;
+    }
+
+    /// std::nullopt if nothing was recorded since the last sample
+    std::optional<std::chrono::microseconds> sample_quantile(double q) {
+        if (_total == 0) {
+            return std::nullopt;
+        }
+        const auto rank = static_cast<uint64_t>(
+          std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(_total)));
+        uint64_t seen = 0;
+        size_t i = 0;
+        for (; i < buckets - 1; ++i) {
+            seen += _counts[i];
+            if (seen >= rank) {
+                break;
+            }
+        }
+        _counts.fill(0);
+        _total = 0;
+        return std::chrono::microseconds(uint64_t(1) << i);
+    }
+
+    static foreground_latency& local() {
+        static thread_local foreground_latency fl;
+        return fl;
+    }
+
+private:
+    /// bucket i holds the latencies in [2^(i-1), 2^i) microseconds
+    static size_t bucket(std::chrono::microseconds d) noexcept {
+        const auto us = static_cast<uint64_t>(std::max<int64_t>(d.count(), 0));
+        return std::min<size_t>(std::bit_width(us), buckets - 1);
+    }
+
+    std::array<uint64_t, buckets> _counts{};
+    uint64_t _total{0};
+};
@@ -18,6 +18,9 @@
 #include <seastar/core/io_priority_class.hh>
 #include <seastar/core/reactor.hh>
 
+#include <cstdint>
+#include <vector>
+
 class priority_manager {
 public:
     ss::io_priority_class raft_priority() { return _raft_priority; }
@@ -27,6 +30,27 @@ public:
     ss::io_priority_class raft_learner_recovery_priority() {
         return _raft_learner_recovery_priority;
     }
+    ss::io_priority_class scrubber_priority() { return _scrubber_priority; }
+    ss::io_priority_class archival_priority() { return _archival_priority; }
+
+    /// a background class and the shares it was registered with
+    struct background_class {
+        ss::io_priority_class iopc;
+        uint32_t shares;
+    };
+
+    /**
+     * The background classes whose shares are scaled to protect foreground
+     * latency. Compaction is not one of them, its shares are driven by the
+     * compaction backlog controller, which applies the same scale.
+     */
+    std::vector<background_class> background_classes() {
+        return {
+          {_raft_learner_recovery_priority, raft_learner_recovery_shares},
+          {_scrubber_priority, scrubber_shares},
+          {_archival_priority, archival_shares},
+        };
+    }
 
     static priority_manager& local() {
         static thread_local priority_manager pm = priority_manager();
@@ -34,6 +58,10 @@ public:
     }
 
 private:
+    static constexpr uint32_t raft_learner_recovery_shares = 100;
+    static constexpr uint32_t scrubber_shares = 50;
+    static constexpr uint32_t archival_shares = 100;
+
     priority_manager()
       : _raft_priority(ss::io_priority_class::register_one("raft", 1000))
       , _controller_priority(
@@ -42,14 +70,20 @@ private:
           ss::io_priority_class::register_one("kafka_read", 1000))
       , _compaction_priority(
           ss::io_priority_class::register_one("compaction", 200))
-      , _raft_learner_recovery_priority(
-          ss::io_priority_class::register_one("raft-learner-recovery", 100)) {}
+      , _raft_learner_recovery_priority(ss::io_priority_class::register_one(
+          "raft-learner-recovery", raft_learner_recovery_shares))
+      , _scrubber_priority(
+          ss::io_priority_class::register_one("scrubber", scrubber_shares))
+      , _archival_priority(
+          ss::io_priority_class::register_one("archival", archival_shares)) {}
 
     ss::io_priority_class _raft_priority;
     ss::io_priority_class _controller_priority;
     ss::io_priority_class _kafka_read_priority;
     ss::io_priority_class _compaction_priority;
     ss::io_priority_class _raft_learner_recovery_priority;
+    ss::io_priority_class _scrubber_priority;
+    ss::io_priority_class _archival_priority;
 };
 
 inline ss::io_priority_class raft_priority() {
@@ -71,3 +105,11 @@ inline ss::io_priority_class compaction_priority() {
 inline ss::io_priority_class raft_learner_recovery_priority() {
     return priority_manager::local().raft_learner_recovery_priority();
 }
+
+inline ss::io_priority_class scrubber_priority() {
+    return priority_manager::local().scrubber_priority();
+}
+
+inline ss::io_priority_class archival_priority() {
+    return priority_manager::local().archival_priority();
+}
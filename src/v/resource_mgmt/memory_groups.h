@@ -11,20 +11,35 @@
 
 #pragma once
 
+#include "config/configuration.h"
+#include "prometheus/prometheus_sanitize.h"
 #include "seastarx.h"
 
 #include <seastar/core/memory.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <fmt/format.h>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
 
 // centralized unit for memory management
+//
+// The shares of the memory of a core are node configuration, the memory_*
+// properties, so that nodes with different workloads use different splits.
 struct memory_groups {
     static size_t kafka_total_memory() {
-        // 30%
-        return ss::memory::stats().total_memory() * .30;
+        return share(config::shard_local_cfg().memory_kafka_fraction());
     }
     /// \brief includes raft & all services
     static size_t rpc_total_memory() {
-        // 30%
-        return ss::memory::stats().total_memory() * .30;
+        return share(config::shard_local_cfg().memory_rpc_fraction());
     }
 
     /**
@@ -32,10 +47,11 @@ struct memory_groups {
      * and may be expanded as needed by segment appenders, or reclaimed from by
      * seastar under memory pressure.
      *
-     * add upper bound of 30 pct of memory as a hard outstanding limit.
+     * add upper bound of chunk_cache_max_memory() as a hard outstanding limit.
      */
     static size_t chunk_cache_min_memory() {
-        return ss::memory::stats().total_memory() * .10; // NOLINT
+        return share(
+          config::shard_local_cfg().memory_chunk_cache_min_fraction());
     }
 
     /**
@@ -44,6 +60,189 @@ struct memory_groups {
      * returned to the cache.
      */
     static size_t chunk_cache_max_memory() {
-        return ss::memory::stats().total_memory() * .30; // NOLINT
+        return share(
+          config::shard_local_cfg().memory_chunk_cache_max_fraction());
+    }
+
+    /**
+     * Bounds within which the adaptive cache sizing controller may move the
+     * chunk cache target and limit. Memory taken from the chunk cache is left
+     * to the batch cache, which grows into free memory.
+     */
+    static size_t chunk_cache_floor_memory() {
+        return share(
+          config::shard_local_cfg().memory_chunk_cache_floor_fraction());
+    }
+    static size_t chunk_cache_ceiling_memory() {
+        return share(
+          config::shard_local_cfg().memory_chunk_cache_ceiling_fraction());
+    }
+
+    /**
+     * Soft budget for the hydrated offset/time indices of closed segments.
+     * Indices beyond the budget are evicted in LRU order and re-read from
+     * disk on the next lookup; base/max offsets and timestamps stay resident.
+     */
+    static size_t segment_index_max_memory() {
+        return share(config::shard_local_cfg().memory_segment_index_fraction());
+    }
+
+    /**
+     * Throws if the configured shares are out of order or leave less than
+     * min_free_fraction of the memory to the batch cache and everything else.
+     */
+    static void validate() {
+        const auto& cfg = config::shard_local_cfg();
+        const auto floor = cfg.memory_chunk_cache_floor_fraction();
+        const auto min = cfg.memory_chunk_cache_min_fraction();
+        const auto max = cfg.memory_chunk_cache_max_fraction();
+        const auto ceiling = cfg.memory_chunk_cache_ceiling_fraction();
+        if (!(0 <= floor && floor <= min && min <= max && max <= ceiling)) {
+            throw std::invalid_argument(fmt::format(
+              "memory_chunk_cache fractions must be ordered as "
+              "0 <= floor ({}) <= min ({}) <= max ({}) <= ceiling ({})",
+              floor,
+              min,
+              max,
+              ceiling));
+        }
+        const auto reserved = cfg.memory_kafka_fraction()
+                              + cfg.memory_rpc_fraction() + ceiling
+                              + cfg.memory_segment_index_fraction();
+        if (
+          cfg.memory_kafka_fraction() < 0 || cfg.memory_rpc_fraction() < 0
+          || cfg.memory_segment_index_fraction() < 0
+          || reserved > 1 - min_free_fraction) {
+            throw std::invalid_argument(fmt::format(
+              "memory fractions of kafka, rpc, chunk cache ceiling and segment "
+              "index add up to {}, above {}",
+              reserved,
+              1 - min_free_fraction));
+        }
     }
+
+    static constexpr double min_free_fraction = 0.05;
+
+private:
+    static size_t share(double fraction) {
+        return ss::memory::stats().total_memory() * fraction;
+    }
+};
+
+/// Subsystems whose memory is accounted by memory_group_accounting.
+enum class memory_group : uint8_t {
+    kafka = 0,
+    rpc,
+    chunk_cache,
+    batch_cache,
+    segment_index,
+    coproc,
 };
+
+inline constexpr size_t memory_group_count = 6;
+
+inline std::string_view memory_group_name(memory_group g) {
+    switch (g) {
+    case memory_group::kafka:
+        return "kafka";
+    case memory_group::rpc:
+        return "rpc";
+    case memory_group::chunk_cache:
+        return "chunk_cache";
+    case memory_group::batch_cache:
+        return "batch_cache";
+    case memory_group::segment_index:
+        return "segment_index";
+    case memory_group::coproc:
+        return "coproc";
+    }
+    return "unknown";
+}
+
+/**
+ * Shard local view of the memory used by each subsystem against its limits.
+ *
+ * The subsystems enforce their limits themselves, the owner of a group
+ * reports its usage and limits here so that they are exported side by side:
+ *
+ *  - kafka, rpc: hard limit, requests wait on the memory semaphore of the
+ *    server.
+ *  - chunk_cache: soft target and hard limit of the outstanding chunks, moved
+ *    at runtime within the floor and ceiling by the cache memory controller.
+ *  - batch_cache: no limit, grows into free memory and is reclaimed by the
+ *    allocator, it gets what the chunk cache controller gives up.
+ *  - segment_index: soft budget, the least recently used indices are evicted.
+ *  - coproc: reported by the coprocessor pipeline when it is enabled.
+ */
+class memory_group_accounting {
+public:
+    struct usage {
+        size_t used{0};
+        std::optional<size_t> soft_limit;
+        std::optional<size_t> hard_limit;
+    };
+    using usage_fn = ss::noncopyable_function<usage()>;
+
+    /// The reporter of a group, replaces the previous one
+    void set_usage(memory_group g, usage_fn fn) { at(g) = std::move(fn); }
+    void clear_usage(memory_group g) { at(g) = std::nullopt; }
+
+    /// std::nullopt if the group is not reported on this shard
+    std::optional<usage> get_usage(memory_group g) {
+        auto& fn = at(g);
+        if (!fn) {
+            return std::nullopt;
+        }
+        return (*fn)();
+    }
+
+    void setup_metrics() {
+        namespace sm = ss::metrics;
+        std::vector<sm::metric_definition> defs;
+        for (size_t i = 0; i < memory_group_count; ++i) {
+            const auto g = static_cast<memory_group>(i);
+            auto label = sm::label("group")(ss::sstring(memory_group_name(g)));
+            defs.push_back(sm::make_gauge(
+              "used_bytes",
+              [this, g] { return get_usage(g).value_or(usage{}).used; },
+              sm::description("Memory used by the group"),
+              {label}));
+            defs.push_back(sm::make_gauge(
+              "soft_limit_bytes",
+              [this, g] {
+                  return get_usage(g).value_or(usage{}).soft_limit.value_or(0);
+              },
+              sm::description("Soft limit of the group, 0 if it has none"),
+              {label}));
+            defs.push_back(sm::make_gauge(
+              "hard_limit_bytes",
+              [this, g] {
+                  return get_usage(g).value_or(usage{}).hard_limit.value_or(0);
+              },
+              sm::description("Hard limit of the group, 0 if it has none"),
+              {label}));
+        }
+        _metrics.add_group(
+          prometheus_sanitize::metrics_name("memory_groups"), defs);
+    }
+
+    void stop() {
+        _metrics.clear();
+        for (auto& fn : _usage) {
+            fn = std::nullopt;
+        }
+    }
+
+private:
+    std::optional<usage_fn>& at(memory_group g) {
+        return _usage[static_cast<size_t>(g)];
+    }
+
+    std::array<std::optional<usage_fn>, memory_group_count> _usage;
+    ss::metrics::metric_groups _metrics;
+};
+
+inline memory_group_accounting& local_memory_groups() {
+    static thread_local memory_group_accounting accounting;
+    return accounting;
+}
@@ -82,6 +82,11 @@ public:
         return total / std::chrono::duration<double>(elapsed).count();
     }
 
+    // return the current rate in units/second without a new observation.
+    double measure(const clock::time_point& now) {
+        return record_and_measure(0., now);
+    }
+
     clock::duration window_size() const { return _window_size; }
 
 private:
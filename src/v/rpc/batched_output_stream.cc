@@ -13,16 +13,18 @@
 #include "vassert.h"
 
 #include <seastar/core/future.hh>
+#include <seastar/core/future-util.hh>
 #include <seastar/core/scattered_message.hh>
 
 #include <fmt/format.h>
 
 namespace rpc {
 batched_output_stream::batched_output_stream(
-  ss::output_stream<char> o, size_t cache)
+  ss::output_stream<char> o, size_t cache, flush_stats* stats)
   : _out(std::move(o))
   , _cache_size(cache)
-  , _write_sem(std::make_unique<ss::semaphore>(1)) {
+  , _write_sem(std::make_unique<ss::semaphore>(1))
+  , _stats(stats) {
     // Size zero reserved for identifying default-initialized
     // instances in stop()
     vassert(_cache_size > 0, "Size must be > 0");
@@ -45,21 +47,52 @@ ss::future<> batched_output_stream::write(ss::scattered_message<char> msg) {
               return already_closed_error(v);
           }
           const size_t vbytes = v.size();
+          if (_unflushed_messages == 0) {
+              _first_unflushed = clock_type::now();
+          }
           return _out.write(std::move(v)).then([this, vbytes] {
               _unflushed_bytes += vbytes;
-              if (
-                _write_sem->waiters() == 0 || _unflushed_bytes >= _cache_size) {
+              ++_unflushed_messages;
+              if (_unflushed_bytes >= _cache_size) {
                   return do_flush();
               }
-              return ss::make_ready_future<>();
+              if (_write_sem->waiters() > 0) {
+                  // the next writer flushes
+                  return ss::make_ready_future<>();
+              }
+              return flush_or_cork();
           });
       });
 }
+ss::future<> batched_output_stream::flush_or_cork() {
+    const bool probe = _flushes_since_probe >= cork_probe_interval;
+    if (
+      (!_cork && !probe)
+      || clock_type::now() - _first_unflushed >= max_cork_latency) {
+        return do_flush();
+    }
+    // the write semaphore is held while yielding, writers scheduled in the
+    // meantime queue on it and the last of them flushes
+    return ss::later().then([this] {
+        if (_write_sem->waiters() > 0) {
+            return ss::make_ready_future<>();
+        }
+        return do_flush();
+    });
+}
 ss::future<> batched_output_stream::do_flush() {
     if (_unflushed_bytes == 0) {
         return ss::make_ready_future<>();
     }
+    const bool probed = _flushes_since_probe >= cork_probe_interval;
+    _cork = _unflushed_messages > 1;
+    _flushes_since_probe = _cork || probed ? 0 : _flushes_since_probe + 1;
+    if (_stats) {
+        ++_stats->flushes;
+        _stats->messages += _unflushed_messages;
+    }
     _unflushed_bytes = 0;
+    _unflushed_messages = 0;
     return _out.flush();
 }
 ss::future<> batched_output_stream::flush() {
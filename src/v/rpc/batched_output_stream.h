@@ -16,18 +16,38 @@
 #include <seastar/core/iostream.hh>
 #include <seastar/core/semaphore.hh>
 
+#include <chrono>
 #include <cstdint>
 
 namespace rpc {
 
+/// flushes of output streams and the number of messages they carried
+struct flush_stats {
+    uint64_t flushes{0};
+    uint64_t messages{0};
+};
+
 /// \brief batch operations for zero copy interface of an output_stream<char>
+///
+/// Messages written while another write is in progress are flushed together.
+/// The stream also corks adaptively: when recent flushes carried more than a
+/// single message, a write lets the tasks already scheduled on the reactor
+/// run before flushing, so that messages written by them end up in the same
+/// writev. Corking is bounded by the unflushed bytes and by max_cork_latency
+/// since the first unflushed message, streams of lone messages are probed
+/// every cork_probe_interval flushes.
 class batched_output_stream {
 public:
+    using clock_type = std::chrono::steady_clock;
     static constexpr size_t default_max_unflushed_bytes = 1024 * 1024;
+    static constexpr std::chrono::microseconds max_cork_latency{500};
+    static constexpr uint32_t cork_probe_interval = 16;
 
     batched_output_stream() = default;
     explicit batched_output_stream(
-      ss::output_stream<char>, size_t cache = default_max_unflushed_bytes);
+      ss::output_stream<char>,
+      size_t cache = default_max_unflushed_bytes,
+      flush_stats* stats = nullptr);
     ~batched_output_stream() noexcept = default;
     // NOTE: explicitly defined for a gcc
     batched_output_stream(batched_output_stream&& o) noexcept
@@ -35,6 +55,11 @@ public:
       , _cache_size(o._cache_size)
       , _write_sem(std::move(o._write_sem))
       , _unflushed_bytes(o._unflushed_bytes)
+      , _unflushed_messages(o._unflushed_messages)
+      , _first_unflushed(o._first_unflushed)
+      , _cork(o._cork)
+      , _flushes_since_probe(o._flushes_since_probe)
+      , _stats(o._stats)
       , _closed(o._closed) {}
     batched_output_stream& operator=(batched_output_stream&& o) noexcept {
         if (this != &o) {
@@ -57,11 +82,17 @@ public:
 
 private:
     ss::future<> do_flush();
+    ss::future<> flush_or_cork();
 
     ss::output_stream<char> _out;
     size_t _cache_size{0};
     std::unique_ptr<ss::semaphore> _write_sem;
     size_t _unflushed_bytes{0};
+    uint32_t _unflushed_messages{0};
+    clock_type::time_point _first_unflushed;
+    bool _cork{false};
+    uint32_t _flushes_since_probe{0};
+    flush_stats* _stats{nullptr};
     bool _closed = false;
 };
 } // namespace rpc
@@ -10,6 +10,7 @@
  */
 
 #pragma once
+#include "rpc/batched_output_stream.h"
 #include "rpc/logger.h"
 #include "utils/unresolved_address.h"
 
@@ -44,6 +45,8 @@ public:
 
     void add_bytes_received(size_t recv) { _in_bytes += recv; }
 
+    flush_stats& output_flushes() { return _output_flushes; }
+
     void connection_established() {
         ++_connects;
         ++_connections;
@@ -90,6 +93,7 @@ private:
     uint32_t _server_correlation_errors = 0;
     uint32_t _client_correlation_errors = 0;
     uint32_t _requests_blocked_memory = 0;
+    flush_stats _output_flushes;
     ss::metrics::metric_groups _metrics;
 
     friend std::ostream& operator<<(std::ostream& o, const client_probe& p);
@@ -9,14 +9,40 @@
 
 #include "rpc/connection_cache.h"
 
+#include "config/configuration.h"
 #include "rpc/backoff_policy.h"
 
+#include <boost/functional/hash.hpp>
 #include <fmt/format.h>
 
 #include <chrono>
 
 namespace rpc {
 
+ss::shard_id connection_cache::shard_for(
+  model::node_id self,
+  ss::shard_id src_shard,
+  model::node_id n,
+  ss::shard_id total_shards) {
+    auto connections = std::max<ss::shard_id>(
+      1, config::shard_local_cfg().rpc_client_connections_per_peer());
+    if (total_shards <= connections) {
+        // every shard has its own connection
+        return src_shard;
+    }
+    /**
+     * Shards with the same remainder modulo the number of connections share
+     * a connection. Its owner is one of them, so that at least the owner
+     * does not hop to another shard, chosen by the pair of nodes to spread
+     * the connections to different peers over all the shards.
+     */
+    auto group = src_shard % connections;
+    auto group_size = (total_shards - group + connections - 1) / connections;
+    size_t h = std::hash<model::node_id>{}(n);
+    boost::hash_combine(h, std::hash<model::node_id>{}(self));
+    return group + connections * (h % group_size);
+}
+
 /// \brief needs to be a future, because mutations may come from different
 /// fibers and they need to be synchronized
 ss::future<> connection_cache::emplace(
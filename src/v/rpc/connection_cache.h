@@ -10,7 +10,6 @@
  */
 
 #pragma once
-#include "hashing/jump_consistent_hash.h"
 #include "model/metadata.h"
 #include "outcome.h"
 #include "outcome_future_utils.h"
@@ -35,7 +34,12 @@ public:
     using underlying = std::unordered_map<model::node_id, transport_ptr>;
     using iterator = typename underlying::iterator;
 
-    static inline ss::shard_id shard_for(
+    /// Shard owning the connection used by shard `src` to talk to `node`.
+    /// Every node keeps up to rpc_client_connections_per_peer connections to
+    /// each of its peers, when there are more shards than connections the
+    /// shards sharing a connection are forwarded to its owner, which is one
+    /// of them.
+    static ss::shard_id shard_for(
       model::node_id self,
       ss::shard_id src,
       model::node_id node,
@@ -139,33 +143,5 @@ private:
     mutex _mutex; // to add/remove nodes
     underlying _cache;
 };
-inline ss::shard_id connection_cache::shard_for(
-  model::node_id self,
-  ss::shard_id src_shard,
-  model::node_id n,
-  ss::shard_id total_shards) {
-    if (ss::smp::count <= 8) {
-        return src_shard;
-    }
-    static const constexpr size_t vnodes = 8;
-    /// make deterministic - choose 1 prime to mix node_id with
-    /// https://planetmath.org/goodhashtableprimes
-    static const constexpr std::array<size_t, vnodes> universe{
-      {12582917,
-       25165843,
-       50331653,
-       100663319,
-       201326611,
-       402653189,
-       805306457,
-       1610612741}};
-
-    // NOLINTNEXTLINE
-    size_t h = universe[jump_consistent_hash(src_shard, vnodes)];
-    boost::hash_combine(h, std::hash<model::node_id>{}(n));
-    boost::hash_combine(h, std::hash<model::node_id>{}(self));
-    // use self node id to shift jump_consistent_hash_assignment
-    return jump_consistent_hash(h, total_shards);
-}
 
 } // namespace rpc
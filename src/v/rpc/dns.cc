@@ -17,14 +17,38 @@
 #include <seastar/net/dns.hh>
 
 namespace rpc {
-ss::future<ss::socket_address> resolve_dns(unresolved_address address) {
+
+static ss::net::dns_resolver& local_resolver() {
     static thread_local ss::net::dns_resolver resolver;
+    return resolver;
+}
+
+static mutex& local_resolver_mutex() {
     static thread_local mutex m;
+    return m;
+}
+
+ss::future<ss::socket_address> resolve_dns(unresolved_address address) {
     // lock
-    auto units = co_await m.get_units();
+    auto units = co_await local_resolver_mutex().get_units();
     // resolve
-    auto i_a = co_await resolver.resolve_name(address.host(), address.family());
+    auto i_a = co_await local_resolver().resolve_name(
+      address.host(), address.family());
 
     co_return ss::socket_address(i_a, address.port());
 };
+
+ss::future<std::vector<ss::socket_address>>
+resolve_dns_all(unresolved_address address) {
+    auto units = co_await local_resolver_mutex().get_units();
+    auto host = co_await local_resolver().get_host_by_name(
+      address.host(), address.family());
+
+    std::vector<ss::socket_address> result;
+    result.reserve(host.addr_list.size());
+    for (const auto& i_a : host.addr_list) {
+        result.emplace_back(i_a, address.port());
+    }
+    co_return result;
+}
 } // namespace rpc
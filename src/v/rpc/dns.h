@@ -11,6 +11,9 @@
 
 #pragma once
 #include "utils/unresolved_address.h"
+
+#include <vector>
+
 namespace rpc {
 /**
  * Resolves addresses using seastar DNS resolver. It uses mutex to workaround
@@ -18,4 +21,11 @@ namespace rpc {
  * different fibers.
  */
 ss::future<ss::socket_address> resolve_dns(unresolved_address);
+
+/**
+ * Resolves all addresses of the host, in the order returned by the resolver.
+ * Used to spread connections across the endpoints of multi-homed services.
+ */
+ss::future<std::vector<ss::socket_address>>
+  resolve_dns_all(unresolved_address);
 } // namespace rpc
@@ -9,7 +9,6 @@
 
 #include "bytes/iobuf.h"
 #include "compression/stream_zstd.h"
-#include "hashing/xx.h"
 #include "reflection/adl.h"
 #include "rpc/types.h"
 #include "vassert.h"
@@ -26,7 +25,8 @@ iobuf header_as_iobuf(const header& h) {
 }
 /// \brief used to send the bytes down the wire
 /// we re-compute the header-checksum on every call
-ss::scattered_message<char> netbuf::as_scattered() && {
+ss::scattered_message<char>
+netbuf::as_scattered(compression_stats* stats) && {
     if (_hdr.correlation_id == 0 || _hdr.meta == 0) {
         throw std::runtime_error(
           "cannot compose scattered view with incomplete header. missing "
@@ -34,20 +34,24 @@ ss::scattered_message<char> netbuf::as_scattered() && {
     }
     if (
       _out.size_bytes() >= _min_compression_bytes
-      && rpc::compression_type::zstd == _hdr.compression) {
+      && rpc::compression_type::zstd == _hdr.compression
+      && (!stats || stats->should_compress())) {
         compression::stream_zstd fn;
-        _out = fn.compress(std::move(_out));
+        auto compressed = fn.compress(_out);
+        if (stats) {
+            stats->record(_out.size_bytes(), compressed.size_bytes());
+        }
+        if (compressed.size_bytes() < _out.size_bytes()) {
+            _out = std::move(compressed);
+        } else {
+            _hdr.compression = rpc::compression_type::none;
+        }
     } else {
         // didn't meet min requirements
         _hdr.compression = rpc::compression_type::none;
     }
-    incremental_xxhash64 h;
-    auto in = iobuf::iterator_consumer(_out.cbegin(), _out.cend());
-    in.consume(_out.size_bytes(), [&h](const char* src, size_t sz) {
-        h.update(src, sz);
-        return ss::stop_iteration::no;
-    });
-    _hdr.payload_checksum = h.digest();
+    _hdr.payload_checksum = payload_checksum(
+      static_cast<payload_checksum_type>(_hdr.version), _out);
     _hdr.payload_size = _out.size_bytes();
     _hdr.header_checksum = rpc::checksum_header_only(_hdr);
     _out.prepend(header_as_iobuf(_hdr));
@@ -12,7 +12,6 @@
 #pragma once
 
 #include "compression/stream_zstd.h"
-#include "hashing/xx.h"
 #include "likely.h"
 #include "reflection/async_adl.h"
 #include "rpc/logger.h"
@@ -65,15 +64,13 @@ parse_header(ss::input_stream<char>& in) {
 
 inline void validate_payload_and_header(const iobuf& io, const header& h) {
     detail::check_out_of_range(io.size_bytes(), h.payload_size);
-    auto in = iobuf::iterator_consumer(io.cbegin(), io.cend());
-    incremental_xxhash64 hasher;
-    size_t consumed = in.consume(
-      io.size_bytes(), [&hasher](const char* src, size_t sz) {
-          hasher.update(src, sz);
-          return ss::stop_iteration::no;
-      });
-    detail::check_out_of_range(consumed, h.payload_size);
-    const auto got_checksum = hasher.digest();
+    if (unlikely(
+          h.version > static_cast<uint8_t>(payload_checksum_type::max))) {
+        throw std::runtime_error(
+          fmt::format("unknown rpc payload checksum type. header: {}", h));
+    }
+    const auto got_checksum = payload_checksum(
+      static_cast<payload_checksum_type>(h.version), io);
     if (h.payload_checksum != got_checksum) {
         throw std::runtime_error(fmt::format(
           "invalid rpc checksum. got:{}, expected:{}",
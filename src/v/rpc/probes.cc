@@ -79,6 +79,19 @@ void server_probe::setup_metrics(
           [this] { return _requests_received - _requests_completed; },
           sm::description(ssx::sformat(
             "{}: Number of requests being processed by server", proto))),
+        sm::make_derive(
+          "output_flushes",
+          [this] { return _output_flushes.flushes; },
+          sm::description(ssx::sformat(
+            "{}: Number of times replies were flushed to the clients",
+            proto))),
+        sm::make_derive(
+          "output_flushed_messages",
+          [this] { return _output_flushes.messages; },
+          sm::description(ssx::sformat(
+            "{}: Number of replies flushed, divided by output_flushes gives "
+            "the replies coalesced per flush",
+            proto))),
       });
 }
 
@@ -181,6 +194,18 @@ void client_probe::setup_metrics(
           sm::description("Number of requests that are blocked because"
                           " of insufficient memory"),
           labels),
+        sm::make_derive(
+          "output_flushes",
+          [this] { return _output_flushes.flushes; },
+          sm::description("Number of times requests were flushed"),
+          labels),
+        sm::make_derive(
+          "output_flushed_messages",
+          [this] { return _output_flushes.messages; },
+          sm::description("Number of requests flushed, divided by "
+                          "output_flushes gives the requests coalesced per "
+                          "flush"),
+          labels),
       });
 }
 
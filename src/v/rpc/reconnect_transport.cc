@@ -9,6 +9,7 @@
 
 #include "rpc/reconnect_transport.h"
 
+#include "config/configuration.h"
 #include "model/timeout_clock.h"
 #include "raft/logger.h"
 #include "rpc/errc.h"
@@ -23,6 +24,9 @@
 
 namespace rpc {
 namespace ch = std::chrono; // NOLINT
+using namespace std::chrono_literals; // NOLINT
+
+static constexpr clock_type::duration max_warm_up_timeout = 10s;
 
 static inline bool has_backoff_expired(
   rpc::clock_type::time_point stamp, clock_type::duration backoff) {
@@ -34,8 +38,49 @@ static inline bool has_backoff_expired(
 }
 
 ss::future<> reconnect_transport::stop() {
+    _warm_up_timer.cancel();
     return _dispatch_gate.close().then([this] { return _transport.stop(); });
 }
+
+void reconnect_transport::reset_backoff() {
+    _backoff_policy.reset();
+    if (config::shard_local_cfg().rpc_client_connection_warm_up()) {
+        _warm_up_timer.cancel();
+        warm_up();
+    }
+}
+
+void reconnect_transport::schedule_warm_up() {
+    if (
+      !config::shard_local_cfg().rpc_client_connection_warm_up()
+      || _dispatch_gate.is_closed()) {
+        return;
+    }
+    _warm_up_timer.rearm(
+      std::max(
+        _stamp + _backoff_policy.current_backoff_duration(),
+        rpc::clock_type::now()));
+}
+
+void reconnect_transport::warm_up() {
+    if (is_valid() || _dispatch_gate.is_closed() || _warm_up_timeout <= 0s) {
+        return;
+    }
+    vlog(
+      rpclog.debug,
+      "reconnecting to {} in the background",
+      _transport.server_address());
+    (void)reconnect(_warm_up_timeout)
+      .discard_result()
+      .handle_exception([addr = _transport.server_address()](
+                          const std::exception_ptr& e) {
+          vlog(
+            rpclog.debug,
+            "error reconnecting to {} in the background: {}",
+            addr,
+            e);
+      });
+}
 ss::future<result<transport*>>
 reconnect_transport::get_connected(clock_type::duration connection_timeout) {
     return get_connected(clock_type::now() + connection_timeout);
@@ -62,6 +107,9 @@ reconnect_transport::reconnect(clock_type::time_point connection_timeout) {
         return ss::make_ready_future<ret_t>(errc::exponential_backoff);
     }
     _stamp = rpc::clock_type::now();
+    // connection_timeout may be clock_type::time_point::max()
+    _warm_up_timeout = std::min<clock_type::duration>(
+      connection_timeout - _stamp, max_warm_up_timeout);
     return with_gate(_dispatch_gate, [this, connection_timeout] {
         return with_semaphore(_connected_sem, 1, [this, connection_timeout] {
             if (is_valid()) {
@@ -80,6 +128,7 @@ reconnect_transport::reconnect(clock_type::time_point connection_timeout) {
                       _backoff_policy.next_backoff();
                       rpclog.trace(
                         "error reconnecting {}", std::current_exception());
+                      schedule_warm_up();
                       return ss::make_ready_future<ret_t>(
                         errc::disconnected_endpoint);
                   }
@@ -19,15 +19,28 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/reactor.hh>
+#include <seastar/core/timer.hh>
 #include <seastar/net/socket_defs.hh>
 
 namespace rpc {
+/**
+ * Transport reconnecting lazily, when a request is sent over a broken
+ * connection, at most once per backoff period.
+ *
+ * With rpc_client_connection_warm_up enabled, a failed connection attempt
+ * schedules another one in the background once the backoff expires, and
+ * resetting the backoff, which is done when a message is received from the
+ * peer, reconnects right away. The connection to a recovering peer, TLS
+ * handshake included, is then established before the first request needs it.
+ */
 class reconnect_transport {
 public:
     explicit reconnect_transport(
       rpc::transport_configuration c, backoff_policy backoff_policy)
       : _transport(std::move(c))
-      , _backoff_policy(std::move(backoff_policy)) {}
+      , _backoff_policy(std::move(backoff_policy)) {
+        _warm_up_timer.set_callback([this] { warm_up(); });
+    }
 
     bool is_valid() const { return _transport.is_valid(); }
 
@@ -44,15 +57,23 @@ public:
         return _transport.server_address();
     }
 
-    void reset_backoff() { _backoff_policy.reset(); }
+    /// resets the backoff, reconnects in the background if warm up is
+    /// enabled
+    void reset_backoff();
 
     ss::future<> stop();
 
 private:
+    void schedule_warm_up();
+    void warm_up();
+
     rpc::transport _transport;
     rpc::clock_type::time_point _stamp{rpc::clock_type::now()};
     ss::semaphore _connected_sem{1};
     ss::gate _dispatch_gate;
     backoff_policy _backoff_policy;
+    ss::timer<rpc::clock_type> _warm_up_timer;
+    /// connection timeout of the last attempt, reused by warm up attempts
+    clock_type::duration _warm_up_timeout{0};
 };
 } // namespace rpc
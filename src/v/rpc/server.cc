@@ -28,7 +28,9 @@ namespace rpc {
 
 server::server(server_configuration c)
   : cfg(std::move(c))
-  , _memory(cfg.max_service_memory_per_core) {}
+  , _memory(cfg.max_service_memory_per_core)
+  , _high_priority_memory(cfg.max_high_priority_memory_per_core.value_or(
+      cfg.max_service_memory_per_core / 10)) {}
 
 server::server(ss::sharded<server_configuration>* s)
   : server(s->local()) {}
@@ -47,6 +49,10 @@ void server::start() {
             ss::listen_options lo;
             lo.reuse_address = true;
             lo.lba = cfg.load_balancing_algo;
+            if (endpoint.shard) {
+                lo.lba = ss::server_socket::load_balancing_algorithm::fixed;
+                lo.fixed_cpu = *endpoint.shard;
+            }
             if (cfg.listen_backlog.has_value()) {
                 lo.listen_backlog = cfg.listen_backlog.value();
             }
@@ -216,7 +222,7 @@ void server::setup_metrics() {
            ssx::sformat("{}: Maximum memory allowed for RPC", cfg.name))),
        sm::make_total_bytes(
          "consumed_mem_bytes",
-         [this] { return cfg.max_service_memory_per_core - _memory.current(); },
+         [this] { return memory_in_use(); },
          sm::description(ssx::sformat(
            "{}: Memory consumed by request processing", cfg.name))),
        sm::make_histogram(
@@ -42,6 +42,10 @@ public:
 
         server_probe& probe() { return _s->_probe; }
         ss::semaphore& memory() { return _s->_memory; }
+        ss::semaphore& memory(method_priority p) {
+            return p == method_priority::high ? _s->_high_priority_memory
+                                              : _s->_memory;
+        }
         hdr_hist& hist() { return _s->_hist; }
         ss::gate& conn_gate() { return _s->_conn_gate; }
         ss::abort_source& abort_source() { return _s->_as; }
@@ -95,6 +99,10 @@ public:
 
     const server_configuration cfg; // NOLINT
     const hdr_hist& histogram() const { return _hist; }
+    /// Memory taken from max_service_memory_per_core by inflight requests
+    size_t memory_in_use() const {
+        return cfg.max_service_memory_per_core - _memory.current();
+    }
 
 private:
     struct listener {
@@ -112,6 +120,7 @@ private:
 
     std::unique_ptr<protocol> _proto;
     ss::semaphore _memory;
+    ss::semaphore _high_priority_memory;
     std::vector<std::unique_ptr<listener>> _listeners;
     boost::intrusive::list<connection> _connections;
     ss::abort_source _as;
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "rpc/batched_output_stream.h"
 #include "seastarx.h"
 
 #include <seastar/core/metrics_registration.hh>
@@ -34,6 +35,8 @@ public:
 
     void add_bytes_received(size_t recv) { _in_bytes += recv; }
 
+    flush_stats& output_flushes() { return _output_flushes; }
+
     void request_received() { ++_requests_received; }
 
     void request_completed() { ++_requests_completed; }
@@ -60,6 +63,7 @@ private:
     uint32_t _corrupted_headers = 0;
     uint32_t _method_not_found_errors = 0;
     uint32_t _requests_blocked_memory = 0;
+    flush_stats _output_flushes;
     friend std::ostream& operator<<(std::ostream& o, const server_probe& p);
 };
 
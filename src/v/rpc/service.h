@@ -60,27 +60,49 @@ struct service::execution_helper {
       ss::input_stream<char>& in,
       streaming_context& ctx,
       uint32_t method_id,
+      method_probes& probes,
       Func&& f) {
+        using clock_type = request_timeline::clock_type;
+        request_timeline t{.received = clock_type::now()};
         return ctx.permanent_memory_reservation(ctx.get_header().payload_size)
-          .then([f = std::forward<Func>(f), method_id, &in, &ctx]() mutable {
+          .then([f = std::forward<Func>(f),
+                 method_id,
+                 &in,
+                 &ctx,
+                 &probes,
+                 t]() mutable {
+              t.admitted = clock_type::now();
               return parse_type<Input>(in, ctx.get_header())
                 .then_wrapped([f = std::forward<Func>(f),
-                               &ctx](ss::future<Input> input_f) mutable {
+                               method_id,
+                               &ctx,
+                               &probes,
+                               t](ss::future<Input> input_f) mutable {
                     if (input_f.failed()) {
                         throw rpc_internal_body_parsing_exception(
                           input_f.get_exception());
                     }
                     ctx.signal_body_parse();
                     auto input = input_f.get0();
-                    return f(std::move(input), ctx);
-                })
-                .then([method_id](Output out) mutable {
-                    auto b = std::make_unique<netbuf>();
-                    auto raw_b = b.get();
-                    raw_b->set_service_method_id(method_id);
-                    return reflection::async_adl<Output>{}
-                      .to(raw_b->buffer(), std::move(out))
-                      .then([b = std::move(b)] { return std::move(*b); });
+                    t.parsed = clock_type::now();
+                    return f(std::move(input), ctx)
+                      .then([method_id, &ctx, &probes, t](Output out) mutable {
+                          t.serviced = clock_type::now();
+                          auto b = std::make_unique<netbuf>();
+                          auto raw_b = b.get();
+                          raw_b->set_service_method_id(method_id);
+                          return reflection::async_adl<Output>{}
+                            .to(raw_b->buffer(), std::move(out))
+                            .then([b = std::move(b),
+                                   method_id,
+                                   &ctx,
+                                   &probes,
+                                   t]() mutable {
+                                t.serialized = clock_type::now();
+                                probes.record(method_id, ctx, t);
+                                return std::move(*b);
+                            });
+                      });
                 });
           });
     }
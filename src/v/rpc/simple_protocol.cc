@@ -24,8 +24,9 @@ struct server_context_impl final : streaming_context {
         res.probe().request_received();
     }
     ss::future<ss::semaphore_units<>> reserve_memory(size_t ask) final {
-        auto fut = get_units(res.memory(), ask);
-        if (res.memory().waiters()) {
+        auto& memory = res.memory(priority);
+        auto fut = get_units(memory, ask);
+        if (memory.waiters()) {
             res.probe().waiting_for_available_memory();
         }
         return fut;
@@ -33,9 +34,13 @@ struct server_context_impl final : streaming_context {
     ~server_context_impl() override { res.probe().request_completed(); }
     const header& get_header() const final { return hdr; }
     void signal_body_parse() final { pr.set_value(); }
+    std::optional<ss::socket_address> peer_address() const final {
+        return res.conn->addr;
+    }
     server::resources res;
     header hdr;
     ss::promise<> pr;
+    method_priority priority = method_priority::normal;
 };
 
 ss::future<> simple_protocol::apply(server::resources rs) {
@@ -63,6 +68,9 @@ send_reply(ss::lw_shared_ptr<server_context_impl> ctx, netbuf buf) {
     buf.set_min_compression_bytes(1024);
     buf.set_compression(rpc::compression_type::zstd);
     buf.set_correlation_id(ctx->get_header().correlation_id);
+    // the client understands the checksum it used
+    buf.set_payload_checksum_type(
+      static_cast<payload_checksum_type>(ctx->get_header().version));
 
     auto view = std::move(buf).as_scattered();
     if (ctx->res.conn_gate().is_closed()) {
@@ -107,8 +115,13 @@ simple_protocol::dispatch_method_once(header h, server::resources rs) {
         }
 
         method* m = it->get()->method_from_id(method_id);
+        ctx->priority = m->priority;
 
-        return m->handle(ctx->res.conn->input(), *ctx)
+        // the request is parsed and handled with the cpu shares of its
+        // service, not the ones of the connection read loop
+        return ss::with_scheduling_group(
+                 it->get()->get_scheduling_group(),
+                 [m, ctx] { return m->handle(ctx->res.conn->input(), *ctx); })
           .then_wrapped([ctx, m, l = ctx->res.hist().auto_measure(), rs](
                           ss::future<netbuf> fut) mutable {
               netbuf reply_buf;
@@ -44,3 +44,48 @@ SEASTAR_THREAD_TEST_CASE(netbuf_pod) {
     BOOST_REQUIRE_EQUAL(src.y, dst.y);
     BOOST_REQUIRE_EQUAL(src.z, dst.z);
 }
+
+SEASTAR_THREAD_TEST_CASE(compression_stats_skip_incompressible) {
+    rpc::compression_stats stats;
+    BOOST_REQUIRE(stats.should_compress());
+    // payloads do not shrink
+    for (int i = 0; i < 20; ++i) {
+        stats.record(4096, 4100);
+    }
+    uint32_t compressed = 0;
+    for (uint32_t i = 0; i < rpc::compression_stats::probe_interval * 4; ++i) {
+        if (stats.should_compress()) {
+            ++compressed;
+        }
+    }
+    // only the probes are compressed
+    BOOST_REQUIRE_EQUAL(compressed, 4);
+
+    // payloads became compressible again
+    for (int i = 0; i < 20; ++i) {
+        stats.record(4096, 1024);
+    }
+    BOOST_REQUIRE(stats.should_compress());
+}
+
+SEASTAR_THREAD_TEST_CASE(netbuf_crc32c_payload_checksum) {
+    for (auto type :
+         {rpc::payload_checksum_type::crc32c,
+          rpc::payload_checksum_type::none}) {
+        auto n = rpc::netbuf();
+        pod src;
+        src.x = 11;
+        src.y = 22;
+        src.z = 33;
+        n.set_correlation_id(42);
+        n.set_service_method_id(66);
+        n.set_payload_checksum_type(type);
+        reflection::async_adl<pod>{}.to(n.buffer(), std::move(src)).get();
+        auto bufs = std::move(n).as_scattered().release().release();
+        auto in = make_iobuf_input_stream(iobuf(std::move(bufs)));
+        const pod dst = rpc::parse_framed<pod>(in).get0();
+        BOOST_REQUIRE_EQUAL(src.x, dst.x);
+        BOOST_REQUIRE_EQUAL(src.y, dst.y);
+        BOOST_REQUIRE_EQUAL(src.z, dst.z);
+    }
+}
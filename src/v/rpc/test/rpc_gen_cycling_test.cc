@@ -7,12 +7,15 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "config/configuration.h"
 #include "model/timeout_clock.h"
 #include "random/generators.h"
 #include "rpc/exceptions.h"
+#include "rpc/reconnect_transport.h"
 #include "rpc/test/rpc_gen_types.h"
 #include "rpc/test/rpc_integration_fixture.h"
 #include "rpc/types.h"
+#include "test_utils/async.h"
 #include "test_utils/fixture.h"
 
 #include <seastar/core/condition-variable.hh>
@@ -414,3 +417,35 @@ FIXTURE_TEST(corrupted_data_at_server, rpc_integration_fixture) {
         BOOST_REQUIRE_EQUAL(echo_resp_new.value().data.str, "testing...");
     }
 }
+
+FIXTURE_TEST(reconnect_warm_up, rpc_integration_fixture) {
+    config::shard_local_cfg().rpc_client_connection_warm_up.set_value(true);
+    auto reset_cfg = ss::defer([] {
+        config::shard_local_cfg().rpc_client_connection_warm_up.set_value(
+          false);
+    });
+    rpc::reconnect_transport t(
+      client_config(),
+      rpc::make_exponential_backoff_policy<rpc::clock_type>(10ms, 100ms));
+    auto dt = ss::defer([&t] { t.stop().get(); });
+
+    BOOST_TEST_MESSAGE("Connecting to a server which is not started");
+    BOOST_REQUIRE(!t.get_connected(1s).get0());
+
+    configure_server();
+    register_services();
+    start_server();
+
+    BOOST_TEST_MESSAGE("Waiting for the background reconnect");
+    tests::cooperative_spin_wait_with_timeout(10s, [&t] {
+        return t.is_valid();
+    }).get();
+
+    auto client = echo::echo_client_protocol(t.get());
+    auto echo_resp = client
+                       .echo(
+                         echo::echo_req{.str = "testing..."},
+                         rpc::client_opts(rpc::clock_type::now() + 2s))
+                       .get0();
+    BOOST_REQUIRE_EQUAL(echo_resp.value().data.str, "testing...");
+}
@@ -0,0 +1,191 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "config/tls_config.h"
+#include "model/timeout_clock.h"
+#include "random/generators.h"
+#include "rpc/test/rpc_integration_fixture.h"
+#include "rpc/types.h"
+#include "units.h"
+#include "utils/hdr_hist.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <boost/range/irange.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals; // NOLINT
+
+static constexpr uint16_t bench_port = 32147;
+// every iteration sends about this many payload bytes, at least one request
+// per stream and at most max_requests_per_iteration requests
+static constexpr size_t bytes_per_iteration = 64_MiB;
+static constexpr size_t max_requests_per_iteration = 256;
+
+static ss::tls::credentials_builder bench_credentials() {
+    return config::tls_config(
+             true,
+             config::key_cert{"redpanda.key", "redpanda.crt"},
+             "root_certificate_authority.chain_cert",
+             false)
+      .get_credentials_builder()
+      .get0()
+      .value();
+}
+
+/// Measures echo round trips of `payload` bytes over `connections` client
+/// connections, each one carrying `streams` concurrent requests. Payloads are
+/// compressed with `compression`, connections are encrypted if `tls` is set.
+///
+/// Every scenario prints a single JSON line summarizing the latency of the
+/// round trips, so that runs of different builds can be collected and
+/// compared by scripts.
+template<
+  size_t payload,
+  rpc::compression_type compression,
+  bool tls,
+  size_t connections,
+  size_t streams>
+struct rpc_roundtrip_bench : rpc_simple_integration_fixture {
+    using client_t = rpc::client<echo::echo_client_protocol>;
+
+    static constexpr size_t requests_per_iteration = std::max(
+      connections * streams,
+      std::min(
+        max_requests_per_iteration,
+        std::max<size_t>(bytes_per_iteration / payload, 1)));
+
+    rpc_roundtrip_bench()
+      : rpc_simple_integration_fixture(bench_port)
+      , _payload(random_generators::gen_alphanum_string(payload)) {
+        std::optional<ss::tls::credentials_builder> creds;
+        if constexpr (tls) {
+            creds = bench_credentials();
+        }
+        configure_server(creds);
+        register_service<echo_impl>();
+        start_server();
+        _clients.reserve(connections);
+        for (size_t i = 0; i < connections; ++i) {
+            auto& cli = _clients.emplace_back(
+              std::make_unique<client_t>(client_config(creds)));
+            cli->connect(model::no_timeout).get();
+        }
+    }
+
+    ~rpc_roundtrip_bench() override {
+        fmt::print(
+          "{{\"payload_bytes\": {}, \"compression\": \"{}\", \"tls\": {}, "
+          "\"connections\": {}, \"streams\": {}, \"requests\": {}, "
+          "\"errors\": {}, \"p50_us\": {}, \"p99_us\": {}, \"p999_us\": {}, "
+          "\"max_us\": {}}}\n",
+          payload,
+          compression == rpc::compression_type::zstd ? "zstd" : "none",
+          tls,
+          connections,
+          streams,
+          _requests,
+          _errors,
+          _hist.get_value_at(50),
+          _hist.get_value_at(99),
+          _hist.get_value_at(99.9),
+          _hist.get_value_at(100));
+        for (auto& cli : _clients) {
+            cli->stop().get();
+        }
+    }
+
+    ss::future<size_t> run() {
+        perf_tests::start_measuring_time();
+        co_await ss::parallel_for_each(
+          boost::irange<size_t>(0, connections * streams), [this](size_t s) {
+              return stream(*_clients[s % connections], s);
+          });
+        perf_tests::stop_measuring_time();
+        co_return requests_per_iteration;
+    }
+
+private:
+    /// sends the requests of stream `s` one after the other
+    ss::future<> stream(client_t& cli, size_t s) {
+        const auto stride = connections * streams;
+        for (size_t i = s; i < requests_per_iteration; i += stride) {
+            auto m = _hist.auto_measure();
+            auto r = co_await cli.echo(
+              echo::echo_req{.str = _payload},
+              rpc::client_opts(rpc::clock_type::now() + 30s, compression, 0));
+            ++_requests;
+            if (!r) {
+                ++_errors;
+            }
+        }
+    }
+
+    ss::sstring _payload;
+    std::vector<std::unique_ptr<client_t>> _clients;
+    hdr_hist _hist;
+    size_t _requests{0};
+    size_t _errors{0};
+};
+
+static constexpr auto none = rpc::compression_type::none;
+static constexpr auto zstd = rpc::compression_type::zstd;
+
+// payload sizes over a single connection
+using plain_64B = rpc_roundtrip_bench<64, none, false, 1, 1>;
+using plain_4KiB = rpc_roundtrip_bench<4_KiB, none, false, 1, 1>;
+using plain_128KiB = rpc_roundtrip_bench<128_KiB, none, false, 1, 1>;
+using plain_1MiB = rpc_roundtrip_bench<1_MiB, none, false, 1, 1>;
+using plain_8MiB = rpc_roundtrip_bench<8_MiB, none, false, 1, 1>;
+// compression
+using zstd_4KiB = rpc_roundtrip_bench<4_KiB, zstd, false, 1, 1>;
+using zstd_1MiB = rpc_roundtrip_bench<1_MiB, zstd, false, 1, 1>;
+using zstd_8MiB = rpc_roundtrip_bench<8_MiB, zstd, false, 1, 1>;
+// encryption
+using tls_64B = rpc_roundtrip_bench<64, none, true, 1, 1>;
+using tls_128KiB = rpc_roundtrip_bench<128_KiB, none, true, 1, 1>;
+using tls_8MiB = rpc_roundtrip_bench<8_MiB, none, true, 1, 1>;
+// concurrent streams multiplexed over a single connection
+using plain_64B_streams_16 = rpc_roundtrip_bench<64, none, false, 1, 16>;
+using plain_128KiB_streams_16
+  = rpc_roundtrip_bench<128_KiB, none, false, 1, 16>;
+using tls_4KiB_streams_16 = rpc_roundtrip_bench<4_KiB, none, true, 1, 16>;
+// many connections
+using plain_64B_connections_16 = rpc_roundtrip_bench<64, none, false, 16, 1>;
+using plain_4KiB_connections_16_streams_4
+  = rpc_roundtrip_bench<4_KiB, none, false, 16, 4>;
+using tls_128KiB_connections_16
+  = rpc_roundtrip_bench<128_KiB, none, true, 16, 1>;
+using zstd_128KiB_connections_4_streams_4
+  = rpc_roundtrip_bench<128_KiB, zstd, false, 4, 4>;
+
+PERF_TEST_F(plain_64B, echo) { return run(); }
+PERF_TEST_F(plain_4KiB, echo) { return run(); }
+PERF_TEST_F(plain_128KiB, echo) { return run(); }
+PERF_TEST_F(plain_1MiB, echo) { return run(); }
+PERF_TEST_F(plain_8MiB, echo) { return run(); }
+PERF_TEST_F(zstd_4KiB, echo) { return run(); }
+PERF_TEST_F(zstd_1MiB, echo) { return run(); }
+PERF_TEST_F(zstd_8MiB, echo) { return run(); }
+PERF_TEST_F(tls_64B, echo) { return run(); }
+PERF_TEST_F(tls_128KiB, echo) { return run(); }
+PERF_TEST_F(tls_8MiB, echo) { return run(); }
+PERF_TEST_F(plain_64B_streams_16, echo) { return run(); }
+PERF_TEST_F(plain_128KiB_streams_16, echo) { return run(); }
+PERF_TEST_F(tls_4KiB_streams_16, echo) { return run(); }
+PERF_TEST_F(plain_64B_connections_16, echo) { return run(); }
+PERF_TEST_F(plain_4KiB_connections_16_streams_4, echo) { return run(); }
+PERF_TEST_F(tls_128KiB_connections_16, echo) { return run(); }
+PERF_TEST_F(zstd_128KiB_connections_4_streams_4, echo) { return run(); }
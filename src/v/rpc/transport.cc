@@ -9,6 +9,7 @@
 
 #include "rpc/transport.h"
 
+#include "config/configuration.h"
 #include "likely.h"
 #include "rpc/dns.h"
 #include "rpc/logger.h"
@@ -60,6 +61,11 @@ transport::transport(
     .credentials = std::move(c.credentials),
   })
   , _memory(c.max_queued_bytes) {
+    if (is_tls() && config::shard_local_cfg().rpc_skip_tls_payload_checksum()) {
+        _payload_checksum = payload_checksum_type::none;
+    } else if (config::shard_local_cfg().rpc_crc32c_payload_checksum()) {
+        _payload_checksum = payload_checksum_type::crc32c;
+    }
     if (!c.disable_metrics) {
         setup_metrics(service_name);
     }
@@ -103,7 +109,10 @@ ss::future<> base_transport::do_connect(clock_type::time_point timeout) {
         // Never implicitly destroy a live output stream here: output streams
         // are only safe to destroy after/during stop()
         vassert(!_out.is_valid(), "destroyed output_stream without stopping");
-        _out = batched_output_stream(_fd->output());
+        _out = batched_output_stream(
+          _fd->output(),
+          batched_output_stream::default_max_unflushed_bytes,
+          &_probe.output_flushes());
     } catch (...) {
         auto e = std::current_exception();
         _probe.connection_error(e);
@@ -294,7 +303,7 @@ void transport::dispatch_send() {
               _last_seq = it->first;
               auto buffer = std::move(it->second->buffer).get();
               auto units = std::move(it->second->resource_units);
-              auto v = std::move(*buffer).as_scattered();
+              auto v = std::move(*buffer).as_scattered(&_compression_stats);
               auto msg_size = v.size();
               _requests_queue.erase(it->first);
               return _out.write(std::move(v))
@@ -358,6 +367,26 @@ void transport::setup_metrics(const std::optional<ss::sstring>& service_name) {
     _probe.setup_metrics(_metrics, service_name, server_address());
 }
 
+void transport::log_if_slow(
+  uint32_t method_id,
+  const header& reply,
+  request_timeline::clock_type::time_point started) const {
+    const auto total = std::chrono::duration_cast<std::chrono::microseconds>(
+      request_timeline::clock_type::now() - started);
+    if (likely(
+          total
+          < config::shard_local_cfg().rpc_slow_request_log_threshold_ms())) {
+        return;
+    }
+    vlog(
+      rpclog.info,
+      "slow request to {}, method: {}, correlation_id: {}, total: {}us",
+      server_address(),
+      method_id,
+      reply.correlation_id,
+      total.count());
+}
+
 transport::~transport() {
     vlog(rpclog.debug, "RPC Client probes: {}", _probe);
     vassert(
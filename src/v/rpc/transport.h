@@ -67,6 +67,8 @@ public:
 
     const unresolved_address& server_address() const { return _server_addr; }
 
+    bool is_tls() const { return _creds != nullptr; }
+
 protected:
     virtual void fail_outstanding_futures() {}
 
@@ -118,6 +120,12 @@ private:
     ss::future<> dispatch(header);
     void fail_outstanding_futures() noexcept final;
     void setup_metrics(const std::optional<ss::sstring>&);
+    /// logs requests slower than rpc_slow_request_log_threshold_ms with the
+    /// correlation id the server logs them with
+    void log_if_slow(
+      uint32_t method_id,
+      const header& reply,
+      request_timeline::clock_type::time_point started) const;
 
     ss::future<result<std::unique_ptr<streaming_context>>>
       do_send(sequence_t, netbuf, rpc::client_opts);
@@ -139,6 +147,8 @@ private:
     requests_queue_t _requests_queue;
     sequence_t _seq;
     sequence_t _last_seq;
+    compression_stats _compression_stats;
+    payload_checksum_type _payload_checksum{payload_checksum_type::xxhash_64};
     friend std::ostream& operator<<(std::ostream&, const transport&);
 };
 
@@ -179,23 +189,28 @@ transport::send_typed(Input r, uint32_t method_id, rpc::client_opts opts) {
     auto b = std::make_unique<rpc::netbuf>();
     b->set_compression(opts.compression);
     b->set_min_compression_bytes(opts.min_compression_bytes);
+    b->set_payload_checksum_type(_payload_checksum);
     auto raw_b = b.get();
     raw_b->set_service_method_id(method_id);
 
     auto& target_buffer = raw_b->buffer();
     auto seq = ++_seq;
+    const auto started = request_timeline::clock_type::now();
     return reflection::async_adl<Input>{}
       .to(target_buffer, std::move(r))
       .then([this, b = std::move(b), seq, opts = std::move(opts)]() mutable {
           return do_send(seq, std::move(*b.get()), std::move(opts));
       })
-      .then([this](result<std::unique_ptr<streaming_context>> sctx) mutable {
+      .then([this, method_id, started](
+              result<std::unique_ptr<streaming_context>> sctx) mutable {
           if (!sctx) {
               return ss::make_ready_future<ret_t>(sctx.error());
           }
           return parse_type<Output>(_in, sctx.value()->get_header())
-            .then([sctx = std::move(sctx)](Output o) {
+            .then([this, sctx = std::move(sctx), method_id, started](
+                    Output o) {
                 sctx.value()->signal_body_parse();
+                log_if_slow(method_id, sctx.value()->get_header(), started);
                 return internal::map_result<Output>(
                   sctx.value()->get_header(), std::move(o));
             });
@@ -9,13 +9,18 @@
 
 #include "rpc/types.h"
 
+#include "config/configuration.h"
 #include "hashing/crc32c.h"
+#include "hashing/xx.h"
 #include "reflection/for_each_field.h"
+#include "rpc/logger.h"
+#include "vlog.h"
 
 #include <seastar/core/byteorder.hh>
 
 #include <boost/crc.hpp>
 #include <fmt/format.h>
+#include <fmt/ostream.h>
 
 #include <ostream>
 
@@ -28,6 +33,9 @@ void crc_one(crc::crc32c& crc, T t) {
 
 uint32_t checksum_header_only(const header& h) {
     auto crc = crc::crc32c();
+    if (h.version != 0) {
+        crc_one(crc, h.version);
+    }
     crc_one(
       crc,
       static_cast<std::underlying_type_t<compression_type>>(h.compression));
@@ -38,6 +46,67 @@ uint32_t checksum_header_only(const header& h) {
     return crc.value();
 }
 
+uint64_t payload_checksum(payload_checksum_type type, const iobuf& io) {
+    auto in = iobuf::iterator_consumer(io.cbegin(), io.cend());
+    switch (type) {
+    case payload_checksum_type::xxhash_64: {
+        incremental_xxhash64 h;
+        in.consume(io.size_bytes(), [&h](const char* src, size_t sz) {
+            h.update(src, sz);
+            return ss::stop_iteration::no;
+        });
+        return h.digest();
+    }
+    case payload_checksum_type::crc32c: {
+        crc::crc32c crc;
+        in.consume(io.size_bytes(), [&crc](const char* src, size_t sz) {
+            crc.extend(src, sz);
+            return ss::stop_iteration::no;
+        });
+        return crc.value();
+    }
+    case payload_checksum_type::none:
+        return 0;
+    }
+    throw std::runtime_error(
+      fmt::format("unknown rpc payload checksum type: {}", int(type)));
+}
+
+void method_probes::record(
+  uint32_t method_id,
+  const streaming_context& ctx,
+  const request_timeline& t) {
+    auto micros = [](request_timeline::clock_type::duration d) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(d);
+    };
+    const auto queued = micros(t.admitted - t.received);
+    const auto parsed = micros(t.parsed - t.admitted);
+    const auto serviced = micros(t.serviced - t.parsed);
+    const auto serialized = micros(t.serialized - t.serviced);
+    _queue_hist.record(queued.count());
+    _serialization_hist.record((parsed + serialized).count());
+    _service_hist.record(serviced.count());
+
+    const auto total = micros(t.serialized - t.received);
+    if (unlikely(
+          total
+          >= config::shard_local_cfg().rpc_slow_request_log_threshold_ms())) {
+        auto peer = ctx.peer_address();
+        vlog(
+          rpclog.info,
+          "slow request from {}, method: {}, correlation_id: {}, total: {}us, "
+          "queued: {}us, parsed: {}us, serviced: {}us, serialized: {}us",
+          peer ? fmt::format("{}", *peer) : "unknown",
+          method_id,
+          ctx.get_header().correlation_id,
+          total.count(),
+          queued.count(),
+          parsed.count(),
+          serviced.count(),
+          serialized.count());
+    }
+}
+
 std::ostream& operator<<(std::ostream& o, const header& h) {
     // NOTE: if we use the int8_t types, ostream doesn't print 0's
     // artificially ast version and compression as ints
@@ -55,6 +124,9 @@ std::ostream& operator<<(std::ostream& o, const server_configuration& c) {
         o << a;
     }
     o << ", max_service_memory_per_core: " << c.max_service_memory_per_core
+      << ", max_high_priority_memory_per_core: "
+      << c.max_high_priority_memory_per_core.value_or(
+           c.max_service_memory_per_core / 10)
       << ", metrics_enabled:" << !c.disable_metrics;
     return o << "}";
 }
@@ -71,6 +143,9 @@ std::ostream& operator<<(std::ostream& os, const server_endpoint& ep) {
       ep.name,
       ep.addr,
       ep.credentials ? "SECURED" : "PLAINTEXT");
+    if (ep.shard) {
+        fmt::print(os, "@{}", *ep.shard);
+    }
     return os;
 }
 
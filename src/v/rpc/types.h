@@ -31,6 +31,7 @@
 #include <seastar/util/bool_class.hh>
 #include <seastar/util/noncopyable_function.hh>
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <iosfwd>
@@ -54,6 +55,20 @@ enum class compression_type : uint8_t {
     max = zstd,
 };
 
+/// \brief checksum of the payload, carried in header::version. clients use
+/// the one they are configured with, servers reply with the checksum type of
+/// the request
+enum class payload_checksum_type : uint8_t {
+    xxhash_64 = 0,
+    /// hardware accelerated crc32c
+    crc32c = 1,
+    /// payload is not checksummed, only used over TLS which already protects
+    /// its integrity
+    none = 2,
+    min = xxhash_64,
+    max = none,
+};
+
 struct negotiation_frame {
     int8_t version = 0;
     /// \brief 0 - no compression
@@ -71,7 +86,9 @@ enum class status : uint32_t {
 
 /// \brief core struct for communications. sent with _each_ payload
 struct header {
-    /// \brief version is unused. always 0. can be used for bitflags as well
+    /// \brief payload_checksum_type used by payload_checksum. 0 (xxhash64)
+    /// for peers which don't know about checksum types. when it isn't 0 it is
+    /// covered by the header checksum
     uint8_t version{0};
     /// \brief everything below the checksum is hashed with crc32
     uint32_t header_checksum{0};
@@ -85,7 +102,7 @@ struct header {
     /// \brief every client/tcp connection will need to match
     /// the ss::future<> that dispatched the method
     uint32_t correlation_id{0};
-    /// \brief xxhash64
+    /// \brief checksum of the payload, see version
     uint64_t payload_checksum{0};
 };
 
@@ -103,6 +120,9 @@ static_assert(
 
 uint32_t checksum_header_only(const header& h);
 
+/// \brief checksum of the payload according to the header version
+uint64_t payload_checksum(payload_checksum_type, const iobuf&);
+
 struct client_opts {
     using resource_units_t
       = ss::foreign_ptr<ss::lw_shared_ptr<std::vector<ss::semaphore_units<>>>>;
@@ -156,6 +176,10 @@ public:
     /// \brief because we parse the input as a _stream_ we need to signal
     /// to the dispatching thread that it can resume parsing for a new RPC
     virtual void signal_body_parse() = 0;
+    /// \brief remote end of the connection, when known
+    virtual std::optional<ss::socket_address> peer_address() const {
+        return std::nullopt;
+    }
 
     /// \brief keep these units until destruction of context.
     /// usually, we want to keep the reservation of the memory size permanently
@@ -171,17 +195,54 @@ private:
     std::vector<ss::semaphore_units<>> _reservations;
 };
 
+/**
+ * Tracks how much the payloads sent over a connection shrink when they are
+ * compressed. Once they stop shrinking by at least min_savings compression is
+ * skipped, only every probe_interval-th payload is still compressed to notice
+ * when the payloads become compressible again.
+ */
+class compression_stats {
+public:
+    static constexpr double min_savings = 0.1;
+    static constexpr uint32_t probe_interval = 64;
+
+    bool should_compress() {
+        if (_ratio <= 1.0 - min_savings) {
+            return true;
+        }
+        return ++_skipped % probe_interval == 0;
+    }
+
+    void record(size_t uncompressed, size_t compressed) {
+        static constexpr double alpha = 0.2;
+        auto ratio = static_cast<double>(compressed)
+                     / static_cast<double>(std::max<size_t>(uncompressed, 1));
+        _ratio = (1.0 - alpha) * _ratio + alpha * ratio;
+        _skipped = 0;
+    }
+
+    /// moving average of compressed to uncompressed size
+    double ratio() const { return _ratio; }
+
+private:
+    double _ratio{0};
+    uint32_t _skipped{0};
+};
+
 class netbuf {
 public:
     /// \brief used to send the bytes down the wire
-    /// we re-compute the header-checksum on every call
-    ss::scattered_message<char> as_scattered() &&;
+    /// we re-compute the header-checksum on every call. payloads are sent
+    /// uncompressed when compression doesn't make them smaller or when the
+    /// stats of the connection says it doesn't pay off
+    ss::scattered_message<char> as_scattered(compression_stats* = nullptr) &&;
 
     void set_status(rpc::status);
     void set_correlation_id(uint32_t);
     void set_compression(rpc::compression_type c);
     void set_service_method_id(uint32_t);
     void set_min_compression_bytes(size_t);
+    void set_payload_checksum_type(payload_checksum_type);
     iobuf& buffer();
 
 private:
@@ -206,17 +267,53 @@ inline void netbuf::set_service_method_id(uint32_t x) { _hdr.meta = x; }
 inline void netbuf::set_min_compression_bytes(size_t min) {
     _min_compression_bytes = min;
 }
+inline void netbuf::set_payload_checksum_type(payload_checksum_type t) {
+    _hdr.version = static_cast<uint8_t>(t);
+}
+
+/// \brief points in time a request handled by a service method went through
+struct request_timeline {
+    using clock_type = hdr_hist::clock_type;
+    clock_type::time_point received;
+    /// memory for the request was reserved
+    clock_type::time_point admitted;
+    clock_type::time_point parsed;
+    /// the method handler returned its reply
+    clock_type::time_point serviced;
+    clock_type::time_point serialized;
+};
 
 class method_probes {
 public:
     hdr_hist& latency_hist() { return _latency_hist; }
     const hdr_hist& latency_hist() const { return _latency_hist; }
+    /// waiting for memory admission
+    const hdr_hist& queue_hist() const { return _queue_hist; }
+    /// reading and parsing the request, serializing the reply
+    const hdr_hist& serialization_hist() const { return _serialization_hist; }
+    /// in the method handler
+    const hdr_hist& service_hist() const { return _service_hist; }
+
+    /// records the phases of a request, requests slower than
+    /// rpc_slow_request_log_threshold_ms are logged with the correlation id
+    /// the client logs them with
+    void record(
+      uint32_t method_id, const streaming_context&, const request_timeline&);
 
 private:
-    // roughly 2024 bytes
+    // roughly 2024 bytes each
     hdr_hist _latency_hist{120s, 1ms};
+    hdr_hist _queue_hist{120s, 1ms};
+    hdr_hist _serialization_hist{120s, 1ms};
+    hdr_hist _service_hist{120s, 1ms};
 };
 
+/// \brief declared per method in the service definition. Small latency
+/// sensitive requests, like raft heartbeats and votes, are high priority: they
+/// are admitted with a memory budget of their own and never wait behind bulk
+/// requests
+enum class method_priority : uint8_t { normal, high };
+
 /// \brief most method implementations will be codegenerated
 /// by $root/tools/rpcgen.py
 struct method {
@@ -225,9 +322,11 @@ struct method {
 
     handler handle;
     method_probes probes;
+    method_priority priority;
 
-    explicit method(handler h)
-      : handle(std::move(h)) {}
+    explicit method(handler h, method_priority p = method_priority::normal)
+      : handle(std::move(h))
+      , priority(p) {}
 };
 
 /// \brief used in returned types for client::send_typed() calls
@@ -253,6 +352,9 @@ struct server_endpoint {
     ss::sstring name;
     ss::socket_address addr;
     ss::shared_ptr<ss::tls::server_credentials> credentials;
+    // when set the connections are accepted on this shard only, otherwise
+    // they are spread across all the shards
+    std::optional<ss::shard_id> shard;
 
     server_endpoint(ss::sstring name, ss::socket_address addr)
       : name(std::move(name))
@@ -266,6 +368,16 @@ struct server_endpoint {
       , addr(addr)
       , credentials(std::move(creds)) {}
 
+    server_endpoint(
+      ss::sstring name,
+      ss::socket_address addr,
+      ss::shared_ptr<ss::tls::server_credentials> creds,
+      ss::shard_id shard)
+      : name(std::move(name))
+      , addr(addr)
+      , credentials(std::move(creds))
+      , shard(shard) {}
+
     server_endpoint(
       ss::socket_address addr,
       ss::shared_ptr<ss::tls::server_credentials> creds)
@@ -278,6 +390,9 @@ struct server_endpoint {
 struct server_configuration {
     std::vector<server_endpoint> addrs;
     int64_t max_service_memory_per_core;
+    /// memory reserved for high priority methods on top of
+    /// max_service_memory_per_core, defaults to a tenth of it
+    std::optional<int64_t> max_high_priority_memory_per_core;
     std::optional<int> listen_backlog;
     std::optional<int> tcp_recv_buf;
     std::optional<int> tcp_send_buf;
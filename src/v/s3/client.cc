@@ -13,6 +13,8 @@
 #include "bytes/iobuf.h"
 #include "bytes/iobuf_istreambuf.h"
 #include "hashing/secure.h"
+#include "http/chunk_encoding.h"
+#include "rpc/dns.h"
 #include "rpc/types.h"
 #include "s3/error.h"
 #include "s3/logger.h"
@@ -26,6 +28,7 @@
 #include <seastar/core/gate.hh>
 #include <seastar/core/iostream.hh>
 #include <seastar/core/lowres_clock.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/temporary_buffer.hh>
 #include <seastar/net/dns.hh>
@@ -54,12 +57,17 @@ struct aws_header_names {
     static constexpr boost::beast::string_view x_amz_content_sha256
       = "x-amz-content-sha256";
     static constexpr boost::beast::string_view x_amz_tagging = "x-amz-tagging";
+    static constexpr boost::beast::string_view x_amz_decoded_content_length
+      = "x-amz-decoded-content-length";
 };
 
 struct aws_header_values {
     static constexpr boost::beast::string_view user_agent
       = "redpanda.vectorized.io";
     static constexpr boost::beast::string_view text_plain = "text/plain";
+    static constexpr boost::beast::string_view application_xml
+      = "application/xml";
+    static constexpr boost::beast::string_view aws_chunked = "aws-chunked";
 };
 
 // configuration //
@@ -119,6 +127,8 @@ ss::future<configuration> configuration::make_configuration(
     client_cfg.max_idle_time = overrides.max_idle_time
                                  ? *overrides.max_idle_time
                                  : default_max_idle_time;
+    client_cfg.sign_payload = overrides.sign_payload;
+    client_cfg.hedge_percentile = overrides.hedge_percentile;
     co_return client_cfg;
 }
 
@@ -126,21 +136,30 @@ std::ostream& operator<<(std::ostream& o, const configuration& c) {
     o << "{access_key:" << c.access_key << ",region:" << c.region()
       << ",secret_key:****"
       << ",access_point_uri:" << c.uri() << ",server_addr:" << c.server_addr
-      << ",max_idle_time:" << c.max_idle_time.count() << "}";
+      << ",max_idle_time:" << c.max_idle_time.count()
+      << ",sign_payload:" << c.sign_payload
+      << ",hedge_percentile:" << c.hedge_percentile.value_or(0) << "}";
     return o;
 }
 
 // request_creator //
 
+/// Size of the payload chunks of the streaming signed uploads
+static constexpr size_t streaming_chunk_size = 64_KiB;
+static constexpr std::string_view chunk_signature_prefix = "chunk-signature=";
+
 request_creator::request_creator(const configuration& conf)
   : _ap(conf.uri)
   , _sign(conf.region, conf.access_key, conf.secret_key) {}
 
 result<http::client::request_header> request_creator::make_get_object_request(
-  bucket_name const& name, object_key const& key) {
+  bucket_name const& name,
+  object_key const& key,
+  std::optional<byte_range> range) {
     http::client::request_header header{};
     // GET /{object-id} HTTP/1.1
     // Host: {bucket-name}.s3.amazonaws.com
+    // Range: bytes={first}-{last}
     // x-amz-date:{req-datetime}
     // Authorization:{signature}
     // x-amz-content-sha256:e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855
@@ -155,6 +174,11 @@ result<http::client::request_header> request_creator::make_get_object_request(
     header.insert(boost::beast::http::field::host, host);
     header.insert(boost::beast::http::field::content_length, "0");
     header.insert(aws_header_names::x_amz_content_sha256, emptysig);
+    if (range) {
+        header.insert(
+          boost::beast::http::field::range,
+          fmt::format("bytes={}-{}", range->first, range->last));
+    }
     auto ec = _sign.sign_header(header, emptysig);
     if (ec) {
         return ec;
@@ -162,8 +186,7 @@ result<http::client::request_header> request_creator::make_get_object_request(
     return header;
 }
 
-result<http::client::request_header>
-request_creator::make_unsigned_put_object_request(
+http::client::request_header request_creator::make_put_object_header(
   bucket_name const& name,
   object_key const& key,
   size_t payload_size_bytes,
@@ -193,12 +216,196 @@ request_creator::make_unsigned_put_object_request(
       std::to_string(payload_size_bytes));
     header.insert(aws_header_names::x_amz_content_sha256, sig);
     if (!tags.empty()) {
-        std::stringstream tstr;
-        for (const auto& [key, val] : tags) {
-            tstr << fmt::format("&{}={}", key, val);
-        }
-        header.insert(aws_header_names::x_amz_tagging, tstr.str().substr(1));
+        header.insert(aws_header_names::x_amz_tagging, format_tags(tags));
+    }
+    return header;
+}
+
+result<http::client::request_header>
+request_creator::make_unsigned_put_object_request(
+  bucket_name const& name,
+  object_key const& key,
+  size_t payload_size_bytes,
+  const std::vector<object_tag>& tags) {
+    auto header = make_put_object_header(name, key, payload_size_bytes, tags);
+    auto ec = _sign.sign_header(header, "UNSIGNED-PAYLOAD");
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+result<request_creator::streaming_request>
+request_creator::make_streaming_put_object_request(
+  bucket_name const& name,
+  object_key const& key,
+  size_t payload_size_bytes,
+  const std::vector<object_tag>& tags) {
+    return sign_streaming_request(
+      make_put_object_header(name, key, payload_size_bytes, tags),
+      payload_size_bytes);
+}
+
+/// Format 'x-amz-tagging' header value
+static std::string format_tags(const std::vector<object_tag>& tags) {
+    std::stringstream tstr;
+    for (const auto& [key, val] : tags) {
+        tstr << fmt::format("&{}={}", key, val);
+    }
+    return tstr.str().substr(1);
+}
+
+result<http::client::request_header>
+request_creator::make_create_multipart_upload_request(
+  bucket_name const& name,
+  object_key const& key,
+  const std::vector<object_tag>& tags) {
+    // POST /{object-id}?uploads HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // x-amz-date:{req-datetime}
+    // Authorization:{signature}
+    // x-amz-tagging: {tags}
+    http::client::request_header header{};
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}?uploads", key().string());
+    std::string emptysig
+      = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+    header.method(boost::beast::http::verb::post);
+    header.target(target);
+    header.insert(
+      boost::beast::http::field::user_agent, aws_header_values::user_agent);
+    header.insert(boost::beast::http::field::host, host);
+    header.insert(
+      boost::beast::http::field::content_type, aws_header_values::text_plain);
+    header.insert(boost::beast::http::field::content_length, "0");
+    header.insert(aws_header_names::x_amz_content_sha256, emptysig);
+    if (!tags.empty()) {
+        header.insert(aws_header_names::x_amz_tagging, format_tags(tags));
+    }
+    auto ec = _sign.sign_header(header, emptysig);
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+http::client::request_header request_creator::make_upload_part_header(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id,
+  size_t part_number,
+  size_t payload_size_bytes) {
+    // PUT /{object-id}?partNumber={part}&uploadId={upload-id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // Content-Length: {size}
+    // Authorization: authorization string
+    // [{size} bytes of part data]
+    //
+    // NOTE: the upload ids generated by S3 are url-safe and used verbatim
+    http::client::request_header header{};
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format(
+      "/{}?partNumber={}&uploadId={}", key().string(), part_number, upload_id);
+    std::string sig = "UNSIGNED-PAYLOAD";
+    header.method(boost::beast::http::verb::put);
+    header.target(target);
+    header.insert(
+      boost::beast::http::field::user_agent, aws_header_values::user_agent);
+    header.insert(boost::beast::http::field::host, host);
+    header.insert(
+      boost::beast::http::field::content_type, aws_header_values::text_plain);
+    header.insert(
+      boost::beast::http::field::content_length,
+      std::to_string(payload_size_bytes));
+    header.insert(aws_header_names::x_amz_content_sha256, sig);
+    return header;
+}
+
+result<http::client::request_header>
+request_creator::make_unsigned_upload_part_request(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id,
+  size_t part_number,
+  size_t payload_size_bytes) {
+    auto header = make_upload_part_header(
+      name, key, upload_id, part_number, payload_size_bytes);
+    auto ec = _sign.sign_header(header, "UNSIGNED-PAYLOAD");
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
+result<request_creator::streaming_request>
+request_creator::make_streaming_upload_part_request(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id,
+  size_t part_number,
+  size_t payload_size_bytes) {
+    return sign_streaming_request(
+      make_upload_part_header(
+        name, key, upload_id, part_number, payload_size_bytes),
+      payload_size_bytes);
+}
+
+result<request_creator::streaming_request>
+request_creator::sign_streaming_request(
+  http::client::request_header header, size_t payload_size_bytes) {
+    // PUT /{object-id} HTTP/1.1
+    // Content-Encoding: aws-chunked
+    // Content-Length: {size of the encoded payload}
+    // x-amz-content-sha256: STREAMING-AWS4-HMAC-SHA256-PAYLOAD
+    // x-amz-decoded-content-length: {size}
+    // [{hex(chunk-size)};chunk-signature={signature}\r\n{chunk}\r\n...]
+    header.set(
+      boost::beast::http::field::content_length,
+      std::to_string(http::extended_chunked_stream_size(
+        payload_size_bytes,
+        streaming_chunk_size,
+        chunk_signature_prefix.size() + chunk_signer::signature_length)));
+    header.insert(
+      boost::beast::http::field::content_encoding,
+      aws_header_values::aws_chunked);
+    header.insert(
+      aws_header_names::x_amz_decoded_content_length,
+      std::to_string(payload_size_bytes));
+    auto signer = _sign.sign_streaming_header(header);
+    if (!signer) {
+        return signer.error();
     }
+    return streaming_request{
+      .header = std::move(header), .signer = std::move(signer.value())};
+}
+
+result<http::client::request_header>
+request_creator::make_unsigned_complete_multipart_upload_request(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id,
+  size_t payload_size_bytes) {
+    // POST /{object-id}?uploadId={upload-id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // Content-Length: {size}
+    // Authorization: authorization string
+    // <CompleteMultipartUpload>...</CompleteMultipartUpload>
+    http::client::request_header header{};
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}?uploadId={}", key().string(), upload_id);
+    std::string sig = "UNSIGNED-PAYLOAD";
+    header.method(boost::beast::http::verb::post);
+    header.target(target);
+    header.insert(
+      boost::beast::http::field::user_agent, aws_header_values::user_agent);
+    header.insert(boost::beast::http::field::host, host);
+    header.insert(
+      boost::beast::http::field::content_type,
+      aws_header_values::application_xml);
+    header.insert(
+      boost::beast::http::field::content_length,
+      std::to_string(payload_size_bytes));
+    header.insert(aws_header_names::x_amz_content_sha256, sig);
     auto ec = _sign.sign_header(header, sig);
     if (ec) {
         return ec;
@@ -206,6 +413,34 @@ request_creator::make_unsigned_put_object_request(
     return header;
 }
 
+result<http::client::request_header>
+request_creator::make_abort_multipart_upload_request(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id) {
+    // DELETE /{object-id}?uploadId={upload-id} HTTP/1.1
+    // Host: {bucket-name}.s3.amazonaws.com
+    // x-amz-date:{req-datetime}
+    // Authorization:{signature}
+    http::client::request_header header{};
+    auto host = fmt::format("{}.{}", name(), _ap());
+    auto target = fmt::format("/{}?uploadId={}", key().string(), upload_id);
+    std::string emptysig
+      = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+    header.method(boost::beast::http::verb::delete_);
+    header.target(target);
+    header.insert(
+      boost::beast::http::field::user_agent, aws_header_values::user_agent);
+    header.insert(boost::beast::http::field::host, host);
+    header.insert(boost::beast::http::field::content_length, "0");
+    header.insert(aws_header_names::x_amz_content_sha256, emptysig);
+    auto ec = _sign.sign_header(header, emptysig);
+    if (ec) {
+        return ec;
+    }
+    return header;
+}
+
 result<http::client::request_header>
 request_creator::make_list_objects_v2_request(
   const bucket_name& name,
@@ -377,12 +612,14 @@ drain_response_stream(http::client::response_stream_ref resp) {
 client::client(const configuration& conf)
   : _requestor(conf)
   , _client(conf)
-  , _probe(conf._probe) {}
+  , _probe(conf._probe)
+  , _sign_payload(conf.sign_payload) {}
 
 client::client(const configuration& conf, const ss::abort_source& as)
   : _requestor(conf)
   , _client(conf, &as, conf._probe, conf.max_idle_time)
-  , _probe(conf._probe) {}
+  , _probe(conf._probe)
+  , _sign_payload(conf.sign_payload) {}
 
 ss::future<> client::stop() { return _client.stop(); }
 
@@ -391,25 +628,33 @@ ss::future<> client::shutdown() {
     return ss::now();
 }
 
+bool client::is_connected() const { return _client.is_valid(); }
+
 ss::future<http::client::response_stream_ref> client::get_object(
   bucket_name const& name,
   object_key const& key,
-  const ss::lowres_clock::duration& timeout) {
-    auto header = _requestor.make_get_object_request(name, key);
+  const ss::lowres_clock::duration& timeout,
+  std::optional<byte_range> range) {
+    auto header = _requestor.make_get_object_request(name, key, range);
     if (!header) {
         return ss::make_exception_future<http::client::response_stream_ref>(
           std::system_error(header.error()));
     }
     vlog(s3_log.trace, "send https request:\n{}", header);
     return _client.request(std::move(header.value()), timeout)
-      .then([](http::client::response_stream_ref&& ref) {
+      .then([ranged = range.has_value()](
+              http::client::response_stream_ref&& ref) {
           // here we didn't receive any bytes from the socket and
           // ref->is_header_done() is 'false', we need to prefetch
           // the header first
-          return ref->prefetch_headers().then([ref = std::move(ref)]() mutable {
+          return ref->prefetch_headers().then([ranged,
+                                               ref = std::move(ref)]() mutable {
               vassert(ref->is_header_done(), "Header is not received");
-              if (
-                ref->get_headers().result() != boost::beast::http::status::ok) {
+              // ranged requests are answered with 'Partial Content'
+              const auto expected
+                = ranged ? boost::beast::http::status::partial_content
+                         : boost::beast::http::status::ok;
+              if (ref->get_headers().result() != expected) {
                   // Got error response, consume the response body and produce
                   // rest api error
                   return drain_response_stream(std::move(ref))
@@ -424,6 +669,25 @@ ss::future<http::client::response_stream_ref> client::get_object(
       });
 }
 
+/// Encode the body of the streaming signed request using the aws-chunked
+/// encoding, the chunks are signed while the body is sent
+static result<http::client::request_header> make_signed_body(
+  result<request_creator::streaming_request> request,
+  ss::input_stream<char>& body) {
+    if (!request) {
+        return request.error();
+    }
+    body = http::make_extended_chunked_stream(
+      std::move(body),
+      streaming_chunk_size,
+      [signer = std::move(request.value().signer)](
+        std::string_view chunk) mutable {
+          return ssx::sformat(
+            "{}{}", chunk_signature_prefix, signer.sign_chunk(chunk));
+      });
+    return std::move(request.value().header);
+}
+
 ss::future<> client::put_object(
   bucket_name const& name,
   object_key const& id,
@@ -431,8 +695,13 @@ ss::future<> client::put_object(
   ss::input_stream<char>&& body,
   const std::vector<object_tag>& tags,
   const ss::lowres_clock::duration& timeout) {
-    auto header = _requestor.make_unsigned_put_object_request(
-      name, id, payload_size, tags);
+    auto header = _sign_payload
+                    ? make_signed_body(
+                      _requestor.make_streaming_put_object_request(
+                        name, id, payload_size, tags),
+                      body)
+                    : _requestor.make_unsigned_put_object_request(
+                      name, id, payload_size, tags);
     if (!header) {
         return ss::make_exception_future<>(std::system_error(header.error()));
     }
@@ -530,6 +799,143 @@ ss::future<> client::delete_object(
       });
 }
 
+ss::future<ss::sstring> client::create_multipart_upload(
+  bucket_name const& name,
+  object_key const& key,
+  const std::vector<object_tag>& tags,
+  const ss::lowres_clock::duration& timeout) {
+    auto header = _requestor.make_create_multipart_upload_request(
+      name, key, tags);
+    if (!header) {
+        throw std::system_error(header.error());
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header);
+    auto ref = co_await _client.request(std::move(header.value()), timeout);
+    auto res = co_await drain_response_stream(ref);
+    if (ref->get_headers().result() != boost::beast::http::status::ok) {
+        co_return co_await parse_rest_error_response<ss::sstring>(
+          std::move(res));
+    }
+    auto root = iobuf_to_ptree(std::move(res));
+    co_return root.get<ss::sstring>("InitiateMultipartUploadResult.UploadId");
+}
+
+ss::future<ss::sstring> client::upload_part(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id,
+  size_t part_number,
+  size_t payload_size,
+  ss::input_stream<char>&& body,
+  const ss::lowres_clock::duration& timeout) {
+    auto header = _sign_payload
+                    ? make_signed_body(
+                      _requestor.make_streaming_upload_part_request(
+                        name, key, upload_id, part_number, payload_size),
+                      body)
+                    : _requestor.make_unsigned_upload_part_request(
+                      name, key, upload_id, part_number, payload_size);
+    if (!header) {
+        co_await body.close();
+        throw std::system_error(header.error());
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header);
+    auto stream = std::move(body);
+    std::exception_ptr ex;
+    ss::sstring etag;
+    try {
+        auto ref = co_await _client.request(
+          std::move(header.value()), stream, timeout);
+        auto res = co_await drain_response_stream(ref);
+        if (ref->get_headers().result() != boost::beast::http::status::ok) {
+            co_await parse_rest_error_response<>(std::move(res));
+        }
+        auto value = ref->get_headers().at(boost::beast::http::field::etag);
+        etag = ss::sstring(value.data(), value.size());
+    } catch (const rest_error_response& err) {
+        _probe->register_failure(err.code());
+        ex = std::current_exception();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await stream.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return etag;
+}
+
+ss::future<> client::complete_multipart_upload(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id,
+  const std::vector<ss::sstring>& etags,
+  const ss::lowres_clock::duration& timeout) {
+    std::stringstream parts;
+    parts << "<CompleteMultipartUpload "
+             "xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">";
+    for (size_t i = 0; i < etags.size(); i++) {
+        parts << fmt::format(
+          "<Part><ETag>{}</ETag><PartNumber>{}</PartNumber></Part>",
+          etags[i],
+          i + 1);
+    }
+    parts << "</CompleteMultipartUpload>";
+    auto payload = parts.str();
+    auto header = _requestor.make_unsigned_complete_multipart_upload_request(
+      name, key, upload_id, payload.size());
+    if (!header) {
+        throw std::system_error(header.error());
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header);
+    iobuf buf;
+    buf.append(payload.data(), payload.size());
+    auto stream = make_iobuf_input_stream(std::move(buf));
+    std::exception_ptr ex;
+    try {
+        auto ref = co_await _client.request(
+          std::move(header.value()), stream, timeout);
+        auto res = co_await drain_response_stream(ref);
+        // the request can fail after the response status was sent, in which
+        // case the error is returned in the body of the 'OK' response
+        if (
+          ref->get_headers().result() != boost::beast::http::status::ok
+          || iobuf_to_ptree(res.copy()).count("Error")) {
+            co_await parse_rest_error_response<>(std::move(res));
+        }
+    } catch (const rest_error_response& err) {
+        _probe->register_failure(err.code());
+        ex = std::current_exception();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await stream.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+}
+
+ss::future<> client::abort_multipart_upload(
+  bucket_name const& name,
+  object_key const& key,
+  const ss::sstring& upload_id,
+  const ss::lowres_clock::duration& timeout) {
+    auto header = _requestor.make_abort_multipart_upload_request(
+      name, key, upload_id);
+    if (!header) {
+        throw std::system_error(header.error());
+    }
+    vlog(s3_log.trace, "send https request:\n{}", header);
+    auto ref = co_await _client.request(std::move(header.value()), timeout);
+    auto res = co_await drain_response_stream(ref);
+    auto status = ref->get_headers().result();
+    if (
+      status != boost::beast::http::status::ok
+      && status != boost::beast::http::status::no_content) {
+        co_await parse_rest_error_response<>(std::move(res));
+    }
+}
+
 client_pool::client_pool(
   size_t size, configuration conf, client_pool_overdraft_policy policy)
   : _max_size(size)
@@ -538,6 +944,40 @@ client_pool::client_pool(
     init();
 }
 
+ss::future<> client_pool::start() {
+    gate_guard guard(_gate);
+    std::vector<ss::socket_address> addresses;
+    try {
+        addresses = co_await rpc::resolve_dns_all(_config.server_addr);
+    } catch (...) {
+        vlog(
+          s3_log.warn,
+          "Failed to resolve {}, connections won't be spread across the "
+          "endpoint addresses: {}",
+          _config.server_addr,
+          std::current_exception());
+        co_return;
+    }
+    if (addresses.size() < 2) {
+        co_return;
+    }
+    for (const auto& addr : addresses) {
+        _endpoints.emplace_back(
+          ssx::sformat("{}", addr.addr()),
+          addr.port(),
+          addr.addr().in_family());
+    }
+    vlog(
+      s3_log.info,
+      "Spreading connections across {} addresses of {}",
+      _endpoints.size(),
+      _config.server_addr);
+    // None of the idle clients is connected yet, rebind them
+    for (auto& cl : _pool) {
+        cl = make_client();
+    }
+}
+
 ss::future<> client_pool::stop() {
     _as.request_abort();
     _cvar.broken();
@@ -559,8 +999,7 @@ ss::future<client_pool::client_lease> client_pool::acquire() {
             if (_policy == client_pool_overdraft_policy::wait_if_empty) {
                 co_await _cvar.wait();
             } else {
-                auto cl = ss::make_shared<client>(_config, _as);
-                _pool.emplace_back(std::move(cl));
+                _pool.emplace_back(make_client());
             }
         }
     } catch (const ss::broken_condition_variable&) {
@@ -571,7 +1010,22 @@ ss::future<client_pool::client_lease> client_pool::acquire() {
     vassert(!_pool.empty(), "'acquire' invariant is broken");
     auto client = _pool.back();
     _pool.pop_back();
-    co_return client_lease{
+    co_return make_lease(std::move(client), std::move(guard));
+}
+
+std::optional<client_pool::client_lease> client_pool::try_acquire() {
+    if (_pool.empty() || _gate.is_closed() || _as.abort_requested()) {
+        return std::nullopt;
+    }
+    gate_guard guard(_gate);
+    auto client = _pool.back();
+    _pool.pop_back();
+    return make_lease(std::move(client), std::move(guard));
+}
+
+client_pool::client_lease
+client_pool::make_lease(http_client_ptr client, gate_guard guard) {
+    return client_lease{
       .client = client,
       .deleter = ss::make_deleter(
         [pool = weak_from_this(), client, g = std::move(guard)] {
@@ -580,20 +1034,163 @@ ss::future<client_pool::client_lease> client_pool::acquire() {
             }
         })};
 }
+
+/// State shared by the GET requests of a hedged request, the first request
+/// to complete sets the result
+struct client_pool::hedged_request {
+    std::chrono::steady_clock::time_point start{
+      std::chrono::steady_clock::now()};
+    std::vector<http_client_ptr> clients;
+    bool done{false};
+    std::optional<get_object_result> result;
+    std::exception_ptr error;
+    ss::shared_promise<> completed;
+};
+
+ss::future<client_pool::get_object_result> client_pool::get_object(
+  const bucket_name& name,
+  const object_key& key,
+  const ss::lowres_clock::duration& timeout,
+  std::optional<byte_range> range) {
+    auto deadline = ss::lowres_clock::now() + timeout;
+    auto request = ss::make_lw_shared<hedged_request>();
+    send_get_object(
+      request, co_await acquire(), name, key, timeout, range, false);
+    auto completed = request->completed.get_shared_future();
+    if (auto delay = hedge_delay();
+        delay && ss::lowres_clock::now() + *delay < deadline) {
+        bool late = false;
+        try {
+            co_await completed.get_future(ss::lowres_clock::now() + *delay);
+        } catch (const ss::timed_out_error&) {
+            late = true;
+        }
+        auto now = ss::lowres_clock::now();
+        if (late && !request->done && now < deadline) {
+            if (auto lease = try_acquire(); lease) {
+                vlog(s3_log.debug, "Hedging GET request of {}", key);
+                _config._probe->register_hedge();
+                send_get_object(
+                  request,
+                  std::move(*lease),
+                  name,
+                  key,
+                  deadline - now,
+                  range,
+                  true);
+            }
+        }
+    }
+    co_await completed.get_future();
+    if (request->error) {
+        std::rethrow_exception(request->error);
+    }
+    co_return std::move(*request->result);
+}
+
+void client_pool::send_get_object(
+  ss::lw_shared_ptr<hedged_request> request,
+  client_lease lease,
+  const bucket_name& name,
+  const object_key& key,
+  const ss::lowres_clock::duration& timeout,
+  std::optional<byte_range> range,
+  bool is_hedge) {
+    auto client = lease.client;
+    request->clients.push_back(client);
+    (void)client->get_object(name, key, timeout, range)
+      .then_wrapped(
+        [this, request, lease = std::move(lease), is_hedge](
+          ss::future<http::client::response_stream_ref> f) mutable {
+            if (request->done) {
+                // lost the race, the body of the response is never read so
+                // the connection can not be reused
+                if (f.failed()) {
+                    f.ignore_ready_future();
+                    return ss::now();
+                }
+                auto client = lease.client;
+                return client->shutdown().finally(
+                  [lease = std::move(lease), resp = f.get0()] {});
+            }
+            request->done = true;
+            for (auto& other : request->clients) {
+                if (other != lease.client) {
+                    (void)other->shutdown().finally([other] {});
+                }
+            }
+            bool slow_down = false;
+            if (f.failed()) {
+                request->error = f.get_exception();
+                try {
+                    std::rethrow_exception(request->error);
+                } catch (const rest_error_response& err) {
+                    slow_down = err.code() == s3_error_code::slow_down;
+                } catch (...) {
+                }
+            } else {
+                _get_latency.record(
+                  std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - request->start)
+                    .count());
+                ++_get_samples;
+                if (is_hedge) {
+                    _config._probe->register_hedge_win();
+                }
+                request->result = get_object_result{
+                  .lease = std::move(lease), .response = f.get0()};
+            }
+            request->completed.set_value();
+            if (slow_down) {
+                // The connection has to be closed upon receiving the
+                // 'SlowDown' response from S3, the next request using it
+                // would otherwise trigger a 'short read' error when S3
+                // forcibly closes it.
+                auto client = lease.client;
+                return client->shutdown().finally(
+                  [lease = std::move(lease)] {});
+            }
+            return ss::now();
+        });
+}
+
+std::optional<ss::lowres_clock::duration> client_pool::hedge_delay() const {
+    if (!_config.hedge_percentile || _get_samples < min_hedge_samples) {
+        return std::nullopt;
+    }
+    auto delay = std::chrono::duration_cast<ss::lowres_clock::duration>(
+      std::chrono::microseconds(
+        _get_latency.get_value_at(*_config.hedge_percentile)));
+    return std::max(delay, min_hedge_delay);
+}
 size_t client_pool::size() const noexcept { return _pool.size(); }
 size_t client_pool::max_size() const noexcept { return _max_size; }
 void client_pool::init() {
     for (size_t i = 0; i < _max_size; i++) {
-        auto cl = ss::make_shared<client>(_config, _as);
-        _pool.emplace_back(std::move(cl));
+        _pool.emplace_back(make_client());
     }
 }
 void client_pool::release(ss::shared_ptr<client> leased) {
     if (_pool.size() == _max_size) {
         return;
     }
-    _pool.emplace_back(std::move(leased));
+    // Clients are acquired from the back of the pool. Keep the ones with an
+    // open connection there so that the connections are reused while they
+    // are alive and the rest of the clients stay idle.
+    if (leased->is_connected()) {
+        _pool.emplace_back(std::move(leased));
+    } else {
+        _pool.insert(_pool.begin(), std::move(leased));
+    }
     _cvar.signal();
 }
+client_pool::http_client_ptr client_pool::make_client() {
+    if (_endpoints.empty()) {
+        return ss::make_shared<client>(_config, _as);
+    }
+    auto conf = _config;
+    conf.server_addr = _endpoints[_next_endpoint++ % _endpoints.size()];
+    return ss::make_shared<client>(conf, _as);
+}
 
 } // namespace s3
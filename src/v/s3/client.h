@@ -16,6 +16,7 @@
 #include "s3/client_probe.h"
 #include "s3/signature.h"
 #include "utils/gate_guard.h"
+#include "utils/hdr_hist.h"
 
 #include <seastar/core/condition-variable.hh>
 #include <seastar/core/coroutine.hh>
@@ -43,6 +44,12 @@ struct object_tag {
     ss::sstring value;
 };
 
+/// Inclusive range of the bytes of an object
+struct byte_range {
+    uint64_t first;
+    uint64_t last;
+};
+
 /// List of default overrides that can be used to workaround issues
 /// that can arise when we want to deal with different S3 API implementations
 /// and different OS issues (like different truststore locations on different
@@ -53,6 +60,8 @@ struct default_overrides {
     std::optional<ca_trust_file> trust_file = std::nullopt;
     std::optional<ss::lowres_clock::duration> max_idle_time = std::nullopt;
     bool disable_tls = false;
+    bool sign_payload = false;
+    std::optional<double> hedge_percentile = std::nullopt;
 };
 
 /// S3 client configuration
@@ -67,6 +76,11 @@ struct configuration : rpc::base_transport::configuration {
     aws_region_name region;
     /// Max time that connection can spend idle
     ss::lowres_clock::duration max_idle_time;
+    /// Sign the payload of the uploads using the streaming signature
+    bool sign_payload{false};
+    /// Percentile of the GET latencies after which the client pool sends a
+    /// duplicate request, the requests are not hedged if not set
+    std::optional<double> hedge_percentile;
     /// Metrics probe (should be created for every aws account on every shard)
     ss::shared_ptr<client_probe> _probe;
 
@@ -112,13 +126,39 @@ public:
       size_t payload_size_bytes,
       const std::vector<object_tag>& tags);
 
+    /// Request with the payload signed using the streaming signature
+    struct streaming_request {
+        http::client::request_header header;
+        /// Signer of the payload chunks
+        chunk_signer signer;
+    };
+
+    /// \brief Create 'PutObject' request header with the streaming signed
+    /// payload. The payload is signed chunk by chunk while it's sent, so
+    /// it doesn't have to be hashed beforehand.
+    ///
+    /// \param name is a bucket that should be used to store new object
+    /// \param key is an object name
+    /// \param payload_size_bytes is a size of the object in bytes
+    /// \return initialized and signed http header and the chunk signer or
+    ///         error
+    result<streaming_request> make_streaming_put_object_request(
+      bucket_name const& name,
+      object_key const& key,
+      size_t payload_size_bytes,
+      const std::vector<object_tag>& tags);
+
     /// \brief Create a 'GetObject' request header
     ///
     /// \param name is a bucket that has the object
     /// \param key is an object name
+    /// \param range is a range of bytes of the object, the whole object is
+    ///        requested if not set
     /// \return initialized and signed http header or error
-    result<http::client::request_header>
-    make_get_object_request(bucket_name const& name, object_key const& key);
+    result<http::client::request_header> make_get_object_request(
+      bucket_name const& name,
+      object_key const& key,
+      std::optional<byte_range> range = std::nullopt);
 
     /// \brief Create a 'DeleteObject' request header
     ///
@@ -128,6 +168,73 @@ public:
     result<http::client::request_header>
     make_delete_object_request(bucket_name const& name, object_key const& key);
 
+    /// \brief Create a 'CreateMultipartUpload' request header
+    ///
+    /// \param name is a bucket that should be used to store new object
+    /// \param key is an object name
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_create_multipart_upload_request(
+      bucket_name const& name,
+      object_key const& key,
+      const std::vector<object_tag>& tags);
+
+    /// \brief Create unsigned 'UploadPart' request header
+    ///
+    /// \param name is a bucket that has the upload
+    /// \param key is an object name
+    /// \param upload_id is an id returned by 'CreateMultipartUpload'
+    /// \param part_number is a number of the part starting from 1
+    /// \param payload_size_bytes is a size of the part in bytes
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_unsigned_upload_part_request(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id,
+      size_t part_number,
+      size_t payload_size_bytes);
+
+    /// \brief Create 'UploadPart' request header with the streaming signed
+    /// payload
+    ///
+    /// \param name is a bucket that has the upload
+    /// \param key is an object name
+    /// \param upload_id is an id returned by 'CreateMultipartUpload'
+    /// \param part_number is a number of the part starting from 1
+    /// \param payload_size_bytes is a size of the part in bytes
+    /// \return initialized and signed http header and the chunk signer or
+    ///         error
+    result<streaming_request> make_streaming_upload_part_request(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id,
+      size_t part_number,
+      size_t payload_size_bytes);
+
+    /// \brief Create unsigned 'CompleteMultipartUpload' request header
+    ///
+    /// \param name is a bucket that has the upload
+    /// \param key is an object name
+    /// \param upload_id is an id returned by 'CreateMultipartUpload'
+    /// \param payload_size_bytes is a size of the list of parts in bytes
+    /// \return initialized and signed http header or error
+    result<http::client::request_header>
+    make_unsigned_complete_multipart_upload_request(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id,
+      size_t payload_size_bytes);
+
+    /// \brief Create 'AbortMultipartUpload' request header
+    ///
+    /// \param name is a bucket that has the upload
+    /// \param key is an object name
+    /// \param upload_id is an id returned by 'CreateMultipartUpload'
+    /// \return initialized and signed http header or error
+    result<http::client::request_header> make_abort_multipart_upload_request(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id);
+
     /// \brief Initialize http header for 'ListObjectsV2' request
     ///
     /// \param name of the bucket
@@ -142,6 +249,23 @@ public:
       std::optional<size_t> max_keys);
 
 private:
+    http::client::request_header make_put_object_header(
+      bucket_name const& name,
+      object_key const& key,
+      size_t payload_size_bytes,
+      const std::vector<object_tag>& tags);
+
+    http::client::request_header make_upload_part_header(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id,
+      size_t part_number,
+      size_t payload_size_bytes);
+
+    /// Switch the request to the aws-chunked encoding and sign it
+    result<streaming_request> sign_streaming_request(
+      http::client::request_header header, size_t payload_size_bytes);
+
     access_point_uri _ap;
     signature_v4 _sign;
 };
@@ -156,16 +280,21 @@ public:
     ss::future<> stop();
     /// Shutdown the underlying connection
     ss::future<> shutdown();
+    /// Return true if the connection to the server is open
+    bool is_connected() const;
 
     /// Download object from S3 bucket
     ///
     /// \param name is a bucket name
     /// \param key is an object key
+    /// \param range is a range of bytes to download, the response contains
+    ///        the whole object if not set
     /// \return future that gets ready after request was sent
     ss::future<http::client::response_stream_ref> get_object(
       bucket_name const& name,
       object_key const& key,
-      const ss::lowres_clock::duration& timeout);
+      const ss::lowres_clock::duration& timeout,
+      std::optional<byte_range> range = std::nullopt);
 
     /// Put object to S3 bucket.
     /// \param name is a bucket name
@@ -181,6 +310,56 @@ public:
       const std::vector<object_tag>& tags,
       const ss::lowres_clock::duration& timeout);
 
+    /// Start multipart upload of an object
+    /// \param name is a bucket name
+    /// \param key is an id of the object
+    /// \return future that returns the id of the upload
+    ss::future<ss::sstring> create_multipart_upload(
+      bucket_name const& name,
+      object_key const& key,
+      const std::vector<object_tag>& tags,
+      const ss::lowres_clock::duration& timeout);
+
+    /// Upload part of a multipart upload
+    /// \param name is a bucket name
+    /// \param key is an id of the object
+    /// \param upload_id is an id returned by 'create_multipart_upload'
+    /// \param part_number is a number of the part starting from 1
+    /// \param payload_size is a size of the part in bytes
+    /// \param body is an input_stream that can be used to read the part
+    /// \return future that returns the ETag of the part
+    ss::future<ss::sstring> upload_part(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id,
+      size_t part_number,
+      size_t payload_size,
+      ss::input_stream<char>&& body,
+      const ss::lowres_clock::duration& timeout);
+
+    /// Assemble the object from the uploaded parts
+    /// \param name is a bucket name
+    /// \param key is an id of the object
+    /// \param upload_id is an id returned by 'create_multipart_upload'
+    /// \param etags are ETags of the parts ordered by the part number
+    /// \return future that becomes ready when the object is created
+    ss::future<> complete_multipart_upload(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id,
+      const std::vector<ss::sstring>& etags,
+      const ss::lowres_clock::duration& timeout);
+
+    /// Abort multipart upload, the uploaded parts are removed
+    /// \param name is a bucket name
+    /// \param key is an id of the object
+    /// \param upload_id is an id returned by 'create_multipart_upload'
+    ss::future<> abort_multipart_upload(
+      bucket_name const& name,
+      object_key const& key,
+      const ss::sstring& upload_id,
+      const ss::lowres_clock::duration& timeout);
+
     struct list_bucket_item {
         ss::sstring key;
         std::chrono::system_clock::time_point last_modified;
@@ -209,6 +388,7 @@ private:
     request_creator _requestor;
     http::client _client;
     ss::shared_ptr<client_probe> _probe;
+    bool _sign_payload;
 };
 
 /// Policy that controls behaviour of the client pool
@@ -223,14 +403,37 @@ enum class client_pool_overdraft_policy {
 };
 
 /// Connection pool implementation
-/// All connections share the same configuration
+/// All connections share the same configuration except for the server
+/// address. Once started, the pool spreads the connections round-robin
+/// across all addresses the endpoint resolves to.
+///
+/// Released clients with an open keep-alive connection are handed out
+/// first so that small requests don't pay for the TCP and TLS handshakes.
+///
+/// GET requests sent through the pool are hedged when the configuration has
+/// a hedge percentile: a duplicate request is sent on an idle client once the
+/// request took longer than that percentile of the previous GET requests.
+/// The first response is used and the connection of the other request is
+/// closed.
 class client_pool : public ss::weakly_referencable<client_pool> {
+    /// no request is hedged before the latencies of this many requests are
+    /// known
+    static constexpr size_t min_hedge_samples = 100;
+    static constexpr ss::lowres_clock::duration min_hedge_delay
+      = std::chrono::milliseconds(10);
+
 public:
     using http_client_ptr = ss::shared_ptr<client>;
     struct client_lease {
         http_client_ptr client;
         ss::deleter deleter;
     };
+    struct get_object_result {
+        /// lease of the client that received the response, it must be kept
+        /// until the response is consumed
+        client_lease lease;
+        http::client::response_stream_ref response;
+    };
 
     client_pool(
       size_t size,
@@ -238,6 +441,11 @@ public:
       client_pool_overdraft_policy policy
       = client_pool_overdraft_policy::wait_if_empty);
 
+    /// \brief Resolve the addresses of the endpoint
+    ///
+    /// The pool can be used without calling this method, in this case all
+    /// connections use the address returned by the resolver on connect.
+    ss::future<> start();
     ss::future<> stop();
 
     /// \brief Acquire http client from the pool.
@@ -249,22 +457,59 @@ public:
     ///         are in use)
     ss::future<client_lease> acquire();
 
+    /// \brief Download object from S3 bucket using the clients of the pool
+    ///
+    /// The request may be hedged, in which case the response of the request
+    /// that completed first, successfully or not, is returned. A hedge is only
+    /// sent while a client is idle and the timeout leaves time for it.
+    /// \param timeout is the timeout of the request, e.g. the time left in
+    ///        the retry chain of the caller
+    ss::future<get_object_result> get_object(
+      const bucket_name& name,
+      const object_key& key,
+      const ss::lowres_clock::duration& timeout,
+      std::optional<byte_range> range = std::nullopt);
+
     /// \brief Get number of connections
     size_t size() const noexcept;
 
     size_t max_size() const noexcept;
 
 private:
+    struct hedged_request;
+
     void init();
     void release(ss::shared_ptr<client> leased);
+    http_client_ptr make_client();
+    client_lease make_lease(http_client_ptr, gate_guard);
+    /// Lease of an idle client, nullopt if all of them are in use
+    std::optional<client_lease> try_acquire();
+
+    /// Sends one GET request of the hedged request
+    void send_get_object(
+      ss::lw_shared_ptr<hedged_request>,
+      client_lease,
+      const bucket_name& name,
+      const object_key& key,
+      const ss::lowres_clock::duration& timeout,
+      std::optional<byte_range> range,
+      bool is_hedge);
+    /// Time after which a GET request is hedged, nullopt if it is not
+    std::optional<ss::lowres_clock::duration> hedge_delay() const;
 
     const size_t _max_size;
     configuration _config;
+    /// Resolved addresses of the endpoint, empty if not started
+    std::vector<unresolved_address> _endpoints;
+    size_t _next_endpoint{0};
     client_pool_overdraft_policy _policy;
     std::vector<http_client_ptr> _pool;
     ss::condition_variable _cvar;
     ss::abort_source _as;
     ss::gate _gate;
+    /// Time until the response headers of the GET requests
+    hdr_hist _get_latency;
+    size_t _get_samples{0};
 };
 
 } // namespace s3
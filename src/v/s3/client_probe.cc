@@ -106,6 +106,18 @@ client_probe::client_probe(
             "Total number of NoSuchKey errors received from cloud "
             "storage provider"),
           labels),
+        sm::make_counter(
+          "num_hedged_downloads",
+          [this] { return _total_hedges; },
+          sm::description("Total number of duplicate GET requests sent after "
+                          "the hedging delay"),
+          labels),
+        sm::make_counter(
+          "num_hedge_wins",
+          [this] { return _total_hedge_wins; },
+          sm::description("Total number of duplicate GET requests answered "
+                          "before the original request"),
+          labels),
       });
 }
 
@@ -47,6 +47,12 @@ public:
     /// Register S3 rpc error
     void register_failure(s3_error_code err);
 
+    /// Register a duplicate GET request
+    void register_hedge() { _total_hedges += 1; }
+    /// Register a response received for a duplicate GET request before the
+    /// response of the original one
+    void register_hedge_win() { _total_hedge_wins += 1; }
+
 private:
     /// Total number of rpc errors
     uint64_t _total_rpc_errors;
@@ -54,6 +60,10 @@ private:
     uint64_t _total_slowdowns;
     /// Total number of NoSuchKey responses
     uint64_t _total_nosuchkeys;
+    /// Total number of hedged GET requests
+    uint64_t _total_hedges{0};
+    /// Total number of hedges answered first
+    uint64_t _total_hedge_wins{0};
     ss::metrics::metric_groups _metrics;
 };
 
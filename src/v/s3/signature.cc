@@ -32,6 +32,9 @@ constexpr int sha256_digest_length = 32;
 using hmac_digest = std::array<char, sha256_digest_length>;
 
 constexpr std::string_view algorithm = "AWS4-HMAC-SHA256";
+constexpr std::string_view streaming_algorithm = "AWS4-HMAC-SHA256-PAYLOAD";
+constexpr std::string_view streaming_payload
+  = "STREAMING-AWS4-HMAC-SHA256-PAYLOAD";
 
 // time_source //
 
@@ -328,6 +331,22 @@ ss::sstring signature_v4::sha256_hexdigest(std::string_view payload) {
 }
 
 std::error_code signature_v4::sign_header(
+  http::client::request_header& header, const ss::sstring& sha256) const {
+    auto signer = sign_header_impl(header, sha256);
+    if (!signer) {
+        return signer.error();
+    }
+    return {};
+}
+
+result<chunk_signer> signature_v4::sign_streaming_header(
+  http::client::request_header& header) const {
+    return sign_header_impl(
+      header,
+      ss::sstring(streaming_payload.data(), streaming_payload.size()));
+}
+
+result<chunk_signer> signature_v4::sign_header_impl(
   http::client::request_header& header, const ss::sstring& sha256) const {
     ss::sstring date_str = _sig_time.format_date();
     ss::sstring service = "s3";
@@ -354,17 +373,55 @@ std::error_code signature_v4::sign_header(
     vlog(s3_log.trace, "\n[canonical-request]\n{}\n", canonical_req.value());
     auto str_to_sign = get_string_to_sign(
       amz_date, cred_scope, canonical_req.value());
-    auto digest = hmac(sign_key, str_to_sign);
+    auto digest = hexdigest(hmac(sign_key, str_to_sign));
     auto auth_header = fmt::format(
       "{} Credential={}/{},SignedHeaders={},Signature={}",
       algorithm,
       _access_key(),
       cred_scope,
       canonical_headers.value().signed_headers,
-      hexdigest(digest));
+      digest);
     header.set(boost::beast::http::field::authorization, auth_header);
     vlog(s3_log.trace, "\n[signed-header]\n\n{}", header);
-    return {};
+    return chunk_signer(
+      std::move(sign_key),
+      std::move(amz_date),
+      std::move(cred_scope),
+      std::move(digest));
+}
+
+// chunk_signer //
+
+chunk_signer::chunk_signer(
+  ss::sstring signing_key,
+  ss::sstring amz_date,
+  ss::sstring scope,
+  ss::sstring seed_signature)
+  : _signing_key(std::move(signing_key))
+  , _amz_date(std::move(amz_date))
+  , _scope(std::move(scope))
+  , _prev_signature(std::move(seed_signature)) {}
+
+/// String-to-sign of the chunk:
+///
+///   "AWS4-HMAC-SHA256-PAYLOAD" + "\n" +
+///   timeStampISO8601Format + "\n" +
+///   <Scope> + "\n" +
+///   <PreviousSignature> + "\n" +
+///   Hex(SHA256Hash("")) + "\n" +
+///   Hex(SHA256Hash(<ChunkData>))
+ss::sstring chunk_signer::sign_chunk(std::string_view chunk) {
+    static const ss::sstring empty_hash = sha_256("");
+    auto str_to_sign = ssx::sformat(
+      "{}\n{}\n{}\n{}\n{}\n{}",
+      streaming_algorithm,
+      _amz_date,
+      _scope,
+      _prev_signature,
+      empty_hash,
+      sha_256(chunk));
+    _prev_signature = hexdigest(hmac(_signing_key, str_to_sign));
+    return _prev_signature;
 }
 
 signature_v4::signature_v4(
@@ -69,6 +69,32 @@ private:
     ss::noncopyable_function<timestamp()> _gettime_fn;
 };
 
+/// Signs the chunks of a payload uploaded with the streaming signature
+/// (STREAMING-AWS4-HMAC-SHA256-PAYLOAD). The signature of every chunk is
+/// chained to the signature of the previous one, the signature of the
+/// request header is used as a seed.
+class chunk_signer {
+public:
+    chunk_signer(
+      ss::sstring signing_key,
+      ss::sstring amz_date,
+      ss::sstring scope,
+      ss::sstring seed_signature);
+
+    /// Return signature of the next chunk of the payload in hex format, the
+    /// last chunk of the payload is always empty
+    ss::sstring sign_chunk(std::string_view chunk);
+
+    /// Length of the hex formatted chunk signature
+    static constexpr size_t signature_length = 64;
+
+private:
+    ss::sstring _signing_key;
+    ss::sstring _amz_date;
+    ss::sstring _scope;
+    ss::sstring _prev_signature;
+};
+
 /// AWS Signature V4 generator
 class signature_v4 {
 public:
@@ -94,6 +120,15 @@ public:
     std::error_code sign_header(
       http::client::request_header& header, const ss::sstring& sha256) const;
 
+    /// \brief Sign http header of the request with the streaming payload
+    /// The payload has to be sent using the aws-chunked encoding with the
+    /// chunks signed by the returned signer.
+    ///
+    /// \param header is an in/out parameter that contains request headers
+    /// \return signer of the payload chunks
+    result<chunk_signer>
+    sign_streaming_header(http::client::request_header& header) const;
+
     static ss::sstring gen_sig_key(
       std::string_view key,
       std::string_view datestr,
@@ -101,6 +136,9 @@ public:
       std::string_view service);
 
 private:
+    result<chunk_signer> sign_header_impl(
+      http::client::request_header& header, const ss::sstring& sha256) const;
+
     /// \brief Calculate SHA256 digest
     ///
     /// \param payload is ref to payload of the query
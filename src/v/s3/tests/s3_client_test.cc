@@ -88,6 +88,19 @@ static constexpr const char* list_objects_payload = R"xml(
   </CommonPrefixes>
 </ListBucketResult>)xml";
 
+static constexpr const char* multipart_create_payload = R"xml(
+<InitiateMultipartUploadResult>
+  <Bucket>test-bucket</Bucket>
+  <Key>test-multipart</Key>
+  <UploadId>test-upload</UploadId>
+</InitiateMultipartUploadResult>)xml";
+static constexpr const char* multipart_complete_payload = R"xml(
+<CompleteMultipartUploadResult>
+  <Bucket>test-bucket</Bucket>
+  <Key>test-multipart</Key>
+  <ETag>etag</ETag>
+</CompleteMultipartUploadResult>)xml";
+
 void set_routes(ss::httpd::routes& r) {
     using namespace ss::httpd;
     auto empty_put_response = new function_handler(
@@ -109,6 +122,35 @@ void set_routes(ss::httpd::routes& r) {
           return ss::sstring(expected_payload, expected_payload_size);
       },
       "txt");
+    auto get_range_response = new function_handler(
+      [](const_req req, reply& reply) {
+          BOOST_REQUIRE(!req.get_header("x-amz-content-sha256").empty());
+          auto range = req.get_header("Range");
+          BOOST_REQUIRE(boost::algorithm::starts_with(range, "bytes="));
+          std::vector<std::string> bounds;
+          boost::algorithm::split(
+            bounds, range.substr(std::strlen("bytes=")), [](char c) {
+                return c == '-';
+            });
+          BOOST_REQUIRE_EQUAL(bounds.size(), 2);
+          auto first = std::stoul(bounds[0]);
+          auto last = std::stoul(bounds[1]);
+          reply.set_status(reply::status_type::partial_content);
+          return ss::sstring(expected_payload + first, last - first + 1);
+      },
+      "txt");
+    // the first request is answered late, e.g. by a slow S3 node
+    auto slow_get_response = new function_handler(
+      [requests = 0](std::unique_ptr<request>, std::unique_ptr<reply> rep)
+        mutable -> ss::future<std::unique_ptr<reply>> {
+          if (requests++ == 0) {
+              co_await ss::sleep(2s);
+          }
+          rep->write_body(
+            "txt", ss::sstring(expected_payload, expected_payload_size));
+          co_return std::move(rep);
+      },
+      "txt");
     auto erroneous_get_response = new function_handler(
       []([[maybe_unused]] const_req req, reply& reply) {
           reply.set_status(reply::status_type::internal_server_error);
@@ -143,14 +185,57 @@ void set_routes(ss::httpd::routes& r) {
           return "";
       },
       "txt");
+    auto create_multipart_response = new function_handler(
+      [](const_req req) {
+          BOOST_REQUIRE(!req.get_header("x-amz-content-sha256").empty());
+          if (req.query_parameters.contains("uploads")) {
+              return ss::sstring(multipart_create_payload);
+          }
+          // complete multipart upload
+          BOOST_REQUIRE_EQUAL(req.get_query_param("uploadId"), "test-upload");
+          BOOST_REQUIRE(
+            req.content.find("<PartNumber>2</PartNumber>")
+            != ss::sstring::npos);
+          BOOST_REQUIRE(
+            req.content.find("<ETag>etag-2</ETag>") != ss::sstring::npos);
+          return ss::sstring(multipart_complete_payload);
+      },
+      "txt");
+    auto upload_part_response = new function_handler(
+      [](const_req req, reply& reply) {
+          BOOST_REQUIRE(!req.get_header("x-amz-content-sha256").empty());
+          BOOST_REQUIRE_EQUAL(req.get_query_param("uploadId"), "test-upload");
+          auto part = req.get_query_param("partNumber");
+          reply.add_header("ETag", fmt::format("etag-{}", part));
+          return "";
+      },
+      "txt");
+    auto abort_multipart_response = new function_handler(
+      [](const_req req, reply& reply) {
+          BOOST_REQUIRE_EQUAL(req.get_query_param("uploadId"), "test-upload");
+          reply.set_status(reply::status_type::no_content);
+          return "";
+      },
+      "txt");
     r.add(operation_type::PUT, url("/test"), empty_put_response);
     r.add(operation_type::PUT, url("/test-error"), erroneous_put_response);
     r.add(operation_type::GET, url("/test"), get_response);
+    r.add(operation_type::GET, url("/test-range"), get_range_response);
+    r.add(operation_type::GET, url("/test-slow"), slow_get_response);
     r.add(operation_type::GET, url("/test-error"), erroneous_get_response);
     r.add(operation_type::DELETE, url("/test"), empty_delete_response);
     r.add(
       operation_type::DELETE, url("/test-error"), erroneous_delete_response);
     r.add(operation_type::GET, url("/"), list_objects_response);
+    r.add(
+      operation_type::POST,
+      url("/test-multipart"),
+      create_multipart_response);
+    r.add(operation_type::PUT, url("/test-multipart"), upload_part_response);
+    r.add(
+      operation_type::DELETE,
+      url("/test-multipart"),
+      abort_multipart_response);
 }
 
 /// Http server and client
@@ -262,6 +347,29 @@ SEASTAR_TEST_CASE(test_get_object_success) {
     });
 }
 
+SEASTAR_TEST_CASE(test_get_object_range) {
+    return ss::async([] {
+        auto conf = transport_configuration();
+        auto [server, client] = started_client_and_server(conf);
+        iobuf payload;
+        auto payload_stream = make_iobuf_ref_output_stream(payload);
+        auto http_response = client
+                               ->get_object(
+                                 s3::bucket_name("test-bucket"),
+                                 s3::object_key("test-range"),
+                                 100ms,
+                                 s3::byte_range{.first = 10, .last = 19})
+                               .get0();
+        auto input_stream = http_response->as_input_stream();
+        ss::copy(input_stream, payload_stream).get0();
+        iobuf_parser p(std::move(payload));
+        auto actual_payload = p.read_string(p.bytes_left());
+        BOOST_REQUIRE_EQUAL(
+          actual_payload, std::string_view(expected_payload + 10, 10));
+        server->stop().get();
+    });
+}
+
 SEASTAR_TEST_CASE(test_get_object_failure) {
     return ss::async([] {
         bool error_triggered = false;
@@ -286,6 +394,39 @@ SEASTAR_TEST_CASE(test_get_object_failure) {
     });
 }
 
+SEASTAR_TEST_CASE(test_multipart_upload) {
+    return ss::async([] {
+        auto conf = transport_configuration();
+        auto [server, client] = started_client_and_server(conf);
+        s3::bucket_name bucket("test-bucket");
+        s3::object_key key("test-multipart");
+        auto upload_id = client->create_multipart_upload(bucket, key, {}, 100ms)
+                           .get0();
+        BOOST_REQUIRE_EQUAL(upload_id, "test-upload");
+        std::vector<ss::sstring> etags;
+        for (size_t part = 1; part <= 2; part++) {
+            iobuf payload;
+            payload.append(expected_payload, expected_payload_size);
+            etags.push_back(client
+                              ->upload_part(
+                                bucket,
+                                key,
+                                upload_id,
+                                part,
+                                expected_payload_size,
+                                make_iobuf_input_stream(std::move(payload)),
+                                100ms)
+                              .get0());
+        }
+        BOOST_REQUIRE_EQUAL(etags[0], "etag-1");
+        BOOST_REQUIRE_EQUAL(etags[1], "etag-2");
+        client->complete_multipart_upload(bucket, key, upload_id, etags, 100ms)
+          .get();
+        client->abort_multipart_upload(bucket, key, upload_id, 100ms).get();
+        server->stop().get();
+    });
+}
+
 SEASTAR_TEST_CASE(test_delete_object_success) {
     return ss::async([] {
         auto conf = transport_configuration();
@@ -440,6 +581,44 @@ SEASTAR_TEST_CASE(test_client_pool_create_new_strategy) {
     });
 }
 
+SEASTAR_TEST_CASE(test_client_pool_keep_alive) {
+    return ss::async([] {
+        using namespace std::chrono_literals;
+        auto conf = transport_configuration();
+        conf.max_idle_time = 10s;
+        auto [server, pool] = started_pool_and_server(
+          2, s3::client_pool_overdraft_policy::wait_if_empty, conf);
+        pool->start().get();
+
+        for (size_t i = 0; i < 10; i++) {
+            auto lease = pool->acquire().get0();
+            auto http_response = lease.client
+                                   ->get_object(
+                                     s3::bucket_name("test-bucket"),
+                                     s3::object_key("test"),
+                                     100ms)
+                                   .get0();
+            iobuf payload;
+            auto payload_stream = make_iobuf_ref_output_stream(payload);
+            auto input_stream = http_response->as_input_stream();
+            ss::copy(input_stream, payload_stream).get();
+            BOOST_REQUIRE(lease.client->is_connected());
+        }
+        // sequential requests reuse the same keep-alive connection
+        auto connections = server->server()
+                             .map_reduce0(
+                               [](const ss::httpd::http_server& s) {
+                                   return s.total_connections();
+                               },
+                               uint64_t(0),
+                               std::plus<>())
+                             .get0();
+        BOOST_REQUIRE_EQUAL(connections, 1);
+        pool->stop().get();
+        server->stop().get();
+    });
+}
+
 SEASTAR_TEST_CASE(test_client_pool_reconnect) {
     return ss::async([] {
         using namespace std::chrono_literals;
@@ -480,3 +659,39 @@ SEASTAR_TEST_CASE(test_client_pool_reconnect) {
         server->stop().get();
     });
 }
+
+SEASTAR_TEST_CASE(test_client_pool_hedged_get) {
+    return ss::async([] {
+        auto conf = transport_configuration();
+        conf.hedge_percentile = 99;
+        auto [server, pool] = started_pool_and_server(
+          2, s3::client_pool_overdraft_policy::wait_if_empty, conf);
+        auto get = [&pool](const char* key) {
+            auto [lease, response] = pool
+                                       ->get_object(
+                                         s3::bucket_name("test-bucket"),
+                                         s3::object_key(key),
+                                         10s)
+                                       .get0();
+            iobuf payload;
+            auto payload_stream = make_iobuf_ref_output_stream(payload);
+            auto input_stream = response->as_input_stream();
+            ss::copy(input_stream, payload_stream).get();
+            iobuf_parser p(std::move(payload));
+            return p.read_string(p.bytes_left());
+        };
+
+        // the latencies of the first requests set the hedging delay
+        for (size_t i = 0; i < 100; i++) {
+            BOOST_REQUIRE_EQUAL(get("test"), expected_payload);
+        }
+
+        // the duplicate request is answered first
+        auto start = ss::lowres_clock::now();
+        BOOST_REQUIRE_EQUAL(get("test-slow"), expected_payload);
+        BOOST_REQUIRE_LT(ss::lowres_clock::now() - start, 1s);
+
+        pool->stop().get();
+        server->stop().get();
+    });
+}
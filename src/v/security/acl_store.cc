@@ -100,21 +100,17 @@ acl_store::find(resource_type resource, const ss::sstring& name) const {
         literals = it->second;
     }
 
-    /*
-     * the acls are sorted within (resource-type, pattern-type) bounds by name
-     * in reverse order so longer names (prefixes) appear first.
-     */
     std::vector<acl_matches::entry_set_ref> prefixes;
-    {
-        auto it = _acls.lower_bound(
-          resource_pattern(resource, name, pattern_type::prefixed));
-
-        auto end = _acls.upper_bound(resource_pattern(
-          resource, name.substr(0, 1), pattern_type::prefixed));
-
-        for (; it != end; ++it) {
-            if (std::string_view(name).starts_with(it->first.name())) {
-                prefixes.emplace_back(it->second);
+    if (const auto it = _prefixes.find(resource); it != _prefixes.end()) {
+        const prefix_node* node = &it->second;
+        for (const auto c : name) {
+            const auto child = node->children.find(c);
+            if (child == node->children.end()) {
+                break;
+            }
+            node = child->second.get();
+            if (node->entries) {
+                prefixes.emplace_back(*node->entries);
             }
         }
     }
@@ -187,6 +183,10 @@ std::vector<std::vector<acl_binding>> acl_store::remove_bindings(
           });
     }
 
+    if (!dry_run) {
+        rebuild_prefix_index();
+    }
+
     std::vector<std::vector<acl_binding>> res;
     res.assign(filters.size(), {});
 
@@ -197,6 +197,24 @@ std::vector<std::vector<acl_binding>> acl_store::remove_bindings(
     return res;
 }
 
+void acl_store::rebuild_prefix_index() {
+    _prefixes.clear();
+    for (const auto& [pattern, entries] : _acls) {
+        if (pattern.pattern() != pattern_type::prefixed || entries.empty()) {
+            continue;
+        }
+        prefix_node* node = &_prefixes[pattern.resource()];
+        for (const auto c : pattern.name()) {
+            auto& child = node->children[c];
+            if (!child) {
+                child = std::make_unique<prefix_node>();
+            }
+            node = child.get();
+        }
+        node->entries = &entries;
+    }
+}
+
 std::vector<acl_binding>
 acl_store::acls(const acl_binding_filter& filter) const {
     std::vector<acl_binding> result;
@@ -12,8 +12,11 @@
 #include "security/acl.h"
 
 #include <absl/container/btree_map.h>
+#include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
 
+#include <memory>
+
 namespace security {
 
 /*
@@ -121,6 +124,7 @@ public:
             entries.insert(binding.entry());
             entries.rehash();
         }
+        rebuild_prefix_index();
     }
 
     // remove bindings according the input filters and return the bindings that
@@ -153,8 +157,25 @@ private:
         }
     };
 
+    /*
+     * trie of the names of the prefixed patterns of a resource type. the node
+     * reached by walking a name refers to the entries of the prefixed pattern
+     * with that name, if any, so that the prefixes matching a resource name
+     * are found in a single walk of the name.
+     *
+     * the index is rebuilt after every update since the entries in the btree
+     * are not pointer stable.
+     */
+    struct prefix_node {
+        absl::flat_hash_map<char, std::unique_ptr<prefix_node>> children;
+        const acl_entry_set* entries{nullptr};
+    };
+
+    void rebuild_prefix_index();
+
     absl::btree_map<resource_pattern, acl_entry_set, resource_pattern_compare>
       _acls;
+    absl::flat_hash_map<resource_type, prefix_node> _prefixes;
 };
 
 } // namespace security
@@ -20,9 +20,13 @@
 #include <seastar/core/sstring.hh>
 #include <seastar/util/bool_class.hh>
 
+#include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
+#include <absl/hash/hash.h>
 #include <fmt/core.h>
 
+#include <string_view>
+
 namespace security {
 
 /*
@@ -35,12 +39,22 @@ namespace security {
  * perform any operation. When authorization occurs if the assocaited principal
  * is found in the set of superusers then its request will be permitted. If the
  * principal is not a superuser then normal ACL authorization applies.
+ *
+ * decision cache
+ * ==============
+ *
+ * The decisions are cached per principal, resource, operation and host, so
+ * that the ACLs are only matched on the first request of a client for a
+ * resource. The cache is cleared by any update of the ACLs or superusers, and
+ * once it holds max_cached_decisions.
  */
 class authorizer final {
 public:
     // allow operation when no ACL match is found
     using allow_empty_matches = ss::bool_class<struct allow_empty_matches_type>;
 
+    static constexpr size_t max_cached_decisions = 64 * 1024;
+
     authorizer()
       : authorizer(allow_empty_matches::no) {}
 
@@ -59,6 +73,7 @@ public:
             }
         }
         _store.add_bindings(bindings);
+        _decisions.clear();
     }
 
     /*
@@ -66,6 +81,9 @@ public:
      */
     std::vector<std::vector<acl_binding>> remove_bindings(
       const std::vector<acl_binding_filter>& filters, bool dry_run = false) {
+        if (!dry_run) {
+            _decisions.clear();
+        }
         return _store.remove_bindings(filters, dry_run);
     }
 
@@ -87,12 +105,44 @@ public:
       const acl_principal& principal,
       const acl_host& host) const {
         auto type = get_resource_type<T>();
-        auto acls = _store.find(type, resource_name());
+        const decision_key_view key{
+          type, resource_name(), operation, principal, host};
+        if (auto it = _decisions.find(key); it != _decisions.end()) {
+            return it->second;
+        }
+        auto allowed = do_authorized(
+          type, resource_name(), operation, principal, host);
+        if (_decisions.size() >= max_cached_decisions) {
+            _decisions.clear();
+        }
+        _decisions.emplace(
+          decision_key{
+            type, ss::sstring(resource_name()), operation, principal, host},
+          allowed);
+        return allowed;
+    }
+
+    void add_superuser(acl_principal principal) {
+        if (unlikely(seclog.is_shard_zero())) {
+            vlog(seclog.debug, "Adding superuser: {}", principal);
+        }
+        _superusers.emplace(std::move(principal));
+        _decisions.clear();
+    }
 
+private:
+    bool do_authorized(
+      resource_type type,
+      const ss::sstring& resource_name,
+      acl_operation operation,
+      const acl_principal& principal,
+      const acl_host& host) const {
         if (_superusers.contains(principal)) {
             return true;
         }
 
+        auto acls = _store.find(type, resource_name);
+
         if (acls.empty()) {
             if (operation == acl_operation::idempotent_write) {
                 return true;
@@ -116,17 +166,69 @@ public:
           });
     }
 
-    void add_superuser(acl_principal principal) {
-        if (unlikely(seclog.is_shard_zero())) {
-            vlog(seclog.debug, "Adding superuser: {}", principal);
+    struct decision_key {
+        resource_type type;
+        ss::sstring name;
+        acl_operation operation;
+        acl_principal principal;
+        acl_host host;
+
+        template<typename H>
+        friend H AbslHashValue(H h, const decision_key& k) {
+            return H::combine(
+              std::move(h),
+              k.type,
+              std::string_view(k.name),
+              k.operation,
+              k.principal,
+              k.host);
         }
-        _superusers.emplace(std::move(principal));
-    }
+    };
+
+    // lookup key of the cache, without copies of the name and principal
+    struct decision_key_view {
+        resource_type type;
+        std::string_view name;
+        acl_operation operation;
+        const acl_principal& principal;
+        const acl_host& host;
+
+        template<typename H>
+        friend H AbslHashValue(H h, const decision_key_view& k) {
+            return H::combine(
+              std::move(h), k.type, k.name, k.operation, k.principal, k.host);
+        }
+    };
+
+    struct decision_key_hash {
+        using is_transparent = void;
+
+        size_t operator()(const decision_key& k) const {
+            return absl::Hash<decision_key>{}(k);
+        }
+
+        size_t operator()(const decision_key_view& k) const {
+            return absl::Hash<decision_key_view>{}(k);
+        }
+    };
+
+    struct decision_key_eq {
+        using is_transparent = void;
+
+        template<typename A, typename B>
+        bool operator()(const A& a, const B& b) const {
+            return a.type == b.type && a.operation == b.operation
+                   && std::string_view(a.name) == std::string_view(b.name)
+                   && a.principal == b.principal && a.host == b.host;
+        }
+    };
 
-private:
     acl_store _store;
     absl::flat_hash_set<acl_principal> _superusers;
     allow_empty_matches _allow_empty_matches;
+    mutable absl::
+      flat_hash_map<decision_key, bool, decision_key_hash, decision_key_eq>
+        _decisions;
 };
 
 } // namespace security
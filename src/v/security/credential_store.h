@@ -68,6 +68,9 @@ public:
     const_iterator begin() const { return _credentials.cbegin(); }
     const_iterator end() const { return _credentials.cend(); }
 
+    size_t size() const { return _credentials.size(); }
+    void clear() { _credentials.clear(); }
+
 private:
     container_type _credentials;
 };
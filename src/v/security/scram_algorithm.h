@@ -16,6 +16,11 @@
 #include "ssx/sformat.h"
 #include "utils/base64.h"
 
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/future-util.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/preempt.hh>
+
 #include <absl/container/node_hash_map.h>
 
 /**
@@ -253,6 +258,25 @@ public:
           iterations);
     }
 
+    /**
+     * make_credentials() with preemption points in the hash of the password,
+     * for use on the reactor.
+     */
+    static ss::future<scram_credential>
+    make_credentials_async(ss::sstring password, int iterations) {
+        bytes salt = random_generators::get_bytes(SaltSize);
+        bytes salted_password = co_await hi_async(
+          bytes(password.begin(), password.end()), salt, iterations);
+        auto clientkey = client_key(salted_password);
+        auto storedkey = stored_key(clientkey);
+        auto serverkey = server_key(salted_password);
+        co_return scram_credential(
+          std::move(salt),
+          std::move(serverkey),
+          std::move(storedkey),
+          iterations);
+    }
+
     static bytes client_proof(
       bytes_view salted_password,
       const client_first_message& client_first,
@@ -286,6 +310,30 @@ public:
         return bytes(result.begin(), result.end());
     }
 
+    /**
+     * hi() with a preemption point between the iterations. The thousands of
+     * iterations of a credential take milliseconds, which would otherwise
+     * stall the reactor when many clients authenticate at once.
+     */
+    static ss::future<bytes> hi_async(bytes str, bytes salt, int iterations) {
+        MacType mac(str);
+        mac.update(salt);
+        mac.update(std::array<char, 4>{0, 0, 0, 1});
+        auto u1 = mac.reset();
+        auto prev = u1;
+        auto result = u1;
+        for (int i = 2; i <= iterations; i++) {
+            mac.update(prev);
+            auto ui = mac.reset();
+            result = result ^ ui;
+            prev = ui;
+            if (ss::need_preempt()) {
+                co_await ss::later();
+            }
+        }
+        co_return bytes(result.begin(), result.end());
+    }
+
     static bytes server_key(bytes_view salted_password) {
         MacType mac(salted_password);
         mac.update("Server Key");
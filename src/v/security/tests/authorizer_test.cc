@@ -874,4 +874,66 @@ BOOST_AUTO_TEST_CASE(topic_group_same_name) {
       kafka::group_id("topic-foo-xxx"), acl_operation::read, user, host));
 }
 
+BOOST_AUTO_TEST_CASE(authz_prefixed_resource_longest_and_shortest) {
+    acl_principal user(principal_type::user, "alice");
+    acl_host host("192.168.3.1");
+
+    authorizer auth;
+
+    // neighbours in the order of the names but not prefixes of the resource
+    std::vector<acl_binding> bindings;
+    bindings.emplace_back(
+      resource_pattern(resource_type::topic, "f", pattern_type::prefixed),
+      allow_read_acl);
+    bindings.emplace_back(
+      resource_pattern(resource_type::topic, "fob", pattern_type::prefixed),
+      allow_write_acl);
+    bindings.emplace_back(
+      resource_pattern(resource_type::topic, "foo-b", pattern_type::prefixed),
+      deny_read_acl);
+    bindings.emplace_back(
+      resource_pattern(resource_type::group, "foo", pattern_type::prefixed),
+      allow_write_acl);
+    auth.add_bindings(bindings);
+
+    BOOST_REQUIRE(auth.authorized(
+      model::topic("foo-a"), acl_operation::read, user, host));
+    BOOST_REQUIRE(!auth.authorized(
+      model::topic("foo-a"), acl_operation::write, user, host));
+    BOOST_REQUIRE(!auth.authorized(
+      model::topic("foo-bar"), acl_operation::read, user, host));
+    BOOST_REQUIRE(auth.authorized(
+      model::topic("fob"), acl_operation::write, user, host));
+    BOOST_REQUIRE(!auth.authorized(
+      model::topic("bar"), acl_operation::read, user, host));
+}
+
+BOOST_AUTO_TEST_CASE(authz_cached_decisions_invalidated) {
+    acl_principal user(principal_type::user, "alice");
+    acl_host host("192.168.3.1");
+    const model::topic topic("foo-3lkjfklwe");
+
+    authorizer auth;
+    BOOST_REQUIRE(!auth.authorized(topic, acl_operation::read, user, host));
+    BOOST_REQUIRE(!auth.authorized(topic, acl_operation::read, user, host));
+
+    std::vector<acl_binding> bindings;
+    bindings.emplace_back(default_resource, allow_read_acl);
+    auth.add_bindings(bindings);
+    BOOST_REQUIRE(auth.authorized(topic, acl_operation::read, user, host));
+    BOOST_REQUIRE(!auth.authorized(topic, acl_operation::write, user, host));
+
+    // a dry run leaves the decisions in place
+    std::vector<acl_binding_filter> filters;
+    filters.emplace_back(default_resource, acl_entry_filter::any());
+    auth.remove_bindings(filters, true);
+    BOOST_REQUIRE(auth.authorized(topic, acl_operation::read, user, host));
+
+    auth.remove_bindings(filters);
+    BOOST_REQUIRE(!auth.authorized(topic, acl_operation::read, user, host));
+
+    auth.add_superuser(user);
+    BOOST_REQUIRE(auth.authorized(topic, acl_operation::write, user, host));
+}
+
 } // namespace security
@@ -0,0 +1,126 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#pragma once
+
+#include "bytes/iobuf_parser.h"
+#include "reflection/type_traits.h"
+#include "serde/serde_exception.h"
+#include "ssx/sformat.h"
+#include "vlog.h"
+
+#include <seastar/core/byteorder.hh>
+
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+namespace serde {
+
+namespace detail {
+
+template<typename T>
+constexpr size_t fixed_size() {
+    if constexpr (reflection::is_named_type_v<T>) {
+        return fixed_size<typename T::type>();
+    } else if constexpr (
+      reflection::is_ss_bool_v<T> || std::is_same_v<T, bool>) {
+        return sizeof(int8_t);
+    } else if constexpr (std::is_enum_v<T>) {
+        return sizeof(std::underlying_type_t<T>);
+    } else {
+        static_assert(
+          std::is_integral_v<T>, "fixed blocks hold integral fields only");
+        return sizeof(T);
+    }
+}
+
+template<typename T>
+void put_fixed(char*& dst, const T& t) {
+    if constexpr (reflection::is_named_type_v<T>) {
+        put_fixed(dst, t());
+    } else if constexpr (
+      reflection::is_ss_bool_v<T> || std::is_same_v<T, bool>) {
+        put_fixed(dst, static_cast<int8_t>(bool(t)));
+    } else if constexpr (std::is_enum_v<T>) {
+        put_fixed(dst, static_cast<std::underlying_type_t<T>>(t));
+    } else {
+        const auto le_t = ss::cpu_to_le(t);
+        std::memcpy(dst, &le_t, sizeof(le_t));
+        dst += sizeof(le_t);
+    }
+}
+
+template<typename T>
+void get_fixed(const char*& src, T& t) {
+    if constexpr (reflection::is_named_type_v<T>) {
+        typename T::type v;
+        get_fixed(src, v);
+        t = T(v);
+    } else if constexpr (
+      reflection::is_ss_bool_v<T> || std::is_same_v<T, bool>) {
+        int8_t v;
+        get_fixed(src, v);
+        t = T(v != 0);
+    } else if constexpr (std::is_enum_v<T>) {
+        std::underlying_type_t<T> v;
+        get_fixed(src, v);
+        t = static_cast<T>(v);
+    } else {
+        T le_t;
+        std::memcpy(&le_t, src, sizeof(le_t));
+        t = ss::le_to_cpu(le_t);
+        src += sizeof(le_t);
+    }
+}
+
+} // namespace detail
+
+/// size of a field in a fixed block, known at compile time
+template<typename T>
+inline constexpr size_t fixed_size_v = detail::fixed_size<std::decay_t<T>>();
+
+/// size of a fixed block holding the fields
+template<typename... Fields>
+inline constexpr size_t fixed_block_size_v = (fixed_size_v<Fields> + ...);
+
+/**
+ * Writes the fields one after the other, little endian and without padding,
+ * as serde::write would write them one by one. The layout of the block is
+ * computed at compile time: the fields are packed into a stack buffer and
+ * appended to the output at once.
+ *
+ * Holds integral fields, their named types, boolean and enums with an
+ * explicitly specified underlying type.
+ */
+template<typename... Fields>
+void write_fixed_block(iobuf& out, const Fields&... fields) {
+    std::array<char, fixed_block_size_v<Fields...>> block;
+    char* dst = block.data();
+    (detail::put_fixed(dst, fields), ...);
+    out.append(block.data(), block.size());
+}
+
+/// Reads the fields of a block written by write_fixed_block
+template<typename... Fields>
+void read_fixed_block(iobuf_parser& in, Fields&... fields) {
+    std::array<char, fixed_block_size_v<Fields...>> block;
+    if (unlikely(in.bytes_left() < block.size())) {
+        throw serde_exception(fmt_with_ctx(
+          ssx::sformat,
+          "fixed block of {} bytes does not fit in bytes_left={}",
+          block.size(),
+          in.bytes_left()));
+    }
+    in.consume_to(block.size(), block.data());
+    const char* src = block.data();
+    (detail::get_fixed(src, fields), ...);
+}
+
+} // namespace serde
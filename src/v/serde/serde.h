@@ -20,6 +20,7 @@
 #include "utils/named_type.h"
 #include "vlog.h"
 
+#include <bit>
 #include <iosfwd>
 #include <numeric>
 #include <string>
@@ -108,6 +109,25 @@ inline constexpr auto const is_serde_compatible_v
     || std::is_same_v<T, iobuf>
     || std::is_same_v<T, ss::sstring>;
 
+/// \brief types encoded as their object representation on a little endian
+/// host, a vector of them is copied at once instead of element by element
+template<typename T>
+constexpr bool is_bulk_copyable() {
+    if constexpr (std::endian::native != std::endian::little) {
+        return false;
+    } else if constexpr (reflection::is_named_type_v<T>) {
+        return std::is_trivially_copyable_v<T>
+               && sizeof(T) == sizeof(typename T::type)
+               && is_bulk_copyable<typename T::type>();
+    } else {
+        return std::is_arithmetic_v<T> && !std::is_same_v<T, bool>
+               && is_serde_compatible_v<T>;
+    }
+}
+
+template<typename T>
+inline constexpr auto const is_bulk_copyable_v = is_bulk_copyable<T>();
+
 #if defined(SERDE_TEST)
 using serde_size_t = uint16_t;
 #else
@@ -170,8 +190,15 @@ void write(iobuf& out, T t) {
               t.size()));
         }
         write(out, static_cast<serde_size_t>(t.size()));
-        for (auto& el : t) {
-            write(out, std::move(el));
+        using value_type = typename Type::value_type;
+        if constexpr (is_bulk_copyable_v<value_type>) {
+            out.append(
+              reinterpret_cast<char const*>(t.data()),
+              t.size() * sizeof(value_type));
+        } else {
+            for (auto& el : t) {
+                write(out, std::move(el));
+            }
         }
     } else if constexpr (reflection::is_named_type_v<Type>) {
         return write(out, static_cast<typename Type::type>(t));
@@ -303,9 +330,23 @@ void read_nested(iobuf_parser& in, T& t, std::size_t const bytes_left_limit) {
         }
     } else if constexpr (reflection::is_std_vector_v<Type>) {
         using value_type = typename Type::value_type;
-        t.resize(read_nested<serde_size_t>(in, bytes_left_limit));
-        for (auto i = 0U; i < t.size(); ++i) {
-            t[i] = read_nested<value_type>(in, bytes_left_limit);
+        auto const size = read_nested<serde_size_t>(in, bytes_left_limit);
+        if constexpr (is_bulk_copyable_v<value_type>) {
+            auto const bytes = size * sizeof(value_type);
+            if (unlikely(in.bytes_left() < bytes)) {
+                throw serde_exception(fmt_with_ctx(
+                  ssx::sformat,
+                  "vector of {} bytes does not fit in bytes_left={}",
+                  bytes,
+                  in.bytes_left()));
+            }
+            t.resize(size);
+            in.consume_to(bytes, reinterpret_cast<char*>(t.data()));
+        } else {
+            t.resize(size);
+            for (auto i = 0U; i < t.size(); ++i) {
+                t[i] = read_nested<value_type>(in, bytes_left_limit);
+            }
         }
     } else if constexpr (reflection::is_named_type_v<Type>) {
         t = Type{read_nested<typename Type::type>(in, bytes_left_limit)};
@@ -7,12 +7,15 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "serde/fixed_block.h"
 #include "serde/serde.h"
 
 #include <seastar/core/reactor.hh>
 #include <seastar/core/sharded.hh>
 #include <seastar/testing/perf_tests.hh>
 
+#include <numeric>
+
 struct small_t
   : public serde::
       envelope<small_t, serde::version<3>, serde::compat_version<2>> {
@@ -88,3 +91,164 @@ PERF_TEST(big_10mb, serialize) {
 PERF_TEST(big_10mb, deserialize) {
     return deserialize_big(10 << 20 /*10MB*/, 1 << 15 /*32KB*/);
 }
+
+// fields of a raft vote request, the encoding and decoding of such fixed size
+// messages field by field is compared with fixed blocks
+struct vote_like_t {
+    int32_t node_id = 1;
+    int64_t node_revision = 2;
+    int32_t target_node_id = 3;
+    int64_t target_revision = 4;
+    int64_t group = 5;
+    int64_t term = 6;
+    int64_t prev_log_index = 7;
+    int64_t prev_log_term = 8;
+    bool leadership_transfer = false;
+};
+
+inline void write_fields(iobuf& out, const vote_like_t& v) {
+    serde::write(out, v.node_id);
+    serde::write(out, v.node_revision);
+    serde::write(out, v.target_node_id);
+    serde::write(out, v.target_revision);
+    serde::write(out, v.group);
+    serde::write(out, v.term);
+    serde::write(out, v.prev_log_index);
+    serde::write(out, v.prev_log_term);
+    serde::write(out, v.leadership_transfer);
+}
+
+inline void write_block(iobuf& out, const vote_like_t& v) {
+    serde::write_fixed_block(
+      out,
+      v.node_id,
+      v.node_revision,
+      v.target_node_id,
+      v.target_revision,
+      v.group,
+      v.term,
+      v.prev_log_index,
+      v.prev_log_term,
+      v.leadership_transfer);
+}
+
+// a batch of vote requests, as sent when a node looses many leaderships
+static constexpr size_t votes_per_message = 1000;
+
+PERF_TEST(vote_fields, serialize) {
+    iobuf o;
+    perf_tests::start_measuring_time();
+    for (size_t i = 0; i < votes_per_message; ++i) {
+        write_fields(o, vote_like_t{});
+    }
+    perf_tests::do_not_optimize(o);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vote_fixed_block, serialize) {
+    iobuf o;
+    perf_tests::start_measuring_time();
+    for (size_t i = 0; i < votes_per_message; ++i) {
+        write_block(o, vote_like_t{});
+    }
+    perf_tests::do_not_optimize(o);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vote_fields, deserialize) {
+    iobuf o;
+    for (size_t i = 0; i < votes_per_message; ++i) {
+        write_fields(o, vote_like_t{});
+    }
+    auto in = iobuf_parser(std::move(o));
+    perf_tests::start_measuring_time();
+    for (size_t i = 0; i < votes_per_message; ++i) {
+        vote_like_t v;
+        serde::read_nested(in, v.node_id, 0);
+        serde::read_nested(in, v.node_revision, 0);
+        serde::read_nested(in, v.target_node_id, 0);
+        serde::read_nested(in, v.target_revision, 0);
+        serde::read_nested(in, v.group, 0);
+        serde::read_nested(in, v.term, 0);
+        serde::read_nested(in, v.prev_log_index, 0);
+        serde::read_nested(in, v.prev_log_term, 0);
+        serde::read_nested(in, v.leadership_transfer, 0);
+        perf_tests::do_not_optimize(v);
+    }
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vote_fixed_block, deserialize) {
+    iobuf o;
+    for (size_t i = 0; i < votes_per_message; ++i) {
+        write_block(o, vote_like_t{});
+    }
+    auto in = iobuf_parser(std::move(o));
+    perf_tests::start_measuring_time();
+    for (size_t i = 0; i < votes_per_message; ++i) {
+        vote_like_t v;
+        serde::read_fixed_block(
+          in,
+          v.node_id,
+          v.node_revision,
+          v.target_node_id,
+          v.target_revision,
+          v.group,
+          v.term,
+          v.prev_log_index,
+          v.prev_log_term,
+          v.leadership_transfer);
+        perf_tests::do_not_optimize(v);
+    }
+    perf_tests::stop_measuring_time();
+}
+
+// offsets of a large controller or health report message, the vector is
+// copied at once, compared with writing and reading its elements one by one
+static constexpr size_t offsets_per_message = 10000;
+
+inline std::vector<int64_t> gen_offsets() {
+    std::vector<int64_t> ret(offsets_per_message);
+    std::iota(ret.begin(), ret.end(), 0);
+    return ret;
+}
+
+PERF_TEST(vector_elements, serialize) {
+    auto v = gen_offsets();
+    iobuf o;
+    perf_tests::start_measuring_time();
+    serde::write(o, static_cast<serde::serde_size_t>(v.size()));
+    for (auto e : v) {
+        serde::write(o, e);
+    }
+    perf_tests::do_not_optimize(o);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vector_bulk, serialize) {
+    auto v = gen_offsets();
+    iobuf o;
+    perf_tests::start_measuring_time();
+    serde::write(o, std::move(v));
+    perf_tests::do_not_optimize(o);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vector_elements, deserialize) {
+    auto in = iobuf_parser(serde::to_iobuf(gen_offsets()));
+    perf_tests::start_measuring_time();
+    std::vector<int64_t> v(serde::read_nested<serde::serde_size_t>(in, 0));
+    for (auto& e : v) {
+        serde::read_nested(in, e, 0);
+    }
+    perf_tests::do_not_optimize(v);
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vector_bulk, deserialize) {
+    auto b = serde::to_iobuf(gen_offsets());
+    perf_tests::start_measuring_time();
+    auto v = serde::from_iobuf<std::vector<int64_t>>(std::move(b));
+    perf_tests::do_not_optimize(v);
+    perf_tests::stop_measuring_time();
+}
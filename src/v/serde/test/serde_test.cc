@@ -10,6 +10,7 @@
 #include "hashing/crc32c.h"
 #include "model/fundamental.h"
 #include "serde/envelope.h"
+#include "serde/fixed_block.h"
 #include "serde/serde.h"
 
 #include <seastar/core/scheduling.hh>
@@ -210,6 +211,40 @@ SEASTAR_THREAD_TEST_CASE(vector_test) {
     BOOST_CHECK((m == std::vector{1, 2, 3}));
 }
 
+SEASTAR_THREAD_TEST_CASE(bulk_copied_vector_test) {
+    static_assert(serde::is_bulk_copyable_v<int64_t>);
+    static_assert(serde::is_bulk_copyable_v<model::offset>);
+    static_assert(!serde::is_bulk_copyable_v<bool>);
+    static_assert(!serde::is_bulk_copyable_v<ss::sstring>);
+
+    std::vector<model::offset> offsets;
+    std::vector<double> doubles;
+    for (int64_t i = 0; i < 1000; ++i) {
+        offsets.emplace_back(i * 0x10001);
+        doubles.push_back(double(i) / 3);
+    }
+
+    // same encoding as the one of the elements written one by one
+    iobuf expected;
+    serde::write(expected, static_cast<serde::serde_size_t>(offsets.size()));
+    for (auto o : offsets) {
+        serde::write(expected, o);
+    }
+    auto b = serde::to_iobuf(offsets);
+    BOOST_REQUIRE(b == expected);
+    BOOST_REQUIRE(
+      serde::from_iobuf<std::vector<model::offset>>(std::move(b)) == offsets);
+    BOOST_REQUIRE(
+      serde::from_iobuf<std::vector<double>>(serde::to_iobuf(doubles))
+      == doubles);
+
+    auto truncated = serde::to_iobuf(offsets);
+    truncated.trim_back(1);
+    BOOST_CHECK_THROW(
+      serde::from_iobuf<std::vector<model::offset>>(std::move(truncated)),
+      serde::serde_exception);
+}
+
 // struct with differing sizes:
 // vector length may take different size (vint)
 // vector data may have different size (_ints.size() * sizeof(int))
@@ -494,3 +529,55 @@ SEASTAR_THREAD_TEST_CASE(compat_test_half_field_2) {
       half_field_2{.a = 1, .b = 2, .c = 3, .d = 0x1234});
     BOOST_CHECK_THROW(serde::from_iobuf<big>(std::move(b1)), std::exception);
 }
+
+SEASTAR_THREAD_TEST_CASE(fixed_block_test) {
+    enum class fixed_enum : int16_t { a = 1, b = 0x1234 };
+    using flag = ss::bool_class<struct flag_tag>;
+
+    iobuf expected;
+    serde::write(expected, model::offset(42));
+    serde::write(expected, int8_t(-3));
+    serde::write(expected, true);
+    serde::write(expected, flag::yes);
+    serde::write_enum(expected, fixed_enum::b);
+    serde::write(expected, uint32_t(0xdeadbeef));
+
+    iobuf b;
+    serde::write_fixed_block(
+      b,
+      model::offset(42),
+      int8_t(-3),
+      true,
+      flag::yes,
+      fixed_enum::b,
+      uint32_t(0xdeadbeef));
+    static_assert(
+      serde::fixed_block_size_v<
+        model::offset,
+        int8_t,
+        bool,
+        flag,
+        fixed_enum,
+        uint32_t> == 17);
+    BOOST_REQUIRE(b == expected);
+
+    model::offset o;
+    int8_t i = 0;
+    bool v = false;
+    flag f = flag::no;
+    fixed_enum e = fixed_enum::a;
+    uint32_t u = 0;
+    auto in = iobuf_parser(std::move(b));
+    serde::read_fixed_block(in, o, i, v, f, e, u);
+    BOOST_REQUIRE_EQUAL(in.bytes_left(), 0);
+    BOOST_REQUIRE_EQUAL(o, model::offset(42));
+    BOOST_REQUIRE_EQUAL(i, -3);
+    BOOST_REQUIRE(v);
+    BOOST_REQUIRE(f == flag::yes);
+    BOOST_REQUIRE(e == fixed_enum::b);
+    BOOST_REQUIRE_EQUAL(u, 0xdeadbeef);
+
+    auto short_in = iobuf_parser(serde::to_iobuf(int32_t(1)));
+    BOOST_CHECK_THROW(
+      serde::read_fixed_block(short_in, o), serde::serde_exception);
+}
@@ -13,12 +13,19 @@
 #include "utils/concepts-enabled.h"
 #include "utils/functional.h"
 
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/future-util.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/later.hh>
+#include <seastar/core/preempt.hh>
+#include <seastar/core/smp.hh>
 #include <seastar/core/when_all.hh>
 
 #include <algorithm>
 #include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
 
 namespace ssx {
 
@@ -258,4 +265,134 @@ inline auto parallel_transform(Rng rng, Func func) {
       });
 }
 
+/// \brief Run tasks in parallel, at most \c max_concurrent of them at a time,
+/// and wait for completion (range version).
+///
+/// Like the unbounded version, run \c func on each element of \c rng and
+/// return a \c future<> containing a \c std::vector<> of the results, in the
+/// order of the range. A task is started as soon as one of the tasks in
+/// flight completes. In case any of the tasks fails, one of the exceptions
+/// is returned once the tasks in flight completed, the tasks not started yet
+/// are not run.
+///
+/// \param rng an \c InputRange, its elements are moved to \c func
+/// \param max_concurrent the maximum number of tasks in flight
+/// \param func Function to invoke with each element in the range (will be
+/// futurized if it doesn't return a \c future<>)
+// clang-format off
+template<typename Rng, typename Func>
+CONCEPT(requires requires(Func f, Rng r) {
+    r.begin();
+    r.end();
+    { r.begin() != r.begin() } -> std::convertible_to<bool>;
+    seastar::futurize_invoke(f, std::move(*r.begin())).get0();
+})
+// clang-format on
+inline auto parallel_transform(Rng rng, size_t max_concurrent, Func func)
+  -> seastar::future<std::vector<
+    decltype(seastar::futurize_invoke(func, std::move(*rng.begin())).get0())>> {
+    using result_type = decltype(
+      seastar::futurize_invoke(func, std::move(*rng.begin())).get0());
+    std::vector<std::optional<result_type>> res(
+      std::distance(rng.begin(), rng.end()));
+    // the tasks are started in the order of the range
+    size_t next = 0;
+    co_await seastar::max_concurrent_for_each(
+      rng, max_concurrent, [&res, &next, &func](auto&& value) {
+          return seastar::futurize_invoke(func, std::move(value))
+            .then([&res, i = next++](result_type r) {
+                res[i].emplace(std::move(r));
+            });
+      });
+    std::vector<result_type> ret;
+    ret.reserve(res.size());
+    for (auto& r : res) {
+        ret.push_back(std::move(*r));
+    }
+    co_return ret;
+}
+
+/// \brief Invoke the synchronous \c func on each element of the range
+/// [\c begin, \c end), yielding to the reactor whenever the task ran out
+/// of its quota.
+///
+/// Unlike seastar::do_for_each the function isn't futurized, a loop over a
+/// large in memory collection costs a preemption check per element. The
+/// range must stay valid, and not be modified, until the future resolves.
+template<typename Iterator, typename Func>
+inline seastar::future<>
+async_for_each(Iterator begin, Iterator end, Func func) {
+    for (; begin != end; ++begin) {
+        func(*begin);
+        if (seastar::need_preempt()) {
+            co_await seastar::later();
+        }
+    }
+}
+
+/// \brief async_for_each (range version)
+template<typename Rng, typename Func>
+inline seastar::future<> async_for_each(Rng& rng, Func func) {
+    return async_for_each(rng.begin(), rng.end(), std::move(func));
+}
+
+/// \brief Map-reduce of items on the shards they belong to, in batches.
+///
+/// The items are grouped by the shard returned by \c shard_of and sent in
+/// batches of at most \c max_batch items, a cross shard message per batch
+/// instead of one per item as with a submit_to per item. A copy of \c mapper
+/// is invoked on the destination shard with a \c std::vector<> of the items
+/// of a batch, the values it returns are reduced with \c reduce on the
+/// calling shard as the batches complete, in no particular order. All the
+/// batches are in flight at once.
+///
+/// \param items moved to the shards they belong to
+/// \param shard_of returns the \c seastar::shard_id of an item
+/// \param max_batch the maximum number of items in a batch
+/// \param mapper Function to invoke with each batch (will be futurized if it
+/// doesn't return a \c future<>)
+/// \param initial the initial value of the reduction
+/// \param reduce binary function of the reduced value and a mapped one
+template<
+  typename T,
+  typename ShardOf,
+  typename Mapper,
+  typename Initial,
+  typename Reduce>
+inline seastar::future<Initial> map_reduce_on_shards(
+  std::vector<T> items,
+  ShardOf shard_of,
+  size_t max_batch,
+  Mapper mapper,
+  Initial initial,
+  Reduce reduce) {
+    struct batch {
+        seastar::shard_id shard;
+        std::vector<T> items;
+    };
+    std::vector<batch> batches;
+    // index of the batch being filled for every shard
+    std::vector<std::optional<size_t>> filling(seastar::smp::count);
+    for (auto& item : items) {
+        seastar::shard_id shard = shard_of(std::as_const(item));
+        auto& idx = filling[shard];
+        if (!idx || batches[*idx].items.size() >= max_batch) {
+            idx = batches.size();
+            batches.push_back(batch{.shard = shard});
+        }
+        batches[*idx].items.push_back(std::move(item));
+    }
+    co_return co_await seastar::map_reduce(
+      std::make_move_iterator(batches.begin()),
+      std::make_move_iterator(batches.end()),
+      [&mapper](batch b) {
+          return seastar::smp::submit_to(
+            b.shard, [mapper, items = std::move(b.items)]() mutable {
+                return seastar::futurize_invoke(mapper, std::move(items));
+            });
+      },
+      std::move(initial),
+      std::move(reduce));
+}
+
 } // namespace ssx
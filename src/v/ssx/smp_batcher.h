@@ -0,0 +1,132 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include <seastar/core/do_with.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/later.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ssx {
+
+/**
+ * \brief Sharded service grouping cross shard calls, one message per
+ * destination shard and poll cycle.
+ *
+ * seastar::smp::submit_to sends a message to the queue of the destination
+ * shard for every call, and another one back with its result. When many
+ * small calls are issued towards the same shard, e.g. by the kafka handlers
+ * dispatching the partitions of every request to their home shard, the
+ * cross shard queues become a cost of their own.
+ *
+ * Calls issued for a shard are queued until the tasks already scheduled on
+ * the reactor ran, then sent together in a single message. The destination
+ * shard queues the results back to the source shard the same way, a result
+ * is sent as soon as its call completes, it never waits for the other calls
+ * of the batch.
+ *
+ * Unlike submit_to the function is destroyed on the destination shard, once
+ * its future resolved.
+ */
+class smp_batcher final
+  : public seastar::peering_sharded_service<smp_batcher> {
+public:
+    explicit smp_batcher(
+      seastar::smp_service_group ssg = seastar::default_smp_service_group())
+      : _opts(ssg)
+      , _queues(seastar::smp::count) {}
+
+    template<typename Func>
+    auto submit_to(seastar::shard_id shard, Func&& func) {
+        using futurator = seastar::futurize<std::invoke_result_t<Func>>;
+        using future_type = typename futurator::type;
+        using promise_type = typename futurator::promise_type;
+        if (shard == seastar::this_shard_id()) {
+            return futurator::invoke(std::forward<Func>(func));
+        }
+        auto p = std::make_unique<promise_type>();
+        auto f = p->get_future();
+        post(
+          shard,
+          [func = std::forward<Func>(func),
+           p = std::move(p),
+           source = seastar::this_shard_id(),
+           &container = container()]() mutable {
+              (void)seastar::do_with(
+                std::move(func),
+                [](auto& func) { return futurator::invoke(func); })
+                .then_wrapped([p = std::move(p), source, &container](
+                                future_type r) mutable {
+                    container.local().post(
+                      source, [p = std::move(p), r = std::move(r)]() mutable {
+                          r.forward_to(std::move(*p));
+                      });
+                });
+          });
+        return f;
+    }
+
+    seastar::future<> stop() { return _gate.close(); }
+
+    /// cross shard messages sent, and calls or results carried by them
+    uint64_t messages() const { return _messages; }
+    uint64_t batched() const { return _batched; }
+
+private:
+    using task = seastar::noncopyable_function<void()>;
+
+    void post(seastar::shard_id shard, task t) {
+        if (_gate.is_closed()) {
+            (void)seastar::smp::submit_to(shard, _opts, std::move(t));
+            return;
+        }
+        auto& q = _queues[shard];
+        q.push_back(std::move(t));
+        if (q.size() == 1) {
+            // first task queued for the shard, the tasks posted until the
+            // reactor gets back to us are sent together
+            (void)seastar::with_gate(_gate, [this, shard] {
+                return seastar::later().then(
+                  [this, shard] { return flush(shard); });
+            });
+        }
+    }
+
+    seastar::future<> flush(seastar::shard_id shard) {
+        auto tasks = std::exchange(_queues[shard], {});
+        ++_messages;
+        _batched += tasks.size();
+        return seastar::smp::submit_to(
+          shard, _opts, [tasks = std::move(tasks)]() mutable {
+              for (auto& t : tasks) {
+                  t();
+              }
+          });
+    }
+
+    seastar::smp_submit_to_options _opts;
+    std::vector<std::vector<task>> _queues;
+    seastar::gate _gate;
+    uint64_t _messages{0};
+    uint64_t _batched{0};
+};
+
+} // namespace ssx
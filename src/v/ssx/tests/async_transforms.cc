@@ -9,6 +9,8 @@
 
 #include "ssx/future-util.h"
 
+#include <seastar/core/sleep.hh>
+#include <seastar/core/smp.hh>
 #include <seastar/core/sstring.hh>
 #include <seastar/testing/thread_test_case.hh>
 
@@ -116,3 +118,72 @@ SEASTAR_THREAD_TEST_CASE(parallel_transform_range_test) {
     BOOST_TEST(std::equal(
       out_range.begin(), out_range.end(), expected.begin(), expected.end()));
 }
+
+SEASTAR_THREAD_TEST_CASE(bounded_parallel_transform_test) {
+    std::vector<int> input(100);
+    std::iota(input.begin(), input.end(), 0);
+
+    size_t in_flight = 0;
+    size_t max_in_flight = 0;
+    std::vector<int> out = ssx::parallel_transform(
+                             std::move(input),
+                             4,
+                             [&](int v) {
+                                 max_in_flight = std::max(
+                                   max_in_flight, ++in_flight);
+                                 // later tasks complete first
+                                 return ss::sleep(std::chrono::microseconds(
+                                                    100 - v))
+                                   .then([&in_flight, v] {
+                                       --in_flight;
+                                       return v * 2;
+                                   });
+                             })
+                             .get0();
+    BOOST_REQUIRE_EQUAL(max_in_flight, 4);
+    BOOST_REQUIRE_EQUAL(out.size(), 100);
+    for (int i = 0; i < 100; ++i) {
+        BOOST_REQUIRE_EQUAL(out[i], i * 2);
+    }
+}
+
+SEASTAR_THREAD_TEST_CASE(async_for_each_test) {
+    std::vector<int> input(100'000);
+    std::iota(input.begin(), input.end(), 0);
+    int64_t sum = 0;
+    ssx::async_for_each(input, [&sum](int v) { sum += v; }).get();
+    BOOST_REQUIRE_EQUAL(sum, int64_t(100'000) * 99'999 / 2);
+}
+
+SEASTAR_THREAD_TEST_CASE(map_reduce_on_shards_test) {
+    std::vector<size_t> input(1000);
+    std::iota(input.begin(), input.end(), 0);
+    size_t batches = 0;
+    auto sum = ssx::map_reduce_on_shards(
+                 std::move(input),
+                 [](size_t v) { return v % ss::smp::count; },
+                 16,
+                 [](std::vector<size_t> batch) {
+                     // runs on the other shards, the errors are reported on
+                     // the calling one
+                     if (batch.size() > 16) {
+                         throw std::runtime_error("batch too large");
+                     }
+                     size_t sum = 0;
+                     for (auto v : batch) {
+                         if (v % ss::smp::count != ss::this_shard_id()) {
+                             throw std::runtime_error("wrong shard");
+                         }
+                         sum += v;
+                     }
+                     return sum;
+                 },
+                 size_t(0),
+                 [&batches](size_t acc, size_t v) {
+                     ++batches;
+                     return acc + v;
+                 })
+                 .get0();
+    BOOST_REQUIRE_EQUAL(sum, size_t(1000) * 999 / 2);
+    BOOST_REQUIRE_GE(batches, 1000 / 16);
+}
@@ -0,0 +1,132 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "seastarx.h"
+#include "ssx/future-util.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <numeric>
+#include <vector>
+
+/// the ssx parallel algorithms compared with the hand rolled loops they
+/// replace, over `items` elements. Run with many cores (e.g. -c 8) for the
+/// cross shard map-reduce.
+template<size_t items>
+struct parallel_bench {
+    static std::vector<size_t> input() {
+        std::vector<size_t> ret(items);
+        std::iota(ret.begin(), ret.end(), 0);
+        return ret;
+    }
+
+    /// a synchronous loop over a large collection with preemption points
+    ss::future<size_t> do_for_each() {
+        auto in = input();
+        size_t sum = 0;
+        perf_tests::start_measuring_time();
+        co_await ss::do_for_each(in, [&sum](size_t v) { sum += v; });
+        perf_tests::stop_measuring_time();
+        perf_tests::do_not_optimize(sum);
+        co_return items;
+    }
+
+    ss::future<size_t> async_for_each() {
+        auto in = input();
+        size_t sum = 0;
+        perf_tests::start_measuring_time();
+        co_await ssx::async_for_each(in, [&sum](size_t v) { sum += v; });
+        perf_tests::stop_measuring_time();
+        perf_tests::do_not_optimize(sum);
+        co_return items;
+    }
+
+    /// bounded transform of the items, 64 at a time
+    ss::future<size_t> max_concurrent_for_each() {
+        auto in = input();
+        std::vector<size_t> out(items);
+        size_t next = 0;
+        perf_tests::start_measuring_time();
+        co_await ss::max_concurrent_for_each(
+          in, 64, [&out, &next](size_t v) {
+              return ss::later().then(
+                [&out, i = next++, v] { out[i] = v * 2; });
+          });
+        perf_tests::stop_measuring_time();
+        perf_tests::do_not_optimize(out);
+        co_return items;
+    }
+
+    ss::future<size_t> parallel_transform() {
+        auto in = input();
+        perf_tests::start_measuring_time();
+        auto out = co_await ssx::parallel_transform(
+          std::move(in), 64, [](size_t v) {
+              return ss::later().then([v] { return v * 2; });
+          });
+        perf_tests::stop_measuring_time();
+        perf_tests::do_not_optimize(out);
+        co_return items;
+    }
+
+    /// sum of the items on the shards they belong to, a message per item
+    ss::future<size_t> submit_per_item() {
+        auto in = input();
+        perf_tests::start_measuring_time();
+        auto sum = co_await ss::map_reduce(
+          in.begin(),
+          in.end(),
+          [](size_t v) {
+              return ss::smp::submit_to(
+                v % ss::smp::count, [v] { return v * 2; });
+          },
+          size_t(0),
+          std::plus<>());
+        perf_tests::stop_measuring_time();
+        perf_tests::do_not_optimize(sum);
+        co_return items;
+    }
+
+    ss::future<size_t> map_reduce_on_shards() {
+        auto in = input();
+        perf_tests::start_measuring_time();
+        auto sum = co_await ssx::map_reduce_on_shards(
+          std::move(in),
+          [](size_t v) { return v % ss::smp::count; },
+          256,
+          [](std::vector<size_t> batch) {
+              size_t sum = 0;
+              for (auto v : batch) {
+                  sum += v * 2;
+              }
+              return sum;
+          },
+          size_t(0),
+          std::plus<>());
+        perf_tests::stop_measuring_time();
+        perf_tests::do_not_optimize(sum);
+        co_return items;
+    }
+};
+
+using items_10K = parallel_bench<10000>;
+using items_1M = parallel_bench<1000000>;
+
+PERF_TEST_F(items_1M, do_for_each) { return do_for_each(); }
+PERF_TEST_F(items_1M, async_for_each) { return async_for_each(); }
+PERF_TEST_F(items_10K, max_concurrent_for_each) {
+    return max_concurrent_for_each();
+}
+PERF_TEST_F(items_10K, parallel_transform) { return parallel_transform(); }
+PERF_TEST_F(items_10K, submit_per_item) { return submit_per_item(); }
+PERF_TEST_F(items_10K, map_reduce_on_shards) {
+    return map_reduce_on_shards();
+}
@@ -0,0 +1,52 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "ssx/smp_batcher.h"
+
+#include <seastar/core/sharded.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <seastarx.h>
+
+#include <stdexcept>
+
+SEASTAR_THREAD_TEST_CASE(batches_calls_to_shard) {
+    ss::sharded<ssx::smp_batcher> batcher;
+    batcher.start().get();
+    const ss::shard_id target = ss::smp::count > 1 ? 1 : 0;
+
+    std::vector<ss::future<std::pair<ss::shard_id, int>>> calls;
+    for (int i = 0; i < 100; ++i) {
+        calls.push_back(batcher.local().submit_to(target, [i] {
+            return std::make_pair(ss::this_shard_id(), i);
+        }));
+    }
+    auto results = ss::when_all_succeed(calls.begin(), calls.end()).get0();
+    for (int i = 0; i < 100; ++i) {
+        BOOST_REQUIRE_EQUAL(results[i].first, target);
+        BOOST_REQUIRE_EQUAL(results[i].second, i);
+    }
+    if (target != ss::this_shard_id()) {
+        BOOST_REQUIRE_EQUAL(batcher.local().messages(), 1);
+        BOOST_REQUIRE_EQUAL(batcher.local().batched(), 100);
+    }
+
+    // errors and asynchronous calls are carried back as well
+    auto failed = batcher.local().submit_to(target, []() -> ss::future<int> {
+        return ss::later().then(
+          []() -> int { throw std::runtime_error("failed"); });
+    });
+    auto later = batcher.local().submit_to(
+      target, [] { return ss::later().then([] { return 42; }); });
+    BOOST_REQUIRE_THROW(failed.get(), std::runtime_error);
+    BOOST_REQUIRE_EQUAL(later.get0(), 42);
+
+    batcher.stop().get();
+}
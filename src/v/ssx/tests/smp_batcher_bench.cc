@@ -0,0 +1,68 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "seastarx.h"
+#include "ssx/smp_batcher.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/smp.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <boost/range/irange.hpp>
+
+/// every shard issues `calls` tiny calls spread over all the other shards,
+/// a call per message with submit_to, or batched by ssx::smp_batcher. Run
+/// with many cores (e.g. -c 32) to load the cross shard queues.
+template<size_t calls>
+struct smp_batcher_bench {
+    smp_batcher_bench() { _batcher.start().get(); }
+    ~smp_batcher_bench() { _batcher.stop().get(); }
+
+    template<typename Submit>
+    ss::future<size_t> run(Submit submit) {
+        if (ss::smp::count < 2) {
+            co_return 0;
+        }
+        perf_tests::start_measuring_time();
+        co_await ss::smp::invoke_on_all([this, submit] {
+            return ss::parallel_for_each(
+              boost::irange<size_t>(0, calls), [this, submit](size_t i) {
+                  auto other = 1 + i % (ss::smp::count - 1);
+                  auto shard = (ss::this_shard_id() + other) % ss::smp::count;
+                  return submit(_batcher.local(), shard).discard_result();
+              });
+        });
+        perf_tests::stop_measuring_time();
+        co_return calls * ss::smp::count;
+    }
+
+    ss::future<size_t> single_hop() {
+        return run([](ssx::smp_batcher&, ss::shard_id shard) {
+            return ss::smp::submit_to(
+              shard, [] { return ss::this_shard_id(); });
+        });
+    }
+
+    ss::future<size_t> batched() {
+        return run([](ssx::smp_batcher& b, ss::shard_id shard) {
+            return b.submit_to(shard, [] { return ss::this_shard_id(); });
+        });
+    }
+
+    ss::sharded<ssx::smp_batcher> _batcher;
+};
+
+using calls_1K = smp_batcher_bench<1000>;
+using calls_16K = smp_batcher_bench<16000>;
+
+PERF_TEST_F(calls_1K, single_hop) { return single_hop(); }
+PERF_TEST_F(calls_1K, batched) { return batched(); }
+PERF_TEST_F(calls_16K, single_hop) { return single_hop(); }
+PERF_TEST_F(calls_16K, batched) { return batched(); }
@@ -0,0 +1,73 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/api.h"
+
+#include "storage/segment_utils.h"
+
+#include <seastar/core/coroutine.hh>
+
+namespace storage {
+
+ss::future<> move_persistent_state(
+  model::ntp ntp,
+  ss::shard_id source_shard,
+  ss::shard_id target_shard,
+  ss::sharded<api>& api) {
+    struct persistent_state {
+        std::optional<iobuf> start_offset;
+        std::optional<iobuf> clean_shutdown;
+    };
+    using state_ptr = std::unique_ptr<persistent_state>;
+    using state_fptr = ss::foreign_ptr<std::unique_ptr<persistent_state>>;
+
+    state_fptr state = co_await api.invoke_on(
+      source_shard, [ntp](storage::api& api) {
+          const auto ks = kvstore::key_space::storage;
+          persistent_state state{
+            .start_offset = api.kvs().get(
+              ks, internal::start_offset_key(ntp)),
+            .clean_shutdown = api.kvs().get(
+              ks, internal::clean_shutdown_key(ntp))};
+          return ss::make_foreign<state_ptr>(
+            std::make_unique<persistent_state>(std::move(state)));
+      });
+
+    co_await api.invoke_on(
+      target_shard, [ntp, state = std::move(state)](storage::api& api) {
+          const auto ks = kvstore::key_space::storage;
+          std::vector<ss::future<>> write_futures;
+          write_futures.reserve(2);
+          if (state->start_offset) {
+              write_futures.push_back(api.kvs().put(
+                ks,
+                internal::start_offset_key(ntp),
+                state->start_offset->copy()));
+          }
+          if (state->clean_shutdown) {
+              write_futures.push_back(api.kvs().put(
+                ks,
+                internal::clean_shutdown_key(ntp),
+                state->clean_shutdown->copy()));
+          }
+          return ss::when_all_succeed(
+            write_futures.begin(), write_futures.end());
+      });
+
+    // remove on source shard
+    co_await api.invoke_on(source_shard, [ntp](storage::api& api) {
+        const auto ks = kvstore::key_space::storage;
+        return ss::when_all_succeed(
+                 api.kvs().remove(ks, internal::start_offset_key(ntp)),
+                 api.kvs().remove(ks, internal::clean_shutdown_key(ntp)))
+          .discard_result();
+    });
+}
+
+} // namespace storage
@@ -15,6 +15,8 @@
 #include "storage/kvstore.h"
 #include "storage/log_manager.h"
 
+#include <seastar/core/sharded.hh>
+
 namespace storage {
 
 class api {
@@ -27,6 +29,7 @@ public:
         _kvstore = std::make_unique<kvstore>(_kv_conf);
         return _kvstore->start().then([this] {
             _log_mgr = std::make_unique<log_manager>(_log_conf, kvs());
+            return _log_mgr->start();
         });
     }
 
@@ -52,4 +55,16 @@ private:
     std::unique_ptr<log_manager> _log_mgr;
 };
 
+/**
+ * moves the storage state of the log kept in the KV store, i.e. the start
+ * offset and the clean shutdown record, from the KV store on source shard to
+ * the one on target shard. Used when a closed log is reopened from the same
+ * directory on another shard of the node.
+ */
+ss::future<> move_persistent_state(
+  model::ntp,
+  ss::shard_id source_shard,
+  ss::shard_id target_shard,
+  ss::sharded<api>&);
+
 } // namespace storage
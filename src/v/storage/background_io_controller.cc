@@ -0,0 +1,110 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#include "storage/background_io_controller.h"
+
+#include "config/configuration.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/metrics.hh>
+#include <seastar/util/log.hh>
+
+#include <algorithm>
+
+namespace storage {
+static ss::logger bg_io_log{"background_io_ctrl"};
+
+background_io_controller::background_io_controller(
+  background_io_controller_config cfg,
+  std::vector<background_class> classes,
+  latency_sampler sample_latency,
+  scale_listener on_scale)
+  : _cfg(cfg)
+  , _classes(std::move(classes))
+  , _sample_latency(std::move(sample_latency))
+  , _on_scale(std::move(on_scale)) {
+    _cfg.min_scale = std::clamp(_cfg.min_scale, 0.0, 1.0);
+}
+
+ss::future<> background_io_controller::start() {
+    _sampling_timer.set_callback([this] {
+        (void)ss::with_gate(_gate, [this] {
+            return update().then([this] {
+                if (!_gate.is_closed()) {
+                    _sampling_timer.arm(_cfg.sampling_interval);
+                }
+            });
+        });
+    });
+    _sampling_timer.arm(_cfg.sampling_interval);
+    return ss::now();
+}
+
+ss::future<> background_io_controller::stop() {
+    _sampling_timer.cancel();
+    return _gate.close();
+}
+
+ss::future<> background_io_controller::update() {
+    _last_latency = _sample_latency();
+    const auto prev = _scale;
+    if (_last_latency && *_last_latency > _cfg.latency_target) {
+        _scale = std::max(_cfg.min_scale, _scale * decrease_factor);
+    } else {
+        _scale = std::min(1.0, _scale + increase_step);
+    }
+    vlog(
+      bg_io_log.trace,
+      "foreground p99: {}us, target: {}ms, scale: {} -> {}",
+      _last_latency ? _last_latency->count() : 0,
+      _cfg.latency_target.count(),
+      prev,
+      _scale);
+    if (_scale == prev) {
+        co_return;
+    }
+    co_await apply();
+}
+
+ss::future<> background_io_controller::apply() {
+    _on_scale(_scale);
+    for (auto& c : _classes) {
+        const auto shares = std::max<uint32_t>(
+          1, static_cast<uint32_t>(static_cast<double>(c.shares) * _scale));
+        co_await c.iopc.update_shares(shares);
+    }
+}
+
+void background_io_controller::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    namespace sm = ss::metrics;
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("storage:background_io:controller"),
+      {
+        sm::make_gauge(
+          "scale",
+          [this] { return _scale; },
+          sm::description("Scale applied to the shares of background IO")),
+        sm::make_gauge(
+          "foreground_latency_us",
+          [this] {
+              return _last_latency.value_or(std::chrono::microseconds(0))
+                .count();
+          },
+          sm::description("p99 of the foreground latency at the last sample")),
+      });
+}
+
+} // namespace storage
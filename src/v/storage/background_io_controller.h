@@ -0,0 +1,90 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "resource_mgmt/io_priority.h"
+#include "seastarx.h"
+
+#include <seastar/core/gate.hh>
+#include <seastar/core/io_priority_class.hh>
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace storage {
+
+struct background_io_controller_config {
+    /// target of the p99 of the foreground latency
+    std::chrono::milliseconds latency_target;
+    std::chrono::milliseconds sampling_interval;
+    /// the shares of the background classes are never scaled below this
+    double min_scale;
+};
+
+/**
+ * Throttles the IO shares of the background classes (learner recovery,
+ * scrubbing, archival and, through a callback, compaction) against a
+ * foreground latency target.
+ *
+ * The controller keeps a scale in [min_scale, 1] applied to the registered
+ * shares of every background class. Every sampling interval the p99 of the
+ * foreground latency since the last sample is compared with the target: the
+ * scale is halved when the target is missed and grows by a tenth when it is
+ * met or when there was no foreground traffic, so background work runs at
+ * full speed unless it pushes foreground latency over the target.
+ */
+class background_io_controller {
+public:
+    using background_class = priority_manager::background_class;
+    using latency_sampler = ss::noncopyable_function<
+      std::optional<std::chrono::microseconds>()>;
+    using scale_listener = ss::noncopyable_function<void(double)>;
+
+    static constexpr double decrease_factor = 0.5;
+    static constexpr double increase_step = 0.1;
+
+    background_io_controller(
+      background_io_controller_config,
+      std::vector<background_class>,
+      latency_sampler,
+      scale_listener);
+
+    ss::future<> start();
+    ss::future<> stop();
+
+    /// sample the foreground latency and apply the new scale
+    ss::future<> update();
+
+    double scale() const { return _scale; }
+
+    void setup_metrics();
+
+private:
+    ss::future<> apply();
+
+    background_io_controller_config _cfg;
+    std::vector<background_class> _classes;
+    latency_sampler _sample_latency;
+    scale_listener _on_scale;
+    double _scale{1.0};
+    std::optional<std::chrono::microseconds> _last_latency;
+    ss::timer<> _sampling_timer;
+    ss::gate _gate;
+    ss::metrics::metric_groups _metrics;
+};
+
+} // namespace storage
@@ -17,6 +17,7 @@
 #include <seastar/core/metrics.hh>
 #include <seastar/core/reactor.hh>
 
+#include <algorithm>
 #include <limits>
 
 namespace storage {
@@ -83,6 +84,10 @@ void backlog_controller::update_setpoint(int64_t v) {
     _setpoint = v;
 }
 
+void backlog_controller::set_shares_scale(double scale) {
+    _shares_scale = std::clamp(scale, 0.0, 1.0);
+}
+
 ss::future<> backlog_controller::stop() {
     _sampling_timer.cancel();
     return _gate.close();
@@ -120,14 +125,18 @@ ss::future<> backlog_controller::update() {
 
     // update error sample
     _prev_error = current_err;
+    _sampler->shares_updated(_current_shares, _min_shares, _max_shares);
 
     co_await set();
 }
 
 ss::future<> backlog_controller::set() {
-    vlog(_log.debug, "updating shares {}", _current_shares);
-    _scheduling_group.set_shares(static_cast<float>(_current_shares));
-    return _io_priority.update_shares(_current_shares);
+    const auto shares = std::max(
+      _min_shares,
+      static_cast<int>(static_cast<double>(_current_shares) * _shares_scale));
+    vlog(_log.debug, "updating shares {} (scale: {})", shares, _shares_scale);
+    _scheduling_group.set_shares(static_cast<float>(shares));
+    return _io_priority.update_shares(shares);
 }
 
 void backlog_controller::setup_metrics(const ss::sstring& controller_label) {
@@ -87,6 +87,9 @@ class backlog_controller {
 public:
     struct sampler {
         virtual ss::future<int64_t> sample_backlog() = 0;
+        /// called after every update with the new controller output
+        virtual void
+        shares_updated(int /*shares*/, int /*min_shares*/, int /*max_shares*/) {}
         virtual ~sampler() noexcept = default;
     };
 
@@ -94,6 +97,9 @@ public:
       std::unique_ptr<sampler>, ss::logger&, backlog_controller_config);
 
     void update_setpoint(int64_t);
+    /// scale the applied shares down, e.g. to protect foreground latency;
+    /// the scale is in (0, 1] and the shares stay at or above min_shares
+    void set_shares_scale(double);
     ss::future<> start();
     ss::future<> stop();
 
@@ -122,6 +128,7 @@ private:
     int64_t _error_integral{0};
     int64_t _setpoint;
     int _current_shares;
+    double _shares_scale{1.0};
     int _min_shares;
     int _max_shares;
     ss::gate _gate;
@@ -10,6 +10,7 @@
 #include "batch_cache.h"
 
 #include "bytes/iobuf_parser.h"
+#include "compression/compression.h"
 #include "model/adl_serde.h"
 #include "utils/gate_guard.h"
 #include "utils/to_string.h"
@@ -35,6 +36,16 @@ batch_cache::range::range(
     add(batch);
 }
 
+batch_cache::range::range(
+  batch_cache_index& index,
+  iobuf arena,
+  std::vector<model::offset> offsets,
+  size_t size)
+  : _arena(std::move(arena))
+  , _offsets(std::move(offsets))
+  , _size(size)
+  , _index(index) {}
+
 model::record_batch batch_cache::range::batch(size_t o) {
     vassert(_valid, "cannot access invalided batch");
     iobuf_const_parser parser(_arena);
@@ -115,8 +126,10 @@ uint32_t batch_cache::range::add(const model::record_batch& b) {
     return offset;
 }
 
-batch_cache::entry
-batch_cache::put(batch_cache_index& index, const model::record_batch& input) {
+batch_cache::entry batch_cache::put(
+  batch_cache_index& index,
+  const model::record_batch& input,
+  admit_on_probation probation) {
 #ifdef SEASTAR_DEFAULT_ALLOCATOR
     static const size_t threshold = ss::memory::stats().total_memory() * .2;
     while (_size_bytes > threshold) {
@@ -130,30 +143,41 @@ batch_cache::put(batch_cache_index& index, const model::record_batch& input) {
     // shouldn't--`e` wouldn't be visible to the reclaimer since it
     // isn't on a lru/pool list.
 
+    // probationary ranges go to the front of the lru, i.e. next in line for
+    // reclaim, so a cold scan recycles its own memory first
+    auto insert = [this, probation](range& r) {
+        r._probationary = bool(probation);
+        if (probation) {
+            _lru.push_front(r);
+        } else {
+            _lru.push_back(r);
+        }
+        _size_bytes += r.memory_size();
+    };
+
     if (static_cast<size_t>(input.size_bytes()) > range::range_size) {
         auto r = new range(index, input);
-        _lru.push_back(*r);
-        _size_bytes += r->memory_size();
+        insert(*r);
         return entry(0, r->weak_from_this());
     }
 
+    auto& small_range = probation ? index._probation_range
+                                  : index._small_batches_range;
     if (
-      !index._small_batches_range || !index._small_batches_range->valid()
-      || !index._small_batches_range->fits(input)) {
+      !small_range || !small_range->valid() || !small_range->fits(input)
+      || small_range->_probationary != bool(probation)) {
         auto r = new range(index);
-        _lru.push_back(*r);
-        _size_bytes += r->memory_size();
-        index._small_batches_range = r->weak_from_this();
+        insert(*r);
+        small_range = r->weak_from_this();
     }
 
-    auto initial_sz = index._small_batches_range->memory_size();
-    auto offset = index._small_batches_range->add(input);
+    auto initial_sz = small_range->memory_size();
+    auto offset = small_range->add(input);
     // calculate size difference to update batch cache size
-    int64_t diff = (int64_t)index._small_batches_range->memory_size()
-                   - initial_sz;
+    int64_t diff = (int64_t)small_range->memory_size() - initial_sz;
     _size_bytes += diff;
     _background_reclaimer.notify();
-    return entry(offset, index._small_batches_range->weak_from_this());
+    return entry(offset, small_range->weak_from_this());
 }
 
 batch_cache::~batch_cache() noexcept {
@@ -176,7 +200,7 @@ void batch_cache::evict(range_ptr&& e) {
     }
 }
 
-size_t batch_cache::reclaim(size_t size) {
+size_t batch_cache::reclaim(size_t size, bool demote) {
     if (is_memory_reclaiming()) {
         return 0;
     }
@@ -225,6 +249,15 @@ size_t batch_cache::reclaim(size_t size) {
         if (unlikely(it->empty())) {
             continue;
         }
+        // offer the range to the compressed tier before releasing it
+        if (demote && !it->_probationary && !it->_index.locked()) {
+            try {
+                this->demote(*it);
+            } catch (const std::bad_alloc&) {
+                // fall through and release the range
+            }
+        }
+
         // reclaim the batch's record data
         reclaimed += it->memory_size();
         it->_arena.clear();
@@ -272,13 +305,158 @@ size_t batch_cache::reclaim(size_t size) {
 
     _last_reclaim = ss::lowres_clock::now();
     _size_bytes -= reclaimed;
+
+    // under real memory pressure the compressed tier goes next
+    if (!demote && reclaimed < _reclaim_size) {
+        reclaimed += drop_compressed(_reclaim_size - reclaimed);
+    }
     return reclaimed;
 }
 
+bool batch_cache::demote(range& r) {
+    const auto max_size = _reclaim_opts.compressed_tier_max_size;
+    if (max_size == 0 || !r.valid() || r._offsets.empty()) {
+        return false;
+    }
+    auto& index = r._index;
+    std::vector<compressed_range::batch_position> batches;
+    batches.reserve(r._offsets.size());
+    model::offset last_offset;
+    for (auto o : r._offsets) {
+        auto it = index._index.find(o);
+        if (it == index._index.end() || it->second.range().get() != &r) {
+            // the index moved on (e.g. truncation), nothing to preserve
+            return false;
+        }
+        batches.push_back({o, it->second.range_offset()});
+        last_offset = it->second.header().last_offset();
+    }
+
+    auto data = compression::compressor::compress(
+      r._arena, model::compression::lz4);
+    const auto compressed_size = data.size_bytes()
+                                 + batches.size()
+                                     * sizeof(compressed_range::batch_position);
+    if (compressed_size >= r._size || compressed_size > max_size) {
+        _probe.range_not_compressible();
+        return false;
+    }
+
+    auto base_offset = batches.front().base_offset;
+    auto cr = std::make_unique<compressed_range>(
+      index, std::move(data), r._size, std::move(batches), last_offset);
+    _compressed_size_bytes += cr->memory_size();
+    _compressed_lru.push_back(*cr);
+    if (auto it = index._compressed.find(base_offset);
+        it != index._compressed.end()) {
+        release_compressed(*it->second);
+    }
+    index._compressed.emplace(base_offset, std::move(cr));
+    _probe.range_demoted();
+
+    if (_compressed_size_bytes > max_size) {
+        drop_compressed(_compressed_size_bytes - max_size);
+    }
+    return true;
+}
+
+void batch_cache::promote(batch_cache_index& index, compressed_range_ptr cr) {
+    _compressed_size_bytes -= cr->memory_size();
+    cr->_hook.unlink();
+
+    std::vector<model::offset> offsets;
+    offsets.reserve(cr->_batches.size());
+    for (const auto& b : cr->_batches) {
+        offsets.push_back(b.base_offset);
+    }
+    auto arena = compression::compressor::uncompress(
+      cr->_data, model::compression::lz4);
+    auto r = new range(
+      index, std::move(arena), std::move(offsets), cr->_uncompressed_size);
+    _lru.push_back(*r);
+    _size_bytes += r->memory_size();
+
+    range::lock_guard g(*r);
+    for (const auto& b : cr->_batches) {
+        entry e(b.range_offset, r->weak_from_this());
+        if (auto it = index._index.find(b.base_offset);
+            it != index._index.end()) {
+            it->second = std::move(e);
+        } else {
+            index._index.emplace(b.base_offset, std::move(e));
+        }
+    }
+    _background_reclaimer.notify();
+}
+
+size_t batch_cache::release_compressed(compressed_range& cr) {
+    auto& index = cr._index;
+    const auto size = cr.memory_size();
+    _compressed_size_bytes -= size;
+    // destroying the range unlinks it from the lru
+    index._compressed.erase(cr.base_offset());
+    return size;
+}
+
+size_t batch_cache::drop_compressed(size_t size) {
+    size_t dropped = 0;
+    for (auto it = _compressed_lru.begin();
+         it != _compressed_lru.end() && dropped < size;) {
+        auto& cr = *it;
+        ++it;
+        if (unlikely(cr._index.locked())) {
+            continue;
+        }
+        dropped += release_compressed(cr);
+    }
+    return dropped;
+}
+
+bool batch_cache_index::maybe_promote(model::offset offset) {
+    if (_compressed.empty()) {
+        _cache->_probe.miss();
+        return false;
+    }
+    auto it = _compressed.upper_bound(offset);
+    if (
+      it == _compressed.begin()
+      || std::prev(it)->second->last_offset() < offset) {
+        _cache->_probe.compressed_miss();
+        return false;
+    }
+    --it;
+    auto cr = std::move(it->second);
+    _compressed.erase(it);
+    _cache->promote(*this, std::move(cr));
+    _cache->_probe.compressed_hit();
+    return true;
+}
+
+void batch_cache_index::drop_compressed_from(model::offset offset) {
+    auto it = _compressed.upper_bound(offset);
+    if (it != _compressed.begin()) {
+        auto prev = std::prev(it);
+        if (prev->second->last_offset() >= offset) {
+            it = prev;
+        }
+    }
+    while (it != _compressed.end()) {
+        auto& cr = *it->second;
+        ++it;
+        _cache->release_compressed(cr);
+    }
+}
+
 std::optional<model::record_batch>
 batch_cache_index::get(model::offset offset) {
     lock_guard lk(*this);
-    if (auto it = find_first_contains(offset); it != _index.end()) {
+    auto it = find_first_contains(offset);
+    if (it == _index.end() && maybe_promote(offset)) {
+        it = find_first_contains(offset);
+    } else if (it != _index.end()) {
+        _cache->_probe.hit();
+    }
+    if (it != _index.end()) {
         batch_cache::range::lock_guard g(*it->second.range());
         _cache->touch(it->second.range());
         return it->second.batch();
@@ -299,7 +477,13 @@ batch_cache_index::read_result batch_cache_index::read(
     if (unlikely(offset > max_offset)) {
         return ret;
     }
-    for (auto it = find_first_contains(offset); it != _index.end();) {
+    auto first = find_first_contains(offset);
+    if (first == _index.end() && maybe_promote(offset)) {
+        first = find_first_contains(offset);
+    } else if (first != _index.end()) {
+        _cache->_probe.hit();
+    }
+    for (auto it = first; it != _index.end();) {
         auto batch = it->second.batch();
 
         auto take = !type_filter || type_filter == batch.header().type;
@@ -354,6 +538,7 @@ batch_cache_index::read_result batch_cache_index::read(
 }
 
 void batch_cache_index::truncate(model::offset offset) {
+    drop_compressed_from(offset);
     lock_guard lk(*this);
     if (auto it = find_first(offset); it != _index.end()) {
         // rule out if possible, otherwise always be pessimistic
@@ -397,7 +582,7 @@ ss::future<> batch_cache::background_reclaimer::reclaim_loop() {
 
         if (free < _min_free_memory) {
             auto to_reclaim = _min_free_memory - free;
-            _cache.reclaim(to_reclaim);
+            _cache.reclaim(to_reclaim, true);
         }
     }
     co_return;
@@ -420,6 +605,7 @@ std::ostream& operator<<(std::ostream& o, const batch_cache& b) {
     // Do _not_ print size of _lru
     return o << "{is_reclaiming:" << b.is_memory_reclaiming()
              << ", size_bytes: " << b._size_bytes
+             << ", compressed_size_bytes: " << b._compressed_size_bytes
              << ", lru_empty:" << b._lru.empty() << "}";
 }
 std::ostream&
@@ -434,7 +620,8 @@ operator<<(std::ostream& o, const batch_cache_index::read_result& c) {
     return o << "}";
 }
 std::ostream& operator<<(std::ostream& o, const batch_cache_index& c) {
-    return o << "{cache_size=" << c._index.size() << "}";
+    return o << "{cache_size=" << c._index.size()
+             << ", compressed_ranges=" << c._compressed.size() << "}";
 }
 
 } // namespace storage
@@ -11,6 +11,8 @@
 
 #pragma once
 #include "model/record.h"
+#include "storage/ntp_config.h"
+#include "storage/probe.h"
 #include "units.h"
 #include "utils/intrusive_list_helpers.h"
 #include "vassert.h"
@@ -27,13 +29,19 @@
 #include <absl/container/flat_hash_map.h>
 
 #include <limits>
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 class batch_cache_test_fixture;
 namespace storage {
 
 class batch_cache_index;
 
+/// set when a batch is cached on behalf of a reader that is likely scanning
+/// rather than tailing the log
+using admit_on_probation = ss::bool_class<struct admit_on_probation_tag>;
+
 /**
  * The batch cache system consists of two components. The `batch_cache` is a
  * global (per-shard) LRU cache of batches stored in memory. The second
@@ -92,8 +100,18 @@ class batch_cache_index;
  * the future, consider other solutions like blocking the reclaimer or only
  * allowing asynchronous reclaims while executing within the batch catch.
  *
- * TODO:
- *  - add probes to track statistics
+ * Compressed tier
+ * ===============
+ *
+ * When `reclaim_options::compressed_tier_max_size` is non-zero, ranges that
+ * the background reclaimer evicts are first compressed with lz4 and parked in
+ * a second, byte-bounded LRU tier before their memory is released. A miss in
+ * the uncompressed tier that hits a compressed range decompresses it back into
+ * a regular range and re-links its batches into the index. This lets a shard
+ * retain several times more tail data for lagging consumers. Demotion never
+ * happens in the synchronous reclaimer upcall, which instead drops compressed
+ * ranges once uncompressed ranges are exhausted. Ranges whose batches are
+ * already compressed by the producer rarely shrink and are simply dropped.
  */
 
 class batch_cache {
@@ -113,6 +131,8 @@ public:
         // background reclaimer settings
         ss::scheduling_group background_reclaimer_sg;
         size_t min_free_memory = 64_MiB;
+        // upper bound on the compressed tier. zero disables the tier
+        size_t compressed_tier_max_size = 0;
     };
 
     /*
@@ -146,6 +166,12 @@ public:
         explicit range(batch_cache_index& index);
         explicit range(
           batch_cache_index& index, const model::record_batch& batch);
+        /// rebuilds a range promoted from the compressed tier
+        range(
+          batch_cache_index& index,
+          iobuf arena,
+          std::vector<model::offset> offsets,
+          size_t size);
 
         ~range() noexcept = default;
         range(range&&) noexcept = delete;
@@ -188,12 +214,66 @@ public:
         std::vector<model::offset> _offsets;
 
         bool _pinned{false};
+        // probationary ranges sit at the cold end of the lru until they are
+        // hit, and are not offered to the compressed tier on reclaim.
+        bool _probationary{false};
         size_t _size = 0;
         intrusive_list_hook _hook;
         batch_cache_index& _index;
     };
 
     using range_ptr = ss::weak_ptr<range>;
+
+    /*
+     * A range demoted to the compressed tier. The arena is compressed as a
+     * single blob along with the base offset and arena position of each batch
+     * so that the range can be rebuilt and re-indexed verbatim.
+     */
+    class compressed_range {
+    public:
+        struct batch_position {
+            model::offset base_offset;
+            uint32_t range_offset;
+        };
+
+        compressed_range(
+          batch_cache_index& index,
+          iobuf data,
+          size_t uncompressed_size,
+          std::vector<batch_position> batches,
+          model::offset last_offset) noexcept
+          : _data(std::move(data))
+          , _uncompressed_size(uncompressed_size)
+          , _batches(std::move(batches))
+          , _last_offset(last_offset)
+          , _index(index) {}
+
+        ~compressed_range() noexcept = default;
+        compressed_range(compressed_range&&) noexcept = delete;
+        compressed_range& operator=(compressed_range&&) noexcept = delete;
+        compressed_range(const compressed_range&) = delete;
+        compressed_range& operator=(const compressed_range&) = delete;
+
+        model::offset base_offset() const {
+            return _batches.front().base_offset;
+        }
+        model::offset last_offset() const { return _last_offset; }
+        size_t memory_size() const {
+            return _data.size_bytes()
+                   + _batches.size() * sizeof(batch_position);
+        }
+
+    private:
+        friend class batch_cache;
+
+        iobuf _data;
+        size_t _uncompressed_size;
+        std::vector<batch_position> _batches;
+        model::offset _last_offset;
+        intrusive_list_hook _hook;
+        batch_cache_index& _index;
+    };
+    using compressed_range_ptr = std::unique_ptr<compressed_range>;
     /**
      * Entry represents single batch in given range, it contains range weak
      * pointer and batch offset in range _arena buffer.
@@ -218,6 +298,7 @@ public:
         range_ptr& range() { return _range; }
         const range_ptr& range() const { return _range; }
         bool valid() const { return _range->valid(); }
+        uint32_t range_offset() const { return _range_offset; }
 
     private:
         uint32_t _range_offset;
@@ -252,11 +333,25 @@ public:
 
     ss::future<> stop() { return _background_reclaimer.stop(); }
 
+    void setup_metrics() {
+        _probe.setup_metrics(
+          [this] { return _size_bytes; },
+          [this] { return _compressed_size_bytes; });
+    }
+
+    const batch_cache_probe& probe() const { return _probe; }
+
+    /// Bytes held by the cached batches, compressed ranges included.
+    size_t size_bytes() const { return _size_bytes + _compressed_size_bytes; }
+
     /// Returns true if the cache is empty, and false otherwise.
-    bool empty() const { return _lru.empty(); }
+    bool empty() const { return _lru.empty() && _compressed_lru.empty(); }
 
     /// Removes all entries from the cache.
-    void clear() { reclaim(std::numeric_limits<size_t>::max()); }
+    void clear() {
+        reclaim(std::numeric_limits<size_t>::max());
+        drop_compressed(std::numeric_limits<size_t>::max());
+    }
 
     /**
      * Copies a batch into the LRU cache.
@@ -264,8 +359,15 @@ public:
      *
      * The returned weak_ptr will be invalidated if its memory is reclaimed. To
      * evict the range, move it into batch_cache::evict().
+     *
+     * Batches admitted on probation are placed at the cold end of the LRU so
+     * that a large scan recycles its own memory instead of evicting the tail.
+     * They are promoted to the hot end if they are hit again.
      */
-    entry put(batch_cache_index&, const model::record_batch&);
+    entry put(
+      batch_cache_index&,
+      const model::record_batch&,
+      admit_on_probation = admit_on_probation::no);
 
     /**
      * \brief Remove a batch from the cache.
@@ -289,6 +391,7 @@ public:
         if (e) {
             auto p = e.get();
             p->_hook.unlink();
+            p->_probationary = false;
             _lru.push_back(*p);
         }
     }
@@ -300,7 +403,7 @@ public:
      * method releases the entire range because this interface is intended to be
      * used to deal with low-memory situations.
      */
-    size_t reclaim(size_t size);
+    size_t reclaim(size_t size) { return reclaim(size, false); }
 
     /**
      * returns true if there is an active reclaim happening
@@ -309,6 +412,26 @@ public:
 
 private:
     friend batch_cache_test_fixture;
+    friend class batch_cache_index;
+
+    /// when `demote` is set reclaimed ranges are offered to the compressed
+    /// tier first. only the background reclaimer may demote since it has to
+    /// allocate.
+    size_t reclaim(size_t size, bool demote);
+
+    /// compress the range into the second tier. returns false if the range
+    /// cannot be demoted and must be dropped as usual.
+    bool demote(range&);
+
+    /// decompress the range back into the first tier and re-index it
+    void promote(batch_cache_index&, compressed_range_ptr);
+
+    /// drop compressed ranges in lru order until `size` bytes were released
+    size_t drop_compressed(size_t size);
+
+    /// release a compressed range owned by an unlocked index
+    size_t release_compressed(compressed_range&);
+
     struct batch_reclaiming_lock {
         explicit batch_reclaiming_lock(batch_cache& b) noexcept
           : ref(b)
@@ -370,9 +493,12 @@ private:
     }
 
     intrusive_list<range, &range::_hook> _lru;
+    intrusive_list<compressed_range, &compressed_range::_hook> _compressed_lru;
     reclaimer _reclaimer;
     bool _is_reclaiming{false};
     size_t _size_bytes{0};
+    size_t _compressed_size_bytes{0};
+    batch_cache_probe _probe;
 
     reclaim_options _reclaim_opts;
     ss::lowres_clock::time_point _last_reclaim;
@@ -396,9 +522,13 @@ public:
         friend std::ostream& operator<<(std::ostream&, const read_result&);
     };
 
-    explicit batch_cache_index(batch_cache& cache)
-      : _cache(&cache) {}
+    explicit batch_cache_index(
+      batch_cache& cache,
+      batch_cache_admission admission = batch_cache_admission::lru)
+      : _cache(&cache)
+      , _admission(admission) {}
     ~batch_cache_index() {
+        drop_compressed_from(model::offset::min());
         lock_guard lk(*this);
         std::for_each(
           _index.begin(), _index.end(), [this](index_type::value_type& e) {
@@ -410,9 +540,15 @@ public:
     batch_cache_index(const batch_cache_index&) = delete;
     batch_cache_index& operator=(const batch_cache_index&) = delete;
 
-    bool empty() const { return _index.empty(); }
+    bool empty() const { return _index.empty() && _compressed.empty(); }
 
-    void put(const model::record_batch& batch) {
+    /**
+     * Cache a copy of the batch. The probation hint is only honoured when the
+     * index uses the scan resistant admission policy.
+     */
+    void put(
+      const model::record_batch& batch,
+      admit_on_probation probation = admit_on_probation::no) {
         lock_guard lk(*this);
         auto offset = batch.header().base_offset;
         if (likely(!_index.contains(offset))) {
@@ -422,7 +558,12 @@ public:
              * entries are initialized in the cache and index, clean-up happens
              * correctly on either side.
              */
-            auto p = _cache->put(*this, batch);
+            auto p = _cache->put(
+              *this,
+              batch,
+              admit_on_probation(
+                probation
+                && _admission == batch_cache_admission::scan_resistant));
             _index.emplace(offset, std::move(p));
         }
     }
@@ -485,6 +626,18 @@ public:
 
 private:
     friend class batch_cache;
+    using compressed_index_type
+      = absl::btree_map<model::offset, batch_cache::compressed_range_ptr>;
+
+    /*
+     * On a miss in the uncompressed tier, move the compressed range that
+     * contains the offset back into the uncompressed tier. Returns true when
+     * a range was promoted.
+     */
+    bool maybe_promote(model::offset offset);
+
+    /// drops compressed ranges that may contain offsets >= `offset`
+    void drop_compressed_from(model::offset offset);
 
     class lock_guard {
     public:
@@ -558,7 +711,12 @@ private:
     bool _locked{false};
     batch_cache* _cache;
     index_type _index;
+    compressed_index_type _compressed;
+    batch_cache_admission _admission;
     batch_cache::range_ptr _small_batches_range = nullptr;
+    // small batches admitted on probation are packed separately so that
+    // they do not share a range with hot batches
+    batch_cache::range_ptr _probation_range = nullptr;
 
     friend std::ostream& operator<<(std::ostream&, const batch_cache_index&);
 };
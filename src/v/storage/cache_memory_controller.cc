@@ -0,0 +1,153 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/cache_memory_controller.h"
+
+#include "config/configuration.h"
+#include "prometheus/prometheus_sanitize.h"
+#include "resource_mgmt/memory_groups.h"
+#include "storage/logger.h"
+#include "vlog.h"
+
+#include <seastar/core/metrics.hh>
+
+#include <algorithm>
+
+namespace storage {
+
+cache_memory_controller::decision
+cache_memory_controller::decide(const sample& delta, size_t step) {
+    if (delta.chunk_waits > 0) {
+        return decision::grow_chunk_cache;
+    }
+    const auto reads = delta.cache_hits + delta.cache_misses;
+    if (reads < min_reads) {
+        return decision::none;
+    }
+    const auto hit_ratio = static_cast<double>(delta.cache_hits)
+                           / static_cast<double>(reads);
+    // only take memory the appenders are not using
+    if (
+      hit_ratio < low_hit_ratio
+      && delta.chunk_size_total + step < delta.chunk_size_limit) {
+        return decision::shrink_chunk_cache;
+    }
+    return decision::none;
+}
+
+cache_memory_controller::cache_memory_controller(
+  batch_cache& bc, internal::chunk_cache& cc)
+  : _batch_cache(bc)
+  , _chunk_cache(cc)
+  , _floor(memory_groups::chunk_cache_floor_memory())
+  , _ceiling(memory_groups::chunk_cache_ceiling_memory())
+  // move memory in steps of 1/20th of the adjustable range
+  , _step(std::max<size_t>(
+      (_ceiling - _floor) / 20, internal::chunk_cache::alignment)) {
+    _timer.set_callback([this] {
+        update();
+        _timer.arm(sampling_interval);
+    });
+}
+
+void cache_memory_controller::start() {
+    _last = take_sample();
+    _timer.arm(sampling_interval);
+}
+
+void cache_memory_controller::stop() { _timer.cancel(); }
+
+cache_memory_controller::sample cache_memory_controller::take_sample() const {
+    return sample{
+      .chunk_waits = _chunk_cache.waits(),
+      .cache_hits = _batch_cache.probe().hits(),
+      .cache_misses = _batch_cache.probe().misses(),
+      .chunk_size_total = _chunk_cache.size_total(),
+      .chunk_size_limit = _chunk_cache.size_limit(),
+    };
+}
+
+void cache_memory_controller::update() {
+    auto current = take_sample();
+    auto delta = sample{
+      .chunk_waits = current.chunk_waits - _last.chunk_waits,
+      .cache_hits = current.cache_hits - _last.cache_hits,
+      .cache_misses = current.cache_misses - _last.cache_misses,
+      .chunk_size_total = current.chunk_size_total,
+      .chunk_size_limit = current.chunk_size_limit,
+    };
+    _last = current;
+    apply(decide(delta, _step));
+}
+
+void cache_memory_controller::apply(decision d) {
+    auto target = _chunk_cache.size_target();
+    auto limit = _chunk_cache.size_limit();
+    switch (d) {
+    case decision::none:
+        return;
+    case decision::grow_chunk_cache: {
+        if (limit >= _ceiling) {
+            return;
+        }
+        auto grown = std::min(limit + _step, _ceiling) - limit;
+        limit += grown;
+        target = std::min(target + grown, limit);
+        // make room for the larger write buffers
+        _batch_cache.reclaim(grown);
+        ++_grow_decisions;
+        break;
+    }
+    case decision::shrink_chunk_cache: {
+        if (limit <= _floor) {
+            return;
+        }
+        limit = std::max(limit - _step, _floor);
+        target = std::min(target, limit);
+        ++_shrink_decisions;
+        break;
+    }
+    }
+    vlog(
+      stlog.debug,
+      "adjusting chunk cache target: {} limit: {}",
+      target,
+      limit);
+    _chunk_cache.set_size_target_and_limit(target, limit);
+}
+
+void cache_memory_controller::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    namespace sm = ss::metrics;
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("storage:cache_memory_controller"),
+      {
+        sm::make_derive(
+          "grow_decisions",
+          [this] { return _grow_decisions; },
+          sm::description("Chunk cache grown at the expense of the batch "
+                          "cache")),
+        sm::make_derive(
+          "shrink_decisions",
+          [this] { return _shrink_decisions; },
+          sm::description("Chunk cache shrunk in favor of the batch cache")),
+        sm::make_gauge(
+          "chunk_cache_target_bytes",
+          [this] { return _chunk_cache.size_target(); },
+          sm::description("Current chunk cache target size")),
+        sm::make_gauge(
+          "chunk_cache_limit_bytes",
+          [this] { return _chunk_cache.size_limit(); },
+          sm::description("Current chunk cache limit")),
+      });
+}
+
+} // namespace storage
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "seastarx.h"
+#include "storage/batch_cache.h"
+#include "storage/chunk_cache.h"
+
+#include <seastar/core/metrics_registration.hh>
+#include <seastar/core/timer.hh>
+
+#include <chrono>
+#include <cstdint>
+
+namespace storage {
+
+/**
+ * Feedback controller splitting the write buffer memory between the chunk
+ * cache and the batch cache.
+ *
+ * The chunk cache starts at its static target and limit. Every sampling
+ * interval the controller compares the number of appenders that waited for a
+ * chunk and the batch cache hit ratio against the previous sample:
+ *
+ *  - appenders waited: the node is write heavy. The chunk cache target and
+ *    limit are raised by one step and the same amount is reclaimed from the
+ *    batch cache.
+ *  - no waits, a poor hit ratio, and the chunk cache is not using its limit:
+ *    the node is read heavy. The chunk cache is shrunk by one step, leaving
+ *    the memory to the batch cache which grows into free memory.
+ *
+ * The chunk cache is kept between memory_groups::chunk_cache_floor_memory()
+ * and memory_groups::chunk_cache_ceiling_memory().
+ */
+class cache_memory_controller {
+public:
+    static constexpr auto sampling_interval = std::chrono::seconds(5);
+    // hit ratio below which the batch cache is considered starved
+    static constexpr double low_hit_ratio = 0.5;
+    // reads needed in an interval before the hit ratio is trusted
+    static constexpr uint64_t min_reads = 100;
+
+    enum class decision { none, grow_chunk_cache, shrink_chunk_cache };
+
+    struct sample {
+        uint64_t chunk_waits{0};
+        uint64_t cache_hits{0};
+        uint64_t cache_misses{0};
+        size_t chunk_size_total{0};
+        size_t chunk_size_limit{0};
+    };
+
+    /// decide from the counters observed over one sampling interval
+    static decision decide(const sample& delta, size_t step);
+
+    cache_memory_controller(batch_cache&, internal::chunk_cache&);
+
+    void start();
+    void stop();
+
+    void setup_metrics();
+
+private:
+    sample take_sample() const;
+    void update();
+    void apply(decision);
+
+    batch_cache& _batch_cache;
+    internal::chunk_cache& _chunk_cache;
+    const size_t _floor;
+    const size_t _ceiling;
+    const size_t _step;
+    sample _last;
+    ss::timer<> _timer;
+
+    uint64_t _grow_decisions{0};
+    uint64_t _shrink_decisions{0};
+    ss::metrics::metric_groups _metrics;
+};
+
+} // namespace storage
@@ -66,7 +66,7 @@ public:
     }
 
     void add(const chunk_ptr& chunk) {
-        if (_size_available >= _size_target) {
+        if (_size_available >= _size_target || _size_total > _size_limit) {
             _size_total -= _chunk_size;
             return;
         }
@@ -82,15 +82,44 @@ public:
         if (!_sem.waiters()) {
             return do_get();
         }
+        ++_waits;
         return ss::get_units(_sem, 1).then(
           [this](ss::semaphore_units<>) { return do_get(); });
     }
 
+    /**
+     * Move the soft target and hard limit of the cache. Pooled chunks above a
+     * lowered target are released, and chunks handed out above a lowered
+     * limit are released as they are returned.
+     */
+    void set_size_target_and_limit(size_t target, size_t limit) {
+        vassert(
+          target <= limit,
+          "chunk cache target {} above limit {}",
+          target,
+          limit);
+        _size_target = target;
+        _size_limit = limit;
+        while (!_chunks.empty() && _size_available > _size_target) {
+            _chunks.pop_front();
+            _size_available -= _chunk_size;
+            _size_total -= _chunk_size;
+        }
+    }
+
+    size_t size_target() const { return _size_target; }
+    size_t size_limit() const { return _size_limit; }
+    size_t size_total() const { return _size_total; }
+    size_t chunk_size() const { return _chunk_size; }
+    /// number of requests that had to wait for a chunk to be returned
+    uint64_t waits() const { return _waits; }
+
 private:
     ss::future<chunk_ptr> do_get() {
         if (auto c = pop_or_allocate(); c) {
             return ss::make_ready_future<chunk_ptr>(c);
         }
+        ++_waits;
         return ss::get_units(_sem, 1).then(
           [this](ss::semaphore_units<>) { return do_get(); });
     }
@@ -119,8 +148,9 @@ private:
     ss::semaphore _sem{0};
     size_t _size_available{0};
     size_t _size_total{0};
-    const size_t _size_target;
-    const size_t _size_limit;
+    size_t _size_target;
+    size_t _size_limit;
+    uint64_t _waits{0};
 
     const size_t _chunk_size{0};
 };
@@ -11,6 +11,7 @@
 
 #pragma once
 #include "bytes/bytes.h"
+#include "hashing/xx.h"
 #include "model/fundamental.h"
 
 #include <cstddef>
@@ -31,6 +32,24 @@ struct compacted_index {
         /// the recovery thread to compact up to key-point on the index.
         truncation,
     };
+    /// \brief how the writer stores record keys. `fingerprint` replaces keys
+    /// longer than `fingerprint_size` with their 128-bit xxhash so that
+    /// entries have a fixed width; shorter keys are kept verbatim, which
+    /// makes the mapping idempotent (indices can be rewritten in either mode)
+    /// and exact for small keys. Two long keys are only merged if their
+    /// 128-bit hashes collide
+    enum class key_mode : uint8_t {
+        full,
+        fingerprint,
+    };
+    static constexpr const size_t fingerprint_size = 16;
+    /// \brief the 128-bit xxhash a key is replaced with in `fingerprint` mode
+    static bytes fingerprint(bytes_view k) {
+        const auto h = xxhash_128(k.data(), k.size());
+        static_assert(sizeof(h) == fingerprint_size);
+        // NOLINTNEXTLINE
+        return bytes(reinterpret_cast<const uint8_t*>(&h), sizeof(h));
+    }
     // bitflags for index
     enum class footer_flags : uint32_t {
         none = 0,
@@ -38,6 +57,8 @@ struct compacted_index {
         truncation = 1U,
         /// needed to determine if we should self compact first
         self_compaction = 1U << 1U,
+        /// a key_bloom_filter sits between the entries and the footer
+        key_filter = 1U << 2U,
     };
     struct footer {
         uint32_t size{0};
@@ -27,6 +27,7 @@
 #include <fmt/core.h>
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace storage::internal {
@@ -97,8 +98,12 @@ ss::future<> compacted_index_chunk_reader::verify_integrity() {
                                             max_bytes = 0;
                                             return;
                                         }
+                                        // a key filter may follow the
+                                        // entries; it is not part of the crc
+                                        const auto n = std::min<size_t>(
+                                          buf.size(), max_bytes);
                                         max_bytes -= buf.size();
-                                        crc.extend(buf.get(), buf.size());
+                                        crc.extend(buf.get(), n);
                                     });
                               })
                        .then([&in, &crc] {
@@ -162,6 +167,33 @@ compacted_index_chunk_reader::load_footer() {
     });
 }
 
+ss::future<std::optional<key_bloom_filter>>
+compacted_index_chunk_reader::load_key_filter() {
+    return load_footer().then([this](compacted_index::footer f) {
+        using ret_t = std::optional<key_bloom_filter>;
+        const size_t end = _file_size.value() - compacted_index::footer_size;
+        if (
+          !bool(f.flags & compacted_index::footer_flags::key_filter)
+          || end <= f.size) {
+            return ss::make_ready_future<ret_t>(std::nullopt);
+        }
+        ss::file_input_stream_options options;
+        options.buffer_size = 4096;
+        options.io_priority_class = _iopc;
+        options.read_ahead = 1;
+        return ss::do_with(
+          ss::make_file_input_stream(
+            _handle, f.size, end - f.size, std::move(options)),
+          [len = end - f.size](ss::input_stream<char>& in) {
+              return ::read_iobuf_exactly(in, len)
+                .then([](iobuf b) {
+                    return key_bloom_filter::from_iobuf(std::move(b));
+                })
+                .finally([&in] { return in.close(); });
+          });
+    });
+}
+
 void compacted_index_chunk_reader::print(std::ostream& o) const { o << *this; }
 
 bool compacted_index_chunk_reader::is_end_of_stream() const {
@@ -34,6 +34,8 @@ public:
 
     ss::future<compacted_index::footer> load_footer() final;
 
+    ss::future<std::optional<key_bloom_filter>> load_key_filter() final;
+
     ss::future<> verify_integrity() final;
 
     void reset() final;
@@ -13,11 +13,13 @@
 
 #include "model/timeout_clock.h"
 #include "storage/compacted_index.h"
+#include "storage/key_bloom_filter.h"
 
 #include <seastar/core/circular_buffer.hh>
 #include <seastar/core/file.hh>
 
 #include <memory>
+#include <optional>
 namespace storage {
 
 // clang-format off
@@ -49,6 +51,10 @@ public:
 
         virtual ss::future<compacted_index::footer> load_footer() = 0;
 
+        /// \brief nullopt if the index has no (valid) key filter
+        virtual ss::future<std::optional<key_bloom_filter>>
+        load_key_filter() = 0;
+
         virtual void reset() = 0;
 
         virtual void print(std::ostream&) const = 0;
@@ -117,6 +123,10 @@ public:
         return _impl->load_footer();
     }
 
+    ss::future<std::optional<key_bloom_filter>> load_key_filter() {
+        return _impl->load_key_filter();
+    }
+
     void print(std::ostream& o) const { _impl->print(o); }
 
     void reset() { _impl->reset(); }
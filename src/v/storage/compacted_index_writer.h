@@ -16,6 +16,7 @@
 
 #include <seastar/core/file.hh>
 #include <seastar/core/future.hh>
+#include <seastar/util/bool_class.hh>
 
 #include <bits/stdint-intn.h>
 
@@ -28,6 +29,7 @@ namespace storage {
     INT16 PAYLOAD
     INT16 PAYLOAD
     ...
+    [KEY_FILTER] // only with footer_flags::key_filter
     FOOTER
 
 PAYLOAD:
@@ -143,7 +145,14 @@ inline ss::future<> compacted_index_writer::append(compacted_index::entry e) {
 }
 inline ss::future<> compacted_index_writer::close() { return _impl->close(); }
 
+using write_key_filter = ss::bool_class<struct write_key_filter_tag>;
+
 compacted_index_writer make_file_backed_compacted_index(
-  ss::sstring filename, ss::file, ss::io_priority_class p, size_t max_memory);
+  ss::sstring filename,
+  ss::file,
+  ss::io_priority_class p,
+  size_t max_memory,
+  compacted_index::key_mode = compacted_index::key_mode::full,
+  write_key_filter = write_key_filter::no);
 
 } // namespace storage
@@ -22,6 +22,16 @@ ss::future<int64_t> compaction_backlog_sampler::sample_backlog() {
     co_return _api.local().log_mgr().compaction_backlog();
 }
 
+void compaction_backlog_sampler::shares_updated(
+  int shares, int min_shares, int max_shares) {
+    double pressure = 0;
+    if (max_shares > min_shares) {
+        pressure = static_cast<double>(shares - min_shares)
+                   / static_cast<double>(max_shares - min_shares);
+    }
+    _api.local().log_mgr().set_housekeeping_pressure(pressure);
+}
+
 compaction_controller::compaction_controller(
   ss::sharded<api>& api, backlog_controller_config cfg)
   : _ctrl(
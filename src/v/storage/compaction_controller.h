@@ -23,6 +23,7 @@ struct compaction_backlog_sampler : public backlog_controller::sampler {
       : _api(api) {}
 
     ss::future<int64_t> sample_backlog() final;
+    void shares_updated(int shares, int min_shares, int max_shares) final;
 
 private:
     ss::sharded<api>& _api;
@@ -36,6 +37,7 @@ public:
 
     ss::future<> start() { return _ctrl.start(); }
     ss::future<> stop() { return _ctrl.stop(); }
+    void set_shares_scale(double scale) { _ctrl.set_shares_scale(scale); }
 
 private:
     backlog_controller _ctrl;
@@ -9,10 +9,13 @@
 
 #include "storage/compaction_reducers.h"
 
+#include "bytes/iobuf_parser.h"
 #include "compression/compression.h"
 #include "model/record.h"
 #include "model/record_utils.h"
+#include "model/record_view.h"
 #include "random/generators.h"
+#include "reflection/adl.h"
 #include "storage/index_state.h"
 #include "storage/logger.h"
 #include "storage/parser_utils.h"
@@ -20,7 +23,11 @@
 #include "storage/segment_utils.h"
 #include "vlog.h"
 
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/iostream.hh>
+#include <seastar/core/seastar.hh>
 
 #include <absl/algorithm/container.h>
 #include <absl/container/flat_hash_map.h>
@@ -105,6 +112,272 @@ index_filtered_copy_reducer::operator()(compacted_index::entry&& e) {
     return ss::make_ready_future<stop_t>(stop_t::no);
 }
 
+sorted_run_key_reducer::sorted_run_key_reducer(
+  std::filesystem::path run_prefix,
+  size_t max_mem,
+  ss::io_priority_class iopc,
+  debug_sanitize_files sanitize)
+  : _run_prefix(std::move(run_prefix))
+  , _max_mem(max_mem)
+  , _iopc(iopc)
+  , _sanitize(sanitize) {}
+
+ss::future<ss::stop_iteration>
+sorted_run_key_reducer::operator()(compacted_index::entry&& e) {
+    const model::offset o = e.offset + model::offset(e.delta);
+    _buffer_mem += e.key.size() + entry_overhead;
+    _buffer.push_back(run_entry{std::move(e.key), o, _natural_index++});
+    if (_buffer_mem < _max_mem) {
+        return ss::make_ready_future<ss::stop_iteration>(
+          ss::stop_iteration::no);
+    }
+    return spill().then([] { return ss::stop_iteration::no; });
+}
+
+void sorted_run_key_reducer::sort_and_dedupe() {
+    std::sort(
+      _buffer.begin(),
+      _buffer.end(),
+      [](const run_entry& a, const run_entry& b) {
+          if (a.key != b.key) {
+              return a.key < b.key;
+          }
+          return a.offset > b.offset;
+      });
+    auto end = std::unique(
+      _buffer.begin(),
+      _buffer.end(),
+      [](const run_entry& a, const run_entry& b) { return a.key == b.key; });
+    _buffer.erase(end, _buffer.end());
+}
+
+/// run format is a sequence of:
+/// UINT32 []BYTE INT64 UINT32
+/// sorted by key, one entry per key
+ss::future<> sorted_run_key_reducer::spill() {
+    sort_and_dedupe();
+    auto path = std::filesystem::path(
+      fmt::format("{}.run_{}", _run_prefix.string(), _runs.size()));
+    _runs.push_back(path);
+    auto f = co_await make_handle(
+      path,
+      ss::open_flags::rw | ss::open_flags::create | ss::open_flags::truncate,
+      ss::file_open_options{},
+      _sanitize);
+    ss::file_output_stream_options options;
+    options.io_priority_class = _iopc;
+    auto out = co_await ss::make_file_output_stream(std::move(f), options);
+    std::exception_ptr ex;
+    try {
+        for (auto& e : _buffer) {
+            iobuf buf;
+            reflection::serialize(buf, uint32_t(e.key.size()));
+            buf.append(e.key.data(), e.key.size());
+            reflection::serialize(buf, e.offset(), e.natural_index);
+            for (auto& frag : buf) {
+                co_await out.write(frag.get(), frag.size());
+            }
+        }
+        co_await out.flush();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await out.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    vlog(
+      gclog.trace,
+      "spilled {} keys of {} to compaction run {}",
+      _buffer.size(),
+      _run_prefix,
+      path);
+    _buffer.clear();
+    _buffer_mem = 0;
+}
+
+namespace {
+struct run_cursor {
+    ss::input_stream<char> in;
+    bytes key;
+    model::offset offset;
+    uint32_t natural_index{0};
+    bool eof{false};
+
+    ss::future<> next() {
+        auto hdr = co_await read_iobuf_exactly(in, sizeof(uint32_t));
+        if (hdr.empty()) {
+            eof = true;
+            co_return;
+        }
+        iobuf_parser p(std::move(hdr));
+        const auto key_size = reflection::adl<uint32_t>{}.from(p);
+        auto body = co_await read_iobuf_exactly(
+          in, key_size + sizeof(int64_t) + sizeof(uint32_t));
+        iobuf_parser b(std::move(body));
+        key = b.read_bytes(key_size);
+        offset = model::offset(reflection::adl<int64_t>{}.from(b));
+        natural_index = reflection::adl<uint32_t>{}.from(b);
+    }
+};
+} // namespace
+
+ss::future<Roaring> sorted_run_key_reducer::merge() {
+    std::vector<std::unique_ptr<run_cursor>> cursors;
+    cursors.reserve(_runs.size());
+    // split the memory budget among the read buffers of every run
+    const size_t buffer_size = std::clamp<size_t>(
+      _max_mem / (_runs.size() + 1), 4_KiB, 128_KiB);
+    std::exception_ptr ex;
+    Roaring ret;
+    try {
+        for (auto& path : _runs) {
+            auto f = co_await make_reader_handle(path, _sanitize);
+            ss::file_input_stream_options options;
+            options.buffer_size = buffer_size;
+            options.io_priority_class = _iopc;
+            options.read_ahead = 1;
+            auto c = std::make_unique<run_cursor>(run_cursor{
+              .in = ss::make_file_input_stream(std::move(f), options)});
+            co_await c->next();
+            cursors.push_back(std::move(c));
+        }
+        // min-heap on (key asc, offset desc)
+        auto cmp = [](const run_cursor* a, const run_cursor* b) {
+            if (a->key != b->key) {
+                return a->key > b->key;
+            }
+            return a->offset < b->offset;
+        };
+        std::vector<run_cursor*> heap;
+        for (auto& c : cursors) {
+            if (!c->eof) {
+                heap.push_back(c.get());
+            }
+        }
+        std::make_heap(heap.begin(), heap.end(), cmp);
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), cmp);
+            auto newest = heap.back();
+            heap.pop_back();
+            ret.add(newest->natural_index);
+            const bytes key = newest->key;
+            std::vector<run_cursor*> advance{newest};
+            // older entries of the same key in other runs
+            while (!heap.empty() && heap.front()->key == key) {
+                std::pop_heap(heap.begin(), heap.end(), cmp);
+                advance.push_back(heap.back());
+                heap.pop_back();
+            }
+            for (auto c : advance) {
+                co_await c->next();
+                if (!c->eof) {
+                    heap.push_back(c);
+                    std::push_heap(heap.begin(), heap.end(), cmp);
+                }
+            }
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    for (auto& c : cursors) {
+        co_await c->in.close();
+    }
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return ret;
+}
+
+ss::future<> sorted_run_key_reducer::remove_runs() {
+    for (auto& path : _runs) {
+        try {
+            co_await ss::remove_file(path.string());
+        } catch (...) {
+            vlog(
+              gclog.warn,
+              "error removing compaction run {}: {}",
+              path,
+              std::current_exception());
+        }
+    }
+    _runs.clear();
+}
+
+ss::future<Roaring> sorted_run_key_reducer::end_of_stream() {
+    if (_runs.empty()) {
+        // everything fit in memory
+        sort_and_dedupe();
+        Roaring ret;
+        for (auto& e : _buffer) {
+            ret.add(e.natural_index);
+        }
+        _buffer.clear();
+        co_return ret;
+    }
+    std::exception_ptr ex;
+    Roaring ret;
+    try {
+        if (!_buffer.empty()) {
+            co_await spill();
+        }
+        ret = co_await merge();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await remove_runs();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return ret;
+}
+
+bool key_offset_map::put(bytes key, model::offset o) {
+    auto it = _map.find(key);
+    if (it != _map.end()) {
+        it->second = std::max(it->second, o);
+        return true;
+    }
+    if (full()) {
+        return false;
+    }
+    _mem_usage += key.size() + entry_overhead;
+    _map.emplace(std::move(key), o);
+    return true;
+}
+
+std::optional<model::offset> key_offset_map::get(const bytes& key) const {
+    if (auto it = _map.find(key); it != _map.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+ss::future<ss::stop_iteration>
+cross_segment_dedupe_reducer::operator()(compacted_index::entry&& e) {
+    using stop_t = ss::stop_iteration;
+    const model::offset o = e.offset + model::offset(e.delta);
+    if (auto newest = _map->get(e.key); newest && *newest > o) {
+        ++_result.shadowed;
+    } else {
+        _result.to_keep.add(_natural_index);
+        _map->put(std::move(e.key), o);
+    }
+    ++_natural_index;
+    return ss::make_ready_future<stop_t>(stop_t::no);
+}
+
+cross_segment_dedupe_reducer::result
+cross_segment_dedupe_reducer::end_of_stream() {
+    // never rewrite a segment into an empty one; its offsets must still be
+    // accounted for by the data file
+    if (_natural_index > 0 && _result.to_keep.isEmpty()) {
+        _result.to_keep.add(_natural_index - 1);
+        --_result.shadowed;
+    }
+    return std::move(_result);
+}
+
 ss::future<ss::stop_iteration>
 compacted_offset_list_reducer::operator()(compacted_index::entry&& e) {
     using stop_t = ss::stop_iteration;
@@ -113,17 +386,48 @@ compacted_offset_list_reducer::operator()(compacted_index::entry&& e) {
     return ss::make_ready_future<stop_t>(stop_t::no);
 }
 
+/// appends the batch to the segment copy and indexes it, the batch must
+/// outlive the returned future
+static ss::future<> write_indexed_batch(
+  segment_appender& appender,
+  index_state& idx,
+  size_t& acc,
+  const model::record_batch& batch) {
+    auto const start_offset = appender.file_byte_offset();
+    auto const header_size = batch.header().size_bytes;
+    acc += header_size;
+    if (idx.maybe_index(
+          acc,
+          32_KiB,
+          start_offset,
+          batch.base_offset(),
+          batch.last_offset(),
+          batch.header().first_timestamp,
+          batch.header().max_timestamp)) {
+        acc = 0;
+    }
+    return storage::write(appender, batch)
+      .then([&appender, start_offset, header_size] {
+          vassert(
+            appender.file_byte_offset() == start_offset + header_size,
+            "Size must be deterministic. Expected:{} == {}",
+            appender.file_byte_offset(),
+            start_offset + header_size);
+      });
+}
+
 std::optional<model::record_batch>
 copy_data_segment_reducer::filter(model::record_batch&& batch) {
     // 1. compute which records to keep
     const auto base = batch.base_offset();
     std::vector<int32_t> offset_deltas;
     offset_deltas.reserve(batch.record_count());
-    batch.for_each_record([this, base, &offset_deltas](const model::record& r) {
-        if (should_keep(base, r.offset_delta())) {
-            offset_deltas.push_back(r.offset_delta());
+    model::record_view_iterator records(batch);
+    while (auto r = records.next()) {
+        if (should_keep(base, r->offset_delta())) {
+            offset_deltas.push_back(r->offset_delta());
         }
-    });
+    }
 
     // 2. no record to keep
     if (offset_deltas.empty()) {
@@ -140,31 +444,22 @@ copy_data_segment_reducer::filter(model::record_batch&& batch) {
     int32_t rec_count = 0;
     std::optional<int64_t> first_timestamp_delta;
     int64_t last_timestamp_delta;
-    batch.for_each_record([&rec_count,
-                           &first_timestamp_delta,
-                           &last_timestamp_delta,
-                           &ret,
-                           &offset_deltas](model::record record) {
+    model::record_view_iterator kept(batch);
+    while (auto record = kept.next()) {
         // contains the key
         if (std::count(
               offset_deltas.begin(),
               offset_deltas.end(),
-              record.offset_delta())) {
-            /*
-             * TODO when we further optimize lazy record materialization ot
-             * make use of views we can avoid this re-encoding by copying or
-             * sharing the view. either way, we were building
-             * record batch with the uncompressed records so they were being
-             * re-encoded.
-             */
+              record->offset_delta())) {
+            // the kept records are copied as encoded in the batch
             if (!first_timestamp_delta) {
-                first_timestamp_delta = record.timestamp_delta();
+                first_timestamp_delta = record->timestamp_delta();
             }
-            last_timestamp_delta = record.timestamp_delta();
-            model::append_record_to_buffer(ret, record);
+            last_timestamp_delta = record->timestamp_delta();
+            record->append_to(ret);
             ++rec_count;
         }
-    });
+    }
     // From: DefaultRecordBatch.java
     // On Compaction: Unlike the older message formats, magic v2 and above
     // preserves the first and last offset/sequence numbers from the
@@ -230,28 +525,7 @@ ss::future<ss::stop_iteration> copy_data_segment_reducer::do_compaction(
     return compress_batch(original, std::move(to_copy.value()))
       .then([this](model::record_batch&& b) {
           return ss::do_with(std::move(b), [this](model::record_batch& batch) {
-              auto const start_offset = _appender->file_byte_offset();
-              auto const header_size = batch.header().size_bytes;
-              _acc += header_size;
-              if (_idx.maybe_index(
-                    _acc,
-                    32_KiB,
-                    start_offset,
-                    batch.base_offset(),
-                    batch.last_offset(),
-                    batch.header().first_timestamp,
-                    batch.header().max_timestamp)) {
-                  _acc = 0;
-              }
-              return storage::write(*_appender, batch)
-                .then([this, start_offset, header_size] {
-                    vassert(
-                      _appender->file_byte_offset()
-                        == start_offset + header_size,
-                      "Size must be deterministic. Expected:{} == {}",
-                      _appender->file_byte_offset(),
-                      start_offset + header_size);
-                });
+              return write_indexed_batch(*_appender, _idx, _acc, batch);
           });
       })
       .then([] { return ss::make_ready_future<stop_t>(stop_t::no); });
@@ -269,6 +543,33 @@ copy_data_segment_reducer::operator()(model::record_batch&& b) {
       });
 }
 
+bool recompress_data_segment_reducer::should_recompress(
+  const model::record_batch& b) const {
+    // control batches, e.g. transaction markers, are never compressed
+    return b.header().type == model::record_batch_type::raft_data
+           && !b.header().attrs.is_control() && b.record_count() > 0
+           && b.header().attrs.compression() != _compression;
+}
+
+ss::future<ss::stop_iteration>
+recompress_data_segment_reducer::operator()(model::record_batch&& b) {
+    // owned by the coroutine frame, the caller's batch may not outlive it
+    auto batch = std::move(b);
+    if (should_recompress(batch)) {
+        auto uncompressed = batch.compressed()
+                              ? co_await decompress_batch(batch)
+                              : batch.copy();
+        auto recompressed = co_await compress_batch(
+          _compression, std::move(uncompressed));
+        // incompressible batches are kept as they were
+        if (recompressed.size_bytes() < batch.size_bytes()) {
+            batch = std::move(recompressed);
+        }
+    }
+    co_await write_indexed_batch(*_appender, _idx, _acc, batch);
+    co_return ss::stop_iteration::no;
+}
+
 ss::future<ss::stop_iteration>
 index_rebuilder_reducer::operator()(model::record_batch&& b) {
     using stop_t = ss::stop_iteration;
@@ -286,9 +587,9 @@ index_rebuilder_reducer::operator()(model::record_batch&& b) {
 
 ss::future<> index_rebuilder_reducer::do_index(model::record_batch&& b) {
     return ss::do_with(std::move(b), [this](model::record_batch& b) {
-        return model::for_each_record(
-          b, [this, o = b.base_offset()](model::record& r) {
-              return _w->index(r.key(), o, r.offset_delta());
+        return model::for_each_record_view(
+          b, [this, o = b.base_offset()](const model::record_view& r) {
+              return _w->index(r.key_bytes(), o, r.offset_delta());
           });
     });
 }
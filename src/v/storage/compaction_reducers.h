@@ -20,6 +20,7 @@
 #include "storage/index_state.h"
 #include "storage/logger.h"
 #include "storage/segment_appender.h"
+#include "storage/types.h"
 #include "units.h"
 
 #include <absl/container/btree_map.h>
@@ -27,6 +28,10 @@
 #include <fmt/core.h>
 #include <roaring/roaring.hh>
 
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
 namespace storage::internal {
 
 struct compaction_reducer {};
@@ -66,6 +71,116 @@ private:
     uint32_t _natural_index{0};
 };
 
+/// Exact variant of compaction_key_reducer under a hard memory cap. Entries
+/// are buffered until the cap is reached, sorted by key and spilled as a run
+/// file next to the index under the compaction io priority class. At the end
+/// the runs are merged and the natural index of the newest entry of every key
+/// is kept. Run files are removed once merged.
+class sorted_run_key_reducer : public compaction_reducer {
+public:
+    sorted_run_key_reducer(
+      std::filesystem::path run_prefix,
+      size_t max_mem,
+      ss::io_priority_class,
+      debug_sanitize_files);
+
+    ss::future<ss::stop_iteration> operator()(compacted_index::entry&&);
+    ss::future<Roaring> end_of_stream();
+
+    size_t spilled_runs() const { return _runs.size(); }
+
+private:
+    struct run_entry {
+        bytes key;
+        model::offset offset;
+        uint32_t natural_index;
+    };
+    static constexpr size_t entry_overhead = sizeof(run_entry);
+
+    /// sorts by key and drops every entry but the newest of each key
+    void sort_and_dedupe();
+    ss::future<> spill();
+    ss::future<Roaring> merge();
+    ss::future<> remove_runs();
+
+    std::filesystem::path _run_prefix;
+    size_t _max_mem;
+    ss::io_priority_class _iopc;
+    debug_sanitize_files _sanitize;
+    std::vector<run_entry> _buffer;
+    size_t _buffer_mem{0};
+    std::vector<std::filesystem::path> _runs;
+    uint32_t _natural_index{0};
+};
+
+/// Newest offset of every key seen across a window of segments of a log. The
+/// map is memory bounded; once it is full unseen keys are no longer admitted,
+/// which only means that fewer shadowed records are dropped from older
+/// segments.
+class key_offset_map {
+public:
+    using underlying_t = absl::node_hash_map<
+      bytes,
+      model::offset,
+      bytes_hasher<uint64_t, xxhash_64>,
+      bytes_type_eq>;
+
+    explicit key_offset_map(size_t max_mem)
+      : _max_mem(max_mem) {}
+
+    /// \brief records `o` for `key`, keeping the greatest offset. Returns
+    /// false if the key was not admitted because the map is full
+    bool put(bytes key, model::offset o);
+
+    std::optional<model::offset> get(const bytes& key) const;
+
+    template<typename Pred>
+    bool any_key(Pred&& p) const {
+        return std::any_of(_map.begin(), _map.end(), [&p](const auto& e) {
+            return p(bytes_view(e.first));
+        });
+    }
+
+    size_t size() const { return _map.size(); }
+    bool empty() const { return _map.empty(); }
+    size_t memory_usage() const { return _mem_usage; }
+    bool full() const { return _mem_usage >= _max_mem; }
+
+private:
+    static constexpr size_t entry_overhead = sizeof(underlying_t::value_type)
+                                             + sizeof(void*);
+
+    underlying_t _map;
+    size_t _mem_usage{0};
+    size_t _max_mem;
+};
+
+/// Consumes the compacted index of a segment that is older than every
+/// segment already recorded in the map. Entries whose key has a newer offset
+/// in the map are shadowed; the rest are kept and recorded in the map so that
+/// even older segments are deduplicated against them.
+class cross_segment_dedupe_reducer : public compaction_reducer {
+public:
+    struct result {
+        /// natural index of the entries to keep
+        Roaring to_keep;
+        size_t shadowed{0};
+        /// set when the index was not read because of its key filter
+        bool skipped{false};
+    };
+
+    explicit cross_segment_dedupe_reducer(key_offset_map& m)
+      : _map(&m) {}
+
+    ss::future<ss::stop_iteration> operator()(compacted_index::entry&&);
+    result end_of_stream();
+
+private:
+    key_offset_map* _map;
+    result _result;
+    uint32_t _natural_index{0};
+};
+
 /// This class copies the input reader into the writer consulting the bitmap of
 /// wether ot keep the entry or not
 class index_filtered_copy_reducer : public compaction_reducer {
@@ -132,6 +247,28 @@ private:
     size_t _acc{0};
 };
 
+/// \brief copies the batches of a segment, rewriting the raft data batches
+/// with another compression when it makes them smaller. Offsets are left
+/// untouched, the index of the copy is returned
+class recompress_data_segment_reducer : public compaction_reducer {
+public:
+    recompress_data_segment_reducer(
+      model::compression c, segment_appender* a) noexcept
+      : _compression(c)
+      , _appender(a) {}
+
+    ss::future<ss::stop_iteration> operator()(model::record_batch&&);
+    storage::index_state end_of_stream() { return std::move(_idx); }
+
+private:
+    bool should_recompress(const model::record_batch&) const;
+
+    model::compression _compression;
+    segment_appender* _appender;
+    index_state _idx;
+    size_t _acc{0};
+};
+
 class index_rebuilder_reducer : public compaction_reducer {
 public:
     explicit index_rebuilder_reducer(compacted_index_writer* w) noexcept
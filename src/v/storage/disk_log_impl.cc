@@ -9,6 +9,7 @@
 
 #include "storage/disk_log_impl.h"
 
+#include "config/configuration.h"
 #include "model/adl_serde.h"
 #include "model/fundamental.h"
 #include "model/namespace.h"
@@ -17,6 +18,8 @@
 #include "reflection/adl.h"
 #include "storage/disk_log_appender.h"
 #include "storage/fwd.h"
+#include "storage/header_sidecar.h"
+#include "storage/key_index.h"
 #include "storage/kvstore.h"
 #include "storage/log_manager.h"
 #include "storage/logger.h"
@@ -26,6 +29,7 @@
 #include "storage/segment.h"
 #include "storage/segment_set.h"
 #include "storage/segment_utils.h"
+#include "storage/shard_wal.h"
 #include "storage/types.h"
 #include "storage/version.h"
 #include "utils/gate_guard.h"
@@ -44,6 +48,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <iterator>
 #include <sstream>
 
@@ -71,6 +76,7 @@ disk_log_impl::disk_log_impl(
         }
     }
     _probe.initial_segments_count(_segs.size());
+    _probe.attach_shard_usage(_manager.shard_disk_usage());
     _probe.setup_metrics(this->config().ntp());
 }
 disk_log_impl::~disk_log_impl() {
@@ -80,6 +86,7 @@ disk_log_impl::~disk_log_impl() {
 ss::future<> disk_log_impl::remove() {
     vassert(!_closed, "Invalid double closing of log - {}", *this);
     _closed = true;
+    _probe.detach_shard_usage();
     // gets all the futures started in the background
     std::vector<ss::future<>> permanent_delete;
     permanent_delete.reserve(_segs.size());
@@ -104,12 +111,18 @@ ss::future<> disk_log_impl::remove() {
                 return _kvstore.remove(
                   kvstore::key_space::storage,
                   internal::start_offset_key(config().ntp()));
+            })
+            .then([this] {
+                return _kvstore.remove(
+                  kvstore::key_space::storage,
+                  internal::clean_shutdown_key(config().ntp()));
             });
       });
 }
 ss::future<> disk_log_impl::close() {
     vassert(!_closed, "Invalid double closing of log - {}", *this);
     _closed = true;
+    _probe.detach_shard_usage();
     if (
       _eviction_monitor
       && !_eviction_monitor->promise.get_future().available()) {
@@ -125,6 +138,25 @@ ss::future<> disk_log_impl::close() {
             });
         });
     });
+
+    // lets the next start skip replaying the last segment
+    std::exception_ptr ex;
+    try {
+        auto record = co_await clean_shutdown_record::make(_segs);
+        co_await _kvstore.put(
+          kvstore::key_space::storage,
+          internal::clean_shutdown_key(config().ntp()),
+          reflection::to_iobuf(std::move(record)));
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        vlog(
+          stlog.warn,
+          "Error recording clean shutdown of {}: {}",
+          config().ntp(),
+          ex);
+    }
 }
 
 model::offset disk_log_impl::size_based_gc_max_offset(size_t max_size) {
@@ -338,6 +370,19 @@ ss::future<> disk_log_impl::do_compact(compaction_config cfg) {
         }
     }
 
+    if (config::shard_local_cfg().compaction_key_map_enabled()) {
+        auto r = co_await deduplicate_compacted_segments(cfg);
+        vlog(
+          gclog.debug,
+          "[{}] log wide deduplication result: {}",
+          config().ntp(),
+          r);
+        if (r.did_compact()) {
+            _compaction_ratio.update(r.compaction_ratio());
+            co_return;
+        }
+    }
+
     if (auto range = find_compaction_range(); range) {
         auto r = co_await compact_adjacent_segments(std::move(*range), cfg);
         vlog(
@@ -349,6 +394,35 @@ ss::future<> disk_log_impl::do_compact(compaction_config cfg) {
     }
 }
 
+ss::future<compaction_result>
+disk_log_impl::deduplicate_compacted_segments(compaction_config cfg) {
+    // the window is the prefix of closed, self compacted segments
+    std::vector<ss::lw_shared_ptr<segment>> segments;
+    for (auto& s : _segs) {
+        if (
+          s->has_appender() || !s->is_compacted_segment()
+          || !s->finished_self_compaction()) {
+            break;
+        }
+        segments.push_back(s);
+    }
+    if (
+      segments.size() < 2
+      || segments.back()->offsets().committed_offset
+           <= _last_deduplicated_offset) {
+        co_return compaction_result(0);
+    }
+    const auto newest = segments.back()->offsets().committed_offset;
+    auto r = co_await storage::internal::deduplicate_segments(
+      std::move(segments),
+      cfg,
+      _probe,
+      *_readers_cache,
+      config::shard_local_cfg().compaction_key_map_memory());
+    _last_deduplicated_offset = newest;
+    co_return r;
+}
+
 std::optional<std::pair<segment_set::iterator, segment_set::iterator>>
 disk_log_impl::find_compaction_range() {
     /*
@@ -543,6 +617,73 @@ disk_log_impl::apply_overrides(compaction_config defaults) const {
     return ret;
 }
 
+ss::future<bool> disk_log_impl::needs_recompression(
+  ss::lw_shared_ptr<segment> seg, model::compression type) {
+    auto h = co_await seg->read_lock();
+    if (seg->is_closed()) {
+        co_return false;
+    }
+    // only the batch headers are needed to tell
+    bool found = false;
+    co_await storage::scan_headers(
+      *seg,
+      0,
+      ss::default_priority_class(),
+      [type, &found](const model::record_batch_header& hdr) {
+          found = hdr.type == model::record_batch_type::raft_data
+                  && !hdr.attrs.is_control() && hdr.record_count > 0
+                  && hdr.attrs.compression() != type;
+          return ss::stop_iteration(found);
+      });
+    co_return found;
+}
+
+ss::future<> disk_log_impl::recompress_cold_segments(compaction_config cfg) {
+    const auto min_age
+      = config::shard_local_cfg().storage_recompression_min_age_ms();
+    if (!min_age || config().ntp().ns != model::kafka_namespace) {
+        co_return;
+    }
+    const auto type = config::shard_local_cfg().storage_recompression_type();
+    const auto bound = model::timestamp(
+      model::timestamp::now().value() - min_age->count());
+
+    // at most one segment is rewritten per pass, like compaction the work is
+    // paced by the housekeeping concurrency of the compaction controller
+    while (!cfg.asrc->abort_requested()) {
+        auto it = std::find_if(
+          _segs.begin(), _segs.end(), [bound](ss::lw_shared_ptr<segment>& s) {
+              return !s->has_appender() && !s->is_recompressed()
+                     && s->index().max_timestamp() <= bound;
+          });
+        if (it == _segs.end()) {
+            co_return;
+        }
+        auto seg = *it;
+        if (!co_await needs_recompression(seg, type)) {
+            seg->mark_as_recompressed();
+            continue;
+        }
+        if (seg->is_closed()) {
+            co_return;
+        }
+        const auto before = seg->size_bytes();
+        const auto after = co_await storage::internal::recompress_segment(
+          seg, cfg, _probe, *_readers_cache, type);
+        seg->mark_as_recompressed();
+        _probe.segment_recompressed(before - std::min(before, after));
+        vlog(
+          gclog.debug,
+          "[{}] recompressed segment {} with {}: {} -> {} bytes",
+          config().ntp(),
+          seg->reader().filename(),
+          type,
+          before,
+          after);
+        co_return;
+    }
+}
+
 ss::future<> disk_log_impl::compact(compaction_config cfg) {
     return ss::try_with_gate(_compaction_gate, [this, cfg]() mutable {
         vlog(
@@ -567,6 +708,7 @@ ss::future<> disk_log_impl::compact(compaction_config cfg) {
         if (config().is_compacted() && !_segs.empty()) {
             f = f.then([this, cfg] { return do_compact(cfg); });
         }
+        f = f.then([this, cfg] { return recompress_cold_segments(cfg); });
         return f.then(
           [this] { _probe.set_compaction_ratio(_compaction_ratio.get()); });
     });
@@ -736,11 +878,40 @@ log_appender disk_log_impl::make_appender(log_append_config cfg) {
       std::make_unique<disk_log_appender>(*this, cfg, now, next_offset));
 }
 
+void disk_log_impl::track_unflushed_append(
+  model::record_batch& batch, size_t bytes) {
+    _unflushed_bytes += bytes;
+    if (!_manager.shared_wal()) {
+        return;
+    }
+    if (
+      _unflushed_bytes
+      <= config::shard_local_cfg().storage_shared_wal_partition_bytes()) {
+        _wal_batches.push_back(batch.share());
+    } else {
+        // too large for the shared wal, the next flush is an fsync
+        _wal_batches.clear();
+    }
+}
+
 ss::future<> disk_log_impl::flush() {
     vassert(!_closed, "flush on closed log - {}", *this);
     if (_segs.empty()) {
         return ss::make_ready_future<>();
     }
+    auto wal = _manager.shared_wal();
+    // the appends logged in an older generation must reach the segments
+    // before the shared wal removes them
+    if (
+      wal && !_wal_batches.empty()
+      && _wal_generation.value_or(wal->generation()) == wal->generation()) {
+        _wal_generation = wal->generation();
+        return _segs.back()->write_back(
+          wal->append(config().ntp(), std::exchange(_wal_batches, {})));
+    }
+    _wal_batches.clear();
+    _unflushed_bytes = 0;
+    _wal_generation.reset();
     return _segs.back()->flush();
 }
 
@@ -916,6 +1087,121 @@ disk_log_impl::timequery(timequery_config cfg) {
       });
 }
 
+ss::future<std::optional<key_query_result>>
+disk_log_impl::key_query(key_query_config cfg) {
+    vassert(!_closed, "key_query on closed log - {}", *this);
+    // a segment replaced by compaction during the query is found closed,
+    // its replacement is looked up by the next attempt
+    for (int attempt = 0;; ++attempt) {
+        try {
+            co_return co_await do_key_query(cfg);
+        } catch (const segment_closed_exception&) {
+            if (attempt >= 2) {
+                throw;
+            }
+        }
+    }
+}
+
+ss::future<std::optional<key_query_result>>
+disk_log_impl::do_key_query(const key_query_config& cfg) {
+    const auto indexed = key_index::indexed_key(cfg.key);
+    // newest first
+    std::vector<ss::lw_shared_ptr<segment>> segs(_segs.begin(), _segs.end());
+    std::reverse(segs.begin(), segs.end());
+    for (auto& s : segs) {
+        const auto start = std::max(s->offsets().base_offset, _start_offset);
+        const auto last = std::min(
+          s->offsets().committed_offset, cfg.max_offset);
+        if (s->offsets().committed_offset < _start_offset) {
+            break;
+        }
+        if (start > last) {
+            continue;
+        }
+        std::optional<key_query_result> r;
+        if (s->has_appender() || !s->finished_self_compaction()) {
+            r = co_await read_key(cfg, start, last);
+        } else if (auto o = co_await find_indexed_key(s, cfg, indexed); o) {
+            if (*o > last) {
+                // the older records of the key are not indexed
+                r = co_await read_key(cfg, start, last);
+            } else if (*o >= start) {
+                r = co_await read_key(cfg, *o, *o);
+            }
+        }
+        if (r) {
+            co_return r;
+        }
+    }
+    co_return std::nullopt;
+}
+
+ss::future<std::optional<model::offset>> disk_log_impl::find_indexed_key(
+  ss::lw_shared_ptr<segment> s,
+  const key_query_config& cfg,
+  const bytes& indexed) {
+    auto h = co_await s->read_lock();
+    if (s->is_closed()) {
+        throw segment_closed_exception();
+    }
+    const auto sanitize = _manager.config().sanitize_fileops;
+    const auto path = internal::compacted_index_path(
+      s->reader().filename().c_str());
+    auto f = co_await internal::make_reader_handle(path, sanitize);
+    auto reader = make_file_backed_compacted_reader(
+      path.string(), std::move(f), cfg.prio, 64_KiB);
+    std::optional<model::offset> ret;
+    std::exception_ptr ex;
+    try {
+        auto& filter = s->compaction_key_filter();
+        if (!filter) {
+            auto loaded = co_await reader.load_key_filter();
+            filter = loaded ? ss::make_lw_shared<const key_bloom_filter>(
+                       std::move(*loaded))
+                            : nullptr;
+        }
+        // the filter has the keys in the form of the compaction index
+        if (
+          !*filter || (*filter)->maybe_contains(cfg.key)
+          || (*filter)->maybe_contains(indexed)) {
+            auto idx = co_await key_index::open(
+              s->reader().filename().c_str(),
+              reader,
+              s->cached_key_index(),
+              cfg.prio,
+              sanitize);
+            s->cached_key_index() = idx;
+            ret = co_await idx->find(indexed, cfg.prio);
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await reader.close().then_wrapped([](ss::future<>) {});
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return ret;
+}
+
+ss::future<std::optional<key_query_result>> disk_log_impl::read_key(
+  const key_query_config& cfg, model::offset start, model::offset last) {
+    log_reader_config rcfg(
+      start,
+      last,
+      0,
+      std::numeric_limits<size_t>::max(),
+      cfg.prio,
+      model::record_batch_type::raft_data,
+      std::nullopt,
+      std::nullopt);
+    // scans must not evict the batches of the tail readers
+    rcfg.skip_batch_cache = start != last;
+    auto reader = co_await make_reader(rcfg);
+    co_return co_await std::move(reader).consume(
+      internal::key_query_consumer(cfg.key, last), model::no_timeout);
+}
+
 ss::future<> disk_log_impl::remove_segment_permanently(
   ss::lw_shared_ptr<segment> s, std::string_view ctx) {
     vlog(stlog.info, "{} - tombstone & delete segment: {}", ctx, s);
@@ -1047,8 +1333,15 @@ ss::future<> disk_log_impl::do_truncate_prefix(truncate_prefix_config cfg) {
 ss::future<> disk_log_impl::truncate(truncate_config cfg) {
     vassert(!_closed, "truncate() on closed log - {}", *this);
     return _failure_probes.truncate().then([this, cfg]() mutable {
+        auto f = ss::now();
+        if (auto wal = _manager.shared_wal(); wal) {
+            // logged first so that a restart does not replay the appends it
+            // removes from the shared wal
+            _wal_batches.clear();
+            f = wal->truncate(config().ntp(), cfg.base_offset);
+        }
         // dispatch the actual truncation
-        return do_truncate(cfg);
+        return f.then([this, cfg] { return do_truncate(cfg); });
     });
 }
 
@@ -1239,6 +1532,31 @@ disk_log_impl::update_configuration(ntp_config::default_overrides o) {
  *  backlog = sum(n=1,cnt) [sum(k=0, cnt - n + 1)][cf^k * sizeof(sn)] -
  *  cf^(cnt-1) * s1
  */
+ss::future<>
+disk_log_impl::scrub(ss::io_priority_class iopc, ss::abort_source& as) {
+    // the compaction gate keeps the log open while segments are scrubbed
+    return ss::try_with_gate(_compaction_gate, [this, iopc, &as] {
+        std::vector<ss::lw_shared_ptr<segment>> to_scrub;
+        for (auto& s : _segs) {
+            if (!s->has_appender() && !s->is_verified()) {
+                to_scrub.push_back(s);
+            }
+        }
+        return ss::do_with(
+          std::move(to_scrub),
+          [this, iopc, &as](std::vector<ss::lw_shared_ptr<segment>>& segs) {
+              return ss::do_for_each(
+                segs, [this, iopc, &as](ss::lw_shared_ptr<segment>& s) {
+                    if (as.abort_requested() || _closed) {
+                        return ss::now();
+                    }
+                    return internal::scrub_segment(s, iopc, as, _probe)
+                      .discard_result();
+                });
+          });
+    });
+}
+
 int64_t disk_log_impl::compaction_backlog() const {
     if (!config().is_compacted() || _segs.empty()) {
         return 0;
@@ -76,6 +76,8 @@ public:
     /// timequery
     ss::future<std::optional<timequery_result>>
     timequery(timequery_config cfg) final;
+    ss::future<std::optional<key_query_result>>
+      key_query(key_query_config) final;
     size_t segment_count() const final { return _segs.size(); }
     offset_stats offsets() const final;
     std::optional<model::term_id> get_term(model::offset) const final;
@@ -95,10 +97,13 @@ public:
     size_t bytes_left_before_roll() const;
 
     size_t size_bytes() const override { return _probe.partition_size(); }
+    uint64_t bytes_written() const override { return _probe.bytes_written(); }
     ss::future<> update_configuration(ntp_config::default_overrides) final;
 
     int64_t compaction_backlog() const final;
 
+    ss::future<> scrub(ss::io_priority_class, ss::abort_source&) final;
+
 private:
     friend class disk_log_appender; // for multi-term appends
     friend class disk_log_builder;  // for tests
@@ -112,13 +117,25 @@ private:
 
     model::offset read_start_offset() const;
 
+    ss::future<std::optional<key_query_result>>
+    do_key_query(const key_query_config&);
+    ss::future<std::optional<model::offset>> find_indexed_key(
+      ss::lw_shared_ptr<segment>, const key_query_config&, const bytes&);
+    ss::future<std::optional<key_query_result>>
+    read_key(const key_query_config&, model::offset, model::offset);
+
     ss::future<> do_compact(compaction_config);
     ss::future<compaction_result> compact_adjacent_segments(
       std::pair<segment_set::iterator, segment_set::iterator>,
       storage::compaction_config cfg);
     std::optional<std::pair<segment_set::iterator, segment_set::iterator>>
     find_compaction_range();
+    ss::future<compaction_result> deduplicate_compacted_segments(
+      storage::compaction_config cfg);
     ss::future<> gc(compaction_config);
+    ss::future<> recompress_cold_segments(compaction_config);
+    ss::future<bool>
+      needs_recompression(ss::lw_shared_ptr<segment>, model::compression);
 
     ss::future<> remove_empty_segments();
 
@@ -150,6 +167,9 @@ private:
 
     compaction_config apply_overrides(compaction_config) const;
 
+    /// tracks an append not yet flushed to the segments, see flush()
+    void track_unflushed_append(model::record_batch&, size_t bytes);
+
 private:
     size_t max_segment_size() const;
     struct eviction_monitor {
@@ -171,6 +191,15 @@ private:
     std::unique_ptr<readers_cache> _readers_cache;
     // average ratio of segment sizes after segment size before compaction
     moving_average<double, 5> _compaction_ratio{1.0};
+    // committed offset of the newest segment covered by the last log wide
+    // deduplication pass
+    model::offset _last_deduplicated_offset;
+    // while the log holds few bytes not yet flushed to its segments its
+    // appends are made durable by the shard wide write-ahead log instead of
+    // an fsync, see shard_wal. generation of the last appends logged there.
+    std::vector<model::record_batch> _wal_batches;
+    size_t _unflushed_bytes{0};
+    std::optional<uint64_t> _wal_generation;
 };
 
 } // namespace storage
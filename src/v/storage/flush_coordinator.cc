@@ -0,0 +1,56 @@
+// Copyright 2020 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/flush_coordinator.h"
+
+#include "config/configuration.h"
+
+namespace storage::internal {
+
+flush_coordinator::flush_coordinator() noexcept
+  : _window(config::shard_local_cfg().segment_flush_coalesce_window_ms()) {
+    _timer.set_callback([this] { dispatch(); });
+}
+
+ss::future<> flush_coordinator::flush(const void* owner, ss::file f) {
+    _probe.flush_requested();
+    if (_window == std::chrono::milliseconds(0)) {
+        _probe.flush_issued();
+        return f.flush();
+    }
+    auto it = _pending.find(owner);
+    if (it == _pending.end()) {
+        it = _pending
+               .emplace(owner, ss::make_lw_shared<pending_flush>(std::move(f)))
+               .first;
+    }
+    auto done = it->second->done.get_shared_future();
+    // the first request of a window bounds its latency
+    if (!_timer.armed()) {
+        _timer.arm(_window);
+    }
+    return done;
+}
+
+void flush_coordinator::dispatch() {
+    auto window = std::exchange(_pending, {});
+    _probe.window_dispatched();
+    for (auto& [_, p] : window) {
+        _probe.flush_issued();
+        (void)p->file.flush().then_wrapped([p](ss::future<> f) {
+            if (f.failed()) {
+                p->done.set_exception(f.get_exception());
+            } else {
+                p->done.set_value();
+            }
+        });
+    }
+}
+
+} // namespace storage::internal
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2020 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "seastarx.h"
+#include "storage/probe.h"
+
+#include <seastar/core/file.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/core/timer.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <chrono>
+
+namespace storage::internal {
+
+/**
+ * Shard wide group commit for segment flushes.
+ *
+ * With many partitions per shard and acks=all every produce request ends in
+ * a flush of its segment. Instead of issuing each flush as it is requested the
+ * coordinator collects requests for up to `segment_flush_coalesce_window_ms`
+ * and then submits one flush per file for the whole window at once. Requests
+ * for a file that already has a flush queued in the open window share it.
+ *
+ * Sharing is only correct for a flush that has not been issued yet: callers
+ * request a flush after their writes have completed, so any flush issued
+ * afterwards covers them. Requests arriving while a window is in flight go
+ * into the next window.
+ *
+ * A zero window issues every flush immediately.
+ */
+class flush_coordinator {
+public:
+    flush_coordinator() noexcept;
+    flush_coordinator(flush_coordinator&&) = delete;
+    flush_coordinator& operator=(flush_coordinator&&) = delete;
+    flush_coordinator(const flush_coordinator&) = delete;
+    flush_coordinator& operator=(const flush_coordinator&) = delete;
+    ~flush_coordinator() noexcept = default;
+
+    /// flush `f` on behalf of `owner`. requests from the same owner within a
+    /// window are coalesced into a single flush of the file.
+    ss::future<> flush(const void* owner, ss::file f);
+
+    void set_window(std::chrono::milliseconds w) { _window = w; }
+    std::chrono::milliseconds window() const { return _window; }
+
+    void setup_metrics() { _probe.setup_metrics(); }
+
+private:
+    struct pending_flush {
+        explicit pending_flush(ss::file f)
+          : file(std::move(f)) {}
+        ss::file file;
+        ss::shared_promise<> done;
+    };
+    using pending_ptr = ss::lw_shared_ptr<pending_flush>;
+
+    void dispatch();
+
+    std::chrono::milliseconds _window;
+    absl::flat_hash_map<const void*, pending_ptr> _pending;
+    ss::timer<> _timer;
+    flush_coordinator_probe _probe;
+};
+
+inline flush_coordinator& flushes() {
+    static thread_local flush_coordinator coordinator;
+    return coordinator;
+}
+
+} // namespace storage::internal
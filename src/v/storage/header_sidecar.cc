@@ -0,0 +1,176 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/header_sidecar.h"
+
+#include "model/record_utils.h"
+#include "storage/logger.h"
+#include "storage/parser.h"
+#include "storage/segment.h"
+#include "storage/segment_utils.h"
+#include "units.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+
+namespace storage {
+
+static constexpr size_t sidecar_read_buffer_size = 32_KiB;
+
+namespace {
+
+struct stream_scan {
+    // file position of the next batch
+    size_t pos;
+    bool stopped{false};
+};
+
+} // namespace
+
+/// visits the headers read from \p in, the headers of the batches starting
+/// at `scan.pos`, until the visitor stops, an invalid header is found or a
+/// batch would end past \p fsize. headers are skipped up to \p start_pos
+static ss::future<> scan_stream(
+  ss::input_stream<char>& in,
+  stream_scan& scan,
+  size_t start_pos,
+  size_t fsize,
+  bool skip_records,
+  header_visitor& visitor) {
+    while (true) {
+        auto buf = co_await in.read_exactly(
+          model::packed_record_batch_header_size);
+        if (buf.size() != model::packed_record_batch_header_size) {
+            co_return;
+        }
+        iobuf b;
+        b.append(std::move(buf));
+        auto hdr = header_from_iobuf(std::move(b));
+        if (
+          hdr.header_crc == 0
+          || hdr.header_crc != model::internal_header_only_crc(hdr)
+          || hdr.size_bytes < int32_t(model::packed_record_batch_header_size)
+          || scan.pos + hdr.size_bytes > fsize) {
+            co_return;
+        }
+        if (
+          scan.pos >= start_pos && visitor(hdr) == ss::stop_iteration::yes) {
+            scan.stopped = true;
+            co_return;
+        }
+        scan.pos += hdr.size_bytes;
+        if (skip_records) {
+            co_await in.skip(
+              hdr.size_bytes - model::packed_record_batch_header_size);
+        }
+    }
+}
+
+static ss::future<> scan_sidecar(
+  segment& s, stream_scan& scan, size_t start_pos, header_visitor& visitor) {
+    auto path = internal::header_sidecar_path(s.reader().filename().c_str());
+    if (!co_await ss::file_exists(path.string())) {
+        co_return;
+    }
+    ss::file f;
+    try {
+        f = co_await ss::open_file_dma(path.string(), ss::open_flags::ro);
+    } catch (...) {
+        vlog(
+          stlog.warn,
+          "Error opening header sidecar {}: {}",
+          path,
+          std::current_exception());
+        co_return;
+    }
+    ss::file_input_stream_options opts;
+    opts.buffer_size = sidecar_read_buffer_size;
+    opts.read_ahead = 1;
+    auto in = ss::make_file_input_stream(f, 0, std::move(opts));
+    std::exception_ptr ex;
+    try {
+        co_await scan_stream(
+          in, scan, start_pos, s.reader().file_size(), false, visitor);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await in.close();
+    if (ex) {
+        // the data file is scanned from the last header read instead
+        vlog(stlog.warn, "Error reading header sidecar {}: {}", path, ex);
+    }
+}
+
+ss::future<size_t> scan_headers(
+  segment& s,
+  size_t start_pos,
+  ss::io_priority_class iopc,
+  header_visitor visitor) {
+    stream_scan scan{.pos = 0};
+    co_await scan_sidecar(s, scan, start_pos, visitor);
+    if (scan.stopped) {
+        co_return scan.pos;
+    }
+
+    // the batches not covered by the sidecar are read from the data file
+    const auto fsize = s.reader().file_size();
+    scan.pos = std::max(scan.pos, start_pos);
+    if (scan.pos >= fsize) {
+        co_return scan.pos;
+    }
+    auto in = s.reader().data_stream(scan.pos, fsize, iopc);
+    std::exception_ptr ex;
+    try {
+        co_await scan_stream(in, scan, start_pos, fsize, true, visitor);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await in.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return scan.pos;
+}
+
+namespace internal {
+
+std::filesystem::path header_sidecar_path(std::filesystem::path segment_path) {
+    return segment_path.replace_extension(".headers");
+}
+
+ss::future<segment_appender_ptr> make_header_sidecar_appender(
+  const std::filesystem::path& segment_path,
+  debug_sanitize_files debug,
+  ss::io_priority_class iopc) {
+    auto f = co_await make_handle(
+      header_sidecar_path(segment_path),
+      ss::open_flags::rw | ss::open_flags::create | ss::open_flags::truncate,
+      {},
+      debug);
+    // a single chunk, the sidecar grows by one header per batch
+    co_return std::make_unique<segment_appender>(
+      f, segment_appender::options(iopc, 1, 0));
+}
+
+ss::future<> remove_header_sidecar(std::filesystem::path segment_path) {
+    auto path = header_sidecar_path(std::move(segment_path));
+    try {
+        co_await ss::remove_file(path.string());
+    } catch (const std::filesystem::filesystem_error& e) {
+        if (e.code() != std::errc::no_such_file_or_directory) {
+            throw;
+        }
+    }
+}
+
+} // namespace internal
+
+} // namespace storage
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "model/record.h"
+#include "seastarx.h"
+#include "storage/fwd.h"
+#include "storage/segment_appender.h"
+#include "storage/types.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/io_priority_class.hh>
+#include <seastar/util/bool_class.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <filesystem>
+
+namespace storage {
+
+/**
+ * \brief header sidecar of a segment
+ *
+ * When segment_header_sidecar is enabled the segments of non-compacted
+ * partitions write the header of every appended batch, in its on-disk
+ * encoding, to a `.headers` file next to the data file. Scans that only look
+ * at batch headers read the sidecar, a small fraction of the segment bytes,
+ * and fall back to the data file for the batches it does not cover.
+ *
+ * The sidecar is a cache: it is only trusted for the prefix of valid headers
+ * whose batches end within the readable part of the data file, and it is
+ * removed whenever the data file is truncated or rewritten.
+ */
+using header_visitor = ss::noncopyable_function<ss::stop_iteration(
+  const model::record_batch_header&)>;
+
+/// \brief visits the headers of the batches of the segment starting at the
+/// file position \p start_pos, which must be a batch boundary, until the
+/// visitor stops or the readable end of the segment is reached.
+///
+/// Returns the file position of the batch the visitor stopped at, or of the
+/// end of the last visited batch.
+ss::future<size_t> scan_headers(
+  segment&, size_t start_pos, ss::io_priority_class, header_visitor);
+
+namespace internal {
+
+std::filesystem::path header_sidecar_path(std::filesystem::path segment_path);
+
+/// opens a new, empty, sidecar for the segment
+ss::future<segment_appender_ptr> make_header_sidecar_appender(
+  const std::filesystem::path& segment_path,
+  debug_sanitize_files,
+  ss::io_priority_class);
+
+/// removes the sidecar of the segment, if any
+ss::future<> remove_header_sidecar(std::filesystem::path segment_path);
+
+} // namespace internal
+
+} // namespace storage
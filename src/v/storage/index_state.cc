@@ -20,20 +20,36 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#include <array>
+#include <bit>
+#include <cstring>
 #include <optional>
 
 namespace storage {
 
+static_assert(
+  std::endian::native == std::endian::little,
+  "v4 index entries are searched in place and must be little endian");
+
 uint64_t index_state::checksum_state(const index_state& r) {
     auto xx = incremental_xxhash64{};
+    const uint32_t vsize = r.entries();
     xx.update_all(
       r.bitflags,
       r.base_offset(),
       r.max_offset(),
       r.base_timestamp(),
       r.max_timestamp(),
-      uint32_t(r.relative_offset_index.size()));
-    const uint32_t vsize = r.relative_offset_index.size();
+      vsize);
+    if (r.is_mapped()) {
+        // xxhash is streaming; hashing the arrays in one go is equivalent to
+        // hashing them entry by entry as we do below
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        xx.update(
+          reinterpret_cast<const char*>(r.mapped_offsets()),
+          vsize * (sizeof(uint32_t) * 2 + sizeof(uint64_t)));
+        return xx.digest();
+    }
     for (auto i = 0U; i < vsize; ++i) {
         xx.update(r.relative_offset_index[i]);
     }
@@ -45,6 +61,58 @@ uint64_t index_state::checksum_state(const index_state& r) {
     }
     return xx.digest();
 }
+
+void index_state::unmap() {
+    if (!is_mapped()) {
+        return;
+    }
+    relative_offset_index.append(mapped_offsets(), _mapped_entries);
+    relative_time_index.append(mapped_times(), _mapped_entries);
+    position_index.append(mapped_positions(), _mapped_entries);
+    _mapped = ss::temporary_buffer<char>();
+    _mapped_entries = 0;
+}
+
+void index_state::drop_entries() {
+    _mapped = ss::temporary_buffer<char>();
+    _mapped_entries = 0;
+    relative_offset_index = {};
+    relative_time_index = {};
+    position_index = {};
+}
+
+size_t index_state::lower_bound_relative_offset(uint32_t needle) const {
+    if (is_mapped()) {
+        return internal::branchless_lower_bound(
+          mapped_offsets(), _mapped_entries, needle);
+    }
+    return relative_offset_index.lower_bound(needle);
+}
+
+size_t index_state::lower_bound_relative_time(uint32_t needle) const {
+    if (is_mapped()) {
+        return internal::branchless_lower_bound(
+          mapped_times(), _mapped_entries, needle);
+    }
+    return relative_time_index.lower_bound(needle);
+}
+
+bool operator==(const index_state& a, const index_state& b) {
+    if (
+      a.size != b.size || a.checksum != b.checksum || a.bitflags != b.bitflags
+      || a.base_offset != b.base_offset || a.max_offset != b.max_offset
+      || a.base_timestamp != b.base_timestamp
+      || a.max_timestamp != b.max_timestamp || a.entries() != b.entries()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.entries(); ++i) {
+        if (a.get_entry(i) != b.get_entry(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool index_state::maybe_index(
   size_t accumulator,
   size_t step,
@@ -96,22 +164,54 @@ std::ostream& operator<<(std::ostream& o, const index_state& s) {
              << ", max_offset:" << s.max_offset
              << ", base_timestamp:" << s.base_timestamp
              << ", max_timestamp:" << s.max_timestamp << ", index("
-             << s.relative_offset_index.size() << ","
-             << s.relative_time_index.size() << "," << s.position_index.size()
-             << ")}";
+             << s.entries() << ", mapped:" << s.is_mapped() << ")}";
+}
+
+template<typename T>
+static T read_le(const char* src) {
+    T v;
+    std::memcpy(&v, src, sizeof(T));
+    return ss::le_to_cpu(v);
 }
 
 std::optional<index_state> index_state::hydrate_from_buffer(iobuf b) {
-    iobuf_parser parser(std::move(b));
-    index_state retval;
+    if (b.empty()) {
+        return std::nullopt;
+    }
+    if (b.begin()->get()[0] == 3) {
+        return hydrate_legacy_v3(std::move(b));
+    }
+    // linearize into a single aligned buffer which is then searched in place
+    auto buf = ss::temporary_buffer<char>::aligned(
+      alignof(uint64_t), b.size_bytes());
+    size_t pos = 0;
+    for (const auto& f : b) {
+        std::memcpy(buf.get_write() + pos, f.get(), f.size());
+        pos += f.size();
+    }
+    return hydrate_from_buffer(std::move(buf));
+}
 
-    auto version = reflection::adl<int8_t>{}.from(parser);
+std::optional<index_state>
+index_state::hydrate_from_buffer(ss::temporary_buffer<char> buf) {
+    if (buf.empty()) {
+        return std::nullopt;
+    }
+    const auto version = static_cast<int8_t>(buf[0]);
     switch (version) {
     case index_state::ondisk_version:
         break;
-
+    case 3: {
+        iobuf b;
+        b.append(std::move(buf));
+        return hydrate_legacy_v3(std::move(b));
+    }
     default:
         /*
+         * v4: same fields as v3 plus 3 bytes of padding after the header so
+         * that the arrays can be searched in place without deserialization.
+         * v3 is still decoded (by value) and rewritten as v4 on next flush.
+         *
          * v3: changed the on-disk format to use 64-bit values for physical
          * offsets to avoid overflow for segments larger than 4gb. backwards
          * compat would require converting the overflowed values. instead, we
@@ -134,6 +234,81 @@ std::optional<index_state> index_state::hydrate_from_buffer(iobuf b) {
           version);
         return std::nullopt;
     }
+    if (unlikely(buf.size() < ondisk_header_size)) {
+        vlog(stlog.debug, "Index too small for header: {}", buf.size());
+        return std::nullopt;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (reinterpret_cast<uintptr_t>(buf.get()) % alignof(uint64_t) != 0) {
+        // only dma and aligned buffers can be searched in place
+        auto aligned = ss::temporary_buffer<char>::aligned(
+          alignof(uint64_t), buf.size());
+        std::memcpy(aligned.get_write(), buf.get(), buf.size());
+        buf = std::move(aligned);
+    }
+
+    index_state retval;
+    const char* p = buf.get() + sizeof(int8_t);
+    retval.size = read_le<uint32_t>(p);
+    p += sizeof(uint32_t);
+    const size_t bytes_left = buf.size() - sizeof(int8_t) - sizeof(uint32_t);
+    if (unlikely(bytes_left != retval.size)) {
+        vlog(
+          stlog.debug,
+          "Index size does not match header size. Got:{}, expected:{}",
+          bytes_left,
+          retval.size);
+        return std::nullopt;
+    }
+    retval.checksum = read_le<uint64_t>(p);
+    p += sizeof(uint64_t);
+    retval.bitflags = read_le<uint32_t>(p);
+    p += sizeof(uint32_t);
+    retval.base_offset = model::offset(read_le<model::offset::type>(p));
+    p += sizeof(model::offset::type);
+    retval.max_offset = model::offset(read_le<model::offset::type>(p));
+    p += sizeof(model::offset::type);
+    retval.base_timestamp = model::timestamp(
+      read_le<model::timestamp::type>(p));
+    p += sizeof(model::timestamp::type);
+    retval.max_timestamp = model::timestamp(
+      read_le<model::timestamp::type>(p));
+    p += sizeof(model::timestamp::type);
+    const uint32_t vsize = read_le<uint32_t>(p);
+
+    const size_t expected = ondisk_header_size
+                            + size_t(vsize)
+                                * (sizeof(uint32_t) * 2 + sizeof(uint64_t));
+    if (unlikely(buf.size() != expected)) {
+        vlog(
+          stlog.debug,
+          "Index entries do not match buffer size. Got:{}, expected:{}",
+          buf.size(),
+          expected);
+        return std::nullopt;
+    }
+    if (vsize > 0) {
+        retval._mapped = std::move(buf);
+        retval._mapped_entries = vsize;
+    }
+    const auto computed_checksum = storage::index_state::checksum_state(retval);
+    if (unlikely(retval.checksum != computed_checksum)) {
+        vlog(
+          stlog.debug,
+          "Invalid checksum for index. Got:{}, expected:{}",
+          computed_checksum,
+          retval.checksum);
+        return std::nullopt;
+    }
+    return retval;
+}
+
+std::optional<index_state> index_state::hydrate_legacy_v3(iobuf b) {
+    iobuf_parser parser(std::move(b));
+    index_state retval;
+
+    auto version = reflection::adl<int8_t>{}.from(parser);
+    vassert(version == 3, "Unexpected legacy index version {}", version);
 
     retval.size = reflection::adl<uint32_t>{}.from(parser);
     if (unlikely(parser.bytes_left() != retval.size)) {
@@ -158,6 +333,9 @@ std::optional<index_state> index_state::hydrate_from_buffer(iobuf b) {
 
     const uint32_t vsize = ss::le_to_cpu(
       reflection::adl<uint32_t>{}.from(parser));
+    retval.relative_offset_index.reserve(vsize);
+    retval.relative_time_index.reserve(vsize);
+    retval.position_index.reserve(vsize);
     for (auto i = 0U; i < vsize; ++i) {
         retval.relative_offset_index.push_back(
           reflection::adl<uint32_t>{}.from(parser));
@@ -186,6 +364,7 @@ std::optional<index_state> index_state::hydrate_from_buffer(iobuf b) {
 }
 
 iobuf index_state::checksum_and_serialize() {
+    static constexpr size_t padding = ondisk_header_size - 53;
     iobuf out;
     vassert(
       relative_offset_index.size() == relative_time_index.size()
@@ -200,7 +379,8 @@ iobuf index_state::checksum_and_serialize() {
         + sizeof(storage::index_state::base_timestamp)
         + sizeof(storage::index_state::max_timestamp)
         + sizeof(uint32_t) // index size
-        + (relative_offset_index.size() * (sizeof(uint32_t) * 2 + sizeof(uint64_t)));
+        + padding
+        + (entries() * (sizeof(uint32_t) * 2 + sizeof(uint64_t)));
     size = final_size;
     checksum = storage::index_state::checksum_state(*this);
     reflection::serialize(
@@ -213,16 +393,24 @@ iobuf index_state::checksum_and_serialize() {
       max_offset(),
       base_timestamp(),
       max_timestamp(),
-      uint32_t(relative_offset_index.size()));
-    const uint32_t vsize = relative_offset_index.size();
-    for (auto i = 0U; i < vsize; ++i) {
-        reflection::adl<uint32_t>{}.to(out, relative_offset_index[i]);
-    }
-    for (auto i = 0U; i < vsize; ++i) {
-        reflection::adl<uint32_t>{}.to(out, relative_time_index[i]);
-    }
-    for (auto i = 0U; i < vsize; ++i) {
-        reflection::adl<uint64_t>{}.to(out, position_index[i]);
+      uint32_t(entries()));
+    const std::array<char, padding> zeros{};
+    out.append(zeros.data(), zeros.size());
+    const uint32_t vsize = entries();
+    if (is_mapped()) {
+        out.append(
+          _mapped.get() + ondisk_header_size,
+          _mapped.size() - ondisk_header_size);
+    } else {
+        for (auto i = 0U; i < vsize; ++i) {
+            reflection::adl<uint32_t>{}.to(out, relative_offset_index[i]);
+        }
+        for (auto i = 0U; i < vsize; ++i) {
+            reflection::adl<uint32_t>{}.to(out, relative_time_index[i]);
+        }
+        for (auto i = 0U; i < vsize; ++i) {
+            reflection::adl<uint64_t>{}.to(out, position_index[i]);
+        }
     }
     // add back the version and size field
     const auto expected_size = size + sizeof(int8_t) + sizeof(uint32_t);
@@ -16,10 +16,38 @@
 #include "model/timestamp.h"
 #include "utils/fragmented_vector.h"
 
+#include <seastar/core/temporary_buffer.hh>
+
 #include <cstdint>
 #include <optional>
 
 namespace storage {
+namespace internal {
+/// \brief branchless lower_bound over a contiguous sorted array.
+///
+/// The search window is halved with a conditional move rather than a branch,
+/// so random needles do not pay for mispredictions. Once the window is small
+/// enough the remaining candidates are counted with a linear scan, which the
+/// compiler vectorizes (SSE/AVX2 on x86, NEON on aarch64).
+template<typename T>
+inline size_t branchless_lower_bound(const T* data, size_t n, T needle) {
+    static constexpr size_t linear_scan_threshold = 16;
+    const T* base = data;
+    while (n > linear_scan_threshold) {
+        const size_t half = n / 2;
+        __builtin_prefetch(base + half / 2);
+        __builtin_prefetch(base + half + half / 2);
+        base = base[half] < needle ? base + half : base;
+        n -= half;
+    }
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        count += base[i] < needle;
+    }
+    return (base - data) + count;
+}
+} // namespace internal
+
 /* Fileformat:
    1 byte  - version
    4 bytes - size - does not include the version or size
@@ -30,12 +58,20 @@ namespace storage {
    8 bytes - base_time
    8 bytes - max_time
    4 bytes - index.size()
+   3 bytes - padding - keeps the arrays below naturally aligned (v4+)
    [] relative_offset_index
    [] relative_time_index
    [] position_index
+
+   All integers are little endian. Starting with v4 the three arrays are
+   laid out so that a dma buffer holding the whole file can be searched in
+   place: the header is 56 bytes, so the u32 arrays are 4 byte aligned and the
+   u64 array is 8 byte aligned as long as the buffer itself is.
  */
 struct index_state {
-    static constexpr int8_t ondisk_version = 3;
+    static constexpr int8_t ondisk_version = 4;
+    /// \brief header bytes before the first array entry, including padding
+    static constexpr size_t ondisk_header_size = 56;
 
     index_state() = default;
     index_state(index_state&&) noexcept = default;
@@ -64,22 +100,69 @@ struct index_state {
     fragmented_vector<uint32_t> relative_time_index;
     fragmented_vector<uint64_t> position_index;
 
-    bool empty() const { return relative_offset_index.empty(); }
+    /// \brief when hydrated from a v4 buffer the entries are read in place
+    /// from the dma buffer and the vectors above stay empty. The first
+    /// mutation copies the entries out, see `unmap()`. Closed segments are
+    /// never mutated, so their index costs exactly one buffer on the heap.
+    bool is_mapped() const { return !_mapped.empty(); }
+    void unmap();
+
+    size_t entries() const {
+        return is_mapped() ? _mapped_entries : relative_offset_index.size();
+    }
+    bool empty() const { return entries() == 0; }
+
+    /// \brief approximate heap bytes held by the entries
+    size_t memory_usage() const {
+        if (is_mapped()) {
+            return _mapped.size();
+        }
+        return relative_offset_index.size()
+               * (sizeof(uint32_t) * 2 + sizeof(uint64_t));
+    }
+
+    /// \brief drops all entries but keeps the header (offsets, timestamps)
+    void drop_entries();
+
+    uint32_t relative_offset(size_t i) const {
+        return is_mapped() ? mapped_offsets()[i] : relative_offset_index[i];
+    }
+    uint32_t relative_time(size_t i) const {
+        return is_mapped() ? mapped_times()[i] : relative_time_index[i];
+    }
+    uint64_t position(size_t i) const {
+        return is_mapped() ? mapped_positions()[i] : position_index[i];
+    }
+
+    /// \brief index of the first entry with relative offset >= needle, or
+    /// entries() when there is none
+    size_t lower_bound_relative_offset(uint32_t needle) const;
+    /// \brief index of the first entry with relative time >= needle, or
+    /// entries() when there is none
+    size_t lower_bound_relative_time(uint32_t needle) const;
 
     void
     add_entry(uint32_t relative_offset, uint32_t relative_time, uint64_t pos) {
+        unmap();
         relative_offset_index.push_back(relative_offset);
         relative_time_index.push_back(relative_time);
         position_index.push_back(pos);
     }
     void pop_back() {
+        unmap();
         relative_offset_index.pop_back();
         relative_time_index.pop_back();
         position_index.pop_back();
     }
-    std::tuple<uint32_t, uint32_t, uint64_t> get_entry(size_t i) {
-        return {
-          relative_offset_index[i], relative_time_index[i], position_index[i]};
+    /// \brief removes the last n entries
+    void pop_back(size_t n) {
+        unmap();
+        relative_offset_index.pop_back(n);
+        relative_time_index.pop_back(n);
+        position_index.pop_back(n);
+    }
+    std::tuple<uint32_t, uint32_t, uint64_t> get_entry(size_t i) const {
+        return {relative_offset(i), relative_time(i), position(i)};
     }
     iobuf checksum_and_serialize();
 
@@ -92,11 +175,34 @@ struct index_state {
       model::timestamp first_timestamp,
       model::timestamp last_timestamp);
 
-    friend bool operator==(const index_state&, const index_state&) = default;
+    friend bool operator==(const index_state&, const index_state&);
 
     static std::optional<index_state> hydrate_from_buffer(iobuf);
+    /// \brief zero-parse hydration; v4 buffers are kept and searched in place
+    static std::optional<index_state>
+      hydrate_from_buffer(ss::temporary_buffer<char>);
     static uint64_t checksum_state(const index_state&);
     friend std::ostream& operator<<(std::ostream&, const index_state&);
+
+private:
+    static std::optional<index_state> hydrate_legacy_v3(iobuf);
+
+    const uint32_t* mapped_offsets() const {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<const uint32_t*>(
+          _mapped.get() + ondisk_header_size);
+    }
+    const uint32_t* mapped_times() const {
+        return mapped_offsets() + _mapped_entries;
+    }
+    const uint64_t* mapped_positions() const {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        return reinterpret_cast<const uint64_t*>(
+          mapped_times() + _mapped_entries);
+    }
+
+    ss::temporary_buffer<char> _mapped;
+    uint32_t _mapped_entries{0};
 };
 
 } // namespace storage
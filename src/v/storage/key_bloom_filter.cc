@@ -0,0 +1,103 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/key_bloom_filter.h"
+
+#include "bytes/iobuf_parser.h"
+#include "hashing/crc32c.h"
+#include "hashing/xx.h"
+#include "vassert.h"
+
+#include <seastar/core/byteorder.hh>
+
+#include <algorithm>
+
+namespace storage {
+
+key_bloom_filter::key_bloom_filter(size_t size_bytes, uint8_t hashes)
+  : _words(std::max<size_t>(1, size_bytes / sizeof(uint64_t)), 0)
+  , _hashes(std::max<uint8_t>(1, hashes)) {}
+
+key_bloom_filter::key_bloom_filter(std::vector<uint64_t> w, uint8_t hashes)
+  : _words(std::move(w))
+  , _hashes(hashes) {}
+
+template<typename Func>
+void key_bloom_filter::for_each_bit(bytes_view key, Func&& f) const {
+    // double hashing (Kirsch-Mitzenmacher) out of a single 64 bit hash
+    const uint64_t h = xxhash_64(key.data(), key.size());
+    const uint64_t h1 = h & 0xffffffff;
+    const uint64_t h2 = (h >> 32U) | 1U;
+    const uint64_t bits = _words.size() * 64;
+    for (uint64_t i = 0; i < _hashes; ++i) {
+        const uint64_t bit = (h1 + i * h2) % bits;
+        f(bit / 64, uint64_t(1) << (bit % 64));
+    }
+}
+
+void key_bloom_filter::add(bytes_view key) {
+    for_each_bit(key, [this](size_t word, uint64_t mask) {
+        _words[word] |= mask;
+    });
+}
+
+bool key_bloom_filter::maybe_contains(bytes_view key) const {
+    bool found = true;
+    for_each_bit(key, [this, &found](size_t word, uint64_t mask) {
+        found = found && (_words[word] & mask) != 0;
+    });
+    return found;
+}
+
+iobuf key_bloom_filter::to_iobuf() const {
+    iobuf ret;
+    crc::crc32c crc;
+    ret.append(&_hashes, sizeof(_hashes));
+    const uint32_t words = ss::cpu_to_le(uint32_t(_words.size()));
+    // NOLINTNEXTLINE
+    ret.append(reinterpret_cast<const char*>(&words), sizeof(words));
+    for (auto w : _words) {
+        const uint64_t le = ss::cpu_to_le(w);
+        // NOLINTNEXTLINE
+        ret.append(reinterpret_cast<const char*>(&le), sizeof(le));
+        crc.extend(le);
+    }
+    const uint32_t c = ss::cpu_to_le(crc.value());
+    // NOLINTNEXTLINE
+    ret.append(reinterpret_cast<const char*>(&c), sizeof(c));
+    return ret;
+}
+
+std::optional<key_bloom_filter> key_bloom_filter::from_iobuf(iobuf b) {
+    iobuf_parser p(std::move(b));
+    if (p.bytes_left() < sizeof(uint8_t) + 2 * sizeof(uint32_t)) {
+        return std::nullopt;
+    }
+    const auto hashes = p.consume_type<uint8_t>();
+    const auto words = ss::le_to_cpu(p.consume_type<uint32_t>());
+    if (
+      hashes == 0 || words == 0
+      || p.bytes_left() != words * sizeof(uint64_t) + sizeof(uint32_t)) {
+        return std::nullopt;
+    }
+    crc::crc32c crc;
+    std::vector<uint64_t> w;
+    w.reserve(words);
+    for (uint32_t i = 0; i < words; ++i) {
+        const auto le = p.consume_type<uint64_t>();
+        crc.extend(le);
+        w.push_back(ss::le_to_cpu(le));
+    }
+    if (ss::le_to_cpu(p.consume_type<uint32_t>()) != crc.value()) {
+        return std::nullopt;
+    }
+    return key_bloom_filter(std::move(w), hashes);
+}
+
+} // namespace storage
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "bytes/bytes.h"
+#include "bytes/iobuf.h"
+#include "units.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace storage {
+
+/// \brief bloom filter over the keys of a compaction index. Stored between
+/// the entries and the footer of the index file when the footer carries
+/// `compacted_index::footer_flags::key_filter`.
+///
+/// The filter has a fixed size; a segment with more keys than the filter was
+/// sized for only sees more false positives, never false negatives.
+class key_bloom_filter {
+public:
+    static constexpr size_t default_size_bytes = 64_KiB;
+    static constexpr uint8_t default_hashes = 4;
+
+    explicit key_bloom_filter(
+      size_t size_bytes = default_size_bytes, uint8_t hashes = default_hashes);
+
+    void add(bytes_view key);
+    bool maybe_contains(bytes_view key) const;
+
+    size_t size_bytes() const { return _words.size() * sizeof(uint64_t); }
+
+    /// format is:
+    /// UINT8 UINT32 []UINT64 UINT32(crc)
+    iobuf to_iobuf() const;
+    /// \brief returns nullopt if the buffer is not a valid filter
+    static std::optional<key_bloom_filter> from_iobuf(iobuf);
+
+private:
+    key_bloom_filter(std::vector<uint64_t>, uint8_t hashes);
+
+    template<typename Func>
+    void for_each_bit(bytes_view key, Func&& f) const;
+
+    std::vector<uint64_t> _words;
+    uint8_t _hashes;
+};
+
+} // namespace storage
@@ -0,0 +1,393 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/key_index.h"
+
+#include "bytes/iobuf_parser.h"
+#include "bytes/utils.h"
+#include "hashing/crc32c.h"
+#include "random/generators.h"
+#include "storage/logger.h"
+#include "storage/parser_utils.h"
+#include "storage/segment_utils.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+
+#include <algorithm>
+
+namespace storage {
+
+// fences size, blocks, keys, the source footer without its version and the
+// crc of the fences, followed by the version
+static constexpr size_t trailer_size = 8 * sizeof(uint32_t) + sizeof(int8_t);
+
+template<typename T>
+static void append_le(iobuf& b, T v) {
+    const T le = ss::cpu_to_le(v);
+    // NOLINTNEXTLINE
+    b.append(reinterpret_cast<const char*>(&le), sizeof(le));
+}
+
+template<typename T>
+static T consume_le(iobuf_parser& p) {
+    return ss::le_to_cpu(p.consume_type<T>());
+}
+
+static void append_key(iobuf& b, const bytes& k) {
+    append_le(b, uint16_t(k.size()));
+    // NOLINTNEXTLINE
+    b.append(reinterpret_cast<const char*>(k.data()), k.size());
+}
+
+static bytes consume_key(iobuf_parser& p) {
+    return p.read_bytes(consume_le<uint16_t>(p));
+}
+
+static bool same_source(
+  const compacted_index::footer& a, const compacted_index::footer& b) {
+    return a.size == b.size && a.keys == b.keys && a.flags == b.flags
+           && a.crc == b.crc;
+}
+
+static ss::future<iobuf> read_range(
+  ss::file f, uint64_t pos, size_t len, ss::io_priority_class iopc) {
+    ss::file_input_stream_options opts;
+    opts.buffer_size = 4096;
+    opts.io_priority_class = iopc;
+    opts.read_ahead = 0;
+    auto in = ss::make_file_input_stream(std::move(f), pos, len, opts);
+    std::exception_ptr ex;
+    iobuf b;
+    try {
+        b = co_await read_iobuf_exactly(in, len);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await in.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    if (b.size_bytes() != len) {
+        throw std::runtime_error(
+          fmt::format("short read of {} bytes at {}", len, pos));
+    }
+    co_return b;
+}
+
+bytes key_index::indexed_key(bytes_view key) {
+    if (key.size() > compacted_index::fingerprint_size) {
+        return compacted_index::fingerprint(key);
+    }
+    return bytes(key.data(), key.size());
+}
+
+key_index::key_index(
+  std::filesystem::path path,
+  std::vector<fence> fences,
+  size_t keys,
+  compacted_index::footer source) noexcept
+  : _path(std::move(path))
+  , _fences(std::move(fences))
+  , _keys(keys)
+  , _source(source) {}
+
+ss::future<ss::lw_shared_ptr<const key_index>> key_index::open(
+  std::filesystem::path segment_path,
+  compacted_index_reader source,
+  ss::lw_shared_ptr<const key_index> cached,
+  ss::io_priority_class iopc,
+  debug_sanitize_files debug) {
+    source.reset();
+    const auto footer = co_await source.load_footer();
+    if (cached && same_source(cached->source(), footer)) {
+        co_return cached;
+    }
+    auto path = internal::key_index_path(std::move(segment_path));
+    auto loaded = co_await load(path, iopc);
+    if (loaded && same_source(loaded->source(), footer)) {
+        co_return ss::make_lw_shared<const key_index>(std::move(*loaded));
+    }
+    vlog(stlog.debug, "Building key index {}", path);
+    auto built = co_await build(
+      std::move(path), std::move(source), footer, iopc, debug);
+    co_return ss::make_lw_shared<const key_index>(std::move(built));
+}
+
+ss::future<std::optional<key_index>>
+key_index::load(std::filesystem::path path, ss::io_priority_class iopc) {
+    if (!co_await ss::file_exists(path.string())) {
+        co_return std::nullopt;
+    }
+    auto f = co_await ss::open_file_dma(path.string(), ss::open_flags::ro);
+    std::optional<key_index> ret;
+    std::exception_ptr ex;
+    try {
+        const auto size = co_await f.size();
+        if (size < trailer_size) {
+            throw std::runtime_error(fmt::format("truncated file: {}", size));
+        }
+        iobuf_parser t(
+          co_await read_range(f, size - trailer_size, trailer_size, iopc));
+        const auto fences_size = consume_le<uint32_t>(t);
+        const auto blocks = consume_le<uint32_t>(t);
+        const auto keys = consume_le<uint32_t>(t);
+        compacted_index::footer source;
+        source.size = consume_le<uint32_t>(t);
+        source.keys = consume_le<uint32_t>(t);
+        source.flags = compacted_index::footer_flags(consume_le<uint32_t>(t));
+        source.crc = consume_le<uint32_t>(t);
+        const auto fences_crc = consume_le<uint32_t>(t);
+        const auto v = t.consume_type<int8_t>();
+        if (v != version || fences_size > size - trailer_size) {
+            throw std::runtime_error(fmt::format(
+              "invalid trailer: version {}, fences size {}", v, fences_size));
+        }
+        const auto data_size = size - trailer_size - fences_size;
+        auto fb = co_await read_range(f, data_size, fences_size, iopc);
+        crc::crc32c crc;
+        crc_extend_iobuf(crc, fb);
+        if (crc.value() != fences_crc) {
+            throw std::runtime_error("fences crc mismatch");
+        }
+        iobuf_parser p(std::move(fb));
+        std::vector<fence> fences;
+        fences.reserve(blocks);
+        while (p.bytes_left() > 0) {
+            auto k = consume_key(p);
+            const auto pos = consume_le<uint64_t>(p);
+            const auto len = consume_le<uint32_t>(p);
+            if (pos + len > data_size) {
+                throw std::runtime_error(
+                  fmt::format("block {}~{} past {}", pos, len, data_size));
+            }
+            fences.push_back(
+              fence{.first_key = std::move(k), .position = pos, .size = len});
+        }
+        if (fences.size() != blocks) {
+            throw std::runtime_error(
+              fmt::format("{} fences, expected {}", fences.size(), blocks));
+        }
+        ret = key_index(path, std::move(fences), keys, source);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await f.close();
+    if (ex) {
+        // rebuilt by the caller
+        vlog(stlog.info, "Ignoring key index {}: {}", path, ex);
+    }
+    co_return ret;
+}
+
+ss::future<key_index> key_index::build(
+  std::filesystem::path path,
+  compacted_index_reader source,
+  compacted_index::footer footer,
+  ss::io_priority_class iopc,
+  debug_sanitize_files debug) {
+    struct collector {
+        ss::future<ss::stop_iteration> operator()(compacted_index::entry e) {
+            if (e.type == compacted_index::entry_type::key) {
+                entries.push_back(entry{
+                  .key = indexed_key(e.key),
+                  .offset = e.offset + model::offset(e.delta)});
+            }
+            return ss::make_ready_future<ss::stop_iteration>(
+              ss::stop_iteration::no);
+        }
+        std::vector<entry> end_of_stream() { return std::move(entries); }
+        std::vector<entry> entries;
+    };
+    source.reset();
+    auto entries = co_await source.consume(collector{}, model::no_timeout);
+    // the latest offset of every key first
+    std::sort(
+      entries.begin(), entries.end(), [](const entry& a, const entry& b) {
+          return a.key < b.key || (a.key == b.key && a.offset > b.offset);
+      });
+    entries.erase(
+      std::unique(
+        entries.begin(),
+        entries.end(),
+        [](const entry& a, const entry& b) { return a.key == b.key; }),
+      entries.end());
+
+    // written aside and renamed, lookups of concurrent builders never see a
+    // partial file
+    auto staging = path;
+    staging += fmt::format(
+      ".{}.staging", random_generators::gen_alphanum_string(4));
+    auto f = co_await internal::make_handle(
+      staging,
+      ss::open_flags::wo | ss::open_flags::create | ss::open_flags::exclusive,
+      {},
+      debug);
+    ss::file_output_stream_options opts;
+    opts.io_priority_class = iopc;
+    auto out = co_await ss::make_file_output_stream(std::move(f), opts);
+    std::vector<fence> fences;
+    std::exception_ptr ex;
+    try {
+        iobuf block;
+        uint64_t pos = 0;
+        auto flush_block = [&fences, &block, &pos, &out] {
+            fences.back().size = block.size_bytes();
+            pos += block.size_bytes();
+            return write_iobuf_to_output_stream(
+              std::exchange(block, iobuf{}), out);
+        };
+        for (const auto& e : entries) {
+            const auto size = sizeof(uint16_t) + e.key.size() + sizeof(int64_t);
+            if (!block.empty() && block.size_bytes() + size > block_size) {
+                co_await flush_block();
+            }
+            if (block.empty()) {
+                fences.push_back(
+                  fence{.first_key = e.key, .position = pos, .size = 0});
+            }
+            append_key(block, e.key);
+            append_le<int64_t>(block, e.offset());
+        }
+        if (!block.empty()) {
+            co_await flush_block();
+        }
+
+        iobuf fb;
+        for (const auto& fc : fences) {
+            append_key(fb, fc.first_key);
+            append_le<uint64_t>(fb, fc.position);
+            append_le<uint32_t>(fb, fc.size);
+        }
+        crc::crc32c crc;
+        crc_extend_iobuf(crc, fb);
+        iobuf trailer;
+        append_le<uint32_t>(trailer, fb.size_bytes());
+        append_le<uint32_t>(trailer, fences.size());
+        append_le<uint32_t>(trailer, entries.size());
+        append_le<uint32_t>(trailer, footer.size);
+        append_le<uint32_t>(trailer, footer.keys);
+        append_le<uint32_t>(
+          trailer,
+          std::underlying_type_t<compacted_index::footer_flags>(footer.flags));
+        append_le<uint32_t>(trailer, footer.crc);
+        append_le<uint32_t>(trailer, crc.value());
+        const int8_t v = version;
+        // NOLINTNEXTLINE
+        trailer.append(reinterpret_cast<const char*>(&v), sizeof(v));
+        fb.append(std::move(trailer));
+        co_await write_iobuf_to_output_stream(std::move(fb), out);
+        co_await out.flush();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    try {
+        co_await out.close();
+        if (!ex) {
+            co_await ss::rename_file(staging.string(), path.string());
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        co_await ss::remove_file(staging.string())
+          .handle_exception([](std::exception_ptr) {});
+        std::rethrow_exception(ex);
+    }
+    co_return key_index(
+      std::move(path), std::move(fences), entries.size(), footer);
+}
+
+ss::future<std::optional<model::offset>>
+key_index::find(const bytes& key, ss::io_priority_class iopc) const {
+    // the last block starting at or before the key
+    auto it = std::upper_bound(
+      _fences.begin(), _fences.end(), key, [](const bytes& k, const fence& f) {
+          return k < f.first_key;
+      });
+    if (it == _fences.begin()) {
+        co_return std::nullopt;
+    }
+    const auto pos = std::prev(it)->position;
+    const auto size = std::prev(it)->size;
+    auto f = co_await ss::open_file_dma(_path.string(), ss::open_flags::ro);
+    iobuf block;
+    std::exception_ptr ex;
+    try {
+        block = co_await read_range(f, pos, size, iopc);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await f.close();
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    iobuf_parser p(std::move(block));
+    while (p.bytes_left() > 0) {
+        const auto k = consume_key(p);
+        const auto o = model::offset(consume_le<int64_t>(p));
+        if (k == key) {
+            co_return o;
+        }
+        if (key < k) {
+            break;
+        }
+    }
+    co_return std::nullopt;
+}
+
+namespace internal {
+
+std::filesystem::path key_index_path(std::filesystem::path segment_path) {
+    return segment_path.replace_extension(".key_index");
+}
+
+ss::future<ss::stop_iteration>
+key_query_consumer::operator()(model::record_batch b) {
+    if (b.header().type != model::record_batch_type::raft_data) {
+        return ss::make_ready_future<ss::stop_iteration>(
+          ss::stop_iteration::no);
+    }
+    if (b.compressed()) {
+        return decompress_batch(std::move(b))
+          .then([this](model::record_batch b) {
+              visit(b);
+              return ss::stop_iteration::no;
+          });
+    }
+    visit(b);
+    return ss::make_ready_future<ss::stop_iteration>(ss::stop_iteration::no);
+}
+
+void key_query_consumer::visit(const model::record_batch& b) {
+    b.for_each_record([this, &b](model::record r) {
+        const auto o = b.base_offset() + model::offset(r.offset_delta());
+        if (
+          o > _max_offset || r.key().size_bytes() != _key.size()
+          || iobuf_to_bytes(r.key()) != _key) {
+            return;
+        }
+        std::optional<iobuf> value;
+        if (r.value_size() >= 0) {
+            value = r.release_value();
+        }
+        _result = key_query_result{
+          .offset = o,
+          .time = model::timestamp(
+            b.header().first_timestamp() + r.timestamp_delta()),
+          .value = std::move(value),
+        };
+    });
+}
+
+} // namespace internal
+
+} // namespace storage
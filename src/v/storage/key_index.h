@@ -0,0 +1,143 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/bytes.h"
+#include "model/fundamental.h"
+#include "model/record.h"
+#include "seastarx.h"
+#include "storage/compacted_index.h"
+#include "storage/compacted_index_reader.h"
+#include "storage/types.h"
+#include "units.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/io_priority_class.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace storage {
+
+/**
+ * \brief sorted key index of a self compacted segment
+ *
+ * A `.key_index` file next to the segment maps every key of its compaction
+ * index to the offset of the latest record with that key. The entries are
+ * sorted by key and grouped in blocks of about `block_size` bytes; the first
+ * key and the file position of every block are kept in memory once the index
+ * is loaded, so a lookup reads a single block.
+ *
+ * The index is derived from the compaction index and records the footer of
+ * the index it was built from. It is stale, and rebuilt, as soon as the
+ * compaction index no longer has that footer, e.g. once the segment was
+ * deduplicated against newer segments.
+ *
+ * Keys longer than compacted_index::fingerprint_size are stored as their
+ * fingerprint whatever the key mode of the compaction index, a lookup must
+ * compare the key of the record it reads.
+ *
+ * format is:
+ * []BLOCK []FENCE UINT32(fences size) UINT32(blocks) UINT32(keys)
+ * FOOTER(source) UINT32(crc of fences) INT8(version)
+ * with BLOCK: []{UINT16(key size) KEY INT64(offset)}
+ * and FENCE: UINT16(key size) KEY UINT64(position) UINT32(size)
+ */
+class key_index {
+public:
+    static constexpr size_t block_size = 4_KiB;
+    static constexpr int8_t version = 1;
+
+    /// \brief the form of \p key stored in the index
+    static bytes indexed_key(bytes_view key);
+
+    /// \brief loads the index of the segment, rebuilt from its compaction
+    /// index \p source when missing or stale. \p cached is returned as is when
+    /// it was built from the current compaction index
+    static ss::future<ss::lw_shared_ptr<const key_index>> open(
+      std::filesystem::path segment_path,
+      compacted_index_reader source,
+      ss::lw_shared_ptr<const key_index> cached,
+      ss::io_priority_class,
+      debug_sanitize_files);
+
+    /// \brief offset of the latest record of the segment with \p key, the
+    /// key in its indexed form
+    ss::future<std::optional<model::offset>>
+    find(const bytes& key, ss::io_priority_class) const;
+
+    size_t keys() const { return _keys; }
+    const compacted_index::footer& source() const { return _source; }
+    const std::filesystem::path& path() const { return _path; }
+
+private:
+    struct entry {
+        bytes key;
+        model::offset offset;
+    };
+    struct fence {
+        bytes first_key;
+        uint64_t position;
+        uint32_t size;
+    };
+
+    key_index(
+      std::filesystem::path,
+      std::vector<fence>,
+      size_t keys,
+      compacted_index::footer source) noexcept;
+
+    static ss::future<std::optional<key_index>>
+      load(std::filesystem::path, ss::io_priority_class);
+    static ss::future<key_index> build(
+      std::filesystem::path,
+      compacted_index_reader,
+      compacted_index::footer,
+      ss::io_priority_class,
+      debug_sanitize_files);
+
+    std::filesystem::path _path;
+    std::vector<fence> _fences;
+    size_t _keys;
+    compacted_index::footer _source;
+};
+
+namespace internal {
+
+std::filesystem::path key_index_path(std::filesystem::path segment_path);
+
+/// \brief consumer of a record_batch_reader keeping the latest record of the
+/// data batches with the key, up to the max offset
+class key_query_consumer {
+public:
+    key_query_consumer(bytes key, model::offset max_offset) noexcept
+      : _key(std::move(key))
+      , _max_offset(max_offset) {}
+
+    ss::future<ss::stop_iteration> operator()(model::record_batch);
+    std::optional<key_query_result> end_of_stream() {
+        return std::move(_result);
+    }
+
+private:
+    void visit(const model::record_batch&);
+
+    bytes _key;
+    model::offset _max_offset;
+    std::optional<key_query_result> _result;
+};
+
+} // namespace internal
+
+} // namespace storage
@@ -19,8 +19,10 @@
 #include "storage/record_batch_builder.h"
 #include "storage/segment_set.h"
 #include "storage/types.h"
+#include "utils/directory_walker.h"
 #include "vlog.h"
 
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/metrics.hh>
 #include <seastar/core/thread.hh>
 #include <seastar/util/defer.hh>
@@ -30,6 +32,19 @@ static ss::logger lg("kvstore");
 
 namespace storage {
 
+/// version of the main snapshot when it is a manifest of key space snapshots
+static constexpr int8_t snapshot_manifest_version = 1;
+static constexpr std::string_view key_space_snapshot_prefix = "kvstore_ks";
+
+static ss::sstring
+key_space_snapshot_name(kvstore::key_space ks, model::offset o) {
+    return fmt::format(
+      "{}_{}_{}",
+      key_space_snapshot_prefix,
+      static_cast<std::underlying_type_t<kvstore::key_space>>(ks),
+      o());
+}
+
 kvstore::kvstore(kvstore_config kv_conf)
   : _conf(std::move(kv_conf))
   , _ntpc(model::kvstore_ntp(ss::this_shard_id()), _conf.base_dir)
@@ -37,7 +52,11 @@ kvstore::kvstore(kvstore_config kv_conf)
       std::filesystem::path(_ntpc.work_directory()),
       simple_snapshot_manager::default_snapshot_filename,
       ss::default_priority_class())
-  , _timer([this] { _sem.signal(); }) {}
+  , _timer([this] { _sem.signal(); })
+  , _key_space_snap(
+      ss::sstring(key_space_snapshot_prefix),
+      std::filesystem::path(_ntpc.work_directory()),
+      ss::default_priority_class()) {}
 
 ss::future<> kvstore::start() {
     vlog(lg.debug, "Starting kvstore: dir {}", _ntpc.work_directory());
@@ -70,6 +89,24 @@ ss::future<> kvstore::start() {
               "key_count",
               [this] { return _db.size(); },
               ss::metrics::description("Number of keys in the database")),
+            ss::metrics::make_total_operations(
+              "key_spaces_snapshotted",
+              [this] { return _probe.key_spaces_snapshotted; },
+              ss::metrics::description(
+                "Number of key space snapshots written")),
+            ss::metrics::make_histogram(
+              "flush_latency",
+              ss::metrics::description(
+                "Latency of writing and flushing a group commit"),
+              [this] {
+                  return _probe.flush_latency.seastar_histogram_logform();
+              }),
+            ss::metrics::make_histogram(
+              "snapshot_latency",
+              ss::metrics::description("Latency of saving a snapshot"),
+              [this] {
+                  return _probe.snapshot_latency.seastar_histogram_logform();
+              }),
           });
     }
 
@@ -131,6 +168,10 @@ ss::future<> kvstore::stop() {
 /*
  * Return a key prefixed by a key-space
  */
+static inline kvstore::key_space key_space_of(bytes_view spaced_key) {
+    return static_cast<kvstore::key_space>(spaced_key[0]);
+}
+
 static inline bytes make_spaced_key(kvstore::key_space ks, bytes_view key) {
     auto ks_native
       = static_cast<std::underlying_type<kvstore::key_space>::type>(ks);
@@ -181,6 +222,7 @@ ss::future<> kvstore::put(key_space ks, bytes key, std::optional<iobuf> value) {
 }
 
 void kvstore::apply_op(bytes key, std::optional<iobuf> value) {
+    _dirty_key_spaces.insert(key_space_of(key));
     auto it = _db.find(key);
     bool found = it != _db.end();
     if (value) {
@@ -239,7 +281,11 @@ ss::future<> kvstore::flush_and_apply_ops() {
      */
     return _segment->append(std::move(batch))
       .then([this](append_result) { return _segment->flush(); })
-      .then([this, last_offset, ops = std::move(ops)]() mutable {
+      .then([this,
+             last_offset,
+             ops = std::move(ops),
+             m = _probe.flush_latency.auto_measure()]() mutable {
+          m.reset();
           for (auto& op : ops) {
               apply_op(std::move(op.key), std::move(op.value));
               op.done.set_value();
@@ -308,6 +354,90 @@ ss::future<> kvstore::roll() {
     return ss::now();
 }
 
+/*
+ * serialize batch: size_prefix + batch
+ */
+static iobuf serialize_snapshot_data(model::record_batch batch) {
+    iobuf data;
+    auto ph = data.reserve(sizeof(int32_t));
+    reflection::serialize(data, std::move(batch));
+    auto size = ss::cpu_to_le(int32_t(data.size_bytes() - sizeof(int32_t)));
+    ph.write((const char*)&size, sizeof(size));
+    return data;
+}
+
+static ss::future<>
+write_snapshot(snapshot_writer& wr, iobuf meta, iobuf data) {
+    return wr.write_metadata(std::move(meta))
+      .then([&wr, data = std::move(data)]() mutable {
+          return write_iobuf_to_output_stream(std::move(data), wr.output());
+      })
+      .then([&wr] { return wr.close(); });
+}
+
+std::optional<model::record_batch>
+kvstore::key_space_batch(key_space ks) const {
+    std::optional<storage::record_batch_builder> builder;
+    for (auto& entry : _db) {
+        if (key_space_of(entry.first) != ks) {
+            continue;
+        }
+        if (!builder) {
+            builder.emplace(model::record_batch_type::kvstore, model::offset(0));
+        }
+        builder->add_raw_kv(
+          bytes_to_iobuf(entry.first),
+          entry.second.share(0, entry.second.size_bytes()));
+    }
+    if (!builder) {
+        return std::nullopt;
+    }
+    return std::move(*builder).build();
+}
+
+ss::future<>
+kvstore::save_key_space_snapshot(key_space ks, model::offset last_offset) {
+    auto batch = key_space_batch(ks);
+    if (!batch) {
+        // every key was removed, the manifest will no longer reference it
+        _key_space_snapshots.erase(ks);
+        co_return;
+    }
+    const auto name = key_space_snapshot_name(ks, last_offset);
+    auto wr = co_await _key_space_snap.start_snapshot(name);
+    iobuf meta;
+    reflection::serialize(meta, last_offset);
+    co_await write_snapshot(
+      wr, std::move(meta), serialize_snapshot_data(std::move(*batch)));
+    co_await _key_space_snap.finish_snapshot(wr);
+    _key_space_snapshots[ks] = last_offset;
+    _probe.key_space_snapshotted();
+}
+
+/*
+ * manifest data is a size prefixed list of
+ *     INT8(key_space) INT64(offset of the key space snapshot)
+ */
+ss::future<> kvstore::save_snapshot_manifest(model::offset last_offset) {
+    iobuf body;
+    reflection::serialize(body, int32_t(_key_space_snapshots.size()));
+    for (auto& [ks, o] : _key_space_snapshots) {
+        reflection::serialize(
+          body, static_cast<std::underlying_type_t<key_space>>(ks), o);
+    }
+    iobuf data;
+    reflection::serialize(data, int32_t(body.size_bytes()));
+    data.append(std::move(body));
+
+    iobuf meta;
+    reflection::serialize(meta, last_offset, snapshot_manifest_version);
+
+    auto wr = co_await _snap.start_snapshot();
+    co_await write_snapshot(wr, std::move(meta), std::move(data));
+    vlog(lg.debug, "Finishing snapshot creation");
+    co_await _snap.finish_snapshot(wr);
+}
+
 ss::future<> kvstore::save_snapshot() {
     vassert(
       _next_offset >= model::offset(0),
@@ -316,54 +446,47 @@ ss::future<> kvstore::save_snapshot() {
 
     // no operations have been applied to the db
     if (_next_offset == model::offset(0)) {
-        return ss::now();
+        co_return;
     }
 
+    // the last log offset represented in the snapshot
+    const auto last_offset = _next_offset - model::offset(1);
     vlog(
       lg.debug,
-      "Creating snapshot at offset {}",
-      _next_offset - model::offset(1));
-
-    // package up the db into a batch
-    storage::record_batch_builder builder(
-      model::record_batch_type::kvstore, model::offset(0));
-    for (auto& entry : _db) {
-        builder.add_raw_kv(
-          bytes_to_iobuf(entry.first),
-          entry.second.share(0, entry.second.size_bytes()));
+      "Creating snapshot at offset {}, changed key spaces: {}",
+      last_offset,
+      _dirty_key_spaces.size());
+    auto m = _probe.snapshot_latency.auto_measure();
+
+    auto dirty = std::exchange(_dirty_key_spaces, {});
+    std::vector<ss::sstring> stale;
+    try {
+        for (auto ks : dirty) {
+            if (auto it = _key_space_snapshots.find(ks);
+                it != _key_space_snapshots.end() && it->second != last_offset) {
+                stale.push_back(key_space_snapshot_name(ks, it->second));
+            }
+            co_await save_key_space_snapshot(ks, last_offset);
+        }
+        co_await save_snapshot_manifest(last_offset);
+    } catch (...) {
+        // retry these key spaces on the next snapshot
+        _dirty_key_spaces.insert(dirty.begin(), dirty.end());
+        throw;
     }
-    auto batch = std::move(builder).build();
-
-    // serialize batch: size_prefix + batch
-    iobuf data;
-    auto ph = data.reserve(sizeof(int32_t));
-    reflection::serialize(data, std::move(batch));
-    auto size = ss::cpu_to_le(int32_t(data.size_bytes() - sizeof(int32_t)));
-    ph.write((const char*)&size, sizeof(size));
 
-    return _snap.start_snapshot().then(
-      [this, data = std::move(data)](snapshot_writer writer) mutable {
-          return ss::do_with(
-            std::move(writer),
-            [this, data = std::move(data)](snapshot_writer& wr) mutable {
-                // the last log offset represented in the snapshot
-                auto last_offset = _next_offset - model::offset(1);
-
-                iobuf meta;
-                reflection::serialize(meta, last_offset);
-
-                return wr.write_metadata(std::move(meta))
-                  .then([&wr, data = std::move(data)]() mutable {
-                      auto& os = wr.output(); // kept alive by do_with above
-                      return write_iobuf_to_output_stream(std::move(data), os);
-                  })
-                  .then([&wr] { return wr.close(); })
-                  .then([this, &wr]() {
-                      vlog(lg.debug, "Finishing snapshot creation");
-                      return _snap.finish_snapshot(wr);
-                  });
-            });
-      });
+    // only unreferenced once the manifest was renamed into place
+    for (auto& name : stale) {
+        try {
+            co_await _key_space_snap.remove_snapshot(name);
+        } catch (...) {
+            vlog(
+              lg.warn,
+              "Failed to remove key space snapshot {}: {}",
+              name,
+              std::current_exception());
+        }
+    }
 }
 
 ss::future<> kvstore::recover() {
@@ -373,6 +496,7 @@ ss::future<> kvstore::recover() {
          * is found, or the offset immediately following the snapshot offset.
          */
         load_snapshot_in_thread();
+        remove_stale_key_space_snapshots_in_thread();
 
         auto dir = std::filesystem::path(_ntpc.work_directory());
         auto segments = recover_segments(
@@ -387,30 +511,8 @@ ss::future<> kvstore::recover() {
     });
 }
 
-void kvstore::load_snapshot_in_thread() {
-    _gate.check(); // early out on shutdown
-
-    // open snapshot reader, if a snapshot exists
-    auto reader = _snap.open_snapshot().get0();
-    if (!reader) {
-        vlog(lg.debug, "Load snapshot: no snapshot found");
-        _next_offset = model::offset(0);
-        return;
-    }
-    auto close_reader = ss::defer([&reader] { return reader->close().get(); });
-
-    // the snapshot metadata contains the last offset represented
-    auto snap_meta = reader->read_metadata().get0();
-    iobuf_parser parser(std::move(snap_meta));
-    auto last_offset = model::offset(
-      reflection::adl<model::offset::type>{}.from(parser));
-    vlog(
-      lg.debug,
-      "Load snapshot: loading snapshot with last offset {}",
-      last_offset);
-
-    // read and restore db from snapshot
-    auto buf = read_iobuf_exactly(reader->input(), sizeof(int32_t)).get0();
+static iobuf read_snapshot_data_in_thread(ss::input_stream<char>& in) {
+    auto buf = read_iobuf_exactly(in, sizeof(int32_t)).get0();
     if (buf.size_bytes() != sizeof(int32_t)) {
         throw std::runtime_error(fmt::format(
           "Failed to read snapshot size. Wanted {} bytes != {}",
@@ -419,14 +521,17 @@ void kvstore::load_snapshot_in_thread() {
     }
     auto size = reflection::from_iobuf<int32_t>(std::move(buf));
 
-    buf = read_iobuf_exactly(reader->input(), size).get0();
+    buf = read_iobuf_exactly(in, size).get0();
     if ((int32_t)buf.size_bytes() != size) {
         throw std::runtime_error(fmt::format(
           "Failed to read snapshot data. Wanted {} bytes != {}",
           size,
           buf.size_bytes()));
     }
+    return buf;
+}
 
+static model::record_batch snapshot_batch_from(iobuf buf) {
     auto batch = reflection::from_iobuf<model::record_batch>(std::move(buf));
 
     auto batch_crc = model::crc_record_batch(batch);
@@ -442,7 +547,84 @@ void kvstore::load_snapshot_in_thread() {
           header_crc,
           batch.header().header_crc));
     }
+    return batch;
+}
+
+void kvstore::load_snapshot_in_thread() {
+    _gate.check(); // early out on shutdown
+
+    // open snapshot reader, if a snapshot exists
+    auto reader = _snap.open_snapshot().get0();
+    if (!reader) {
+        vlog(lg.debug, "Load snapshot: no snapshot found");
+        _next_offset = model::offset(0);
+        return;
+    }
+    auto close_reader = ss::defer([&reader] { return reader->close().get(); });
+
+    // the snapshot metadata contains the last offset represented
+    auto snap_meta = reader->read_metadata().get0();
+    iobuf_parser parser(std::move(snap_meta));
+    auto last_offset = model::offset(
+      reflection::adl<model::offset::type>{}.from(parser));
+    vlog(
+      lg.debug,
+      "Load snapshot: loading snapshot with last offset {}",
+      last_offset);
+
+    // a manifest of key space snapshots carries a version after the offset
+    int8_t version = 0;
+    if (parser.bytes_left() > 0) {
+        version = reflection::adl<int8_t>{}.from(parser);
+    }
+
+    auto data = read_snapshot_data_in_thread(reader->input());
+    if (version == snapshot_manifest_version) {
+        load_key_space_snapshots_in_thread(std::move(data));
+    } else {
+        restore_snapshot_batch(snapshot_batch_from(std::move(data)));
+        // a single snapshot of every key space, rewrite the key spaces
+        // individually on the next snapshot
+        for (auto& entry : _db) {
+            _dirty_key_spaces.insert(key_space_of(entry.first));
+        }
+    }
+
+    _next_offset = last_offset + model::offset(1);
+}
 
+void kvstore::load_key_space_snapshots_in_thread(iobuf manifest) {
+    iobuf_parser parser(std::move(manifest));
+    const auto count = reflection::adl<int32_t>{}.from(parser);
+    for (int32_t i = 0; i < count; ++i) {
+        const auto ks = static_cast<key_space>(
+          reflection::adl<std::underlying_type_t<key_space>>{}.from(parser));
+        const auto offset = model::offset(
+          reflection::adl<model::offset::type>{}.from(parser));
+        const auto name = key_space_snapshot_name(ks, offset);
+
+        auto reader = _key_space_snap.open_snapshot(name).get0();
+        if (!reader) {
+            throw std::runtime_error(
+              fmt::format("Key space snapshot {} not found", name));
+        }
+        auto close_reader = ss::defer(
+          [&reader] { return reader->close().get(); });
+        iobuf_parser meta(reader->read_metadata().get0());
+        const auto snap_offset = model::offset(
+          reflection::adl<model::offset::type>{}.from(meta));
+        if (snap_offset != offset) {
+            throw std::runtime_error(fmt::format(
+              "Key space snapshot {} has offset {}", name, snap_offset));
+        }
+        vlog(lg.debug, "Load snapshot: loading key space snapshot {}", name);
+        restore_snapshot_batch(snapshot_batch_from(
+          read_snapshot_data_in_thread(reader->input())));
+        _key_space_snapshots[ks] = offset;
+    }
+}
+
+void kvstore::restore_snapshot_batch(model::record_batch batch) {
     batch.for_each_record([this](model::record r) {
         auto key = iobuf_to_bytes(r.release_key());
         _probe.add_cached_bytes(key.size() + r.value().size_bytes());
@@ -455,8 +637,29 @@ void kvstore::load_snapshot_in_thread() {
           res.first->first,
           res.first->second);
     });
+}
 
-    _next_offset = last_offset + model::offset(1);
+void kvstore::remove_stale_key_space_snapshots_in_thread() {
+    _key_space_snap.remove_partial_snapshots().get();
+    absl::flat_hash_set<ss::sstring> referenced;
+    for (auto& [ks, o] : _key_space_snapshots) {
+        referenced.insert(key_space_snapshot_name(ks, o));
+    }
+    const auto dir = std::filesystem::path(_ntpc.work_directory());
+    const auto prefix = fmt::format("{}_", key_space_snapshot_prefix);
+    directory_walker::walk(
+      dir.string(),
+      [&referenced, &dir, &prefix](ss::directory_entry ent) {
+          if (
+            !ent.type || *ent.type != ss::directory_entry_type::regular
+            || !std::string_view(ent.name).starts_with(prefix)
+            || referenced.contains(ent.name)) {
+              return ss::now();
+          }
+          vlog(lg.info, "Removing stale key space snapshot {}", ent.name);
+          return ss::remove_file((dir / ent.name.c_str()).string());
+      })
+      .get();
 }
 
 void kvstore::replay_segments_in_thread(segment_set segs) {
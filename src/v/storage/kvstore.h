@@ -17,6 +17,7 @@
 #include "storage/segment_set.h"
 #include "storage/snapshot.h"
 #include "storage/types.h"
+#include "utils/hdr_hist.h"
 #include "utils/mutex.h"
 
 #include <seastar/core/abort_source.hh>
@@ -26,6 +27,7 @@
 #include <seastar/core/timer.hh>
 
 #include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 
 namespace storage {
 
@@ -60,6 +62,17 @@ namespace storage {
  * in which access to the underlying file storing the metadata was already
  * controlled.
  *
+ * Snapshots
+ * =========
+ *
+ * When a segment rolls the database is snapshotted so the segment can be
+ * removed. Each key_space is snapshotted into its own file and only the key
+ * spaces that changed since the previous snapshot are rewritten. The main
+ * `snapshot` file is a manifest naming the key space snapshot of every key
+ * space, and renaming it into place commits the new set. Key space snapshot
+ * names carry their offset, so a crash before the manifest is renamed leaves
+ * the previous set intact; unreferenced files are removed on recovery.
+ *
  * Limitations
  * ===========
  *
@@ -146,11 +159,20 @@ private:
     model::offset _next_offset;
     absl::flat_hash_map<bytes, iobuf, bytes_type_hash, bytes_type_eq> _db;
 
+    // per key space snapshots committed by the manifest and the key spaces
+    // that changed since
+    snapshot_manager _key_space_snap;
+    absl::flat_hash_map<key_space, model::offset> _key_space_snapshots;
+    absl::flat_hash_set<key_space> _dirty_key_spaces;
+
     ss::future<> put(key_space ks, bytes key, std::optional<iobuf> value);
     void apply_op(bytes key, std::optional<iobuf> value);
     ss::future<> flush_and_apply_ops();
     ss::future<> roll();
     ss::future<> save_snapshot();
+    ss::future<> save_key_space_snapshot(key_space, model::offset);
+    ss::future<> save_snapshot_manifest(model::offset);
+    std::optional<model::record_batch> key_space_batch(key_space) const;
 
     /*
      * Recovery
@@ -160,6 +182,9 @@ private:
      */
     ss::future<> recover();
     void load_snapshot_in_thread();
+    void load_key_space_snapshots_in_thread(iobuf manifest);
+    void restore_snapshot_batch(model::record_batch);
+    void remove_stale_key_space_snapshots_in_thread();
     void replay_segments_in_thread(segment_set);
 
     /**
@@ -199,12 +224,17 @@ private:
         void entry_removed() { ++entries_removed; }
         void add_cached_bytes(size_t count) { cached_bytes += count; }
         void dec_cached_bytes(size_t count) { cached_bytes -= count; }
+        void key_space_snapshotted() { ++key_spaces_snapshotted; }
 
         uint64_t segments_rolled{0};
         uint64_t entries_fetched{0};
         uint64_t entries_written{0};
         uint64_t entries_removed{0};
+        uint64_t key_spaces_snapshotted{0};
         size_t cached_bytes{0};
+        // append + flush of a group commit
+        hdr_hist flush_latency;
+        hdr_hist snapshot_latency;
 
         ss::metrics::metric_groups metrics;
     };
@@ -19,6 +19,15 @@
 #include <seastar/core/rwlock.hh>
 
 namespace storage {
+/**
+ * Leases the segments of an offset range to a reader.
+ *
+ * Only the segment being read is read locked: the range is locked with its
+ * first segment and the reader moves the lock to the next segment as it
+ * reaches it. Compaction swaps and truncations of the other segments of the
+ * range don't wait for the reader, which reads every segment in the state it
+ * has when it gets to it.
+ */
 class lock_manager {
 public:
     explicit lock_manager(segment_set& s) noexcept
@@ -33,6 +42,7 @@ public:
         lease& operator=(const lease&) = delete;
 
         segment_set range;
+        /// lock of the segment of the range being read
         std::vector<ss::rwlock::holder> locks;
 
         friend std::ostream& operator<<(std::ostream&, const lease&);
@@ -66,6 +66,9 @@ public:
         virtual ss::future<std::optional<timequery_result>>
           timequery(timequery_config) = 0;
 
+        virtual ss::future<std::optional<key_query_result>>
+          key_query(key_query_config) = 0;
+
         const ntp_config& config() const { return _config; }
 
         virtual size_t segment_count() const = 0;
@@ -81,11 +84,17 @@ public:
         }
 
         virtual size_t size_bytes() const = 0;
+        /// total bytes appended since the log was opened
+        virtual uint64_t bytes_written() const = 0;
         virtual ss::future<>
           update_configuration(ntp_config::default_overrides) = 0;
 
         virtual int64_t compaction_backlog() const = 0;
 
+        // verifies the batches of immutable segments in the background
+        virtual ss::future<> scrub(ss::io_priority_class, ss::abort_source&)
+          = 0;
+
     private:
         ntp_config _config;
 
@@ -151,6 +160,18 @@ public:
         return _impl->timequery(cfg);
     }
 
+    /**
+     * \brief Latest record with the key among the data batches up to
+     * `max_offset` of a compacted log
+     *
+     * Segments that finished self compaction are looked up in their sorted
+     * key index, see key_index.h, the others are scanned.
+     */
+    ss::future<std::optional<key_query_result>>
+    key_query(key_query_config cfg) {
+        return _impl->key_query(std::move(cfg));
+    }
+
     ss::future<> compact(compaction_config cfg) { return _impl->compact(cfg); }
 
     /**
@@ -181,10 +202,21 @@ public:
 
     int64_t compaction_backlog() const { return _impl->compaction_backlog(); }
 
+    /**
+     * \brief Verifies the crc of every batch of the segments that no longer
+     * have an appender and were not verified yet. Reads of verified segments
+     * skip the per batch header crc check.
+     */
+    ss::future<> scrub(ss::io_priority_class iopc, ss::abort_source& as) {
+        return _impl->scrub(iopc, as);
+    }
+
     std::ostream& print(std::ostream& o) const { return _impl->print(o); }
 
     size_t size_bytes() const { return _impl->size_bytes(); }
 
+    uint64_t bytes_written() const { return _impl->bytes_written(); }
+
     impl* get_impl() const { return _impl.get(); }
 
 private:
@@ -12,11 +12,16 @@
 #include "config/configuration.h"
 #include "likely.h"
 #include "model/fundamental.h"
+#include "model/record_batch_reader.h"
+#include "model/timeout_clock.h"
 #include "model/timestamp.h"
+#include "reflection/adl.h"
 #include "resource_mgmt/io_priority.h"
+#include "resource_mgmt/memory_groups.h"
 #include "storage/batch_cache.h"
 #include "storage/compacted_index_writer.h"
 #include "storage/fs_utils.h"
+#include "storage/header_sidecar.h"
 #include "storage/kvstore.h"
 #include "storage/log.h"
 #include "storage/logger.h"
@@ -31,10 +36,12 @@
 #include "vlog.h"
 
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/file.hh>
 #include <seastar/core/future-util.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/core/print.hh>
 #include <seastar/core/seastar.hh>
 #include <seastar/core/shared_ptr.hh>
@@ -43,7 +50,9 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <exception>
 #include <filesystem>
 #include <optional>
@@ -55,35 +64,216 @@ log_manager::log_manager(log_config config, kvstore& kvstore) noexcept
   : _config(std::move(config))
   , _kvstore(kvstore)
   , _jitter(_config.compaction_interval)
-  , _batch_cache(config.reclaim_opts) {
+  , _batch_cache(config.reclaim_opts)
+  , _cache_memory_controller(_batch_cache, internal::chunks())
+  , _recovery_sem(std::max<size_t>(
+      config::shard_local_cfg().storage_recovery_concurrency(), 1))
+  , _removal_sem(std::max<size_t>(
+      config::shard_local_cfg().storage_removal_concurrency(), 1)) {
     _compaction_timer.set_callback([this] { trigger_housekeeping(); });
-    _compaction_timer.rearm(_jitter());
+    _housekeeping_round_end = _jitter();
+    _compaction_timer.rearm(ss::lowres_clock::now() + housekeeping_tick());
+    _scrub_timer.set_callback([this] { trigger_scrub(); });
+    arm_scrub();
+    if (
+      _config.stype == log_config::storage_type::disk
+      && config::shard_local_cfg().storage_shared_wal()) {
+        _wal = std::make_unique<shard_wal>(
+          _config.base_dir, _config.sanitize_fileops);
+        _wal_drain_timer.set_callback([this] { trigger_wal_drain(); });
+    }
+    if (config::shard_local_cfg().enable_adaptive_cache_sizing()) {
+        _cache_memory_controller.start();
+    }
+    auto& groups = local_memory_groups();
+    groups.set_usage(memory_group::batch_cache, [this] {
+        return memory_group_accounting::usage{
+          .used = _batch_cache.size_bytes()};
+    });
+    groups.set_usage(memory_group::chunk_cache, [] {
+        const auto& chunks = internal::chunks();
+        return memory_group_accounting::usage{
+          .used = chunks.size_total(),
+          .soft_limit = chunks.size_target(),
+          .hard_limit = chunks.size_limit()};
+    });
+    groups.set_usage(memory_group::segment_index, [] {
+        return memory_group_accounting::usage{
+          .used = segment_index::hydrated_memory_usage(),
+          .soft_limit = memory_groups::segment_index_max_memory()};
+    });
 }
 void log_manager::trigger_housekeeping() {
     (void)ss::with_gate(_open_gate, [this] {
-        auto next_housekeeping = _jitter();
-        return housekeeping().finally([this, next_housekeeping] {
+        return housekeeping().finally([this] {
             // all of these *MUST* be in the finally
             if (_open_gate.is_closed()) {
                 return;
             }
 
-            _compaction_timer.rearm(next_housekeeping);
+            _compaction_timer.rearm(
+              ss::lowres_clock::now() + housekeeping_tick());
         });
     }).handle_exception([](std::exception_ptr e) {
         vlog(stlog.info, "Error processing housekeeping(): {}", e);
     });
 }
 
+ss::lowres_clock::duration log_manager::housekeeping_tick() const {
+    return std::clamp<ss::lowres_clock::duration>(
+      _config.compaction_interval,
+      std::chrono::milliseconds(10),
+      std::chrono::seconds(1));
+}
+
+size_t log_manager::housekeeping_concurrency() const {
+    auto max = std::max<size_t>(
+      config::shard_local_cfg().storage_housekeeping_max_concurrency(), 1);
+    return 1
+           + static_cast<size_t>(
+             std::round(_housekeeping_pressure * static_cast<double>(max - 1)));
+}
+
+ss::future<> log_manager::start() {
+    if (!_wal) {
+        co_return;
+    }
+    co_await _wal->start();
+    arm_wal_drain();
+}
+
+void log_manager::arm_wal_drain() {
+    if (_open_gate.is_closed()) {
+        return;
+    }
+    _wal_drain_timer.rearm(
+      ss::lowres_clock::now()
+      + config::shard_local_cfg().storage_shared_wal_drain_interval_ms());
+}
+
+void log_manager::trigger_wal_drain() {
+    (void)ss::with_gate(_open_gate, [this] {
+        return _wal
+          ->drain([this](absl::flat_hash_set<model::ntp> ntps) {
+              return flush_wal_logs(std::move(ntps));
+          })
+          .finally([this] { arm_wal_drain(); });
+    }).handle_exception([](std::exception_ptr e) {
+        vlog(stlog.info, "Error draining the shared wal: {}", e);
+    });
+}
+
+ss::future<>
+log_manager::flush_wal_logs(absl::flat_hash_set<model::ntp> ntps) {
+    static constexpr size_t max_concurrent_flushes = 64;
+    co_await ss::max_concurrent_for_each(
+      ntps, max_concurrent_flushes, [this](const model::ntp& ntp) {
+          // the log may have been closed, and flushed, since it appended
+          auto it = _logs.find(ntp);
+          if (it == _logs.end()) {
+              return ss::now();
+          }
+          auto l = it->second.handle;
+          return l.flush().finally([l] {});
+      });
+}
+
+ss::future<log> log_manager::replay_shared_wal(log l) {
+    auto batches = _wal->take_recovered(l.config().ntp());
+    auto next = std::max(
+      l.offsets().dirty_offset + model::offset(1), model::offset(0));
+    // only the contiguous appends following the end of the log are missing,
+    // those before were flushed to the segments
+    model::record_batch_reader::data_t missing;
+    for (auto& b : batches) {
+        if (b.last_offset() < next) {
+            continue;
+        }
+        if (b.base_offset() != next) {
+            break;
+        }
+        next = b.last_offset() + model::offset(1);
+        missing.push_back(std::move(b));
+    }
+    if (missing.empty()) {
+        co_return l;
+    }
+    vlog(
+      stlog.info,
+      "Replaying {} batches of {} from the shared wal, offsets [{}, {}]",
+      missing.size(),
+      l.config().ntp(),
+      missing.front().base_offset(),
+      missing.back().last_offset());
+    auto appender = l.make_appender(log_append_config{
+      .should_fsync = log_append_config::fsync::yes,
+      .io_priority = ss::default_priority_class(),
+      .timeout = model::no_timeout});
+    co_await model::make_memory_record_batch_reader(std::move(missing))
+      .for_each_ref(std::move(appender), model::no_timeout);
+    co_return l;
+}
+
+void log_manager::arm_scrub() {
+    if (_open_gate.is_closed()) {
+        return;
+    }
+    if (auto ival = config::shard_local_cfg().storage_scrub_interval_ms()) {
+        _scrub_timer.rearm(ss::lowres_clock::now() + *ival);
+    }
+}
+
+void log_manager::trigger_scrub() {
+    (void)ss::with_gate(_open_gate, [this] {
+        return scrub().finally([this] { arm_scrub(); });
+    }).handle_exception([](std::exception_ptr e) {
+        vlog(stlog.info, "Error processing scrub(): {}", e);
+    });
+}
+
+ss::future<> log_manager::scrub() {
+    std::vector<log> logs;
+    logs.reserve(_logs.size());
+    for (auto& [_, meta] : _logs) {
+        logs.push_back(meta.handle);
+    }
+    return ss::do_with(std::move(logs), [this](std::vector<log>& logs) {
+        return ss::do_for_each(logs, [this](log& l) {
+            if (_abort_source.abort_requested()) {
+                return ss::now();
+            }
+            return ss::with_scheduling_group(
+                     _config.compaction_sg,
+                     [this, l]() mutable {
+                         return l.scrub(scrubber_priority(), _abort_source);
+                     })
+              .handle_exception([l](const std::exception_ptr& e) {
+                  // e.g. the log was closed while it was being scrubbed
+                  vlog(stlog.debug, "Error scrubbing {}: {}", l, e);
+              });
+        });
+    });
+}
+
 ss::future<> log_manager::stop() {
     _compaction_timer.cancel();
+    _scrub_timer.cancel();
+    _wal_drain_timer.cancel();
+    _cache_memory_controller.stop();
+    auto& groups = local_memory_groups();
+    groups.clear_usage(memory_group::batch_cache);
+    groups.clear_usage(memory_group::chunk_cache);
+    groups.clear_usage(memory_group::segment_index);
     _abort_source.request_abort();
+    _recovery_sem.broken();
     return _open_gate.close()
       .then([this] {
           return ss::parallel_for_each(_logs, [](logs_type::value_type& entry) {
               return entry.second.handle.close();
           });
       })
+      // the closed logs flushed their segments
+      .then([this] { return _wal ? _wal->stop() : ss::now(); })
       .then([this] { return _batch_cache.stop(); });
 }
 
@@ -95,53 +285,98 @@ static inline logs_type::iterator find_next_non_compacted_log(logs_type& logs) {
       });
 }
 
+std::vector<model::ntp> log_manager::next_housekeeping_batch() {
+    using bflags = log_housekeeping_meta::bitflags;
+    auto now = ss::lowres_clock::now();
+    if (find_next_non_compacted_log(_logs) == _logs.end()) {
+        // every log was visited in this round; start the next one once its
+        // interval elapsed
+        if (now < _housekeeping_round_end) {
+            return {};
+        }
+        for (auto& h : _logs) {
+            h.second.flags &= ~bflags::compacted;
+        }
+        _housekeeping_round_end = _jitter();
+    }
+    size_t pending = std::count_if(
+      _logs.begin(), _logs.end(), [](const logs_type::value_type& l) {
+          return bflags::none == (l.second.flags & bflags::compacted);
+      });
+    // spread the logs that are still pending over the ticks left in the
+    // round. logs created mid round are picked up by the remaining ticks
+    size_t ticks_left = 1;
+    if (_housekeeping_round_end > now) {
+        ticks_left = std::max<size_t>(
+          (_housekeeping_round_end - now) / housekeeping_tick(), 1);
+    }
+    size_t quota = (pending + ticks_left - 1) / ticks_left;
+
+    std::vector<model::ntp> batch;
+    batch.reserve(quota);
+    for (auto& [ntp, meta] : _logs) {
+        if (batch.size() == quota) {
+            break;
+        }
+        if (bflags::none != (meta.flags & bflags::compacted)) {
+            continue;
+        }
+        meta.flags |= bflags::compacted;
+        meta.last_compaction = now;
+        batch.push_back(ntp);
+    }
+    return batch;
+}
+
 ss::future<> log_manager::housekeeping() {
     auto collection_threshold = model::timestamp(
       model::timestamp::now().value() - _config.delete_retention.count());
     /**
-     * Note that this loop does a double find - which is not fast. This solution
-     * is the tradeoff to *not* lock the segment during log_manager::remove(ntp)
-     * and to *not* use an ordered container.
+     * The batch holds ntps rather than iterators or handles: a concurrent
+     * log_manager::remove() invalidates all the iterators of the
+     * absl::flat_hash_map, and a removed log must not be compacted. Each log
+     * is therefore looked up again right before it is processed.
      *
-     * The issue with keeping an iterator and effectively doing a iterator++
-     * is that during a concurrent log_manager::remove() we invalidate all the
-     * iterators for the absl::flat_hash_map; - an alternative here would be to
-     * use a lock
-     *
-     * Note that we also do not use an ordered container like an absl::tree-set
-     * because finds are frequent on this datastructure and we want to serve
-     * them as fast as we can since the majority of the time they will be in the
-     * hotpath / (request-response)
+     * The number of logs processed concurrently follows the compaction
+     * controller output: a single log at a time while the compaction backlog
+     * is under its setpoint, up to storage_housekeeping_max_concurrency when
+     * the controller saturates.
      */
-    using bflags = log_housekeeping_meta::bitflags;
-    return ss::do_until(
-             [this] {
-                 auto it = find_next_non_compacted_log(_logs);
-                 return it == _logs.end();
-             },
-             [this, collection_threshold] {
-                 return ss::with_scheduling_group(
-                   _config.compaction_sg, [this, collection_threshold] {
-                       auto it = find_next_non_compacted_log(_logs);
-                       if (it == _logs.end()) {
-                           // must check again because between the stop
-                           // condition and this continuation we might have
-                           // removed the log
-                           return ss::now();
-                       }
-                       it->second.flags |= bflags::compacted;
-                       it->second.last_compaction = ss::lowres_clock::now();
-                       return it->second.handle.compact(compaction_config(
-                         collection_threshold,
-                         _config.retention_bytes,
-                         _config.compaction_priority,
-                         _abort_source));
-                   });
-             })
-      .finally([this] {
-          for (auto& h : _logs) {
-              h.second.flags &= ~bflags::compacted;
-          }
+    auto batch = next_housekeeping_batch();
+    if (batch.empty()) {
+        return ss::now();
+    }
+    return ss::do_with(
+      std::move(batch),
+      [this, collection_threshold](std::vector<model::ntp>& batch) {
+          return ss::max_concurrent_for_each(
+            batch,
+            housekeeping_concurrency(),
+            [this, collection_threshold](const model::ntp& ntp) {
+                return ss::with_scheduling_group(
+                  _config.compaction_sg, [this, &ntp, collection_threshold] {
+                      auto it = _logs.find(ntp);
+                      if (it == _logs.end() || _abort_source.abort_requested()) {
+                          // removed while waiting for its turn
+                          return ss::now();
+                      }
+                      auto handle = it->second.handle;
+                      return handle
+                        .compact(compaction_config(
+                          collection_threshold,
+                          _config.retention_bytes,
+                          _config.compaction_priority,
+                          _abort_source))
+                        .handle_exception(
+                          [handle](const std::exception_ptr& e) {
+                              vlog(
+                                stlog.info,
+                                "Error housekeeping {}: {}",
+                                handle,
+                                e);
+                          });
+                  });
+            });
       });
 }
 ss::future<ss::lw_shared_ptr<segment>> log_manager::make_log_segment(
@@ -154,26 +389,57 @@ ss::future<ss::lw_shared_ptr<segment>> log_manager::make_log_segment(
     return ss::with_gate(
       _open_gate, [this, &ntp, base_offset, term, pc, version, buf_size] {
           return make_segment(
-            ntp,
-            base_offset,
-            term,
-            pc,
-            version,
-            buf_size,
-            _config.sanitize_fileops,
-            create_cache(ntp.cache_enabled()));
+                   ntp,
+                   base_offset,
+                   term,
+                   pc,
+                   version,
+                   buf_size,
+                   _config.sanitize_fileops,
+                   create_cache(ntp.cache_enabled(), ntp.cache_admission()))
+            .then([this, &ntp, pc](ss::lw_shared_ptr<segment> seg) {
+                return maybe_add_header_sidecar(ntp, pc, std::move(seg));
+            });
       });
 }
 
+ss::future<ss::lw_shared_ptr<segment>> log_manager::maybe_add_header_sidecar(
+  const ntp_config& ntp,
+  ss::io_priority_class pc,
+  ss::lw_shared_ptr<segment> seg) {
+    // compaction rewrites the data files, the sidecars would go stale
+    if (
+      !config::shard_local_cfg().segment_header_sidecar()
+      || ntp.is_compacted()) {
+        co_return seg;
+    }
+    try {
+        auto sidecar = co_await internal::make_header_sidecar_appender(
+          std::filesystem::path(seg->reader().filename().c_str()),
+          _config.sanitize_fileops,
+          pc);
+        seg->set_header_sidecar(std::move(sidecar));
+    } catch (...) {
+        // header scans read the data file instead
+        vlog(
+          stlog.warn,
+          "Could not create the header sidecar of {}: {}",
+          seg->reader().filename(),
+          std::current_exception());
+    }
+    co_return seg;
+}
+
 std::optional<batch_cache_index>
-log_manager::create_cache(with_cache ntp_cache_enabled) {
+log_manager::create_cache(
+  with_cache ntp_cache_enabled, batch_cache_admission admission) {
     if (unlikely(
           _config.cache == with_cache::no
           || ntp_cache_enabled == with_cache::no)) {
         return std::nullopt;
     }
 
-    return batch_cache_index(_batch_cache);
+    return batch_cache_index(_batch_cache, admission);
 }
 
 ss::future<log> log_manager::manage(ntp_config cfg) {
@@ -184,15 +450,48 @@ ss::future<log> log_manager::manage(ntp_config cfg) {
 
 ss::future<> log_manager::recover_log_state(const ntp_config& cfg) {
     return ss::file_exists(cfg.work_directory())
-      .then(
-        [this, key = internal::start_offset_key(cfg.ntp())](bool dir_exists) {
-            if (dir_exists) {
-                return ss::now();
-            }
-            // directory was deleted, make sure we do not have any state in KV
-            // store.
-            return _kvstore.remove(kvstore::key_space::storage, key);
-        });
+      .then([this, ntp = cfg.ntp()](bool dir_exists) {
+          if (dir_exists) {
+              return ss::now();
+          }
+          // directory was deleted, make sure we do not have any state in KV
+          // store.
+          return _kvstore
+            .remove(
+              kvstore::key_space::storage, internal::start_offset_key(ntp))
+            .then([this, ntp] {
+                return _kvstore.remove(
+                  kvstore::key_space::storage,
+                  internal::clean_shutdown_key(ntp));
+            });
+      });
+}
+
+ss::future<std::optional<clean_shutdown_record>>
+log_manager::take_clean_shutdown_record(const model::ntp& ntp) {
+    auto key = internal::clean_shutdown_key(ntp);
+    auto value = _kvstore.get(kvstore::key_space::storage, key);
+    if (!value) {
+        return ss::make_ready_future<std::optional<clean_shutdown_record>>(
+          std::nullopt);
+    }
+    std::optional<clean_shutdown_record> record;
+    try {
+        record = reflection::from_iobuf<clean_shutdown_record>(
+          std::move(*value));
+    } catch (...) {
+        vlog(
+          stlog.info,
+          "Ignoring invalid clean shutdown record of {}: {}",
+          ntp,
+          std::current_exception());
+    }
+    // the record only describes the log as it was closed, it must not be
+    // trusted again once the log is written to
+    return _kvstore.remove(kvstore::key_space::storage, std::move(key))
+      .then([record = std::move(record)]() mutable {
+          return std::move(record);
+      });
 }
 
 ss::future<log> log_manager::do_manage(ntp_config cfg) {
@@ -201,10 +500,20 @@ ss::future<log> log_manager::do_manage(ntp_config cfg) {
           "log_manager:: cannot have empty config.base_dir"));
     }
 
+    // the files of a previous incarnation of the log are still being removed
+    if (auto it = _removals.find(cfg.ntp()); it != _removals.end()) {
+        return it->second->get_shared_future().then(
+          [this, cfg = std::move(cfg)]() mutable {
+              return do_manage(std::move(cfg));
+          });
+    }
+
     vassert(
       _logs.find(cfg.ntp()) == _logs.end(), "cannot double register same ntp");
 
-    if (_config.stype == log_config::storage_type::memory) {
+    if (
+      _config.stype == log_config::storage_type::memory
+      || cfg.is_in_memory()) {
         auto path = cfg.work_directory();
         auto l = storage::make_memory_backed_log(std::move(cfg));
         _logs.emplace(l.config().ntp(), l);
@@ -212,26 +521,72 @@ ss::future<log> log_manager::do_manage(ntp_config cfg) {
         return ss::recursive_touch_directory(path).then([l] { return l; });
     }
 
-    return recover_log_state(cfg).then([this, cfg = std::move(cfg)]() mutable {
-        ss::sstring path = cfg.work_directory();
-        with_cache cache_enabled = cfg.cache_enabled();
-        return recover_segments(
-                 std::filesystem::path(path),
-                 _config.sanitize_fileops,
-                 cfg.is_compacted(),
-                 [this, cache_enabled] { return create_cache(cache_enabled); },
-                 _abort_source)
-          .then([this, cfg = std::move(cfg)](segment_set segments) mutable {
+    return ss::do_with(std::move(cfg), [this](ntp_config& cfg) {
+        return ss::with_semaphore(
+                 _recovery_sem, 1, [this, &cfg] { return recover_log(cfg); })
+          .then([this, &cfg](segment_set segments) {
               auto l = storage::make_disk_backed_log(
                 std::move(cfg), *this, std::move(segments), _kvstore);
               auto [_, success] = _logs.emplace(l.config().ntp(), l);
               vassert(
                 success, "Could not keep track of:{} - concurrency issue", l);
               return l;
+          })
+          .then([this](log l) {
+              if (_wal) {
+                  return replay_shared_wal(std::move(l));
+              }
+              return ss::make_ready_future<log>(std::move(l));
           });
     });
 }
 
+ss::future<segment_set> log_manager::recover_log(const ntp_config& cfg) {
+    if (_recoveries_in_flight++ == 0) {
+        _recovery_start = std::chrono::steady_clock::now();
+    }
+    auto timings = ss::make_lw_shared<recovery_timings>();
+    return recover_log_state(cfg)
+      .then([this, &cfg] { return take_clean_shutdown_record(cfg.ntp()); })
+      .then([this, &cfg, timings](
+              std::optional<clean_shutdown_record> clean_shutdown) mutable {
+          with_cache cache_enabled = cfg.cache_enabled();
+          auto cache_admission = cfg.cache_admission();
+          return recover_segments(
+            std::filesystem::path(cfg.work_directory()),
+            _config.sanitize_fileops,
+            cfg.is_compacted(),
+            [this, cache_enabled, cache_admission] {
+                return create_cache(cache_enabled, cache_admission);
+            },
+            _abort_source,
+            config::shard_local_cfg().storage_recovery_segment_concurrency(),
+            timings.get(),
+            std::move(clean_shutdown));
+      })
+      .then([this, &cfg, timings](segment_set segments) {
+          vlog(stlog.debug, "Recovered {} in {}", cfg.ntp(), *timings);
+          _recovery_timings += *timings;
+          ++_logs_recovered;
+          return segments;
+      })
+      .finally([this] {
+          if (--_recoveries_in_flight > 0) {
+              return;
+          }
+          auto elapsed = std::chrono::steady_clock::now() - _recovery_start;
+          vlog(
+            stlog.info,
+            "Recovered {} logs in {}ms, cumulative phase timings: {}",
+            _logs_recovered,
+            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed)
+              .count(),
+            _recovery_timings);
+          _logs_recovered = 0;
+          _recovery_timings = {};
+      });
+}
+
 ss::future<> log_manager::shutdown(model::ntp ntp) {
     vlog(stlog.debug, "Asked to shutdown: {}", ntp);
     return ss::with_gate(_open_gate, [this, ntp = std::move(ntp)] {
@@ -254,24 +609,44 @@ ss::future<> log_manager::remove(model::ntp ntp) {
         // 'ss::shared_ptr<>' make a copy
         storage::log lg = handle.mapped().handle;
         vlog(stlog.info, "Removing: {}", lg);
-        // NOTE: it is ok to *not* externally synchronize the log here
-        // because remove, takes a write lock on each individual segments
-        // waiting for all of them to be closed before actually removing the
-        // underlying log. If there is a background operation like
-        // compaction or so, it will block correctly.
-        auto ntp_dir = lg.config().work_directory();
-        ss::sstring topic_dir = lg.config().topic_directory().string();
-        return lg.remove()
-          .then([dir = std::move(ntp_dir)] { return ss::remove_file(dir); })
-          .then([this, dir = std::move(topic_dir)]() mutable {
-              // We always dispatch topic directory deletion to core 0 as
-              // requests may come from different cores
-              return dispatch_topic_dir_deletion(std::move(dir));
+        auto removal = ss::make_lw_shared<ss::shared_promise<>>();
+        _removals.emplace(ntp, removal);
+        // stop() waits for the background removals through the gate
+        (void)ss::with_gate(_open_gate, [this, lg] {
+            return ss::with_semaphore(
+              _removal_sem, 1, [this, lg] { return remove_files(lg); });
+        })
+          .handle_exception([ntp](std::exception_ptr e) {
+              vlog(stlog.warn, "Error removing {}: {}", ntp, e);
           })
-          .finally([lg] {});
+          .finally([this, ntp, removal] {
+              _removals.erase(ntp);
+              removal->set_value();
+          });
+        return ss::now();
     });
 }
 
+ss::future<> log_manager::remove_files(log lg) {
+    // NOTE: it is ok to *not* externally synchronize the log here
+    // because remove, takes a write lock on each individual segments
+    // waiting for all of them to be closed before actually removing the
+    // underlying log. If there is a background operation like
+    // compaction or so, it will block correctly.
+    auto ntp_dir = lg.config().work_directory();
+    ss::sstring topic_dir = lg.config().topic_directory().string();
+    if (_wal) {
+        // a log managed again under the same ntp must not replay its appends
+        co_await _wal->truncate(lg.config().ntp(), model::offset::min());
+    }
+    co_await lg.remove();
+    co_await ss::remove_file(ntp_dir);
+    // We always dispatch topic directory deletion to core 0 as
+    // requests may come from different cores
+    co_await dispatch_topic_dir_deletion(std::move(topic_dir));
+    vlog(stlog.info, "Removed: {}", lg.config().ntp());
+}
+
 ss::future<> log_manager::dispatch_topic_dir_deletion(ss::sstring dir) {
     return ss::smp::submit_to(0, [dir = std::move(dir)]() mutable {
         static thread_local mutex fs_lock;
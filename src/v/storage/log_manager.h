@@ -15,10 +15,15 @@
 #include "random/simple_time_jitter.h"
 #include "seastarx.h"
 #include "storage/batch_cache.h"
+#include "storage/cache_memory_controller.h"
+#include "storage/flush_coordinator.h"
 #include "storage/log.h"
 #include "storage/log_housekeeping_meta.h"
 #include "storage/ntp_config.h"
+#include "storage/probe.h"
 #include "storage/segment.h"
+#include "storage/segment_set.h"
+#include "storage/shard_wal.h"
 #include "storage/types.h"
 #include "storage/version.h"
 #include "units.h"
@@ -30,14 +35,18 @@
 #include <seastar/core/gate.hh>
 #include <seastar/core/lowres_clock.hh>
 #include <seastar/core/scheduling.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/sstring.hh>
 
 #include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <optional>
+#include <vector>
 
 namespace storage {
 
@@ -172,6 +181,10 @@ class log_manager {
 public:
     explicit log_manager(log_config, kvstore& kvstore) noexcept;
 
+    /// recovers the shared write-ahead log when storage_shared_wal is set,
+    /// logs must only be managed once it completed
+    ss::future<> start();
+
     ss::future<log> manage(ntp_config);
 
     ss::future<> shutdown(model::ntp);
@@ -179,6 +192,12 @@ public:
     /**
      * Remove an ntp and clean-up its storage.
      *
+     * The log stops being managed right away, its segments are closed and
+     * its files deleted in the background by at most
+     * `storage_removal_concurrency` removals at a time, so that deleting a
+     * large topic does not hold up the caller. Managing the same ntp again
+     * waits for its pending removal to finish.
+     *
      * NOTE: if removal of an ntp causes the parent topic directory to become
      * empty then it is also removed. Currently topic deletion is the only
      * action that drives partition removal, so this makes sense. This must be
@@ -189,6 +208,18 @@ public:
 
     ss::future<> stop();
 
+    /// registers shard-wide storage metrics, e.g. the batch cache
+    void setup_metrics() {
+        _batch_cache.setup_metrics();
+        _cache_memory_controller.setup_metrics();
+        internal::flushes().setup_metrics();
+        _disk_usage.setup_metrics();
+    }
+
+    /// bytes on disk of the logs managed by the shard, without walking them
+    uint64_t disk_usage() const { return _disk_usage.bytes(); }
+    disk_usage_probe& shard_disk_usage() { return _disk_usage; }
+
     ss::future<ss::lw_shared_ptr<segment>> make_log_segment(
       const ntp_config&,
       model::offset,
@@ -199,6 +230,10 @@ public:
 
     const log_config& config() const { return _config; }
 
+    /// write-ahead log shared by the small partitions of the shard, null
+    /// unless storage_shared_wal is set
+    shard_wal* shared_wal() { return _wal.get(); }
+
     /// Returns the number of managed logs.
     size_t size() const { return _logs.size(); }
 
@@ -215,33 +250,90 @@ public:
 
     int64_t compaction_backlog() const;
 
+    /// \brief normalized compaction controller output in [0, 1]; scales the
+    /// number of logs housekept concurrently per tick
+    void set_housekeeping_pressure(double p) {
+        _housekeeping_pressure = std::clamp(p, 0.0, 1.0);
+    }
+
 private:
     using logs_type = absl::flat_hash_map<model::ntp, log_housekeeping_meta>;
 
     ss::future<log> do_manage(ntp_config);
+    ss::future<segment_set> recover_log(const ntp_config&);
+    ss::future<ss::lw_shared_ptr<segment>> maybe_add_header_sidecar(
+      const ntp_config&, ss::io_priority_class, ss::lw_shared_ptr<segment>);
 
     /**
      * \brief delete old segments and trigger compacted segments
-     *        runs inside a seastar thread
+     *
+     * Every log is housekept once per (jittered) compaction interval. Rather
+     * than visiting all logs back to back, each tick processes a share of
+     * the logs not yet visited in the current round so the work is spread
+     * evenly over the interval.
      */
     void trigger_housekeeping();
-    void arm_housekeeping();
     ss::future<> housekeeping();
+    std::vector<model::ntp> next_housekeeping_batch();
+    ss::lowres_clock::duration housekeeping_tick() const;
+    size_t housekeeping_concurrency() const;
+
+    /// \brief verifies the closed segments of every log, see log::scrub
+    void trigger_scrub();
+    void arm_scrub();
+    ss::future<> scrub();
 
-    std::optional<batch_cache_index> create_cache(with_cache);
+    /// \brief flushes the segments of the partitions in the shared wal so
+    /// that it can remove its older segments, see shard_wal::drain
+    void trigger_wal_drain();
+    void arm_wal_drain();
+    ss::future<> flush_wal_logs(absl::flat_hash_set<model::ntp>);
+    /// appends those of the appends found in the shared wal on startup
+    /// that are missing from the segments of the log
+    ss::future<log> replay_shared_wal(log);
 
+    std::optional<batch_cache_index>
+      create_cache(with_cache, batch_cache_admission);
+
+    ss::future<> remove_files(log);
     ss::future<> dispatch_topic_dir_deletion(ss::sstring dir);
     ss::future<> recover_log_state(const ntp_config&);
+    ss::future<std::optional<clean_shutdown_record>>
+    take_clean_shutdown_record(const model::ntp&);
 
     log_config _config;
     kvstore& _kvstore;
     simple_time_jitter<ss::lowres_clock> _jitter;
     ss::timer<ss::lowres_clock> _compaction_timer;
+    ss::lowres_clock::time_point _housekeeping_round_end;
+    double _housekeeping_pressure{0};
+    ss::timer<ss::lowres_clock> _scrub_timer;
+    std::unique_ptr<shard_wal> _wal;
+    ss::timer<ss::lowres_clock> _wal_drain_timer;
+    // outlives the logs, they account their size into it until closed
+    disk_usage_probe _disk_usage;
     logs_type _logs;
     batch_cache _batch_cache;
+    cache_memory_controller _cache_memory_controller;
     ss::gate _open_gate;
     ss::abort_source _abort_source;
 
+    // bounds the number of logs recovered concurrently. recoveries started
+    // together at startup are accounted into _recovery_timings, which is
+    // reported and reset once the last in-flight recovery completes.
+    ss::semaphore _recovery_sem;
+    size_t _recoveries_in_flight{0};
+    size_t _logs_recovered{0};
+    recovery_timings _recovery_timings;
+    std::chrono::steady_clock::time_point _recovery_start;
+
+    // bounds the number of logs whose files are removed concurrently, the
+    // removals in progress are tracked so that an ntp is not managed again
+    // before its old files are gone.
+    ss::semaphore _removal_sem;
+    absl::flat_hash_map<model::ntp, ss::lw_shared_ptr<ss::shared_promise<>>>
+      _removals;
+
     friend std::ostream& operator<<(std::ostream&, const log_manager&);
 };
 std::ostream& operator<<(std::ostream& o, log_config::storage_type t);
@@ -10,6 +10,7 @@
 #include "storage/log_reader.h"
 
 #include "bytes/iobuf.h"
+#include "config/configuration.h"
 #include "model/record.h"
 #include "storage/logger.h"
 #include "vassert.h"
@@ -17,6 +18,7 @@
 
 #include <seastar/core/abort_source.hh>
 #include <seastar/core/circular_buffer.hh>
+#include <seastar/core/coroutine.hh>
 
 #include <fmt/ostream.h>
 
@@ -123,18 +125,27 @@ void skipping_consumer::print(std::ostream& os) const {
 }
 
 log_segment_batch_reader::log_segment_batch_reader(
-  segment& seg, log_reader_config& config, probe& p) noexcept
+  segment& seg,
+  log_reader_config& config,
+  const read_ahead_policy& read_ahead,
+  probe& p) noexcept
   : _seg(seg)
   , _config(config)
+  , _read_ahead(read_ahead)
   , _probe(p) {}
 
 std::unique_ptr<continuous_batch_parser> log_segment_batch_reader::initialize(
   model::timeout_clock::time_point timeout,
   std::optional<model::offset> next_cached_batch) {
-    auto input = _seg.offset_data_stream(_config.start_offset, _config.prio);
+    auto input = _seg.offset_data_stream(
+      _config.start_offset, _config.prio, _read_ahead.size());
+    // only immutable segments stay verified
+    auto verify = continuous_batch_parser::verify_header_crc(
+      !_seg.is_verified() || _seg.has_appender());
     return std::make_unique<continuous_batch_parser>(
       std::make_unique<skipping_consumer>(*this, timeout, next_cached_batch),
-      std::move(input));
+      std::move(input),
+      verify);
 }
 
 ss::future<> log_segment_batch_reader::close() {
@@ -153,7 +164,9 @@ void log_segment_batch_reader::add_one(model::record_batch&& batch) {
     _state.buffer_size += size_bytes;
     _probe.add_bytes_read(size_bytes);
     if (!_config.skip_batch_cache) {
-        _seg.cache_put(b);
+        // a reader working through a closed segment is behind the tail of
+        // the log; those batches are admitted on probation
+        _seg.cache_put(b, admit_on_probation(!_seg.has_appender()));
     }
 }
 ss::future<result<records_t>>
@@ -196,8 +209,17 @@ log_segment_batch_reader::read_some(model::timeout_clock::time_point timeout) {
     }
 
     if (!_iterator) {
-        _iterator = initialize(timeout, cache_read.next_cached_batch);
+        // closed segment indices may have been evicted under memory pressure
+        return _seg.index().hydrate().then(
+          [this, timeout, next = cache_read.next_cached_batch] {
+              _iterator = initialize(timeout, next);
+              return read_from_iterator();
+          });
     }
+    return read_from_iterator();
+}
+
+ss::future<result<records_t>> log_segment_batch_reader::read_from_iterator() {
     auto ptr = _iterator.get();
     return ptr->consume().then(
       [this](result<size_t> bytes_consumed) -> result<records_t> {
@@ -216,6 +238,8 @@ log_reader::log_reader(
   : _lease(std::move(l))
   , _iterator(_lease->range.begin())
   , _config(config)
+  , _read_ahead(
+      config::shard_local_cfg().segment_reader_max_readahead_size())
   , _probe(probe) {
     if (config.abort_source) {
         auto op_sub = config.abort_source.value().get().subscribe(
@@ -231,34 +255,43 @@ log_reader::log_reader(
 
     if (_iterator.next_seg != _lease->range.end()) {
         _iterator.reader = std::make_unique<log_segment_batch_reader>(
-          **_iterator.next_seg, _config, _probe);
+          **_iterator.next_seg, _config, _read_ahead, _probe);
     }
 }
 
 ss::future<> log_reader::find_next_valid_iterator() {
     if (_config.start_offset <= _iterator.offsets().dirty_offset) {
-        return ss::make_ready_future<>();
+        co_return;
     }
-    std::unique_ptr<log_segment_batch_reader> tmp_reader = nullptr;
+    auto tmp_reader = std::move(_iterator.reader);
     while (_config.start_offset > _iterator.offsets().dirty_offset) {
         _iterator.next_seg++;
-        if (!tmp_reader) {
-            tmp_reader = std::move(_iterator.reader);
-        }
         if (is_end_of_stream()) {
             break;
         }
     }
-    if (_iterator.next_seg != _lease->range.end()) {
-        _iterator.reader = std::make_unique<log_segment_batch_reader>(
-          **_iterator.next_seg, _config, _probe);
-        _iterator.current_reader_seg = _iterator.next_seg;
-    }
+    // the segment read so far is unlocked before the next one is locked, a
+    // compaction locking both of them then doesn't wait for this reader
     if (tmp_reader) {
-        auto raw = tmp_reader.get();
-        return raw->close().finally([r = std::move(tmp_reader)] {});
+        co_await tmp_reader->close();
     }
-    return ss::make_ready_future<>();
+    _lease->locks.clear();
+    if (is_end_of_stream()) {
+        co_return;
+    }
+    auto seg = *_iterator.next_seg;
+    _lease->locks.push_back(co_await seg->read_lock());
+    if (is_end_of_stream()) {
+        co_return;
+    }
+    if (seg->is_closed()) {
+        // removed by a truncation or a compaction since the range was leased
+        set_end_of_stream();
+        co_return;
+    }
+    _iterator.reader = std::make_unique<log_segment_batch_reader>(
+      *seg, _config, _read_ahead, _probe);
+    _iterator.current_reader_seg = _iterator.next_seg;
 }
 
 ss::future<log_reader::storage_t>
@@ -292,7 +325,14 @@ log_reader::do_load_slice(model::timeout_clock::time_point timeout) {
         return fut.then([] { return ss::make_ready_future<storage_t>(); });
     }
     return fut
-      .then([this, timeout] { return _iterator.reader->read_some(timeout); })
+      .then([this, timeout] {
+          if (!_iterator.reader) {
+              // the segment reached was closed, the recursion below ends the
+              // stream
+              return ss::make_ready_future<result<records_t>>(records_t{});
+          }
+          return _iterator.reader->read_some(timeout);
+      })
       .then([this, timeout](result<records_t> recs) -> ss::future<storage_t> {
           if (!recs) {
               set_end_of_stream();
@@ -337,6 +377,46 @@ static inline bool is_finished_offset(segment_set& s, model::offset o) {
     }
     return true;
 }
+ss::future<size_t> log_reader::prefetch(size_t max_bytes) {
+    if (
+      !is_reusable() || _config.skip_batch_cache
+      || _iterator.current_reader_seg == _lease->range.end()) {
+        co_return 0;
+    }
+    auto& seg = **_iterator.current_reader_seg;
+    if (!seg.has_cache()) {
+        co_return 0;
+    }
+    // a private copy, the prefetch must not advance this reader
+    log_reader_config cfg = _config;
+    cfg.max_bytes = max_bytes;
+    cfg.bytes_consumed = 0;
+    cfg.over_budget = false;
+    cfg.first_timestamp = std::nullopt;
+    cfg.abort_source = std::nullopt;
+    log_segment_batch_reader reader(seg, cfg, _read_ahead, _probe);
+    std::exception_ptr ex;
+    try {
+        while (cfg.bytes_consumed < cfg.max_bytes
+               && cfg.start_offset <= cfg.max_offset) {
+            auto recs = co_await reader.read_some(model::no_timeout);
+            if (!recs || recs.value().empty()) {
+                break;
+            }
+            // read_some has put the batches read from disk into the cache
+            cfg.start_offset = recs.value().back().last_offset()
+                               + model::offset(1);
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await reader.close();
+    if (ex) {
+        vlog(stlog.debug, "prefetch of {} failed: {}", seg, ex);
+    }
+    co_return cfg.bytes_consumed;
+}
+
 bool log_reader::is_done() {
     return is_end_of_stream()
            || is_finished_offset(_lease->range, _config.start_offset);
@@ -25,6 +25,8 @@
 #include <seastar/core/io_queue.hh>
 #include <seastar/util/optimized_optional.hh>
 
+#include <algorithm>
+
 /**
 storage/log_reader: use iterator-style traversal for reading
 
@@ -50,6 +52,35 @@ after every invocation of `record_batch_reader::load_batches()`
 */
 namespace storage {
 
+/**
+ * Sizes the disk reads issued by a log_reader. A reader that keeps being
+ * reused from the readers_cache is consuming the log sequentially, and every
+ * chunk that used at least half of the current read size doubles it, up to
+ * the configured maximum. Smaller chunks halve it back so that readers with
+ * sparse access keep issuing small reads.
+ */
+class read_ahead_policy {
+public:
+    static constexpr size_t min_size = default_segment_readahead_size;
+
+    explicit read_ahead_policy(size_t max_size) noexcept
+      : _max_size(std::max(max_size, min_size)) {}
+
+    size_t size() const { return _size; }
+
+    void record_sequential_read(size_t bytes) {
+        if (bytes >= _size / 2) {
+            _size = std::min(_size * 2, _max_size);
+        } else {
+            _size = std::max(_size / 2, min_size);
+        }
+    }
+
+private:
+    size_t _max_size;
+    size_t _size{min_size};
+};
+
 class log_segment_batch_reader;
 class skipping_consumer final : public batch_consumer {
 public:
@@ -91,7 +122,10 @@ public:
     static constexpr size_t max_buffer_size = 32 * 1024; // 32KB
 
     log_segment_batch_reader(
-      segment&, log_reader_config& config, probe& p) noexcept;
+      segment&,
+      log_reader_config& config,
+      const read_ahead_policy&,
+      probe& p) noexcept;
     log_segment_batch_reader(log_segment_batch_reader&&) noexcept = default;
     log_segment_batch_reader&
     operator=(log_segment_batch_reader&&) noexcept = delete;
@@ -110,6 +144,9 @@ private:
       model::timeout_clock::time_point,
       std::optional<model::offset> next_cached_batch);
 
+    ss::future<result<ss::circular_buffer<model::record_batch>>>
+    read_from_iterator();
+
     void add_one(model::record_batch&&);
 
 private:
@@ -121,6 +158,7 @@ private:
 
     segment& _seg;
     log_reader_config& _config;
+    const read_ahead_policy& _read_ahead;
     probe& _probe;
 
     std::unique_ptr<continuous_batch_parser> _iterator;
@@ -165,6 +203,8 @@ public:
      * 3. read next chunk of batches
      */
     void reset_config(log_reader_config cfg) {
+        // a reset is a cache hit for the offset following the previous read
+        _read_ahead.record_sequential_read(_config.bytes_consumed);
         _config = cfg;
         _iterator.next_seg = _iterator.current_reader_seg;
     };
@@ -203,6 +243,14 @@ public:
      */
     bool is_reusable() const { return _iterator.reader != nullptr; }
 
+    /**
+     * Reads up to \p max_bytes following the next read lower bound from the
+     * current segment into the batch cache, without consuming them. A reused
+     * reader then serves its next read from the cache. Must only be called
+     * while the reader is not being read from.
+     */
+    ss::future<size_t> prefetch(size_t max_bytes);
+
 private:
     void set_end_of_stream() { _iterator.next_seg = _lease->range.end(); }
     bool is_done();
@@ -234,6 +282,7 @@ private:
     std::unique_ptr<lock_manager::lease> _lease;
     iterator_pair _iterator;
     log_reader_config _config;
+    read_ahead_policy _read_ahead;
     model::offset _last_base;
     probe& _probe;
     ss::abort_source::subscription _as_sub;
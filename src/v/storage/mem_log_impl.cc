@@ -7,6 +7,7 @@
 // the Business Source License, use of this software will be governed
 // by the Apache License, Version 2.0
 
+#include "config/configuration.h"
 #include "likely.h"
 #include "model/fundamental.h"
 #include "model/record.h"
@@ -14,6 +15,7 @@
 #include "model/timeout_clock.h"
 #include "model/timestamp.h"
 #include "seastarx.h"
+#include "storage/key_index.h"
 #include "storage/log.h"
 #include "storage/logger.h"
 #include "storage/types.h"
@@ -49,9 +51,13 @@ struct entries_ordering {
 };
 
 struct mem_probe {
-    void add_bytes_written(size_t sz) { partition_bytes += sz; }
+    void add_bytes_written(size_t sz) {
+        partition_bytes += sz;
+        bytes_written += sz;
+    }
     void remove_bytes_written(size_t sz) { partition_bytes -= sz; }
     size_t partition_bytes{0};
+    uint64_t bytes_written{0};
 };
 
 struct mem_log_impl;
@@ -144,7 +150,8 @@ struct mem_log_impl final : log::impl {
     using underlying_t = std::deque<model::record_batch>;
     // forward ctor
     explicit mem_log_impl(ntp_config cfg)
-      : log::impl(std::move(cfg)) {}
+      : log::impl(std::move(cfg))
+      , _bounded(config().is_in_memory()) {}
     ~mem_log_impl() override = default;
     mem_log_impl(const mem_log_impl&) = delete;
     mem_log_impl& operator=(const mem_log_impl&) = delete;
@@ -160,6 +167,7 @@ struct mem_log_impl final : log::impl {
     ss::future<> remove() final { return ss::make_ready_future<>(); }
     ss::future<> flush() final { return ss::make_ready_future<>(); }
     ss::future<> compact(compaction_config cfg) final {
+        cfg = apply_overrides(cfg);
         return gc(cfg.eviction_time, cfg.max_bytes);
     }
     std::ostream& print(std::ostream& o) const final {
@@ -183,6 +191,26 @@ struct mem_log_impl final : log::impl {
         }
         return ss::make_ready_future<ret_t>();
     }
+    ss::future<std::optional<key_query_result>>
+    key_query(key_query_config cfg) final {
+        // not indexed, the batches are scanned
+        log_reader_config rcfg(
+          offsets().start_offset,
+          cfg.max_offset,
+          0,
+          std::numeric_limits<size_t>::max(),
+          cfg.prio,
+          model::record_batch_type::raft_data,
+          std::nullopt,
+          std::nullopt);
+        return make_reader(rcfg).then(
+          [cfg = std::move(cfg)](model::record_batch_reader r) mutable {
+              return std::move(r).consume(
+                internal::key_query_consumer(
+                  std::move(cfg.key), cfg.max_offset),
+                model::no_timeout);
+          });
+    }
     ss::future<> truncate_prefix(truncate_prefix_config cfg) final {
         stlog.debug("PREFIX Truncating {} log at {}", config().ntp(), cfg);
         if (_data.empty()) {
@@ -241,6 +269,47 @@ struct mem_log_impl final : log::impl {
         return ss::make_ready_future<>();
     }
 
+    /// the retention of the topic, bounded by in_memory_log_max_bytes for the
+    /// logs of in memory topics
+    compaction_config apply_overrides(compaction_config cfg) const {
+        if (config().has_overrides()) {
+            const auto& o = config().get_overrides();
+            if (o.retention_bytes.is_disabled()) {
+                cfg.max_bytes = std::nullopt;
+            }
+            if (o.retention_bytes.has_value()) {
+                cfg.max_bytes = o.retention_bytes.value();
+            }
+            if (o.retention_time.is_disabled()) {
+                cfg.eviction_time = model::timestamp::min();
+            }
+            if (o.retention_time.has_value()) {
+                cfg.eviction_time = model::timestamp(
+                  model::timestamp::now().value()
+                  - o.retention_time.value().count());
+            }
+        }
+        if (_bounded) {
+            cfg.max_bytes = std::min(
+              cfg.max_bytes.value_or(std::numeric_limits<size_t>::max()),
+              config::shard_local_cfg().in_memory_log_max_bytes());
+        }
+        return cfg;
+    }
+
+    /// evicts the oldest batches of an in memory log past its memory bound
+    /// without waiting for the next housekeeping round
+    void maybe_evict() {
+        if (
+          _bounded
+          && _probe.partition_bytes
+               > config::shard_local_cfg().in_memory_log_max_bytes()) {
+            (void)gc(
+              model::timestamp::min(),
+              config::shard_local_cfg().in_memory_log_max_bytes());
+        }
+    }
+
     ss::future<> gc(
       model::timestamp eviction_time,
       std::optional<size_t> max_partition_retention_size) {
@@ -263,17 +332,22 @@ struct mem_log_impl final : log::impl {
             _eviction_monitor->promise.set_value(max_offset);
             _eviction_monitor.reset();
         }
-        if (max_offset > _max_collectible_offset) {
-            return ss::now();
-        }
+        // batches which are not yet safe to evict, e.g. not committed, stay
+        max_offset = std::min(max_offset, _max_collectible_offset);
 
+        // the last batch is kept for the log offsets to survive eviction, as
+        // the active segment of a disk log is
         auto it = _data.begin();
-        while (it != _data.end() && it->last_offset() <= max_offset) {
+        while (!_data.empty() && std::next(it) != _data.end()
+               && it->last_offset() <= max_offset) {
             _probe.remove_bytes_written(it->size_bytes());
             it++;
         }
 
         if (it != _data.begin()) {
+            for (auto& reader : _readers) {
+                reader.invalidate();
+            }
             _data.erase(_data.begin(), it);
             _data.shrink_to_fit();
         }
@@ -314,6 +388,10 @@ struct mem_log_impl final : log::impl {
 
     int64_t compaction_backlog() const final { return 0; }
 
+    ss::future<> scrub(ss::io_priority_class, ss::abort_source&) final {
+        return ss::now();
+    }
+
     ss::future<model::record_batch_reader>
     make_reader(log_reader_config cfg) final {
         auto it = std::lower_bound(
@@ -373,15 +451,9 @@ struct mem_log_impl final : log::impl {
           .last_term_start_offset = last_term_base_offset};
     }
 
-    size_t size_bytes() const override {
-        return std::accumulate(
-          _data.cbegin(),
-          _data.cend(),
-          size_t(0),
-          [](size_t acc, const model::record_batch& b) {
-              return acc + b.size_bytes();
-          });
-    }
+    uint64_t bytes_written() const override { return _probe.bytes_written; }
+
+    size_t size_bytes() const override { return _probe.partition_bytes; }
 
     struct eviction_monitor {
         ss::promise<model::offset> promise;
@@ -393,6 +465,8 @@ struct mem_log_impl final : log::impl {
     ss::rwlock _eviction_lock;
     mem_probe _probe;
     model::offset _max_collectible_offset;
+    // logs of in memory topics are bounded by in_memory_log_max_bytes
+    bool _bounded;
 };
 
 ss::future<ss::stop_iteration>
@@ -420,6 +494,7 @@ ss::future<append_result> mem_log_appender::end_of_stream() {
       .last_offset = _cur_offset - model::offset(1),
       .byte_size = _byte_size,
       .last_term = _log._data.back().term()};
+    _log.maybe_evict();
     return ss::make_ready_future<append_result>(ret);
 }
 
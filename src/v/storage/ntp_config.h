@@ -10,6 +10,7 @@
  */
 
 #pragma once
+#include "model/compression.h"
 #include "model/fundamental.h"
 #include "model/metadata.h"
 #include "ssx/sformat.h"
@@ -23,6 +24,14 @@ namespace storage {
 using with_cache = ss::bool_class<struct log_cache_tag>;
 using topic_recovery_enabled
   = ss::bool_class<struct topic_recovery_enabled_tag>;
+using in_memory_log = ss::bool_class<struct in_memory_log_tag>;
+using with_write_caching = ss::bool_class<struct write_caching_tag>;
+
+/// controls how batches read back from closed segments enter the batch cache.
+/// `scan_resistant` admits them on probation so that a consumer catching up on
+/// old data cannot evict the batches that tail consumers are hitting.
+enum class batch_cache_admission : int8_t { lru = 0, scan_resistant = 1 };
+std::ostream& operator<<(std::ostream&, batch_cache_admission);
 
 class ntp_config {
 public:
@@ -40,8 +49,17 @@ public:
         tristate<std::chrono::milliseconds> retention_time{std::nullopt};
         // if set, log will not use batch cache
         with_cache cache_enabled = with_cache::yes;
+        // admission policy for batches cached by readers
+        batch_cache_admission cache_admission = batch_cache_admission::lru;
         // if set the value will be used during parititon recovery
         topic_recovery_enabled recovery_enabled = topic_recovery_enabled::yes;
+        // if set, produced batches using a different codec are recompressed
+        // to it before they are appended, `producer` keeps them as produced
+        std::optional<model::compression> compression;
+        // if set, the log is kept in memory only and is never written to disk
+        in_memory_log in_memory = in_memory_log::no;
+        // if set, quorum writes are acknowledged before they are flushed
+        with_write_caching write_caching = with_write_caching::no;
 
         friend std::ostream&
         operator<<(std::ostream&, const default_overrides&);
@@ -116,6 +134,33 @@ public:
         return with_cache(!has_overrides() || _overrides->cache_enabled);
     }
 
+    batch_cache_admission cache_admission() const {
+        return has_overrides() ? _overrides->cache_admission
+                               : batch_cache_admission::lru;
+    }
+
+    /// Codec the produced batches are recompressed to, nullopt if they are
+    /// appended as produced
+    std::optional<model::compression> recompression_type() const {
+        if (
+          !has_overrides() || !_overrides->compression
+          || *_overrides->compression == model::compression::producer) {
+            return std::nullopt;
+        }
+        return _overrides->compression;
+    }
+
+    /// Logs of ephemeral topics, replicated but never written to disk
+    in_memory_log is_in_memory() const {
+        return in_memory_log(has_overrides() && _overrides->in_memory);
+    }
+
+    /// Quorum writes are acknowledged once a majority appended them, the log
+    /// is flushed in the background
+    with_write_caching write_caching() const {
+        return with_write_caching(has_overrides() && _overrides->write_caching);
+    }
+
     void set_overrides(default_overrides o) {
         _overrides = std::make_unique<default_overrides>(o);
     }
@@ -35,7 +35,7 @@
 namespace storage {
 using stop_parser = batch_consumer::stop_parser;
 
-static model::record_batch_header header_from_iobuf(iobuf b) {
+model::record_batch_header header_from_iobuf(iobuf b) {
     iobuf_parser parser(std::move(b));
     auto header_crc = reflection::adl<uint32_t>{}.from(parser);
     auto sz = reflection::adl<int32_t>{}.from(parser);
@@ -137,9 +137,19 @@ ss::future<result<stop_parser>> continuous_batch_parser::consume_header() {
     }
 }
 
+/// \brief a header that cannot describe a batch. used to fall back to
+/// verifying the crc of headers that are otherwise trusted
+static bool is_implausible_header(const model::record_batch_header& h) {
+    return h.size_bytes < int32_t(model::packed_record_batch_header_size)
+           || h.last_offset_delta < 0 || h.record_count < 0
+           || h.base_offset < model::offset(0);
+}
+
 template<class Consumer>
-static ss::future<result<model::record_batch_header>>
-read_header_impl(ss::input_stream<char>& input, const Consumer& consumer) {
+static ss::future<result<model::record_batch_header>> read_header_impl(
+  ss::input_stream<char>& input,
+  const Consumer& consumer,
+  bool verify_crc = true) {
     auto b = co_await read_iobuf_exactly(
       input, model::packed_record_batch_header_size);
 
@@ -162,6 +172,9 @@ read_header_impl(ss::input_stream<char>& input, const Consumer& consumer) {
         // happens when we fallocate the file
         co_return parser_errc::fallocated_file_read_zero_bytes_for_header;
     }
+    if (!verify_crc && likely(!is_implausible_header(header))) {
+        co_return header;
+    }
     if (auto computed_crc = model::internal_header_only_crc(header);
         unlikely(header.header_crc != computed_crc)) {
         vlog(
@@ -179,7 +192,7 @@ read_header_impl(ss::input_stream<char>& input, const Consumer& consumer) {
 
 ss::future<result<model::record_batch_header>>
 continuous_batch_parser::read_header() {
-    return read_header_impl(_input, *_consumer);
+    return read_header_impl(_input, *_consumer, bool(_verify_header_crc));
 }
 
 ss::future<result<stop_parser>> continuous_batch_parser::consume_one() {
@@ -93,11 +93,18 @@ inline std::ostream& operator<<(std::ostream& os, const batch_consumer& c) {
 
 class continuous_batch_parser {
 public:
+    /// skipping the header crc is only safe for data that was already
+    /// verified, e.g. closed segments checked by the scrubber. headers that
+    /// look malformed are still verified.
+    using verify_header_crc = ss::bool_class<struct verify_header_crc_tag>;
+
     continuous_batch_parser(
       std::unique_ptr<batch_consumer> consumer,
-      ss::input_stream<char> input) noexcept
+      ss::input_stream<char> input,
+      verify_header_crc verify = verify_header_crc::yes) noexcept
       : _consumer(std::move(consumer))
-      , _input(std::move(input)) {}
+      , _input(std::move(input))
+      , _verify_header_crc(verify) {}
     continuous_batch_parser(const continuous_batch_parser&) = delete;
     continuous_batch_parser& operator=(const continuous_batch_parser&) = delete;
     continuous_batch_parser(continuous_batch_parser&&) noexcept = default;
@@ -133,6 +140,7 @@ private:
     parser_errc _err = parser_errc::none;
     size_t _bytes_consumed{0};
     size_t _physical_base_offset{0};
+    verify_header_crc _verify_header_crc;
 };
 
 using record_batch_transform_predicate = ss::noncopyable_function<
@@ -153,4 +161,8 @@ ss::future<result<size_t>> transform_stream(
   ss::output_stream<char> out,
   record_batch_transform_predicate pred);
 
+/// decodes a batch header in its on-disk encoding, of
+/// model::packed_record_batch_header_size bytes, without validating it
+model::record_batch_header header_from_iobuf(iobuf);
+
 } // namespace storage
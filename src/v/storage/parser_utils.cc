@@ -9,12 +9,15 @@
 
 #include "storage/parser_utils.h"
 
+#include "compression/async_compressor.h"
 #include "compression/compression.h"
 #include "model/compression.h"
 #include "model/record.h"
 #include "model/record_utils.h"
 #include "reflection/adl.h"
 #include "storage/logger.h"
+#include "units.h"
+#include "utils/vint.h"
 #include "vlog.h"
 
 #include <seastar/core/byteorder.hh>
@@ -37,7 +40,9 @@ ss::future<model::record_batch> decompress_batch(model::record_batch&& b) {
     if (!b.compressed()) {
         return ss::make_ready_future<model::record_batch>(std::move(b));
     }
-    return decompress_batch(b);
+    return ss::do_with(std::move(b), [](model::record_batch& b) {
+        return decompress_batch(b);
+    });
 }
 
 ss::future<model::record_batch> decompress_batch(const model::record_batch& b) {
@@ -48,15 +53,60 @@ ss::future<model::record_batch> decompress_batch(const model::record_batch& b) {
             "Asked to decompressed a non-compressed batch:{}",
             b.header())));
     }
-    iobuf body_buf = compression::compressor::uncompress(
-      b.data(), b.header().attrs.compression());
-    // must remove compression first!
-    auto h = b.header();
-    h.attrs.remove_compression();
-    reset_size_checksum_metadata(h, body_buf);
-    auto batch = model::record_batch(
-      h, std::move(body_buf), model::record_batch::tag_ctor_ng{});
-    return ss::make_ready_future<model::record_batch>(std::move(batch));
+    return compression::local_async_compressor()
+      .uncompress(b.data(), b.header().attrs.compression())
+      .then([h = b.header()](iobuf body_buf) mutable {
+          // must remove compression first!
+          h.attrs.remove_compression();
+          reset_size_checksum_metadata(h, body_buf);
+          return model::record_batch(
+            h, std::move(body_buf), model::record_batch::tag_ctor_ng{});
+      });
+}
+
+// size of the uncompressed parts the records are parsed from
+static constexpr size_t decompression_step = 32_KiB;
+
+compressed_records_reader::compressed_records_reader(
+  const model::record_batch& b)
+  : _record_count(b.record_count())
+  , _decompressor(compression::compressor::make_stream_decompressor(
+      b.data(), b.header().attrs.compression())) {}
+
+bool compressed_records_reader::fill(size_t n) {
+    while (_buffer.size_bytes() < n) {
+        auto part = _decompressor->next(decompression_step);
+        if (part.empty()) {
+            return false;
+        }
+        _buffer.append(std::move(part));
+    }
+    return true;
+}
+
+std::optional<model::record> compressed_records_reader::next() {
+    if (_records_read == _record_count) {
+        if (unlikely(fill(1))) {
+            throw std::out_of_range(
+              "Record iteration stopped with uncompressed bytes remaining");
+        }
+        return std::nullopt;
+    }
+    // the record length prefix might be shorter than the max vint length
+    fill(vint::max_length);
+    auto [length, length_size] = iobuf_const_parser(_buffer).read_varlong();
+    if (unlikely(length < 0 || !fill(length_size + length))) {
+        throw std::out_of_range(fmt::format(
+          "Record {} of {} with size {} is out of the uncompressed batch",
+          _records_read,
+          _record_count,
+          length));
+    }
+    const size_t record_size = length_size + length;
+    iobuf_parser parser(_buffer.share(0, record_size));
+    _buffer.trim_front(record_size);
+    ++_records_read;
+    return model::parse_one_record_from_buffer(parser);
 }
 
 compress_batch_consumer::compress_batch_consumer(
@@ -100,14 +150,15 @@ compress_batch(model::compression c, const model::record_batch& b) {
       "Asked to compress a batch with type `none`: {} - {}",
       c,
       b.header());
-    auto payload = compression::compressor::compress(b.data(), c);
-    auto h = b.header();
-    // compression bit must be set first!
-    h.attrs |= c;
-    reset_size_checksum_metadata(h, payload);
-    auto batch = model::record_batch(
-      h, std::move(payload), model::record_batch::tag_ctor_ng{});
-    return ss::make_ready_future<model::record_batch>(std::move(batch));
+    return compression::local_async_compressor()
+      .compress(b.data(), c)
+      .then([c, h = b.header()](iobuf payload) mutable {
+          // compression bit must be set first!
+          h.attrs |= c;
+          reset_size_checksum_metadata(h, payload);
+          return model::record_batch(
+            h, std::move(payload), model::record_batch::tag_ctor_ng{});
+      });
 }
 
 /// \brief resets the size, header crc and payload crc
@@ -12,9 +12,14 @@
 #pragma once
 
 #include "bytes/iobuf_parser.h"
+#include "compression/stream_decompressor.h"
 #include "model/record.h"
 #include "model/record_batch_reader.h"
 
+#include <seastar/core/loop.hh>
+
+#include <memory>
+
 namespace storage::internal {
 
 /// \brief Decompress over a model::record_batch_reader
@@ -42,13 +47,58 @@ private:
 
 /// \brief batch decompression
 ss::future<model::record_batch> decompress_batch(model::record_batch&&);
-/// \brief batch decompression
+/// \brief batch decompression, the batch must outlive the returned future
 ss::future<model::record_batch> decompress_batch(const model::record_batch&);
 
+/// \brief records of a compressed batch, the batch is decompressed
+/// incrementally so that the memory used is bounded by the size of the
+/// largest record instead of the uncompressed size of the batch.
+/// The batch must outlive the reader.
+class compressed_records_reader {
+public:
+    explicit compressed_records_reader(const model::record_batch&);
+
+    /// Next record of the batch, nullopt after the last one
+    std::optional<model::record> next();
+
+private:
+    /// Decompresses until at least n bytes are buffered, returns false if
+    /// the uncompressed data ends first
+    bool fill(size_t n);
+
+    int32_t _record_count;
+    int32_t _records_read{0};
+    std::unique_ptr<compression::stream_decompressor> _decompressor;
+    // uncompressed data not parsed yet
+    iobuf _buffer;
+};
+
+/// \brief lazy iteration over the records of a compressed batch without
+/// decompressing the whole batch, see compressed_records_reader
+template<typename Func>
+inline ss::future<>
+for_each_compressed_record(const model::record_batch& batch, Func&& f) {
+    return ss::do_with(
+      compressed_records_reader(batch),
+      [f = std::forward<Func>(f)](compressed_records_reader& reader) mutable {
+          return ss::repeat([&reader, &f] {
+              auto record = reader.next();
+              if (!record) {
+                  return ss::make_ready_future<ss::stop_iteration>(
+                    ss::stop_iteration::yes);
+              }
+              return ss::do_with(
+                       std::move(*record),
+                       [&f](model::record& r) { return f(r); })
+                .then([] { return ss::stop_iteration::no; });
+          });
+      });
+}
+
 /// \brief batch compression
 ss::future<model::record_batch>
 compress_batch(model::compression, model::record_batch&&);
-/// \brief batch compression
+/// \brief batch compression, the batch must outlive the returned future
 ss::future<model::record_batch>
 compress_batch(model::compression, const model::record_batch&);
 
@@ -10,6 +10,7 @@
 #include "storage/probe.h"
 
 #include "config/configuration.h"
+#include "prometheus/partition_metrics.h"
 #include "prometheus/prometheus_sanitize.h"
 #include "storage/readers_cache_probe.h"
 #include "storage/segment.h"
@@ -23,141 +24,236 @@ void probe::setup_metrics(const model::ntp& ntp) {
     }
 
     namespace sm = ss::metrics;
-    auto ns_label = sm::label("namespace");
-    auto topic_label = sm::label("topic");
-    auto partition_label = sm::label("partition");
-    const std::vector<sm::label_instance> labels = {
-      ns_label(ntp.ns()),
-      topic_label(ntp.tp.topic()),
-      partition_label(ntp.tp.partition()),
-    };
+    using partition_metrics::metric_kind;
+    partition_metrics::setup(
+      "storage:log",
+      ntp,
+      {
+        {"written_bytes",
+         "Total number of bytes written",
+         metric_kind::total_bytes,
+         [this] { return _bytes_written; }},
+        {"batches_written",
+         "Total number of batches written",
+         metric_kind::counter,
+         [this] { return _batches_written; }},
+        {"read_bytes",
+         "Total number of bytes read",
+         metric_kind::total_bytes,
+         [this] { return _bytes_read; }},
+        {"cached_read_bytes",
+         "Total number of cached bytes read",
+         metric_kind::total_bytes,
+         [this] { return _cached_bytes_read; }},
+        {"batches_read",
+         "Total number of batches read",
+         metric_kind::counter,
+         [this] { return _batches_read; }},
+        {"cached_batches_read",
+         "Total number of cached batches read",
+         metric_kind::counter,
+         [this] { return _cached_batches_read; }},
+        {"log_segments_created",
+         "Number of created log segments",
+         metric_kind::counter,
+         [this] { return _log_segments_created; }},
+        {"log_segments_removed",
+         "Number of removed log segments",
+         metric_kind::counter,
+         [this] { return _log_segments_removed; }},
+        {"log_segments_active",
+         "Number of active log segments",
+         metric_kind::gauge,
+         [this] { return _log_segments_active; }},
+        {"batch_parse_errors",
+         "Number of batch parsing (reading) errors",
+         metric_kind::counter,
+         [this] { return _batch_parse_errors; }},
+        {"batch_write_errors",
+         "Number of batch write errors",
+         metric_kind::counter,
+         [this] { return _batch_write_errors; }},
+        {"corrupted_compaction_indices",
+         "Number of times we had to re-construct the .compaction index on a "
+         "segment",
+         metric_kind::counter,
+         [this] { return _corrupted_compaction_index; }},
+        {"segments_verified",
+         "Number of segments verified by the scrubber",
+         metric_kind::counter,
+         [this] { return _segments_verified; }},
+        {"segment_scrub_failures",
+         "Number of segments in which the scrubber found a corrupt batch",
+         metric_kind::counter,
+         [this] { return _segment_scrub_failures; }},
+        {"compacted_segment",
+         "Number of compacted segments",
+         metric_kind::counter,
+         [this] { return _segment_compacted; }},
+        {"recompressed_segment",
+         "Number of closed segments rewritten with a stronger compression",
+         metric_kind::counter,
+         [this] { return _segment_recompressed; }},
+        {"recompression_saved_bytes",
+         "Bytes saved by rewriting closed segments with a stronger compression",
+         metric_kind::total_bytes,
+         [this] { return _recompression_saved_bytes; }},
+        {"partition_size",
+         "Current size of partition in bytes",
+         metric_kind::gauge,
+         [this] { return _partition_bytes; }},
+      },
+      _metrics,
+      _aggregated_metrics);
 
+    if (!partition_metrics::per_partition(ntp)) {
+        return;
+    }
     _metrics.add_group(
       prometheus_sanitize::metrics_name("storage:log"),
       {
-        sm::make_total_bytes(
-          "written_bytes",
-          [this] { return _bytes_written; },
-          sm::description("Total number of bytes written"),
-          labels),
-        sm::make_derive(
-          "batches_written",
-          [this] { return _batches_written; },
-          sm::description("Total number of batches written"),
-          labels),
-        sm::make_total_bytes(
-          "read_bytes",
-          [this] { return _bytes_read; },
-          sm::description("Total number of bytes read"),
-          labels),
-        sm::make_total_bytes(
-          "cached_read_bytes",
-          [this] { return _cached_bytes_read; },
-          sm::description("Total number of cached bytes read"),
-          labels),
-        sm::make_derive(
-          "batches_read",
-          [this] { return _batches_read; },
-          sm::description("Total number of batches read"),
-          labels),
-        sm::make_derive(
-          "cached_batches_read",
-          [this] { return _cached_batches_read; },
-          sm::description("Total number of cached batches read"),
-          labels),
-        sm::make_derive(
-          "log_segments_created",
-          [this] { return _log_segments_created; },
-          sm::description("Number of created log segments"),
-          labels),
-        sm::make_derive(
-          "log_segments_removed",
-          [this] { return _log_segments_removed; },
-          sm::description("Number of removed log segments"),
-          labels),
-        sm::make_derive(
-          "log_segments_active",
-          [this] { return _log_segments_active; },
-          sm::description("Number of active log segments"),
-          labels),
-        sm::make_derive(
-          "batch_parse_errors",
-          [this] { return _batch_parse_errors; },
-          sm::description("Number of batch parsing (reading) errors"),
-          labels),
-        sm::make_derive(
-          "batch_write_errors",
-          [this] { return _batch_write_errors; },
-          sm::description("Number of batch write errors"),
-          labels),
-        sm::make_derive(
-          "corrupted_compaction_indices",
-          [this] { return _corrupted_compaction_index; },
-          sm::description("Number of times we had to re-construct the "
-                          ".compaction index on a segment"),
-          labels),
-        sm::make_derive(
-          "compacted_segment",
-          [this] { return _segment_compacted; },
-          sm::description("Number of compacted segments"),
-          labels),
-        sm::make_gauge(
-          "partition_size",
-          [this] { return _partition_bytes; },
-          sm::description("Current size of partition in bytes"),
-          labels),
         sm::make_total_bytes(
           "compaction_ratio",
           [this] { return _compaction_ratio; },
           sm::description("Average segment compaction ratio"),
-          labels),
+          partition_metrics::labels(ntp)),
       });
 }
 
 void probe::add_initial_segment(const segment& s) {
-    _partition_bytes += s.reader().file_size();
+    add_partition_bytes(s.reader().file_size());
 }
 void probe::delete_segment(const segment& s) {
-    _partition_bytes -= s.reader().file_size();
+    remove_partition_bytes(s.reader().file_size());
+}
+
+void disk_usage_probe::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    namespace sm = ss::metrics;
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("storage:disk_usage"),
+      {
+        sm::make_gauge(
+          "bytes",
+          [this] { return _bytes; },
+          sm::description("Bytes on disk of the logs of the shard")),
+      });
 }
 
 void readers_cache_probe::setup_metrics(const model::ntp& ntp) {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    using partition_metrics::metric_kind;
+    partition_metrics::setup(
+      "storage:log",
+      ntp,
+      {
+        {"readers_added",
+         "Number of readers added to cache",
+         metric_kind::counter,
+         [this] { return _readers_added; }},
+        {"readers_evicted",
+         "Number of readers evicted from cache",
+         metric_kind::counter,
+         [this] { return _readers_evicted; }},
+        {"cache_hits",
+         "Reader cache hits",
+         metric_kind::counter,
+         [this] { return _cache_hits; }},
+        {"cache_misses",
+         "Reader cache misses",
+         metric_kind::counter,
+         [this] { return _cache_misses; }},
+        {"reader_prefetches",
+         "Read-aheads started for sequential cached readers",
+         metric_kind::counter,
+         [this] { return _prefetches; }},
+        {"reader_prefetches_skipped",
+         "Read-aheads not started because the shard limit was reached",
+         metric_kind::counter,
+         [this] { return _prefetches_skipped; }},
+        {"reader_prefetched_bytes",
+         "Bytes read ahead into the batch cache",
+         metric_kind::counter,
+         [this] { return _prefetched_bytes; }},
+      },
+      _metrics,
+      _aggregated_metrics);
+}
+
+void batch_cache_probe::setup_metrics(
+  std::function<size_t()> size_bytes,
+  std::function<size_t()> compressed_size_bytes) {
     if (config::shard_local_cfg().disable_metrics()) {
         return;
     }
     namespace sm = ss::metrics;
-    auto ns_label = sm::label("namespace");
-    auto topic_label = sm::label("topic");
-    auto partition_label = sm::label("partition");
-    const std::vector<sm::label_instance> labels = {
-      ns_label(ntp.ns()),
-      topic_label(ntp.tp.topic()),
-      partition_label(ntp.tp.partition()),
-    };
+    _metrics.add_group(
+      prometheus_sanitize::metrics_name("storage:batch_cache"),
+      {
+        sm::make_derive(
+          "hits",
+          [this] { return _hits; },
+          sm::description("Reads served from the uncompressed tier")),
+        sm::make_derive(
+          "misses",
+          [this] { return _misses; },
+          sm::description("Reads missing the uncompressed tier")),
+        sm::make_derive(
+          "compressed_hits",
+          [this] { return _compressed_hits; },
+          sm::description("Uncompressed tier misses served by the "
+                          "compressed tier")),
+        sm::make_derive(
+          "compressed_misses",
+          [this] { return _compressed_misses; },
+          sm::description("Reads missing both tiers")),
+        sm::make_derive(
+          "ranges_demoted",
+          [this] { return _ranges_demoted; },
+          sm::description("Ranges moved to the compressed tier on reclaim")),
+        sm::make_derive(
+          "ranges_not_compressible",
+          [this] { return _ranges_not_compressible; },
+          sm::description("Reclaimed ranges dropped as not compressible")),
+        sm::make_gauge(
+          "size_bytes",
+          std::move(size_bytes),
+          sm::description("Bytes held by the uncompressed tier")),
+        sm::make_gauge(
+          "compressed_size_bytes",
+          std::move(compressed_size_bytes),
+          sm::description("Bytes held by the compressed tier")),
+      });
+}
 
+void flush_coordinator_probe::setup_metrics() {
+    if (config::shard_local_cfg().disable_metrics()) {
+        return;
+    }
+    namespace sm = ss::metrics;
     _metrics.add_group(
-      prometheus_sanitize::metrics_name("storage:log"),
+      prometheus_sanitize::metrics_name("storage:flush_coordinator"),
       {
         sm::make_derive(
-          "readers_added",
-          [this] { return _readers_added; },
-          sm::description("Number of readers added to cache"),
-          labels),
+          "flushes_requested",
+          [this] { return _flushes_requested; },
+          sm::description("Segment flushes requested by appenders")),
         sm::make_derive(
-          "readers_evicted",
-          [this] { return _readers_evicted; },
-          sm::description("Number of readers evicted from cache"),
-          labels),
+          "flushes_issued",
+          [this] { return _flushes_issued; },
+          sm::description("Segment flushes issued to the file system")),
         sm::make_derive(
-          "cache_hits",
-          [this] { return _cache_hits; },
-          sm::description("Reader cache hits"),
-          labels),
+          "flushes_saved",
+          [this] { return _flushes_requested - _flushes_issued; },
+          sm::description("Flush requests that shared an issued flush")),
         sm::make_derive(
-          "cache_misses",
-          [this] { return _cache_misses; },
-          sm::description("Reader cache misses"),
-          labels),
+          "windows_dispatched",
+          [this] { return _windows_dispatched; },
+          sm::description("Coalescing windows dispatched")),
       });
 }
 } // namespace storage
@@ -11,19 +11,41 @@
 
 #pragma once
 #include "model/fundamental.h"
+#include "prometheus/partition_metrics.h"
 #include "storage/fwd.h"
 #include "storage/logger.h"
 
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/shared_ptr.hh>
 
+#include <algorithm>
 #include <cstdint>
+#include <functional>
 
 namespace storage {
+
+/// \brief bytes on disk of the logs of a shard
+///
+/// The probes of the logs account their partition size into it as it
+/// changes, on append, segment roll and removal, compaction and truncation,
+/// so the shard total is known without walking the logs.
+class disk_usage_probe {
+public:
+    void add(uint64_t bytes) { _bytes += bytes; }
+    void remove(uint64_t bytes) { _bytes -= std::min(_bytes, bytes); }
+    uint64_t bytes() const { return _bytes; }
+
+    void setup_metrics();
+
+private:
+    uint64_t _bytes = 0;
+    ss::metrics::metric_groups _metrics;
+};
+
 class probe {
 public:
     void add_bytes_written(uint64_t written) {
-        _partition_bytes += written;
+        add_partition_bytes(written);
         _bytes_written += written;
     }
 
@@ -47,6 +69,10 @@ public:
     void initial_segments_count(size_t cnt) { _log_segments_active = cnt; }
 
     void segment_compacted() { ++_segment_compacted; }
+    void segment_recompressed(size_t bytes_saved) {
+        ++_segment_recompressed;
+        _recompression_saved_bytes += bytes_saved;
+    }
 
     void batch_write_error(const std::exception_ptr& e) {
         stlog.error("Error writing record batch {}", e);
@@ -59,17 +85,46 @@ public:
     }
 
     void batch_parse_error() { ++_batch_parse_errors; }
+    void segment_verified() { ++_segments_verified; }
+    void segment_scrub_failed() { ++_segment_scrub_failures; }
 
     void setup_metrics(const model::ntp&);
 
     void delete_segment(const segment&);
 
     size_t partition_size() const { return _partition_bytes; }
+    uint64_t bytes_written() const { return _bytes_written; }
     void add_initial_segment(const segment&);
-    void remove_partition_bytes(size_t remove) { _partition_bytes -= remove; }
+    void remove_partition_bytes(size_t remove) {
+        _partition_bytes -= remove;
+        if (_shard_usage) {
+            _shard_usage->remove(remove);
+        }
+    }
     void set_compaction_ratio(double r) { _compaction_ratio = r; }
 
+    /// the partition size is accounted in the disk usage of the shard until
+    /// detached, when the log is closed or removed
+    void attach_shard_usage(disk_usage_probe& usage) {
+        _shard_usage = &usage;
+        _shard_usage->add(_partition_bytes);
+    }
+    void detach_shard_usage() {
+        if (_shard_usage) {
+            _shard_usage->remove(_partition_bytes);
+            _shard_usage = nullptr;
+        }
+    }
+
 private:
+    void add_partition_bytes(uint64_t bytes) {
+        _partition_bytes += bytes;
+        if (_shard_usage) {
+            _shard_usage->add(bytes);
+        }
+    }
+
+    disk_usage_probe* _shard_usage = nullptr;
     uint64_t _partition_bytes = 0;
     uint64_t _bytes_written = 0;
     uint64_t _bytes_read = 0;
@@ -80,13 +135,60 @@ private:
     uint64_t _cached_batches_read = 0;
 
     uint32_t _segment_compacted = 0;
+    uint32_t _segment_recompressed = 0;
+    uint64_t _recompression_saved_bytes = 0;
     uint32_t _corrupted_compaction_index = 0;
     uint32_t _log_segments_created = 0;
     uint32_t _log_segments_removed = 0;
     uint32_t _log_segments_active = 0;
     uint32_t _batch_parse_errors = 0;
     uint32_t _batch_write_errors = 0;
+    uint32_t _segments_verified = 0;
+    uint32_t _segment_scrub_failures = 0;
     double _compaction_ratio = 1.0;
     ss::metrics::metric_groups _metrics;
+    partition_metrics::registry::member _aggregated_metrics;
+};
+
+/// shard-wide counters of the batch cache and its compressed second tier
+class batch_cache_probe {
+public:
+    void hit() { ++_hits; }
+    void miss() { ++_misses; }
+    void compressed_hit() { ++_compressed_hits; }
+    void compressed_miss() { ++_compressed_misses; }
+    void range_demoted() { ++_ranges_demoted; }
+    void range_not_compressible() { ++_ranges_not_compressible; }
+
+    uint64_t hits() const { return _hits; }
+    uint64_t misses() const { return _misses; }
+
+    void setup_metrics(
+      std::function<size_t()> size_bytes,
+      std::function<size_t()> compressed_size_bytes);
+
+private:
+    uint64_t _hits = 0;
+    uint64_t _misses = 0;
+    uint64_t _compressed_hits = 0;
+    uint64_t _compressed_misses = 0;
+    uint64_t _ranges_demoted = 0;
+    uint64_t _ranges_not_compressible = 0;
+    ss::metrics::metric_groups _metrics;
+};
+
+class flush_coordinator_probe {
+public:
+    void flush_requested() { ++_flushes_requested; }
+    void flush_issued() { ++_flushes_issued; }
+    void window_dispatched() { ++_windows_dispatched; }
+
+    void setup_metrics();
+
+private:
+    uint64_t _flushes_requested = 0;
+    uint64_t _flushes_issued = 0;
+    uint64_t _windows_dispatched = 0;
+    ss::metrics::metric_groups _metrics;
 };
 } // namespace storage
@@ -0,0 +1,73 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/read_coalescing_file.h"
+
+#include <algorithm>
+
+namespace storage {
+
+/// the part of the buffer read at \p read_offset holding the range starting
+/// at \p offset. empty when the read was short of it
+static ss::temporary_buffer<uint8_t> share_range(
+  ss::temporary_buffer<uint8_t>& buf,
+  uint64_t read_offset,
+  uint64_t offset,
+  size_t range_size) {
+    const size_t skip = offset - read_offset;
+    if (skip >= buf.size()) {
+        return ss::temporary_buffer<uint8_t>();
+    }
+    return buf.share(skip, std::min(range_size, buf.size() - skip));
+}
+
+ss::future<ss::temporary_buffer<uint8_t>> read_coalescing_file::dma_read_bulk(
+  uint64_t offset, size_t range_size, const ss::io_priority_class& pc) {
+    auto it = std::find_if(
+      _pending.begin(),
+      _pending.end(),
+      [offset, range_size](const ss::lw_shared_ptr<pending_read>& p) {
+          return p->covers(offset, range_size);
+      });
+    if (it != _pending.end()) {
+        ++_coalesced_reads;
+        auto read_offset = (*it)->offset;
+        return (*it)->waiters.emplace_back().get_future().then(
+          [read_offset, offset, range_size](
+            ss::temporary_buffer<uint8_t> buf) {
+              return share_range(buf, read_offset, offset, range_size);
+          });
+    }
+
+    auto pending = ss::make_lw_shared<pending_read>(
+      pending_read{.offset = offset, .size = range_size});
+    _pending.push_back(pending);
+    return get_file_impl(_file)
+      ->dma_read_bulk(offset, range_size, pc)
+      .then_wrapped([this, pending](
+                      ss::future<ss::temporary_buffer<uint8_t>> f) {
+          std::erase(_pending, pending);
+          if (f.failed()) {
+              auto e = f.get_exception();
+              for (auto& w : pending->waiters) {
+                  w.set_exception(e);
+              }
+              return ss::make_exception_future<ss::temporary_buffer<uint8_t>>(
+                e);
+          }
+          auto buf = f.get0();
+          for (auto& w : pending->waiters) {
+              w.set_value(buf.share());
+          }
+          return ss::make_ready_future<ss::temporary_buffer<uint8_t>>(
+            std::move(buf));
+      });
+}
+
+} // namespace storage
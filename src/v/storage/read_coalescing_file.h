@@ -0,0 +1,116 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/file.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/core/temporary_buffer.hh>
+
+#include <vector>
+
+namespace storage {
+
+/**
+ * \brief file handle sharing concurrent reads of the same range
+ *
+ * Wraps the read only handle of a segment data file. When a burst of readers
+ * reads the same cold range of a segment at once, e.g. consumers fanning out
+ * after a restart, each of them would read it from disk before the batch
+ * cache is populated. A bulk read of a range covered by a read still in
+ * flight waits for that read and shares its buffer instead.
+ *
+ * All the other operations are forwarded to the wrapped handle.
+ */
+class read_coalescing_file final : public ss::file_impl {
+public:
+    explicit read_coalescing_file(ss::file f)
+      : _file(std::move(f)) {}
+
+    ss::future<ss::temporary_buffer<uint8_t>> dma_read_bulk(
+      uint64_t offset,
+      size_t range_size,
+      const ss::io_priority_class& pc) final;
+
+    ss::future<size_t> write_dma(
+      uint64_t pos,
+      const void* buffer,
+      size_t len,
+      const ss::io_priority_class& pc) final {
+        return get_file_impl(_file)->write_dma(pos, buffer, len, pc);
+    }
+    ss::future<size_t> write_dma(
+      uint64_t pos,
+      std::vector<iovec> iov,
+      const ss::io_priority_class& pc) final {
+        return get_file_impl(_file)->write_dma(pos, std::move(iov), pc);
+    }
+    ss::future<size_t> read_dma(
+      uint64_t pos,
+      void* buffer,
+      size_t len,
+      const ss::io_priority_class& pc) final {
+        return get_file_impl(_file)->read_dma(pos, buffer, len, pc);
+    }
+    ss::future<size_t> read_dma(
+      uint64_t pos,
+      std::vector<iovec> iov,
+      const ss::io_priority_class& pc) final {
+        return get_file_impl(_file)->read_dma(pos, std::move(iov), pc);
+    }
+    ss::future<> flush() final { return get_file_impl(_file)->flush(); }
+    ss::future<struct stat> stat() final {
+        return get_file_impl(_file)->stat();
+    }
+    ss::future<> truncate(uint64_t length) final {
+        return get_file_impl(_file)->truncate(length);
+    }
+    ss::future<> discard(uint64_t offset, uint64_t length) final {
+        return get_file_impl(_file)->discard(offset, length);
+    }
+    ss::future<> allocate(uint64_t position, uint64_t length) final {
+        return get_file_impl(_file)->allocate(position, length);
+    }
+    ss::future<uint64_t> size() final { return get_file_impl(_file)->size(); }
+    ss::future<> close() final { return get_file_impl(_file)->close(); }
+    std::unique_ptr<ss::file_handle_impl> dup() final {
+        return get_file_impl(_file)->dup();
+    }
+    ss::subscription<ss::directory_entry> list_directory(
+      std::function<ss::future<>(ss::directory_entry de)> next) final {
+        return get_file_impl(_file)->list_directory(std::move(next));
+    }
+
+    /// number of bulk reads served by a read already in flight
+    uint64_t coalesced_reads() const { return _coalesced_reads; }
+
+private:
+    struct pending_read {
+        uint64_t offset;
+        size_t size;
+        std::vector<ss::promise<ss::temporary_buffer<uint8_t>>> waiters;
+
+        bool covers(uint64_t o, size_t len) const {
+            return offset <= o && o + len <= offset + size;
+        }
+    };
+
+    ss::file _file;
+    // reads in flight. bursts keep a handful of them, a linear search is
+    // cheaper than maintaining an interval index
+    std::vector<ss::lw_shared_ptr<pending_read>> _pending;
+    uint64_t _coalesced_reads{0};
+};
+
+} // namespace storage
@@ -10,6 +10,7 @@
  */
 #include "storage/readers_cache.h"
 
+#include "config/configuration.h"
 #include "model/fundamental.h"
 #include "storage/types.h"
 #include "utils/gate_guard.h"
@@ -25,6 +26,11 @@
 
 namespace storage {
 
+// reuses after which a reader is considered a sequential consumer
+static constexpr uint32_t prefetch_after_hits = 2;
+// read-aheads in flight across all readers caches of the shard
+static thread_local size_t prefetches_in_flight = 0;
+
 readers_cache::readers_cache(
   model::ntp ntp, std::chrono::milliseconds eviction_timeout)
   : _ntp(std::move(ntp))
@@ -119,6 +125,7 @@ readers_cache::get_reader(const log_reader_config& cfg) {
     auto& e = *it;
     vlog(stlog.trace, "{} - reader cache hit for: {}", _ntp, cfg);
     it->reader->reset_config(cfg);
+    ++it->sequential_hits;
     _probe.cache_hit();
 
     // we use cached_reader wrapper to track reader usage, when cached_reader is
@@ -152,6 +159,7 @@ ss::future<> readers_cache::stop() {
      * Close and dispose cached readers
      */
     for (auto& r : _readers) {
+        co_await r.prefetch_gate.close();
         co_await r.reader->finally();
     }
     _readers.clear_and_dispose([](entry* e) {
@@ -260,6 +268,7 @@ readers_cache::~readers_cache() {
 ss::future<>
 readers_cache::dispose_entries(intrusive_list<entry, &entry::_hook> entries) {
     for (auto& e : entries) {
+        co_await e.prefetch_gate.close();
         co_await e.reader->finally();
     }
 
@@ -291,17 +300,19 @@ void readers_cache::dispose_in_background(
 void readers_cache::dispose_in_background(entry* e) {
     try {
         (void)ss::with_gate(_gate, [this, e] {
-            return e->reader->finally().finally([this, e] {
-                vlog(
-                  stlog.trace,
-                  "{} - removing reader: [{},{}] lower_bound: {}",
-                  _ntp,
-                  e->reader->lease_range_base_offset(),
-                  e->reader->lease_range_end_offset(),
-                  e->reader->next_read_lower_bound());
-                _probe.reader_evicted();
-                delete e; // NOLINT
-            });
+            return e->prefetch_gate.close()
+              .then([e] { return e->reader->finally(); })
+              .finally([this, e] {
+                  vlog(
+                    stlog.trace,
+                    "{} - removing reader: [{},{}] lower_bound: {}",
+                    _ntp,
+                    e->reader->lease_range_base_offset(),
+                    e->reader->lease_range_end_offset(),
+                    e->reader->next_read_lower_bound());
+                  _probe.reader_evicted();
+                  delete e; // NOLINT
+              });
         });
     } catch (const ss::gate_closed_exception& ex) {
         vlog(stlog.debug, "gate closed while disposing reader");
@@ -319,6 +330,40 @@ void readers_cache::dispose_in_background(entry* e) {
     }
 }
 
+void readers_cache::maybe_prefetch(entry* e) {
+    const auto max_bytes
+      = config::shard_local_cfg().readers_cache_prefetch_bytes();
+    if (
+      max_bytes == 0 || e->sequential_hits < prefetch_after_hits
+      || e->prefetch_gate.get_count() > 0 || _gate.is_closed()) {
+        return;
+    }
+    if (
+      prefetches_in_flight
+      >= config::shard_local_cfg().readers_cache_max_prefetches()) {
+        _probe.prefetch_skipped();
+        return;
+    }
+    ++prefetches_in_flight;
+    _probe.prefetch_started();
+    vlog(
+      stlog.trace,
+      "{} - prefetching {} bytes from: {}",
+      _ntp,
+      max_bytes,
+      e->reader->next_read_lower_bound());
+    (void)ss::with_gate(_gate, [this, e, max_bytes] {
+        return ss::with_gate(e->prefetch_gate, [this, e, max_bytes] {
+            return e->reader->prefetch(max_bytes).then(
+              [this](size_t bytes) { _probe.add_prefetched_bytes(bytes); });
+        });
+    })
+      .handle_exception([this](const std::exception_ptr& e) {
+          vlog(stlog.debug, "{} - prefetch failed: {}", _ntp, e);
+      })
+      .finally([] { --prefetches_in_flight; });
+}
+
 ss::future<> readers_cache::maybe_evict() {
     auto now = ss::lowres_clock::now();
     co_await evict_if([this, now](entry& e) {
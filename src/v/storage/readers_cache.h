@@ -32,6 +32,10 @@ namespace storage {
  * interface to force readers eviction in face of truncation and segments
  * removal. Readers are evicted from the cache according to LRU policy and
  * automatically when they can not longer be reused (f.e. EOF).
+ *
+ * A reader that keeps being reused sequentially is returned to the cache with
+ * a read-ahead of its next slice into the batch cache, so that the next read
+ * is served from memory. Read-aheads are bounded per shard.
  */
 class readers_cache {
 public:
@@ -97,6 +101,11 @@ private:
         std::unique_ptr<log_reader> reader;
         ss::lowres_clock::time_point last_used = ss::lowres_clock::now();
         bool valid = true;
+        // consecutive reuses, each starting where the previous read ended
+        uint32_t sequential_hits = 0;
+        // held by an in-flight read-ahead, closed before the reader is
+        // disposed
+        ss::gate prefetch_gate;
         intrusive_list_hook _hook;
     };
     /**
@@ -122,6 +131,7 @@ private:
              */
             if (_e->reader->is_reusable() && _e->valid) {
                 _cache->_readers.push_back(*_e);
+                _cache->maybe_prefetch(_e);
             } else {
                 _cache->dispose_in_background(_e);
             }
@@ -133,6 +143,7 @@ private:
         readers_cache* _cache;
     };
 
+    void maybe_prefetch(entry*);
     ss::future<> maybe_evict();
     ss::future<> dispose_entries(intrusive_list<entry, &entry::_hook>);
     void dispose_in_background(intrusive_list<entry, &entry::_hook>);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "model/fundamental.h"
+#include "prometheus/partition_metrics.h"
 
 #include <seastar/core/metrics_registration.hh>
 
@@ -14,6 +15,9 @@ public:
     void reader_evicted() { _readers_evicted++; }
     void cache_hit() { _cache_hits++; }
     void cache_miss() { _cache_misses++; }
+    void prefetch_started() { _prefetches++; }
+    void prefetch_skipped() { _prefetches_skipped++; }
+    void add_prefetched_bytes(size_t bytes) { _prefetched_bytes += bytes; }
 
     void setup_metrics(const model::ntp& ntp);
 
@@ -22,7 +26,11 @@ private:
     uint64_t _readers_evicted{0};
     uint64_t _cache_misses{0};
     uint64_t _cache_hits{0};
+    uint64_t _prefetches{0};
+    uint64_t _prefetches_skipped{0};
+    uint64_t _prefetched_bytes{0};
 
     ss::metrics::metric_groups _metrics;
+    partition_metrics::registry::member _aggregated_metrics;
 };
 } // namespace storage
@@ -11,9 +11,11 @@
 
 #include "compression/compression.h"
 #include "config/configuration.h"
+#include "model/record_view.h"
 #include "storage/compacted_index_writer.h"
 #include "storage/fs_utils.h"
 #include "storage/fwd.h"
+#include "storage/header_sidecar.h"
 #include "storage/logger.h"
 #include "storage/parser_utils.h"
 #include "storage/readers_cache.h"
@@ -94,12 +96,14 @@ ss::future<> segment::remove_persistent_state() {
     vassert(is_closed(), "Cannot clear state from unclosed segment");
 
     std::vector<std::filesystem::path> rm;
-    rm.reserve(3);
+    rm.reserve(5);
     rm.emplace_back(reader().filename().c_str());
     rm.emplace_back(index().filename().c_str());
+    rm.push_back(internal::header_sidecar_path(reader().filename().c_str()));
     if (is_compacted_segment()) {
         rm.push_back(
           internal::compacted_index_path(reader().filename().c_str()));
+        rm.push_back(internal::key_index_path(reader().filename().c_str()));
     }
     vlog(stlog.info, "removing: {}", rm);
     return ss::do_with(
@@ -137,6 +141,9 @@ ss::future<> segment::do_close() {
     if (_compaction_index) {
         f = f.then([this] { return _compaction_index->close(); });
     }
+    if (_header_sidecar) {
+        f = f.then([this] { return _header_sidecar->close(); });
+    }
     // after appender flushes to make sure we make things visible
     // only after appender flush
     f = f.then([this] { return _idx.close(); });
@@ -146,13 +153,16 @@ ss::future<> segment::do_close() {
 ss::future<> segment::do_release_appender(
   segment_appender_ptr appender,
   std::optional<batch_cache_index> cache,
-  std::optional<compacted_index_writer> compacted_index) {
+  std::optional<compacted_index_writer> compacted_index,
+  segment_appender_ptr header_sidecar) {
     return ss::do_with(
       std::move(appender),
       std::move(compacted_index),
+      std::move(header_sidecar),
       [this, cache = std::move(cache)](
         segment_appender_ptr& appender,
-        std::optional<compacted_index_writer>& compacted_index) {
+        std::optional<compacted_index_writer>& compacted_index,
+        segment_appender_ptr& header_sidecar) {
           return appender->close()
             .then([this] { return _idx.flush(); })
             .then([&compacted_index] {
@@ -160,6 +170,12 @@ ss::future<> segment::do_release_appender(
                     return compacted_index->close();
                 }
                 return ss::now();
+            })
+            .then([&header_sidecar] {
+                if (header_sidecar) {
+                    return header_sidecar->close();
+                }
+                return ss::now();
             });
       });
 }
@@ -191,8 +207,9 @@ ss::future<> segment::release_appender(readers_cache* readers_cache) {
                         ? std::exchange(_cache, std::nullopt)
                         : std::nullopt;
                   auto i = std::exchange(_compaction_index, std::nullopt);
+                  auto h = std::exchange(_header_sidecar, nullptr);
                   return do_release_appender(
-                    std::move(a), std::move(c), std::move(i));
+                    std::move(a), std::move(c), std::move(i), std::move(h));
               })
               .finally([h = std::move(h)] {});
         });
@@ -213,24 +230,35 @@ void segment::release_appender_in_background(readers_cache* readers_cache) {
                ? std::exchange(_cache, std::nullopt)
                : std::nullopt;
     auto i = std::exchange(_compaction_index, std::nullopt);
+    auto s = std::exchange(_header_sidecar, nullptr);
     (void)ss::with_gate(
       _gate,
       [this,
        readers_cache,
        a = std::move(a),
        c = std::move(c),
-       i = std::move(i)]() mutable {
+       i = std::move(i),
+       s = std::move(s)]() mutable {
           return readers_cache
             ->evict_range(_tracker.base_offset, _tracker.dirty_offset)
-            .then([this, a = std::move(a), c = std::move(c), i = std::move(i)](
-                    readers_cache::range_lock_holder) mutable {
-                return write_lock().then(
-                  [this, a = std::move(a), c = std::move(c), i = std::move(i)](
-                    ss::rwlock::holder h) mutable {
-                      return do_release_appender(
-                               std::move(a), std::move(c), std::move(i))
-                        .finally([h = std::move(h)] {});
-                  });
+            .then([this,
+                   a = std::move(a),
+                   c = std::move(c),
+                   i = std::move(i),
+                   s = std::move(s)](readers_cache::range_lock_holder) mutable {
+                return write_lock().then([this,
+                                          a = std::move(a),
+                                          c = std::move(c),
+                                          i = std::move(i),
+                                          s = std::move(s)](
+                                           ss::rwlock::holder h) mutable {
+                    return do_release_appender(
+                             std::move(a),
+                             std::move(c),
+                             std::move(i),
+                             std::move(s))
+                      .finally([h = std::move(h)] {});
+                });
             });
       });
 }
@@ -241,6 +269,28 @@ ss::future<> segment::flush() {
         return do_flush().finally([h = std::move(h)] {});
     });
 }
+ss::future<> segment::write_back(ss::future<> durable) {
+    check_segment_not_closed("write_back()");
+    return read_lock().then(
+      [this, durable = std::move(durable)](ss::rwlock::holder h) mutable {
+          if (!_appender) {
+              return std::move(durable).finally([h = std::move(h)] {});
+          }
+          auto o = _tracker.dirty_offset;
+          auto fsize = _appender->file_byte_offset();
+          return ss::when_all_succeed(
+                   _appender->write_back(), std::move(durable))
+            .discard_result()
+            .then([this, o, fsize] {
+                _tracker.committed_offset = std::max(
+                  o, _tracker.committed_offset);
+                _tracker.stable_offset = _tracker.committed_offset;
+                _reader.set_file_size(std::max(fsize, _reader.file_size()));
+            })
+            .finally([h = std::move(h)] {});
+      });
+}
+
 ss::future<> segment::do_flush() {
     if (!_appender) {
         return ss::make_ready_future<>();
@@ -297,6 +347,19 @@ segment::do_truncate(model::offset prev_last_offset, size_t physical) {
           [this] { return remove_compacted_index(_reader.filename()); });
     }
 
+    // the sidecar would keep the headers of the truncated batches, the
+    // headers appended from now on are read from the data file
+    if (_header_sidecar) {
+        f = f.then([this] {
+            return ss::do_with(
+              std::exchange(_header_sidecar, nullptr),
+              [](segment_appender_ptr& s) { return s->close(); });
+        });
+    }
+    f = f.then([this] {
+        return internal::remove_header_sidecar(_reader.filename().c_str());
+    });
+
     f = f.then(
       [this, prev_last_offset] { return _idx.truncate(prev_last_offset); });
 
@@ -310,7 +373,10 @@ segment::do_truncate(model::offset prev_last_offset, size_t physical) {
                 auto cache = std::exchange(_cache, std::nullopt);
                 auto c_idx = std::exchange(_compaction_index, std::nullopt);
                 return do_release_appender(
-                  std::move(appender), std::move(cache), std::move(c_idx));
+                  std::move(appender),
+                  std::move(cache),
+                  std::move(c_idx),
+                  nullptr);
             });
         }
     } else {
@@ -344,9 +410,9 @@ void segment::cache_truncate(model::offset offset) {
 ss::future<> segment::do_compaction_index_batch(const model::record_batch& b) {
     vassert(!b.compressed(), "wrong method. Call compact_index_batch. {}", b);
     auto& w = compaction_index();
-    return model::for_each_record(
-      b, [o = b.base_offset(), &w](const model::record& r) {
-          return w.index(r.key(), o, r.offset_delta());
+    return model::for_each_record_view(
+      b, [o = b.base_offset(), &w](const model::record_view& r) {
+          return w.index(r.key_bytes(), o, r.offset_delta());
       });
 }
 ss::future<> segment::compaction_index_batch(const model::record_batch& b) {
@@ -356,11 +422,22 @@ ss::future<> segment::compaction_index_batch(const model::record_batch& b) {
     if (!b.compressed()) {
         return do_compaction_index_batch(b);
     }
-    return internal::decompress_batch(b).then([this](model::record_batch&& b) {
-        return ss::do_with(std::move(b), [this](model::record_batch& b) {
-            return do_compaction_index_batch(b);
-        });
-    });
+    // keys are extracted without decompressing the whole batch at once
+    auto& w = compaction_index();
+    return internal::for_each_compressed_record(
+      b, [o = b.base_offset(), &w](const model::record& r) {
+          return w.index(r.key(), o, r.offset_delta());
+      });
+}
+
+ss::future<> segment::header_sidecar_batch(const model::record_batch& b) {
+    if (!_header_sidecar) {
+        return ss::now();
+    }
+    auto hdrbuf = std::make_unique<iobuf>(disk_header_to_iobuf(b.header()));
+    auto ptr = hdrbuf.get();
+    return _header_sidecar->append(*ptr).finally(
+      [cpy = std::move(hdrbuf)] {});
 }
 
 ss::future<append_result> segment::append(const model::record_batch& b) {
@@ -413,7 +490,9 @@ ss::future<append_result> segment::append(const model::record_batch& b) {
             cache_put(b);
             return ret;
         });
-    auto index_fut = compaction_index_batch(b);
+    auto index_fut = ss::when_all_succeed(
+                       compaction_index_batch(b), header_sidecar_batch(b))
+                       .discard_result();
     return ss::when_all(std::move(write_fut), std::move(index_fut))
       .then([](std::tuple<ss::future<append_result>, ss::future<>> p) {
           auto& [append_fut, index_fut] = p;
@@ -449,13 +528,18 @@ ss::future<append_result> segment::append(model::record_batch&& b) {
 
 ss::input_stream<char>
 segment::offset_data_stream(model::offset o, ss::io_priority_class iopc) {
+    return offset_data_stream(o, iopc, _reader.buffer_size());
+}
+
+ss::input_stream<char> segment::offset_data_stream(
+  model::offset o, ss::io_priority_class iopc, size_t buffer_size) {
     check_segment_not_closed("offset_data_stream()");
     auto nearest = _idx.find_nearest(o);
     size_t position = 0;
     if (nearest) {
         position = nearest->filepos;
     }
-    return _reader.data_stream(position, iopc);
+    return _reader.data_stream(position, iopc, buffer_size);
 }
 
 void segment::advance_stable_offset(size_t offset) {
@@ -558,7 +642,7 @@ ss::future<ss::lw_shared_ptr<segment>> open_segment(
     // preventing x-file synchronization This is fine, because truncation to
     // sealed segments are supposed to be very rare events. The hotpath of
     // truncating the appender, is optimized.
-    return internal::make_reader_handle(path, sanitize_fileops)
+    return internal::make_segment_reader_handle(path, sanitize_fileops)
       .then([](ss::file f) {
           return f.stat().then([f](struct stat s) {
               return ss::make_ready_future<std::tuple<uint64_t, ss::file>>(
@@ -14,6 +14,8 @@
 #include "storage/batch_cache.h"
 #include "storage/compacted_index_writer.h"
 #include "storage/fwd.h"
+#include "storage/key_bloom_filter.h"
+#include "storage/key_index.h"
 #include "storage/segment_appender.h"
 #include "storage/segment_index.h"
 #include "storage/segment_reader.h"
@@ -62,6 +64,8 @@ public:
         finished_self_compaction = 1U << 1U,
         mark_tombstone = 1U << 2U,
         closed = 1U << 3U,
+        verified = 1U << 4U,
+        recompressed = 1U << 5U,
     };
 
 public:
@@ -81,6 +85,10 @@ public:
 
     ss::future<> close();
     ss::future<> flush();
+    /// \brief flush for appends made durable elsewhere, e.g. in the shard
+    /// wide write-ahead log: writes the appended data to the file without an
+    /// fsync and makes it committed once \p durable resolved as well
+    ss::future<> write_back(ss::future<> durable);
     ss::future<> release_appender(readers_cache*);
     ss::future<> truncate(model::offset, size_t physical);
 
@@ -95,6 +103,9 @@ public:
     /// main read interface
     ss::input_stream<char>
       offset_data_stream(model::offset, ss::io_priority_class);
+    /// main read interface issuing disk reads of `buffer_size` bytes
+    ss::input_stream<char> offset_data_stream(
+      model::offset, ss::io_priority_class, size_t buffer_size);
 
     const offset_tracker& offsets() const { return _tracker; }
     bool empty() const;
@@ -109,6 +120,16 @@ public:
     bool is_compacted_segment() const;
     void mark_as_finished_self_compaction();
     bool finished_self_compaction() const;
+    /// \brief set by the scrubber once the crc of every batch of a segment
+    /// without an appender was verified; cleared when the data file changes.
+    /// reads of verified segments skip the batch header crc
+    void mark_as_verified();
+    void unmark_as_verified();
+    bool is_verified() const;
+    /// \brief set by housekeeping once the data batches of a closed segment
+    /// use storage_recompression_type or could not be made smaller with it
+    void mark_as_recompressed();
+    bool is_recompressed() const;
     /// \brief used for compaction, to reset the tracker from index
     void force_set_commit_offset_from_index();
     // low level api's are discouraged and might be deprecated
@@ -123,8 +144,25 @@ public:
     bool has_appender() const;
     compacted_index_writer& compaction_index();
     const compacted_index_writer& compaction_index() const;
+    /// \brief attaches the appender of the header sidecar, see
+    /// header_sidecar.h. the headers of the batches appended from then on are
+    /// written to it
+    void set_header_sidecar(segment_appender_ptr);
+    bool has_header_sidecar() const;
 
     void release_batch_cache_index() { _cache.reset(); }
+    /// \brief key filter of the compaction index, cached by log wide
+    /// compaction once loaded. It stays valid when the index is rewritten
+    /// because rewrites only drop keys. Disengaged until loaded
+    std::optional<ss::lw_shared_ptr<const key_bloom_filter>>&
+    compaction_key_filter() {
+        return _compaction_key_filter;
+    }
+    /// \brief sorted key index last opened by log::key_query, null until
+    /// then. key_index::open tells whether it is still current
+    ss::lw_shared_ptr<const key_index>& cached_key_index() {
+        return _key_index;
+    }
     /** Cache methods */
     std::optional<std::reference_wrapper<batch_cache_index>> cache();
     std::optional<std::reference_wrapper<const batch_cache_index>>
@@ -137,7 +175,9 @@ public:
       std::optional<model::timestamp> first_ts,
       size_t max_bytes,
       bool skip_lru_promote);
-    void cache_put(const model::record_batch& batch);
+    void cache_put(
+      const model::record_batch& batch,
+      admit_on_probation = admit_on_probation::no);
 
     ss::future<ss::rwlock::holder> read_lock(
       ss::semaphore::time_point timeout = ss::semaphore::time_point::max());
@@ -157,10 +197,12 @@ private:
     ss::future<> do_release_appender(
       segment_appender_ptr,
       std::optional<batch_cache_index>,
-      std::optional<compacted_index_writer>);
+      std::optional<compacted_index_writer>,
+      segment_appender_ptr header_sidecar);
     ss::future<> remove_tombstones();
     ss::future<> compaction_index_batch(const model::record_batch&);
     ss::future<> do_compaction_index_batch(const model::record_batch&);
+    ss::future<> header_sidecar_batch(const model::record_batch&);
     void release_appender_in_background(readers_cache* readers_cache);
 
     struct appender_callbacks : segment_appender::callbacks {
@@ -184,7 +226,12 @@ private:
     bitflags _flags{bitflags::none};
     segment_appender_ptr _appender;
     std::optional<compacted_index_writer> _compaction_index;
+    segment_appender_ptr _header_sidecar;
     std::optional<batch_cache_index> _cache;
+    // a null pointer means the index has no key filter
+    std::optional<ss::lw_shared_ptr<const key_bloom_filter>>
+      _compaction_key_filter;
+    ss::lw_shared_ptr<const key_index> _key_index;
     ss::rwlock _destructive_ops;
     ss::gate _gate;
 
@@ -285,6 +332,17 @@ inline bool segment::finished_self_compaction() const {
     return (_flags & bitflags::finished_self_compaction)
            == bitflags::finished_self_compaction;
 }
+inline void segment::mark_as_verified() { _flags |= bitflags::verified; }
+inline void segment::unmark_as_verified() { _flags &= ~bitflags::verified; }
+inline bool segment::is_verified() const {
+    return (_flags & bitflags::verified) == bitflags::verified;
+}
+inline void segment::mark_as_recompressed() {
+    _flags |= bitflags::recompressed;
+}
+inline bool segment::is_recompressed() const {
+    return (_flags & bitflags::recompressed) == bitflags::recompressed;
+}
 inline std::optional<std::reference_wrapper<batch_cache_index>>
 segment::cache() {
     using ret_t = std::optional<std::reference_wrapper<batch_cache_index>>;
@@ -317,9 +375,10 @@ inline batch_cache_index::read_result segment::cache_get(
       .next_batch = offset,
     };
 }
-inline void segment::cache_put(const model::record_batch& batch) {
+inline void segment::cache_put(
+  const model::record_batch& batch, admit_on_probation probation) {
     if (likely(bool(_cache))) {
-        _cache->put(batch);
+        _cache->put(batch, probation);
     }
 }
 inline ss::future<ss::rwlock::holder>
@@ -353,6 +412,12 @@ inline compacted_index_writer& segment::compaction_index() {
 inline const compacted_index_writer& segment::compaction_index() const {
     return *_compaction_index;
 }
+inline void segment::set_header_sidecar(segment_appender_ptr s) {
+    _header_sidecar = std::move(s);
+}
+inline bool segment::has_header_sidecar() const {
+    return bool(_header_sidecar);
+}
 inline void segment::set_close() { _flags |= bitflags::closed; }
 inline bool segment::is_tombstone() const {
     return (_flags & bitflags::mark_tombstone) == bitflags::mark_tombstone;
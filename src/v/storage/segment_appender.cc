@@ -12,6 +12,7 @@
 #include "config/configuration.h"
 #include "likely.h"
 #include "storage/chunk_cache.h"
+#include "storage/flush_coordinator.h"
 #include "storage/logger.h"
 #include "vassert.h"
 #include "vlog.h"
@@ -91,6 +92,7 @@ segment_appender::segment_appender(segment_appender&& o) noexcept
   , _closed(o._closed)
   , _committed_offset(o._committed_offset)
   , _fallocation_offset(o._fallocation_offset)
+  , _fallocation_pending(std::move(o._fallocation_pending))
   , _bytes_flush_pending(o._bytes_flush_pending)
   , _concurrent_flushes(std::move(o._concurrent_flushes))
   , _head(std::move(o._head))
@@ -149,10 +151,13 @@ ss::future<> segment_appender::do_append(const char* buf, const size_t n) {
           });
     }
 
-    if (next_committed_offset() + n > _fallocation_offset) {
+    if (
+      _opts.falloc_step > 0
+      && next_committed_offset() + n > _fallocation_offset) {
         return do_next_adaptive_fallocation().then(
           [this, buf, n] { return do_append(buf, n); });
     }
+    maybe_fallocate_ahead();
 
     size_t written = 0;
     if (likely(_head)) {
@@ -311,31 +316,36 @@ ss::future<> segment_appender::close() {
 }
 
 ss::future<> segment_appender::do_next_adaptive_fallocation() {
-    return ss::with_semaphore(
-             _concurrent_flushes,
-             ss::semaphore::max_counter(),
-             [this]() mutable {
-                 vassert(
-                   _prev_head_write->available_units() == 1,
-                   "Unexpected pending head write {}",
-                   *this);
-                 // step - compute step rounded to 4096; this is needed because
-                 // during a truncation the follow up fallocation might not be
-                 // page aligned
-                 auto step = _opts.falloc_step;
-                 if (_fallocation_offset % 4096 != 0) {
-                     // add left over bytes to a full page
-                     step += 4096 - (_fallocation_offset % 4096);
-                 }
-                 vassert(
-                   _fallocation_offset >= _committed_offset,
-                   "Attempting to fallocate at {} below the committed offset "
-                   "{}",
-                   _fallocation_offset,
-                   _committed_offset);
-                 return _out.allocate(_fallocation_offset, step)
-                   .then([this, step] { _fallocation_offset += step; });
-             })
+    if (_fallocation_pending) {
+        return _fallocation_pending->get_shared_future();
+    }
+    auto pending = ss::make_lw_shared<ss::shared_promise<>>();
+    _fallocation_pending = pending;
+    (void)ss::with_semaphore(
+      _concurrent_flushes,
+      ss::semaphore::max_counter(),
+      [this]() mutable {
+          vassert(
+            _prev_head_write->available_units() == 1,
+            "Unexpected pending head write {}",
+            *this);
+          // step - compute step rounded to 4096; this is needed because
+          // during a truncation the follow up fallocation might not be
+          // page aligned
+          auto step = _opts.falloc_step;
+          if (_fallocation_offset % 4096 != 0) {
+              // add left over bytes to a full page
+              step += 4096 - (_fallocation_offset % 4096);
+          }
+          vassert(
+            _fallocation_offset >= _committed_offset,
+            "Attempting to fallocate at {} below the committed offset "
+            "{}",
+            _fallocation_offset,
+            _committed_offset);
+          return _out.allocate(_fallocation_offset, step)
+            .then([this, step] { _fallocation_offset += step; });
+      })
       .handle_exception([this](std::exception_ptr e) {
           vassert(
             false,
@@ -344,7 +354,29 @@ ss::future<> segment_appender::do_next_adaptive_fallocation() {
             "have enough space. Error: {} - {}",
             e,
             *this);
+      })
+      .then([this, pending] {
+          if (_fallocation_pending == pending) {
+              _fallocation_pending = nullptr;
+          }
+          pending->set_value();
       });
+    return pending->get_shared_future();
+}
+
+void segment_appender::maybe_fallocate_ahead() {
+    /*
+     * once the write head is within half a step of the end of the allocated
+     * extent the next one is allocated in the background, so that appends do
+     * not stall on file system metadata updates at the extent boundary.
+     */
+    if (
+      _opts.falloc_step == 0 || _fallocation_pending
+      || next_committed_offset() + _opts.falloc_step / 2
+           <= _fallocation_offset) {
+        return;
+    }
+    (void)do_next_adaptive_fallocation();
 }
 
 ss::future<> segment_appender::maybe_advance_stable_offset(
@@ -400,16 +432,31 @@ ss::future<> segment_appender::process_flush_ops(size_t committed) {
 
     _flush_ops.erase(flushable, _flush_ops.end());
 
-    return _out.flush().then([this, committed, ops = std::move(ops)]() mutable {
-        _flushed_offset = committed;
-        /*
-         * TODO: as an optimization, add a little house keeping to determine if
-         * eligible flush operations showed up while flush() was completing.
-         */
-        for (auto& op : ops) {
+    // write backs only waited on the data to be written
+    auto synced = std::partition(ops.begin(), ops.end(), [](flush_op& op) {
+        if (!op.sync) {
             op.p.set_value();
         }
+        return !op.sync;
     });
+    ops.erase(ops.begin(), synced);
+    if (ops.empty()) {
+        return ss::now();
+    }
+
+    // the flush may be coalesced with flushes of other segments on the shard
+    return internal::flushes().flush(this, _out).then(
+      [this, committed, ops = std::move(ops)]() mutable {
+          _flushed_offset = committed;
+          /*
+           * TODO: as an optimization, add a little house keeping to determine
+           * if eligible flush operations showed up while flush() was
+           * completing.
+           */
+          for (auto& op : ops) {
+              op.p.set_value();
+          }
+      });
 }
 
 void segment_appender::dispatch_background_head_write() {
@@ -535,9 +582,27 @@ ss::future<> segment_appender::flush() {
       _stable_offset,
       *this);
 
-    return _out.flush().handle_exception([this](std::exception_ptr e) {
-        vassert(false, "Could not flush: {} - {}", e, *this);
-    });
+    return internal::flushes().flush(this, _out).handle_exception(
+      [this](std::exception_ptr e) {
+          vassert(false, "Could not flush: {} - {}", e, *this);
+      });
+}
+
+ss::future<> segment_appender::write_back() {
+    _inactive_timer.cancel();
+
+    if (_head && _head->bytes_pending()) {
+        auto& w = _flush_ops.emplace_back(file_byte_offset(), false);
+        dispatch_background_head_write();
+        return w.p.get_future();
+    }
+
+    // completed once the inflight writes are, see maybe advance stable offset
+    if (!_inflight.empty()) {
+        auto& w = _flush_ops.emplace_back(file_byte_offset(), false);
+        return w.p.get_future();
+    }
+    return ss::now();
 }
 
 ss::future<> segment_appender::hard_flush() {
@@ -545,20 +610,28 @@ ss::future<> segment_appender::hard_flush() {
     if (_head && _head->bytes_pending()) {
         dispatch_background_head_write();
     }
-    return ss::with_semaphore(
-             _concurrent_flushes,
-             ss::semaphore::max_counter(),
-             [this]() mutable {
-                 vassert(
-                   _prev_head_write->available_units() == 1,
-                   "Unexpected pending head write {}",
-                   *this);
-                 vassert(
-                   _flush_ops.empty(),
-                   "Pending flushes after hard flush {}",
-                   *this);
-                 return _out.flush();
-             })
+    // a background fallocation must finish before the file is truncated or
+    // closed
+    auto fallocation = _fallocation_pending
+                         ? _fallocation_pending->get_shared_future()
+                         : ss::now();
+    return std::move(fallocation)
+      .then([this] {
+          return ss::with_semaphore(
+            _concurrent_flushes,
+            ss::semaphore::max_counter(),
+            [this]() mutable {
+                vassert(
+                  _prev_head_write->available_units() == 1,
+                  "Unexpected pending head write {}",
+                  *this);
+                vassert(
+                  _flush_ops.empty(),
+                  "Pending flushes after hard flush {}",
+                  *this);
+                return _out.flush();
+            });
+      })
       .handle_exception([this](std::exception_ptr e) {
           vassert(false, "Could not flush: {} - {}", e, *this);
       });
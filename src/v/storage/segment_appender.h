@@ -21,9 +21,11 @@
 #include <seastar/core/file.hh>
 #include <seastar/core/fstream.hh>
 #include <seastar/core/iostream.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/sstring.hh>
 
 #include <iosfwd>
+#include <optional>
 
 namespace storage {
 
@@ -49,9 +51,20 @@ public:
 
         ss::io_priority_class priority;
         size_t number_of_chunks;
+        // size of the extents preallocated ahead of the write head. zero
+        // disables preallocation and lets writes grow the file.
         size_t falloc_step{fallocation_step};
     };
 
+    /** Validator for fallocation step configuration setting */
+    static std::optional<ss::sstring>
+    validate_fallocation_step(const size_t& value) {
+        if (value % 4096 != 0) {
+            return "Fallocation step must be a multiple of 4096";
+        }
+        return std::nullopt;
+    }
+
     segment_appender(ss::file f, options opts);
     ~segment_appender() noexcept;
     segment_appender(segment_appender&&) noexcept;
@@ -70,6 +83,9 @@ public:
     ss::future<> truncate(size_t n);
     ss::future<> close();
     ss::future<> flush();
+    /// like flush() but without the fsync: resolves once the appended data
+    /// was written to the file
+    ss::future<> write_back();
 
     struct callbacks {
         virtual void committed_physical_offset(size_t) = 0;
@@ -80,6 +96,7 @@ public:
 private:
     void dispatch_background_head_write();
     ss::future<> do_next_adaptive_fallocation();
+    void maybe_fallocate_ahead();
     ss::future<> hydrate_last_half_page();
     ss::future<> do_truncation(size_t);
     ss::future<> do_append(const char* buf, const size_t n);
@@ -103,15 +120,21 @@ private:
     bool _closed{false};
     size_t _committed_offset{0};
     size_t _fallocation_offset{0};
+    // set while an fallocation is queued or running. appends that run into
+    // the end of the allocated extent wait on it instead of queuing another.
+    ss::lw_shared_ptr<ss::shared_promise<>> _fallocation_pending;
     size_t _bytes_flush_pending{0};
     ss::semaphore _concurrent_flushes;
     ss::lw_shared_ptr<chunk> _head;
     ss::lw_shared_ptr<ss::semaphore> _prev_head_write;
 
     struct flush_op {
-        explicit flush_op(size_t offset)
-          : offset(offset) {}
+        explicit flush_op(size_t offset, bool sync = true)
+          : offset(offset)
+          , sync(sync) {}
         size_t offset;
+        // false for write_back(), which does not wait on an fsync
+        bool sync;
         ss::promise<> p;
     };
 
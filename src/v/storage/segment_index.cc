@@ -10,8 +10,10 @@
 #include "storage/segment_index.h"
 
 #include "model/timestamp.h"
+#include "resource_mgmt/memory_groups.h"
 #include "storage/logger.h"
 #include "vassert.h"
+#include "vlog.h"
 
 #include <seastar/core/fstream.hh>
 #include <seastar/core/iostream.hh>
@@ -34,6 +36,61 @@ static inline segment_index::entry translate_index_entry(
     };
 }
 
+/// Shard-wide LRU of the hydrated indices of closed segments. Once the total
+/// goes above memory_groups::segment_index_max_memory() the least recently
+/// used indices drop their entries; they are re-read on the next hydrate().
+class segment_index_tracker {
+public:
+    void track(segment_index& idx) {
+        untrack(idx);
+        idx._tracked_bytes = idx._state.memory_usage();
+        _bytes += idx._tracked_bytes;
+        _lru.push_front(idx);
+        evict_to_budget(idx);
+    }
+
+    void touch(segment_index& idx) {
+        if (idx._hydrated_hook.is_linked()) {
+            idx._hydrated_hook.unlink();
+            _lru.push_front(idx);
+        }
+    }
+
+    void untrack(segment_index& idx) noexcept {
+        if (idx._hydrated_hook.is_linked()) {
+            idx._hydrated_hook.unlink();
+        }
+        _bytes -= std::exchange(idx._tracked_bytes, 0);
+    }
+
+    size_t bytes() const { return _bytes; }
+
+private:
+    void evict_to_budget(const segment_index& keep) {
+        auto it = _lru.end();
+        while (_bytes > _budget && it != _lru.begin()) {
+            auto candidate = std::prev(it);
+            // a successful eviction unlinks the candidate, leaving `it` valid
+            if (&*candidate == &keep || !candidate->evict()) {
+                it = candidate;
+            }
+        }
+    }
+
+    intrusive_list<segment_index, &segment_index::_hydrated_hook> _lru;
+    size_t _bytes{0};
+    const size_t _budget{memory_groups::segment_index_max_memory()};
+};
+
+static segment_index_tracker& hydrated_indices() {
+    static thread_local segment_index_tracker tracker;
+    return tracker;
+}
+
+size_t segment_index::hydrated_memory_usage() {
+    return hydrated_indices().bytes();
+}
+
 segment_index::segment_index(
   ss::sstring filename, ss::file f, model::offset base, size_t step)
   : _name(std::move(filename))
@@ -42,17 +99,82 @@ segment_index::segment_index(
     _state.base_offset = base;
 }
 
+segment_index::segment_index(segment_index&& o) noexcept
+  : _name(std::move(o._name))
+  , _out(std::move(o._out))
+  , _step(o._step)
+  , _acc(o._acc)
+  , _needs_persistence(o._needs_persistence)
+  , _evicted(o._evicted)
+  , _state(std::move(o._state))
+  , _tracked_bytes(std::exchange(o._tracked_bytes, 0)) {
+    _hydrated_hook.swap_nodes(o._hydrated_hook);
+}
+
+segment_index& segment_index::operator=(segment_index&& o) noexcept {
+    if (this != &o) {
+        untrack_hydrated();
+        _name = std::move(o._name);
+        _out = std::move(o._out);
+        _step = o._step;
+        _acc = o._acc;
+        _needs_persistence = o._needs_persistence;
+        _evicted = o._evicted;
+        _state = std::move(o._state);
+        _tracked_bytes = std::exchange(o._tracked_bytes, 0);
+        _hydrated_hook.swap_nodes(o._hydrated_hook);
+    }
+    return *this;
+}
+
+segment_index::~segment_index() noexcept { untrack_hydrated(); }
+
+void segment_index::track_hydrated() { hydrated_indices().track(*this); }
+
+void segment_index::untrack_hydrated() { hydrated_indices().untrack(*this); }
+
+bool segment_index::evict() {
+    if (_needs_persistence || _evicted) {
+        return false;
+    }
+    untrack_hydrated();
+    _state.drop_entries();
+    _evicted = true;
+    return true;
+}
+
+ss::future<> segment_index::hydrate() {
+    if (!_evicted) {
+        hydrated_indices().touch(*this);
+        return ss::now();
+    }
+    return do_materialize_index().then([this](bool ok) {
+        _evicted = false;
+        if (!ok) {
+            // keep the resident header: lookups scan from the segment start
+            vlog(stlog.info, "Could not re-hydrate evicted index {}", _name);
+            return;
+        }
+        track_hydrated();
+    });
+}
+
 void segment_index::reset() {
+    untrack_hydrated();
     auto base = _state.base_offset;
     _state = {};
     _state.base_offset = base;
     _acc = 0;
+    _evicted = false;
 }
 
 void segment_index::swap_index_state(index_state&& o) {
     _needs_persistence = true;
     _acc = 0;
+    _evicted = false;
     std::swap(_state, o);
+    // tracked but not evictable until the new state is flushed
+    track_hydrated();
 }
 
 void segment_index::maybe_track(
@@ -80,16 +202,11 @@ segment_index::find_nearest(model::timestamp t) {
         return std::nullopt;
     }
     const uint32_t i = t() - _state.base_timestamp();
-    auto it = std::lower_bound(
-      std::begin(_state.relative_time_index),
-      std::end(_state.relative_time_index),
-      i,
-      std::less<uint32_t>{});
-    if (it == _state.relative_offset_index.end()) {
+    const size_t idx = _state.lower_bound_relative_time(i);
+    if (idx == _state.entries()) {
         return std::nullopt;
     }
-    auto dist = std::distance(_state.relative_offset_index.begin(), it);
-    return translate_index_entry(_state, _state.get_entry(dist));
+    return translate_index_entry(_state, _state.get_entry(idx));
 }
 
 std::optional<segment_index::entry>
@@ -98,18 +215,14 @@ segment_index::find_nearest(model::offset o) {
         return std::nullopt;
     }
     const uint32_t needle = o() - _state.base_offset();
-    auto it = std::lower_bound(
-      std::begin(_state.relative_offset_index),
-      std::end(_state.relative_offset_index),
-      needle,
-      std::less<uint32_t>{});
-    if (it == _state.relative_offset_index.end()) {
-        it = std::prev(it);
+    size_t idx = _state.lower_bound_relative_offset(needle);
+    if (idx == _state.entries()) {
+        idx = idx - 1;
     }
     // make it signed so it can be negative
-    int i = std::distance(_state.relative_offset_index.begin(), it);
+    int i = idx;
     do {
-        if (_state.relative_offset_index[i] <= needle) {
+        if (_state.relative_offset(i) <= needle) {
             return translate_index_entry(_state, _state.get_entry(i));
         }
     } while (i-- > 0);
@@ -121,20 +234,15 @@ ss::future<> segment_index::truncate(model::offset o) {
     if (o < _state.base_offset) {
         return ss::now();
     }
+    if (_evicted) {
+        return hydrate().then([this, o] { return truncate(o); });
+    }
     const uint32_t i = o() - _state.base_offset();
-    auto it = std::lower_bound(
-      std::begin(_state.relative_offset_index),
-      std::end(_state.relative_offset_index),
-      i,
-      std::less<uint32_t>{});
+    const size_t idx = _state.lower_bound_relative_offset(i);
 
-    if (it != _state.relative_offset_index.end()) {
+    if (idx != _state.entries()) {
         _needs_persistence = true;
-        int remove_back_elems = std::distance(
-          it, _state.relative_offset_index.end());
-        while (remove_back_elems-- > 0) {
-            _state.pop_back();
-        }
+        _state.pop_back(_state.entries() - idx);
         if (_state.empty()) {
             _state.max_timestamp = _state.base_timestamp;
             _state.max_offset = _state.base_offset;
@@ -148,6 +256,15 @@ ss::future<> segment_index::truncate(model::offset o) {
 }
 
 ss::future<bool> segment_index::materialize_index() {
+    return do_materialize_index().then([this](bool ok) {
+        if (ok) {
+            track_hydrated();
+        }
+        return ok;
+    });
+}
+
+ss::future<bool> segment_index::do_materialize_index() {
     return _out.size()
       .then([this](uint64_t size) mutable {
           return _out.dma_read_bulk<char>(0, size);
@@ -156,13 +273,14 @@ ss::future<bool> segment_index::materialize_index() {
           if (buf.empty()) {
               return false;
           }
-          iobuf b;
-          b.append(std::move(buf));
-          auto hydrated = index_state::hydrate_from_buffer(std::move(b));
+          // dma buffers are aligned, so v4 indices are searched in place
+          auto hydrated = index_state::hydrate_from_buffer(std::move(buf));
           if (!hydrated) {
               return false;
           }
           _state = std::move(hydrated.value());
+          // legacy (by value) encodings are rewritten on the next flush
+          _needs_persistence = !_state.empty() && !_state.is_mapped();
           return true;
       });
 }
@@ -202,7 +320,8 @@ ss::future<> segment_index::close() {
 std::ostream& operator<<(std::ostream& o, const segment_index& i) {
     return o << "{file:" << i.filename() << ", offsets:" << i.base_offset()
              << ", index:" << i._state << ", step:" << i._step
-             << ", needs_persistence:" << i._needs_persistence << "}";
+             << ", needs_persistence:" << i._needs_persistence
+             << ", evicted:" << i._evicted << "}";
 }
 std::ostream& operator<<(std::ostream& o, const segment_index_ptr& i) {
     if (i) {
@@ -14,6 +14,7 @@
 #include "model/record.h"
 #include "model/timestamp.h"
 #include "storage/index_state.h"
+#include "utils/intrusive_list_helpers.h"
 
 #include <seastar/core/file.hh>
 #include <seastar/core/unaligned.hh>
@@ -50,18 +51,32 @@ public:
 
     segment_index(
       ss::sstring filename, ss::file, model::offset base, size_t step);
-    ~segment_index() noexcept = default;
-    segment_index(segment_index&&) noexcept = default;
-    segment_index& operator=(segment_index&&) noexcept = default;
+    ~segment_index() noexcept;
+    segment_index(segment_index&&) noexcept;
+    segment_index& operator=(segment_index&&) noexcept;
     segment_index(const segment_index&) = delete;
     segment_index& operator=(const segment_index&) = delete;
 
     void maybe_track(const model::record_batch_header&, size_t filepos);
+    /// \brief returns std::nullopt when the entries are evicted; callers
+    /// then fall back to scanning from the start of the segment. readers on
+    /// the hot path should call `hydrate()` first.
     std::optional<entry> find_nearest(model::offset);
     std::optional<entry> find_nearest(model::timestamp);
 
+    /// \brief re-reads evicted entries from disk and marks the index as
+    /// recently used. a no-op for indices that were never evicted.
+    ss::future<> hydrate();
+    bool is_evicted() const { return _evicted; }
+
+    /// \brief bytes held by hydrated indices of closed segments on this
+    /// shard, bounded by memory_groups::segment_index_max_memory()
+    static size_t hydrated_memory_usage();
+
     model::offset base_offset() const { return _state.base_offset; }
     model::offset max_offset() const { return _state.max_offset; }
+    /// \brief checksum of the last persisted or hydrated index state
+    uint64_t checksum() const { return _state.checksum; }
     model::timestamp max_timestamp() const { return _state.max_timestamp; }
     model::timestamp base_timestamp() const { return _state.base_timestamp; }
     const ss::sstring& filename() const { return _name; }
@@ -84,13 +99,25 @@ public:
     index_state release_index_state() && { return std::move(_state); }
 
 private:
+    ss::future<bool> do_materialize_index();
+    void track_hydrated();
+    void untrack_hydrated();
+    /// \brief drops the entries, keeping base/max offsets and timestamps
+    bool evict();
+
     ss::sstring _name;
     ss::file _out;
     size_t _step;
     size_t _acc{0};
     bool _needs_persistence{false};
+    bool _evicted{false};
     index_state _state;
 
+    // closed segment indices hydrated from disk are kept in a shard-wide LRU
+    intrusive_list_hook _hydrated_hook;
+    size_t _tracked_bytes{0};
+
+    friend class segment_index_tracker;
     friend std::ostream& operator<<(std::ostream&, const segment_index&);
 };
 
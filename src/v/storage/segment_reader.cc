@@ -17,8 +17,13 @@
 #include <seastar/core/reactor.hh>
 #include <seastar/core/sstring.hh>
 
+#include <algorithm>
+
 namespace storage {
 
+// number of reads of the default buffer size kept in flight by a stream
+static constexpr size_t default_read_ahead = 10;
+
 segment_reader::segment_reader(
   ss::sstring filename,
   ss::file data_file,
@@ -29,19 +34,30 @@ segment_reader::segment_reader(
   , _file_size(file_size)
   , _buffer_size(buffer_size) {}
 
+ss::file_input_stream_options segment_reader::stream_options(
+  const ss::io_priority_class& pc, size_t buffer_size) const {
+    ss::file_input_stream_options options;
+    options.buffer_size = buffer_size;
+    options.io_priority_class = pc;
+    options.read_ahead = std::max<size_t>(
+      2, default_read_ahead * _buffer_size / buffer_size);
+    return options;
+}
+
 ss::input_stream<char>
 segment_reader::data_stream(size_t pos, const ss::io_priority_class& pc) {
+    return data_stream(pos, pc, _buffer_size);
+}
+
+ss::input_stream<char> segment_reader::data_stream(
+  size_t pos, const ss::io_priority_class& pc, size_t buffer_size) {
     vassert(
       pos <= _file_size,
       "cannot read negative bytes. Asked to read at position: '{}' - {}",
       pos,
       *this);
-    ss::file_input_stream_options options;
-    options.buffer_size = _buffer_size;
-    options.io_priority_class = pc;
-    options.read_ahead = 10;
     return make_file_input_stream(
-      _data_file, pos, _file_size - pos, std::move(options));
+      _data_file, pos, _file_size - pos, stream_options(pc, buffer_size));
 }
 
 ss::input_stream<char> segment_reader::data_stream(
@@ -58,12 +74,11 @@ ss::input_stream<char> segment_reader::data_stream(
       pos_begin,
       pos_end,
       *this);
-    ss::file_input_stream_options options;
-    options.buffer_size = _buffer_size;
-    options.io_priority_class = pc;
-    options.read_ahead = 10;
     return make_file_input_stream(
-      _data_file, pos_begin, pos_end - pos_begin, std::move(options));
+      _data_file,
+      pos_begin,
+      pos_end - pos_begin,
+      stream_options(pc, _buffer_size));
 }
 
 ss::future<> segment_reader::truncate(size_t n) {
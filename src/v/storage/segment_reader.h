@@ -43,6 +43,9 @@ public:
     void set_file_size(size_t o) { _file_size = o; }
     size_t file_size() const { return _file_size; }
 
+    /// default size of the reads issued by data streams
+    size_t buffer_size() const { return _buffer_size; }
+
     /// file name
     const ss::sstring& filename() const { return _filename; }
 
@@ -64,10 +67,18 @@ public:
     /// starting at position @pos
     ss::input_stream<char>
     data_stream(size_t pos, const ss::io_priority_class&);
+    /// same as above but issues reads of `buffer_size` bytes instead of the
+    /// reader default. the number of reads kept in flight is scaled down so
+    /// that large reads do not multiply the memory held by the stream.
+    ss::input_stream<char> data_stream(
+      size_t pos, const ss::io_priority_class&, size_t buffer_size);
     ss::input_stream<char>
     data_stream(size_t pos_begin, size_t pos_end, const ss::io_priority_class&);
 
 private:
+    ss::file_input_stream_options
+    stream_options(const ss::io_priority_class&, size_t buffer_size) const;
+
     ss::sstring _filename;
     ss::file _data_file;
     size_t _file_size{0};
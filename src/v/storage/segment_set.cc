@@ -16,13 +16,18 @@
 #include "vassert.h"
 #include "vlog.h"
 
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/loop.hh>
 #include <seastar/core/seastar.hh>
 #include <seastar/core/thread.hh>
+#include <seastar/util/defer.hh>
 
+#include <boost/range/irange.hpp>
 #include <fmt/format.h>
+#include <fmt/ostream.h>
 
+#include <chrono>
 #include <exception>
 
 namespace storage {
@@ -55,13 +60,61 @@ void segment_set::add(ss::lw_shared_ptr<segment> h) {
           *h,
           *this);
     }
+    if (!_max_timestamps_dirty && !_handles.empty()) {
+        // the previous tail is no longer appended to, fold it in the summary
+        auto ts = _handles.back()->index().max_timestamp();
+        if (!_max_timestamps.empty()) {
+            ts = std::max(ts, _max_timestamps.back());
+        }
+        _max_timestamps.push_back(ts);
+    }
     _handles.emplace_back(std::move(h));
 }
 
-void segment_set::pop_back() { _handles.pop_back(); }
-void segment_set::pop_front() { _handles.pop_front(); }
+void segment_set::pop_back() {
+    _handles.pop_back();
+    _max_timestamps_dirty = true;
+}
+void segment_set::pop_front() {
+    _handles.pop_front();
+    _max_timestamps_dirty = true;
+}
 void segment_set::erase(iterator begin, iterator end) {
     _handles.erase(begin, end);
+    _max_timestamps_dirty = true;
+}
+
+void segment_set::rebuild_max_timestamps() const {
+    _max_timestamps.clear();
+    if (!_handles.empty()) {
+        _max_timestamps.reserve(_handles.size() - 1);
+    }
+    auto running = model::timestamp::min();
+    for (size_t i = 0; i + 1 < _handles.size(); ++i) {
+        running = std::max(running, _handles[i]->index().max_timestamp());
+        _max_timestamps.push_back(running);
+    }
+    _max_timestamps_dirty = false;
+}
+
+/// index of the first segment that may hold a timestamp >= needle, or size()
+size_t segment_set::max_timestamp_lower_bound(model::timestamp needle) const {
+    if (_handles.empty()) {
+        return 0;
+    }
+    if (_max_timestamps_dirty) {
+        rebuild_max_timestamps();
+    }
+    auto it = std::lower_bound(
+      _max_timestamps.begin(), _max_timestamps.end(), needle);
+    if (it != _max_timestamps.end()) {
+        return std::distance(_max_timestamps.begin(), it);
+    }
+    // only the active segment is left, its index is read live
+    if (_handles.back()->index().max_timestamp() >= needle) {
+        return _handles.size() - 1;
+    }
+    return _handles.size();
 }
 
 template<typename Iterator>
@@ -130,15 +183,16 @@ segment_set::lower_bound(model::offset offset) const {
 // entry is greater than the target timestamp, the broker will do binary search
 // on that time index to find the closest index entry and scan the log from
 // there. Otherwise it will move on to the next log segment.
+//
+// The per-segment max timestamps are summarized in `_max_timestamps` so that
+// this search does not touch the segment indices at all.
 segment_set::iterator segment_set::lower_bound(model::timestamp needle) {
-    return std::lower_bound(
-      std::begin(_handles), std::end(_handles), needle, segment_ordering{});
+    return std::next(_handles.begin(), max_timestamp_lower_bound(needle));
 }
 
 segment_set::const_iterator
 segment_set::lower_bound(model::timestamp needle) const {
-    return segments_lower_bound(
-      std::cbegin(_handles), std::cend(_handles), needle);
+    return std::next(_handles.cbegin(), max_timestamp_lower_bound(needle));
 }
 
 std::ostream& operator<<(std::ostream& o, const segment_set& s) {
@@ -149,12 +203,82 @@ std::ostream& operator<<(std::ostream& o, const segment_set& s) {
     return o << "]}";
 }
 
+ss::future<clean_shutdown_record>
+clean_shutdown_record::make(const segment_set& segs) {
+    clean_shutdown_record r;
+    r.segments.reserve(segs.size());
+    for (const auto& s : segs) {
+        // the appender is closed, so the file holds exactly the segment data
+        auto size = co_await ss::file_size(s->reader().filename());
+        r.segments.push_back(segment_meta{
+          .base_offset = s->offsets().base_offset,
+          .dirty_offset = s->offsets().dirty_offset,
+          .file_size = size,
+          .index_checksum = s->index().checksum()});
+    }
+    co_return r;
+}
+
+static bool matches(
+  const clean_shutdown_record::segment_meta& m, const segment& s) {
+    return m.base_offset == s.offsets().base_offset
+           && m.dirty_offset == s.offsets().dirty_offset
+           && m.index_checksum == s.index().checksum();
+}
+
+/// \brief whether \p last can be trusted without a replay. all the other
+/// segments must have materialized their index and match the record.
+static bool is_clean_shutdown_in_thread(
+  const clean_shutdown_record& record,
+  const segment_set::underlying_t& good,
+  segment& last) {
+    if (record.segments.size() != good.size() + 1) {
+        return false;
+    }
+    for (size_t i = 0; i < good.size(); ++i) {
+        if (!matches(record.segments[i], *good[i])) {
+            return false;
+        }
+    }
+    const auto& meta = record.segments.back();
+    if (
+      meta.base_offset != last.offsets().base_offset
+      || meta.file_size == 0) {
+        return false;
+    }
+    try {
+        if (
+          last.reader().stat().get0().st_size != (off_t)meta.file_size
+          || !last.materialize_index().get0()) {
+            return false;
+        }
+    } catch (...) {
+        vlog(
+          stlog.info,
+          "Error validating clean shutdown of segment:{}. Details:{}",
+          last,
+          std::current_exception());
+        return false;
+    }
+    // a mismatch leaves offsets behind that the replay below overwrites
+    return matches(meta, last);
+}
+
 // Recover the last segment. Whenever we close a segment, we will likely
 // open a new one to which we will direct new writes. That new segment
-// might be empty. To optimize log replay, implement #140.
-static ss::future<segment_set>
-unsafe_do_recover(segment_set&& segments, ss::abort_source& as) {
-    return ss::async([segments = std::move(segments), &as]() mutable {
+// might be empty. A log that was closed cleanly skips the replay when its
+// segments still match the record written on close.
+static ss::future<segment_set> unsafe_do_recover(
+  segment_set&& segments,
+  ss::abort_source& as,
+  size_t io_concurrency,
+  recovery_timings& timings,
+  std::optional<clean_shutdown_record> clean_shutdown) {
+    return ss::async([segments = std::move(segments),
+                      &as,
+                      io_concurrency,
+                      &timings,
+                      clean_shutdown = std::move(clean_shutdown)]() mutable {
         if (segments.empty() || as.abort_requested()) {
             return std::move(segments);
         }
@@ -162,32 +286,59 @@ unsafe_do_recover(segment_set&& segments, ss::abort_source& as) {
         segment_set::underlying_t to_recover;
         to_recover.push_back(std::move(good.back()));
         good.pop_back(); // always recover last segment
+
+        // index files are independent of each other, check them concurrently
+        auto index_start = std::chrono::steady_clock::now();
+        std::vector<char> materialized(good.size(), false);
+        ss::max_concurrent_for_each(
+          boost::irange<size_t>(0, good.size()),
+          io_concurrency,
+          [&good, &materialized](size_t i) {
+              auto& s = *good[i];
+              // use the segment materialize instead of going through
+              // the index directly to hydrate the max_offset state
+              return s.materialize_index()
+                .then([&materialized, i](bool ok) { materialized[i] = ok; })
+                .handle_exception([&s](const std::exception_ptr& e) {
+                    vlog(
+                      stlog.info,
+                      "Error materializing index:{}. Recovering parent "
+                      "segment:{}. Details:{}",
+                      s.index().filename(),
+                      s.reader().filename(),
+                      e);
+                });
+          })
+          .get();
+        timings.index_check += std::chrono::steady_clock::now() - index_start;
+
         // keep segments sorted
-        auto good_end = std::stable_partition(
-          good.begin(), good.end(), [](ss::lw_shared_ptr<segment>& ss) {
-              auto& s = *ss;
-              try {
-                  // use the segment materialize instead of going through
-                  // the index directly to hydrate the max_offset state
-                  return s.materialize_index().get0();
-              } catch (...) {
-                  vlog(
-                    stlog.info,
-                    "Error materializing index:{}. Recovering parent "
-                    "segment:{}. Details:{}",
-                    s.index().filename(),
-                    s.reader().filename(),
-                    std::current_exception());
-              }
-              return false;
-          });
-        std::move(
-          std::move_iterator(good_end),
-          std::move_iterator(good.end()),
-          std::back_inserter(to_recover));
-        good.erase(
-          good_end,
-          good.end()); // remove all the ones we copied into recover
+        segment_set::underlying_t materialized_segments;
+        for (size_t i = 0; i < good.size(); ++i) {
+            if (materialized[i]) {
+                materialized_segments.push_back(std::move(good[i]));
+            } else {
+                to_recover.push_back(std::move(good[i]));
+            }
+        }
+        good = std::move(materialized_segments);
+
+        if (
+          clean_shutdown && to_recover.size() == 1
+          && is_clean_shutdown_in_thread(
+            *clean_shutdown, good, *to_recover.front())) {
+            vlog(
+              stlog.debug,
+              "Skipping recovery of cleanly closed segment: {}",
+              to_recover.front());
+            good.push_back(std::move(to_recover.front()));
+            return segment_set(std::move(good));
+        }
+
+        auto replay_start = std::chrono::steady_clock::now();
+        auto account_replay = ss::defer([&timings, replay_start] {
+            timings.replay += std::chrono::steady_clock::now() - replay_start;
+        });
 
         // remove empty segments
         auto non_empty_end = std::stable_partition(
@@ -218,6 +369,7 @@ unsafe_do_recover(segment_set&& segments, ss::abort_source& as) {
             if (unlikely(as.abort_requested())) {
                 return segment_set(std::move(good));
             }
+            ++timings.replayed_segments;
             auto replayer = log_replayer(*s);
             auto recovered = replayer.recover_in_thread(
               ss::default_priority_class());
@@ -243,8 +395,12 @@ unsafe_do_recover(segment_set&& segments, ss::abort_source& as) {
     });
 }
 
-static ss::future<segment_set>
-do_recover(segment_set&& segments, ss::abort_source& as) {
+static ss::future<segment_set> do_recover(
+  segment_set&& segments,
+  ss::abort_source& as,
+  size_t io_concurrency,
+  recovery_timings& timings,
+  std::optional<clean_shutdown_record> clean_shutdown) {
     // light-weight copy used for clean-up if recovery fails
     segment_set::underlying_t copy;
     copy.reserve(segments.size());
@@ -256,7 +412,12 @@ do_recover(segment_set&& segments, ss::abort_source& as) {
     // are any pending io operations on a file associated with the segment
     // at the time of destruction seastar will complain about the file handle
     // being destroyed with pending ops.
-    return unsafe_do_recover(std::move(segments), as)
+    return unsafe_do_recover(
+             std::move(segments),
+             as,
+             io_concurrency,
+             timings,
+             std::move(clean_shutdown))
       .handle_exception(
         [copy = std::move(copy)](const std::exception_ptr& ex) mutable {
             return ss::do_with(
@@ -279,60 +440,71 @@ do_recover(segment_set&& segments, ss::abort_source& as) {
 /**
  * \brief Open all segments in a directory.
  *
- * Returns an exceptional future if any error occured opening a
- * segment. Otherwise all open segment readers are returned.
+ * The directory is listed first and then up to \p io_concurrency segments
+ * are opened at once. Returns an exceptional future if any error occured
+ * opening a segment. Otherwise all open segment readers are returned.
  */
 static ss::future<segment_set::underlying_t> open_segments(
   ss::sstring dir,
   debug_sanitize_files sanitize_fileops,
   std::function<std::optional<batch_cache_index>()> cache_factory,
-  ss::abort_source& as) {
+  ss::abort_source& as,
+  size_t io_concurrency,
+  recovery_timings& timings) {
     using segs_type = segment_set::underlying_t;
-    return ss::do_with(
-      segs_type{},
-      [&as, cache_factory, sanitize_fileops, dir = std::move(dir)](
-        segs_type& segs) {
-          auto f = directory_walker::walk(
-            dir,
-            [&as, cache_factory, dir, sanitize_fileops, &segs](
-              ss::directory_entry seg) {
-                // abort if requested
-                if (as.abort_requested()) {
-                    return ss::now();
-                }
-                /*
-                 * Skip non-regular files (including links)
-                 */
-                if (
-                  !seg.type || *seg.type != ss::directory_entry_type::regular) {
-                    return ss::make_ready_future<>();
-                }
-                auto path = std::filesystem::path(
-                  fmt::format("{}/{}", dir, seg.name));
-                try {
-                    auto is_valid = segment_path::parse_segment_filename(
-                      path.filename().string());
-                    if (!is_valid) {
-                        return ss::make_ready_future<>();
-                    }
-                } catch (...) {
-                    // not a reader filename
-                    return ss::make_ready_future<>();
-                }
-                return open_segment(path, sanitize_fileops, cache_factory())
-                  .then([&segs](ss::lw_shared_ptr<segment> p) {
-                      segs.push_back(std::move(p));
-                  });
-            });
+    std::vector<std::filesystem::path> paths;
+    auto listing_start = std::chrono::steady_clock::now();
+    co_await directory_walker::walk(
+      dir, [&as, &dir, &paths](ss::directory_entry seg) {
+          // abort if requested
+          if (as.abort_requested()) {
+              return ss::now();
+          }
           /*
-           * if the directory walker returns an exceptional future then all
-           * the segment readers that were created are cleaned up by
-           * ss::do_with.
+           * Skip non-regular files (including links)
            */
-          return f.then([&segs]() mutable {
-              return ss::make_ready_future<segs_type>(std::move(segs));
-          });
+          if (!seg.type || *seg.type != ss::directory_entry_type::regular) {
+              return ss::now();
+          }
+          auto path = std::filesystem::path(
+            fmt::format("{}/{}", dir, seg.name));
+          try {
+              auto is_valid = segment_path::parse_segment_filename(
+                path.filename().string());
+              if (!is_valid) {
+                  return ss::now();
+              }
+          } catch (...) {
+              // not a reader filename
+              return ss::now();
+          }
+          paths.push_back(std::move(path));
+          return ss::now();
+      });
+    auto open_start = std::chrono::steady_clock::now();
+    timings.listing += open_start - listing_start;
+
+    /*
+     * if opening any segment fails then all the segment readers that were
+     * created are cleaned up with the coroutine frame.
+     */
+    segs_type segs;
+    co_await ss::max_concurrent_for_each(
+      paths,
+      io_concurrency,
+      [&as, &cache_factory, &segs, sanitize_fileops](
+        const std::filesystem::path& path) {
+          if (as.abort_requested()) {
+              return ss::now();
+          }
+          return open_segment(path, sanitize_fileops, cache_factory())
+            .then([&segs](ss::lw_shared_ptr<segment> p) {
+                segs.push_back(std::move(p));
+            });
       });
+    timings.open += std::chrono::steady_clock::now() - open_start;
+    timings.segments += segs.size();
+    co_return segs;
 }
 
 ss::future<segment_set> recover_segments(
@@ -340,13 +512,35 @@ ss::future<segment_set> recover_segments(
   debug_sanitize_files sanitize_fileops,
   bool is_compaction_enabled,
   std::function<std::optional<batch_cache_index>()> cache_factory,
-  ss::abort_source& as) {
+  ss::abort_source& as,
+  size_t io_concurrency,
+  recovery_timings* timings,
+  std::optional<clean_shutdown_record> clean_shutdown) {
+    // recovery of a single log is accounted into a local and only reported
+    // when it completes
+    auto local = ss::make_lw_shared<recovery_timings>();
+    io_concurrency = std::max<size_t>(io_concurrency, 1);
     return ss::recursive_touch_directory(path.string())
-      .then([&as, cache_factory, sanitize_fileops, path = std::move(path)] {
+      .then([&as,
+             cache_factory,
+             sanitize_fileops,
+             io_concurrency,
+             local,
+             path = std::move(path)] {
           return open_segments(
-            path.string(), sanitize_fileops, cache_factory, as);
+            path.string(),
+            sanitize_fileops,
+            cache_factory,
+            as,
+            io_concurrency,
+            *local);
       })
-      .then([&as, is_compaction_enabled](segment_set::underlying_t segs) {
+      .then([&as,
+             is_compaction_enabled,
+             io_concurrency,
+             local,
+             clean_shutdown = std::move(clean_shutdown)](
+              segment_set::underlying_t segs) mutable {
           auto segments = segment_set(std::move(segs));
           // we have to mark compacted segments before recovery to allow reading
           // gaps introduced by compaction
@@ -355,8 +549,45 @@ ss::future<segment_set> recover_segments(
                   s->mark_as_compacted_segment();
               }
           }
-          return do_recover(std::move(segments), as);
+          return do_recover(
+            std::move(segments),
+            as,
+            io_concurrency,
+            *local,
+            std::move(clean_shutdown));
+      })
+      .then([local, timings](segment_set segments) {
+          if (timings) {
+              *timings += *local;
+          }
+          return segments;
       });
 }
 
+recovery_timings& recovery_timings::operator+=(const recovery_timings& o) {
+    listing += o.listing;
+    open += o.open;
+    index_check += o.index_check;
+    replay += o.replay;
+    segments += o.segments;
+    replayed_segments += o.replayed_segments;
+    return *this;
+}
+
+std::ostream& operator<<(std::ostream& o, const recovery_timings& t) {
+    using std::chrono::duration_cast;
+    using std::chrono::milliseconds;
+    fmt::print(
+      o,
+      "{{listing: {}ms, open: {}ms, index_check: {}ms, replay: {}ms, "
+      "segments: {}, replayed_segments: {}}}",
+      duration_cast<milliseconds>(t.listing).count(),
+      duration_cast<milliseconds>(t.open).count(),
+      duration_cast<milliseconds>(t.index_check).count(),
+      duration_cast<milliseconds>(t.replay).count(),
+      t.segments,
+      t.replayed_segments);
+    return o;
+}
+
 } // namespace storage
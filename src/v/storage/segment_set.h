@@ -15,7 +15,11 @@
 
 #include <seastar/core/circular_buffer.hh>
 
+#include <chrono>
 #include <deque>
+#include <iosfwd>
+#include <optional>
+#include <vector>
 
 namespace storage {
 /*
@@ -62,7 +66,11 @@ public:
     void pop_front();
     void erase(iterator begin, iterator end);
 
-    underlying_t release() && { return std::move(_handles); }
+    underlying_t release() && {
+        _max_timestamps.clear();
+        _max_timestamps_dirty = true;
+        return std::move(_handles);
+    }
     type& back() { return _handles.back(); }
     const type& back() const { return _handles.back(); }
     const type& front() const { return _handles.front(); }
@@ -82,17 +90,72 @@ public:
     const_iterator end() const { return _handles.end(); }
 
 private:
+    void rebuild_max_timestamps() const;
+    size_t max_timestamp_lower_bound(model::timestamp) const;
+
     underlying_t _handles;
 
+    // running maximum of index().max_timestamp() for every segment except the
+    // last one, which is being appended to and is always read live. the
+    // running max is monotonic by construction, so a timequery can pick its
+    // starting segment with a binary search over this compact vector instead
+    // of chasing pointers into each segment's index. closed segment
+    // timestamps only shrink (compaction), so a stale entry is conservative:
+    // the reader simply starts one segment early. any structural change other
+    // than add() rebuilds the summary lazily on the next timestamp lookup.
+    mutable std::vector<model::timestamp> _max_timestamps;
+    mutable bool _max_timestamps_dirty{true};
+
     friend std::ostream& operator<<(std::ostream&, const segment_set&);
 };
 
+/// Wall clock time spent in each phase of recovering the segments of a log.
+struct recovery_timings {
+    using duration = std::chrono::steady_clock::duration;
+
+    // listing the directory
+    duration listing{0};
+    // opening segment readers and index files
+    duration open{0};
+    // materializing the indices of all but the last segment
+    duration index_check{0};
+    // replaying the segments that could not be trusted
+    duration replay{0};
+    size_t segments{0};
+    size_t replayed_segments{0};
+
+    recovery_timings& operator+=(const recovery_timings&);
+    friend std::ostream& operator<<(std::ostream&, const recovery_timings&);
+};
+
+/// Persisted when a log is closed cleanly. A log whose segments still match
+/// the record on the next start does not replay its last segment.
+struct clean_shutdown_record {
+    struct segment_meta {
+        model::offset base_offset;
+        model::offset dirty_offset;
+        uint64_t file_size{0};
+        uint64_t index_checksum{0};
+    };
+    std::vector<segment_meta> segments;
+
+    /// \brief describes the segments of a closed log
+    static ss::future<clean_shutdown_record> make(const segment_set&);
+};
+
+/// Opens and recovers the segments of the log in \p path. At most \p
+/// io_concurrency segments are opened or have their index checked at once.
+/// The last segment is trusted without a replay when it matches \p
+/// clean_shutdown.
 ss::future<segment_set> recover_segments(
   std::filesystem::path path,
   debug_sanitize_files sanitize_fileops,
   bool is_compaction_enabled,
   std::function<std::optional<batch_cache_index>()> batch_cache_factory,
-  ss::abort_source& as);
+  ss::abort_source& as,
+  size_t io_concurrency = 1,
+  recovery_timings* timings = nullptr,
+  std::optional<clean_shutdown_record> clean_shutdown = std::nullopt);
 
 std::ostream& operator<<(std::ostream&, const segment_set&);
 
@@ -10,10 +10,13 @@
 #include "storage/segment_utils.h"
 
 #include "bytes/iobuf_parser.h"
+#include "bytes/utils.h"
 #include "config/configuration.h"
+#include "hashing/crc32c.h"
 #include "likely.h"
 #include "model/adl_serde.h"
 #include "model/fundamental.h"
+#include "model/record_utils.h"
 #include "model/timeout_clock.h"
 #include "random/generators.h"
 #include "reflection/adl.h"
@@ -22,12 +25,15 @@
 #include "storage/compacted_index_writer.h"
 #include "storage/compaction_reducers.h"
 #include "storage/fwd.h"
+#include "storage/header_sidecar.h"
 #include "storage/index_state.h"
 #include "storage/lock_manager.h"
 #include "storage/log_reader.h"
 #include "storage/logger.h"
 #include "storage/ntp_config.h"
+#include "storage/parser.h"
 #include "storage/parser_utils.h"
+#include "storage/read_coalescing_file.h"
 #include "storage/segment.h"
 #include "storage/types.h"
 #include "units.h"
@@ -47,6 +53,7 @@
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/when_all.hh>
 #include <seastar/util/defer.hh>
+#include <seastar/util/noncopyable_function.hh>
 
 #include <absl/container/btree_map.h>
 #include <absl/container/flat_hash_map.h>
@@ -130,6 +137,30 @@ ss::future<ss::file> make_reader_handle(
       debug);
 }
 
+ss::future<ss::file> make_segment_reader_handle(
+  const std::filesystem::path& path, storage::debug_sanitize_files debug) {
+    auto f = co_await make_reader_handle(path, debug);
+    if (config::shard_local_cfg().storage_read_coalescing()) {
+        f = ss::file(ss::make_shared<read_coalescing_file>(std::move(f)));
+    }
+    co_return f;
+}
+
+/// file backed index writer with the key layout from the configuration
+static compacted_index_writer make_configured_compacted_index(
+  ss::sstring name, ss::file f, ss::io_priority_class iopc) {
+    auto& cfg = config::shard_local_cfg();
+    return make_file_backed_compacted_index(
+      std::move(name),
+      std::move(f),
+      iopc,
+      segment_appender::write_behind_memory / 2,
+      cfg.compaction_index_fingerprint_keys()
+        ? compacted_index::key_mode::fingerprint
+        : compacted_index::key_mode::full,
+      write_key_filter(cfg.compaction_index_key_filter()));
+}
+
 ss::future<compacted_index_writer> make_compacted_index_writer(
   const std::filesystem::path& path,
   debug_sanitize_files debug,
@@ -141,11 +172,7 @@ ss::future<compacted_index_writer> make_compacted_index_writer(
               // exception during an OOM condition, since the appender allocates
               // 1MB of memory aligned buffers
               return ss::make_ready_future<compacted_index_writer>(
-                make_file_backed_compacted_index(
-                  path.string(),
-                  writer,
-                  iopc,
-                  segment_appender::write_behind_memory / 2));
+                make_configured_compacted_index(path.string(), writer, iopc));
           } catch (...) {
               auto e = std::current_exception();
               vlog(stlog.error, "could not allocate compacted-index: {}", e);
@@ -169,7 +196,11 @@ ss::future<segment_appender_ptr> make_segment_appender(
               // 1MB of memory aligned buffers
               return ss::make_ready_future<segment_appender_ptr>(
                 std::make_unique<segment_appender>(
-                  writer, segment_appender::options(iopc, number_of_chunks)));
+                  writer,
+                  segment_appender::options(
+                    iopc,
+                    number_of_chunks,
+                    config::shard_local_cfg().segment_fallocation_step())));
           } catch (...) {
               auto e = std::current_exception();
               vlog(stlog.error, "could not allocate appender: {}", e);
@@ -200,6 +231,22 @@ natural_index_of_entries_to_keep(compacted_index_reader reader) {
     return reader.consume(compaction_key_reducer(), model::no_timeout);
 }
 
+ss::future<Roaring> natural_index_of_entries_to_keep(
+  compacted_index_reader reader, compaction_config cfg) {
+    auto max_mem = config::shard_local_cfg().compaction_sorted_run_memory();
+    if (!max_mem) {
+        return natural_index_of_entries_to_keep(reader);
+    }
+    reader.reset();
+    return reader.consume(
+      sorted_run_key_reducer(
+        std::filesystem::path(reader.filename().c_str()),
+        *max_mem,
+        cfg.iopc,
+        cfg.sanitize),
+      model::no_timeout);
+}
+
 ss::future<> copy_filtered_entries(
   compacted_index_reader reader,
   Roaring to_copy_index,
@@ -222,36 +269,36 @@ ss::future<> copy_filtered_entries(
       });
 }
 
+static ss::future<> write_filtered_compacted_index(
+  compacted_index_reader reader, Roaring bitmap, compaction_config cfg) {
+    const auto tmpname = std::filesystem::path(
+      fmt::format("{}.staging", reader.filename()));
+    return make_handle(
+             tmpname,
+             ss::open_flags::rw | ss::open_flags::truncate
+               | ss::open_flags::create,
+             writer_opts(),
+             cfg.sanitize)
+      .then([tmpname, cfg, reader, bm = std::move(bitmap)](ss::file f) mutable {
+          auto writer = make_configured_compacted_index(
+            tmpname.string(), std::move(f), cfg.iopc);
+          return copy_filtered_entries(
+            reader, std::move(bm), std::move(writer));
+      })
+      .then([old_name = tmpname.string(), new_name = reader.filename()] {
+          // from glibc: If oldname is not a directory, then any
+          // existing file named newname is removed during the
+          // renaming operation
+          return ss::rename_file(old_name, new_name);
+      });
+}
+
 static ss::future<> do_write_clean_compacted_index(
   compacted_index_reader reader, compaction_config cfg) {
-    return natural_index_of_entries_to_keep(reader).then([reader,
-                                                          cfg](Roaring bitmap) {
-        const auto tmpname = std::filesystem::path(
-          fmt::format("{}.staging", reader.filename()));
-        return make_handle(
-                 tmpname,
-                 ss::open_flags::rw | ss::open_flags::truncate
-                   | ss::open_flags::create,
-                 writer_opts(),
-                 cfg.sanitize)
-          .then(
-            [tmpname, cfg, reader, bm = std::move(bitmap)](ss::file f) mutable {
-                auto writer = make_file_backed_compacted_index(
-                  tmpname.string(),
-                  std::move(f),
-                  cfg.iopc,
-                  // TODO: pass this memory from the cfg
-                  segment_appender::write_behind_memory / 2);
-                return copy_filtered_entries(
-                  reader, std::move(bm), std::move(writer));
-            })
-          .then([old_name = tmpname.string(), new_name = reader.filename()] {
-              // from glibc: If oldname is not a directory, then any
-              // existing file named newname is removed during the
-              // renaming operation
-              return ss::rename_file(old_name, new_name);
-          });
-    });
+    return natural_index_of_entries_to_keep(reader, cfg).then(
+      [reader, cfg](Roaring bitmap) {
+          return write_filtered_compacted_index(reader, std::move(bitmap), cfg);
+      });
 }
 
 ss::future<> write_clean_compacted_index(
@@ -392,106 +439,222 @@ model::record_batch_reader create_segment_full_reader(
       std::move(lease), reader_cfg, pb);
 }
 
-ss::future<> do_swap_data_file_handles(
+ss::future<segment_reader> open_rewritten_data_file(
   std::filesystem::path compacted,
   ss::lw_shared_ptr<storage::segment> s,
-  storage::compaction_config cfg,
+  storage::compaction_config cfg) {
+    auto f = co_await make_segment_reader_handle(compacted, cfg.sanitize);
+    std::exception_ptr ex;
+    uint64_t size = 0;
+    try {
+        auto st = co_await f.stat();
+        size = st.st_size;
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        co_await f.close();
+        std::rethrow_exception(ex);
+    }
+    co_return segment_reader(
+      s->reader().filename(),
+      std::move(f),
+      size,
+      default_segment_readahead_size);
+}
+
+ss::future<segment_reader> do_swap_data_file_handles(
+  std::filesystem::path compacted,
+  ss::lw_shared_ptr<storage::segment> s,
+  segment_reader r,
   probe& pb) {
-    return s->reader()
-      .close()
-      .then([compacted, s] {
-          ss::sstring old_name = compacted.string();
-          vlog(
-            gclog.trace,
-            "swapping compacted segment temp file {} with the segment {}",
-            old_name,
-            s->reader().filename());
-          return ss::rename_file(old_name, s->reader().filename());
-      })
-      .then([s, cfg] {
-          auto to_open = std::filesystem::path(s->reader().filename().c_str());
-          return make_reader_handle(to_open, cfg.sanitize);
-      })
-      .then([s, &pb](ss::file f) mutable {
-          return f.stat()
-            .then([f](struct stat s) {
-                return ss::make_ready_future<std::tuple<uint64_t, ss::file>>(
-                  std::make_tuple(s.st_size, f));
-            })
-            .then([s, &pb](std::tuple<uint64_t, ss::file> t) {
-                auto& [size, fd] = t;
-                auto r = segment_reader(
-                  s->reader().filename(),
-                  std::move(fd),
-                  size,
-                  default_segment_readahead_size);
-                // update partition size probe
-                pb.delete_segment(*s.get());
-                std::swap(s->reader(), r);
-                pb.add_initial_segment(*s.get());
-            });
-      });
+    vlog(
+      gclog.trace,
+      "swapping compacted segment temp file {} with the segment {}",
+      compacted,
+      s->reader().filename());
+    std::exception_ptr ex;
+    try {
+        // the current data file stays readable through its open handle
+        co_await ss::rename_file(compacted.string(), s->reader().filename());
+        // the headers of the rewritten data file are read from it
+        co_await remove_header_sidecar(s->reader().filename().c_str());
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (ex) {
+        co_await r.close();
+        std::rethrow_exception(ex);
+    }
+    // update partition size probe
+    pb.delete_segment(*s.get());
+    std::swap(s->reader(), r);
+    // the new data file has not been scrubbed
+    s->unmark_as_verified();
+    pb.add_initial_segment(*s.get());
+    co_return std::move(r);
 }
 
 /**
- * Executes segment compaction, returns size of compacted segment
+ * Writes the staging data file of the segment with `copy_data`, holding the
+ * read lock, and swaps it in along with the index it returns. Returns the
+ * size of the rewritten segment
+ *
+ * The rewritten data file is opened before the write lock is taken and the
+ * replaced one is closed after it is released, readers are only held off
+ * while the files and indices are swapped.
  */
-ss::future<size_t> do_self_compact_segment(
+static ss::future<size_t> do_replace_segment_data(
   ss::lw_shared_ptr<segment> s,
   compaction_config cfg,
   storage::probe& pb,
-  storage::readers_cache& readers_cache) {
-    vlog(gclog.trace, "self compacting segment {}", s->reader().filename());
-    return s->read_lock()
-      .then([cfg, s, &pb](ss::rwlock::holder h) {
-          if (s->is_closed()) {
-              return ss::make_exception_future<index_state>(
-                segment_closed_exception());
-          }
+  storage::readers_cache& readers_cache,
+  ss::noncopyable_function<ss::future<index_state>(ss::rwlock::holder)>
+    copy_data) {
+    auto h = co_await s->read_lock();
+    if (s->is_closed()) {
+        throw segment_closed_exception();
+    }
+    auto idx = co_await copy_data(std::move(h));
+    auto compacted_file = data_segment_staging_name(s);
+    auto rewritten = co_await open_rewritten_data_file(
+      compacted_file, s, cfg);
 
-          return do_compact_segment_index(s, cfg)
+    std::exception_ptr ex;
+    bool swapping = false;
+    std::optional<segment_reader> replaced;
+    size_t size = 0;
+    try {
+        auto cache_lock = co_await readers_cache.evict_segment_readers(s);
+        auto lock = co_await s->write_lock();
+        if (s->is_closed()) {
+            throw segment_closed_exception();
+        }
+        co_await s->index().drop_all_data();
+        // the swap closes the rewritten data file if it fails
+        swapping = true;
+        replaced.emplace(co_await do_swap_data_file_handles(
+          compacted_file, s, std::move(rewritten), pb));
+        s->index().swap_index_state(std::move(idx));
+        s->force_set_commit_offset_from_index();
+        s->release_batch_cache_index();
+        co_await s->index().flush();
+        size = s->size_bytes();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    if (replaced) {
+        co_await replaced->close();
+    } else if (!swapping) {
+        co_await rewritten.close();
+    }
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return size;
+}
+
+/**
+ * Rewrites the compaction index of the segment with `compact_index` and then
+ * copies the data of the entries left in the index, returns size of
+ * compacted segment
+ */
+static ss::future<size_t> do_rewrite_segment(
+  ss::lw_shared_ptr<segment> s,
+  compaction_config cfg,
+  storage::probe& pb,
+  storage::readers_cache& readers_cache,
+  ss::noncopyable_function<ss::future<>()> compact_index) {
+    return do_replace_segment_data(
+      s,
+      cfg,
+      pb,
+      readers_cache,
+      [s, cfg, &pb, compact_index = std::move(compact_index)](
+        ss::rwlock::holder h) mutable {
+          return compact_index()
             // copy the bytes after segment is good - note that we
             // need to do it with the READ-lock, not the write lock
             .then([cfg, s, h = std::move(h), &pb]() mutable {
                 return do_copy_segment_data(s, cfg, pb, std::move(h));
             });
-      })
-      .then([s, &readers_cache](storage::index_state idx) {
-          return readers_cache.evict_segment_readers(s).then(
-            [s,
-             idx = std::move(idx)](readers_cache::range_lock_holder) mutable {
-                return s->write_lock().then(
-                  [s, idx = std::move(idx)](ss::rwlock::holder h) mutable {
-                      using type = std::tuple<index_state, ss::rwlock::holder>;
-                      if (s->is_closed()) {
-                          return ss::make_exception_future<type>(
-                            segment_closed_exception());
-                      }
-                      return ss::make_ready_future<type>(
-                        std::make_tuple(std::move(idx), std::move(h)));
-                  });
-            });
-      })
-      .then([cfg, s, &pb](std::tuple<index_state, ss::rwlock::holder> h) {
-          return s->index()
-            .drop_all_data()
-            .then([s, cfg, &pb] {
-                auto compacted_file = data_segment_staging_name(s);
-                return do_swap_data_file_handles(compacted_file, s, cfg, pb);
-            })
-            .then([h = std::move(h), s]() mutable {
-                auto& [idx, lock] = h;
-                s->index().swap_index_state(std::move(idx));
-                s->force_set_commit_offset_from_index();
-                s->release_batch_cache_index();
-                return s->index()
-                  .flush()
-                  .then([s] { return s->size_bytes(); })
-                  .finally([l = std::move(lock)] {});
-            });
       });
 }
 
+static ss::future<index_state> do_copy_recompressed_segment_data(
+  ss::lw_shared_ptr<segment> s,
+  compaction_config cfg,
+  storage::probe& pb,
+  model::compression c,
+  ss::rwlock::holder h) {
+    const auto tmpname = data_segment_staging_name(s);
+    auto w = co_await make_segment_appender(
+      tmpname,
+      cfg.sanitize,
+      segment_appender::write_behind_memory
+        / config::shard_local_cfg().append_chunk_size(),
+      cfg.iopc);
+    vlog(
+      gclog.trace,
+      "recompressing segment data from {} to {}",
+      s->reader().filename(),
+      tmpname);
+    auto r = create_segment_full_reader(s, cfg, pb, std::move(h));
+    std::exception_ptr ex;
+    index_state idx;
+    try {
+        idx = co_await std::move(r).consume(
+          recompress_data_segment_reducer(c, w.get()), model::no_timeout);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    try {
+        co_await w->close();
+    } catch (...) {
+        vlog(
+          gclog.error,
+          "Error closing recompressed segment {}: {}",
+          tmpname,
+          std::current_exception());
+    }
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return idx;
+}
+
+ss::future<size_t> recompress_segment(
+  ss::lw_shared_ptr<segment> s,
+  compaction_config cfg,
+  storage::probe& pb,
+  storage::readers_cache& readers_cache,
+  model::compression c) {
+    if (s->has_appender()) {
+        return ss::make_exception_future<size_t>(std::runtime_error(fmt::format(
+          "Cannot recompress an active segment. cfg:{} - segment:{}", cfg, s)));
+    }
+    vlog(gclog.trace, "recompressing segment {}", s->reader().filename());
+    return do_replace_segment_data(
+      s, cfg, pb, readers_cache, [s, cfg, &pb, c](ss::rwlock::holder h) {
+          return do_copy_recompressed_segment_data(
+            s, cfg, pb, c, std::move(h));
+      });
+}
+
+/**
+ * Executes segment compaction, returns size of compacted segment
+ */
+ss::future<size_t> do_self_compact_segment(
+  ss::lw_shared_ptr<segment> s,
+  compaction_config cfg,
+  storage::probe& pb,
+  storage::readers_cache& readers_cache) {
+    vlog(gclog.trace, "self compacting segment {}", s->reader().filename());
+    return do_rewrite_segment(s, cfg, pb, readers_cache, [s, cfg] {
+        return do_compact_segment_index(s, cfg);
+    });
+}
+
 ss::future<> rebuild_compaction_index(
   model::record_batch_reader rdr,
   std::filesystem::path p,
@@ -573,6 +736,142 @@ ss::future<compaction_result> self_compact_segment(
       });
 }
 
+static ss::future<cross_segment_dedupe_reducer::result>
+do_dedupe_segment_index(
+  ss::lw_shared_ptr<segment> s, compaction_config cfg, key_offset_map& map) {
+    auto h = co_await s->read_lock();
+    if (s->is_closed()) {
+        throw segment_closed_exception();
+    }
+    const auto path = compacted_index_path(s->reader().filename().c_str());
+    auto f = co_await make_reader_handle(path, cfg.sanitize);
+    auto reader = make_file_backed_compacted_reader(
+      path.string(), std::move(f), cfg.iopc, 64_KiB);
+    std::exception_ptr ex;
+    cross_segment_dedupe_reducer::result result;
+    try {
+        auto& filter = s->compaction_key_filter();
+        if (!filter) {
+            auto loaded = co_await reader.load_key_filter();
+            filter = loaded ? ss::make_lw_shared<const key_bloom_filter>(
+                       std::move(*loaded))
+                            : nullptr;
+        }
+        /*
+         * none of the newer keys can be in this segment; its own keys are not
+         * recorded in the map either, which only costs deduplication of older
+         * segments against it, and that happened in the round where this
+         * segment was the newest one
+         */
+        if (
+          *filter && !map.empty()
+          && !map.any_key([&f = **filter](bytes_view k) {
+                 return f.maybe_contains(k);
+             })) {
+            vlog(
+              gclog.trace,
+              "key filter: no shadowed keys in {}",
+              s->reader().filename());
+            result.skipped = true;
+        } else {
+            reader.reset();
+            result = co_await reader.consume(
+              cross_segment_dedupe_reducer(map), model::no_timeout);
+        }
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await reader.close().then_wrapped([](ss::future<>) {});
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+    co_return result;
+}
+
+static ss::future<> rewrite_deduplicated_index(
+  ss::lw_shared_ptr<segment> s, compaction_config cfg, Roaring to_keep) {
+    const auto path = compacted_index_path(s->reader().filename().c_str());
+    return make_reader_handle(path, cfg.sanitize)
+      .then([cfg, path, bm = std::move(to_keep)](ss::file f) mutable {
+          auto reader = make_file_backed_compacted_reader(
+            path.string(), std::move(f), cfg.iopc, 64_KiB);
+          return write_filtered_compacted_index(reader, std::move(bm), cfg)
+            .finally([reader]() mutable {
+                return reader.close().then_wrapped([](ss::future<>) {});
+            });
+      });
+}
+
+ss::future<compaction_result> deduplicate_segments(
+  std::vector<ss::lw_shared_ptr<segment>> segments,
+  compaction_config cfg,
+  storage::probe& pb,
+  storage::readers_cache& readers_cache,
+  size_t max_key_map_memory) {
+    key_offset_map map(max_key_map_memory);
+    size_t size_before = 0;
+    size_t size_after = 0;
+    bool compacted = false;
+    if (segments.empty()) {
+        co_return compaction_result(0);
+    }
+    /*
+     * segments are visited newest to oldest. the index of the next (older)
+     * segment is scanned while the current one is being rewritten; this is
+     * safe because the scan only needs the keys of newer segments, which are
+     * already in the map by the time the current scan finished.
+     */
+    auto it = segments.rbegin();
+    auto next = do_dedupe_segment_index(*it, cfg, map);
+    for (; it != segments.rend(); ++it) {
+        auto s = *it;
+        auto dedupe = co_await std::move(next);
+        if (std::next(it) != segments.rend()) {
+            next = do_dedupe_segment_index(*std::next(it), cfg, map);
+        }
+        const auto sz = s->size_bytes();
+        size_before += sz;
+        if (dedupe.shadowed == 0) {
+            size_after += sz;
+            continue;
+        }
+        vlog(
+          gclog.debug,
+          "dropping {} entries shadowed by newer segments from {}",
+          dedupe.shadowed,
+          s->reader().filename());
+        std::exception_ptr ex;
+        try {
+            size_after += co_await do_rewrite_segment(
+              s,
+              cfg,
+              pb,
+              readers_cache,
+              [s, cfg, bm = std::move(dedupe.to_keep)]() mutable {
+                  return rewrite_deduplicated_index(s, cfg, std::move(bm));
+              });
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        if (ex) {
+            // do not leave the in-flight scan behind
+            if (std::next(it) != segments.rend()) {
+                co_await std::move(next).then_wrapped(
+                  [](ss::future<cross_segment_dedupe_reducer::result> f) {
+                      f.ignore_ready_future();
+                  });
+            }
+            std::rethrow_exception(ex);
+        }
+        pb.segment_compacted();
+        compacted = true;
+    }
+    if (!compacted) {
+        co_return compaction_result(size_before);
+    }
+    co_return compaction_result(size_before, size_after);
+}
+
 ss::future<ss::lw_shared_ptr<segment>> make_concatenated_segment(
   std::filesystem::path path,
   std::vector<ss::lw_shared_ptr<segment>> segments,
@@ -770,7 +1069,12 @@ ss::future<std::vector<ss::rwlock::holder>> transfer_segment(
 
     // segment data file
     auto from_path = std::filesystem::path(from->reader().filename());
-    co_await do_swap_data_file_handles(from_path, to, cfg, probe);
+    auto replaced = co_await do_swap_data_file_handles(
+      from_path,
+      to,
+      co_await open_rewritten_data_file(from_path, to, cfg),
+      probe);
+    co_await replaced.close();
 
     // offset index
     to->index().swap_index_state(
@@ -835,10 +1139,118 @@ size_t jitter_segment_size(size_t sz, jitter_percents jitter_percents) {
     return jitter + sz;
 }
 
+/// checks the full crc of every batch, the parser checks the header crc
+class scrubbing_consumer final : public batch_consumer {
+public:
+    explicit scrubbing_consumer(const segment& s, ss::abort_source& as)
+      : _seg(s)
+      , _as(as) {}
+
+    consume_result
+    accept_batch_start(const model::record_batch_header&) const final {
+        return batch_consumer::consume_result::accept_batch;
+    }
+
+    void skip_batch_start(model::record_batch_header, size_t, size_t) final {}
+
+    void consume_batch_start(
+      model::record_batch_header header,
+      size_t physical_base_offset,
+      size_t size_on_disk) final {
+        _header = header;
+        _end_of_batch = physical_base_offset + size_on_disk;
+        _crc = crc::crc32c();
+        model::crc_record_batch_header(_crc, header);
+    }
+
+    void consume_records(iobuf&& records) final {
+        crc_extend_iobuf(_crc, records);
+    }
+
+    stop_parser consume_batch_end() final {
+        if ((uint32_t)_header.crc != _crc.value()) {
+            vlog(
+              stlog.error,
+              "scrubber found a corrupt batch in {}. expected crc {}, got {} "
+              "- {}",
+              _seg,
+              _header.crc,
+              _crc.value(),
+              _header);
+            _corrupt = true;
+            return stop_parser::yes;
+        }
+        _verified_bytes = _end_of_batch;
+        return stop_parser(_as.abort_requested());
+    }
+
+    void print(std::ostream& os) const final {
+        fmt::print(os, "storage::scrubbing_consumer segment {}", _seg);
+    }
+
+    size_t verified_bytes() const { return _verified_bytes; }
+    bool corrupt() const { return _corrupt; }
+
+private:
+    const segment& _seg;
+    ss::abort_source& _as;
+    model::record_batch_header _header;
+    crc::crc32c _crc;
+    size_t _end_of_batch{0};
+    size_t _verified_bytes{0};
+    bool _corrupt{false};
+};
+
+ss::future<bool> scrub_segment(
+  ss::lw_shared_ptr<segment> s,
+  ss::io_priority_class iopc,
+  ss::abort_source& as,
+  storage::probe& pb) {
+    auto h = co_await s->read_lock();
+    if (s->is_closed() || s->has_appender() || s->is_verified()) {
+        co_return s->is_verified();
+    }
+    const auto file_size = s->reader().file_size();
+    auto consumer = std::make_unique<scrubbing_consumer>(*s, as);
+    auto& scrubber = *consumer;
+    auto parser = continuous_batch_parser(
+      std::move(consumer), s->reader().data_stream(0, iopc));
+    std::exception_ptr ex;
+    try {
+        co_await parser.consume();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await parser.close();
+    if (ex) {
+        vlog(stlog.info, "error scrubbing segment {}: {}", *s, ex);
+        co_return false;
+    }
+    if (scrubber.corrupt()) {
+        pb.segment_scrub_failed();
+        co_return false;
+    }
+    if (scrubber.verified_bytes() != file_size) {
+        // aborted, or a parse error that the read path reports by itself
+        co_return false;
+    }
+    vlog(stlog.debug, "scrubber verified segment {}", *s);
+    s->mark_as_verified();
+    pb.segment_verified();
+    co_return true;
+}
+
 bytes start_offset_key(model::ntp ntp) {
     iobuf buf;
     reflection::serialize(buf, kvstore_key_type::start_offset, std::move(ntp));
     return iobuf_to_bytes(buf);
 }
 
+bytes clean_shutdown_key(model::ntp ntp) {
+    iobuf buf;
+    reflection::serialize(
+      buf, kvstore_key_type::clean_shutdown, std::move(ntp));
+    return iobuf_to_bytes(buf);
+}
+
 } // namespace storage::internal
@@ -37,6 +37,34 @@ ss::future<compaction_result> self_compact_segment(
   storage::probe&,
   storage::readers_cache&);
 
+/*
+ * Log wide deduplication of self compacted segments.
+ *
+ * Segments must be closed, self compacted and sorted by offset. They are
+ * visited newest to oldest while a memory bounded key map collects the newest
+ * offset of every key; records of older segments whose key has a newer offset
+ * are dropped instead of waiting for adjacent segments to be concatenated.
+ * This method will acquire its own locks on the segments.
+ */
+ss::future<compaction_result> deduplicate_segments(
+  std::vector<ss::lw_shared_ptr<storage::segment>>,
+  storage::compaction_config,
+  storage::probe&,
+  storage::readers_cache&,
+  size_t max_key_map_memory);
+
+/*
+ * Verifies the crc of every batch of a segment without an appender, under
+ * its read lock, and marks the segment verified when the whole data file
+ * checked out. Returns false when the segment was not verified, either
+ * because a batch was corrupt or because the scrub was aborted.
+ */
+ss::future<bool> scrub_segment(
+  ss::lw_shared_ptr<segment>,
+  ss::io_priority_class,
+  ss::abort_source&,
+  storage::probe&);
+
 /*
  * Concatentate segments into a minimal new segment.
  *
@@ -89,6 +117,10 @@ make_writer_handle(const std::filesystem::path&, storage::debug_sanitize_files);
 /// make file handle with default opts
 ss::future<ss::file>
 make_reader_handle(const std::filesystem::path&, storage::debug_sanitize_files);
+/// make the read handle of a segment data file, sharing concurrent reads of
+/// the same range when storage_read_coalescing is enabled
+ss::future<ss::file> make_segment_reader_handle(
+  const std::filesystem::path&, storage::debug_sanitize_files);
 ss::future<ss::file> make_handle(
   const std::filesystem::path path,
   ss::open_flags flags,
@@ -119,6 +151,10 @@ size_t number_of_chunks_from_config(const storage::ntp_config&);
 /// save starting at 0 on a *new* `.compacted_index` file this represents
 /// the fully dedupped entries, clean of truncations, etc
 ss::future<Roaring> natural_index_of_entries_to_keep(compacted_index_reader);
+/// \brief same as above. Deduplicates exactly with sorted runs spilled next
+/// to the index when `compaction_sorted_run_memory` caps the memory
+ss::future<Roaring> natural_index_of_entries_to_keep(
+  compacted_index_reader, storage::compaction_config);
 
 ss::future<> copy_filtered_entries(
   storage::compacted_index_reader input,
@@ -150,10 +186,30 @@ ss::future<storage::index_state> do_copy_segment_data(
   storage::probe&,
   ss::rwlock::holder);
 
-ss::future<> do_swap_data_file_handles(
-  std::filesystem::path compacted,
+/// \brief rewrites the data batches of a closed segment with the
+/// compression \p c when it makes them smaller, offsets are preserved.
+/// Returns the size of the rewritten segment
+ss::future<size_t> recompress_segment(
   ss::lw_shared_ptr<storage::segment>,
   storage::compaction_config,
+  storage::probe&,
+  storage::readers_cache&,
+  model::compression c);
+
+/// Opens the rewritten data file of the segment before it is swapped in,
+/// readers keep reading the current data file meanwhile
+ss::future<segment_reader> open_rewritten_data_file(
+  std::filesystem::path compacted,
+  ss::lw_shared_ptr<storage::segment>,
+  storage::compaction_config);
+
+/// Swaps in the data file opened by open_rewritten_data_file, the segment
+/// must be write locked. Returns the reader of the replaced data file, to be
+/// closed once the lock is released
+ss::future<segment_reader> do_swap_data_file_handles(
+  std::filesystem::path compacted,
+  ss::lw_shared_ptr<storage::segment>,
+  segment_reader,
   probe&);
 
 std::filesystem::path compacted_index_path(std::filesystem::path segment_path);
@@ -167,8 +223,10 @@ size_t
 // key types used to store data in key-value store
 enum class kvstore_key_type : int8_t {
     start_offset = 0,
+    clean_shutdown = 1,
 };
 
 bytes start_offset_key(model::ntp ntp);
+bytes clean_shutdown_key(model::ntp ntp);
 
 } // namespace storage::internal
@@ -0,0 +1,310 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/shard_wal.h"
+
+#include "model/adl_serde.h"
+#include "model/namespace.h"
+#include "model/record_utils.h"
+#include "reflection/adl.h"
+#include "storage/logger.h"
+#include "storage/record_batch_builder.h"
+#include "storage/segment.h"
+#include "storage/segment_set.h"
+#include "vlog.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/seastar.hh>
+
+#include <algorithm>
+
+namespace storage {
+
+shard_wal::shard_wal(ss::sstring base_dir, debug_sanitize_files sanitize)
+  : _ntpc(model::shard_wal_ntp(ss::this_shard_id()), std::move(base_dir))
+  , _sanitize_fileops(sanitize) {}
+
+ss::future<> shard_wal::start() {
+    vlog(stlog.info, "Starting shared wal: dir {}", _ntpc.work_directory());
+    co_await recover();
+    co_await make_segment();
+
+    // group commit background fiber
+    (void)ss::with_gate(_gate, [this] {
+        return ss::do_until(
+          [this] { return _gate.is_closed(); },
+          [this] {
+              // consume at least one unit to avoid spinning on wait(0)
+              auto units = std::max(_sem.current(), size_t(1));
+              return _sem.wait(units).then([this] {
+                  if (_gate.is_closed()) {
+                      return ss::now();
+                  }
+                  return _mutex.with([this] { return flush_ops(); });
+              });
+          });
+    });
+}
+
+ss::future<> shard_wal::stop() {
+    vlog(stlog.info, "Stopping shared wal: dir {}", _ntpc.work_directory());
+    _as.request_abort();
+
+    // prevent new ops, signal the group commit fiber to exit
+    auto f = _gate.close();
+    _sem.signal();
+    for (auto& op : _ops) {
+        op.done.set_exception(ss::gate_closed_exception());
+    }
+    _ops.clear();
+    co_await std::move(f);
+
+    if (_segment) {
+        co_await _segment->flush();
+        co_await _segment->close();
+    }
+    for (auto& seg : _recovered_segments) {
+        co_await seg->close();
+    }
+}
+
+ss::future<> shard_wal::append(
+  const model::ntp& ntp, std::vector<model::record_batch> batches) {
+    std::vector<std::pair<iobuf, iobuf>> records;
+    records.reserve(batches.size());
+    for (auto& b : batches) {
+        iobuf value;
+        reflection::serialize(value, entry_type::append);
+        reflection::adl<model::record_batch>{}.to_storage_encoding(
+          value, std::move(b));
+        records.emplace_back(reflection::to_iobuf(ntp), std::move(value));
+    }
+    return enqueue(ntp, std::move(records));
+}
+
+ss::future<> shard_wal::truncate(const model::ntp& ntp, model::offset o) {
+    std::vector<std::pair<iobuf, iobuf>> records;
+    iobuf value;
+    reflection::serialize(value, entry_type::truncate, o);
+    records.emplace_back(reflection::to_iobuf(ntp), std::move(value));
+    return enqueue(ntp, std::move(records));
+}
+
+ss::future<> shard_wal::enqueue(
+  const model::ntp& ntp, std::vector<std::pair<iobuf, iobuf>> records) {
+    return ss::with_gate(
+      _gate, [this, &ntp, records = std::move(records)]() mutable {
+          _ntps.insert(ntp);
+          auto& w = _ops.emplace_back(std::move(records));
+          _sem.signal();
+          return w.done.get_future();
+      });
+}
+
+ss::future<> shard_wal::flush_ops() {
+    if (_ops.empty()) {
+        co_return;
+    }
+    // the appends queued while a commit is in flight go to the next one
+    auto ops = std::exchange(_ops, {});
+
+    storage::record_batch_builder builder(
+      model::record_batch_type::shard_wal, _next_offset);
+    for (auto& op : ops) {
+        for (auto& [key, value] : op.records) {
+            builder.add_raw_kv(std::move(key), std::move(value));
+        }
+    }
+    auto batch = std::move(builder).build();
+    auto last_offset = batch.last_offset();
+
+    std::exception_ptr ex;
+    try {
+        co_await _segment->append(std::move(batch));
+        _next_offset = last_offset + model::offset(1);
+        co_await _segment->flush();
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    for (auto& op : ops) {
+        if (ex) {
+            op.done.set_exception(ex);
+        } else {
+            op.done.set_value();
+        }
+    }
+    if (ex) {
+        vlog(stlog.error, "Error committing to the shared wal: {}", ex);
+    }
+}
+
+ss::future<> shard_wal::make_segment() {
+    _segment = co_await storage::make_segment(
+      _ntpc,
+      _next_offset,
+      model::term_id(0),
+      ss::default_priority_class(),
+      record_version_type::v1,
+      default_segment_readahead_size,
+      _sanitize_fileops,
+      std::nullopt);
+}
+
+ss::future<> shard_wal::drain(flush_logs_t flush_logs) {
+    auto gate_holder = _gate.hold();
+
+    // roll between two group commits: the appends committed to the rolled
+    // segment, and those still queued, are from partitions in `ntps`
+    auto units = co_await _mutex.get_units();
+    ++_generation;
+    auto ntps = std::exchange(_ntps, {});
+    std::vector<ss::lw_shared_ptr<segment>> rolled;
+    if (_segment->appender().file_byte_offset() > 0) {
+        rolled.push_back(std::exchange(_segment, nullptr));
+        co_await rolled.back()->close();
+        co_await make_segment();
+    }
+    units.return_all();
+
+    co_await flush_logs(std::move(ntps));
+    co_await remove_segments(std::move(rolled));
+    if (_recovered.empty() && !_recovered_segments.empty()) {
+        auto segs = std::exchange(_recovered_segments, {});
+        for (auto& seg : segs) {
+            co_await seg->close();
+        }
+        co_await remove_segments(std::move(segs));
+    }
+}
+
+ss::future<>
+shard_wal::remove_segments(std::vector<ss::lw_shared_ptr<segment>> segs) {
+    for (auto& seg : segs) {
+        vlog(
+          stlog.debug,
+          "Removing shared wal segment with base offset {}",
+          seg->offsets().base_offset);
+        co_await ss::remove_file(seg->reader().filename());
+        co_await ss::remove_file(seg->index().filename());
+    }
+}
+
+std::vector<model::record_batch>
+shard_wal::take_recovered(const model::ntp& ntp) {
+    auto node = _recovered.extract(ntp);
+    if (node.empty()) {
+        return {};
+    }
+    return std::move(node.mapped());
+}
+
+ss::future<> shard_wal::recover() {
+    auto segments = co_await recover_segments(
+      std::filesystem::path(_ntpc.work_directory()),
+      _sanitize_fileops,
+      false,
+      [] { return std::nullopt; },
+      _as);
+
+    for (auto& seg : segments) {
+        _next_offset = std::max(
+          {_next_offset,
+           seg->offsets().base_offset + model::offset(1),
+           seg->offsets().dirty_offset + model::offset(1)});
+        auto parser = std::make_unique<continuous_batch_parser>(
+          std::make_unique<replay_consumer>(this),
+          seg->reader().data_stream(0, ss::default_priority_class()));
+        co_await parser->consume().discard_result();
+        co_await parser->close();
+        _recovered_segments.push_back(seg);
+    }
+    absl::erase_if(_recovered, [](const auto& p) { return p.second.empty(); });
+    vlog(
+      stlog.info,
+      "Recovered appends of {} partitions from {} shared wal segments",
+      _recovered.size(),
+      _recovered_segments.size());
+}
+
+void shard_wal::apply(model::record_batch batch) {
+    // a truncation, or an append overwriting the log tail after one, drops
+    // the appends logged before it from its offset on
+    auto drop_from = [](
+                       std::vector<model::record_batch>& batches,
+                       model::offset o) {
+        auto it = std::find_if(
+          batches.begin(), batches.end(), [o](const model::record_batch& b) {
+              return b.base_offset() >= o;
+          });
+        batches.erase(it, batches.end());
+    };
+
+    batch.for_each_record([this, &drop_from](model::record r) {
+        auto ntp = reflection::from_iobuf<model::ntp>(r.release_key());
+        iobuf_parser parser(r.release_value());
+        auto type = reflection::adl<entry_type>{}.from(parser);
+        auto& batches = _recovered[ntp];
+        switch (type) {
+        case entry_type::append: {
+            auto b = reflection::adl<model::record_batch>{}.from(parser);
+            drop_from(batches, b.base_offset());
+            batches.push_back(std::move(b));
+            break;
+        }
+        case entry_type::truncate:
+            drop_from(batches, reflection::adl<model::offset>{}.from(parser));
+            break;
+        }
+    });
+}
+
+batch_consumer::consume_result shard_wal::replay_consumer::accept_batch_start(
+  const model::record_batch_header&) const {
+    if (_wal->_as.abort_requested()) {
+        return batch_consumer::consume_result::stop_parser;
+    }
+    return batch_consumer::consume_result::accept_batch;
+}
+
+void shard_wal::replay_consumer::skip_batch_start(
+  model::record_batch_header h, size_t, size_t) {
+    vassert(false, "shared wal should never skip batches, header: {}", h);
+}
+
+void shard_wal::replay_consumer::consume_batch_start(
+  model::record_batch_header header, size_t, size_t) {
+    _header = header;
+}
+
+void shard_wal::replay_consumer::consume_records(iobuf&& records) {
+    _records = std::move(records);
+}
+
+batch_consumer::stop_parser shard_wal::replay_consumer::consume_batch_end() {
+    model::record_batch batch(
+      _header, std::move(_records), model::record_batch::tag_ctor_ng{});
+    // the tail of a commit interrupted by a crash was never acknowledged
+    if (
+      batch.header().type != model::record_batch_type::shard_wal
+      || batch.header().crc != model::crc_record_batch(batch)) {
+        vlog(
+          stlog.warn,
+          "Stopping shared wal replay at invalid batch {}",
+          batch.header());
+        return stop_parser::yes;
+    }
+    _wal->apply(std::move(batch));
+    return stop_parser::no;
+}
+
+void shard_wal::replay_consumer::print(std::ostream& os) const {
+    os << "storage::shard_wal";
+}
+
+} // namespace storage
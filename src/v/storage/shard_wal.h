@@ -0,0 +1,154 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "bytes/iobuf.h"
+#include "model/fundamental.h"
+#include "model/record.h"
+#include "seastarx.h"
+#include "storage/ntp_config.h"
+#include "storage/parser.h"
+#include "storage/segment.h"
+#include "storage/types.h"
+#include "utils/mutex.h"
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/semaphore.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+
+#include <vector>
+
+namespace storage {
+
+/**
+ * \brief write-ahead log shared by the small partitions of a shard
+ *
+ * With many mostly idle partitions per shard every acks=all append ends in a
+ * small write and an fsync of the segment of its partition. When
+ * storage_shared_wal is enabled, logs holding few bytes not yet flushed to
+ * their segments write their appends to the segments without an fsync and
+ * make them durable here instead, where the appends of all the partitions of
+ * the shard are group committed with a single fsync.
+ *
+ * The log is drained periodically: it rolls to a new generation, the
+ * partitions with appends in the older generation flush their segments and
+ * the segments of the older generation are removed. On startup the appends
+ * found in the remaining segments are handed to their partitions as they are
+ * managed again, which append those missing from their segments.
+ *
+ * Truncations are logged as well, so that the appends they removed are not
+ * replayed.
+ */
+class shard_wal {
+public:
+    using flush_logs_t = ss::noncopyable_function<ss::future<>(
+      absl::flat_hash_set<model::ntp>)>;
+
+    shard_wal(ss::sstring base_dir, debug_sanitize_files sanitize_fileops);
+
+    ss::future<> start();
+    ss::future<> stop();
+
+    /// makes the appends durable, resolves once they were flushed
+    ss::future<> append(const model::ntp&, std::vector<model::record_batch>);
+
+    /// logs a truncation of the partition at the offset: the appends logged
+    /// before it are not replayed from the offset on
+    ss::future<> truncate(const model::ntp&, model::offset);
+
+    /// \brief generation of the appends, moves forward on every drain
+    ///
+    /// A log whose appends went to an older generation must flush its
+    /// segments before being made durable here again.
+    uint64_t generation() const { return _generation; }
+
+    /// rolls to a new generation and removes the segments of the older ones
+    /// once \p flush_logs flushed the segments of the partitions they hold
+    ss::future<> drain(flush_logs_t flush_logs);
+
+    /// the appends of the partition found on startup, in offset order
+    std::vector<model::record_batch> take_recovered(const model::ntp&);
+
+    /// number of partitions whose appends found on startup were not taken
+    size_t recovered_size() const { return _recovered.size(); }
+
+private:
+    enum class entry_type : int8_t { append = 0, truncate = 1 };
+
+    struct op {
+        std::vector<std::pair<iobuf, iobuf>> records;
+        ss::promise<> done;
+
+        explicit op(std::vector<std::pair<iobuf, iobuf>> records)
+          : records(std::move(records)) {}
+    };
+
+    ss::future<> enqueue(
+      const model::ntp&, std::vector<std::pair<iobuf, iobuf>> records);
+    ss::future<> flush_ops();
+    ss::future<> make_segment();
+    ss::future<> remove_segments(std::vector<ss::lw_shared_ptr<segment>>);
+
+    ss::future<> recover();
+    void apply(model::record_batch);
+
+    class replay_consumer final : public batch_consumer {
+    public:
+        explicit replay_consumer(shard_wal* wal)
+          : _wal(wal) {}
+
+        consume_result
+        accept_batch_start(const model::record_batch_header&) const override;
+        void consume_batch_start(
+          model::record_batch_header header, size_t, size_t) override;
+        void skip_batch_start(
+          model::record_batch_header header, size_t, size_t) override;
+        void consume_records(iobuf&&) override;
+        stop_parser consume_batch_end() override;
+        void print(std::ostream&) const override;
+
+    private:
+        shard_wal* _wal;
+        model::record_batch_header _header;
+        iobuf _records;
+    };
+
+    ntp_config _ntpc;
+    debug_sanitize_files _sanitize_fileops;
+    ss::gate _gate;
+    ss::abort_source _as;
+
+    // appends are queued in `_ops` and group committed by a background fiber
+    // to `_segment`. the mutex serializes the commits with the rolls.
+    std::vector<op> _ops;
+    ss::semaphore _sem{0};
+    mutex _mutex;
+    ss::lw_shared_ptr<segment> _segment;
+    model::offset _next_offset{0};
+    uint64_t _generation{0};
+    // partitions with appends in the current generation
+    absl::flat_hash_set<model::ntp> _ntps;
+
+    // the segments found on startup are removed once all the partitions
+    // took their appends
+    std::vector<ss::lw_shared_ptr<segment>> _recovered_segments;
+    absl::flat_hash_map<model::ntp, std::vector<model::record_batch>>
+      _recovered;
+};
+
+} // namespace storage
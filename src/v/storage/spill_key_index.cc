@@ -33,10 +33,17 @@ spill_key_index::spill_key_index(
   ss::sstring name,
   ss::file index_file,
   ss::io_priority_class p,
-  size_t max_memory)
+  size_t max_memory,
+  compacted_index::key_mode key_mode,
+  write_key_filter with_key_filter)
   : compacted_index_writer::impl(std::move(name))
   , _appender(std::move(index_file), segment_appender::options(p, 1))
-  , _max_mem(max_memory) {}
+  , _max_mem(max_memory)
+  , _key_mode(key_mode) {
+    if (with_key_filter) {
+        _key_filter.emplace();
+    }
+}
 
 spill_key_index::~spill_key_index() {
     vassert(
@@ -45,8 +52,19 @@ spill_key_index::~spill_key_index() {
       _midx.size());
 }
 
+std::optional<bytes> spill_key_index::fingerprint(bytes_view v) const {
+    if (
+      _key_mode == compacted_index::key_mode::full
+      || v.size() <= compacted_index::fingerprint_size) {
+        return std::nullopt;
+    }
+    return compacted_index::fingerprint(v);
+}
+
 ss::future<>
-spill_key_index::index(bytes_view v, model::offset base_offset, int32_t delta) {
+spill_key_index::index(bytes_view k, model::offset base_offset, int32_t delta) {
+    const auto fp = fingerprint(k);
+    const auto v = fp ? bytes_view(*fp) : k;
     if (auto it = _midx.find(v); it != _midx.end()) {
         auto& pair = it->second;
         if (base_offset > pair.base_offset) {
@@ -98,6 +116,9 @@ ss::future<> spill_key_index::add_key(bytes b, value_type v) {
 
 ss::future<>
 spill_key_index::index(bytes&& b, model::offset base_offset, int32_t delta) {
+    if (auto fp = fingerprint(b)) {
+        b = std::move(*fp);
+    }
     if (auto it = _midx.find(b); it != _midx.end()) {
         auto& pair = it->second;
         // must use both base+delta, since we only want to keep the latest
@@ -148,6 +169,9 @@ ss::future<> spill_key_index::spill(
         size_t key_size = std::min(max_key_size, b.size());
 
         payload.append(b.data(), key_size);
+        if (_key_filter && type == compacted_index::entry_type::key) {
+            _key_filter->add(bytes_view(b.data(), key_size));
+        }
     }
     const size_t size = payload.size_bytes() - size_reservation;
     const size_t size_le = ss::cpu_to_le(size); // downcast
@@ -217,16 +241,26 @@ ss::future<> spill_key_index::close() {
           "Failed to drain all keys, {} bytes left",
           _keys_mem_usage);
         _footer.crc = _crc.value();
-        return ss::do_with(
-                 reflection::to_iobuf(_footer),
-                 [this](iobuf& b) {
-                     vassert(
-                       b.size_bytes() == compacted_index::footer_size,
-                       "Footer is bigger than expected: {}",
-                       b);
-                     return _appender.append(b);
-                 })
-          .then([this] { return _appender.close(); });
+        auto f = ss::now();
+        if (_key_filter) {
+            // not part of _footer.size nor the crc; the filter has its own
+            set_flag(compacted_index::footer_flags::key_filter);
+            f = ss::do_with(_key_filter->to_iobuf(), [this](iobuf& b) {
+                return _appender.append(b);
+            });
+        }
+        return f.then([this] {
+            return ss::do_with(
+                     reflection::to_iobuf(_footer),
+                     [this](iobuf& b) {
+                         vassert(
+                           b.size_bytes() == compacted_index::footer_size,
+                           "Footer is bigger than expected: {}",
+                           b);
+                         return _appender.append(b);
+                     })
+              .then([this] { return _appender.close(); });
+        });
     });
 }
 
@@ -250,8 +284,13 @@ std::ostream& operator<<(std::ostream& o, const spill_key_index& k) {
 
 namespace storage {
 compacted_index_writer make_file_backed_compacted_index(
-  ss::sstring name, ss::file f, ss::io_priority_class p, size_t max_memory) {
+  ss::sstring name,
+  ss::file f,
+  ss::io_priority_class p,
+  size_t max_memory,
+  compacted_index::key_mode key_mode,
+  write_key_filter with_key_filter) {
     return compacted_index_writer(std::make_unique<internal::spill_key_index>(
-      std::move(name), std::move(f), p, max_memory));
+      std::move(name), std::move(f), p, max_memory, key_mode, with_key_filter));
 }
 } // namespace storage
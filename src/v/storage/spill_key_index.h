@@ -16,14 +16,17 @@
 #include "model/fundamental.h"
 #include "storage/compacted_index.h"
 #include "storage/compacted_index_writer.h"
+#include "storage/key_bloom_filter.h"
 #include "storage/segment_appender.h"
 #include "utils/vint.h"
 
 #include <seastar/core/file.hh>
 #include <seastar/core/future.hh>
 
-#include <absl/container/node_hash_map.h>
+#include <absl/container/flat_hash_map.h>
 #include <absl/hash/hash.h>
+
+#include <optional>
 namespace storage::internal {
 using namespace storage; // NOLINT
 class spill_key_index final : public compacted_index_writer::impl {
@@ -35,7 +38,7 @@ public:
     static constexpr auto value_sz = sizeof(value_type);
     static constexpr size_t max_key_size = compacted_index::max_entry_size
                                            - (2 * vint::max_length);
-    using underlying_t = absl::node_hash_map<
+    using underlying_t = absl::flat_hash_map<
       bytes,
       value_type,
       bytes_hasher<uint64_t, xxhash_64>,
@@ -45,7 +48,9 @@ public:
       ss::sstring filename,
       ss::file index_file,
       ss::io_priority_class,
-      size_t max_memory);
+      size_t max_memory,
+      compacted_index::key_mode = compacted_index::key_mode::full,
+      write_key_filter = write_key_filter::no);
     spill_key_index(const spill_key_index&) = delete;
     spill_key_index& operator=(const spill_key_index&) = delete;
     spill_key_index(spill_key_index&&) noexcept = default;
@@ -75,6 +80,10 @@ private:
           HashtableDebugAccess<underlying_t>;
         return debug::AllocatedByteSize(_midx);
     }
+    /// \brief fingerprint of the key when the key mode requires one. A
+    /// fingerprint fits the inline storage of `bytes`, so the open
+    /// addressing table holds it without a heap allocation per key
+    std::optional<bytes> fingerprint(bytes_view) const;
     ss::future<> drain_all_keys();
     ss::future<> add_key(bytes b, value_type);
     ss::future<> spill(compacted_index::entry_type, bytes_view, value_type);
@@ -82,6 +91,8 @@ private:
     segment_appender _appender;
     underlying_t _midx;
     size_t _max_mem;
+    compacted_index::key_mode _key_mode;
+    std::optional<key_bloom_filter> _key_filter;
     size_t _keys_mem_usage{0};
     compacted_index::footer _footer;
     crc::crc32c _crc;
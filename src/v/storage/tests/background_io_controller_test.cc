@@ -0,0 +1,84 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "resource_mgmt/foreground_latency.h"
+#include "seastarx.h"
+#include "storage/background_io_controller.h"
+
+#include <seastar/core/io_priority_class.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/unit_test.hpp>
+
+#include <optional>
+
+using namespace std::chrono_literals; // NOLINT
+
+SEASTAR_THREAD_TEST_CASE(test_scale_follows_latency_target) {
+    std::optional<std::chrono::microseconds> latency;
+    double notified = 1.0;
+    auto iopc = ss::io_priority_class::register_one("bg_io_test", 100);
+    storage::background_io_controller ctrl(
+      storage::background_io_controller_config{
+        .latency_target = 10ms,
+        .sampling_interval = 1s,
+        .min_scale = 0.1},
+      {{iopc, 100}},
+      [&latency] { return latency; },
+      [&notified](double s) { notified = s; });
+
+    // idle and under the target the scale stays at its maximum
+    ctrl.update().get();
+    BOOST_REQUIRE_EQUAL(ctrl.scale(), 1.0);
+    latency = 5ms;
+    ctrl.update().get();
+    BOOST_REQUIRE_EQUAL(ctrl.scale(), 1.0);
+
+    // missing the target halves the scale down to the minimum
+    latency = 20ms;
+    ctrl.update().get();
+    BOOST_REQUIRE_EQUAL(ctrl.scale(), 0.5);
+    BOOST_REQUIRE_EQUAL(notified, 0.5);
+    for (int i = 0; i < 5; ++i) {
+        ctrl.update().get();
+    }
+    BOOST_REQUIRE_EQUAL(ctrl.scale(), 0.1);
+    BOOST_REQUIRE_EQUAL(notified, 0.1);
+
+    // meeting it again recovers additively
+    latency = std::nullopt;
+    ctrl.update().get();
+    BOOST_REQUIRE_CLOSE(ctrl.scale(), 0.2, 1e-6);
+    for (int i = 0; i < 10; ++i) {
+        ctrl.update().get();
+    }
+    BOOST_REQUIRE_EQUAL(ctrl.scale(), 1.0);
+    BOOST_REQUIRE_EQUAL(notified, 1.0);
+    ctrl.stop().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_foreground_latency_quantile) {
+    foreground_latency fl;
+    BOOST_REQUIRE(!fl.sample_quantile(0.99));
+
+    for (int i = 0; i < 99; ++i) {
+        fl.record(100us);
+    }
+    fl.record(5000us);
+    // 100us is in [64, 128), 5000us in [4096, 8192)
+    BOOST_REQUIRE(fl.sample_quantile(0.99) == 128us);
+    // sampling resets the distribution
+    BOOST_REQUIRE(!fl.sample_quantile(0.99));
+
+    for (int i = 0; i < 10; ++i) {
+        fl.record(100us);
+        fl.record(5000us);
+    }
+    BOOST_REQUIRE(fl.sample_quantile(0.99) == 8192us);
+}
@@ -43,8 +43,15 @@ static model::record_batch make_random_batch(
 struct batch_cache_test_fixture {
     batch_cache_test_fixture()
       : cache(opts) {}
+    explicit batch_cache_test_fixture(
+      const storage::batch_cache::reclaim_options& o)
+      : cache(o) {}
 
     auto& get_lru() { return cache._lru; };
+    size_t compressed_size() const { return cache._compressed_size_bytes; }
+    size_t reclaim_with_demotion(size_t size) {
+        return cache.reclaim(size, true);
+    }
     ~batch_cache_test_fixture() { cache.stop().get(); }
 
     storage::batch_cache cache;
@@ -306,3 +313,109 @@ FIXTURE_TEST(test_random_batch_sizes, batch_cache_test_fixture) {
         BOOST_REQUIRE_LE(r.waste(), max_waste);
     }
 }
+
+static storage::batch_cache::reclaim_options compressed_tier_opts = {
+  .growth_window = std::chrono::milliseconds(3000),
+  .stable_window = std::chrono::milliseconds(10000),
+  .min_size = 128 << 10,
+  .max_size = 4 << 20,
+  .compressed_tier_max_size = 1 << 20,
+};
+
+struct compressed_tier_fixture : batch_cache_test_fixture {
+    compressed_tier_fixture()
+      : batch_cache_test_fixture(compressed_tier_opts) {}
+};
+
+FIXTURE_TEST(compressed_tier_round_trip, compressed_tier_fixture) {
+    storage::batch_cache_index index(cache);
+
+    std::vector<model::record_batch> batches;
+    model::offset o(0);
+    for (int i = 0; i < 20; ++i) {
+        // highly compressible key/value payloads
+        auto b = make_batch(20, o);
+        o = b.last_offset() + model::offset(1);
+        index.put(b);
+        batches.push_back(std::move(b));
+    }
+
+    reclaim_with_demotion(std::numeric_limits<size_t>::max());
+    BOOST_REQUIRE_GT(compressed_size(), 0);
+    BOOST_REQUIRE(get_lru().empty());
+    BOOST_REQUIRE(!cache.empty());
+
+    // a read promotes the compressed range back into the first tier
+    for (auto& b : batches) {
+        auto res = index.get(b.base_offset());
+        BOOST_REQUIRE(res);
+        BOOST_REQUIRE_EQUAL(*res, b);
+    }
+    BOOST_REQUIRE(!get_lru().empty());
+}
+
+FIXTURE_TEST(compressed_tier_truncate, compressed_tier_fixture) {
+    storage::batch_cache_index index(cache);
+
+    auto b = make_batch(20, model::offset(0));
+    index.put(b);
+    reclaim_with_demotion(std::numeric_limits<size_t>::max());
+    BOOST_REQUIRE_GT(compressed_size(), 0);
+
+    index.truncate(model::offset(0));
+    BOOST_REQUIRE_EQUAL(compressed_size(), 0);
+    BOOST_REQUIRE(!index.get(model::offset(0)));
+}
+
+FIXTURE_TEST(compressed_tier_dropped_by_sync_reclaim, compressed_tier_fixture) {
+    storage::batch_cache_index index(cache);
+
+    index.put(make_batch(20, model::offset(0)));
+    reclaim_with_demotion(std::numeric_limits<size_t>::max());
+    BOOST_REQUIRE_GT(compressed_size(), 0);
+
+    cache.reclaim(std::numeric_limits<size_t>::max());
+    BOOST_REQUIRE_EQUAL(compressed_size(), 0);
+    BOOST_REQUIRE(cache.empty());
+}
+
+FIXTURE_TEST(probationary_batches_reclaimed_first, batch_cache_test_fixture) {
+    storage::batch_cache_index index(
+      cache, storage::batch_cache_admission::scan_resistant);
+
+    index.put(make_batch(10, model::offset(0)));
+    index.put(
+      make_batch(10, model::offset(100)), storage::admit_on_probation::yes);
+
+    // hot and probationary batches never share a range
+    BOOST_REQUIRE_EQUAL(get_lru().size(), 2);
+
+    cache.reclaim(1);
+    BOOST_REQUIRE(!index.get(model::offset(100)));
+    BOOST_REQUIRE(index.get(model::offset(0)));
+}
+
+FIXTURE_TEST(probationary_hit_promotes, batch_cache_test_fixture) {
+    storage::batch_cache_index index(
+      cache, storage::batch_cache_admission::scan_resistant);
+
+    index.put(
+      make_batch(10, model::offset(0)), storage::admit_on_probation::yes);
+    index.put(make_batch(10, model::offset(100)));
+
+    // a hit moves the probationary range to the hot end of the lru
+    BOOST_REQUIRE(index.get(model::offset(0)));
+    cache.reclaim(1);
+    BOOST_REQUIRE(!index.get(model::offset(100)));
+    BOOST_REQUIRE(index.get(model::offset(0)));
+}
+
+FIXTURE_TEST(lru_admission_ignores_probation, batch_cache_test_fixture) {
+    storage::batch_cache_index index(cache);
+
+    index.put(make_batch(10, model::offset(0)));
+    index.put(
+      make_batch(10, model::offset(100)), storage::admit_on_probation::yes);
+
+    BOOST_REQUIRE_EQUAL(get_lru().size(), 1);
+}
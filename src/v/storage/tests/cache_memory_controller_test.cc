@@ -0,0 +1,75 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "storage/cache_memory_controller.h"
+#include "storage/chunk_cache.h"
+#include "units.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+using controller = storage::cache_memory_controller;
+static constexpr size_t step = 1_MiB;
+
+SEASTAR_THREAD_TEST_CASE(test_append_waits_grow_chunk_cache) {
+    auto d = controller::decide(
+      controller::sample{
+        .chunk_waits = 1,
+        .cache_hits = 1000,
+        .cache_misses = 0,
+        .chunk_size_total = 10_MiB,
+        .chunk_size_limit = 10_MiB},
+      step);
+    BOOST_REQUIRE(d == controller::decision::grow_chunk_cache);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_poor_hit_ratio_shrinks_idle_chunk_cache) {
+    controller::sample s{
+      .chunk_waits = 0,
+      .cache_hits = 10,
+      .cache_misses = 990,
+      .chunk_size_total = 2_MiB,
+      .chunk_size_limit = 10_MiB};
+    BOOST_REQUIRE(
+      controller::decide(s, step)
+      == controller::decision::shrink_chunk_cache);
+
+    // appenders are using the memory
+    s.chunk_size_total = 10_MiB;
+    BOOST_REQUIRE(
+      controller::decide(s, step) == controller::decision::none);
+
+    // too few reads to judge the hit ratio
+    s.chunk_size_total = 2_MiB;
+    s.cache_hits = 0;
+    s.cache_misses = controller::min_reads - 1;
+    BOOST_REQUIRE(
+      controller::decide(s, step) == controller::decision::none);
+
+    // healthy hit ratio
+    s.cache_hits = 900;
+    s.cache_misses = 100;
+    BOOST_REQUIRE(
+      controller::decide(s, step) == controller::decision::none);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_chunk_cache_lowered_target_releases_chunks) {
+    storage::internal::chunk_cache cache;
+    std::vector<ss::lw_shared_ptr<storage::segment_appender_chunk>> chunks;
+    for (int i = 0; i < 4; ++i) {
+        chunks.push_back(cache.get().get0());
+    }
+    for (auto& c : chunks) {
+        cache.add(c);
+    }
+    const auto total = cache.size_total();
+    BOOST_REQUIRE_EQUAL(total, 4 * cache.chunk_size());
+
+    cache.set_size_target_and_limit(cache.chunk_size(), cache.size_limit());
+    BOOST_REQUIRE_EQUAL(cache.size_total(), cache.chunk_size());
+}
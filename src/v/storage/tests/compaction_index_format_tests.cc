@@ -22,6 +22,9 @@
 #include "utils/tmpbuf_file.h"
 #include "utils/vint.h"
 
+#include <seastar/core/seastar.hh>
+
+#include <absl/container/flat_hash_map.h>
 #include <boost/test/unit_test_suite.hpp>
 
 struct compacted_topic_fixture {};
@@ -150,6 +153,67 @@ FIXTURE_TEST(
     BOOST_REQUIRE_EQUAL(vec[0].key, bytes_view(key.data(), max_sz));
 }
 
+FIXTURE_TEST(format_verification_fingerprint_keys, compacted_topic_fixture) {
+    tmpbuf_file::store_t index_data;
+    auto idx = storage::make_file_backed_compacted_index(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      1_MiB,
+      storage::compacted_index::key_mode::fingerprint);
+    const auto short_key = random_generators::get_bytes(
+      storage::compacted_index::fingerprint_size);
+    const auto key1 = random_generators::get_bytes(1_KiB);
+    const auto key2 = random_generators::get_bytes(1_MiB);
+    for (auto i = 0; i < 30; i += 3) {
+        idx.index(short_key, model::offset(i), 0).get();
+        idx.index(key1, model::offset(i + 1), 0).get();
+        idx.index(key2, model::offset(i + 2), 0).get();
+    }
+    idx.close().get();
+    info("{}", idx);
+
+    auto rdr = storage::make_file_backed_compacted_reader(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      32_KiB);
+    auto vec = compaction_index_reader_to_memory(std::move(rdr)).get0();
+    BOOST_REQUIRE_EQUAL(vec.size(), 3);
+    absl::flat_hash_map<bytes, model::offset> keys;
+    for (auto& e : vec) {
+        BOOST_REQUIRE_LE(
+          e.key.size(), storage::compacted_index::fingerprint_size);
+        keys.emplace(e.key, e.offset);
+    }
+    BOOST_REQUIRE_EQUAL(keys.size(), 3);
+    BOOST_REQUIRE_EQUAL(keys[short_key], model::offset(27));
+
+    // indexing a fingerprint again must not change it
+    tmpbuf_file::store_t copy_data;
+    auto copy = storage::make_file_backed_compacted_index(
+      "dummy copy",
+      ss::file(ss::make_shared(tmpbuf_file(copy_data))),
+      ss::default_priority_class(),
+      1_MiB,
+      storage::compacted_index::key_mode::fingerprint);
+    for (auto& e : vec) {
+        copy.index(e.key, e.offset, e.delta).get();
+    }
+    copy.close().get();
+    auto copy_rdr = storage::make_file_backed_compacted_reader(
+      "dummy copy",
+      ss::file(ss::make_shared(tmpbuf_file(copy_data))),
+      ss::default_priority_class(),
+      32_KiB);
+    auto copy_vec
+      = compaction_index_reader_to_memory(std::move(copy_rdr)).get0();
+    BOOST_REQUIRE_EQUAL(copy_vec.size(), 3);
+    for (auto& e : copy_vec) {
+        BOOST_REQUIRE_EQUAL(keys[e.key], e.offset);
+    }
+}
+
 FIXTURE_TEST(key_reducer_no_truncate_filter, compacted_topic_fixture) {
     tmpbuf_file::store_t index_data;
     auto idx = storage::make_file_backed_compacted_index(
@@ -344,3 +408,167 @@ FIXTURE_TEST(index_filtered_copy_tests, compacted_topic_fixture) {
         }
     }
 }
+
+FIXTURE_TEST(cross_segment_dedupe_reducer_test, compacted_topic_fixture) {
+    const auto key1 = random_generators::get_bytes(128);
+    const auto key2 = random_generators::get_bytes(128);
+    const auto key3 = random_generators::get_bytes(128);
+
+    // newer segment already recorded key1 and key2
+    storage::internal::key_offset_map map(1_MiB);
+    BOOST_REQUIRE(map.put(key1, model::offset(100)));
+    BOOST_REQUIRE(map.put(key2, model::offset(101)));
+
+    tmpbuf_file::store_t index_data;
+    auto idx = storage::make_file_backed_compacted_index(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      1_KiB);
+    idx.index(key1, model::offset(10), 0).get();
+    idx.index(key3, model::offset(11), 0).get();
+    idx.index(key2, model::offset(12), 0).get();
+    idx.close().get();
+
+    auto rdr = storage::make_file_backed_compacted_reader(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      32_KiB);
+    auto result = rdr
+                    .consume(
+                      storage::internal::cross_segment_dedupe_reducer(map),
+                      model::no_timeout)
+                    .get0();
+
+    BOOST_REQUIRE_EQUAL(result.shadowed, 2);
+    BOOST_REQUIRE_EQUAL(result.to_keep.cardinality(), 1);
+    BOOST_REQUIRE(result.to_keep.contains(1));
+    // survivors are visible to even older segments
+    BOOST_REQUIRE_EQUAL(*map.get(key3), model::offset(11));
+    BOOST_REQUIRE_EQUAL(*map.get(key1), model::offset(100));
+}
+
+FIXTURE_TEST(key_offset_map_max_mem, compacted_topic_fixture) {
+    const auto key1 = random_generators::get_bytes(1_KiB);
+    const auto key2 = random_generators::get_bytes(1_KiB);
+    storage::internal::key_offset_map map(1_KiB);
+
+    BOOST_REQUIRE(map.put(key1, model::offset(1)));
+    BOOST_REQUIRE(map.full());
+    // full map rejects unseen keys but still tracks newer offsets
+    BOOST_REQUIRE(!map.put(key2, model::offset(2)));
+    BOOST_REQUIRE(map.put(key1, model::offset(3)));
+    BOOST_REQUIRE_EQUAL(map.size(), 1);
+    BOOST_REQUIRE_EQUAL(*map.get(key1), model::offset(3));
+    BOOST_REQUIRE(!map.get(key2));
+}
+
+FIXTURE_TEST(key_filter_roundtrip, compacted_topic_fixture) {
+    tmpbuf_file::store_t index_data;
+    auto idx = storage::make_file_backed_compacted_index(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      1_MiB,
+      storage::compacted_index::key_mode::full,
+      storage::write_key_filter::yes);
+    std::vector<bytes> keys;
+    for (auto i = 0; i < 100; ++i) {
+        keys.push_back(random_generators::get_bytes(20));
+        idx.index(keys.back(), model::offset(i), 0).get();
+    }
+    idx.close().get();
+
+    auto rdr = storage::make_file_backed_compacted_reader(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      32_KiB);
+    // the filter must not break the entries nor their checksum
+    rdr.verify_integrity().get();
+    auto footer = rdr.load_footer().get0();
+    BOOST_REQUIRE(bool(
+      footer.flags & storage::compacted_index::footer_flags::key_filter));
+    auto filter = rdr.load_key_filter().get0();
+    BOOST_REQUIRE(filter);
+    for (auto& k : keys) {
+        BOOST_REQUIRE(filter->maybe_contains(k));
+    }
+    size_t false_positives = 0;
+    for (auto i = 0; i < 1000; ++i) {
+        false_positives += filter->maybe_contains(
+          random_generators::get_bytes(20));
+    }
+    BOOST_REQUIRE_LT(false_positives, 10);
+    auto vec = compaction_index_reader_to_memory(rdr).get0();
+    BOOST_REQUIRE_EQUAL(vec.size(), 100);
+}
+
+FIXTURE_TEST(key_filter_absent, compacted_topic_fixture) {
+    tmpbuf_file::store_t index_data;
+    auto idx = storage::make_file_backed_compacted_index(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      1_MiB);
+    idx.index(random_generators::get_bytes(20), model::offset(1), 0).get();
+    idx.close().get();
+
+    auto rdr = storage::make_file_backed_compacted_reader(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      32_KiB);
+    BOOST_REQUIRE(!rdr.load_key_filter().get0());
+}
+
+FIXTURE_TEST(
+  sorted_run_key_reducer_matches_key_reducer, compacted_topic_fixture) {
+    tmpbuf_file::store_t index_data;
+    auto idx = storage::make_file_backed_compacted_index(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      // FORCE eviction with every key basically
+      1_KiB);
+    std::vector<bytes> keys;
+    for (auto i = 0; i < 100; ++i) {
+        keys.push_back(random_generators::get_bytes(64));
+    }
+    for (auto i = 0; i < 1000; ++i) {
+        idx.index(keys[random_generators::get_int(99)], model::offset(i), 0)
+          .get();
+    }
+    idx.close().get();
+
+    auto rdr = storage::make_file_backed_compacted_reader(
+      "dummy name",
+      ss::file(ss::make_shared(tmpbuf_file(index_data))),
+      ss::default_priority_class(),
+      32_KiB);
+    auto expected = rdr
+                      .consume(
+                        storage::internal::compaction_key_reducer(1_MiB),
+                        model::no_timeout)
+                      .get0();
+
+    const auto prefix = std::filesystem::path(fmt::format(
+      "sorted_run_test_{}", random_generators::gen_alphanum_string(6)));
+    rdr.reset();
+    // small enough to spill many runs
+    auto bitmap = rdr
+                    .consume(
+                      storage::internal::sorted_run_key_reducer(
+                        prefix,
+                        2_KiB,
+                        ss::default_priority_class(),
+                        storage::debug_sanitize_files::yes),
+                      model::no_timeout)
+                    .get0();
+
+    info("expected: {}, got: {}", expected.toString(), bitmap.toString());
+    BOOST_REQUIRE(expected == bitmap);
+    BOOST_REQUIRE(
+      !ss::file_exists(fmt::format("{}.run_0", prefix.string())).get0());
+}
@@ -0,0 +1,126 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "config/configuration.h"
+#include "model/record.h"
+#include "storage/header_sidecar.h"
+#include "storage/segment.h"
+#include "storage/tests/disk_log_builder_fixture.h"
+#include "test_utils/fixture.h"
+
+#include <seastar/core/seastar.hh>
+
+#include <vector>
+
+struct header_sidecar_fixture : log_builder_fixture {
+    header_sidecar_fixture() {
+        config::shard_local_cfg().get("segment_header_sidecar").set_value(true);
+    }
+    ~header_sidecar_fixture() {
+        config::shard_local_cfg().get("segment_header_sidecar").set_value(
+          false);
+    }
+
+    std::filesystem::path sidecar_path(storage::segment& s) {
+        return storage::internal::header_sidecar_path(
+          s.reader().filename().c_str());
+    }
+
+    /// headers and file positions of the batches of the segment, as read by
+    /// scan_headers from \p start_pos
+    std::vector<std::pair<model::record_batch_header, size_t>>
+    scan(storage::segment& s, size_t start_pos = 0) {
+        std::vector<std::pair<model::record_batch_header, size_t>> ret;
+        auto pos = start_pos;
+        auto end = storage::scan_headers(
+                     s,
+                     start_pos,
+                     ss::default_priority_class(),
+                     [&ret, &pos](const model::record_batch_header& h) {
+                         ret.emplace_back(h, pos);
+                         pos += h.size_bytes;
+                         return ss::stop_iteration::no;
+                     })
+                     .get0();
+        BOOST_REQUIRE_EQUAL(end, pos);
+        return ret;
+    }
+};
+
+FIXTURE_TEST(scan_reads_headers_from_sidecar, header_sidecar_fixture) {
+    using namespace storage; // NOLINT
+    b | start() | add_segment(0) | add_random_batches(0, 20);
+    // closes the sidecar of the first segment
+    b.get_disk_log_impl().force_roll(ss::default_priority_class()).get();
+
+    auto& seg = b.get_segment(0);
+    BOOST_REQUIRE(!seg.has_header_sidecar());
+    auto sidecar = sidecar_path(seg);
+    BOOST_REQUIRE(ss::file_exists(sidecar.string()).get0());
+
+    auto from_sidecar = scan(seg);
+    BOOST_REQUIRE_EQUAL(
+      ss::file_size(sidecar.string()).get0(),
+      from_sidecar.size() * model::packed_record_batch_header_size);
+
+    auto batches = b.consume().get0();
+    BOOST_REQUIRE_EQUAL(from_sidecar.size(), batches.size());
+    for (size_t i = 0; i < batches.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(
+          from_sidecar[i].first.base_offset, batches[i].base_offset());
+        BOOST_REQUIRE_EQUAL(
+          from_sidecar[i].first.last_offset(), batches[i].last_offset());
+        BOOST_REQUIRE_EQUAL(
+          from_sidecar[i].first.size_bytes, batches[i].size_bytes());
+    }
+    BOOST_REQUIRE_EQUAL(
+      from_sidecar.back().second + from_sidecar.back().first.size_bytes,
+      seg.reader().file_size());
+
+    // starting within the segment, and stopping at a batch
+    auto stop = from_sidecar[10].first.base_offset;
+    auto stop_at = storage::scan_headers(
+                     seg,
+                     from_sidecar[5].second,
+                     ss::default_priority_class(),
+                     [stop](const model::record_batch_header& h) {
+                         return ss::stop_iteration(h.base_offset == stop);
+                     })
+                     .get0();
+    BOOST_REQUIRE_EQUAL(stop_at, from_sidecar[10].second);
+
+    // without the sidecar the headers are read from the data file
+    ss::remove_file(sidecar.string()).get();
+    auto from_data = scan(seg);
+    BOOST_REQUIRE_EQUAL(from_data.size(), from_sidecar.size());
+    for (size_t i = 0; i < from_data.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(from_data[i].first, from_sidecar[i].first);
+        BOOST_REQUIRE_EQUAL(from_data[i].second, from_sidecar[i].second);
+    }
+    b | stop();
+}
+
+FIXTURE_TEST(truncation_removes_sidecar, header_sidecar_fixture) {
+    using namespace storage; // NOLINT
+    b | start() | add_segment(0) | add_random_batches(0, 10);
+    auto& seg = b.get_segment(0);
+    BOOST_REQUIRE(seg.has_header_sidecar());
+    auto sidecar = sidecar_path(seg);
+    auto before = scan(seg);
+
+    b.truncate(before[5].first.base_offset).get();
+    BOOST_REQUIRE(!seg.has_header_sidecar());
+    BOOST_REQUIRE(!ss::file_exists(sidecar.string()).get0());
+    auto after = scan(seg);
+    BOOST_REQUIRE_EQUAL(after.size(), 5);
+    for (size_t i = 0; i < after.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(after[i].first, before[i].first);
+    }
+    b | stop();
+}
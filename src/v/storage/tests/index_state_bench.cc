@@ -0,0 +1,74 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "random/generators.h"
+#include "storage/index_state.h"
+#include "units.h"
+
+#include <seastar/testing/perf_tests.hh>
+
+#include <algorithm>
+#include <vector>
+
+// a 1GB segment indexed every 32KB
+static constexpr uint32_t entries = 32768;
+static constexpr size_t lookups = 1000;
+
+struct index_search_bench {
+    index_search_bench() {
+        storage::index_state st;
+        uint32_t offset = 0;
+        for (uint32_t i = 0; i < entries; ++i) {
+            offset += random_generators::get_int<uint32_t>(1, 100);
+            st.add_entry(offset, i, uint64_t(i) * 32_KiB);
+            sorted.push_back(offset);
+        }
+        auto buf = st.checksum_and_serialize();
+        mapped = std::move(
+          storage::index_state::hydrate_from_buffer(std::move(buf)).value());
+        for (size_t i = 0; i < lookups; ++i) {
+            needles.push_back(random_generators::get_int<uint32_t>(0, offset));
+        }
+    }
+
+    storage::index_state mapped;
+    std::vector<uint32_t> sorted;
+    std::vector<uint32_t> needles;
+};
+
+PERF_TEST_F(index_search_bench, std_lower_bound) {
+    perf_tests::start_measuring_time();
+    for (auto n : needles) {
+        auto it = std::lower_bound(sorted.begin(), sorted.end(), n);
+        perf_tests::do_not_optimize(it);
+    }
+    perf_tests::stop_measuring_time();
+    return lookups;
+}
+
+PERF_TEST_F(index_search_bench, branchless_lower_bound) {
+    perf_tests::start_measuring_time();
+    for (auto n : needles) {
+        auto i = storage::internal::branchless_lower_bound(
+          sorted.data(), sorted.size(), n);
+        perf_tests::do_not_optimize(i);
+    }
+    perf_tests::stop_measuring_time();
+    return lookups;
+}
+
+PERF_TEST_F(index_search_bench, mapped_index_state) {
+    perf_tests::start_measuring_time();
+    for (auto n : needles) {
+        auto i = mapped.lower_bound_relative_offset(n);
+        perf_tests::do_not_optimize(i);
+    }
+    perf_tests::stop_measuring_time();
+    return lookups;
+}
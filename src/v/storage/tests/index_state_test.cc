@@ -97,3 +97,98 @@ BOOST_AUTO_TEST_CASE(encode_decode_future_version) {
     auto dst = storage::index_state::hydrate_from_buffer(src_buf.copy());
     BOOST_REQUIRE(!dst);
 }
+
+static storage::index_state make_index_state_with_entries(uint32_t n) {
+    auto st = make_random_index_state();
+    for (uint32_t i = 1; i < n; ++i) {
+        st.add_entry(i * 10, i * 20, i * 30);
+    }
+    return st;
+}
+
+static ss::temporary_buffer<char> to_temporary_buffer(const iobuf& buf) {
+    auto tmp = iobuf_to_bytes(buf);
+    return ss::temporary_buffer<char>(
+      reinterpret_cast<const char*>(tmp.data()), tmp.size());
+}
+
+BOOST_AUTO_TEST_CASE(encode_decode_in_place) {
+    auto src = make_index_state_with_entries(100);
+    auto src_buf = src.checksum_and_serialize();
+
+    auto dst = storage::index_state::hydrate_from_buffer(
+      to_temporary_buffer(src_buf));
+    BOOST_REQUIRE(dst);
+    BOOST_REQUIRE(dst->is_mapped());
+    BOOST_REQUIRE_EQUAL(dst->entries(), 100);
+    BOOST_REQUIRE(dst->relative_offset_index.empty());
+    BOOST_REQUIRE_EQUAL(src, *dst);
+    BOOST_REQUIRE_EQUAL(
+      dst->lower_bound_relative_offset(500),
+      src.lower_bound_relative_offset(500));
+    BOOST_REQUIRE_EQUAL(
+      dst->lower_bound_relative_time(1001), src.lower_bound_relative_time(1001));
+
+    // serializing a mapped index must be byte for byte identical
+    auto dst_buf = dst->checksum_and_serialize();
+    BOOST_REQUIRE_EQUAL(src_buf, dst_buf);
+}
+
+BOOST_AUTO_TEST_CASE(mutate_mapped_index) {
+    auto src = make_index_state_with_entries(10);
+    auto dst = storage::index_state::hydrate_from_buffer(
+      to_temporary_buffer(src.checksum_and_serialize()));
+    BOOST_REQUIRE(dst && dst->is_mapped());
+
+    dst->pop_back();
+    src.pop_back();
+    BOOST_REQUIRE(!dst->is_mapped());
+    BOOST_REQUIRE_EQUAL(src, *dst);
+
+    dst->add_entry(1000, 2000, 3000);
+    src.add_entry(1000, 2000, 3000);
+    BOOST_REQUIRE_EQUAL(src, *dst);
+}
+
+BOOST_AUTO_TEST_CASE(encode_decode_v3) {
+    auto src = make_index_state_with_entries(10);
+    auto tmp = iobuf_to_bytes(src.checksum_and_serialize());
+
+    // v3 is v4 without the padding that follows the 53 byte header
+    iobuf v3;
+    int8_t version = 3;
+    v3.append((const char*)&version, sizeof(version));
+    uint32_t size_le = ss::cpu_to_le(uint32_t(src.size - 3));
+    v3.append((const char*)&size_le, sizeof(size_le));
+    v3.append(bytes_to_iobuf(tmp.substr(5, 53 - 5)));
+    v3.append(bytes_to_iobuf(tmp.substr(56)));
+
+    auto dst = storage::index_state::hydrate_from_buffer(v3.copy());
+    BOOST_REQUIRE(dst);
+    BOOST_REQUIRE(!dst->is_mapped());
+    BOOST_REQUIRE_EQUAL(dst->entries(), src.entries());
+    for (size_t i = 0; i < src.entries(); ++i) {
+        BOOST_REQUIRE(src.get_entry(i) == dst->get_entry(i));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(branchless_lower_bound_matches_std) {
+    for (size_t n : {0, 1, 2, 15, 16, 17, 33, 100, 1000, 4097}) {
+        std::vector<uint32_t> v;
+        v.reserve(n);
+        uint32_t value = 0;
+        for (size_t i = 0; i < n; ++i) {
+            // duplicates are allowed in the time index
+            value += i % 3;
+            v.push_back(value);
+        }
+        for (uint32_t needle = 0; needle <= value + 1; ++needle) {
+            auto expected = std::distance(
+              v.begin(), std::lower_bound(v.begin(), v.end(), needle));
+            BOOST_REQUIRE_EQUAL(
+              storage::internal::branchless_lower_bound(
+                v.data(), v.size(), needle),
+              size_t(expected));
+        }
+    }
+}
@@ -0,0 +1,204 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/iobuf_parser.h"
+#include "model/namespace.h"
+#include "model/record.h"
+#include "storage/key_index.h"
+#include "storage/record_batch_builder.h"
+#include "storage/segment.h"
+#include "storage/tests/disk_log_builder_fixture.h"
+#include "test_utils/fixture.h"
+
+#include <seastar/core/abort_source.hh>
+#include <seastar/core/seastar.hh>
+
+#include <string_view>
+
+struct key_query_fixture : log_builder_fixture {
+    void start_compacted() {
+        using namespace storage; // NOLINT
+        ntp_config::default_overrides ov;
+        ov.cleanup_policy_bitflags = model::cleanup_policy_bitflags::compaction;
+        b | start(ntp_config(
+          model::ntp(
+            model::kafka_namespace, model::topic("t"), model::partition_id(0)),
+          b.get_log_config().base_dir,
+          std::make_unique<ntp_config::default_overrides>(ov)));
+    }
+
+    /// a batch of records with the keys, each valued `<key>@<offset>`
+    void append(int64_t base, std::vector<std::string_view> keys) {
+        storage::record_batch_builder builder(
+          model::record_batch_type::raft_data, model::offset(base));
+        for (size_t i = 0; i < keys.size(); ++i) {
+            iobuf k;
+            k.append(keys[i].data(), keys[i].size());
+            const auto value = fmt::format("{}@{}", keys[i], base + int64_t(i));
+            iobuf v;
+            v.append(value.data(), value.size());
+            builder.add_raw_kv(std::move(k), std::move(v));
+        }
+        b | storage::add_batch(std::move(builder).build());
+    }
+
+    void append_tombstone(int64_t base, std::string_view key) {
+        storage::record_batch_builder builder(
+          model::record_batch_type::raft_data, model::offset(base));
+        iobuf k;
+        k.append(key.data(), key.size());
+        builder.add_raw_kv(std::move(k), std::nullopt);
+        b | storage::add_batch(std::move(builder).build());
+    }
+
+    void roll() {
+        b.get_disk_log_impl().force_roll(ss::default_priority_class()).get();
+    }
+
+    void housekeeping() {
+        ss::abort_source as;
+        b.get_log()
+          .compact(storage::compaction_config(
+            model::timestamp::min(),
+            std::nullopt,
+            ss::default_priority_class(),
+            as))
+          .get();
+    }
+
+    std::optional<storage::key_query_result>
+    query(std::string_view key, model::offset max = model::offset::max()) {
+        return b.get_log()
+          .key_query(storage::key_query_config(
+            bytes(reinterpret_cast<const uint8_t*>(key.data()), key.size()),
+            max,
+            ss::default_priority_class()))
+          .get0();
+    }
+
+    bool has_key_index(size_t segment) {
+        auto& s = b.get_segment(segment);
+        return ss::file_exists(storage::internal::key_index_path(
+                                 s.reader().filename().c_str())
+                                 .string())
+          .get0();
+    }
+
+    static ss::sstring value_of(const storage::key_query_result& r) {
+        BOOST_REQUIRE(r.value);
+        iobuf_parser p(r.value->copy());
+        return p.read_string(p.bytes_left());
+    }
+};
+
+FIXTURE_TEST(latest_value_across_segments, key_query_fixture) {
+    start_compacted();
+    b | storage::add_segment(0);
+    append(0, {"a", "b", "a"});
+    append(3, {"c"});
+    roll();
+    append(4, {"a", "d"});
+    housekeeping();
+
+    BOOST_REQUIRE(b.get_segment(0).finished_self_compaction());
+    BOOST_REQUIRE(!has_key_index(0));
+
+    // the active segment is scanned
+    auto r = query("a");
+    BOOST_REQUIRE(r);
+    BOOST_REQUIRE_EQUAL(r->offset, model::offset(4));
+    BOOST_REQUIRE_EQUAL(value_of(*r), "a@4");
+
+    // the closed segment is looked up in its key index
+    r = query("b");
+    BOOST_REQUIRE(r);
+    BOOST_REQUIRE_EQUAL(r->offset, model::offset(1));
+    BOOST_REQUIRE_EQUAL(value_of(*r), "b@1");
+    BOOST_REQUIRE(has_key_index(0));
+
+    r = query("c");
+    BOOST_REQUIRE(r);
+    BOOST_REQUIRE_EQUAL(value_of(*r), "c@3");
+
+    BOOST_REQUIRE(!query("e"));
+    b | storage::stop();
+}
+
+FIXTURE_TEST(bounded_by_max_offset, key_query_fixture) {
+    start_compacted();
+    b | storage::add_segment(0);
+    append(0, {"a", "b"});
+    append(2, {"a"});
+    roll();
+    append(3, {"a"});
+    housekeeping();
+
+    auto r = query("a", model::offset(2));
+    BOOST_REQUIRE(r);
+    BOOST_REQUIRE_EQUAL(value_of(*r), "a@2");
+    // the indexed record is past the max offset, the segment is scanned and
+    // the older record of the key was compacted away
+    BOOST_REQUIRE(!query("a", model::offset(1)));
+    BOOST_REQUIRE_EQUAL(
+      query("b", model::offset(1))->offset, model::offset(1));
+    BOOST_REQUIRE(!query("b", model::offset(0)));
+    b | storage::stop();
+}
+
+FIXTURE_TEST(long_keys_and_tombstones, key_query_fixture) {
+    start_compacted();
+    const std::string_view long_key
+      = "a key longer than the fingerprint of the compaction index";
+    b | storage::add_segment(0);
+    append(0, {long_key, "x"});
+    roll();
+    append_tombstone(2, "x");
+    housekeeping();
+
+    auto r = query(long_key);
+    BOOST_REQUIRE(r);
+    BOOST_REQUIRE_EQUAL(value_of(*r), fmt::format("{}@0", long_key));
+
+    // nor a prefix of the key
+    BOOST_REQUIRE(!query(std::string_view(long_key.data(), 20)));
+
+    r = query("x");
+    BOOST_REQUIRE(r);
+    BOOST_REQUIRE_EQUAL(r->offset, model::offset(2));
+    BOOST_REQUIRE(!r->value);
+    b | storage::stop();
+}
+
+FIXTURE_TEST(corrupted_index_is_rebuilt, key_query_fixture) {
+    start_compacted();
+    b | storage::add_segment(0);
+    append(0, {"a", "b"});
+    roll();
+    append(2, {"c"});
+    housekeeping();
+    BOOST_REQUIRE_EQUAL(value_of(*query("a")), "a@0");
+
+    auto& seg = b.get_segment(0);
+    auto idx = seg.cached_key_index();
+    BOOST_REQUIRE(idx);
+    BOOST_REQUIRE_EQUAL(idx->keys(), size_t(2));
+
+    // e.g. a crash while the index was written
+    seg.cached_key_index() = nullptr;
+    {
+        auto path = idx->path().string();
+        auto f = ss::open_file_dma(path, ss::open_flags::wo).get0();
+        f.truncate(10).get();
+        f.close().get();
+    }
+    BOOST_REQUIRE_EQUAL(value_of(*query("b")), "b@1");
+    BOOST_REQUIRE(seg.cached_key_index());
+    BOOST_REQUIRE_EQUAL(seg.cached_key_index()->keys(), size_t(2));
+    b | storage::stop();
+}
@@ -230,3 +230,58 @@ SEASTAR_THREAD_TEST_CASE(kvstore) {
 
     cleanup_store(dir).get();
 }
+
+SEASTAR_THREAD_TEST_CASE(kvstore_key_space_snapshots) {
+    set_configuration("disable_metrics", true);
+
+    auto dir = ssx::sformat(
+      "kvstore_test_{}", random_generators::get_int(4000));
+
+    auto conf = prepare_store(dir).get();
+
+    std::unordered_map<bytes, iobuf> consensus;
+    std::unordered_map<bytes, iobuf> testing;
+
+    auto kvs = std::make_unique<storage::kvstore>(conf);
+    kvs->start().get();
+
+    // written once and carried over by later snapshots without changes
+    for (int i = 0; i < 50; i++) {
+        auto key = random_generators::get_bytes(4);
+        auto value = bytes_to_iobuf(random_generators::get_bytes(100));
+        consensus[key] = value.copy();
+        kvs->put(storage::kvstore::key_space::consensus, key, std::move(value))
+          .get();
+    }
+
+    // enough writes to roll several segments and snapshot each time
+    for (int i = 0; i < 500; i++) {
+        auto key = random_generators::get_bytes(2);
+        auto value = bytes_to_iobuf(random_generators::get_bytes(100));
+        testing[key] = value.copy();
+        kvs->put(storage::kvstore::key_space::testing, key, std::move(value))
+          .get();
+    }
+    kvs->stop().get();
+    kvs.reset(nullptr);
+
+    // shutdown, restart, and verify both key spaces
+    for (int restart = 0; restart < 2; restart++) {
+        kvs = std::make_unique<storage::kvstore>(conf);
+        kvs->start().get();
+        for (auto& e : consensus) {
+            BOOST_REQUIRE(
+              kvs->get(storage::kvstore::key_space::consensus, e.first).value()
+              == e.second);
+        }
+        for (auto& e : testing) {
+            BOOST_REQUIRE(
+              kvs->get(storage::kvstore::key_space::testing, e.first).value()
+              == e.second);
+        }
+        kvs->stop().get();
+        kvs.reset(nullptr);
+    }
+
+    cleanup_store(dir).get();
+}
@@ -114,3 +114,88 @@ SEASTAR_THREAD_TEST_CASE(test_can_load_logs) {
     BOOST_CHECK(
       file_exists(seg4->reader().filename() + ".cannotrecover").get0());
 }
+
+SEASTAR_THREAD_TEST_CASE(test_removed_log_is_reaped_before_managed_again) {
+    auto conf = make_config();
+    storage::api store(
+      storage::kvstore_config(
+        1_MiB, 10ms, conf.base_dir, storage::debug_sanitize_files::yes),
+      conf);
+    store.start().get();
+    auto stop_kvstore = ss::defer([&store] { store.stop().get(); });
+    auto& m = store.log_mgr();
+    auto ntp = model::ntp("ns-removed", "topic-1", 0);
+    auto cfg = config_from_ntp(ntp);
+    directories::initialize(cfg.work_directory()).get();
+    auto seg = m.make_log_segment(
+                  cfg,
+                  model::offset(0),
+                  model::term_id(1),
+                  ss::default_priority_class())
+                 .get0();
+    write_batches(seg);
+    seg->close().get();
+
+    m.manage(config_from_ntp(ntp)).get();
+    BOOST_REQUIRE_EQUAL(m.get(ntp)->segment_count(), 1);
+
+    // the log is unmanaged right away, its files are removed in the background
+    m.remove(ntp).get();
+    BOOST_REQUIRE_EQUAL(m.size(), 0);
+
+    // managing the ntp again waits for the old segments to be removed
+    m.manage(config_from_ntp(ntp)).get();
+    BOOST_REQUIRE_EQUAL(m.get(ntp)->segment_count(), 0);
+    BOOST_REQUIRE(!file_exists(seg->reader().filename()).get0());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_shard_disk_usage) {
+    auto conf = make_config();
+    storage::api store(
+      storage::kvstore_config(
+        1_MiB, 10ms, conf.base_dir, storage::debug_sanitize_files::yes),
+      conf);
+    store.start().get();
+    auto stop_kvstore = ss::defer([&store] { store.stop().get(); });
+    auto& m = store.log_mgr();
+    BOOST_REQUIRE_EQUAL(m.disk_usage(), 0);
+
+    auto ntp1 = model::ntp("ns-usage", "topic-1", 0);
+    auto ntp2 = model::ntp("ns-usage", "topic-1", 1);
+    directories::initialize(config_from_ntp(ntp1).work_directory()).get();
+    auto seg = m.make_log_segment(
+                  config_from_ntp(ntp1),
+                  model::offset(0),
+                  model::term_id(1),
+                  ss::default_priority_class())
+                 .get0();
+    write_batches(seg);
+    seg->close().get();
+
+    // the recovered segments are accounted
+    auto log1 = m.manage(config_from_ntp(ntp1)).get0();
+    BOOST_REQUIRE_GT(log1.size_bytes(), 0);
+    BOOST_REQUIRE_EQUAL(m.disk_usage(), log1.size_bytes());
+
+    // and the appended batches
+    auto log2 = m.manage(config_from_ntp(ntp2)).get0();
+    storage::log_append_config append_cfg{
+      storage::log_append_config::fsync::no,
+      ss::default_priority_class(),
+      model::no_timeout};
+    model::make_memory_record_batch_reader(
+      test::make_random_batches(model::offset(0), 5))
+      .for_each_ref(log2.make_appender(append_cfg), model::no_timeout)
+      .get();
+    BOOST_REQUIRE_GT(log2.size_bytes(), 0);
+    BOOST_REQUIRE_EQUAL(
+      m.disk_usage(), log1.size_bytes() + log2.size_bytes());
+
+    // managing the ntp again waits for its removal, its log is empty
+    m.remove(ntp1).get();
+    BOOST_REQUIRE_EQUAL(
+      m.manage(config_from_ntp(ntp1)).get0().size_bytes(), 0);
+    BOOST_REQUIRE_EQUAL(m.disk_usage(), log2.size_bytes());
+    m.shutdown(ntp2).get();
+    BOOST_REQUIRE_EQUAL(m.disk_usage(), 0);
+}
@@ -10,6 +10,7 @@
 #include "bytes/iobuf.h"
 #include "random/generators.h"
 #include "seastarx.h"
+#include "storage/flush_coordinator.h"
 #include "storage/segment_appender.h"
 
 #include <seastar/core/reactor.hh>
@@ -217,3 +218,43 @@ SEASTAR_THREAD_TEST_CASE(test_can_append_little_data) {
     BOOST_REQUIRE_EQUAL(appender.file_byte_offset(), data.size());
     appender.close().get();
 }
+
+SEASTAR_THREAD_TEST_CASE(test_coalesced_flushes_across_appenders) {
+    auto& coordinator = internal::flushes();
+    auto prev_window = coordinator.window();
+    coordinator.set_window(std::chrono::milliseconds(5));
+
+    std::vector<ss::file> files;
+    std::vector<std::unique_ptr<segment_appender>> appenders;
+    for (int i = 0; i < 8; ++i) {
+        auto f = ss::open_file_dma(
+                   fmt::format("test_segment_appender_coalesce_{}.log", i),
+                   ss::open_flags::create | ss::open_flags::rw
+                     | ss::open_flags::truncate)
+                   .get0();
+        files.push_back(f);
+        appenders.push_back(std::make_unique<segment_appender>(
+          f, segment_appender::options(ss::default_priority_class(), 1)));
+    }
+
+    // flushes requested within one window all complete and cover the data
+    const ss::sstring data = "123456789\n";
+    std::vector<ss::future<>> flushes;
+    for (auto& a : appenders) {
+        a->append(data.data(), data.size()).get();
+        flushes.push_back(a->flush());
+    }
+    ss::when_all_succeed(flushes.begin(), flushes.end()).get();
+
+    for (size_t i = 0; i < appenders.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(appenders[i]->file_byte_offset(), data.size());
+        auto in = make_file_input_stream(files[i], 0);
+        auto result = in.read_exactly(data.size()).get0();
+        BOOST_REQUIRE_EQUAL(
+          std::string_view(result.get(), result.size()),
+          std::string_view(data));
+        in.close().get();
+        appenders[i]->close().get();
+    }
+    coordinator.set_window(prev_window);
+}
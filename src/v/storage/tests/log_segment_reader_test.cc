@@ -19,6 +19,7 @@
 #include "storage/segment_appender_utils.h"
 #include "storage/segment_reader.h"
 #include "storage/tests/utils/random_batch.h"
+#include "units.h"
 #include "utils/disk_log_builder.h"
 #include "utils/file_sanitizer.h"
 
@@ -289,3 +290,27 @@ SEASTAR_THREAD_TEST_CASE(test_does_not_read_past_max_offset) {
     b | stop();
     check_batches(res, batches);
 }
+
+SEASTAR_THREAD_TEST_CASE(test_read_ahead_policy_adapts) {
+    read_ahead_policy policy(1_MiB);
+    BOOST_REQUIRE_EQUAL(policy.size(), read_ahead_policy::min_size);
+
+    // sequential chunks that fill the read grow it up to the maximum
+    for (int i = 0; i < 10; ++i) {
+        policy.record_sequential_read(policy.size());
+    }
+    BOOST_REQUIRE_EQUAL(policy.size(), 1_MiB);
+
+    // sparse chunks shrink it back down
+    policy.record_sequential_read(1_KiB);
+    BOOST_REQUIRE_EQUAL(policy.size(), 512_KiB);
+    for (int i = 0; i < 10; ++i) {
+        policy.record_sequential_read(0);
+    }
+    BOOST_REQUIRE_EQUAL(policy.size(), read_ahead_policy::min_size);
+
+    // a maximum below the default read size is ignored
+    read_ahead_policy small(4_KiB);
+    small.record_sequential_read(1_MiB);
+    BOOST_REQUIRE_EQUAL(small.size(), read_ahead_policy::min_size);
+}
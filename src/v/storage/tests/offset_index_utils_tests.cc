@@ -65,7 +65,7 @@ FIXTURE_TEST(index_round_trip, context) {
     BOOST_REQUIRE(raw_idx != std::nullopt);
     info("verifying tracking info: {}", *raw_idx);
     BOOST_REQUIRE_EQUAL(raw_idx->max_offset(), 1023);
-    BOOST_REQUIRE_EQUAL(raw_idx->relative_offset_index.size(), 1024);
+    BOOST_REQUIRE_EQUAL(raw_idx->entries(), 1024);
 }
 
 FIXTURE_TEST(bucket_bug1, context) {
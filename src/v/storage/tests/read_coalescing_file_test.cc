@@ -0,0 +1,93 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "random/generators.h"
+#include "ssx/sformat.h"
+#include "storage/read_coalescing_file.h"
+
+#include <seastar/core/file.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include <cstring>
+
+static ss::sstring write_file(size_t size) {
+    auto name = ssx::sformat(
+      "read_coalescing_file_test_{}", random_generators::get_int(10000));
+    auto fd = ss::open_file_dma(
+                name,
+                ss::open_flags::create | ss::open_flags::rw
+                  | ss::open_flags::truncate)
+                .get0();
+    auto out = ss::make_file_output_stream(std::move(fd)).get0();
+    const auto b = random_generators::gen_alphanum_string(size);
+    out.write(b.data(), b.size()).get();
+    out.flush().get();
+    out.close().get();
+    return name;
+}
+
+static bool same_bytes(
+  const ss::temporary_buffer<uint8_t>& a,
+  const ss::temporary_buffer<uint8_t>& b) {
+    return a.size() == b.size()
+           && std::memcmp(a.get(), b.get(), a.size()) == 0;
+}
+
+SEASTAR_THREAD_TEST_CASE(concurrent_reads_share_disk_read) {
+    auto name = write_file(16384);
+    auto plain = ss::open_file_dma(name, ss::open_flags::ro).get0();
+    auto impl = ss::make_shared<storage::read_coalescing_file>(
+      ss::open_file_dma(name, ss::open_flags::ro).get0());
+    ss::file f(impl);
+
+    auto first = f.dma_read_bulk<uint8_t>(0, 8192);
+    auto same = f.dma_read_bulk<uint8_t>(0, 8192);
+    auto within = f.dma_read_bulk<uint8_t>(4096, 4096);
+    auto beyond = f.dma_read_bulk<uint8_t>(4096, 8192);
+    auto first_buf = first.get0();
+    auto same_buf = same.get0();
+    auto within_buf = within.get0();
+    auto beyond_buf = beyond.get0();
+    BOOST_REQUIRE_EQUAL(impl->coalesced_reads(), 2);
+
+    BOOST_REQUIRE(
+      same_bytes(first_buf, plain.dma_read_bulk<uint8_t>(0, 8192).get0()));
+    BOOST_REQUIRE(same_bytes(same_buf, first_buf));
+    BOOST_REQUIRE(
+      same_bytes(within_buf, plain.dma_read_bulk<uint8_t>(4096, 4096).get0()));
+    BOOST_REQUIRE(
+      same_bytes(beyond_buf, plain.dma_read_bulk<uint8_t>(4096, 8192).get0()));
+
+    // once completed, reads are issued again
+    f.dma_read_bulk<uint8_t>(0, 8192).get();
+    BOOST_REQUIRE_EQUAL(impl->coalesced_reads(), 2);
+
+    plain.close().get();
+    f.close().get();
+    ss::remove_file(name).get();
+}
+
+SEASTAR_THREAD_TEST_CASE(short_read_is_shared) {
+    auto name = write_file(4096);
+    auto impl = ss::make_shared<storage::read_coalescing_file>(
+      ss::open_file_dma(name, ss::open_flags::ro).get0());
+    ss::file f(impl);
+
+    // the first read reaches past the end of the file
+    auto first = f.dma_read_bulk<uint8_t>(0, 16384);
+    auto past_end = f.dma_read_bulk<uint8_t>(8192, 4096);
+    BOOST_REQUIRE_EQUAL(first.get0().size(), 4096);
+    BOOST_REQUIRE_EQUAL(past_end.get0().size(), 0);
+    BOOST_REQUIRE_EQUAL(impl->coalesced_reads(), 1);
+
+    f.close().get();
+    ss::remove_file(name).get();
+}
@@ -0,0 +1,114 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "config/configuration.h"
+#include "model/namespace.h"
+#include "model/record.h"
+#include "random/generators.h"
+#include "storage/parser_utils.h"
+#include "storage/segment.h"
+#include "storage/tests/disk_log_builder_fixture.h"
+#include "test_utils/fixture.h"
+
+#include <seastar/core/abort_source.hh>
+
+#include <chrono>
+
+struct recompression_fixture : log_builder_fixture {
+    recompression_fixture() {
+        config::shard_local_cfg()
+          .get("storage_recompression_min_age_ms")
+          .set_value(std::make_optional(std::chrono::milliseconds(0)));
+    }
+    ~recompression_fixture() {
+        config::shard_local_cfg()
+          .get("storage_recompression_min_age_ms")
+          .set_value(std::optional<std::chrono::milliseconds>{});
+    }
+
+    void housekeeping() {
+        ss::abort_source as;
+        b.get_log()
+          .compact(storage::compaction_config(
+            model::timestamp::min(),
+            std::nullopt,
+            ss::default_priority_class(),
+            as))
+          .get();
+    }
+
+    static model::record_batch uncompressed(model::record_batch b) {
+        if (!b.compressed()) {
+            return b;
+        }
+        return storage::internal::decompress_batch(std::move(b)).get0();
+    }
+};
+
+static model::ntp kafka_ntp() {
+    return model::ntp(
+      model::kafka_namespace,
+      model::topic(random_generators::gen_alphanum_string(8)),
+      model::partition_id(0));
+}
+
+FIXTURE_TEST(recompresses_closed_segments, recompression_fixture) {
+    using namespace storage; // NOLINT
+    b | start(kafka_ntp()) | add_segment(0)
+      | add_random_batches(0, 20, maybe_compress_batches::no);
+    b.get_disk_log_impl().force_roll(ss::default_priority_class()).get();
+    auto before = b.consume().get0();
+    const auto size_before = b.get_segment(0).size_bytes();
+
+    housekeeping();
+
+    auto& seg = b.get_segment(0);
+    BOOST_REQUIRE(seg.is_recompressed());
+    BOOST_REQUIRE_LT(seg.size_bytes(), size_before);
+    auto after = b.consume().get0();
+    BOOST_REQUIRE_EQUAL(after.size(), before.size());
+    for (size_t i = 0; i < after.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(after[i].base_offset(), before[i].base_offset());
+        BOOST_REQUIRE_EQUAL(after[i].last_offset(), before[i].last_offset());
+        BOOST_REQUIRE(
+          !after[i].compressed()
+          || after[i].header().attrs.compression()
+               == model::compression::zstd);
+        BOOST_REQUIRE_EQUAL(
+          uncompressed(after[i].copy()).data(),
+          uncompressed(before[i].copy()).data());
+    }
+
+    // the batches of the active segment are left as they are
+    BOOST_REQUIRE(!b.get_segment(1).is_recompressed());
+    b | stop();
+}
+
+FIXTURE_TEST(skips_recompressed_segments, recompression_fixture) {
+    using namespace storage; // NOLINT
+    config::shard_local_cfg()
+      .get("storage_recompression_type")
+      .set_value(model::compression::lz4);
+    b | start(kafka_ntp()) | add_segment(0)
+      | add_random_batches(0, 10, maybe_compress_batches::no);
+    b.get_disk_log_impl().force_roll(ss::default_priority_class()).get();
+
+    housekeeping();
+    auto& seg = b.get_segment(0);
+    BOOST_REQUIRE(seg.is_recompressed());
+    const auto size = seg.size_bytes();
+
+    // a new pass with another codec does not rewrite the segment
+    config::shard_local_cfg()
+      .get("storage_recompression_type")
+      .set_value(model::compression::zstd);
+    housekeeping();
+    BOOST_REQUIRE_EQUAL(b.get_segment(0).size_bytes(), size);
+    b | stop();
+}
@@ -14,6 +14,7 @@
 #include "model/record.h"
 #include "random/generators.h"
 #include "reflection/adl.h"
+#include "storage/parser_utils.h"
 #include "storage/record_batch_builder.h"
 
 #include <seastar/testing/thread_test_case.hh>
@@ -126,3 +127,42 @@ SEASTAR_THREAD_TEST_CASE(serialize_deserialize_then_cmp) {
     });
     BOOST_CHECK_EQUAL(sample_data, sample_output);
 }
+
+SEASTAR_THREAD_TEST_CASE(iterate_compressed_records) {
+    storage::record_batch_builder rbb(
+      model::record_batch_type::raft_data, model::offset(0));
+    // records larger than the incremental decompression step
+    for (auto i = 0; i < 20; ++i) {
+        iobuf key, value;
+        key.append(random_generators::gen_alphanum_string(16).data(), 16);
+        auto v = random_generators::gen_alphanum_string(
+          random_generators::get_int(1, 100000));
+        value.append(v.data(), v.size());
+        rbb.add_raw_kv(std::move(key), std::move(value));
+    }
+    auto batch = std::move(rbb).build();
+    const auto expected = batch.copy_records();
+
+    for (auto c :
+         {model::compression::gzip,
+          model::compression::snappy,
+          model::compression::lz4,
+          model::compression::zstd}) {
+        auto compressed = storage::internal::compress_batch(c, batch).get0();
+        std::vector<model::record> records;
+        storage::internal::for_each_compressed_record(
+          compressed,
+          [&records](model::record& r) {
+              records.push_back(r.share());
+              return ss::now();
+          })
+          .get();
+        BOOST_REQUIRE_EQUAL(records.size(), expected.size());
+        for (size_t i = 0; i < records.size(); ++i) {
+            BOOST_CHECK_EQUAL(records[i].key(), expected[i].key());
+            BOOST_CHECK_EQUAL(records[i].value(), expected[i].value());
+            BOOST_CHECK_EQUAL(
+              records[i].offset_delta(), expected[i].offset_delta());
+        }
+    }
+}
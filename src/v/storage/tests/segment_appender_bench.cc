@@ -0,0 +1,73 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "random/generators.h"
+#include "storage/segment_appender.h"
+#include "units.h"
+#include "utils/hdr_hist.h"
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/file.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/testing/perf_tests.hh>
+
+#include <fmt/format.h>
+
+// every iteration writes a 16MiB segment as a stream of flushed 16KiB appends
+static constexpr size_t append_size = 16_KiB;
+static constexpr size_t appends_per_iteration = 1024;
+
+struct appender_bench {
+    ~appender_bench() {
+        fmt::print(
+          "fallocation step {}: append+flush p50: {}us p99: {}us\n",
+          falloc_step,
+          hist.get_value_at(50),
+          hist.get_value_at(99));
+    }
+
+    ss::future<size_t> run(size_t step) {
+        falloc_step = step;
+        const auto name = fmt::format("appender_bench_{}.log", falloc_step);
+        auto f = co_await ss::open_file_dma(
+          name,
+          ss::open_flags::create | ss::open_flags::rw
+            | ss::open_flags::truncate);
+        auto appender = storage::segment_appender(
+          f,
+          storage::segment_appender::options(
+            ss::default_priority_class(), 1, falloc_step));
+
+        perf_tests::start_measuring_time();
+        for (size_t i = 0; i < appends_per_iteration; ++i) {
+            auto m = hist.auto_measure();
+            co_await appender.append(data.data(), data.size());
+            co_await appender.flush();
+        }
+        perf_tests::stop_measuring_time();
+
+        co_await appender.close();
+        co_await ss::remove_file(name);
+        co_return appends_per_iteration;
+    }
+
+    const ss::sstring data = random_generators::gen_alphanum_string(
+      append_size);
+    size_t falloc_step{0};
+    hdr_hist hist;
+};
+
+PERF_TEST_F(appender_bench, append_preallocated) {
+    return run(storage::segment_appender::fallocation_step);
+}
+
+PERF_TEST_F(appender_bench, append_not_preallocated) {
+    return run(0);
+}
@@ -0,0 +1,121 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "model/fundamental.h"
+#include "random/generators.h"
+#include "storage/shard_wal.h"
+#include "storage/tests/utils/random_batch.h"
+
+#include <seastar/core/seastar.hh>
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/util/file.hh>
+
+static model::ntp test_ntp(int p) {
+    return model::ntp(
+      model::ns("kafka"), model::topic("tapioca"), model::partition_id(p));
+}
+
+static model::record_batch make_batch(model::offset o, model::term_id t) {
+    auto b = storage::test::make_random_batch(o, 3, false);
+    b.set_term(t);
+    return b;
+}
+
+static std::vector<model::record_batch>
+batches_of(std::initializer_list<model::record_batch*> batches) {
+    std::vector<model::record_batch> ret;
+    for (auto b : batches) {
+        ret.push_back(b->copy());
+    }
+    return ret;
+}
+
+static ss::sstring prepare_dir() {
+    auto dir = ssx::sformat(
+      "shard_wal_test_{}", random_generators::get_int(4000));
+    if (ss::file_exists(dir).get0()) {
+        ss::recursive_remove_directory(std::filesystem::path(dir)).get();
+    }
+    return dir;
+}
+
+SEASTAR_THREAD_TEST_CASE(replays_appends_and_truncations) {
+    auto dir = prepare_dir();
+    auto a = make_batch(model::offset(0), model::term_id(1));
+    auto b = make_batch(model::offset(3), model::term_id(1));
+    auto c = make_batch(model::offset(6), model::term_id(1));
+    auto b2 = make_batch(model::offset(3), model::term_id(2));
+    auto other = make_batch(model::offset(0), model::term_id(1));
+
+    {
+        storage::shard_wal wal(dir, storage::debug_sanitize_files::yes);
+        wal.start().get();
+        wal.append(test_ntp(0), batches_of({&a, &b, &c})).get();
+        // a new leader overwrites the tail of the log
+        wal.truncate(test_ntp(0), model::offset(3)).get();
+        wal.append(test_ntp(0), batches_of({&b2})).get();
+        wal.append(test_ntp(1), batches_of({&other})).get();
+        // the partition was removed
+        wal.append(test_ntp(2), batches_of({&other})).get();
+        wal.truncate(test_ntp(2), model::offset::min()).get();
+        wal.stop().get();
+    }
+
+    storage::shard_wal wal(dir, storage::debug_sanitize_files::yes);
+    wal.start().get();
+    BOOST_REQUIRE_EQUAL(wal.recovered_size(), 2);
+
+    auto recovered = wal.take_recovered(test_ntp(0));
+    BOOST_REQUIRE_EQUAL(recovered.size(), 2);
+    BOOST_REQUIRE_EQUAL(recovered[0], a);
+    BOOST_REQUIRE_EQUAL(recovered[1], b2);
+    BOOST_REQUIRE_EQUAL(wal.take_recovered(test_ntp(1)).size(), 1);
+    BOOST_REQUIRE(wal.take_recovered(test_ntp(2)).empty());
+    BOOST_REQUIRE_EQUAL(wal.recovered_size(), 0);
+    wal.stop().get();
+
+    ss::recursive_remove_directory(std::filesystem::path(dir)).get();
+}
+
+SEASTAR_THREAD_TEST_CASE(drain_removes_flushed_appends) {
+    auto dir = prepare_dir();
+    auto a = make_batch(model::offset(0), model::term_id(1));
+    auto b = make_batch(model::offset(3), model::term_id(1));
+
+    {
+        storage::shard_wal wal(dir, storage::debug_sanitize_files::yes);
+        wal.start().get();
+        wal.append(test_ntp(0), batches_of({&a})).get();
+        const auto generation = wal.generation();
+
+        absl::flat_hash_set<model::ntp> flushed;
+        wal
+          .drain([&flushed](absl::flat_hash_set<model::ntp> ntps) {
+              flushed = std::move(ntps);
+              return ss::now();
+          })
+          .get();
+        BOOST_REQUIRE_GT(wal.generation(), generation);
+        BOOST_REQUIRE(flushed.contains(test_ntp(0)));
+
+        // appends after the drain stay until the next one
+        wal.append(test_ntp(1), batches_of({&b})).get();
+        wal.stop().get();
+    }
+
+    storage::shard_wal wal(dir, storage::debug_sanitize_files::yes);
+    wal.start().get();
+    BOOST_REQUIRE(wal.take_recovered(test_ntp(0)).empty());
+    auto recovered = wal.take_recovered(test_ntp(1));
+    BOOST_REQUIRE_EQUAL(recovered.size(), 1);
+    BOOST_REQUIRE_EQUAL(recovered[0], b);
+    wal.stop().get();
+
+    ss::recursive_remove_directory(std::filesystem::path(dir)).get();
+}
@@ -8,6 +8,7 @@
 // by the Apache License, Version 2.0
 
 #include "bytes/bytes.h"
+#include "config/configuration.h"
 #include "model/fundamental.h"
 #include "model/record.h"
 #include "model/record_batch_reader.h"
@@ -15,7 +16,9 @@
 #include "model/timestamp.h"
 #include "random/generators.h"
 #include "storage/batch_cache.h"
+#include "storage/lock_manager.h"
 #include "storage/log_manager.h"
+#include "storage/log_reader.h"
 #include "storage/record_batch_builder.h"
 #include "storage/segment_utils.h"
 #include "storage/tests/storage_test_fixture.h"
@@ -1482,6 +1485,57 @@ FIXTURE_TEST(many_segment_locking, storage_test_fixture) {
         BOOST_REQUIRE(locks.size() == segments.size());
     }
 }
+FIXTURE_TEST(reader_locks_segment_being_read, storage_test_fixture) {
+    auto cfg = default_log_config(test_dir);
+    cfg.stype = storage::log_config::storage_type::disk;
+    storage::log_manager mgr = make_log_manager(cfg);
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    auto ntp = model::ntp("default", "test", 0);
+    auto log
+      = mgr.manage(storage::ntp_config(ntp, mgr.config().base_dir)).get0();
+
+    auto disk_log = get_disk_log(log);
+    append_single_record_batch(log, 20, model::term_id(1));
+    disk_log->force_roll(ss::default_priority_class()).get();
+    append_single_record_batch(log, 30, model::term_id(2));
+    disk_log->force_roll(ss::default_priority_class()).get();
+    append_single_record_batch(log, 40, model::term_id(3));
+    log.flush().get0();
+
+    std::vector<ss::lw_shared_ptr<storage::segment>> segments;
+    std::copy(
+      disk_log->segments().begin(),
+      disk_log->segments().end(),
+      std::back_inserter(segments));
+    BOOST_REQUIRE_EQUAL(segments.size(), 3);
+
+    storage::lock_manager lock_mngr(disk_log->segments());
+    storage::probe pb;
+    storage::log_reader_config reader_cfg(
+      model::offset(0), model::offset::max(), ss::default_priority_class());
+    auto lease = lock_mngr.range_lock(reader_cfg).get0();
+    BOOST_REQUIRE_EQUAL(lease->range.size(), 3);
+    BOOST_REQUIRE_EQUAL(lease->locks.size(), 1);
+    auto reader = model::make_record_batch_reader<storage::log_reader>(
+      std::move(lease), reader_cfg, pb);
+
+    auto deadline = [] {
+        return ss::semaphore::clock::now() + std::chrono::milliseconds(100);
+    };
+    // the segments the reader didn't reach yet may be rewritten
+    segments[1]->write_lock(deadline()).get0();
+    segments[2]->write_lock(deadline()).get0();
+    BOOST_REQUIRE_THROW(
+      segments[0]->write_lock(deadline()).get0(), ss::semaphore_timed_out);
+
+    auto batches = model::consume_reader_to_memory(
+                     std::move(reader), model::no_timeout)
+                     .get0();
+    BOOST_REQUIRE_EQUAL(batches.size(), 90);
+    BOOST_REQUIRE_EQUAL(batches.back().last_offset(), model::offset(89));
+    segments[0]->write_lock(deadline()).get0();
+}
+
 FIXTURE_TEST(reader_reusability_test_parser_header, storage_test_fixture) {
     auto cfg = default_log_config(test_dir);
     cfg.stype = storage::log_config::storage_type::disk;
@@ -1976,3 +2030,118 @@ FIXTURE_TEST(reader_prevents_log_shutdown, storage_test_fixture) {
     }
     f.get();
 }
+
+FIXTURE_TEST(clean_shutdown_skips_recovery, storage_test_fixture) {
+    auto ntp = model::ntp("default", "test", 0);
+    auto key = storage::internal::clean_shutdown_key(ntp);
+    std::vector<model::record_batch_header> headers;
+    storage::offset_stats offsets_before;
+    {
+        storage::log_manager mgr = make_log_manager();
+        auto log
+          = mgr.manage(storage::ntp_config(ntp, mgr.config().base_dir)).get0();
+        headers = append_random_batches(log, 10);
+        offsets_before = log.offsets();
+        mgr.stop().get();
+    }
+    // clean close records the segments
+    BOOST_REQUIRE(kvstore.get(storage::kvstore::key_space::storage, key));
+
+    storage::log_manager mgr = make_log_manager();
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    auto log
+      = mgr.manage(storage::ntp_config(ntp, mgr.config().base_dir)).get0();
+    // the record is consumed by recovery
+    BOOST_REQUIRE(!kvstore.get(storage::kvstore::key_space::storage, key));
+
+    BOOST_REQUIRE_EQUAL(log.offsets().dirty_offset, offsets_before.dirty_offset);
+    auto batches = read_and_validate_all_batches(log);
+    BOOST_REQUIRE_EQUAL(headers.size(), batches.size());
+    validate_offsets(model::offset(0), headers, batches);
+
+    // appends continue after the trusted segment
+    append_random_batches(log, 1);
+    BOOST_REQUIRE_GT(log.offsets().dirty_offset, offsets_before.dirty_offset);
+}
+
+FIXTURE_TEST(scrubbed_segments_are_verified, storage_test_fixture) {
+    auto ntp = model::ntp("default", "test", 0);
+    std::vector<model::record_batch_header> headers;
+    {
+        storage::log_manager mgr = make_log_manager();
+        auto log
+          = mgr.manage(storage::ntp_config(ntp, mgr.config().base_dir)).get0();
+        headers = append_random_batches(log, 10);
+        mgr.stop().get();
+    }
+
+    // segments recovered at startup have no appender
+    storage::log_manager mgr = make_log_manager();
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    auto log
+      = mgr.manage(storage::ntp_config(ntp, mgr.config().base_dir)).get0();
+    auto disk_log = get_disk_log(log);
+    for (auto& s : disk_log->segments()) {
+        BOOST_REQUIRE(!s->is_verified());
+    }
+
+    ss::abort_source as;
+    log.scrub(ss::default_priority_class(), as).get();
+    for (auto& s : disk_log->segments()) {
+        BOOST_REQUIRE(s->is_verified());
+    }
+
+    // reads of verified segments skip the header crc
+    auto batches = read_and_validate_all_batches(log);
+    BOOST_REQUIRE_EQUAL(headers.size(), batches.size());
+    validate_offsets(model::offset(0), headers, batches);
+}
+
+FIXTURE_TEST(in_memory_topic_is_bounded, storage_test_fixture) {
+    config::shard_local_cfg().get("in_memory_log_max_bytes").set_value(
+      size_t(2_KiB));
+    auto reset = ss::defer([] {
+        config::shard_local_cfg().get("in_memory_log_max_bytes").set_value(
+          size_t(64_MiB));
+    });
+    auto cfg = default_log_config(test_dir);
+    cfg.stype = storage::log_config::storage_type::disk;
+    storage::log_manager mgr = make_log_manager(cfg);
+    auto deferred = ss::defer([&mgr]() mutable { mgr.stop().get0(); });
+    using overrides_t = storage::ntp_config::default_overrides;
+    overrides_t ov;
+    ov.in_memory = storage::in_memory_log::yes;
+    auto ntp = model::ntp("kafka", "ephemeral", 0);
+    auto log = mgr.manage(storage::ntp_config(
+                            ntp,
+                            mgr.config().base_dir,
+                            std::make_unique<overrides_t>(ov)))
+                 .get0();
+    BOOST_REQUIRE(get_disk_log(log) == nullptr);
+
+    // nothing is evicted before it is collectible
+    auto headers = append_random_batches(log, 30);
+    BOOST_REQUIRE_EQUAL(log.offsets().start_offset, model::offset(0));
+    auto batches = read_and_validate_all_batches(log);
+    validate_offsets(model::offset(0), headers, batches);
+
+    log.set_collectible_offset(log.offsets().dirty_offset);
+    append_random_batches(log, 1);
+    BOOST_REQUIRE_GT(log.offsets().start_offset, model::offset(0));
+
+    ss::abort_source as;
+    log.set_collectible_offset(log.offsets().dirty_offset);
+    log
+      .compact(storage::compaction_config(
+        model::timestamp::min(),
+        std::nullopt,
+        ss::default_priority_class(),
+        as))
+      .get();
+    BOOST_REQUIRE_LE(log.size_bytes(), 2_KiB);
+    BOOST_REQUIRE_GT(log.size_bytes(), 0);
+
+    // the batches were never written to disk
+    BOOST_REQUIRE(std::filesystem::is_empty(
+      std::filesystem::path(log.config().work_directory())));
+}
@@ -8,11 +8,15 @@
 // by the Apache License, Version 2.0
 
 #include "config/configuration.h"
+#include "random/generators.h"
 #include "storage/tests/disk_log_builder_fixture.h"
 #include "storage/tests/utils/random_batch.h"
 #include "test_utils/fixture.h"
 
 #include <seastar/core/file.hh>
+#include <seastar/core/lowres_clock.hh>
+
+#include <chrono>
 
 FIXTURE_TEST(timequery, log_builder_fixture) {
     using namespace storage; // NOLINT
@@ -114,3 +118,49 @@ FIXTURE_TEST(timequery_single_value, log_builder_fixture) {
     BOOST_TEST(res->offset == model::offset(0));
     b | stop();
 }
+
+FIXTURE_TEST(timequery_many_segments, log_builder_fixture) {
+    using namespace storage; // NOLINT
+
+    b | start();
+
+    // 1000 segments, each with 10 batches; offset == timestamp
+    static constexpr int segments = 1000;
+    static constexpr int batches_per_segment = 10;
+    for (auto s = 0; s < segments; ++s) {
+        const auto base = s * batches_per_segment;
+        b | add_segment(base);
+        for (auto o = base; o < base + batches_per_segment; ++o) {
+            auto batch = test::make_random_batch(model::offset(o), 1, false);
+            batch.header().first_timestamp = model::timestamp(o);
+            batch.header().max_timestamp = model::timestamp(o);
+            b | add_batch(std::move(batch));
+        }
+    }
+
+    auto log = b.get_log();
+    static constexpr int queries = 2000;
+    auto start = ss::lowres_clock::now();
+    for (auto q = 0; q < queries; ++q) {
+        const auto ts = random_generators::get_int(
+          0, segments * batches_per_segment - 1);
+        storage::timequery_config config(
+          model::timestamp(ts),
+          log.offsets().dirty_offset,
+          ss::default_priority_class());
+
+        auto res = log.timequery(config).get0();
+        BOOST_REQUIRE(res);
+        BOOST_REQUIRE_EQUAL(res->time, model::timestamp(ts));
+        BOOST_REQUIRE_EQUAL(res->offset, model::offset(ts));
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      ss::lowres_clock::now() - start);
+    info(
+      "{} timequeries over {} segments took {}ms",
+      queries,
+      segments,
+      elapsed.count());
+
+    b | stop();
+}
@@ -50,23 +50,48 @@ std::ostream& operator<<(std::ostream& o, const timequery_result& a) {
 std::ostream& operator<<(std::ostream& o, const timequery_config& a) {
     return o << "{max_offset:" << a.max_offset << ", time:" << a.time << "}";
 }
+std::ostream& operator<<(std::ostream& o, const key_query_config& a) {
+    return o << "{max_offset:" << a.max_offset
+             << ", key_size:" << a.key.size() << "}";
+}
+std::ostream& operator<<(std::ostream& o, const key_query_result& a) {
+    return o << "{offset:" << a.offset << ", time:" << a.time
+             << ", value_size:"
+             << (a.value ? int64_t(a.value->size_bytes()) : -1) << "}";
+}
 
 std::ostream&
 operator<<(std::ostream& o, const ntp_config::default_overrides& v) {
     fmt::print(
       o,
       "{{compaction_strategy: {}, cleanup_policy_bitflags: {}, segment_size: "
-      "{}, retention_bytes: {}, retention_time_ms: {}, recovery_enabled: {}}}",
+      "{}, retention_bytes: {}, retention_time_ms: {}, recovery_enabled: {}, "
+      "cache_admission: {}, compression: {}, in_memory: {}, write_caching: "
+      "{}}}",
       v.compaction_strategy,
       v.cleanup_policy_bitflags,
       v.segment_size,
       v.retention_bytes,
       v.retention_time,
-      v.recovery_enabled);
+      v.recovery_enabled,
+      v.cache_admission,
+      v.compression,
+      v.in_memory,
+      v.write_caching);
 
     return o;
 }
 
+std::ostream& operator<<(std::ostream& o, batch_cache_admission a) {
+    switch (a) {
+    case batch_cache_admission::lru:
+        return o << "lru";
+    case batch_cache_admission::scan_resistant:
+        return o << "scan_resistant";
+    }
+    return o << "unknown";
+}
+
 std::ostream& operator<<(std::ostream& o, const ntp_config& v) {
     o << "{ntp:" << v.ntp() << ", base_dir:" << v.base_directory()
       << ", overrides:";
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include "bytes/bytes.h"
 #include "model/fundamental.h"
 #include "model/limits.h"
 #include "model/record.h"
@@ -156,6 +157,28 @@ struct timequery_result {
     friend std::ostream& operator<<(std::ostream& o, const timequery_result&);
 };
 
+/// \brief latest record of a key of a compacted log, see log::key_query
+struct key_query_config {
+    key_query_config(
+      bytes k, model::offset o, ss::io_priority_class iop) noexcept
+      : key(std::move(k))
+      , max_offset(o)
+      , prio(iop) {}
+    bytes key;
+    model::offset max_offset;
+    ss::io_priority_class prio;
+
+    friend std::ostream& operator<<(std::ostream& o, const key_query_config&);
+};
+struct key_query_result {
+    model::offset offset;
+    model::timestamp time;
+    /// disengaged for a tombstone
+    std::optional<iobuf> value;
+
+    friend std::ostream& operator<<(std::ostream& o, const key_query_result&);
+};
+
 struct truncate_config {
     truncate_config(model::offset o, ss::io_priority_class p)
       : base_offset(o)
@@ -0,0 +1,185 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "syschecks/self_test.h"
+
+#include "syschecks/syschecks.h"
+#include "units.h"
+
+#include <seastar/core/aligned_buffer.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/file.hh>
+#include <seastar/core/future-util.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/smp.hh>
+
+#include <boost/range/irange.hpp>
+#include <fmt/ostream.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <ostream>
+
+namespace syschecks {
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t fsync_block_size = 4_KiB;
+constexpr size_t sequential_io_size = 128_KiB;
+
+double bytes_per_sec(size_t bytes, clock_type::duration d) {
+    const auto secs = std::chrono::duration<double>(d).count();
+    return secs > 0 ? static_cast<double>(bytes) / secs : 0;
+}
+
+std::chrono::microseconds
+percentile(std::vector<clock_type::duration>& samples, double p) {
+    if (samples.empty()) {
+        return std::chrono::microseconds(0);
+    }
+    std::sort(samples.begin(), samples.end());
+    const auto i = std::min(
+      samples.size() - 1,
+      static_cast<size_t>(p * static_cast<double>(samples.size())));
+    return std::chrono::duration_cast<std::chrono::microseconds>(samples[i]);
+}
+
+ss::future<> time_write_fsync(
+  ss::file& f, const self_test_config& cfg, self_test_results& r) {
+    auto buf = ss::allocate_aligned_buffer<char>(
+      fsync_block_size, f.disk_write_dma_alignment());
+    std::memset(buf.get(), 'r', fsync_block_size);
+    std::vector<clock_type::duration> samples;
+    samples.reserve(cfg.fsync_samples);
+    const auto deadline = clock_type::now() + cfg.max_duration;
+    for (size_t i = 0; i < cfg.fsync_samples; ++i) {
+        const auto begin = clock_type::now();
+        if (begin > deadline) {
+            break;
+        }
+        co_await f.dma_write(i * fsync_block_size, buf.get(), fsync_block_size);
+        co_await f.flush();
+        samples.push_back(clock_type::now() - begin);
+    }
+    r.write_fsync_p50 = percentile(samples, 0.5);
+    r.write_fsync_p99 = percentile(samples, 0.99);
+}
+
+ss::future<> time_sequential_io(
+  ss::file& f, const self_test_config& cfg, self_test_results& r) {
+    const auto alignment = std::max(
+      f.disk_write_dma_alignment(), f.disk_read_dma_alignment());
+    auto buf = ss::allocate_aligned_buffer<char>(sequential_io_size, alignment);
+    std::memset(buf.get(), 'r', sequential_io_size);
+
+    auto deadline = clock_type::now() + cfg.max_duration;
+    auto begin = clock_type::now();
+    size_t written = 0;
+    while (written < cfg.disk_bytes && clock_type::now() < deadline) {
+        written += co_await f.dma_write(
+          written, buf.get(), sequential_io_size);
+    }
+    co_await f.flush();
+    r.write_bytes_per_sec = bytes_per_sec(written, clock_type::now() - begin);
+
+    deadline = clock_type::now() + cfg.max_duration;
+    begin = clock_type::now();
+    size_t read = 0;
+    while (read < written && clock_type::now() < deadline) {
+        const auto n = co_await f.dma_read(
+          read, buf.get(), sequential_io_size);
+        if (n == 0) {
+            break;
+        }
+        read += n;
+    }
+    r.read_bytes_per_sec = bytes_per_sec(read, clock_type::now() - begin);
+}
+
+ss::future<double> time_memcpy(size_t bytes) {
+    static constexpr size_t passes = 8;
+    std::vector<char> src(bytes, 'r');
+    std::vector<char> dst(bytes, 0);
+    clock_type::duration elapsed{0};
+    for (size_t i = 0; i < passes; ++i) {
+        const auto begin = clock_type::now();
+        std::memcpy(dst.data(), src.data(), bytes);
+        elapsed += clock_type::now() - begin;
+        // a pass stalls the reactor, let the other tasks of the shard run
+        co_await ss::later();
+    }
+    co_return bytes_per_sec(passes * bytes, elapsed);
+}
+
+} // namespace
+
+std::ostream& operator<<(std::ostream& o, const self_test_results& r) {
+    fmt::print(
+      o,
+      "{{write_fsync_p50: {}us, write_fsync_p99: {}us, write: {:.1f}MiB/s, "
+      "read: {:.1f}MiB/s, memory: [",
+      r.write_fsync_p50.count(),
+      r.write_fsync_p99.count(),
+      r.write_bytes_per_sec / MiB,
+      r.read_bytes_per_sec / MiB);
+    for (size_t i = 0; i < r.memory_bytes_per_sec.size(); ++i) {
+        fmt::print(
+          o, "{}{:.1f}MiB/s", i ? ", " : "", r.memory_bytes_per_sec[i] / MiB);
+    }
+    return o << "]}";
+}
+
+ss::future<self_test_results>
+self_test(const ss::sstring& data_directory, self_test_config cfg) {
+    self_test_results r;
+    const auto path = (std::filesystem::path(data_directory.c_str())
+                       / ".redpanda_self_test")
+                        .native();
+    checklog.info("Running the startup self test in {}", data_directory);
+
+    auto f = co_await ss::open_file_dma(
+      path,
+      ss::open_flags::rw | ss::open_flags::create | ss::open_flags::truncate);
+    std::exception_ptr ex;
+    try {
+        co_await time_write_fsync(f, cfg, r);
+        co_await time_sequential_io(f, cfg, r);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    co_await f.close();
+    co_await ss::remove_file(path);
+    if (ex) {
+        std::rethrow_exception(ex);
+    }
+
+    r.memory_bytes_per_sec.resize(ss::smp::count);
+    co_await ss::parallel_for_each(
+      boost::irange(0u, ss::smp::count), [&r, &cfg](ss::shard_id shard) {
+          return ss::smp::submit_to(
+                   shard,
+                   [bytes = cfg.memory_bytes] { return time_memcpy(bytes); })
+            .then([&r, shard](double bw) {
+                r.memory_bytes_per_sec[shard] = bw;
+            });
+      });
+
+    checklog.info("Startup self test results: {}", r);
+    co_return r;
+}
+
+std::optional<self_test_results>& local_self_test_results() {
+    static thread_local std::optional<self_test_results> results;
+    return results;
+}
+
+} // namespace syschecks
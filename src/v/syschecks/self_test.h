@@ -0,0 +1,59 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/sstring.hh>
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <vector>
+
+namespace syschecks {
+
+struct self_test_config {
+    /// bytes written then read back sequentially in the data directory
+    size_t disk_bytes;
+    /// number of 4KiB write and fsync round trips timed
+    size_t fsync_samples{64};
+    /// size of the buffer copied by the memory test of each shard
+    size_t memory_bytes;
+    /// bound of the duration of each of the disk tests
+    std::chrono::milliseconds max_duration{std::chrono::seconds(30)};
+};
+
+struct self_test_results {
+    /// latency of a 4KiB direct write followed by an fsync
+    std::chrono::microseconds write_fsync_p50{0};
+    std::chrono::microseconds write_fsync_p99{0};
+    /// sequential direct io throughput
+    double write_bytes_per_sec{0};
+    double read_bytes_per_sec{0};
+    /// memcpy bandwidth of each shard, measured concurrently
+    std::vector<double> memory_bytes_per_sec;
+
+    friend std::ostream& operator<<(std::ostream&, const self_test_results&);
+};
+
+/// \brief bounded benchmark of the disk of the data directory and of the
+/// memory of every shard, run once at startup. Runs on shard 0.
+ss::future<self_test_results>
+self_test(const ss::sstring& data_directory, self_test_config cfg);
+
+/// results of the startup self test of the node, if it ran
+std::optional<self_test_results>& local_self_test_results();
+
+} // namespace syschecks
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+#include "seastarx.h"
+
+#include <seastar/core/future.hh>
+#include <seastar/core/semaphore.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+/*
+ * latency driven limit of the requests processed concurrently.
+ *
+ * unlike queue_depth_control, which smooths the latency over long windows,
+ * the limit reacts to every completed request. while the requests complete
+ * within the target latency and the limit is being used, it grows by one per
+ * limit's worth of requests. once a request goes beyond the target, the limit
+ * shrinks by the ratio of the target to the measured latency, bounded by the
+ * backoff ratio. requests in flight when the limit was lowered report the
+ * same overload, so it is lowered at most once per target latency.
+ */
+class adaptive_concurrency_limit {
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    struct config {
+        std::chrono::milliseconds target_latency;
+        size_t min_limit;
+        size_t max_limit;
+        double backoff_ratio{0.5};
+    };
+
+    /// a slot of the limit, the request latency is sampled when released
+    class permit {
+    public:
+        permit(adaptive_concurrency_limit& limit, ss::semaphore_units<> units)
+          : _limit(&limit)
+          , _units(std::move(units))
+          , _start(clock_type::now()) {}
+
+        permit(permit&& o) noexcept
+          : _limit(std::exchange(o._limit, nullptr))
+          , _units(std::move(o._units))
+          , _start(o._start) {}
+        permit& operator=(permit&&) = delete;
+        permit(const permit&) = delete;
+        permit& operator=(const permit&) = delete;
+
+        ~permit() noexcept {
+            if (_limit) {
+                _limit->update(clock_type::now() - _start);
+            }
+        }
+
+    private:
+        adaptive_concurrency_limit* _limit;
+        ss::semaphore_units<> _units;
+        clock_type::time_point _start;
+    };
+
+    explicit adaptive_concurrency_limit(const config& cfg)
+      : _cfg(cfg)
+      , _limit(static_cast<double>(cfg.max_limit))
+      , _units(cfg.max_limit)
+      , _sem(_units)
+      , _last_decrease(clock_type::now() - cfg.target_latency) {}
+
+    ss::future<permit> get_permit() {
+        return ss::get_units(_sem, 1).then([this](ss::semaphore_units<> u) {
+            return permit(*this, std::move(u));
+        });
+    }
+
+    /// true when a new request would have to wait for a slot
+    bool saturated() const { return _sem.available_units() <= 0; }
+
+    size_t limit() const { return _units; }
+    size_t in_flight() const {
+        return static_cast<size_t>(
+          std::max<ssize_t>(0, ssize_t(_units) - _sem.available_units()));
+    }
+
+    void update(clock_type::duration latency) {
+        const auto target = std::chrono::duration_cast<clock_type::duration>(
+          _cfg.target_latency);
+        if (latency > target) {
+            const auto now = clock_type::now();
+            if (now - _last_decrease < target) {
+                return;
+            }
+            _last_decrease = now;
+            const auto gradient = std::max(
+              _cfg.backoff_ratio,
+              static_cast<double>(target.count())
+                / static_cast<double>(latency.count()));
+            set_limit(_limit * gradient);
+        } else if (in_flight() * 2 >= _units) {
+            // only grow a limit that is used, an idle shard must not
+            // accumulate a limit it never verified
+            set_limit(_limit + 1.0 / _limit);
+        }
+    }
+
+private:
+    void set_limit(double limit) {
+        _limit = std::clamp(
+          limit,
+          static_cast<double>(_cfg.min_limit),
+          static_cast<double>(_cfg.max_limit));
+        const auto units = static_cast<size_t>(std::floor(_limit));
+        if (units < _units) {
+            _sem.consume(_units - units);
+        } else if (units > _units) {
+            _sem.signal(units - _units);
+        }
+        _units = units;
+    }
+
+    const config _cfg;
+    double _limit;
+    size_t _units;
+    ss::semaphore _sem;
+    clock_type::time_point _last_decrease;
+};
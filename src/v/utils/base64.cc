@@ -42,6 +42,27 @@ bytes base64_to_bytes(std::string_view input) {
     return output;
 }
 
+iobuf base64_to_iobuf(std::string_view input) {
+    ss::temporary_buffer<char> output(input.size());
+    size_t output_len; // NOLINT
+    int ret = base64_decode(
+      input.data(), input.size(), output.get_write(), &output_len, 0);
+    if (unlikely(!ret)) {
+        throw base64_decoder_exception();
+    }
+    vassert(
+      output_len <= input.size(),
+      "base64 decode overflow: {} > {}",
+      output_len,
+      input.size());
+    output.trim(output_len);
+    iobuf ret_buf;
+    if (output_len > 0) {
+        ret_buf.append(std::move(output));
+    }
+    return ret_buf;
+}
+
 ss::sstring bytes_to_base64(bytes_view input) {
     const size_t output_capacity = encode_capacity(input.size());
     ss::sstring output(ss::sstring::initialized_later{}, output_capacity);
@@ -61,9 +82,10 @@ ss::sstring bytes_to_base64(bytes_view input) {
     return output;
 }
 
-ss::sstring iobuf_to_base64(const iobuf& input) {
+size_t base64_encoded_capacity(size_t size) { return encode_capacity(size); }
+
+size_t iobuf_to_base64(const iobuf& input, char* output) {
     const size_t output_capacity = encode_capacity(input.size_bytes());
-    ss::sstring output(ss::sstring::initialized_later{}, output_capacity);
     size_t written = 0;
 
     base64_state state; // NOLINT
@@ -73,9 +95,9 @@ ss::sstring iobuf_to_base64(const iobuf& input) {
     iobuf::iterator_consumer input_it(input.cbegin(), input.cend());
     input_it.consume(
       input.size_bytes(),
-      [&state, &written, &output, output_capacity](const char* src, size_t sz) {
-          size_t output_len;                          // NOLINT
-          char* output_ptr = output.data() + written; // NOLINT
+      [&state, &written, output, output_capacity](const char* src, size_t sz) {
+          size_t output_len;                   // NOLINT
+          char* output_ptr = output + written; // NOLINT
           base64_stream_encode(&state, src, sz, output_ptr, &output_len);
           written += output_len;
           vassert(
@@ -88,15 +110,19 @@ ss::sstring iobuf_to_base64(const iobuf& input) {
 
     // finalize output
     size_t output_len; // NOLINT
-    base64_stream_encode_final(
-      &state, output.data() + written, &output_len); // NOLINT
+    base64_stream_encode_final(&state, output + written, &output_len); // NOLINT
     written += output_len;
     vassert(
       written <= output_capacity,
       "base64 encode overflow: {} > {}",
       written,
       output_capacity);
+    return written;
+}
 
-    output.resize(written);
+ss::sstring iobuf_to_base64(const iobuf& input) {
+    ss::sstring output(
+      ss::sstring::initialized_later{}, encode_capacity(input.size_bytes()));
+    output.resize(iobuf_to_base64(input, output.data()));
     return output;
 }
@@ -24,7 +24,18 @@ public:
 
 // base64 <-> bytes
 bytes base64_to_bytes(std::string_view);
+// Decodes into a single fragment, without the copy of base64_to_bytes and
+// bytes_to_iobuf
+iobuf base64_to_iobuf(std::string_view);
 ss::sstring bytes_to_base64(bytes_view);
 
 // base64 <-> iobuf
 ss::sstring iobuf_to_base64(const iobuf&);
+
+// Upper bound of the size of the base64 encoding of size bytes
+size_t base64_encoded_capacity(size_t size);
+
+// Encodes the iobuf into output, which must have room for
+// base64_encoded_capacity(input.size_bytes()) chars. Returns the number of
+// chars written
+size_t iobuf_to_base64(const iobuf& input, char* output);
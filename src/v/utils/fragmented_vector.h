@@ -12,6 +12,7 @@
 
 #include "vassert.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -19,10 +20,15 @@
  * A very very simple fragmented vector that provides random access like a
  * vector, but does not store its data in contiguous memory.
  *
- * There is no reserve method because we allocate a full fragment at a time.
- * However, after you populate a vector you might want to call shrink to fit if
- * your fragment is large. A more advanced strategy could allocate capacity up
- * front which just requires a bit more accounting.
+ * Fragments are allocated in full, except for the first fragment of a vector
+ * whose final size is known up front, see reserve(). After you populate a
+ * vector element by element you might want to call shrink to fit if your
+ * fragment is large.
+ *
+ * Elements are stored in fragments of fragment_size bytes, so the fragment
+ * size bounds the largest allocation of the vector. Bulk operations, i.e.
+ * append(), pop_back(n) and lower_bound(), work on whole fragments at a time
+ * instead of element by element.
  *
  * The iterator implementation works for a few things like std::lower_bound,
  * upper_bound, distance, etc... see fragmented_vector_test.
@@ -30,9 +36,7 @@
  * Note that the decision to allocate a full fragment at a time isn't
  * necessarily an optimization, but rather a restriction that simplifies the
  * implementation. If expand fragmented_vector to be more general purpose, we
- * should indeed make it more flexible. If we add a reserve method to allocate
- * all of the space at once we might benefit from the allocator helping with
- * giving us contiguous memory.
+ * should indeed make it more flexible.
  */
 template<typename T, size_t fragment_size = 8192>
 class fragmented_vector {
@@ -53,15 +57,51 @@ public:
 
     void push_back(T elem) {
         if (_size == _capacity) {
-            std::vector<T> frag;
+            add_fragment(elems_per_frag);
+        }
+        auto& frag = _frags.back();
+        if (frag.size() == frag.capacity()) {
+            // first fragment sized by reserve() growing past the reservation
             frag.reserve(elems_per_frag);
-            _frags.push_back(std::move(frag));
-            _capacity += elems_per_frag;
         }
-        _frags.back().push_back(elem);
+        frag.push_back(std::move(elem));
         ++_size;
     }
 
+    /// \brief appends the n elements of the array, a fragment at a time
+    void append(const T* data, size_t n) {
+        while (n > 0) {
+            if (_size == _capacity) {
+                add_fragment(elems_per_frag);
+            }
+            auto& frag = _frags.back();
+            const size_t count = std::min(n, _capacity - _size);
+            if (frag.capacity() < frag.size() + count) {
+                frag.reserve(elems_per_frag);
+            }
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            frag.insert(frag.end(), data, data + count);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            data += count;
+            n -= count;
+            _size += count;
+        }
+    }
+
+    /// \brief makes room for n elements in total. The fragment directory is
+    /// sized once and, when the vector is empty and n fits in one fragment,
+    /// the first fragment is allocated for exactly n elements instead of a
+    /// full fragment.
+    void reserve(size_t n) {
+        if (n <= _size) {
+            return;
+        }
+        _frags.reserve((n + elems_per_frag - 1) / elems_per_frag);
+        if (_frags.empty() && n < elems_per_frag) {
+            add_fragment(n);
+        }
+    }
+
     void pop_back() {
         vassert(_size > 0, "Cannot pop from empty container");
         _frags.back().pop_back();
@@ -72,6 +112,22 @@ public:
         }
     }
 
+    /// \brief removes the last n elements, whole fragments are released
+    /// without touching their elements one by one
+    void pop_back(size_t n) {
+        vassert(n <= _size, "Cannot pop {} of {} elements", n, _size);
+        const size_t size = _size - n;
+        const size_t frags = (size + elems_per_frag - 1) / elems_per_frag;
+        _frags.erase(_frags.begin() + frags, _frags.end());
+        _capacity = frags * elems_per_frag;
+        if (!_frags.empty()) {
+            auto& last = _frags.back();
+            last.erase(
+              last.begin() + (size - (frags - 1) * elems_per_frag), last.end());
+        }
+        _size = size;
+    }
+
     const T& operator[](size_t index) const {
         vassert(index < _size, "Index out of range {}/{}", index, _size);
         auto& frag = _frags.at(index / elems_per_frag);
@@ -88,8 +144,30 @@ public:
         }
     }
 
+    /// \brief index of the first element not less than v, or size() when
+    /// there is none. The elements must be sorted. The fragment is found by
+    /// a binary search over the last element of every fragment and the
+    /// element by a binary search within the contiguous fragment, instead of
+    /// going through operator[] for every probe.
+    size_t lower_bound(const T& v) const {
+        if (empty()) {
+            return 0;
+        }
+        auto frag = std::partition_point(
+          _frags.begin(), _frags.end(), [&v](const std::vector<T>& f) {
+              return f.back() < v;
+          });
+        if (frag == _frags.end()) {
+            return _size;
+        }
+        auto it = std::lower_bound(frag->begin(), frag->end(), v);
+        return std::distance(_frags.begin(), frag) * elems_per_frag
+               + std::distance(frag->begin(), it);
+    }
+
     bool operator==(const fragmented_vector& o) const noexcept {
-        return o._frags == _frags;
+        // an empty vector may hold the fragment allocated by reserve()
+        return o._size == _size && (_size == 0 || o._frags == _frags);
     }
 
     class const_iterator {
@@ -135,6 +213,13 @@ public:
     const_iterator end() const { return const_iterator(this, _size); }
 
 private:
+    void add_fragment(size_t reserved) {
+        std::vector<T> frag;
+        frag.reserve(reserved);
+        _frags.push_back(std::move(frag));
+        _capacity += elems_per_frag;
+    }
+
     size_t _size{0};
     size_t _capacity{0};
     std::vector<std::vector<T>> _frags;
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+
+#pragma once
+
+// Must include first for a seastar transitive type only on GCC
+// where metrics_types needs cstdint as an include header
+#include <cstdint>
+
+// vectorized types. needed comment to allow clang-format
+// header sorting to not resort cstdint
+#include "seastarx.h"
+
+#include <seastar/core/metrics_types.hh>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <ostream>
+#include <utility>
+
+/// \brief log-linear histogram cheap enough to record on per-request paths.
+///
+/// Values are counted in a fixed array of buckets: every power of two range
+/// [2^e, 2^(e+1)) is split in 2^sub_bucket_bits linear buckets, values below
+/// 2^sub_bucket_bits have a bucket each and values of 2^max_exponent or more
+/// are counted in the last bucket. Recording is a bit scan and an increment,
+/// there is no lock or allocation and, unlike hdr_hist, measurements are not
+/// tracked by the histogram.
+///
+/// Histograms of the same type merge bucket by bucket, e.g. to aggregate the
+/// histograms of all shards with map_reduce0(..., log_hist{}, std::plus<>{}).
+template<
+  typename duration_t = std::chrono::microseconds,
+  unsigned sub_bucket_bits = 2,
+  unsigned max_exponent = 32>
+class log_hist {
+    static_assert(sub_bucket_bits < max_exponent && max_exponent < 64);
+
+public:
+    using clock_type = std::chrono::steady_clock;
+    static constexpr size_t sub_buckets = size_t(1) << sub_bucket_bits;
+    static constexpr size_t num_buckets
+      = (max_exponent - sub_bucket_bits + 1) * sub_buckets;
+
+    /// \brief move-only type recording the duration of its lifetime, unless
+    /// set_trace(false) was called. The histogram must outlive it.
+    class measurement {
+    public:
+        explicit measurement(log_hist& h)
+          : _h(&h)
+          , _begin_t(clock_type::now()) {}
+        measurement(const measurement&) = delete;
+        measurement& operator=(const measurement&) = delete;
+        measurement(measurement&& o) noexcept
+          : _h(std::exchange(o._h, nullptr))
+          , _begin_t(o._begin_t) {}
+        measurement& operator=(measurement&& o) noexcept {
+            if (this != &o) {
+                record();
+                _h = std::exchange(o._h, nullptr);
+                _begin_t = o._begin_t;
+            }
+            return *this;
+        }
+        ~measurement() noexcept { record(); }
+
+        void set_trace(bool b) {
+            if (!b) {
+                _h = nullptr;
+            }
+        }
+
+    private:
+        void record() noexcept {
+            if (_h) {
+                _h->record(std::chrono::duration_cast<duration_t>(
+                  clock_type::now() - _begin_t));
+            }
+        }
+
+        log_hist* _h;
+        clock_type::time_point _begin_t;
+    };
+
+    measurement auto_measure() { return measurement(*this); }
+
+    void record(uint64_t value) noexcept {
+        ++_buckets[bucket_index(value)];
+        ++_sample_count;
+        _sample_sum += value;
+    }
+    void record(duration_t d) noexcept {
+        record(static_cast<uint64_t>(std::max<int64_t>(d.count(), 0)));
+    }
+
+    log_hist& operator+=(const log_hist& o) noexcept {
+        for (size_t i = 0; i < num_buckets; ++i) {
+            _buckets[i] += o._buckets[i];
+        }
+        _sample_count += o._sample_count;
+        _sample_sum += o._sample_sum;
+        return *this;
+    }
+    friend log_hist operator+(log_hist a, const log_hist& b) noexcept {
+        a += b;
+        return a;
+    }
+
+    uint64_t sample_count() const { return _sample_count; }
+    uint64_t sample_sum() const { return _sample_sum; }
+
+    /// \brief upper bound of the bucket holding the given percentile, 0 if
+    /// the histogram is empty
+    uint64_t get_value_at(double percentile) const {
+        const auto rank = static_cast<uint64_t>(
+          std::ceil(percentile / 100.0 * static_cast<double>(_sample_count)));
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < num_buckets; ++i) {
+            cumulative += _buckets[i];
+            if (cumulative > 0 && cumulative >= rank) {
+                return bucket_upper_bound(i);
+            }
+        }
+        return 0;
+    }
+
+    /// \brief one cumulative bucket per power of two, the linear buckets
+    /// are folded to keep the number of exported series low
+    ss::metrics::histogram seastar_histogram_logform() const {
+        static constexpr size_t exported = max_exponent - sub_bucket_bits + 1;
+        ss::metrics::histogram sshist;
+        sshist.buckets.resize(exported);
+        sshist.sample_count = _sample_count;
+        sshist.sample_sum = static_cast<double>(_sample_sum);
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < num_buckets; ++i) {
+            cumulative += _buckets[i];
+            if ((i + 1) % sub_buckets == 0) {
+                auto& bucket = sshist.buckets[i / sub_buckets];
+                bucket.count = cumulative;
+                bucket.upper_bound = static_cast<double>(
+                  uint64_t(1) << (i / sub_buckets + sub_bucket_bits));
+            }
+        }
+        return sshist;
+    }
+
+    static constexpr size_t bucket_index(uint64_t value) noexcept {
+        if (value < sub_buckets) {
+            return value;
+        }
+        const unsigned e = std::bit_width(value) - 1;
+        if (e >= max_exponent) {
+            return num_buckets - 1;
+        }
+        const unsigned shift = e - sub_bucket_bits;
+        return ((shift + 1) << sub_bucket_bits)
+               + ((value >> shift) & (sub_buckets - 1));
+    }
+
+    /// \brief exclusive upper bound of the values counted in the bucket
+    static constexpr uint64_t bucket_upper_bound(size_t index) noexcept {
+        if (index < sub_buckets) {
+            return index + 1;
+        }
+        const size_t shift = (index >> sub_bucket_bits) - 1;
+        const uint64_t sub = index & (sub_buckets - 1);
+        return (sub_buckets + sub + 1) << shift;
+    }
+
+private:
+    std::array<uint64_t, num_buckets> _buckets{};
+    uint64_t _sample_count{0};
+    uint64_t _sample_sum{0};
+
+    friend std::ostream& operator<<(std::ostream& o, const log_hist& h) {
+        return o << "{count: " << h._sample_count << ", sum: " << h._sample_sum
+                 << ", p50: " << h.get_value_at(50.0)
+                 << ", p99: " << h.get_value_at(99.0)
+                 << ", p999: " << h.get_value_at(99.9) << "}";
+    }
+};
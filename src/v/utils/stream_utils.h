@@ -26,6 +26,7 @@
 #include <seastar/core/temporary_buffer.hh>
 
 #include <exception>
+#include <vector>
 
 namespace detail {
 
@@ -216,8 +217,41 @@ auto construct_data_sources(
       std::make_tuple(std::make_unique<fanout_data_source<Ch>>(fanout, ix)...));
 }
 
+template<class Ch>
+struct concat_data_source final : ss::data_source_impl {
+    explicit concat_data_source(std::vector<ss::input_stream<Ch>> in)
+      : _in(std::move(in)) {}
+
+    ss::future<ss::temporary_buffer<Ch>> get() final {
+        while (_ix < _in.size()) {
+            auto buf = co_await _in[_ix].read();
+            if (!buf.empty()) {
+                co_return buf;
+            }
+            ++_ix;
+        }
+        co_return ss::temporary_buffer<Ch>();
+    }
+
+    ss::future<> close() final {
+        for (auto& in : _in) {
+            co_await in.close();
+        }
+    }
+
+    std::vector<ss::input_stream<Ch>> _in;
+    size_t _ix{0};
+};
+
 } // namespace detail
 
+/// Input stream that reads the input streams one after another
+template<typename Ch>
+ss::input_stream<Ch> input_stream_concat(std::vector<ss::input_stream<Ch>> in) {
+    return ss::input_stream<Ch>(ss::data_source(
+      std::make_unique<detail::concat_data_source<Ch>>(std::move(in))));
+}
+
 template<size_t N, typename Ch>
 auto input_stream_fanout(
   ss::input_stream<Ch> in,
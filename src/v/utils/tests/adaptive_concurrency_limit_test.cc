@@ -0,0 +1,77 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "utils/adaptive_concurrency_limit.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <chrono>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+static adaptive_concurrency_limit::config test_config() {
+    return adaptive_concurrency_limit::config{
+      .target_latency = 10s,
+      .min_limit = 2,
+      .max_limit = 8,
+    };
+}
+
+SEASTAR_THREAD_TEST_CASE(overload_lowers_limit_once_per_target) {
+    adaptive_concurrency_limit limit(test_config());
+    BOOST_REQUIRE_EQUAL(limit.limit(), 8);
+
+    // twice the target halves the limit, the following samples of the same
+    // overload are ignored
+    limit.update(20s);
+    BOOST_REQUIRE_EQUAL(limit.limit(), 4);
+    limit.update(40s);
+    BOOST_REQUIRE_EQUAL(limit.limit(), 4);
+}
+
+SEASTAR_THREAD_TEST_CASE(saturated_requests_wait_for_a_slot) {
+    adaptive_concurrency_limit limit(test_config());
+    limit.update(20s);
+    std::vector<adaptive_concurrency_limit::permit> permits;
+    for (size_t i = 0; i < 4; ++i) {
+        permits.push_back(limit.get_permit().get0());
+    }
+    BOOST_REQUIRE(limit.saturated());
+    BOOST_REQUIRE_EQUAL(limit.in_flight(), 4);
+
+    auto f = limit.get_permit();
+    BOOST_REQUIRE(!f.available());
+    permits.pop_back();
+    auto p = f.get0();
+    BOOST_REQUIRE_EQUAL(limit.in_flight(), 4);
+}
+
+SEASTAR_THREAD_TEST_CASE(fast_requests_grow_a_used_limit) {
+    adaptive_concurrency_limit limit(test_config());
+    limit.update(20s);
+    BOOST_REQUIRE_EQUAL(limit.limit(), 4);
+
+    // an idle limit does not grow
+    for (size_t i = 0; i < 10; ++i) {
+        limit.update(1s);
+    }
+    BOOST_REQUIRE_EQUAL(limit.limit(), 4);
+
+    std::vector<adaptive_concurrency_limit::permit> permits;
+    for (size_t i = 0; i < 4; ++i) {
+        permits.push_back(limit.get_permit().get0());
+    }
+    // about a slot per limit's worth of requests within the target
+    for (size_t i = 0; i < 5; ++i) {
+        limit.update(1s);
+    }
+    BOOST_REQUIRE_EQUAL(limit.limit(), 5);
+    BOOST_REQUIRE(!limit.saturated());
+}
@@ -31,6 +31,7 @@ BOOST_AUTO_TEST_CASE(iobuf_type) {
         BOOST_REQUIRE_EQUAL(encoded, expected);
         auto decoded = base64_to_bytes(encoded);
         BOOST_REQUIRE_EQUAL(decoded, iobuf_to_bytes(input));
+        BOOST_REQUIRE_EQUAL(base64_to_iobuf(encoded), input);
     };
 
     encdec(bytes_to_iobuf(""), "");
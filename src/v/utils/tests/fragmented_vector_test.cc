@@ -95,3 +95,49 @@ BOOST_AUTO_TEST_CASE(fragmented_vector_test) {
           std::distance(it, truth.end()), std::distance(it2, other.end()));
     }
 }
+
+BOOST_AUTO_TEST_CASE(fragmented_vector_bulk_test) {
+    // 128 elements per fragment
+    std::vector<int64_t> truth;
+    fragmented_vector<int64_t, 1024> other;
+
+    other.reserve(100);
+    BOOST_REQUIRE(other.empty());
+    BOOST_REQUIRE(other == fragmented_vector<int64_t, 1024>{});
+
+    // bulk appends starting and ending within fragments
+    for (auto n : {1, 50, 77, 128, 300, 3}) {
+        std::vector<int64_t> part;
+        for (int i = 0; i < n; ++i) {
+            part.push_back(static_cast<int64_t>(truth.size() + i) * 2);
+        }
+        truth.insert(truth.end(), part.begin(), part.end());
+        other.append(part.data(), part.size());
+        test_equal(truth, other);
+    }
+    for (int64_t i = 0; i < 200; ++i) {
+        truth.push_back(truth.back() + 2);
+        other.push_back(truth.back());
+        test_equal(truth, other);
+    }
+
+    for (int64_t v = -1; v <= truth.back() + 1; ++v) {
+        auto it = std::lower_bound(truth.begin(), truth.end(), v);
+        BOOST_REQUIRE_EQUAL(
+          other.lower_bound(v),
+          static_cast<size_t>(std::distance(truth.begin(), it)));
+    }
+
+    // bulk pops ending on and within fragment boundaries
+    for (size_t n : {5, 123, 128, 256, 1, 40}) {
+        truth.resize(truth.size() - n);
+        other.pop_back(n);
+        test_equal(truth, other);
+    }
+    other.pop_back(other.size());
+    BOOST_REQUIRE(other.empty());
+    BOOST_REQUIRE_EQUAL(other.lower_bound(0), 0U);
+    other.push_back(7);
+    BOOST_REQUIRE_EQUAL(other.back(), 7);
+    BOOST_REQUIRE_EQUAL(other.size(), 1U);
+}
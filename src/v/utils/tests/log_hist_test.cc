@@ -0,0 +1,75 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Use of this software is governed by the Business Source License
+ * included in the file licenses/BSL.md
+ *
+ * As of the Change Date specified in that file, in accordance with
+ * the Business Source License, use of this software will be governed
+ * by the Apache License, Version 2.0
+ */
+#include "utils/log_hist.h"
+
+#include <boost/test/unit_test.hpp>
+
+using hist_t = log_hist<std::chrono::microseconds>;
+
+BOOST_AUTO_TEST_CASE(log_hist_buckets_test) {
+    // every value falls in the bucket bounded by its index
+    for (uint64_t v = 0; v < 100000; ++v) {
+        auto i = hist_t::bucket_index(v);
+        BOOST_REQUIRE_LT(i, hist_t::num_buckets);
+        BOOST_REQUIRE_LT(v, hist_t::bucket_upper_bound(i));
+        if (i > 0) {
+            BOOST_REQUIRE_GE(v, hist_t::bucket_upper_bound(i - 1));
+        }
+    }
+    // values past the last power of two are clamped to the last bucket
+    BOOST_REQUIRE_EQUAL(
+      hist_t::bucket_index(uint64_t(1) << 40), hist_t::num_buckets - 1);
+    BOOST_REQUIRE_EQUAL(
+      hist_t::bucket_upper_bound(hist_t::num_buckets - 1), uint64_t(1) << 32);
+}
+
+BOOST_AUTO_TEST_CASE(log_hist_merge_test) {
+    hist_t a;
+    hist_t b;
+    BOOST_REQUIRE_EQUAL(a.get_value_at(99.0), 0U);
+    for (uint64_t v = 1; v <= 1000; ++v) {
+        (v % 2 == 0 ? a : b).record(v);
+    }
+    auto merged = a + b;
+    BOOST_REQUIRE_EQUAL(merged.sample_count(), 1000U);
+    BOOST_REQUIRE_EQUAL(merged.sample_sum(), 500500U);
+
+    // percentiles are approximated by the upper bound of their bucket,
+    // within a quarter of the value with 4 linear buckets per power of two
+    auto p50 = merged.get_value_at(50.0);
+    BOOST_REQUIRE_GT(p50, 500U);
+    BOOST_REQUIRE_LE(p50, 500U + 500U / 4 + 1);
+    BOOST_REQUIRE_GT(merged.get_value_at(100.0), 1000U);
+
+    auto sshist = merged.seastar_histogram_logform();
+    BOOST_REQUIRE_EQUAL(sshist.sample_count, 1000U);
+    BOOST_REQUIRE_EQUAL(sshist.buckets.size(), 31U);
+    // cumulative counts of the values below 4, 8, 16, ...
+    BOOST_REQUIRE_EQUAL(sshist.buckets[0].count, 3U);
+    BOOST_REQUIRE_EQUAL(sshist.buckets[0].upper_bound, 4);
+    BOOST_REQUIRE_EQUAL(sshist.buckets[1].count, 7U);
+    BOOST_REQUIRE_EQUAL(sshist.buckets[8].count, 1000U);
+    BOOST_REQUIRE_EQUAL(sshist.buckets.back().count, 1000U);
+}
+
+BOOST_AUTO_TEST_CASE(log_hist_measurement_test) {
+    hist_t h;
+    {
+        auto m = h.auto_measure();
+        auto moved = std::move(m);
+    }
+    BOOST_REQUIRE_EQUAL(h.sample_count(), 1U);
+    {
+        auto m = h.auto_measure();
+        m.set_trace(false);
+    }
+    BOOST_REQUIRE_EQUAL(h.sample_count(), 1U);
+}
@@ -0,0 +1,109 @@
+// Copyright 2021 Vectorized, Inc.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.md
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0
+
+#include "bytes/bytes.h"
+#include "bytes/iobuf.h"
+#include "bytes/iobuf_parser.h"
+#include "utils/vint.h"
+
+#include <seastar/testing/perf_tests.hh>
+
+#include <random>
+
+static constexpr size_t varints = 3 * 4096;
+
+// encoded varints of at most max_bits, small ones are the typical record
+// deltas and lengths
+static bytes gen(int max_bits) {
+    std::mt19937_64 rng(42); // NOLINT
+    bytes ret;
+    for (size_t i = 0; i < varints; ++i) {
+        auto bits = 1 + rng() % max_bits;
+        ret += vint::to_bytes(static_cast<int64_t>(rng() >> (64 - bits)));
+    }
+    return ret;
+}
+
+static iobuf to_iobuf(const bytes& b) {
+    iobuf ret;
+    ret.append(b.data(), b.size());
+    return ret;
+}
+
+static void run_generic(int max_bits) {
+    auto data = gen(max_bits);
+    perf_tests::start_measuring_time();
+    bytes_view in(data);
+    for (size_t i = 0; i < varints; ++i) {
+        auto [v, n] = vint::deserialize(in);
+        perf_tests::do_not_optimize(v);
+        in.remove_prefix(n);
+    }
+    perf_tests::stop_measuring_time();
+}
+
+static void run_contiguous(int max_bits) {
+    auto data = gen(max_bits);
+    perf_tests::start_measuring_time();
+    size_t pos = 0;
+    for (size_t i = 0; i < varints; ++i) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        auto [v, n] = vint::deserialize(data.data() + pos, data.size() - pos);
+        perf_tests::do_not_optimize(v);
+        pos += n;
+    }
+    perf_tests::stop_measuring_time();
+}
+
+// byte by byte decoding through the fragment iterator, followed by a skip
+static void run_iterator(int max_bits) {
+    auto data = to_iobuf(gen(max_bits));
+    perf_tests::start_measuring_time();
+    iobuf::iterator_consumer in(data.cbegin(), data.cend());
+    for (size_t i = 0; i < varints; ++i) {
+        auto [v, n] = vint::deserialize(in);
+        perf_tests::do_not_optimize(v);
+        in.skip(n);
+    }
+    perf_tests::stop_measuring_time();
+}
+
+static void run_parser(int max_bits) {
+    auto data = to_iobuf(gen(max_bits));
+    perf_tests::start_measuring_time();
+    iobuf_parser parser(std::move(data));
+    for (size_t i = 0; i < varints; ++i) {
+        perf_tests::do_not_optimize(parser.read_varlong());
+    }
+    perf_tests::stop_measuring_time();
+}
+
+// three varints at a time, as the timestamp, offset and key length fields of
+// a record
+static void run_parser_grouped(int max_bits) {
+    auto data = to_iobuf(gen(max_bits));
+    perf_tests::start_measuring_time();
+    iobuf_parser parser(std::move(data));
+    for (size_t i = 0; i < varints; i += 3) {
+        perf_tests::do_not_optimize(parser.read_varlongs<3>());
+    }
+    perf_tests::stop_measuring_time();
+}
+
+PERF_TEST(vint_small, generic) { run_generic(14); }
+PERF_TEST(vint_small, contiguous) { run_contiguous(14); }
+PERF_TEST(vint_small, iterator) { run_iterator(14); }
+PERF_TEST(vint_small, parser) { run_parser(14); }
+PERF_TEST(vint_small, parser_grouped) { run_parser_grouped(14); }
+
+PERF_TEST(vint_large, generic) { run_generic(63); }
+PERF_TEST(vint_large, contiguous) { run_contiguous(63); }
+PERF_TEST(vint_large, iterator) { run_iterator(63); }
+PERF_TEST(vint_large, parser) { run_parser(63); }
+PERF_TEST(vint_large, parser_grouped) { run_parser_grouped(63); }
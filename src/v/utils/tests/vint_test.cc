@@ -8,6 +8,8 @@
 // by the Apache License, Version 2.0
 
 #include "bytes/bytes.h"
+#include "bytes/iobuf.h"
+#include "bytes/iobuf_parser.h"
 #include "utils/vint.h"
 
 #include <seastar/testing/thread_test_case.hh>
@@ -17,7 +19,9 @@
 #include <array>
 #include <cstdint>
 #include <iostream>
+#include <limits>
 #include <random>
+#include <vector>
 
 namespace {
 
@@ -31,8 +35,82 @@ void check_roundtrip_sweep(int64_t count) {
     }
 }
 
+// values of every encoded length, from 1 to max_length bytes
+std::vector<int64_t> sample_values() {
+    std::vector<int64_t> values{
+      0,
+      -1,
+      1,
+      std::numeric_limits<int64_t>::min(),
+      std::numeric_limits<int64_t>::max()};
+    std::mt19937_64 rng(42); // NOLINT
+    for (int bits = 1; bits < 64; ++bits) {
+        for (int i = 0; i < 16; ++i) {
+            auto v = static_cast<int64_t>(rng() >> (64 - bits));
+            values.push_back(v);
+            values.push_back(-v);
+        }
+    }
+    return values;
+}
+
 } // namespace
 
 SEASTAR_THREAD_TEST_CASE(sanity_signed_sweep_64) {
     check_roundtrip_sweep(100000000);
 }
+
+SEASTAR_THREAD_TEST_CASE(contiguous_deserialize_matches_generic) {
+    for (auto v : sample_values()) {
+        auto b = vint::to_bytes(v);
+        // with and without room for the single load, with trailing bytes
+        // that must be ignored
+        for (size_t trailing : {0, 7, 16}) {
+            bytes buf = b + bytes(trailing, 0xff);
+            auto [value, len] = vint::deserialize(buf.data(), buf.size());
+            BOOST_REQUIRE_EQUAL(value, v);
+            BOOST_REQUIRE_EQUAL(len, b.size());
+        }
+        // truncated input gives the same partial result
+        for (size_t n = 0; n < b.size(); ++n) {
+            auto expected = vint::deserialize(bytes_view(b.data(), n));
+            BOOST_REQUIRE(vint::deserialize(b.data(), n) == expected);
+        }
+    }
+    // varints with more continuation bytes than max_length
+    bytes invalid(16, 0xff);
+    BOOST_REQUIRE(
+      vint::deserialize(invalid.data(), invalid.size())
+      == vint::deserialize(bytes_view(invalid)));
+}
+
+SEASTAR_THREAD_TEST_CASE(parser_reads_varlongs_across_fragments) {
+    auto values = sample_values();
+    iobuf encoded;
+    for (auto v : values) {
+        auto b = vint::to_bytes(v);
+        encoded.append(b.data(), b.size());
+    }
+    // small fragments so that many varints cross the fragment ends
+    for (size_t frag_size : {1, 3, 13, 64}) {
+        iobuf fragmented;
+        auto in = encoded.copy();
+        while (!in.empty()) {
+            auto n = std::min(frag_size, in.size_bytes());
+            fragmented.append_fragments(in.share(0, n));
+            in.trim_front(n);
+        }
+        iobuf_parser parser(std::move(fragmented));
+        size_t i = 0;
+        for (; i + 3 <= values.size(); i += 3) {
+            auto group = parser.read_varlongs<3>();
+            for (size_t j = 0; j < group.size(); ++j) {
+                BOOST_REQUIRE_EQUAL(group[j], values[i + j]);
+            }
+        }
+        for (; i < values.size(); ++i) {
+            BOOST_REQUIRE_EQUAL(parser.read_varlong().first, values[i]);
+        }
+        BOOST_REQUIRE_EQUAL(parser.bytes_left(), 0);
+    }
+}
@@ -12,7 +12,10 @@
 #pragma once
 #include "bytes/bytes.h"
 
+#include <seastar/core/byteorder.hh>
+
 #include <cstdint>
+#include <cstring>
 
 // class is actually zigzag vint; always signed ints
 // matches exactly the kafka encoding which uses protobuf
@@ -97,4 +100,43 @@ inline std::pair<int64_t, size_t> deserialize(Range&& r) noexcept {
     return {decode_zigzag(result), bytes_read};
 }
 
+namespace detail {
+inline constexpr uint64_t continuation_bits = 0x8080808080808080ULL;
+
+/// \brief decodes the varint at the start of a little endian word without
+/// a loop over its bytes: the length is found from the first byte without a
+/// continuation bit and the 7 bit groups are packed together in 3 steps.
+/// Returns a length of 0 if the varint does not end within the word.
+inline constexpr std::pair<uint64_t, size_t>
+decode_word(uint64_t word) noexcept {
+    const uint64_t stops = ~word & continuation_bits;
+    if (stops == 0) {
+        return {0, 0};
+    }
+    // the bytes up to and including the first one without continuation bit
+    const uint64_t mask = stops ^ (stops - 1);
+    uint64_t x = word & mask & ~continuation_bits;
+    x = ((x & 0x7f007f007f007f00ULL) >> 1) | (x & 0x007f007f007f007fULL);
+    x = ((x & 0x3fff00003fff0000ULL) >> 2) | (x & 0x00003fff00003fffULL);
+    x = ((x & 0x0fffffff00000000ULL) >> 4) | (x & 0x000000000fffffffULL);
+    return {x, (__builtin_ctzll(stops) + 1) / 8};
+}
+} // namespace detail
+
+/// \brief deserialize from contiguous memory of len bytes. Same result as
+/// the generic version, the varints of up to 8 bytes (values of up to 56
+/// bits) are decoded from a single load when len allows it.
+inline std::pair<int64_t, size_t>
+deserialize(const uint8_t* src, size_t len) noexcept {
+    if (likely(len >= sizeof(uint64_t))) {
+        uint64_t word;
+        std::memcpy(&word, src, sizeof(word));
+        auto [value, bytes_read] = detail::decode_word(ss::le_to_cpu(word));
+        if (likely(bytes_read != 0)) {
+            return {decode_zigzag(value), bytes_read};
+        }
+    }
+    return deserialize(bytes_view(src, len));
+}
+
 } // namespace vint
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "v8_engine/batch_buffer.h"
+
+#include "v8_engine/script.h"
+
+#include <seastar/core/byteorder.hh>
+
+#include <fmt/format.h>
+
+#include <cstring>
+#include <limits>
+
+namespace v8_engine {
+
+ss::temporary_buffer<char> pack_records(const batch_records& records) {
+    size_t data_size = 0;
+    for (const auto& r : records) {
+        data_size += r.size();
+    }
+    const size_t header_size = batch_buffer_header_size(records.size());
+    if (header_size + data_size > std::numeric_limits<uint32_t>::max()) {
+        throw script_exception(fmt::format(
+          "Batch of {} records and {} bytes is too large for a script",
+          records.size(),
+          data_size));
+    }
+    ss::temporary_buffer<char> buf(header_size + data_size);
+    char* header = buf.get_write();
+    char* data = header + header_size;
+    ss::write_le<uint32_t>(header, records.size());
+    uint32_t offset = 0;
+    for (size_t i = 0; i < records.size(); ++i) {
+        ss::write_le<uint32_t>(header + sizeof(uint32_t) * (i + 1), offset);
+        std::memcpy(data + offset, records[i].get(), records[i].size());
+        offset += records[i].size();
+    }
+    ss::write_le<uint32_t>(
+      header + sizeof(uint32_t) * (records.size() + 1), offset);
+    return buf;
+}
+
+batch_records unpack_records(std::string_view buffer) {
+    auto malformed = [&buffer](std::string_view reason) {
+        return script_exception(fmt::format(
+          "Malformed batch of {} bytes returned by script: {}",
+          buffer.size(),
+          reason));
+    };
+    if (buffer.size() < batch_buffer_header_size(0)) {
+        throw malformed("no header");
+    }
+    const uint32_t count = ss::read_le<uint32_t>(buffer.data());
+    const size_t header_size = batch_buffer_header_size(count);
+    if (buffer.size() < header_size) {
+        throw malformed("truncated offsets");
+    }
+    const char* offsets = buffer.data() + sizeof(uint32_t);
+    const size_t data_size = buffer.size() - header_size;
+    auto offset_at = [offsets](size_t i) {
+        return ss::read_le<uint32_t>(offsets + sizeof(uint32_t) * i);
+    };
+    batch_records records;
+    records.reserve(count);
+    uint32_t begin = offset_at(0);
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t end = offset_at(i + 1);
+        if (end < begin || end > data_size) {
+            throw malformed(fmt::format("record {} out of bounds", i));
+        }
+        records.emplace_back(
+          buffer.data() + header_size + begin, end - begin);
+        begin = end;
+    }
+    return records;
+}
+
+} // namespace v8_engine
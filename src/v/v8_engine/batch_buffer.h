@@ -0,0 +1,42 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#pragma once
+
+#include "seastarx.h"
+
+#include <seastar/core/temporary_buffer.hh>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace v8_engine {
+
+// Records of a batch packed in one buffer, so that a script handles the whole
+// batch in a single call. All integers are little endian uint32:
+//
+//   [record count n][n + 1 record offsets][record data]
+//
+// The offsets are relative to the start of the record data, record i spans
+// [offset i, offset i + 1), the last offset is the size of the record data.
+using batch_records = std::vector<ss::temporary_buffer<char>>;
+
+// Size of the header of a packed batch with `count` records
+constexpr size_t batch_buffer_header_size(size_t count) {
+    return sizeof(uint32_t) * (count + 2);
+}
+
+ss::temporary_buffer<char> pack_records(const batch_records& records);
+
+// Throws script_exception if the buffer is not a valid packed batch
+batch_records unpack_records(std::string_view buffer);
+
+} // namespace v8_engine
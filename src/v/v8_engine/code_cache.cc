@@ -0,0 +1,51 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "v8_engine/code_cache.h"
+
+#include "hashing/xx.h"
+
+namespace v8_engine {
+
+uint64_t code_cache::source_hash(const ss::temporary_buffer<char>& js_code) {
+    return xxhash_64(js_code.get(), js_code.size());
+}
+
+code_cache::data_ptr code_cache::get(uint64_t source_hash) const {
+    auto it = _entries.find(source_hash);
+    return it == _entries.end() ? nullptr : it->second;
+}
+
+void code_cache::put(uint64_t source_hash, data_ptr data) {
+    if (!data || _entries.contains(source_hash)) {
+        return;
+    }
+    if (_size_bytes + data->size() > _max_bytes) {
+        return;
+    }
+    _size_bytes += data->size();
+    _entries.emplace(source_hash, std::move(data));
+}
+
+void code_cache::erase(uint64_t source_hash) {
+    auto it = _entries.find(source_hash);
+    if (it == _entries.end()) {
+        return;
+    }
+    _size_bytes -= it->second->size();
+    _entries.erase(it);
+}
+
+void code_cache::clear() {
+    _entries.clear();
+    _size_bytes = 0;
+}
+
+} // namespace v8_engine
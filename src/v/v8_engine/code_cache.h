@@ -0,0 +1,66 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#pragma once
+
+#include "seastarx.h"
+#include "units.h"
+
+#include <seastar/core/temporary_buffer.hh>
+
+#include <absl/container/flat_hash_map.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace v8_engine {
+
+// V8 code cache (bytecode) of compiled js scripts, keyed by the hash of their
+// source. Scripts compiled again, in another isolate or after an executor
+// restart, deserialize the bytecode instead of parsing and compiling the
+// source.
+//
+// The bytecode is immutable once cached and is shared with std::shared_ptr,
+// so the same bytes can be put into the caches of the other shards without
+// copying them. V8 checks the bytecode against the source and its own version
+// and flags when it is consumed, a rejected cache falls back to compiling.
+class code_cache {
+public:
+    static constexpr size_t default_max_bytes = 8_MiB;
+
+    using data_t = std::vector<uint8_t>;
+    using data_ptr = std::shared_ptr<const data_t>;
+
+    explicit code_cache(size_t max_bytes = default_max_bytes)
+      : _max_bytes(max_bytes) {}
+
+    static uint64_t source_hash(const ss::temporary_buffer<char>& js_code);
+
+    // Bytecode of the source, null if it is not cached
+    data_ptr get(uint64_t source_hash) const;
+
+    // Caches the bytecode of the source. Once the memory bound is reached
+    // new scripts are not cached
+    void put(uint64_t source_hash, data_ptr);
+
+    void erase(uint64_t source_hash);
+    void clear();
+
+    size_t size_bytes() const { return _size_bytes; }
+    size_t entries() const { return _entries.size(); }
+
+private:
+    size_t _max_bytes;
+    size_t _size_bytes{0};
+    absl::flat_hash_map<uint64_t, data_ptr> _entries;
+};
+
+} // namespace v8_engine
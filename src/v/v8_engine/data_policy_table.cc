@@ -14,11 +14,37 @@ namespace v8_engine {
 
 bool data_policy_table::insert(
   model::topic_namespace topic, v8_engine::data_policy dp) {
-    return _dps.insert({topic, std::move(dp)}).second;
+    const bool inserted = _dps.insert({topic, std::move(dp)}).second;
+    if (inserted) {
+        bump_version(topic);
+    }
+    return inserted;
 }
 
 bool data_policy_table::erase(model::topic_namespace topic) {
-    return _dps.erase(topic) == 1;
+    const bool erased = _dps.erase(topic) == 1;
+    if (erased) {
+        bump_version(topic);
+    }
+    return erased;
+}
+
+void data_policy_table::clear() {
+    _dps.clear();
+    // versions only grow, the cleared topics get new ones once set again
+    _versions.clear();
+    _transformed.clear();
+}
+
+uint64_t
+data_policy_table::policy_version(const model::topic_namespace& topic) const {
+    auto it = _versions.find(topic);
+    return it == _versions.end() ? 0 : it->second;
+}
+
+void data_policy_table::bump_version(const model::topic_namespace& topic) {
+    _versions[topic] = _next_version++;
+    _transformed.invalidate(topic);
 }
 
 std::optional<v8_engine::data_policy>
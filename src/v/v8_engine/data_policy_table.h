@@ -11,8 +11,11 @@
 #pragma once
 
 #include "model/metadata.h"
+#include "v8_engine/code_cache.h"
 #include "v8_engine/data_policy.h"
+#include "v8_engine/transformed_batch_cache.h"
 
+#include <absl/container/flat_hash_map.h>
 #include <absl/container/node_hash_map.h>
 
 namespace v8_engine {
@@ -22,6 +25,11 @@ public:
     using container_type
       = absl::node_hash_map<model::topic_namespace, v8_engine::data_policy>;
 
+    explicit data_policy_table(
+      size_t transformed_cache_bytes
+      = transformed_batch_cache::default_max_bytes)
+      : _transformed(transformed_cache_bytes) {}
+
     bool insert(model::topic_namespace, v8_engine::data_policy);
 
     bool erase(model::topic_namespace);
@@ -29,10 +37,35 @@ public:
     std::optional<v8_engine::data_policy>
     get_data_policy(const model::topic_namespace& topic) const;
 
+    /// Version of the data policy of the topic, changes every time the
+    /// policy is set or removed. Transformed batches are cached with it
+    uint64_t policy_version(const model::topic_namespace& topic) const;
+
+    /// Batches transformed by the data policies of this shard
+    transformed_batch_cache& transformed_batches() { return _transformed; }
+
+    /// Bytecode of the scripts of the data policies, shared by all of the
+    /// isolates of this shard and kept across executor restarts
+    code_cache& scripts_code_cache() { return _code_cache; }
+
     size_t size() const { return _dps.size(); }
 
+    container_type::const_iterator begin() const { return _dps.cbegin(); }
+    container_type::const_iterator end() const { return _dps.cend(); }
+
+    void clear();
+
 private:
+    // Invalidates the cached transforms of the topic
+    void bump_version(const model::topic_namespace&);
+
     container_type _dps;
+    absl::flat_hash_map<model::topic_namespace, uint64_t> _versions;
+    // Source of the versions, shared by all of the topics so that a policy
+    // removed and set again never reuses a version
+    uint64_t _next_version{1};
+    transformed_batch_cache _transformed;
+    code_cache _code_cache;
 };
 
 } // namespace v8_engine
@@ -18,75 +18,82 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/smp.hh>
 
+#include <algorithm>
 #include <exception>
 
 namespace v8_engine {
 
 namespace internal {
 
-// spsc_queue
+// task_queue
 
-spsc_queue::spsc_queue(size_t queue_size)
-  : _items(queue_size) {}
+task_queue::task_queue(size_t queue_size)
+  // one node of the pool is the dummy node of the queue
+  : _items(queue_size + 1) {}
 
-void spsc_queue::close() {
-    _is_stopped = true;
-    _push_mutex.broken();
-    _has_element_cv.notify_all();
-}
+void task_queue::close() { _push_mutex.broken(); }
 
-ss::future<> spsc_queue::push(work_item* item) {
+ss::future<> task_queue::push(work_item* item) {
     // Only one coroutine can wait on ss::readable_eventfd, so we need to use
     // mutex for push
     auto lock = co_await _push_mutex.get_units();
 
-    while (!_items.push(item)) {
+    while (!_items.bounded_push(item)) {
         co_await _is_not_full.wait();
     }
-
-    _has_element_cv.notify_one();
 }
 
-work_item* spsc_queue::pop() {
+work_item* task_queue::pop() {
     work_item* item = nullptr;
-    std::unique_lock lock{_std_mutex};
-
-    // We need to use wait_for, because std::thread can miss notification from
-    // seastar thread (between check pred and sleep)
-    _has_element_cv.wait_for(lock, _timeout_cond_wait_std_thread_ms, [this] {
-        return !empty() || _is_stopped;
-    });
-
-    if (!empty()) {
-        item = _items.front();
-        _items.pop();
+    if (_items.pop(item)) {
         _is_not_full.write_side().signal(1);
+        return item;
     }
-
-    return item;
+    return nullptr;
 }
 
-bool spsc_queue::empty() { return _items.empty(); }
+bool task_queue::empty() const { return _items.empty(); }
 
 } // namespace internal
 
 // executor
 
 executor::executor(
-  ss::alien::instance& instance, uint8_t cpu_id, size_t queue_size)
+  ss::alien::instance& instance,
+  std::vector<unsigned> cpu_ids,
+  size_t queue_size)
   : _alien_instance(instance)
-  , _thread([this, cpu_id] {
-      pin(cpu_id);
-      loop();
-  })
-  , _tasks(queue_size)
-  , _watchdog_shard(ss::this_shard_id()) {}
+  , _queue_size(queue_size)
+  , _queues(ss::smp::count) {
+    vassert(!cpu_ids.empty(), "Executor needs at least one thread");
+    _threads.reserve(cpu_ids.size());
+    for (size_t i = 0; i < cpu_ids.size(); ++i) {
+        _threads.emplace_back([this, i, cpu_id = cpu_ids[i]] {
+            pin(cpu_id);
+            loop(i);
+        });
+    }
+}
 
 ss::future<> executor::stop() {
-    _tasks.close();
-    return _gate.close().then([this] {
-        _is_stopped = true;
-        _thread.join();
+    _is_closing.store(true, std::memory_order_release);
+    // The queue of a shard is only used on that shard, the tasks already
+    // pushed are processed before the gates close
+    co_await ss::smp::invoke_on_all([this] {
+        auto* queue = _queues[ss::this_shard_id()].load();
+        if (!queue) {
+            return ss::now();
+        }
+        queue->close();
+        return queue->gate().close();
+    });
+    _is_stopped = true;
+    _has_element_cv.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+    co_await ss::smp::invoke_on_all([this] {
+        delete _queues[ss::this_shard_id()].exchange(nullptr);
     });
 }
 
@@ -94,20 +101,48 @@ bool executor::is_stopping() const {
     return _is_stopped.load(std::memory_order_relaxed);
 }
 
-void executor::rearm_watchdog(
-  internal::work_item& task, std::chrono::milliseconds timeout) {
-    // We need to reset callback for each item in queue. Because we have only
-    // one timer for all tasks in executor.
-    _watchdog.set_callback([&task] { task.cancel(); });
-
-    _watchdog.rearm(
-      ss::lowres_clock::time_point(ss::lowres_clock::now() + timeout));
+internal::task_queue& executor::local_queue() {
+    auto& slot = _queues[ss::this_shard_id()];
+    auto* queue = slot.load(std::memory_order_relaxed);
+    if (!queue) {
+        queue = new internal::task_queue(_queue_size);
+        slot.store(queue, std::memory_order_release);
+    }
+    return *queue;
 }
 
-void executor::cancel_watchdog(internal::work_item& task) {
-    if (!_watchdog.cancel()) {
-        task.on_timeout();
+internal::work_item* executor::try_pop(size_t thread_idx) {
+    const size_t n_threads = _threads.size();
+    const size_t n_queues = _queues.size();
+    auto pop_from = [this](size_t shard) -> internal::work_item* {
+        auto* queue = _queues[shard].load(std::memory_order_acquire);
+        return queue ? queue->pop() : nullptr;
+    };
+    for (size_t shard = thread_idx % n_threads; shard < n_queues;
+         shard += n_threads) {
+        if (auto* item = pop_from(shard)) {
+            return item;
+        }
+    }
+    // Steal from the queues of the other threads, starting after the affine
+    // ones to spread the threads over the queues
+    for (size_t i = 1; i <= n_queues; ++i) {
+        const size_t shard = (thread_idx + i) % n_queues;
+        if (shard % n_threads == thread_idx % n_threads) {
+            continue;
+        }
+        if (auto* item = pop_from(shard)) {
+            return item;
+        }
     }
+    return nullptr;
+}
+
+bool executor::has_tasks() const {
+    return std::any_of(_queues.begin(), _queues.end(), [](const auto& slot) {
+        auto* queue = slot.load(std::memory_order_acquire);
+        return queue && !queue->empty();
+    });
 }
 
 void executor::pin(unsigned cpu_id) {
@@ -118,33 +153,46 @@ void executor::pin(unsigned cpu_id) {
     vassert(r == 0, "Can not pin executor thread to core {}", cpu_id);
 }
 
-void executor::loop() {
-    while (!(is_stopping() && _tasks.empty())) {
-        internal::work_item* item = _tasks.pop();
-
-        if (item) {
-            ss::alien::submit_to(
-              _alien_instance,
-              _watchdog_shard,
-              [this, item] {
-                  rearm_watchdog(*item, item->get_timeout());
-                  return ss::now();
-              })
-              .wait();
-
-            item->process();
-
-            ss::alien::submit_to(
-              _alien_instance,
-              _watchdog_shard,
-              [this, item] {
-                  cancel_watchdog(*item);
-                  return ss::now();
-              })
-              .wait();
-
-            item->done();
+void executor::process(internal::work_item& item) {
+    ss::alien::submit_to(
+      _alien_instance,
+      item.shard,
+      [&item] {
+          item.arm_watchdog();
+          return ss::now();
+      })
+      .wait();
+
+    item.process();
+
+    ss::alien::submit_to(
+      _alien_instance,
+      item.shard,
+      [&item] {
+          item.disarm_watchdog();
+          return ss::now();
+      })
+      .wait();
+
+    item.done();
+}
+
+void executor::loop(size_t thread_idx) {
+    while (true) {
+        if (auto* item = try_pop(thread_idx)) {
+            process(*item);
+            continue;
+        }
+        if (is_stopping() && !has_tasks()) {
+            return;
         }
+        std::unique_lock lock{_std_mutex};
+        // We need to use wait_for, because std::thread can miss notification
+        // from seastar thread (between check pred and sleep)
+        _has_element_cv.wait_for(
+          lock, _timeout_cond_wait_std_thread_ms, [this] {
+              return has_tasks() || is_stopping();
+          });
     }
 }
 
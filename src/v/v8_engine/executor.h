@@ -24,13 +24,15 @@
 #include <seastar/core/smp.hh>
 #include <seastar/util/later.hh>
 
-#include <boost/lockfree/spsc_queue.hpp>
+#include <boost/lockfree/queue.hpp>
 
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <exception>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 namespace v8_engine {
 
@@ -38,6 +40,8 @@ namespace internal {
 
 // Abstract class for executor task
 struct work_item {
+    work_item()
+      : shard(ss::this_shard_id()) {}
     virtual ~work_item() {}
     virtual void process() noexcept = 0;
     virtual void cancel() noexcept = 0;
@@ -49,7 +53,27 @@ struct work_item {
 
     virtual void done() = 0;
 
+    // Cancels the task once it runs for longer than its timeout. Must be
+    // called on the shard that submitted the task
+    void arm_watchdog() {
+        _watchdog.set_callback([this] { cancel(); });
+        _watchdog.arm(ss::lowres_clock::now() + get_timeout());
+    }
+
+    // Must be called on the shard that submitted the task
+    void disarm_watchdog() {
+        if (!_watchdog.cancel()) {
+            on_timeout();
+        }
+    }
+
     std::exception_ptr _exception;
+
+    // Shard that submitted the task, its watchdog runs there
+    ss::shard_id shard;
+
+private:
+    ss::timer<ss::lowres_clock> _watchdog;
 };
 
 // This class implement task for executor. Contains promise logic
@@ -115,15 +139,11 @@ struct task final : work_item {
     std::chrono::milliseconds _timeout;
 };
 
-// This class implement queue for submit task from seastar to std::thread. Only
-// one core with seastar can submit task to queue. Only one std::thread can
-// consume task from queue.
-class spsc_queue {
-    static constexpr std::chrono::milliseconds _timeout_cond_wait_std_thread_ms{
-      30};
-
+// Queue of the tasks submitted by one shard. Only the shard that created the
+// queue can push to it, any executor thread can pop from it.
+class task_queue {
 public:
-    explicit spsc_queue(size_t queue_size);
+    explicit task_queue(size_t queue_size);
 
     // Close queue and break waiting on seastar mutex
     void close();
@@ -131,32 +151,49 @@ public:
     // Push new item to queue. Only one future can wait on readable_eventfd
     ss::future<> push(work_item* item);
 
-    // Pop element from queue (blocking)
+    // Pop element from queue, nullptr if the queue is empty. Called from the
+    // executor threads
     work_item* pop();
 
-    bool empty();
+    bool empty() const;
+
+    // Held open by the tasks of the shard until they are done
+    ss::gate& gate() { return _gate; }
 
 private:
     mutex _push_mutex;
     seastar::readable_eventfd _is_not_full;
+    ss::gate _gate;
 
-    std::atomic<bool> _is_stopped{false};
-
-    boost::lockfree::spsc_queue<work_item*> _items;
-
-    std::mutex _std_mutex;
-    std::condition_variable _has_element_cv;
+    // The node pool is preallocated, its size is bounded by 2^16 - 1 nodes
+    boost::lockfree::queue<work_item*, boost::lockfree::fixed_sized<true>>
+      _items;
 };
 
 } // namespace internal
 
-// This class implement executor (std::thread) for runing v8 script. It
-// uses boost::spsc_queue for storing task.
-// For use we need create ss::shared<executor> and run submit like
-// executor_sharded.invoke_on(<core with executor>)
+// This class implement executor (pool of std::thread) for runing v8 script.
+// Every shard submits its tasks to a queue of its own, created on the first
+// submit from the shard. Every thread prefers the queues of the shards
+// affine to it, `shard % number of threads`, and steals the tasks of the
+// other queues when those are empty, so that one slow script only holds one
+// thread. Scripts own their isolate, which can run on any of the threads.
+//
+// submit() can be called from any shard, stop() must be called from the shard
+// that created the executor.
 class executor {
+    static constexpr std::chrono::milliseconds _timeout_cond_wait_std_thread_ms{
+      30};
+
 public:
-    executor(ss::alien::instance& instance, uint8_t cpu_id, size_t queue_size);
+    // Pool of one thread for every cpu id, pinned to it
+    executor(
+      ss::alien::instance& instance,
+      std::vector<unsigned> cpu_ids,
+      size_t queue_size);
+
+    executor(ss::alien::instance& instance, uint8_t cpu_id, size_t queue_size)
+      : executor(instance, std::vector<unsigned>{cpu_id}, queue_size) {}
 
     executor(const executor& other) = delete;
     executor& operator=(const executor& other) = delete;
@@ -165,7 +202,8 @@ public:
 
     ~executor() = default;
 
-    // Stop executou. Stop queue with task and close gate
+    // Stop executor. Stop the queues of all shards, wait for their tasks and
+    // join the threads
     ss::future<> stop();
 
     bool is_stopping() const;
@@ -187,42 +225,53 @@ public:
     ss::future<> submit(
       WrapperFuncForExecutor&& func_for_executor,
       std::chrono::milliseconds timeout) {
-        gate_guard guard{_gate};
+        if (_is_closing.load(std::memory_order_acquire)) {
+            throw ss::gate_closed_exception();
+        }
+        internal::task_queue& queue = local_queue();
+        gate_guard guard{queue.gate()};
 
         auto new_task
           = std::make_unique<internal::task<WrapperFuncForExecutor>>(
             std::forward<WrapperFuncForExecutor>(func_for_executor), timeout);
 
-        co_await _tasks.push(new_task.get());
+        co_await queue.push(new_task.get());
+        _has_element_cv.notify_one();
         co_await new_task->get_future();
     }
 
 private:
-    // Set callback and rearm watchdog
-    void rearm_watchdog(
-      internal::work_item& task, std::chrono::milliseconds timeout);
+    // Queue of the current shard, created on first use
+    internal::task_queue& local_queue();
+
+    // Next task for the thread, from its affine queues first, nullptr if all
+    // of the queues are empty
+    internal::work_item* try_pop(size_t thread_idx);
 
-    // Cancel watchdog
-    void cancel_watchdog(internal::work_item& task);
+    bool has_tasks() const;
 
     // We need to pin thread to core without seastar reactor
     void pin(unsigned cpu_id);
 
     // Main loop for threads in executor
-    void loop();
+    void loop(size_t thread_idx);
+
+    void process(internal::work_item& item);
 
     ss::alien::instance& _alien_instance;
 
+    std::atomic<bool> _is_closing{false};
     std::atomic<bool> _is_stopped{false};
 
-    std::thread _thread;
+    size_t _queue_size;
 
-    ss::gate _gate;
-    internal::spsc_queue _tasks;
+    // Queue per shard, only written by the shard it belongs to
+    std::vector<std::atomic<internal::task_queue*>> _queues;
 
-    ss::timer<ss::lowres_clock> _watchdog;
+    std::mutex _std_mutex;
+    std::condition_variable _has_element_cv;
 
-    ss::shard_id _watchdog_shard;
+    std::vector<std::thread> _threads;
 };
 
 } // namespace v8_engine
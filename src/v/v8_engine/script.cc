@@ -21,6 +21,7 @@
 
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <string_view>
 #include <utility>
 
@@ -43,7 +44,10 @@ script::~script() {
     _context.Reset();
 }
 
-void script::compile_script(ss::temporary_buffer<char> js_code) {
+void script::compile_script(
+  ss::temporary_buffer<char> js_code,
+  const code_cache::data_t* cached,
+  code_cache::data_t* produced) {
     v8::Locker locker(_isolate.get());
     v8::Isolate::Scope isolate_scope(_isolate.get());
     v8::HandleScope handle_scope(_isolate.get());
@@ -57,12 +61,36 @@ void script::compile_script(ss::temporary_buffer<char> js_code) {
                                           v8::NewStringType::kNormal,
                                           js_code.size())
                                           .ToLocalChecked();
+    // Owned by the source, the bytes stay owned by the cache
+    v8::ScriptCompiler::CachedData* cached_data = nullptr;
+    if (cached) {
+        cached_data = new v8::ScriptCompiler::CachedData(
+          cached->data(),
+          static_cast<int>(cached->size()),
+          v8::ScriptCompiler::CachedData::BufferNotOwned);
+    }
+    v8::ScriptCompiler::Source source(script_code, cached_data);
     v8::Local<v8::Script> compiled_script;
-    if (!v8::Script::Compile(local_ctx, script_code)
+    if (!v8::ScriptCompiler::Compile(
+           local_ctx,
+           &source,
+           cached_data ? v8::ScriptCompiler::kConsumeCodeCache
+                       : v8::ScriptCompiler::kNoCompileOptions)
            .ToLocal(&compiled_script)) {
         throw_exception_from_v8(try_catch, "Can not compile script");
     }
 
+    // A rejected cache was compiled from the source, replace it
+    const bool from_cache = cached_data && !source.GetCachedData()->rejected;
+    if (produced && !from_cache) {
+        std::unique_ptr<v8::ScriptCompiler::CachedData> code(
+          v8::ScriptCompiler::CreateCodeCache(
+            compiled_script->GetUnboundScript()));
+        if (code) {
+            produced->assign(code->data, code->data + code->length);
+        }
+    }
+
     // Run js code in first time and init some data from them.
     // Need to be running in executor.
     v8::Local<v8::Value> result;
@@ -99,7 +127,8 @@ void script::set_function(std::string_view name) {
     _function.Reset(_isolate.get(), function_val.As<v8::Function>());
 }
 
-void script::run_internal(ss::temporary_buffer<char> data) {
+void script::run_internal(
+  ss::temporary_buffer<char> data, std::vector<char>* result_buffer) {
     v8::Locker locker(_isolate.get());
     v8::Isolate::Scope isolate_scope(_isolate.get());
     v8::HandleScope handle_scope(_isolate.get());
@@ -127,6 +156,19 @@ void script::run_internal(ss::temporary_buffer<char> data) {
             throw_exception_from_v8(try_catch, "Can not run function");
         }
     }
+
+    if (result_buffer) {
+        if (result->IsArrayBuffer()) {
+            auto returned = result.As<v8::ArrayBuffer>()->GetBackingStore();
+            const auto* begin = static_cast<const char*>(returned->Data());
+            result_buffer->assign(begin, begin + returned->ByteLength());
+        } else if (result->IsUndefined()) {
+            result_buffer->assign(data.begin(), data.end());
+        } else {
+            throw_exception_from_v8(
+              "Function must return an ArrayBuffer or nothing");
+        }
+    }
 }
 
 void script::throw_exception_from_v8(std::string_view msg) {
@@ -11,8 +11,11 @@
 #pragma once
 
 #include "seastarx.h"
+#include "v8_engine/batch_buffer.h"
+#include "v8_engine/code_cache.h"
 #include "v8_engine/environment.h"
 
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/semaphore.hh>
@@ -21,7 +24,10 @@
 #include <seastar/core/timer.hh>
 
 #include <chrono>
+#include <memory>
+#include <string_view>
 #include <v8.h>
+#include <vector>
 
 namespace v8_engine {
 
@@ -77,6 +83,33 @@ public:
           .then([this, name = std::move(name)] { set_function(name); });
     }
 
+    /// Compile js code like init above, from the bytecode cached for the
+    /// same source if there is one. The bytecode of a script compiled from
+    /// its source is put into the cache.
+    ///
+    /// \param cache of the bytecode, must outlive the returned future
+    template<typename Executor>
+    ss::future<> init(
+      ss::sstring name,
+      ss::temporary_buffer<char> js_code,
+      Executor& executor,
+      code_cache& cache) {
+        const auto hash = code_cache::source_hash(js_code);
+        auto cached = cache.get(hash);
+        auto produced = std::make_unique<code_cache::data_t>();
+        compile_task task(
+          *this, std::move(js_code), cached.get(), produced.get());
+        co_await add_future_handlers(
+          executor.submit(std::move(task), _first_run_timeout_ms));
+        set_function(name);
+        if (!produced->empty()) {
+            cache.put(
+              hash,
+              std::make_shared<const code_cache::data_t>(
+                std::move(*produced)));
+        }
+    }
+
     /// Run function from js script.
     ///
     /// \param data for js script. TODO: think about temporary_buffer. Maybe
@@ -89,10 +122,35 @@ public:
           executor.submit(std::move(task), _timeout_ms));
     }
 
+    /// Run function from js script once for all of the records of a batch.
+    ///
+    /// The function receives the records packed in one ArrayBuffer, see
+    /// batch_buffer.h, and returns the filtered or transformed records packed
+    /// the same way in a new ArrayBuffer, or nothing if it only changed the
+    /// records in place.
+    /// \param records of the batch
+    /// \param executor for run script
+    template<typename Executor>
+    ss::future<batch_records>
+    run_batch(const batch_records& records, Executor& executor) {
+        std::vector<char> result;
+        run_task task(*this, pack_records(records), &result);
+        co_await add_future_handlers(
+          executor.submit(std::move(task), _timeout_ms));
+        co_return unpack_records(
+          std::string_view(result.data(), result.size()));
+    }
+
 private:
     // Must be running in executor, because it runs js code
     // in first time for init global vars and e.t.c.
-    void compile_script(ss::temporary_buffer<char> js_code);
+    // The script is deserialized from cached bytecode if not null and V8
+    // accepts it, otherwise it is compiled and its bytecode is written to
+    // produced if not null
+    void compile_script(
+      ss::temporary_buffer<char> js_code,
+      const code_cache::data_t* cached = nullptr,
+      code_cache::data_t* produced = nullptr);
 
     // Init function from compiled js code.
     void set_function(std::string_view name);
@@ -103,7 +161,10 @@ private:
     /// We need to controle execution time for js function
 
     /// \param buffer with data, wich js code can read and edit.
-    void run_internal(ss::temporary_buffer<char> data);
+    /// \param result if not null, receives the ArrayBuffer returned by the
+    /// function, or the data if it returned nothing
+    void run_internal(
+      ss::temporary_buffer<char> data, std::vector<char>* result = nullptr);
 
     // Throw c++ exception from v8::TryCatch
     void throw_exception_from_v8(std::string_view msg);
@@ -162,18 +223,41 @@ private:
 
     class compile_task : public task_for_executor {
     public:
-        compile_task(script& script, ss::temporary_buffer<char> data)
-          : task_for_executor(script, std::move(data)) {}
-
-        void operator()() override { _script.compile_script(std::move(_data)); }
+        compile_task(
+          script& script,
+          ss::temporary_buffer<char> data,
+          const code_cache::data_t* cached = nullptr,
+          code_cache::data_t* produced = nullptr)
+          : task_for_executor(script, std::move(data))
+          , _cached(cached)
+          , _produced(produced) {}
+
+        void operator()() override {
+            _script.compile_script(std::move(_data), _cached, _produced);
+        }
+
+    private:
+        // Owned by the caller of submit, alive until the task is done
+        const code_cache::data_t* _cached;
+        code_cache::data_t* _produced;
     };
 
     class run_task : public task_for_executor {
     public:
-        run_task(script& script, ss::temporary_buffer<char> data)
-          : task_for_executor(script, std::move(data)) {}
-
-        void operator()() override { _script.run_internal(std::move(_data)); }
+        run_task(
+          script& script,
+          ss::temporary_buffer<char> data,
+          std::vector<char>* result = nullptr)
+          : task_for_executor(script, std::move(data))
+          , _result(result) {}
+
+        void operator()() override {
+            _script.run_internal(std::move(_data), _result);
+        }
+
+    private:
+        // Owned by the caller of submit, alive until the task is done
+        std::vector<char>* _result;
     };
 };
 
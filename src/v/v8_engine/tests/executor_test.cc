@@ -247,3 +247,42 @@ SEASTAR_THREAD_TEST_CASE(stress_test) {
         test_executor.stop().get();
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(slow_task_does_not_block_pool_test) {
+    struct task_for_test {
+        explicit task_for_test(unsigned seconds, char& is_finish)
+          : _seconds(seconds)
+          , _is_finish(is_finish) {}
+
+        void operator()() {
+            sleep(_seconds);
+            _is_finish = 1;
+        }
+
+        void cancel() {}
+
+        void on_timeout() {}
+
+        unsigned _seconds;
+        char& _is_finish;
+    };
+
+    v8_engine::executor test_executor(
+      ss::engine().alien(), std::vector<unsigned>{1, 1}, 10);
+
+    char slow_finished = 0;
+    char fast_finished = 0;
+    auto slow = test_executor.submit(
+      task_for_test(2, slow_finished), std::chrono::milliseconds(5000));
+    // the second thread of the pool takes the task while the first one is
+    // busy with the slow task
+    test_executor
+      .submit(task_for_test(0, fast_finished), std::chrono::milliseconds(5000))
+      .get();
+    BOOST_REQUIRE_EQUAL(fast_finished, 1);
+    BOOST_REQUIRE_EQUAL(slow_finished, 0);
+
+    slow.get();
+    BOOST_REQUIRE_EQUAL(slow_finished, 1);
+    test_executor.stop().get();
+}
@@ -152,3 +152,105 @@ SEASTAR_THREAD_TEST_CASE(run_timeout_test) {
           return "Sript timeout" == std::string(e.what());
       });
 }
+
+static v8_engine::batch_records
+make_records(const std::vector<ss::sstring>& values) {
+    v8_engine::batch_records records;
+    for (const auto& v : values) {
+        records.emplace_back(v.data(), v.size());
+    }
+    return records;
+}
+
+static std::vector<ss::sstring>
+to_strings(const v8_engine::batch_records& records) {
+    std::vector<ss::sstring> values;
+    for (const auto& r : records) {
+        values.emplace_back(r.get(), r.size());
+    }
+    return values;
+}
+
+SEASTAR_THREAD_TEST_CASE(batch_buffer_roundtrip_test) {
+    const std::vector<ss::sstring> values = {"first", "", "third record"};
+    auto packed = v8_engine::pack_records(make_records(values));
+    BOOST_REQUIRE_EQUAL(
+      packed.size(), v8_engine::batch_buffer_header_size(3) + 17);
+    auto unpacked = v8_engine::unpack_records(
+      std::string_view(packed.get(), packed.size()));
+    BOOST_REQUIRE(to_strings(unpacked) == values);
+
+    // offsets past the end of the data
+    BOOST_REQUIRE_THROW(
+      v8_engine::unpack_records(
+        std::string_view(packed.get(), packed.size() - 1)),
+      v8_engine::script_exception);
+    BOOST_REQUIRE_THROW(
+      v8_engine::unpack_records(std::string_view(packed.get(), 2)),
+      v8_engine::script_exception);
+}
+
+SEASTAR_THREAD_TEST_CASE(run_batch_test) {
+    executor_wrapper_for_test executor_wrapper;
+
+    v8_engine::script script(100, TIMEOUT_FOR_TEST_MS);
+
+    ss::temporary_buffer<char> js_code
+      = read_fully_tmpbuf("batch_filter.js").get();
+    script
+      .init("batch_filter", std::move(js_code), executor_wrapper.get_executor())
+      .get();
+
+    auto records = make_records({"abc", "#dropped", "", "qwerty", "#"});
+    auto result = script.run_batch(records, executor_wrapper.get_executor())
+                    .get0();
+    const std::vector<ss::sstring> expected = {"ABC", "", "QWERTY"};
+    BOOST_REQUIRE(to_strings(result) == expected);
+}
+
+SEASTAR_THREAD_TEST_CASE(run_batch_in_place_test) {
+    executor_wrapper_for_test executor_wrapper;
+
+    v8_engine::script script(100, TIMEOUT_FOR_TEST_MS);
+
+    // upper cases the whole packed buffer in place and returns nothing, the
+    // header is made of small integers which are left unchanged
+    ss::temporary_buffer<char> js_code = read_fully_tmpbuf("to_upper.js").get();
+    script.init("to_upper", std::move(js_code), executor_wrapper.get_executor())
+      .get();
+
+    auto result = script
+                    .run_batch(
+                      make_records({"abc", "qwerty"}),
+                      executor_wrapper.get_executor())
+                    .get0();
+    const std::vector<ss::sstring> expected = {"ABC", "QWERTY"};
+    BOOST_REQUIRE(to_strings(result) == expected);
+}
+
+SEASTAR_THREAD_TEST_CASE(code_cache_test) {
+    v8_engine::code_cache cache;
+    ss::temporary_buffer<char> js_code = read_fully_tmpbuf("to_upper.js").get();
+
+    // compiled from the source by the first isolate, from the bytecode by the
+    // following ones, including the ones of a restarted executor
+    for (int i = 0; i < 3; ++i) {
+        executor_wrapper_for_test executor_wrapper;
+        v8_engine::script script(100, TIMEOUT_FOR_TEST_MS);
+        script
+          .init(
+            "to_upper",
+            js_code.share(),
+            executor_wrapper.get_executor(),
+            cache)
+          .get();
+        BOOST_REQUIRE_EQUAL(cache.entries(), 1);
+        BOOST_REQUIRE(cache.get(v8_engine::code_cache::source_hash(js_code)));
+
+        ss::sstring raw_data = "qwerty";
+        ss::temporary_buffer<char> data(raw_data.data(), raw_data.size());
+        script.run(data.share(), executor_wrapper.get_executor()).get();
+        BOOST_REQUIRE_EQUAL(
+          std::string(data.get_write(), data.size()), "QWERTY");
+    }
+}
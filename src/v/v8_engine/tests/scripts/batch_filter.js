@@ -0,0 +1,36 @@
+// Drops the records starting with '#' and upper cases the others. The records
+// of the batch are passed and returned packed in one buffer:
+// [count][count + 1 offsets][data], all little endian uint32
+function batch_filter(obj) {
+    let view = new DataView(obj);
+    let count = view.getUint32(0, true);
+    let data_start = 4 * (count + 2);
+    let kept = [];
+    let size = 0;
+    for (let i = 0; i < count; i++) {
+        let begin = view.getUint32(4 * (i + 1), true);
+        let end = view.getUint32(4 * (i + 2), true);
+        let record = new Uint8Array(obj, data_start + begin, end - begin);
+        if (record.length > 0 && record[0] == 35) {
+            continue;
+        }
+        kept.push(record);
+        size += record.length;
+    }
+    let out_start = 4 * (kept.length + 2);
+    let out = new ArrayBuffer(out_start + size);
+    let out_view = new DataView(out);
+    let bytes = new Uint8Array(out);
+    out_view.setUint32(0, kept.length, true);
+    let pos = 0;
+    for (let i = 0; i < kept.length; i++) {
+        out_view.setUint32(4 * (i + 1), pos, true);
+        for (let j = 0; j < kept[i].length; j++) {
+            let c = kept[i][j];
+            bytes[out_start + pos + j] = (c >= 97 && c <= 122) ? c - 32 : c;
+        }
+        pos += kept[i].length;
+    }
+    out_view.setUint32(4 * (kept.length + 1), pos, true);
+    return out;
+}
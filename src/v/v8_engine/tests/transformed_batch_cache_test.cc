@@ -0,0 +1,86 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "model/fundamental.h"
+#include "storage/tests/utils/random_batch.h"
+#include "v8_engine/data_policy_table.h"
+#include "v8_engine/transformed_batch_cache.h"
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include <boost/test/unit_test.hpp>
+
+static const model::topic_namespace test_tn(
+  model::ns("kafka"), model::topic("dp_topic"));
+
+static v8_engine::transformed_batch_cache::key
+make_key(uint64_t version, const model::record_batch& b, int partition = 0) {
+    return {
+      .ntp = model::ntp(test_tn.ns, test_tn.tp, model::partition_id(partition)),
+      .policy_version = version,
+      .base_offset = b.base_offset(),
+      .last_offset = b.last_offset()};
+}
+
+SEASTAR_THREAD_TEST_CASE(cache_hit_and_version_mismatch_test) {
+    v8_engine::transformed_batch_cache cache;
+    auto batch = storage::test::make_random_batch(model::offset(10), 5, false);
+    cache.put(make_key(1, batch), batch);
+
+    auto cached = cache.get(make_key(1, batch));
+    BOOST_REQUIRE(cached);
+    BOOST_REQUIRE_EQUAL(*cached, batch);
+    // transformed with another version of the policy
+    BOOST_REQUIRE(!cache.get(make_key(2, batch)));
+    BOOST_REQUIRE(!cache.get(make_key(1, batch, 1)));
+}
+
+SEASTAR_THREAD_TEST_CASE(cache_evicts_least_recently_used_test) {
+    auto first = storage::test::make_random_batch(model::offset(0), 5, false);
+    auto second = storage::test::make_random_batch(model::offset(5), 5, false);
+    auto third = storage::test::make_random_batch(model::offset(10), 5, false);
+    const size_t bound = 2
+                         * std::max(
+                           {first.memory_usage(),
+                            second.memory_usage(),
+                            third.memory_usage()});
+    v8_engine::transformed_batch_cache cache(bound);
+
+    cache.put(make_key(1, first), first);
+    cache.put(make_key(1, second), second);
+    // the first batch becomes the most recently used
+    BOOST_REQUIRE(cache.get(make_key(1, first)));
+    cache.put(make_key(1, third), third);
+
+    BOOST_REQUIRE_LE(cache.size_bytes(), bound);
+    BOOST_REQUIRE(cache.get(make_key(1, first)));
+    BOOST_REQUIRE(!cache.get(make_key(1, second)));
+    BOOST_REQUIRE(cache.get(make_key(1, third)));
+}
+
+SEASTAR_THREAD_TEST_CASE(cache_invalidated_on_policy_change_test) {
+    v8_engine::data_policy_table table;
+    BOOST_REQUIRE_EQUAL(table.policy_version(test_tn), 0);
+    table.insert(test_tn, v8_engine::data_policy("fn", "script"));
+    const auto version = table.policy_version(test_tn);
+    BOOST_REQUIRE_NE(version, 0);
+
+    auto batch = storage::test::make_random_batch(model::offset(0), 5, false);
+    table.transformed_batches().put(make_key(version, batch), batch);
+    BOOST_REQUIRE_EQUAL(table.transformed_batches().entries(), 1);
+
+    table.erase(test_tn);
+    BOOST_REQUIRE_EQUAL(table.transformed_batches().entries(), 0);
+    BOOST_REQUIRE_EQUAL(table.transformed_batches().size_bytes(), 0);
+
+    // a policy set again never reuses the version of the previous one
+    table.insert(test_tn, v8_engine::data_policy("fn", "script"));
+    BOOST_REQUIRE_GT(table.policy_version(test_tn), version);
+}
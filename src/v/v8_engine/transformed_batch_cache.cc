@@ -0,0 +1,68 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#include "v8_engine/transformed_batch_cache.h"
+
+namespace v8_engine {
+
+transformed_batch_cache::~transformed_batch_cache() noexcept { clear(); }
+
+std::optional<model::record_batch>
+transformed_batch_cache::get(const key& k) {
+    auto found = _entries.find(k);
+    if (found == _entries.end()) {
+        return std::nullopt;
+    }
+    auto& e = found->second;
+    _lru.erase(_lru.iterator_to(e));
+    _lru.push_front(e);
+    return e.batch.share();
+}
+
+void transformed_batch_cache::put(key k, const model::record_batch& batch) {
+    const size_t size = batch.memory_usage();
+    if (size > _max_bytes) {
+        return;
+    }
+    if (auto found = _entries.find(k); found != _entries.end()) {
+        erase(found);
+    }
+    while (_size_bytes + size > _max_bytes && !_lru.empty()) {
+        erase(_entries.find(*_lru.back().k));
+    }
+    auto [it, _] = _entries.emplace(std::move(k), batch.copy());
+    it->second.k = &it->first;
+    _lru.push_front(it->second);
+    _size_bytes += size;
+}
+
+void transformed_batch_cache::invalidate(const model::topic_namespace& tn) {
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        auto current = it++;
+        const auto& ntp = current->first.ntp;
+        if (ntp.ns == tn.ns && ntp.tp.topic == tn.tp) {
+            erase(current);
+        }
+    }
+}
+
+void transformed_batch_cache::clear() {
+    _lru.clear();
+    _entries.clear();
+    _size_bytes = 0;
+}
+
+void transformed_batch_cache::erase(map_t::iterator it) {
+    _lru.erase(_lru.iterator_to(it->second));
+    _size_bytes -= it->second.batch.memory_usage();
+    _entries.erase(it);
+}
+
+} // namespace v8_engine
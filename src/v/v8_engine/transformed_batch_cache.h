@@ -0,0 +1,104 @@
+/*
+ * Copyright 2021 Vectorized, Inc.
+ *
+ * Licensed as a Redpanda Enterprise file under the Redpanda Community
+ * License (the "License"); you may not use this file except in compliance with
+ * the License. You may obtain a copy of the License at
+ *
+ * https://github.com/vectorizedio/redpanda/blob/master/licenses/rcl.md
+ */
+
+#pragma once
+
+#include "model/fundamental.h"
+#include "model/metadata.h"
+#include "model/record.h"
+#include "units.h"
+#include "utils/intrusive_list_helpers.h"
+
+#include <absl/container/node_hash_map.h>
+
+#include <optional>
+
+namespace v8_engine {
+
+// Memory bounded LRU cache of the batches transformed by the data policy of
+// their topic, so that consumers fetching the same range of a partition pay
+// for the script run once.
+//
+// Entries are keyed by the version of the policy they were transformed with,
+// batches transformed with a policy that was replaced in the meantime are
+// never returned. The entries of a topic are dropped when its policy changes.
+class transformed_batch_cache {
+public:
+    static constexpr size_t default_max_bytes = 16_MiB;
+
+    struct key {
+        model::ntp ntp;
+        uint64_t policy_version;
+        // Offsets of the source batch
+        model::offset base_offset;
+        model::offset last_offset;
+
+        bool operator==(const key&) const = default;
+
+        template<typename H>
+        friend H AbslHashValue(H h, const key& k) {
+            return H::combine(
+              std::move(h),
+              std::hash<model::ntp>{}(k.ntp),
+              k.policy_version,
+              k.base_offset(),
+              k.last_offset());
+        }
+    };
+
+    explicit transformed_batch_cache(size_t max_bytes = default_max_bytes)
+      : _max_bytes(max_bytes) {}
+
+    transformed_batch_cache(const transformed_batch_cache&) = delete;
+    transformed_batch_cache& operator=(const transformed_batch_cache&)
+      = delete;
+    transformed_batch_cache(transformed_batch_cache&&) = delete;
+    transformed_batch_cache& operator=(transformed_batch_cache&&) = delete;
+    ~transformed_batch_cache() noexcept;
+
+    // Shares the cached batch, the entry becomes the most recently used
+    std::optional<model::record_batch> get(const key&);
+
+    // Caches a copy of the batch, evicting the least recently used entries
+    // to stay within the memory bound. Batches larger than the bound are not
+    // cached
+    void put(key, const model::record_batch&);
+
+    // Drops the entries of all of the partitions of the topic
+    void invalidate(const model::topic_namespace&);
+
+    void clear();
+
+    size_t size_bytes() const { return _size_bytes; }
+    size_t entries() const { return _entries.size(); }
+
+private:
+    struct entry {
+        explicit entry(model::record_batch b)
+          : batch(std::move(b)) {}
+
+        model::record_batch batch;
+        // Key of the entry in the map, its nodes are stable
+        const key* k{nullptr};
+        intrusive_list_hook hook;
+    };
+
+    using map_t = absl::node_hash_map<key, entry>;
+
+    void erase(map_t::iterator);
+
+    size_t _max_bytes;
+    size_t _size_bytes{0};
+    map_t _entries;
+    // Most recently used at the front
+    intrusive_list<entry, &entry::hook> _lru;
+};
+
+} // namespace v8_engine
@@ -88,6 +88,21 @@ public:
                 "latency",
                 [this] { return _methods[{{loop.index-1}}].probes.latency_hist().seastar_histogram_logform(); },
                 sm::description("Internal RPC service latency"),
+                labels),
+               sm::make_histogram(
+                "queue_latency",
+                [this] { return _methods[{{loop.index-1}}].probes.queue_hist().seastar_histogram_logform(); },
+                sm::description("Internal RPC time waiting for memory admission"),
+                labels),
+               sm::make_histogram(
+                "serialization_latency",
+                [this] { return _methods[{{loop.index-1}}].probes.serialization_hist().seastar_histogram_logform(); },
+                sm::description("Internal RPC time reading and parsing requests, and serializing replies"),
+                labels),
+               sm::make_histogram(
+                "service_latency",
+                [this] { return _methods[{{loop.index-1}}].probes.service_hist().seastar_histogram_logform(); },
+                sm::description("Internal RPC time in the method handler"),
                 labels)});
         }
       {%- endfor %}
@@ -115,6 +130,7 @@ public:
     raw_{{method.name}}(ss::input_stream<char>& in, rpc::streaming_context& ctx) {
       return execution_helper<{{method.input_type}},
                               {{method.output_type}}>::exec(in, ctx, {{method.id}},
+      _methods[{{loop.index - 1}}].probes,
       [this](
           {{method.input_type}}&& t, rpc::streaming_context& ctx) -> ss::future<{{method.output_type}}> {
           return {{method.name}}(std::move(t), ctx);
@@ -132,7 +148,7 @@ private:
       {%- for method in methods %}
       rpc::method([this] (ss::input_stream<char>& in, rpc::streaming_context& ctx) {
          return raw_{{method.name}}(in, ctx);
-      }){{ "," if not loop.last }}
+      }, rpc::method_priority::{{method.priority}}){{ "," if not loop.last }}
       {%- endfor %}
     {% raw %}}}{% endraw %};
     ss::metrics::metric_groups _metrics;
@@ -234,6 +250,11 @@ def _enrich_methods(service):
 
     for m in service["methods"]:
         m["id"] = _xor_id(m)
+        # latency sensitive methods are declared with "priority": "high"
+        m.setdefault("priority", "normal")
+        if m["priority"] not in ("normal", "high"):
+            raise ValueError("unknown priority %s of method %s" %
+                             (m["priority"], m["name"]))
 
     return service
 